@@ -15,7 +15,13 @@
 #ifndef RCLCPP__ALLOCATOR__ALLOCATOR_COMMON_HPP_
 #define RCLCPP__ALLOCATOR__ALLOCATOR_COMMON_HPP_
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
 
 #include "rcl/allocator.h"
 
@@ -62,12 +68,79 @@ void * retyped_reallocate(void * untyped_pointer, size_t size, void * untyped_al
   return std::allocator_traits<Alloc>::allocate(*typed_allocator, size);
 }
 
+template<typename Alloc>
+struct is_polymorphic_allocator : std::false_type {};
+
+template<typename T>
+struct is_polymorphic_allocator<std::pmr::polymorphic_allocator<T>>: std::true_type {};
+
+template<typename T>
+class MessagePoolAllocator;
+
+template<typename Alloc>
+struct is_message_pool_allocator : std::false_type {};
+
+template<typename T>
+struct is_message_pool_allocator<MessagePoolAllocator<T>>: std::true_type {};
+
+namespace detail
+{
+
+// The rcl allocator does not pass the size of the memory it frees, but memory resources need
+// it, so every block starts with a header holding its size.
+constexpr size_t resource_header_size = alignof(std::max_align_t);
+
+inline void * resource_allocate(size_t size, void * untyped_resource)
+{
+  auto resource = static_cast<std::pmr::memory_resource *>(untyped_resource);
+  if (!resource) {
+    throw std::runtime_error("Received incorrect allocator type");
+  }
+  auto block = static_cast<unsigned char *>(
+    resource->allocate(size + resource_header_size, alignof(std::max_align_t)));
+  std::memcpy(block, &size, sizeof(size));
+  return block + resource_header_size;
+}
+
+inline void resource_deallocate(void * untyped_pointer, void * untyped_resource)
+{
+  auto resource = static_cast<std::pmr::memory_resource *>(untyped_resource);
+  if (!resource) {
+    throw std::runtime_error("Received incorrect allocator type");
+  }
+  if (!untyped_pointer) {
+    return;
+  }
+  auto block = static_cast<unsigned char *>(untyped_pointer) - resource_header_size;
+  size_t size;
+  std::memcpy(&size, block, sizeof(size));
+  resource->deallocate(block, size + resource_header_size, alignof(std::max_align_t));
+}
+
+inline void * resource_reallocate(void * untyped_pointer, size_t size, void * untyped_resource)
+{
+  void * new_pointer = resource_allocate(size, untyped_resource);
+  if (untyped_pointer) {
+    size_t old_size;
+    std::memcpy(
+      &old_size, static_cast<unsigned char *>(untyped_pointer) - resource_header_size,
+      sizeof(old_size));
+    std::memcpy(new_pointer, untyped_pointer, std::min(old_size, size));
+    resource_deallocate(untyped_pointer, untyped_resource);
+  }
+  return new_pointer;
+}
+
+}  // namespace detail
 
 // Convert a std::allocator_traits-formatted Allocator into an rcl allocator
 template<
   typename T,
   typename Alloc,
-  typename std::enable_if<!std::is_same<Alloc, std::allocator<void>>::value>::type * = nullptr>
+  typename std::enable_if<
+    !std::is_same<Alloc, std::allocator<void>>::value &&
+    !is_polymorphic_allocator<Alloc>::value &&
+    !is_message_pool_allocator<Alloc>::value>::type * = nullptr>
 rcl_allocator_t get_rcl_allocator(Alloc & allocator)
 {
   rcl_allocator_t rcl_allocator = rcl_get_default_allocator();
@@ -82,6 +155,47 @@ rcl_allocator_t get_rcl_allocator(Alloc & allocator)
   return rcl_allocator;
 }
 
+// Convert a polymorphic allocator into an rcl allocator using its memory resource
+/**
+ * The memory resource, rather than the allocator, is the state of the rcl allocator, so it has
+ * to outlive the rcl allocator, as it always has to outlive the polymorphic allocators using it.
+ */
+template<
+  typename T,
+  typename Alloc,
+  typename std::enable_if<is_polymorphic_allocator<Alloc>::value>::type * = nullptr>
+rcl_allocator_t get_rcl_allocator(Alloc & allocator)
+{
+  rcl_allocator_t rcl_allocator = rcl_get_default_allocator();
+  rcl_allocator.allocate = &detail::resource_allocate;
+  rcl_allocator.deallocate = &detail::resource_deallocate;
+  rcl_allocator.reallocate = &detail::resource_reallocate;
+  rcl_allocator.zero_allocate =
+    [](size_t number_of_elements, size_t size_of_element, void * untyped_resource) -> void * {
+      const size_t size = number_of_elements * size_of_element;
+      void * pointer = detail::resource_allocate(size, untyped_resource);
+      std::memset(pointer, 0, size);
+      return pointer;
+    };
+  rcl_allocator.state = allocator.resource();
+  return rcl_allocator;
+}
+
+// Convert a message pool allocator into an rcl allocator
+/**
+ * The rcl allocator frees memory without passing its size, which the pool needs to put a block
+ * back into the right bucket, so rcl allocations do not go through the pool at all.
+ */
+template<
+  typename T,
+  typename Alloc,
+  typename std::enable_if<is_message_pool_allocator<Alloc>::value>::type * = nullptr>
+rcl_allocator_t get_rcl_allocator(Alloc & allocator)
+{
+  (void)allocator;
+  return rcl_get_default_allocator();
+}
+
 // TODO(jacquelinekay) Workaround for an incomplete implementation of std::allocator<void>
 template<
   typename T,
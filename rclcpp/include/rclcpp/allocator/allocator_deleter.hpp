@@ -49,8 +49,10 @@ public:
   template<typename T>
   void operator()(T * ptr)
   {
-    std::allocator_traits<AllocRebind<T>>::destroy(*allocator_, ptr);
-    std::allocator_traits<AllocRebind<T>>::deallocate(*allocator_, ptr, 1);
+    // Rebind a copy, as the allocator may be of another value type, e.g. a polymorphic allocator.
+    AllocRebind<T> allocator(*allocator_);
+    std::allocator_traits<AllocRebind<T>>::destroy(allocator, ptr);
+    std::allocator_traits<AllocRebind<T>>::deallocate(allocator, ptr, 1);
     ptr = nullptr;
   }
 
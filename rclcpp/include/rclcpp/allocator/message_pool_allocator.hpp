@@ -0,0 +1,186 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__ALLOCATOR__MESSAGE_POOL_ALLOCATOR_HPP_
+#define RCLCPP__ALLOCATOR__MESSAGE_POOL_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rclcpp
+{
+namespace allocator
+{
+
+/// State shared by all copies and rebinds of a MessagePoolAllocator.
+class MessagePool
+{
+public:
+  explicit MessagePool(size_t max_pooled_blocks)
+  : max_pooled_blocks_(max_pooled_blocks)
+  {}
+
+  ~MessagePool()
+  {
+    for (auto & bucket : buckets_) {
+      for (void * block : bucket.second) {
+        ::operator delete(block);
+      }
+    }
+  }
+
+  /// Take a block of the given size from the pool, allocating one if none is available.
+  void * allocate(size_t size)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto & bucket = buckets_[size];
+      if (!bucket.empty()) {
+        void * block = bucket.back();
+        bucket.pop_back();
+        return block;
+      }
+      // Make sure returning this block later will not need to grow the bucket.
+      bucket.reserve(max_pooled_blocks_);
+    }
+    return ::operator new(size);
+  }
+
+  /// Give a block back to the pool, freeing it if the pool for its size is full.
+  void deallocate(void * block, size_t size)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto & bucket = buckets_[size];
+      if (bucket.size() < max_pooled_blocks_) {
+        bucket.push_back(block);
+        return;
+      }
+    }
+    ::operator delete(block);
+  }
+
+  /// Return the number of blocks of the given size currently held by the pool.
+  size_t pooled_blocks(size_t size) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto bucket_it = buckets_.find(size);
+    return bucket_it == buckets_.end() ? 0 : bucket_it->second.size();
+  }
+
+private:
+  const size_t max_pooled_blocks_;
+  std::unordered_map<size_t, std::vector<void *>> buckets_;
+  mutable std::mutex mutex_;
+};
+
+/// Allocator which recycles the memory of single objects, e.g. messages, through a pool.
+/**
+ * Allocations of a single object are served from, and returned to, a pool shared by all copies
+ * and rebinds of the allocator, so that publishing and receiving messages of the same type does
+ * not allocate once the pool has been filled.
+ * Allocations of arrays bypass the pool, and so does the rcl allocator derived from it with
+ * rclcpp::allocator::get_rcl_allocator(), which uses the default rcl allocator, because rcl
+ * frees memory without passing its size.
+ *
+ * Pass the same instance as the allocator of the publisher and of the subscriptions of a topic
+ * to share one pool per topic.
+ * This notably recycles the copies the rclcpp::experimental::IntraProcessManager makes for every
+ * subscription requiring ownership of a message but the last one.
+ * Only the memory of the message itself is recycled, memory owned by its members, like the
+ * sequences of the message, is still allocated by their own allocators.
+ *
+ * All member functions are thread-safe.
+ */
+template<typename T>
+class MessagePoolAllocator
+{
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  template<typename U>
+  struct rebind
+  {
+    using other = MessagePoolAllocator<U>;
+  };
+
+  /// Constructor.
+  /**
+   * \param max_pooled_blocks maximum number of free blocks of the same size kept by the pool
+   */
+  explicit MessagePoolAllocator(size_t max_pooled_blocks = 16)
+  : pool_(std::make_shared<MessagePool>(max_pooled_blocks))
+  {}
+
+  template<typename U>
+  MessagePoolAllocator(const MessagePoolAllocator<U> & other) noexcept
+  : pool_(other.get_pool())
+  {}
+
+  T * allocate(size_t n)
+  {
+    static_assert(
+      alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+      "MessagePoolAllocator does not support over-aligned types");
+    if (n == 1) {
+      return static_cast<T *>(pool_->allocate(sizeof(T)));
+    }
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T * ptr, size_t n)
+  {
+    if (!ptr) {
+      return;
+    }
+    if (n == 1) {
+      pool_->deallocate(ptr, sizeof(T));
+      return;
+    }
+    ::operator delete(ptr);
+  }
+
+  const std::shared_ptr<MessagePool> & get_pool() const noexcept
+  {
+    return pool_;
+  }
+
+private:
+  std::shared_ptr<MessagePool> pool_;
+};
+
+template<typename T, typename U>
+bool operator==(const MessagePoolAllocator<T> & a, const MessagePoolAllocator<U> & b) noexcept
+{
+  return a.get_pool() == b.get_pool();
+}
+
+template<typename T, typename U>
+bool operator!=(const MessagePoolAllocator<T> & a, const MessagePoolAllocator<U> & b) noexcept
+{
+  return !(a == b);
+}
+
+}  // namespace allocator
+}  // namespace rclcpp
+
+#endif  // RCLCPP__ALLOCATOR__MESSAGE_POOL_ALLOCATOR_HPP_
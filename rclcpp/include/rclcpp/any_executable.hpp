@@ -15,6 +15,7 @@
 #ifndef RCLCPP__ANY_EXECUTABLE_HPP_
 #define RCLCPP__ANY_EXECUTABLE_HPP_
 
+#include <chrono>
 #include <memory>
 
 #include "rclcpp/callback_group.hpp"
@@ -48,6 +49,8 @@ struct AnyExecutable
   rclcpp::CallbackGroup::SharedPtr callback_group;
   rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base;
   std::shared_ptr<void> data;
+  // End of the wait which found the executable ready, only set if the executor is instrumented.
+  std::chrono::steady_clock::time_point ready_time;
 };
 
 }  // namespace rclcpp
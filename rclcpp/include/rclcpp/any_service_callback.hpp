@@ -22,7 +22,9 @@
 #include <type_traits>
 #include <utility>
 
+#include "rclcpp/detail/service_message_pool.hpp"
 #include "rclcpp/function_traits.hpp"
+#include "rclcpp/tracing.hpp"
 #include "rclcpp/visibility_control.hpp"
 #include "rmw/types.h"
 #include "tracetools/tracetools.h"
@@ -149,14 +151,21 @@ public:
     }
   }
 
+  /// Call the callback with a request, returning the response unless it is deferred.
+  /**
+   * \param[in] response_pool if not null, the response is taken from it instead of being
+   *   allocated.
+   */
   // template<typename Allocator = std::allocator<typename ServiceT::Response>>
   std::shared_ptr<typename ServiceT::Response>
   dispatch(
     const std::shared_ptr<rclcpp::Service<ServiceT>> & service_handle,
     const std::shared_ptr<rmw_request_id_t> & request_header,
-    std::shared_ptr<typename ServiceT::Request> request)
+    std::shared_ptr<typename ServiceT::Request> request,
+    rclcpp::detail::ServiceMessagePool<typename ServiceT::Response> * response_pool = nullptr)
   {
     TRACEPOINT(callback_start, static_cast<const void *>(this), false);
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackStart, this, 0, false);
     if (std::holds_alternative<std::monostate>(callback_)) {
       // TODO(ivanpauno): Remove the set method, and force the users of this class
       // to pass a callback at construnciton.
@@ -173,7 +182,8 @@ public:
       return nullptr;
     }
     // auto response = allocate_shared<typename ServiceT::Response, Allocator>();
-    auto response = std::make_shared<typename ServiceT::Response>();
+    auto response = response_pool ?
+      response_pool->acquire() : std::make_shared<typename ServiceT::Response>();
     if (std::holds_alternative<SharedPtrCallback>(callback_)) {
       (void)request_header;
       const auto & cb = std::get<SharedPtrCallback>(callback_);
@@ -183,6 +193,7 @@ public:
       cb(request_header, std::move(request), response);
     }
     TRACEPOINT(callback_end, static_cast<const void *>(this));
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackEnd, this, 0, 0);
     return response;
   }
 
@@ -29,8 +29,11 @@
 #include "rclcpp/allocator/allocator_common.hpp"
 #include "rclcpp/detail/subscription_callback_type_helper.hpp"
 #include "rclcpp/function_traits.hpp"
+#include "rclcpp/lazy_message.hpp"
 #include "rclcpp/message_info.hpp"
 #include "rclcpp/serialized_message.hpp"
+#include "rclcpp/subscription_loaned_message.hpp"
+#include "rclcpp/tracing.hpp"
 #include "rclcpp/type_adapter.hpp"
 
 
@@ -137,6 +140,17 @@ struct AnySubscriptionCallbackPossibleTypes
         const std::shared_ptr<const rclcpp::SerializedMessage> &,
         const rclcpp::MessageInfo &)>;
 
+  using LoanedMessageROSMessageCallback =
+    std::function<void (rclcpp::SubscriptionLoanedMessage<ROSMessageType>)>;
+  using LoanedMessageWithInfoROSMessageCallback =
+    std::function<void (
+        rclcpp::SubscriptionLoanedMessage<ROSMessageType>,
+        const rclcpp::MessageInfo &)>;
+  using LazyMessageROSMessageCallback =
+    std::function<void (rclcpp::LazyMessage<ROSMessageType>)>;
+  using LazyMessageWithInfoROSMessageCallback =
+    std::function<void (rclcpp::LazyMessage<ROSMessageType>, const rclcpp::MessageInfo &)>;
+
   // Deprecated signatures:
   using SharedPtrCallback =
     std::function<void (std::shared_ptr<SubscribedType>)>;
@@ -188,7 +202,11 @@ struct AnySubscriptionCallbackHelper<MessageT, AllocatorT, false>
     typename CallbackTypes::SharedPtrCallback,
     typename CallbackTypes::SharedPtrWithInfoCallback,
     typename CallbackTypes::SharedPtrSerializedMessageCallback,
-    typename CallbackTypes::SharedPtrSerializedMessageWithInfoCallback
+    typename CallbackTypes::SharedPtrSerializedMessageWithInfoCallback,
+    typename CallbackTypes::LoanedMessageROSMessageCallback,
+    typename CallbackTypes::LoanedMessageWithInfoROSMessageCallback,
+    typename CallbackTypes::LazyMessageROSMessageCallback,
+    typename CallbackTypes::LazyMessageWithInfoROSMessageCallback
   >;
 };
 
@@ -228,7 +246,11 @@ struct AnySubscriptionCallbackHelper<MessageT, AllocatorT, true>
     typename CallbackTypes::SharedPtrWithInfoCallback,
     typename CallbackTypes::SharedPtrWithInfoROSMessageCallback,
     typename CallbackTypes::SharedPtrSerializedMessageCallback,
-    typename CallbackTypes::SharedPtrSerializedMessageWithInfoCallback
+    typename CallbackTypes::SharedPtrSerializedMessageWithInfoCallback,
+    typename CallbackTypes::LoanedMessageROSMessageCallback,
+    typename CallbackTypes::LoanedMessageWithInfoROSMessageCallback,
+    typename CallbackTypes::LazyMessageROSMessageCallback,
+    typename CallbackTypes::LazyMessageWithInfoROSMessageCallback
   >;
 };
 
@@ -329,6 +351,14 @@ private:
     typename CallbackTypes::SharedPtrSerializedMessageCallback;
   using SharedPtrSerializedMessageWithInfoCallback =
     typename CallbackTypes::SharedPtrSerializedMessageWithInfoCallback;
+  using LoanedMessageROSMessageCallback =
+    typename CallbackTypes::LoanedMessageROSMessageCallback;
+  using LoanedMessageWithInfoROSMessageCallback =
+    typename CallbackTypes::LoanedMessageWithInfoROSMessageCallback;
+  using LazyMessageROSMessageCallback =
+    typename CallbackTypes::LazyMessageROSMessageCallback;
+  using LazyMessageWithInfoROSMessageCallback =
+    typename CallbackTypes::LazyMessageWithInfoROSMessageCallback;
 
   template<typename T>
   struct NotNull
@@ -476,6 +506,21 @@ public:
     }
   }
 
+  std::unique_ptr<ROSMessageType, ROSMessageTypeDeleter>
+  convert_custom_type_to_ros_message_unique_ptr(const SubscribedType & msg)
+  {
+    if constexpr (rclcpp::TypeAdapter<MessageT>::is_specialized::value) {
+      auto ptr = ROSMessageTypeAllocatorTraits::allocate(ros_message_type_allocator_, 1);
+      ROSMessageTypeAllocatorTraits::construct(ros_message_type_allocator_, ptr);
+      rclcpp::TypeAdapter<MessageT>::convert_to_ros_message(msg, *ptr);
+      return std::unique_ptr<ROSMessageType, ROSMessageTypeDeleter>(ptr, ros_message_type_deleter_);
+    } else {
+      throw std::runtime_error(
+              "convert_custom_type_to_ros_message_unique_ptr "
+              "unexpectedly called without TypeAdapter");
+    }
+  }
+
   // Dispatch when input is a ros message and the output could be anything.
   void
   dispatch(
@@ -483,6 +528,7 @@ public:
     const rclcpp::MessageInfo & message_info)
   {
     TRACEPOINT(callback_start, static_cast<const void *>(this), false);
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackStart, this, 0, false);
     // Check if the variant is "unset", throw if it is.
     if (callback_variant_.index() == 0) {
       if (std::get<0>(callback_variant_) == nullptr) {
@@ -550,6 +596,21 @@ public:
           std::is_same_v<T, SharedPtrWithInfoROSMessageCallback>)
         {
           callback(message, message_info);
+        } else if constexpr (std::is_same_v<T, LoanedMessageROSMessageCallback>) {
+          callback(rclcpp::SubscriptionLoanedMessage<ROSMessageType>(std::move(message)));
+        } else if constexpr (std::is_same_v<T, LoanedMessageWithInfoROSMessageCallback>) {
+          callback(
+            rclcpp::SubscriptionLoanedMessage<ROSMessageType>(std::move(message)),
+            message_info);
+        } else if constexpr (std::is_same_v<T, LazyMessageROSMessageCallback>) {
+          callback(
+            rclcpp::LazyMessage<ROSMessageType>(
+              std::shared_ptr<const ROSMessageType>(std::move(message))));
+        } else if constexpr (std::is_same_v<T, LazyMessageWithInfoROSMessageCallback>) {
+          callback(
+            rclcpp::LazyMessage<ROSMessageType>(
+              std::shared_ptr<const ROSMessageType>(std::move(message))),
+            message_info);
         }
         // condition to catch SerializedMessage types
         else if constexpr (  // NOLINT[readability/braces]
@@ -574,6 +635,7 @@ public:
         }
       }, callback_variant_);
     TRACEPOINT(callback_end, static_cast<const void *>(this));
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackEnd, this, 0, 0);
   }
 
   // Dispatch when input is a serialized message and the output could be anything.
@@ -583,6 +645,7 @@ public:
     const rclcpp::MessageInfo & message_info)
   {
     TRACEPOINT(callback_start, static_cast<const void *>(this), false);
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackStart, this, 0, false);
     // Check if the variant is "unset", throw if it is.
     if (callback_variant_.index() == 0) {
       if (std::get<0>(callback_variant_) == nullptr) {
@@ -621,6 +684,12 @@ public:
             create_serialized_message_unique_ptr_from_shared_ptr(serialized_message),
             message_info);
         }
+        // conditions for output deserialized on demand
+        else if constexpr (std::is_same_v<T, LazyMessageROSMessageCallback>) {  // NOLINT
+          callback(rclcpp::LazyMessage<ROSMessageType>(serialized_message));
+        } else if constexpr (std::is_same_v<T, LazyMessageWithInfoROSMessageCallback>) {
+          callback(rclcpp::LazyMessage<ROSMessageType>(serialized_message), message_info);
+        }
         // conditions for output anything else
         else if constexpr (  // NOLINT[whitespace/newline]
           std::is_same_v<T, ConstRefCallback>||
@@ -642,7 +711,9 @@ public:
           std::is_same_v<T, SharedPtrCallback>||
           std::is_same_v<T, SharedPtrROSMessageCallback>||
           std::is_same_v<T, SharedPtrWithInfoCallback>||
-          std::is_same_v<T, SharedPtrWithInfoROSMessageCallback>)
+          std::is_same_v<T, SharedPtrWithInfoROSMessageCallback>||
+          std::is_same_v<T, LoanedMessageROSMessageCallback>||
+          std::is_same_v<T, LoanedMessageWithInfoROSMessageCallback>)
         {
           throw std::runtime_error(
             "cannot dispatch rclcpp::SerializedMessage to "
@@ -654,6 +725,7 @@ public:
         }
       }, callback_variant_);
     TRACEPOINT(callback_end, static_cast<const void *>(this));
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackEnd, this, 0, 0);
   }
 
   void
@@ -662,6 +734,7 @@ public:
     const rclcpp::MessageInfo & message_info)
   {
     TRACEPOINT(callback_start, static_cast<const void *>(this), true);
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackStart, this, 0, true);
     // Check if the variant is "unset", throw if it is.
     if (callback_variant_.index() == 0) {
       if (std::get<0>(callback_variant_) == nullptr) {
@@ -736,6 +809,14 @@ public:
           std::is_same_v<T, ConstRefSharedConstPtrWithInfoROSMessageCallback>)
         {
           callback(message, message_info);
+        } else if constexpr (std::is_same_v<T, LoanedMessageROSMessageCallback>) {
+          callback(rclcpp::SubscriptionLoanedMessage<ROSMessageType>(message));
+        } else if constexpr (std::is_same_v<T, LoanedMessageWithInfoROSMessageCallback>) {
+          callback(rclcpp::SubscriptionLoanedMessage<ROSMessageType>(message), message_info);
+        } else if constexpr (std::is_same_v<T, LazyMessageROSMessageCallback>) {
+          callback(rclcpp::LazyMessage<ROSMessageType>(message));
+        } else if constexpr (std::is_same_v<T, LazyMessageWithInfoROSMessageCallback>) {
+          callback(rclcpp::LazyMessage<ROSMessageType>(message), message_info);
         }
         // condition to catch SerializedMessage types
         else if constexpr (  // NOLINT[readability/braces]
@@ -760,6 +841,7 @@ public:
         }
       }, callback_variant_);
     TRACEPOINT(callback_end, static_cast<const void *>(this));
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackEnd, this, 0, 0);
   }
 
   void
@@ -768,6 +850,7 @@ public:
     const rclcpp::MessageInfo & message_info)
   {
     TRACEPOINT(callback_start, static_cast<const void *>(this), true);
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackStart, this, 0, true);
     // Check if the variant is "unset", throw if it is.
     if (callback_variant_.index() == 0) {
       if (std::get<0>(callback_variant_) == nullptr) {
@@ -842,6 +925,24 @@ public:
           std::is_same_v<T, ConstRefSharedConstPtrWithInfoROSMessageCallback>)
         {
           callback(std::move(message), message_info);
+        } else if constexpr (std::is_same_v<T, LoanedMessageROSMessageCallback>) {
+          callback(
+            rclcpp::SubscriptionLoanedMessage<ROSMessageType>(
+              std::shared_ptr<const ROSMessageType>(std::move(message))));
+        } else if constexpr (std::is_same_v<T, LoanedMessageWithInfoROSMessageCallback>) {
+          callback(
+            rclcpp::SubscriptionLoanedMessage<ROSMessageType>(
+              std::shared_ptr<const ROSMessageType>(std::move(message))),
+            message_info);
+        } else if constexpr (std::is_same_v<T, LazyMessageROSMessageCallback>) {
+          callback(
+            rclcpp::LazyMessage<ROSMessageType>(
+              std::shared_ptr<const ROSMessageType>(std::move(message))));
+        } else if constexpr (std::is_same_v<T, LazyMessageWithInfoROSMessageCallback>) {
+          callback(
+            rclcpp::LazyMessage<ROSMessageType>(
+              std::shared_ptr<const ROSMessageType>(std::move(message))),
+            message_info);
         }
         // condition to catch SerializedMessage types
         else if constexpr (  // NOLINT[readability/braces]
@@ -866,6 +967,122 @@ public:
         }
       }, callback_variant_);
     TRACEPOINT(callback_end, static_cast<const void *>(this));
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackEnd, this, 0, 0);
+  }
+
+  /// Dispatch a message of the custom type of a TypeAdapter, shared intra process.
+  template<typename T = SubscribedType>
+  std::enable_if_t<
+    rclcpp::TypeAdapter<MessageT>::is_specialized::value && std::is_same_v<T, SubscribedType>
+  >
+  dispatch_intra_process(
+    std::shared_ptr<const T> message,
+    const rclcpp::MessageInfo & message_info)
+  {
+    dispatch_intra_process_custom_type(std::move(message), nullptr, message_info);
+  }
+
+  /// Dispatch a message of the custom type of a TypeAdapter, owned by this subscription.
+  template<typename T = SubscribedType>
+  std::enable_if_t<
+    rclcpp::TypeAdapter<MessageT>::is_specialized::value && std::is_same_v<T, SubscribedType>
+  >
+  dispatch_intra_process(
+    std::unique_ptr<T, SubscribedTypeDeleter> message,
+    const rclcpp::MessageInfo & message_info)
+  {
+    dispatch_intra_process_custom_type(nullptr, std::move(message), message_info);
+  }
+
+  /// Dispatch a message loaned by the middleware, to a callback taking the loan.
+  /**
+   * \throws std::runtime_error if the callback does not take a SubscriptionLoanedMessage,
+   *   \sa is_loaned_message_callback()
+   */
+  void
+  dispatch_loaned_message(
+    rclcpp::SubscriptionLoanedMessage<ROSMessageType> message,
+    const rclcpp::MessageInfo & message_info)
+  {
+    TRACEPOINT(callback_start, static_cast<const void *>(this), false);
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackStart, this, 0, false);
+    if (auto callback = std::get_if<LoanedMessageROSMessageCallback>(&callback_variant_)) {
+      (*callback)(std::move(message));
+    } else if (  // NOLINT[readability/braces]
+      auto callback_with_info =
+      std::get_if<LoanedMessageWithInfoROSMessageCallback>(&callback_variant_))
+    {
+      (*callback_with_info)(std::move(message), message_info);
+    } else {
+      throw std::runtime_error(
+              "cannot dispatch a loaned message to a callback which does not take "
+              "rclcpp::SubscriptionLoanedMessage");
+    }
+    TRACEPOINT(callback_end, static_cast<const void *>(this));
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackEnd, this, 0, 0);
+  }
+
+  constexpr
+  bool
+  is_loaned_message_callback() const
+  {
+    return
+      std::holds_alternative<LoanedMessageROSMessageCallback>(callback_variant_) ||
+      std::holds_alternative<LoanedMessageWithInfoROSMessageCallback>(callback_variant_);
+  }
+
+  /// Whether the callback takes ownership of the messages, which must be copied if shared.
+  constexpr
+  bool
+  takes_message_ownership() const
+  {
+    bool takes_ros_message_ownership =
+      std::holds_alternative<UniquePtrROSMessageCallback>(callback_variant_) ||
+      std::holds_alternative<UniquePtrWithInfoROSMessageCallback>(callback_variant_) ||
+      std::holds_alternative<SharedPtrROSMessageCallback>(callback_variant_) ||
+      std::holds_alternative<SharedPtrWithInfoROSMessageCallback>(callback_variant_);
+    if constexpr (rclcpp::TypeAdapter<MessageT>::is_specialized::value) {
+      return
+        takes_ros_message_ownership ||
+        std::holds_alternative<UniquePtrCallback>(callback_variant_) ||
+        std::holds_alternative<UniquePtrWithInfoCallback>(callback_variant_) ||
+        std::holds_alternative<SharedPtrCallback>(callback_variant_) ||
+        std::holds_alternative<SharedPtrWithInfoCallback>(callback_variant_);
+    } else {
+      return takes_ros_message_ownership;
+    }
+  }
+
+  /// Whether the callback takes the custom type of a TypeAdapter, rather than its ROS message.
+  constexpr
+  bool
+  is_custom_type_callback() const
+  {
+    if constexpr (rclcpp::TypeAdapter<MessageT>::is_specialized::value) {
+      return
+        std::holds_alternative<ConstRefCallback>(callback_variant_) ||
+        std::holds_alternative<ConstRefWithInfoCallback>(callback_variant_) ||
+        std::holds_alternative<UniquePtrCallback>(callback_variant_) ||
+        std::holds_alternative<UniquePtrWithInfoCallback>(callback_variant_) ||
+        std::holds_alternative<SharedConstPtrCallback>(callback_variant_) ||
+        std::holds_alternative<SharedConstPtrWithInfoCallback>(callback_variant_) ||
+        std::holds_alternative<ConstRefSharedConstPtrCallback>(callback_variant_) ||
+        std::holds_alternative<ConstRefSharedConstPtrWithInfoCallback>(callback_variant_) ||
+        std::holds_alternative<SharedPtrCallback>(callback_variant_) ||
+        std::holds_alternative<SharedPtrWithInfoCallback>(callback_variant_);
+    } else {
+      return false;
+    }
+  }
+
+  /// Whether the callback takes the messages serialized, deserializing them on access.
+  constexpr
+  bool
+  is_lazy_message_callback() const
+  {
+    return
+      std::holds_alternative<LazyMessageROSMessageCallback>(callback_variant_) ||
+      std::holds_alternative<LazyMessageWithInfoROSMessageCallback>(callback_variant_);
   }
 
   constexpr
@@ -873,6 +1090,8 @@ public:
   use_take_shared_method() const
   {
     return
+      is_loaned_message_callback() ||
+      is_lazy_message_callback() ||
       std::holds_alternative<SharedConstPtrCallback>(callback_variant_) ||
       std::holds_alternative<SharedConstPtrWithInfoCallback>(callback_variant_) ||
       std::holds_alternative<ConstRefSharedConstPtrCallback>(callback_variant_) ||
@@ -888,7 +1107,8 @@ public:
       std::holds_alternative<UniquePtrSerializedMessageCallback>(callback_variant_) ||
       std::holds_alternative<SharedConstPtrSerializedMessageCallback>(callback_variant_) ||
       std::holds_alternative<ConstRefSharedConstPtrSerializedMessageCallback>(callback_variant_) ||
-      std::holds_alternative<SharedPtrSerializedMessageCallback>(callback_variant_);
+      std::holds_alternative<SharedPtrSerializedMessageCallback>(callback_variant_) ||
+      is_lazy_message_callback();
   }
 
   void
@@ -918,6 +1138,135 @@ public:
   }
 
 private:
+  /// Dispatch a message of the custom type, either shared or owned, received intra process.
+  void
+  dispatch_intra_process_custom_type(
+    std::shared_ptr<const SubscribedType> shared_message,
+    std::unique_ptr<SubscribedType, SubscribedTypeDeleter> unique_message,
+    const rclcpp::MessageInfo & message_info)
+  {
+    TRACEPOINT(callback_start, static_cast<const void *>(this), true);
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackStart, this, 0, true);
+    // Check if the variant is "unset", throw if it is.
+    if (callback_variant_.index() == 0) {
+      if (std::get<0>(callback_variant_) == nullptr) {
+        // This can happen if it is default initialized, or if it is assigned nullptr.
+        throw std::runtime_error("dispatch called on an unset AnySubscriptionCallback");
+      }
+    }
+    const SubscribedType & message = shared_message ? *shared_message : *unique_message;
+    auto take_unique_message = [&shared_message, &unique_message, this]() {
+        if (unique_message) {
+          return std::move(unique_message);
+        }
+        return create_custom_unique_ptr_from_custom_shared_ptr_message(shared_message);
+      };
+    auto take_shared_message = [&shared_message, &unique_message]() {
+        if (shared_message) {
+          return std::move(shared_message);
+        }
+        return std::shared_ptr<const SubscribedType>(std::move(unique_message));
+      };
+    // Dispatch.
+    std::visit(
+      [&message, &message_info, &take_unique_message, &take_shared_message, this](
+        auto && callback)
+      {
+        using T = std::decay_t<decltype(callback)>;
+
+        // conditions for custom type
+        if constexpr (std::is_same_v<T, ConstRefCallback>) {
+          callback(message);
+        } else if constexpr (std::is_same_v<T, ConstRefWithInfoCallback>) {
+          callback(message, message_info);
+        } else if constexpr (  // NOLINT[readability/braces]
+          std::is_same_v<T, UniquePtrCallback>||
+          std::is_same_v<T, SharedPtrCallback>)
+        {
+          callback(take_unique_message());
+        } else if constexpr (  // NOLINT[readability/braces]
+          std::is_same_v<T, UniquePtrWithInfoCallback>||
+          std::is_same_v<T, SharedPtrWithInfoCallback>)
+        {
+          callback(take_unique_message(), message_info);
+        } else if constexpr (  // NOLINT[readability/braces]
+          std::is_same_v<T, SharedConstPtrCallback>||
+          std::is_same_v<T, ConstRefSharedConstPtrCallback>)
+        {
+          callback(take_shared_message());
+        } else if constexpr (  // NOLINT[readability/braces]
+          std::is_same_v<T, SharedConstPtrWithInfoCallback>||
+          std::is_same_v<T, ConstRefSharedConstPtrWithInfoCallback>)
+        {
+          callback(take_shared_message(), message_info);
+        }
+        // conditions for ros message type
+        else if constexpr (std::is_same_v<T, ConstRefROSMessageCallback>) {  // NOLINT
+          callback(*convert_custom_type_to_ros_message_unique_ptr(message));
+        } else if constexpr (std::is_same_v<T, ConstRefWithInfoROSMessageCallback>) {
+          callback(*convert_custom_type_to_ros_message_unique_ptr(message), message_info);
+        } else if constexpr (  // NOLINT[readability/braces]
+          std::is_same_v<T, UniquePtrROSMessageCallback>||
+          std::is_same_v<T, SharedPtrROSMessageCallback>||
+          std::is_same_v<T, SharedConstPtrROSMessageCallback>||
+          std::is_same_v<T, ConstRefSharedConstPtrROSMessageCallback>)
+        {
+          callback(convert_custom_type_to_ros_message_unique_ptr(message));
+        } else if constexpr (  // NOLINT[readability/braces]
+          std::is_same_v<T, UniquePtrWithInfoROSMessageCallback>||
+          std::is_same_v<T, SharedPtrWithInfoROSMessageCallback>||
+          std::is_same_v<T, SharedConstPtrWithInfoROSMessageCallback>||
+          std::is_same_v<T, ConstRefSharedConstPtrWithInfoROSMessageCallback>)
+        {
+          callback(convert_custom_type_to_ros_message_unique_ptr(message), message_info);
+        } else if constexpr (std::is_same_v<T, LoanedMessageROSMessageCallback>) {
+          callback(
+            rclcpp::SubscriptionLoanedMessage<ROSMessageType>(
+              std::shared_ptr<const ROSMessageType>(
+                convert_custom_type_to_ros_message_unique_ptr(message))));
+        } else if constexpr (std::is_same_v<T, LoanedMessageWithInfoROSMessageCallback>) {
+          callback(
+            rclcpp::SubscriptionLoanedMessage<ROSMessageType>(
+              std::shared_ptr<const ROSMessageType>(
+                convert_custom_type_to_ros_message_unique_ptr(message))),
+            message_info);
+        } else if constexpr (std::is_same_v<T, LazyMessageROSMessageCallback>) {
+          callback(
+            rclcpp::LazyMessage<ROSMessageType>(
+              std::shared_ptr<const ROSMessageType>(
+                convert_custom_type_to_ros_message_unique_ptr(message))));
+        } else if constexpr (std::is_same_v<T, LazyMessageWithInfoROSMessageCallback>) {
+          callback(
+            rclcpp::LazyMessage<ROSMessageType>(
+              std::shared_ptr<const ROSMessageType>(
+                convert_custom_type_to_ros_message_unique_ptr(message))),
+            message_info);
+        }
+        // condition to catch SerializedMessage types
+        else if constexpr (  // NOLINT[readability/braces]
+          std::is_same_v<T, ConstRefSerializedMessageCallback>||
+          std::is_same_v<T, ConstRefSerializedMessageWithInfoCallback>||
+          std::is_same_v<T, UniquePtrSerializedMessageCallback>||
+          std::is_same_v<T, UniquePtrSerializedMessageWithInfoCallback>||
+          std::is_same_v<T, SharedConstPtrSerializedMessageCallback>||
+          std::is_same_v<T, SharedConstPtrSerializedMessageWithInfoCallback>||
+          std::is_same_v<T, ConstRefSharedConstPtrSerializedMessageCallback>||
+          std::is_same_v<T, ConstRefSharedConstPtrSerializedMessageWithInfoCallback>||
+          std::is_same_v<T, SharedPtrSerializedMessageCallback>||
+          std::is_same_v<T, SharedPtrSerializedMessageWithInfoCallback>)
+        {
+          throw std::runtime_error(
+            "Cannot dispatch a message of the custom type to rclcpp::SerializedMessage");
+        }
+        // condition to catch unhandled callback types
+        else {  // NOLINT[readability/braces]
+          static_assert(always_false_v<T>, "unhandled callback type");
+        }
+      }, callback_variant_);
+    TRACEPOINT(callback_end, static_cast<const void *>(this));
+    rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackEnd, this, 0, 0);
+  }
+
   // TODO(wjwwood): switch to inheriting from std::variant (i.e. HelperT::variant_type) once
   // inheriting from std::variant is realistic (maybe C++23?), see:
   //   http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2020/p2162r0.html
@@ -16,11 +16,16 @@
 #define RCLCPP__CALLBACK_GROUP_HPP_
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
 #include "rclcpp/client.hpp"
+#include "rclcpp/executor_instrumentation.hpp"
 #include "rclcpp/publisher_base.hpp"
 #include "rclcpp/service.hpp"
 #include "rclcpp/subscription_base.hpp"
@@ -46,6 +51,41 @@ enum class CallbackGroupType
   Reentrant
 };
 
+/// What an overloaded executor does with the ready entities of a callback group.
+/**
+ * See rclcpp::ExecutorOptions::overload for when an executor is overloaded.
+ */
+enum class CallbackGroupOverloadPolicy
+{
+  /// The entities are executed anyway, the default.
+  Execute,
+  /// The queued messages of the subscriptions are dropped and the timer calls are skipped.
+  /**
+   * The other entities are executed anyway, e.g. a service still responds to its requests.
+   * Combined with a priority scheduling policy, the entities which are shed are the ones of the
+   * lowest priority, since those are dispatched last.
+   */
+  Shed,
+  /// Only the latest queued message of each subscription is handled, the older ones are dropped.
+  /**
+   * The other entities are executed as usual.
+   */
+  SkipStale,
+};
+
+/// Overloaded dispatch of an entity of a callback group, see CallbackGroup::report_overload().
+struct OverloadEvent
+{
+  /// Number of entities found ready by the wait the entity was found ready by.
+  size_t ready_count = 0;
+  /// Time from the end of that wait to the dispatch, 0 if the dispatch lag is not measured.
+  std::chrono::nanoseconds dispatch_lag{0};
+  /// Policy applied to the entity.
+  CallbackGroupOverloadPolicy policy = CallbackGroupOverloadPolicy::Execute;
+  /// True if the entity was not executed.
+  bool shed = false;
+};
+
 class CallbackGroup
 {
   friend class rclcpp::node_interfaces::NodeServices;
@@ -95,39 +135,66 @@ public:
     CallbackGroupType group_type,
     bool automatically_add_to_executor_with_node = true);
 
+  /// Immutable snapshot of the entities of a callback group.
+  /**
+   * Adding or removing an entity publishes a new snapshot with a higher version, so readers
+   * iterate a snapshot without locking, and can tell from the version whether anything was
+   * added or removed since they last looked.
+   * Destroyed entities stay in the snapshot as expired weak pointers until the next change.
+   */
+  struct Entities
+  {
+    uint64_t version = 0;
+    std::vector<rclcpp::SubscriptionBase::WeakPtr> subscriptions;
+    std::vector<rclcpp::TimerBase::WeakPtr> timers;
+    std::vector<rclcpp::ServiceBase::WeakPtr> services;
+    std::vector<rclcpp::ClientBase::WeakPtr> clients;
+    std::vector<rclcpp::Waitable::WeakPtr> waitables;
+  };
+
+  /// Return the current snapshot of the entities of this callback group, without locking.
+  RCLCPP_PUBLIC
+  std::shared_ptr<const Entities>
+  get_entities() const;
+
+  /// Return the version of the entities of this callback group, see Entities.
+  RCLCPP_PUBLIC
+  uint64_t
+  get_entities_version() const;
+
   template<typename Function>
   rclcpp::SubscriptionBase::SharedPtr
   find_subscription_ptrs_if(Function func) const
   {
-    return _find_ptrs_if_impl<rclcpp::SubscriptionBase, Function>(func, subscription_ptrs_);
+    return _find_ptrs_if_impl<rclcpp::SubscriptionBase, Function>(func, &Entities::subscriptions);
   }
 
   template<typename Function>
   rclcpp::TimerBase::SharedPtr
   find_timer_ptrs_if(Function func) const
   {
-    return _find_ptrs_if_impl<rclcpp::TimerBase, Function>(func, timer_ptrs_);
+    return _find_ptrs_if_impl<rclcpp::TimerBase, Function>(func, &Entities::timers);
   }
 
   template<typename Function>
   rclcpp::ServiceBase::SharedPtr
   find_service_ptrs_if(Function func) const
   {
-    return _find_ptrs_if_impl<rclcpp::ServiceBase, Function>(func, service_ptrs_);
+    return _find_ptrs_if_impl<rclcpp::ServiceBase, Function>(func, &Entities::services);
   }
 
   template<typename Function>
   rclcpp::ClientBase::SharedPtr
   find_client_ptrs_if(Function func) const
   {
-    return _find_ptrs_if_impl<rclcpp::ClientBase, Function>(func, client_ptrs_);
+    return _find_ptrs_if_impl<rclcpp::ClientBase, Function>(func, &Entities::clients);
   }
 
   template<typename Function>
   rclcpp::Waitable::SharedPtr
   find_waitable_ptrs_if(Function func) const
   {
-    return _find_ptrs_if_impl<rclcpp::Waitable, Function>(func, waitable_ptrs_);
+    return _find_ptrs_if_impl<rclcpp::Waitable, Function>(func, &Entities::waitables);
   }
 
   RCLCPP_PUBLIC
@@ -163,6 +230,145 @@ public:
   bool
   automatically_add_to_executor_with_node() const;
 
+  /// Set the scheduling priority of the entities in this callback group.
+  /**
+   * Only executors using a priority scheduling policy, see rclcpp::ExecutorSchedulingPolicy,
+   * take the priority into account.
+   * Ready entities of a group with a higher priority are executed first.
+   *
+   * \param[in] priority the new priority, 0 by default
+   */
+  RCLCPP_PUBLIC
+  void
+  set_priority(int priority);
+
+  /// Return the scheduling priority of the entities in this callback group.
+  RCLCPP_PUBLIC
+  int
+  get_priority() const;
+
+  /// Set the scheduling weight of the entities in this callback group.
+  /**
+   * Only executors using the round robin scheduling policy, see
+   * rclcpp::ExecutorSchedulingPolicy::RoundRobin, take the weight into account.
+   * A ready entity is executed up to weight times in a row before its turn passes to the next
+   * ready entity of the same kind.
+   *
+   * \param[in] weight the new weight, 1 by default
+   * \throws std::invalid_argument if weight is 0
+   */
+  RCLCPP_PUBLIC
+  void
+  set_scheduling_weight(size_t weight);
+
+  /// Return the scheduling weight of the entities in this callback group.
+  RCLCPP_PUBLIC
+  size_t
+  get_scheduling_weight() const;
+
+  /// Enable or disable the entities in this callback group.
+  /**
+   * Executors do not wait on the entities of a disabled callback group, so these neither wake
+   * the executor nor get executed, while the callback group stays associated with the executor.
+   * Executors apply the change when they collect the entities again, which the caller can
+   * request by triggering the notify guard condition of the node of the callback group.
+   *
+   * \param[in] enabled false to disable the entities, true (the default) to enable them again
+   */
+  RCLCPP_PUBLIC
+  void
+  set_enabled(bool enabled);
+
+  /// Return true if the entities in this callback group are enabled.
+  RCLCPP_PUBLIC
+  bool
+  is_enabled() const;
+
+  /// Set the time budget of each execution of an entity in this callback group.
+  /**
+   * Executors which report their executions to an rclcpp::ExecutorInstrumentation, see
+   * rclcpp::ExecutorOptions::instrumentation, also time the executions of the entities which
+   * have a budget when they are not instrumented.
+   * An execution taking longer than its budget is counted, passed to the execution overrun
+   * callback and reported to the instrumentation of the executor, with its budget.
+   * A subscription can have its own budget, see rclcpp::SubscriptionOptionsBase::execution_budget.
+   *
+   * \param[in] budget the budget of each execution, 0 (the default) for none
+   * \throws std::invalid_argument if the budget is negative
+   */
+  RCLCPP_PUBLIC
+  void
+  set_execution_budget(std::chrono::nanoseconds budget);
+
+  /// Return the time budget of each execution of an entity in this callback group.
+  RCLCPP_PUBLIC
+  std::chrono::nanoseconds
+  get_execution_budget() const;
+
+  /// Set the callback called after each execution which overran its budget.
+  /**
+   * The callback is called by the executor thread which executed the entity, so it should
+   * return quickly, e.g. only log or count the overrun.
+   *
+   * \param[in] callback called with the measurement of the execution, nullptr to unset it
+   */
+  RCLCPP_PUBLIC
+  void
+  set_execution_overrun_callback(
+    std::function<void(const rclcpp::ExecutableExecution &)> callback);
+
+  /// Return the number of executions of the entities in this group which overran their budget.
+  RCLCPP_PUBLIC
+  uint64_t
+  get_execution_overrun_count() const;
+
+  /// Count an execution which overran its budget and call the execution overrun callback.
+  /**
+   * Called by the executors, see set_execution_budget().
+   */
+  RCLCPP_PUBLIC
+  void
+  report_execution_overrun(const rclcpp::ExecutableExecution & execution);
+
+  /// Set what an overloaded executor does with the ready entities of this callback group.
+  /**
+   * \param[in] policy the new policy, CallbackGroupOverloadPolicy::Execute by default
+   */
+  RCLCPP_PUBLIC
+  void
+  set_overload_policy(CallbackGroupOverloadPolicy policy);
+
+  /// Return what an overloaded executor does with the ready entities of this callback group.
+  RCLCPP_PUBLIC
+  CallbackGroupOverloadPolicy
+  get_overload_policy() const;
+
+  /// Set the callback called for each overloaded dispatch of an entity in this callback group.
+  /**
+   * It lets the producers of the work be signaled, e.g. asked to publish less often, while the
+   * executor does not keep up with it, whatever the overload policy.
+   * The callback is called by the executor thread which dispatched the entity, before its
+   * execution, so it should return quickly.
+   *
+   * \param[in] callback called with the overloaded dispatch, nullptr to unset it
+   */
+  RCLCPP_PUBLIC
+  void
+  set_backpressure_callback(std::function<void(const rclcpp::OverloadEvent &)> callback);
+
+  /// Return the number of executions of the entities in this group which were shed.
+  RCLCPP_PUBLIC
+  uint64_t
+  get_shed_count() const;
+
+  /// Count an overloaded dispatch which was shed and call the backpressure callback.
+  /**
+   * Called by the executors, see set_overload_policy().
+   */
+  RCLCPP_PUBLIC
+  void
+  report_overload(const rclcpp::OverloadEvent & event);
+
 protected:
   RCLCPP_DISABLE_COPY(CallbackGroup)
 
@@ -194,25 +400,39 @@ protected:
   void
   remove_waitable(const rclcpp::Waitable::SharedPtr waitable_ptr) noexcept;
 
+  /// Publish a copy of the entities modified by the given function, with the next version.
+  RCLCPP_PUBLIC
+  void
+  update_entities(const std::function<void(Entities &)> & modify);
+
   CallbackGroupType type_;
-  // Mutex to protect the subsequent vectors of pointers.
+  // Mutex serializing the updates of the entities, readers do not take it.
   mutable std::mutex mutex_;
   std::atomic_bool associated_with_executor_;
-  std::vector<rclcpp::SubscriptionBase::WeakPtr> subscription_ptrs_;
-  std::vector<rclcpp::TimerBase::WeakPtr> timer_ptrs_;
-  std::vector<rclcpp::ServiceBase::WeakPtr> service_ptrs_;
-  std::vector<rclcpp::ClientBase::WeakPtr> client_ptrs_;
-  std::vector<rclcpp::Waitable::WeakPtr> waitable_ptrs_;
+  // Current snapshot of the entities, accessed with the std::atomic_load/store overloads.
+  std::shared_ptr<const Entities> entities_;
   std::atomic_bool can_be_taken_from_;
   const bool automatically_add_to_executor_with_node_;
+  std::atomic_int priority_;
+  std::atomic<size_t> scheduling_weight_;
+  std::atomic_bool enabled_;
+  std::atomic<int64_t> execution_budget_ns_;
+  std::atomic<uint64_t> execution_overrun_count_;
+  std::mutex execution_overrun_callback_mutex_;
+  std::function<void(const rclcpp::ExecutableExecution &)> execution_overrun_callback_;
+  std::atomic<CallbackGroupOverloadPolicy> overload_policy_;
+  std::atomic<uint64_t> shed_count_;
+  std::mutex backpressure_callback_mutex_;
+  std::function<void(const rclcpp::OverloadEvent &)> backpressure_callback_;
 
 private:
   template<typename TypeT, typename Function>
   typename TypeT::SharedPtr _find_ptrs_if_impl(
-    Function func, const std::vector<typename TypeT::WeakPtr> & vect_ptrs) const
+    Function func, std::vector<typename TypeT::WeakPtr> Entities::* vect_ptrs) const
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (auto & weak_ptr : vect_ptrs) {
+    // Iterate the current snapshot, entities added meanwhile are in the next one.
+    const std::shared_ptr<const Entities> entities = get_entities();
+    for (auto & weak_ptr : (*entities).*vect_ptrs) {
       auto ref_ptr = weak_ptr.lock();
       if (ref_ptr && func(ref_ptr)) {
         return ref_ptr;
@@ -16,9 +16,10 @@
 #define RCLCPP__CLIENT_HPP_
 
 #include <atomic>
+#include <functional>
 #include <future>
-#include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <optional>  // NOLINT, cpplint doesn't think this is a cpp std header
 #include <sstream>
 #include <string>
@@ -29,9 +30,16 @@
 
 #include "rcl/client.h"
 #include "rcl/error_handling.h"
+#include "rcl/event_callback.h"
 #include "rcl/wait.h"
 
+#include "rclcpp/detail/inplace_function.hpp"
+#include "rclcpp/detail/pending_requests_table.hpp"
+#include "rclcpp/detail/service_message_pool.hpp"
+#include "rclcpp/detail/service_response_cache.hpp"
 #include "rclcpp/exceptions.hpp"
+#include "rclcpp/experimental/service_intra_process.hpp"
+#include "rclcpp/experimental/service_intra_process_base.hpp"
 #include "rclcpp/function_traits.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/node_interfaces/node_graph_interface.hpp"
@@ -115,6 +123,11 @@ namespace node_interfaces
 class NodeBaseInterface;
 }  // namespace node_interfaces
 
+namespace experimental
+{
+class IntraProcessManager;
+}  // namespace experimental
+
 class ClientBase
 {
 public:
@@ -215,9 +228,67 @@ public:
   bool
   exchange_in_use_by_wait_set_state(bool in_use_state);
 
+  /// Set a callback to be called when each new response is received.
+  /**
+   * The callback receives a size_t which is the number of responses received
+   * since the last time this callback was called.
+   * Normally this is 1, but can be > 1 if responses were received before any
+   * callback was set.
+   *
+   * Since this callback is called from the middleware, you should aim to make
+   * it fast and not blocking.
+   * If you need to do a lot of work or wait for some other event, you should
+   * spin it off to another thread, otherwise you risk blocking the middleware.
+   *
+   * Calling it again will clear any previously set callback.
+   *
+   * This function is thread-safe.
+   *
+   * \sa rmw_client_set_on_new_response_callback
+   * \sa rcl_client_set_on_new_response_callback
+   *
+   * \param[in] callback functor to be called when a new response is received
+   * \throws std::invalid_argument if the callback is empty
+   */
+  RCLCPP_PUBLIC
+  void
+  set_on_new_response_callback(std::function<void(size_t)> callback);
+
+  /// Unset the callback registered for new responses, if any.
+  RCLCPP_PUBLIC
+  void
+  clear_on_new_response_callback();
+
+  /// Send the requests intra process to the services of the same context.
+  /**
+   * It is called by rclcpp::create_client() when intra process communication is enabled for
+   * the node.
+   */
+  RCLCPP_PUBLIC
+  void
+  setup_intra_process();
+
 protected:
   RCLCPP_DISABLE_COPY(ClientBase)
 
+  /// Return the service receiving the requests intra process, if any.
+  /**
+   * \return the ServiceIntraProcess of a service of the same context with the name of this
+   *   client, or nullptr if there is none or intra process communication is disabled.
+   */
+  RCLCPP_PUBLIC
+  rclcpp::experimental::ServiceIntraProcessBase::SharedPtr
+  get_intra_process_service() const;
+
+  /// Return a new id for a request sent intra process, such ids are negative.
+  RCLCPP_PUBLIC
+  int64_t
+  get_next_intra_process_request_id();
+
+  RCLCPP_PUBLIC
+  void
+  set_on_new_response_callback(rcl_event_callback_t callback, const void * user_data);
+
   RCLCPP_PUBLIC
   bool
   wait_for_service_nanoseconds(std::chrono::nanoseconds timeout);
@@ -237,6 +308,13 @@ protected:
   std::shared_ptr<rcl_client_t> client_handle_;
 
   std::atomic<bool> in_use_by_wait_set_{false};
+
+  std::recursive_mutex callback_mutex_;
+  std::function<void(size_t)> on_new_response_callback_{nullptr};
+
+  std::weak_ptr<rclcpp::experimental::IntraProcessManager> weak_ipm_;
+  std::string intra_process_service_name_;
+  std::atomic<int64_t> next_intra_process_request_id_{-1};
 };
 
 template<typename ServiceT>
@@ -261,6 +339,8 @@ public:
 
   using CallbackType = std::function<void (SharedFuture)>;
   using CallbackWithRequestType = std::function<void (SharedFutureWithRequest)>;
+  /// Callback called with the response only, stored in place in the pending requests.
+  using ResponseCallbackType = rclcpp::detail::InplaceFunction<void (SharedResponse)>;
 
   RCLCPP_SMART_PTR_DEFINITIONS(Client)
 
@@ -394,9 +474,52 @@ public:
   std::shared_ptr<void>
   create_response() override
   {
+    auto response_pool = std::atomic_load(&response_pool_);
+    if (response_pool) {
+      return response_pool->acquire();
+    }
     return std::shared_ptr<void>(new typename ServiceT::Response());
   }
 
+  /// Reuse the requests and the responses of the client, instead of allocating them.
+  /**
+   * The responses are taken into messages of a pool, and borrow_request() hands out the
+   * messages of another pool, each keeping up to capacity messages, see
+   * rclcpp::detail::ServiceMessagePool.
+   * A message goes back to its pool once it is released, e.g. when the future holding a
+   * response is destroyed.
+   *
+   * It can be called at any time, the messages in use are given back to the previous pools.
+   *
+   * \param[in] capacity number of messages kept by each pool, 0 disables the pools.
+   */
+  void
+  set_message_pool_capacity(size_t capacity)
+  {
+    std::shared_ptr<RequestPool> request_pool;
+    std::shared_ptr<ResponsePool> response_pool;
+    if (capacity > 0) {
+      request_pool = RequestPool::make_shared(capacity);
+      response_pool = ResponsePool::make_shared(capacity);
+    }
+    std::atomic_store(&request_pool_, std::move(request_pool));
+    std::atomic_store(&response_pool_, std::move(response_pool));
+  }
+
+  /// Return a request to be given to async_send_request().
+  /**
+   * It is taken from the pool of the client, if set_message_pool_capacity() enabled it.
+   */
+  SharedRequest
+  borrow_request()
+  {
+    auto request_pool = std::atomic_load(&request_pool_);
+    if (request_pool) {
+      return request_pool->acquire();
+    }
+    return std::make_shared<Request>();
+  }
+
   /// Create a shared pointer with a rmw_request_id_t
   /**
    * \return shared pointer with a rmw_request_id_t
@@ -427,6 +550,10 @@ public:
     auto & value = *optional_pending_request;
     auto typed_response = std::static_pointer_cast<typename ServiceT::Response>(
       std::move(response));
+    auto response_cache = std::atomic_load(&response_cache_);
+    if (response_cache) {
+      response_cache->complete(request_header->sequence_number, typed_response);
+    }
     if (std::holds_alternative<Promise>(value)) {
       auto & promise = std::get<Promise>(value);
       promise.set_value(std::move(typed_response));
@@ -445,6 +572,9 @@ public:
       auto & request = std::get<SharedRequest>(inner);
       promise.set_value(std::make_pair(std::move(request), std::move(typed_response)));
       callback(std::move(future));
+    } else if (std::holds_alternative<ResponseCallbackType>(value)) {
+      const auto & callback = std::get<ResponseCallbackType>(value);
+      callback(std::move(typed_response));
     }
   }
 
@@ -473,17 +603,57 @@ public:
    * }
    * ```
    *
+   * If intra process communication is enabled and a service of the same context has the name
+   * of this client, the request is given to it as is, without being serialized, and the future
+   * completes with the response given by the service callback.
+   * The request must then not be modified until the future completes.
+   * Such a request is not pending in the client, it has a negative request id, and its future
+   * completes with a std::future_error if the service is destroyed before responding.
+   *
+   * If the response cache is enabled, see enable_response_cache(), and a response to an equal
+   * request is cached, the future is completed before being returned and the request id is 0.
+   *
    * \param[in] request request to be send.
    * \return a FutureAndRequestId instance.
    */
   FutureAndRequestId
   async_send_request(SharedRequest request)
   {
+    std::string cache_key;
+    auto cached_response = find_cached_response(*request, cache_key);
+    if (cached_response) {
+      Promise promise;
+      promise.set_value(std::move(cached_response));
+      return FutureAndRequestId(promise.get_future(), 0);
+    }
+
+    auto intra_process_service = std::dynamic_pointer_cast<
+      rclcpp::experimental::ServiceIntraProcess<ServiceT>>(this->get_intra_process_service());
+    if (intra_process_service) {
+      auto shared_promise = std::make_shared<Promise>();
+      auto future = shared_promise->get_future();
+      const int64_t req_id = this->get_next_intra_process_request_id();
+      auto response_cache = std::atomic_load(&response_cache_);
+      if (response_cache && !cache_key.empty()) {
+        response_cache->add_pending(req_id, std::move(cache_key));
+      }
+      intra_process_service->send_request(
+        std::move(request),
+        [shared_promise, response_cache, req_id](SharedResponse response) {
+          if (response_cache) {
+            response_cache->complete(req_id, response);
+          }
+          shared_promise->set_value(std::move(response));
+        });
+      return FutureAndRequestId(std::move(future), req_id);
+    }
+
     Promise promise;
     auto future = promise.get_future();
     auto req_id = async_send_request_impl(
       *request,
-      std::move(promise));
+      std::move(promise),
+      std::move(cache_key));
     return FutureAndRequestId(std::move(future), req_id);
   }
 
@@ -498,6 +668,9 @@ public:
    * In this case, it's convenient to setup a timer to cleanup the pending requests.
    * See for example the `examples_rclcpp_async_client` package in https://github.com/ros2/examples.
    *
+   * If a response to an equal request is cached, see enable_response_cache(), the callback is
+   * called with it before returning, and the request id is 0.
+   *
    * \param[in] request request to be send.
    * \param[in] cb callback that will be called when we get a response for this request.
    * \return the request id representing the request just sent.
@@ -516,18 +689,27 @@ public:
   {
     Promise promise;
     auto shared_future = promise.get_future().share();
+    std::string cache_key;
+    auto cached_response = find_cached_response(*request, cache_key);
+    if (cached_response) {
+      promise.set_value(std::move(cached_response));
+      cb(shared_future);
+      return SharedFutureAndRequestId{std::move(shared_future), 0};
+    }
     auto req_id = async_send_request_impl(
       *request,
       std::make_tuple(
         CallbackType{std::forward<CallbackT>(cb)},
         shared_future,
-        std::move(promise)));
+        std::move(promise)),
+      std::move(cache_key));
     return SharedFutureAndRequestId{std::move(shared_future), req_id};
   }
 
   /// Send a request to the service server and schedule a callback in the executor.
   /**
    * Similar to the previous method, but you can get both the request and response in the callback.
+   * Cache hits are handled as by the previous method.
    *
    * \param[in] request request to be send.
    * \param[in] cb callback that will be called when we get a response for this request.
@@ -547,16 +729,104 @@ public:
   {
     PromiseWithRequest promise;
     auto shared_future = promise.get_future().share();
+    std::string cache_key;
+    auto cached_response = find_cached_response(*request, cache_key);
+    if (cached_response) {
+      promise.set_value(std::make_pair(std::move(request), std::move(cached_response)));
+      cb(shared_future);
+      return SharedFutureWithRequestAndRequestId{std::move(shared_future), 0};
+    }
     auto req_id = async_send_request_impl(
       *request,
       std::make_tuple(
         CallbackWithRequestType{std::forward<CallbackT>(cb)},
         request,
         shared_future,
-        std::move(promise)));
+        std::move(promise)),
+      std::move(cache_key));
     return SharedFutureWithRequestAndRequestId{std::move(shared_future), req_id};
   }
 
+  /// Send a request to the service server and schedule a callback called with the response.
+  /**
+   * Unlike the previous overloads, no promise nor future is created: the callback is stored in
+   * place in the pending requests, so sending a request does not allocate in the client for
+   * callables which fit in a ResponseCallbackType, e.g. a lambda capturing a few pointers.
+   * Larger callables are rejected at compile time.
+   *
+   * The pending request must be cleaned up as for the previous overloads if no response is
+   * received, see remove_pending_request() and prune_pending_requests().
+   * Cache hits are handled as by the previous overloads.
+   *
+   * \param[in] request request to be send.
+   * \param[in] cb callback that will be called with the response to this request.
+   * \return the request id representing the request just sent.
+   */
+  template<
+    typename CallbackT,
+    typename std::enable_if<
+      rclcpp::function_traits::same_arguments<
+        CallbackT,
+        ResponseCallbackType
+      >::value
+    >::type * = nullptr
+  >
+  int64_t
+  async_send_request(SharedRequest request, CallbackT && cb)
+  {
+    std::string cache_key;
+    auto cached_response = find_cached_response(*request, cache_key);
+    if (cached_response) {
+      cb(std::move(cached_response));
+      return 0;
+    }
+    return async_send_request_impl(
+      *request,
+      ResponseCallbackType{std::forward<CallbackT>(cb)},
+      std::move(cache_key));
+  }
+
+  /// Answer the requests equal to a previous one with its response, for a time to live.
+  /**
+   * This is meant for idempotent services, e.g. read-only lookups made repeatedly with the same
+   * request: a request equal to one whose response was received less than time_to_live ago
+   * is not sent, the overloads of async_send_request() complete it with the cached response
+   * before returning, with the request id 0.
+   * The requests are compared by their serialized form.
+   * The cached responses are shared by all the requests they answer, so they must not be
+   * modified.
+   *
+   * The cache can be dropped with invalidate_response_cache(), e.g. from the callback of a
+   * subscription to a topic notifying the changes of the data of the service.
+   * Enabling the cache again drops it as well.
+   *
+   * \param[in] time_to_live duration for which a response is reused.
+   * \param[in] max_entries number of responses kept.
+   */
+  void
+  enable_response_cache(std::chrono::nanoseconds time_to_live, size_t max_entries = 100)
+  {
+    std::atomic_store(
+      &response_cache_, ResponseCache::make_shared(time_to_live, max_entries));
+  }
+
+  /// Stop caching the responses, and drop the cached ones.
+  void
+  disable_response_cache()
+  {
+    std::atomic_store(&response_cache_, std::shared_ptr<ResponseCache>());
+  }
+
+  /// Drop the cached responses, and the ones of the requests in flight, as they may be outdated.
+  void
+  invalidate_response_cache()
+  {
+    auto response_cache = std::atomic_load(&response_cache_);
+    if (response_cache) {
+      response_cache->clear();
+    }
+  }
+
   /// Cleanup a pending request.
   /**
    * This notifies the client that we have waited long enough for a response from the server
@@ -572,7 +842,11 @@ public:
   remove_pending_request(int64_t request_id)
   {
     std::lock_guard guard(pending_requests_mutex_);
-    return pending_requests_.erase(request_id) != 0u;
+    auto response_cache = std::atomic_load(&response_cache_);
+    if (response_cache) {
+      response_cache->remove_pending(request_id);
+    }
+    return pending_requests_.erase(request_id);
   }
 
   /// Cleanup a pending request.
@@ -619,6 +893,10 @@ public:
   prune_pending_requests()
   {
     std::lock_guard guard(pending_requests_mutex_);
+    auto response_cache = std::atomic_load(&response_cache_);
+    if (response_cache) {
+      response_cache->clear_pending();
+    }
     auto ret = pending_requests_.size();
     pending_requests_.clear();
     return ret;
@@ -638,16 +916,21 @@ public:
     std::vector<int64_t, AllocatorT> * pruned_requests = nullptr)
   {
     std::lock_guard guard(pending_requests_mutex_);
-    auto old_size = pending_requests_.size();
-    for (auto it = pending_requests_.begin(), last = pending_requests_.end(); it != last; ) {
-      if (it->second.first < time_point) {
-        pruned_requests->push_back(it->first);
-        it = pending_requests_.erase(it);
-      } else {
-        ++it;
-      }
+    auto response_cache = std::atomic_load(&response_cache_);
+    if (!response_cache) {
+      // Only the pruned requests are visited, the oldest requests are at the front of the table.
+      return pending_requests_.erase_older_than(time_point, pruned_requests);
+    }
+    std::vector<int64_t, AllocatorT> local_pruned_requests;
+    if (nullptr == pruned_requests) {
+      pruned_requests = &local_pruned_requests;
+    }
+    const size_t first_pruned = pruned_requests->size();
+    size_t ret = pending_requests_.erase_older_than(time_point, pruned_requests);
+    for (size_t i = first_pruned; i < pruned_requests->size(); ++i) {
+      response_cache->remove_pending((*pruned_requests)[i]);
     }
-    return old_size - pending_requests_.size();
+    return ret;
   }
 
 protected:
@@ -658,50 +941,72 @@ protected:
   using CallbackInfoVariant = std::variant<
     std::promise<SharedResponse>,
     CallbackTypeValueVariant,
-    CallbackWithRequestTypeValueVariant>;
+    CallbackWithRequestTypeValueVariant,
+    ResponseCallbackType>;
 
   int64_t
-  async_send_request_impl(const Request & request, CallbackInfoVariant value)
+  async_send_request_impl(
+    const Request & request, CallbackInfoVariant value, std::string cache_key = std::string())
   {
     int64_t sequence_number;
     rcl_ret_t ret = rcl_send_request(get_client_handle().get(), &request, &sequence_number);
     if (RCL_RET_OK != ret) {
       rclcpp::exceptions::throw_from_rcl_error(ret, "failed to send request");
     }
+    auto time_sent = std::chrono::system_clock::now();
     {
       std::lock_guard<std::mutex> lock(pending_requests_mutex_);
-      pending_requests_.try_emplace(
-        sequence_number,
-        std::make_pair(std::chrono::system_clock::now(), std::move(value)));
+      pending_requests_.insert(sequence_number, time_sent, std::move(value));
+      // Before the response can be handled, which takes the pending request with the lock held.
+      auto response_cache = std::atomic_load(&response_cache_);
+      if (response_cache && !cache_key.empty()) {
+        response_cache->add_pending(sequence_number, std::move(cache_key));
+      }
     }
     return sequence_number;
   }
 
+  /// Return the response cached for a request, or null.
+  /**
+   * \param[out] cache_key the key of the request if the cache is enabled, to be given to
+   *   async_send_request_impl() so that the response is cached.
+   */
+  SharedResponse
+  find_cached_response(const Request & request, std::string & cache_key)
+  {
+    auto response_cache = std::atomic_load(&response_cache_);
+    if (!response_cache) {
+      return nullptr;
+    }
+    cache_key = response_cache->make_key(request);
+    return response_cache->find(cache_key);
+  }
+
   std::optional<CallbackInfoVariant>
   get_and_erase_pending_request(int64_t request_number)
   {
     std::unique_lock<std::mutex> lock(pending_requests_mutex_);
-    auto it = this->pending_requests_.find(request_number);
-    if (it == this->pending_requests_.end()) {
+    auto value = this->pending_requests_.take(request_number);
+    if (!value) {
       RCUTILS_LOG_DEBUG_NAMED(
         "rclcpp",
         "Received invalid sequence number. Ignoring...");
-      return std::nullopt;
     }
-    auto value = std::move(it->second.second);
-    this->pending_requests_.erase(request_number);
     return value;
   }
 
   RCLCPP_DISABLE_COPY(Client)
 
-  std::unordered_map<
-    int64_t,
-    std::pair<
-      std::chrono::time_point<std::chrono::system_clock>,
-      CallbackInfoVariant>>
-  pending_requests_;
+  using RequestPool = rclcpp::detail::ServiceMessagePool<Request>;
+  using ResponsePool = rclcpp::detail::ServiceMessagePool<Response>;
+  using ResponseCache = rclcpp::detail::ServiceResponseCache<ServiceT>;
+
+  rclcpp::detail::PendingRequestsTable<CallbackInfoVariant> pending_requests_;
   std::mutex pending_requests_mutex_;
+  // Accessed with the std::atomic_load/store overloads, null unless enabled.
+  std::shared_ptr<RequestPool> request_pool_;
+  std::shared_ptr<ResponsePool> response_pool_;
+  std::shared_ptr<ResponseCache> response_cache_;
 };
 
 }  // namespace rclcpp
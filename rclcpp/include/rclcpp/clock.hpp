@@ -19,6 +19,8 @@
 #include <memory>
 #include <mutex>
 
+#include "rclcpp/contexts/default_context.hpp"
+#include "rclcpp/duration.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/time.hpp"
 #include "rclcpp/visibility_control.hpp"
@@ -71,6 +73,9 @@ public:
   /**
    * Returns current time from the time source specified by clock_type.
    *
+   * While a rclcpp::TimeSource overrides the ROS time of the clock, e.g. with simulated time,
+   * the time is read with a single atomic load, so that threads reading it do not contend.
+   *
    * \return current time.
    * \throws anything rclcpp::exceptions::throw_from_rcl_error can throw.
    */
@@ -78,6 +83,47 @@ public:
   Time
   now();
 
+  /// Sleep until a specified time, according to the clock.
+  /**
+   * For a clock of type `RCL_STEADY_TIME` or `RCL_SYSTEM_TIME`, or of type `RCL_ROS_TIME` while
+   * ROS time is not active, the thread blocks on a condition variable with the corresponding
+   * std::chrono clock.
+   * While ROS time is active, e.g. with simulated time, the thread blocks until the time source
+   * sets a time which reaches `until`, instead of polling now().
+   *
+   * The sleep is interrupted if the context is shut down, or if ROS time is activated or
+   * deactivated for the clock during the sleep.
+   * If the context is already shut down, the clock can only sleep if ROS time is not active.
+   *
+   * \param[in] until time to sleep until, of the same clock type as this clock
+   * \param[in] context the shutdown of which interrupts the sleep
+   * \return true if `until` was reached, false if the sleep was interrupted.
+   * \throws std::runtime_error if the clock type of `until` is not the type of this clock, or if
+   * the context is null.
+   * \throws anything rclcpp::exceptions::throw_from_rcl_error can throw.
+   */
+  RCLCPP_PUBLIC
+  bool
+  sleep_until(
+    Time until,
+    Context::SharedPtr context = contexts::get_global_default_context());
+
+  /// Sleep for a specified duration, according to the clock.
+  /**
+   * Equivalent to `sleep_until(now() + rel_time, context)`, see sleep_until().
+   *
+   * \param[in] rel_time duration of the sleep
+   * \param[in] context the shutdown of which interrupts the sleep
+   * \return true if the duration elapsed, false if the sleep was interrupted.
+   * \throws std::runtime_error if the context is null.
+   * \throws anything rclcpp::exceptions::throw_from_rcl_error can throw.
+   */
+  RCLCPP_PUBLIC
+  bool
+  sleep_for(
+    Duration rel_time,
+    Context::SharedPtr context = contexts::get_global_default_context());
+
   /**
    * Returns the clock of the type `RCL_ROS_TIME` is active.
    *
@@ -90,6 +136,10 @@ public:
   ros_time_is_active();
 
   /// Return the rcl_clock_t clock handle
+  /**
+   * While a rclcpp::TimeSource overrides the ROS time of the clock, the ROS time override must
+   * not be changed through the handle, since now() reads the time published by the time source.
+   */
   RCLCPP_PUBLIC
   rcl_clock_t *
   get_clock_handle() noexcept;
@@ -131,7 +181,25 @@ public:
     JumpHandler::post_callback_t post_callback,
     const rcl_jump_threshold_t & threshold);
 
+  /// Return true if any JumpHandler created by create_jump_callback() is still alive.
+  RCLCPP_PUBLIC
+  bool
+  has_jump_handlers() const noexcept;
+
 private:
+  friend TimeSource;
+
+  // Publish the ROS time override set by the time source, or its absence, for now().
+  // Called with the clock mutex locked, after the rcl clock was updated.
+  RCLCPP_PUBLIC
+  void
+  set_ros_time_override_snapshot(bool ros_time_active, rcl_time_point_value_t nanoseconds) noexcept;
+
+  // Return true if the snapshot of the ROS time override is active and has the given time.
+  RCLCPP_PUBLIC
+  bool
+  ros_time_override_snapshot_equals(rcl_time_point_value_t nanoseconds) const noexcept;
+
   // Invoke time jump callback
   RCLCPP_PUBLIC
   static void
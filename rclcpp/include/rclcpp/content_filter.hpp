@@ -0,0 +1,106 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__CONTENT_FILTER_HPP_
+#define RCLCPP__CONTENT_FILTER_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rosidl_runtime_cpp/message_type_support_decl.hpp"
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+
+/// Options of the content filter of a subscription.
+struct ContentFilterOptions
+{
+  /// Filter expression, see rclcpp::ContentFilter, empty for no filter.
+  std::string filter_expression;
+  /// Values of the parameters of the filter expression, referred to as %0, %1...
+  std::vector<std::string> expression_parameters;
+};
+
+/// Selects messages by the values of their fields, as the DDS content filtered topics do.
+/**
+ * The filter expression has the syntax of the DDS content filtered topics, e.g.
+ * "header.frame_id = 'map' AND (data > %0 OR data BETWEEN -1 AND 1)", made of:
+ * - the comparisons of a field with a value or another field, with =, <>, !=, <, <=, > and >=;
+ * - the ranges of values of a field, with BETWEEN and NOT BETWEEN;
+ * - the patterns of a string field, with LIKE and NOT LIKE, where % matches any characters and
+ *   _ any single character;
+ * - the combinations of conditions, with AND, OR, NOT and parentheses.
+ *
+ * The values are integers, floating point numbers, TRUE, FALSE, strings between single
+ * quotes, or the parameters of the expression, themselves written as such values.
+ * The fields are the primitive and string fields of the messages, which may be nested in
+ * messages but not in arrays or sequences, e.g. "header.stamp.sec".
+ * The numbers are compared as long doubles, the strings character by character.
+ *
+ * The fields are resolved once, from the introspection type support of the messages, so
+ * evaluating the filter reads them without looking them up.
+ * A filter is not modified once constructed, so it can be used by several threads.
+ */
+class ContentFilter
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(ContentFilter)
+
+  /// Constructor.
+  /**
+   * \param[in] type_support the type support of the messages, either the one of
+   *   rosidl_typesupport_introspection_cpp or one providing it, as the one of
+   *   rosidl_typesupport_cpp does.
+   * \param[in] filter_expression the filter expression.
+   * \param[in] expression_parameters the values of the parameters of the expression.
+   * \throws std::invalid_argument if the type support provides no introspection information,
+   *   or if the expression or one of its parameters is not valid.
+   */
+  RCLCPP_PUBLIC
+  ContentFilter(
+    const rosidl_message_type_support_t * type_support,
+    const std::string & filter_expression,
+    const std::vector<std::string> & expression_parameters = {});
+
+  RCLCPP_PUBLIC
+  ~ContentFilter();
+
+  /// Return true if the message is selected by the filter.
+  /**
+   * \param[in] message the ROS message, of the type of the filter.
+   */
+  RCLCPP_PUBLIC
+  bool
+  matches(const void * message) const;
+
+  /// Return the filter expression and its parameters.
+  RCLCPP_PUBLIC
+  const ContentFilterOptions &
+  get_options() const;
+
+private:
+  struct Condition;
+  class Parser;
+
+  ContentFilterOptions options_;
+  std::unique_ptr<const Condition> condition_;
+};
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__CONTENT_FILTER_HPP_
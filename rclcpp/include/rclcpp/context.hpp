@@ -37,6 +37,11 @@
 namespace rclcpp
 {
 
+namespace detail
+{
+class AsyncLogDispatcher;
+}  // namespace detail
+
 /// Thrown when init is called on an already initialized context.
 class ContextAlreadyInitialized : public std::runtime_error
 {
@@ -367,6 +372,8 @@ private:
 
   // Keep shared ownership of the global logging mutex.
   std::shared_ptr<std::recursive_mutex> logging_mutex_;
+  // Keep shared ownership of the global dispatcher of the asynchronous logging.
+  std::shared_ptr<rclcpp::detail::AsyncLogDispatcher> async_log_dispatcher_;
 
   std::unordered_map<std::type_index, std::shared_ptr<void>> sub_contexts_;
   // This mutex is recursive so that the constructor of a sub context may
@@ -0,0 +1,304 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__COROUTINE_HPP_
+#define RCLCPP__COROUTINE_HPP_
+
+// Awaitable results of the asynchronous calls, for C++20 coroutines.
+//
+// Everything in this header requires a compiler supporting coroutines, e.g. building with
+// -std=c++20, in which case RCLCPP_HAS_COROUTINES is defined.
+//
+// A callback, e.g. of a timer, which is a rclcpp::Task coroutine can await the response of a
+// service, or the next message of a topic, without blocking its thread: it is suspended and
+// resumed by the executor, from the callback receiving the response or the message.
+// Chains of requests then run on a single threaded executor, without extra threads waiting on
+// futures.
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define RCLCPP_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifdef RCLCPP_HAS_COROUTINES
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "rclcpp/client.hpp"
+#include "rclcpp/node.hpp"
+#include "rclcpp/qos.hpp"
+#include "rclcpp/subscription.hpp"
+#include "rclcpp/timer.hpp"
+
+namespace rclcpp
+{
+
+/// Return type of the coroutines started by a call and running on their own.
+/**
+ * The coroutine runs when it is called, until its first suspension, and is resumed by the
+ * callbacks completing what it awaits.
+ * Its state is released when it returns.
+ * An exception it does not catch is thrown to the code resuming it, i.e. the caller or the
+ * executor executing the completing callback.
+ */
+class Task
+{
+public:
+  struct promise_type
+  {
+    Task
+    get_return_object() noexcept
+    {
+      return Task();
+    }
+
+    std::suspend_never
+    initial_suspend() noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never
+    final_suspend() noexcept
+    {
+      return {};
+    }
+
+    void
+    return_void() noexcept
+    {}
+
+    void
+    unhandled_exception()
+    {
+      throw;
+    }
+  };
+};
+
+namespace detail
+{
+
+/// State shared by an awaiter and the callbacks completing it.
+/**
+ * The first call to complete() resumes the coroutine, the next ones are ignored.
+ * It is shared with the callbacks, so that it outlives the awaiter if they are called late.
+ */
+template<typename ResultT>
+struct AwaitState
+{
+  /// Store the result if it is the first one, return false otherwise.
+  bool
+  set_result(ResultT new_result)
+  {
+    if (completed.exchange(true)) {
+      return false;
+    }
+    result = std::move(new_result);
+    return true;
+  }
+
+  /// Store the result and resume the coroutine, if it is the first result.
+  void
+  complete(ResultT new_result)
+  {
+    if (set_result(std::move(new_result))) {
+      handle.resume();
+    }
+  }
+
+  std::coroutine_handle<> handle;
+  std::atomic<bool> completed{false};
+  ResultT result{};
+};
+
+}  // namespace detail
+
+/// Awaiter of the response of a service, see send_request_awaitable().
+template<typename ServiceT>
+class ResponseAwaiter
+{
+public:
+  using ClientT = rclcpp::Client<ServiceT>;
+
+  ResponseAwaiter(
+    typename ClientT::SharedPtr client,
+    typename ClientT::SharedRequest request)
+  : client_(std::move(client)),
+    request_(std::move(request)),
+    state_(std::make_shared<detail::AwaitState<typename ClientT::SharedResponse>>())
+  {}
+
+  bool
+  await_ready() const noexcept
+  {
+    return false;
+  }
+
+  void
+  await_suspend(std::coroutine_handle<> handle)
+  {
+    state_->handle = handle;
+    // The response can resume the coroutine before the request call returns, so only locals
+    // are used from here on.
+    auto client = client_;
+    auto state = state_;
+    client->async_send_request(
+      request_,
+      [state](typename ClientT::SharedFuture future) {
+        state->complete(future.get());
+      });
+  }
+
+  typename ClientT::SharedResponse
+  await_resume()
+  {
+    return std::move(state_->result);
+  }
+
+private:
+  typename ClientT::SharedPtr client_;
+  typename ClientT::SharedRequest request_;
+  std::shared_ptr<detail::AwaitState<typename ClientT::SharedResponse>> state_;
+};
+
+/// Send a request to a service and await its response.
+/**
+ * The coroutine is resumed by the executor of the client, when it executes the response.
+ * It stays suspended if no response arrives, e.g. if the client is destroyed or its pending
+ * requests are pruned first.
+ *
+ * \param[in] client the client of the service.
+ * \param[in] request the request.
+ * \return an awaitable whose result is the response.
+ */
+template<typename ServiceT>
+ResponseAwaiter<ServiceT>
+send_request_awaitable(
+  typename rclcpp::Client<ServiceT>::SharedPtr client,
+  typename rclcpp::Client<ServiceT>::SharedRequest request)
+{
+  return ResponseAwaiter<ServiceT>(std::move(client), std::move(request));
+}
+
+/// Awaiter of the next message of a topic, see wait_for_message_awaitable().
+template<typename MsgT>
+class MessageAwaiter
+{
+public:
+  MessageAwaiter(
+    rclcpp::Node::SharedPtr node,
+    const std::string & topic,
+    const rclcpp::QoS & qos,
+    std::chrono::nanoseconds time_to_wait)
+  : node_(std::move(node)),
+    topic_(topic),
+    qos_(qos),
+    time_to_wait_(time_to_wait),
+    state_(std::make_shared<State>())
+  {}
+
+  bool
+  await_ready() const noexcept
+  {
+    return false;
+  }
+
+  void
+  await_suspend(std::coroutine_handle<> handle)
+  {
+    state_->handle = handle;
+    auto state = state_;
+    // The entities are released when the coroutine is resumed, after they are stored.
+    std::lock_guard<std::mutex> lock(state->entities_mutex);
+    state->subscription = node_->create_subscription<MsgT>(
+      topic_, qos_,
+      [state](std::shared_ptr<const MsgT> message) {
+        state->complete(std::move(message));
+      });
+    if (time_to_wait_ >= std::chrono::nanoseconds::zero()) {
+      state->timer = node_->create_wall_timer(
+        time_to_wait_,
+        [state]() {
+          state->complete(nullptr);
+        });
+    }
+  }
+
+  std::shared_ptr<const MsgT>
+  await_resume()
+  {
+    {
+      std::lock_guard<std::mutex> lock(state_->entities_mutex);
+      state_->subscription.reset();
+      if (state_->timer) {
+        state_->timer->cancel();
+        state_->timer.reset();
+      }
+    }
+    return std::move(state_->result);
+  }
+
+private:
+  struct State : detail::AwaitState<std::shared_ptr<const MsgT>>
+  {
+    std::mutex entities_mutex;
+    typename rclcpp::Subscription<MsgT>::SharedPtr subscription;
+    rclcpp::TimerBase::SharedPtr timer;
+  };
+
+  rclcpp::Node::SharedPtr node_;
+  std::string topic_;
+  rclcpp::QoS qos_;
+  std::chrono::nanoseconds time_to_wait_;
+  std::shared_ptr<State> state_;
+};
+
+/// Await the next message of a topic.
+/**
+ * A subscription, and a timer if there is a timeout, are created on the node for the duration
+ * of the wait, in its default callback group, so the coroutine is resumed by the executor of
+ * the node.
+ *
+ * \param[in] node the node to create the subscription on.
+ * \param[in] topic the topic to wait for messages.
+ * \param[in] qos the QoS of the subscription.
+ * \param[in] time_to_wait the timeout, negative to wait without timeout.
+ * \return an awaitable whose result is the message, or nullptr on timeout.
+ */
+template<typename MsgT, typename Rep = int64_t, typename Period = std::milli>
+MessageAwaiter<MsgT>
+wait_for_message_awaitable(
+  rclcpp::Node::SharedPtr node,
+  const std::string & topic,
+  const rclcpp::QoS & qos = rclcpp::QoS(1),
+  std::chrono::duration<Rep, Period> time_to_wait = std::chrono::duration<Rep, Period>(-1))
+{
+  return MessageAwaiter<MsgT>(
+    std::move(node), topic, qos,
+    std::chrono::duration_cast<std::chrono::nanoseconds>(time_to_wait));
+}
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP_HAS_COROUTINES
+
+#endif  // RCLCPP__COROUTINE_HPP_
@@ -45,6 +45,9 @@ create_client(
     node_graph,
     service_name,
     options);
+  if (node_base->get_use_intra_process_default()) {
+    cli->setup_intra_process();
+  }
 
   auto cli_base_ptr = std::dynamic_pointer_cast<rclcpp::ClientBase>(cli);
   node_services->add_client(cli_base_ptr, group);
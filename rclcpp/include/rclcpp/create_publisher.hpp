@@ -15,10 +15,14 @@
 #ifndef RCLCPP__CREATE_PUBLISHER_HPP_
 #define RCLCPP__CREATE_PUBLISHER_HPP_
 
+#include <chrono>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
+#include "rclcpp/create_timer.hpp"
+#include "rclcpp/detail/resolve_enable_topic_statistics.hpp"
 #include "rclcpp/node_interfaces/get_node_topics_interface.hpp"
 #include "rclcpp/node_interfaces/node_topics_interface.hpp"
 #include "rclcpp/node_options.hpp"
@@ -26,8 +30,11 @@
 #include "rclcpp/publisher_options.hpp"
 #include "rclcpp/qos.hpp"
 #include "rclcpp/qos_overriding_options.hpp"
+#include "rclcpp/topic_statistics/publisher_topic_statistics.hpp"
 #include "rclcpp/detail/qos_parameters.hpp"
 
+#include "statistics_msgs/msg/metrics_message.hpp"
+
 #include "rmw/qos_profiles.h"
 
 namespace rclcpp
@@ -71,6 +78,56 @@ create_publisher(
   // Add the publisher to the node topics interface.
   node_topics_interface->add_publisher(pub, options.callback_group);
 
+  if (rclcpp::detail::resolve_enable_topic_statistics(
+      options,
+      *node_topics_interface->get_node_base_interface()))
+  {
+    if (options.topic_stats_options.publish_period <= std::chrono::milliseconds(0)) {
+      throw std::invalid_argument(
+              "topic_stats_options.publish_period must be greater than 0, specified value of " +
+              std::to_string(options.topic_stats_options.publish_period.count()) +
+              " ms");
+    }
+
+    // The statistics publisher is not measured itself.
+    rclcpp::PublisherOptionsWithAllocator<std::allocator<void>> statistics_options;
+    statistics_options.topic_stats_options.state = TopicStatisticsState::Disable;
+    auto statistics_publisher =
+      rclcpp::detail::create_publisher<statistics_msgs::msg::MetricsMessage>(
+      node_parameters,
+      node_topics_interface,
+      options.topic_stats_options.publish_topic,
+      qos,
+      statistics_options);
+
+    auto publisher_topic_stats =
+      std::make_shared<rclcpp::topic_statistics::PublisherTopicStatistics>(
+      std::string(node_topics_interface->get_node_base_interface()->get_fully_qualified_name()) +
+      ":" + pub->get_topic_name(),
+      statistics_publisher);
+
+    std::weak_ptr<rclcpp::topic_statistics::PublisherTopicStatistics>
+    weak_publisher_topic_stats(publisher_topic_stats);
+    auto pub_call_back = [weak_publisher_topic_stats]() {
+        auto publisher_topic_stats = weak_publisher_topic_stats.lock();
+        if (publisher_topic_stats) {
+          publisher_topic_stats->publish_message_and_reset_measurements();
+        }
+      };
+
+    auto timer = create_wall_timer(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        options.topic_stats_options.publish_period),
+      pub_call_back,
+      options.callback_group,
+      node_topics_interface->get_node_base_interface(),
+      node_topics_interface->get_node_timers_interface()
+    );
+
+    publisher_topic_stats->set_publisher_timer(timer);
+    pub->set_topic_statistics(publisher_topic_stats);
+  }
+
   return std::dynamic_pointer_cast<PublisherT>(pub);
 }
 }  // namespace detail
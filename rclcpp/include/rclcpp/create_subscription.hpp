@@ -93,7 +93,10 @@ create_subscription(
 
     subscription_topic_stats = std::make_shared<
       rclcpp::topic_statistics::SubscriptionTopicStatistics<ROSMessageType>
-      >(node_topics_interface->get_node_base_interface()->get_name(), publisher);
+      >(
+      node_topics_interface->get_node_base_interface()->get_name(), publisher,
+      options.topic_stats_options.lock_free_accumulation,
+      options.topic_stats_options.report_percentiles);
 
     std::weak_ptr<
       rclcpp::topic_statistics::SubscriptionTopicStatistics<ROSMessageType>
@@ -39,19 +39,24 @@ create_timer(
   rclcpp::Clock::SharedPtr clock,
   rclcpp::Duration period,
   CallbackT && callback,
-  rclcpp::CallbackGroup::SharedPtr group = nullptr)
+  rclcpp::CallbackGroup::SharedPtr group = nullptr,
+  std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero())
 {
   auto timer = rclcpp::GenericTimer<CallbackT>::make_shared(
     clock,
     period.to_chrono<std::chrono::nanoseconds>(),
     std::forward<CallbackT>(callback),
     node_base->get_context());
+  timer->set_slack(slack);
 
   node_timers->add_timer(timer, group);
   return timer;
 }
 
 /// Create a timer with a given clock
+/**
+ * \param[in] slack how late the timer may be called, see rclcpp::TimerBase::set_slack()
+ */
 template<typename NodeT, typename CallbackT>
 typename rclcpp::TimerBase::SharedPtr
 create_timer(
@@ -59,7 +64,8 @@ create_timer(
   rclcpp::Clock::SharedPtr clock,
   rclcpp::Duration period,
   CallbackT && callback,
-  rclcpp::CallbackGroup::SharedPtr group = nullptr)
+  rclcpp::CallbackGroup::SharedPtr group = nullptr,
+  std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero())
 {
   return create_timer(
     rclcpp::node_interfaces::get_node_base_interface(node),
@@ -67,7 +73,8 @@ create_timer(
     clock,
     period,
     std::forward<CallbackT>(callback),
-    group);
+    group,
+    slack);
 }
 
 /// Convenience method to create a timer with node resources.
@@ -81,9 +88,10 @@ create_timer(
  * \param group
  * \param node_base
  * \param node_timers
+ * \param slack how late the timer may be called, see rclcpp::TimerBase::set_slack()
  * \return
  * \throws std::invalid argument if either node_base or node_timers
- * are null, or period is negative or too large
+ * are null, period is negative or too large, or slack is negative
  */
 template<typename DurationRepT, typename DurationT, typename CallbackT>
 typename rclcpp::WallTimer<CallbackT>::SharedPtr
@@ -92,7 +100,8 @@ create_wall_timer(
   CallbackT callback,
   rclcpp::CallbackGroup::SharedPtr group,
   node_interfaces::NodeBaseInterface * node_base,
-  node_interfaces::NodeTimersInterface * node_timers)
+  node_interfaces::NodeTimersInterface * node_timers,
+  std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero())
 {
   if (node_base == nullptr) {
     throw std::invalid_argument{"input node_base cannot be null"};
@@ -134,6 +143,7 @@ create_wall_timer(
 
   auto timer = rclcpp::WallTimer<CallbackT>::make_shared(
     period_ns, std::move(callback), node_base->get_context());
+  timer->set_slack(slack);
   node_timers->add_timer(timer, group);
   return timer;
 }
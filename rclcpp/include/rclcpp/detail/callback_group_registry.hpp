@@ -0,0 +1,250 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__CALLBACK_GROUP_REGISTRY_HPP_
+#define RCLCPP__DETAIL__CALLBACK_GROUP_REGISTRY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "rclcpp/callback_group.hpp"
+#include "rclcpp/node_interfaces/node_base_interface.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Registry of the callback groups of an executor and of their nodes, by integer id.
+/**
+ * Each registered callback group gets a stable id, an index into a vector of entries which
+ * also holds the id of its node, and each node keeps the number of its registered groups.
+ * Resolving a group, or telling whether a node has any group left, is a hash lookup on the
+ * address of the group or node followed by an array access, without locking weak pointers
+ * of other entries.
+ *
+ * Ids of removed groups and nodes are reused.
+ * An entry whose group or node was destroyed stays until remove_expired() is called, usually
+ * once the entity collection reported an invalid group; a new group or node allocated at the
+ * same address replaces it.
+ *
+ * This class is not thread-safe.
+ */
+class CallbackGroupRegistry
+{
+public:
+  using Id = size_t;
+
+  /// Id returned when a callback group is not registered.
+  static constexpr Id invalid_id = SIZE_MAX;
+
+  /// Register a callback group and its node.
+  /**
+   * \return the id of the group, or invalid_id if it is already registered.
+   */
+  Id
+  add(
+    const rclcpp::CallbackGroup::SharedPtr & group,
+    const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr & node)
+  {
+    if (invalid_id != find(group.get())) {
+      return invalid_id;
+    }
+    // Drop an entry of a destroyed group which had the same address.
+    auto stale = group_ids_.find(group.get());
+    if (stale != group_ids_.end()) {
+      release_group(stale->second);
+    }
+    Id id;
+    if (free_group_ids_.empty()) {
+      id = groups_.size();
+      groups_.emplace_back();
+    } else {
+      id = free_group_ids_.back();
+      free_group_ids_.pop_back();
+    }
+    GroupEntry & entry = groups_[id];
+    entry.key = group.get();
+    entry.group = group;
+    entry.node_id = acquire_node(node);
+    entry.in_use = true;
+    group_ids_[entry.key] = id;
+    return id;
+  }
+
+  /// Unregister a callback group.
+  /**
+   * \return true if the node of the group has no registered group left, false otherwise or
+   *   if the group is not registered.
+   */
+  bool
+  remove(const rclcpp::CallbackGroup * group)
+  {
+    auto it = group_ids_.find(group);
+    if (it == group_ids_.end()) {
+      return false;
+    }
+    return release_group(it->second);
+  }
+
+  /// Return the id of a live callback group, or invalid_id if it is not registered.
+  Id
+  find(const rclcpp::CallbackGroup * group) const
+  {
+    auto it = group_ids_.find(group);
+    if (it == group_ids_.end() || groups_[it->second].group.expired()) {
+      return invalid_id;
+    }
+    return it->second;
+  }
+
+  /// Return the callback group with the given id, nullptr if it was destroyed.
+  rclcpp::CallbackGroup::SharedPtr
+  get_group(Id id) const
+  {
+    return groups_[id].group.lock();
+  }
+
+  /// Return the node of the callback group with the given id, nullptr if it was destroyed.
+  rclcpp::node_interfaces::NodeBaseInterface::SharedPtr
+  get_node(Id id) const
+  {
+    return nodes_[groups_[id].node_id].node.lock();
+  }
+
+  /// Return true if a live node has any registered callback group.
+  bool
+  has_node(const rclcpp::node_interfaces::NodeBaseInterface * node) const
+  {
+    auto it = node_ids_.find(node);
+    return it != node_ids_.end() && !nodes_[it->second].node.expired();
+  }
+
+  /// Unregister the callback groups of which the group or the node was destroyed.
+  /**
+   * \return the number of unregistered callback groups.
+   */
+  size_t
+  remove_expired()
+  {
+    size_t removed = 0;
+    for (Id id = 0; id < groups_.size(); ++id) {
+      const GroupEntry & entry = groups_[id];
+      if (entry.in_use && (entry.group.expired() || nodes_[entry.node_id].node.expired())) {
+        release_group(id);
+        ++removed;
+      }
+    }
+    return removed;
+  }
+
+  /// Return the number of registered callback groups.
+  size_t
+  size() const
+  {
+    return group_ids_.size();
+  }
+
+  /// Unregister all the callback groups and nodes.
+  void
+  clear()
+  {
+    groups_.clear();
+    free_group_ids_.clear();
+    group_ids_.clear();
+    nodes_.clear();
+    free_node_ids_.clear();
+    node_ids_.clear();
+  }
+
+private:
+  struct GroupEntry
+  {
+    const rclcpp::CallbackGroup * key = nullptr;
+    rclcpp::CallbackGroup::WeakPtr group;
+    Id node_id = invalid_id;
+    bool in_use = false;
+  };
+
+  struct NodeEntry
+  {
+    const rclcpp::node_interfaces::NodeBaseInterface * key = nullptr;
+    rclcpp::node_interfaces::NodeBaseInterface::WeakPtr node;
+    size_t number_of_groups = 0;
+  };
+
+  Id
+  acquire_node(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr & node)
+  {
+    auto it = node_ids_.find(node.get());
+    if (it != node_ids_.end() && !nodes_[it->second].node.expired()) {
+      ++nodes_[it->second].number_of_groups;
+      return it->second;
+    }
+    // A destroyed node with the same address keeps its entry until its groups are removed.
+    Id id;
+    if (free_node_ids_.empty()) {
+      id = nodes_.size();
+      nodes_.emplace_back();
+    } else {
+      id = free_node_ids_.back();
+      free_node_ids_.pop_back();
+    }
+    NodeEntry & entry = nodes_[id];
+    entry.key = node.get();
+    entry.node = node;
+    entry.number_of_groups = 1;
+    node_ids_[entry.key] = id;
+    return id;
+  }
+
+  /// Release a group entry, return true if its node has no group left.
+  bool
+  release_group(Id id)
+  {
+    GroupEntry & entry = groups_[id];
+    auto it = group_ids_.find(entry.key);
+    if (it != group_ids_.end() && it->second == id) {
+      group_ids_.erase(it);
+    }
+    NodeEntry & node_entry = nodes_[entry.node_id];
+    bool node_removed = false;
+    if (0 == --node_entry.number_of_groups) {
+      auto node_it = node_ids_.find(node_entry.key);
+      if (node_it != node_ids_.end() && node_it->second == entry.node_id) {
+        node_ids_.erase(node_it);
+      }
+      node_entry = NodeEntry();
+      free_node_ids_.push_back(entry.node_id);
+      node_removed = true;
+    }
+    entry = GroupEntry();
+    free_group_ids_.push_back(id);
+    return node_removed;
+  }
+
+  std::vector<GroupEntry> groups_;
+  std::vector<Id> free_group_ids_;
+  std::unordered_map<const rclcpp::CallbackGroup *, Id> group_ids_;
+  std::vector<NodeEntry> nodes_;
+  std::vector<Id> free_node_ids_;
+  std::unordered_map<const rclcpp::node_interfaces::NodeBaseInterface *, Id> node_ids_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__CALLBACK_GROUP_REGISTRY_HPP_
@@ -0,0 +1,52 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__FAST_EXIT_HPP_
+#define RCLCPP__DETAIL__FAST_EXIT_HPP_
+
+#include "rcl/context.h"
+#include "rcl/node.h"
+
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Register an rcl context initialized with rclcpp::InitOptions::fast_exit().
+RCLCPP_PUBLIC
+void
+register_fast_exit_context(const rcl_context_t * context);
+
+/// Unregister an rcl context, before it is finalized.
+RCLCPP_PUBLIC
+void
+unregister_fast_exit_context(const rcl_context_t * context);
+
+/// Return true if the entities of the node are destroyed without finalizing their rcl handle.
+/**
+ * That is the case once the context of the node, initialized with
+ * rclcpp::InitOptions::fast_exit(), is shut down.
+ * The middleware then releases the entities along with the node and its participant, without
+ * announcing the destruction of each of them to the graph.
+ */
+RCLCPP_PUBLIC
+bool
+skip_entity_finalization(const rcl_node_t * node_handle);
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__FAST_EXIT_HPP_
@@ -0,0 +1,181 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__INPLACE_FUNCTION_HPP_
+#define RCLCPP__DETAIL__INPLACE_FUNCTION_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rclcpp
+{
+namespace detail
+{
+
+template<typename SignatureT, size_t Capacity = 4 * sizeof(void *)>
+class InplaceFunction;
+
+/// Copyable callable wrapper, which stores the callable in place and never allocates.
+/**
+ * Unlike std::function, whose small buffer only fits a pointer or two in common implementations,
+ * the callable is always stored in the wrapper, and a callable larger than its capacity is
+ * rejected at compile time.
+ * Calling an empty wrapper throws std::bad_function_call.
+ */
+template<typename ReturnT, typename ... ArgsT, size_t Capacity>
+class InplaceFunction<ReturnT(ArgsT...), Capacity>
+{
+public:
+  InplaceFunction() noexcept = default;
+
+  InplaceFunction(std::nullptr_t) noexcept  // NOLINT(runtime/explicit)
+  {}
+
+  template<
+    typename CallableT,
+    typename = std::enable_if_t<
+      !std::is_same_v<std::decay_t<CallableT>, InplaceFunction> &&
+      std::is_invocable_r_v<ReturnT, std::decay_t<CallableT> &, ArgsT...>
+    >
+  >
+  InplaceFunction(CallableT && callable)  // NOLINT(runtime/explicit)
+  {
+    using StoredT = std::decay_t<CallableT>;
+    static_assert(
+      sizeof(StoredT) <= Capacity,
+      "the callable is too large to be stored in place, increase the capacity");
+    static_assert(
+      alignof(StoredT) <= alignof(std::max_align_t),
+      "the alignment of the callable is not supported");
+    new (&storage_) StoredT(std::forward<CallableT>(callable));
+    vtable_ = &vtable_for<StoredT>;
+  }
+
+  InplaceFunction(const InplaceFunction & other)
+  {
+    if (other.vtable_) {
+      other.vtable_->copy(&storage_, &other.storage_);
+      vtable_ = other.vtable_;
+    }
+  }
+
+  InplaceFunction(InplaceFunction && other) noexcept
+  {
+    if (other.vtable_) {
+      other.vtable_->move(&storage_, &other.storage_);
+      vtable_ = other.vtable_;
+      other.reset();
+    }
+  }
+
+  InplaceFunction &
+  operator=(const InplaceFunction & other)
+  {
+    if (this != &other) {
+      InplaceFunction copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  InplaceFunction &
+  operator=(InplaceFunction && other) noexcept
+  {
+    if (this != &other) {
+      reset();
+      if (other.vtable_) {
+        other.vtable_->move(&storage_, &other.storage_);
+        vtable_ = other.vtable_;
+        other.reset();
+      }
+    }
+    return *this;
+  }
+
+  InplaceFunction &
+  operator=(std::nullptr_t) noexcept
+  {
+    reset();
+    return *this;
+  }
+
+  ~InplaceFunction()
+  {
+    reset();
+  }
+
+  ReturnT
+  operator()(ArgsT... args) const
+  {
+    if (!vtable_) {
+      throw std::bad_function_call();
+    }
+    return vtable_->invoke(&storage_, std::forward<ArgsT>(args)...);
+  }
+
+  explicit operator bool() const noexcept
+  {
+    return vtable_ != nullptr;
+  }
+
+private:
+  using Storage = std::aligned_storage_t<Capacity, alignof(std::max_align_t)>;
+
+  struct VTable
+  {
+    ReturnT (* invoke)(const void * storage, ArgsT && ... args);
+    void (* copy)(void * storage, const void * other_storage);
+    void (* move)(void * storage, void * other_storage);
+    void (* destroy)(void * storage);
+  };
+
+  template<typename StoredT>
+  static constexpr VTable vtable_for = {
+    [](const void * storage, ArgsT && ... args) -> ReturnT {
+      // The callable is called as non-const, like std::function does.
+      return std::invoke(
+        *const_cast<StoredT *>(static_cast<const StoredT *>(storage)),
+        std::forward<ArgsT>(args)...);
+    },
+    [](void * storage, const void * other_storage) {
+      new (storage) StoredT(*static_cast<const StoredT *>(other_storage));
+    },
+    [](void * storage, void * other_storage) {
+      new (storage) StoredT(std::move(*static_cast<StoredT *>(other_storage)));
+    },
+    [](void * storage) {
+      static_cast<StoredT *>(storage)->~StoredT();
+    }
+  };
+
+  void
+  reset() noexcept
+  {
+    if (vtable_) {
+      vtable_->destroy(&storage_);
+      vtable_ = nullptr;
+    }
+  }
+
+  Storage storage_;
+  const VTable * vtable_ = nullptr;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__INPLACE_FUNCTION_HPP_
@@ -0,0 +1,181 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__LOANED_MESSAGE_POOL_HPP_
+#define RCLCPP__DETAIL__LOANED_MESSAGE_POOL_HPP_
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "rcl/error_handling.h"
+#include "rcl/publisher.h"
+
+#include "rclcpp/allocator/allocator_common.hpp"
+#include "rclcpp/exceptions.hpp"
+#include "rclcpp/logging.hpp"
+#include "rclcpp/publisher_base.hpp"
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Pool of messages handed out by a publisher as rclcpp::LoanedMessage instances.
+/**
+ * If the middleware can loan messages, the pool borrows up to its capacity of messages from the
+ * middleware at once and hands them out without calling into rcl.
+ * Otherwise the messages are allocated with the allocator of the publisher.
+ * In both cases the messages which are not published, or which were copied by the middleware,
+ * are given back to the pool and reused, up to its capacity.
+ *
+ * The pool keeps the rcl publisher alive, so that its loans can still be returned when the
+ * publisher outlives it.
+ *
+ * This class is thread-safe.
+ */
+template<typename MessageT, typename AllocatorT = std::allocator<void>>
+class LoanedMessagePool
+{
+  using MessageAllocatorTraits = rclcpp::allocator::AllocRebind<MessageT, AllocatorT>;
+  using MessageAllocator = typename MessageAllocatorTraits::allocator_type;
+
+public:
+  LoanedMessagePool(
+    const rclcpp::PublisherBase & pub,
+    const MessageAllocator & allocator,
+    size_t capacity)
+  : publisher_handle_(pub.get_publisher_handle()),
+    can_loan_messages_(pub.can_loan_messages()),
+    message_allocator_(allocator),
+    capacity_(capacity)
+  {
+    messages_.reserve(capacity_);
+  }
+
+  ~LoanedMessagePool()
+  {
+    for (MessageT * message : messages_) {
+      free_message(message);
+    }
+  }
+
+  /// Whether the messages of the pool are loaned from the middleware.
+  bool
+  can_loan_messages() const
+  {
+    return can_loan_messages_;
+  }
+
+  /// Take a message from the pool, borrowing or allocating more messages if it is empty.
+  /**
+   * \throws anything rclcpp::exceptions::throw_from_rcl_error can throw.
+   */
+  MessageT *
+  acquire()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (messages_.empty()) {
+      if (!can_loan_messages_) {
+        MessageT * message = MessageAllocatorTraits::allocate(message_allocator_, 1);
+        new (message) MessageT();
+        return message;
+      }
+      // Borrow ahead, the middleware may limit the number of loans, so only the first one must
+      // succeed.
+      messages_.push_back(borrow_message(true));
+      while (messages_.size() < capacity_) {
+        MessageT * message = borrow_message(false);
+        if (nullptr == message) {
+          break;
+        }
+        messages_.push_back(message);
+      }
+    }
+    MessageT * message = messages_.back();
+    messages_.pop_back();
+    return message;
+  }
+
+  /// Give back a message taken from the pool, which was not given to the middleware.
+  void
+  recycle(MessageT * message)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (messages_.size() >= capacity_) {
+      lock.unlock();
+      free_message(message);
+      return;
+    }
+    if (!can_loan_messages_) {
+      // Hand out a default constructed message, as the allocator would.
+      message->~MessageT();
+      new (message) MessageT();
+    }
+    messages_.push_back(message);
+  }
+
+private:
+  MessageT *
+  borrow_message(bool throw_on_error)
+  {
+    void * message_ptr = nullptr;
+    auto ret = rcl_borrow_loaned_message(
+      publisher_handle_.get(),
+      rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>(),
+      &message_ptr);
+    if (RCL_RET_OK != ret) {
+      if (throw_on_error) {
+        rclcpp::exceptions::throw_from_rcl_error(ret);
+      }
+      rcl_reset_error();
+      return nullptr;
+    }
+    return static_cast<MessageT *>(message_ptr);
+  }
+
+  void
+  free_message(MessageT * message)
+  {
+    if (can_loan_messages_) {
+      auto ret = rcl_return_loaned_message_from_publisher(publisher_handle_.get(), message);
+      if (RCL_RET_OK != ret) {
+        RCLCPP_ERROR(
+          rclcpp::get_logger("LoanedMessage"),
+          "rcl_return_loaned_message_from_publisher failed: %s", rcl_get_error_string().str);
+        rcl_reset_error();
+      }
+    } else {
+      message->~MessageT();
+      MessageAllocatorTraits::deallocate(message_allocator_, message, 1);
+    }
+  }
+
+  std::shared_ptr<const rcl_publisher_t> publisher_handle_;
+  const bool can_loan_messages_;
+  MessageAllocator message_allocator_;
+  const size_t capacity_;
+
+  std::mutex mutex_;
+  std::vector<MessageT *> messages_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__LOANED_MESSAGE_POOL_HPP_
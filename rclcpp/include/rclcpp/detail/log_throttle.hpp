@@ -0,0 +1,112 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__LOG_THROTTLE_HPP_
+#define RCLCPP__DETAIL__LOG_THROTTLE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+
+class Clock;
+
+namespace detail
+{
+
+/// Throttle of a call site of the RCLCPP_*_THROTTLE logging macros.
+/**
+ * A log call is throttled if less than the duration elapsed since the previous log, on the
+ * clock passed to the macro.
+ * Once a record is logged, the next calls are throttled by reading a coarse monotonic clock,
+ * which does not go through rcl, until the duration may have elapsed.
+ * Only then the clock of the macro is read, to decide whether the call is logged.
+ *
+ * This is skipped for a ROS clock with the ROS time active, whose time may not follow the
+ * monotonic clock.
+ * So the records are logged as with the clock of the macro, except when the clock jumps forward,
+ * e.g. the system time or a ROS time activated meanwhile, where the next record may still wait
+ * for the duration to elapse on the monotonic clock.
+ *
+ * The member functions are thread-safe and lock-free.
+ */
+class LogThrottle
+{
+public:
+  /// Constructor.
+  /**
+   * \param[in] skip_first if true, the first call which is not throttled is not logged either,
+   *   but it starts a throttling period, as with RCUTILS_LOG_*_SKIPFIRST_THROTTLE.
+   */
+  constexpr explicit LogThrottle(bool skip_first = false) noexcept
+  : skip_first_(skip_first)
+  {}
+
+  /// Return true if the call must be logged, which starts a new throttling period.
+  /**
+   * \param[in] clock clock measuring the duration.
+   * \param[in] duration_ms minimum duration between two logged records, in milliseconds.
+   */
+  bool
+  should_log(rclcpp::Clock & clock, int64_t duration_ms)
+  {
+    if (coarse_steady_now() < coarse_deadline_.load(std::memory_order_relaxed)) {
+      return false;
+    }
+    return should_log_with_clock(clock, duration_ms);
+  }
+
+  /// Return the time of the coarse monotonic clock, in nanoseconds.
+  /**
+   * On Linux it is read from the vDSO, without a system call.
+   */
+  static int64_t
+  coarse_steady_now() noexcept
+  {
+#if defined(__linux__)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000 + static_cast<int64_t>(now.tv_nsec);
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+private:
+  /// Decide with the clock of the macro, once the duration may have elapsed.
+  RCLCPP_PUBLIC
+  bool
+  should_log_with_clock(rclcpp::Clock & clock, int64_t duration_ms);
+
+  const bool skip_first_;
+  std::atomic<bool> first_{true};
+  /// Time of the clock of the macro when the last record was logged.
+  std::atomic<int64_t> last_logged_{0};
+  /// Time of the coarse monotonic clock before which the calls are throttled.
+  std::atomic<int64_t> coarse_deadline_{0};
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__LOG_THROTTLE_HPP_
@@ -0,0 +1,115 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__MESSAGE_RATE_LIMITER_HPP_
+#define RCLCPP__DETAIL__MESSAGE_RATE_LIMITER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Limit the rate of the messages accepted by a subscription.
+/**
+ * A message is accepted if at least the minimum period elapsed since the previously accepted
+ * message, on the steady clock, and the messages arriving in between are dropped.
+ * With a minimum period of zero, which is the default, every message is accepted without
+ * reading the clock.
+ *
+ * All member functions, except set_min_period(), are thread-safe and lock-free.
+ */
+class MessageRateLimiter
+{
+public:
+  explicit MessageRateLimiter(std::chrono::nanoseconds min_period = std::chrono::nanoseconds(0))
+  : min_period_(min_period)
+  {}
+
+  /// Set the minimum period between two accepted messages, zero to accept all the messages.
+  void
+  set_min_period(std::chrono::nanoseconds min_period)
+  {
+    min_period_ = min_period;
+  }
+
+  std::chrono::nanoseconds
+  get_min_period() const
+  {
+    return min_period_;
+  }
+
+  /// Return true if a message arriving now would be dropped.
+  bool
+  is_limited() const
+  {
+    if (min_period_.count() <= 0) {
+      return false;
+    }
+    return now() < next_accepted_time_.load(std::memory_order_relaxed);
+  }
+
+  /// Record that a message was accepted now, which starts a new period.
+  void
+  record_accepted()
+  {
+    if (min_period_.count() > 0) {
+      next_accepted_time_.store(now() + min_period_.count(), std::memory_order_relaxed);
+    }
+  }
+
+  /// Accept a message arriving now if it is not limited, see is_limited() and record_accepted().
+  /**
+   * \return true if the message is accepted, false if it must be dropped.
+   */
+  bool
+  try_accept()
+  {
+    if (min_period_.count() <= 0) {
+      return true;
+    }
+    const int64_t current_time = now();
+    int64_t next_accepted_time = next_accepted_time_.load(std::memory_order_relaxed);
+    while (current_time >= next_accepted_time) {
+      // Only one of the messages arriving concurrently starts the new period.
+      if (
+        next_accepted_time_.compare_exchange_weak(
+          next_accepted_time, current_time + min_period_.count(), std::memory_order_relaxed))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  static int64_t
+  now()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  std::chrono::nanoseconds min_period_;
+  // Steady time, in nanoseconds, from which the next message is accepted.
+  std::atomic<int64_t> next_accepted_time_{0};
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__MESSAGE_RATE_LIMITER_HPP_
@@ -0,0 +1,223 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__PENDING_REQUESTS_TABLE_HPP_
+#define RCLCPP__DETAIL__PENDING_REQUESTS_TABLE_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>  // NOLINT, cpplint doesn't think this is a cpp std header
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Table of the pending requests of a client, indexed by their sequence number.
+/**
+ * The sequence numbers of the requests of a client increase monotonically, so the pending
+ * requests are kept in a ring of slots indexed by the sequence number modulo its capacity.
+ * Inserting, finding and erasing a request costs O(1), the ring grows to span the oldest and
+ * the newest pending request.
+ *
+ * Requests are expected to be inserted in the order they were sent, so the oldest requests are
+ * at the front of the ring and erase_older_than() only visits the requests it erases.
+ * A request with a sequence number before the front of the ring, which the middleware should
+ * not produce, is kept in a separate map.
+ *
+ * This class is not thread-safe.
+ */
+template<typename ValueT>
+class PendingRequestsTable
+{
+public:
+  using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+  /// Insert a request, return false if a request with the same sequence number exists.
+  bool
+  insert(int64_t sequence_number, TimePoint time_sent, ValueT && value)
+  {
+    if (ring_size_ == 0) {
+      head_ = sequence_number;
+      end_ = sequence_number;
+    }
+    if (sequence_number < head_) {
+      return out_of_order_.try_emplace(
+        sequence_number, time_sent, std::move(value)).second;
+    }
+    if (static_cast<uint64_t>(sequence_number - head_) >= slots_.size()) {
+      grow(static_cast<uint64_t>(sequence_number - head_) + 1u);
+    }
+    Slot & slot = slots_[index(sequence_number)];
+    if (slot.value) {
+      return false;
+    }
+    slot.sequence_number = sequence_number;
+    slot.time_sent = time_sent;
+    slot.value.emplace(std::move(value));
+    ++ring_size_;
+    if (sequence_number >= end_) {
+      end_ = sequence_number + 1;
+    }
+    return true;
+  }
+
+  /// Remove a request and return its value, std::nullopt if there is no such request.
+  std::optional<ValueT>
+  take(int64_t sequence_number)
+  {
+    std::optional<ValueT> value;
+    if (sequence_number >= head_ && sequence_number < end_) {
+      Slot & slot = slots_[index(sequence_number)];
+      if (slot.value && slot.sequence_number == sequence_number) {
+        value = std::move(slot.value);
+        release(slot);
+        return value;
+      }
+    }
+    auto it = out_of_order_.find(sequence_number);
+    if (it != out_of_order_.end()) {
+      value = std::move(it->second.second);
+      out_of_order_.erase(it);
+    }
+    return value;
+  }
+
+  /// Remove a request, return false if there is no such request.
+  bool
+  erase(int64_t sequence_number)
+  {
+    return take(sequence_number).has_value();
+  }
+
+  /// Remove the requests sent before a time point.
+  /**
+   * \param[in] time_point requests sent before it are removed
+   * \param[inout] erased if not null, the sequence numbers of the removed requests are pushed into
+   *   it
+   * \return the number of removed requests
+   */
+  template<typename AllocatorT = std::allocator<int64_t>>
+  size_t
+  erase_older_than(TimePoint time_point, std::vector<int64_t, AllocatorT> * erased = nullptr)
+  {
+    size_t number_erased = 0;
+    // The front of the ring is always a pending request, see release().
+    while (ring_size_ > 0) {
+      Slot & slot = slots_[index(head_)];
+      if (!(slot.time_sent < time_point)) {
+        break;
+      }
+      if (erased) {
+        erased->push_back(slot.sequence_number);
+      }
+      release(slot);
+      ++number_erased;
+    }
+    for (auto it = out_of_order_.begin(); it != out_of_order_.end(); ) {
+      if (it->second.first < time_point) {
+        if (erased) {
+          erased->push_back(it->first);
+        }
+        it = out_of_order_.erase(it);
+        ++number_erased;
+      } else {
+        ++it;
+      }
+    }
+    return number_erased;
+  }
+
+  /// Remove all requests.
+  void
+  clear()
+  {
+    for (Slot & slot : slots_) {
+      slot.value.reset();
+    }
+    ring_size_ = 0;
+    out_of_order_.clear();
+  }
+
+  size_t
+  size() const
+  {
+    return ring_size_ + out_of_order_.size();
+  }
+
+private:
+  struct Slot
+  {
+    int64_t sequence_number = 0;
+    TimePoint time_sent;
+    std::optional<ValueT> value;
+  };
+
+  size_t
+  index(int64_t sequence_number) const
+  {
+    // The capacity is a power of two.
+    return static_cast<size_t>(static_cast<uint64_t>(sequence_number) & (slots_.size() - 1u));
+  }
+
+  /// Free a slot whose value was moved out or reset, and advance the front past free slots.
+  void
+  release(Slot & slot)
+  {
+    slot.value.reset();
+    --ring_size_;
+    if (ring_size_ == 0) {
+      head_ = end_;
+      return;
+    }
+    while (!slots_[index(head_)].value) {
+      ++head_;
+    }
+  }
+
+  void
+  grow(uint64_t span)
+  {
+    size_t capacity = slots_.empty() ? 16u : slots_.size();
+    while (capacity < span) {
+      capacity *= 2u;
+    }
+    std::vector<Slot> slots(capacity);
+    for (Slot & slot : slots_) {
+      if (slot.value) {
+        slots[static_cast<size_t>(static_cast<uint64_t>(slot.sequence_number) & (capacity - 1u))] =
+          std::move(slot);
+      }
+    }
+    slots_ = std::move(slots);
+  }
+
+  std::vector<Slot> slots_;
+  /// Sequence number of the oldest request in the ring, if it is not empty.
+  int64_t head_ = 0;
+  /// Sequence number after the newest request in the ring.
+  int64_t end_ = 0;
+  size_t ring_size_ = 0;
+  std::unordered_map<int64_t, std::pair<TimePoint, ValueT>> out_of_order_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__PENDING_REQUESTS_TABLE_HPP_
@@ -15,8 +15,8 @@
 #ifndef RCLCPP__DETAIL__QOS_PARAMETERS_HPP_
 #define RCLCPP__DETAIL__QOS_PARAMETERS_HPP_
 
-#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <map>
@@ -130,42 +130,44 @@ declare_qos_parameters(
   const ::rclcpp::QoS & default_qos,
   EntityQosParametersTraits)
 {
-  auto & parameters_interface = *rclcpp::node_interfaces::get_node_parameters_interface(node);
-  std::string param_prefix;
+  auto parameters_interface = rclcpp::node_interfaces::get_node_parameters_interface(node);
   const auto & id = options.get_id();
-  {
-    std::ostringstream oss{"qos_overrides.", std::ios::ate};
-    oss << topic_name << "." << EntityQosParametersTraits::entity_type();
-    if (!id.empty()) {
-      oss << "_" << id;
-    }
-    oss << ".";
-    param_prefix = oss.str();
+  const std::string entity_type = EntityQosParametersTraits::entity_type();
+  std::string param_prefix = "qos_overrides." + topic_name + "." + entity_type;
+  std::string param_description_suffix = "} for " + entity_type + " {" + topic_name + "}";
+  if (!id.empty()) {
+    param_prefix += "_" + id;
+    param_description_suffix += " with id {" + id + "}";
   }
-  std::string param_description_suffix;
-  {
-    std::ostringstream oss{"} for ", std::ios::ate};
-    oss << EntityQosParametersTraits::entity_type() << " {" << topic_name << "}";
-    if (!id.empty()) {
-      oss << " with id {" << id << "}";
-    }
-    param_description_suffix = oss.str();
+  param_prefix += ".";
+  // The policy kinds are flags, so the requested ones are looked up in a mask.
+  uint32_t requested_policies = 0u;
+  for (auto policy : options.get_policy_kinds()) {
+    requested_policies |= static_cast<uint32_t>(policy);
   }
   rclcpp::QoS qos = default_qos;
-  for (auto policy : EntityQosParametersTraits::allowed_policies()) {
-    if (
-      std::count(options.get_policy_kinds().begin(), options.get_policy_kinds().end(), policy))
-    {
-      std::ostringstream param_name{param_prefix, std::ios::ate};
-      param_name << qos_policy_kind_to_cstr(policy);
-      std::ostringstream param_desciption{"qos policy {", std::ios::ate};
-      param_desciption << qos_policy_kind_to_cstr(policy) << param_description_suffix;
-      rcl_interfaces::msg::ParameterDescriptor descriptor{};
-      descriptor.description = param_desciption.str();
-      descriptor.read_only = true;
-      auto value = declare_parameter_or_get(
-        parameters_interface, param_name.str(),
-        get_default_qos_param_value(policy, qos), descriptor);
+  if (0u != requested_policies) {
+    // Declare the parameters of the entity in one parameter event, which is also merged with the
+    // events of the other entities when the caller holds a ParameterEventBatch.
+    rclcpp::node_interfaces::ParameterEventBatch batch(parameters_interface);
+    for (auto policy : EntityQosParametersTraits::allowed_policies()) {
+      if (0u == (requested_policies & static_cast<uint32_t>(policy))) {
+        continue;
+      }
+      const std::string policy_name = qos_policy_kind_to_cstr(policy);
+      const std::string param_name = param_prefix + policy_name;
+      rclcpp::ParameterValue value;
+      if (parameters_interface->has_parameter(param_name)) {
+        // Declared by a previous entity, avoid the exception thrown when declaring it again.
+        value = parameters_interface->get_parameter(param_name).get_parameter_value();
+      } else {
+        rcl_interfaces::msg::ParameterDescriptor descriptor{};
+        descriptor.description = "qos policy {" + policy_name + param_description_suffix;
+        descriptor.read_only = true;
+        value = declare_parameter_or_get(
+          *parameters_interface, param_name,
+          get_default_qos_param_value(policy, qos), descriptor);
+      }
       ::rclcpp::detail::apply_qos_override(policy, value, qos);
     }
   }
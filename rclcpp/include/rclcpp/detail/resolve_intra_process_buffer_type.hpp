@@ -36,8 +36,10 @@ resolve_intra_process_buffer_type(
   rclcpp::IntraProcessBufferType resolved_buffer_type = buffer_type;
 
   // If the user has not specified a type for the intra-process buffer, use the callback's type.
+  // Callbacks which do not take ownership of the messages, e.g. taking a const reference, share
+  // them, so that a message published to several such subscriptions is not copied for each.
   if (resolved_buffer_type == IntraProcessBufferType::CallbackDefault) {
-    if (any_subscription_callback.use_take_shared_method()) {
+    if (!any_subscription_callback.takes_message_ownership()) {
       resolved_buffer_type = IntraProcessBufferType::SharedPtr;
     } else {
       resolved_buffer_type = IntraProcessBufferType::UniquePtr;
@@ -47,6 +49,23 @@ resolve_intra_process_buffer_type(
   return resolved_buffer_type;
 }
 
+/// Return true if each message taken from the intra-process buffer is copied for the callback.
+/**
+ * This is the case when the buffer shares the messages but the callback takes their ownership,
+ * which is never the case for a buffer type resolved from "CallbackDefault".
+ */
+template<typename CallbackMessageT, typename AllocatorT>
+bool
+intra_process_buffer_copies_messages(
+  const rclcpp::IntraProcessBufferType resolved_buffer_type,
+  const rclcpp::AnySubscriptionCallback<CallbackMessageT, AllocatorT> & any_subscription_callback)
+{
+  return
+    (resolved_buffer_type == IntraProcessBufferType::SharedPtr ||
+    resolved_buffer_type == IntraProcessBufferType::LockFreeSharedPtr) &&
+    any_subscription_callback.takes_message_ownership();
+}
+
 }  // namespace detail
 
 }  // namespace rclcpp
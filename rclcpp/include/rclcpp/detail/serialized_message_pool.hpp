@@ -0,0 +1,93 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef RCLCPP__DETAIL__SERIALIZED_MESSAGE_POOL_HPP_
+#define RCLCPP__DETAIL__SERIALIZED_MESSAGE_POOL_HPP_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rcl/allocator.h"
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Pool of serialized messages taken by subscriptions, reusing their buffers.
+/**
+ * A message borrowed from the pool goes back to it once the last shared_ptr to it is released,
+ * e.g. after the callback of the subscription, if it did not keep the message.
+ * The buffers of the messages are never shrunk, so they stay at the largest size taken and
+ * the middleware does not need to reallocate them for the next messages.
+ * A message whose buffer was moved out, e.g. to be relayed, is freed instead of being kept.
+ *
+ * At most max_size messages are kept, the extra ones are freed when released.
+ * The messages borrowed from the pool may outlive it, they are freed when released then.
+ *
+ * This class is thread-safe, and must be owned by a std::shared_ptr.
+ */
+class SerializedMessagePool : public std::enable_shared_from_this<SerializedMessagePool>
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(SerializedMessagePool)
+
+  /// Constructor.
+  /**
+   * \param[in] max_size maximum number of messages kept by the pool.
+   * \param[in] allocator allocator of the messages and their buffers.
+   */
+  RCLCPP_PUBLIC
+  explicit SerializedMessagePool(
+    size_t max_size,
+    const rcl_allocator_t & allocator = rcl_get_default_allocator());
+
+  RCLCPP_PUBLIC
+  ~SerializedMessagePool();
+
+  /// Borrow an empty message, allocating it if the pool is empty.
+  /**
+   * \param[in] capacity minimum capacity of the buffer of the message.
+   * \return shared_ptr to the message, which gives it back to the pool when released.
+   */
+  RCLCPP_PUBLIC
+  std::shared_ptr<rclcpp::SerializedMessage>
+  borrow(size_t capacity = 0);
+
+  /// Return the number of messages kept by the pool, which are not borrowed.
+  RCLCPP_PUBLIC
+  size_t
+  size() const;
+
+private:
+  void
+  recycle(rclcpp::SerializedMessage * message);
+
+  const size_t max_size_;
+  const rcl_allocator_t allocator_;
+
+  mutable std::mutex mutex_;
+  std::vector<rclcpp::SerializedMessage *> messages_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__SERIALIZED_MESSAGE_POOL_HPP_
@@ -0,0 +1,125 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef RCLCPP__DETAIL__SERVICE_MESSAGE_POOL_HPP_
+#define RCLCPP__DETAIL__SERVICE_MESSAGE_POOL_HPP_
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/macros.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Pool of the requests or responses of a service or a client.
+/**
+ * The middleware cannot loan service messages, so this is the pooled fallback of
+ * rclcpp::detail::LoanedMessagePool for services: the messages are handed out as shared
+ * pointers which give them back to the pool once released, so that taking a request or
+ * building a response does not allocate the message.
+ * The messages given back are reset to their default value, as a newly allocated message would
+ * be, and are kept up to the capacity of the pool.
+ *
+ * The messages may outlive the pool, they are deleted when released after it.
+ *
+ * This class is thread-safe.
+ */
+template<typename MessageT>
+class ServiceMessagePool : public std::enable_shared_from_this<ServiceMessagePool<MessageT>>
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(ServiceMessagePool)
+
+  /// Constructor.
+  /**
+   * \param[in] capacity maximum number of messages kept to be reused.
+   */
+  explicit ServiceMessagePool(size_t capacity)
+  : capacity_(capacity)
+  {
+    messages_.reserve(capacity_);
+  }
+
+  /// Take a message from the pool, allocating one if it is empty.
+  /**
+   * The pool must be owned by a shared pointer.
+   */
+  std::shared_ptr<MessageT>
+  acquire()
+  {
+    std::unique_ptr<MessageT> message;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!messages_.empty()) {
+        message = std::move(messages_.back());
+        messages_.pop_back();
+      }
+    }
+    if (!message) {
+      message = std::make_unique<MessageT>();
+    }
+    std::weak_ptr<ServiceMessagePool> weak_this = this->shared_from_this();
+    return std::shared_ptr<MessageT>(
+      message.release(),
+      [weak_this](MessageT * released_message) {
+        std::unique_ptr<MessageT> owned_message(released_message);
+        auto pool = weak_this.lock();
+        if (pool) {
+          pool->recycle(std::move(owned_message));
+        }
+      });
+  }
+
+  /// Return the number of messages ready to be reused.
+  size_t
+  size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return messages_.size();
+  }
+
+private:
+  void
+  recycle(std::unique_ptr<MessageT> message)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (messages_.size() >= capacity_) {
+        return;
+      }
+    }
+    // Reset outside of the lock, the pool may have been filled concurrently in the meantime.
+    *message = MessageT();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (messages_.size() < capacity_) {
+      messages_.push_back(std::move(message));
+    }
+  }
+
+  const size_t capacity_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<MessageT>> messages_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__SERVICE_MESSAGE_POOL_HPP_
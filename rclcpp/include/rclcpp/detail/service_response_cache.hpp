@@ -0,0 +1,185 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef RCLCPP__DETAIL__SERVICE_RESPONSE_CACHE_HPP_
+#define RCLCPP__DETAIL__SERVICE_RESPONSE_CACHE_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Responses of a client, by request, kept for a time to live.
+/**
+ * The requests are identified by their serialized form, so two requests with the same fields
+ * get the same response, and there are no false hits.
+ * The responses are shared with all the requests hitting the cache, so they must not be
+ * modified.
+ *
+ * The keys of the requests sent are kept until their response is received, so that
+ * clear() also discards the responses in flight, which may be outdated.
+ *
+ * This class is thread-safe.
+ */
+template<typename ServiceT>
+class ServiceResponseCache
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(ServiceResponseCache)
+
+  using Request = typename ServiceT::Request;
+  using SharedResponse = std::shared_ptr<typename ServiceT::Response>;
+
+  /// Constructor.
+  /**
+   * \param[in] time_to_live duration for which a response is returned for a request.
+   * \param[in] max_entries number of responses kept, the expired ones are dropped first when
+   *   it is reached.
+   */
+  ServiceResponseCache(std::chrono::nanoseconds time_to_live, size_t max_entries)
+  : time_to_live_(time_to_live), max_entries_(max_entries)
+  {}
+
+  /// Return the key of a request.
+  /**
+   * \throws anything rclcpp::SerializationBase::serialize_message() can throw.
+   */
+  std::string
+  make_key(const Request & request) const
+  {
+    // Serialized into the buffer of the calling thread, only the key is allocated.
+    const auto & rcl_serialized_request =
+      serialization_.serialize_message(&request).get_rcl_serialized_message();
+    return std::string(
+      reinterpret_cast<const char *>(rcl_serialized_request.buffer),
+      rcl_serialized_request.buffer_length);
+  }
+
+  /// Return the response cached for a request, or null if none was or it expired.
+  SharedResponse
+  find(const std::string & key)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return nullptr;
+    }
+    if (it->second.expiry <= std::chrono::steady_clock::now()) {
+      entries_.erase(it);
+      return nullptr;
+    }
+    return it->second.response;
+  }
+
+  /// Remember the key of a request sent, until its response completes it.
+  void
+  add_pending(int64_t request_id, std::string key)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_keys_[request_id] = std::move(key);
+  }
+
+  /// Forget a request sent, e.g. as no response will be received.
+  void
+  remove_pending(int64_t request_id)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_keys_.erase(request_id);
+  }
+
+  /// Forget all the requests sent.
+  void
+  clear_pending()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_keys_.clear();
+  }
+
+  /// Cache the response to a request sent, unless it was forgotten.
+  void
+  complete(int64_t request_id, SharedResponse response)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pending_keys_.find(request_id);
+    if (it == pending_keys_.end()) {
+      return;
+    }
+    std::string key = std::move(it->second);
+    pending_keys_.erase(it);
+    if (0 == max_entries_) {
+      return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (entries_.size() >= max_entries_ && entries_.find(key) == entries_.end()) {
+      for (auto entry = entries_.begin(); entry != entries_.end(); ) {
+        entry = entry->second.expiry <= now ? entries_.erase(entry) : std::next(entry);
+      }
+      if (entries_.size() >= max_entries_) {
+        entries_.erase(entries_.begin());
+      }
+    }
+    entries_[std::move(key)] = Entry{std::move(response), now + time_to_live_};
+  }
+
+  /// Drop all the responses, including the ones of the requests in flight.
+  void
+  clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    pending_keys_.clear();
+  }
+
+  /// Return the number of responses cached, including the expired ones not dropped yet.
+  size_t
+  size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+private:
+  struct Entry
+  {
+    SharedResponse response;
+    std::chrono::steady_clock::time_point expiry;
+  };
+
+  const std::chrono::nanoseconds time_to_live_;
+  const size_t max_entries_;
+  const rclcpp::Serialization<Request> serialization_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::unordered_map<int64_t, std::string> pending_keys_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__SERVICE_RESPONSE_CACHE_HPP_
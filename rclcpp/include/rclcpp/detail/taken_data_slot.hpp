@@ -0,0 +1,70 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__TAKEN_DATA_SLOT_HPP_
+#define RCLCPP__DETAIL__TAKEN_DATA_SLOT_HPP_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Storage of the data taken by a waitable, reused once the executor releases it.
+/**
+ * rclcpp::Waitable::take_data() returns the data to execute as a std::shared_ptr<void>.
+ * A waitable which takes data for each event returns the storage of this slot, so that it is
+ * allocated once, rather than once per event, as long as the executor releases the data of an
+ * event before taking the next one.
+ * The data of concurrent events, e.g. taken by several threads of an executor, is allocated
+ * for the events finding the storage still in use.
+ *
+ * The storage is reset to a default constructed T when reused, but the waitable should
+ * release what the data holds, e.g. the messages, once executed.
+ *
+ * This class is thread-safe.
+ */
+template<typename T>
+class TakenDataSlot
+{
+public:
+  /// Return the storage for the data of the next event, holding a default constructed T.
+  std::shared_ptr<T>
+  acquire()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Only the slot creates references, so no other owner can appear once it is the last one.
+    if (storage_ && 1 == storage_.use_count()) {
+      // Synchronize with the release of the last other reference, done by another thread.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      *storage_ = T();
+      return storage_;
+    }
+    // The newest storage is kept, the one still in use is freed once released.
+    storage_ = std::make_shared<T>();
+    return storage_;
+  }
+
+private:
+  std::mutex mutex_;
+  std::shared_ptr<T> storage_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__TAKEN_DATA_SLOT_HPP_
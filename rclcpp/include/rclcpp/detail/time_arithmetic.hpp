@@ -0,0 +1,144 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__TIME_ARITHMETIC_HPP_
+#define RCLCPP__DETAIL__TIME_ARITHMETIC_HPP_
+
+#include <cstdint>
+#include <limits>
+
+#include "rcl/time.h"
+
+#include "rclcpp/visibility_control.hpp"
+
+/// Hint that a condition, e.g. an arithmetic overflow, is almost never true.
+#if defined(__GNUC__) || defined(__clang__)
+# define RCLCPP_DETAIL_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#else
+# define RCLCPP_DETAIL_UNLIKELY(condition) (condition)
+#endif
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Outcome of an operation on int64_t nanoseconds.
+enum class NanosecondsArithmeticStatus
+{
+  Ok,
+  Overflow,
+  Underflow,
+};
+
+/// Add two numbers of nanoseconds, unless the sum is not representable.
+/**
+ * \param[in] lhs the first addend.
+ * \param[in] rhs the second addend.
+ * \param[out] result the sum, only set if the status is Ok.
+ * \return whether the sum overflows, underflows or was computed.
+ */
+constexpr NanosecondsArithmeticStatus
+checked_add_nanoseconds(int64_t lhs, int64_t rhs, int64_t & result) noexcept
+{
+  if (RCLCPP_DETAIL_UNLIKELY(rhs > 0 && lhs > std::numeric_limits<int64_t>::max() - rhs)) {
+    return NanosecondsArithmeticStatus::Overflow;
+  }
+  if (RCLCPP_DETAIL_UNLIKELY(rhs < 0 && lhs < std::numeric_limits<int64_t>::min() - rhs)) {
+    return NanosecondsArithmeticStatus::Underflow;
+  }
+  result = lhs + rhs;
+  return NanosecondsArithmeticStatus::Ok;
+}
+
+/// Subtract two numbers of nanoseconds, unless the difference is not representable.
+/**
+ * \param[in] lhs the minuend.
+ * \param[in] rhs the subtrahend.
+ * \param[out] result the difference, only set if the status is Ok.
+ * \return whether the difference overflows, underflows or was computed.
+ */
+constexpr NanosecondsArithmeticStatus
+checked_subtract_nanoseconds(int64_t lhs, int64_t rhs, int64_t & result) noexcept
+{
+  if (RCLCPP_DETAIL_UNLIKELY(rhs < 0 && lhs > std::numeric_limits<int64_t>::max() + rhs)) {
+    return NanosecondsArithmeticStatus::Overflow;
+  }
+  if (RCLCPP_DETAIL_UNLIKELY(rhs > 0 && lhs < std::numeric_limits<int64_t>::min() + rhs)) {
+    return NanosecondsArithmeticStatus::Underflow;
+  }
+  result = lhs - rhs;
+  return NanosecondsArithmeticStatus::Ok;
+}
+
+/// Return the representable value closest to the result of a failed operation.
+constexpr int64_t
+saturated_nanoseconds(NanosecondsArithmeticStatus status) noexcept
+{
+  return NanosecondsArithmeticStatus::Overflow == status ?
+         std::numeric_limits<int64_t>::max() : std::numeric_limits<int64_t>::min();
+}
+
+/// Add two numbers of nanoseconds, saturating at the limits of int64_t.
+constexpr int64_t
+saturating_add_nanoseconds(int64_t lhs, int64_t rhs) noexcept
+{
+  int64_t result = 0;
+  const auto status = checked_add_nanoseconds(lhs, rhs, result);
+  return NanosecondsArithmeticStatus::Ok == status ? result : saturated_nanoseconds(status);
+}
+
+/// Subtract two numbers of nanoseconds, saturating at the limits of int64_t.
+constexpr int64_t
+saturating_subtract_nanoseconds(int64_t lhs, int64_t rhs) noexcept
+{
+  int64_t result = 0;
+  const auto status = checked_subtract_nanoseconds(lhs, rhs, result);
+  return NanosecondsArithmeticStatus::Ok == status ? result : saturated_nanoseconds(status);
+}
+
+/// Throw the exception of an operation which overflowed or underflowed.
+/**
+ * It is out of line, so that the inline arithmetic of rclcpp::Time and rclcpp::Duration does
+ * not carry the construction of the exceptions.
+ *
+ * \param[in] status Overflow or Underflow.
+ * \param[in] operation the operation, e.g. "addition", starting the message of the exception.
+ * \throws std::overflow_error if the status is Overflow
+ * \throws std::underflow_error otherwise
+ */
+[[noreturn]] RCLCPP_PUBLIC
+void
+throw_nanoseconds_arithmetic_error(NanosecondsArithmeticStatus status, const char * operation);
+
+/// Throw the exception of a comparison of times with different clock types.
+/**
+ * \throws std::runtime_error always
+ */
+[[noreturn]] RCLCPP_PUBLIC
+void
+throw_time_comparison_error();
+
+/// Throw the exception of a subtraction of times with different clock types.
+/**
+ * \throws std::runtime_error always
+ */
+[[noreturn]] RCLCPP_PUBLIC
+void
+throw_time_subtraction_error(rcl_clock_type_t lhs, rcl_clock_type_t rhs);
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__TIME_ARITHMETIC_HPP_
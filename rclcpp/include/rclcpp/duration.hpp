@@ -19,6 +19,7 @@
 
 #include "builtin_interfaces/msg/duration.hpp"
 #include "rcl/time.h"
+#include "rclcpp/detail/time_arithmetic.hpp"
 #include "rclcpp/visibility_control.hpp"
 
 namespace rclcpp
@@ -96,12 +97,28 @@ public:
   bool
   operator>(const rclcpp::Duration & rhs) const;
 
+  /**
+   * \throws std::overflow_error if addition leads to overflow
+   * \throws std::underflow_error if addition leads to underflow
+   */
   Duration
   operator+(const rclcpp::Duration & rhs) const;
 
+  /**
+   * \throws std::overflow_error if subtraction leads to overflow
+   * \throws std::underflow_error if subtraction leads to underflow
+   */
   Duration
   operator-(const rclcpp::Duration & rhs) const;
 
+  /// Add a duration, saturating at the representable limits instead of throwing.
+  Duration
+  saturating_add(const rclcpp::Duration & rhs) const noexcept;
+
+  /// Subtract a duration, saturating at the representable limits instead of throwing.
+  Duration
+  saturating_sub(const rclcpp::Duration & rhs) const noexcept;
+
   /// Get the maximum representable value.
   /**
    * \return the maximum representable value
@@ -158,6 +175,99 @@ private:
   Duration() = default;
 };
 
+// The arithmetic and the comparisons are inline, since they are used on hot paths, e.g. to
+// schedule timers and to compare stamps.
+
+inline bool
+Duration::operator==(const rclcpp::Duration & rhs) const
+{
+  return rcl_duration_.nanoseconds == rhs.rcl_duration_.nanoseconds;
+}
+
+inline bool
+Duration::operator!=(const rclcpp::Duration & rhs) const
+{
+  return rcl_duration_.nanoseconds != rhs.rcl_duration_.nanoseconds;
+}
+
+inline bool
+Duration::operator<(const rclcpp::Duration & rhs) const
+{
+  return rcl_duration_.nanoseconds < rhs.rcl_duration_.nanoseconds;
+}
+
+inline bool
+Duration::operator<=(const rclcpp::Duration & rhs) const
+{
+  return rcl_duration_.nanoseconds <= rhs.rcl_duration_.nanoseconds;
+}
+
+inline bool
+Duration::operator>=(const rclcpp::Duration & rhs) const
+{
+  return rcl_duration_.nanoseconds >= rhs.rcl_duration_.nanoseconds;
+}
+
+inline bool
+Duration::operator>(const rclcpp::Duration & rhs) const
+{
+  return rcl_duration_.nanoseconds > rhs.rcl_duration_.nanoseconds;
+}
+
+inline Duration
+Duration::operator+(const rclcpp::Duration & rhs) const
+{
+  rcl_duration_value_t result = 0;
+  const auto status = detail::checked_add_nanoseconds(
+    rcl_duration_.nanoseconds, rhs.rcl_duration_.nanoseconds, result);
+  if (RCLCPP_DETAIL_UNLIKELY(detail::NanosecondsArithmeticStatus::Ok != status)) {
+    detail::throw_nanoseconds_arithmetic_error(status, "addition");
+  }
+  return Duration::from_nanoseconds(result);
+}
+
+inline Duration
+Duration::operator-(const rclcpp::Duration & rhs) const
+{
+  rcl_duration_value_t result = 0;
+  const auto status = detail::checked_subtract_nanoseconds(
+    rcl_duration_.nanoseconds, rhs.rcl_duration_.nanoseconds, result);
+  if (RCLCPP_DETAIL_UNLIKELY(detail::NanosecondsArithmeticStatus::Ok != status)) {
+    detail::throw_nanoseconds_arithmetic_error(status, "duration subtraction");
+  }
+  return Duration::from_nanoseconds(result);
+}
+
+inline Duration
+Duration::saturating_add(const rclcpp::Duration & rhs) const noexcept
+{
+  return Duration::from_nanoseconds(
+    detail::saturating_add_nanoseconds(
+      rcl_duration_.nanoseconds, rhs.rcl_duration_.nanoseconds));
+}
+
+inline Duration
+Duration::saturating_sub(const rclcpp::Duration & rhs) const noexcept
+{
+  return Duration::from_nanoseconds(
+    detail::saturating_subtract_nanoseconds(
+      rcl_duration_.nanoseconds, rhs.rcl_duration_.nanoseconds));
+}
+
+inline rcl_duration_value_t
+Duration::nanoseconds() const
+{
+  return rcl_duration_.nanoseconds;
+}
+
+inline Duration
+Duration::from_nanoseconds(rcl_duration_value_t nanoseconds)
+{
+  Duration ret;
+  ret.rcl_duration_.nanoseconds = nanoseconds;
+  return ret;
+}
+
 }  // namespace rclcpp
 
 #endif  // RCLCPP__DURATION_HPP_
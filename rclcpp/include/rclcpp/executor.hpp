@@ -16,6 +16,7 @@
 #define RCLCPP__EXECUTOR_HPP_
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstdlib>
@@ -33,6 +34,7 @@
 
 #include "rclcpp/context.hpp"
 #include "rclcpp/contexts/default_context.hpp"
+#include "rclcpp/detail/callback_group_registry.hpp"
 #include "rclcpp/guard_condition.hpp"
 #include "rclcpp/executor_options.hpp"
 #include "rclcpp/future_return_code.hpp"
@@ -52,6 +54,11 @@ typedef std::map<rclcpp::CallbackGroup::WeakPtr,
 // Forward declaration is used in convenience method signature.
 class Node;
 
+namespace detail
+{
+class TakePipeline;
+}  // namespace detail
+
 /// Coordinate the order and timing of available communication tasks.
 /**
  * Executor provides spin functions (including spin_node_once and spin_some).
@@ -401,6 +408,53 @@ public:
   void
   set_memory_strategy(memory_strategy::MemoryStrategy::SharedPtr memory_strategy);
 
+  /// Return how often ready executables were passed over for ones of higher priority.
+  /**
+   * Every time an executable is selected under a priority scheduling policy, the number of
+   * ready executables of a lower priority which could have been executed instead is added.
+   * A steadily growing count means that low priority callback groups are being starved.
+   * The count stays 0 with ExecutorSchedulingPolicy::FixedOrder and RoundRobin.
+   *
+   * \return the accumulated number of passed over executables
+   */
+  RCLCPP_PUBLIC
+  size_t
+  get_starvation_count() const;
+
+  /// Return how many entities were dispatched while the executor was overloaded.
+  /**
+   * \see rclcpp::ExecutorOptions::overload
+   * \return the accumulated number of overloaded dispatches
+   */
+  RCLCPP_PUBLIC
+  size_t
+  get_overload_count() const;
+
+  /// Return the observer of the waits and executions, see ExecutorOptions::instrumentation.
+  RCLCPP_PUBLIC
+  rclcpp::ExecutorInstrumentation::SharedPtr
+  get_instrumentation() const;
+
+  /// Prepare the executor to spin without allocating nor page faulting in steady state.
+  /**
+   * Call this from the thread which will spin, after all nodes were added and before spinning.
+   * It:
+   *
+   *   - collects the entities of the executor, so that the memory strategy and the wait set
+   *     are sized for them,
+   *   - borrows and returns a message of every subscription, so that their message memory
+   *     strategies create their buffers, and
+   *   - faults in the stack of the calling thread, with the stack size of the real-time memory
+   *     options of the context, see InitOptions::real_time_memory().
+   *
+   * Adding or removing entities afterwards resizes the executor again on the next wait.
+   *
+   * \throws std::runtime_error if the wait set could not be prepared
+   */
+  RCLCPP_PUBLIC
+  void
+  prepare_for_real_time();
+
 protected:
   RCLCPP_PUBLIC
   void
@@ -425,19 +479,19 @@ protected:
   RCLCPP_PUBLIC
   static void
   execute_subscription(
-    rclcpp::SubscriptionBase::SharedPtr subscription);
+    const rclcpp::SubscriptionBase::SharedPtr & subscription);
 
   RCLCPP_PUBLIC
   static void
-  execute_timer(rclcpp::TimerBase::SharedPtr timer);
+  execute_timer(const rclcpp::TimerBase::SharedPtr & timer);
 
   RCLCPP_PUBLIC
   static void
-  execute_service(rclcpp::ServiceBase::SharedPtr service);
+  execute_service(const rclcpp::ServiceBase::SharedPtr & service);
 
   RCLCPP_PUBLIC
   static void
-  execute_client(rclcpp::ClientBase::SharedPtr client);
+  execute_client(const rclcpp::ClientBase::SharedPtr & client);
 
   /**
    * \throws std::runtime_error if the wait set can be cleared
@@ -446,6 +500,16 @@ protected:
   void
   wait_for_work(std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1));
 
+  /// Wait on the filled wait set polling first, see ExecutorOptions::busy_poll.
+  /**
+   * \param[in] timeout how long to wait at most, negative to wait without a timeout
+   * \param[out] stage stage of the wait in which it returned
+   * \return the return code of the last call to rcl_wait()
+   */
+  RCLCPP_PUBLIC
+  rcl_ret_t
+  busy_poll_wait(std::chrono::nanoseconds timeout, WaitStage & stage);
+
   RCLCPP_PUBLIC
   rclcpp::node_interfaces::NodeBaseInterface::SharedPtr
   get_node_by_group(
@@ -521,11 +585,65 @@ protected:
   virtual void
   add_callback_groups_from_nodes_associated_to_executor() RCPPUTILS_TSA_REQUIRES(mutex_);
 
+  /// Trigger the interrupt guard condition, unless a previous trigger is still pending.
+  /**
+   * A trigger is pending from the time it triggers the guard condition until the wait woken up
+   * by it calls consume_interrupt_guard_condition_trigger(), so that a burst of interruptions,
+   * e.g. adding many nodes, wakes the wait once.
+   *
+   * \return the return code of rcl_trigger_guard_condition(), RCL_RET_OK if a trigger is pending
+   */
+  RCLCPP_PUBLIC
+  rcl_ret_t
+  trigger_interrupt_guard_condition();
+
+  /// Let the next trigger_interrupt_guard_condition() trigger the guard condition again.
+  /**
+   * This must be called after each wait on the interrupt guard condition, before checking what
+   * the wait may have been interrupted for.
+   */
+  RCLCPP_PUBLIC
+  void
+  consume_interrupt_guard_condition_trigger();
+
+  /// Let the callback group of an executable be taken from again after its execution.
+  /**
+   * \throws std::runtime_error if there is an issue triggering the guard condition
+   */
+  RCLCPP_PUBLIC
+  void
+  release_callback_group(AnyExecutable & any_exec);
+
+  /// Apply the overload policy of the callback group of an executable, if it is overloaded.
+  /**
+   * Must be called before the executable is executed, if the overload is detected.
+   *
+   * \param[in] any_exec the executable to be executed
+   * \param[out] skip_stale_messages true if only the latest message of the subscription of the
+   *   executable must be handled
+   * \return true if the executable was shed and must not be executed
+   */
+  RCLCPP_PUBLIC
+  bool
+  apply_overload_policy(AnyExecutable & any_exec, bool & skip_stale_messages);
+
+  /// Report a wait for work on wait_set_ to the instrumentation, which must not be null.
+  /**
+   * Must be called right after the wait, so that the dispatch latencies of the executions
+   * which follow are measured from its end.
+   *
+   * \param[in] wait_start time at which the wait started
+   */
+  RCLCPP_PUBLIC
+  void
+  report_wait(std::chrono::steady_clock::time_point wait_start);
+
   /// Spinning state, used to prevent multi threaded calls to spin and to cancel blocking spins.
   std::atomic_bool spinning;
 
   /// Guard condition for signaling the rmw layer to wake up for special events.
   rcl_guard_condition_t interrupt_guard_condition_ = rcl_get_zero_initialized_guard_condition();
+  std::atomic_bool interrupt_guard_condition_trigger_pending_{false};
 
   std::shared_ptr<rclcpp::GuardCondition> shutdown_guard_condition_;
 
@@ -557,6 +675,15 @@ protected:
   WeakNodesToGuardConditionsMap
   weak_nodes_to_guard_conditions_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
 
+  typedef std::map<rclcpp::node_interfaces::NodeBaseInterface::WeakPtr,
+      std::shared_ptr<std::atomic_bool>,
+      std::owner_less<rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>>
+    WeakNodesToNotifyFlagsMap;
+
+  /// maps nodes to the flags set by their notifications, with shared node notifications
+  WeakNodesToNotifyFlagsMap
+  weak_nodes_to_notify_flags_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+
   /// maps callback groups associated to nodes
   WeakCallbackGroupsToNodesMap
   weak_groups_associated_with_executor_to_nodes_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
@@ -569,10 +696,66 @@ protected:
   WeakCallbackGroupsToNodesMap
   weak_groups_to_nodes_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
 
+  /// ids of all callback groups of weak_groups_to_nodes_ and of their nodes
+  rclcpp::detail::CallbackGroupRegistry group_registry_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+
   /// nodes that are associated with the executor
   std::list<rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>
   weak_nodes_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
 
+  /// True if callback groups, nodes or entities changed since the entities were last collected.
+  /**
+   * While this is false, wait_for_work() asks the memory strategy to reuse the entities of the
+   * previous collection instead of walking every node and callback group again.
+   * It is set when a callback group or node is added, when one is removed and the memory
+   * strategy cannot drop its entities alone, when the memory strategy is replaced, and when the
+   * notify guard condition of an associated node was triggered.
+   */
+  std::atomic_bool entities_need_rebuild_{true};
+
+  /// Order in which ready executables are dispatched, see ExecutorOptions.
+  const ExecutorSchedulingPolicy scheduling_policy_;
+
+  /// Number of ready executables passed over for ones of higher priority.
+  std::atomic_size_t starvation_count_{0};
+
+  /// Number of threads currently in wait_for_work().
+  std::atomic_size_t threads_waiting_for_work_{0};
+
+  /// Observer of the waits and executions, null if they are not measured.
+  const rclcpp::ExecutorInstrumentation::SharedPtr instrumentation_;
+
+  /// Polling done before blocking in wait_for_work(), see ExecutorOptions.
+  const BusyPollOptions busy_poll_;
+
+  /// Limits beyond which the executor is overloaded, see ExecutorOptions.
+  const OverloadOptions overload_;
+
+  /// True if any limit of overload_ is set.
+  const bool detects_overload_;
+
+  /// Number of entities found ready by the last wait for work, if the overload is detected.
+  std::atomic_size_t last_wait_ready_count_{0};
+
+  /// Number of executables dispatched since the last wait for work.
+  std::atomic_size_t dispatched_since_wait_{0};
+
+  /// Number of executables dispatched while the executor was overloaded.
+  std::atomic_size_t overload_count_{0};
+
+  /// Whether the nodes notify through the interrupt guard condition, see ExecutorOptions.
+  const bool shared_node_notifications_;
+
+  /// Set by a node notification until wait_for_work() checks the flags of the nodes.
+  std::atomic_bool node_notifications_pending_{false};
+
+  /// Threads taking messages ahead of the callbacks, null if there are none, see ExecutorOptions.
+  std::unique_ptr<rclcpp::detail::TakePipeline> take_pipeline_;
+
+  /// End of the last wait for work in nanoseconds of the steady clock, if instrumented or if
+  /// the overload is detected.
+  std::atomic<int64_t> last_wait_end_nanoseconds_{0};
+
   /// shutdown callback handle registered to Context
   rclcpp::OnShutdownCallbackHandle shutdown_callback_handle_;
 };
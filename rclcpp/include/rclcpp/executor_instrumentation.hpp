@@ -0,0 +1,294 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXECUTOR_INSTRUMENTATION_HPP_
+#define RCLCPP__EXECUTOR_INSTRUMENTATION_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/topic_statistics/hdr_histogram.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+
+class CallbackGroup;
+class ClientBase;
+class ServiceBase;
+class SubscriptionBase;
+class TimerBase;
+class Waitable;
+
+/// Kind of the entity whose callback an executor executed.
+enum class ExecutableType
+{
+  Timer,
+  Subscription,
+  Service,
+  Client,
+  Waitable,
+};
+
+/// Stage of a wait for work in which an executor found an entity ready, see BusyPollOptions.
+enum class WaitStage
+{
+  /// Polling back to back.
+  Spin,
+  /// Polling after yielding the CPU.
+  Yield,
+  /// Blocked in the middleware, the only stage when busy polling is disabled.
+  Block,
+};
+
+/// Measurement of the execution of a ready entity by an executor.
+struct ExecutableExecution
+{
+  ExecutableType type;
+  /// Address of the rclcpp::TimerBase, SubscriptionBase, ServiceBase, ClientBase or Waitable.
+  const void * entity;
+  const rclcpp::CallbackGroup * callback_group;
+  /// Time from the end of the wait which found the entity ready to the start of its execution.
+  std::chrono::nanoseconds dispatch_latency;
+  /// Time taken by the execution, including taking the message, request or response.
+  std::chrono::nanoseconds duration;
+  /// Budget of the execution, 0 for none, see rclcpp::CallbackGroup::set_execution_budget().
+  std::chrono::nanoseconds budget{0};
+};
+
+/// Observer of the waits and executions of an executor, see ExecutorOptions::instrumentation.
+/**
+ * The methods are called by the threads of the executor, right after the wait or execution they
+ * report, so they must be thread-safe and should return quickly.
+ */
+class ExecutorInstrumentation
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(ExecutorInstrumentation)
+
+  RCLCPP_PUBLIC
+  virtual ~ExecutorInstrumentation();
+
+  /// Called after each wait for work, with the time spent blocked in the wait.
+  RCLCPP_PUBLIC
+  virtual void
+  on_wait(std::chrono::nanoseconds wait_duration);
+
+  /// Called after each wait for work, right after on_wait(), with the size of its wait set.
+  /**
+   * \param[in] wait_set_size number of subscriptions, timers, services, clients, events and
+   *   guard conditions waited on
+   * \param[in] ready_count number of them found ready by the wait
+   */
+  RCLCPP_PUBLIC
+  virtual void
+  on_wait_result(size_t wait_set_size, size_t ready_count);
+
+  /// Called after each execution of a ready entity.
+  RCLCPP_PUBLIC
+  virtual void
+  on_execute(const ExecutableExecution & execution);
+
+  /// Called for each expired timer found by a wait, with the time elapsed since it expired.
+  /**
+   * \param[in] stage stage of the wait which found the timer ready
+   * \param[in] latency time from the expiry of the timer to the end of the wait
+   */
+  RCLCPP_PUBLIC
+  virtual void
+  on_wake_up(WaitStage stage, std::chrono::nanoseconds latency);
+};
+
+/// Accumulated durations of the executions of an entity or a callback group, or of the waits.
+struct ExecutionStatistics
+{
+  uint64_t count = 0u;
+  std::chrono::nanoseconds total_duration{0};
+  std::chrono::nanoseconds max_duration{0};
+  std::chrono::nanoseconds total_dispatch_latency{0};
+  std::chrono::nanoseconds max_dispatch_latency{0};
+  /// Number of executions which took longer than their budget.
+  uint64_t overrun_count = 0u;
+};
+
+/// Instrumentation accumulating the execution statistics of each entity and callback group.
+/**
+ * The statistics are accumulated in atomic counters, found in fixed-size tables indexed by the
+ * address of the entity or callback group, so that reporting an execution never locks nor
+ * allocates.
+ * Once the tables are full, the executions of the entities and callback groups which are not
+ * tracked yet are only counted by get_untracked_execution_count().
+ * The statistics are indexed by address, an entity created at the address of a destroyed one
+ * shares its statistics.
+ *
+ * The statistics can be queried from any thread, while the executor is spinning.
+ */
+class ExecutionStatisticsCollector : public ExecutorInstrumentation
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(ExecutionStatisticsCollector)
+
+  /// Statistics of an entity, see get_all_entity_statistics().
+  struct EntityStatistics
+  {
+    ExecutableType type;
+    const void * entity;
+    ExecutionStatistics statistics;
+  };
+
+  /**
+   * \param[in] max_entities number of entities, and of callback groups, which are tracked
+   */
+  RCLCPP_PUBLIC
+  explicit ExecutionStatisticsCollector(size_t max_entities = 1024u);
+
+  RCLCPP_PUBLIC
+  virtual ~ExecutionStatisticsCollector();
+
+  RCLCPP_PUBLIC
+  void
+  on_wait(std::chrono::nanoseconds wait_duration) override;
+
+  RCLCPP_PUBLIC
+  void
+  on_execute(const ExecutableExecution & execution) override;
+
+  RCLCPP_PUBLIC
+  void
+  on_wake_up(WaitStage stage, std::chrono::nanoseconds latency) override;
+
+  /// Return the statistics of the executions of an entity.
+  RCLCPP_PUBLIC
+  ExecutionStatistics
+  get_entity_statistics(const rclcpp::TimerBase * timer) const;
+
+  RCLCPP_PUBLIC
+  ExecutionStatistics
+  get_entity_statistics(const rclcpp::SubscriptionBase * subscription) const;
+
+  RCLCPP_PUBLIC
+  ExecutionStatistics
+  get_entity_statistics(const rclcpp::ServiceBase * service) const;
+
+  RCLCPP_PUBLIC
+  ExecutionStatistics
+  get_entity_statistics(const rclcpp::ClientBase * client) const;
+
+  RCLCPP_PUBLIC
+  ExecutionStatistics
+  get_entity_statistics(const rclcpp::Waitable * waitable) const;
+
+  /// Return the statistics of all the executed entities, e.g. to find the slowest callbacks.
+  RCLCPP_PUBLIC
+  std::vector<EntityStatistics>
+  get_all_entity_statistics() const;
+
+  /// Return the statistics of the executions of the entities of a callback group.
+  RCLCPP_PUBLIC
+  ExecutionStatistics
+  get_callback_group_statistics(const rclcpp::CallbackGroup * callback_group) const;
+
+  /// Return the statistics of the waits, whose dispatch latencies are 0.
+  RCLCPP_PUBLIC
+  ExecutionStatistics
+  get_wait_statistics() const;
+
+  /// Return the number of executions of entities or callback groups which are not tracked.
+  RCLCPP_PUBLIC
+  uint64_t
+  get_untracked_execution_count() const;
+
+  /// Return the histogram of the wake-up latencies, in nanoseconds, of a stage of the waits.
+  /**
+   * The wake-up latency is the time from the expiry of a timer to the end of the wait which
+   * found it ready, see ExecutorInstrumentation::on_wake_up().
+   * Comparing the histograms of the stages helps sizing the stages of BusyPollOptions.
+   */
+  RCLCPP_PUBLIC
+  const rclcpp::topic_statistics::HdrHistogram &
+  get_wake_up_latency_histogram(WaitStage stage) const;
+
+private:
+  struct Counters
+  {
+    std::atomic<uint64_t> count{0u};
+    std::atomic<int64_t> total_duration{0};
+    std::atomic<int64_t> max_duration{0};
+    std::atomic<int64_t> total_dispatch_latency{0};
+    std::atomic<int64_t> max_dispatch_latency{0};
+    std::atomic<uint64_t> overrun_count{0u};
+
+    void
+    add(
+      std::chrono::nanoseconds dispatch_latency, std::chrono::nanoseconds duration,
+      bool overrun);
+
+    ExecutionStatistics
+    load() const;
+  };
+
+  struct Slot
+  {
+    std::atomic<const void *> key{nullptr};
+    std::atomic<ExecutableType> type{ExecutableType::Timer};
+    Counters counters;
+  };
+
+  /// Open addressing hash table, whose slots are claimed once and never released.
+  class SlotTable
+  {
+  public:
+    explicit SlotTable(size_t max_keys);
+
+    /// Return the slot of the key, claiming a free slot for a new key, or null if full.
+    Slot *
+    find_or_claim(const void * key);
+
+    const Slot *
+    find(const void * key) const;
+
+    size_t
+    size() const;
+
+    const Slot &
+    at(size_t index) const;
+
+  private:
+    size_t
+    first_index(const void * key) const;
+
+    size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+  };
+
+  ExecutionStatistics
+  get_statistics(const void * entity) const;
+
+  SlotTable entities_;
+  SlotTable callback_groups_;
+  Counters waits_;
+  std::atomic<uint64_t> untracked_execution_count_{0u};
+  /// Indexed by WaitStage.
+  std::array<rclcpp::topic_statistics::HdrHistogram, 3> wake_up_latencies_;
+};
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXECUTOR_INSTRUMENTATION_HPP_
@@ -15,8 +15,11 @@
 #ifndef RCLCPP__EXECUTOR_OPTIONS_HPP_
 #define RCLCPP__EXECUTOR_OPTIONS_HPP_
 
+#include <chrono>
+
 #include "rclcpp/context.hpp"
 #include "rclcpp/contexts/default_context.hpp"
+#include "rclcpp/executor_instrumentation.hpp"
 #include "rclcpp/memory_strategies.hpp"
 #include "rclcpp/memory_strategy.hpp"
 #include "rclcpp/visibility_control.hpp"
@@ -24,18 +27,121 @@
 namespace rclcpp
 {
 
+/// Order in which an executor dispatches the executables which are ready at the same time.
+enum class ExecutorSchedulingPolicy
+{
+  /// Timers first, then subscriptions, services, clients and waitables.
+  FixedOrder,
+  /// Highest callback group priority first, in fixed order between equal priorities.
+  Priority,
+  /// Like Priority, but timers of equal priority are ordered by earliest deadline first.
+  PriorityEarliestDeadlineFirst,
+  /// Like FixedOrder, but the ready entities of each kind take turns.
+  /**
+   * Each kind keeps a cursor on the entity executed last, the next ready entity after it is
+   * executed next, so an entity which is always ready cannot starve the others of its kind.
+   * An entity is executed up to the scheduling weight of its callback group times in a row,
+   * see CallbackGroup::set_scheduling_weight().
+   */
+  RoundRobin,
+};
+
+/// Polling done by an executor waiting for work, see ExecutorOptions::busy_poll.
+/**
+ * Instead of blocking in the middleware right away, the executor polls the readiness of its
+ * entities with waits whose timeout is zero, first back to back, then yielding the CPU between
+ * them, and only then blocks for the rest of the timeout.
+ * It trades CPU time for the latency of waking a blocked thread up, e.g. for a high rate loop
+ * on an isolated core.
+ * The wake-up latencies of each stage are reported by ExecutorInstrumentation::on_wake_up().
+ */
+struct BusyPollOptions
+{
+  /// Poll before blocking, when true.
+  bool enabled = false;
+  /// Number of polls done back to back, spinning on the CPU.
+  size_t spin_iterations = 1000u;
+  /// Number of polls done after the spinning ones, yielding the CPU before each of them.
+  size_t yield_iterations = 100u;
+};
+
+/// Limits beyond which an executor is overloaded, see ExecutorOptions::overload.
+/**
+ * An executor which is overloaded applies the overload policy of the callback group of each
+ * entity it dispatches, see rclcpp::CallbackGroup::set_overload_policy(), and reports the
+ * dispatch to its backpressure callback, see rclcpp::CallbackGroup::set_backpressure_callback().
+ * Each limit is disabled when it is 0, the default, so the executor is never overloaded.
+ */
+struct OverloadOptions
+{
+  /// Number of entities found ready by a wait which are dispatched before being overloaded.
+  /**
+   * The entities dispatched after these ones, e.g. the ones of the lowest priorities with a
+   * priority scheduling policy, are overloaded.
+   */
+  size_t max_ready_count = 0u;
+  /// Longest time from the end of the wait which found an entity ready to its dispatch.
+  std::chrono::nanoseconds max_dispatch_lag{0};
+};
+
 /// Options to be passed to the executor constructor.
 struct ExecutorOptions
 {
   ExecutorOptions()
   : memory_strategy(rclcpp::memory_strategies::create_default_strategy()),
     context(rclcpp::contexts::get_global_default_context()),
-    max_conditions(0)
+    max_conditions(0),
+    scheduling_policy(ExecutorSchedulingPolicy::FixedOrder)
   {}
 
   rclcpp::memory_strategy::MemoryStrategy::SharedPtr memory_strategy;
   rclcpp::Context::SharedPtr context;
   size_t max_conditions;
+  ExecutorSchedulingPolicy scheduling_policy;
+  /// Observer of the waits and executions, e.g. an ExecutionStatisticsCollector.
+  /**
+   * Nothing is measured when it is null, the default.
+   * Executors which execute entities through Executor::execute_any_executable() report them,
+   * the static and events executors do not.
+   */
+  rclcpp::ExecutorInstrumentation::SharedPtr instrumentation;
+  /// Polling done before blocking in a wait for work, disabled by default.
+  /**
+   * Executors which wait through Executor::wait_for_work() poll, the static and events
+   * executors do not.
+   */
+  BusyPollOptions busy_poll;
+  /// Number of threads taking and deserializing messages ahead of the callbacks, 0 for none.
+  /**
+   * With pipeline threads, while the callback of a subscription handles a message, a pipeline
+   * thread takes and deserializes its next messages, up to its maximum number of messages per
+   * take, so that deserializing large messages is not on the critical path of the callbacks.
+   * The callbacks are still called in the order of the messages, by the executor thread,
+   * within the constraints of their callback group.
+   * It only applies to the subscriptions taking more than one message per execution, see
+   * SubscriptionOptionsBase::max_messages_per_take, which take ROS messages that are neither
+   * loaned, rate limited, nor only the latest ones.
+   * Executors which execute entities through Executor::execute_any_executable() use it, the
+   * static and events executors do not.
+   */
+  size_t take_pipeline_threads = 0;
+  /// Whether the nodes notify their changes to the executor through its interrupt guard condition.
+  /**
+   * By default, the executor waits on the notify guard condition of each of its nodes, so its
+   * wait set grows with the number of nodes.
+   * With shared notifications, a node sets its own flag and triggers the interrupt guard
+   * condition instead, so the wait set holds the same guard conditions whatever the number of
+   * nodes, and the executor only collects the entities again when a flag is set.
+   * Executors which wait through Executor::wait_for_work() use it, the static and events
+   * executors, and the multi threaded executor with several wait sets, do not.
+   */
+  bool shared_node_notifications = false;
+  /// Limits beyond which the executor is overloaded, none by default.
+  /**
+   * Executors which execute entities through Executor::execute_any_executable() detect it, the
+   * static and events executors do not.
+   */
+  OverloadOptions overload;
 };
 
 }  // namespace rclcpp
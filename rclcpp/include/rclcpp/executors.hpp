@@ -18,9 +18,15 @@
 #include <future>
 #include <memory>
 
+#include "rclcpp/executors/events_executor.hpp"
 #include "rclcpp/executors/multi_threaded_executor.hpp"
+#include "rclcpp/executors/shared_thread_pool.hpp"
 #include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rclcpp/executors/static_multi_threaded_executor.hpp"
 #include "rclcpp/executors/static_single_threaded_executor.hpp"
+#include "rclcpp/executors/thread_affinity_executor.hpp"
+#include "rclcpp/executors/time_triggered_executor.hpp"
+#include "rclcpp/executors/work_stealing_multi_threaded_executor.hpp"
 #include "rclcpp/node.hpp"
 #include "rclcpp/utilities.hpp"
 #include "rclcpp/visibility_control.hpp"
@@ -51,8 +57,12 @@ spin(rclcpp::Node::SharedPtr node_ptr);
 namespace executors
 {
 
+using rclcpp::executors::EventsExecutor;
 using rclcpp::executors::MultiThreadedExecutor;
 using rclcpp::executors::SingleThreadedExecutor;
+using rclcpp::executors::StaticMultiThreadedExecutor;
+using rclcpp::executors::ThreadAffinityExecutor;
+using rclcpp::executors::WorkStealingMultiThreadedExecutor;
 
 /// Spin (blocking) until the future is complete, it times out waiting, or rclcpp is interrupted.
 /**
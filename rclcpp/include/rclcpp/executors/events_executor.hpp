@@ -0,0 +1,272 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXECUTORS__EVENTS_EXECUTOR_HPP_
+#define RCLCPP__EXECUTORS__EVENTS_EXECUTOR_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "rclcpp/callback_group.hpp"
+#include "rclcpp/client.hpp"
+#include "rclcpp/executor.hpp"
+#include "rclcpp/experimental/timers_manager.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/service.hpp"
+#include "rclcpp/subscription_base.hpp"
+#include "rclcpp/timer.hpp"
+#include "rclcpp/visibility_control.hpp"
+#include "rclcpp/waitable.hpp"
+
+namespace rclcpp
+{
+namespace executors
+{
+
+/// Single-threaded executor which is driven by the "new data" listeners of its entities.
+/**
+ * Instead of building and waiting on a wait set with all the entities of its callback groups,
+ * this executor registers a listener callback on every subscription, service, client and
+ * waitable it is given.
+ * The middleware calls these listeners when new data arrives and each call pushes one event
+ * into a queue, which the spinning thread pops and dispatches.
+ * The cost of a cycle is therefore proportional to the number of events, not to the number of
+ * entities.
+ *
+ * Timers are scheduled by a rclcpp::experimental::TimersManager, which pushes an event for
+ * every expired timer, from its own thread while spin() runs and from the spinning thread for
+ * the other spin functions.
+ * Their callbacks are executed by the spinning thread like the other events.
+ * Timers using a ROS time source do not follow jumps of simulated time, see TimersManager.
+ *
+ * Waitables which do not implement Waitable::set_on_ready_callback() cannot be executed and are
+ * skipped with a warning.
+ * Nodes and callback groups can be added and removed while spinning, changes to the entities
+ * of a node are noticed through the notify guard condition of the node.
+ */
+class EventsExecutor : public rclcpp::Executor
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(EventsExecutor)
+
+  /// Default constructor. See the default constructor for Executor.
+  RCLCPP_PUBLIC
+  explicit EventsExecutor(
+    const rclcpp::ExecutorOptions & options = rclcpp::ExecutorOptions());
+
+  /// Default destructor.
+  RCLCPP_PUBLIC
+  virtual ~EventsExecutor();
+
+  /// Execute events and timers as they become ready, until the executor is cancelled.
+  /**
+   * \sa rclcpp::Executor:spin() for more details
+   * \throws std::runtime_error when spin() called while already spinning
+   */
+  RCLCPP_PUBLIC
+  void
+  spin() override;
+
+  /// Execute the events and timers which are ready, without blocking.
+  /**
+   * \sa rclcpp::Executor::spin_some() for more details
+   */
+  RCLCPP_PUBLIC
+  void
+  spin_some(std::chrono::nanoseconds max_duration = std::chrono::nanoseconds(0)) override;
+
+  /// Execute events and timers until none are ready or max_duration has elapsed.
+  /**
+   * \sa rclcpp::Executor::spin_all() for more details
+   */
+  RCLCPP_PUBLIC
+  void
+  spin_all(std::chrono::nanoseconds max_duration) override;
+
+  /// Return a file descriptor which becomes readable when events are ready to be dispatched.
+  /**
+   * It lets an external event loop, e.g. based on epoll, asio or libuv, drive this executor
+   * from its own thread instead of a thread blocked in spin(): the descriptor is polled with
+   * the other descriptors of the loop, and dispatch_ready() is called once it is readable.
+   * It is owned by the executor and stays valid until the executor is destroyed.
+   *
+   * Expiring timers do not make it readable, the loop should also wake up after
+   * get_next_timer_timeout() to call dispatch_ready().
+   *
+   * \return the descriptor of an eventfd, created on the first call.
+   * \throws std::runtime_error if the platform is not Linux, which is the only one supported.
+   * \throws std::system_error if the eventfd could not be created.
+   */
+  RCLCPP_PUBLIC
+  int
+  get_ready_fd();
+
+  /// Execute the events and timers which are ready, without blocking.
+  /**
+   * The descriptor of get_ready_fd() is reset first, so the events which become ready while
+   * this runs make it readable again.
+   *
+   * \throws std::runtime_error if the executor is spinning in another thread.
+   */
+  RCLCPP_PUBLIC
+  void
+  dispatch_ready();
+
+  /// Return the time until the next timer expires, to be used as the timeout of an event loop.
+  /**
+   * \return the time until the next timer expires, 0 if one already expired, or a negative
+   *   duration if there is no timer.
+   */
+  RCLCPP_PUBLIC
+  std::chrono::nanoseconds
+  get_next_timer_timeout();
+
+protected:
+  RCLCPP_PUBLIC
+  void
+  remove_callback_group_from_map(
+    rclcpp::CallbackGroup::SharedPtr group_ptr,
+    WeakCallbackGroupsToNodesMap & weak_groups_to_nodes,
+    bool notify = true) override RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  RCLCPP_PUBLIC
+  void
+  spin_once_impl(std::chrono::nanoseconds timeout) override;
+
+private:
+  RCLCPP_DISABLE_COPY(EventsExecutor)
+
+  enum class ExecutorEventType
+  {
+    SUBSCRIPTION_EVENT,
+    SERVICE_EVENT,
+    CLIENT_EVENT,
+    WAITABLE_EVENT,
+    TIMER_EVENT
+  };
+
+  /// Notification pushed by the listener of an entity.
+  struct ExecutorEvent
+  {
+    /// Address of the entity, used to look it up without keeping it alive.
+    const void * entity_key;
+    ExecutorEventType type;
+    /// Number of messages, requests, responses or events which became ready.
+    size_t num_events;
+  };
+
+  template<typename EntityT>
+  using EntityMap = std::unordered_map<const void *, std::weak_ptr<EntityT>>;
+
+  /// Push an event into the queue and wake the spinning thread.
+  void
+  push_event(const ExecutorEvent & event);
+
+  /// Make the descriptor of get_ready_fd() readable, if it was created.
+  void
+  signal_ready_fd();
+
+  /// Wait until an event is queued, the executor is notified, or the timeout elapses.
+  /**
+   * The queued events are moved to the back of ready_events_.
+   *
+   * \param[in] timeout how long to wait at most, negative to wait without a timeout
+   */
+  void
+  wait_for_events(std::chrono::nanoseconds timeout);
+
+  /// Execute the ready events until none is left, spinning stops or the deadline has passed.
+  /**
+   * Events which were not executed are put back into the queue.
+   *
+   * \return true if any event was executed
+   */
+  bool
+  execute_events(std::chrono::steady_clock::time_point deadline);
+
+  void
+  execute_event(const ExecutorEvent & event);
+
+  /// Put the events which were not executed back to the front of the queue.
+  void
+  requeue_ready_events();
+
+  void
+  spin_ready_events(std::chrono::nanoseconds max_duration, bool exhaustive);
+
+  /// Add the callback groups of associated nodes and update the listeners if entities changed.
+  void
+  refresh_entities_if_needed();
+
+  /// Register the listeners of new entities and unregister the ones of removed entities.
+  /**
+   * \param[in] weak_groups_to_nodes the callback groups whose entities should have a listener
+   */
+  void
+  refresh_entities(const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes)
+  RCPPUTILS_TSA_REQUIRES(mutex_);
+
+  /// Wait on the notify guard conditions of the nodes and signal changes to the spinning thread.
+  void
+  run_entities_watcher();
+
+  /// Look up an entity registered with the given key, nullptr if it was removed or destroyed.
+  template<typename EntityT>
+  std::shared_ptr<EntityT>
+  get_entity(const EntityMap<EntityT> & entities, const void * entity_key)
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    auto it = entities.find(entity_key);
+    if (it == entities.end()) {
+      return nullptr;
+    }
+    return it->second.lock();
+  }
+
+  std::mutex events_queue_mutex_;
+  std::condition_variable events_queue_cv_;
+  std::deque<ExecutorEvent> events_queue_;
+  /// True if the spinning thread should wake up without an event, e.g. for cancel().
+  bool notified_ = false;
+
+  std::mutex ready_fd_mutex_;
+  /// Descriptor returned by get_ready_fd(), -1 until it is created.
+  std::atomic_int ready_fd_{-1};
+
+  /// Events taken from the queue, only used by the spinning thread.
+  std::deque<ExecutorEvent> ready_events_;
+
+  EntityMap<rclcpp::SubscriptionBase> subscriptions_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+  EntityMap<rclcpp::ServiceBase> services_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+  EntityMap<rclcpp::ClientBase> clients_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+  EntityMap<rclcpp::Waitable> waitables_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+  EntityMap<rclcpp::TimerBase> timers_ RCPPUTILS_TSA_GUARDED_BY(mutex_);
+
+  std::unique_ptr<rclcpp::experimental::TimersManager> timers_manager_;
+
+  std::atomic_bool stop_entities_watcher_{false};
+  std::thread entities_watcher_thread_;
+};
+
+}  // namespace executors
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXECUTORS__EVENTS_EXECUTOR_HPP_
@@ -0,0 +1,429 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXECUTORS__FIXED_TOPOLOGY_EXECUTOR_HPP_
+#define RCLCPP__EXECUTORS__FIXED_TOPOLOGY_EXECUTOR_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "rcl/wait.h"
+#include "rcpputils/scope_exit.hpp"
+
+#include "rclcpp/client.hpp"
+#include "rclcpp/context.hpp"
+#include "rclcpp/contexts/default_context.hpp"
+#include "rclcpp/exceptions.hpp"
+#include "rclcpp/guard_condition.hpp"
+#include "rclcpp/logging.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/message_info.hpp"
+#include "rclcpp/service.hpp"
+#include "rclcpp/subscription_base.hpp"
+#include "rclcpp/timer.hpp"
+#include "rclcpp/utilities.hpp"
+#include "rclcpp/wait_set.hpp"
+
+namespace rclcpp
+{
+namespace executors
+{
+
+/// Kind of an entity of a FixedTopologyExecutor.
+enum class FixedTopologyEntityKind
+{
+  Subscription,
+  Timer,
+  Service,
+  Client,
+  Unsupported,
+};
+
+/// Return the kind of an entity type, at compile time.
+template<typename EntityT>
+constexpr FixedTopologyEntityKind
+get_fixed_topology_entity_kind()
+{
+  if (std::is_base_of<rclcpp::SubscriptionBase, EntityT>::value) {
+    return FixedTopologyEntityKind::Subscription;
+  }
+  if (std::is_base_of<rclcpp::TimerBase, EntityT>::value) {
+    return FixedTopologyEntityKind::Timer;
+  }
+  if (std::is_base_of<rclcpp::ServiceBase, EntityT>::value) {
+    return FixedTopologyEntityKind::Service;
+  }
+  if (std::is_base_of<rclcpp::ClientBase, EntityT>::value) {
+    return FixedTopologyEntityKind::Client;
+  }
+  return FixedTopologyEntityKind::Unsupported;
+}
+
+namespace detail
+{
+
+/// Layout of the entities of a FixedTopologyExecutor, computed at compile time.
+template<typename ... EntitiesT>
+struct FixedTopologyLayout
+{
+  /// Kinds of the entities, in the order of the type list.
+  static constexpr FixedTopologyEntityKind kinds[] = {
+    get_fixed_topology_entity_kind<EntitiesT>()...
+  };
+
+  /// Return the number of entities of a kind.
+  static constexpr size_t
+  count(FixedTopologyEntityKind kind)
+  {
+    size_t number = 0u;
+    for (FixedTopologyEntityKind entity_kind : kinds) {
+      number += entity_kind == kind ? 1u : 0u;
+    }
+    return number;
+  }
+
+  /// Return the index of an entity among the ones of its kind, i.e. in the rcl wait set.
+  static constexpr size_t
+  index_in_kind(size_t entity_index)
+  {
+    size_t index = 0u;
+    for (size_t i = 0u; i < entity_index; ++i) {
+      index += kinds[i] == kinds[entity_index] ? 1u : 0u;
+    }
+    return index;
+  }
+
+  /// Return the index in the type list of the i-th entity of a kind.
+  static constexpr size_t
+  entity_index(FixedTopologyEntityKind kind, size_t index)
+  {
+    for (size_t i = 0u; i < sizeof...(EntitiesT); ++i) {
+      if (kinds[i] == kind && 0u == index--) {
+        return i;
+      }
+    }
+    return sizeof...(EntitiesT);
+  }
+};
+
+}  // namespace detail
+
+/// Executor of a set of entities known at compile time.
+/**
+ * The entities are given as a list of their concrete types, e.g.
+ * `rclcpp::Subscription<MessageT>` or `rclcpp::WallTimer<CallbackT>`, and are never added nor
+ * removed.
+ * So, unlike the other executors:
+ *
+ *   - the wait set is an rclcpp::StaticWaitSet, whose sizes are computed at compile time,
+ *   - the ready entities are found by an unrolled sequence of checks, one per entity,
+ *   - the entities are executed through their concrete types, without virtual dispatch,
+ *   - there are no callback groups, nodes, maps nor memory strategy to go through.
+ *
+ * This is meant for fixed function processes, e.g. controllers on embedded targets, whose
+ * entities are created once at startup, after which each cycle has a minimal overhead.
+ *
+ * Subscriptions, timers, services and clients are supported.
+ * The intra process communication, the loaned messages and the waitables, e.g. the events of
+ * the entities, are not: an intra process subscription only receives the messages published
+ * from other processes.
+ * The entities are executed in the order of the type list, from a single thread.
+ *
+ * \tparam EntitiesT concrete types of the entities.
+ */
+template<typename ... EntitiesT>
+class FixedTopologyExecutor
+{
+  static_assert(sizeof...(EntitiesT) > 0u, "a fixed topology executor needs entities");
+  static_assert(
+    ((get_fixed_topology_entity_kind<EntitiesT>() != FixedTopologyEntityKind::Unsupported) &&
+    ...),
+    "the entities of a fixed topology executor must be subscriptions, timers, services or clients");
+
+  using Layout = detail::FixedTopologyLayout<EntitiesT...>;
+
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(FixedTopologyExecutor)
+
+  static constexpr size_t number_of_subscriptions =
+    Layout::count(FixedTopologyEntityKind::Subscription);
+  static constexpr size_t number_of_timers = Layout::count(FixedTopologyEntityKind::Timer);
+  static constexpr size_t number_of_services = Layout::count(FixedTopologyEntityKind::Service);
+  static constexpr size_t number_of_clients = Layout::count(FixedTopologyEntityKind::Client);
+
+  /// Wait set of the executor, with a guard condition to interrupt it.
+  using WaitSet = rclcpp::StaticWaitSet<
+    number_of_subscriptions, 1u, number_of_timers, number_of_clients, number_of_services, 0u>;
+
+  /// Constructor, with the default context.
+  explicit FixedTopologyExecutor(std::shared_ptr<EntitiesT>... entities)
+  : FixedTopologyExecutor(
+      rclcpp::contexts::get_global_default_context(), std::move(entities)...)
+  {}
+
+  /// Constructor.
+  /**
+   * \param[in] context the context of the entities, whose shutdown interrupts spin().
+   * \param[in] entities the entities to execute.
+   * \throws std::invalid_argument if an entity is null.
+   */
+  explicit FixedTopologyExecutor(
+    rclcpp::Context::SharedPtr context,
+    std::shared_ptr<EntitiesT>... entities)
+  : FixedTopologyExecutor(
+      std::make_index_sequence<number_of_subscriptions>(),
+      std::make_index_sequence<number_of_timers>(),
+      std::make_index_sequence<number_of_clients>(),
+      std::make_index_sequence<number_of_services>(),
+      std::move(context),
+      std::make_tuple(std::move(entities)...))
+  {}
+
+  ~FixedTopologyExecutor()
+  {
+    context_->remove_on_shutdown_callback(shutdown_callback_handle_);
+  }
+
+  /// Wait for ready entities and execute them, each at most once.
+  /**
+   * \param[in] timeout maximum time to wait, or a negative duration to wait without limit.
+   * \return true if the wait was not timed out nor interrupted, i.e. entities were ready,
+   *   unless their data was already taken.
+   */
+  template<typename RepT = int64_t, typename PeriodT = std::nano>
+  bool
+  spin_once(std::chrono::duration<RepT, PeriodT> timeout = std::chrono::duration<RepT, PeriodT>(-1))
+  {
+    auto wait_result = wait_set_.wait(timeout);
+    if (wait_result.kind() != rclcpp::WaitResultKind::Ready) {
+      return false;
+    }
+    const rcl_wait_set_t & rcl_wait_set = wait_result.get_wait_set().get_rcl_wait_set();
+    if (nullptr != rcl_wait_set.guard_conditions[0]) {
+      return false;
+    }
+    execute_ready_entities(rcl_wait_set, std::index_sequence_for<EntitiesT...>());
+    return true;
+  }
+
+  /// Execute the entities as they become ready, until cancel() or the shutdown of the context.
+  /**
+   * \throws std::runtime_error if the executor is already spinning.
+   */
+  void
+  spin()
+  {
+    if (spinning_.exchange(true)) {
+      throw std::runtime_error("spin() called while already spinning");
+    }
+    RCPPUTILS_SCOPE_EXIT(this->spinning_.store(false););
+    while (rclcpp::ok(context_) && spinning_.load()) {
+      spin_once();
+    }
+  }
+
+  /// Make spin() return, and interrupt a wait in progress.
+  void
+  cancel()
+  {
+    spinning_.store(false);
+    interrupt_guard_condition_->trigger();
+  }
+
+  /// Return the entities, in the order of the type list.
+  const std::tuple<std::shared_ptr<EntitiesT>...> &
+  get_entities() const
+  {
+    return entities_;
+  }
+
+private:
+  RCLCPP_DISABLE_COPY(FixedTopologyExecutor)
+
+  template<size_t ... SubscriptionIs, size_t ... TimerIs, size_t ... ClientIs, size_t ... ServiceIs>
+  FixedTopologyExecutor(
+    std::index_sequence<SubscriptionIs...>,
+    std::index_sequence<TimerIs...>,
+    std::index_sequence<ClientIs...>,
+    std::index_sequence<ServiceIs...>,
+    rclcpp::Context::SharedPtr context,
+    std::tuple<std::shared_ptr<EntitiesT>...> entities)
+  : context_(std::move(context)),
+    entities_(std::move(entities)),
+    interrupt_guard_condition_(std::make_shared<rclcpp::GuardCondition>(context_)),
+    wait_set_(
+      {{std::shared_ptr<rclcpp::SubscriptionBase>(
+          get_entity<FixedTopologyEntityKind::Subscription, SubscriptionIs>())...}},
+      {{interrupt_guard_condition_}},
+      {{std::shared_ptr<rclcpp::TimerBase>(
+          get_entity<FixedTopologyEntityKind::Timer, TimerIs>())...}},
+      {{std::shared_ptr<rclcpp::ClientBase>(
+          get_entity<FixedTopologyEntityKind::Client, ClientIs>())...}},
+      {{std::shared_ptr<rclcpp::ServiceBase>(
+          get_entity<FixedTopologyEntityKind::Service, ServiceIs>())...}},
+      {},
+      context_)
+  {
+    std::apply(
+      [](const auto & ... entity) {
+        if (((nullptr == entity) || ...)) {
+          throw std::invalid_argument("the entities of a fixed topology executor must not be null");
+        }
+      }, entities_);
+    std::weak_ptr<rclcpp::GuardCondition> weak_guard_condition = interrupt_guard_condition_;
+    shutdown_callback_handle_ = context_->add_on_shutdown_callback(
+      [weak_guard_condition]() {
+        auto guard_condition = weak_guard_condition.lock();
+        if (guard_condition) {
+          guard_condition->trigger();
+        }
+      });
+  }
+
+  /// Return the i-th entity of a kind.
+  template<FixedTopologyEntityKind KindT, size_t IndexT>
+  const auto &
+  get_entity() const
+  {
+    return std::get<Layout::entity_index(KindT, IndexT)>(entities_);
+  }
+
+  template<size_t ... Is>
+  void
+  execute_ready_entities(const rcl_wait_set_t & rcl_wait_set, std::index_sequence<Is...>)
+  {
+    (execute_if_ready<Is>(rcl_wait_set), ...);
+  }
+
+  /// Execute an entity if it is ready, through its concrete type.
+  template<size_t I>
+  void
+  execute_if_ready(const rcl_wait_set_t & rcl_wait_set)
+  {
+    using EntityT = std::tuple_element_t<I, std::tuple<EntitiesT...>>;
+    constexpr FixedTopologyEntityKind kind = Layout::kinds[I];
+    constexpr size_t index = Layout::index_in_kind(I);
+    EntityT & entity = *std::get<I>(entities_);
+    if constexpr (kind == FixedTopologyEntityKind::Subscription) {
+      if (nullptr != rcl_wait_set.subscriptions[index]) {
+        execute_subscription(entity);
+      }
+    } else if constexpr (kind == FixedTopologyEntityKind::Timer) {
+      if (nullptr != rcl_wait_set.timers[index] && entity.EntityT::call()) {
+        entity.EntityT::execute_callback();
+      }
+    } else if constexpr (kind == FixedTopologyEntityKind::Service) {
+      if (nullptr != rcl_wait_set.services[index]) {
+        execute_service(entity);
+      }
+    } else {
+      if (nullptr != rcl_wait_set.clients[index]) {
+        execute_client(entity);
+      }
+    }
+  }
+
+  template<typename SubscriptionT>
+  static void
+  execute_subscription(SubscriptionT & subscription)
+  {
+    rclcpp::MessageInfo message_info;
+    message_info.get_rmw_message_info().from_intra_process = false;
+    try {
+      if (subscription.is_serialized()) {
+        auto message = subscription.SubscriptionT::create_serialized_message();
+        if (subscription.take_serialized(*message, message_info)) {
+          subscription.SubscriptionT::handle_serialized_message(message, message_info);
+        }
+        subscription.SubscriptionT::return_serialized_message(message);
+        return;
+      }
+      std::shared_ptr<void> message = subscription.SubscriptionT::create_message();
+      if (subscription.take_type_erased(message.get(), message_info)) {
+        subscription.SubscriptionT::handle_message(message, message_info);
+      }
+      subscription.SubscriptionT::return_message(message);
+    } catch (const rclcpp::exceptions::RCLError & rcl_error) {
+      RCLCPP_ERROR(
+        rclcpp::get_logger("rclcpp"),
+        "fixed topology executor taking a message from topic '%s' unexpectedly failed: %s",
+        subscription.get_topic_name(), rcl_error.what());
+    }
+  }
+
+  template<typename ServiceT>
+  static void
+  execute_service(ServiceT & service)
+  {
+    auto request_header = service.ServiceT::create_request_header();
+    std::shared_ptr<void> request = service.ServiceT::create_request();
+    try {
+      if (service.take_type_erased_request(request.get(), *request_header)) {
+        service.ServiceT::handle_request(request_header, request);
+      }
+    } catch (const rclcpp::exceptions::RCLError & rcl_error) {
+      RCLCPP_ERROR(
+        rclcpp::get_logger("rclcpp"),
+        "fixed topology executor taking a request from service '%s' unexpectedly failed: %s",
+        service.get_service_name(), rcl_error.what());
+    }
+  }
+
+  template<typename ClientT>
+  static void
+  execute_client(ClientT & client)
+  {
+    auto request_header = client.ClientT::create_request_header();
+    std::shared_ptr<void> response = client.ClientT::create_response();
+    try {
+      if (client.take_type_erased_response(response.get(), *request_header)) {
+        client.ClientT::handle_response(request_header, response);
+      }
+    } catch (const rclcpp::exceptions::RCLError & rcl_error) {
+      RCLCPP_ERROR(
+        rclcpp::get_logger("rclcpp"),
+        "fixed topology executor taking a response from service '%s' unexpectedly failed: %s",
+        client.get_service_name(), rcl_error.what());
+    }
+  }
+
+  rclcpp::Context::SharedPtr context_;
+  std::tuple<std::shared_ptr<EntitiesT>...> entities_;
+  rclcpp::GuardCondition::SharedPtr interrupt_guard_condition_;
+  WaitSet wait_set_;
+  rclcpp::OnShutdownCallbackHandle shutdown_callback_handle_;
+  std::atomic_bool spinning_{false};
+};
+
+/// Create a FixedTopologyExecutor, whose entity types are deduced from the arguments.
+/**
+ * \param[in] entities the entities to execute, e.g. the subscriptions and the timers of a node.
+ */
+template<typename ... EntitiesT>
+typename FixedTopologyExecutor<EntitiesT...>::UniquePtr
+make_fixed_topology_executor(std::shared_ptr<EntitiesT>... entities)
+{
+  return std::make_unique<FixedTopologyExecutor<EntitiesT...>>(std::move(entities)...);
+}
+
+}  // namespace executors
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXECUTORS__FIXED_TOPOLOGY_EXECUTOR_HPP_
@@ -16,13 +16,20 @@
 #define RCLCPP__EXECUTORS__MULTI_THREADED_EXECUTOR_HPP_
 
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <thread>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "rclcpp/any_executable.hpp"
 #include "rclcpp/executor.hpp"
+#include "rclcpp/executors/shared_thread_pool.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/memory_strategies.hpp"
 #include "rclcpp/visibility_control.hpp"
@@ -32,6 +39,21 @@ namespace rclcpp
 namespace executors
 {
 
+/// Executor which executes the ready callbacks with a pool of threads.
+/**
+ * By default the threads take turns waiting on a single wait set, so only one thread waits or
+ * takes a ready executable at a time.
+ * With several wait sets, the callback groups are partitioned across the wait sets, each of
+ * them waited on by its own thread, which queues the ready executables for the threads of the
+ * pool.
+ * The waits of unrelated callback groups then run in parallel.
+ * A callback group stays in the wait set it was first assigned to, the one with the fewest
+ * callback groups, until it is removed from the executor.
+ *
+ * With a SharedThreadPool, see set_thread_pool(), the thread calling spin() waits on the wait
+ * set and the threads of the pool execute the ready executables, at most the number of
+ * threads of the executor at a time.
+ */
 class MultiThreadedExecutor : public rclcpp::Executor
 {
 public:
@@ -50,13 +72,17 @@ public:
    *   the default 0 will use the number of cpu cores found instead
    * \param yield_before_execute if true std::this_thread::yield() is called
    * \param timeout maximum time to wait
+   * \param number_of_wait_sets number of wait sets the callback groups are partitioned across
+   *   by spin(), each with its own waiting thread in addition to the thread pool, the default 1
+   *   lets the threads of the pool take turns waiting instead
    */
   RCLCPP_PUBLIC
   MultiThreadedExecutor(
     const rclcpp::ExecutorOptions & options = rclcpp::ExecutorOptions(),
     size_t number_of_threads = 0,
     bool yield_before_execute = false,
-    std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1));
+    std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1),
+    size_t number_of_wait_sets = 1);
 
   RCLCPP_PUBLIC
   virtual ~MultiThreadedExecutor();
@@ -73,6 +99,26 @@ public:
   size_t
   get_number_of_threads();
 
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_wait_sets() const;
+
+  /// Execute the callbacks with a pool of threads shared with other executors.
+  /**
+   * No thread is created by spin() then, besides the one calling it, which waits for the
+   * ready executables, and the number of threads of the executor is the maximum number of its
+   * executables executed by the pool at the same time.
+   * spin() returns once the executables given to the pool were executed.
+   *
+   * \param[in] thread_pool the pool, e.g. SharedThreadPool::get_global_instance(), or nullptr
+   *   for the executor to create its own threads again.
+   * \throws std::runtime_error if the executor is spinning.
+   * \throws std::invalid_argument if the executor has several wait sets.
+   */
+  RCLCPP_PUBLIC
+  void
+  set_thread_pool(SharedThreadPool::SharedPtr thread_pool);
+
 protected:
   RCLCPP_PUBLIC
   void
@@ -81,10 +127,60 @@ protected:
 private:
   RCLCPP_DISABLE_COPY(MultiThreadedExecutor)
 
+  /// Wait set of a part of the callback groups, see number_of_wait_sets.
+  class WaitSetShard;
+
+  /// spin() with several wait sets.
+  void
+  spin_sharded();
+
+  /// spin() with a shared thread pool.
+  void
+  spin_with_thread_pool();
+
+  /// Wait on a wait set and queue its ready executables, until spinning stops.
+  void
+  run_waiter(size_t wait_set_index);
+
+  /// Execute the queued executables, until spinning stops.
+  void
+  run_worker();
+
+  /// Assign the new callback groups to the wait sets, and forget the removed ones.
+  /**
+   * \param[in] nodes_changed true to collect the entities of all the wait sets again
+   */
+  void
+  update_wait_set_shards(bool nodes_changed);
+
+  /// Stop the waiting threads and the thread pool.
+  void
+  stop_wait_set_shards();
+
   std::mutex wait_mutex_;
   size_t number_of_threads_;
   bool yield_before_execute_;
   std::chrono::nanoseconds next_exec_timeout_;
+
+  std::vector<std::unique_ptr<WaitSetShard>> shards_;
+  /// Callback groups of each wait set, protected by mutex_.
+  std::vector<rclcpp::WeakCallbackGroupsToNodesMap> shard_callback_groups_;
+  /// Notify guard conditions of the nodes waited on by the first wait set, protected by mutex_.
+  WeakNodesToGuardConditionsMap shard_node_guard_conditions_;
+
+  std::mutex ready_mutex_;
+  std::condition_variable ready_condition_;
+  std::deque<std::pair<WaitSetShard *, std::unique_ptr<rclcpp::AnyExecutable>>>
+  ready_executables_;
+  bool shards_stopped_{false};
+
+  SharedThreadPool::SharedPtr thread_pool_;
+  std::mutex thread_pool_mutex_;
+  std::condition_variable thread_pool_condition_;
+  /// Number of executables given to the thread pool and not executed yet.
+  size_t thread_pool_executions_{0};
+  /// First exception thrown by an executable executed by the thread pool.
+  std::exception_ptr thread_pool_error_;
 };
 
 }  // namespace executors
@@ -0,0 +1,96 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXECUTORS__SHARED_THREAD_POOL_HPP_
+#define RCLCPP__EXECUTORS__SHARED_THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace executors
+{
+
+/// Pool of threads shared by several executors of a process.
+/**
+ * Executors attached to the same pool, see MultiThreadedExecutor::set_thread_pool(), execute
+ * their callbacks on its threads instead of creating their own, so that the number of threads
+ * of the process tracks the number of cores however many executors it runs.
+ * Each executor keeps its number of threads as a quota of its callbacks executed at the same
+ * time, so that one executor cannot take all the threads of the pool.
+ *
+ * The tasks are executed in the order they are submitted.
+ * This class is thread-safe.
+ */
+class SharedThreadPool
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(SharedThreadPool)
+
+  /// Constructor.
+  /**
+   * \param[in] number_of_threads number of threads of the pool, the default 0 uses the
+   *   number of cpu cores found instead.
+   */
+  RCLCPP_PUBLIC
+  explicit SharedThreadPool(size_t number_of_threads = 0);
+
+  /// Destructor, executing the submitted tasks before joining the threads.
+  /**
+   * It must not be called by a task of the pool.
+   */
+  RCLCPP_PUBLIC
+  ~SharedThreadPool();
+
+  /// Get the pool shared by the whole process, created with one thread per cpu core.
+  RCLCPP_PUBLIC
+  static SharedPtr
+  get_global_instance();
+
+  /// Execute a task on a thread of the pool.
+  /**
+   * The task must not throw.
+   */
+  RCLCPP_PUBLIC
+  void
+  submit(std::function<void ()> task);
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_threads() const;
+
+private:
+  /// Execute the submitted tasks, until the pool is destroyed.
+  void
+  run();
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::function<void ()>> tasks_;
+  bool stopped_{false};
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace executors
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXECUTORS__SHARED_THREAD_POOL_HPP_
@@ -38,6 +38,11 @@ namespace executors
 /// Single-threaded executor implementation.
 /**
  * This is the default executor created by rclcpp::spin.
+ *
+ * As long as no node, callback group or entity is added or removed, dispatching a ready
+ * executable does not allocate memory in the executor itself.
+ * Subscriptions still get their messages from their message memory strategy, which allocates
+ * unless a preallocating one, like the MessagePoolMemoryStrategy, is used.
  */
 class SingleThreadedExecutor : public rclcpp::Executor
 {
@@ -283,7 +283,67 @@ public:
   rclcpp::Waitable::SharedPtr
   get_waitable(size_t i) {return exec_list_.waitable[i];}
 
+  /// Return the executable list, with the entities found ready by the last refresh_wait_set().
+  /**
+   * It is valid until the next execution of the collector, which may replace its entities.
+   */
+  RCLCPP_PUBLIC
+  const rclcpp::experimental::ExecutableList &
+  get_executable_list() const {return exec_list_;}
+
+  /// Return the callback group of a subscription by index.
+  /**
+   * \param[in] i The index of the subscription, as in get_subscription()
+   * \return the callback group, which may have been destroyed in the meantime
+   */
+  RCLCPP_PUBLIC
+  rclcpp::CallbackGroup::WeakPtr
+  get_subscription_group(size_t i) {return groups_.subscription[i];}
+
+  /// Return the callback group of a timer by index, \see get_subscription_group()
+  RCLCPP_PUBLIC
+  rclcpp::CallbackGroup::WeakPtr
+  get_timer_group(size_t i) {return groups_.timer[i];}
+
+  /// Return the callback group of a service by index, \see get_subscription_group()
+  RCLCPP_PUBLIC
+  rclcpp::CallbackGroup::WeakPtr
+  get_service_group(size_t i) {return groups_.service[i];}
+
+  /// Return the callback group of a client by index, \see get_subscription_group()
+  RCLCPP_PUBLIC
+  rclcpp::CallbackGroup::WeakPtr
+  get_client_group(size_t i) {return groups_.client[i];}
+
+  /// Return the callback group of a waitable by index, \see get_subscription_group()
+  /**
+   * The waitable of the collector itself has no callback group.
+   */
+  RCLCPP_PUBLIC
+  rclcpp::CallbackGroup::WeakPtr
+  get_waitable_group(size_t i) {return groups_.waitable[i];}
+
 private:
+  /// Callback groups of the entities of an executable list, at the same index.
+  struct CallbackGroupList
+  {
+    void
+    clear()
+    {
+      subscription.clear();
+      timer.clear();
+      service.clear();
+      client.clear();
+      waitable.clear();
+    }
+
+    std::vector<rclcpp::CallbackGroup::WeakPtr> subscription;
+    std::vector<rclcpp::CallbackGroup::WeakPtr> timer;
+    std::vector<rclcpp::CallbackGroup::WeakPtr> service;
+    std::vector<rclcpp::CallbackGroup::WeakPtr> client;
+    std::vector<rclcpp::CallbackGroup::WeakPtr> waitable;
+  };
+
   /// Function to reallocate space for entities in the wait set.
   /**
    * \throws std::runtime_error if wait set couldn't be cleared or resized.
@@ -291,11 +351,33 @@ private:
   void
   prepare_wait_set();
 
-  void
-  fill_executable_list();
+  /// Collect the entities of the callback groups and replace exec_list_ if they changed.
+  /**
+   * \return true if exec_list_ changed
+   */
+  bool
+  update_executable_list();
 
+  /// Drop the entities of the callback groups removed since the last wait from exec_list_.
+  /**
+   * The entities of the other callback groups are kept as they are, without collecting them
+   * again.
+   *
+   * \return true if any entity was dropped
+   */
+  bool
+  remove_entities_of_removed_callback_groups();
+
+  /// Remove the callback groups of which the group or the node was destroyed.
   void
-  fill_memory_strategy();
+  remove_invalid_callback_groups(WeakCallbackGroupsToNodesMap & weak_groups_to_nodes);
+
+  /// Add the handles of exec_list_ and the guard conditions of the executor to the wait set.
+  /**
+   * \return false if any of the handles couldn't be added
+   */
+  bool
+  add_handles_to_wait_set();
 
   /// Return true if the node belongs to the collector
   /**
@@ -317,7 +399,10 @@ private:
   add_callback_groups_from_nodes_associated_to_executor();
 
   void
-  fill_executable_list_from_map(const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes);
+  fill_executable_list_from_map(
+    const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes,
+    rclcpp::experimental::ExecutableList & exec_list,
+    CallbackGroupList & groups);
 
   /// Memory strategy: an interface for handling user-defined memory allocation strategies.
   rclcpp::memory_strategy::MemoryStrategy::SharedPtr memory_strategy_;
@@ -336,15 +421,22 @@ private:
   /// List of weak nodes registered in the static executor
   std::list<rclcpp::node_interfaces::NodeBaseInterface::WeakPtr> weak_nodes_;
 
-  // Mutex to protect vector of new nodes.
+  // Mutex to protect vector of new nodes and the one of removed callback groups.
   std::mutex new_nodes_mutex_;
   std::vector<rclcpp::node_interfaces::NodeBaseInterface::WeakPtr> new_nodes_;
+  /// Callback groups removed from another thread, dropped from exec_list_ before the next wait.
+  std::vector<rclcpp::CallbackGroup::WeakPtr> removed_callback_groups_;
 
   /// Wait set for managing entities that the rmw layer waits on.
   rcl_wait_set_t * p_wait_set_ = nullptr;
 
   /// Executable list: timers, subscribers, clients, services and waitables
   rclcpp::experimental::ExecutableList exec_list_;
+  /// List the entities are collected into, swapped with exec_list_ when they changed.
+  rclcpp::experimental::ExecutableList next_exec_list_;
+  /// Callback groups of the entities of exec_list_ and next_exec_list_.
+  CallbackGroupList groups_;
+  CallbackGroupList next_groups_;
 
   /// Bool to check if the entities collector has been initialized
   bool initialized_ = false;
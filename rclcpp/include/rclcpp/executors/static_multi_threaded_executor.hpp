@@ -0,0 +1,133 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXECUTORS__STATIC_MULTI_THREADED_EXECUTOR_HPP_
+#define RCLCPP__EXECUTORS__STATIC_MULTI_THREADED_EXECUTOR_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "rclcpp/any_executable.hpp"
+#include "rclcpp/executors/static_single_threaded_executor.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace executors
+{
+
+/// Multi-threaded executor waiting on the fixed wait set of the static executor.
+/**
+ * The entities are collected by a rclcpp::executors::StaticExecutorEntitiesCollector, as in the
+ * rclcpp::executors::StaticSingleThreadedExecutor, so a wait only costs filling the wait set
+ * from the cached handles.
+ * After a wait, the thread which waited queues every ready executable, and the threads of the
+ * pool take them from that queue.
+ *
+ * Mutually exclusive callback groups are taken with the atomic flag of the group,
+ * rclcpp::CallbackGroup::can_be_taken_from(), when an executable is queued and released once it
+ * was executed.
+ * Ready executables of a group which is taken stay ready in the wait set and are queued after
+ * the group was released.
+ *
+ * spin_some(), spin_all() and spin_once() execute from the calling thread only, as in the
+ * rclcpp::executors::StaticSingleThreadedExecutor.
+ */
+class StaticMultiThreadedExecutor : public StaticSingleThreadedExecutor
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(StaticMultiThreadedExecutor)
+
+  /// Constructor for StaticMultiThreadedExecutor.
+  /**
+   * \param options common options for all executors
+   * \param number_of_threads number of threads to have in the thread pool,
+   *   the default 0 will use the number of cpu cores found instead
+   * \param timeout maximum time to wait
+   */
+  RCLCPP_PUBLIC
+  explicit StaticMultiThreadedExecutor(
+    const rclcpp::ExecutorOptions & options = rclcpp::ExecutorOptions(),
+    size_t number_of_threads = 0,
+    std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1));
+
+  RCLCPP_PUBLIC
+  virtual ~StaticMultiThreadedExecutor();
+
+  /**
+   * \sa rclcpp::Executor:spin() for more details
+   * \throws std::runtime_error when spin() called while already spinning
+   */
+  RCLCPP_PUBLIC
+  void
+  spin() override;
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_threads();
+
+protected:
+  RCLCPP_PUBLIC
+  void
+  run(size_t this_thread_number);
+
+  /// Take the next queued executable, waiting for work and queuing it if none is left.
+  /**
+   * Must be called with wait_mutex_ held.
+   *
+   * \param[out] any_exec the executable taken, left untouched if nothing was found
+   * \return true if an executable was taken, otherwise false
+   */
+  RCLCPP_PUBLIC
+  bool
+  get_next_ready_executable(rclcpp::AnyExecutable & any_exec);
+
+  /// Queue the ready executables of the wait set, taking their mutually exclusive groups.
+  /**
+   * Must be called with wait_mutex_ held, after the wait set was refreshed.
+   *
+   * \return true if a ready executable was left in the wait set because its group is taken
+   */
+  RCLCPP_PUBLIC
+  bool
+  queue_ready_executables();
+
+private:
+  RCLCPP_DISABLE_COPY(StaticMultiThreadedExecutor)
+
+  /// Notify the thread waiting for a callback group to be released.
+  void
+  notify_group_released();
+
+  std::mutex wait_mutex_;
+  size_t number_of_threads_;
+  std::chrono::nanoseconds next_exec_timeout_;
+  /// Executables queued after a wait, guarded by wait_mutex_.
+  std::deque<rclcpp::AnyExecutable> ready_executables_;
+
+  std::mutex released_mutex_;
+  std::condition_variable released_cv_;
+  /// Incremented every time an executable was executed and its callback group released.
+  uint64_t released_count_ = 0;
+};
+
+}  // namespace executors
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXECUTORS__STATIC_MULTI_THREADED_EXECUTOR_HPP_
@@ -202,6 +202,11 @@ protected:
   bool
   execute_ready_executables(bool spin_once = false);
 
+  /// Wait for work with the entities collector, reporting the wait to the instrumentation.
+  RCLCPP_PUBLIC
+  void
+  refresh_wait_set(std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1));
+
   RCLCPP_PUBLIC
   void
   spin_some_impl(std::chrono::nanoseconds max_duration, bool exhaustive);
@@ -210,10 +215,10 @@ protected:
   void
   spin_once_impl(std::chrono::nanoseconds timeout) override;
 
+  StaticExecutorEntitiesCollector::SharedPtr entities_collector_;
+
 private:
   RCLCPP_DISABLE_COPY(StaticSingleThreadedExecutor)
-
-  StaticExecutorEntitiesCollector::SharedPtr entities_collector_;
 };
 
 }  // namespace executors
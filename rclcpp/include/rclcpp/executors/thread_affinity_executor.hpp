@@ -0,0 +1,206 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXECUTORS__THREAD_AFFINITY_EXECUTOR_HPP_
+#define RCLCPP__EXECUTORS__THREAD_AFFINITY_EXECUTOR_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "rclcpp/callback_group.hpp"
+#include "rclcpp/executor.hpp"
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/node_interfaces/node_base_interface.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace executors
+{
+
+/// Executor which runs selected callback groups on dedicated, optionally pinned, threads.
+/**
+ * Each worker is a thread with its own wait set, which only waits on the callback groups
+ * assigned to that worker with add_callback_group_to_worker().
+ * A slow callback group can therefore not delay the groups of another worker.
+ * The worker threads can be pinned to a set of CPUs and be given a SCHED_FIFO priority, both
+ * are only supported on Linux.
+ *
+ * Callback groups which are not assigned to a worker, e.g. the ones of a node added with
+ * add_node(), are executed by the thread calling spin(), as the SingleThreadedExecutor would.
+ *
+ * On machines with several NUMA nodes, make_numa_worker_options() creates a pool of workers
+ * per NUMA node, and add_callback_group_to_numa_node() keeps a callback group on the NUMA node
+ * where its data is produced.
+ * The workers of a NUMA node can also prefer the memory of that node for their allocations,
+ * e.g. for the messages published from their callbacks.
+ * A subscription with an IntraProcessBufferType::SharedPtr buffer copies the messages it
+ * requires the ownership of in the thread executing it, so on its own NUMA node.
+ */
+class ThreadAffinityExecutor : public rclcpp::Executor
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(ThreadAffinityExecutor)
+
+  /// Options of one worker thread.
+  struct WorkerOptions
+  {
+    /// CPUs the worker thread may run on, empty to keep the affinity of the spinning thread.
+    std::vector<size_t> cpu_affinity;
+    /// SCHED_FIFO priority of the worker thread, 0 to keep the default scheduling policy.
+    int sched_fifo_priority = 0;
+    /// NUMA node of the worker, see add_callback_group_to_numa_node(), -1 for none.
+    int numa_node = -1;
+    /// True for the worker thread to allocate from the memory of its NUMA node.
+    /**
+     * The memory of the node is preferred, the kernel falls back to other nodes when it is
+     * exhausted.
+     */
+    bool prefer_numa_node_memory = false;
+  };
+
+  /// Return the CPUs of each NUMA node of the machine, indexed by NUMA node.
+  /**
+   * Where the topology is unknown, a single node with all the CPUs is returned.
+   */
+  RCLCPP_PUBLIC
+  static std::vector<std::vector<size_t>>
+  get_numa_node_cpus();
+
+  /// Create the options of a pool of workers per NUMA node.
+  /**
+   * The workers are pinned to the CPUs of their NUMA node and, by default, prefer its memory.
+   * The workers of NUMA node n have the indices [n * threads_per_numa_node,
+   * (n + 1) * threads_per_numa_node).
+   *
+   * \param[in] threads_per_numa_node number of workers created for each NUMA node
+   * \param[in] prefer_numa_node_memory false to keep the default memory policy, e.g. when the
+   *   workers allocate memory consumed on all the NUMA nodes
+   */
+  RCLCPP_PUBLIC
+  static std::vector<WorkerOptions>
+  make_numa_worker_options(size_t threads_per_numa_node = 1, bool prefer_numa_node_memory = true);
+
+  /// Constructor for ThreadAffinityExecutor.
+  /**
+   * \param options common options for all executors, the context is shared with the workers
+   * \param workers options of the worker threads, one thread is created for each entry
+   */
+  RCLCPP_PUBLIC
+  explicit ThreadAffinityExecutor(
+    const rclcpp::ExecutorOptions & options = rclcpp::ExecutorOptions(),
+    std::vector<WorkerOptions> workers = std::vector<WorkerOptions>());
+
+  RCLCPP_PUBLIC
+  virtual ~ThreadAffinityExecutor();
+
+  /// Assign a callback group to a worker thread.
+  /**
+   * If the callback group was added to this executor before, it is moved to the worker.
+   *
+   * \param[in] group_ptr a shared ptr that points to a callback group
+   * \param[in] node_ptr a shared pointer that points to a node base interface
+   * \param[in] worker_index index of the worker in the options given to the constructor
+   * \param[in] notify True to trigger the interrupt guard condition during this function
+   * \throws std::out_of_range if there is no worker with the given index
+   * \throws std::runtime_error if the callback group is associated to another executor
+   */
+  RCLCPP_PUBLIC
+  void
+  add_callback_group_to_worker(
+    rclcpp::CallbackGroup::SharedPtr group_ptr,
+    rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr,
+    size_t worker_index,
+    bool notify = true);
+
+  /// Assign a callback group to the least loaded worker of a NUMA node.
+  /**
+   * The workers of a NUMA node are the ones whose options have that numa_node, and the load
+   * of a worker is the number of callback groups assigned to it.
+   *
+   * \param[in] group_ptr a shared ptr that points to a callback group
+   * \param[in] node_ptr a shared pointer that points to a node base interface
+   * \param[in] numa_node NUMA node the callback group is executed on
+   * \param[in] notify True to trigger the interrupt guard condition during this function
+   * \return the index of the worker the callback group was assigned to
+   * \throws std::out_of_range if no worker is on the given NUMA node
+   * \throws std::runtime_error if the callback group is associated to another executor
+   */
+  RCLCPP_PUBLIC
+  size_t
+  add_callback_group_to_numa_node(
+    rclcpp::CallbackGroup::SharedPtr group_ptr,
+    rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr,
+    int numa_node,
+    bool notify = true);
+
+  /// Remove a callback group from a worker thread.
+  /**
+   * \param[in] group_ptr a shared ptr that points to a callback group
+   * \param[in] worker_index index of the worker the group was assigned to
+   * \param[in] notify True to trigger the interrupt guard condition during this function
+   * \throws std::out_of_range if there is no worker with the given index
+   * \throws std::runtime_error if the callback group is not assigned to that worker
+   */
+  RCLCPP_PUBLIC
+  void
+  remove_callback_group_from_worker(
+    rclcpp::CallbackGroup::SharedPtr group_ptr,
+    size_t worker_index,
+    bool notify = true);
+
+  /// Spin the worker threads and the callback groups not assigned to a worker.
+  /**
+   * Blocks until the executor is cancelled or its context is shut down, and only returns once
+   * all worker threads have stopped.
+   *
+   * \sa rclcpp::Executor:spin() for more details
+   * \throws std::runtime_error when spin() called while already spinning
+   * \throws std::system_error if the affinity or priority of a worker could not be set
+   */
+  RCLCPP_PUBLIC
+  void
+  spin() override;
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_workers() const;
+
+protected:
+  /// Apply the options of a worker to the calling thread.
+  /**
+   * \throws std::system_error if the affinity, priority or memory policy could not be set
+   * \throws std::runtime_error if options were requested which are not supported on this
+   *   platform
+   */
+  RCLCPP_PUBLIC
+  static void
+  apply_worker_options(const WorkerOptions & options);
+
+  RCLCPP_PUBLIC
+  void
+  run_worker(size_t worker_index);
+
+private:
+  RCLCPP_DISABLE_COPY(ThreadAffinityExecutor)
+
+  std::vector<WorkerOptions> worker_options_;
+  std::vector<std::unique_ptr<rclcpp::executors::SingleThreadedExecutor>> worker_executors_;
+};
+
+}  // namespace executors
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXECUTORS__THREAD_AFFINITY_EXECUTOR_HPP_
@@ -0,0 +1,187 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXECUTORS__TIME_TRIGGERED_EXECUTOR_HPP_
+#define RCLCPP__EXECUTORS__TIME_TRIGGERED_EXECUTOR_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/callback_group.hpp"
+#include "rclcpp/clock.hpp"
+#include "rclcpp/executor.hpp"
+#include "rclcpp/executors/static_single_threaded_executor.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/node_interfaces/node_base_interface.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace executors
+{
+
+/// Executor running a cyclic schedule of callback groups, for deterministic control loops.
+/**
+ * The cycle is divided in slots, each running a callback group, e.g. a control loop from 0 to
+ * 2 ms and a state estimation from 2 to 3 ms of a 5 ms cycle.
+ * At the start of a slot, measured with the clock of the executor, the entities of its callback
+ * group which are ready are collected without blocking and executed once, so the data used by
+ * a slot is the data received before it started, whatever arrives during the cycle.
+ * A slot which ends after its end time is reported as an overrun, see set_overrun_callback(),
+ * and the next slots start late, until the schedule catches up.
+ * When a whole cycle is missed, the schedule skips to the next cycle instead of running the
+ * missed ones back to back.
+ *
+ * Each callback group keeps the fixed entity list of a StaticSingleThreadedExecutor, so that
+ * starting a slot does not collect the entities again.
+ * A callback group may run in several slots of the cycle.
+ * Nodes and callback groups can only be added through add_slot().
+ *
+ * The executor only checks whether it was cancelled between slots.
+ */
+class TimeTriggeredExecutor : public rclcpp::Executor
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(TimeTriggeredExecutor)
+
+  /// A slot which ended after its end time.
+  struct Overrun
+  {
+    /// Index of the slot, as returned by add_slot().
+    size_t slot_index;
+    /// Number of the cycle, from 0 for the first cycle of spin().
+    uint64_t cycle;
+    /// Time from the end time of the slot to its actual end.
+    std::chrono::nanoseconds lateness;
+  };
+
+  using OverrunCallback = std::function<void (const Overrun &)>;
+
+  /// Constructor.
+  /**
+   * \param[in] cycle_period period of the schedule.
+   * \param[in] clock clock of the schedule, a steady clock by default.
+   * \param[in] options common options for all executors.
+   * \throws std::invalid_argument if the period is not positive, or the clock is nullptr.
+   */
+  RCLCPP_PUBLIC
+  explicit TimeTriggeredExecutor(
+    std::chrono::nanoseconds cycle_period,
+    rclcpp::Clock::SharedPtr clock = std::make_shared<rclcpp::Clock>(RCL_STEADY_TIME),
+    const rclcpp::ExecutorOptions & options = rclcpp::ExecutorOptions());
+
+  RCLCPP_PUBLIC
+  virtual ~TimeTriggeredExecutor();
+
+  /// Add a slot to the schedule.
+  /**
+   * The slots must be added in the order of their start times, and must not overlap.
+   *
+   * \param[in] group callback group run in the slot.
+   * \param[in] node node of the callback group.
+   * \param[in] offset start time of the slot, from the start of the cycle.
+   * \param[in] duration duration of the slot.
+   * \return the index of the slot.
+   * \throws std::invalid_argument if the slot overlaps the previous one, or ends after the
+   *   cycle.
+   * \throws std::runtime_error if the executor is spinning.
+   */
+  RCLCPP_PUBLIC
+  size_t
+  add_slot(
+    rclcpp::CallbackGroup::SharedPtr group,
+    rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node,
+    std::chrono::nanoseconds offset,
+    std::chrono::nanoseconds duration);
+
+  /// Set the callback called with each overrun, from the thread spinning, after the slot.
+  RCLCPP_PUBLIC
+  void
+  set_overrun_callback(OverrunCallback callback);
+
+  /// Get the number of overruns since the construction of the executor.
+  RCLCPP_PUBLIC
+  uint64_t
+  get_overrun_count() const;
+
+  /// Run the schedule until the executor is cancelled or its context is shut down.
+  /**
+   * \throws std::runtime_error when spin() called while already spinning
+   */
+  RCLCPP_PUBLIC
+  void
+  spin() override;
+
+  /// Not supported, see add_slot().
+  /**
+   * \throws std::runtime_error always
+   */
+  RCLCPP_PUBLIC
+  void
+  add_callback_group(
+    rclcpp::CallbackGroup::SharedPtr group_ptr,
+    rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr,
+    bool notify = true) override;
+
+  /// Not supported, see add_slot().
+  /**
+   * \throws std::runtime_error always
+   */
+  RCLCPP_PUBLIC
+  void
+  add_node(
+    rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr,
+    bool notify = true) override;
+
+  /// Not supported, see add_slot().
+  /**
+   * \throws std::runtime_error always
+   */
+  RCLCPP_PUBLIC
+  void
+  add_node(std::shared_ptr<rclcpp::Node> node_ptr, bool notify = true) override;
+
+private:
+  RCLCPP_DISABLE_COPY(TimeTriggeredExecutor)
+
+  struct Slot
+  {
+    std::chrono::nanoseconds offset;
+    std::chrono::nanoseconds duration;
+    // Executor of the callback group of the slot, shared by the slots of the same group.
+    StaticSingleThreadedExecutor * executor;
+  };
+
+  const std::chrono::nanoseconds cycle_period_;
+  rclcpp::Clock::SharedPtr clock_;
+  const rclcpp::ExecutorOptions options_;
+
+  std::mutex slots_mutex_;
+  std::vector<Slot> slots_;
+  std::vector<std::pair<rclcpp::CallbackGroup::WeakPtr,
+    std::unique_ptr<StaticSingleThreadedExecutor>>> group_executors_;
+  OverrunCallback overrun_callback_;
+  std::atomic<uint64_t> overrun_count_{0};
+};
+
+}  // namespace executors
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXECUTORS__TIME_TRIGGERED_EXECUTOR_HPP_
@@ -0,0 +1,142 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXECUTORS__WORK_STEALING_MULTI_THREADED_EXECUTOR_HPP_
+#define RCLCPP__EXECUTORS__WORK_STEALING_MULTI_THREADED_EXECUTOR_HPP_
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/any_executable.hpp"
+#include "rclcpp/executor.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/memory_strategies.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace executors
+{
+
+/// Multi-threaded executor which distributes batches of ready work to per-thread queues.
+/**
+ * Unlike rclcpp::executors::MultiThreadedExecutor, which takes the wait mutex once per
+ * executable, this executor collects every ready executable found after a single wait into a
+ * batch.
+ * The batch is spread across one ready queue per thread, and a thread whose own queue is empty
+ * steals work from the back of the other threads' queues before it tries to refill them.
+ * The wait mutex is therefore only taken when all queues have been drained.
+ *
+ * Mutually exclusive callback groups are still respected: once an executable from such a group
+ * is put into a queue, the group is marked as taken until the executable has been executed, so
+ * no other executable from that group can become part of a batch in the meantime.
+ */
+class WorkStealingMultiThreadedExecutor : public rclcpp::Executor
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(WorkStealingMultiThreadedExecutor)
+
+  /// Constructor for WorkStealingMultiThreadedExecutor.
+  /**
+   * \param options common options for all executors
+   * \param number_of_threads number of threads to have in the thread pool,
+   *   the default 0 will use the number of cpu cores found instead
+   * \param max_batch_size maximum number of executables collected into the ready queues by a
+   *   single refill, the default 0 will use `4 * number_of_threads`
+   * \param timeout maximum time to wait
+   */
+  RCLCPP_PUBLIC
+  explicit WorkStealingMultiThreadedExecutor(
+    const rclcpp::ExecutorOptions & options = rclcpp::ExecutorOptions(),
+    size_t number_of_threads = 0,
+    size_t max_batch_size = 0,
+    std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1));
+
+  RCLCPP_PUBLIC
+  virtual ~WorkStealingMultiThreadedExecutor();
+
+  /**
+   * \sa rclcpp::Executor:spin() for more details
+   * \throws std::runtime_error when spin() called while already spinning
+   */
+  RCLCPP_PUBLIC
+  void
+  spin() override;
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_threads();
+
+  RCLCPP_PUBLIC
+  size_t
+  get_max_batch_size();
+
+protected:
+  RCLCPP_PUBLIC
+  void
+  run(size_t this_thread_number);
+
+  /// Take an executable from this thread's queue, or steal one from another thread's queue.
+  /**
+   * \param[in] this_thread_number index of the calling thread's ready queue
+   * \param[out] any_exec the executable taken, left untouched if nothing was found
+   * \return true if an executable was taken, otherwise false
+   */
+  RCLCPP_PUBLIC
+  bool
+  take_ready_executable(
+    size_t this_thread_number,
+    std::unique_ptr<rclcpp::AnyExecutable> & any_exec);
+
+  /// Wait for work if needed and distribute all ready executables across the ready queues.
+  /**
+   * Must be called with wait_mutex_ held.
+   *
+   * \param[in] this_thread_number index of the calling thread, which receives the first
+   *   executable of the batch
+   * \return the number of executables that were added to the ready queues
+   */
+  RCLCPP_PUBLIC
+  size_t
+  refill_ready_queues(size_t this_thread_number);
+
+  /// Drop all queued executables, releasing their callback groups.
+  RCLCPP_PUBLIC
+  void
+  clear_ready_queues();
+
+private:
+  RCLCPP_DISABLE_COPY(WorkStealingMultiThreadedExecutor)
+
+  struct ReadyQueue
+  {
+    std::mutex mutex;
+    std::deque<std::unique_ptr<rclcpp::AnyExecutable>> executables;
+  };
+
+  std::mutex wait_mutex_;
+  size_t number_of_threads_;
+  size_t max_batch_size_;
+  std::chrono::nanoseconds next_exec_timeout_;
+  std::vector<std::unique_ptr<ReadyQueue>> ready_queues_;
+};
+
+}  // namespace executors
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXECUTORS__WORK_STEALING_MULTI_THREADED_EXECUTOR_HPP_
@@ -0,0 +1,208 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__BUFFERS__ADAPTIVE_RING_BUFFER_IMPLEMENTATION_HPP_
+#define RCLCPP__EXPERIMENTAL__BUFFERS__ADAPTIVE_RING_BUFFER_IMPLEMENTATION_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/experimental/buffers/buffer_implementation_base.hpp"
+#include "rclcpp/logger.hpp"
+#include "rclcpp/logging.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+namespace buffers
+{
+
+/// Store elements in a FIFO buffer whose capacity follows how far behind the consumer is
+/**
+ * The buffer starts with a capacity of min_capacity elements.
+ * When it is full, its capacity is doubled, up to max_capacity elements, instead of dropping the
+ * oldest element, so that a consumer falling behind during a burst does not lose elements.
+ * When the consumer empties it, and it was never more than a quarter full since the last time it
+ * was empty, its capacity is halved, down to min_capacity, to release the memory.
+ * Once its capacity is max_capacity, a full buffer drops its oldest element.
+ *
+ * All public member functions are thread-safe.
+ */
+template<typename BufferT>
+class AdaptiveRingBufferImplementation : public BufferImplementationBase<BufferT>
+{
+public:
+  AdaptiveRingBufferImplementation(size_t min_capacity, size_t max_capacity)
+  : min_capacity_(min_capacity),
+    max_capacity_(max_capacity)
+  {
+    if (min_capacity == 0) {
+      throw std::invalid_argument("capacity must be a positive, non-zero value");
+    }
+    if (max_capacity < min_capacity) {
+      throw std::invalid_argument("maximum capacity must not be smaller than the capacity");
+    }
+    ring_buffer_.resize(min_capacity_);
+  }
+
+  virtual ~AdaptiveRingBufferImplementation() {}
+
+  /// Add a new element to store in the ring buffer
+  /**
+   * The buffer grows if it is full, or drops its oldest element if it cannot grow anymore.
+   * This member function is thread-safe.
+   *
+   * \param request the element to be stored in the ring buffer
+   */
+  void enqueue(BufferT request)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (size_ == ring_buffer_.size()) {
+      if (ring_buffer_.size() < max_capacity_) {
+        resize_(std::min(max_capacity_, 2 * ring_buffer_.size()));
+      } else {
+        ring_buffer_[read_index_] = std::move(request);
+        read_index_ = next_(read_index_);
+        return;
+      }
+    }
+    ring_buffer_[(read_index_ + size_) % ring_buffer_.size()] = std::move(request);
+    ++size_;
+    peak_size_ = std::max(peak_size_, size_);
+  }
+
+  /// Remove the oldest element from ring buffer
+  /**
+   * The buffer shrinks if it becomes empty and was mostly unused.
+   * This member function is thread-safe.
+   *
+   * \return the element that is being removed from the ring buffer
+   */
+  BufferT dequeue()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (size_ == 0) {
+      RCLCPP_ERROR(rclcpp::get_logger("rclcpp"), "Calling dequeue on empty intra-process buffer");
+      throw std::runtime_error("Calling dequeue on empty intra-process buffer");
+    }
+
+    auto request = std::move(ring_buffer_[read_index_]);
+    read_index_ = next_(read_index_);
+    --size_;
+
+    if (size_ == 0) {
+      if (ring_buffer_.size() > min_capacity_ && peak_size_ <= ring_buffer_.size() / 4) {
+        resize_(std::max(min_capacity_, ring_buffer_.size() / 2));
+      }
+      peak_size_ = 0;
+    }
+
+    return request;
+  }
+
+  /// Get if the ring buffer has at least one element stored
+  /**
+   * This member function is thread-safe.
+   *
+   * \return `true` if there is data and `false` otherwise
+   */
+  inline bool has_data() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_ != 0;
+  }
+
+  /// Get if adding an element drops the oldest one
+  /**
+   * This member function is thread-safe.
+   *
+   * \return `true` if the buffer is full and cannot grow anymore, `false` otherwise
+   */
+  inline bool is_full() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_ == max_capacity_;
+  }
+
+  /// Get the number of elements stored in the ring buffer
+  /**
+   * This member function is thread-safe.
+   */
+  inline size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+  }
+
+  /// Get the current capacity of the ring buffer
+  /**
+   * This member function is thread-safe.
+   */
+  inline size_t capacity() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_buffer_.size();
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<BufferT>(min_capacity_).swap(ring_buffer_);
+    read_index_ = 0;
+    size_ = 0;
+    peak_size_ = 0;
+  }
+
+private:
+  inline size_t next_(size_t val) const
+  {
+    return (val + 1) % ring_buffer_.size();
+  }
+
+  /// Move the stored elements to a buffer of the given capacity, which must fit them.
+  void resize_(size_t capacity)
+  {
+    std::vector<BufferT> ring_buffer(capacity);
+    for (size_t i = 0; i < size_; ++i) {
+      ring_buffer[i] = std::move(ring_buffer_[(read_index_ + i) % ring_buffer_.size()]);
+    }
+    ring_buffer_.swap(ring_buffer);
+    read_index_ = 0;
+  }
+
+  const size_t min_capacity_;
+  const size_t max_capacity_;
+
+  std::vector<BufferT> ring_buffer_;
+
+  size_t read_index_{0};
+  size_t size_{0};
+  // Largest size since the buffer was last empty.
+  size_t peak_size_{0};
+
+  mutable std::mutex mutex_;
+};
+
+}  // namespace buffers
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__BUFFERS__ADAPTIVE_RING_BUFFER_IMPLEMENTATION_HPP_
@@ -15,6 +15,8 @@
 #ifndef RCLCPP__EXPERIMENTAL__BUFFERS__BUFFER_IMPLEMENTATION_BASE_HPP_
 #define RCLCPP__EXPERIMENTAL__BUFFERS__BUFFER_IMPLEMENTATION_BASE_HPP_
 
+#include <cstddef>
+
 namespace rclcpp
 {
 namespace experimental
@@ -33,6 +35,10 @@ public:
 
   virtual void clear() = 0;
   virtual bool has_data() const = 0;
+  virtual bool is_full() const = 0;
+
+  virtual size_t size() const = 0;
+  virtual size_t capacity() const = 0;
 };
 
 }  // namespace buffers
@@ -15,6 +15,7 @@
 #ifndef RCLCPP__EXPERIMENTAL__BUFFERS__INTRA_PROCESS_BUFFER_HPP_
 #define RCLCPP__EXPERIMENTAL__BUFFERS__INTRA_PROCESS_BUFFER_HPP_
 
+#include <cstddef>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -22,6 +23,7 @@
 #include "rclcpp/allocator/allocator_common.hpp"
 #include "rclcpp/allocator/allocator_deleter.hpp"
 #include "rclcpp/experimental/buffers/buffer_implementation_base.hpp"
+#include "rclcpp/experimental/intra_process_message_info.hpp"
 #include "rclcpp/macros.hpp"
 
 namespace rclcpp
@@ -41,7 +43,11 @@ public:
   virtual void clear() = 0;
 
   virtual bool has_data() const = 0;
+  virtual bool is_full() const = 0;
   virtual bool use_take_shared_method() const = 0;
+
+  virtual size_t size() const = 0;
+  virtual size_t capacity() const = 0;
 };
 
 template<
@@ -63,8 +69,39 @@ public:
 
   virtual MessageSharedPtr consume_shared() = 0;
   virtual MessageUniquePtr consume_unique() = 0;
+
+  /// Add a message with the metadata of its publication.
+  virtual void add_shared(MessageSharedPtr msg, const IntraProcessMessageInfo & info) = 0;
+  virtual void add_unique(MessageUniquePtr msg, const IntraProcessMessageInfo & info) = 0;
+
+  /// Remove the oldest message, and get the metadata of its publication.
+  /**
+   * The metadata is default constructed if the message was added without it.
+   */
+  virtual MessageSharedPtr consume_shared(IntraProcessMessageInfo & info) = 0;
+  virtual MessageUniquePtr consume_unique(IntraProcessMessageInfo & info) = 0;
+};
+
+/// Type of the messages stored in the elements of a buffer, with or without their metadata.
+template<typename BufferT>
+struct BufferElementTraits
+{
+  using MessagePtrT = BufferT;
+  static constexpr bool stores_message_info = false;
 };
 
+template<typename MessagePtrT_>
+struct BufferElementTraits<std::pair<MessagePtrT_, IntraProcessMessageInfo>>
+{
+  using MessagePtrT = MessagePtrT_;
+  static constexpr bool stores_message_info = true;
+};
+
+/// Intra-process buffer storing the messages in a BufferImplementationBase.
+/**
+ * BufferT is either the shared or the unique pointer of the messages, or a pair of one of them
+ * and of the IntraProcessMessageInfo of the message, to keep the metadata of the messages.
+ */
 template<
   typename MessageT,
   typename Alloc = std::allocator<void>,
@@ -85,8 +122,8 @@ public:
     std::unique_ptr<BufferImplementationBase<BufferT>> buffer_impl,
     std::shared_ptr<Alloc> allocator = nullptr)
   {
-    bool valid_type = (std::is_same<BufferT, MessageSharedPtr>::value ||
-      std::is_same<BufferT, MessageUniquePtr>::value);
+    bool valid_type = (std::is_same<StoredMessageT, MessageSharedPtr>::value ||
+      std::is_same<StoredMessageT, MessageUniquePtr>::value);
     if (!valid_type) {
       throw std::runtime_error("Creating TypedIntraProcessBuffer with not valid BufferT");
     }
@@ -104,22 +141,57 @@ public:
 
   void add_shared(MessageSharedPtr msg) override
   {
-    add_shared_impl<BufferT>(std::move(msg));
+    add_shared(std::move(msg), IntraProcessMessageInfo());
   }
 
   void add_unique(MessageUniquePtr msg) override
   {
-    buffer_->enqueue(std::move(msg));
+    add_unique(std::move(msg), IntraProcessMessageInfo());
   }
 
   MessageSharedPtr consume_shared() override
   {
-    return consume_shared_impl<BufferT>();
+    IntraProcessMessageInfo info;
+    return consume_shared(info);
   }
 
   MessageUniquePtr consume_unique() override
   {
-    return consume_unique_impl<BufferT>();
+    IntraProcessMessageInfo info;
+    return consume_unique(info);
+  }
+
+  void add_shared(MessageSharedPtr msg, const IntraProcessMessageInfo & info) override
+  {
+    if constexpr (std::is_same<StoredMessageT, MessageSharedPtr>::value) {
+      enqueue_(std::move(msg), info);
+    } else {
+      // This should not happen: here a copy is unconditionally made, while the intra-process
+      // manager can decide whether a copy is needed depending on the number and the type of
+      // buffers
+      enqueue_(copy_message_(msg), info);
+    }
+  }
+
+  void add_unique(MessageUniquePtr msg, const IntraProcessMessageInfo & info) override
+  {
+    // automatic cast from unique ptr to shared ptr, if the buffer stores shared ptrs
+    enqueue_(std::move(msg), info);
+  }
+
+  MessageSharedPtr consume_shared(IntraProcessMessageInfo & info) override
+  {
+    // automatic cast from unique ptr to shared ptr, if the buffer stores unique ptrs
+    return dequeue_(info);
+  }
+
+  MessageUniquePtr consume_unique(IntraProcessMessageInfo & info) override
+  {
+    if constexpr (std::is_same<StoredMessageT, MessageSharedPtr>::value) {
+      return copy_message_(dequeue_(info));
+    } else {
+      return dequeue_(info);
+    }
   }
 
   bool has_data() const override
@@ -127,110 +199,73 @@ public:
     return buffer_->has_data();
   }
 
+  bool is_full() const override
+  {
+    return buffer_->is_full();
+  }
+
   void clear() override
   {
     buffer_->clear();
   }
 
+  size_t size() const override
+  {
+    return buffer_->size();
+  }
+
+  size_t capacity() const override
+  {
+    return buffer_->capacity();
+  }
+
   bool use_take_shared_method() const override
   {
-    return std::is_same<BufferT, MessageSharedPtr>::value;
+    return std::is_same<StoredMessageT, MessageSharedPtr>::value;
   }
 
 private:
+  using StoredMessageT = typename BufferElementTraits<BufferT>::MessagePtrT;
+
   std::unique_ptr<BufferImplementationBase<BufferT>> buffer_;
 
   std::shared_ptr<MessageAlloc> message_allocator_;
 
-  // MessageSharedPtr to MessageSharedPtr
-  template<typename DestinationT>
-  typename std::enable_if<
-    std::is_same<DestinationT, MessageSharedPtr>::value
-  >::type
-  add_shared_impl(MessageSharedPtr shared_msg)
-  {
-    buffer_->enqueue(std::move(shared_msg));
-  }
-
-  // MessageSharedPtr to MessageUniquePtr
-  template<typename DestinationT>
-  typename std::enable_if<
-    std::is_same<DestinationT, MessageUniquePtr>::value
-  >::type
-  add_shared_impl(MessageSharedPtr shared_msg)
+  void enqueue_(StoredMessageT msg, const IntraProcessMessageInfo & info)
   {
-    // This should not happen: here a copy is unconditionally made, while the intra-process manager
-    // can decide whether a copy is needed depending on the number and the type of buffers
-
-    MessageUniquePtr unique_msg;
-    MessageDeleter * deleter = std::get_deleter<MessageDeleter, const MessageT>(shared_msg);
-    auto ptr = MessageAllocTraits::allocate(*message_allocator_.get(), 1);
-    MessageAllocTraits::construct(*message_allocator_.get(), ptr, *shared_msg);
-    if (deleter) {
-      unique_msg = MessageUniquePtr(ptr, *deleter);
+    if constexpr (BufferElementTraits<BufferT>::stores_message_info) {
+      buffer_->enqueue(BufferT(std::move(msg), info));
     } else {
-      unique_msg = MessageUniquePtr(ptr);
+      (void)info;
+      buffer_->enqueue(std::move(msg));
     }
-
-    buffer_->enqueue(std::move(unique_msg));
   }
 
-  // MessageSharedPtr to MessageSharedPtr
-  template<typename OriginT>
-  typename std::enable_if<
-    std::is_same<OriginT, MessageSharedPtr>::value,
-    MessageSharedPtr
-  >::type
-  consume_shared_impl()
+  StoredMessageT dequeue_(IntraProcessMessageInfo & info)
   {
-    return buffer_->dequeue();
-  }
-
-  // MessageUniquePtr to MessageSharedPtr
-  template<typename OriginT>
-  typename std::enable_if<
-    (std::is_same<OriginT, MessageUniquePtr>::value),
-    MessageSharedPtr
-  >::type
-  consume_shared_impl()
-  {
-    // automatic cast from unique ptr to shared ptr
-    return buffer_->dequeue();
+    if constexpr (BufferElementTraits<BufferT>::stores_message_info) {
+      BufferT element = buffer_->dequeue();
+      info = element.second;
+      return std::move(element.first);
+    } else {
+      info = IntraProcessMessageInfo();
+      return buffer_->dequeue();
+    }
   }
 
-  // MessageSharedPtr to MessageUniquePtr
-  template<typename OriginT>
-  typename std::enable_if<
-    (std::is_same<OriginT, MessageSharedPtr>::value),
-    MessageUniquePtr
-  >::type
-  consume_unique_impl()
+  MessageUniquePtr copy_message_(const MessageSharedPtr & shared_msg)
   {
-    MessageSharedPtr buffer_msg = buffer_->dequeue();
-
     MessageUniquePtr unique_msg;
-    MessageDeleter * deleter = std::get_deleter<MessageDeleter, const MessageT>(buffer_msg);
+    MessageDeleter * deleter = std::get_deleter<MessageDeleter, const MessageT>(shared_msg);
     auto ptr = MessageAllocTraits::allocate(*message_allocator_.get(), 1);
-    MessageAllocTraits::construct(*message_allocator_.get(), ptr, *buffer_msg);
+    MessageAllocTraits::construct(*message_allocator_.get(), ptr, *shared_msg);
     if (deleter) {
       unique_msg = MessageUniquePtr(ptr, *deleter);
     } else {
       unique_msg = MessageUniquePtr(ptr);
     }
-
     return unique_msg;
   }
-
-  // MessageUniquePtr to MessageUniquePtr
-  template<typename OriginT>
-  typename std::enable_if<
-    (std::is_same<OriginT, MessageUniquePtr>::value),
-    MessageUniquePtr
-  >::type
-  consume_unique_impl()
-  {
-    return buffer_->dequeue();
-  }
 };
 
 }  // namespace buffers
@@ -0,0 +1,239 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__BUFFERS__LOCK_FREE_RING_BUFFER_IMPLEMENTATION_HPP_
+#define RCLCPP__EXPERIMENTAL__BUFFERS__LOCK_FREE_RING_BUFFER_IMPLEMENTATION_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "rclcpp/experimental/buffers/buffer_implementation_base.hpp"
+#include "rclcpp/logger.hpp"
+#include "rclcpp/logging.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+namespace buffers
+{
+
+/// Store elements in a fixed-size, FIFO buffer without taking a lock
+/**
+ * Behaves like RingBufferImplementation, i.e. the oldest element is dropped when a new element
+ * is added to a full buffer, but synchronizes through atomic operations only.
+ * Each slot carries a sequence number which tells producers and consumers whether the slot is
+ * free or holds a published element, so has_data() is a couple of atomic loads instead of a
+ * mutex acquisition.
+ *
+ * Any number of threads may enqueue and dequeue concurrently.
+ * The producer side is always multi-producer safe, because a single publisher may be used from
+ * several threads at the same time, and a producer which finds the buffer full removes the
+ * oldest element itself.
+ *
+ * All public member functions are thread-safe.
+ */
+template<typename BufferT>
+class LockFreeRingBufferImplementation : public BufferImplementationBase<BufferT>
+{
+public:
+  explicit LockFreeRingBufferImplementation(size_t capacity)
+  : capacity_(capacity)
+  {
+    if (capacity == 0) {
+      throw std::invalid_argument("capacity must be a positive, non-zero value");
+    }
+    slots_ = std::make_unique<Slot[]>(capacity_);
+    for (size_t i = 0; i < capacity_; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  virtual ~LockFreeRingBufferImplementation() {}
+
+  /// Add a new element to store in the ring buffer
+  /**
+   * If the buffer is full, the oldest element is removed to make room for the new one.
+   * This member function is thread-safe.
+   *
+   * \param request the element to be stored in the ring buffer
+   */
+  void enqueue(BufferT request)
+  {
+    while (!try_enqueue_(request)) {
+      // The buffer is full, drop the oldest element; if a consumer got to it first, retry anyway.
+      BufferT dropped;
+      try_dequeue_(dropped);
+    }
+  }
+
+  /// Remove the oldest element from ring buffer
+  /**
+   * This member function is thread-safe.
+   *
+   * \return the element that is being removed from the ring buffer
+   */
+  BufferT dequeue()
+  {
+    BufferT request;
+    if (!try_dequeue_(request)) {
+      RCLCPP_ERROR(rclcpp::get_logger("rclcpp"), "Calling dequeue on empty intra-process buffer");
+      throw std::runtime_error("Calling dequeue on empty intra-process buffer");
+    }
+    return request;
+  }
+
+  /// Get if the ring buffer has at least one element stored
+  /**
+   * This member function is thread-safe.
+   *
+   * \return `true` if there is data and `false` otherwise
+   */
+  inline bool has_data() const
+  {
+    const size_t position = read_position_.value.load(std::memory_order_relaxed);
+    const Slot & slot = slots_[position % capacity_];
+    return slot.sequence.load(std::memory_order_acquire) == position + 1;
+  }
+
+  /// Get if the size of the buffer is equal to its capacity
+  /**
+   * This member function is thread-safe, but the result is only a snapshot when other threads
+   * are enqueuing or dequeuing at the same time.
+   *
+   * \return `true` if the size of the buffer is equal is capacity
+   * and `false` otherwise
+   */
+  inline bool is_full() const
+  {
+    const size_t read_position = read_position_.value.load(std::memory_order_acquire);
+    const size_t write_position = write_position_.value.load(std::memory_order_acquire);
+    return write_position - read_position >= capacity_;
+  }
+
+  /// Get the number of elements stored in the ring buffer
+  /**
+   * This member function is thread-safe, but the result is only a snapshot when other threads
+   * are enqueuing or dequeuing at the same time.
+   */
+  inline size_t size() const
+  {
+    const size_t read_position = read_position_.value.load(std::memory_order_acquire);
+    const size_t write_position = write_position_.value.load(std::memory_order_acquire);
+    return std::min(write_position - read_position, capacity_);
+  }
+
+  /// Get the maximum number of elements stored in the ring buffer
+  inline size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  void clear() {}
+
+private:
+  /// Size assumed for a cache line, used to keep the positions from sharing one.
+  static constexpr size_t cache_line_size = 64;
+
+  struct Slot
+  {
+    std::atomic_size_t sequence{0};
+    BufferT data{};
+  };
+
+  struct alignas(cache_line_size) PaddedPosition
+  {
+    std::atomic_size_t value{0};
+  };
+
+  /// Store an element in the next free slot, if there is one
+  /**
+   * \param request the element to store, moved from only on success
+   * \return `false` if the buffer is full and `true` otherwise
+   */
+  bool try_enqueue_(BufferT & request)
+  {
+    size_t position = write_position_.value.load(std::memory_order_relaxed);
+    while (true) {
+      Slot & slot = slots_[position % capacity_];
+      const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+      if (difference == 0) {
+        if (
+          write_position_.value.compare_exchange_weak(
+            position, position + 1, std::memory_order_relaxed))
+        {
+          slot.data = std::move(request);
+          slot.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        // The slot still holds the element written one lap earlier.
+        return false;
+      } else {
+        position = write_position_.value.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Remove the oldest element, if there is one
+  /**
+   * \param request set to the removed element on success
+   * \return `false` if the buffer is empty and `true` otherwise
+   */
+  bool try_dequeue_(BufferT & request)
+  {
+    size_t position = read_position_.value.load(std::memory_order_relaxed);
+    while (true) {
+      Slot & slot = slots_[position % capacity_];
+      const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto difference = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+      if (difference == 0) {
+        if (
+          read_position_.value.compare_exchange_weak(
+            position, position + 1, std::memory_order_relaxed))
+        {
+          request = std::move(slot.data);
+          slot.data = BufferT();
+          slot.sequence.store(position + capacity_, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        // Nothing has been published to this slot yet.
+        return false;
+      } else {
+        position = read_position_.value.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  const size_t capacity_;
+
+  std::unique_ptr<Slot[]> slots_;
+
+  PaddedPosition write_position_;
+  PaddedPosition read_position_;
+};
+
+}  // namespace buffers
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__BUFFERS__LOCK_FREE_RING_BUFFER_IMPLEMENTATION_HPP_
@@ -140,6 +140,22 @@ public:
     return is_full_();
   }
 
+  /// Get the number of elements stored in the ring buffer
+  /**
+   * This member function is thread-safe.
+   */
+  inline size_t size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+  }
+
+  /// Get the maximum number of elements stored in the ring buffer
+  inline size_t capacity() const
+  {
+    return capacity_;
+  }
+
   void clear() {}
 
 private:
@@ -15,14 +15,19 @@
 #ifndef RCLCPP__EXPERIMENTAL__CREATE_INTRA_PROCESS_BUFFER_HPP_
 #define RCLCPP__EXPERIMENTAL__CREATE_INTRA_PROCESS_BUFFER_HPP_
 
+#include <cstddef>
 #include <memory>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 
 #include "rcl/subscription.h"
 
+#include "rclcpp/experimental/buffers/adaptive_ring_buffer_implementation.hpp"
 #include "rclcpp/experimental/buffers/intra_process_buffer.hpp"
+#include "rclcpp/experimental/buffers/lock_free_ring_buffer_implementation.hpp"
 #include "rclcpp/experimental/buffers/ring_buffer_implementation.hpp"
+#include "rclcpp/experimental/intra_process_message_info.hpp"
 #include "rclcpp/intra_process_buffer_type.hpp"
 #include "rclcpp/qos.hpp"
 
@@ -31,6 +36,16 @@ namespace rclcpp
 namespace experimental
 {
 
+/// Create the intra-process buffer of a subscription.
+/**
+ * \param[in] buffer_type Type of the elements stored by the buffer.
+ * \param[in] qos QoS of the subscription, whose depth is the capacity of the buffer.
+ * \param[in] allocator Allocator of the messages.
+ * \param[in] max_buffer_size If greater than the depth, the buffer grows up to this capacity when
+ *   it is full, and shrinks back when it is emptied.
+ * \throws std::invalid_argument if max_buffer_size is greater than the depth with a lock-free
+ *   buffer type.
+ */
 template<
   typename MessageT,
   typename Alloc = std::allocator<void>,
@@ -39,12 +54,21 @@ typename rclcpp::experimental::buffers::IntraProcessBuffer<MessageT, Alloc, Dele
 create_intra_process_buffer(
   IntraProcessBufferType buffer_type,
   const rclcpp::QoS & qos,
-  std::shared_ptr<Alloc> allocator)
+  std::shared_ptr<Alloc> allocator,
+  size_t max_buffer_size = 0)
 {
-  using MessageSharedPtr = std::shared_ptr<const MessageT>;
-  using MessageUniquePtr = std::unique_ptr<MessageT, Deleter>;
+  // The messages are stored with the metadata of their publication.
+  using SharedElementT = std::pair<std::shared_ptr<const MessageT>, IntraProcessMessageInfo>;
+  using UniqueElementT = std::pair<std::unique_ptr<MessageT, Deleter>, IntraProcessMessageInfo>;
 
   size_t buffer_size = qos.depth();
+  const bool adaptive = max_buffer_size > buffer_size;
+  if (adaptive &&
+    (IntraProcessBufferType::LockFreeSharedPtr == buffer_type ||
+    IntraProcessBufferType::LockFreeUniquePtr == buffer_type))
+  {
+    throw std::invalid_argument("lock-free intra-process buffers cannot be adaptive");
+  }
 
   using rclcpp::experimental::buffers::IntraProcessBuffer;
   typename IntraProcessBuffer<MessageT, Alloc, Deleter>::UniquePtr buffer;
@@ -52,11 +76,19 @@ create_intra_process_buffer(
   switch (buffer_type) {
     case IntraProcessBufferType::SharedPtr:
       {
-        using BufferT = MessageSharedPtr;
-
-        auto buffer_implementation =
-          std::make_unique<rclcpp::experimental::buffers::RingBufferImplementation<BufferT>>(
-          buffer_size);
+        using BufferT = SharedElementT;
+
+        std::unique_ptr<rclcpp::experimental::buffers::BufferImplementationBase<BufferT>>
+        buffer_implementation;
+        if (adaptive) {
+          buffer_implementation = std::make_unique<
+            rclcpp::experimental::buffers::AdaptiveRingBufferImplementation<BufferT>>(
+            buffer_size, max_buffer_size);
+        } else {
+          buffer_implementation =
+            std::make_unique<rclcpp::experimental::buffers::RingBufferImplementation<BufferT>>(
+            buffer_size);
+        }
 
         // Construct the intra_process_buffer
         buffer =
@@ -69,11 +101,51 @@ create_intra_process_buffer(
       }
     case IntraProcessBufferType::UniquePtr:
       {
-        using BufferT = MessageUniquePtr;
+        using BufferT = UniqueElementT;
+
+        std::unique_ptr<rclcpp::experimental::buffers::BufferImplementationBase<BufferT>>
+        buffer_implementation;
+        if (adaptive) {
+          buffer_implementation = std::make_unique<
+            rclcpp::experimental::buffers::AdaptiveRingBufferImplementation<BufferT>>(
+            buffer_size, max_buffer_size);
+        } else {
+          buffer_implementation =
+            std::make_unique<rclcpp::experimental::buffers::RingBufferImplementation<BufferT>>(
+            buffer_size);
+        }
+
+        // Construct the intra_process_buffer
+        buffer =
+          std::make_unique<rclcpp::experimental::buffers::TypedIntraProcessBuffer<MessageT, Alloc,
+            Deleter, BufferT>>(
+          std::move(buffer_implementation),
+          allocator);
+
+        break;
+      }
+    case IntraProcessBufferType::LockFreeSharedPtr:
+      {
+        using BufferT = SharedElementT;
+
+        auto buffer_implementation = std::make_unique<
+          rclcpp::experimental::buffers::LockFreeRingBufferImplementation<BufferT>>(buffer_size);
+
+        // Construct the intra_process_buffer
+        buffer =
+          std::make_unique<rclcpp::experimental::buffers::TypedIntraProcessBuffer<MessageT, Alloc,
+            Deleter, BufferT>>(
+          std::move(buffer_implementation),
+          allocator);
+
+        break;
+      }
+    case IntraProcessBufferType::LockFreeUniquePtr:
+      {
+        using BufferT = UniqueElementT;
 
-        auto buffer_implementation =
-          std::make_unique<rclcpp::experimental::buffers::RingBufferImplementation<BufferT>>(
-          buffer_size);
+        auto buffer_implementation = std::make_unique<
+          rclcpp::experimental::buffers::LockFreeRingBufferImplementation<BufferT>>(buffer_size);
 
         // Construct the intra_process_buffer
         buffer =
@@ -15,9 +15,12 @@
 #ifndef RCLCPP__EXPERIMENTAL__EXECUTABLE_LIST_HPP_
 #define RCLCPP__EXPERIMENTAL__EXECUTABLE_LIST_HPP_
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
+#include "rcl/wait.h"
+
 #include "rclcpp/client.hpp"
 #include "rclcpp/service.hpp"
 #include "rclcpp/subscription_base.hpp"
@@ -31,9 +34,20 @@ namespace experimental
 {
 
 /// This class contains subscriptionbase, timerbase, etc. which can be used to run callbacks.
+/**
+ * The entities of each kind are stored as parallel arrays: the entities, their rcl handles,
+ * which are added to the wait set without dereferencing the entities, and a bitset of the
+ * entities found ready by the last wait, all at the same index.
+ */
 class ExecutableList final
 {
 public:
+  /// Bitset of ready entities, bit i of word i / 64 is set if the entity i is ready.
+  using ReadySet = std::vector<uint64_t>;
+
+  /// Index returned by next_ready() when no entity is left.
+  static constexpr size_t npos = SIZE_MAX;
+
   RCLCPP_PUBLIC
   ExecutableList();
 
@@ -64,22 +78,59 @@ public:
   void
   add_waitable(rclcpp::Waitable::SharedPtr waitable);
 
+  /// Exchange the entities, handles and ready sets with another list, keeping the capacities.
+  RCLCPP_PUBLIC
+  void
+  swap(ExecutableList & other);
+
+  /// Update the ready sets from a wait set which has been waited on.
+  /**
+   * The handles of the list must be the first ones of each kind in the wait set, added in the
+   * order of the list.
+   * \param[in] wait_set the wait set.
+   * \return true if any subscription, timer, service or client is ready.
+   */
+  RCLCPP_PUBLIC
+  bool
+  update_ready(const rcl_wait_set_t & wait_set);
+
+  /// Return the index of the first ready entity at or after index, or npos.
+  RCLCPP_PUBLIC
+  static size_t
+  next_ready(const ReadySet & ready, size_t index);
+
   // Vector containing the SubscriptionBase of all the subscriptions added to the executor.
   std::vector<rclcpp::SubscriptionBase::SharedPtr> subscription;
   // Contains the count of added subscriptions
   size_t number_of_subscriptions;
+  // rcl handles of the subscriptions, at the same index.
+  std::vector<const rcl_subscription_t *> subscription_handle;
+  // Subscriptions found ready by the last wait, see update_ready().
+  ReadySet subscription_ready;
   // Vector containing the TimerBase of all the timers added to the executor.
   std::vector<rclcpp::TimerBase::SharedPtr> timer;
   // Contains the count of added timers
   size_t number_of_timers;
+  // rcl handles of the timers, at the same index.
+  std::vector<const rcl_timer_t *> timer_handle;
+  // Timers found ready by the last wait, see update_ready().
+  ReadySet timer_ready;
   // Vector containing the ServiceBase of all the services added to the executor.
   std::vector<rclcpp::ServiceBase::SharedPtr> service;
   // Contains the count of added services
   size_t number_of_services;
+  // rcl handles of the services, at the same index.
+  std::vector<const rcl_service_t *> service_handle;
+  // Services found ready by the last wait, see update_ready().
+  ReadySet service_ready;
   // Vector containing the ClientBase of all the clients added to the executor.
   std::vector<rclcpp::ClientBase::SharedPtr> client;
   // Contains the count of added clients
   size_t number_of_clients;
+  // rcl handles of the clients, at the same index.
+  std::vector<const rcl_client_t *> client_handle;
+  // Clients found ready by the last wait, see update_ready().
+  ReadySet client_ready;
   // Vector containing all the waitables added to the executor.
   std::vector<rclcpp::Waitable::SharedPtr> waitable;
   // Contains the count of added waitables
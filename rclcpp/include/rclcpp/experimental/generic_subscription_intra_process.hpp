@@ -0,0 +1,114 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__GENERIC_SUBSCRIPTION_INTRA_PROCESS_HPP_
+#define RCLCPP__EXPERIMENTAL__GENERIC_SUBSCRIPTION_INTRA_PROCESS_HPP_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "rclcpp/context.hpp"
+#include "rclcpp/experimental/subscription_intra_process_buffer.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/qos.hpp"
+#include "rclcpp/serialized_message.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+
+/// Intra-process subscription of a rclcpp::GenericSubscription.
+/**
+ * It receives the serialized messages published intra process by rclcpp::GenericPublisher
+ * instances with the same topic name and type, which are never deserialized or sent through the
+ * middleware.
+ *
+ * By default the messages are owned by the buffer, so that the callback receives the published
+ * message itself when it is the only subscription, and a copy otherwise.
+ */
+class GenericSubscriptionIntraProcess
+  : public SubscriptionIntraProcessBuffer<rclcpp::SerializedMessage>
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(GenericSubscriptionIntraProcess)
+
+  using CallbackT = std::function<void (std::shared_ptr<rclcpp::SerializedMessage>)>;
+
+  GenericSubscriptionIntraProcess(
+    CallbackT callback,
+    rclcpp::Context::SharedPtr context,
+    const std::string & topic_name,
+    const rclcpp::QoS & qos_profile,
+    rclcpp::IntraProcessBufferType buffer_type)
+  : SubscriptionIntraProcessBuffer<rclcpp::SerializedMessage>(
+      std::make_shared<std::allocator<void>>(),
+      context,
+      topic_name,
+      qos_profile,
+      buffer_type == rclcpp::IntraProcessBufferType::CallbackDefault ?
+      rclcpp::IntraProcessBufferType::UniquePtr : buffer_type),
+    callback_(std::move(callback))
+  {}
+
+  virtual ~GenericSubscriptionIntraProcess() = default;
+
+  std::shared_ptr<void>
+  take_data() override
+  {
+    if (!this->buffer_->has_data()) {
+      // An on ready callback may report more messages than remain, e.g. after a message was
+      // dropped from a full buffer.
+      return nullptr;
+    }
+    return std::static_pointer_cast<void>(
+      std::shared_ptr<rclcpp::SerializedMessage>(this->buffer_->consume_unique()));
+  }
+
+  void
+  execute(std::shared_ptr<void> & data) override
+  {
+    if (!data) {
+      // take_data() found no message.
+      return;
+    }
+    callback_(std::static_pointer_cast<rclcpp::SerializedMessage>(data));
+  }
+
+protected:
+  void
+  dispatch_directly(ConstMessageSharedPtr message, const IntraProcessMessageInfo & info) override
+  {
+    (void)info;
+    // The callback may modify the message, which other subscriptions share.
+    callback_(std::make_shared<rclcpp::SerializedMessage>(*message));
+  }
+
+  void
+  dispatch_directly(MessageUniquePtr message, const IntraProcessMessageInfo & info) override
+  {
+    (void)info;
+    callback_(std::shared_ptr<rclcpp::SerializedMessage>(std::move(message)));
+  }
+
+private:
+  CallbackT callback_;
+};
+
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__GENERIC_SUBSCRIPTION_INTRA_PROCESS_HPP_
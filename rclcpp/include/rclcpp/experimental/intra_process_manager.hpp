@@ -17,20 +17,24 @@
 
 #include <rmw/types.h>
 
-#include <shared_mutex>
-
 #include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <exception>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "rclcpp/allocator/allocator_deleter.hpp"
+#include "rclcpp/experimental/intra_process_message_info.hpp"
+#include "rclcpp/experimental/publisher_intra_process_history.hpp"
+#include "rclcpp/experimental/publisher_intra_process_ring.hpp"
+#include "rclcpp/experimental/service_intra_process_base.hpp"
 #include "rclcpp/experimental/subscription_intra_process.hpp"
 #include "rclcpp/experimental/subscription_intra_process_base.hpp"
 #include "rclcpp/experimental/subscription_intra_process_buffer.hpp"
@@ -38,6 +42,7 @@
 #include "rclcpp/logging.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/publisher_base.hpp"
+#include "rclcpp/type_adapter.hpp"
 #include "rclcpp/visibility_control.hpp"
 
 namespace rclcpp
@@ -87,6 +92,27 @@ namespace experimental
  * This information allows this class to operate efficiently by performing the
  * fewest number of copies of the message required.
  *
+ * The routes from publishers to subscriptions are kept in an immutable table,
+ * which is replaced as a whole when a publisher or subscription is added or
+ * removed.
+ * Publishing only loads the current table, so it never waits for a lock held
+ * by another publishing thread or by a registration.
+ *
+ * A publisher with transient local durability is registered with a history of
+ * its last messages, which are replayed to the transient local subscriptions
+ * registered after they were published.
+ *
+ * A publisher can also be registered with a ring, where each message is stored
+ * once for all the subscriptions sharing the messages, which read it from there
+ * instead of storing it in their own buffer.
+ *
+ * Each message is stored with an IntraProcessMessageInfo, the time of its
+ * publication, its sequence number and the gid of its publisher, which the
+ * subscriptions give to their callbacks as the message info.
+ *
+ * Services are registered by name, so that the clients of the same context
+ * send them their requests intra process, see rclcpp::Client.
+ *
  * This class is neither CopyConstructable nor CopyAssignable.
  */
 class IntraProcessManager
@@ -109,6 +135,8 @@ public:
    * the information of its wrapped subscription (i.e. topic name and QoS).
    *
    * In addition this generates a unique intra process id for the subscription.
+   * If the subscription has transient local durability, the histories of the
+   * matching publishers are replayed to it.
    *
    * \param subscription the SubscriptionIntraProcess to register.
    * \return an unsigned 64-bit integer which is the subscription's unique id.
@@ -117,9 +145,25 @@ public:
   uint64_t
   add_subscription(rclcpp::experimental::SubscriptionIntraProcessBase::SharedPtr subscription);
 
+  /// Register a subscription of serialized messages, returns subscriptions unique id.
+  /**
+   * The subscription only receives the messages of the publishers of serialized messages
+   * registered with add_serialized_publisher() for the same topic and type.
+   * Its buffer must store rclcpp::SerializedMessage, \sa GenericSubscriptionIntraProcess.
+   *
+   * \param subscription the SubscriptionIntraProcess to register.
+   * \param type_name the name of the type of the serialized messages, e.g. "std_msgs/msg/String".
+   * \return an unsigned 64-bit integer which is the subscription's unique id.
+   */
+  RCLCPP_PUBLIC
+  uint64_t
+  add_serialized_subscription(
+    rclcpp::experimental::SubscriptionIntraProcessBase::SharedPtr subscription,
+    const std::string & type_name);
+
   /// Unregister a subscription using the subscription's unique id.
   /**
-   * This method does not allocate memory.
+   * This method allocates a new routing table without the subscription.
    *
    * \param intra_process_subscription_id id of the subscription to remove.
    */
@@ -134,16 +178,45 @@ public:
    *
    * In addition this generates a unique intra process id for the publisher.
    *
+   * A publisher with transient local durability gives the history where its
+   * messages are kept, it must be a PublisherIntraProcessHistory of the type
+   * of the published ROS messages.
+   *
+   * A publisher sharing a ring with its subscriptions gives the ring, it must be a
+   * PublisherIntraProcessRing of the type of the published ROS messages.
+   *
    * \param publisher publisher to be registered with the manager.
+   * \param history history of the publisher, nullptr if it has volatile durability.
+   * \param ring ring of the publisher, nullptr to provide the messages to each subscription.
    * \return an unsigned 64-bit integer which is the publisher's unique id.
    */
   RCLCPP_PUBLIC
   uint64_t
-  add_publisher(rclcpp::PublisherBase::SharedPtr publisher);
+  add_publisher(
+    rclcpp::PublisherBase::SharedPtr publisher,
+    PublisherIntraProcessHistoryBase::SharedPtr history = nullptr,
+    PublisherIntraProcessRingBase::SharedPtr ring = nullptr);
+
+  /// Register a publisher of serialized messages, returns the publisher unique id.
+  /**
+   * The publisher only publishes to the subscriptions of serialized messages registered with
+   * add_serialized_subscription() for the same topic and type.
+   * It publishes rclcpp::SerializedMessage instances, e.g. with
+   * do_intra_process_publish<rclcpp::SerializedMessage>().
+   *
+   * \param publisher publisher to be registered with the manager.
+   * \param type_name the name of the type of the serialized messages, e.g. "std_msgs/msg/String".
+   * \return an unsigned 64-bit integer which is the publisher's unique id.
+   */
+  RCLCPP_PUBLIC
+  uint64_t
+  add_serialized_publisher(
+    rclcpp::PublisherBase::SharedPtr publisher,
+    const std::string & type_name);
 
   /// Unregister a publisher using the publisher's unique id.
   /**
-   * This method does not allocate memory.
+   * This method allocates a new routing table without the publisher.
    *
    * \param intra_process_publisher_id id of the publisher to remove.
    */
@@ -151,6 +224,37 @@ public:
   void
   remove_publisher(uint64_t intra_process_publisher_id);
 
+  /// Register a service with the manager, returns the service unique id.
+  /**
+   * The clients of the same service name find it with get_service_intra_process().
+   *
+   * \param service the ServiceIntraProcess of the service to register.
+   * \return an unsigned 64-bit integer which is the service's unique id.
+   */
+  RCLCPP_PUBLIC
+  uint64_t
+  add_service(rclcpp::experimental::ServiceIntraProcessBase::SharedPtr service);
+
+  /// Unregister a service using the service's unique id.
+  /**
+   * \param intra_process_service_id id of the service to remove.
+   */
+  RCLCPP_PUBLIC
+  void
+  remove_service(uint64_t intra_process_service_id);
+
+  /// Return the service registered with the given name, if any.
+  /**
+   * If several services have the name, the first one registered is returned.
+   * It does not take a lock, so it can be called for every request.
+   *
+   * \param service_name the fully qualified name of the service.
+   * \return the ServiceIntraProcess of the service, or nullptr if there is none.
+   */
+  RCLCPP_PUBLIC
+  rclcpp::experimental::ServiceIntraProcessBase::SharedPtr
+  get_service_intra_process(const std::string & service_name) const;
+
   /// Publishes an intra-process message, passed as a unique pointer.
   /**
    * This is one of the two methods for publishing intra-process.
@@ -187,10 +291,20 @@ public:
     using MessageAllocTraits = allocator::AllocRebind<MessageT, Alloc>;
     using MessageAllocatorT = typename MessageAllocTraits::allocator_type;
 
-    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto routing_table = get_routing_table();
 
-    auto publisher_it = pub_to_subs_.find(intra_process_publisher_id);
-    if (publisher_it == pub_to_subs_.end()) {
+    if (
+      routing_table->histories.count(intra_process_publisher_id) != 0 ||
+      routing_table->rings.count(intra_process_publisher_id) != 0)
+    {
+      // The history or the ring shares the message, as the subscriptions not requiring ownership.
+      this->template do_intra_process_publish_and_return_shared<MessageT, Alloc, Deleter>(
+        intra_process_publisher_id, std::move(message), allocator);
+      return;
+    }
+
+    auto publisher_it = routing_table->pub_to_subs.find(intra_process_publisher_id);
+    if (publisher_it == routing_table->pub_to_subs.end()) {
       // Publisher is either invalid or no longer exists.
       RCLCPP_WARN(
         rclcpp::get_logger("rclcpp"),
@@ -198,13 +312,14 @@ public:
       return;
     }
     const auto & sub_ids = publisher_it->second;
+    const auto info = make_message_info(intra_process_publisher_id, *routing_table);
 
     if (sub_ids.take_ownership_subscriptions.empty()) {
       // None of the buffers require ownership, so we promote the pointer
       std::shared_ptr<MessageT> msg = std::move(message);
 
       this->template add_shared_msg_to_buffers<MessageT, Alloc, Deleter>(
-        msg, sub_ids.take_shared_subscriptions);
+        msg, info, sub_ids.take_shared_subscriptions, routing_table->subscriptions);
     } else if (!sub_ids.take_ownership_subscriptions.empty() && // NOLINT
       sub_ids.take_shared_subscriptions.size() <= 1)
     {
@@ -220,7 +335,9 @@ public:
 
       this->template add_owned_msg_to_buffers<MessageT, Alloc, Deleter>(
         std::move(message),
+        info,
         concatenated_vector,
+        routing_table->subscriptions,
         allocator);
     } else if (!sub_ids.take_ownership_subscriptions.empty() && // NOLINT
       sub_ids.take_shared_subscriptions.size() > 1)
@@ -230,9 +347,10 @@ public:
       auto shared_msg = std::allocate_shared<MessageT, MessageAllocatorT>(allocator, *message);
 
       this->template add_shared_msg_to_buffers<MessageT, Alloc, Deleter>(
-        shared_msg, sub_ids.take_shared_subscriptions);
+        shared_msg, info, sub_ids.take_shared_subscriptions, routing_table->subscriptions);
       this->template add_owned_msg_to_buffers<MessageT, Alloc, Deleter>(
-        std::move(message), sub_ids.take_ownership_subscriptions, allocator);
+        std::move(message), info, sub_ids.take_ownership_subscriptions,
+        routing_table->subscriptions, allocator);
     }
   }
 
@@ -249,10 +367,16 @@ public:
     using MessageAllocTraits = allocator::AllocRebind<MessageT, Alloc>;
     using MessageAllocatorT = typename MessageAllocTraits::allocator_type;
 
-    std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+    auto routing_table = get_routing_table();
+
+    std::shared_ptr<PublisherIntraProcessHistory<MessageT, Alloc, Deleter>> history;
+    std::unique_lock<std::mutex> history_lock;
+    std::tie(history, history_lock) =
+      lock_history<PublisherIntraProcessHistory<MessageT, Alloc, Deleter>>(
+      intra_process_publisher_id, routing_table);
 
-    auto publisher_it = pub_to_subs_.find(intra_process_publisher_id);
-    if (publisher_it == pub_to_subs_.end()) {
+    auto publisher_it = routing_table->pub_to_subs.find(intra_process_publisher_id);
+    if (publisher_it == routing_table->pub_to_subs.end()) {
       // Publisher is either invalid or no longer exists.
       RCLCPP_WARN(
         rclcpp::get_logger("rclcpp"),
@@ -260,29 +384,46 @@ public:
       return nullptr;
     }
     const auto & sub_ids = publisher_it->second;
+    const auto info = make_message_info(intra_process_publisher_id, *routing_table);
 
     if (sub_ids.take_ownership_subscriptions.empty()) {
       // If there are no owning, just convert to shared.
       std::shared_ptr<MessageT> shared_msg = std::move(message);
+      if (history) {
+        history->add(shared_msg, info);
+        history_lock.unlock();
+      }
+      add_msg_to_ring<MessageT, Alloc, Deleter>(
+        intra_process_publisher_id, shared_msg, info, *routing_table);
       if (!sub_ids.take_shared_subscriptions.empty()) {
         this->template add_shared_msg_to_buffers<MessageT, Alloc, Deleter>(
-          shared_msg, sub_ids.take_shared_subscriptions);
+          shared_msg, info, sub_ids.take_shared_subscriptions, routing_table->subscriptions);
       }
       return shared_msg;
     } else {
       // Construct a new shared pointer from the message for the buffers that
       // do not require ownership and to return.
       auto shared_msg = std::allocate_shared<MessageT, MessageAllocatorT>(allocator, *message);
+      if (history) {
+        history->add(shared_msg, info);
+        history_lock.unlock();
+      }
+      add_msg_to_ring<MessageT, Alloc, Deleter>(
+        intra_process_publisher_id, shared_msg, info, *routing_table);
 
       if (!sub_ids.take_shared_subscriptions.empty()) {
         this->template add_shared_msg_to_buffers<MessageT, Alloc, Deleter>(
           shared_msg,
-          sub_ids.take_shared_subscriptions);
+          info,
+          sub_ids.take_shared_subscriptions,
+          routing_table->subscriptions);
       }
       if (!sub_ids.take_ownership_subscriptions.empty()) {
         this->template add_owned_msg_to_buffers<MessageT, Alloc, Deleter>(
           std::move(message),
+          info,
           sub_ids.take_ownership_subscriptions,
+          routing_table->subscriptions,
           allocator);
       }
 
@@ -290,11 +431,150 @@ public:
     }
   }
 
+  /// Publishes an intra-process message which the publisher shares, read-only.
+  /**
+   * The message is given as is to the subscriptions which do not require ownership, and to the
+   * history of the publisher, if any.
+   * The subscriptions which require ownership are given copies.
+   * This is used to share a message loaned from the middleware, see
+   * rclcpp::LoanedMessage::release_shared().
+   *
+   * This method can throw an exception if the publisher id is not found or
+   * if the publisher shared_ptr given to add_publisher has gone out of scope.
+   *
+   * \param intra_process_publisher_id the id of the publisher of this message.
+   * \param message the message that is being shared.
+   * \param allocator the allocator of the copies of the message.
+   * \param deleter the deleter of the copies of the message.
+   */
+  template<
+    typename MessageT,
+    typename Alloc = std::allocator<void>,
+    typename Deleter = std::default_delete<MessageT>>
+  void
+  do_intra_process_publish_shared(
+    uint64_t intra_process_publisher_id,
+    std::shared_ptr<const MessageT> message,
+    typename allocator::AllocRebind<MessageT, Alloc>::allocator_type & allocator,
+    const Deleter & deleter)
+  {
+    using MessageAllocTraits = allocator::AllocRebind<MessageT, Alloc>;
+
+    auto routing_table = get_routing_table();
+
+    std::shared_ptr<PublisherIntraProcessHistory<MessageT, Alloc, Deleter>> history;
+    std::unique_lock<std::mutex> history_lock;
+    std::tie(history, history_lock) =
+      lock_history<PublisherIntraProcessHistory<MessageT, Alloc, Deleter>>(
+      intra_process_publisher_id, routing_table);
+
+    auto publisher_it = routing_table->pub_to_subs.find(intra_process_publisher_id);
+    if (publisher_it == routing_table->pub_to_subs.end()) {
+      // Publisher is either invalid or no longer exists.
+      RCLCPP_WARN(
+        rclcpp::get_logger("rclcpp"),
+        "Calling do_intra_process_publish for invalid or no longer existing publisher id");
+      return;
+    }
+    const auto & sub_ids = publisher_it->second;
+    const auto info = make_message_info(intra_process_publisher_id, *routing_table);
+
+    if (history) {
+      history->add(message, info);
+      history_lock.unlock();
+    }
+    add_msg_to_ring<MessageT, Alloc, Deleter>(
+      intra_process_publisher_id, message, info, *routing_table);
+    if (!sub_ids.take_shared_subscriptions.empty()) {
+      this->template add_shared_msg_to_buffers<MessageT, Alloc, Deleter>(
+        message, info, sub_ids.take_shared_subscriptions, routing_table->subscriptions);
+    }
+    if (!sub_ids.take_ownership_subscriptions.empty()) {
+      auto ptr = MessageAllocTraits::allocate(allocator, 1);
+      MessageAllocTraits::construct(allocator, ptr, *message);
+      this->template add_owned_msg_to_buffers<MessageT, Alloc, Deleter>(
+        std::unique_ptr<MessageT, Deleter>(ptr, deleter),
+        info,
+        sub_ids.take_ownership_subscriptions,
+        routing_table->subscriptions,
+        allocator);
+    }
+  }
+
+  /// Publishes an intra-process message of the custom type of a TypeAdapter.
+  /**
+   * The message is given as is to the subscriptions whose buffer stores the custom type, i.e.
+   * the subscriptions with the same TypeAdapter and a callback taking the custom type.
+   * It is converted to ROSMessageType at most once for the other subscriptions.
+   *
+   * This method can throw an exception if the publisher id is not found or
+   * if the publisher shared_ptr given to add_publisher has gone out of scope.
+   *
+   * This method does allocate memory.
+   *
+   * \param intra_process_publisher_id the id of the publisher of this message.
+   * \param message the message that is being stored.
+   * \param allocator the allocator of the copies of the message.
+   * \param ros_message_allocator the allocator of the ROS messages converted from the message.
+   */
+  template<
+    typename PublishedType,
+    typename ROSMessageType,
+    typename Alloc,
+    typename PublishedTypeDeleter,
+    typename ROSMessageTypeDeleter>
+  void
+  do_intra_process_publish_custom_type(
+    uint64_t intra_process_publisher_id,
+    std::unique_ptr<PublishedType, PublishedTypeDeleter> message,
+    typename allocator::AllocRebind<PublishedType, Alloc>::allocator_type & allocator,
+    typename allocator::AllocRebind<ROSMessageType, Alloc>::allocator_type & ros_message_allocator)
+  {
+    this->template add_custom_type_msg_to_buffers<
+      PublishedType, ROSMessageType, Alloc, PublishedTypeDeleter, ROSMessageTypeDeleter>(
+      intra_process_publisher_id, std::move(message), allocator, ros_message_allocator, false);
+  }
+
+  /// Publishes an intra-process message of the custom type, and returns it as a ROS message.
+  /**
+   * \sa do_intra_process_publish_custom_type()
+   * \return the message converted to ROSMessageType, which can be published inter process.
+   */
+  template<
+    typename PublishedType,
+    typename ROSMessageType,
+    typename Alloc,
+    typename PublishedTypeDeleter,
+    typename ROSMessageTypeDeleter>
+  std::shared_ptr<const ROSMessageType>
+  do_intra_process_publish_custom_type_and_return_ros_shared(
+    uint64_t intra_process_publisher_id,
+    std::unique_ptr<PublishedType, PublishedTypeDeleter> message,
+    typename allocator::AllocRebind<PublishedType, Alloc>::allocator_type & allocator,
+    typename allocator::AllocRebind<ROSMessageType, Alloc>::allocator_type & ros_message_allocator)
+  {
+    return this->template add_custom_type_msg_to_buffers<
+      PublishedType, ROSMessageType, Alloc, PublishedTypeDeleter, ROSMessageTypeDeleter>(
+      intra_process_publisher_id, std::move(message), allocator, ros_message_allocator, true);
+  }
+
   /// Return true if the given rmw_gid_t matches any stored Publishers.
   RCLCPP_PUBLIC
   bool
   matches_any_publishers(const rmw_gid_t * id) const;
 
+  /// Return true if the given rmw_gid_t matches a stored Publisher publishing to a subscription.
+  /**
+   * The messages which such a publisher also published inter process are received intra
+   * process by the subscription.
+   *
+   * \param id the gid of the publisher.
+   * \param intra_process_subscription_id the id of the subscription.
+   */
+  RCLCPP_PUBLIC
+  bool
+  matches_any_publishers(const rmw_gid_t * id, uint64_t intra_process_subscription_id) const;
+
   /// Return the number of intraprocess subscriptions that are matched with a given publisher id.
   RCLCPP_PUBLIC
   size_t
@@ -304,11 +584,37 @@ public:
   rclcpp::experimental::SubscriptionIntraProcessBase::SharedPtr
   get_subscription_intra_process(uint64_t intra_process_subscription_id);
 
+  /// Intra process publishers and subscriptions of one topic and the routes between them.
+  struct TopicInfo
+  {
+    std::string topic_name;
+    /// Number of registered publishers on the topic.
+    size_t publisher_count = 0;
+    /// Number of registered subscriptions on the topic.
+    size_t subscription_count = 0;
+    /// Number of publisher and subscription pairs exchanging messages intra process.
+    /**
+     * Lower than publisher_count * subscription_count if some pairs cannot communicate,
+     * e.g. because of incompatible QoS.
+     */
+    size_t route_count = 0;
+  };
+
+  /// Return the registered publishers, subscriptions and routes of each topic.
+  /**
+   * \return the topics with at least one registered publisher or subscription, sorted by name
+   */
+  RCLCPP_PUBLIC
+  std::vector<TopicInfo>
+  get_topic_info() const;
+
 private:
   struct SplittedSubscriptions
   {
     std::vector<uint64_t> take_shared_subscriptions;
     std::vector<uint64_t> take_ownership_subscriptions;
+    /// Subscriptions reading the messages from the ring of the publisher, only notified of them.
+    std::vector<uint64_t> ring_subscriptions;
   };
 
   using SubscriptionMap =
@@ -320,20 +626,155 @@ private:
   using PublisherToSubscriptionIdsMap =
     std::unordered_map<uint64_t, SplittedSubscriptions>;
 
+  /// Gid of a publisher and number of the messages it published, see make_message_info().
+  struct PublicationState
+  {
+    rmw_gid_t gid{};
+    std::atomic<uint64_t> sequence_number{0};
+  };
+
+  /// Immutable snapshot of the registered entities and of the routes between them.
+  struct RoutingTable
+  {
+    PublisherToSubscriptionIdsMap pub_to_subs;
+    SubscriptionMap subscriptions;
+    PublisherMap publishers;
+    /// Type names of the publishers and subscriptions of serialized messages, by id.
+    std::unordered_map<uint64_t, std::string> serialized_types;
+    /// Histories of the publishers with transient local durability, by id.
+    std::unordered_map<uint64_t, PublisherIntraProcessHistoryBase::SharedPtr> histories;
+    /// Rings of the publishers sharing their messages with their subscriptions, by id.
+    std::unordered_map<uint64_t, PublisherIntraProcessRingBase::SharedPtr> rings;
+    /// Publication state of the publishers, by id, shared by the successive tables.
+    std::unordered_map<uint64_t, std::shared_ptr<PublicationState>> publication_states;
+    /// Services by name, with their ids, in the order of their registration.
+    std::unordered_map<
+      std::string,
+      std::vector<std::pair<uint64_t, rclcpp::experimental::ServiceIntraProcessBase::WeakPtr>>
+    > services;
+  };
+
+  /// Get the current routing table, without taking a lock.
+  std::shared_ptr<const RoutingTable>
+  get_routing_table() const
+  {
+    return std::atomic_load(&routing_table_);
+  }
+
+  /// Lock the history of a publisher, if it has one, and reload the routing table.
+  /**
+   * The routing table is reloaded with the history locked, so that a subscription registered
+   * concurrently is either in the table or gets the message replayed.
+   */
+  template<typename HistoryT>
+  std::pair<std::shared_ptr<HistoryT>, std::unique_lock<std::mutex>>
+  lock_history(
+    uint64_t intra_process_publisher_id,
+    std::shared_ptr<const RoutingTable> & routing_table) const
+  {
+    auto history_it = routing_table->histories.find(intra_process_publisher_id);
+    if (history_it == routing_table->histories.end()) {
+      return {nullptr, std::unique_lock<std::mutex>()};
+    }
+    auto history = std::dynamic_pointer_cast<HistoryT>(history_it->second);
+    if (nullptr == history) {
+      throw std::runtime_error(
+              "failed to dynamic cast PublisherIntraProcessHistoryBase to "
+              "PublisherIntraProcessHistory<MessageT, Alloc, Deleter>");
+    }
+    auto lock = history->lock();
+    routing_table = get_routing_table();
+    return {std::move(history), std::move(lock)};
+  }
+
+  /// Return the metadata of a new publication of a publisher.
+  /**
+   * It increments the sequence number of the publisher, without taking a lock.
+   */
+  RCLCPP_PUBLIC
+  static
+  IntraProcessMessageInfo
+  make_message_info(uint64_t intra_process_publisher_id, const RoutingTable & routing_table);
+
+  /// Replace the routing table, must be called with mutex_ held.
+  RCLCPP_PUBLIC
+  void
+  set_routing_table(std::shared_ptr<RoutingTable> routing_table);
+
   RCLCPP_PUBLIC
   static
   uint64_t
   get_next_unique_id();
 
   RCLCPP_PUBLIC
+  static
   void
-  insert_sub_id_for_pub(uint64_t sub_id, uint64_t pub_id, bool use_take_shared_method);
+  insert_sub_id_for_pub(
+    RoutingTable & routing_table,
+    uint64_t sub_id,
+    uint64_t pub_id,
+    const rclcpp::experimental::SubscriptionIntraProcessBase::SharedPtr & subscription);
 
   RCLCPP_PUBLIC
+  uint64_t
+  register_subscription(
+    rclcpp::experimental::SubscriptionIntraProcessBase::SharedPtr subscription,
+    const std::string * serialized_type_name);
+
+  RCLCPP_PUBLIC
+  uint64_t
+  register_publisher(
+    rclcpp::PublisherBase::SharedPtr publisher,
+    const std::string * serialized_type_name,
+    PublisherIntraProcessHistoryBase::SharedPtr history,
+    PublisherIntraProcessRingBase::SharedPtr ring);
+
+  RCLCPP_PUBLIC
+  static
   bool
   can_communicate(
+    const RoutingTable & routing_table,
+    uint64_t pub_id,
     rclcpp::PublisherBase::SharedPtr pub,
-    rclcpp::experimental::SubscriptionIntraProcessBase::SharedPtr sub) const;
+    uint64_t sub_id,
+    rclcpp::experimental::SubscriptionIntraProcessBase::SharedPtr sub);
+
+  /// Store a message in the ring of its publisher, if any, and notify the subscriptions reading it.
+  template<
+    typename MessageT,
+    typename Alloc,
+    typename Deleter>
+  void
+  add_msg_to_ring(
+    uint64_t intra_process_publisher_id,
+    std::shared_ptr<const MessageT> message,
+    const IntraProcessMessageInfo & info,
+    const RoutingTable & routing_table)
+  {
+    auto ring_it = routing_table.rings.find(intra_process_publisher_id);
+    if (ring_it == routing_table.rings.end()) {
+      return;
+    }
+    const auto & subscription_ids =
+      routing_table.pub_to_subs.at(intra_process_publisher_id).ring_subscriptions;
+    if (subscription_ids.empty()) {
+      return;
+    }
+    // Created by the publisher, for the type of its messages.
+    auto ring = static_cast<PublisherIntraProcessRing<MessageT, Alloc, Deleter> *>(
+      ring_it->second.get());
+    ring->push(std::move(message), info);
+    for (auto id : subscription_ids) {
+      auto subscription_it = routing_table.subscriptions.find(id);
+      if (subscription_it == routing_table.subscriptions.end()) {
+        throw std::runtime_error("subscription has unexpectedly gone out of scope");
+      }
+      auto subscription = subscription_it->second.lock();
+      if (subscription) {
+        subscription->notify_intra_process_message();
+      }
+    }
+  }
 
   template<
     typename MessageT,
@@ -342,29 +783,31 @@ private:
   void
   add_shared_msg_to_buffers(
     std::shared_ptr<const MessageT> message,
-    std::vector<uint64_t> subscription_ids)
+    const IntraProcessMessageInfo & info,
+    const std::vector<uint64_t> & subscription_ids,
+    const SubscriptionMap & subscriptions)
   {
     for (auto id : subscription_ids) {
-      auto subscription_it = subscriptions_.find(id);
-      if (subscription_it == subscriptions_.end()) {
+      auto subscription_it = subscriptions.find(id);
+      if (subscription_it == subscriptions.end()) {
         throw std::runtime_error("subscription has unexpectedly gone out of scope");
       }
       auto subscription_base = subscription_it->second.lock();
       if (subscription_base) {
         auto subscription = std::dynamic_pointer_cast<
-          rclcpp::experimental::SubscriptionIntraProcessBuffer<MessageT, Alloc, Deleter>
+          rclcpp::experimental::ROSMessageIntraProcessBuffer<MessageT, Alloc, Deleter>
           >(subscription_base);
         if (nullptr == subscription) {
           throw std::runtime_error(
                   "failed to dynamic cast SubscriptionIntraProcessBase to "
-                  "SubscriptionIntraProcessBuffer<MessageT, Alloc, Deleter>, which "
+                  "ROSMessageIntraProcessBuffer<MessageT, Alloc, Deleter>, which "
                   "can happen when the publisher and subscription use different "
                   "allocator types, which is not supported");
         }
 
-        subscription->provide_intra_process_message(message);
-      } else {
-        subscriptions_.erase(id);
+        if (subscription->accepts_message(*message)) {
+          subscription->provide_intra_process_message(message, info);
+        }
       }
     }
   }
@@ -376,54 +819,210 @@ private:
   void
   add_owned_msg_to_buffers(
     std::unique_ptr<MessageT, Deleter> message,
-    std::vector<uint64_t> subscription_ids,
+    const IntraProcessMessageInfo & info,
+    const std::vector<uint64_t> & subscription_ids,
+    const SubscriptionMap & subscriptions,
     typename allocator::AllocRebind<MessageT, Alloc>::allocator_type & allocator)
   {
     using MessageAllocTraits = allocator::AllocRebind<MessageT, Alloc>;
     using MessageUniquePtr = std::unique_ptr<MessageT, Deleter>;
+    using ROSMessageBufferT =
+      rclcpp::experimental::ROSMessageIntraProcessBuffer<MessageT, Alloc, Deleter>;
 
-    for (auto it = subscription_ids.begin(); it != subscription_ids.end(); it++) {
-      auto subscription_it = subscriptions_.find(*it);
-      if (subscription_it == subscriptions_.end()) {
+    // The message is given to the last subscription accepting it, so each subscription is only
+    // provided its copy once the next accepting subscription is found.
+    std::shared_ptr<ROSMessageBufferT> pending_subscription;
+    for (auto id : subscription_ids) {
+      auto subscription_it = subscriptions.find(id);
+      if (subscription_it == subscriptions.end()) {
         throw std::runtime_error("subscription has unexpectedly gone out of scope");
       }
       auto subscription_base = subscription_it->second.lock();
       if (subscription_base) {
-        auto subscription = std::dynamic_pointer_cast<
-          rclcpp::experimental::SubscriptionIntraProcessBuffer<MessageT, Alloc, Deleter>
-          >(subscription_base);
+        auto subscription = std::dynamic_pointer_cast<ROSMessageBufferT>(subscription_base);
         if (nullptr == subscription) {
           throw std::runtime_error(
                   "failed to dynamic cast SubscriptionIntraProcessBase to "
-                  "SubscriptionIntraProcessBuffer<MessageT, Alloc, Deleter>, which "
+                  "ROSMessageIntraProcessBuffer<MessageT, Alloc, Deleter>, which "
                   "can happen when the publisher and subscription use different "
                   "allocator types, which is not supported");
         }
-
-        if (std::next(it) == subscription_ids.end()) {
-          // If this is the last subscription, give up ownership
-          subscription->provide_intra_process_message(std::move(message));
-        } else {
-          // Copy the message since we have additional subscriptions to serve
+        if (!subscription->accepts_message(*message)) {
+          continue;
+        }
+        if (pending_subscription) {
+          // Copy the message since we have additional subscriptions to serve.
+          // The copy uses the publisher's allocator, which can recycle the memory of the copies
+          // released by the subscriptions, see rclcpp::allocator::MessagePoolAllocator.
           MessageUniquePtr copy_message;
           Deleter deleter = message.get_deleter();
           auto ptr = MessageAllocTraits::allocate(allocator, 1);
           MessageAllocTraits::construct(allocator, ptr, *message);
           copy_message = MessageUniquePtr(ptr, deleter);
 
-          subscription->provide_intra_process_message(std::move(copy_message));
+          pending_subscription->provide_intra_process_message(std::move(copy_message), info);
         }
-      } else {
-        subscriptions_.erase(subscription_it);
+        pending_subscription = std::move(subscription);
       }
     }
+    if (pending_subscription) {
+      // This is the last subscription, give up ownership
+      pending_subscription->provide_intra_process_message(std::move(message), info);
+    }
+  }
+
+  template<
+    typename PublishedType,
+    typename ROSMessageType,
+    typename Alloc,
+    typename PublishedTypeDeleter,
+    typename ROSMessageTypeDeleter>
+  std::shared_ptr<const ROSMessageType>
+  add_custom_type_msg_to_buffers(
+    uint64_t intra_process_publisher_id,
+    std::unique_ptr<PublishedType, PublishedTypeDeleter> message,
+    typename allocator::AllocRebind<PublishedType, Alloc>::allocator_type & allocator,
+    typename allocator::AllocRebind<ROSMessageType, Alloc>::allocator_type & ros_message_allocator,
+    bool return_ros_message)
+  {
+    using PublishedTypeAllocTraits = allocator::AllocRebind<PublishedType, Alloc>;
+    using PublishedTypeUniquePtr = std::unique_ptr<PublishedType, PublishedTypeDeleter>;
+    using ROSMessageTypeAllocTraits = allocator::AllocRebind<ROSMessageType, Alloc>;
+    using ROSMessageTypeUniquePtr = std::unique_ptr<ROSMessageType, ROSMessageTypeDeleter>;
+    using CustomTypeBufferT = rclcpp::experimental::SubscriptionIntraProcessBuffer<
+      PublishedType, Alloc, PublishedTypeDeleter, ROSMessageType, ROSMessageTypeDeleter>;
+    using ROSMessageBufferT = rclcpp::experimental::ROSMessageIntraProcessBuffer<
+      ROSMessageType, Alloc, ROSMessageTypeDeleter>;
+    using HistoryT = PublisherIntraProcessHistory<ROSMessageType, Alloc, ROSMessageTypeDeleter>;
+
+    auto routing_table = get_routing_table();
+
+    std::shared_ptr<HistoryT> history;
+    std::unique_lock<std::mutex> history_lock;
+    std::tie(history, history_lock) =
+      lock_history<HistoryT>(intra_process_publisher_id, routing_table);
+
+    auto publisher_it = routing_table->pub_to_subs.find(intra_process_publisher_id);
+    if (publisher_it == routing_table->pub_to_subs.end()) {
+      // Publisher is either invalid or no longer exists.
+      RCLCPP_WARN(
+        rclcpp::get_logger("rclcpp"),
+        "Calling do_intra_process_publish for invalid or no longer existing publisher id");
+      return nullptr;
+    }
+    const auto & sub_ids = publisher_it->second;
+    const auto info = make_message_info(intra_process_publisher_id, *routing_table);
+
+    // Sort the subscriptions by the type stored in their buffer.
+    std::vector<std::shared_ptr<CustomTypeBufferT>> custom_type_shared;
+    std::vector<std::shared_ptr<CustomTypeBufferT>> custom_type_owned;
+    std::vector<std::shared_ptr<ROSMessageBufferT>> ros_message_shared;
+    std::vector<std::shared_ptr<ROSMessageBufferT>> ros_message_owned;
+    auto sort_subscriptions =
+      [&routing_table, &custom_type_shared, &custom_type_owned, &ros_message_shared,
+        &ros_message_owned](const std::vector<uint64_t> & subscription_ids, bool take_shared)
+      {
+        for (auto id : subscription_ids) {
+          auto subscription_it = routing_table->subscriptions.find(id);
+          if (subscription_it == routing_table->subscriptions.end()) {
+            throw std::runtime_error("subscription has unexpectedly gone out of scope");
+          }
+          auto subscription_base = subscription_it->second.lock();
+          if (!subscription_base) {
+            continue;
+          }
+          auto custom_type_subscription =
+            std::dynamic_pointer_cast<CustomTypeBufferT>(subscription_base);
+          if (custom_type_subscription) {
+            (take_shared ? custom_type_shared : custom_type_owned).push_back(
+              std::move(custom_type_subscription));
+            continue;
+          }
+          auto ros_message_subscription =
+            std::dynamic_pointer_cast<ROSMessageBufferT>(subscription_base);
+          if (nullptr == ros_message_subscription) {
+            throw std::runtime_error(
+                    "failed to dynamic cast SubscriptionIntraProcessBase to "
+                    "ROSMessageIntraProcessBuffer<ROSMessageType, Alloc, Deleter>, which "
+                    "can happen when the publisher and subscription use different "
+                    "allocator types, which is not supported");
+          }
+          (take_shared ? ros_message_shared : ros_message_owned).push_back(
+            std::move(ros_message_subscription));
+        }
+      };
+    sort_subscriptions(sub_ids.take_shared_subscriptions, true);
+    sort_subscriptions(sub_ids.take_ownership_subscriptions, false);
+
+    // Convert the message once, for all the subscriptions which need a ROS message.
+    std::shared_ptr<const ROSMessageType> ros_message;
+    const bool has_ring_subscriptions = !sub_ids.ring_subscriptions.empty();
+    if (
+      return_ros_message || history || has_ring_subscriptions || !ros_message_shared.empty() ||
+      !ros_message_owned.empty())
+    {
+      auto ptr = std::allocate_shared<ROSMessageType>(ros_message_allocator);
+      rclcpp::TypeAdapter<PublishedType, ROSMessageType>::convert_to_ros_message(*message, *ptr);
+      ros_message = std::move(ptr);
+    }
+    if (history) {
+      history->add(ros_message, info);
+      history_lock.unlock();
+    }
+    if (has_ring_subscriptions) {
+      add_msg_to_ring<ROSMessageType, Alloc, ROSMessageTypeDeleter>(
+        intra_process_publisher_id, ros_message, info, *routing_table);
+    }
+    for (auto & subscription : ros_message_shared) {
+      if (subscription->accepts_message(*ros_message)) {
+        subscription->provide_intra_process_message(ros_message, info);
+      }
+    }
+    if (!ros_message_owned.empty()) {
+      ROSMessageTypeDeleter ros_message_deleter;
+      allocator::set_allocator_for_deleter(&ros_message_deleter, &ros_message_allocator);
+      for (auto & subscription : ros_message_owned) {
+        if (!subscription->accepts_message(*ros_message)) {
+          continue;
+        }
+        auto ptr = ROSMessageTypeAllocTraits::allocate(ros_message_allocator, 1);
+        ROSMessageTypeAllocTraits::construct(ros_message_allocator, ptr, *ros_message);
+        subscription->provide_intra_process_message(
+          ROSMessageTypeUniquePtr(ptr, ros_message_deleter), info);
+      }
+    }
+
+    if (custom_type_owned.empty()) {
+      if (!custom_type_shared.empty()) {
+        std::shared_ptr<const PublishedType> shared_msg = std::move(message);
+        for (auto & subscription : custom_type_shared) {
+          subscription->provide_intra_process_data(shared_msg, info);
+        }
+      }
+      return ros_message;
+    }
+    if (!custom_type_shared.empty()) {
+      auto shared_msg = std::allocate_shared<PublishedType>(allocator, *message);
+      for (auto & subscription : custom_type_shared) {
+        subscription->provide_intra_process_data(shared_msg, info);
+      }
+    }
+    // Copy the message for all the owning subscriptions but the last one, which takes it.
+    for (auto it = custom_type_owned.begin(); std::next(it) != custom_type_owned.end(); ++it) {
+      auto ptr = PublishedTypeAllocTraits::allocate(allocator, 1);
+      PublishedTypeAllocTraits::construct(allocator, ptr, *message);
+      (*it)->provide_intra_process_data(
+        PublishedTypeUniquePtr(ptr, message.get_deleter()), info);
+    }
+    custom_type_owned.back()->provide_intra_process_data(std::move(message), info);
+    return ros_message;
   }
 
-  PublisherToSubscriptionIdsMap pub_to_subs_;
-  SubscriptionMap subscriptions_;
-  PublisherMap publishers_;
+  // Publishing only reads this snapshot, registering or removing an entity replaces it.
+  std::shared_ptr<const RoutingTable> routing_table_;
 
-  mutable std::shared_timed_mutex mutex_;
+  // Serializes the modifications of the routing table.
+  std::mutex mutex_;
 };
 
 }  // namespace experimental
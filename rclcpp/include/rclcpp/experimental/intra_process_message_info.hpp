@@ -0,0 +1,72 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__INTRA_PROCESS_MESSAGE_INFO_HPP_
+#define RCLCPP__EXPERIMENTAL__INTRA_PROCESS_MESSAGE_INFO_HPP_
+
+#include <cstdint>
+
+#include "rcutils/time.h"
+#include "rmw/types.h"
+
+namespace rclcpp
+{
+namespace experimental
+{
+
+/// Metadata of a message published intra process, stored with the message in the buffers.
+/**
+ * It is given to the subscription callbacks taking a rclcpp::MessageInfo, as the middleware
+ * gives the metadata of the messages it delivers, see to_rmw_message_info().
+ */
+struct IntraProcessMessageInfo
+{
+  /// Time of the publication, from the system clock, 0 if unknown.
+  rcutils_time_point_value_t source_timestamp = 0;
+  /// Number of the messages published intra process by the publisher, this one included.
+  /**
+   * The first message of a publisher has the number 1, 0 means unknown.
+   * The numbers are independent of the sequence numbers of the middleware.
+   */
+  uint64_t publication_sequence_number = 0;
+  /// Intra process id of the publisher, 0 if unknown.
+  uint64_t intra_process_publisher_id = 0;
+  /// Gid of the publisher, zero initialized if unknown.
+  rmw_gid_t publisher_gid{};
+};
+
+/// Return the rmw_message_info_t of a message received intra process.
+/**
+ * \param[in] info the metadata of the message.
+ * \return the message info, whose received_timestamp is the current time.
+ */
+inline
+rmw_message_info_t
+to_rmw_message_info(const IntraProcessMessageInfo & info)
+{
+  rmw_message_info_t message_info = rmw_get_zero_initialized_message_info();
+  message_info.source_timestamp = info.source_timestamp;
+  if (RCUTILS_RET_OK != rcutils_system_time_now(&message_info.received_timestamp)) {
+    message_info.received_timestamp = 0;
+  }
+  message_info.publication_sequence_number = info.publication_sequence_number;
+  message_info.publisher_gid = info.publisher_gid;
+  message_info.from_intra_process = true;
+  return message_info;
+}
+
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__INTRA_PROCESS_MESSAGE_INFO_HPP_
@@ -0,0 +1,143 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__PUBLISHER_INTRA_PROCESS_HISTORY_HPP_
+#define RCLCPP__EXPERIMENTAL__PUBLISHER_INTRA_PROCESS_HISTORY_HPP_
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/experimental/intra_process_message_info.hpp"
+#include "rclcpp/experimental/subscription_intra_process_base.hpp"
+#include "rclcpp/experimental/subscription_intra_process_buffer.hpp"
+#include "rclcpp/macros.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+
+/// Last messages published intra process by a publisher with transient local durability.
+/**
+ * The IntraProcessManager replays them to the transient local subscriptions added after they
+ * were published, as the middleware does for inter process late joiners.
+ * The messages are shared with the subscriptions, so they are neither serialized nor copied,
+ * unless a subscription requires their ownership.
+ */
+class PublisherIntraProcessHistoryBase
+{
+public:
+  RCLCPP_SMART_PTR_ALIASES_ONLY(PublisherIntraProcessHistoryBase)
+
+  virtual ~PublisherIntraProcessHistoryBase() = default;
+
+  /// Lock the history, for the duration of a publication.
+  /**
+   * A publication stores its message and selects its recipients with the lock held, so that
+   * a subscription added concurrently gets the message either replayed or published.
+   */
+  std::unique_lock<std::mutex>
+  lock()
+  {
+    return std::unique_lock<std::mutex>(mutex_);
+  }
+
+  /// Provide the stored messages to a subscription, from the oldest to the newest.
+  virtual void
+  replay(SubscriptionIntraProcessBase::SharedPtr subscription) = 0;
+
+protected:
+  std::mutex mutex_;
+};
+
+/// History of the messages of type MessageT published by a publisher.
+template<
+  typename MessageT,
+  typename Alloc = std::allocator<void>,
+  typename Deleter = std::default_delete<MessageT>>
+class PublisherIntraProcessHistory : public PublisherIntraProcessHistoryBase
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(PublisherIntraProcessHistory)
+
+  /// Constructor.
+  /**
+   * \param[in] depth number of messages kept, the history depth of the publisher.
+   * \throws std::invalid_argument if depth is 0.
+   */
+  explicit PublisherIntraProcessHistory(size_t depth)
+  : depth_(depth)
+  {
+    if (0 == depth) {
+      throw std::invalid_argument("the depth of an intra process history must not be 0");
+    }
+  }
+
+  /// Store a published message, dropping the oldest one if the history is full.
+  /**
+   * Must be called with the history locked, see lock().
+   * The metadata of the publication is replayed with the message.
+   */
+  void
+  add(std::shared_ptr<const MessageT> message, const IntraProcessMessageInfo & info)
+  {
+    if (messages_.size() == depth_) {
+      messages_.pop_front();
+    }
+    messages_.emplace_back(std::move(message), info);
+  }
+
+  void
+  replay(SubscriptionIntraProcessBase::SharedPtr subscription) override
+  {
+    auto ros_message_subscription = std::dynamic_pointer_cast<
+      rclcpp::experimental::ROSMessageIntraProcessBuffer<MessageT, Alloc, Deleter>>(
+      subscription);
+    if (nullptr == ros_message_subscription) {
+      throw std::runtime_error(
+              "failed to dynamic cast SubscriptionIntraProcessBase to "
+              "ROSMessageIntraProcessBuffer<MessageT, Alloc, Deleter>, which "
+              "can happen when the publisher and subscription use different "
+              "allocator types, which is not supported");
+    }
+    std::vector<StoredMessage> messages;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      messages.assign(messages_.begin(), messages_.end());
+    }
+    // The buffer of the subscription copies the messages if it requires their ownership.
+    for (auto & message : messages) {
+      if (ros_message_subscription->accepts_message(*message.first)) {
+        ros_message_subscription->provide_intra_process_message(
+          std::move(message.first), message.second);
+      }
+    }
+  }
+
+private:
+  using StoredMessage = std::pair<std::shared_ptr<const MessageT>, IntraProcessMessageInfo>;
+
+  const size_t depth_;
+  std::deque<StoredMessage> messages_;
+};
+
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__PUBLISHER_INTRA_PROCESS_HISTORY_HPP_
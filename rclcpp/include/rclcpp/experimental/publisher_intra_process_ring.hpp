@@ -0,0 +1,174 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__PUBLISHER_INTRA_PROCESS_RING_HPP_
+#define RCLCPP__EXPERIMENTAL__PUBLISHER_INTRA_PROCESS_RING_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/experimental/intra_process_message_info.hpp"
+#include "rclcpp/experimental/subscription_intra_process_base.hpp"
+#include "rclcpp/experimental/subscription_intra_process_buffer.hpp"
+#include "rclcpp/macros.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+
+/// Ring of the last messages published intra process by a publisher, read by its subscriptions.
+/**
+ * Each message is stored once, whatever the number of subscriptions reading the ring, which
+ * only keep the position of the next message they read, see
+ * ROSMessageIntraProcessBuffer::add_publisher_ring().
+ * Publishing a message then costs a single store, plus the wake-up of each subscription,
+ * instead of adding the message to the buffer of each subscription.
+ * A subscription falling behind by more than the capacity of the ring loses the oldest
+ * messages, as it would with a buffer of that depth.
+ */
+class PublisherIntraProcessRingBase
+{
+public:
+  RCLCPP_SMART_PTR_ALIASES_ONLY(PublisherIntraProcessRingBase)
+
+  virtual ~PublisherIntraProcessRingBase() = default;
+
+  /// Let a subscription read the messages published from now on.
+  /**
+   * \return false if the subscription cannot read the ring, and must be given the messages.
+   */
+  virtual bool
+  attach(SubscriptionIntraProcessBase::SharedPtr subscription) = 0;
+
+  /// Mark the ring as closed, once its publisher is removed.
+  /**
+   * The subscriptions detach from a closed ring once they read all its messages.
+   */
+  void
+  close()
+  {
+    closed_.store(true);
+  }
+
+  bool
+  is_closed() const
+  {
+    return closed_.load();
+  }
+
+private:
+  std::atomic_bool closed_{false};
+};
+
+/// Ring of the messages of type MessageT published by a publisher.
+template<typename MessageT, typename Alloc, typename Deleter>
+class PublisherIntraProcessRing
+  : public PublisherIntraProcessRingBase,
+  public std::enable_shared_from_this<PublisherIntraProcessRing<MessageT, Alloc, Deleter>>
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(PublisherIntraProcessRing)
+
+  /// Constructor.
+  /**
+   * \param[in] capacity number of messages kept, the history depth of the publisher.
+   * \throws std::invalid_argument if capacity is 0.
+   */
+  explicit PublisherIntraProcessRing(size_t capacity)
+  : slots_(capacity)
+  {
+    if (0 == capacity) {
+      throw std::invalid_argument("the capacity of an intra process ring must not be 0");
+    }
+  }
+
+  /// Store a published message, overwriting the oldest one if the ring is full.
+  void
+  push(std::shared_ptr<const MessageT> message, const IntraProcessMessageInfo & info)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t end = end_.load(std::memory_order_relaxed);
+    slots_[end % slots_.size()] = StoredMessage(std::move(message), info);
+    end_.store(end + 1, std::memory_order_release);
+  }
+
+  /// Get the position following the last published message, i.e. the number of messages.
+  uint64_t
+  end() const
+  {
+    return end_.load(std::memory_order_acquire);
+  }
+
+  size_t
+  capacity() const
+  {
+    return slots_.size();
+  }
+
+  /// Read the message at a position.
+  /**
+   * \return false if the message is not published yet, or was overwritten.
+   */
+  bool
+  read(
+    uint64_t position,
+    std::shared_ptr<const MessageT> & message,
+    IntraProcessMessageInfo & info) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t end = end_.load(std::memory_order_relaxed);
+    if (position >= end || end - position > slots_.size()) {
+      return false;
+    }
+    const auto & slot = slots_[position % slots_.size()];
+    message = slot.first;
+    info = slot.second;
+    return true;
+  }
+
+  bool
+  attach(SubscriptionIntraProcessBase::SharedPtr subscription) override
+  {
+    auto ros_message_subscription = std::dynamic_pointer_cast<
+      rclcpp::experimental::ROSMessageIntraProcessBuffer<MessageT, Alloc, Deleter>>(
+      subscription);
+    if (nullptr == ros_message_subscription) {
+      throw std::runtime_error(
+              "failed to dynamic cast SubscriptionIntraProcessBase to "
+              "ROSMessageIntraProcessBuffer<MessageT, Alloc, Deleter>, which "
+              "can happen when the publisher and subscription use different "
+              "allocator types, which is not supported");
+    }
+    return ros_message_subscription->add_publisher_ring(this->shared_from_this());
+  }
+
+private:
+  using StoredMessage = std::pair<std::shared_ptr<const MessageT>, IntraProcessMessageInfo>;
+
+  mutable std::mutex mutex_;
+  std::vector<StoredMessage> slots_;
+  std::atomic<uint64_t> end_{0};
+};
+
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__PUBLISHER_INTRA_PROCESS_RING_HPP_
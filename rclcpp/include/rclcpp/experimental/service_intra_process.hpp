@@ -0,0 +1,164 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__SERVICE_INTRA_PROCESS_HPP_
+#define RCLCPP__EXPERIMENTAL__SERVICE_INTRA_PROCESS_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "rmw/types.h"
+
+#include "rclcpp/context.hpp"
+#include "rclcpp/experimental/service_intra_process_base.hpp"
+#include "rclcpp/macros.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+
+/// Queue of the requests sent intra process to a service of type ServiceT.
+/**
+ * The requests and the responses are passed as shared pointers, without being serialized.
+ * The requests are given negative sequence numbers, so that they are not mistaken for the
+ * requests received from the middleware, whose sequence numbers are positive.
+ */
+template<typename ServiceT>
+class ServiceIntraProcess : public ServiceIntraProcessBase
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(ServiceIntraProcess)
+
+  using SharedRequest = std::shared_ptr<typename ServiceT::Request>;
+  using SharedResponse = std::shared_ptr<typename ServiceT::Response>;
+  /// Called with the response to a request, from the thread sending the response.
+  using ResponseCallback = std::function<void (SharedResponse)>;
+  /// Called by the executor with each request, see Service::handle_intra_process_request().
+  using RequestHandler =
+    std::function<void (std::shared_ptr<rmw_request_id_t>, SharedRequest)>;
+
+  ServiceIntraProcess(
+    rclcpp::Context::SharedPtr context,
+    const std::string & service_name,
+    RequestHandler request_handler)
+  : ServiceIntraProcessBase(std::move(context), service_name),
+    request_handler_(std::move(request_handler))
+  {}
+
+  virtual ~ServiceIntraProcess() = default;
+
+  /// Return true if the header is the one of a request sent intra process.
+  static bool
+  is_intra_process_request(const rmw_request_id_t & request_header)
+  {
+    return request_header.sequence_number < 0;
+  }
+
+  /// Queue a request, to be executed by the executor of the service.
+  /**
+   * \param[in] request the request, shared with the service callback.
+   * \param[in] response_callback called with the response once the service sends it.
+   */
+  void
+  send_request(SharedRequest request, ResponseCallback response_callback)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      const int64_t sequence_number = next_sequence_number_--;
+      pending_responses_.emplace(sequence_number, std::move(response_callback));
+      requests_.emplace_back(sequence_number, std::move(request));
+    }
+    notify_new_request();
+  }
+
+  /// Give the response of a request to its client.
+  /**
+   * \return false if the request is unknown, e.g. it was already responded to.
+   */
+  bool
+  send_response(int64_t sequence_number, SharedResponse response)
+  {
+    ResponseCallback response_callback;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = pending_responses_.find(sequence_number);
+      if (it == pending_responses_.end()) {
+        return false;
+      }
+      response_callback = std::move(it->second);
+      pending_responses_.erase(it);
+    }
+    response_callback(std::move(response));
+    return true;
+  }
+
+  bool
+  is_ready(rcl_wait_set_t * wait_set) override
+  {
+    (void)wait_set;
+    std::lock_guard<std::mutex> lock(mutex_);
+    return !requests_.empty();
+  }
+
+  std::shared_ptr<void>
+  take_data() override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (requests_.empty()) {
+      return nullptr;
+    }
+    auto request = std::make_shared<QueuedRequest>(std::move(requests_.front()));
+    requests_.pop_front();
+    if (!requests_.empty()) {
+      trigger_guard_condition();
+    }
+    return request;
+  }
+
+  void
+  execute(std::shared_ptr<void> & data) override
+  {
+    if (!data) {
+      return;
+    }
+    auto request = std::static_pointer_cast<QueuedRequest>(data);
+    auto request_header = std::make_shared<rmw_request_id_t>();
+    std::memset(request_header->writer_guid, 0, sizeof(request_header->writer_guid));
+    request_header->sequence_number = request->first;
+    request_handler_(std::move(request_header), std::move(request->second));
+  }
+
+private:
+  using QueuedRequest = std::pair<int64_t, SharedRequest>;
+
+  RequestHandler request_handler_;
+
+  std::mutex mutex_;
+  std::deque<QueuedRequest> requests_;
+  std::unordered_map<int64_t, ResponseCallback> pending_responses_;
+  int64_t next_sequence_number_{-1};
+};
+
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__SERVICE_INTRA_PROCESS_HPP_
@@ -0,0 +1,119 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__SERVICE_INTRA_PROCESS_BASE_HPP_
+#define RCLCPP__EXPERIMENTAL__SERVICE_INTRA_PROCESS_BASE_HPP_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "rcl/wait.h"
+
+#include "rclcpp/context.hpp"
+#include "rclcpp/guard_condition.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/visibility_control.hpp"
+#include "rclcpp/waitable.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+
+/// Waitable executing the requests sent intra process to a service.
+/**
+ * It is added to the callback group of the service, so the requests of the clients of the
+ * same context are executed as the requests received from the middleware, without being
+ * serialized.
+ */
+class ServiceIntraProcessBase : public rclcpp::Waitable
+{
+public:
+  RCLCPP_SMART_PTR_ALIASES_ONLY(ServiceIntraProcessBase)
+
+  RCLCPP_PUBLIC
+  ServiceIntraProcessBase(
+    rclcpp::Context::SharedPtr context,
+    const std::string & service_name);
+
+  RCLCPP_PUBLIC
+  virtual ~ServiceIntraProcessBase();
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_ready_guard_conditions() override {return 1;}
+
+  RCLCPP_PUBLIC
+  bool
+  add_to_wait_set(rcl_wait_set_t * wait_set) override;
+
+  /// Return the fully qualified name of the service.
+  RCLCPP_PUBLIC
+  const char *
+  get_service_name() const;
+
+  /// Set a callback to be called when each new request arrives.
+  /**
+   * The callback receives the number of requests received since the last time it was called,
+   * and 0 as identifier.
+   * Requests which arrived before the callback was set are reported on the call to this
+   * function.
+   *
+   * The callback is called from the thread sending the request, so it should be fast and not
+   * blocking.
+   *
+   * \param[in] callback functor to be called when a new request is received
+   * \throws std::invalid_argument if the callback is empty
+   */
+  RCLCPP_PUBLIC
+  void
+  set_on_ready_callback(std::function<void(size_t, int)> callback) override;
+
+  /// Unset the callback registered for new requests, if any.
+  RCLCPP_PUBLIC
+  void
+  clear_on_ready_callback() override;
+
+protected:
+  /// Wake the executor up for a new request, must be called once it is queued.
+  RCLCPP_PUBLIC
+  void
+  notify_new_request();
+
+  /// Wake the executor up again, without reporting a new request.
+  /**
+   * A guard condition wakes a wait set up once however often it was triggered, so this is
+   * called when requests are still queued after one was taken.
+   */
+  RCLCPP_PUBLIC
+  void
+  trigger_guard_condition();
+
+private:
+  RCLCPP_DISABLE_COPY(ServiceIntraProcessBase)
+
+  std::string service_name_;
+  rclcpp::GuardCondition guard_condition_;
+
+  std::recursive_mutex callback_mutex_;
+  std::function<void(size_t)> on_new_request_callback_{nullptr};
+  size_t unread_count_{0};
+};
+
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__SERVICE_INTRA_PROCESS_BASE_HPP_
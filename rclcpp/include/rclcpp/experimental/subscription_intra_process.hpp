@@ -17,46 +17,75 @@
 
 #include <rmw/rmw.h>
 
+#include <chrono>
 #include <functional>
 #include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "rcl/error_handling.h"
 
 #include "rclcpp/any_subscription_callback.hpp"
+#include "rclcpp/detail/taken_data_slot.hpp"
 #include "rclcpp/experimental/buffers/intra_process_buffer.hpp"
 #include "rclcpp/experimental/create_intra_process_buffer.hpp"
+#include "rclcpp/experimental/intra_process_message_info.hpp"
+#include "rclcpp/experimental/publisher_intra_process_ring.hpp"
 #include "rclcpp/experimental/subscription_intra_process_base.hpp"
 #include "rclcpp/experimental/subscription_intra_process_buffer.hpp"
 #include "rclcpp/qos.hpp"
+#include "rclcpp/time.hpp"
+#include "rclcpp/tracing.hpp"
 #include "rclcpp/type_support_decl.hpp"
 #include "rclcpp/waitable.hpp"
 #include "tracetools/tracetools.h"
 
 namespace rclcpp
 {
+
+namespace topic_statistics
+{
+/**
+ * SubscriptionTopicStatistics is forward declared here, avoiding a circular inclusion between
+ * `subscription_topic_statistics.hpp`, which includes `publisher.hpp`, and this header.
+ */
+template<typename CallbackMessageT>
+class SubscriptionTopicStatistics;
+}  // namespace topic_statistics
+
 namespace experimental
 {
 
+/// Intra-process subscription, dispatching the messages of its buffer to the callback.
+/**
+ * MessageT is the type stored by the buffer, which is the custom type of a type adapter when the
+ * callback takes it, otherwise the ROS message type.
+ */
 template<
   typename MessageT,
   typename Alloc = std::allocator<void>,
   typename Deleter = std::default_delete<MessageT>,
-  typename CallbackMessageT = MessageT>
+  typename CallbackMessageT = MessageT,
+  typename ROSMessageType = MessageT,
+  typename ROSMessageTypeDeleter = Deleter>
 class SubscriptionIntraProcess
   : public SubscriptionIntraProcessBuffer<
     MessageT,
     Alloc,
-    Deleter
+    Deleter,
+    ROSMessageType,
+    ROSMessageTypeDeleter
   >
 {
   using SubscriptionIntraProcessBufferT = SubscriptionIntraProcessBuffer<
     MessageT,
     Alloc,
-    Deleter
+    Deleter,
+    ROSMessageType,
+    ROSMessageTypeDeleter
   >;
 
 public:
@@ -74,14 +103,21 @@ public:
     rclcpp::Context::SharedPtr context,
     const std::string & topic_name,
     const rclcpp::QoS & qos_profile,
-    rclcpp::IntraProcessBufferType buffer_type)
-  : SubscriptionIntraProcessBuffer<MessageT, Alloc, Deleter>(
+    rclcpp::IntraProcessBufferType buffer_type,
+    size_t buffer_memory_budget = 0)
+  : SubscriptionIntraProcessBufferT(
       allocator,
       context,
       topic_name,
       qos_profile,
-      buffer_type),
-    any_callback_(callback)
+      buffer_type,
+      buffer_memory_budget),
+    any_callback_(callback),
+    // Callbacks which do not take ownership of the messages, e.g. taking a const reference, take
+    // them as they are stored, so that shared messages are not copied.
+    take_shared_(
+      any_callback_.use_take_shared_method() ||
+      (!any_callback_.takes_message_ownership() && this->buffer_->use_take_shared_method()))
   {
     TRACEPOINT(
       rclcpp_subscription_callback_added,
@@ -100,19 +136,28 @@ public:
   std::shared_ptr<void>
   take_data()
   {
-    ConstMessageSharedPtr shared_msg;
-    MessageUniquePtr unique_msg;
-
-    if (any_callback_.use_take_shared_method()) {
-      shared_msg = this->buffer_->consume_shared();
+    auto taken_message = taken_messages_.acquire();
+    if (this->buffer_->has_data()) {
+      if (take_shared_) {
+        taken_message->shared_msg = this->buffer_->consume_shared(taken_message->info);
+      } else {
+        taken_message->unique_msg = this->buffer_->consume_unique(taken_message->info);
+      }
     } else {
-      unique_msg = this->buffer_->consume_unique();
+      bool consumed = false;
+      if constexpr (std::is_same<MessageT, ROSMessageType>::value) {
+        // The messages of the publishers sharing a ring are shared, whatever the callback.
+        consumed = this->consume_from_rings(taken_message->shared_msg, taken_message->info);
+      }
+      if (!consumed) {
+        // An on ready callback may report more messages than remain, e.g. after a message was
+        // dropped from a full buffer.
+        return nullptr;
+      }
     }
-    return std::static_pointer_cast<void>(
-      std::make_shared<std::pair<ConstMessageSharedPtr, MessageUniquePtr>>(
-        std::pair<ConstMessageSharedPtr, MessageUniquePtr>(
-          shared_msg, std::move(unique_msg)))
-    );
+    this->trace_message(
+      rclcpp::tracing::TraceEventType::IntraProcessDequeue, taken_message->info);
+    return std::static_pointer_cast<void>(taken_message);
   }
 
   void execute(std::shared_ptr<void> & data)
@@ -120,7 +165,28 @@ public:
     execute_impl<MessageT>(data);
   }
 
+  /// Set the topic statistics of the subscription, measuring the messages before dispatching them.
+  /**
+   * Only the buffers storing the ROS message type measure the messages, since the statistics
+   * read their header.
+   */
+  void
+  set_topic_statistics(
+    std::shared_ptr<rclcpp::topic_statistics::SubscriptionTopicStatistics<ROSMessageType>>
+    topic_statistics)
+  {
+    topic_statistics_ = std::move(topic_statistics);
+  }
+
 protected:
+  /// A message taken from the buffer, with the metadata of its publication.
+  struct TakenMessage
+  {
+    ConstMessageSharedPtr shared_msg;
+    MessageUniquePtr unique_msg;
+    IntraProcessMessageInfo info;
+  };
+
   template<typename T>
   typename std::enable_if<std::is_same<T, rcl_serialized_message_t>::value, void>::type
   execute_impl(std::shared_ptr<void> & data)
@@ -134,27 +200,75 @@ protected:
   execute_impl(std::shared_ptr<void> & data)
   {
     if (!data) {
-      throw std::runtime_error("'data' is empty");
+      // take_data() found no message.
+      return;
     }
 
-    rmw_message_info_t msg_info;
-    msg_info.publisher_gid = {0, {0}};
-    msg_info.from_intra_process = true;
+    auto taken_message = std::static_pointer_cast<TakenMessage>(data);
+    // Moved out, so that the reused storage does not keep the message.
+    IntraProcessMessageInfo info = taken_message->info;
+    if (take_shared_ || taken_message->shared_msg) {
+      ConstMessageSharedPtr shared_msg = std::move(taken_message->shared_msg);
+      taken_message.reset();
+      dispatch(std::move(shared_msg), info);
+    } else {
+      MessageUniquePtr unique_msg = std::move(taken_message->unique_msg);
+      taken_message.reset();
+      dispatch(std::move(unique_msg), info);
+    }
+  }
 
-    auto shared_ptr = std::static_pointer_cast<std::pair<ConstMessageSharedPtr, MessageUniquePtr>>(
-      data);
+  void
+  dispatch_directly(ConstMessageSharedPtr message, const IntraProcessMessageInfo & info) override
+  {
+    if constexpr (std::is_same<MessageT, rcl_serialized_message_t>::value) {
+      (void)message;
+      (void)info;
+      throw std::runtime_error("Subscription intra-process can't handle serialized messages");
+    } else {
+      dispatch(std::move(message), info);
+    }
+  }
 
-    if (any_callback_.use_take_shared_method()) {
-      ConstMessageSharedPtr shared_msg = shared_ptr->first;
-      any_callback_.dispatch_intra_process(shared_msg, msg_info);
+  void
+  dispatch_directly(MessageUniquePtr message, const IntraProcessMessageInfo & info) override
+  {
+    if constexpr (std::is_same<MessageT, rcl_serialized_message_t>::value) {
+      (void)message;
+      (void)info;
+      throw std::runtime_error("Subscription intra-process can't handle serialized messages");
+    } else {
+      dispatch(std::move(message), info);
+    }
+  }
+
+  /// Measure a message and give it to the callback, from the executor or the publishing thread.
+  template<typename MessagePtrT>
+  void
+  dispatch(MessagePtrT message, const IntraProcessMessageInfo & info)
+  {
+    rmw_message_info_t msg_info = to_rmw_message_info(info);
+    if constexpr (std::is_same<MessageT, ROSMessageType>::value) {
+      if (topic_statistics_) {
+        // Measured before the callback takes the message, excluding it from the message age.
+        const auto nanos = std::chrono::time_point_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now());
+        topic_statistics_->handle_intra_process_message(
+          *message, rclcpp::Time(nanos.time_since_epoch().count()), info.source_timestamp);
+      }
+    }
+    if constexpr (std::is_same<MessagePtrT, ConstMessageSharedPtr>::value) {
+      any_callback_.dispatch_intra_process(message, msg_info);
     } else {
-      MessageUniquePtr unique_msg = std::move(shared_ptr->second);
-      any_callback_.dispatch_intra_process(std::move(unique_msg), msg_info);
+      any_callback_.dispatch_intra_process(std::move(message), msg_info);
     }
-    shared_ptr.reset();
   }
 
   AnySubscriptionCallback<CallbackMessageT, Alloc> any_callback_;
+  const bool take_shared_;
+  rclcpp::detail::TakenDataSlot<TakenMessage> taken_messages_;
+  std::shared_ptr<rclcpp::topic_statistics::SubscriptionTopicStatistics<ROSMessageType>>
+  topic_statistics_;
 };
 
 }  // namespace experimental
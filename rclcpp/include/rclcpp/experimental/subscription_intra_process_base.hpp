@@ -17,6 +17,8 @@
 
 #include <rmw/rmw.h>
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -26,11 +28,15 @@
 #include "rcl/error_handling.h"
 
 #include "rclcpp/qos.hpp"
+#include "rclcpp/qos_event.hpp"
 #include "rclcpp/type_support_decl.hpp"
 #include "rclcpp/waitable.hpp"
 
 namespace rclcpp
 {
+
+class CallbackGroup;
+
 namespace experimental
 {
 
@@ -77,10 +83,138 @@ public:
   QoS
   get_actual_qos() const;
 
+  /// Get the number of messages waiting in the buffer, i.e. how far behind the callback is.
+  virtual size_t
+  get_lag() const = 0;
+
+  /// Get the number of messages the buffer can currently hold.
+  /**
+   * It is the depth of the QoS, unless the buffer is adaptive.
+   * \sa rclcpp::SubscriptionOptionsBase::intra_process_buffer_memory_budget
+   */
+  virtual size_t
+  get_buffer_capacity() const = 0;
+
+  /// Get the number of messages dropped because the buffer was full, since its creation.
+  RCLCPP_PUBLIC
+  uint64_t
+  get_dropped_count() const;
+
+  /// Set a callback to be called when a message is dropped because the buffer is full.
+  /**
+   * It is the intra-process equivalent of the message lost event of the subscription, see
+   * rclcpp::SubscriptionEventCallbacks::message_lost_callback.
+   * The callback receives the number of messages dropped since the creation of the buffer, and
+   * the number of messages dropped since its previous call.
+   *
+   * The callback is called from the thread publishing the message, so it
+   * should be fast and not blocking.
+   *
+   * \param[in] callback functor to be called when a message is dropped, or nullptr to unset it
+   */
+  RCLCPP_PUBLIC
+  void
+  set_message_lost_callback(rclcpp::QOSMessageLostCallbackType callback);
+
+  /// Let the publishers call the callback on their thread, instead of queuing the messages.
+  /**
+   * A message is dispatched directly while the callback group is added to an executor and can
+   * be taken from, the buffer holds no older message and fewer than max_depth direct dispatches
+   * are nested in the publishing thread, e.g. by callbacks publishing to the next stage of a
+   * filter chain.
+   * Otherwise the message is queued and executed by the executor, as without direct dispatch.
+   * The callback is never dispatched directly while it is already dispatched directly, whether
+   * it publishes to its own topic or several threads publish concurrently.
+   *
+   * Must be called before the subscription is added to the IntraProcessManager.
+   *
+   * \param[in] max_depth maximum number of nested direct dispatches, 0 to disable them.
+   * \param[in] callback_group the callback group of the subscription.
+   * \sa rclcpp::SubscriptionOptionsBase::intra_process_direct_dispatch_depth
+   */
+  RCLCPP_PUBLIC
+  void
+  set_direct_dispatch(size_t max_depth, std::weak_ptr<rclcpp::CallbackGroup> callback_group);
+
+  /// Get the number of messages dispatched directly on the publishing threads.
+  RCLCPP_PUBLIC
+  uint64_t
+  get_direct_dispatch_count() const;
+
+  /// Wake the subscription for a new message of a publisher ring it reads.
+  /**
+   * \sa rclcpp::experimental::ROSMessageIntraProcessBuffer::add_publisher_ring()
+   */
+  RCLCPP_PUBLIC
+  void
+  notify_intra_process_message();
+
+  /// Set a callback to be called when each new message arrives.
+  /**
+   * The callback receives a size_t which is the number of messages received
+   * since the last time this callback was called, and 0 as identifier.
+   * Messages which arrived before the callback was set are reported on the
+   * call to this function.
+   *
+   * The callback is called from the thread publishing the message, so it
+   * should be fast and not blocking.
+   *
+   * Calling it again will clear any previously set callback.
+   *
+   * \param[in] callback functor to be called when a new message is received
+   * \throws std::invalid_argument if the callback is empty
+   */
+  RCLCPP_PUBLIC
+  void
+  set_on_ready_callback(std::function<void(size_t, int)> callback) override;
+
+  /// Unset the callback registered for new messages, if any.
+  RCLCPP_PUBLIC
+  void
+  clear_on_ready_callback() override;
+
 protected:
+  /// Call the on ready callback for a new message, or count it if none is set.
+  RCLCPP_PUBLIC
+  void
+  invoke_on_new_message();
+
+  /// Count a message dropped from the full buffer, and call the message lost callback if set.
+  RCLCPP_PUBLIC
+  void
+  on_message_dropped();
+
+  /// Start a direct dispatch if the message can skip the buffer, see set_direct_dispatch().
+  /**
+   * \return true if the callback must be called with the message, followed by
+   *   end_direct_dispatch(), false if the message must be queued.
+   */
+  RCLCPP_PUBLIC
+  bool
+  try_begin_direct_dispatch();
+
+  /// End a direct dispatch started by try_begin_direct_dispatch(), releasing the callback group.
+  RCLCPP_PUBLIC
+  void
+  end_direct_dispatch();
+
   std::recursive_mutex reentrant_mutex_;
   rcl_guard_condition_t gc_;
 
+  std::recursive_mutex callback_mutex_;
+  std::function<void(size_t)> on_new_message_callback_{nullptr};
+  size_t unread_count_{0};
+
+  std::atomic<uint64_t> dropped_count_{0};
+  rclcpp::QOSMessageLostCallbackType on_message_lost_callback_{nullptr};
+  // Value of dropped_count_ at the previous call of the message lost callback.
+  uint64_t reported_dropped_count_{0};
+
+  size_t max_direct_dispatch_depth_{0};
+  std::weak_ptr<rclcpp::CallbackGroup> direct_dispatch_callback_group_;
+  std::atomic_bool direct_dispatching_{false};
+  std::atomic<uint64_t> direct_dispatch_count_{0};
+
 private:
   virtual void
   trigger_guard_condition() = 0;
@@ -17,20 +17,30 @@
 
 #include <rmw/rmw.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "rcl/error_handling.h"
 
 #include "rclcpp/any_subscription_callback.hpp"
+#include "rclcpp/detail/message_rate_limiter.hpp"
 #include "rclcpp/experimental/buffers/intra_process_buffer.hpp"
 #include "rclcpp/experimental/create_intra_process_buffer.hpp"
+#include "rclcpp/experimental/intra_process_message_info.hpp"
 #include "rclcpp/experimental/subscription_intra_process_base.hpp"
 #include "rclcpp/qos.hpp"
+#include "rclcpp/tracing.hpp"
+#include "rclcpp/type_adapter.hpp"
 #include "rclcpp/type_support_decl.hpp"
 #include "rclcpp/waitable.hpp"
 #include "tracetools/tracetools.h"
@@ -40,25 +50,137 @@ namespace rclcpp
 namespace experimental
 {
 
+// Defined in publisher_intra_process_ring.hpp, read by the buffers of the subscriptions.
 template<
   typename MessageT,
   typename Alloc = std::allocator<void>,
-  typename Deleter = std::default_delete<MessageT>
+  typename Deleter = std::default_delete<MessageT>>
+class PublisherIntraProcessRing;
+
+/// Interface of the intra-process buffers receiving ROS messages.
+/**
+ * The publishers of ROS messages provide their messages through this interface, whatever the
+ * type stored by the buffer of the subscription.
+ */
+template<
+  typename ROSMessageType,
+  typename Alloc = std::allocator<void>,
+  typename ROSMessageTypeDeleter = std::default_delete<ROSMessageType>
 >
-class SubscriptionIntraProcessBuffer : public SubscriptionIntraProcessBase
+class ROSMessageIntraProcessBuffer : public SubscriptionIntraProcessBase
 {
+public:
+  RCLCPP_SMART_PTR_ALIASES_ONLY(ROSMessageIntraProcessBuffer)
+
+  using ConstMessageSharedPtr = std::shared_ptr<const ROSMessageType>;
+  using MessageUniquePtr = std::unique_ptr<ROSMessageType, ROSMessageTypeDeleter>;
+  using PublisherRingT = PublisherIntraProcessRing<ROSMessageType, Alloc, ROSMessageTypeDeleter>;
+
+  ROSMessageIntraProcessBuffer(
+    const std::string & topic_name,
+    const rclcpp::QoS & qos_profile)
+  : SubscriptionIntraProcessBase(topic_name, qos_profile)
+  {}
+
+  virtual ~ROSMessageIntraProcessBuffer() = default;
+
+  /// Provide a message, with the metadata of its publication.
+  virtual void
+  provide_intra_process_message(
+    ConstMessageSharedPtr message,
+    const IntraProcessMessageInfo & info) = 0;
+
+  virtual void
+  provide_intra_process_message(
+    MessageUniquePtr message,
+    const IntraProcessMessageInfo & info) = 0;
+
+  /// Read the messages of a publisher from its ring, instead of being provided them.
+  /**
+   * The subscription reads the messages published from now on, and is only notified of them,
+   * see SubscriptionIntraProcessBase::notify_intra_process_message().
+   *
+   * \return false if the subscription cannot read rings, and must be provided the messages.
+   */
+  virtual bool
+  add_publisher_ring(std::shared_ptr<PublisherRingT> ring)
+  {
+    (void)ring;
+    return false;
+  }
+
+  /// Set the predicate selecting the messages provided to this buffer, see accepts_message().
+  void
+  set_message_filter(std::function<bool (const void *)> message_filter)
+  {
+    message_filter_ = std::move(message_filter);
+  }
+
+  /// Set the minimum period between two messages provided to this buffer, see accepts_message().
+  void
+  set_min_message_period(std::chrono::nanoseconds min_message_period)
+  {
+    message_rate_limiter_.set_min_period(min_message_period);
+  }
+
+  /// Return false if the message must not be provided to this buffer.
+  /**
+   * It is called by the publishers before they provide, and possibly copy, a message.
+   * A message passing the filter arriving before the end of the minimum message period is
+   * rejected, otherwise it must be provided, as it starts a new period.
+   */
+  bool
+  accepts_message(const ROSMessageType & message)
+  {
+    if (message_filter_ && !message_filter_(&message)) {
+      return false;
+    }
+    return message_rate_limiter_.try_accept();
+  }
+
+private:
+  std::function<bool (const void *)> message_filter_;
+  rclcpp::detail::MessageRateLimiter message_rate_limiter_;
+};
+
+/// Intra-process buffer of a subscription, storing messages of the subscribed type.
+/**
+ * With a type adapter, the subscribed type is the custom type while ROSMessageType is the ROS
+ * message type of the adapter.
+ * Publishers of the custom type provide their messages with provide_intra_process_data(), so
+ * that they reach the buffer without being converted.
+ * The ROS messages provided with provide_intra_process_message() are converted to the custom
+ * type before being stored.
+ */
+template<
+  typename SubscribedType,
+  typename Alloc = std::allocator<void>,
+  typename SubscribedTypeDeleter = std::default_delete<SubscribedType>,
+  typename ROSMessageType = SubscribedType,
+  typename ROSMessageTypeDeleter = SubscribedTypeDeleter
+>
+class SubscriptionIntraProcessBuffer
+  : public ROSMessageIntraProcessBuffer<ROSMessageType, Alloc, ROSMessageTypeDeleter>
+{
+  using ROSMessageIntraProcessBufferT =
+    ROSMessageIntraProcessBuffer<ROSMessageType, Alloc, ROSMessageTypeDeleter>;
+
 public:
   RCLCPP_SMART_PTR_DEFINITIONS(SubscriptionIntraProcessBuffer)
 
-  using MessageAllocTraits = allocator::AllocRebind<MessageT, Alloc>;
+  using MessageAllocTraits = allocator::AllocRebind<SubscribedType, Alloc>;
   using MessageAlloc = typename MessageAllocTraits::allocator_type;
-  using ConstMessageSharedPtr = std::shared_ptr<const MessageT>;
-  using MessageUniquePtr = std::unique_ptr<MessageT, Deleter>;
+  using ConstMessageSharedPtr = std::shared_ptr<const SubscribedType>;
+  using MessageUniquePtr = std::unique_ptr<SubscribedType, SubscribedTypeDeleter>;
+
+  using ConstROSMessageSharedPtr = typename ROSMessageIntraProcessBufferT::ConstMessageSharedPtr;
+  using ROSMessageUniquePtr = typename ROSMessageIntraProcessBufferT::MessageUniquePtr;
+  using PublisherRingT = typename ROSMessageIntraProcessBufferT::PublisherRingT;
 
   using BufferUniquePtr = typename rclcpp::experimental::buffers::IntraProcessBuffer<
-    MessageT,
+    SubscribedType,
     Alloc,
-    Deleter
+    SubscribedTypeDeleter
     >::UniquePtr;
 
   SubscriptionIntraProcessBuffer(
@@ -66,22 +188,31 @@ public:
     rclcpp::Context::SharedPtr context,
     const std::string & topic_name,
     const rclcpp::QoS & qos_profile,
-    rclcpp::IntraProcessBufferType buffer_type)
-  : SubscriptionIntraProcessBase(topic_name, qos_profile)
+    rclcpp::IntraProcessBufferType buffer_type,
+    size_t buffer_memory_budget = 0)
+  : ROSMessageIntraProcessBufferT(topic_name, qos_profile),
+    message_allocator_(*allocator)
   {
+    if constexpr (!std::is_same<SubscribedType, ROSMessageType>::value) {
+      // Only used to convert the ROS messages.
+      allocator::set_allocator_for_deleter(&message_deleter_, &message_allocator_);
+    }
+
     // Create the intra-process buffer.
-    buffer_ = rclcpp::experimental::create_intra_process_buffer<MessageT, Alloc, Deleter>(
+    buffer_ = rclcpp::experimental::create_intra_process_buffer<
+      SubscribedType, Alloc, SubscribedTypeDeleter>(
       buffer_type,
       qos_profile,
-      allocator);
+      allocator,
+      buffer_memory_budget / sizeof(SubscribedType));
 
     // Create the guard condition.
     rcl_guard_condition_options_t guard_condition_options =
       rcl_guard_condition_get_default_options();
 
-    gc_ = rcl_get_zero_initialized_guard_condition();
+    this->gc_ = rcl_get_zero_initialized_guard_condition();
     rcl_ret_t ret = rcl_guard_condition_init(
-      &gc_, context->get_rcl_context().get(), guard_condition_options);
+      &this->gc_, context->get_rcl_context().get(), guard_condition_options);
 
     if (RCL_RET_OK != ret) {
       throw std::runtime_error(
@@ -91,7 +222,7 @@ public:
 
   virtual ~SubscriptionIntraProcessBuffer()
   {
-    if (rcl_guard_condition_fini(&gc_) != RCL_RET_OK) {
+    if (rcl_guard_condition_fini(&this->gc_) != RCL_RET_OK) {
       RCUTILS_LOG_ERROR_NAMED(
         "rclcpp",
         "Failed to destroy guard condition: %s",
@@ -103,21 +234,96 @@ public:
   is_ready(rcl_wait_set_t * wait_set)
   {
     (void) wait_set;
-    return buffer_->has_data();
+    return buffer_->has_data() || get_ring_lag() > 0;
+  }
+
+  /// Read the messages of a publisher from its ring, if this buffer shares the messages.
+  /**
+   * The buffers converting the messages to a custom type, or taking their ownership, keep
+   * being provided the messages, as the subscriptions dispatching them directly.
+   * The messages are filtered and rate limited when they are read from the ring, see
+   * accepts_message().
+   */
+  bool
+  add_publisher_ring(std::shared_ptr<PublisherRingT> ring) override
+  {
+    if constexpr (!std::is_same<SubscribedType, ROSMessageType>::value) {
+      (void)ring;
+      return false;
+    } else {
+      if (!buffer_->use_take_shared_method() || this->max_direct_dispatch_depth_ > 0) {
+        return false;
+      }
+      RingCursor ring_cursor;
+      ring_cursor.position = ring->end();
+      ring_cursor.ring = std::move(ring);
+      std::lock_guard<std::mutex> lock(ring_cursors_mutex_);
+      ring_cursors_.push_back(std::move(ring_cursor));
+      return true;
+    }
+  }
+
+  void
+  provide_intra_process_message(
+    ConstROSMessageSharedPtr message,
+    const IntraProcessMessageInfo & info) override
+  {
+    if constexpr (std::is_same<SubscribedType, ROSMessageType>::value) {
+      provide_intra_process_data(std::move(message), info);
+    } else {
+      provide_intra_process_data(convert_ros_message_to_subscribed_type(*message), info);
+    }
+  }
+
+  void
+  provide_intra_process_message(
+    ROSMessageUniquePtr message,
+    const IntraProcessMessageInfo & info) override
+  {
+    if constexpr (std::is_same<SubscribedType, ROSMessageType>::value) {
+      provide_intra_process_data(std::move(message), info);
+    } else {
+      provide_intra_process_data(convert_ros_message_to_subscribed_type(*message), info);
+    }
   }
 
+  /// Store a message of the subscribed type, shared with other subscriptions.
   void
-  provide_intra_process_message(ConstMessageSharedPtr message)
+  provide_intra_process_data(ConstMessageSharedPtr message, const IntraProcessMessageInfo & info)
   {
-    buffer_->add_shared(std::move(message));
+    if (this->try_begin_direct_dispatch()) {
+      dispatch_directly_and_end(std::move(message), info);
+      return;
+    }
+    // A full buffer drops its oldest message, the number of ready messages does not change.
+    const bool adds_ready_message = !buffer_->is_full();
+    trace_message(rclcpp::tracing::TraceEventType::IntraProcessEnqueue, info);
+    buffer_->add_shared(std::move(message), info);
     trigger_guard_condition();
+    if (adds_ready_message) {
+      this->invoke_on_new_message();
+    } else {
+      this->on_message_dropped();
+    }
   }
 
+  /// Store a message of the subscribed type, owned by this subscription.
   void
-  provide_intra_process_message(MessageUniquePtr message)
+  provide_intra_process_data(MessageUniquePtr message, const IntraProcessMessageInfo & info)
   {
-    buffer_->add_unique(std::move(message));
+    if (this->try_begin_direct_dispatch()) {
+      dispatch_directly_and_end(std::move(message), info);
+      return;
+    }
+    const bool adds_ready_message = !buffer_->is_full();
+    trace_message(rclcpp::tracing::TraceEventType::IntraProcessEnqueue, info);
+    buffer_->add_unique(std::move(message), info);
     trigger_guard_condition();
+    if (adds_ready_message) {
+      this->invoke_on_new_message();
+    } else {
+      this->on_message_dropped();
+    }
   }
 
   bool
@@ -126,15 +332,165 @@ public:
     return buffer_->use_take_shared_method();
   }
 
+  size_t
+  get_lag() const override
+  {
+    return buffer_->size() + get_ring_lag();
+  }
+
+  size_t
+  get_buffer_capacity() const override
+  {
+    return buffer_->capacity();
+  }
+
 protected:
+  /// Call the callback with a message on the publishing thread, see set_direct_dispatch().
+  virtual void
+  dispatch_directly(ConstMessageSharedPtr message, const IntraProcessMessageInfo & info) = 0;
+
+  virtual void
+  dispatch_directly(MessageUniquePtr message, const IntraProcessMessageInfo & info) = 0;
+
   void
   trigger_guard_condition()
   {
-    rcl_ret_t ret = rcl_trigger_guard_condition(&gc_);
+    rcl_ret_t ret = rcl_trigger_guard_condition(&this->gc_);
     (void)ret;
   }
 
+  /// Dispatch a message directly, ending the direct dispatch even if the callback throws.
+  template<typename MessagePtrT>
+  void
+  dispatch_directly_and_end(MessagePtrT message, const IntraProcessMessageInfo & info)
+  {
+    struct DirectDispatchEnd
+    {
+      ~DirectDispatchEnd() {buffer->end_direct_dispatch();}
+      SubscriptionIntraProcessBuffer * buffer;
+    } direct_dispatch_end{this};
+    dispatch_directly(std::move(message), info);
+  }
+
+  /// Number of messages of the rings not read yet, at most the capacity of this buffer per ring.
+  size_t
+  get_ring_lag() const
+  {
+    std::lock_guard<std::mutex> lock(ring_cursors_mutex_);
+    size_t lag = 0;
+    for (const auto & ring_cursor : ring_cursors_) {
+      const uint64_t distance = ring_cursor.ring->end() - ring_cursor.position;
+      lag += static_cast<size_t>(
+        std::min<uint64_t>(distance, std::min(buffer_->capacity(), ring_cursor.ring->capacity())));
+    }
+    return lag;
+  }
+
+  /// Read the oldest message of the rings accepted by this buffer, and move past it.
+  /**
+   * The messages overwritten in a ring, or beyond the capacity of this buffer, are dropped.
+   *
+   * \return false if no message is left.
+   */
+  bool
+  consume_from_rings(ConstROSMessageSharedPtr & message, IntraProcessMessageInfo & info)
+  {
+    size_t dropped_count = 0;
+    bool consumed = false;
+    {
+      std::lock_guard<std::mutex> lock(ring_cursors_mutex_);
+      while (!consumed) {
+        // The next message of each ring, the oldest one being consumed.
+        RingCursor * oldest_cursor = nullptr;
+        for (auto & ring_cursor : ring_cursors_) {
+          const uint64_t depth = std::min(buffer_->capacity(), ring_cursor.ring->capacity());
+          const uint64_t end = ring_cursor.ring->end();
+          if (end - ring_cursor.position > depth) {
+            dropped_count += static_cast<size_t>(end - depth - ring_cursor.position);
+            ring_cursor.position = end - depth;
+          }
+          if (ring_cursor.position == end) {
+            continue;
+          }
+          if (
+            !ring_cursor.ring->read(ring_cursor.position, ring_cursor.message, ring_cursor.info))
+          {
+            // Overwritten since end() was read.
+            ++dropped_count;
+            ++ring_cursor.position;
+            continue;
+          }
+          if (
+            !oldest_cursor ||
+            ring_cursor.info.source_timestamp < oldest_cursor->info.source_timestamp)
+          {
+            oldest_cursor = &ring_cursor;
+          }
+        }
+        if (!oldest_cursor) {
+          break;
+        }
+        ++oldest_cursor->position;
+        if (this->accepts_message(*oldest_cursor->message)) {
+          message = std::move(oldest_cursor->message);
+          info = oldest_cursor->info;
+          consumed = true;
+        }
+        for (auto & ring_cursor : ring_cursors_) {
+          ring_cursor.message.reset();
+        }
+      }
+      // The rings of the removed publishers are left once they are read.
+      ring_cursors_.erase(
+        std::remove_if(
+          ring_cursors_.begin(), ring_cursors_.end(),
+          [](const RingCursor & ring_cursor) {
+            return ring_cursor.ring->is_closed() &&
+            ring_cursor.position == ring_cursor.ring->end();
+          }),
+        ring_cursors_.end());
+    }
+    for (size_t i = 0; i < dropped_count; ++i) {
+      this->on_message_dropped();
+    }
+    return consumed;
+  }
+
+  /// Record the enqueue or dequeue of a message, identified by its publisher and number.
+  void
+  trace_message(rclcpp::tracing::TraceEventType type, const IntraProcessMessageInfo & info)
+  {
+    rclcpp::tracing::trace(
+      type, static_cast<const rclcpp::Waitable *>(this),
+      info.intra_process_publisher_id, info.publication_sequence_number);
+  }
+
+  MessageUniquePtr
+  convert_ros_message_to_subscribed_type(const ROSMessageType & ros_message)
+  {
+    auto ptr = MessageAllocTraits::allocate(message_allocator_, 1);
+    MessageAllocTraits::construct(message_allocator_, ptr);
+    rclcpp::TypeAdapter<SubscribedType, ROSMessageType>::convert_to_custom(ros_message, *ptr);
+    return MessageUniquePtr(ptr, message_deleter_);
+  }
+
+  MessageAlloc message_allocator_;
+  SubscribedTypeDeleter message_deleter_;
   BufferUniquePtr buffer_;
+
+private:
+  /// Position of the next message read from the ring of a publisher.
+  struct RingCursor
+  {
+    std::shared_ptr<PublisherRingT> ring;
+    uint64_t position = 0;
+    // The message read at the position, while looking for the oldest message.
+    ConstROSMessageSharedPtr message;
+    IntraProcessMessageInfo info;
+  };
+
+  mutable std::mutex ring_cursors_mutex_;
+  std::vector<RingCursor> ring_cursors_;
 };
 
 }  // namespace experimental
@@ -0,0 +1,211 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__TIMERS_MANAGER_HPP_
+#define RCLCPP__EXPERIMENTAL__TIMERS_MANAGER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/timer.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+
+/// Track the deadlines of timers in a min-heap and report the timers which expired.
+/**
+ * The timers are kept in a heap ordered by their next call time, so finding the expired
+ * timers costs O(1) while none expired and O(log n) per expired timer, independently of the
+ * number of timers.
+ *
+ * A timer may be called up to its slack after its deadline, see
+ * rclcpp::TimerBase::set_slack(), so its next call time is its deadline plus its slack.
+ * Whenever a timer is called, the other timers whose deadline passed are called as well, which
+ * costs an additional O(n), so that timers with close deadlines share a single wake-up.
+ *
+ * Once start() was called, a dedicated thread sleeps on a condition variable until the earliest
+ * deadline.
+ * Alternatively, execute_ready_timers() reports the expired timers from the calling thread.
+ * In both cases, rclcpp::TimerBase::call() is called on every expired timer and the timer is
+ * passed to the on ready callback, it is up to the callback, e.g. an executor, to eventually
+ * run rclcpp::TimerBase::execute_callback().
+ *
+ * Deadlines are computed from rclcpp::TimerBase::time_until_trigger() and tracked with the
+ * steady clock, so timers of a ROS time clock do not follow jumps of simulated time.
+ * A timer that is reset is rescheduled, a canceled timer is not reported until it is reset.
+ *
+ * All member functions are thread-safe.
+ */
+class TimersManager
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(TimersManager)
+
+  /// Callback receiving the timers which expired.
+  /**
+   * It is called with the internal lock of the manager held, so it should return quickly and
+   * must not call back into the manager.
+   */
+  using OnReadyCallback = std::function<void (const rclcpp::TimerBase *)>;
+
+  /// Constructor.
+  /**
+   * \param[in] on_ready_callback called with every timer which expired
+   * \throws std::invalid_argument if on_ready_callback is empty
+   */
+  RCLCPP_PUBLIC
+  explicit TimersManager(OnReadyCallback on_ready_callback);
+
+  /// Stop the timers thread, if running, and remove all timers.
+  RCLCPP_PUBLIC
+  ~TimersManager();
+
+  /// Add a timer, adding the same timer twice has no effect.
+  /**
+   * \param[in] timer the timer to add
+   * \throws std::invalid_argument if timer is null
+   */
+  RCLCPP_PUBLIC
+  void
+  add_timer(rclcpp::TimerBase::SharedPtr timer);
+
+  /// Remove a timer, it is not reported anymore once this returns.
+  /**
+   * \param[in] timer the timer to remove
+   */
+  RCLCPP_PUBLIC
+  void
+  remove_timer(const rclcpp::TimerBase::SharedPtr & timer);
+
+  /// Remove all timers.
+  RCLCPP_PUBLIC
+  void
+  clear();
+
+  /// Start the thread reporting the timers as they expire.
+  /**
+   * \throws std::runtime_error if the thread is already running
+   */
+  RCLCPP_PUBLIC
+  void
+  start();
+
+  /// Stop the thread started with start(), do nothing if it is not running.
+  RCLCPP_PUBLIC
+  void
+  stop();
+
+  /// Report all the timers which expired, from the calling thread.
+  /**
+   * \return the number of timers reported
+   */
+  RCLCPP_PUBLIC
+  size_t
+  execute_ready_timers();
+
+  /// Return the time until the earliest deadline.
+  /**
+   * \return the time until the earliest deadline, 0 if it already passed, or -1 if no timer
+   *   is waiting to expire
+   */
+  RCLCPP_PUBLIC
+  std::chrono::nanoseconds
+  get_head_timeout();
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_timers() const;
+
+private:
+  struct TimerEntry
+  {
+    /// Time by which the timer must be called, its ready time plus its slack.
+    std::chrono::steady_clock::time_point deadline;
+    /// Time from which the timer can be called.
+    std::chrono::steady_clock::time_point ready_time;
+    rclcpp::TimerBase::WeakPtr timer;
+    /// Identifies the timer, also once it was destroyed.
+    const rclcpp::TimerBase * key;
+  };
+
+  /// Heap comparator putting the earliest deadline at the front.
+  static bool
+  has_later_deadline(const TimerEntry & a, const TimerEntry & b)
+  {
+    return a.deadline > b.deadline;
+  }
+
+  /// Return the next deadline of a timer, without its slack, time_point::max() if it is canceled.
+  /**
+   * \param[in] timer the timer
+   * \param[in] now the current time, the deadline is not before it
+   */
+  static std::chrono::steady_clock::time_point
+  get_deadline(rclcpp::TimerBase & timer, std::chrono::steady_clock::time_point now);
+
+  /// Set the ready time of an entry, and its deadline from the slack of the timer.
+  static void
+  set_ready_time(
+    TimerEntry & entry,
+    const rclcpp::TimerBase & timer,
+    std::chrono::steady_clock::time_point ready_time);
+
+  void
+  run_timers();
+
+  size_t
+  execute_ready_timers_unsafe();
+
+  /// Call the timer of an entry if it is ready, and set its next ready time.
+  /**
+   * \param[in] entry the entry of the timer
+   * \param[in] now the time at which the ready timers are called
+   * \param[inout] executed incremented if the timer was called
+   * \return false if the timer was destroyed, true otherwise
+   */
+  bool
+  call_timer_unsafe(
+    TimerEntry & entry,
+    std::chrono::steady_clock::time_point now,
+    size_t & executed);
+
+  /// Recompute all deadlines, after a timer was reset.
+  void
+  reschedule_timers_unsafe();
+
+  OnReadyCallback on_ready_callback_;
+
+  mutable std::mutex timers_mutex_;
+  std::condition_variable timers_cv_;
+  std::vector<TimerEntry> timers_heap_;
+  /// True if the front of the heap may have changed since the timers thread started waiting.
+  bool head_changed_ = false;
+  /// True if a timer was reset since the deadlines were last computed.
+  bool timers_reset_ = false;
+  bool running_ = false;
+  std::thread timers_thread_;
+};
+
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__TIMERS_MANAGER_HPP_
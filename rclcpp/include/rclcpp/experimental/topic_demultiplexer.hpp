@@ -0,0 +1,299 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__EXPERIMENTAL__TOPIC_DEMULTIPLEXER_HPP_
+#define RCLCPP__EXPERIMENTAL__TOPIC_DEMULTIPLEXER_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/create_generic_subscription.hpp"
+#include "rclcpp/detail/inplace_function.hpp"
+#include "rclcpp/generic_subscription.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/node_interfaces/node_topics_interface.hpp"
+#include "rclcpp/qos.hpp"
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "rclcpp/subscription_options.hpp"
+
+#include "rosidl_runtime_cpp/traits.hpp"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+namespace rclcpp
+{
+namespace experimental
+{
+
+/// Single subscription to a topic, whose messages are fanned out to several callbacks.
+/**
+ * Each message is taken from the middleware once, and deserialized once for each message type
+ * callbacks were added with, instead of once for each consumer subscribing to the topic.
+ * The deserialized message is shared by the callbacks of its type.
+ *
+ * The callbacks are called one after the other, by the executor executing the underlying
+ * rclcpp::GenericSubscription.
+ * Callbacks can be added and removed from any thread, a message which is being dispatched is
+ * still given to the callbacks which were registered when its dispatch started.
+ */
+class TopicDemultiplexer
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(TopicDemultiplexer)
+
+  using CallbackId = uint64_t;
+
+  /// Create the subscription to the topic.
+  /**
+   * \param[in] topics_interface interface of the node the subscription is added to
+   * \param[in] topic_name name of the topic
+   * \param[in] topic_type type of the topic, e.g. "sensor_msgs/msg/PointCloud2"
+   * \param[in] qos %QoS of the subscription
+   * \param[in] options options of the subscription, see rclcpp::create_generic_subscription()
+   */
+  template<typename AllocatorT = std::allocator<void>>
+  TopicDemultiplexer(
+    rclcpp::node_interfaces::NodeTopicsInterface::SharedPtr topics_interface,
+    const std::string & topic_name,
+    const std::string & topic_type,
+    const rclcpp::QoS & qos,
+    const rclcpp::SubscriptionOptionsWithAllocator<AllocatorT> & options = (
+      rclcpp::SubscriptionOptionsWithAllocator<AllocatorT>()
+    ))
+  : topic_type_(topic_type),
+    holder_(std::make_shared<CallbackTableHolder>(std::make_shared<const CallbackTable>()))
+  {
+    // The subscription may outlive this instance while it is being executed.
+    std::weak_ptr<CallbackTableHolder> weak_holder = holder_;
+    subscription_ = rclcpp::create_generic_subscription(
+      topics_interface, topic_name, topic_type, qos,
+      [weak_holder](std::shared_ptr<rclcpp::SerializedMessage> message) {
+        auto holder = weak_holder.lock();
+        if (holder) {
+          TopicDemultiplexer::dispatch(holder->get(), std::move(message));
+        }
+      },
+      options);
+  }
+
+  virtual ~TopicDemultiplexer() = default;
+
+  /// Add a callback receiving the messages in serialized form.
+  CallbackId
+  add_serialized_callback(
+    std::function<void (std::shared_ptr<const rclcpp::SerializedMessage>)> callback)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto table = std::make_shared<CallbackTable>(*holder_->get());
+    const CallbackId id = next_callback_id_++;
+    table->serialized_callbacks.emplace_back(id, std::move(callback));
+    holder_->set(std::move(table));
+    return id;
+  }
+
+  /// Add a callback receiving the deserialized messages.
+  /**
+   * The messages are deserialized once for all the callbacks with the same message type.
+   *
+   * \throws std::invalid_argument if MessageT is not the type of the topic.
+   */
+  template<typename MessageT>
+  CallbackId
+  add_callback(std::function<void (std::shared_ptr<const MessageT>)> callback)
+  {
+    static_assert(
+      rosidl_generator_traits::is_message<MessageT>::value,
+      "the message type of a TopicDemultiplexer callback must be a ROS message");
+    if (topic_type_ != rosidl_generator_traits::name<MessageT>()) {
+      throw std::invalid_argument(
+        std::string("callback message type '") + rosidl_generator_traits::name<MessageT>() +
+        "' does not match the topic type '" + topic_type_ + "'");
+    }
+    const rosidl_message_type_support_t * type_support =
+      rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto table = std::make_shared<CallbackTable>(*holder_->get());
+    const CallbackId id = next_callback_id_++;
+    auto type_callback =
+      [callback = std::move(callback)](const std::shared_ptr<const void> & message) {
+        callback(std::static_pointer_cast<const MessageT>(message));
+      };
+    for (auto & group : table->typed_callbacks) {
+      if (group.type_support == type_support) {
+        group.callbacks.emplace_back(id, std::move(type_callback));
+        holder_->set(std::move(table));
+        return id;
+      }
+    }
+    TypedCallbackGroup group;
+    group.type_support = type_support;
+    group.deserialize =
+      [serialization = std::make_shared<rclcpp::Serialization<MessageT>>()](
+      const rclcpp::SerializedMessage & serialized_message) -> std::shared_ptr<const void> {
+        auto message = std::make_shared<MessageT>();
+        serialization->deserialize_message(&serialized_message, message.get());
+        return message;
+      };
+    group.callbacks.emplace_back(id, std::move(type_callback));
+    table->typed_callbacks.push_back(std::move(group));
+    holder_->set(std::move(table));
+    return id;
+  }
+
+  /// Remove a callback, return false if there is no such callback.
+  bool
+  remove_callback(CallbackId id)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto table = std::make_shared<CallbackTable>(*holder_->get());
+    bool removed = erase_callback(table->serialized_callbacks, id);
+    for (auto it = table->typed_callbacks.begin(); !removed && it != table->typed_callbacks.end();
+      ++it)
+    {
+      removed = erase_callback(it->callbacks, id);
+      if (removed && it->callbacks.empty()) {
+        // No message is deserialized for a type without callbacks.
+        table->typed_callbacks.erase(it);
+        break;
+      }
+    }
+    if (removed) {
+      holder_->set(std::move(table));
+    }
+    return removed;
+  }
+
+  /// Return the number of callbacks.
+  size_t
+  get_callback_count() const
+  {
+    auto table = holder_->get();
+    size_t count = table->serialized_callbacks.size();
+    for (const auto & group : table->typed_callbacks) {
+      count += group.callbacks.size();
+    }
+    return count;
+  }
+
+  /// Return the number of times each message is deserialized.
+  size_t
+  get_message_type_count() const
+  {
+    return holder_->get()->typed_callbacks.size();
+  }
+
+  /// Return the subscription taking the messages of the topic.
+  rclcpp::GenericSubscription::SharedPtr
+  get_subscription() const
+  {
+    return subscription_;
+  }
+
+private:
+  using SerializedCallback =
+    std::function<void (std::shared_ptr<const rclcpp::SerializedMessage>)>;
+  // Stored in place, so the wrappers of the callbacks do not allocate.
+  using TypeErasedCallback =
+    rclcpp::detail::InplaceFunction<void (const std::shared_ptr<const void> &)>;
+
+  struct TypedCallbackGroup
+  {
+    const rosidl_message_type_support_t * type_support = nullptr;
+    rclcpp::detail::InplaceFunction<
+      std::shared_ptr<const void>(const rclcpp::SerializedMessage &)> deserialize;
+    std::vector<std::pair<CallbackId, TypeErasedCallback>> callbacks;
+  };
+
+  /// Immutable snapshot of the callbacks, replaced when a callback is added or removed.
+  struct CallbackTable
+  {
+    std::vector<std::pair<CallbackId, SerializedCallback>> serialized_callbacks;
+    std::vector<TypedCallbackGroup> typed_callbacks;
+  };
+
+  class CallbackTableHolder
+  {
+  public:
+    explicit CallbackTableHolder(std::shared_ptr<const CallbackTable> table)
+    : table_(std::move(table))
+    {}
+
+    std::shared_ptr<const CallbackTable>
+    get() const
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return table_;
+    }
+
+    void
+    set(std::shared_ptr<const CallbackTable> table)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      table_ = std::move(table);
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::shared_ptr<const CallbackTable> table_;
+  };
+
+  template<typename CallbackVectorT>
+  static bool
+  erase_callback(CallbackVectorT & callbacks, CallbackId id)
+  {
+    for (auto it = callbacks.begin(); it != callbacks.end(); ++it) {
+      if (it->first == id) {
+        callbacks.erase(it);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static void
+  dispatch(
+    const std::shared_ptr<const CallbackTable> & table,
+    std::shared_ptr<rclcpp::SerializedMessage> message)
+  {
+    std::shared_ptr<const rclcpp::SerializedMessage> serialized_message = std::move(message);
+    for (const auto & callback : table->serialized_callbacks) {
+      callback.second(serialized_message);
+    }
+    for (const auto & group : table->typed_callbacks) {
+      std::shared_ptr<const void> typed_message = group.deserialize(*serialized_message);
+      for (const auto & callback : group.callbacks) {
+        callback.second(typed_message);
+      }
+    }
+  }
+
+  const std::string topic_type_;
+  /// Serializes the modifications of the callback table.
+  std::mutex mutex_;
+  CallbackId next_callback_id_ = 0;
+  std::shared_ptr<CallbackTableHolder> holder_;
+  rclcpp::GenericSubscription::SharedPtr subscription_;
+};
+
+}  // namespace experimental
+}  // namespace rclcpp
+
+#endif  // RCLCPP__EXPERIMENTAL__TOPIC_DEMULTIPLEXER_HPP_
@@ -0,0 +1,199 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__FRAGMENTED_MESSAGE_HPP_
+#define RCLCPP__FRAGMENTED_MESSAGE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rclcpp/generic_publisher.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+
+/// Position of a fragment in the message it is part of.
+struct FragmentInfo
+{
+  /// Identifier of the message, unique for its publisher.
+  uint64_t message_id;
+  /// Size of the whole message.
+  size_t message_size;
+  /// Position of the data of the fragment in the message.
+  size_t offset;
+};
+
+/// Publisher of large serialized messages as fragments of bounded size.
+/**
+ * Each message is published through a rclcpp::GenericPublisher as a sequence of fragments,
+ * each starting with a header identifying the message and the position of the fragment in it.
+ * A message can be produced incrementally, e.g. read from a file or serialized piece by piece,
+ * so that only one fragment is held in memory while publishing, and a lost fragment only
+ * drops the message it belongs to, without blocking the messages after it.
+ *
+ * The fragments are not messages of the type of the topic, so the topic must only be read by
+ * rclcpp::GenericSubscription instances giving them to a rclcpp::FragmentReassembler.
+ * Its %QoS should be reliable, with a depth of at least the number of fragments of a message.
+ *
+ * This class is thread-safe, the fragments of the messages published concurrently are
+ * published one message after the other.
+ */
+class FragmentedPublisher
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(FragmentedPublisher)
+
+  /// Produces the data of a message, filling the buffer with at most size bytes.
+  /**
+   * Returns the number of bytes written, 0 if there is no more data.
+   */
+  using Source = std::function<size_t (uint8_t * buffer, size_t size)>;
+
+  /// Size of the header of each fragment.
+  static constexpr size_t header_size = 28;
+
+  /// Constructor.
+  /**
+   * \param[in] publisher publisher of the fragments.
+   * \param[in] fragment_size maximum size of a fragment, header included.
+   * \throws std::invalid_argument if the publisher is nullptr, or if the fragment size is not
+   *   larger than header_size.
+   */
+  RCLCPP_PUBLIC
+  FragmentedPublisher(rclcpp::GenericPublisher::SharedPtr publisher, size_t fragment_size);
+
+  /// Publish a serialized message as fragments.
+  RCLCPP_PUBLIC
+  void
+  publish(const rclcpp::SerializedMessage & message);
+
+  /// Publish a message produced incrementally, as fragments.
+  /**
+   * \param[in] size size of the message.
+   * \param[in] source called for the data of each fragment, in order.
+   * \throws std::runtime_error if the source ends before the size of the message.
+   */
+  RCLCPP_PUBLIC
+  void
+  publish(size_t size, const Source & source);
+
+private:
+  rclcpp::GenericPublisher::SharedPtr publisher_;
+  std::mutex mutex_;
+  // The fragment being published, reused for each of them.
+  std::vector<uint8_t> fragment_;
+  uint64_t next_message_id_;
+};
+
+/// Reassembler of the messages published by a rclcpp::FragmentedPublisher.
+/**
+ * The fragments of a message must be added in order, as published on a reliable topic.
+ * A message missing a fragment is dropped, as are the oldest incomplete messages when more
+ * than max_pending_messages are incomplete, e.g. interleaved from several publishers.
+ *
+ * Either the messages are reassembled, holding at most max_pending_messages messages of at
+ * most max_message_size bytes in memory, or the data of each fragment is streamed to a
+ * callback, without holding any message.
+ *
+ * This class is not thread-safe, the fragments are expected to be added from the callback of
+ * a subscription.
+ */
+class FragmentReassembler
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(FragmentReassembler)
+
+  /// Called with each reassembled message.
+  using MessageCallback = std::function<void (std::shared_ptr<rclcpp::SerializedMessage>)>;
+  /// Called with the data of each fragment, in order, the last one ending at the message size.
+  using StreamCallback = std::function<void (const FragmentInfo &, const uint8_t *, size_t)>;
+
+  /// Constructor reassembling the messages.
+  /**
+   * \param[in] callback called with each reassembled message.
+   * \param[in] max_message_size size above which the messages are dropped.
+   * \param[in] max_pending_messages maximum number of incomplete messages.
+   * \throws std::invalid_argument if max_pending_messages is 0.
+   */
+  RCLCPP_PUBLIC
+  FragmentReassembler(
+    MessageCallback callback, size_t max_message_size, size_t max_pending_messages = 1);
+
+  /// Constructor streaming the data of the fragments.
+  /**
+   * \param[in] callback called with the data of each fragment of the messages not dropped.
+   * \param[in] max_pending_messages maximum number of incomplete messages.
+   * \throws std::invalid_argument if max_pending_messages is 0.
+   */
+  RCLCPP_PUBLIC
+  explicit FragmentReassembler(StreamCallback callback, size_t max_pending_messages = 1);
+
+  /// Add a fragment received by a subscription.
+  /**
+   * \return false if the fragment is invalid, or was dropped with its message.
+   */
+  RCLCPP_PUBLIC
+  bool
+  add_fragment(const rclcpp::SerializedMessage & fragment);
+
+  /// Get the number of messages dropped, for a missing fragment, their size or their age.
+  RCLCPP_PUBLIC
+  size_t
+  get_dropped_message_count() const;
+
+  /// Parse the header of a fragment.
+  /**
+   * \param[in] fragment the fragment.
+   * \param[out] info the position of the fragment in its message.
+   * \param[out] data the data of the fragment.
+   * \param[out] size the size of the data of the fragment.
+   * \return false if the fragment is invalid.
+   */
+  RCLCPP_PUBLIC
+  static bool
+  parse_fragment(
+    const rclcpp::SerializedMessage & fragment,
+    FragmentInfo & info,
+    const uint8_t * & data,
+    size_t & size);
+
+private:
+  struct PendingMessage
+  {
+    uint64_t id;
+    size_t size;
+    size_t next_offset;
+    // nullptr when streaming.
+    std::shared_ptr<rclcpp::SerializedMessage> message;
+  };
+
+  MessageCallback message_callback_;
+  StreamCallback stream_callback_;
+  const size_t max_message_size_;
+  const size_t max_pending_messages_;
+  std::deque<PendingMessage> pending_messages_;
+  size_t dropped_message_count_{0};
+};
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__FRAGMENTED_MESSAGE_HPP_
@@ -16,12 +16,18 @@
 #ifndef RCLCPP__GENERIC_PUBLISHER_HPP_
 #define RCLCPP__GENERIC_PUBLISHER_HPP_
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "rcpputils/shared_library.hpp"
 
 #include "rclcpp/callback_group.hpp"
+#include "rclcpp/detail/resolve_use_intra_process.hpp"
+#include "rclcpp/experimental/intra_process_manager.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/node_interfaces/node_base_interface.hpp"
 #include "rclcpp/node_interfaces/node_topics_interface.hpp"
@@ -39,7 +45,10 @@ namespace rclcpp
  * Since the type is not known at compile time, this is not a template, and the dynamic library
  * containing type support information has to be identified and loaded based on the type name.
  *
- * It does not support intra-process handling.
+ * With intra-process communication enabled, its messages are given to the
+ * rclcpp::GenericSubscription instances of the same process and type without going through the
+ * middleware.
+ * Typed subscriptions still receive them through the middleware.
  */
 class GenericPublisher : public rclcpp::PublisherBase
 {
@@ -63,7 +72,8 @@ public:
    * \param callback Callback for new messages of serialized form
    * \param options %Publisher options.
    * Not all publisher options are currently respected, the only relevant options for this
-   * publisher are `event_callbacks`, `use_default_callbacks`, and `%callback_group`.
+   * publisher are `event_callbacks`, `use_default_callbacks`, `use_intra_process_comm`,
+   * `serialized_message_codec`, and `%callback_group`.
    */
   template<typename AllocatorT = std::allocator<void>>
   GenericPublisher(
@@ -78,7 +88,9 @@ public:
       topic_name,
       *rclcpp::get_typesupport_handle(topic_type, "rosidl_typesupport_cpp", *ts_lib),
       options.template to_rcl_publisher_options<rclcpp::SerializedMessage>(qos)),
-    ts_lib_(ts_lib)
+    ts_lib_(ts_lib),
+    topic_type_(topic_type),
+    codec_(options.serialized_message_codec)
   {
     // This is unfortunately duplicated with the code in publisher.hpp.
     // TODO(nnmm): Deduplicate by moving this into PublisherBase.
@@ -110,16 +122,153 @@ public:
     }
   }
 
+  /// Called post construction, so that construction may continue after shared_from_this() works.
+  template<typename AllocatorT = std::allocator<void>>
+  void
+  post_init_setup(
+    rclcpp::node_interfaces::NodeBaseInterface * node_base,
+    const rclcpp::QoS & qos,
+    const rclcpp::PublisherOptionsWithAllocator<AllocatorT> & options)
+  {
+    // If needed, setup intra process communication.
+    if (rclcpp::detail::resolve_use_intra_process(options, *node_base)) {
+      auto context = node_base->get_context();
+      // Get the intra process manager instance for this context.
+      auto ipm = context->get_sub_context<rclcpp::experimental::IntraProcessManager>();
+      // Register the publisher with the intra process manager.
+      if (qos.history() != rclcpp::HistoryPolicy::KeepLast) {
+        throw std::invalid_argument(
+                "intraprocess communication allowed only with keep last history qos policy");
+      }
+      if (qos.depth() == 0) {
+        throw std::invalid_argument(
+                "intraprocess communication is not allowed with a zero qos history depth value");
+      }
+      if (qos.durability() != rclcpp::DurabilityPolicy::Volatile) {
+        throw std::invalid_argument(
+                "intraprocess communication allowed only with volatile durability");
+      }
+      uint64_t intra_process_publisher_id =
+        ipm->add_serialized_publisher(this->shared_from_this(), topic_type_);
+      this->setup_intra_process(
+        intra_process_publisher_id,
+        ipm);
+    }
+  }
+
   RCLCPP_PUBLIC
   virtual ~GenericPublisher() = default;
 
   /// Publish a rclcpp::SerializedMessage.
+  /**
+   * With intra-process communication enabled, the message is copied once for the intra-process
+   * subscriptions.
+   */
   RCLCPP_PUBLIC
   void publish(const rclcpp::SerializedMessage & message);
 
+  /// Publish a rclcpp::SerializedMessage, giving its ownership to rclcpp.
+  /**
+   * With intra-process communication enabled, the message itself is given to an intra-process
+   * subscription, so it is not copied if it is the only one.
+   *
+   * \throws std::runtime_error if the message is a null pointer
+   */
+  RCLCPP_PUBLIC
+  void publish(std::unique_ptr<rclcpp::SerializedMessage> message);
+
+  /// Publish a rclcpp::SerializedMessage, moving its buffer.
+  /**
+   * This allows relaying a message taken by a rclcpp::GenericSubscription without copying it.
+   * With intra-process communication enabled, the buffer of the message is moved to the
+   * message given to the intra-process subscriptions, and published inter-process from there if
+   * needed.
+   * Otherwise the message is published inter-process from its buffer, which the middleware
+   * copies, as serialized messages cannot be loaned to it.
+   *
+   * \param[in] message the message, which may be left empty.
+   */
+  RCLCPP_PUBLIC
+  void publish(rclcpp::SerializedMessage && message);
+
+  /// Publish serialized data owned by the caller, without copying it inter-process.
+  /**
+   * The data only needs to stay valid for the duration of the call.
+   * With intra-process communication enabled, it is copied once for the intra-process
+   * subscriptions, as they may keep it after the call.
+   *
+   * \param[in] data The serialized message.
+   * \param[in] length The length of the serialized message.
+   */
+  RCLCPP_PUBLIC
+  void publish(const uint8_t * data, size_t length);
+
+  /// Publish serialized data owned by the caller, giving it to rclcpp without copying it.
+  /**
+   * The data is adopted by a rclcpp::SerializedMessage, which is published as with
+   * publish(std::unique_ptr<rclcpp::SerializedMessage>), so it is not copied either for an
+   * intra-process subscription.
+   * This allows replaying e.g. memory mapped recordings without copying each message.
+   *
+   * \param[in] data The serialized message, valid until the deleter is called.
+   * \param[in] length The length of the serialized message.
+   * \param[in] deleter Called once the data is no longer used, possibly from another thread.
+   * \sa rclcpp::SerializedMessage::SerializedMessage(const uint8_t *, size_t,
+   *   ExternalBufferDeleter, const rcl_allocator_t &)
+   */
+  RCLCPP_PUBLIC
+  void publish(
+    const uint8_t * data,
+    size_t length,
+    rclcpp::SerializedMessage::ExternalBufferDeleter deleter);
+
+  /// Borrow a serialized message to write length bytes of serialized data into.
+  /**
+   * The message is to be published with publish_borrowed_serialized_message(), e.g. after
+   * reading a recorded message straight into its buffer.
+   * The middleware cannot loan serialized messages, so the buffers are kept by the publisher
+   * instead: the ones of the messages published inter-process only are reused by the next
+   * borrows, so that publishing at a high rate does not allocate once they are large enough.
+   *
+   * \param[in] length The length of the serialized data to be written.
+   * \return a message owning a buffer of at least length bytes, of which length is set.
+   */
+  RCLCPP_PUBLIC
+  std::unique_ptr<rclcpp::SerializedMessage>
+  borrow_serialized_message(size_t length);
+
+  /// Publish a message returned by borrow_serialized_message().
+  /**
+   * It is published as with publish(std::unique_ptr<rclcpp::SerializedMessage>), and its buffer
+   * is kept for the next borrows unless it was given to intra-process subscriptions.
+   *
+   * \param[in] message The borrowed message, whose length may have been changed.
+   * \throws std::runtime_error if the message is a null pointer
+   */
+  RCLCPP_PUBLIC
+  void
+  publish_borrowed_serialized_message(std::unique_ptr<rclcpp::SerializedMessage> message);
+
 private:
+  void
+  do_inter_process_publish(const rclcpp::SerializedMessage & message);
+
+  void
+  do_intra_process_publish(std::unique_ptr<rclcpp::SerializedMessage> message);
+
+  std::shared_ptr<const rclcpp::SerializedMessage>
+  do_intra_process_publish_and_return_shared(std::unique_ptr<rclcpp::SerializedMessage> message);
+
   // The type support library should stay loaded, so it is stored in the GenericPublisher
   std::shared_ptr<rcpputils::SharedLibrary> ts_lib_;
+  const std::string topic_type_;
+  // Compresses the messages published inter process, if enabled by the options.
+  rclcpp::SerializedMessageCodec::SharedPtr codec_;
+  std::allocator<rclcpp::SerializedMessage> serialized_message_allocator_;
+
+  // Messages published by publish_borrowed_serialized_message(), kept for the next borrows.
+  std::mutex borrowed_serialized_messages_mutex_;
+  std::vector<std::unique_ptr<rclcpp::SerializedMessage>> borrowed_serialized_messages_;
 };
 
 }  // namespace rclcpp
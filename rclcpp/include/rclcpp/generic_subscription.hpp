@@ -18,16 +18,22 @@
 
 #include <functional>
 #include <memory>
+#include <stdexcept>
 #include <string>
 
 #include "rcpputils/shared_library.hpp"
 
 #include "rclcpp/callback_group.hpp"
+#include "rclcpp/detail/resolve_use_intra_process.hpp"
+#include "rclcpp/detail/serialized_message_pool.hpp"
+#include "rclcpp/experimental/generic_subscription_intra_process.hpp"
+#include "rclcpp/experimental/intra_process_manager.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/node_interfaces/node_base_interface.hpp"
 #include "rclcpp/node_interfaces/node_topics_interface.hpp"
 #include "rclcpp/qos.hpp"
 #include "rclcpp/serialized_message.hpp"
+#include "rclcpp/serialized_message_codec.hpp"
 #include "rclcpp/subscription_base.hpp"
 #include "rclcpp/typesupport_helpers.hpp"
 #include "rclcpp/visibility_control.hpp"
@@ -40,7 +46,10 @@ namespace rclcpp
  * Since the type is not known at compile time, this is not a template, and the dynamic library
  * containing type support information has to be identified and loaded based on the type name.
  *
- * It does not support intra-process handling.
+ * With intra-process communication enabled, it receives the messages of the
+ * rclcpp::GenericPublisher instances of the same process and type without going through the
+ * middleware.
+ * The messages of typed publishers are still received through the middleware.
  */
 class GenericSubscription : public rclcpp::SubscriptionBase
 {
@@ -64,8 +73,10 @@ public:
    * \param callback Callback for new messages of serialized form
    * \param options %Subscription options.
    * Not all subscription options are currently respected, the only relevant options for this
-   * subscription are `event_callbacks`, `use_default_callbacks`, `ignore_local_publications`, and
-   * `%callback_group`.
+   * subscription are `event_callbacks`, `use_default_callbacks`, `ignore_local_publications`,
+   * `max_messages_per_take`, `take_latest_only`, `min_message_period`, `execution_budget`,
+   * `serialized_message_pool_size`, `serialized_message_codec`, `use_intra_process_comm`,
+   * `intra_process_buffer_type`, and `%callback_group`.
    */
   template<typename AllocatorT = std::allocator<void>>
   GenericSubscription(
@@ -84,8 +95,17 @@ public:
       options.template to_rcl_subscription_options<rclcpp::SerializedMessage>(qos),
       true),
     callback_(callback),
-    ts_lib_(ts_lib)
+    ts_lib_(ts_lib),
+    codec_(options.serialized_message_codec)
   {
+    this->set_max_messages_per_take(options.max_messages_per_take);
+    this->set_take_latest_only(options.take_latest_only);
+    this->set_min_message_period(options.min_message_period);
+    this->set_execution_budget(options.execution_budget);
+    if (options.serialized_message_pool_size > 0) {
+      serialized_message_pool_ = rclcpp::detail::SerializedMessagePool::make_shared(
+        options.serialized_message_pool_size);
+    }
     // This is unfortunately duplicated with the code in subscription.hpp.
     // TODO(nnmm): Deduplicate by moving this into SubscriptionBase.
     if (options.event_callbacks.deadline_callback) {
@@ -119,6 +139,52 @@ public:
         options.event_callbacks.message_lost_callback,
         RCL_SUBSCRIPTION_MESSAGE_LOST);
     }
+
+    // Setup intra process publishing if requested.
+    if (rclcpp::detail::resolve_use_intra_process(options, *node_base)) {
+      // Check if the QoS is compatible with intra-process.
+      auto qos_profile = get_actual_qos();
+      if (qos_profile.history() != rclcpp::HistoryPolicy::KeepLast) {
+        throw std::invalid_argument(
+                "intraprocess communication allowed only with keep last history qos policy");
+      }
+      if (qos_profile.depth() == 0) {
+        throw std::invalid_argument(
+                "intraprocess communication is not allowed with 0 depth qos policy");
+      }
+      if (qos_profile.durability() != rclcpp::DurabilityPolicy::Volatile) {
+        throw std::invalid_argument(
+                "intraprocess communication allowed only with volatile durability");
+      }
+
+      auto context = node_base->get_context();
+      auto buffer_qos_profile = qos_profile;
+      if (options.take_latest_only) {
+        // A new message replaces the one not handled yet.
+        buffer_qos_profile.keep_last(1);
+      }
+      subscription_intra_process_ =
+        std::make_shared<rclcpp::experimental::GenericSubscriptionIntraProcess>(
+        callback_,
+        context,
+        this->get_topic_name(),  // important to get like this, as it has the fully-qualified name
+        buffer_qos_profile,
+        options.intra_process_buffer_type);
+      subscription_intra_process_->set_min_message_period(options.min_message_period);
+      if (options.intra_process_direct_dispatch_depth > 0) {
+        subscription_intra_process_->set_direct_dispatch(
+          options.intra_process_direct_dispatch_depth,
+          options.callback_group ?
+          options.callback_group : node_base->get_default_callback_group());
+      }
+
+      // Add it to the intra process manager.
+      using rclcpp::experimental::IntraProcessManager;
+      auto ipm = context->get_sub_context<IntraProcessManager>();
+      uint64_t intra_process_subscription_id =
+        ipm->add_serialized_subscription(subscription_intra_process_, topic_type);
+      this->setup_intra_process(intra_process_subscription_id, ipm);
+    }
   }
 
   RCLCPP_PUBLIC
@@ -161,6 +227,11 @@ private:
   std::function<void(std::shared_ptr<rclcpp::SerializedMessage>)> callback_;
   // The type support library should stay loaded, so it is stored in the GenericSubscription
   std::shared_ptr<rcpputils::SharedLibrary> ts_lib_;
+  rclcpp::experimental::GenericSubscriptionIntraProcess::SharedPtr subscription_intra_process_;
+  // Reuses the taken messages, if enabled by the options.
+  rclcpp::detail::SerializedMessagePool::SharedPtr serialized_message_pool_;
+  // Decodes the messages received inter process, if enabled by the options.
+  rclcpp::SerializedMessageCodec::SharedPtr codec_;
 };
 
 }  // namespace rclcpp
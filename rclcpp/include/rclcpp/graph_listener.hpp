@@ -16,6 +16,7 @@
 #define RCLCPP__GRAPH_LISTENER_HPP_
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -58,6 +59,36 @@ public:
   : std::runtime_error("node not found") {}
 };
 
+/// Thrown when the given graph observer is not in the GraphListener.
+class GraphObserverNotFoundError : public std::runtime_error
+{
+public:
+  GraphObserverNotFoundError()
+  : std::runtime_error("graph observer not found") {}
+};
+
+/// Object notified of the graph changes by the GraphListener, see add_graph_observer().
+class GraphObserver
+{
+public:
+  RCLCPP_PUBLIC
+  virtual ~GraphObserver();
+
+  /// Return the graph guard condition of the node of the observer, waited on by the listener.
+  virtual
+  const rcl_guard_condition_t *
+  get_graph_guard_condition() const = 0;
+
+  /// Called from the listening thread after each graph change it observed.
+  /**
+   * This is called while the observers cannot be added or removed, so it must not call
+   * GraphListener::add_graph_observer() or GraphListener::remove_graph_observer().
+   */
+  virtual
+  void
+  on_graph_change() = 0;
+};
+
 /// Notifies many nodes of graph changes by listening in a thread.
 class GraphListener : public std::enable_shared_from_this<GraphListener>
 {
@@ -116,6 +147,29 @@ public:
   void
   remove_node(rclcpp::node_interfaces::NodeGraphInterface * node_graph);
 
+  /// Add an observer notified of each graph change, until it is removed.
+  /**
+   * Unlike the nodes, the guard condition of an observer is always waited on, and the observer
+   * is notified of a graph change whichever guard condition it was observed with.
+   *
+   * \throws GraphListenerShutdownError if the GraphListener is shutdown
+   * \throws std::invalid_argument if observer is nullptr
+   * \throws std::system_error anything std::mutex::lock() throws
+   */
+  RCLCPP_PUBLIC
+  void
+  add_graph_observer(GraphObserver * observer);
+
+  /// Remove an observer, which is not notified anymore once this returns.
+  /**
+   * \throws GraphObserverNotFoundError if the given observer is not in the list
+   * \throws std::invalid_argument if observer is nullptr
+   * \throws std::system_error anything std::mutex::lock() throws
+   */
+  RCLCPP_PUBLIC
+  void
+  remove_graph_observer(GraphObserver * observer);
+
   /// Stop the listening thread.
   /**
    * The thread cannot be restarted, and the class is defunct after calling.
@@ -148,6 +202,18 @@ public:
   bool
   is_shutdown();
 
+  /// Return the number of graph changes the listening thread observed.
+  /**
+   * The count is incremented before the nodes are notified of a graph change, so a result
+   * queried after reading a count reflects at least the graph changes counted so far.
+   * Only graph changes seen by nodes with graph users, see
+   * rclcpp::node_interfaces::NodeGraphInterface::count_graph_users(), or by graph observers are
+   * counted.
+   */
+  RCLCPP_PUBLIC
+  uint64_t
+  get_graph_change_count() const;
+
 protected:
   /// Main function for the listening thread.
   RCLCPP_PUBLIC
@@ -175,17 +241,40 @@ private:
   void
   __shutdown();
 
+  /// A distinct graph guard condition, with the nodes and observers using it.
+  struct GraphGuardCondition
+  {
+    const rcl_guard_condition_t * guard_condition;
+    /// The rmw guard condition, which is shared by the nodes of a context with some rmw.
+    const void * rmw_handle;
+    std::vector<rclcpp::node_interfaces::NodeGraphInterface *> nodes;
+    std::vector<GraphObserver *> observers;
+    bool is_waited_on;
+    size_t wait_set_index;
+  };
+
+  /// Group the graph guard conditions of the nodes and observers, if they changed.
+  /** Must be called with node_graph_interfaces_mutex_ locked. */
+  void
+  update_graph_guard_conditions();
+
   std::weak_ptr<rclcpp::Context> weak_parent_context_;
   std::shared_ptr<rcl_context_t> rcl_parent_context_;
 
   std::thread listener_thread_;
   bool is_started_;
   std::atomic_bool is_shutdown_;
+  std::atomic<uint64_t> graph_change_count_{0u};
   mutable std::mutex shutdown_mutex_;
 
   mutable std::mutex node_graph_interfaces_barrier_mutex_;
   mutable std::mutex node_graph_interfaces_mutex_;
   std::vector<rclcpp::node_interfaces::NodeGraphInterface *> node_graph_interfaces_;
+  /// Guarded by node_graph_interfaces_mutex_ as well.
+  std::vector<GraphObserver *> graph_observers_;
+  /// Guarded by node_graph_interfaces_mutex_ as well, rebuilt when nodes or observers change.
+  std::vector<GraphGuardCondition> graph_guard_conditions_;
+  bool graph_guard_conditions_changed_ = true;
 
   rcl_guard_condition_t interrupt_guard_condition_ = rcl_get_zero_initialized_guard_condition();
   rcl_wait_set_t wait_set_ = rcl_get_zero_initialized_wait_set();
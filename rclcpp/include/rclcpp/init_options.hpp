@@ -15,15 +15,50 @@
 #ifndef RCLCPP__INIT_OPTIONS_HPP_
 #define RCLCPP__INIT_OPTIONS_HPP_
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 
 #include "rcl/init_options.h"
+#include "rclcpp/real_time_memory.hpp"
 #include "rclcpp/visibility_control.hpp"
 
 namespace rclcpp
 {
 
+/// Behavior of a log call while the queue of the asynchronous logging is full.
+enum class AsyncLoggingOverflowPolicy
+{
+  /// Drop the log record, see rclcpp::get_async_logging_dropped_count().
+  Drop,
+  /// Output the log record from the log call, waiting for the other threads logging.
+  Block,
+};
+
+/// Options of the asynchronous logging, see InitOptions::async_logging().
+struct AsyncLoggingOptions
+{
+  /// If true, the log records are output by a background thread instead of the logging thread.
+  bool enabled = false;
+  /// Number of log records which can be queued, rounded up to a power of two.
+  size_t queue_size = 1024u;
+  AsyncLoggingOverflowPolicy overflow_policy = AsyncLoggingOverflowPolicy::Drop;
+};
+
+/// Options of the aggregation of the /rosout records, see InitOptions::rosout_aggregation().
+struct RosoutAggregationOptions
+{
+  /// If true, the log records of the nodes of the context are published by a shared publisher.
+  bool enabled = false;
+  /// Period at which the pending log records are published.
+  std::chrono::milliseconds period{100};
+  /// Number of log records published per second at most, or zero for no limit.
+  size_t max_records_per_second = 100u;
+  /// Number of log records waiting to be published at most, the next ones are dropped.
+  size_t max_pending_records = 1024u;
+};
+
 /// Encapsulation of options for initializing rclcpp.
 class InitOptions
 {
@@ -63,6 +98,101 @@ public:
   InitOptions &
   auto_initialize_logging(bool initialize_logging);
 
+  /// Return the options of the asynchronous logging.
+  RCLCPP_PUBLIC
+  const AsyncLoggingOptions &
+  async_logging() const;
+
+  /// Set the options of the asynchronous logging, used if this initializes the logging.
+  /**
+   * With the asynchronous logging, a log call formats its message and queues it, and a background
+   * thread outputs the queued records to the console, the log file and /rosout.
+   * So a log call does not wait for another thread logging, nor for the output itself, unless
+   * the queue is full and the overflow policy is AsyncLoggingOverflowPolicy::Block.
+   *
+   * The options are only used by the context which initializes the logging, i.e. the first one
+   * initialized with auto_initialize_logging(), the queue is flushed when the logging is finalized.
+   *
+   * \param[in] options of the asynchronous logging
+   * \throws std::invalid_argument if the queue size is zero
+   */
+  RCLCPP_PUBLIC
+  InitOptions &
+  async_logging(const AsyncLoggingOptions & options);
+
+  /// Return `true` if the entities are destroyed without finalization once the context is shutdown.
+  RCLCPP_PUBLIC
+  bool
+  fast_exit() const;
+
+  /// Set flag indicating if the entities skip their finalization once the context is shutdown.
+  /**
+   * Destroying a publisher, a subscription, a service or a client normally finalizes it in the
+   * middleware, which announces its destruction to the graph, one entity at a time.
+   * With the fast exit, the entities destroyed after the shutdown of the context are not
+   * finalized, the middleware releases them along with their node and its participant.
+   * So the teardown of a process with many entities announces the destruction of each node only.
+   *
+   * This is meant for processes exiting after the shutdown, the entities destroyed afterwards
+   * leak the memory of their rcl handles.
+   * The default is `false`.
+   */
+  RCLCPP_PUBLIC
+  InitOptions &
+  fast_exit(bool fast_exit);
+
+  /// Return the options of the memory setup for real-time processes.
+  RCLCPP_PUBLIC
+  const RealTimeMemoryOptions &
+  real_time_memory() const;
+
+  /// Set the options of the memory setup for real-time processes, applied by the context init.
+  /**
+   * Once rcl is initialized, rclcpp::Context::init() locks the memory of the process, and
+   * faults in the heap and the stack of the initializing thread, see
+   * rclcpp::prepare_memory_for_real_time().
+   * rclcpp::Executor::prepare_for_real_time() prepares the executor and faults in the stack of
+   * the spinning thread with the same stack size.
+   * By default nothing is done.
+   *
+   * \param[in] options of the memory setup
+   */
+  RCLCPP_PUBLIC
+  InitOptions &
+  real_time_memory(const RealTimeMemoryOptions & options);
+
+  /// Return the options of the aggregation of the /rosout records.
+  RCLCPP_PUBLIC
+  const RosoutAggregationOptions &
+  rosout_aggregation() const;
+
+  /// Set the options of the aggregation of the /rosout records of the nodes of the context.
+  /**
+   * Without the aggregation, each node has its own /rosout publisher, and each log call
+   * publishes its record before returning.
+   * With the aggregation, the nodes of the context whose rosout is enabled share a single
+   * /rosout publisher, see rclcpp::NodeOptions::use_shared_infrastructure().
+   * A log call only formats its record and queues it, the pending records are published
+   * periodically by a background thread:
+   *
+   *   - a record repeating a pending one is counted instead of being queued, it is published
+   *     once, with the number of repetitions appended to its message,
+   *   - at most max_records_per_second records are published per second, the others wait for
+   *     the next periods,
+   *   - the records logged while max_pending_records records are pending are dropped, their
+   *     number is published in a warning of the `rclcpp` logger.
+   *
+   * So a burst of log records does not flood the middleware, at the cost of the latency of the
+   * records on /rosout.
+   * The console and the log file are not affected.
+   *
+   * \param[in] options of the aggregation
+   * \throws std::invalid_argument if the period or the maximum number of pending records is zero
+   */
+  RCLCPP_PUBLIC
+  InitOptions &
+  rosout_aggregation(const RosoutAggregationOptions & options);
+
   /// Assignment operator.
   RCLCPP_PUBLIC
   InitOptions &
@@ -107,6 +237,10 @@ private:
   mutable std::mutex init_options_mutex_;
   std::unique_ptr<rcl_init_options_t> init_options_;
   bool initialize_logging_{true};
+  AsyncLoggingOptions async_logging_options_;
+  bool fast_exit_{false};
+  RealTimeMemoryOptions real_time_memory_options_;
+  RosoutAggregationOptions rosout_aggregation_options_;
 };
 
 }  // namespace rclcpp
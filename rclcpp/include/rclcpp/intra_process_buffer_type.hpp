@@ -27,7 +27,11 @@ enum class IntraProcessBufferType
   /// Set the data type used in the intra-process buffer as std::unique_ptr<MessageT>
   UniquePtr,
   /// Set the data type used in the intra-process buffer as the same used in the callback
-  CallbackDefault
+  CallbackDefault,
+  /// Like SharedPtr, but stored in a buffer which does not take a lock
+  LockFreeSharedPtr,
+  /// Like UniquePtr, but stored in a buffer which does not take a lock
+  LockFreeUniquePtr
 };
 
 }  // namespace rclcpp
@@ -0,0 +1,227 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__LAZY_MESSAGE_HPP_
+#define RCLCPP__LAZY_MESSAGE_HPP_
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "builtin_interfaces/msg/time.hpp"
+#include "rcl/types.h"
+
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Whether MessageT has a `header` member with a `stamp` and a `frame_id`, as std_msgs/Header.
+template<typename MessageT, typename = void>
+struct has_header : std::false_type
+{};
+
+template<typename MessageT>
+struct has_header<
+  MessageT,
+  std::void_t<
+    decltype(std::declval<MessageT>().header.stamp),
+    decltype(std::declval<MessageT>().header.frame_id)>>
+  : std::integral_constant<
+    bool,
+    std::is_same_v<
+      decltype(std::declval<MessageT>().header.stamp), builtin_interfaces::msg::Time> &&
+    std::is_same_v<decltype(std::declval<MessageT>().header.frame_id), std::string>>
+{};
+
+/// Read the stamp and the frame id of a std_msgs/Header at the start of a CDR serialized message.
+/**
+ * Only the plain CDR and CDR2 encodings are supported, which are the ones of the messages
+ * serialized by the middleware.
+ *
+ * \param[in] serialized_message the serialized message, starting with the header.
+ * \param[out] stamp the stamp of the header, if not null.
+ * \param[out] frame_id the frame id of the header, if not null.
+ * \return false if the encoding is not supported or the message is too short.
+ */
+RCLCPP_PUBLIC
+bool
+read_serialized_header(
+  const rcl_serialized_message_t & serialized_message,
+  builtin_interfaces::msg::Time * stamp,
+  std::string * frame_id);
+
+}  // namespace detail
+
+/// Message received serialized by a subscription, which is deserialized on first access.
+/**
+ * Subscription callbacks taking this type receive the messages serialized, as taken from the
+ * middleware, and only pay for the deserialization of the messages they access with get().
+ * If the message has a std_msgs/Header as its first field, get_stamp() and get_frame_id() read
+ * the header from the serialized message, so that callbacks selecting the messages by their
+ * header skip the deserialization of the messages they reject.
+ *
+ * Messages received intra process are already deserialized, and shared with this instance.
+ *
+ * This class is move-only, and is not thread-safe.
+ */
+template<typename MessageT>
+class LazyMessage
+{
+public:
+  /// Wrap a serialized message, deserialized on first access.
+  explicit LazyMessage(std::shared_ptr<const rclcpp::SerializedMessage> serialized_message)
+  : serialized_message_(std::move(serialized_message))
+  {
+    if (!serialized_message_) {
+      throw std::invalid_argument("the serialized message of a LazyMessage must not be null");
+    }
+  }
+
+  /// Share a message which is already deserialized.
+  explicit LazyMessage(std::shared_ptr<const MessageT> message)
+  : message_(std::move(message))
+  {
+    if (!message_) {
+      throw std::invalid_argument("the message of a LazyMessage must not be null");
+    }
+  }
+
+  LazyMessage(LazyMessage && other) = default;
+
+  LazyMessage &
+  operator=(LazyMessage && other) = default;
+
+  LazyMessage(const LazyMessage &) = delete;
+
+  LazyMessage &
+  operator=(const LazyMessage &) = delete;
+
+  /// Whether the message was deserialized, or received deserialized.
+  bool
+  is_deserialized() const
+  {
+    return nullptr != message_;
+  }
+
+  /// Return the message, deserializing it on the first call.
+  /**
+   * \throws rclcpp::exceptions::RCLError if the message can not be deserialized.
+   */
+  std::shared_ptr<const MessageT>
+  get_shared() const
+  {
+    if (!message_) {
+      static const rclcpp::Serialization<MessageT> serialization;
+      auto message = std::make_shared<MessageT>();
+      serialization.deserialize_message(serialized_message_.get(), message.get());
+      message_ = std::move(message);
+    }
+    return message_;
+  }
+
+  /// Return the message, deserializing it on the first call.
+  /**
+   * \throws rclcpp::exceptions::RCLError if the message can not be deserialized.
+   */
+  const MessageT &
+  get() const
+  {
+    return *get_shared();
+  }
+
+  const MessageT &
+  operator*() const
+  {
+    return get();
+  }
+
+  const MessageT *
+  operator->() const
+  {
+    return &get();
+  }
+
+  /// Return the serialized message, or nullptr if the message was received deserialized.
+  const std::shared_ptr<const rclcpp::SerializedMessage> &
+  get_serialized_message() const
+  {
+    return serialized_message_;
+  }
+
+  /// Return the stamp of the header of the message, without deserializing it if possible.
+  template<typename T = MessageT>
+  std::enable_if_t<detail::has_header<T>::value, builtin_interfaces::msg::Time>
+  get_stamp() const
+  {
+    builtin_interfaces::msg::Time stamp;
+    if (!message_ && header_is_first() &&
+      detail::read_serialized_header(
+        serialized_message_->get_rcl_serialized_message(), &stamp, nullptr))
+    {
+      return stamp;
+    }
+    return get().header.stamp;
+  }
+
+  /// Return the frame id of the header of the message, without deserializing it if possible.
+  template<typename T = MessageT>
+  std::enable_if_t<detail::has_header<T>::value, std::string>
+  get_frame_id() const
+  {
+    std::string frame_id;
+    if (!message_ && header_is_first() &&
+      detail::read_serialized_header(
+        serialized_message_->get_rcl_serialized_message(), nullptr, &frame_id))
+    {
+      return frame_id;
+    }
+    return get().header.frame_id;
+  }
+
+private:
+  /// Whether the header is the first field of the message, with the stamp before the frame id.
+  /**
+   * The members of a generated message are declared in the order of its fields, which is also
+   * the order in which they are serialized.
+   */
+  static bool
+  header_is_first()
+  {
+    static const bool is_first = []() {
+        const MessageT message;
+        const auto base = reinterpret_cast<const char *>(&message);
+        const auto stamp = reinterpret_cast<const char *>(&message.header.stamp);
+        const auto frame_id = reinterpret_cast<const char *>(&message.header.frame_id);
+        return base == reinterpret_cast<const char *>(&message.header) && base == stamp &&
+               frame_id > stamp &&
+               static_cast<size_t>(frame_id - stamp) < sizeof(builtin_interfaces::msg::Time) +
+               alignof(std::string);
+      }();
+    return is_first;
+  }
+
+  std::shared_ptr<const rclcpp::SerializedMessage> serialized_message_;
+  mutable std::shared_ptr<const MessageT> message_;
+};
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__LAZY_MESSAGE_HPP_
@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "rclcpp/allocator/allocator_common.hpp"
+#include "rclcpp/detail/loaned_message_pool.hpp"
 #include "rclcpp/logging.hpp"
 #include "rclcpp/publisher_base.hpp"
 
@@ -59,11 +60,30 @@ public:
   LoanedMessage(
     const rclcpp::PublisherBase & pub,
     std::allocator<MessageT> allocator)
+  : LoanedMessage(pub, std::move(allocator), pub.can_loan_messages())
+  {}
+
+  /// Constructor of the LoanedMessage class, choosing whether to loan from the middleware.
+  /**
+   * The publisher uses it not to loan a message from the middleware when it only has intra
+   * process subscriptions, the message being given to them instead, see is_loaned().
+   *
+   * \param[in] pub rclcpp::Publisher instance to which the memory belongs
+   * \param[in] allocator Allocator instance used if the message is not loaned
+   * \param[in] loan_from_middleware true to loan the message from the middleware, which must
+   *   be able to loan messages
+   * \throws anything rclcpp::exceptions::throw_from_rcl_error can throw.
+   */
+  LoanedMessage(
+    const rclcpp::PublisherBase & pub,
+    std::allocator<MessageT> allocator,
+    bool loan_from_middleware)
   : pub_(pub),
     message_(nullptr),
-    message_allocator_(std::move(allocator))
+    message_allocator_(std::move(allocator)),
+    loaned_(loan_from_middleware)
   {
-    if (pub_.can_loan_messages()) {
+    if (loaned_) {
       void * message_ptr = nullptr;
       auto ret = rcl_borrow_loaned_message(
         pub_.get_publisher_handle().get(),
@@ -74,14 +94,37 @@ public:
       }
       message_ = static_cast<MessageT *>(message_ptr);
     } else {
-      RCLCPP_INFO_ONCE(
-        rclcpp::get_logger("rclcpp"),
-        "Currently used middleware can't loan messages. Local allocator will be used.");
+      if (!pub_.can_loan_messages()) {
+        RCLCPP_INFO_ONCE(
+          rclcpp::get_logger("rclcpp"),
+          "Currently used middleware can't loan messages. Local allocator will be used.");
+      }
       message_ = message_allocator_.allocate(1);
       new (message_) MessageT();
     }
   }
 
+  /// Constructor of the LoanedMessage class, taking the message from a pool of the publisher.
+  /**
+   * The message is either loaned from the middleware ahead of time, or allocated by a previous
+   * LoanedMessage of the pool, and it is given back to the pool instead of being returned to the
+   * middleware or deallocated.
+   *
+   * \param[in] pub rclcpp::Publisher instance to which the memory belongs
+   * \param[in] pool pool of messages of the publisher
+   * \throws anything rclcpp::exceptions::throw_from_rcl_error can throw.
+   */
+  LoanedMessage(
+    const rclcpp::PublisherBase & pub,
+    std::shared_ptr<rclcpp::detail::LoanedMessagePool<MessageT, AllocatorT>> pool)
+  : pub_(pub),
+    message_(nullptr),
+    pool_(std::move(pool))
+  {
+    loaned_ = pool_->can_loan_messages();
+    message_ = pool_->acquire();
+  }
+
   /// Constructor of the LoanedMessage class.
   /**
    * The constructor of this class allocates memory for a given message type
@@ -116,7 +159,9 @@ public:
   LoanedMessage(LoanedMessage<MessageT> && other)
   : pub_(std::move(other.pub_)),
     message_(std::move(other.message_)),
-    message_allocator_(std::move(other.message_allocator_))
+    message_allocator_(std::move(other.message_allocator_)),
+    pool_(std::move(other.pool_)),
+    loaned_(other.loaned_)
   {
     other.message_ = nullptr;
   }
@@ -141,7 +186,9 @@ public:
       return;
     }
 
-    if (pub_.can_loan_messages()) {
+    if (pool_) {
+      pool_->recycle(message_);
+    } else if (loaned_) {
       // return allocated memory to the middleware
       auto ret =
         rcl_return_loaned_message_from_publisher(pub_.get_publisher_handle().get(), message_);
@@ -171,6 +218,16 @@ public:
     return message_ != nullptr;
   }
 
+  /// Return true if the message is loaned from the middleware.
+  /**
+   * Otherwise it is allocated locally, either because the middleware cannot loan messages or
+   * because the publisher only had intra process subscriptions when it was borrowed.
+   */
+  bool is_loaned() const
+  {
+    return loaned_;
+  }
+
   /// Access the ROS message instance.
   /**
    * A call to `get()` will return a mutable reference to the underlying ROS message instance.
@@ -192,6 +249,7 @@ public:
    * `rcl_return_loaned_message_from_publisher` manually.
    * If the memory is from the local allocator, the memory is freed when the unique pointer
    * goes out instead.
+   * If the message was taken from a pool, it is given back to the pool in that case.
    *
    * \return std::unique_ptr to the message instance.
    */
@@ -201,7 +259,15 @@ public:
     auto msg = message_;
     message_ = nullptr;
 
-    if (pub_.can_loan_messages()) {
+    if (pool_ && !pool_->can_loan_messages()) {
+      return std::unique_ptr<MessageT, std::function<void(MessageT *)>>(
+        msg,
+        [pool = pool_](MessageT * msg_ptr) {
+          pool->recycle(msg_ptr);
+        });
+    }
+
+    if (pool_ || loaned_) {
       return std::unique_ptr<MessageT, std::function<void(MessageT *)>>(msg, [](MessageT *) {});
     }
 
@@ -214,6 +280,58 @@ public:
       });
   }
 
+  /// Release ownership of the ROS message instance, to share it read-only.
+  /**
+   * Unlike with release(), the memory stays managed: when the last copy of the returned pointer
+   * is destroyed, the message is given back to the pool it was taken from, returned to the
+   * middleware if it is loaned, or freed with the local allocator.
+   * The publisher uses it to share a loaned message with its intra process subscriptions,
+   * without copying it.
+   * A loaned message must not be published with `rcl_publish_loaned_message` afterwards, as
+   * the middleware would take its ownership.
+   *
+   * \return std::shared_ptr to the message instance, which must not be modified.
+   */
+  std::shared_ptr<const MessageT>
+  release_shared()
+  {
+    auto msg = message_;
+    message_ = nullptr;
+
+    if (pool_) {
+      return std::shared_ptr<const MessageT>(
+        msg,
+        [pool = pool_](const MessageT * msg_ptr) {
+          pool->recycle(const_cast<MessageT *>(msg_ptr));
+        });
+    }
+
+    if (loaned_) {
+      // Keep the rcl publisher alive, the loan can be returned after the publisher is destroyed.
+      return std::shared_ptr<const MessageT>(
+        msg,
+        [publisher_handle = pub_.get_publisher_handle()](const MessageT * msg_ptr) {
+          auto ret = rcl_return_loaned_message_from_publisher(
+            publisher_handle.get(), const_cast<MessageT *>(msg_ptr));
+          if (ret != RCL_RET_OK) {
+            RCLCPP_ERROR(
+              rclcpp::get_logger("LoanedMessage"),
+              "rcl_return_loaned_message_from_publisher failed: %s", rcl_get_error_string().str);
+            rcl_reset_error();
+          }
+        });
+    }
+
+    return std::shared_ptr<const MessageT>(
+      msg,
+      [allocator = message_allocator_](const MessageT * msg_ptr) mutable {
+        MessageT * mutable_msg_ptr = const_cast<MessageT *>(msg_ptr);
+        // call destructor before deallocating
+        mutable_msg_ptr->~MessageT();
+        allocator.deallocate(mutable_msg_ptr, 1);
+      });
+  }
+
 protected:
   const rclcpp::PublisherBase & pub_;
 
@@ -221,6 +339,12 @@ protected:
 
   MessageAllocator message_allocator_;
 
+  /// Pool the message was taken from, if any.
+  std::shared_ptr<rclcpp::detail::LoanedMessagePool<MessageT, AllocatorT>> pool_;
+
+  /// True if the message is loaned from the middleware, directly or through the pool.
+  bool loaned_ = false;
+
   /// Deleted copy constructor to preserve memory integrity.
   LoanedMessage(const LoanedMessage<MessageT> & other) = delete;
 };
@@ -15,6 +15,8 @@
 #ifndef RCLCPP__LOGGER_HPP_
 #define RCLCPP__LOGGER_HPP_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -88,6 +90,34 @@ RCLCPP_PUBLIC
 rcpputils::fs::path
 get_logging_directory();
 
+/// Get the number of log records dropped by the asynchronous logging.
+/**
+ * Records are dropped while the queue of the asynchronous logging is full, if its overflow policy
+ * is rclcpp::AsyncLoggingOverflowPolicy::Drop, see rclcpp::InitOptions::async_logging().
+ *
+ * \returns the number of records dropped since the process started.
+ */
+RCLCPP_PUBLIC
+uint64_t
+get_async_logging_dropped_count();
+
+/// Invalidate the effective levels cached by the loggers, see rclcpp::Logger::is_enabled_for().
+/**
+ * It is called when a level is set with rclcpp::Logger::set_level(), and when the logging is
+ * initialized or finalized, but it must be called after setting a level with the rcutils
+ * logging functions directly, e.g. rcutils_logging_set_default_logger_level().
+ */
+RCLCPP_PUBLIC
+void
+invalidate_logger_level_caches();
+
+namespace detail
+{
+/// Incremented each time the logger levels change, cached levels of older generations are stale.
+RCLCPP_PUBLIC
+extern std::atomic<uint64_t> g_logger_level_generation;
+}  // namespace detail
+
 class Logger
 {
 public:
@@ -119,9 +149,17 @@ private:
    * This cannot be called directly, see `rclcpp::get_logger` instead.
    */
   explicit Logger(const std::string & name)
-  : name_(new std::string(name)) {}
+  : name_(new std::string(name)),
+    level_cache_(std::make_shared<std::atomic<uint64_t>>(0u)) {}
+
+  /// Update the cached effective level, and compare the given level to it.
+  RCLCPP_PUBLIC
+  bool
+  update_level_cache(Level level, uint64_t generation) const;
 
   std::shared_ptr<const std::string> name_;
+  // Generation of the logger levels in the high bits, effective level in the low 8 bits.
+  std::shared_ptr<std::atomic<uint64_t>> level_cache_;
 
 public:
   RCLCPP_PUBLIC
@@ -174,6 +212,30 @@ public:
   RCLCPP_PUBLIC
   void
   set_level(Level level);
+
+  /// Return true if messages of the given severity are logged by this logger.
+  /**
+   * The effective level of the logger, i.e. its level or the level of its closest ancestor with
+   * a level set, is cached, so that checking a disabled severity, e.g. in the logging macros, does
+   * not look the level up while no logger level changes, see
+   * rclcpp::invalidate_logger_level_caches().
+   *
+   * \param[in] level the severity of the messages
+   * \return true if the level is at least the effective level of the logger.
+   */
+  bool
+  is_enabled_for(Level level) const
+  {
+    if (!level_cache_) {
+      return rcutils_logging_logger_is_enabled_for(nullptr, static_cast<int>(level));
+    }
+    const uint64_t generation = detail::g_logger_level_generation.load(std::memory_order_acquire);
+    const uint64_t cached = level_cache_->load(std::memory_order_relaxed);
+    if ((cached >> 8u) != generation) {
+      return update_level_cache(level, generation);
+    }
+    return static_cast<uint64_t>(level) >= (cached & 0xffu);
+  }
 };
 
 }  // namespace rclcpp
@@ -51,6 +51,43 @@ public:
 
   virtual bool collect_entities(const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes) = 0;
 
+  /// Refill the handles from the entities found by the last call to collect_entities().
+  /**
+   * This allows an executor to skip walking every node and callback group when it knows that
+   * no entity was added or removed since the last collection.
+   * Memory strategies which do not keep the result of the last collection return false, in
+   * which case the caller has to clear the handles and collect the entities again.
+   * False is also returned if an entity, callback group or node of the last collection has
+   * expired since.
+   *
+   * \return true if the handles were refilled, false if a full collection is required
+   */
+  virtual bool
+  restore_collected_entities()
+  {
+    return false;
+  }
+
+  /// Drop the entities of a callback group from the result of the last collection.
+  /**
+   * This allows an executor to keep reusing the collected entities of the other callback
+   * groups when one is removed from it, instead of collecting them all again.
+   * The handles to wait on are left as they are, until they are refilled.
+   * Memory strategies which do not keep the result of the last collection return false, as
+   * when the group is not part of it, in which case the caller has to collect the entities
+   * again.
+   *
+   * \param[in] group the callback group removed from the executor
+   * \return true if the entities of the group were dropped, false if a full collection is
+   *   required
+   */
+  virtual bool
+  remove_collected_callback_group(const rclcpp::CallbackGroup::WeakPtr & group)
+  {
+    (void)group;
+    return false;
+  }
+
   virtual size_t number_of_ready_subscriptions() const = 0;
   virtual size_t number_of_ready_services() const = 0;
   virtual size_t number_of_ready_clients() const = 0;
@@ -93,6 +130,62 @@ public:
     rclcpp::AnyExecutable & any_exec,
     const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes) = 0;
 
+  /// Take the ready executable with the highest callback group priority.
+  /**
+   * Between executables of equal priority the fixed order timers, subscriptions, services,
+   * clients and waitables is kept.
+   * If timers_by_deadline is true, ready timers of equal priority are ordered by the time until
+   * their next deadline instead, earliest first.
+   *
+   * Memory strategies which do not support priorities take the next executable in fixed order.
+   *
+   * \param[out] any_exec set to the selected executable, left empty if none is ready
+   * \param[in] weak_groups_to_nodes the callback groups to take the executable from
+   * \param[in] timers_by_deadline true to order timers of equal priority by deadline
+   * \return the number of ready executables of lower priority which were passed over
+   */
+  virtual size_t
+  get_next_prioritized_executable(
+    rclcpp::AnyExecutable & any_exec,
+    const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes,
+    bool timers_by_deadline)
+  {
+    (void)timers_by_deadline;
+    get_next_timer(any_exec, weak_groups_to_nodes);
+    if (!any_exec.timer) {
+      get_next_subscription(any_exec, weak_groups_to_nodes);
+    }
+    if (!any_exec.timer && !any_exec.subscription) {
+      get_next_service(any_exec, weak_groups_to_nodes);
+    }
+    if (!any_exec.timer && !any_exec.subscription && !any_exec.service) {
+      get_next_client(any_exec, weak_groups_to_nodes);
+    }
+    if (!any_exec.timer && !any_exec.subscription && !any_exec.service && !any_exec.client) {
+      get_next_waitable(any_exec, weak_groups_to_nodes);
+    }
+    return 0;
+  }
+
+  /// Take the next ready executable in turn, timers first, then subscriptions, etc.
+  /**
+   * Within each kind, the ready executables are taken in turn, starting after the one taken
+   * last, which is taken again until it was taken as many times in a row as the scheduling
+   * weight of its callback group, see ExecutorSchedulingPolicy::RoundRobin.
+   *
+   * Memory strategies which do not support it take the next executable in fixed order.
+   *
+   * \param[out] any_exec set to the selected executable, left empty if none is ready
+   * \param[in] weak_groups_to_nodes the callback groups to take the executable from
+   */
+  virtual void
+  get_next_round_robin_executable(
+    rclcpp::AnyExecutable & any_exec,
+    const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes)
+  {
+    MemoryStrategy::get_next_prioritized_executable(any_exec, weak_groups_to_nodes, false);
+  }
+
   virtual rcl_allocator_t
   get_allocator() = 0;
 
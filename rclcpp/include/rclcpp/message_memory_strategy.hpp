@@ -21,6 +21,7 @@
 #include "rcl/types.h"
 
 #include "rclcpp/allocator/allocator_common.hpp"
+#include "rclcpp/detail/serialized_message_pool.hpp"
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/serialized_message.hpp"
@@ -87,8 +88,17 @@ public:
     return std::allocate_shared<MessageT, MessageAlloc>(*message_allocator_.get());
   }
 
+  /// By default, dynamically allocate a new serialized message, unless the pool is enabled.
+  /**
+   * \sa set_serialized_message_pool_size()
+   * \param[in] capacity Minimum capacity of the buffer of the message.
+   * \return Shared pointer to the serialized message.
+   */
   virtual std::shared_ptr<rclcpp::SerializedMessage> borrow_serialized_message(size_t capacity)
   {
+    if (serialized_message_pool_) {
+      return serialized_message_pool_->borrow(capacity);
+    }
     return std::make_shared<rclcpp::SerializedMessage>(capacity);
   }
 
@@ -102,6 +112,26 @@ public:
     default_buffer_capacity_ = capacity;
   }
 
+  /// Reuse the serialized messages once released, keeping at most max_size of them.
+  /**
+   * The reused messages keep the largest buffer they were given by the middleware, so taking
+   * serialized messages does not allocate once the pool is warmed up.
+   * A message is only reused once the last shared_ptr to it is released, so callbacks may keep
+   * the messages they are given.
+   * Must be called before the subscription is used.
+   *
+   * \param[in] max_size Maximum number of messages kept, 0 to disable the pool.
+   */
+  virtual void set_serialized_message_pool_size(size_t max_size)
+  {
+    if (0 == max_size) {
+      serialized_message_pool_ = nullptr;
+      return;
+    }
+    serialized_message_pool_ =
+      rclcpp::detail::SerializedMessagePool::make_shared(max_size, rcutils_allocator_);
+  }
+
   /// Release ownership of the message, which will deallocate it if it has no more owners.
   /** \param[in] msg Shared pointer to the message we are returning. */
   virtual void return_message(std::shared_ptr<MessageT> & msg)
@@ -124,6 +154,7 @@ public:
   std::shared_ptr<BufferAlloc> buffer_allocator_;
   BufferDeleter buffer_deleter_;
   size_t default_buffer_capacity_ = 0;
+  rclcpp::detail::SerializedMessagePool::SharedPtr serialized_message_pool_;
 
   rcutils_allocator_t rcutils_allocator_;
 };
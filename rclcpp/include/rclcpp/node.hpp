@@ -59,6 +59,7 @@
 #include "rclcpp/node_interfaces/node_waitables_interface.hpp"
 #include "rclcpp/node_options.hpp"
 #include "rclcpp/parameter.hpp"
+#include "rclcpp/parameter_handle.hpp"
 #include "rclcpp/publisher.hpp"
 #include "rclcpp/publisher_options.hpp"
 #include "rclcpp/qos.hpp"
@@ -232,13 +233,16 @@ public:
    * \param[in] period Time interval between triggers of the callback.
    * \param[in] callback User-defined callback function.
    * \param[in] group Callback group to execute this timer's callback in.
+   * \param[in] slack How late the timer may be called, to share a wake-up with other timers,
+   *   see rclcpp::TimerBase::set_slack().
    */
   template<typename DurationRepT = int64_t, typename DurationT = std::milli, typename CallbackT>
   typename rclcpp::WallTimer<CallbackT>::SharedPtr
   create_wall_timer(
     std::chrono::duration<DurationRepT, DurationT> period,
     CallbackT callback,
-    rclcpp::CallbackGroup::SharedPtr group = nullptr);
+    rclcpp::CallbackGroup::SharedPtr group = nullptr,
+    std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero());
 
   /// Create and return a Client.
   /**
@@ -280,7 +284,8 @@ public:
    * \param[in] qos %QoS settings
    * \param options %Publisher options.
    * Not all publisher options are currently respected, the only relevant options for this
-   * publisher are `event_callbacks`, `use_default_callbacks`, and `%callback_group`.
+   * publisher are `event_callbacks`, `use_default_callbacks`, `use_intra_process_comm`, and
+   * `%callback_group`.
    * \return Shared pointer to the created generic publisher.
    */
   template<typename AllocatorT = std::allocator<void>>
@@ -304,8 +309,8 @@ public:
    * \param[in] callback Callback for new messages of serialized form
    * \param[in] options %Subscription options.
    * Not all subscription options are currently respected, the only relevant options for this
- * subscription are `event_callbacks`, `use_default_callbacks`, `ignore_local_publications`, and
- * `%callback_group`.
+   * subscription are `event_callbacks`, `use_default_callbacks`, `ignore_local_publications`,
+   * `use_intra_process_comm`, `intra_process_buffer_type`, and `%callback_group`.
    * \return Shared pointer to the created generic subscription.
    */
   template<typename AllocatorT = std::allocator<void>>
@@ -785,6 +790,23 @@ public:
     const std::string & prefix,
     std::map<std::string, ParameterT> & values) const;
 
+  /// Return a handle reading the current value of the parameter, e.g. from a hot path.
+  /**
+   * Unlike get_parameter(), reading the value with rclcpp::ParameterHandle::get() does not
+   * look the parameter up nor take a lock, and does not copy the value of strings and arrays.
+   * The handle is updated in place whenever the parameter is set, until it is destroyed.
+   *
+   * \param[in] name The name of the parameter.
+   * \return The handle of the parameter.
+   * \throws rclcpp::exceptions::ParameterNotDeclaredException if the parameter
+   *   has not been declared and undeclared parameters are not allowed.
+   * \throws rclcpp::exceptions::InvalidParameterTypeException if the parameter
+   *   has a value of another type than ParameterT.
+   */
+  template<typename ParameterT>
+  typename rclcpp::ParameterHandle<ParameterT>::SharedPtr
+  get_parameter_handle(const std::string & name) const;
+
   /// Return the parameter descriptor for the given parameter name.
   /**
    * Like get_parameters(), this method may throw the
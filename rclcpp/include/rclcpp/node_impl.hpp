@@ -110,14 +110,16 @@ typename rclcpp::WallTimer<CallbackT>::SharedPtr
 Node::create_wall_timer(
   std::chrono::duration<DurationRepT, DurationT> period,
   CallbackT callback,
-  rclcpp::CallbackGroup::SharedPtr group)
+  rclcpp::CallbackGroup::SharedPtr group,
+  std::chrono::nanoseconds slack)
 {
   return rclcpp::create_wall_timer(
     period,
     std::move(callback),
     group,
     this->node_base_.get(),
-    this->node_timers_.get());
+    this->node_timers_.get(),
+    slack);
 }
 
 template<typename ServiceT>
@@ -309,6 +311,16 @@ Node::get_parameter_or(
   return got_parameter;
 }
 
+template<typename ParameterT>
+typename rclcpp::ParameterHandle<ParameterT>::SharedPtr
+Node::get_parameter_handle(const std::string & name) const
+{
+  auto handle = std::make_shared<rclcpp::ParameterHandle<ParameterT>>(
+    extend_name_with_sub_namespace(name, this->get_sub_namespace()));
+  node_parameters_->add_parameter_handle(handle);
+  return handle;
+}
+
 // this is a partially-specialized version of get_parameter above,
 // where our concrete type for ParameterT is std::map, but the to-be-determined
 // type is the value in the map.
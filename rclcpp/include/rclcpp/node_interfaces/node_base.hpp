@@ -15,10 +15,13 @@
 #ifndef RCLCPP__NODE_INTERFACES__NODE_BASE_HPP_
 #define RCLCPP__NODE_INTERFACES__NODE_BASE_HPP_
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include "rcl/node.h"
@@ -121,6 +124,18 @@ public:
   std::unique_lock<std::recursive_mutex>
   acquire_notify_guard_condition_lock() const override;
 
+  RCLCPP_PUBLIC
+  rcl_ret_t
+  trigger_notify_guard_condition() override;
+
+  RCLCPP_PUBLIC
+  void
+  consume_notify_guard_condition_trigger() override;
+
+  RCLCPP_PUBLIC
+  void
+  set_notify_callback(std::function<void ()> callback) override;
+
   RCLCPP_PUBLIC
   bool
   get_use_intra_process_default() const override;
@@ -151,6 +166,30 @@ private:
   mutable std::recursive_mutex notify_guard_condition_mutex_;
   rcl_guard_condition_t notify_guard_condition_ = rcl_get_zero_initialized_guard_condition();
   bool notify_guard_condition_is_valid_;
+  /// Set by a trigger until its waiter consumes it, to skip the triggers meanwhile.
+  std::atomic_bool notify_guard_condition_trigger_pending_{false};
+  /// Called by the triggers along with the notify guard condition, if set.
+  std::function<void ()> notify_callback_;
+
+  /// Hash of the arguments of resolve_topic_or_service_name().
+  struct ResolvedNameKeyHash
+  {
+    size_t
+    operator()(const std::tuple<std::string, bool, bool> & key) const
+    {
+      return std::hash<std::string>()(std::get<0>(key)) ^
+             (static_cast<size_t>(std::get<1>(key)) << 1) ^
+             (static_cast<size_t>(std::get<2>(key)) << 2);
+    }
+  };
+
+  /// Names resolved by resolve_topic_or_service_name(), by name, is_service and only_expand.
+  /**
+   * The name, namespace and remap rules of a node do not change, so they are never invalidated.
+   */
+  mutable std::mutex resolved_names_mutex_;
+  mutable std::unordered_map<
+    std::tuple<std::string, bool, bool>, std::string, ResolvedNameKeyHash> resolved_names_;
 };
 
 }  // namespace node_interfaces
@@ -15,6 +15,7 @@
 #ifndef RCLCPP__NODE_INTERFACES__NODE_BASE_INTERFACE_HPP_
 #define RCLCPP__NODE_INTERFACES__NODE_BASE_INTERFACE_HPP_
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -160,6 +161,44 @@ public:
   std::unique_lock<std::recursive_mutex>
   acquire_notify_guard_condition_lock() const = 0;
 
+  /// Trigger the notify guard condition, unless a previous trigger is still pending.
+  /**
+   * A trigger is pending from the time it triggers the guard condition until the waiter of the
+   * guard condition calls consume_notify_guard_condition_trigger(), so that a burst of changes,
+   * e.g. the creation of many entities, wakes the waiter once.
+   *
+   * \return the return code of rcl_trigger_guard_condition(), RCL_RET_OK if a trigger is pending
+   */
+  RCLCPP_PUBLIC
+  virtual
+  rcl_ret_t
+  trigger_notify_guard_condition() = 0;
+
+  /// Let the next trigger_notify_guard_condition() trigger the notify guard condition again.
+  /**
+   * This must be called by the waiter of the notify guard condition when it woke up on it, and
+   * when it starts waiting on it, before it collects the entities of the node.
+   */
+  RCLCPP_PUBLIC
+  virtual
+  void
+  consume_notify_guard_condition_trigger() = 0;
+
+  /// Set a callback called by each trigger_notify_guard_condition() which triggers.
+  /**
+   * It lets a waiter be notified of the changes of many nodes without waiting on the notify
+   * guard condition of each of them, see ExecutorOptions::shared_node_notifications.
+   * The callback is called with the notify guard condition lock held, so it must neither block
+   * nor call back into the node.
+   * Once this returns, the previous callback is not being called anymore.
+   *
+   * \param[in] callback called on notification, or nullptr to stop calling the previous one
+   */
+  RCLCPP_PUBLIC
+  virtual
+  void
+  set_notify_callback(std::function<void ()> callback) = 0;
+
   /// Return the default preference for using intra process communication.
   RCLCPP_PUBLIC
   virtual
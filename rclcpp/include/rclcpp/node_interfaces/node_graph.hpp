@@ -16,11 +16,13 @@
 #define RCLCPP__NODE_INTERFACES__NODE_GRAPH_HPP_
 
 #include <chrono>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -45,13 +47,24 @@ namespace node_interfaces
 {
 
 /// Implementation the NodeGraph part of the Node API.
+/**
+ * If use_graph_cache is true, the results of get_topic_names_and_types(), get_node_names(),
+ * count_publishers() and count_subscribers() are cached until the graph listener of the context
+ * observes a graph change, see
+ * rclcpp::graph_listener::GraphListener::get_graph_change_count().
+ * They are then as recent as the last graph change the graph listener was woken up for, which
+ * is usually received shortly after the change itself, instead of being queried from rmw on
+ * each call.
+ */
 class NodeGraph : public NodeGraphInterface
 {
 public:
   RCLCPP_SMART_PTR_ALIASES_ONLY(NodeGraph)
 
   RCLCPP_PUBLIC
-  explicit NodeGraph(rclcpp::node_interfaces::NodeBaseInterface * node_base);
+  explicit NodeGraph(
+    rclcpp::node_interfaces::NodeBaseInterface * node_base,
+    bool use_graph_cache = false);
 
   RCLCPP_PUBLIC
   virtual
@@ -61,6 +74,14 @@ public:
   std::map<std::string, std::vector<std::string>>
   get_topic_names_and_types(bool no_demangle = false) const override;
 
+  /// Return the topic names and types, shared with the other callers while the graph is unchanged.
+  /**
+   * Unlike get_topic_names_and_types(), this does not copy the cached result.
+   */
+  RCLCPP_PUBLIC
+  std::shared_ptr<const std::map<std::string, std::vector<std::string>>>
+  get_topic_names_and_types_snapshot(bool no_demangle = false) const;
+
   RCLCPP_PUBLIC
   std::map<std::string, std::vector<std::string>>
   get_service_names_and_types() const override;
@@ -95,6 +116,31 @@ public:
   std::vector<std::string>
   get_node_names() const override;
 
+  /// Return the node names, shared with the other callers while the graph is unchanged.
+  /**
+   * Unlike get_node_names(), this does not copy the cached result.
+   */
+  RCLCPP_PUBLIC
+  std::shared_ptr<const std::vector<std::string>>
+  get_node_names_snapshot() const;
+
+  /// Return the nodes, topics with their endpoints and QoS, and services of the graph at once.
+  /**
+   * Instead of a call per topic to get_publishers_info_by_topic() and
+   * get_subscriptions_info_by_topic() by each caller, the whole graph is queried once and the
+   * snapshot is shared with the other callers while the graph is unchanged, if the graph cache
+   * is used, see the constructor.
+   * With the graph cache, whose graph event makes the graph listener count the graph changes,
+   * the graph is queried again if it changed while it was queried, a few times at most, so that
+   * the snapshot is consistent.
+   * Without it, the graph is queried once and the snapshot may mix states of a changing graph.
+   *
+   * \throws std::runtime_error or rclcpp::exceptions::RCLError if a graph query fails.
+   */
+  RCLCPP_PUBLIC
+  std::shared_ptr<const rclcpp::GraphSnapshot>
+  get_graph_snapshot() const;
+
   RCLCPP_PUBLIC
   std::vector<std::tuple<std::string, std::string, std::string>>
   get_node_names_with_enclaves() const override;
@@ -133,6 +179,13 @@ public:
     rclcpp::Event::SharedPtr event,
     std::chrono::nanoseconds timeout) override;
 
+  RCLCPP_PUBLIC
+  bool
+  wait_for_service_server(
+    rclcpp::Event::SharedPtr event,
+    const std::string & service_name,
+    std::chrono::nanoseconds timeout) override;
+
   RCLCPP_PUBLIC
   size_t
   count_graph_users() const override;
@@ -152,6 +205,66 @@ public:
 private:
   RCLCPP_DISABLE_COPY(NodeGraph)
 
+  using TopicNamesAndTypes = std::map<std::string, std::vector<std::string>>;
+
+  /// Results of the graph queries, valid while the graph change count is unchanged.
+  struct GraphCache
+  {
+    std::mutex mutex;
+    /// Graph change count of the graph listener when the results were queried.
+    uint64_t graph_change_count {0u};
+    /// Graph event held so that the graph listener counts the graph changes seen by this node.
+    rclcpp::Event::SharedPtr graph_event;
+    /// Topic names and types, indexed by no_demangle.
+    std::shared_ptr<const TopicNamesAndTypes> topic_names_and_types[2];
+    std::shared_ptr<const std::vector<std::string>> node_names;
+    std::shared_ptr<const rclcpp::GraphSnapshot> graph_snapshot;
+    std::unordered_map<std::string, size_t> publisher_counts;
+    std::unordered_map<std::string, size_t> subscriber_counts;
+  };
+
+  /// Names resolved for the graph queries, by the name given to them.
+  /**
+   * The name, namespace and remap rules of a node do not change, so they are never invalidated.
+   */
+  struct ResolvedNames
+  {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::string> expanded;
+    std::unordered_map<std::string, std::string> remapped;
+  };
+
+  /// Return the fully qualified name of a topic, expanded with the name and namespace of the node.
+  std::string
+  expand_topic_name(const std::string & topic_name) const;
+
+  /// Return the fully qualified name of a topic, expanded and then remapped.
+  std::string
+  remap_topic_name(const std::string & topic_name) const;
+
+  /// Query the whole graph, see get_graph_snapshot().
+  /**
+   * \param[in] retry_on_graph_change query again if the graph listener counted a graph change
+   *   meanwhile, only reliable while the node holds a graph event, like the graph cache does
+   */
+  rclcpp::GraphSnapshot
+  query_graph_snapshot(bool retry_on_graph_change) const;
+
+  /// Lock the graph cache, after clearing it if the graph changed, if the cache is used.
+  /**
+   * \return false if the results must be queried without the cache, the lock is then not owned
+   */
+  bool
+  lock_graph_cache(std::unique_lock<std::mutex> & lock) const;
+
+  /// Throw if the event was not acquired with get_graph_event().
+  void
+  check_graph_event(const rclcpp::Event::SharedPtr & event) const;
+
+  /// Count the graph change for the waited services it lists, see wait_for_service_server().
+  void
+  update_waited_services();
+
   /// Handle to the NodeBaseInterface given in the constructor.
   rclcpp::node_interfaces::NodeBaseInterface * node_base_;
 
@@ -169,6 +282,21 @@ private:
   /// Number of graph events out on loan, used to determine if the graph should be monitored.
   /** graph_users_count_ is atomic so that it can be accessed without acquiring the graph_mutex_ */
   std::atomic_size_t graph_users_count_;
+
+  /// A service waited for with wait_for_service_server().
+  struct WaitedService
+  {
+    size_t waiters {0u};
+    /// Number of graph changes which listed a server of the service.
+    uint64_t listed_count {0u};
+  };
+  /// Waited services by fully qualified name, guarded by graph_mutex_.
+  std::unordered_map<std::string, WaitedService> waited_services_;
+
+  /// Whether the results of the graph queries are cached.
+  const bool use_graph_cache_;
+  mutable GraphCache graph_cache_;
+  mutable ResolvedNames resolved_names_;
 };
 
 }  // namespace node_interfaces
@@ -130,6 +130,25 @@ private:
   rclcpp::QoS qos_profile_;
 };
 
+/// Immutable view of the whole ROS graph, see NodeGraph::get_graph_snapshot().
+struct GraphSnapshot
+{
+  /// Types and endpoints of a topic.
+  struct Topic
+  {
+    std::vector<std::string> types;
+    std::vector<TopicEndpointInfo> publishers;
+    std::vector<TopicEndpointInfo> subscriptions;
+  };
+
+  /// Fully qualified names of the nodes.
+  std::vector<std::string> node_names;
+  /// Topics, by fully qualified name.
+  std::map<std::string, Topic> topics;
+  /// Types of the services, by fully qualified name.
+  std::map<std::string, std::vector<std::string>> services;
+};
+
 namespace node_interfaces
 {
 
@@ -345,6 +364,33 @@ public:
     rclcpp::Event::SharedPtr event,
     std::chrono::nanoseconds timeout) = 0;
 
+  /// Wait for a graph change listing a server of a service.
+  /**
+   * Unlike wait_for_graph_change(), the graph changes which do not list the service do not wake
+   * the caller up: the services are queried once per graph change for all the waiters of the
+   * node, and only the waiters of the listed services are woken up.
+   * A listed server may not be matched with a client yet, so the caller should check that the
+   * service is ready, e.g. with rclcpp::ClientBase::service_is_ready().
+   *
+   * The given Event must be acquired through the get_graph_event() method, the graph changes
+   * are only listened to while it is held.
+   *
+   * \param[in] event graph event acquired with get_graph_event().
+   * \param[in] service_name fully qualified name of the service.
+   * \param[in] timeout maximum duration of the wait.
+   * \return true if a graph change listed the service, false on timeout or shutdown.
+   * \throws InvalidEventError if the given event is nullptr
+   * \throws EventNotRegisteredError if the given event was not acquired with
+   *   get_graph_event().
+   */
+  RCLCPP_PUBLIC
+  virtual
+  bool
+  wait_for_service_server(
+    rclcpp::Event::SharedPtr event,
+    const std::string & service_name,
+    std::chrono::nanoseconds timeout) = 0;
+
   /// Return the number of on loan graph events, see get_graph_event().
   /**
    * This is typically only used by the rclcpp::graph_listener::GraphListener.
@@ -21,10 +21,16 @@
 #include "rclcpp/macros.hpp"
 #include "rclcpp/node_interfaces/node_base_interface.hpp"
 #include "rclcpp/node_interfaces/node_logging_interface.hpp"
+#include "rclcpp/qos.hpp"
 #include "rclcpp/visibility_control.hpp"
 
 namespace rclcpp
 {
+namespace detail
+{
+class SharedNodeInfrastructure;
+}  // namespace detail
+
 namespace node_interfaces
 {
 
@@ -34,8 +40,19 @@ class NodeLogging : public NodeLoggingInterface
 public:
   RCLCPP_SMART_PTR_ALIASES_ONLY(NodeLoggingInterface)
 
+  /// Constructor.
+  /**
+   * \param[in] node_base the node
+   * \param[in] use_shared_rosout if true, the log records of the node logger are published by
+   *   the "/rosout" publisher shared by the nodes of the context, created with rosout_qos by the
+   *   first node using it, see rclcpp::NodeOptions::use_shared_rosout()
+   * \param[in] rosout_qos QoS of the shared "/rosout" publisher
+   */
   RCLCPP_PUBLIC
-  explicit NodeLogging(rclcpp::node_interfaces::NodeBaseInterface * node_base);
+  explicit NodeLogging(
+    rclcpp::node_interfaces::NodeBaseInterface * node_base,
+    bool use_shared_rosout = false,
+    const rclcpp::QoS & rosout_qos = rclcpp::RosoutQoS());
 
   RCLCPP_PUBLIC
   virtual
@@ -56,6 +73,9 @@ private:
   rclcpp::node_interfaces::NodeBaseInterface * node_base_;
 
   rclcpp::Logger logger_;
+
+  /// Shared "/rosout" publisher of the node logger, if used.
+  std::shared_ptr<rclcpp::detail::SharedNodeInfrastructure> shared_infrastructure_;
 };
 
 }  // namespace node_interfaces
@@ -15,9 +15,13 @@
 #ifndef RCLCPP__NODE_INTERFACES__NODE_PARAMETERS_HPP_
 #define RCLCPP__NODE_INTERFACES__NODE_PARAMETERS_HPP_
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <map>
 #include <memory>
 #include <list>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -30,9 +34,11 @@
 
 #include "rclcpp/macros.hpp"
 #include "rclcpp/node_interfaces/node_base_interface.hpp"
+#include "rclcpp/node_interfaces/node_graph_interface.hpp"
 #include "rclcpp/node_interfaces/node_logging_interface.hpp"
 #include "rclcpp/node_interfaces/node_parameters_interface.hpp"
 #include "rclcpp/node_interfaces/node_services_interface.hpp"
+#include "rclcpp/node_interfaces/node_timers_interface.hpp"
 #include "rclcpp/node_interfaces/node_topics_interface.hpp"
 #include "rclcpp/parameter.hpp"
 #include "rclcpp/parameter_service.hpp"
@@ -41,6 +47,17 @@
 
 namespace rclcpp
 {
+namespace detail
+{
+class LocalParameterEvents;
+class SharedNodeInfrastructure;
+}  // namespace detail
+
+namespace graph_listener
+{
+class GraphListener;
+}  // namespace graph_listener
+
 namespace node_interfaces
 {
 
@@ -97,7 +114,12 @@ public:
     const rclcpp::QoS & parameter_event_qos,
     const rclcpp::PublisherOptionsBase & parameter_event_publisher_options,
     bool allow_undeclared_parameters,
-    bool automatically_declare_parameters_from_overrides);
+    bool automatically_declare_parameters_from_overrides,
+    const node_interfaces::NodeTimersInterface::SharedPtr node_timers = nullptr,
+    std::chrono::nanoseconds parameter_event_coalescing_period = std::chrono::nanoseconds(0),
+    bool use_shared_infrastructure = false,
+    bool lazy_parameter_services = false,
+    const node_interfaces::NodeGraphInterface::SharedPtr node_graph = nullptr);
 
   RCLCPP_PUBLIC
   virtual
@@ -203,11 +225,41 @@ public:
   const std::map<std::string, rclcpp::ParameterValue> &
   get_parameter_overrides() const override;
 
+  RCLCPP_PUBLIC
+  void
+  add_parameter_handle(const rclcpp::detail::ParameterHandleBase::SharedPtr & handle) override;
+
+  RCLCPP_PUBLIC
+  void
+  begin_parameter_event_batch() override;
+
+  RCLCPP_PUBLIC
+  void
+  end_parameter_event_batch() override;
+
   using CallbacksContainerType = std::list<OnSetParametersCallbackHandle::WeakPtr>;
 
 private:
   RCLCPP_DISABLE_COPY(NodeParameters)
 
+  /// Update the handles of a parameter after it was declared, set or undeclared.
+  void
+  update_parameter_handles(const std::string & name);
+
+  /// Publish a parameter event, or merge it into the pending event if batched or coalesced.
+  void
+  publish_parameter_event(rcl_interfaces::msg::ParameterEvent && parameter_event);
+
+  /// Publish the pending event, if any.
+  void
+  publish_pending_parameter_event();
+
+  class ParameterClientObserver;
+
+  /// Create the lazy parameter services, if not created yet and a client of them is discovered.
+  void
+  create_parameter_services_if_discovered();
+
   mutable std::recursive_mutex mutex_;
 
   // There are times when we don't want to allow modifications to parameters
@@ -223,12 +275,46 @@ private:
 
   std::map<std::string, rclcpp::ParameterValue> parameter_overrides_;
 
+  /// Handles of the parameters by name, expired ones are removed when their parameter changes.
+  std::multimap<std::string, rclcpp::detail::ParameterHandleBase::WeakPtr> parameter_handles_;
+
   bool allow_undeclared_ = false;
 
   Publisher<rcl_interfaces::msg::ParameterEvent>::SharedPtr events_publisher_;
 
+  /// Number of nested parameter event batches.
+  size_t parameter_event_batch_depth_ = 0;
+
+  /// Events merged during a batch or coalescing period, not published yet.
+  bool has_pending_parameter_event_ = false;
+  rcl_interfaces::msg::ParameterEvent pending_parameter_event_;
+
+  /// One-shot timer publishing the pending event at the end of the coalescing period, or null.
+  rclcpp::TimerBase::SharedPtr coalescing_timer_;
+
   std::shared_ptr<ParameterService> parameter_service_;
 
+  /// Creates the lazy parameter services, or null if created or not lazy.
+  /** Guarded by lazy_parameter_services_mutex_. */
+  std::function<void ()> create_parameter_service_;
+  std::mutex lazy_parameter_services_mutex_;
+  /// The fully qualified names of the lazy parameter services.
+  std::vector<std::string> lazy_parameter_service_names_;
+  node_interfaces::NodeGraphInterface::SharedPtr node_graph_;
+  std::shared_ptr<rclcpp::graph_listener::GraphListener> graph_listener_;
+  std::unique_ptr<ParameterClientObserver> parameter_client_observer_;
+
+  /// Creates the lazy events publisher, or null if created or disabled.
+  std::function<void ()> create_events_publisher_;
+  /// Set once the lazy parameter services are created, from the graph listener thread.
+  std::atomic<bool> lazy_parameter_services_created_{false};
+
+  /// Shared parameter services and "/parameter_events" publisher, if used.
+  std::shared_ptr<rclcpp::detail::SharedNodeInfrastructure> shared_infrastructure_;
+
+  /// Observers of the parameter events in process, set if the events are published.
+  std::shared_ptr<rclcpp::detail::LocalParameterEvents> local_parameter_events_;
+
   std::string combined_name_;
 
   node_interfaces::NodeLoggingInterface::SharedPtr node_logging_;
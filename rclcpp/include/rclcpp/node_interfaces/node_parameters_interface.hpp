@@ -15,17 +15,21 @@
 #ifndef RCLCPP__NODE_INTERFACES__NODE_PARAMETERS_INTERFACE_HPP_
 #define RCLCPP__NODE_INTERFACES__NODE_PARAMETERS_INTERFACE_HPP_
 
+#include <exception>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "rcl_interfaces/msg/list_parameters_result.hpp"
 #include "rcl_interfaces/msg/parameter_descriptor.hpp"
 #include "rcl_interfaces/msg/set_parameters_result.hpp"
 
+#include "rclcpp/logging.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/parameter.hpp"
+#include "rclcpp/parameter_handle.hpp"
 #include "rclcpp/visibility_control.hpp"
 
 namespace rclcpp
@@ -230,6 +234,68 @@ public:
   virtual
   const std::map<std::string, rclcpp::ParameterValue> &
   get_parameter_overrides() const = 0;
+
+  /// Register a handle, which is updated in place whenever its parameter changes.
+  /**
+   * \sa rclcpp::Node::get_parameter_handle
+   * \throws rclcpp::exceptions::ParameterNotDeclaredException if the parameter
+   *   has not been declared and undeclared parameters are not allowed.
+   * \throws rclcpp::exceptions::InvalidParameterTypeException if the parameter
+   *   has a value of another type than the handle.
+   */
+  RCLCPP_PUBLIC
+  virtual
+  void
+  add_parameter_handle(const rclcpp::detail::ParameterHandleBase::SharedPtr & handle) = 0;
+
+  /// Start merging the parameter events, until the matching end_parameter_event_batch().
+  /**
+   * Batches can be nested, the merged event is published when the outermost batch ends.
+   * \sa rclcpp::node_interfaces::ParameterEventBatch
+   */
+  RCLCPP_PUBLIC
+  virtual
+  void
+  begin_parameter_event_batch() = 0;
+
+  /// End a batch, publishing the merged event if it was the outermost one.
+  RCLCPP_PUBLIC
+  virtual
+  void
+  end_parameter_event_batch() = 0;
+};
+
+/// Scope in which the parameter events of a node are merged into a single event.
+/**
+ * The parameters declared, changed and deleted while the batch exists are published in one
+ * rcl_interfaces::msg::ParameterEvent when it is destroyed, e.g. to declare many parameters at
+ * startup without publishing an event per parameter.
+ */
+class ParameterEventBatch
+{
+public:
+  explicit ParameterEventBatch(NodeParametersInterface::SharedPtr node_parameters)
+  : node_parameters_(std::move(node_parameters))
+  {
+    node_parameters_->begin_parameter_event_batch();
+  }
+
+  ~ParameterEventBatch()
+  {
+    try {
+      node_parameters_->end_parameter_event_batch();
+    } catch (const std::exception & exception) {
+      RCLCPP_ERROR(
+        rclcpp::get_logger("rclcpp"),
+        "failed to publish the parameter event of a batch: %s", exception.what());
+    }
+  }
+
+  ParameterEventBatch(const ParameterEventBatch &) = delete;
+  ParameterEventBatch & operator=(const ParameterEventBatch &) = delete;
+
+private:
+  NodeParametersInterface::SharedPtr node_parameters_;
 };
 
 }  // namespace node_interfaces
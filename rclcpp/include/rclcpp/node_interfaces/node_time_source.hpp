@@ -49,7 +49,9 @@ public:
     rclcpp::node_interfaces::NodeClockInterface::SharedPtr node_clock,
     rclcpp::node_interfaces::NodeParametersInterface::SharedPtr node_parameters,
     const rclcpp::QoS & qos = rclcpp::ClockQoS(),
-    bool use_clock_thread = true
+    bool use_clock_thread = true,
+    bool use_shared_clock_source = false,
+    bool use_shared_infrastructure = false
   );
 
   RCLCPP_PUBLIC
@@ -15,6 +15,7 @@
 #ifndef RCLCPP__NODE_OPTIONS_HPP_
 #define RCLCPP__NODE_OPTIONS_HPP_
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <vector>
@@ -46,12 +47,18 @@ public:
    *   - enable_topic_statistics = false
    *   - start_parameter_services = true
    *   - start_parameter_event_publisher = true
+   *   - lazy_parameter_services = false
+   *   - lazy_lifecycle_services = false
    *   - clock_qos = rclcpp::ClockQoS()
    *   - use_clock_thread = true
+   *   - use_shared_clock_source = false
+   *   - use_graph_cache = false
+   *   - use_shared_infrastructure = false
    *   - rosout_qos = rclcpp::RosoutQoS()
    *   - parameter_event_qos = rclcpp::ParameterEventQoS
    *     - with history setting and depth from rmw_qos_profile_parameter_events
    *   - parameter_event_publisher_options = rclcpp::PublisherOptionsBase
+   *   - parameter_event_coalescing_period = 0, i.e. disabled
    *   - allow_undeclared_parameters = false
    *   - automatically_declare_parameters_from_overrides = false
    *   - allocator = rcl_get_default_allocator()
@@ -246,6 +253,53 @@ public:
   NodeOptions &
   start_parameter_event_publisher(bool start_parameter_event_publisher);
 
+  /// Return the lazy_parameter_services flag.
+  RCLCPP_PUBLIC
+  bool
+  lazy_parameter_services() const;
+
+  /// Set the lazy_parameter_services flag, return this for parameter idiom.
+  /**
+   * If true, the parameter services and the parameter event publisher enabled by
+   * start_parameter_services() and start_parameter_event_publisher() are not created with the
+   * node, which saves their construction and discovery for the nodes never queried.
+   *
+   * The parameter services are created once a client of them is discovered in the graph, so
+   * the first requests of a client may wait for the services to be discovered in turn.
+   * The parameter event publisher is created with the parameter services, or for the first
+   * parameter event that is not only about declared parameters, e.g. the first set parameter.
+   * The events published before are dropped.
+   *
+   * It does not apply to the nodes using the shared infrastructure, see
+   * use_shared_infrastructure().
+   */
+  RCLCPP_PUBLIC
+  NodeOptions &
+  lazy_parameter_services(bool lazy_parameter_services);
+
+  /// Return the lazy_lifecycle_services flag.
+  RCLCPP_PUBLIC
+  bool
+  lazy_lifecycle_services() const;
+
+  /// Set the lazy_lifecycle_services flag, return this for parameter idiom.
+  /**
+   * If true, a rclcpp_lifecycle::LifecycleNode does not create its lifecycle services and its
+   * transition event publisher with the node, which saves their construction and discovery for
+   * the nodes only managed in process, e.g. by a rclcpp_lifecycle::LifecycleGroup.
+   *
+   * They are all created once a client of one of the services or a subscription to the
+   * transition events is discovered in the graph, so the first requests of a client may wait
+   * for the services to be discovered in turn.
+   * The transition events of the transitions before are not published.
+   *
+   * It has no effect on a rclcpp::Node, nor on a lifecycle node created without its
+   * communication interface.
+   */
+  RCLCPP_PUBLIC
+  NodeOptions &
+  lazy_lifecycle_services(bool lazy_lifecycle_services);
+
   /// Return a reference to the clock QoS.
   RCLCPP_PUBLIC
   const rclcpp::QoS &
@@ -273,6 +327,74 @@ public:
   NodeOptions &
   use_clock_thread(bool use_clock_thread);
 
+  /// Return the use_shared_clock_source flag.
+  RCLCPP_PUBLIC
+  bool
+  use_shared_clock_source() const;
+
+  /// Set the use_shared_clock_source flag, return this for parameter idiom.
+  /**
+   * If true, the node uses the "/clock" subscription shared by the nodes of its context which
+   * set this flag, instead of its own subscription and clock thread, when it uses simulated
+   * time.
+   * See rclcpp::TimeSource::set_use_shared_clock_source().
+   */
+  RCLCPP_PUBLIC
+  NodeOptions &
+  use_shared_clock_source(bool use_shared_clock_source);
+
+  /// Return the use_graph_cache flag.
+  RCLCPP_PUBLIC
+  bool
+  use_graph_cache() const;
+
+  /// Set the use_graph_cache flag, return this for parameter idiom.
+  /**
+   * If true, the node caches the results of its topic names and types, node names and
+   * count_publishers() / count_subscribers() graph queries until the graph changes.
+   * See rclcpp::node_interfaces::NodeGraph.
+   */
+  RCLCPP_PUBLIC
+  NodeOptions &
+  use_graph_cache(bool use_graph_cache);
+
+  /// Return the use_shared_infrastructure flag.
+  RCLCPP_PUBLIC
+  bool
+  use_shared_infrastructure() const;
+
+  /// Set the use_shared_infrastructure flag, return this for parameter idiom.
+  /**
+   * If true, the node does not create its own parameter services, "/parameter_events"
+   * publisher, "/rosout" publisher, nor time source subscriptions.
+   * It uses the ones shared by the nodes of its context which set this flag instead, which are
+   * created on a hidden node, named "_node_infrastructure_" followed by a random number, with
+   * the QoS settings of the first node using them.
+   * This lets a process, e.g. a component container, create many nodes without creating the
+   * entities of each of them.
+   *
+   * The start_parameter_services, start_parameter_event_publisher and enable_rosout flags still
+   * apply.
+   * The parameters of the node are served by the shared parameter services, named after the
+   * fully qualified name of the node, e.g. "/ns/talker/rate".
+   * The time source of the node uses the shared "/clock" subscription, see
+   * use_shared_clock_source().
+   *
+   * This will cause the internal rcl_node_options_t struct to be invalidated.
+   */
+  RCLCPP_PUBLIC
+  NodeOptions &
+  use_shared_infrastructure(bool use_shared_infrastructure);
+
+  /// Return true if the log records of the node are published by the shared "/rosout" publisher.
+  /**
+   * They are if rosout is enabled and either the node uses the shared infrastructure or its
+   * context aggregates the rosout records, see rclcpp::InitOptions::rosout_aggregation().
+   */
+  RCLCPP_PUBLIC
+  bool
+  use_shared_rosout() const;
+
   /// Return a reference to the parameter_event_qos QoS.
   RCLCPP_PUBLIC
   const rclcpp::QoS &
@@ -317,6 +439,25 @@ public:
   parameter_event_publisher_options(
     const rclcpp::PublisherOptionsBase & parameter_event_publisher_options);
 
+  /// Return the period during which parameter events are merged before being published.
+  RCLCPP_PUBLIC
+  const std::chrono::nanoseconds &
+  parameter_event_coalescing_period() const;
+
+  /// Set the parameter_event_coalescing_period, return this for parameter idiom.
+  /**
+   * If greater than zero, the parameters declared, changed and deleted during this period after
+   * a first parameter event are merged into a single event, which is published by a timer of the
+   * node when the period elapses, instead of publishing one event for each change.
+   * The timer is executed by the executor spinning the node.
+   * Otherwise, each change is published right away, unless it is done in a
+   * rclcpp::node_interfaces::ParameterEventBatch.
+   */
+  RCLCPP_PUBLIC
+  NodeOptions &
+  parameter_event_coalescing_period(
+    const std::chrono::nanoseconds & parameter_event_coalescing_period);
+
   /// Return the allow_undeclared_parameters flag.
   RCLCPP_PUBLIC
   bool
@@ -400,10 +541,20 @@ private:
 
   bool start_parameter_event_publisher_ {true};
 
+  bool lazy_parameter_services_ {false};
+
+  bool lazy_lifecycle_services_ {false};
+
   rclcpp::QoS clock_qos_ = rclcpp::ClockQoS();
 
   bool use_clock_thread_ {true};
 
+  bool use_shared_clock_source_ {false};
+
+  bool use_graph_cache_ {false};
+
+  bool use_shared_infrastructure_ {false};
+
   rclcpp::QoS parameter_event_qos_ = rclcpp::ParameterEventsQoS(
     rclcpp::QoSInitialization::from_rmw(rmw_qos_profile_parameter_events)
   );
@@ -412,6 +563,8 @@ private:
 
   rclcpp::PublisherOptionsBase parameter_event_publisher_options_ = rclcpp::PublisherOptionsBase();
 
+  std::chrono::nanoseconds parameter_event_coalescing_period_ {0};
+
   bool allow_undeclared_parameters_ {false};
 
   bool automatically_declare_parameters_from_overrides_ {false};
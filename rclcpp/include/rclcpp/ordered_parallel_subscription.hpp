@@ -0,0 +1,363 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__ORDERED_PARALLEL_SUBSCRIPTION_HPP_
+#define RCLCPP__ORDERED_PARALLEL_SUBSCRIPTION_HPP_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "rcl/wait.h"
+
+#include "rclcpp/callback_group.hpp"
+#include "rclcpp/context.hpp"
+#include "rclcpp/guard_condition.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/qos.hpp"
+#include "rclcpp/subscription.hpp"
+#include "rclcpp/subscription_options.hpp"
+#include "rclcpp/waitable.hpp"
+
+namespace rclcpp
+{
+
+/// Subscription processing its messages in parallel and outputting the results in order.
+/**
+ * The messages are taken in order by a subscription in a mutually exclusive callback group,
+ * which numbers them, and are processed concurrently by the threads of the executor running
+ * the reentrant callback group of this waitable.
+ * The results go through a reorder buffer, so that the output callback is called with them
+ * in the order of the messages, one at a time, by the thread completing the oldest pending
+ * message.
+ *
+ * At most window messages are in flight, i.e. taken but whose result is not output yet.
+ * When the window is full, the thread taking the messages processes the oldest queued one
+ * itself, which bounds the memory used and keeps single threaded executors progressing.
+ *
+ * A message whose processing threw an exception has no result, the exception is propagated
+ * to the executor and the following results are output.
+ *
+ * \sa create_ordered_parallel_subscription()
+ */
+template<typename MessageT, typename ResultT>
+class OrderedParallelSubscription : public rclcpp::Waitable
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(OrderedParallelSubscription)
+
+  /// Process a message, called concurrently for different messages.
+  using ProcessCallback = std::function<ResultT(std::shared_ptr<const MessageT>)>;
+  /// Output the result of a message, called in the order of the messages.
+  using OutputCallback = std::function<void(ResultT)>;
+
+  /// Constructor, see create_ordered_parallel_subscription().
+  /**
+   * \param[in] node the node creating the subscription taking the messages.
+   * \param[in] topic_name the topic to subscribe to.
+   * \param[in] qos the quality of service of the subscription.
+   * \param[in] process_callback the callback processing the messages.
+   * \param[in] output_callback the callback receiving the results, in order.
+   * \param[in] window the maximum number of messages in flight.
+   * \param[in] options the options of the subscription, whose callback group must be mutually
+   *   exclusive, so that the messages are numbered in the order they are taken.
+   * \throws std::invalid_argument if a callback is empty, the window is 0 or the callback
+   *   group of the options is not mutually exclusive.
+   */
+  template<typename NodeT>
+  OrderedParallelSubscription(
+    NodeT && node,
+    const std::string & topic_name,
+    const rclcpp::QoS & qos,
+    ProcessCallback process_callback,
+    OutputCallback output_callback,
+    size_t window,
+    const rclcpp::SubscriptionOptions & options)
+  {
+    if (!process_callback || !output_callback) {
+      throw std::invalid_argument("the callbacks of an ordered parallel subscription are empty");
+    }
+    if (0 == window) {
+      throw std::invalid_argument("the window of an ordered parallel subscription must not be 0");
+    }
+    if (!options.callback_group ||
+      rclcpp::CallbackGroupType::MutuallyExclusive != options.callback_group->type())
+    {
+      throw std::invalid_argument(
+              "the messages of an ordered parallel subscription must be taken by a mutually "
+              "exclusive callback group");
+    }
+    state_ = std::make_shared<State>(
+      node->get_node_base_interface()->get_context(), std::move(process_callback),
+      std::move(output_callback), window);
+    // The subscription shares the state, which outlives this waitable while it is executed.
+    subscription_ = node->template create_subscription<MessageT>(
+      topic_name, qos,
+      [state = state_](std::shared_ptr<const MessageT> message) {
+        state->enqueue(std::move(message));
+      },
+      options);
+  }
+
+  virtual ~OrderedParallelSubscription() = default;
+
+  /// Get the subscription taking the messages.
+  typename rclcpp::Subscription<MessageT>::SharedPtr
+  get_subscription() const
+  {
+    return subscription_;
+  }
+
+  /// Get the number of messages taken whose result is not output yet.
+  size_t
+  get_number_of_messages_in_flight() const
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->in_flight;
+  }
+
+  size_t
+  get_number_of_ready_guard_conditions() override {return 1;}
+
+  bool
+  add_to_wait_set(rcl_wait_set_t * wait_set) override
+  {
+    rcl_ret_t ret = rcl_wait_set_add_guard_condition(
+      wait_set, &state_->guard_condition.get_rcl_guard_condition(), NULL);
+    return RCL_RET_OK == ret;
+  }
+
+  bool
+  is_ready(rcl_wait_set_t * wait_set) override
+  {
+    (void)wait_set;
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return !state_->queue.empty();
+  }
+
+  std::shared_ptr<void>
+  take_data() override
+  {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    if (state_->queue.empty()) {
+      return nullptr;
+    }
+    auto item = std::make_shared<Item>(std::move(state_->queue.front()));
+    state_->queue.pop_front();
+    const bool more = !state_->queue.empty();
+    lock.unlock();
+    if (more) {
+      // Wake another thread up for the next message, which is processed concurrently.
+      state_->guard_condition.trigger();
+    }
+    return item;
+  }
+
+  void
+  execute(std::shared_ptr<void> & data) override
+  {
+    if (!data) {
+      return;
+    }
+    state_->process(*std::static_pointer_cast<Item>(data));
+  }
+
+private:
+  struct Item
+  {
+    uint64_t sequence;
+    std::shared_ptr<const MessageT> message;
+  };
+
+  struct State
+  {
+    State(
+      rclcpp::Context::SharedPtr context,
+      ProcessCallback process_callback,
+      OutputCallback output_callback,
+      size_t window)
+    : guard_condition(std::move(context)),
+      process_callback(std::move(process_callback)),
+      output_callback(std::move(output_callback)),
+      window(window)
+    {}
+
+    /// Queue a message taken by the subscription, waiting for room in the window.
+    void
+    enqueue(std::shared_ptr<const MessageT> message)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      queue.push_back(Item{next_sequence++, std::move(message)});
+      ++in_flight;
+      lock.unlock();
+      guard_condition.trigger();
+      lock.lock();
+      while (in_flight > window) {
+        if (queue.empty()) {
+          // The messages in flight are processed by other threads.
+          window_condition.wait(lock);
+          continue;
+        }
+        Item item = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        process(item);
+        lock.lock();
+      }
+    }
+
+    /// Process a message and output the results which are next in order.
+    void
+    process(const Item & item)
+    {
+      std::optional<ResultT> result;
+      try {
+        result.emplace(process_callback(item.message));
+      } catch (...) {
+        complete(item.sequence, std::nullopt);
+        throw;
+      }
+      complete(item.sequence, std::move(result));
+    }
+
+    void
+    complete(uint64_t sequence, std::optional<ResultT> result)
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      results.emplace(sequence, std::move(result));
+      if (outputting) {
+        // The thread outputting the results outputs this one as well once it is next.
+        return;
+      }
+      outputting = true;
+      auto it = results.begin();
+      while (it != results.end() && it->first == next_output_sequence) {
+        std::optional<ResultT> next_result = std::move(it->second);
+        results.erase(it);
+        ++next_output_sequence;
+        --in_flight;
+        lock.unlock();
+        window_condition.notify_all();
+        if (next_result) {
+          try {
+            output_callback(std::move(*next_result));
+          } catch (...) {
+            lock.lock();
+            outputting = false;
+            throw;
+          }
+        }
+        lock.lock();
+        it = results.begin();
+      }
+      outputting = false;
+    }
+
+    rclcpp::GuardCondition guard_condition;
+    const ProcessCallback process_callback;
+    const OutputCallback output_callback;
+    const size_t window;
+
+    mutable std::mutex mutex;
+    std::condition_variable window_condition;
+    std::deque<Item> queue;
+    std::map<uint64_t, std::optional<ResultT>> results;
+    uint64_t next_sequence{0};
+    uint64_t next_output_sequence{0};
+    size_t in_flight{0};
+    bool outputting{false};
+  };
+
+  std::shared_ptr<State> state_;
+  typename rclcpp::Subscription<MessageT>::SharedPtr subscription_;
+};
+
+/// Create a subscription processing its messages in parallel and outputting them in order.
+/**
+ * The messages are processed by the threads of the executor running the callback group, e.g.
+ * a rclcpp::executors::MultiThreadedExecutor, so the processing scales with its threads while
+ * the results are output in the order of the messages.
+ * The messages are taken by a new mutually exclusive callback group of the node.
+ *
+ * \param[in] node the node of the subscription.
+ * \param[in] topic_name the topic to subscribe to.
+ * \param[in] qos the quality of service of the subscription.
+ * \param[in] process_callback the callback processing the messages, concurrently.
+ * \param[in] output_callback the callback receiving the results, in order.
+ * \param[in] window the maximum number of messages in flight.
+ * \param[in] options the options of the subscription, whose callback group, if any, executes
+ *   the processing and must be reentrant, a new reentrant callback group of the node if null.
+ * \return the ordered parallel subscription, which is removed from the node once destroyed.
+ * \throws std::invalid_argument if a callback is empty, the window is 0 or the callback group
+ *   of the options is not reentrant.
+ */
+template<typename MessageT, typename ResultT, typename NodeT>
+typename OrderedParallelSubscription<MessageT, ResultT>::SharedPtr
+create_ordered_parallel_subscription(
+  NodeT && node,
+  const std::string & topic_name,
+  const rclcpp::QoS & qos,
+  typename OrderedParallelSubscription<MessageT, ResultT>::ProcessCallback process_callback,
+  typename OrderedParallelSubscription<MessageT, ResultT>::OutputCallback output_callback,
+  size_t window,
+  const rclcpp::SubscriptionOptions & options = rclcpp::SubscriptionOptions())
+{
+  using OrderedParallelSubscriptionT = OrderedParallelSubscription<MessageT, ResultT>;
+  rclcpp::CallbackGroup::SharedPtr group = options.callback_group;
+  if (!group) {
+    group = node->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+  } else if (rclcpp::CallbackGroupType::Reentrant != group->type()) {
+    throw std::invalid_argument(
+            "the messages of an ordered parallel subscription must be processed by a reentrant "
+            "callback group");
+  }
+  rclcpp::SubscriptionOptions take_options = options;
+  take_options.callback_group =
+    node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+
+  auto node_waitables = node->get_node_waitables_interface();
+  std::weak_ptr<rclcpp::node_interfaces::NodeWaitablesInterface> weak_node = node_waitables;
+  std::weak_ptr<rclcpp::CallbackGroup> weak_group = group;
+  auto deleter = [weak_node, weak_group](OrderedParallelSubscriptionT * ptr)
+    {
+      auto shared_node = weak_node.lock();
+      auto shared_group = weak_group.lock();
+      if (shared_node && shared_group) {
+        // API expects a shared pointer, give it one with a deleter that does nothing.
+        std::shared_ptr<OrderedParallelSubscriptionT> fake_shared_ptr(
+          ptr, [](OrderedParallelSubscriptionT *) {});
+        shared_node->remove_waitable(fake_shared_ptr, shared_group);
+      }
+      delete ptr;
+    };
+  std::shared_ptr<OrderedParallelSubscriptionT> subscription(
+    new OrderedParallelSubscriptionT(
+      node, topic_name, qos, std::move(process_callback), std::move(output_callback), window,
+      take_options),
+    deleter);
+  node_waitables->add_waitable(subscription, group);
+  return subscription;
+}
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__ORDERED_PARALLEL_SUBSCRIPTION_HPP_
@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <future>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -299,6 +300,165 @@ private:
   std::string remote_node_name_;
 };
 
+/// Parameters client of several remote nodes, sending the requests to all of them at once.
+/**
+ * Each operation sends its request to every remote node without waiting for the responses, so
+ * that configuring many nodes takes about one round trip instead of one per node.
+ * The returned future is ready once every remote node responded, and holds the results by
+ * remote node name.
+ * If a request fails, the future holds the exception of the first failure, once every remote
+ * node responded or failed.
+ *
+ * As with AsyncParametersClient, the responses are only received while the node is spun.
+ */
+class AsyncMultiNodeParametersClient
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(AsyncMultiNodeParametersClient)
+
+  template<typename ResultT>
+  using ResultsByNode = std::map<std::string, ResultT>;
+
+  /// Create a parameters client for each of the remote nodes.
+  /**
+   * \param[in] node_base_interface The node base interface of the corresponding node.
+   * \param[in] node_topics_interface Node topic base interface.
+   * \param[in] node_graph_interface The node graph interface of the corresponding node.
+   * \param[in] node_services_interface Node service interface.
+   * \param[in] remote_node_names names of the remote nodes
+   * \param[in] qos_profile (optional) The rmw qos profile to use to subscribe
+   * \param[in] group (optional) The clients will be added to this callback group.
+   * \throws std::invalid_argument if a remote node name is repeated
+   */
+  RCLCPP_PUBLIC
+  AsyncMultiNodeParametersClient(
+    const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base_interface,
+    const rclcpp::node_interfaces::NodeTopicsInterface::SharedPtr node_topics_interface,
+    const rclcpp::node_interfaces::NodeGraphInterface::SharedPtr node_graph_interface,
+    const rclcpp::node_interfaces::NodeServicesInterface::SharedPtr node_services_interface,
+    const std::vector<std::string> & remote_node_names,
+    const rmw_qos_profile_t & qos_profile = rmw_qos_profile_parameters,
+    rclcpp::CallbackGroup::SharedPtr group = nullptr);
+
+  template<typename NodeT>
+  AsyncMultiNodeParametersClient(
+    const std::shared_ptr<NodeT> node,
+    const std::vector<std::string> & remote_node_names,
+    const rmw_qos_profile_t & qos_profile = rmw_qos_profile_parameters,
+    rclcpp::CallbackGroup::SharedPtr group = nullptr)
+  : AsyncMultiNodeParametersClient(
+      node->get_node_base_interface(),
+      node->get_node_topics_interface(),
+      node->get_node_graph_interface(),
+      node->get_node_services_interface(),
+      remote_node_names,
+      qos_profile,
+      group)
+  {}
+
+  template<typename NodeT>
+  AsyncMultiNodeParametersClient(
+    NodeT * node,
+    const std::vector<std::string> & remote_node_names,
+    const rmw_qos_profile_t & qos_profile = rmw_qos_profile_parameters,
+    rclcpp::CallbackGroup::SharedPtr group = nullptr)
+  : AsyncMultiNodeParametersClient(
+      node->get_node_base_interface(),
+      node->get_node_topics_interface(),
+      node->get_node_graph_interface(),
+      node->get_node_services_interface(),
+      remote_node_names,
+      qos_profile,
+      group)
+  {}
+
+  /// Return the names of the remote nodes.
+  RCLCPP_PUBLIC
+  std::vector<std::string>
+  get_remote_node_names() const;
+
+  /// Return the client of one of the remote nodes.
+  /**
+   * \throws std::out_of_range if the node is not one of the remote nodes
+   */
+  RCLCPP_PUBLIC
+  AsyncParametersClient::SharedPtr
+  get_client(const std::string & remote_node_name) const;
+
+  /// Get the same parameters from all the remote nodes.
+  RCLCPP_PUBLIC
+  std::shared_future<ResultsByNode<std::vector<rclcpp::Parameter>>>
+  get_parameters(
+    const std::vector<std::string> & names,
+    std::function<
+      void(std::shared_future<ResultsByNode<std::vector<rclcpp::Parameter>>>)
+    > callback = nullptr);
+
+  /// Set the same parameters on all the remote nodes.
+  RCLCPP_PUBLIC
+  std::shared_future<ResultsByNode<std::vector<rcl_interfaces::msg::SetParametersResult>>>
+  set_parameters(
+    const std::vector<rclcpp::Parameter> & parameters,
+    std::function<
+      void(std::shared_future<
+        ResultsByNode<std::vector<rcl_interfaces::msg::SetParametersResult>>>)
+    > callback = nullptr);
+
+  /// Set different parameters on some of the remote nodes.
+  /**
+   * \param[in] parameters_by_node parameters to set, by remote node name
+   * \param[in] callback (optional) callback called once the future is ready
+   * \throws std::out_of_range if a node is not one of the remote nodes, before sending any
+   *   request
+   */
+  RCLCPP_PUBLIC
+  std::shared_future<ResultsByNode<std::vector<rcl_interfaces::msg::SetParametersResult>>>
+  set_parameters(
+    const ResultsByNode<std::vector<rclcpp::Parameter>> & parameters_by_node,
+    std::function<
+      void(std::shared_future<
+        ResultsByNode<std::vector<rcl_interfaces::msg::SetParametersResult>>>)
+    > callback = nullptr);
+
+  /// List the parameters of all the remote nodes.
+  RCLCPP_PUBLIC
+  std::shared_future<ResultsByNode<rcl_interfaces::msg::ListParametersResult>>
+  list_parameters(
+    const std::vector<std::string> & prefixes,
+    uint64_t depth,
+    std::function<
+      void(std::shared_future<ResultsByNode<rcl_interfaces::msg::ListParametersResult>>)
+    > callback = nullptr);
+
+  /// Return if the parameter services of all the remote nodes are ready.
+  RCLCPP_PUBLIC
+  bool
+  service_is_ready() const;
+
+  /// Wait for the parameter services of all the remote nodes to be ready.
+  /**
+   * \param timeout maximum time to wait, for all the remote nodes
+   * \return `true` if the services are ready and the timeout is not over, `false` otherwise
+   */
+  template<typename RepT = int64_t, typename RatioT = std::milli>
+  bool
+  wait_for_service(
+    std::chrono::duration<RepT, RatioT> timeout = std::chrono::duration<RepT, RatioT>(-1))
+  {
+    return wait_for_service_nanoseconds(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(timeout)
+    );
+  }
+
+protected:
+  RCLCPP_PUBLIC
+  bool
+  wait_for_service_nanoseconds(std::chrono::nanoseconds timeout);
+
+private:
+  std::map<std::string, AsyncParametersClient::SharedPtr> clients_;
+};
+
 class SyncParametersClient
 {
 public:
@@ -371,6 +531,16 @@ public:
     const rmw_qos_profile_t & qos_profile = rmw_qos_profile_parameters)
   : executor_(executor), node_base_interface_(node_base_interface)
   {
+    // The clients are in a callback group of their own, added to the executor once, so that each
+    // request is waited for without adding the node to the executor, nor executing its other
+    // entities, and while the node is spun by another executor.
+    // The node is still added for the requests to its own parameter services when no executor
+    // spins it, as they would not be served otherwise.
+    targets_own_node_ = remote_node_name.empty() ||
+      remote_node_name == node_base_interface->get_name() ||
+      remote_node_name == node_base_interface->get_fully_qualified_name();
+    callback_group_ = node_base_interface->create_callback_group(
+      rclcpp::CallbackGroupType::MutuallyExclusive, false);
     async_parameters_client_ =
       std::make_shared<AsyncParametersClient>(
       node_base_interface,
@@ -378,9 +548,14 @@ public:
       node_graph_interface,
       node_services_interface,
       remote_node_name,
-      qos_profile);
+      qos_profile,
+      callback_group_);
+    executor_->add_callback_group(callback_group_, node_base_interface);
   }
 
+  RCLCPP_PUBLIC
+  ~SyncParametersClient();
+
   template<typename RepT = int64_t, typename RatioT = std::milli>
   std::vector<rclcpp::Parameter>
   get_parameters(
@@ -631,6 +806,8 @@ protected:
 private:
   rclcpp::Executor::SharedPtr executor_;
   const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base_interface_;
+  rclcpp::CallbackGroup::SharedPtr callback_group_;
+  bool targets_own_node_;
   AsyncParametersClient::SharedPtr async_parameters_client_;
 };
 
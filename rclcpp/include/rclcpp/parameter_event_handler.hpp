@@ -17,6 +17,7 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -29,13 +30,20 @@
 #include "rclcpp/node_interfaces/node_topics_interface.hpp"
 #include "rclcpp/parameter.hpp"
 #include "rclcpp/qos.hpp"
+#include "rclcpp/serialized_message.hpp"
 #include "rclcpp/subscription.hpp"
+#include "rclcpp/subscription_options.hpp"
 #include "rclcpp/visibility_control.hpp"
 #include "rcl_interfaces/msg/parameter_event.hpp"
 
 namespace rclcpp
 {
 
+namespace detail
+{
+class LocalParameterEvents;
+}  // namespace detail
+
 struct ParameterCallbackHandle
 {
   RCLCPP_SMART_PTR_DEFINITIONS(ParameterCallbackHandle)
@@ -155,6 +163,12 @@ struct ParameterEventCallbackHandle
  * To remove a parameter event callback, use:
  *
  *   param_handler->remove_event_parameter_callback(handle);
+ *
+ * The events of the nodes in the same context as the node of the handler are not received on
+ * the "/parameter_events" topic, but given to the handler by these nodes, without being
+ * serialized nor copied.
+ * The callbacks are then called from the thread changing the parameters, which must not wait
+ * for a thread calling the callbacks of the handler.
  */
 class ParameterEventHandler
 {
@@ -174,12 +188,19 @@ public:
     auto node_topics = rclcpp::node_interfaces::get_node_topics_interface(node);
 
     callbacks_ = std::make_shared<Callbacks>();
+    observe_local_parameter_events();
 
+    // The events are received serialized, so that the events of the nodes without callbacks
+    // are dropped before being deserialized, and serialized messages are not delivered intra
+    // process.
+    rclcpp::SubscriptionOptions options;
+    options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
     event_subscription_ = rclcpp::create_subscription<rcl_interfaces::msg::ParameterEvent>(
       node_topics, "/parameter_events", qos,
-      [callbacks = callbacks_](const rcl_interfaces::msg::ParameterEvent & event) {
-        callbacks->event_callback(event);
-      });
+      [callbacks = callbacks_](const rclcpp::SerializedMessage & serialized_event) {
+        callbacks->serialized_event_callback(serialized_event);
+      },
+      options);
   }
 
   using ParameterEventCallbackType =
@@ -289,38 +310,15 @@ public:
   using CallbacksContainerType = std::list<ParameterCallbackHandle::WeakPtr>;
 
 protected:
-  // *INDENT-OFF* Uncrustify doesn't handle indented public/private labels
-  // Hash function for string pair required in std::unordered_map
-  // See: https://stackoverflow.com/questions/35985960/c-why-is-boosthash-combine-the-best-way-to-combine-hash-values
-  class StringPairHash
-  {
-  public:
-    template<typename T>
-    inline void hash_combine(std::size_t & seed, const T & v) const
-    {
-      std::hash<T> hasher;
-      seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-    }
-
-    inline size_t operator()(const std::pair<std::string, std::string> & s) const
-    {
-      size_t seed = 0;
-      hash_combine(seed, s.first);
-      hash_combine(seed, s.second);
-      return seed;
-    }
-  };
-  // *INDENT-ON*
-
   struct Callbacks
   {
     std::recursive_mutex mutex_;
 
-    // Map container for registered parameters
+    // Registered parameter callbacks, indexed by node name and then by parameter name, so that
+    // an event only looks up the callbacks of its node and parameters.
     std::unordered_map<
-      std::pair<std::string, std::string>,
-      CallbacksContainerType,
-      StringPairHash
+      std::string,
+      std::unordered_map<std::string, CallbacksContainerType>
     > parameter_callbacks_;
 
     std::list<ParameterEventCallbackHandle::WeakPtr> event_callbacks_;
@@ -329,8 +327,25 @@ protected:
     RCLCPP_PUBLIC
     void
     event_callback(const rcl_interfaces::msg::ParameterEvent & event);
+
+    /// Callback for serialized parameter events, deserialized only if they have callbacks.
+    /**
+     * The events of a node without parameter callbacks are dropped without being deserialized,
+     * unless a callback for all parameter events is registered.
+     */
+    RCLCPP_PUBLIC
+    void
+    serialized_event_callback(const rclcpp::SerializedMessage & serialized_event);
+
+    // The events of the nodes given in process are dropped when received on the topic.
+    std::shared_ptr<rclcpp::detail::LocalParameterEvents> local_parameter_events_;
   };
 
+  /// Get the events of the nodes of the same context in process.
+  RCLCPP_PUBLIC
+  void
+  observe_local_parameter_events();
+
   std::shared_ptr<Callbacks> callbacks_;
 
   // Utility function for resolving node path.
@@ -340,6 +355,9 @@ protected:
   std::shared_ptr<rclcpp::node_interfaces::NodeBaseInterface> node_base_;
 
   rclcpp::Subscription<rcl_interfaces::msg::ParameterEvent>::SharedPtr event_subscription_;
+
+  // Removes the observer of the local parameter events once the last copy is destroyed.
+  std::shared_ptr<void> local_parameter_events_observer_;
 };
 
 }  // namespace rclcpp
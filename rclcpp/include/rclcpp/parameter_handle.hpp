@@ -0,0 +1,162 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__PARAMETER_HANDLE_HPP_
+#define RCLCPP__PARAMETER_HANDLE_HPP_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/parameter_value.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// Base of the parameter handles, updated by the node parameters when the parameter changes.
+class ParameterHandleBase
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(ParameterHandleBase)
+
+  explicit ParameterHandleBase(std::string name)
+  : name_(std::move(name))
+  {}
+
+  virtual ~ParameterHandleBase() = default;
+
+  /// Return the fully qualified name of the parameter.
+  const std::string &
+  get_name() const
+  {
+    return name_;
+  }
+
+  /// Return false if the parameter is not set, was undeclared, or changed to another type.
+  bool
+  is_valid() const
+  {
+    return valid_.load(std::memory_order_acquire);
+  }
+
+  /// Store the new value of the parameter, return false if the handle cannot hold its type.
+  /**
+   * It is called by the node parameters, which never update a handle concurrently.
+   */
+  virtual bool
+  update(const rclcpp::ParameterValue & value) = 0;
+
+  /// Mark the value as outdated, keeping the last valid value readable.
+  void
+  invalidate()
+  {
+    valid_.store(false, std::memory_order_release);
+  }
+
+protected:
+  std::atomic<bool> valid_{false};
+
+private:
+  const std::string name_;
+};
+
+}  // namespace detail
+
+/// Handle reading the current value of a parameter without a lookup, a lock, or a copy.
+/**
+ * The handle is updated in place every time its parameter is set, see
+ * rclcpp::Node::get_parameter_handle().
+ * For bool, integer and floating point parameters reading the value is a single atomic load.
+ * For the other types, e.g. strings or arrays, the value is shared with the handle, and reading
+ * it returns a reference counted pointer to the current value instead of a copy.
+ *
+ * If the parameter is undeclared or changes to another type, the handle keeps its last value,
+ * and is_valid() returns false until the parameter has the type of the handle again.
+ *
+ * \tparam ParameterT type of the parameter value, e.g. double, int64_t, or std::string
+ */
+template<typename ParameterT>
+class ParameterHandle : public detail::ParameterHandleBase
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(ParameterHandle)
+
+  /// Whether the value is read with an atomic load.
+  static constexpr bool is_atomic = std::is_arithmetic_v<ParameterT>;
+
+  /// Type returned by get(), the value itself, or a shared pointer to it.
+  using ReadType = std::conditional_t<
+    is_atomic, ParameterT, std::shared_ptr<const ParameterT>>;
+
+  explicit ParameterHandle(std::string name)
+  : detail::ParameterHandleBase(std::move(name))
+  {}
+
+  /// Return the last valid value, or a default constructed value if it never was valid.
+  ReadType
+  get() const
+  {
+    if constexpr (is_atomic) {
+      return value_.load(std::memory_order_acquire);
+    } else {
+      return std::atomic_load_explicit(&value_, std::memory_order_acquire);
+    }
+  }
+
+  bool
+  update(const rclcpp::ParameterValue & value) override
+  {
+    ParameterT new_value;
+    try {
+      new_value = static_cast<ParameterT>(value.get<ParameterT>());
+    } catch (const rclcpp::ParameterTypeException &) {
+      invalidate();
+      return false;
+    }
+    if constexpr (is_atomic) {
+      value_.store(new_value, std::memory_order_release);
+    } else {
+      std::atomic_store_explicit(
+        &value_, std::shared_ptr<const ParameterT>(std::make_shared<ParameterT>(
+          std::move(new_value))), std::memory_order_release);
+    }
+    valid_.store(true, std::memory_order_release);
+    return true;
+  }
+
+private:
+  using StorageT = std::conditional_t<
+    is_atomic, std::atomic<ParameterT>, std::shared_ptr<const ParameterT>>;
+
+  static StorageT
+  initial_value()
+  {
+    if constexpr (is_atomic) {
+      return ParameterT();
+    } else {
+      return std::make_shared<const ParameterT>();
+    }
+  }
+
+  StorageT value_{initial_value()};
+};
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__PARAMETER_HANDLE_HPP_
@@ -0,0 +1,80 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__PARAMETER_SNAPSHOT_HPP_
+#define RCLCPP__PARAMETER_SNAPSHOT_HPP_
+
+#include <string>
+#include <vector>
+
+#include "rclcpp/node_interfaces/node_parameters_interface.hpp"
+#include "rclcpp/parameter.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+
+/// Save parameters to a binary snapshot file.
+/**
+ * A snapshot is loaded with load_parameter_snapshot() much faster than a YAML parameter file,
+ * so that a node with many parameters can save them and get them back when restarted, e.g.:
+ *
+ *   auto node = std::make_shared<rclcpp::Node>(
+ *     "calibration",
+ *     rclcpp::NodeOptions()
+ *     .parameter_overrides(rclcpp::load_parameter_snapshot("calibration.snapshot"))
+ *     .automatically_declare_parameters_from_overrides(true));
+ *
+ * The snapshot is written to a temporary file renamed once complete, so that an interrupted
+ * save does not replace the previous snapshot.
+ * It uses the byte order of the machine, and is not meant to be exchanged between machines.
+ *
+ * \param[in] filename name of the snapshot file, replaced if it exists.
+ * \param[in] parameters parameters saved, in this order.
+ * \throws std::system_error if the file cannot be written.
+ */
+RCLCPP_PUBLIC
+void
+save_parameter_snapshot(
+  const std::string & filename,
+  const std::vector<rclcpp::Parameter> & parameters);
+
+/// Save all the parameters of a node to a binary snapshot file.
+/**
+ * \param[in] filename name of the snapshot file, replaced if it exists.
+ * \param[in] node_parameters parameters interface of the node.
+ * \throws std::system_error if the file cannot be written.
+ */
+RCLCPP_PUBLIC
+void
+save_parameter_snapshot(
+  const std::string & filename,
+  rclcpp::node_interfaces::NodeParametersInterface & node_parameters);
+
+/// Load the parameters of a binary snapshot file saved by save_parameter_snapshot().
+/**
+ * The file is mapped in memory where supported, rather than read.
+ *
+ * \param[in] filename name of the snapshot file.
+ * \returns the parameters, in the order they were saved.
+ * \throws std::system_error if the file cannot be read.
+ * \throws rclcpp::exceptions::InvalidParametersException if the file is not a valid snapshot.
+ */
+RCLCPP_PUBLIC
+std::vector<rclcpp::Parameter>
+load_parameter_snapshot(const std::string & filename);
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__PARAMETER_SNAPSHOT_HPP_
@@ -20,6 +20,7 @@
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <variant>
 #include <vector>
 
 #include "rcl_interfaces/msg/parameter_type.hpp"
@@ -147,10 +148,10 @@ public:
   typename std::enable_if<type == ParameterType::PARAMETER_BOOL, const bool &>::type
   get() const
   {
-    if (value_.type != rcl_interfaces::msg::ParameterType::PARAMETER_BOOL) {
-      throw ParameterTypeException(ParameterType::PARAMETER_BOOL, get_type());
+    if (auto value = std::get_if<ParameterType::PARAMETER_BOOL>(&value_)) {
+      return *value;
     }
-    return value_.bool_value;
+    throw ParameterTypeException(ParameterType::PARAMETER_BOOL, get_type());
   }
 
   template<ParameterType type>
@@ -158,10 +159,10 @@ public:
   typename std::enable_if<type == ParameterType::PARAMETER_INTEGER, const int64_t &>::type
   get() const
   {
-    if (value_.type != rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER) {
-      throw ParameterTypeException(ParameterType::PARAMETER_INTEGER, get_type());
+    if (auto value = std::get_if<ParameterType::PARAMETER_INTEGER>(&value_)) {
+      return *value;
     }
-    return value_.integer_value;
+    throw ParameterTypeException(ParameterType::PARAMETER_INTEGER, get_type());
   }
 
   template<ParameterType type>
@@ -169,10 +170,10 @@ public:
   typename std::enable_if<type == ParameterType::PARAMETER_DOUBLE, const double &>::type
   get() const
   {
-    if (value_.type != rcl_interfaces::msg::ParameterType::PARAMETER_DOUBLE) {
-      throw ParameterTypeException(ParameterType::PARAMETER_DOUBLE, get_type());
+    if (auto value = std::get_if<ParameterType::PARAMETER_DOUBLE>(&value_)) {
+      return *value;
     }
-    return value_.double_value;
+    throw ParameterTypeException(ParameterType::PARAMETER_DOUBLE, get_type());
   }
 
   template<ParameterType type>
@@ -180,10 +181,10 @@ public:
   typename std::enable_if<type == ParameterType::PARAMETER_STRING, const std::string &>::type
   get() const
   {
-    if (value_.type != rcl_interfaces::msg::ParameterType::PARAMETER_STRING) {
-      throw ParameterTypeException(ParameterType::PARAMETER_STRING, get_type());
+    if (auto value = std::get_if<ParameterType::PARAMETER_STRING>(&value_)) {
+      return *value;
     }
-    return value_.string_value;
+    throw ParameterTypeException(ParameterType::PARAMETER_STRING, get_type());
   }
 
   template<ParameterType type>
@@ -192,10 +193,10 @@ public:
     type == ParameterType::PARAMETER_BYTE_ARRAY, const std::vector<uint8_t> &>::type
   get() const
   {
-    if (value_.type != rcl_interfaces::msg::ParameterType::PARAMETER_BYTE_ARRAY) {
-      throw ParameterTypeException(ParameterType::PARAMETER_BYTE_ARRAY, get_type());
+    if (auto value = std::get_if<ParameterType::PARAMETER_BYTE_ARRAY>(&value_)) {
+      return *value;
     }
-    return value_.byte_array_value;
+    throw ParameterTypeException(ParameterType::PARAMETER_BYTE_ARRAY, get_type());
   }
 
   template<ParameterType type>
@@ -204,10 +205,10 @@ public:
     type == ParameterType::PARAMETER_BOOL_ARRAY, const std::vector<bool> &>::type
   get() const
   {
-    if (value_.type != rcl_interfaces::msg::ParameterType::PARAMETER_BOOL_ARRAY) {
-      throw ParameterTypeException(ParameterType::PARAMETER_BOOL_ARRAY, get_type());
+    if (auto value = std::get_if<ParameterType::PARAMETER_BOOL_ARRAY>(&value_)) {
+      return *value;
     }
-    return value_.bool_array_value;
+    throw ParameterTypeException(ParameterType::PARAMETER_BOOL_ARRAY, get_type());
   }
 
   template<ParameterType type>
@@ -216,10 +217,10 @@ public:
     type == ParameterType::PARAMETER_INTEGER_ARRAY, const std::vector<int64_t> &>::type
   get() const
   {
-    if (value_.type != rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER_ARRAY) {
-      throw ParameterTypeException(ParameterType::PARAMETER_INTEGER_ARRAY, get_type());
+    if (auto value = std::get_if<ParameterType::PARAMETER_INTEGER_ARRAY>(&value_)) {
+      return *value;
     }
-    return value_.integer_array_value;
+    throw ParameterTypeException(ParameterType::PARAMETER_INTEGER_ARRAY, get_type());
   }
 
   template<ParameterType type>
@@ -228,10 +229,10 @@ public:
     type == ParameterType::PARAMETER_DOUBLE_ARRAY, const std::vector<double> &>::type
   get() const
   {
-    if (value_.type != rcl_interfaces::msg::ParameterType::PARAMETER_DOUBLE_ARRAY) {
-      throw ParameterTypeException(ParameterType::PARAMETER_DOUBLE_ARRAY, get_type());
+    if (auto value = std::get_if<ParameterType::PARAMETER_DOUBLE_ARRAY>(&value_)) {
+      return *value;
     }
-    return value_.double_array_value;
+    throw ParameterTypeException(ParameterType::PARAMETER_DOUBLE_ARRAY, get_type());
   }
 
   template<ParameterType type>
@@ -240,10 +241,10 @@ public:
     type == ParameterType::PARAMETER_STRING_ARRAY, const std::vector<std::string> &>::type
   get() const
   {
-    if (value_.type != rcl_interfaces::msg::ParameterType::PARAMETER_STRING_ARRAY) {
-      throw ParameterTypeException(ParameterType::PARAMETER_STRING_ARRAY, get_type());
+    if (auto value = std::get_if<ParameterType::PARAMETER_STRING_ARRAY>(&value_)) {
+      return *value;
     }
-    return value_.string_array_value;
+    throw ParameterTypeException(ParameterType::PARAMETER_STRING_ARRAY, get_type());
   }
 
   // The following get() variants allow the use of primitive types
@@ -352,7 +353,21 @@ public:
   }
 
 private:
-  rcl_interfaces::msg::ParameterValue value_;
+  // The values, whose indices are the parameter types, so that a parameter value is only as
+  // large as a string instead of a whole rcl_interfaces::msg::ParameterValue.
+  using Storage = std::variant<
+    std::monostate,
+    bool,
+    int64_t,
+    double,
+    std::string,
+    std::vector<uint8_t>,
+    std::vector<bool>,
+    std::vector<int64_t>,
+    std::vector<double>,
+    std::vector<std::string>>;
+
+  Storage value_;
 };
 
 /// Return the value of a parameter as a string
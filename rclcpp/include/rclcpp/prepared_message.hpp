@@ -0,0 +1,86 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__PREPARED_MESSAGE_HPP_
+#define RCLCPP__PREPARED_MESSAGE_HPP_
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+
+namespace rclcpp
+{
+
+/// A ROS message serialized once, to be published repeatedly without being serialized again.
+/**
+ * It is meant for the messages which are republished unchanged, e.g. a static map or a robot
+ * description published periodically for the subscriptions joining late.
+ * The message is shared read-only with the prepared message, it must not be modified afterwards.
+ *
+ * When it is published, see rclcpp::Publisher::publish(const PreparedMessage &), the serialized
+ * message is given to the middleware, and the message itself is shared with the intra process
+ * subscriptions, without being copied unless they require its ownership.
+ */
+template<typename MessageT>
+class PreparedMessage
+{
+public:
+  /// Serialize a message.
+  /**
+   * \param[in] message the message, which must not be modified afterwards.
+   * \throws std::invalid_argument if message is a null pointer.
+   * \throws rclcpp::exceptions::RCLError based exceptions if the serialization fails.
+   */
+  explicit PreparedMessage(std::shared_ptr<const MessageT> message)
+  : message_(std::move(message))
+  {
+    if (!message_) {
+      throw std::invalid_argument("cannot prepare a message which is a null pointer");
+    }
+    rclcpp::Serialization<MessageT> serialization;
+    serialization.serialize_message(message_.get(), &serialized_message_);
+  }
+
+  /// Return the message.
+  const MessageT &
+  get() const
+  {
+    return *message_;
+  }
+
+  /// Return the message, shared read-only.
+  const std::shared_ptr<const MessageT> &
+  get_shared() const
+  {
+    return message_;
+  }
+
+  /// Return the serialized form of the message.
+  const rclcpp::SerializedMessage &
+  get_serialized_message() const
+  {
+    return serialized_message_;
+  }
+
+private:
+  std::shared_ptr<const MessageT> message_;
+  rclcpp::SerializedMessage serialized_message_;
+};
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__PREPARED_MESSAGE_HPP_
@@ -17,9 +17,11 @@
 
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "rcl/error_handling.h"
@@ -29,15 +31,21 @@
 
 #include "rclcpp/allocator/allocator_common.hpp"
 #include "rclcpp/allocator/allocator_deleter.hpp"
+#include "rclcpp/detail/loaned_message_pool.hpp"
 #include "rclcpp/detail/resolve_use_intra_process.hpp"
 #include "rclcpp/experimental/intra_process_manager.hpp"
+#include "rclcpp/experimental/publisher_intra_process_history.hpp"
+#include "rclcpp/experimental/publisher_intra_process_ring.hpp"
 #include "rclcpp/get_message_type_support_handle.hpp"
 #include "rclcpp/is_ros_compatible_type.hpp"
 #include "rclcpp/loaned_message.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/node_interfaces/node_base_interface.hpp"
+#include "rclcpp/prepared_message.hpp"
 #include "rclcpp/publisher_base.hpp"
 #include "rclcpp/publisher_options.hpp"
+#include "rclcpp/topic_statistics/publisher_topic_statistics.hpp"
+#include "rclcpp/tracing.hpp"
 #include "rclcpp/type_adapter.hpp"
 #include "rclcpp/type_support_decl.hpp"
 #include "rclcpp/visibility_control.hpp"
@@ -138,6 +146,12 @@ public:
     allocator::set_allocator_for_deleter(&published_type_deleter_, &published_type_allocator_);
     allocator::set_allocator_for_deleter(&ros_message_type_deleter_, &ros_message_type_allocator_);
 
+    if (options_.loaned_message_pool_size > 0) {
+      loaned_message_pool_ =
+        std::make_shared<rclcpp::detail::LoanedMessagePool<ROSMessageType, AllocatorT>>(
+        *this, ros_message_type_allocator_, options_.loaned_message_pool_size);
+    }
+
     if (options_.event_callbacks.deadline_callback) {
       this->add_event_handler(
         options_.event_callbacks.deadline_callback,
@@ -164,6 +178,9 @@ public:
         // pass
       }
     }
+    if (options_.event_callbacks.matched_callback) {
+      this->add_matched_event_handler(node_base, options_.event_callbacks.matched_callback);
+    }
     // Setup continues in the post construction method, post_init_setup().
   }
 
@@ -194,11 +211,25 @@ public:
         throw std::invalid_argument(
                 "intraprocess communication is not allowed with a zero qos history depth value");
       }
-      if (qos.durability() != rclcpp::DurabilityPolicy::Volatile) {
+      rclcpp::experimental::PublisherIntraProcessHistoryBase::SharedPtr history;
+      if (qos.durability() == rclcpp::DurabilityPolicy::TransientLocal) {
+        // The last messages are kept for the intra process subscriptions joining late.
+        history = std::make_shared<rclcpp::experimental::PublisherIntraProcessHistory<
+              ROSMessageType, AllocatorT, ROSMessageTypeDeleter>>(qos.depth());
+        // And published inter process, for the middleware to keep them for the others.
+        intra_process_history_enabled_ = true;
+      } else if (qos.durability() != rclcpp::DurabilityPolicy::Volatile) {
         throw std::invalid_argument(
-                "intraprocess communication allowed only with volatile durability");
+                "intraprocess communication allowed only with volatile or transient local "
+                "durability");
       }
-      uint64_t intra_process_publisher_id = ipm->add_publisher(this->shared_from_this());
+      rclcpp::experimental::PublisherIntraProcessRingBase::SharedPtr ring;
+      if (options_.use_intra_process_ring) {
+        ring = std::make_shared<rclcpp::experimental::PublisherIntraProcessRing<
+              ROSMessageType, AllocatorT, ROSMessageTypeDeleter>>(qos.depth());
+      }
+      uint64_t intra_process_publisher_id =
+        ipm->add_publisher(this->shared_from_this(), std::move(history), std::move(ring));
       this->setup_intra_process(
         intra_process_publisher_id,
         ipm);
@@ -219,6 +250,13 @@ public:
    * If the message is not being published but processed differently, the destructor of this
    * class will either return the message to the middleware or deallocate it via the internal
    * allocator.
+   * If PublisherOptionsBase::loaned_message_pool_size is set, the message is taken from a pool
+   * of messages borrowed ahead, or allocated once, and it is given back to that pool instead.
+   *
+   * If intra process communication is used and all the subscriptions are intra process ones,
+   * the message is not loaned from the middleware but allocated with the message allocator,
+   * or taken from the pool if it does not loan messages, as it is given to the subscriptions
+   * when published.
    * \sa rclcpp::LoanedMessage for details of the LoanedMessage class.
    *
    * \return LoanedMessage containing memory for a ROS message of type ROSMessageType
@@ -226,6 +264,17 @@ public:
   rclcpp::LoanedMessage<ROSMessageType, AllocatorT>
   borrow_loaned_message()
   {
+    if (intra_process_is_enabled_ && this->can_loan_messages() &&
+      !this->inter_process_publish_needed())
+    {
+      return rclcpp::LoanedMessage<ROSMessageType, AllocatorT>(
+        *this,
+        this->get_ros_message_type_allocator(),
+        false);
+    }
+    if (loaned_message_pool_) {
+      return rclcpp::LoanedMessage<ROSMessageType, AllocatorT>(*this, loaned_message_pool_);
+    }
     return rclcpp::LoanedMessage<ROSMessageType, AllocatorT>(
       *this,
       this->get_ros_message_type_allocator());
@@ -249,25 +298,22 @@ public:
   >
   publish(std::unique_ptr<T, ROSMessageTypeDeleter> msg)
   {
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(), rclcpp::topic_statistics::PublishMeasurementType::Publish);
     if (!intra_process_is_enabled_) {
       this->do_inter_process_publish(*msg);
       return;
     }
-    // If an interprocess subscription exist, then the unique_ptr is promoted
-    // to a shared_ptr and published.
-    // This allows doing the intraprocess publish first and then doing the
-    // interprocess publish, resulting in lower publish-to-subscribe latency.
-    // It's not possible to do that with an unique_ptr,
-    // as do_intra_process_publish takes the ownership of the message.
-    bool inter_process_publish_needed =
-      get_subscription_count() > get_intra_process_subscription_count();
-
-    if (inter_process_publish_needed) {
-      auto shared_msg = this->do_intra_process_publish_and_return_shared(std::move(msg));
-      this->do_inter_process_publish(*shared_msg);
-    } else {
-      this->do_intra_process_publish(std::move(msg));
+    if (!msg) {
+      throw std::runtime_error("cannot publish msg which is a null pointer");
+    }
+    // The message is published inter process while it is still owned, then moved to the intra
+    // process subscriptions, so that an inter process subscription, e.g. a remote tool, does not
+    // make the intra process subscriptions taking ownership receive copies.
+    if (this->inter_process_publish_needed()) {
+      this->do_inter_process_publish(*msg);
     }
+    this->do_intra_process_publish(std::move(msg));
   }
 
   /// Publish a message on the topic.
@@ -289,6 +335,8 @@ public:
   >
   publish(const T & msg)
   {
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(), rclcpp::topic_statistics::PublishMeasurementType::Publish);
     // Avoid allocating when not using intra process.
     if (!intra_process_is_enabled_) {
       // In this case we're not using intra process.
@@ -301,6 +349,35 @@ public:
     this->publish(std::move(unique_msg));
   }
 
+  /// Publish an immutable message on the topic.
+  /**
+   * This signature allows the user to publish a message already shared, e.g. a message
+   * received by a subscription and republished, without copying it.
+   * With intra process communication, the message is shared read-only with the intra process
+   * subscriptions, and copied only for the subscriptions requiring its ownership.
+   *
+   * \param[in] msg A shared pointer to the message to send, which must not be modified after.
+   * \throws std::runtime_error if msg is a null pointer.
+   */
+  void
+  publish(std::shared_ptr<const ROSMessageType> msg)
+  {
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(), rclcpp::topic_statistics::PublishMeasurementType::Publish);
+    if (!msg) {
+      throw std::runtime_error("cannot publish msg which is a null pointer");
+    }
+    if (intra_process_is_enabled_) {
+      if (intra_process_history_enabled_ || this->get_intra_process_subscription_count() > 0) {
+        this->do_intra_process_publish_shared(msg);
+      }
+      if (!this->inter_process_publish_needed()) {
+        return;
+      }
+    }
+    this->do_inter_process_publish(*msg);
+  }
+
   /// Publish a message on the topic.
   /**
    * This signature is enabled if this class was created with a TypeAdapter and
@@ -319,13 +396,23 @@ public:
   >
   publish(std::unique_ptr<T, PublishedTypeDeleter> msg)
   {
-    // TODO(wjwwood): later update this to give the unique_ptr to the intra
-    // process manager and let it decide if it needs to be converted or not.
-    // For now, convert it unconditionally and pass it the ROSMessageType
-    // publish function specialization.
-    auto unique_ros_msg = this->create_ros_message_unique_ptr();
-    rclcpp::TypeAdapter<MessageT>::convert_to_ros_message(*msg, *unique_ros_msg);
-    this->publish(std::move(unique_ros_msg));
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(), rclcpp::topic_statistics::PublishMeasurementType::Publish);
+    if (!intra_process_is_enabled_) {
+      this->do_inter_process_publish_converted(*msg);
+      return;
+    }
+    // The intra process manager only converts the message for the subscriptions which do not
+    // take the custom type, and for the inter process publish.
+    bool inter_process_publish_needed = this->inter_process_publish_needed();
+
+    if (inter_process_publish_needed) {
+      auto ros_msg = this->do_intra_process_publish_custom_type_and_return_ros_shared(
+        std::move(msg));
+      this->do_inter_process_publish(*ros_msg);
+    } else {
+      this->do_intra_process_publish_custom_type(std::move(msg));
+    }
   }
 
   /// Publish a message on the topic.
@@ -346,57 +433,130 @@ public:
   >
   publish(const T & msg)
   {
-    // TODO(wjwwood): later update this to give the unique_ptr to the intra
-    // process manager and let it decide if it needs to be converted or not.
-    // For now, convert it unconditionally and pass it the ROSMessageType
-    // publish function specialization.
-
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(), rclcpp::topic_statistics::PublishMeasurementType::Publish);
     // Avoid allocating when not using intra process.
     if (!intra_process_is_enabled_) {
       // Convert to the ROS message equivalent and publish it.
-      ROSMessageType ros_msg;
-      rclcpp::TypeAdapter<MessageT>::convert_to_ros_message(msg, ros_msg);
       // In this case we're not using intra process.
-      return this->do_inter_process_publish(ros_msg);
+      return this->do_inter_process_publish_converted(msg);
     }
-    // Otherwise we have to allocate memory in a unique_ptr, convert it,
-    // and pass it along.
+    // Otherwise we have to allocate memory in a unique_ptr and pass it along.
     // As the message is not const, a copy should be made.
-    // A shared_ptr<const MessageT> could also be constructed here.
-    auto unique_ros_msg = this->create_ros_message_unique_ptr();
-    rclcpp::TypeAdapter<MessageT>::convert_to_ros_message(msg, *unique_ros_msg);
-    this->publish(std::move(unique_ros_msg));
+    auto ptr = PublishedTypeAllocatorTraits::allocate(published_type_allocator_, 1);
+    PublishedTypeAllocatorTraits::construct(published_type_allocator_, ptr, msg);
+    this->publish(
+      std::unique_ptr<PublishedType, PublishedTypeDeleter>(ptr, published_type_deleter_));
   }
 
   void
   publish(const rcl_serialized_message_t & serialized_msg)
   {
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(), rclcpp::topic_statistics::PublishMeasurementType::Publish);
     return this->do_serialized_publish(&serialized_msg);
   }
 
   void
   publish(const SerializedMessage & serialized_msg)
   {
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(), rclcpp::topic_statistics::PublishMeasurementType::Publish);
     return this->do_serialized_publish(&serialized_msg.get_rcl_serialized_message());
   }
 
+  /// Serialize a message once, to publish it repeatedly, see rclcpp::PreparedMessage.
+  /**
+   * \param[in] msg the message, which is copied.
+   * \return the prepared message, to be published with publish(const PreparedMessage &).
+   */
+  PreparedMessage<ROSMessageType>
+  prepare_message(const ROSMessageType & msg)
+  {
+    return PreparedMessage<ROSMessageType>(
+      std::allocate_shared<ROSMessageType>(ros_message_type_allocator_, msg));
+  }
+
+  /// Serialize a message once, to publish it repeatedly, see rclcpp::PreparedMessage.
+  /**
+   * \param[in] msg the message, whose ownership is taken.
+   * \return the prepared message, to be published with publish(const PreparedMessage &).
+   * \throws std::invalid_argument if msg is a null pointer.
+   */
+  PreparedMessage<ROSMessageType>
+  prepare_message(std::unique_ptr<ROSMessageType, ROSMessageTypeDeleter> msg)
+  {
+    return PreparedMessage<ROSMessageType>(std::move(msg));
+  }
+
+  /// Publish a prepared message, without serializing it again.
+  /**
+   * The serialized message is published inter process, as with publish(const SerializedMessage &).
+   * With intra process communication, the message is shared with the intra process
+   * subscriptions instead, and only published inter process if needed, as with the other
+   * publish() overloads, so that the cost of a publication is the cost of its transport.
+   *
+   * \param[in] prepared_msg the message, which can be published again afterwards.
+   * \throws rclcpp::exceptions::RCLError based exceptions if the underlying rcl calls fail.
+   */
+  void
+  publish(const PreparedMessage<ROSMessageType> & prepared_msg)
+  {
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(), rclcpp::topic_statistics::PublishMeasurementType::Publish);
+    if (intra_process_is_enabled_) {
+      if (intra_process_history_enabled_ || this->get_intra_process_subscription_count() > 0) {
+        this->do_intra_process_publish_shared(prepared_msg.get_shared());
+      }
+      if (!this->inter_process_publish_needed()) {
+        return;
+      }
+    }
+    this->do_inter_process_serialized_publish(
+      &prepared_msg.get_serialized_message().get_rcl_serialized_message());
+  }
+
   /// Publish an instance of a LoanedMessage.
   /**
    * When publishing a loaned message, the memory for this ROS message will be deallocated
    * after being published.
    * The instance of the loaned message is no longer valid after this call.
    *
+   * With intra process communication, a message which is not loaned from the middleware is
+   * published as a std::unique_ptr would be.
+   * A loaned message is shared read-only with the intra process subscriptions, without a copy,
+   * and returned to the middleware once they release it.
+   * It is then published inter process as a regular message, since a loaned publication would
+   * give its ownership to the middleware.
+   *
    * \param loaned_msg The LoanedMessage instance to be published.
    */
   void
   publish(rclcpp::LoanedMessage<ROSMessageType, AllocatorT> && loaned_msg)
   {
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(), rclcpp::topic_statistics::PublishMeasurementType::Publish);
     if (!loaned_msg.is_valid()) {
       throw std::runtime_error("loaned message is not valid");
     }
     if (intra_process_is_enabled_) {
-      // TODO(Karsten1987): support loaned message passed by intraprocess
-      throw std::runtime_error("storing loaned messages in intra process is not supported yet");
+      if (!loaned_msg.is_loaned()) {
+        // The message was allocated with the message allocator of the publisher, either by the
+        // LoanedMessage or by the pool, so the message deleter can free it.
+        auto msg = loaned_msg.release();
+        this->publish(
+          std::unique_ptr<ROSMessageType, ROSMessageTypeDeleter>(
+            msg.release(), ros_message_type_deleter_));
+        return;
+      }
+      if (intra_process_history_enabled_ || this->get_intra_process_subscription_count() > 0) {
+        auto shared_msg = loaned_msg.release_shared();
+        this->do_intra_process_publish_shared(shared_msg);
+        if (this->inter_process_publish_needed()) {
+          this->do_inter_process_publish(*shared_msg);
+        }
+        return;
+      }
     }
 
     // verify that publisher supports loaned messages
@@ -415,6 +575,116 @@ public:
     }
   }
 
+  /// Publish a range of messages on the topic.
+  /**
+   * The elements of the range are either ROS messages, which are copied if intra process
+   * communication is used, or unique pointers to ROS messages, which are moved from.
+   *
+   * The messages are published in order, as with a call to publish() for each of them, but
+   * the setup shared by all the messages is done once: the intra process manager is looked up
+   * and the subscription counts deciding whether the messages must also be published inter
+   * process are queried a single time for the whole batch.
+   *
+   * \param[in] first the beginning of the range of messages
+   * \param[in] last the end of the range of messages
+   * \throws std::runtime_error if an element is a null pointer, the previous messages were
+   *   published
+   * \throws rclcpp::exceptions::RCLError based exceptions if the underlying rcl calls fail
+   */
+  template<typename InputIt>
+  void
+  publish_batch(InputIt first, InputIt last)
+  {
+    using ValueT = typename std::iterator_traits<InputIt>::value_type;
+    constexpr bool is_unique_ptr =
+      std::is_same<ValueT, std::unique_ptr<ROSMessageType, ROSMessageTypeDeleter>>::value;
+    static_assert(
+      is_unique_ptr || std::is_same<ValueT, ROSMessageType>::value,
+      "publish_batch() takes a range of ROS messages or of unique pointers to ROS messages");
+
+    if (!intra_process_is_enabled_) {
+      for (; first != last; ++first) {
+        rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+          topic_statistics_.get(), rclcpp::topic_statistics::PublishMeasurementType::Publish);
+        if constexpr (is_unique_ptr) {
+          if (!*first) {
+            throw std::runtime_error("cannot publish msg which is a null pointer");
+          }
+          this->do_inter_process_publish(**first);
+        } else {
+          this->do_inter_process_publish(*first);
+        }
+      }
+      return;
+    }
+
+    auto ipm = weak_ipm_.lock();
+    if (!ipm) {
+      throw std::runtime_error(
+              "intra process publish called after destruction of intra process manager");
+    }
+    bool inter_process_publish_needed = this->inter_process_publish_needed();
+
+    for (; first != last; ++first) {
+      rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+        topic_statistics_.get(), rclcpp::topic_statistics::PublishMeasurementType::Publish);
+      std::unique_ptr<ROSMessageType, ROSMessageTypeDeleter> msg;
+      if constexpr (is_unique_ptr) {
+        msg = std::move(*first);
+        if (!msg) {
+          throw std::runtime_error("cannot publish msg which is a null pointer");
+        }
+      } else {
+        msg = this->duplicate_ros_message_as_unique_ptr(*first);
+      }
+      this->record_intra_process_fan_out();
+      // Published inter process while still owned, as publish() does.
+      if (inter_process_publish_needed) {
+        this->do_inter_process_publish(*msg);
+      }
+      ipm->template do_intra_process_publish<ROSMessageType, AllocatorT>(
+        intra_process_publisher_id_,
+        std::move(msg),
+        ros_message_type_allocator_);
+    }
+  }
+
+  /// Publish a container of messages on the topic.
+  /**
+   * \sa publish_batch(InputIt, InputIt)
+   *
+   * \param[in] msgs the messages, unique pointers in it are moved from
+   */
+  template<typename ContainerT>
+  void
+  publish_batch(ContainerT & msgs)
+  {
+    this->publish_batch(std::begin(msgs), std::end(msgs));
+  }
+
+  /// Publish the message built by a generator, only if a subscription matches the publisher.
+  /**
+   * The generator is not called when no subscription, local or remote, matches the publisher,
+   * see has_subscribers(), so that expensive messages, e.g. for debugging, cost nothing to
+   * the publishers nobody listens to.
+   * The messages skipped are not kept by the publisher, so subscriptions with a transient local
+   * durability joining later do not receive them.
+   *
+   * \param[in] generator callable without arguments, returning a message accepted by publish(),
+   *   e.g. a ROSMessageType or a std::unique_ptr to it.
+   * \return true if the message was built and published, false if it was skipped.
+   */
+  template<typename GeneratorT>
+  bool
+  publish_lazy(GeneratorT && generator)
+  {
+    if (!this->has_subscribers()) {
+      return false;
+    }
+    this->publish(std::forward<GeneratorT>(generator)());
+    return true;
+  }
+
   [[deprecated("use get_published_type_allocator() or get_ros_message_type_allocator() instead")]]
   std::shared_ptr<PublishedTypeAllocator>
   get_allocator() const
@@ -439,6 +709,11 @@ protected:
   do_inter_process_publish(const ROSMessageType & msg)
   {
     TRACEPOINT(rclcpp_publish, nullptr, static_cast<const void *>(&msg));
+    rclcpp::tracing::trace(
+      rclcpp::tracing::TraceEventType::Publish, publisher_handle_.get(), 0, &msg);
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(),
+      rclcpp::topic_statistics::PublishMeasurementType::InterProcessPublish);
     auto status = rcl_publish(publisher_handle_.get(), &msg, nullptr);
 
     if (RCL_RET_PUBLISHER_INVALID == status) {
@@ -463,6 +738,15 @@ protected:
       // TODO(Karsten1987): support serialized message passed by intraprocess
       throw std::runtime_error("storing serialized messages in intra process is not supported yet");
     }
+    this->do_inter_process_serialized_publish(serialized_msg);
+  }
+
+  void
+  do_inter_process_serialized_publish(const rcl_serialized_message_t * serialized_msg)
+  {
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(),
+      rclcpp::topic_statistics::PublishMeasurementType::InterProcessPublish);
     auto status = rcl_publish_serialized_message(publisher_handle_.get(), serialized_msg, nullptr);
     if (RCL_RET_OK != status) {
       rclcpp::exceptions::throw_from_rcl_error(status, "failed to publish serialized message");
@@ -473,6 +757,9 @@ protected:
   do_loaned_message_publish(
     std::unique_ptr<ROSMessageType, std::function<void(ROSMessageType *)>> msg)
   {
+    rclcpp::topic_statistics::ScopedPublishMeasurement measurement(
+      topic_statistics_.get(),
+      rclcpp::topic_statistics::PublishMeasurementType::InterProcessPublish);
     auto status = rcl_publish_loaned_message(publisher_handle_.get(), msg.get(), nullptr);
 
     if (RCL_RET_PUBLISHER_INVALID == status) {
@@ -490,6 +777,47 @@ protected:
     }
   }
 
+  /// Return true if the messages published intra process must also be published inter process.
+  /**
+   * They are if there are inter process subscriptions, or to be kept by the middleware for the
+   * inter process subscriptions joining late, with transient local durability.
+   */
+  bool
+  inter_process_publish_needed() const
+  {
+    return intra_process_history_enabled_ ||
+           get_subscription_count() > get_intra_process_subscription_count();
+  }
+
+  /// Convert a message of the custom type of the TypeAdapter, and publish it inter process.
+  /**
+   * With PublisherOptionsBase::reuse_converted_ros_message, the message is converted into a
+   * ROS message kept by the calling thread, whose buffers are reused by the next conversions.
+   */
+  template<typename T>
+  void
+  do_inter_process_publish_converted(const T & msg)
+  {
+    if (options_.reuse_converted_ros_message) {
+      thread_local ROSMessageType reused_ros_msg;
+      rclcpp::TypeAdapter<MessageT>::convert_to_ros_message(msg, reused_ros_msg);
+      this->do_inter_process_publish(reused_ros_msg);
+      return;
+    }
+    ROSMessageType ros_msg;
+    rclcpp::TypeAdapter<MessageT>::convert_to_ros_message(msg, ros_msg);
+    this->do_inter_process_publish(ros_msg);
+  }
+
+  /// Record the intra process subscriptions a message is published to, if statistics are enabled.
+  void
+  record_intra_process_fan_out() const
+  {
+    if (topic_statistics_) {
+      topic_statistics_->record_intra_process_fan_out(this->get_intra_process_subscription_count());
+    }
+  }
+
   void
   do_intra_process_publish(std::unique_ptr<ROSMessageType, ROSMessageTypeDeleter> msg)
   {
@@ -501,6 +829,7 @@ protected:
     if (!msg) {
       throw std::runtime_error("cannot publish msg which is a null pointer");
     }
+    this->record_intra_process_fan_out();
 
     ipm->template do_intra_process_publish<ROSMessageType, AllocatorT>(
       intra_process_publisher_id_,
@@ -520,6 +849,7 @@ protected:
     if (!msg) {
       throw std::runtime_error("cannot publish msg which is a null pointer");
     }
+    this->record_intra_process_fan_out();
 
     return ipm->template do_intra_process_publish_and_return_shared<ROSMessageType,
              AllocatorT>(
@@ -528,6 +858,69 @@ protected:
       ros_message_type_allocator_);
   }
 
+  void
+  do_intra_process_publish_shared(std::shared_ptr<const ROSMessageType> msg)
+  {
+    auto ipm = weak_ipm_.lock();
+    if (!ipm) {
+      throw std::runtime_error(
+              "intra process publish called after destruction of intra process manager");
+    }
+    if (!msg) {
+      throw std::runtime_error("cannot publish msg which is a null pointer");
+    }
+    this->record_intra_process_fan_out();
+
+    ipm->template do_intra_process_publish_shared<ROSMessageType, AllocatorT>(
+      intra_process_publisher_id_,
+      std::move(msg),
+      ros_message_type_allocator_,
+      ros_message_type_deleter_);
+  }
+
+  void
+  do_intra_process_publish_custom_type(std::unique_ptr<PublishedType, PublishedTypeDeleter> msg)
+  {
+    auto ipm = weak_ipm_.lock();
+    if (!ipm) {
+      throw std::runtime_error(
+              "intra process publish called after destruction of intra process manager");
+    }
+    if (!msg) {
+      throw std::runtime_error("cannot publish msg which is a null pointer");
+    }
+    this->record_intra_process_fan_out();
+
+    ipm->template do_intra_process_publish_custom_type<PublishedType, ROSMessageType, AllocatorT,
+      PublishedTypeDeleter, ROSMessageTypeDeleter>(
+      intra_process_publisher_id_,
+      std::move(msg),
+      published_type_allocator_,
+      ros_message_type_allocator_);
+  }
+
+  std::shared_ptr<const ROSMessageType>
+  do_intra_process_publish_custom_type_and_return_ros_shared(
+    std::unique_ptr<PublishedType, PublishedTypeDeleter> msg)
+  {
+    auto ipm = weak_ipm_.lock();
+    if (!ipm) {
+      throw std::runtime_error(
+              "intra process publish called after destruction of intra process manager");
+    }
+    if (!msg) {
+      throw std::runtime_error("cannot publish msg which is a null pointer");
+    }
+    this->record_intra_process_fan_out();
+
+    return ipm->template do_intra_process_publish_custom_type_and_return_ros_shared<
+      PublishedType, ROSMessageType, AllocatorT, PublishedTypeDeleter, ROSMessageTypeDeleter>(
+      intra_process_publisher_id_,
+      std::move(msg),
+      published_type_allocator_,
+      ros_message_type_allocator_);
+  }
+
   /// Return a new unique_ptr using the ROSMessageType of the publisher.
   std::unique_ptr<ROSMessageType, ROSMessageTypeDeleter>
   create_ros_message_unique_ptr()
@@ -557,6 +950,13 @@ protected:
   PublishedTypeDeleter published_type_deleter_;
   ROSMessageTypeAllocator ros_message_type_allocator_;
   ROSMessageTypeDeleter ros_message_type_deleter_;
+
+  /// Pool of the loaned messages, if enabled by the options.
+  std::shared_ptr<rclcpp::detail::LoanedMessagePool<ROSMessageType, AllocatorT>>
+  loaned_message_pool_;
+
+  /// True if the intra process manager keeps a history of the messages, for transient local.
+  bool intra_process_history_enabled_ = false;
 };
 
 }  // namespace rclcpp
@@ -21,6 +21,7 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -37,6 +38,8 @@
 namespace rclcpp
 {
 
+class Context;
+
 // Forward declaration is used for friend statement.
 namespace node_interfaces
 {
@@ -53,6 +56,11 @@ namespace experimental
 class IntraProcessManager;
 }  // namespace experimental
 
+namespace topic_statistics
+{
+class PublisherTopicStatistics;
+}  // namespace topic_statistics
+
 class PublisherBase : public std::enable_shared_from_this<PublisherBase>
 {
   friend ::rclcpp::node_interfaces::NodeTopicsInterface;
@@ -115,6 +123,16 @@ public:
   const std::vector<std::shared_ptr<rclcpp::QOSEventHandlerBase>> &
   get_event_handlers() const;
 
+  /// Get a single waitable executing all the QoS event handlers of this publisher.
+  /**
+   * Executors add it instead of each handler, so that they handle one waitable per publisher.
+   * \return the only event handler, a rclcpp::QOSEventHandlerGroup of all of them, or nullptr
+   *   if there are none.
+   */
+  RCLCPP_PUBLIC
+  rclcpp::Waitable::SharedPtr
+  get_event_handlers_waitable();
+
   /// Get subscription count
   /** \return The number of subscriptions. */
   RCLCPP_PUBLIC
@@ -127,6 +145,23 @@ public:
   size_t
   get_intra_process_subscription_count() const;
 
+  /// Return true if at least one subscription, local or remote, matches this publisher.
+  /**
+   * Unlike get_subscription_count(), it does not query the middleware, so it can be called
+   * before each publication, e.g. to skip building messages nobody listens to.
+   * The first call starts counting the subscriptions of the topic from the GraphListener thread
+   * of the context, after each graph change, and the following calls read the cached result.
+   * A new subscription is seen once its graph change is handled, as it is seen by the
+   * middleware once discovered.
+   * Subscriptions with an incompatible QoS are counted.
+   *
+   * \throws rclcpp::graph_listener::GraphListenerShutdownError on the first call, if the
+   *   GraphListener is shutdown
+   */
+  RCLCPP_PUBLIC
+  bool
+  has_subscribers() const;
+
   /// Manually assert that this Publisher is alive (for RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC).
   /**
    * If the rmw Liveliness policy is set to RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC, the creator
@@ -203,6 +238,22 @@ public:
   std::vector<rclcpp::NetworkFlowEndpoint>
   get_network_flow_endpoints() const;
 
+  /// Set the topic statistics measuring the publications, or null to disable them.
+  /**
+   * Implementation utility function used to setup the topic statistics after creation, see
+   * PublisherOptionsBase::topic_stats_options.
+   * It must not be called while the publisher is publishing.
+   */
+  RCLCPP_PUBLIC
+  void
+  set_topic_statistics(
+    std::shared_ptr<rclcpp::topic_statistics::PublisherTopicStatistics> topic_statistics);
+
+  /// Get the topic statistics measuring the publications, null if they are disabled.
+  RCLCPP_PUBLIC
+  std::shared_ptr<rclcpp::topic_statistics::PublisherTopicStatistics>
+  get_topic_statistics() const;
+
 protected:
   template<typename EventCallbackT>
   void
@@ -216,9 +267,21 @@ protected:
       rcl_publisher_event_init,
       publisher_handle_,
       event_type);
-    event_handlers_.emplace_back(handler);
+    add_event_handler(std::move(handler));
   }
 
+  /// Add a QoS event handler, allocating the event handlers with the first one.
+  RCLCPP_PUBLIC
+  void
+  add_event_handler(std::shared_ptr<rclcpp::QOSEventHandlerBase> handler);
+
+  /// Add a handler of the changes of the number of subscriptions matched by the publisher.
+  RCLCPP_PUBLIC
+  void
+  add_matched_event_handler(
+    rclcpp::node_interfaces::NodeBaseInterface * node_base,
+    const QOSMatchedCallbackType & callback);
+
   RCLCPP_PUBLIC
   void default_incompatible_qos_callback(QOSOfferedIncompatibleQoSInfo & info) const;
 
@@ -226,7 +289,16 @@ protected:
 
   std::shared_ptr<rcl_publisher_t> publisher_handle_;
 
-  std::vector<std::shared_ptr<rclcpp::QOSEventHandlerBase>> event_handlers_;
+  /// QoS event handlers of the publisher.
+  struct EventHandlers
+  {
+    std::vector<std::shared_ptr<rclcpp::QOSEventHandlerBase>> handlers;
+    std::shared_ptr<rclcpp::QOSEventHandlerGroup> group;
+  };
+  /// Allocated with the first handler, so the publishers without any, e.g. created with
+  /// PublisherOptionsBase::use_default_callbacks false and no event callbacks, do not pay
+  /// for them.
+  std::unique_ptr<EventHandlers> event_handlers_;
 
   using IntraProcessManagerWeakPtr =
     std::weak_ptr<rclcpp::experimental::IntraProcessManager>;
@@ -234,7 +306,17 @@ protected:
   IntraProcessManagerWeakPtr weak_ipm_;
   uint64_t intra_process_publisher_id_;
 
+  std::shared_ptr<rclcpp::topic_statistics::PublisherTopicStatistics> topic_statistics_;
+
   rmw_gid_t rmw_gid_;
+
+private:
+  class SubscriptionObserver;
+
+  std::weak_ptr<rclcpp::Context> context_;
+  // Created by the first call to has_subscribers().
+  mutable std::once_flag subscription_observer_flag_;
+  mutable std::unique_ptr<SubscriptionObserver> subscription_observer_;
 };
 
 }  // namespace rclcpp
@@ -15,6 +15,7 @@
 #ifndef RCLCPP__PUBLISHER_OPTIONS_HPP_
 #define RCLCPP__PUBLISHER_OPTIONS_HPP_
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -28,6 +29,8 @@
 #include "rclcpp/qos.hpp"
 #include "rclcpp/qos_event.hpp"
 #include "rclcpp/qos_overriding_options.hpp"
+#include "rclcpp/serialized_message_codec.hpp"
+#include "rclcpp/topic_statistics_state.hpp"
 
 namespace rclcpp
 {
@@ -59,6 +62,66 @@ struct PublisherOptionsBase
   rmw_implementation_payload = nullptr;
 
   QosOverridingOptions qos_overriding_options;
+
+  /// Number of messages kept for Publisher::borrow_loaned_message(), 0 to disable the pool.
+  /**
+   * The messages are borrowed ahead from the middleware if it can loan messages, otherwise they
+   * are allocated once and reused.
+   */
+  size_t loaned_message_pool_size = 0;
+
+  /// True to store each message published intra process once, in a ring read by the subscriptions.
+  /**
+   * The subscriptions sharing the messages read them from the ring, which holds as many messages
+   * as the depth of the QoS, instead of each storing them in its buffer, so that publishing
+   * costs the same whatever the number of subscriptions, except for waking them.
+   * A subscription keeps at most as many unread messages as the smaller of the depths of the
+   * publisher and of its own QoS, the older ones being dropped as from a full buffer.
+   * Its message filter and its minimum message period are applied when it reads the messages.
+   * The subscriptions taking the ownership of the messages, storing a type adapted type or
+   * dispatching the messages directly are provided the messages, as without a ring.
+   *
+   * \sa rclcpp::experimental::PublisherIntraProcessRing
+   */
+  bool use_intra_process_ring = false;
+
+  /// True to convert the messages of a TypeAdapter into a ROS message reused by each thread.
+  /**
+   * The messages of the custom type published inter process only are converted into the same
+   * ROS message of the publishing thread, shared by the publishers of the same type, instead of
+   * a new one, so that its buffers, e.g. the data of an image, are not allocated again.
+   * The TypeAdapter must then set all the fields of the ROS message, e.g. assign the sequences
+   * instead of appending to them, since it gets the message of the previous conversion.
+   * Each thread keeps the largest converted message until it exits.
+   */
+  bool reuse_converted_ros_message = false;
+
+  /// Optional codec compressing the messages published inter process, nullptr by default.
+  /**
+   * Only used by rclcpp::GenericPublisher.
+   * The subscriptions of the topic must use a codec of the same name to decode the messages.
+   *
+   * \sa rclcpp::SerializedMessageCodec
+   */
+  std::shared_ptr<rclcpp::SerializedMessageCodec> serialized_message_codec = nullptr;
+
+  /// Options of the topic statistics of the publisher, see PublisherTopicStatistics.
+  struct TopicStatisticsOptions
+  {
+    // Enable and disable topic statistics calculation and publication. Defaults to disabled,
+    // so that the publishers of a node with topic statistics enabled are not measured unless
+    // requested.
+    TopicStatisticsState state = TopicStatisticsState::Disable;
+
+    // Topic to which topic statistics get published when enabled. Defaults to /statistics.
+    std::string publish_topic = "/statistics";
+
+    // Topic statistics publication period in ms. Defaults to one second.
+    // Only values greater than zero are allowed.
+    std::chrono::milliseconds publish_period{std::chrono::seconds(1)};
+  };
+
+  TopicStatisticsOptions topic_stats_options;
 };
 
 /// Structure containing optional configuration for Publishers.
@@ -15,23 +15,36 @@
 #ifndef RCLCPP__QOS_EVENT_HPP_
 #define RCLCPP__QOS_EVENT_HPP_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "rcl/error_handling.h"
+#include "rcl/event_callback.h"
+#include "rcl/node.h"
 #include "rmw/incompatible_qos_events_statuses.h"
 
 #include "rcutils/logging_macros.h"
 
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/function_traits.hpp"
+#include "rclcpp/guard_condition.hpp"
+#include "rclcpp/macros.hpp"
 #include "rclcpp/waitable.hpp"
 
 namespace rclcpp
 {
 
+namespace graph_listener
+{
+class GraphListener;
+}  // namespace graph_listener
+
 using QOSDeadlineRequestedInfo = rmw_requested_deadline_missed_status_t;
 using QOSDeadlineOfferedInfo = rmw_offered_deadline_missed_status_t;
 using QOSLivelinessChangedInfo = rmw_liveliness_changed_status_t;
@@ -40,6 +53,19 @@ using QOSMessageLostInfo = rmw_message_lost_status_t;
 using QOSOfferedIncompatibleQoSInfo = rmw_offered_qos_incompatible_event_status_t;
 using QOSRequestedIncompatibleQoSInfo = rmw_requested_qos_incompatible_event_status_t;
 
+/// Matching status of a publisher or of a subscription, see MatchedEventHandler.
+struct MatchedInfo
+{
+  /// Number of endpoints matched so far, including the ones which are not matched anymore.
+  size_t total_count;
+  /// Change of total_count since the last time the callback was called.
+  size_t total_count_change;
+  /// Number of currently matched endpoints.
+  size_t current_count;
+  /// Change of current_count since the last time the callback was called.
+  int32_t current_count_change;
+};
+
 using QOSDeadlineRequestedCallbackType = std::function<void (QOSDeadlineRequestedInfo &)>;
 using QOSDeadlineOfferedCallbackType = std::function<void (QOSDeadlineOfferedInfo &)>;
 using QOSLivelinessChangedCallbackType = std::function<void (QOSLivelinessChangedInfo &)>;
@@ -48,6 +74,7 @@ using QOSMessageLostCallbackType = std::function<void (QOSMessageLostInfo &)>;
 using QOSOfferedIncompatibleQoSCallbackType = std::function<void (QOSOfferedIncompatibleQoSInfo &)>;
 using QOSRequestedIncompatibleQoSCallbackType =
   std::function<void (QOSRequestedIncompatibleQoSInfo &)>;
+using QOSMatchedCallbackType = std::function<void (MatchedInfo &)>;
 
 /// Contains callbacks for various types of events a Publisher can receive from the middleware.
 struct PublisherEventCallbacks
@@ -55,6 +82,8 @@ struct PublisherEventCallbacks
   QOSDeadlineOfferedCallbackType deadline_callback;
   QOSLivelinessLostCallbackType liveliness_callback;
   QOSOfferedIncompatibleQoSCallbackType incompatible_qos_callback;
+  /// Called when the number of subscriptions matched by the publisher changed.
+  QOSMatchedCallbackType matched_callback;
 };
 
 /// Contains callbacks for non-message events that a Subscription can receive from the middleware.
@@ -64,6 +93,8 @@ struct SubscriptionEventCallbacks
   QOSLivelinessChangedCallbackType liveliness_callback;
   QOSRequestedIncompatibleQoSCallbackType incompatible_qos_callback;
   QOSMessageLostCallbackType message_lost_callback;
+  /// Called when the number of publishers matched by the subscription changed.
+  QOSMatchedCallbackType matched_callback;
 };
 
 class UnsupportedEventTypeException : public exceptions::RCLErrorBase, public std::runtime_error
@@ -102,9 +133,43 @@ public:
   bool
   is_ready(rcl_wait_set_t * wait_set) override;
 
+  /// Set a callback to be called when each new event instance occurs.
+  /**
+   * The callback receives a size_t which is the number of events that occurred
+   * since the last time this callback was called, and 0 as identifier.
+   * Normally the number is 1, but can be > 1 if events occurred before any
+   * callback was set.
+   *
+   * Since this callback is called from the middleware, you should aim to make
+   * it fast and not blocking.
+   *
+   * Calling it again will clear any previously set callback.
+   *
+   * \sa rmw_event_set_callback
+   * \sa rcl_event_set_callback
+   *
+   * \param[in] callback functor to be called when a new event occurs
+   * \throws std::invalid_argument if the callback is empty
+   */
+  RCLCPP_PUBLIC
+  void
+  set_on_ready_callback(std::function<void(size_t, int)> callback) override;
+
+  /// Unset the callback registered for new events, if any.
+  RCLCPP_PUBLIC
+  void
+  clear_on_ready_callback() override;
+
 protected:
-  rcl_event_t event_handle_;
+  RCLCPP_PUBLIC
+  void
+  set_on_new_event_callback(rcl_event_callback_t callback, const void * user_data);
+
+  rcl_event_t event_handle_ = rcl_get_zero_initialized_event();
   size_t wait_set_event_index_;
+
+  std::recursive_mutex callback_mutex_;
+  std::function<void(size_t)> on_new_event_callback_{nullptr};
 };
 
 template<typename EventCallbackT, typename ParentHandleT>
@@ -168,6 +233,169 @@ private:
   EventCallbackT event_callback_;
 };
 
+/// Handler of the changes of the number of endpoints matched by a publisher or a subscription.
+/**
+ * The middleware does not report matched events, so the handler counts the subscriptions of
+ * the topic of a publisher, or the publishers of the topic of a subscription, from the
+ * GraphListener thread of the context after each graph change.
+ * The callback is then executed once for all the changes counted since its last call, without
+ * graph queries from the executor.
+ * Endpoints with incompatible QoS are counted as matched.
+ */
+class MatchedEventHandler : public QOSEventHandlerBase
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(MatchedEventHandler)
+
+  /// Function counting the endpoints of a topic, rcl_count_publishers() or rcl_count_subscribers().
+  using CountFunction = rcl_ret_t (*)(const rcl_node_t *, const char *, size_t *);
+
+  /**
+   * \param[in] callback called when the number of matched endpoints changed
+   * \param[in] context of the node, whose GraphListener counts the endpoints
+   * \param[in] node_handle rcl node of the publisher or of the subscription
+   * \param[in] topic_name fully qualified name of the topic
+   * \param[in] count_function counting the endpoints matched on the topic
+   * \throws rclcpp::graph_listener::GraphListenerShutdownError if the GraphListener is shutdown
+   */
+  RCLCPP_PUBLIC
+  MatchedEventHandler(
+    const QOSMatchedCallbackType & callback,
+    rclcpp::Context::SharedPtr context,
+    std::shared_ptr<rcl_node_t> node_handle,
+    const std::string & topic_name,
+    CountFunction count_function);
+
+  RCLCPP_PUBLIC
+  virtual ~MatchedEventHandler();
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_ready_events() override;
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_ready_guard_conditions() override;
+
+  RCLCPP_PUBLIC
+  bool
+  add_to_wait_set(rcl_wait_set_t * wait_set) override;
+
+  RCLCPP_PUBLIC
+  bool
+  is_ready(rcl_wait_set_t * wait_set) override;
+
+  /// Take the changes counted since the last call, or null if there are none.
+  RCLCPP_PUBLIC
+  std::shared_ptr<void>
+  take_data() override;
+
+  RCLCPP_PUBLIC
+  void
+  execute(std::shared_ptr<void> & data) override;
+
+  /// Set a callback called with 1 each time the matched endpoints change, and 0 as identifier.
+  RCLCPP_PUBLIC
+  void
+  set_on_ready_callback(std::function<void(size_t, int)> callback) override;
+
+  RCLCPP_PUBLIC
+  void
+  clear_on_ready_callback() override;
+
+private:
+  class Observer;
+
+  /// Count the matched endpoints, and signal a change.
+  void
+  update_matched_count();
+
+  QOSMatchedCallbackType callback_;
+  std::shared_ptr<rcl_node_t> node_handle_;
+  std::string topic_name_;
+  CountFunction count_function_;
+  std::shared_ptr<rclcpp::graph_listener::GraphListener> graph_listener_;
+  rclcpp::GuardCondition guard_condition_;
+  size_t wait_set_guard_condition_index_;
+
+  std::mutex status_mutex_;
+  MatchedInfo status_{0u, 0u, 0u, 0};
+  bool changed_{false};
+
+  std::function<void(size_t, int)> on_ready_callback_{nullptr};
+  std::unique_ptr<Observer> observer_;
+};
+
+/// Single waitable executing all the event handlers of a publisher or of a subscription.
+/**
+ * Executors then handle one waitable per publisher or subscription instead of one per event
+ * handler, checking which handlers are ready and executing them all at once.
+ * With the EventsExecutor, each event is taken and executed on its own.
+ */
+class QOSEventHandlerGroup : public Waitable
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(QOSEventHandlerGroup)
+
+  RCLCPP_PUBLIC
+  explicit QOSEventHandlerGroup(std::vector<std::shared_ptr<QOSEventHandlerBase>> handlers);
+
+  RCLCPP_PUBLIC
+  virtual ~QOSEventHandlerGroup();
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_ready_events() override;
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_ready_guard_conditions() override;
+
+  RCLCPP_PUBLIC
+  bool
+  add_to_wait_set(rcl_wait_set_t * wait_set) override;
+
+  /// Check which handlers are ready, returning true if any is.
+  RCLCPP_PUBLIC
+  bool
+  is_ready(rcl_wait_set_t * wait_set) override;
+
+  /// Take the data of the ready handlers, or of one handler reported by the on ready callback.
+  RCLCPP_PUBLIC
+  std::shared_ptr<void>
+  take_data() override;
+
+  /// Execute the handlers whose data was taken.
+  RCLCPP_PUBLIC
+  void
+  execute(std::shared_ptr<void> & data) override;
+
+  /// Set a callback called when any handler becomes ready, with the index of the handler.
+  RCLCPP_PUBLIC
+  void
+  set_on_ready_callback(std::function<void(size_t, int)> callback) override;
+
+  RCLCPP_PUBLIC
+  void
+  clear_on_ready_callback() override;
+
+  /// Get the grouped event handlers.
+  RCLCPP_PUBLIC
+  const std::vector<std::shared_ptr<QOSEventHandlerBase>> &
+  get_event_handlers() const;
+
+private:
+  using ReadyData = std::vector<std::pair<size_t, std::shared_ptr<void>>>;
+
+  std::vector<std::shared_ptr<QOSEventHandlerBase>> handlers_;
+
+  std::mutex ready_mutex_;
+  // Handlers found ready by is_ready().
+  std::vector<bool> ready_;
+  // Events reported by the on ready callbacks of each handler, and not taken yet.
+  std::vector<size_t> pending_events_;
+};
+
 }  // namespace rclcpp
 
 #endif  // RCLCPP__QOS_EVENT_HPP_
@@ -85,6 +85,10 @@ class QosParameters;
  *          reliability: reliable
  *          depth: 10
  * ```
+ *
+ * The parameters of an entity are declared in a single parameter event.
+ * To declare the parameters of many entities in one event, create them while holding a
+ * rclcpp::node_interfaces::ParameterEventBatch of the node.
  */
 class QosOverridingOptions
 {
@@ -19,7 +19,10 @@
 #include <memory>
 #include <thread>
 
+#include "rclcpp/clock.hpp"
+#include "rclcpp/duration.hpp"
 #include "rclcpp/macros.hpp"
+#include "rclcpp/time.hpp"
 #include "rclcpp/utilities.hpp"
 #include "rclcpp/visibility_control.hpp"
 
@@ -112,8 +115,79 @@ private:
   std::chrono::time_point<Clock, ClockDurationNano> last_interval_;
 };
 
-using Rate = GenericRate<std::chrono::system_clock>;
-using WallRate = GenericRate<std::chrono::steady_clock>;
+/// Rate sleeping on a rclcpp::Clock, which can use ROS time.
+/**
+ * The rate sleeps with rclcpp::Clock::sleep_until(), so with a clock of type `RCL_ROS_TIME`,
+ * e.g. the clock of a node using simulated time, it wakes up when the time source sets the time
+ * of the next interval instead of polling.
+ * The sleeps are interrupted by the shutdown of the global default context.
+ */
+class Rate : public RateBase
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(Rate)
+
+  /**
+   * \param[in] rate frequency of the rate, in Hz
+   * \param[in] clock clock to sleep on, by default the system time
+   */
+  RCLCPP_PUBLIC
+  explicit Rate(
+    double rate,
+    Clock::SharedPtr clock = std::make_shared<Clock>(RCL_SYSTEM_TIME));
+
+  /**
+   * \param[in] period period of the rate
+   * \param[in] clock clock to sleep on, by default the system time
+   */
+  RCLCPP_PUBLIC
+  explicit Rate(
+    const Duration & period,
+    Clock::SharedPtr clock = std::make_shared<Clock>(RCL_SYSTEM_TIME));
+
+  /// Sleep until the next interval.
+  /**
+   * \return false if the interval was already missed, or if the sleep was interrupted.
+   */
+  RCLCPP_PUBLIC
+  bool
+  sleep() override;
+
+  RCLCPP_PUBLIC
+  bool
+  is_steady() const override;
+
+  /// Return the type of the clock the rate sleeps on.
+  RCLCPP_PUBLIC
+  rcl_clock_type_t
+  get_type() const;
+
+  RCLCPP_PUBLIC
+  void
+  reset() override;
+
+  RCLCPP_PUBLIC
+  std::chrono::nanoseconds
+  period() const;
+
+private:
+  RCLCPP_DISABLE_COPY(Rate)
+
+  Clock::SharedPtr clock_;
+  Duration period_;
+  Time last_interval_;
+};
+
+/// Rate sleeping on the steady time.
+class WallRate : public Rate
+{
+public:
+  RCLCPP_PUBLIC
+  explicit WallRate(double rate);
+
+  RCLCPP_PUBLIC
+  explicit WallRate(const Duration & period);
+};
 
 }  // namespace rclcpp
 
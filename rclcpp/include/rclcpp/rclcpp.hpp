@@ -132,6 +132,7 @@
  *   - rclcpp/message_memory_strategy.hpp
  *   - rclcpp/strategies/allocator_memory_strategy.hpp
  *   - rclcpp/strategies/message_pool_memory_strategy.hpp
+ *   - rclcpp/strategies/reclaiming_message_pool_memory_strategy.hpp
  * - Context object which is shared amongst multiple Nodes:
  *   - rclcpp::Context
  *   - rclcpp/context.hpp
@@ -140,6 +141,7 @@
  *   - rclcpp/duration.hpp
  *   - rclcpp/function_traits.hpp
  *   - rclcpp/macros.hpp
+ *   - rclcpp/real_time_memory.hpp
  *   - rclcpp/time.hpp
  *   - rclcpp/utilities.hpp
  *   - rclcpp/typesupport_helpers.hpp
@@ -0,0 +1,82 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__REAL_TIME_MEMORY_HPP_
+#define RCLCPP__REAL_TIME_MEMORY_HPP_
+
+#include <cstddef>
+
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+
+/// Options of the memory setup of a real-time process, see InitOptions::real_time_memory().
+struct RealTimeMemoryOptions
+{
+  /// If true, all the current and future memory of the process is locked in RAM.
+  bool lock_memory = false;
+  /// Number of bytes of the stack of the calling thread to fault in, 0 to skip it.
+  size_t prefault_stack_size = 0u;
+  /// Number of bytes of the heap to fault in and keep in the process, 0 to skip it.
+  size_t prefault_heap_size = 0u;
+};
+
+/// Lock all the current and future memory of the process in RAM.
+/**
+ * Also configures the C allocator, if it is glibc, to never give memory back to the system nor
+ * to map separate blocks for large allocations, so that memory freed and allocated again stays
+ * locked and faulted in.
+ *
+ * Locking memory usually needs the CAP_IPC_LOCK capability, or a sufficient RLIMIT_MEMLOCK.
+ *
+ * \throws std::system_error if the memory could not be locked
+ * \throws std::runtime_error if locking memory is not supported on this platform
+ */
+RCLCPP_PUBLIC
+void
+lock_memory();
+
+/// Fault in the given number of bytes of the stack of the calling thread.
+/**
+ * Once the memory is locked, this ensures the stack does not page fault up to that depth.
+ *
+ * \param[in] size number of bytes of the stack to fault in
+ */
+RCLCPP_PUBLIC
+void
+prefault_stack(size_t size);
+
+/// Fault in the given number of bytes of the heap, and keep them in the process.
+/**
+ * The memory is allocated, touched and freed again, so it should be called after lock_memory(),
+ * which keeps freed memory in the process.
+ *
+ * \param[in] size number of bytes of the heap to fault in
+ */
+RCLCPP_PUBLIC
+void
+prefault_heap(size_t size);
+
+/// Apply the given options, locking the memory first if requested.
+/**
+ * \throws anything lock_memory() can throw
+ */
+RCLCPP_PUBLIC
+void
+prepare_memory_for_real_time(const RealTimeMemoryOptions & options);
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__REAL_TIME_MEMORY_HPP_
@@ -15,6 +15,8 @@
 #ifndef RCLCPP__SERIALIZATION_HPP_
 #define RCLCPP__SERIALIZATION_HPP_
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -60,12 +62,39 @@ public:
 
   /// Serialize a ROS2 message to a serialized stream
   /**
+   * The buffer of the serialized message is only grown when it is too small, so reusing the same
+   * serialized message for each message does not allocate once it fits the largest message.
+   *
    * \param[in] ros_message The ROS2 message which is read and serialized by rmw.
    * \param[out] serialized_message The serialized message.
    */
   void serialize_message(
     const void * ros_message, SerializedMessage * serialized_message) const;
 
+  /// Serialize a ROS2 message to a buffer owned by the calling thread
+  /**
+   * The same buffer is used by all the serializations done on the calling thread and keeps the
+   * largest capacity which was needed, so that no memory is allocated after warm-up.
+   *
+   * \param[in] ros_message The ROS2 message which is read and serialized by rmw.
+   * \return The serialized message, valid until the next call of this function on the calling
+   *   thread.
+   */
+  const SerializedMessage & serialize_message(const void * ros_message) const;
+
+  /// Serialize a ROS2 message to a buffer provided by the caller
+  /**
+   * The buffer is never reallocated, serializing a message larger than the buffer fails.
+   *
+   * \param[in] ros_message The ROS2 message which is read and serialized by rmw.
+   * \param[out] buffer The buffer the serialized message is written to.
+   * \param[in] buffer_capacity The size of the buffer.
+   * \return The size of the serialized message.
+   * \throws rclcpp::exceptions::RCLErrorBase if the serialized message does not fit the buffer.
+   */
+  size_t serialize_into(
+    const void * ros_message, uint8_t * buffer, size_t buffer_capacity) const;
+
   /// Deserialize a serialized stream to a ROS message
   /**
    * \param[in] serialized_message The serialized message to be converted to ROS2 by rmw.
@@ -0,0 +1,192 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__SERIALIZED_FIELD_ACCESSOR_HPP_
+#define RCLCPP__SERIALIZED_FIELD_ACCESSOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rcpputils/shared_library.hpp"
+#include "rosidl_runtime_cpp/message_type_support_decl.hpp"
+
+#include "rclcpp/serialized_message.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+
+/// Reads a field of serialized messages, without deserializing them.
+/**
+ * The position of the field in the CDR buffer of the messages is resolved once, from the
+ * introspection type support of their type, into the steps skipping the fields before it.
+ * The fields of fixed size at the beginning of the messages are skipped at once, so reading
+ * e.g. the `header.stamp` of a message costs the same whatever the size of the message.
+ * The strings and sequences before the field are skipped by reading their length.
+ *
+ * Only the primitive and string fields can be read, which may be nested in messages but not
+ * in arrays or sequences, e.g. "header.stamp.sec" or "header.frame_id".
+ * Wide characters, wide strings and long doubles are not supported, neither as the field nor
+ * before it.
+ *
+ * An accessor is not modified once constructed, so it can be used by several threads.
+ */
+class SerializedFieldAccessor
+{
+public:
+  /// Constructor.
+  /**
+   * \param[in] type_support the type support of the messages, either the one of
+   *   rosidl_typesupport_introspection_cpp or one providing it, as the one of
+   *   rosidl_typesupport_cpp does.
+   * \param[in] field_name the name of the field, after the names of the messages containing it,
+   *   separated by dots.
+   * \throws std::invalid_argument if the type support provides no introspection information,
+   *   or if the field does not exist or is not supported.
+   */
+  RCLCPP_PUBLIC
+  SerializedFieldAccessor(
+    const rosidl_message_type_support_t * type_support,
+    const std::string & field_name);
+
+  /// Constructor, for the messages of a type known by name, e.g. by a GenericSubscription.
+  /**
+   * \param[in] type the type of the messages, e.g. "std_msgs/msg/Header".
+   * \param[in] field_name the name of the field, see the other constructor.
+   * \throws std::runtime_error if the introspection type support cannot be loaded.
+   * \throws std::invalid_argument if the field does not exist or is not supported.
+   */
+  RCLCPP_PUBLIC
+  SerializedFieldAccessor(const std::string & type, const std::string & field_name);
+
+  /// Read the field of a serialized message.
+  /**
+   * \tparam T the type of the field, either bool, a fixed width integer type, float, double or
+   *   std::string, with uint8_t for the char and byte fields.
+   * \param[in] message the message, of the type of the accessor.
+   * \return the value of the field.
+   * \throws std::invalid_argument if T is not the type of the field.
+   * \throws std::runtime_error if the message is not CDR encoded or is truncated.
+   */
+  template<typename T>
+  T
+  get(const rclcpp::SerializedMessage & message) const
+  {
+    T value{};
+    read(message, value);
+    return value;
+  }
+
+private:
+  /// Step of the position of the field, from the beginning of the message.
+  struct Step
+  {
+    enum class Kind : uint8_t
+    {
+      /// Go to a fixed position.
+      Seek,
+      /// Skip `count` primitives.
+      SkipPrimitives,
+      /// Skip a sequence of primitives.
+      SkipPrimitiveSequence,
+      /// Skip `count` strings.
+      SkipStrings,
+      /// Skip a sequence of strings.
+      SkipStringSequence,
+      /// Skip `count` messages, with the steps of `steps_index`.
+      SkipMessages,
+      /// Skip a sequence of messages, with the steps of `steps_index`.
+      SkipMessageSequence,
+    };
+
+    Kind kind;
+    size_t size;
+    size_t count;
+    size_t steps_index;
+  };
+
+  class Reader;
+  class Resolver;
+
+  void
+  resolve(const rosidl_message_type_support_t * type_support, const std::string & field_name);
+
+  void
+  skip(Reader & reader, const std::vector<Step> & steps) const;
+
+  template<typename T>
+  void
+  read_primitive(const rclcpp::SerializedMessage & message, bool type_matches, T & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, bool & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, uint8_t & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, int8_t & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, uint16_t & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, int16_t & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, uint32_t & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, int32_t & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, uint64_t & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, int64_t & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, float & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, double & value) const;
+
+  RCLCPP_PUBLIC
+  void
+  read(const rclcpp::SerializedMessage & message, std::string & value) const;
+
+  /// The introspection type support library, when loaded by the accessor.
+  std::shared_ptr<rcpputils::SharedLibrary> library_;
+  /// The steps to the field, and the steps to skip the messages of the arrays and sequences.
+  std::vector<std::vector<Step>> steps_;
+  uint8_t field_type_id_;
+};
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__SERIALIZED_FIELD_ACCESSOR_HPP_
@@ -15,6 +15,9 @@
 #ifndef RCLCPP__SERIALIZED_MESSAGE_HPP_
 #define RCLCPP__SERIALIZED_MESSAGE_HPP_
 
+#include <cstdint>
+#include <functional>
+
 #include "rcl/allocator.h"
 #include "rcl/types.h"
 
@@ -27,6 +30,9 @@ namespace rclcpp
 class RCLCPP_PUBLIC_TYPE SerializedMessage
 {
 public:
+  /// Called with an external buffer and its length once the message no longer uses it.
+  using ExternalBufferDeleter = std::function<void (const uint8_t *, size_t)>;
+
   /// Default constructor for a SerializedMessage
   /**
    * Default constructs a serialized message and initalizes it
@@ -51,6 +57,27 @@ public:
     size_t initial_capacity,
     const rcl_allocator_t & allocator = rcl_get_default_allocator());
 
+  /// Constructor for a SerializedMessage adopting an external buffer, without copying it
+  /**
+   * The message uses the buffer in place, e.g. a memory mapped recording, until it is
+   * destroyed, at which point the deleter is called with the buffer.
+   * The buffer must not be modified through the message: it is copied into memory allocated
+   * with the allocator first if the message needs to own it, see reserve() and
+   * release_rcl_serialized_message().
+   * Copies of the message own a copy of the buffer.
+   *
+   * \param[in] buffer The serialized data, which must stay valid until the deleter is called.
+   * \param[in] length The length of the serialized data, which is also the capacity.
+   * \param[in] deleter Called once the buffer is no longer used, or nullptr if the caller
+   *   keeps the buffer alive for the lifetime of the message.
+   * \param[in] allocator The allocator to be used if the buffer is copied.
+   */
+  SerializedMessage(
+    const uint8_t * buffer,
+    size_t length,
+    ExternalBufferDeleter deleter,
+    const rcl_allocator_t & allocator = rcl_get_default_allocator());
+
   /// Copy Constructor for a SerializedMessage
   SerializedMessage(const SerializedMessage & other);
 
@@ -98,10 +125,14 @@ public:
    */
   size_t capacity() const;
 
+  /// Return true if the data buffer is an external buffer adopted by the message
+  bool uses_external_buffer() const;
+
   /// Allocate memory in the data buffer
   /**
    * The data buffer of the underlying rcl_serialized_message_t will be resized.
    * This might change the data layout and invalidates all pointers to the data.
+   * An external buffer is copied into memory allocated with the allocator first.
    */
   void reserve(size_t capacity);
 
@@ -109,11 +140,20 @@ public:
   /**
    * The memory (i.e. the data buffer) of the serialized message will no longer
    * be managed by this instance and the memory won't be deallocated on destruction.
+   * An external buffer is copied first, so that the returned buffer can always be
+   * deallocated with its allocator.
    */
   rcl_serialized_message_t release_rcl_serialized_message();
 
 private:
+  /// Copy the external buffer into memory allocated with the allocator, and release it.
+  void copy_external_buffer();
+
+  /// Give the external buffer back to its deleter, leaving the message zero initialized.
+  void release_external_buffer();
+
   rcl_serialized_message_t serialized_message_;
+  ExternalBufferDeleter external_buffer_deleter_;
 };
 
 }  // namespace rclcpp
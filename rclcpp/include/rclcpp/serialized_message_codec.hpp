@@ -0,0 +1,128 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__SERIALIZED_MESSAGE_CODEC_HPP_
+#define RCLCPP__SERIALIZED_MESSAGE_CODEC_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+
+/// Compression of the serialized messages of a topic, e.g. with LZ4 or zstd and a dictionary.
+/**
+ * A codec is given to rclcpp::GenericPublisher and rclcpp::GenericSubscription through the
+ * `serialized_message_codec` of their options, to compress the messages published inter
+ * process, e.g. over a constrained link.
+ * The messages published intra process are not compressed.
+ *
+ * Each encoded message starts with a header naming its codec and giving its decoded size.
+ * A subscription with a codec receives the messages of the publishers without a codec as they
+ * are, since a CDR serialized message starts with a zero byte, unlike the header, and throws
+ * away the messages of another codec.
+ * A subscription without a codec can not decode the messages of a publisher with one, so all
+ * the subscriptions of a compressed topic must opt in.
+ *
+ * rclcpp does not provide compression algorithms, the derived classes implement them with the
+ * library of their choice.
+ * They may be called concurrently, from each thread publishing or executing a subscription.
+ */
+class SerializedMessageCodec
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(SerializedMessageCodec)
+
+  /// Constructor.
+  /**
+   * \param[in] name name of the codec, written in each encoded message, e.g. "lz4".
+   * \throws std::invalid_argument if the name is empty or longer than 255 characters.
+   */
+  RCLCPP_PUBLIC
+  explicit SerializedMessageCodec(const std::string & name);
+
+  RCLCPP_PUBLIC
+  virtual ~SerializedMessageCodec();
+
+  /// Get the name of the codec.
+  RCLCPP_PUBLIC
+  const std::string &
+  get_name() const;
+
+  /// Encode a message.
+  /**
+   * A message that the codec does not make smaller is returned as it is, without the header.
+   *
+   * \param[in] message the serialized message to encode.
+   * \return the encoded message.
+   * \throws std::runtime_error if the compression fails.
+   */
+  RCLCPP_PUBLIC
+  rclcpp::SerializedMessage
+  encode(const rclcpp::SerializedMessage & message);
+
+  /// Decode a message encoded by a codec of the same name.
+  /**
+   * \param[in] message the encoded message.
+   * \param[out] decoded_message the decoded message, resized as needed.
+   * \throws std::runtime_error if the message was encoded by another codec, or is corrupted.
+   */
+  RCLCPP_PUBLIC
+  void
+  decode(const rclcpp::SerializedMessage & message, rclcpp::SerializedMessage & decoded_message);
+
+  /// Return true if the message was encoded by a codec, of any name.
+  RCLCPP_PUBLIC
+  static bool
+  is_encoded(const rclcpp::SerializedMessage & message);
+
+protected:
+  /// Return the largest size of the compressed data of the given size.
+  virtual size_t
+  max_compressed_size(size_t size) const = 0;
+
+  /// Compress data.
+  /**
+   * \param[in] data the data to compress.
+   * \param[in] size the size of the data.
+   * \param[out] compressed the buffer of the compressed data.
+   * \param[in] capacity the size of the buffer, at least max_compressed_size(size).
+   * \return the size of the compressed data, or 0 if the compression failed.
+   */
+  virtual size_t
+  compress(const uint8_t * data, size_t size, uint8_t * compressed, size_t capacity) = 0;
+
+  /// Decompress data.
+  /**
+   * \param[in] compressed the compressed data.
+   * \param[in] compressed_size the size of the compressed data.
+   * \param[out] data the buffer of the decompressed data.
+   * \param[in] size the size of the data before its compression, as given to compress().
+   * \return false if the data is corrupted.
+   */
+  virtual bool
+  decompress(const uint8_t * compressed, size_t compressed_size, uint8_t * data, size_t size) = 0;
+
+private:
+  const std::string name_;
+};
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__SERIALIZED_MESSAGE_CODEC_HPP_
@@ -19,14 +19,21 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 
 #include "rcl/error_handling.h"
+#include "rcl/event_callback.h"
 #include "rcl/service.h"
 
 #include "rclcpp/any_service_callback.hpp"
+#include "rclcpp/context.hpp"
+#include "rclcpp/detail/fast_exit.hpp"
+#include "rclcpp/detail/service_message_pool.hpp"
 #include "rclcpp/exceptions.hpp"
+#include "rclcpp/experimental/service_intra_process.hpp"
+#include "rclcpp/experimental/service_intra_process_base.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/type_support_decl.hpp"
 #include "rclcpp/expand_topic_or_service_name.hpp"
@@ -39,6 +46,11 @@
 namespace rclcpp
 {
 
+namespace experimental
+{
+class IntraProcessManager;
+}  // namespace experimental
+
 class ServiceBase
 {
 public:
@@ -121,9 +133,61 @@ public:
   bool
   exchange_in_use_by_wait_set_state(bool in_use_state);
 
+  /// Set a callback to be called when each new request is received.
+  /**
+   * The callback receives a size_t which is the number of requests received
+   * since the last time this callback was called.
+   * Normally this is 1, but can be > 1 if requests were received before any
+   * callback was set.
+   *
+   * Since this callback is called from the middleware, you should aim to make
+   * it fast and not blocking.
+   * If you need to do a lot of work or wait for some other event, you should
+   * spin it off to another thread, otherwise you risk blocking the middleware.
+   *
+   * Calling it again will clear any previously set callback.
+   *
+   * This function is thread-safe.
+   *
+   * \sa rmw_service_set_on_new_request_callback
+   * \sa rcl_service_set_on_new_request_callback
+   *
+   * \param[in] callback functor to be called when a new request is received
+   * \throws std::invalid_argument if the callback is empty
+   */
+  RCLCPP_PUBLIC
+  void
+  set_on_new_request_callback(std::function<void(size_t)> callback);
+
+  /// Unset the callback registered for new requests, if any.
+  RCLCPP_PUBLIC
+  void
+  clear_on_new_request_callback();
+
+  /// Return the waitable executing the requests sent intra process, if enabled.
+  /**
+   * It must be added to the callback group of the service.
+   *
+   * \return the waitable, or nullptr if intra process communication is disabled.
+   */
+  RCLCPP_PUBLIC
+  rclcpp::Waitable::SharedPtr
+  get_intra_process_waitable() const;
+
 protected:
   RCLCPP_DISABLE_COPY(ServiceBase)
 
+  /// Register the waitable receiving the intra process requests with the intra process manager.
+  RCLCPP_PUBLIC
+  void
+  setup_intra_process(
+    rclcpp::experimental::ServiceIntraProcessBase::SharedPtr intra_process_service,
+    rclcpp::Context::SharedPtr context);
+
+  RCLCPP_PUBLIC
+  void
+  set_on_new_request_callback(rcl_event_callback_t callback, const void * user_data);
+
   RCLCPP_PUBLIC
   rcl_node_t *
   get_rcl_node_handle();
@@ -138,6 +202,13 @@ protected:
   bool owns_rcl_handle_ = true;
 
   std::atomic<bool> in_use_by_wait_set_{false};
+
+  std::recursive_mutex callback_mutex_;
+  std::function<void(size_t)> on_new_request_callback_{nullptr};
+
+  rclcpp::experimental::ServiceIntraProcessBase::SharedPtr intra_process_service_;
+  std::weak_ptr<rclcpp::experimental::IntraProcessManager> weak_ipm_;
+  uint64_t intra_process_service_id_ = 0;
 };
 
 template<typename ServiceT>
@@ -183,6 +254,10 @@ public:
     service_handle_ = std::shared_ptr<rcl_service_t>(
       new rcl_service_t, [handle = node_handle_, service_name](rcl_service_t * service)
       {
+        if (rclcpp::detail::skip_entity_finalization(handle.get())) {
+          delete service;
+          return;
+        }
         if (rcl_service_fini(service, handle.get()) != RCL_RET_OK) {
           RCLCPP_ERROR(
             rclcpp::get_node_logger(handle.get()).get_child("rclcpp"),
@@ -301,6 +376,35 @@ public:
   {
   }
 
+  /// Receive the requests of the clients of the same context intra process.
+  /**
+   * The requests and the responses are shared with the clients, without being serialized.
+   * It is called by rclcpp::create_service() when intra process communication is enabled for
+   * the node, before the service is added to its callback group.
+   *
+   * \param[in] context the context of the service, whose intra process manager is used.
+   */
+  void
+  setup_intra_process(rclcpp::Context::SharedPtr context)
+  {
+    std::weak_ptr<Service<ServiceT>> weak_this = this->shared_from_this();
+    auto intra_process_service =
+      std::make_shared<rclcpp::experimental::ServiceIntraProcess<ServiceT>>(
+      context,
+      this->get_service_name(),
+      [weak_this](
+        std::shared_ptr<rmw_request_id_t> request_header,
+        std::shared_ptr<typename ServiceT::Request> request)
+      {
+        auto shared_this = weak_this.lock();
+        if (shared_this) {
+          shared_this->handle_intra_process_request(
+            std::move(request_header), std::move(request));
+        }
+      });
+    ServiceBase::setup_intra_process(std::move(intra_process_service), std::move(context));
+  }
+
   /// Take the next request from the service.
   /**
    * \sa ServiceBase::take_type_erased_request().
@@ -322,9 +426,52 @@ public:
   std::shared_ptr<void>
   create_request() override
   {
+    auto request_pool = std::atomic_load(&request_pool_);
+    if (request_pool) {
+      return request_pool->acquire();
+    }
     return std::make_shared<typename ServiceT::Request>();
   }
 
+  /// Reuse the requests and the responses of the service, instead of allocating them.
+  /**
+   * The requests are taken into, and the responses of the non deferred callbacks are built in,
+   * messages of pools which keep up to capacity messages each, see
+   * rclcpp::detail::ServiceMessagePool.
+   * The middleware cannot loan service messages, so they are still copied when taken and sent,
+   * but services answering at a high rate with large messages avoid allocating them.
+   *
+   * It can be called at any time, the messages in use are given back to the previous pools.
+   *
+   * \param[in] capacity number of messages kept by each pool, 0 disables the pools.
+   */
+  void
+  set_message_pool_capacity(size_t capacity)
+  {
+    std::shared_ptr<RequestPool> request_pool;
+    std::shared_ptr<ResponsePool> response_pool;
+    if (capacity > 0) {
+      request_pool = RequestPool::make_shared(capacity);
+      response_pool = ResponsePool::make_shared(capacity);
+    }
+    std::atomic_store(&request_pool_, std::move(request_pool));
+    std::atomic_store(&response_pool_, std::move(response_pool));
+  }
+
+  /// Return a response to be given to send_response(), e.g. by a deferred response callback.
+  /**
+   * It is taken from the pool of the service, if set_message_pool_capacity() enabled it.
+   */
+  std::shared_ptr<typename ServiceT::Response>
+  borrow_response()
+  {
+    auto response_pool = std::atomic_load(&response_pool_);
+    if (response_pool) {
+      return response_pool->acquire();
+    }
+    return std::make_shared<typename ServiceT::Response>();
+  }
+
   std::shared_ptr<rmw_request_id_t>
   create_request_header() override
   {
@@ -337,15 +484,54 @@ public:
     std::shared_ptr<void> request) override
   {
     auto typed_request = std::static_pointer_cast<typename ServiceT::Request>(request);
-    auto response = any_callback_.dispatch(this->shared_from_this(), request_header, typed_request);
+    auto response_pool = std::atomic_load(&response_pool_);
+    auto response = any_callback_.dispatch(
+      this->shared_from_this(), request_header, typed_request, response_pool.get());
     if (response) {
       send_response(*request_header, *response);
     }
   }
 
+  /// Handle a request sent intra process, the response is given to the client as is.
+  void
+  handle_intra_process_request(
+    std::shared_ptr<rmw_request_id_t> request_header,
+    std::shared_ptr<typename ServiceT::Request> request)
+  {
+    auto response_pool = std::atomic_load(&response_pool_);
+    auto response = any_callback_.dispatch(
+      this->shared_from_this(), request_header, std::move(request), response_pool.get());
+    if (response) {
+      get_typed_intra_process_service()->send_response(
+        request_header->sequence_number, std::move(response));
+    }
+  }
+
+  /// Send the response to a request.
+  /**
+   * When the service was created with a deferred response callback, taking only the request
+   * header and the request, this is how the response is sent.
+   * It can be called from any thread, once the callback returned, so requests can be handled
+   * concurrently, e.g. by a pool of workers, while the service stays in a mutually exclusive
+   * callback group.
+   * Concurrent calls are serialized, as the underlying rcl_send_response() is not thread-safe.
+   *
+   * \param[in] req_id the header of the request, as passed to the callback
+   * \param[in] response the response to send
+   * \throws rclcpp::exceptions::RCLError based exceptions if the underlying
+   *   rcl calls fail.
+   */
   void
   send_response(rmw_request_id_t & req_id, typename ServiceT::Response & response)
   {
+    using ServiceIntraProcessT = rclcpp::experimental::ServiceIntraProcess<ServiceT>;
+    if (intra_process_service_ && ServiceIntraProcessT::is_intra_process_request(req_id)) {
+      // A deferred response to a request sent intra process, copied as it is not owned.
+      get_typed_intra_process_service()->send_response(
+        req_id.sequence_number, std::make_shared<typename ServiceT::Response>(response));
+      return;
+    }
+    std::lock_guard<std::mutex> lock(send_response_mutex_);
     rcl_ret_t ret = rcl_send_response(get_service_handle().get(), &req_id, &response);
 
     if (ret != RCL_RET_OK) {
@@ -356,7 +542,21 @@ public:
 private:
   RCLCPP_DISABLE_COPY(Service)
 
+  std::shared_ptr<rclcpp::experimental::ServiceIntraProcess<ServiceT>>
+  get_typed_intra_process_service() const
+  {
+    return std::static_pointer_cast<rclcpp::experimental::ServiceIntraProcess<ServiceT>>(
+      intra_process_service_);
+  }
+
+  using RequestPool = rclcpp::detail::ServiceMessagePool<typename ServiceT::Request>;
+  using ResponsePool = rclcpp::detail::ServiceMessagePool<typename ServiceT::Response>;
+
   AnyServiceCallback<ServiceT> any_callback_;
+  std::mutex send_response_mutex_;
+  // Accessed with the std::atomic_load/store overloads, null unless enabled.
+  std::shared_ptr<RequestPool> request_pool_;
+  std::shared_ptr<ResponsePool> response_pool_;
 };
 
 }  // namespace rclcpp
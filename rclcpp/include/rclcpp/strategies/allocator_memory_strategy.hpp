@@ -15,7 +15,15 @@
 #ifndef RCLCPP__STRATEGIES__ALLOCATOR_MEMORY_STRATEGY_HPP_
 #define RCLCPP__STRATEGIES__ALLOCATOR_MEMORY_STRATEGY_HPP_
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "rcl/allocator.h"
@@ -52,14 +60,12 @@ public:
   using VoidAlloc = typename VoidAllocTraits::allocator_type;
 
   explicit AllocatorMemoryStrategy(std::shared_ptr<Alloc> allocator)
-  {
-    allocator_ = std::make_shared<VoidAlloc>(*allocator.get());
-  }
+  : AllocatorMemoryStrategy(VoidAlloc(*allocator.get()))
+  {}
 
   AllocatorMemoryStrategy()
-  {
-    allocator_ = std::make_shared<VoidAlloc>();
-  }
+  : AllocatorMemoryStrategy(VoidAlloc())
+  {}
 
   void add_guard_condition(const rcl_guard_condition_t * guard_condition) override
   {
@@ -83,11 +89,8 @@ public:
 
   void clear_handles() override
   {
-    subscription_handles_.clear();
-    service_handles_.clear();
-    client_handles_.clear();
-    timer_handles_.clear();
-    waitable_handles_.clear();
+    clear_handles_to_wait_on();
+    clear_collected_entities();
   }
 
   void remove_null_handles(rcl_wait_set_t * wait_set) override
@@ -160,39 +163,182 @@ public:
         has_invalid_weak_groups_or_nodes = true;
         continue;
       }
-      if (!group || !group->can_be_taken_from().load()) {
-        continue;
-      }
+      // Entities of groups which are currently in use or disabled are remembered, but not
+      // waited on.
+      const bool wait_on_entities = group->can_be_taken_from().load() && group->is_enabled();
+      const rclcpp::CallbackGroup::WeakPtr & weak_group = pair.first;
+      // Taken first, an entity added during the collection makes the restore fail.
+      const uint64_t entities_version = group->get_entities_version();
       group->find_subscription_ptrs_if(
-        [this](const rclcpp::SubscriptionBase::SharedPtr & subscription) {
-          subscription_handles_.push_back(subscription->get_subscription_handle());
+        [this, wait_on_entities, &weak_group](
+          const rclcpp::SubscriptionBase::SharedPtr & subscription)
+        {
+          auto handle = subscription->get_subscription_handle();
+          subscription_index_[handle.get()] = {
+            subscription, weak_group, collected_subscription_handles_.size()};
+          collected_subscription_handles_.push_back(handle);
+          if (wait_on_entities) {
+            subscription_handles_.push_back(std::move(handle));
+          }
           return false;
         });
       group->find_service_ptrs_if(
-        [this](const rclcpp::ServiceBase::SharedPtr & service) {
-          service_handles_.push_back(service->get_service_handle());
+        [this, wait_on_entities, &weak_group](const rclcpp::ServiceBase::SharedPtr & service) {
+          auto handle = service->get_service_handle();
+          service_index_[handle.get()] = {
+            service, weak_group, collected_service_handles_.size()};
+          collected_service_handles_.push_back(handle);
+          if (wait_on_entities) {
+            service_handles_.push_back(std::move(handle));
+          }
           return false;
         });
       group->find_client_ptrs_if(
-        [this](const rclcpp::ClientBase::SharedPtr & client) {
-          client_handles_.push_back(client->get_client_handle());
+        [this, wait_on_entities, &weak_group](const rclcpp::ClientBase::SharedPtr & client) {
+          auto handle = client->get_client_handle();
+          client_index_[handle.get()] = {
+            client, weak_group, collected_client_handles_.size()};
+          collected_client_handles_.push_back(handle);
+          if (wait_on_entities) {
+            client_handles_.push_back(std::move(handle));
+          }
           return false;
         });
       group->find_timer_ptrs_if(
-        [this](const rclcpp::TimerBase::SharedPtr & timer) {
-          timer_handles_.push_back(timer->get_timer_handle());
+        [this, wait_on_entities, &weak_group](const rclcpp::TimerBase::SharedPtr & timer) {
+          auto handle = timer->get_timer_handle();
+          timer_index_[handle.get()] = {
+            timer, weak_group, collected_timer_handles_.size()};
+          collected_timer_handles_.push_back(handle);
+          if (wait_on_entities) {
+            timer_handles_.push_back(std::move(handle));
+          }
           return false;
         });
       group->find_waitable_ptrs_if(
-        [this](const rclcpp::Waitable::SharedPtr & waitable) {
-          waitable_handles_.push_back(waitable);
+        [this, wait_on_entities, &weak_group](const rclcpp::Waitable::SharedPtr & waitable) {
+          waitable_index_[waitable.get()] = {
+            waitable, weak_group, collected_waitable_handles_.size()};
+          collected_waitable_handles_.push_back(waitable);
+          if (wait_on_entities) {
+            waitable_handles_.push_back(waitable);
+          }
           return false;
         });
+      collected_groups_.push_back(
+        {pair.first, pair.second, entities_version,
+          collected_subscription_handles_.size(), collected_service_handles_.size(),
+          collected_client_handles_.size(), collected_timer_handles_.size(),
+          collected_waitable_handles_.size()});
     }
+    // Collections may be split over several calls, any invalid entry makes the result unusable.
+    collected_entities_invalid_ = collected_entities_invalid_ || has_invalid_weak_groups_or_nodes;
+    collected_entities_valid_ = !collected_entities_invalid_;
 
     return has_invalid_weak_groups_or_nodes;
   }
 
+  bool restore_collected_entities() override
+  {
+    if (!collected_entities_valid_) {
+      return false;
+    }
+    clear_handles_to_wait_on();
+    size_t subscriptions_begin = 0;
+    size_t services_begin = 0;
+    size_t clients_begin = 0;
+    size_t timers_begin = 0;
+    size_t waitables_begin = 0;
+    for (const auto & collected_group : collected_groups_) {
+      auto group = collected_group.group.lock();
+      if (group == nullptr || collected_group.node.expired()) {
+        // Let the caller do a full collection, which reports the invalid group or node.
+        clear_handles();
+        return false;
+      }
+      if (group->get_entities_version() != collected_group.entities_version) {
+        // Entities were added to or removed from the group since the last collection.
+        clear_handles();
+        return false;
+      }
+      if (group->can_be_taken_from().load() && group->is_enabled()) {
+        if (
+          !restore_handles(
+            collected_subscription_handles_, subscriptions_begin,
+            collected_group.subscriptions_end, subscription_handles_) ||
+          !restore_handles(
+            collected_service_handles_, services_begin,
+            collected_group.services_end, service_handles_) ||
+          !restore_handles(
+            collected_client_handles_, clients_begin,
+            collected_group.clients_end, client_handles_) ||
+          !restore_handles(
+            collected_timer_handles_, timers_begin,
+            collected_group.timers_end, timer_handles_) ||
+          !restore_handles(
+            collected_waitable_handles_, waitables_begin,
+            collected_group.waitables_end, waitable_handles_))
+        {
+          // An entity was destroyed since the last collection.
+          clear_handles();
+          return false;
+        }
+      }
+      subscriptions_begin = collected_group.subscriptions_end;
+      services_begin = collected_group.services_end;
+      clients_begin = collected_group.clients_end;
+      timers_begin = collected_group.timers_end;
+      waitables_begin = collected_group.waitables_end;
+    }
+    return true;
+  }
+
+  bool remove_collected_callback_group(const rclcpp::CallbackGroup::WeakPtr & group) override
+  {
+    if (!collected_entities_valid_) {
+      return false;
+    }
+    auto it = std::find_if(
+      collected_groups_.begin(), collected_groups_.end(),
+      [&group](const CollectedGroup & collected_group) {
+        return !collected_group.group.owner_before(group) &&
+        !group.owner_before(collected_group.group);
+      });
+    if (it == collected_groups_.end()) {
+      return false;
+    }
+    CollectedGroup previous_group{};
+    if (it != collected_groups_.begin()) {
+      previous_group = *(it - 1);
+    }
+    erase_collected_handles(
+      collected_subscription_handles_, subscription_index_,
+      previous_group.subscriptions_end, it->subscriptions_end);
+    erase_collected_handles(
+      collected_service_handles_, service_index_,
+      previous_group.services_end, it->services_end);
+    erase_collected_handles(
+      collected_client_handles_, client_index_,
+      previous_group.clients_end, it->clients_end);
+    erase_collected_handles(
+      collected_timer_handles_, timer_index_,
+      previous_group.timers_end, it->timers_end);
+    erase_collected_handles(
+      collected_waitable_handles_, waitable_index_,
+      previous_group.waitables_end, it->waitables_end);
+    // The ranges of the following groups move back by the number of entities dropped.
+    const CollectedGroup removed_group = *it;
+    for (auto next = it + 1; next != collected_groups_.end(); ++next) {
+      next->subscriptions_end -= removed_group.subscriptions_end - previous_group.subscriptions_end;
+      next->services_end -= removed_group.services_end - previous_group.services_end;
+      next->clients_end -= removed_group.clients_end - previous_group.clients_end;
+      next->timers_end -= removed_group.timers_end - previous_group.timers_end;
+      next->waitables_end -= removed_group.waitables_end - previous_group.waitables_end;
+    }
+    collected_groups_.erase(it);
+    return true;
+  }
+
   void add_waitable_handle(const rclcpp::Waitable::SharedPtr & waitable) override
   {
     if (nullptr == waitable) {
@@ -267,31 +413,41 @@ public:
   {
     auto it = subscription_handles_.begin();
     while (it != subscription_handles_.end()) {
-      auto subscription = get_subscription_by_handle(*it, weak_groups_to_nodes);
-      if (subscription) {
-        // Find the group for this handle and see if it can be serviced
-        auto group = get_group_by_subscription(subscription, weak_groups_to_nodes);
-        if (!group) {
-          // Group was not found, meaning the subscription is not valid...
-          // Remove it from the ready list and continue looking
-          it = subscription_handles_.erase(it);
-          continue;
-        }
-        if (!group->can_be_taken_from().load()) {
-          // Group is mutually exclusive and is being used, so skip it for now
-          // Leave it to be checked next time, but continue searching
-          ++it;
-          continue;
+      rclcpp::SubscriptionBase::SharedPtr subscription;
+      rclcpp::CallbackGroup::SharedPtr group;
+      if (
+        !find_indexed_entity(
+          subscription_index_, it->get(), weak_groups_to_nodes, subscription, group))
+      {
+        // The handle was not collected by this strategy, search the callback groups for it.
+        subscription = get_subscription_by_handle(*it, weak_groups_to_nodes);
+        if (subscription) {
+          group = get_group_by_subscription(subscription, weak_groups_to_nodes);
         }
-        // Otherwise it is safe to set and return the any_exec
-        any_exec.subscription = subscription;
-        any_exec.callback_group = group;
-        any_exec.node_base = get_node_by_group(group, weak_groups_to_nodes);
-        subscription_handles_.erase(it);
-        return;
       }
-      // Else, the subscription is no longer valid, remove it and continue
-      it = subscription_handles_.erase(it);
+      if (!subscription) {
+        // The subscription is no longer valid, remove it and continue
+        it = subscription_handles_.erase(it);
+        continue;
+      }
+      if (!group) {
+        // Group was not found, meaning the subscription is not valid...
+        // Remove it from the ready list and continue looking
+        it = subscription_handles_.erase(it);
+        continue;
+      }
+      if (!group->can_be_taken_from().load()) {
+        // Group is mutually exclusive and is being used, so skip it for now
+        // Leave it to be checked next time, but continue searching
+        ++it;
+        continue;
+      }
+      // Otherwise it is safe to set and return the any_exec
+      any_exec.subscription = subscription;
+      any_exec.callback_group = group;
+      any_exec.node_base = get_node_by_group(group, weak_groups_to_nodes);
+      subscription_handles_.erase(it);
+      return;
     }
   }
 
@@ -302,31 +458,38 @@ public:
   {
     auto it = service_handles_.begin();
     while (it != service_handles_.end()) {
-      auto service = get_service_by_handle(*it, weak_groups_to_nodes);
-      if (service) {
-        // Find the group for this handle and see if it can be serviced
-        auto group = get_group_by_service(service, weak_groups_to_nodes);
-        if (!group) {
-          // Group was not found, meaning the service is not valid...
-          // Remove it from the ready list and continue looking
-          it = service_handles_.erase(it);
-          continue;
+      rclcpp::ServiceBase::SharedPtr service;
+      rclcpp::CallbackGroup::SharedPtr group;
+      if (!find_indexed_entity(service_index_, it->get(), weak_groups_to_nodes, service, group)) {
+        // The handle was not collected by this strategy, search the callback groups for it.
+        service = get_service_by_handle(*it, weak_groups_to_nodes);
+        if (service) {
+          group = get_group_by_service(service, weak_groups_to_nodes);
         }
-        if (!group->can_be_taken_from().load()) {
-          // Group is mutually exclusive and is being used, so skip it for now
-          // Leave it to be checked next time, but continue searching
-          ++it;
-          continue;
-        }
-        // Otherwise it is safe to set and return the any_exec
-        any_exec.service = service;
-        any_exec.callback_group = group;
-        any_exec.node_base = get_node_by_group(group, weak_groups_to_nodes);
-        service_handles_.erase(it);
-        return;
       }
-      // Else, the service is no longer valid, remove it and continue
-      it = service_handles_.erase(it);
+      if (!service) {
+        // The service is no longer valid, remove it and continue
+        it = service_handles_.erase(it);
+        continue;
+      }
+      if (!group) {
+        // Group was not found, meaning the service is not valid...
+        // Remove it from the ready list and continue looking
+        it = service_handles_.erase(it);
+        continue;
+      }
+      if (!group->can_be_taken_from().load()) {
+        // Group is mutually exclusive and is being used, so skip it for now
+        // Leave it to be checked next time, but continue searching
+        ++it;
+        continue;
+      }
+      // Otherwise it is safe to set and return the any_exec
+      any_exec.service = service;
+      any_exec.callback_group = group;
+      any_exec.node_base = get_node_by_group(group, weak_groups_to_nodes);
+      service_handles_.erase(it);
+      return;
     }
   }
 
@@ -337,31 +500,38 @@ public:
   {
     auto it = client_handles_.begin();
     while (it != client_handles_.end()) {
-      auto client = get_client_by_handle(*it, weak_groups_to_nodes);
-      if (client) {
-        // Find the group for this handle and see if it can be serviced
-        auto group = get_group_by_client(client, weak_groups_to_nodes);
-        if (!group) {
-          // Group was not found, meaning the service is not valid...
-          // Remove it from the ready list and continue looking
-          it = client_handles_.erase(it);
-          continue;
+      rclcpp::ClientBase::SharedPtr client;
+      rclcpp::CallbackGroup::SharedPtr group;
+      if (!find_indexed_entity(client_index_, it->get(), weak_groups_to_nodes, client, group)) {
+        // The handle was not collected by this strategy, search the callback groups for it.
+        client = get_client_by_handle(*it, weak_groups_to_nodes);
+        if (client) {
+          group = get_group_by_client(client, weak_groups_to_nodes);
         }
-        if (!group->can_be_taken_from().load()) {
-          // Group is mutually exclusive and is being used, so skip it for now
-          // Leave it to be checked next time, but continue searching
-          ++it;
-          continue;
-        }
-        // Otherwise it is safe to set and return the any_exec
-        any_exec.client = client;
-        any_exec.callback_group = group;
-        any_exec.node_base = get_node_by_group(group, weak_groups_to_nodes);
-        client_handles_.erase(it);
-        return;
       }
-      // Else, the service is no longer valid, remove it and continue
-      it = client_handles_.erase(it);
+      if (!client) {
+        // The client is no longer valid, remove it and continue
+        it = client_handles_.erase(it);
+        continue;
+      }
+      if (!group) {
+        // Group was not found, meaning the client is not valid...
+        // Remove it from the ready list and continue looking
+        it = client_handles_.erase(it);
+        continue;
+      }
+      if (!group->can_be_taken_from().load()) {
+        // Group is mutually exclusive and is being used, so skip it for now
+        // Leave it to be checked next time, but continue searching
+        ++it;
+        continue;
+      }
+      // Otherwise it is safe to set and return the any_exec
+      any_exec.client = client;
+      any_exec.callback_group = group;
+      any_exec.node_base = get_node_by_group(group, weak_groups_to_nodes);
+      client_handles_.erase(it);
+      return;
     }
   }
 
@@ -372,36 +542,43 @@ public:
   {
     auto it = timer_handles_.begin();
     while (it != timer_handles_.end()) {
-      auto timer = get_timer_by_handle(*it, weak_groups_to_nodes);
-      if (timer) {
-        // Find the group for this handle and see if it can be serviced
-        auto group = get_group_by_timer(timer, weak_groups_to_nodes);
-        if (!group) {
-          // Group was not found, meaning the timer is not valid...
-          // Remove it from the ready list and continue looking
-          it = timer_handles_.erase(it);
-          continue;
-        }
-        if (!group->can_be_taken_from().load()) {
-          // Group is mutually exclusive and is being used, so skip it for now
-          // Leave it to be checked next time, but continue searching
-          ++it;
-          continue;
+      rclcpp::TimerBase::SharedPtr timer;
+      rclcpp::CallbackGroup::SharedPtr group;
+      if (!find_indexed_entity(timer_index_, it->get(), weak_groups_to_nodes, timer, group)) {
+        // The handle was not collected by this strategy, search the callback groups for it.
+        timer = get_timer_by_handle(*it, weak_groups_to_nodes);
+        if (timer) {
+          group = get_group_by_timer(timer, weak_groups_to_nodes);
         }
-        if (!timer->call()) {
-          // timer was cancelled, skip it.
-          ++it;
-          continue;
-        }
-        // Otherwise it is safe to set and return the any_exec
-        any_exec.timer = timer;
-        any_exec.callback_group = group;
-        any_exec.node_base = get_node_by_group(group, weak_groups_to_nodes);
-        timer_handles_.erase(it);
-        return;
       }
-      // Else, the timer is no longer valid, remove it and continue
-      it = timer_handles_.erase(it);
+      if (!timer) {
+        // The timer is no longer valid, remove it and continue
+        it = timer_handles_.erase(it);
+        continue;
+      }
+      if (!group) {
+        // Group was not found, meaning the timer is not valid...
+        // Remove it from the ready list and continue looking
+        it = timer_handles_.erase(it);
+        continue;
+      }
+      if (!group->can_be_taken_from().load()) {
+        // Group is mutually exclusive and is being used, so skip it for now
+        // Leave it to be checked next time, but continue searching
+        ++it;
+        continue;
+      }
+      if (!timer->call()) {
+        // timer was cancelled, skip it.
+        ++it;
+        continue;
+      }
+      // Otherwise it is safe to set and return the any_exec
+      any_exec.timer = timer;
+      any_exec.callback_group = group;
+      any_exec.node_base = get_node_by_group(group, weak_groups_to_nodes);
+      timer_handles_.erase(it);
+      return;
     }
   }
 
@@ -415,7 +592,14 @@ public:
       auto waitable = *it;
       if (waitable) {
         // Find the group for this handle and see if it can be serviced
-        auto group = get_group_by_waitable(waitable, weak_groups_to_nodes);
+        rclcpp::Waitable::SharedPtr indexed_waitable;
+        rclcpp::CallbackGroup::SharedPtr group;
+        if (
+          !find_indexed_entity(
+            waitable_index_, waitable.get(), weak_groups_to_nodes, indexed_waitable, group))
+        {
+          group = get_group_by_waitable(waitable, weak_groups_to_nodes);
+        }
         if (!group) {
           // Group was not found, meaning the waitable is not valid...
           // Remove it from the ready list and continue looking
@@ -440,6 +624,205 @@ public:
     }
   }
 
+  size_t
+  get_next_prioritized_executable(
+    rclcpp::AnyExecutable & any_exec,
+    const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes,
+    bool timers_by_deadline) override
+  {
+    // Rank every ready executable which could be taken now, invalid handles are left in place
+    // for the get_next_*() functions to remove.
+    PrioritizedSelection selection;
+    for (size_t i = 0; i < timer_handles_.size(); ++i) {
+      rclcpp::TimerBase::SharedPtr timer;
+      auto group = find_takeable_group(
+        timer_index_, timer_handles_[i], weak_groups_to_nodes, timer,
+        get_timer_by_handle, get_group_by_timer);
+      if (!group || timer->is_canceled()) {
+        continue;
+      }
+      auto deadline = std::chrono::nanoseconds::max();
+      if (timers_by_deadline) {
+        deadline = timer->time_until_trigger();
+      }
+      selection.consider(ExecutableKind::Timer, i, group->get_priority(), deadline);
+    }
+    for (size_t i = 0; i < subscription_handles_.size(); ++i) {
+      rclcpp::SubscriptionBase::SharedPtr subscription;
+      auto group = find_takeable_group(
+        subscription_index_, subscription_handles_[i], weak_groups_to_nodes, subscription,
+        get_subscription_by_handle, get_group_by_subscription);
+      if (group) {
+        selection.consider(ExecutableKind::Subscription, i, group->get_priority());
+      }
+    }
+    for (size_t i = 0; i < service_handles_.size(); ++i) {
+      rclcpp::ServiceBase::SharedPtr service;
+      auto group = find_takeable_group(
+        service_index_, service_handles_[i], weak_groups_to_nodes, service,
+        get_service_by_handle, get_group_by_service);
+      if (group) {
+        selection.consider(ExecutableKind::Service, i, group->get_priority());
+      }
+    }
+    for (size_t i = 0; i < client_handles_.size(); ++i) {
+      rclcpp::ClientBase::SharedPtr client;
+      auto group = find_takeable_group(
+        client_index_, client_handles_[i], weak_groups_to_nodes, client,
+        get_client_by_handle, get_group_by_client);
+      if (group) {
+        selection.consider(ExecutableKind::Client, i, group->get_priority());
+      }
+    }
+    for (size_t i = 0; i < waitable_handles_.size(); ++i) {
+      const auto & waitable = waitable_handles_[i];
+      if (!waitable) {
+        continue;
+      }
+      rclcpp::Waitable::SharedPtr indexed_waitable;
+      rclcpp::CallbackGroup::SharedPtr group;
+      if (
+        !find_indexed_entity(
+          waitable_index_, waitable.get(), weak_groups_to_nodes, indexed_waitable, group))
+      {
+        group = get_group_by_waitable(waitable, weak_groups_to_nodes);
+      }
+      if (group && group->can_be_taken_from().load()) {
+        selection.consider(ExecutableKind::Waitable, i, group->get_priority());
+      }
+    }
+    if (!selection.found) {
+      return 0;
+    }
+
+    // The selected handle is the first one the matching get_next_*() function can take.
+    switch (selection.kind) {
+      case ExecutableKind::Timer:
+        move_to_front(timer_handles_, selection.index);
+        get_next_timer(any_exec, weak_groups_to_nodes);
+        break;
+      case ExecutableKind::Subscription:
+        move_to_front(subscription_handles_, selection.index);
+        get_next_subscription(any_exec, weak_groups_to_nodes);
+        break;
+      case ExecutableKind::Service:
+        move_to_front(service_handles_, selection.index);
+        get_next_service(any_exec, weak_groups_to_nodes);
+        break;
+      case ExecutableKind::Client:
+        move_to_front(client_handles_, selection.index);
+        get_next_client(any_exec, weak_groups_to_nodes);
+        break;
+      case ExecutableKind::Waitable:
+        move_to_front(waitable_handles_, selection.index);
+        get_next_waitable(any_exec, weak_groups_to_nodes);
+        break;
+    }
+    return selection.number_eligible - selection.number_at_priority;
+  }
+
+  void
+  get_next_round_robin_executable(
+    rclcpp::AnyExecutable & any_exec,
+    const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes) override
+  {
+    // The handle whose turn it is is moved to the front, for the get_next_*() function.
+    if (
+      select_in_turn(
+        timer_handles_, timer_index_, timer_cursor_,
+        [&](const std::shared_ptr<const rcl_timer_t> & handle) {
+          rclcpp::TimerBase::SharedPtr timer;
+          return find_takeable_group(
+            timer_index_, handle, weak_groups_to_nodes, timer,
+            get_timer_by_handle, get_group_by_timer);
+        }))
+    {
+      get_next_timer(any_exec, weak_groups_to_nodes);
+      if (any_exec.timer) {
+        take_turn(timer_cursor_, timer_index_, any_exec.timer->get_timer_handle().get());
+        return;
+      }
+    }
+    if (
+      select_in_turn(
+        subscription_handles_, subscription_index_, subscription_cursor_,
+        [&](const std::shared_ptr<const rcl_subscription_t> & handle) {
+          rclcpp::SubscriptionBase::SharedPtr subscription;
+          return find_takeable_group(
+            subscription_index_, handle, weak_groups_to_nodes, subscription,
+            get_subscription_by_handle, get_group_by_subscription);
+        }))
+    {
+      get_next_subscription(any_exec, weak_groups_to_nodes);
+      if (any_exec.subscription) {
+        take_turn(
+          subscription_cursor_, subscription_index_,
+          any_exec.subscription->get_subscription_handle().get());
+        return;
+      }
+    }
+    if (
+      select_in_turn(
+        service_handles_, service_index_, service_cursor_,
+        [&](const std::shared_ptr<const rcl_service_t> & handle) {
+          rclcpp::ServiceBase::SharedPtr service;
+          return find_takeable_group(
+            service_index_, handle, weak_groups_to_nodes, service,
+            get_service_by_handle, get_group_by_service);
+        }))
+    {
+      get_next_service(any_exec, weak_groups_to_nodes);
+      if (any_exec.service) {
+        take_turn(service_cursor_, service_index_, any_exec.service->get_service_handle().get());
+        return;
+      }
+    }
+    if (
+      select_in_turn(
+        client_handles_, client_index_, client_cursor_,
+        [&](const std::shared_ptr<const rcl_client_t> & handle) {
+          rclcpp::ClientBase::SharedPtr client;
+          return find_takeable_group(
+            client_index_, handle, weak_groups_to_nodes, client,
+            get_client_by_handle, get_group_by_client);
+        }))
+    {
+      get_next_client(any_exec, weak_groups_to_nodes);
+      if (any_exec.client) {
+        take_turn(client_cursor_, client_index_, any_exec.client->get_client_handle().get());
+        return;
+      }
+    }
+    if (
+      select_in_turn(
+        waitable_handles_, waitable_index_, waitable_cursor_,
+        [&](const rclcpp::Waitable::SharedPtr & waitable) -> rclcpp::CallbackGroup::SharedPtr {
+          if (!waitable) {
+            return nullptr;
+          }
+          rclcpp::Waitable::SharedPtr indexed_waitable;
+          rclcpp::CallbackGroup::SharedPtr group;
+          if (
+            !find_indexed_entity(
+              waitable_index_, waitable.get(), weak_groups_to_nodes, indexed_waitable, group))
+          {
+            group = get_group_by_waitable(waitable, weak_groups_to_nodes);
+          }
+          if (!group || !group->can_be_taken_from().load()) {
+            return nullptr;
+          }
+          return group;
+        }))
+    {
+      get_next_waitable(any_exec, weak_groups_to_nodes);
+      if (any_exec.waitable) {
+        take_turn(waitable_cursor_, waitable_index_, any_exec.waitable.get());
+        return;
+      }
+    }
+    // Handles which were not takeable are left in place for the get_next_*() functions.
+  }
+
   rcl_allocator_t get_allocator() override
   {
     return rclcpp::allocator::get_rcl_allocator<void *, VoidAlloc>(*allocator_.get());
@@ -505,6 +888,29 @@ public:
   }
 
 private:
+  // All containers use the allocator, so that a stateful allocator, e.g. a polymorphic allocator
+  // of a memory resource, also backs the bookkeeping of the executor.
+  explicit AllocatorMemoryStrategy(const VoidAlloc & allocator)
+  : guard_conditions_(allocator),
+    subscription_handles_(allocator),
+    service_handles_(allocator),
+    client_handles_(allocator),
+    timer_handles_(allocator),
+    waitable_handles_(allocator),
+    collected_groups_(allocator),
+    collected_subscription_handles_(allocator),
+    collected_service_handles_(allocator),
+    collected_client_handles_(allocator),
+    collected_timer_handles_(allocator),
+    collected_waitable_handles_(allocator),
+    subscription_index_(allocator),
+    service_index_(allocator),
+    client_index_(allocator),
+    timer_index_(allocator),
+    waitable_index_(allocator),
+    allocator_(std::allocate_shared<VoidAlloc>(allocator, allocator))
+  {}
+
   template<typename T>
   using VectorRebind =
     std::vector<T, typename std::allocator_traits<Alloc>::template rebind_alloc<T>>;
@@ -517,6 +923,323 @@ private:
   VectorRebind<std::shared_ptr<const rcl_timer_t>> timer_handles_;
   VectorRebind<std::shared_ptr<Waitable>> waitable_handles_;
 
+  template<typename K, typename V>
+  using UnorderedMapRebind = std::unordered_map<
+    K, V, std::hash<K>, std::equal_to<K>,
+    typename std::allocator_traits<Alloc>::template rebind_alloc<std::pair<const K, V>>>;
+
+  /// Entity and callback group of a collected handle.
+  template<typename EntityT>
+  struct IndexedEntity
+  {
+    std::weak_ptr<EntityT> entity;
+    rclcpp::CallbackGroup::WeakPtr group;
+    /// Position of the handle in the collection, the order in which entities take turns.
+    size_t position;
+  };
+
+  template<typename HandleT, typename EntityT>
+  using EntityIndex = UnorderedMapRebind<const HandleT *, IndexedEntity<EntityT>>;
+
+  /// Resolve a handle to its entity and callback group with the index built while collecting.
+  /**
+   * The entity and group are left empty if either has expired or if the group is not part of
+   * weak_groups_to_nodes anymore.
+   *
+   * \return false if the handle is not in the index, true otherwise
+   */
+  template<typename HandleT, typename EntityT>
+  static bool find_indexed_entity(
+    const EntityIndex<HandleT, EntityT> & index,
+    const HandleT * handle,
+    const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes,
+    std::shared_ptr<EntityT> & entity,
+    rclcpp::CallbackGroup::SharedPtr & group)
+  {
+    auto found = index.find(handle);
+    if (found == index.end()) {
+      return false;
+    }
+    entity = found->second.entity.lock();
+    group = found->second.group.lock();
+    if (
+      !entity || !group ||
+      weak_groups_to_nodes.find(found->second.group) == weak_groups_to_nodes.end())
+    {
+      entity.reset();
+      group.reset();
+    }
+    return true;
+  }
+
+  /// Return the callback group of a ready handle if its entity can be executed now.
+  /**
+   * \return the callback group, or nullptr if the entity or its group is not valid anymore or
+   *   if the group is mutually exclusive and already in use
+   */
+  template<typename HandleT, typename EntityT, typename FindEntityT, typename FindGroupT>
+  static rclcpp::CallbackGroup::SharedPtr
+  find_takeable_group(
+    const EntityIndex<HandleT, EntityT> & index,
+    const std::shared_ptr<const HandleT> & handle,
+    const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes,
+    std::shared_ptr<EntityT> & entity,
+    FindEntityT find_entity,
+    FindGroupT find_group)
+  {
+    rclcpp::CallbackGroup::SharedPtr group;
+    if (!find_indexed_entity(index, handle.get(), weak_groups_to_nodes, entity, group)) {
+      entity = find_entity(handle, weak_groups_to_nodes);
+      if (entity) {
+        group = find_group(entity, weak_groups_to_nodes);
+      }
+    }
+    if (!entity || !group || !group->can_be_taken_from().load()) {
+      return nullptr;
+    }
+    return group;
+  }
+
+  template<typename T>
+  static void move_to_front(VectorRebind<T> & handles, size_t index)
+  {
+    std::rotate(handles.begin(), handles.begin() + index, handles.begin() + index + 1);
+  }
+
+  /// Entity of one kind executed last by get_next_round_robin_executable().
+  struct RoundRobinCursor
+  {
+    const void * handle = nullptr;
+    // Before the first position, so that the first entity gets the first turn.
+    size_t position = std::numeric_limits<size_t>::max();
+    size_t executions = 0;
+  };
+
+  /// Move the ready handle whose turn it is to the front of the handles.
+  /**
+   * The entity executed last keeps its turn until it was executed as many times in a row as
+   * the scheduling weight of its callback group, then the next ready entity in collection
+   * order after it gets the turn, wrapping around.
+   *
+   * \return false if no ready handle can be taken now
+   */
+  template<typename SharedHandleT, typename HandleT, typename EntityT, typename TakeableGroupT>
+  static bool select_in_turn(
+    VectorRebind<SharedHandleT> & handles,
+    const EntityIndex<HandleT, EntityT> & index,
+    const RoundRobinCursor & cursor,
+    TakeableGroupT takeable_group)
+  {
+    size_t current = handles.size();
+    size_t selected = handles.size();
+    size_t selected_distance = 0;
+    for (size_t i = 0; i < handles.size(); ++i) {
+      auto group = takeable_group(handles[i]);
+      if (!group) {
+        continue;
+      }
+      if (handles[i].get() == cursor.handle) {
+        if (cursor.executions < group->get_scheduling_weight()) {
+          // The turn of the entity executed last is not over.
+          selected = i;
+          break;
+        }
+        current = i;
+        continue;
+      }
+      auto found = index.find(handles[i].get());
+      const size_t position =
+        found == index.end() ? std::numeric_limits<size_t>::max() : found->second.position;
+      // Unsigned arithmetic wraps the positions before the cursor after the ones following it.
+      const size_t distance = position - cursor.position - 1u;
+      if (selected == handles.size() || distance < selected_distance) {
+        selected = i;
+        selected_distance = distance;
+      }
+    }
+    if (selected == handles.size()) {
+      // The entity executed last is the only one ready, it is executed again.
+      selected = current;
+    }
+    if (selected == handles.size()) {
+      return false;
+    }
+    move_to_front(handles, selected);
+    return true;
+  }
+
+  /// Record the execution of an entity by get_next_round_robin_executable().
+  template<typename HandleT, typename EntityT>
+  static void take_turn(
+    RoundRobinCursor & cursor,
+    const EntityIndex<HandleT, EntityT> & index,
+    const HandleT * handle)
+  {
+    if (handle == cursor.handle) {
+      ++cursor.executions;
+      return;
+    }
+    auto found = index.find(handle);
+    cursor.handle = handle;
+    cursor.position =
+      found == index.end() ? std::numeric_limits<size_t>::max() : found->second.position;
+    cursor.executions = 1u;
+  }
+
+  enum class ExecutableKind
+  {
+    Timer,
+    Subscription,
+    Service,
+    Client,
+    Waitable,
+  };
+
+  /// Best ready executable seen so far by get_next_prioritized_executable().
+  struct PrioritizedSelection
+  {
+    /// Rank an executable, candidates must be considered in fixed order.
+    void consider(
+      ExecutableKind candidate_kind, size_t candidate_index, int candidate_priority,
+      std::chrono::nanoseconds candidate_deadline = std::chrono::nanoseconds::max())
+    {
+      ++number_eligible;
+      if (found && candidate_priority == priority) {
+        ++number_at_priority;
+        if (candidate_deadline >= deadline) {
+          return;
+        }
+      } else if (found && candidate_priority < priority) {
+        return;
+      } else {
+        number_at_priority = 1;
+      }
+      found = true;
+      kind = candidate_kind;
+      index = candidate_index;
+      priority = candidate_priority;
+      deadline = candidate_deadline;
+    }
+
+    bool found = false;
+    ExecutableKind kind = ExecutableKind::Timer;
+    size_t index = 0;
+    int priority = 0;
+    std::chrono::nanoseconds deadline = std::chrono::nanoseconds::max();
+    size_t number_eligible = 0;
+    size_t number_at_priority = 0;
+  };
+
+  /// Entities of one callback group, as ranges into the collected handle vectors.
+  struct CollectedGroup
+  {
+    rclcpp::CallbackGroup::WeakPtr group;
+    rclcpp::node_interfaces::NodeBaseInterface::WeakPtr node;
+    uint64_t entities_version;
+    size_t subscriptions_end;
+    size_t services_end;
+    size_t clients_end;
+    size_t timers_end;
+    size_t waitables_end;
+  };
+
+  void clear_handles_to_wait_on()
+  {
+    subscription_handles_.clear();
+    service_handles_.clear();
+    client_handles_.clear();
+    timer_handles_.clear();
+    waitable_handles_.clear();
+  }
+
+  void clear_collected_entities()
+  {
+    collected_entities_valid_ = false;
+    collected_entities_invalid_ = false;
+    subscription_index_.clear();
+    service_index_.clear();
+    client_index_.clear();
+    timer_index_.clear();
+    waitable_index_.clear();
+    collected_groups_.clear();
+    collected_subscription_handles_.clear();
+    collected_service_handles_.clear();
+    collected_client_handles_.clear();
+    collected_timer_handles_.clear();
+    collected_waitable_handles_.clear();
+  }
+
+  /// Append the still alive handles in [begin, end) to the handles to wait on.
+  template<typename WeakHandleT, typename SharedHandleT>
+  static bool restore_handles(
+    const VectorRebind<WeakHandleT> & collected_handles,
+    size_t begin,
+    size_t end,
+    VectorRebind<SharedHandleT> & handles)
+  {
+    for (size_t i = begin; i < end; ++i) {
+      auto handle = collected_handles[i].lock();
+      if (!handle) {
+        return false;
+      }
+      handles.push_back(std::move(handle));
+    }
+    return true;
+  }
+
+  /// Erase the collected handles in [begin, end) and their entries of the index.
+  template<typename WeakHandleT, typename HandleT, typename EntityT>
+  static void erase_collected_handles(
+    VectorRebind<WeakHandleT> & collected_handles,
+    EntityIndex<HandleT, EntityT> & index,
+    size_t begin,
+    size_t end)
+  {
+    if (begin == end) {
+      return;
+    }
+    for (auto it = index.begin(); it != index.end(); ) {
+      if (it->second.position >= end) {
+        // Keeps the positions equal to the indices of the handles in the collection.
+        it->second.position -= end - begin;
+        ++it;
+      } else if (it->second.position >= begin) {
+        it = index.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    collected_handles.erase(
+      collected_handles.begin() + static_cast<std::ptrdiff_t>(begin),
+      collected_handles.begin() + static_cast<std::ptrdiff_t>(end));
+  }
+
+  // Result of the last collect_entities(), reused until entities are added or removed.
+  // Weak pointers are kept so that destroyed entities are not kept alive by the cache.
+  VectorRebind<CollectedGroup> collected_groups_;
+  VectorRebind<std::weak_ptr<const rcl_subscription_t>> collected_subscription_handles_;
+  VectorRebind<std::weak_ptr<const rcl_service_t>> collected_service_handles_;
+  VectorRebind<std::weak_ptr<const rcl_client_t>> collected_client_handles_;
+  VectorRebind<std::weak_ptr<const rcl_timer_t>> collected_timer_handles_;
+  VectorRebind<std::weak_ptr<Waitable>> collected_waitable_handles_;
+  bool collected_entities_valid_ = false;
+  bool collected_entities_invalid_ = false;
+
+  // Lookup tables from collected handles to their entity and group, so that resolving a ready
+  // handle does not require searching every callback group.
+  EntityIndex<rcl_subscription_t, rclcpp::SubscriptionBase> subscription_index_;
+  EntityIndex<rcl_service_t, rclcpp::ServiceBase> service_index_;
+  EntityIndex<rcl_client_t, rclcpp::ClientBase> client_index_;
+  EntityIndex<rcl_timer_t, rclcpp::TimerBase> timer_index_;
+  EntityIndex<rclcpp::Waitable, rclcpp::Waitable> waitable_index_;
+
+  // Turns of the ready entities of each kind, kept across waits and collections.
+  RoundRobinCursor timer_cursor_;
+  RoundRobinCursor subscription_cursor_;
+  RoundRobinCursor service_cursor_;
+  RoundRobinCursor client_cursor_;
+  RoundRobinCursor waitable_cursor_;
+
   std::shared_ptr<VoidAlloc> allocator_;
 };
 
@@ -0,0 +1,321 @@
+// Copyright 2015 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__STRATEGIES__RECLAIMING_MESSAGE_POOL_MEMORY_STRATEGY_HPP_
+#define RCLCPP__STRATEGIES__RECLAIMING_MESSAGE_POOL_MEMORY_STRATEGY_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/message_memory_strategy.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace strategies
+{
+namespace reclaiming_message_pool_memory_strategy
+{
+
+/// Thread-safe memory allocation strategy for messages, reclaiming them when they are released.
+/**
+ * The messages are preallocated in a pool and borrowed from a lock-free free list, so that
+ * borrowing and releasing a message is safe from any thread, e.g. with the
+ * rclcpp::executors::MultiThreadedExecutor.
+ * A message is only given back to the pool once the last shared_ptr (or weak_ptr) to it is
+ * released, so callbacks may keep the messages they are given as long as they want.
+ *
+ * The shared_ptr control blocks are placed next to the messages in the pool, so borrowing a
+ * message does not allocate, except for the members of messages which are not of fixed size.
+ *
+ * If all messages are in use, the pool grows by initial_size messages at a time, up to
+ * max_size messages, after which borrowing a message throws.
+ * The pool outlives this object as long as messages borrowed from it are alive.
+ */
+template<typename MessageT>
+class ReclaimingMessagePoolMemoryStrategy
+  : public message_memory_strategy::MessageMemoryStrategy<MessageT>
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(ReclaimingMessagePoolMemoryStrategy)
+
+  /// Constructor.
+  /**
+   * \param[in] initial_size Number of messages preallocated, and added every time the pool grows.
+   * \param[in] max_size Maximum number of messages of the pool, no growth if 0.
+   * \throws std::invalid_argument if initial_size is 0, or max_size is too large.
+   */
+  explicit ReclaimingMessagePoolMemoryStrategy(size_t initial_size, size_t max_size = 0)
+  : pool_(std::make_shared<Pool>(initial_size, max_size))
+  {}
+
+  /// Borrow a message from the message pool, growing it if needed and allowed.
+  /**
+   * \return Shared pointer to the borrowed message, which returns it to the pool once released.
+   * \throws std::runtime_error if all the messages of the pool are in use.
+   */
+  std::shared_ptr<MessageT> borrow_message() override
+  {
+    Slot * slot = pool_->acquire();
+    if (nullptr == slot) {
+      throw std::runtime_error("No message available in the message pool.");
+    }
+    return std::shared_ptr<MessageT>(
+      &slot->message, MessageResetter(), ControlBlockAllocator<MessageT>(pool_, slot));
+  }
+
+  /// Release the ownership of the message, which returns it to the pool if it has no more owners.
+  /** \param[in] msg Shared pointer to the message to return. */
+  void return_message(std::shared_ptr<MessageT> & msg) override
+  {
+    msg.reset();
+  }
+
+  /// Return the number of messages currently allocated by the pool.
+  size_t capacity() const
+  {
+    return pool_->capacity();
+  }
+
+  /// Return the number of messages of the pool which are not in use.
+  size_t available() const
+  {
+    return pool_->available();
+  }
+
+private:
+  // Enough space for the control block of a shared_ptr with a deleter and an allocator.
+  static constexpr size_t control_block_capacity = 128;
+
+  struct Slot
+  {
+    MessageT message;
+    // Index of the next free slot plus one, 0 being the end of the free list.
+    std::atomic<uint32_t> next{0};
+    uint32_t index = 0;
+    alignas(std::max_align_t) unsigned char control_block[control_block_capacity];
+  };
+
+  class Pool
+  {
+public:
+    Pool(size_t initial_size, size_t max_size)
+    : chunk_size_(initial_size),
+      number_of_chunks_(max_size > initial_size ? (max_size + initial_size - 1) / initial_size : 1)
+    {
+      if (0 == initial_size) {
+        throw std::invalid_argument("the initial size of the message pool must not be 0");
+      }
+      if (number_of_chunks_ * chunk_size_ >= std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("the maximum size of the message pool is too large");
+      }
+      chunks_.reset(new std::atomic<Slot *>[number_of_chunks_]);
+      for (size_t i = 0; i < number_of_chunks_; ++i) {
+        chunks_[i].store(nullptr, std::memory_order_relaxed);
+      }
+      add_chunk();
+    }
+
+    ~Pool()
+    {
+      for (size_t i = 0; i < number_of_chunks_; ++i) {
+        delete[] chunks_[i].load(std::memory_order_relaxed);
+      }
+    }
+
+    Slot * acquire()
+    {
+      Slot * slot = pop();
+      while (nullptr == slot) {
+        // Growing is rare, so it is serialized, while the other threads keep using the pool.
+        std::lock_guard<std::mutex> lock(growth_mutex_);
+        slot = pop();
+        if (nullptr != slot) {
+          break;
+        }
+        if (!add_chunk()) {
+          return nullptr;
+        }
+        slot = pop();
+      }
+      available_.fetch_sub(1, std::memory_order_relaxed);
+      return slot;
+    }
+
+    void release(Slot * slot)
+    {
+      available_.fetch_add(1, std::memory_order_relaxed);
+      push(slot);
+    }
+
+    size_t capacity() const
+    {
+      return number_of_chunks_added_.load(std::memory_order_acquire) * chunk_size_;
+    }
+
+    size_t available() const
+    {
+      return available_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint64_t index_mask = 0xffffffff;
+
+    Slot & get_slot(uint32_t index) const
+    {
+      return chunks_[index / chunk_size_].load(std::memory_order_acquire)[index % chunk_size_];
+    }
+
+    // The head of the free list holds the index of the first free slot plus one, and a tag
+    // incremented by every change, so that a concurrent pop and push of the same slot is
+    // detected by the compare and swap.
+    Slot * pop()
+    {
+      uint64_t head = head_.load(std::memory_order_acquire);
+      while (0 != (head & index_mask)) {
+        Slot & slot = get_slot(static_cast<uint32_t>(head & index_mask) - 1);
+        const uint64_t next = slot.next.load(std::memory_order_relaxed);
+        const uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+        if (
+          head_.compare_exchange_weak(
+            head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+        {
+          return &slot;
+        }
+      }
+      return nullptr;
+    }
+
+    void push(Slot * slot)
+    {
+      uint64_t head = head_.load(std::memory_order_relaxed);
+      uint64_t new_head;
+      do {
+        slot->next.store(static_cast<uint32_t>(head & index_mask), std::memory_order_relaxed);
+        new_head = (((head >> 32) + 1) << 32) | (static_cast<uint64_t>(slot->index) + 1);
+      } while (
+        !head_.compare_exchange_weak(
+          head, new_head, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // Must be called with the growth mutex locked, or from the constructor.
+    bool add_chunk()
+    {
+      const size_t chunk = number_of_chunks_added_.load(std::memory_order_relaxed);
+      if (chunk >= number_of_chunks_) {
+        return false;
+      }
+      Slot * slots = new Slot[chunk_size_];
+      for (size_t i = 0; i < chunk_size_; ++i) {
+        slots[i].index = static_cast<uint32_t>(chunk * chunk_size_ + i);
+      }
+      chunks_[chunk].store(slots, std::memory_order_release);
+      number_of_chunks_added_.store(chunk + 1, std::memory_order_release);
+      for (size_t i = chunk_size_; i > 0; --i) {
+        release(&slots[i - 1]);
+      }
+      return true;
+    }
+
+    const size_t chunk_size_;
+    const size_t number_of_chunks_;
+    std::unique_ptr<std::atomic<Slot *>[]> chunks_;
+    std::atomic<size_t> number_of_chunks_added_{0};
+    std::atomic<uint64_t> head_{0};
+    std::atomic<size_t> available_{0};
+    std::mutex growth_mutex_;
+  };
+
+  /// Reset the message when its last owner releases it, so it is ready for the next borrow.
+  struct MessageResetter
+  {
+    void operator()(MessageT * message) const
+    {
+      message->~MessageT();
+      new (message) MessageT;
+    }
+  };
+
+  /// Allocator of the shared_ptr control block, which gives the slot back to the pool.
+  /**
+   * The control block outlives the message as long as weak_ptrs to it exist, so the slot is
+   * only released when the control block is deallocated.
+   */
+  template<typename T>
+  class ControlBlockAllocator
+  {
+public:
+    using value_type = T;
+
+    ControlBlockAllocator(std::shared_ptr<Pool> pool, Slot * slot) noexcept
+    : pool_(std::move(pool)), slot_(slot)
+    {}
+
+    template<typename U>
+    ControlBlockAllocator(const ControlBlockAllocator<U> & other) noexcept
+    : pool_(other.pool_), slot_(other.slot_)
+    {}
+
+    T * allocate(size_t n)
+    {
+      if (n * sizeof(T) <= control_block_capacity && alignof(T) <= alignof(std::max_align_t)) {
+        return reinterpret_cast<T *>(slot_->control_block);
+      }
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T * ptr, size_t)
+    {
+      if (reinterpret_cast<unsigned char *>(ptr) != slot_->control_block) {
+        ::operator delete(ptr);
+      }
+      pool_->release(slot_);
+    }
+
+    template<typename U>
+    bool operator==(const ControlBlockAllocator<U> & other) const noexcept
+    {
+      return slot_ == other.slot_;
+    }
+
+    template<typename U>
+    bool operator!=(const ControlBlockAllocator<U> & other) const noexcept
+    {
+      return slot_ != other.slot_;
+    }
+
+private:
+    template<typename U>
+    friend class ControlBlockAllocator;
+
+    std::shared_ptr<Pool> pool_;
+    Slot * slot_;
+  };
+
+  std::shared_ptr<Pool> pool_;
+};
+
+}  // namespace reclaiming_message_pool_memory_strategy
+}  // namespace strategies
+}  // namespace rclcpp
+
+#endif  // RCLCPP__STRATEGIES__RECLAIMING_MESSAGE_POOL_MEMORY_STRATEGY_HPP_
@@ -0,0 +1,413 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__STRUCTURED_LOGGING_HPP_
+#define RCLCPP__STRUCTURED_LOGGING_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+#include "rcutils/logging.h"
+
+#include "rclcpp/logger.hpp"
+#include "rclcpp/logging.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+/// Logging which defers the formatting of the messages to the sinks consuming them.
+/**
+ * RCLCPP_LOG_STRUCTURED() copies the identifier of its call site, the format string of which is
+ * registered once, and its raw arguments into a ring buffer of the logging thread.
+ * A background thread moves the records from the buffers of all the threads to the sinks, see
+ * add_sink(), which format them only if they need to, e.g. OutputSink formats each record and
+ * passes it to the logging output handler while BinaryFileSink writes it as is, to be decoded
+ * offline by read_binary_file().
+ *
+ * The arguments must be integers, floating point numbers, pointers or strings, which are all
+ * copied, so that the arguments do not need to outlive the log call.
+ * They are formatted as if by printf, which the format string must match.
+ */
+namespace structured_logging
+{
+
+/// Call site of RCLCPP_LOG_STRUCTURED().
+struct Site
+{
+  uint32_t id;
+  int severity;
+  std::string format;
+  std::string function_name;
+  std::string file_name;
+  size_t line_number;
+};
+
+/// Copied argument of a record, pointers are stored as unsigned integers.
+using Argument = std::variant<int64_t, uint64_t, double, std::string>;
+
+/// Record of a call to RCLCPP_LOG_STRUCTURED(), as consumed by the sinks.
+struct Record
+{
+  const Site * site;
+  std::string logger_name;
+  rcutils_time_point_value_t timestamp;
+  std::vector<Argument> arguments;
+};
+
+/// Return the message of a record, i.e. its format string formatted with its arguments.
+RCLCPP_PUBLIC
+std::string
+format(const Record & record);
+
+/// Consumer of the structured log records.
+/**
+ * The methods are called from the background thread of the structured logging, or from a thread
+ * calling flush(), never concurrently.
+ */
+class Sink
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(Sink)
+
+  RCLCPP_PUBLIC
+  virtual ~Sink();
+
+  /// Consume a record, the site of which outlives the sink.
+  RCLCPP_PUBLIC
+  virtual void
+  consume(const Record & record) = 0;
+
+  /// Called after a batch of records was consumed.
+  RCLCPP_PUBLIC
+  virtual void
+  flush();
+};
+
+/// Sink formatting each record, and passing it to the logging output handler.
+/**
+ * The records are output like the messages of the RCLCPP_* macros, e.g. to the console, the log
+ * file and /rosout, with the time stamps of the log calls.
+ */
+class OutputSink : public Sink
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(OutputSink)
+
+  RCLCPP_PUBLIC
+  void
+  consume(const Record & record) override;
+};
+
+/// Sink writing the records without formatting them, see read_binary_file().
+/**
+ * The file holds the call sites, once each, and the records with their raw arguments, in the
+ * byte order of the machine writing it.
+ */
+class BinaryFileSink : public Sink
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(BinaryFileSink)
+
+  /**
+   * \param[in] path of the file, which is truncated
+   * \throws std::runtime_error if the file cannot be opened
+   */
+  RCLCPP_PUBLIC
+  explicit BinaryFileSink(const std::string & path);
+
+  RCLCPP_PUBLIC
+  virtual ~BinaryFileSink();
+
+  RCLCPP_PUBLIC
+  void
+  consume(const Record & record) override;
+
+  RCLCPP_PUBLIC
+  void
+  flush() override;
+
+private:
+  std::ofstream file_;
+  std::unordered_set<uint32_t> written_sites_;
+  std::string buffer_;
+};
+
+/// Read a file written by BinaryFileSink, passing each of its records to the callback.
+/**
+ * \param[in] path of the file
+ * \param[in] callback called with each record, whose site is only valid during the call
+ * \throws std::runtime_error if the file cannot be opened, or is not a structured log file
+ */
+RCLCPP_PUBLIC
+void
+read_binary_file(const std::string & path, std::function<void(const Record &)> callback);
+
+/// Add a sink, the structured logging is disabled while there are no sinks.
+RCLCPP_PUBLIC
+void
+add_sink(Sink::SharedPtr sink);
+
+/// Remove a sink, after passing it the records logged before.
+RCLCPP_PUBLIC
+void
+remove_sink(const Sink::SharedPtr & sink);
+
+/// Pass the records logged before to the sinks, without waiting for the background thread.
+RCLCPP_PUBLIC
+void
+flush();
+
+/// Set the size of the ring buffers of the threads which did not log a structured record yet.
+/**
+ * \param[in] size in bytes, rounded up to a power of two, 64 KiB by default
+ */
+RCLCPP_PUBLIC
+void
+set_thread_buffer_size(size_t size);
+
+/// Return the number of records dropped because the buffer of their thread was full.
+RCLCPP_PUBLIC
+uint64_t
+get_dropped_record_count();
+
+namespace detail
+{
+
+/// True while there are sinks.
+RCLCPP_PUBLIC
+extern std::atomic<bool> g_enabled;
+
+/// Register a call site, returning its identifier.
+RCLCPP_PUBLIC
+uint32_t
+register_site(
+  const char * format, int severity, const char * function_name, const char * file_name,
+  size_t line_number);
+
+// Tags of the encoded arguments.
+enum ArgumentTag : uint8_t
+{
+  SignedTag = 0u,
+  UnsignedTag = 1u,
+  FloatingPointTag = 2u,
+  StringTag = 3u,
+};
+
+/// Ring buffer of the records of a thread, with a single producer and a single consumer.
+/**
+ * Each record is encoded as:
+ *   - uint32_t size of the record, a multiple of 8, or 0 to wrap to the start of the buffer
+ *   - uint32_t id of the site
+ *   - int64_t time stamp
+ *   - uint16_t length of the logger name, followed by the logger name
+ *   - uint8_t number of arguments, followed by the tag and the value of each argument, i.e. 8
+ *     bytes for the numbers, or the uint32_t length followed by the characters of a string
+ */
+class ThreadBuffer
+{
+public:
+  RCLCPP_PUBLIC
+  explicit ThreadBuffer(size_t size);
+
+  /// Return the buffer of the calling thread, creating it on its first call.
+  RCLCPP_PUBLIC
+  static ThreadBuffer &
+  get();
+
+  /// Return contiguous space for a record, or null if the buffer is full.
+  RCLCPP_PUBLIC
+  uint8_t *
+  reserve(size_t size);
+
+  /// Make the record written to the reserved space available to the consumer.
+  RCLCPP_PUBLIC
+  void
+  commit();
+
+  /// Pass each available record, as encoded, to the callback, return the number of records.
+  RCLCPP_PUBLIC
+  size_t
+  consume(const std::function<void(const uint8_t *, size_t)> & callback);
+
+  /// Whether the thread of the buffer exited.
+  std::atomic<bool> orphaned{false};
+
+private:
+  std::unique_ptr<uint8_t[]> data_;
+  const uint64_t mask_;
+  // Positions since the creation of the buffer, of the next write and of the next read.
+  std::atomic<uint64_t> write_position_{0u};
+  std::atomic<uint64_t> read_position_{0u};
+  // Position after the reserved record, published by commit().
+  uint64_t reserved_end_{0u};
+};
+
+template<typename T>
+constexpr bool is_string_argument_v = std::is_convertible_v<const T &, std::string_view>;
+
+template<typename T>
+std::string_view
+to_string_view(const T & argument)
+{
+  if constexpr (std::is_pointer_v<T>) {
+    return argument ? std::string_view(argument) : std::string_view("(null)");
+  } else {
+    return std::string_view(argument);
+  }
+}
+
+template<typename T>
+size_t
+encoded_size(const T & argument)
+{
+  if constexpr (is_string_argument_v<T>) {
+    return 1u + sizeof(uint32_t) + to_string_view(argument).size();
+  } else {
+    static_assert(
+      std::is_arithmetic_v<T>|| std::is_pointer_v<T>|| std::is_enum_v<T>,
+      "arguments of RCLCPP_LOG_STRUCTURED must be numbers, pointers or strings");
+    return 1u + 8u;
+  }
+}
+
+template<typename T>
+uint8_t *
+encode(uint8_t * out, const T & argument)
+{
+  if constexpr (is_string_argument_v<T>) {
+    const std::string_view value = to_string_view(argument);
+    const auto length = static_cast<uint32_t>(value.size());
+    *out++ = StringTag;
+    std::memcpy(out, &length, sizeof(length));
+    std::memcpy(out + sizeof(length), value.data(), value.size());
+    return out + sizeof(length) + value.size();
+  } else if constexpr (std::is_floating_point_v<T>) {
+    const auto value = static_cast<double>(argument);
+    *out++ = FloatingPointTag;
+    std::memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+  } else if constexpr (std::is_pointer_v<T>) {
+    const auto value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(argument));
+    *out++ = UnsignedTag;
+    std::memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+  } else if constexpr (std::is_enum_v<T>) {
+    return encode(out, static_cast<std::underlying_type_t<T>>(argument));
+  } else if constexpr (std::is_signed_v<T>) {
+    const auto value = static_cast<int64_t>(argument);
+    *out++ = SignedTag;
+    std::memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+  } else {
+    const auto value = static_cast<uint64_t>(argument);
+    *out++ = UnsignedTag;
+    std::memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+  }
+}
+
+/// Count a record dropped because the buffer of its thread was full.
+RCLCPP_PUBLIC
+void
+count_dropped_record();
+
+/// Copy a record to the buffer of the calling thread.
+template<typename ... Args>
+void
+log(uint32_t site_id, const rclcpp::Logger & logger, const char *, const Args & ... args)
+{
+  static_assert(sizeof...(Args) < 256u, "too many arguments for RCLCPP_LOG_STRUCTURED");
+  const char * name = logger.get_name();
+  const std::string_view logger_name(name ? name : "");
+  const size_t name_length = std::min<size_t>(logger_name.size(), UINT16_MAX);
+  const size_t unaligned_size = 2u * sizeof(uint32_t) + sizeof(int64_t) + sizeof(uint16_t) +
+    name_length + 1u + (size_t(0u) + ... + encoded_size(args));
+  const size_t size = (unaligned_size + 7u) & ~size_t(7u);
+
+  ThreadBuffer & buffer = ThreadBuffer::get();
+  uint8_t * out = buffer.reserve(size);
+  if (!out) {
+    count_dropped_record();
+    return;
+  }
+  const auto record_size = static_cast<uint32_t>(size);
+  const int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::system_clock::now().time_since_epoch()).count();
+  const auto name_size = static_cast<uint16_t>(name_length);
+  const auto argument_count = static_cast<uint8_t>(sizeof...(Args));
+  std::memcpy(out, &record_size, sizeof(record_size));
+  std::memcpy(out + 4u, &site_id, sizeof(site_id));
+  std::memcpy(out + 8u, &timestamp, sizeof(timestamp));
+  std::memcpy(out + 16u, &name_size, sizeof(name_size));
+  std::memcpy(out + 18u, logger_name.data(), name_length);
+  out += 18u + name_length;
+  *out++ = argument_count;
+  ((out = encode(out, args)), ...);
+  buffer.commit();
+}
+
+}  // namespace detail
+}  // namespace structured_logging
+}  // namespace rclcpp
+
+/// Log a message whose formatting is deferred to the sinks of the structured logging.
+/**
+ * For example:
+ *
+ *     RCLCPP_LOG_STRUCTURED(
+ *       node->get_logger(), rclcpp::Logger::Level::Debug, "position %f %f", x, y);
+ *
+ * Nothing is logged while no sink was added, see rclcpp::structured_logging::add_sink().
+ * The severity is checked like the severity of the RCLCPP_* macros.
+ *
+ * \param logger The `rclcpp::Logger` to use
+ * \param severity The rclcpp::Logger::Level of the message
+ * \param ... The format string literal, followed by the numbers, pointers or strings it formats.
+ */
+#define RCLCPP_LOG_STRUCTURED(logger, severity, ...) \
+  do { \
+    static_assert( \
+      ::std::is_same<typename std::remove_cv<typename std::remove_reference<decltype(logger)> \
+      ::type>::type, typename ::rclcpp::Logger>::value, \
+      "First argument to logging macros must be an rclcpp::Logger"); \
+    if (!::rclcpp::structured_logging::detail::g_enabled.load(std::memory_order_relaxed)) { \
+      break; \
+    } \
+    const ::rclcpp::Logger & rclcpp_logging_logger_ = (logger); \
+    if (!rclcpp_logging_logger_.is_enabled_for(severity)) { \
+      break; \
+    } \
+    static const uint32_t rclcpp_structured_logging_site_ = \
+      ::rclcpp::structured_logging::detail::register_site( \
+      RCLCPP_FIRST_ARG(__VA_ARGS__, ""), static_cast<int>(severity), __func__, __FILE__, \
+      __LINE__); \
+    ::rclcpp::structured_logging::detail::log( \
+      rclcpp_structured_logging_site_, rclcpp_logging_logger_, __VA_ARGS__); \
+  } while (0)
+
+#endif  // RCLCPP__STRUCTURED_LOGGING_HPP_
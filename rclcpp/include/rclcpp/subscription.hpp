@@ -146,6 +146,19 @@ public:
     options_(options),
     message_memory_strategy_(message_memory_strategy)
   {
+    this->set_max_messages_per_take(options.max_messages_per_take);
+    this->set_take_latest_only(options.take_latest_only);
+    this->set_min_message_period(options.min_message_period);
+    this->set_execution_budget(options.execution_budget);
+    if (options.serialized_message_pool_size > 0) {
+      message_memory_strategy_->set_serialized_message_pool_size(
+        options.serialized_message_pool_size);
+    }
+    if (!options.content_filter_options.filter_expression.empty()) {
+      this->set_content_filter(
+        options.content_filter_options.filter_expression,
+        options.content_filter_options.expression_parameters);
+    }
     if (options.event_callbacks.deadline_callback) {
       this->add_event_handler(
         options.event_callbacks.deadline_callback,
@@ -177,6 +190,9 @@ public:
         options.event_callbacks.message_lost_callback,
         RCL_SUBSCRIPTION_MESSAGE_LOST);
     }
+    if (options.event_callbacks.matched_callback) {
+      this->add_matched_event_handler(node_base, options.event_callbacks.matched_callback);
+    }
 
     // Setup intra process publishing if requested.
     if (rclcpp::detail::resolve_use_intra_process(options, *node_base)) {
@@ -192,20 +208,94 @@ public:
         throw std::invalid_argument(
                 "intraprocess communication is not allowed with 0 depth qos policy");
       }
-      if (qos_profile.durability() != rclcpp::DurabilityPolicy::Volatile) {
+      // The intra process manager replays the history of the transient local publishers.
+      if (
+        qos_profile.durability() != rclcpp::DurabilityPolicy::Volatile &&
+        qos_profile.durability() != rclcpp::DurabilityPolicy::TransientLocal)
+      {
         throw std::invalid_argument(
-                "intraprocess communication allowed only with volatile durability");
+                "intraprocess communication allowed only with volatile or transient local "
+                "durability");
       }
 
       // First create a SubscriptionIntraProcess which will be given to the intra-process manager.
       auto context = node_base->get_context();
-      subscription_intra_process_ = std::make_shared<SubscriptionIntraProcessT>(
-        callback,
-        options.get_allocator(),
-        context,
-        this->get_topic_name(),  // important to get like this, as it has the fully-qualified name
-        qos_profile,
-        resolve_intra_process_buffer_type(options.intra_process_buffer_type, callback));
+      // The name of the rcl subscription is fully-qualified.
+      const char * resolved_topic_name = this->get_topic_name();
+      auto buffer_type =
+        resolve_intra_process_buffer_type(options.intra_process_buffer_type, callback);
+      // The QoS and the buffer type of the intra-process buffer.
+      auto buffer_qos_profile = qos_profile;
+      if (options.take_latest_only) {
+        if (options.intra_process_buffer_memory_budget > 0) {
+          throw std::invalid_argument(
+                  "an intra-process buffer keeping the latest message only cannot be adaptive");
+        }
+        // A lock-free buffer of a single message, in which a new message replaces the old one.
+        buffer_qos_profile.keep_last(1);
+        if (IntraProcessBufferType::SharedPtr == buffer_type) {
+          buffer_type = IntraProcessBufferType::LockFreeSharedPtr;
+        } else if (IntraProcessBufferType::UniquePtr == buffer_type) {
+          buffer_type = IntraProcessBufferType::LockFreeUniquePtr;
+        }
+      }
+      if (rclcpp::detail::intra_process_buffer_copies_messages(buffer_type, callback)) {
+        RCLCPP_WARN(
+          rclcpp::get_logger("rclcpp"),
+          "the intra-process buffer of the subscription to '%s' shares the messages, but its "
+          "callback takes their ownership: each message will be copied, use the "
+          "'CallbackDefault' intra-process buffer type to avoid it", resolved_topic_name);
+      }
+      if constexpr (rclcpp::TypeAdapter<MessageT>::is_specialized::value) {
+        // The filters, the rate limit and the topic statistics are applied by the buffers
+        // receiving the ROS message type, which is not stored by this buffer.
+        if (
+          callback.is_custom_type_callback() && !options.message_filter &&
+          options.content_filter_options.filter_expression.empty() &&
+          options.min_message_period.count() == 0 && !subscription_topic_statistics)
+        {
+          // Store the custom type, so that the messages of the publishers using the same
+          // TypeAdapter are not converted to the ROS message type and back.
+          subscription_intra_process_ = std::make_shared<CustomTypeSubscriptionIntraProcessT>(
+            callback,
+            options.get_allocator(),
+            context,
+            resolved_topic_name,
+            buffer_qos_profile,
+            buffer_type,
+            options.intra_process_buffer_memory_budget);
+        }
+      }
+      if (!subscription_intra_process_) {
+        auto subscription_intra_process = std::make_shared<SubscriptionIntraProcessT>(
+          callback,
+          options.get_allocator(),
+          context,
+          resolved_topic_name,
+          buffer_qos_profile,
+          buffer_type,
+          options.intra_process_buffer_memory_budget);
+        // Evaluated by the publishers, before the messages are queued.
+        subscription_intra_process->set_message_filter(
+          [message_filter = options.message_filter,
+          content_filter = this->get_content_filter_predicate()](const void * message) {
+            return (!message_filter || message_filter(message)) && content_filter(message);
+          });
+        subscription_intra_process->set_min_message_period(options.min_message_period);
+        subscription_intra_process->set_topic_statistics(subscription_topic_statistics);
+        subscription_intra_process_ = std::move(subscription_intra_process);
+      }
+      if (options.intra_process_direct_dispatch_depth > 0) {
+        // The callback group is the one the subscription is added to by the node.
+        subscription_intra_process_->set_direct_dispatch(
+          options.intra_process_direct_dispatch_depth,
+          options.callback_group ?
+          options.callback_group : node_base->get_default_callback_group());
+      }
+      if (options.event_callbacks.message_lost_callback) {
+        subscription_intra_process_->set_message_lost_callback(
+          options.event_callbacks.message_lost_callback);
+      }
       TRACEPOINT(
         rclcpp_subscription_init,
         static_cast<const void *>(get_subscription_handle().get()),
@@ -324,6 +414,9 @@ public:
       return;
     }
     auto typed_message = std::static_pointer_cast<ROSMessageType>(message);
+    if (!is_message_selected(typed_message.get())) {
+      return;
+    }
 
     std::chrono::time_point<std::chrono::system_clock> now;
     if (subscription_topic_statistics_) {
@@ -356,12 +449,43 @@ public:
     const rclcpp::MessageInfo & message_info) override
   {
     auto typed_message = static_cast<ROSMessageType *>(loaned_message);
+    if (!is_message_selected(typed_message)) {
+      return;
+    }
     // message is loaned, so we have to make sure that the deleter does not deallocate the message
     auto sptr = std::shared_ptr<ROSMessageType>(
       typed_message, [](ROSMessageType * msg) {(void) msg;});
     any_callback_.dispatch(sptr, message_info);
   }
 
+  void
+  handle_loaned_message_taking_ownership(
+    void *& loaned_message,
+    const rclcpp::MessageInfo & message_info) override
+  {
+    if (!any_callback_.is_loaned_message_callback()) {
+      handle_loaned_message(loaned_message, message_info);
+      return;
+    }
+    auto typed_message = static_cast<ROSMessageType *>(loaned_message);
+    if (!is_message_selected(typed_message)) {
+      // The loan is returned by the caller.
+      return;
+    }
+    if (subscription_topic_statistics_) {
+      // The message may be gone once the callback returned.
+      const auto nanos = std::chrono::time_point_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now());
+      const auto time = rclcpp::Time(nanos.time_since_epoch().count());
+      subscription_topic_statistics_->handle_message(*typed_message, time);
+    }
+    // The loan now belongs to the callback, which returns it when it is done with the message.
+    rclcpp::SubscriptionLoanedMessage<ROSMessageType> message(
+      get_subscription_handle(), typed_message);
+    loaned_message = nullptr;
+    any_callback_.dispatch_loaned_message(std::move(message), message_info);
+  }
+
   /// Return the borrowed message.
   /**
    * \param[inout] message message to be returned
@@ -392,6 +516,14 @@ public:
 private:
   RCLCPP_DISABLE_COPY(Subscription)
 
+  /// Return false if the message is dropped by the message filter or by the content filter.
+  bool
+  is_message_selected(const ROSMessageType * message) const
+  {
+    return (!options_.message_filter || options_.message_filter(message)) &&
+           this->matches_content_filter(message);
+  }
+
   AnySubscriptionCallback<MessageT, AllocatorT> any_callback_;
   /// Copy of original options passed during construction.
   /**
@@ -410,7 +542,14 @@ private:
     AllocatorT,
     ROSMessageTypeDeleter,
     MessageT>;
-  std::shared_ptr<SubscriptionIntraProcessT> subscription_intra_process_;
+  using CustomTypeSubscriptionIntraProcessT = rclcpp::experimental::SubscriptionIntraProcess<
+    SubscribedType,
+    AllocatorT,
+    SubscribedTypeDeleter,
+    MessageT,
+    ROSMessageType,
+    ROSMessageTypeDeleter>;
+  rclcpp::experimental::SubscriptionIntraProcessBase::SharedPtr subscription_intra_process_;
 };
 
 }  // namespace rclcpp
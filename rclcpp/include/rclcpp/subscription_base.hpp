@@ -16,17 +16,23 @@
 #define RCLCPP__SUBSCRIPTION_BASE_HPP_
 
 #include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <utility>
 
+#include "rcl/event_callback.h"
 #include "rcl/subscription.h"
 
 #include "rmw/rmw.h"
 
 #include "rclcpp/any_subscription_callback.hpp"
+#include "rclcpp/content_filter.hpp"
+#include "rclcpp/detail/message_rate_limiter.hpp"
 #include "rclcpp/experimental/intra_process_manager.hpp"
 #include "rclcpp/experimental/subscription_intra_process_base.hpp"
 #include "rclcpp/macros.hpp"
@@ -104,6 +110,16 @@ public:
   const std::vector<std::shared_ptr<rclcpp::QOSEventHandlerBase>> &
   get_event_handlers() const;
 
+  /// Get a single waitable executing all the QoS event handlers of this subscription.
+  /**
+   * Executors add it instead of each handler, so that they handle one waitable per subscription.
+   * \return the only event handler, a rclcpp::QOSEventHandlerGroup of all of them, or nullptr
+   *   if there are none.
+   */
+  RCLCPP_PUBLIC
+  rclcpp::Waitable::SharedPtr
+  get_event_handlers_waitable();
+
   /// Get the actual QoS settings, after the defaults have been determined.
   /**
    * The actual configuration applied when using RMW_QOS_POLICY_*_SYSTEM_DEFAULT
@@ -195,6 +211,22 @@ public:
   void
   handle_loaned_message(void * loaned_message, const rclcpp::MessageInfo & message_info) = 0;
 
+  /// Handle a loaned message, taking over the loan if the callback can keep it.
+  /**
+   * If the loan is taken over, loaned_message is set to nullptr and the caller must not return
+   * it to the middleware.
+   * The default implementation calls handle_loaned_message() and leaves the loan to the caller.
+   *
+   * \param[inout] loaned_message the message loaned by the middleware
+   * \param[in] message_info the information of the message
+   */
+  RCLCPP_PUBLIC
+  virtual
+  void
+  handle_loaned_message_taking_ownership(
+    void *& loaned_message,
+    const rclcpp::MessageInfo & message_info);
+
   /// Return the message borrowed in create_message.
   /** \param[in] message Shared pointer to the returned message. */
   RCLCPP_PUBLIC
@@ -221,6 +253,85 @@ public:
   bool
   is_serialized() const;
 
+  /// Return the maximum number of messages an executor takes each time the subscription is ready.
+  /**
+   * \sa rclcpp::SubscriptionOptionsBase::max_messages_per_take
+   * \return the maximum number of messages taken per readiness event, at least 1
+   */
+  RCLCPP_PUBLIC
+  size_t
+  get_max_messages_per_take() const;
+
+  /// Return true if executors only handle the newest message each time the subscription is ready.
+  /**
+   * \sa rclcpp::SubscriptionOptionsBase::take_latest_only
+   */
+  RCLCPP_PUBLIC
+  bool
+  get_take_latest_only() const;
+
+  /// Return the minimum period between two messages handled by the subscription.
+  /**
+   * \sa rclcpp::SubscriptionOptionsBase::min_message_period
+   */
+  RCLCPP_PUBLIC
+  std::chrono::nanoseconds
+  get_min_message_period() const;
+
+  /// Return the time budget of each execution of the subscription, 0 if it has none.
+  /**
+   * \sa rclcpp::SubscriptionOptionsBase::execution_budget
+   */
+  RCLCPP_PUBLIC
+  std::chrono::nanoseconds
+  get_execution_budget() const;
+
+  /// Return true if the subscription has a content filter.
+  /**
+   * \sa rclcpp::SubscriptionOptionsBase::content_filter_options
+   */
+  RCLCPP_PUBLIC
+  bool
+  is_cft_enabled() const;
+
+  /// Set the content filter of the subscription, replacing the current one.
+  /**
+   * The filter applies to the next messages handled by the subscription and published intra
+   * process to it.
+   * A subscription with a TypeAdapter keeping the custom type in its intra-process buffer only
+   * filters the messages published intra process if it was created with a content filter.
+   *
+   * \param[in] filter_expression the filter expression, see rclcpp::ContentFilter, or an empty
+   *   string to remove the filter.
+   * \param[in] expression_parameters the values of the parameters of the expression.
+   * \throws std::invalid_argument if the expression or one of its parameters is not valid, or
+   *   if the subscription takes serialized messages.
+   */
+  RCLCPP_PUBLIC
+  void
+  set_content_filter(
+    const std::string & filter_expression,
+    const std::vector<std::string> & expression_parameters = {});
+
+  /// Return the filter expression and its parameters, empty if there is no content filter.
+  RCLCPP_PUBLIC
+  rclcpp::ContentFilterOptions
+  get_content_filter() const;
+
+  /// Return true if a message taken now must be dropped, because of the minimum message period.
+  /**
+   * Executors check it before taking a message, so that the dropped messages are neither
+   * copied nor deserialized.
+   */
+  RCLCPP_PUBLIC
+  bool
+  is_message_rate_limited() const;
+
+  /// Record that a message was taken to be handled, which starts a new minimum message period.
+  RCLCPP_PUBLIC
+  void
+  record_message_taken();
+
   /// Get matching publisher count.
   /** \return The number of publishers on this topic. */
   RCLCPP_PUBLIC
@@ -283,6 +394,37 @@ public:
   std::vector<rclcpp::NetworkFlowEndpoint>
   get_network_flow_endpoints() const;
 
+  /// Set a callback to be called when each new message is received.
+  /**
+   * The callback receives a size_t which is the number of messages received
+   * since the last time this callback was called.
+   * Normally this is 1, but can be > 1 if messages were received before any
+   * callback was set.
+   *
+   * Since this callback is called from the middleware, you should aim to make
+   * it fast and not blocking.
+   * If you need to do a lot of work or wait for some other event, you should
+   * spin it off to another thread, otherwise you risk blocking the middleware.
+   *
+   * Calling it again will clear any previously set callback.
+   *
+   * This function is thread-safe.
+   *
+   * \sa rmw_subscription_set_on_new_message_callback
+   * \sa rcl_subscription_set_on_new_message_callback
+   *
+   * \param[in] callback functor to be called when a new message is received
+   * \throws std::invalid_argument if the callback is empty
+   */
+  RCLCPP_PUBLIC
+  void
+  set_on_new_message_callback(std::function<void(size_t)> callback);
+
+  /// Unset the callback registered for new messages, if any.
+  RCLCPP_PUBLIC
+  void
+  clear_on_new_message_callback();
+
 protected:
   template<typename EventCallbackT>
   void
@@ -296,10 +438,21 @@ protected:
       rcl_subscription_event_init,
       get_subscription_handle(),
       event_type);
-    qos_events_in_use_by_wait_set_.insert(std::make_pair(handler.get(), false));
-    event_handlers_.emplace_back(handler);
+    add_event_handler(std::move(handler));
   }
 
+  /// Add a QoS event handler, allocating the event handlers with the first one.
+  RCLCPP_PUBLIC
+  void
+  add_event_handler(std::shared_ptr<rclcpp::QOSEventHandlerBase> handler);
+
+  /// Add a handler of the changes of the number of publishers matched by the subscription.
+  RCLCPP_PUBLIC
+  void
+  add_matched_event_handler(
+    rclcpp::node_interfaces::NodeBaseInterface * node_base,
+    const QOSMatchedCallbackType & callback);
+
   RCLCPP_PUBLIC
   void default_incompatible_qos_callback(QOSRequestedIncompatibleQoSInfo & info) const;
 
@@ -307,28 +460,93 @@ protected:
   bool
   matches_any_intra_process_publishers(const rmw_gid_t * sender_gid) const;
 
+  /// Set the maximum number of messages an executor takes each time the subscription is ready.
+  /**
+   * \throws std::invalid_argument if max_messages_per_take is 0
+   */
+  RCLCPP_PUBLIC
+  void
+  set_max_messages_per_take(size_t max_messages_per_take);
+
+  /// Set whether executors only handle the newest message each time the subscription is ready.
+  RCLCPP_PUBLIC
+  void
+  set_take_latest_only(bool take_latest_only);
+
+  /// Set the minimum period between two messages handled by the subscription.
+  /**
+   * \throws std::invalid_argument if min_message_period is negative
+   */
+  RCLCPP_PUBLIC
+  void
+  set_min_message_period(std::chrono::nanoseconds min_message_period);
+
+  /// Set the time budget of each execution of the subscription.
+  /**
+   * \throws std::invalid_argument if execution_budget is negative
+   */
+  RCLCPP_PUBLIC
+  void
+  set_execution_budget(std::chrono::nanoseconds execution_budget);
+
+  RCLCPP_PUBLIC
+  void
+  set_on_new_message_callback(rcl_event_callback_t callback, const void * user_data);
+
+  /// Return true if the message matches the content filter, or if there is none.
+  RCLCPP_PUBLIC
+  bool
+  matches_content_filter(const void * message) const;
+
+  /// Return a predicate evaluating the current content filter, see matches_content_filter().
+  /**
+   * The predicate does not refer to the subscription, so it can be evaluated by the
+   * intra-process buffer of the subscription once the subscription is destroyed.
+   */
+  RCLCPP_PUBLIC
+  std::function<bool (const void *)>
+  get_content_filter_predicate() const;
+
   rclcpp::node_interfaces::NodeBaseInterface * const node_base_;
 
   std::shared_ptr<rcl_node_t> node_handle_;
   std::shared_ptr<rcl_subscription_t> subscription_handle_;
   std::shared_ptr<rcl_subscription_t> intra_process_subscription_handle_;
 
-  std::vector<std::shared_ptr<rclcpp::QOSEventHandlerBase>> event_handlers_;
+  /// QoS event handlers of the subscription, and whether they are in use by a wait set.
+  struct EventHandlers
+  {
+    std::vector<std::shared_ptr<rclcpp::QOSEventHandlerBase>> handlers;
+    std::shared_ptr<rclcpp::QOSEventHandlerGroup> group;
+    std::unordered_map<rclcpp::QOSEventHandlerBase *, std::atomic<bool>> in_use_by_wait_set;
+  };
+  /// Allocated with the first handler, so the subscriptions without any, e.g. created with
+  /// SubscriptionOptionsBase::use_default_callbacks false and no event callbacks, do not pay
+  /// for them.
+  std::unique_ptr<EventHandlers> event_handlers_;
 
   bool use_intra_process_;
   IntraProcessManagerWeakPtr weak_ipm_;
   uint64_t intra_process_subscription_id_;
 
+  std::recursive_mutex callback_mutex_;
+  std::function<void(size_t)> on_new_message_callback_{nullptr};
+
 private:
   RCLCPP_DISABLE_COPY(SubscriptionBase)
 
   rosidl_message_type_support_t type_support_;
   bool is_serialized_;
+  size_t max_messages_per_take_;
+  bool take_latest_only_;
+  rclcpp::detail::MessageRateLimiter message_rate_limiter_;
+  std::chrono::nanoseconds execution_budget_{0};
+
+  struct ContentFilterState;
+  std::shared_ptr<ContentFilterState> content_filter_state_;
 
   std::atomic<bool> subscription_in_use_by_wait_set_{false};
   std::atomic<bool> intra_process_subscription_waitable_in_use_by_wait_set_{false};
-  std::unordered_map<rclcpp::QOSEventHandlerBase *,
-    std::atomic<bool>> qos_events_in_use_by_wait_set_;
 };
 
 }  // namespace rclcpp
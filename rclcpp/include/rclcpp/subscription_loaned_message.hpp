@@ -0,0 +1,154 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__SUBSCRIPTION_LOANED_MESSAGE_HPP_
+#define RCLCPP__SUBSCRIPTION_LOANED_MESSAGE_HPP_
+
+#include <memory>
+#include <utility>
+
+#include "rcl/error_handling.h"
+#include "rcl/subscription.h"
+
+#include "rclcpp/logging.hpp"
+
+namespace rclcpp
+{
+
+/// Read-only message received by a subscription, possibly loaned by the middleware.
+/**
+ * Subscription callbacks taking this type receive the messages loaned by middlewares which can
+ * loan messages, e.g. over shared memory, without any copy or heap allocation.
+ * The loan is returned to the middleware when this instance is destroyed, so it can be moved out
+ * of the callback and kept as long as needed, bearing in mind that the middleware may limit the
+ * number of messages on loan.
+ *
+ * Messages which are not loaned, e.g. taken from a middleware which can not loan messages or
+ * received intra process, are shared with this instance instead.
+ *
+ * This class is move-only.
+ */
+template<typename MessageT>
+class SubscriptionLoanedMessage
+{
+public:
+  /// Take over a message loaned by the middleware to a subscription.
+  /**
+   * \param[in] subscription_handle the subscription the message was taken from
+   * \param[in] loaned_message the loaned message, returned to the middleware by this instance
+   */
+  SubscriptionLoanedMessage(
+    std::shared_ptr<rcl_subscription_t> subscription_handle,
+    MessageT * loaned_message)
+  : subscription_handle_(std::move(subscription_handle)),
+    message_(loaned_message)
+  {}
+
+  /// Share a message which is not loaned.
+  explicit SubscriptionLoanedMessage(std::shared_ptr<const MessageT> message)
+  : message_(message.get()),
+    shared_message_(std::move(message))
+  {}
+
+  SubscriptionLoanedMessage(SubscriptionLoanedMessage && other)
+  : subscription_handle_(std::move(other.subscription_handle_)),
+    message_(other.message_),
+    shared_message_(std::move(other.shared_message_))
+  {
+    other.message_ = nullptr;
+  }
+
+  SubscriptionLoanedMessage &
+  operator=(SubscriptionLoanedMessage && other)
+  {
+    if (this != &other) {
+      reset();
+      subscription_handle_ = std::move(other.subscription_handle_);
+      message_ = other.message_;
+      shared_message_ = std::move(other.shared_message_);
+      other.message_ = nullptr;
+    }
+    return *this;
+  }
+
+  SubscriptionLoanedMessage(const SubscriptionLoanedMessage &) = delete;
+
+  SubscriptionLoanedMessage &
+  operator=(const SubscriptionLoanedMessage &) = delete;
+
+  ~SubscriptionLoanedMessage()
+  {
+    reset();
+  }
+
+  /// Return the loan to the middleware, or release the shared message.
+  void
+  reset()
+  {
+    if (nullptr != message_ && subscription_handle_) {
+      rcl_ret_t ret = rcl_return_loaned_message_from_subscription(
+        subscription_handle_.get(), const_cast<MessageT *>(message_));
+      if (RCL_RET_OK != ret) {
+        RCLCPP_ERROR(
+          rclcpp::get_logger("rclcpp"),
+          "rcl_return_loaned_message_from_subscription() failed: %s", rcl_get_error_string().str);
+        rcl_reset_error();
+      }
+    }
+    subscription_handle_.reset();
+    shared_message_.reset();
+    message_ = nullptr;
+  }
+
+  /// Whether this instance holds a message.
+  bool
+  is_valid() const
+  {
+    return nullptr != message_;
+  }
+
+  /// Whether the message is loaned by the middleware.
+  bool
+  is_loaned() const
+  {
+    return nullptr != message_ && subscription_handle_ != nullptr;
+  }
+
+  const MessageT &
+  get() const
+  {
+    return *message_;
+  }
+
+  const MessageT &
+  operator*() const
+  {
+    return *message_;
+  }
+
+  const MessageT *
+  operator->() const
+  {
+    return message_;
+  }
+
+private:
+  std::shared_ptr<rcl_subscription_t> subscription_handle_;
+  const MessageT * message_ = nullptr;
+  std::shared_ptr<const MessageT> shared_message_;
+};
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__SUBSCRIPTION_LOANED_MESSAGE_HPP_
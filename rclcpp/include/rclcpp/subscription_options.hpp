@@ -16,18 +16,21 @@
 #define RCLCPP__SUBSCRIPTION_OPTIONS_HPP_
 
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <type_traits>
 #include <vector>
 
 #include "rclcpp/callback_group.hpp"
+#include "rclcpp/content_filter.hpp"
 #include "rclcpp/detail/rmw_implementation_specific_subscription_payload.hpp"
 #include "rclcpp/intra_process_buffer_type.hpp"
 #include "rclcpp/intra_process_setting.hpp"
 #include "rclcpp/qos.hpp"
 #include "rclcpp/qos_event.hpp"
 #include "rclcpp/qos_overriding_options.hpp"
+#include "rclcpp/serialized_message_codec.hpp"
 #include "rclcpp/topic_statistics_state.hpp"
 #include "rclcpp/visibility_control.hpp"
 
@@ -60,10 +63,145 @@ struct SubscriptionOptionsBase
   /// Setting the data-type stored in the intraprocess buffer
   IntraProcessBufferType intra_process_buffer_type = IntraProcessBufferType::CallbackDefault;
 
+  /// Memory budget, in bytes, of an adaptive intra-process buffer, or 0 for a fixed-size buffer.
+  /**
+   * By default the intra-process buffer holds as many messages as the depth of the QoS.
+   * With a budget, the buffer starts with the depth of the QoS and grows when the callback falls
+   * behind, up to as many messages as fit in the budget, then shrinks back when the callback
+   * catches up.
+   * The size of a message is estimated with sizeof(), which does not count the memory of its
+   * unbounded sequences and strings.
+   * Lock-free intra-process buffer types do not support it.
+   *
+   * \sa rclcpp::experimental::SubscriptionIntraProcessBase::get_lag()
+   */
+  size_t intra_process_buffer_memory_budget = 0;
+
+  /// Maximum number of messages taken each time the executor finds the subscription ready.
+  /**
+   * With a value greater than 1 the executor keeps taking and handling messages, reusing the
+   * same message and message info, until the middleware queue is empty or the limit is reached.
+   * This drains a burst of messages in a single wait cycle; it only applies to messages received
+   * through the middleware, not through intra-process communication.
+   * Must be greater than zero.
+   */
+  size_t max_messages_per_take = 1;
+
+  /// True to only give the newest message to the callback, dropping the older ones.
+  /**
+   * In this "mailbox" mode a slow callback always gets the freshest message instead of working
+   * through the stale messages queued behind it.
+   * Each time the executor finds the subscription ready, it takes all the messages queued by the
+   * middleware, serialized, and only deserializes and handles the last one;
+   * max_messages_per_take is ignored.
+   * The intra-process buffer holds a single message, replaced by each new message without
+   * taking a lock, so it cannot be combined with intra_process_buffer_memory_budget.
+   */
+  bool take_latest_only = false;
+
+  /// Minimum period between two messages given to the callback, zero to give all the messages.
+  /**
+   * The messages arriving faster than this are dropped before being deserialized, e.g. to
+   * downsample a high rate topic for visualization or logging.
+   * The messages received through the middleware are dropped when the executor takes them, as
+   * loaned messages if the middleware supports it, otherwise serialized.
+   * The messages published intra process are dropped by the publishers, before they are queued.
+   * The rate is measured on the steady clock when the messages are taken or queued, not from
+   * their timestamps.
+   */
+  std::chrono::nanoseconds min_message_period{0};
+
+  /// Maximum nesting of direct dispatches of the messages published intra process, 0 to queue them.
+  /**
+   * With a value greater than 0, the publishers call the callback on their own thread, inside
+   * publish(), instead of queuing the messages and waking the executor, e.g. for the low latency
+   * of a chain of filters publishing to each other.
+   * The callback must be fast, and thread safe if several threads publish to the topic.
+   * A message is still queued and executed by the executor when the callback group is not added
+   * to an executor, when it is mutually exclusive and one of its callbacks is executing, when
+   * older messages are queued, when the callback is already being dispatched directly, or when
+   * this number of direct dispatches are already nested in the publishing thread.
+   * Once a direct dispatch ends, a mutually exclusive callback group wakes its executor, which
+   * may have skipped its work meanwhile; a reentrant callback group does not need it.
+   * The exceptions thrown by the callback are thrown by publish().
+   *
+   * \sa rclcpp::experimental::SubscriptionIntraProcessBase::set_direct_dispatch()
+   */
+  size_t intra_process_direct_dispatch_depth = 0;
+
+  /// Time budget of each execution of the subscription, 0 to use the one of its callback group.
+  /**
+   * Only applies to the messages received through the middleware, the messages published
+   * intra process are executed with the budget of the callback group.
+   *
+   * \sa rclcpp::CallbackGroup::set_execution_budget()
+   */
+  std::chrono::nanoseconds execution_budget{0};
+
+  /// Number of serialized messages reused by the subscription, 0 to allocate each of them.
+  /**
+   * Only used by the subscriptions taking serialized messages, including
+   * rclcpp::GenericSubscription.
+   * The messages released by the callback are kept with their buffers, so taking serialized
+   * messages does not allocate once the buffers reached the size of the largest message.
+   *
+   * \sa rclcpp::message_memory_strategy::MessageMemoryStrategy::set_serialized_message_pool_size()
+   */
+  size_t serialized_message_pool_size = 0;
+
+  /// Optional codec decoding the messages received inter process, nullptr by default.
+  /**
+   * Only used by rclcpp::GenericSubscription.
+   * The messages encoded by the publishers using a codec of the same name are decoded before
+   * the callback, the messages which were not encoded are given to it as they are, and the
+   * messages encoded by another codec are dropped.
+   *
+   * \sa rclcpp::SerializedMessageCodec
+   */
+  std::shared_ptr<rclcpp::SerializedMessageCodec> serialized_message_codec = nullptr;
+
   /// Optional RMW implementation specific payload to be used during creation of the subscription.
   std::shared_ptr<rclcpp::detail::RMWImplementationSpecificSubscriptionPayload>
   rmw_implementation_payload = nullptr;
 
+  /// Optional predicate selecting the messages given to the callback.
+  /**
+   * It is called with a pointer to each ROS message received by the subscription, before the
+   * callback, and the messages for which it returns false are dropped.
+   * Messages published intra process are filtered on the publishing thread, before they are
+   * queued, so that the dropped messages are neither copied nor wake the executor.
+   * The messages of a type adapted subscription are filtered in their ROS message type.
+   * Serialized messages are not filtered.
+   *
+   * \sa set_message_filter() to set it with a predicate taking the ROS message type.
+   */
+  std::function<bool (const void *)> message_filter = nullptr;
+
+  /// Set the message filter from a predicate taking the ROS message type of the subscription.
+  template<typename ROSMessageT>
+  void
+  set_message_filter(std::function<bool (const ROSMessageT &)> filter)
+  {
+    if (!filter) {
+      message_filter = nullptr;
+      return;
+    }
+    message_filter = [filter = std::move(filter)](const void * message) {
+        return filter(*static_cast<const ROSMessageT *>(message));
+      };
+  }
+
+  /// Optional content filter, selecting the messages given to the callback by their fields.
+  /**
+   * The filter expression has the syntax of the DDS content filtered topics, see
+   * rclcpp::ContentFilter, e.g. "data > %0" with the parameter "10".
+   * The messages are filtered by rclcpp, as the message filter is, before the callback and
+   * on the publishing thread for the messages published intra process.
+   * It can be replaced at runtime, see rclcpp::SubscriptionBase::set_content_filter().
+   * Serialized messages are not filtered.
+   */
+  ContentFilterOptions content_filter_options;
+
   // Options to configure topic statistics collector in the subscription.
   struct TopicStatisticsOptions
   {
@@ -76,6 +214,15 @@ struct SubscriptionOptionsBase
     // Topic statistics publication period in ms. Defaults to one second.
     // Only values greater than zero are allowed.
     std::chrono::milliseconds publish_period{std::chrono::seconds(1)};
+
+    // Measure the received messages with atomic counters instead of taking a lock, so that
+    // multiple threads receiving messages do not contend. Defaults to disabled.
+    bool lock_free_accumulation = false;
+
+    // Also publish the 50th, 90th, 99th and 99.9th percentiles of the measurements, as metrics
+    // suffixed with _p50, _p90, _p99 and _p99_9 whose maximum is the percentile. They are
+    // counted in fixed-size histograms, with a relative error below 1%. Defaults to disabled.
+    bool report_percentiles = false;
   };
 
   TopicStatisticsOptions topic_stats_options;
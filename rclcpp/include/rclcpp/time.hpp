@@ -21,6 +21,7 @@
 
 #include "rcl/time.h"
 
+#include "rclcpp/detail/time_arithmetic.hpp"
 #include "rclcpp/duration.hpp"
 
 namespace rclcpp
@@ -50,7 +51,6 @@ public:
    * \param nanoseconds since time epoch
    * \param clock_type clock type
    */
-  RCLCPP_PUBLIC
   explicit Time(int64_t nanoseconds = 0, rcl_clock_type_t clock_type = RCL_SYSTEM_TIME);
 
   /// Copy constructor
@@ -103,46 +103,39 @@ public:
   /**
    * \throws std::runtime_error if the time sources are different
    */
-  RCLCPP_PUBLIC
   bool
   operator==(const rclcpp::Time & rhs) const;
 
-  RCLCPP_PUBLIC
   bool
   operator!=(const rclcpp::Time & rhs) const;
 
   /**
    * \throws std::runtime_error if the time sources are different
    */
-  RCLCPP_PUBLIC
   bool
   operator<(const rclcpp::Time & rhs) const;
 
   /**
    * \throws std::runtime_error if the time sources are different
    */
-  RCLCPP_PUBLIC
   bool
   operator<=(const rclcpp::Time & rhs) const;
 
   /**
    * \throws std::runtime_error if the time sources are different
    */
-  RCLCPP_PUBLIC
   bool
   operator>=(const rclcpp::Time & rhs) const;
 
   /**
    * \throws std::runtime_error if the time sources are different
    */
-  RCLCPP_PUBLIC
   bool
   operator>(const rclcpp::Time & rhs) const;
 
   /**
    * \throws std::overflow_error if addition leads to overflow
    */
-  RCLCPP_PUBLIC
   Time
   operator+(const rclcpp::Duration & rhs) const;
 
@@ -150,36 +143,42 @@ public:
    * \throws std::runtime_error if the time sources are different
    * \throws std::overflow_error if addition leads to overflow
    */
-  RCLCPP_PUBLIC
   Duration
   operator-(const rclcpp::Time & rhs) const;
 
   /**
    * \throws std::overflow_error if addition leads to overflow
    */
-  RCLCPP_PUBLIC
   Time
   operator-(const rclcpp::Duration & rhs) const;
 
   /**
    * \throws std::overflow_error if addition leads to overflow
    */
-  RCLCPP_PUBLIC
   Time &
   operator+=(const rclcpp::Duration & rhs);
 
   /**
    * \throws std::overflow_error if addition leads to overflow
    */
-  RCLCPP_PUBLIC
   Time &
   operator-=(const rclcpp::Duration & rhs);
 
+  /// Add a duration, saturating at the representable limits instead of throwing.
+  /**
+   * Unlike operator+(), it never throws, e.g. to compute the deadlines of a schedule.
+   */
+  Time
+  saturating_add(const rclcpp::Duration & rhs) const noexcept;
+
+  /// Subtract a duration, saturating at the representable limits instead of throwing.
+  Time
+  saturating_sub(const rclcpp::Duration & rhs) const noexcept;
+
   /// Get the nanoseconds since epoch
   /**
    * \return the nanoseconds since epoch as a rcl_time_point_value_t structure.
    */
-  RCLCPP_PUBLIC
   rcl_time_point_value_t
   nanoseconds() const;
 
@@ -206,7 +205,6 @@ public:
   /**
    * \return the clock type
    */
-  RCLCPP_PUBLIC
   rcl_clock_type_t
   get_clock_type() const;
 
@@ -215,12 +213,164 @@ private:
   friend Clock;  // Allow clock to manipulate internal data
 };
 
+// The arithmetic and the comparisons are inline, since they are used on hot paths, e.g. to
+// schedule timers and to compare stamps. The exceptions are thrown out of line.
+
+inline
+Time::Time(int64_t nanoseconds, rcl_clock_type_t clock_type)
+{
+  rcl_time_.nanoseconds = nanoseconds;
+  rcl_time_.clock_type = clock_type;
+}
+
+inline bool
+Time::operator==(const rclcpp::Time & rhs) const
+{
+  if (RCLCPP_DETAIL_UNLIKELY(rcl_time_.clock_type != rhs.rcl_time_.clock_type)) {
+    detail::throw_time_comparison_error();
+  }
+  return rcl_time_.nanoseconds == rhs.rcl_time_.nanoseconds;
+}
+
+inline bool
+Time::operator!=(const rclcpp::Time & rhs) const
+{
+  return !(*this == rhs);
+}
+
+inline bool
+Time::operator<(const rclcpp::Time & rhs) const
+{
+  if (RCLCPP_DETAIL_UNLIKELY(rcl_time_.clock_type != rhs.rcl_time_.clock_type)) {
+    detail::throw_time_comparison_error();
+  }
+  return rcl_time_.nanoseconds < rhs.rcl_time_.nanoseconds;
+}
+
+inline bool
+Time::operator<=(const rclcpp::Time & rhs) const
+{
+  if (RCLCPP_DETAIL_UNLIKELY(rcl_time_.clock_type != rhs.rcl_time_.clock_type)) {
+    detail::throw_time_comparison_error();
+  }
+  return rcl_time_.nanoseconds <= rhs.rcl_time_.nanoseconds;
+}
+
+inline bool
+Time::operator>=(const rclcpp::Time & rhs) const
+{
+  if (RCLCPP_DETAIL_UNLIKELY(rcl_time_.clock_type != rhs.rcl_time_.clock_type)) {
+    detail::throw_time_comparison_error();
+  }
+  return rcl_time_.nanoseconds >= rhs.rcl_time_.nanoseconds;
+}
+
+inline bool
+Time::operator>(const rclcpp::Time & rhs) const
+{
+  if (RCLCPP_DETAIL_UNLIKELY(rcl_time_.clock_type != rhs.rcl_time_.clock_type)) {
+    detail::throw_time_comparison_error();
+  }
+  return rcl_time_.nanoseconds > rhs.rcl_time_.nanoseconds;
+}
+
+inline Time
+Time::operator+(const rclcpp::Duration & rhs) const
+{
+  rcl_time_point_value_t result = 0;
+  const auto status =
+    detail::checked_add_nanoseconds(rcl_time_.nanoseconds, rhs.nanoseconds(), result);
+  if (RCLCPP_DETAIL_UNLIKELY(detail::NanosecondsArithmeticStatus::Ok != status)) {
+    detail::throw_nanoseconds_arithmetic_error(status, "addition");
+  }
+  return Time(result, rcl_time_.clock_type);
+}
+
+inline Duration
+Time::operator-(const rclcpp::Time & rhs) const
+{
+  if (RCLCPP_DETAIL_UNLIKELY(rcl_time_.clock_type != rhs.rcl_time_.clock_type)) {
+    detail::throw_time_subtraction_error(rcl_time_.clock_type, rhs.rcl_time_.clock_type);
+  }
+  rcl_duration_value_t result = 0;
+  const auto status = detail::checked_subtract_nanoseconds(
+    rcl_time_.nanoseconds, rhs.rcl_time_.nanoseconds, result);
+  if (RCLCPP_DETAIL_UNLIKELY(detail::NanosecondsArithmeticStatus::Ok != status)) {
+    detail::throw_nanoseconds_arithmetic_error(status, "time subtraction");
+  }
+  return Duration::from_nanoseconds(result);
+}
+
+inline Time
+Time::operator-(const rclcpp::Duration & rhs) const
+{
+  rcl_time_point_value_t result = 0;
+  const auto status =
+    detail::checked_subtract_nanoseconds(rcl_time_.nanoseconds, rhs.nanoseconds(), result);
+  if (RCLCPP_DETAIL_UNLIKELY(detail::NanosecondsArithmeticStatus::Ok != status)) {
+    detail::throw_nanoseconds_arithmetic_error(status, "time subtraction");
+  }
+  return Time(result, rcl_time_.clock_type);
+}
+
+inline Time &
+Time::operator+=(const rclcpp::Duration & rhs)
+{
+  const auto status = detail::checked_add_nanoseconds(
+    rcl_time_.nanoseconds, rhs.nanoseconds(), rcl_time_.nanoseconds);
+  if (RCLCPP_DETAIL_UNLIKELY(detail::NanosecondsArithmeticStatus::Ok != status)) {
+    detail::throw_nanoseconds_arithmetic_error(status, "addition");
+  }
+  return *this;
+}
+
+inline Time &
+Time::operator-=(const rclcpp::Duration & rhs)
+{
+  const auto status = detail::checked_subtract_nanoseconds(
+    rcl_time_.nanoseconds, rhs.nanoseconds(), rcl_time_.nanoseconds);
+  if (RCLCPP_DETAIL_UNLIKELY(detail::NanosecondsArithmeticStatus::Ok != status)) {
+    detail::throw_nanoseconds_arithmetic_error(status, "time subtraction");
+  }
+  return *this;
+}
+
+inline Time
+Time::saturating_add(const rclcpp::Duration & rhs) const noexcept
+{
+  return Time(
+    detail::saturating_add_nanoseconds(rcl_time_.nanoseconds, rhs.nanoseconds()),
+    rcl_time_.clock_type);
+}
+
+inline Time
+Time::saturating_sub(const rclcpp::Duration & rhs) const noexcept
+{
+  return Time(
+    detail::saturating_subtract_nanoseconds(rcl_time_.nanoseconds, rhs.nanoseconds()),
+    rcl_time_.clock_type);
+}
+
+inline rcl_time_point_value_t
+Time::nanoseconds() const
+{
+  return rcl_time_.nanoseconds;
+}
+
+inline rcl_clock_type_t
+Time::get_clock_type() const
+{
+  return rcl_time_.clock_type;
+}
+
 /**
  * \throws std::overflow_error if addition leads to overflow
  */
-RCLCPP_PUBLIC
-Time
-operator+(const rclcpp::Duration & lhs, const rclcpp::Time & rhs);
+inline Time
+operator+(const rclcpp::Duration & lhs, const rclcpp::Time & rhs)
+{
+  return rhs + lhs;
+}
 
 }  // namespace rclcpp
 
@@ -136,6 +136,40 @@ public:
   RCLCPP_PUBLIC
   void set_use_clock_thread(bool use_clock_thread);
 
+  /// Get whether the clock subscription is shared with the other nodes of the context
+  RCLCPP_PUBLIC
+  bool get_use_shared_clock_source();
+
+  /// Set whether the clock subscription is shared with the other nodes of the context
+  /**
+   * If true, the time source does not create its own `/clock` subscription, nor clock thread,
+   * when the node uses simulated time.
+   * A single subscription of the context, with a single thread, receives the clock messages and
+   * passes them to all the time sources using it.
+   * It is created with the QoS of the first time source using it, and the QoS overrides of the
+   * nodes do not apply to it.
+   *
+   * It applies the next time the node starts using simulated time, or is attached.
+   */
+  RCLCPP_PUBLIC
+  void set_use_shared_clock_source(bool use_shared_clock_source);
+
+  /// Get whether the time source uses the infrastructure shared by the nodes of the context
+  RCLCPP_PUBLIC
+  bool get_use_shared_infrastructure();
+
+  /// Set whether the time source uses the infrastructure shared by the nodes of the context
+  /**
+   * If true, the time source receives the parameter events of its node from the
+   * `/parameter_events` subscription shared by the nodes of the context, instead of its own,
+   * and uses the shared `/clock` subscription, see set_use_shared_clock_source().
+   * See also rclcpp::NodeOptions::use_shared_infrastructure().
+   *
+   * It applies the next time a node is attached.
+   */
+  RCLCPP_PUBLIC
+  void set_use_shared_infrastructure(bool use_shared_infrastructure);
+
   /// Check if the clock thread is joinable
   RCLCPP_PUBLIC
   bool clock_thread_is_joinable();
@@ -145,6 +179,18 @@ public:
   ~TimeSource();
 
 private:
+  // Publish the ROS time override of a clock for Clock::now(), see ClocksState::set_clock().
+  RCLCPP_LOCAL
+  static void
+  set_ros_time_override_snapshot(
+    rclcpp::Clock & clock, bool ros_time_active, rcl_time_point_value_t nanoseconds) noexcept;
+
+  // Return true if the ROS time override of a clock is active and has the given time.
+  RCLCPP_LOCAL
+  static bool
+  ros_time_override_snapshot_equals(
+    const rclcpp::Clock & clock, rcl_time_point_value_t nanoseconds) noexcept;
+
   class ClocksState;
   std::shared_ptr<ClocksState> clocks_state_;
 
@@ -154,6 +200,9 @@ private:
   // Preserve the arguments received by the constructor for reuse at runtime
   bool constructed_use_clock_thread_;
   rclcpp::QoS constructed_qos_;
+
+  bool use_shared_clock_source_{false};
+  bool use_shared_infrastructure_{false};
 };
 
 }  // namespace rclcpp
@@ -17,8 +17,10 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <thread>
 #include <type_traits>
@@ -29,6 +31,7 @@
 #include "rclcpp/function_traits.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/rate.hpp"
+#include "rclcpp/tracing.hpp"
 #include "rclcpp/utilities.hpp"
 #include "rclcpp/visibility_control.hpp"
 #include "tracetools/tracetools.h"
@@ -43,6 +46,33 @@
 namespace rclcpp
 {
 
+/// What a timer does when its callback is called after one or more of its next deadlines.
+/**
+ * The deadlines of a timer are absolute, at a whole number of periods from the time the timer
+ * was created or reset, so a late call does not delay the following deadlines.
+ */
+enum class TimerOverrunPolicy
+{
+  /// Call the callback once and drop the missed deadlines, keeping the phase of the timer.
+  Skip,
+  /// Call the callback once for the late deadline and once for each missed deadline, in a row.
+  CatchUp,
+  /// Call the callback once for all the missed deadlines, and restart the period from the call.
+  Coalesce,
+};
+
+/// Lateness of the calls of a timer, see rclcpp::TimerBase::get_statistics().
+struct TimerStatistics
+{
+  /// Number of calls of the timer, the repeated calls of the CatchUp policy excluded.
+  uint64_t call_count = 0u;
+  /// Number of deadlines which passed while the timer was waiting for a call.
+  uint64_t missed_deadline_count = 0u;
+  /// Sum of the delays from the deadlines to the calls, the mean jitter times call_count.
+  std::chrono::nanoseconds total_lateness{0};
+  std::chrono::nanoseconds max_lateness{0};
+};
+
 class TimerBase
 {
 public:
@@ -85,12 +115,34 @@ public:
 
   /// Reset the timer.
   /**
+   * Calls the callback set with set_on_reset_callback(), if any.
+   *
    * \throws std::runtime_error if the rcl_timer_reset returns a failure
    */
   RCLCPP_PUBLIC
   void
   reset();
 
+  /// Set a callback to be called after the timer was reset.
+  /**
+   * This lets e.g. a rclcpp::experimental::TimersManager reschedule the timer, since a reset
+   * changes its next call time.
+   * The callback is called from the thread calling reset(), and replaces any previous one.
+   *
+   * \param[in] callback functor to be called after the timer was reset
+   */
+  RCLCPP_PUBLIC
+  void
+  set_on_reset_callback(std::function<void()> callback);
+
+  /// Unset the callback registered with set_on_reset_callback().
+  /**
+   * Once this returns, the previous callback is neither running nor called anymore.
+   */
+  RCLCPP_PUBLIC
+  void
+  clear_on_reset_callback();
+
   /// Indicate that we're about to execute the callback.
   /**
    * The multithreaded executor takes advantage of this to avoid scheduling
@@ -107,6 +159,15 @@ public:
   virtual void
   execute_callback() = 0;
 
+  /// Drop the execution of the callback which call() was made for.
+  /**
+   * Used instead of execute_callback(), e.g. by an overloaded executor shedding the execution,
+   * so that the deadlines the timer would have caught up on are dropped as well.
+   */
+  RCLCPP_PUBLIC
+  void
+  skip_callback();
+
   RCLCPP_PUBLIC
   std::shared_ptr<const rcl_timer_t>
   get_timer_handle();
@@ -134,6 +195,51 @@ public:
   RCLCPP_PUBLIC
   bool is_ready();
 
+  /// Set what the timer does when it is called late, by default TimerOverrunPolicy::Skip.
+  /**
+   * It can be called from any thread, and applies from the next call of the timer.
+   */
+  RCLCPP_PUBLIC
+  void
+  set_overrun_policy(TimerOverrunPolicy policy);
+
+  RCLCPP_PUBLIC
+  TimerOverrunPolicy
+  get_overrun_policy() const;
+
+  /// Set how late the timer may be called, to be called together with other timers.
+  /**
+   * Executors scheduling timers with a rclcpp::experimental::TimersManager, e.g. the
+   * rclcpp::executors::EventsExecutor, wake up at the latest at the deadline of a timer plus its
+   * slack, and then call every timer whose deadline passed.
+   * Timers with close deadlines are thus called in one wake-up, rather than each in its own.
+   * Other executors wait for the deadline and ignore the slack.
+   *
+   * It can be called from any thread, and applies from the next deadline of the timer.
+   *
+   * \param[in] slack how late the timer may be called, 0 by default.
+   * \throws std::invalid_argument if slack is negative.
+   */
+  RCLCPP_PUBLIC
+  void
+  set_slack(std::chrono::nanoseconds slack);
+
+  RCLCPP_PUBLIC
+  std::chrono::nanoseconds
+  get_slack() const;
+
+  /// Return the lateness of the calls of the timer since it was created or its statistics reset.
+  /**
+   * It can be called from any thread, while the timer is executed.
+   */
+  RCLCPP_PUBLIC
+  TimerStatistics
+  get_statistics() const;
+
+  RCLCPP_PUBLIC
+  void
+  reset_statistics();
+
   /// Exchange the "in use by wait set" state for this timer.
   /**
    * This is used to ensure this timer is not used by multiple
@@ -149,10 +255,37 @@ public:
   exchange_in_use_by_wait_set_state(bool in_use_state);
 
 protected:
+  /// Notify the rcl timer of the call, record its lateness and apply the overrun policy.
+  /**
+   * \return `false` if the timer was canceled, `true` otherwise.
+   * \throws std::runtime_error if it failed to notify the rcl timer of the call
+   */
+  RCLCPP_PUBLIC
+  bool
+  call_timer_handle();
+
+  /// Return how many times execute_callback() must call the callback, which resets it to 1.
+  RCLCPP_PUBLIC
+  uint64_t
+  take_callback_call_count();
+
   Clock::SharedPtr clock_;
   std::shared_ptr<rcl_timer_t> timer_handle_;
 
+  std::atomic<TimerOverrunPolicy> overrun_policy_{TimerOverrunPolicy::Skip};
+  std::atomic<int64_t> slack_{0};
+  // Deadlines to catch up on in the next execution, see TimerOverrunPolicy::CatchUp.
+  std::atomic<uint64_t> catch_up_call_count_{0u};
+
+  std::atomic<uint64_t> call_count_{0u};
+  std::atomic<uint64_t> missed_deadline_count_{0u};
+  std::atomic<int64_t> total_lateness_{0};
+  std::atomic<int64_t> max_lateness_{0};
+
   std::atomic<bool> in_use_by_wait_set_{false};
+
+  std::mutex on_reset_callback_mutex_;
+  std::function<void()> on_reset_callback_{nullptr};
 };
 
 
@@ -209,14 +342,7 @@ public:
   bool
   call() override
   {
-    rcl_ret_t ret = rcl_timer_call(timer_handle_.get());
-    if (ret == RCL_RET_TIMER_CANCELED) {
-      return false;
-    }
-    if (ret != RCL_RET_OK) {
-      throw std::runtime_error("Failed to notify timer that callback occurred");
-    }
-    return true;
+    return call_timer_handle();
   }
 
   /**
@@ -225,9 +351,17 @@ public:
   void
   execute_callback() override
   {
-    TRACEPOINT(callback_start, static_cast<const void *>(&callback_), false);
-    execute_callback_delegate<>();
-    TRACEPOINT(callback_end, static_cast<const void *>(&callback_));
+    const uint64_t callback_call_count = take_callback_call_count();
+    for (uint64_t i = 0u; i < callback_call_count; ++i) {
+      if (i > 0u && is_canceled()) {
+        break;
+      }
+      TRACEPOINT(callback_start, static_cast<const void *>(&callback_), false);
+      rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackStart, &callback_, 0, false);
+      execute_callback_delegate<>();
+      TRACEPOINT(callback_end, static_cast<const void *>(&callback_));
+      rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::CallbackEnd, &callback_, 0, 0);
+    }
   }
 
   // void specialization
@@ -0,0 +1,217 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__TIMER_WHEEL_HPP_
+#define RCLCPP__TIMER_WHEEL_HPP_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rcl/wait.h"
+
+#include "rclcpp/context.hpp"
+#include "rclcpp/contexts/default_context.hpp"
+#include "rclcpp/guard_condition.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/timer.hpp"
+#include "rclcpp/visibility_control.hpp"
+#include "rclcpp/waitable.hpp"
+
+namespace rclcpp
+{
+
+/// Waitable hosting many cheap software timers on a hierarchical timer wheel.
+/**
+ * Each rclcpp::TimerBase owns an rcl timer, which the executor adds to its wait set and
+ * checks after every wait, so thousands of low rate timers (timeouts, watchdogs, ...) make
+ * every wait expensive.
+ * The timers of a TimerWheel are entries of a wheel of slots instead: adding, restarting or
+ * cancelling one is O(1), and the wheel appears in the wait set as a single rcl timer,
+ * ticking only while the wheel holds timers.
+ *
+ * The wheel has 4 levels of 256 slots, the slots of the first level last one tick and those of
+ * each following level span a whole revolution of the previous one.
+ * The timers expire on the first tick at or after their deadline, so the tick is their
+ * granularity, and they are measured on the steady clock.
+ *
+ * The wheel is added to a node like any Waitable, and its callbacks are executed in the
+ * callback group it is added to:
+ *
+ * ```cpp
+ * auto wheel = std::make_shared<rclcpp::TimerWheel>();
+ * node->get_node_waitables_interface()->add_waitable(wheel, nullptr);
+ * auto id = wheel->add_timer(5s, [](){RCLCPP_WARN(logger, "watchdog expired");});
+ * // ... on each heartbeat
+ * wheel->restart_timer(id, 5s);
+ * ```
+ */
+class TimerWheel : public rclcpp::Waitable
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(TimerWheel)
+
+  /// Identifier of a timer of the wheel, never 0.
+  using TimerId = uint64_t;
+  using TimerCallback = std::function<void ()>;
+
+  /// Constructor.
+  /**
+   * \param[in] context the context of the executor waiting on the wheel.
+   * \param[in] tick the duration of a tick of the wheel.
+   * \throws std::invalid_argument if the tick is not positive.
+   */
+  RCLCPP_PUBLIC
+  explicit TimerWheel(
+    rclcpp::Context::SharedPtr context = rclcpp::contexts::get_global_default_context(),
+    std::chrono::nanoseconds tick = std::chrono::milliseconds(10));
+
+  RCLCPP_PUBLIC
+  virtual ~TimerWheel() = default;
+
+  /// Add a timer to the wheel.
+  /**
+   * \param[in] delay time until the first expiration of the timer.
+   * \param[in] callback called by the executor on each expiration.
+   * \param[in] period period of the following expirations, rounded up to whole ticks, 0 for
+   *   a one shot timer.
+   * \return the identifier of the timer.
+   * \throws std::invalid_argument if the callback is empty or the period is negative.
+   */
+  RCLCPP_PUBLIC
+  TimerId
+  add_timer(
+    std::chrono::nanoseconds delay,
+    TimerCallback callback,
+    std::chrono::nanoseconds period = std::chrono::nanoseconds(0));
+
+  /// Move the next expiration of a timer to `delay` from now.
+  /**
+   * \return false if the timer is unknown, e.g. it was cancelled or it was a one shot timer
+   *   which has expired.
+   */
+  RCLCPP_PUBLIC
+  bool
+  restart_timer(TimerId id, std::chrono::nanoseconds delay);
+
+  /// Remove a timer from the wheel.
+  /**
+   * A timer cancelled while its expiration is being executed by another thread may still be
+   * called once.
+   * \return false if the timer is unknown.
+   */
+  RCLCPP_PUBLIC
+  bool
+  cancel_timer(TimerId id);
+
+  /// Return the number of timers in the wheel.
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_timers() const;
+
+  /// Return the duration of a tick of the wheel.
+  RCLCPP_PUBLIC
+  std::chrono::nanoseconds
+  get_tick() const;
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_ready_timers() override {return 1;}
+
+  RCLCPP_PUBLIC
+  size_t
+  get_number_of_ready_guard_conditions() override {return 1;}
+
+  RCLCPP_PUBLIC
+  bool
+  add_to_wait_set(rcl_wait_set_t * wait_set) override;
+
+  RCLCPP_PUBLIC
+  bool
+  is_ready(rcl_wait_set_t * wait_set) override;
+
+  RCLCPP_PUBLIC
+  std::shared_ptr<void>
+  take_data() override;
+
+  RCLCPP_PUBLIC
+  void
+  execute(std::shared_ptr<void> & data) override;
+
+private:
+  static constexpr size_t kSlotBits = 8;
+  static constexpr size_t kSlotsPerLevel = size_t(1) << kSlotBits;
+  static constexpr size_t kLevels = 4;
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  struct Entry
+  {
+    std::shared_ptr<const TimerCallback> callback;
+    uint64_t expiry_tick{0};
+    uint64_t period_ticks{0};
+    uint32_t generation{0};
+    uint32_t slot{kNone};
+    uint32_t previous{kNone};
+    uint32_t next{kNone};
+  };
+
+  uint64_t
+  now_tick() const;
+
+  uint64_t
+  deadline_tick(std::chrono::nanoseconds delay) const;
+
+  Entry *
+  find(TimerId id);
+
+  void
+  link(uint32_t index);
+
+  void
+  unlink(uint32_t index);
+
+  void
+  release(uint32_t index);
+
+  void
+  cascade(size_t level);
+
+  void
+  advance(uint64_t tick, std::vector<std::shared_ptr<const TimerCallback>> & expired);
+
+  void
+  start_ticking();
+
+  const std::chrono::nanoseconds tick_;
+  const std::chrono::steady_clock::time_point start_;
+
+  rclcpp::TimerBase::SharedPtr tick_timer_;
+  rclcpp::GuardCondition guard_condition_;
+
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> free_entries_;
+  std::array<uint32_t, kLevels * kSlotsPerLevel> slots_;
+  uint64_t current_tick_{0};
+  size_t size_{0};
+};
+
+}  // namespace rclcpp
+
+#endif  // RCLCPP__TIMER_WHEEL_HPP_
@@ -0,0 +1,164 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__TOPIC_STATISTICS__ATOMIC_STATISTICS_ACCUMULATOR_HPP_
+#define RCLCPP__TOPIC_STATISTICS__ATOMIC_STATISTICS_ACCUMULATOR_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+#include "libstatistics_collector/moving_average_statistics/types.hpp"
+
+namespace rclcpp
+{
+namespace topic_statistics
+{
+
+/// Accumulator of the statistics of a measurement, which never blocks while adding samples.
+/**
+ * Samples are added to one of two banks of atomic counters, while the other bank is read and
+ * cleared when the statistics of the window are taken, so that no sample is split across two
+ * windows.
+ * Adding samples is lock-free and can be done from any number of threads concurrently, taking
+ * the statistics waits for the samples being added to the bank it reads.
+ */
+class AtomicStatisticsAccumulator
+{
+public:
+  using StatisticData = libstatistics_collector::moving_average_statistics::StatisticData;
+
+  /// Add a sample.
+  void
+  add_measurement(double value)
+  {
+    Bank * bank;
+    while (true) {
+      bank = &banks_[active_bank_.load()];
+      bank->writers.fetch_add(1);
+      // The bank may have been swapped after it was loaded, its reader then waits for this
+      // writer, which must use the new bank.
+      if (bank == &banks_[active_bank_.load()]) {
+        break;
+      }
+      bank->writers.fetch_sub(1);
+    }
+    bank->sample_count.fetch_add(1, std::memory_order_relaxed);
+    atomic_add(bank->sum, value);
+    atomic_add(bank->sum_of_squares, value * value);
+    atomic_update(bank->min, value, [](double a, double b) {return a < b;});
+    atomic_update(bank->max, value, [](double a, double b) {return a > b;});
+    bank->writers.fetch_sub(1);
+  }
+
+  /// Return the statistics of the samples added since the last reset, and reset them.
+  StatisticData
+  get_statistics_and_reset()
+  {
+    std::lock_guard<std::mutex> lock(reader_mutex_);
+    const unsigned int bank_index = active_bank_.load();
+    active_bank_.store(1u - bank_index);
+    Bank & bank = banks_[bank_index];
+    while (bank.writers.load() != 0u) {
+      std::this_thread::yield();
+    }
+    StatisticData data = to_statistic_data(bank);
+    bank.clear();
+    return data;
+  }
+
+  /// Return the statistics of the samples added since the last reset.
+  /**
+   * The result is approximate if samples are added concurrently.
+   */
+  StatisticData
+  get_statistics() const
+  {
+    std::lock_guard<std::mutex> lock(reader_mutex_);
+    return to_statistic_data(banks_[active_bank_.load()]);
+  }
+
+private:
+  struct Bank
+  {
+    std::atomic<uint64_t> writers{0u};
+    std::atomic<uint64_t> sample_count{0u};
+    std::atomic<double> sum{0.0};
+    std::atomic<double> sum_of_squares{0.0};
+    std::atomic<double> min{std::numeric_limits<double>::infinity()};
+    std::atomic<double> max{-std::numeric_limits<double>::infinity()};
+
+    void
+    clear()
+    {
+      sample_count.store(0u, std::memory_order_relaxed);
+      sum.store(0.0, std::memory_order_relaxed);
+      sum_of_squares.store(0.0, std::memory_order_relaxed);
+      min.store(std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+      max.store(-std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+    }
+  };
+
+  static void
+  atomic_add(std::atomic<double> & target, double value)
+  {
+    double current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+    }
+  }
+
+  template<typename CompareT>
+  static void
+  atomic_update(std::atomic<double> & target, double value, CompareT better)
+  {
+    double current = target.load(std::memory_order_relaxed);
+    while (better(value, current) &&
+      !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  static StatisticData
+  to_statistic_data(const Bank & bank)
+  {
+    StatisticData data;
+    data.sample_count = bank.sample_count.load(std::memory_order_relaxed);
+    if (data.sample_count == 0u) {
+      return data;
+    }
+    const double count = static_cast<double>(data.sample_count);
+    data.average = bank.sum.load(std::memory_order_relaxed) / count;
+    data.min = bank.min.load(std::memory_order_relaxed);
+    data.max = bank.max.load(std::memory_order_relaxed);
+    const double variance =
+      bank.sum_of_squares.load(std::memory_order_relaxed) / count - data.average * data.average;
+    // Rounding can make the variance of nearly equal samples slightly negative.
+    data.standard_deviation = std::sqrt(std::max(variance, 0.0));
+    return data;
+  }
+
+  Bank banks_[2];
+  std::atomic<unsigned int> active_bank_{0u};
+  /// Serializes the readers, which swap the banks.
+  mutable std::mutex reader_mutex_;
+};
+
+}  // namespace topic_statistics
+}  // namespace rclcpp
+
+#endif  // RCLCPP__TOPIC_STATISTICS__ATOMIC_STATISTICS_ACCUMULATOR_HPP_
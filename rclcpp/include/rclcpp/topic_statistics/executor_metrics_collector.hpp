@@ -0,0 +1,181 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__TOPIC_STATISTICS__EXECUTOR_METRICS_COLLECTOR_HPP_
+#define RCLCPP__TOPIC_STATISTICS__EXECUTOR_METRICS_COLLECTOR_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rclcpp/create_publisher.hpp"
+#include "rclcpp/create_timer.hpp"
+#include "rclcpp/executor_instrumentation.hpp"
+#include "rclcpp/macros.hpp"
+#include "rclcpp/node_interfaces/get_node_base_interface.hpp"
+#include "rclcpp/node_interfaces/get_node_timers_interface.hpp"
+#include "rclcpp/publisher.hpp"
+#include "rclcpp/qos.hpp"
+#include "rclcpp/time.hpp"
+#include "rclcpp/timer.hpp"
+#include "rclcpp/topic_statistics/atomic_statistics_accumulator.hpp"
+#include "rclcpp/topic_statistics/subscription_topic_statistics.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+#include "statistics_msgs/msg/metrics_message.hpp"
+
+namespace rclcpp
+{
+namespace topic_statistics
+{
+
+/// Executor instrumentation publishing the runtime metrics of an executor.
+/**
+ * Set it as the ExecutorOptions::instrumentation of an executor, of any type, to measure over
+ * each window:
+ *
+ *   - "executor_wait_set_size": number of entities waited on by each wait,
+ *   - "executor_ready_entities": number of entities found ready by each wait,
+ *   - "executor_wait_time": time blocked in each wait, in ms,
+ *   - "executor_execution_time": time of each execution of a ready entity, in ms,
+ *   - "executor_cycle_rate": number of waits per second, and
+ *   - "executor_utilization": percentage of the time of the threads of the executor spent
+ *     executing rather than waiting, which stays low for an executor with threads to spare.
+ *
+ * The measurements are accumulated without locking.
+ * The metrics of a window are published by publish_metrics_and_reset(), usually called by a
+ * timer, see create_executor_metrics_collector(), or returned by collect_metrics_and_reset().
+ */
+class ExecutorMetricsCollector : public rclcpp::ExecutorInstrumentation
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(ExecutorMetricsCollector)
+
+  /// Constructor.
+  /**
+   * \param[in] executor_name name identifying the executor, the measurement source of the
+   *   published messages
+   * \param[in] publisher publisher of the metrics, null if they are only collected
+   */
+  RCLCPP_PUBLIC
+  explicit ExecutorMetricsCollector(
+    const std::string & executor_name,
+    rclcpp::Publisher<statistics_msgs::msg::MetricsMessage>::SharedPtr publisher = nullptr);
+
+  RCLCPP_PUBLIC
+  virtual ~ExecutorMetricsCollector();
+
+  RCLCPP_PUBLIC
+  void
+  on_wait(std::chrono::nanoseconds wait_duration) override;
+
+  RCLCPP_PUBLIC
+  void
+  on_wait_result(size_t wait_set_size, size_t ready_count) override;
+
+  RCLCPP_PUBLIC
+  void
+  on_execute(const rclcpp::ExecutableExecution & execution) override;
+
+  /// Return the metrics measured since the last reset, one message per metric, and reset them.
+  RCLCPP_PUBLIC
+  std::vector<statistics_msgs::msg::MetricsMessage>
+  collect_metrics_and_reset();
+
+  /// Publish the metrics measured since the last reset, and reset them.
+  /**
+   * \throws std::runtime_error if the collector has no publisher
+   */
+  RCLCPP_PUBLIC
+  void
+  publish_metrics_and_reset();
+
+  /// Set the timer calling publish_metrics_and_reset(), canceled with the collector.
+  RCLCPP_PUBLIC
+  void
+  set_publisher_timer(rclcpp::TimerBase::SharedPtr publisher_timer);
+
+private:
+  const std::string executor_name_;
+  rclcpp::Publisher<statistics_msgs::msg::MetricsMessage>::SharedPtr publisher_;
+  rclcpp::TimerBase::SharedPtr publisher_timer_;
+
+  AtomicStatisticsAccumulator wait_set_size_;
+  AtomicStatisticsAccumulator ready_count_;
+  AtomicStatisticsAccumulator wait_time_;
+  AtomicStatisticsAccumulator execution_time_;
+  std::atomic<uint64_t> cycle_count_{0u};
+  std::atomic<int64_t> total_wait_nanoseconds_{0};
+  std::atomic<int64_t> total_execution_nanoseconds_{0};
+
+  /// Protects the window, which is reset by the thread collecting the metrics.
+  std::mutex window_mutex_;
+  rclcpp::Time window_start_;
+  std::chrono::steady_clock::time_point window_steady_start_;
+};
+
+/// Create an ExecutorMetricsCollector publishing periodically with the resources of a node.
+/**
+ * The timer publishing the metrics is executed by the executor spinning the node, which may
+ * be the measured executor.
+ *
+ * \param[in] node node creating the publisher and the timer
+ * \param[in] executor_name name identifying the executor in the published messages
+ * \param[in] topic_name topic of the metrics, the topic statistics one by default
+ * \param[in] publish_period period of the publication of the metrics
+ * \return the collector, to be set as the ExecutorOptions::instrumentation of the executor
+ * \throws std::invalid_argument if the publish period is not positive
+ */
+template<typename NodeT>
+ExecutorMetricsCollector::SharedPtr
+create_executor_metrics_collector(
+  NodeT && node,
+  const std::string & executor_name,
+  const std::string & topic_name = kDefaultPublishTopicName,
+  std::chrono::milliseconds publish_period = kDefaultPublishingPeriod)
+{
+  if (publish_period <= std::chrono::milliseconds(0)) {
+    throw std::invalid_argument(
+            "publish_period must be greater than 0, specified value of " +
+            std::to_string(publish_period.count()) + " ms");
+  }
+  auto publisher = rclcpp::create_publisher<statistics_msgs::msg::MetricsMessage>(
+    node, topic_name, rclcpp::QoS(10));
+  auto collector = std::make_shared<ExecutorMetricsCollector>(executor_name, publisher);
+  std::weak_ptr<ExecutorMetricsCollector> weak_collector(collector);
+  auto timer = rclcpp::create_wall_timer(
+    publish_period,
+    [weak_collector]() {
+      auto collector = weak_collector.lock();
+      if (collector) {
+        collector->publish_metrics_and_reset();
+      }
+    },
+    nullptr,
+    rclcpp::node_interfaces::get_node_base_interface(node).get(),
+    rclcpp::node_interfaces::get_node_timers_interface(node).get());
+  collector->set_publisher_timer(timer);
+  return collector;
+}
+
+}  // namespace topic_statistics
+}  // namespace rclcpp
+
+#endif  // RCLCPP__TOPIC_STATISTICS__EXECUTOR_METRICS_COLLECTOR_HPP_
@@ -0,0 +1,177 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__TOPIC_STATISTICS__HDR_HISTOGRAM_HPP_
+#define RCLCPP__TOPIC_STATISTICS__HDR_HISTOGRAM_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace rclcpp
+{
+namespace topic_statistics
+{
+
+/// Histogram of integer values with a bounded relative error, e.g. latencies in nanoseconds.
+/**
+ * The values are counted in buckets whose width doubles with each power of two, each divided
+ * in 128 sub-buckets, like in HdrHistogram with two significant digits: a value is reported
+ * with a relative error lower than 1%, from 0 to the highest trackable value.
+ * Larger values are counted as the highest trackable value, negative values as 0.
+ *
+ * The memory is allocated when the histogram is constructed, recording a value costs a few
+ * arithmetic operations and one atomic increment, so values can be recorded from any number of
+ * threads concurrently without a lock.
+ * Percentiles taken or a reset done while values are recorded concurrently may or may not
+ * account for the values being recorded.
+ */
+class HdrHistogram
+{
+public:
+  /// Default highest trackable value, about 68 seconds in nanoseconds.
+  static constexpr int64_t kDefaultHighestTrackableValue = int64_t(1) << 36;
+
+  /**
+   * \param[in] highest_trackable_value the largest value which is distinguished
+   * \throws std::invalid_argument if highest_trackable_value is lower than 256
+   */
+  explicit HdrHistogram(int64_t highest_trackable_value = kDefaultHighestTrackableValue)
+  : highest_trackable_value_(highest_trackable_value)
+  {
+    if (highest_trackable_value_ < kSubBucketCount) {
+      throw std::invalid_argument("the highest trackable value must be at least 256");
+    }
+    size_t bucket_count = 1u;
+    while ((kSubBucketCount << (bucket_count - 1u)) <= highest_trackable_value_) {
+      ++bucket_count;
+    }
+    counts_length_ = (bucket_count + 1u) * kSubBucketHalfCount;
+    counts_ = std::make_unique<std::atomic<uint64_t>[]>(counts_length_);
+    reset();
+  }
+
+  /// Count a value.
+  void
+  record(int64_t value)
+  {
+    value = std::clamp<int64_t>(value, 0, highest_trackable_value_);
+    counts_[counts_index(static_cast<uint64_t>(value))].fetch_add(1u, std::memory_order_relaxed);
+    total_count_.fetch_add(1u, std::memory_order_relaxed);
+  }
+
+  /// Return the number of values counted since the last reset.
+  uint64_t
+  get_total_count() const
+  {
+    return total_count_.load(std::memory_order_relaxed);
+  }
+
+  /// Return the value which the given percentage of the counted values are lower or equal to.
+  /**
+   * The returned value is the highest value equivalent to the counted value, i.e. counted in the
+   * same sub-bucket, so that it is never lower than the actual percentile.
+   *
+   * \param[in] percentile the percentage, between 0 and 100, e.g. 99.9
+   * \return the value, or 0 if no value was counted
+   */
+  int64_t
+  get_value_at_percentile(double percentile) const
+  {
+    const uint64_t total_count = get_total_count();
+    if (total_count == 0u) {
+      return 0;
+    }
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    const uint64_t count_at_percentile = std::max<uint64_t>(
+      1u, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(total_count))));
+    uint64_t cumulative_count = 0u;
+    for (size_t i = 0; i < counts_length_; ++i) {
+      cumulative_count += counts_[i].load(std::memory_order_relaxed);
+      if (cumulative_count >= count_at_percentile) {
+        return std::min(highest_equivalent_value(i), highest_trackable_value_);
+      }
+    }
+    // Values were counted concurrently, after the total count was read.
+    return highest_trackable_value_;
+  }
+
+  /// Forget all the counted values.
+  void
+  reset()
+  {
+    for (size_t i = 0; i < counts_length_; ++i) {
+      counts_[i].store(0u, std::memory_order_relaxed);
+    }
+    total_count_.store(0u, std::memory_order_relaxed);
+  }
+
+private:
+  static constexpr int64_t kSubBucketCount = 256;
+  static constexpr size_t kSubBucketHalfCount = 128u;
+  static constexpr unsigned int kSubBucketHalfCountMagnitude = 7u;
+
+  /// Return the index of the highest bit set, value must not be 0.
+  static unsigned int
+  highest_bit(uint64_t value)
+  {
+    unsigned int bit = 0u;
+    for (unsigned int shift = 32u; shift > 0u; shift /= 2u) {
+      if (value >> shift) {
+        value >>= shift;
+        bit += shift;
+      }
+    }
+    return bit;
+  }
+
+  static size_t
+  counts_index(uint64_t value)
+  {
+    // The first bucket spans [0, 256) with 256 sub-buckets, the others [128, 256) << bucket.
+    const unsigned int bucket =
+      highest_bit(value | (kSubBucketCount - 1)) - kSubBucketHalfCountMagnitude;
+    const size_t sub_bucket = static_cast<size_t>(value >> bucket);
+    return (static_cast<size_t>(bucket) << kSubBucketHalfCountMagnitude) + sub_bucket;
+  }
+
+  static int64_t
+  highest_equivalent_value(size_t index)
+  {
+    size_t bucket = index >> kSubBucketHalfCountMagnitude;
+    size_t sub_bucket = (index & (kSubBucketHalfCount - 1u)) + kSubBucketHalfCount;
+    if (bucket == 0u) {
+      // The second half of the first bucket has the same resolution.
+      sub_bucket -= kSubBucketHalfCount;
+    } else {
+      --bucket;
+    }
+    const int64_t lowest = static_cast<int64_t>(sub_bucket) << bucket;
+    return lowest + (int64_t(1) << bucket) - 1;
+  }
+
+  const int64_t highest_trackable_value_;
+  size_t counts_length_;
+  std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+  std::atomic<uint64_t> total_count_{0u};
+};
+
+}  // namespace topic_statistics
+}  // namespace rclcpp
+
+#endif  // RCLCPP__TOPIC_STATISTICS__HDR_HISTOGRAM_HPP_
@@ -0,0 +1,178 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__TOPIC_STATISTICS__PUBLISHER_TOPIC_STATISTICS_HPP_
+#define RCLCPP__TOPIC_STATISTICS__PUBLISHER_TOPIC_STATISTICS_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/time.hpp"
+#include "rclcpp/topic_statistics/atomic_statistics_accumulator.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+#include "statistics_msgs/msg/metrics_message.hpp"
+
+namespace rclcpp
+{
+
+class PublisherBase;
+class TimerBase;
+
+namespace topic_statistics
+{
+
+/// Part of a publication measured by a ScopedPublishMeasurement.
+enum class PublishMeasurementType
+{
+  /// The whole publish call, by the publisher.
+  Publish,
+  /// The publication to the middleware, including the serialization of the message.
+  InterProcessPublish,
+};
+
+/// Class used to collect, measure, and publish the topic statistics of a publisher.
+/**
+ * The statistics are the producer side counterpart of SubscriptionTopicStatistics:
+ *
+ *   - "publish_period": time between the starts of consecutive publish calls, in ms,
+ *   - "publish_duration": time taken by each publish call, in ms,
+ *   - "inter_process_publish_duration": time taken by the middleware to publish a message,
+ *     including its serialization, in ms, and
+ *   - "intra_process_fan_out": number of intra process subscriptions of each message
+ *     published intra process.
+ *
+ * The measurements are accumulated without taking a lock, so that concurrent publishers do not
+ * contend.
+ * They are enabled by PublisherOptionsBase::topic_stats_options.
+ */
+class PublisherTopicStatistics
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(PublisherTopicStatistics)
+
+  /// Constructor.
+  /**
+   * \param[in] source_name the measurement source name of the published messages, which
+   *   identifies the node and the topic of the measured publisher
+   * \param[in] publisher the rclcpp::Publisher<statistics_msgs::msg::MetricsMessage> used to
+   *   publish the statistics, owned by this instance
+   * \throws std::invalid_argument if publisher is null or does not publish MetricsMessage
+   */
+  RCLCPP_PUBLIC
+  PublisherTopicStatistics(
+    const std::string & source_name,
+    std::shared_ptr<rclcpp::PublisherBase> publisher);
+
+  RCLCPP_PUBLIC
+  virtual ~PublisherTopicStatistics();
+
+  /// Start a measurement, see ScopedPublishMeasurement.
+  /**
+   * A publish call made by another publish call of the same publisher on the same thread, e.g.
+   * publish(const MessageT &) forwarding to publish(std::unique_ptr<MessageT>), is not measured.
+   *
+   * \return true if the measurement must be ended with end_measurement()
+   */
+  RCLCPP_PUBLIC
+  bool
+  begin_measurement(PublishMeasurementType type, std::chrono::steady_clock::time_point start);
+
+  /// End a measurement started by begin_measurement().
+  RCLCPP_PUBLIC
+  void
+  end_measurement(PublishMeasurementType type, std::chrono::nanoseconds duration);
+
+  /// Record the number of intra process subscriptions a message is published to.
+  RCLCPP_PUBLIC
+  void
+  record_intra_process_fan_out(size_t subscription_count);
+
+  /// Return the statistics measured since the last reset, one message per metric, and reset them.
+  RCLCPP_PUBLIC
+  std::vector<statistics_msgs::msg::MetricsMessage>
+  collect_metrics_and_reset();
+
+  /// Publish the statistics measured since the last reset, and reset them.
+  RCLCPP_PUBLIC
+  void
+  publish_message_and_reset_measurements();
+
+  /// Set the timer used to publish statistics messages, canceled with this instance.
+  RCLCPP_PUBLIC
+  void
+  set_publisher_timer(std::shared_ptr<rclcpp::TimerBase> publisher_timer);
+
+private:
+  static constexpr int64_t kNoPublication{-1};
+
+  const std::string source_name_;
+  std::shared_ptr<rclcpp::PublisherBase> publisher_;
+  std::shared_ptr<rclcpp::TimerBase> publisher_timer_;
+
+  AtomicStatisticsAccumulator publish_period_;
+  AtomicStatisticsAccumulator publish_duration_;
+  AtomicStatisticsAccumulator inter_process_publish_duration_;
+  AtomicStatisticsAccumulator intra_process_fan_out_;
+  /// Start of the last publish call, in nanoseconds of the steady clock.
+  std::atomic<int64_t> last_publish_nanoseconds_{kNoPublication};
+
+  std::mutex window_mutex_;
+  rclcpp::Time window_start_;
+};
+
+/// Measure a part of a publication, from its construction to its destruction.
+/**
+ * Nothing is measured, not even the time, when the statistics are null, i.e. disabled.
+ */
+class ScopedPublishMeasurement
+{
+public:
+  ScopedPublishMeasurement(PublisherTopicStatistics * statistics, PublishMeasurementType type)
+  : statistics_(statistics), type_(type)
+  {
+    if (statistics_) {
+      start_ = std::chrono::steady_clock::now();
+      if (!statistics_->begin_measurement(type_, start_)) {
+        statistics_ = nullptr;
+      }
+    }
+  }
+
+  ~ScopedPublishMeasurement()
+  {
+    if (statistics_) {
+      statistics_->end_measurement(type_, std::chrono::steady_clock::now() - start_);
+    }
+  }
+
+private:
+  RCLCPP_DISABLE_COPY(ScopedPublishMeasurement)
+
+  PublisherTopicStatistics * statistics_;
+  const PublishMeasurementType type_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace topic_statistics
+}  // namespace rclcpp
+
+#endif  // RCLCPP__TOPIC_STATISTICS__PUBLISHER_TOPIC_STATISTICS_HPP_
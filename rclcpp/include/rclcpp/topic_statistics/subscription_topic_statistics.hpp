@@ -15,7 +15,10 @@
 #ifndef RCLCPP__TOPIC_STATISTICS__SUBSCRIPTION_TOPIC_STATISTICS_HPP_
 #define RCLCPP__TOPIC_STATISTICS__SUBSCRIPTION_TOPIC_STATISTICS_HPP_
 
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -30,6 +33,8 @@
 #include "rclcpp/time.hpp"
 #include "rclcpp/publisher.hpp"
 #include "rclcpp/timer.hpp"
+#include "rclcpp/topic_statistics/atomic_statistics_accumulator.hpp"
+#include "rclcpp/topic_statistics/hdr_histogram.hpp"
 
 #include "statistics_msgs/msg/metrics_message.hpp"
 
@@ -40,10 +45,15 @@ namespace topic_statistics
 
 constexpr const char kDefaultPublishTopicName[]{"/statistics"};
 constexpr const std::chrono::milliseconds kDefaultPublishingPeriod{std::chrono::seconds(1)};
+/// Percentiles reported when enabled, with the suffix of their metric name
+constexpr const std::pair<double, const char *> kReportedPercentiles[]{
+  {50.0, "_p50"}, {90.0, "_p90"}, {99.0, "_p99"}, {99.9, "_p99_9"}};
 
 using libstatistics_collector::collector::GenerateStatisticMessage;
 using statistics_msgs::msg::MetricsMessage;
 using libstatistics_collector::moving_average_statistics::StatisticData;
+namespace topic_statistics_constants =
+  libstatistics_collector::topic_statistics_collector::topic_statistics_constants;
 
 /**
  * Class used to collect, measure, and publish topic statistics data. Current statistics
@@ -75,14 +85,25 @@ public:
    * topic source
    * \param publisher instance constructed by the node in order to publish statistics data.
    * This class owns the publisher.
+   * \param lock_free_accumulation whether the received messages are measured without taking a
+   * lock, see rclcpp::SubscriptionOptionsBase::TopicStatisticsOptions::lock_free_accumulation
+   * \param report_percentiles whether the percentiles of the measurements are published, see
+   * rclcpp::SubscriptionOptionsBase::TopicStatisticsOptions::report_percentiles
    * \throws std::invalid_argument if publisher pointer is nullptr
    */
   SubscriptionTopicStatistics(
     const std::string & node_name,
-    rclcpp::Publisher<statistics_msgs::msg::MetricsMessage>::SharedPtr publisher)
+    rclcpp::Publisher<statistics_msgs::msg::MetricsMessage>::SharedPtr publisher,
+    bool lock_free_accumulation = false,
+    bool report_percentiles = false)
   : node_name_(node_name),
-    publisher_(std::move(publisher))
+    publisher_(std::move(publisher)),
+    lock_free_accumulation_(lock_free_accumulation)
   {
+    if (report_percentiles) {
+      message_age_histogram_ = std::make_unique<HdrHistogram>();
+      message_period_histogram_ = std::make_unique<HdrHistogram>();
+    }
     // TODO(dbbonnie): ros-tooling/aws-roadmap/issues/226, received message age
 
     if (nullptr == publisher_) {
@@ -99,7 +120,8 @@ public:
 
   /// Handle a message received by the subscription to collect statistics.
   /**
-   * This method acquires a lock to prevent race conditions to collectors list.
+   * This method acquires a lock to prevent race conditions to collectors list, unless the
+   * accumulation is lock-free.
    *
    * \param received_message the message received by the subscription
    * \param now_nanoseconds current time in nanoseconds
@@ -108,12 +130,58 @@ public:
     const CallbackMessageT & received_message,
     const rclcpp::Time now_nanoseconds) const
   {
+    if (message_age_histogram_) {
+      record_percentiles(received_message, now_nanoseconds.nanoseconds());
+    }
+    if (lock_free_accumulation_) {
+      accumulate_message(received_message, now_nanoseconds.nanoseconds());
+      return;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     for (const auto & collector : subscriber_statistics_collectors_) {
       collector->OnMessageReceived(received_message, now_nanoseconds.nanoseconds());
     }
   }
 
+  /// Handle a message received intra process to collect statistics.
+  /**
+   * The message is measured as by handle_message(), except that the age of a message without a
+   * header is measured from its publication, since the intra process manager timestamps the
+   * messages it delivers.
+   *
+   * \param received_message the message received by the subscription
+   * \param now_nanoseconds current time in nanoseconds
+   * \param publication_nanoseconds time of the publication of the message in nanoseconds since
+   * epoch, 0 if unknown
+   */
+  void handle_intra_process_message(
+    const CallbackMessageT & received_message,
+    const rclcpp::Time now_nanoseconds,
+    rcl_time_point_value_t publication_nanoseconds) const
+  {
+    handle_message(received_message, now_nanoseconds);
+    if (0 == publication_nanoseconds ||
+      libstatistics_collector::topic_statistics_collector::TimeStamp<CallbackMessageT>::value(
+        received_message).first)
+    {
+      return;
+    }
+    const std::chrono::nanoseconds age_nanos{
+      now_nanoseconds.nanoseconds() - publication_nanoseconds};
+    const double age_millis = std::chrono::duration<double, std::milli>(age_nanos).count();
+    if (message_age_histogram_) {
+      message_age_histogram_->record(age_nanos.count());
+    }
+    if (lock_free_accumulation_) {
+      message_age_.add_measurement(age_millis);
+      return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (received_message_age_) {
+      received_message_age_->AcceptData(age_millis);
+    }
+  }
+
   /// Set the timer used to publish statistics messages.
   /**
    * \param publisher_timer the timer to fire the publisher, created by the node
@@ -132,7 +200,24 @@ public:
     std::vector<MetricsMessage> msgs;
     rclcpp::Time window_end{get_current_nanoseconds_since_epoch()};
 
-    {
+    if (lock_free_accumulation_) {
+      msgs.push_back(
+        libstatistics_collector::collector::GenerateStatisticMessage(
+          node_name_,
+          topic_statistics_constants::kMsgAgeStatName,
+          topic_statistics_constants::kMillisecondUnitName,
+          window_start_,
+          window_end,
+          message_age_.get_statistics_and_reset()));
+      msgs.push_back(
+        libstatistics_collector::collector::GenerateStatisticMessage(
+          node_name_,
+          topic_statistics_constants::kMsgPeriodStatName,
+          topic_statistics_constants::kMillisecondUnitName,
+          window_start_,
+          window_end,
+          message_period_.get_statistics_and_reset()));
+    } else {
       std::lock_guard<std::mutex> lock(mutex_);
       for (auto & collector : subscriber_statistics_collectors_) {
         const auto collected_stats = collector->GetStatisticsResults();
@@ -148,6 +233,13 @@ public:
         msgs.push_back(message);
       }
     }
+    if (message_age_histogram_) {
+      add_percentile_messages(
+        topic_statistics_constants::kMsgAgeStatName, *message_age_histogram_, window_end, msgs);
+      add_percentile_messages(
+        topic_statistics_constants::kMsgPeriodStatName, *message_period_histogram_, window_end,
+        msgs);
+    }
 
     for (auto & msg : msgs) {
       publisher_->publish(msg);
@@ -165,6 +257,11 @@ protected:
   std::vector<StatisticData> get_current_collector_data() const
   {
     std::vector<StatisticData> data;
+    if (lock_free_accumulation_) {
+      data.push_back(message_age_.get_statistics());
+      data.push_back(message_period_.get_statistics());
+      return data;
+    }
     std::lock_guard<std::mutex> lock(mutex_);
     for (const auto & collector : subscriber_statistics_collectors_) {
       data.push_back(collector->GetStatisticsResults());
@@ -172,7 +269,91 @@ protected:
     return data;
   }
 
+  /// Return the histogram of the received message ages in nanoseconds, if percentiles are reported.
+  const HdrHistogram * get_message_age_histogram() const
+  {
+    return message_age_histogram_.get();
+  }
+
+  /// Return the histogram of the received message periods in nanoseconds, if percentiles are
+  /// reported.
+  const HdrHistogram * get_message_period_histogram() const
+  {
+    return message_period_histogram_.get();
+  }
+
 private:
+  /// Record the age and the period of a received message in the histograms.
+  void record_percentiles(
+    const CallbackMessageT & received_message,
+    rcl_time_point_value_t now_nanoseconds) const
+  {
+    const auto timestamp =
+      libstatistics_collector::topic_statistics_collector::TimeStamp<CallbackMessageT>::value(
+      received_message);
+    if (timestamp.first) {
+      message_age_histogram_->record(now_nanoseconds - timestamp.second);
+    }
+    const rcl_time_point_value_t previous_nanoseconds =
+      last_histogram_nanoseconds_.exchange(now_nanoseconds);
+    if (previous_nanoseconds != kNoMessageReceived) {
+      message_period_histogram_->record(now_nanoseconds - previous_nanoseconds);
+    }
+  }
+
+  /// Add a message for each reported percentile of a histogram, and reset the histogram.
+  /**
+   * The percentile is the maximum of its message, e.g. the p99 message has the maximum of the
+   * 99% lowest measurements, along with the sample count of the window.
+   */
+  void add_percentile_messages(
+    const std::string & metric_name,
+    HdrHistogram & histogram,
+    const rclcpp::Time & window_end,
+    std::vector<MetricsMessage> & msgs) const
+  {
+    StatisticData data;
+    data.sample_count = histogram.get_total_count();
+    for (const auto & percentile : kReportedPercentiles) {
+      if (data.sample_count > 0u) {
+        data.max = std::chrono::duration<double, std::milli>(
+          std::chrono::nanoseconds(histogram.get_value_at_percentile(percentile.first))).count();
+      }
+      msgs.push_back(
+        libstatistics_collector::collector::GenerateStatisticMessage(
+          node_name_,
+          metric_name + percentile.second,
+          topic_statistics_constants::kMillisecondUnitName,
+          window_start_,
+          window_end,
+          data));
+    }
+    histogram.reset();
+  }
+
+  /// Measure the age and the period of a received message, without taking a lock.
+  void accumulate_message(
+    const CallbackMessageT & received_message,
+    rcl_time_point_value_t now_nanoseconds) const
+  {
+    // Same measurements as the ReceivedMessageAgeCollector and ReceivedMessagePeriodCollector.
+    const auto timestamp =
+      libstatistics_collector::topic_statistics_collector::TimeStamp<CallbackMessageT>::value(
+      received_message);
+    if (timestamp.first) {
+      const std::chrono::nanoseconds age_nanos{now_nanoseconds - timestamp.second};
+      message_age_.add_measurement(
+        std::chrono::duration<double, std::milli>(age_nanos).count());
+    }
+    const rcl_time_point_value_t previous_nanoseconds =
+      last_message_nanoseconds_.exchange(now_nanoseconds);
+    if (previous_nanoseconds != kNoMessageReceived) {
+      const std::chrono::nanoseconds period_nanos{now_nanoseconds - previous_nanoseconds};
+      message_period_.add_measurement(
+        std::chrono::duration<double, std::milli>(period_nanos).count());
+    }
+  }
+
   /// Construct and start all collectors and set window_start_.
   /**
    * This method acquires a lock to prevent race conditions to collectors list.
@@ -181,6 +362,7 @@ private:
   {
     auto received_message_age = std::make_unique<ReceivedMessageAge>();
     received_message_age->Start();
+    received_message_age_ = received_message_age.get();
     subscriber_statistics_collectors_.emplace_back(std::move(received_message_age));
 
     auto received_message_period = std::make_unique<ReceivedMessagePeriod>();
@@ -205,6 +387,7 @@ private:
         collector->Stop();
       }
 
+      received_message_age_ = nullptr;
       subscriber_statistics_collectors_.clear();
     }
 
@@ -230,6 +413,8 @@ private:
   mutable std::mutex mutex_;
   /// Collection of statistics collectors
   std::vector<std::unique_ptr<TopicStatsCollector>> subscriber_statistics_collectors_{};
+  /// Received message age collector, among the collectors, fed by intra process messages too
+  ReceivedMessageAge * received_message_age_{nullptr};
   /// Node name used to generate topic statistics messages to be published
   const std::string node_name_;
   /// Publisher, created by the node, used to publish topic statistics messages
@@ -238,6 +423,20 @@ private:
   rclcpp::TimerBase::SharedPtr publisher_timer_;
   /// The start of the collection window, used in the published topic statistics message
   rclcpp::Time window_start_;
+
+  /// Whether the measurements below are used instead of the collectors
+  const bool lock_free_accumulation_;
+  static constexpr rcl_time_point_value_t kNoMessageReceived{-1};
+  /// Time at which the last message was received, for the lock-free message period
+  mutable std::atomic<rcl_time_point_value_t> last_message_nanoseconds_{kNoMessageReceived};
+  /// Lock-free measurements of the received message age and period
+  mutable AtomicStatisticsAccumulator message_age_;
+  mutable AtomicStatisticsAccumulator message_period_;
+  /// Time at which the last message was received, for the message period histogram
+  mutable std::atomic<rcl_time_point_value_t> last_histogram_nanoseconds_{kNoMessageReceived};
+  /// Histograms of the received message age and period, null unless percentiles are reported
+  std::unique_ptr<HdrHistogram> message_age_histogram_;
+  std::unique_ptr<HdrHistogram> message_period_histogram_;
 };
 }  // namespace topic_statistics
 }  // namespace rclcpp
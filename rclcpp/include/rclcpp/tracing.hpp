@@ -0,0 +1,254 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__TRACING_HPP_
+#define RCLCPP__TRACING_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "rclcpp/macros.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace tracing
+{
+
+/// Kind of a TraceEvent, the meaning of its handle, source and data depends on it.
+enum class TraceEventType : uint32_t
+{
+  /// A message published to the middleware.
+  /** handle: rcl_publisher_t, data: address of the message. */
+  Publish = 0,
+  /// A message published intra process.
+  /** source: intra process id of the publisher, data: its publication sequence number. */
+  IntraProcessPublish = 1,
+  /// A message taken from the middleware.
+  /** handle: rcl_subscription_t, data: address of the message. */
+  Take = 2,
+  /// A message stored in the buffer of an intra process subscription.
+  /**
+   * handle: the rclcpp::Waitable of the subscription, source and data: the intra process id of
+   * the publisher and the publication sequence number of the message.
+   */
+  IntraProcessEnqueue = 3,
+  /// A message taken from the buffer of an intra process subscription, same fields as enqueue.
+  IntraProcessDequeue = 4,
+  /// An executor starting the execution of a ready entity.
+  /**
+   * handle: the rclcpp::TimerBase, SubscriptionBase, ServiceBase, ClientBase or Waitable,
+   * data: its rclcpp::ExecutableType.
+   */
+  ExecutorDispatch = 5,
+  /// A user callback starting.
+  /**
+   * handle: the callback, as for the callback_start tracepoint, data: 1 if it executes a
+   * message received intra process.
+   */
+  CallbackStart = 6,
+  /// A user callback ending, handle: the callback.
+  CallbackEnd = 7,
+};
+
+/// Fixed size record of an event, as written by the RingBufferTraceBackend.
+/**
+ * The events of a thread are recorded in order, so a callback is related to the dispatch which
+ * precedes it on the same thread, and an intra process message is followed from its
+ * publication to its dequeue by the publisher id and sequence number.
+ */
+struct TraceEvent
+{
+  /// Time of the event, from the steady clock, in nanoseconds.
+  int64_t time_ns;
+  /// Identifier of the thread recording the event, unique in the process.
+  uint64_t thread_id;
+  uint64_t handle;
+  uint64_t source;
+  uint64_t data;
+  /// TraceEventType of the event.
+  uint32_t type;
+  uint32_t reserved;
+};
+
+/// Receiver of the events recorded at the tracepoints of rclcpp, see set_backend().
+/**
+ * record() is called from the threads hitting the tracepoints, e.g. publishing or executing
+ * callbacks, so it must be thread-safe, and should be lock-free and should not allocate.
+ */
+class TraceBackend
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(TraceBackend)
+
+  TraceBackend() = default;
+
+  RCLCPP_PUBLIC
+  virtual ~TraceBackend();
+
+  virtual void
+  record(const TraceEvent & event) = 0;
+};
+
+/// Set the backend receiving the events of the process, or disable tracing with nullptr.
+/**
+ * This tracing is independent of the tracetools tracepoints, which require LTTng, the same
+ * sites report to both.
+ * A replaced backend is kept alive until the end of the process, because a thread may still be
+ * recording to it.
+ */
+RCLCPP_PUBLIC
+void
+set_backend(TraceBackend::SharedPtr backend);
+
+/// Return the current backend, nullptr if tracing is disabled.
+RCLCPP_PUBLIC
+TraceBackend::SharedPtr
+get_backend();
+
+/// Return true if a backend is set.
+RCLCPP_PUBLIC
+bool
+is_enabled();
+
+/// Record an event with the current time and thread to the current backend, if any.
+RCLCPP_PUBLIC
+void
+record(TraceEventType type, uint64_t handle, uint64_t source, uint64_t data);
+
+/// Convert a field of a TraceEvent, pointers are recorded as their address.
+template<typename T>
+inline uint64_t
+to_field(T * pointer)
+{
+  return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+}
+
+inline uint64_t
+to_field(std::nullptr_t)
+{
+  return 0;
+}
+
+template<
+  typename T,
+  typename = std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value>>
+inline uint64_t
+to_field(T value)
+{
+  return static_cast<uint64_t>(value);
+}
+
+/// Record an event if tracing is enabled, the fields are given as pointers or integers.
+template<typename HandleT, typename DataT>
+inline void
+trace(TraceEventType type, HandleT handle, uint64_t source, DataT data)
+{
+  if (is_enabled()) {
+    record(type, to_field(handle), source, to_field(data));
+  }
+}
+
+/// Backend writing the events to a binary file, from a lock-free ring buffer per thread.
+/**
+ * A thread writes its events to its own ring, without locking, which flush() drains to the file.
+ * When the ring of a thread is full, its events are dropped and counted, until the next flush.
+ *
+ * The file starts with a header of the magic number "RCLTRACE", the format version and the
+ * size of a record, as three little endian uint64_t on the usual platforms, followed by the
+ * TraceEvent records.
+ * The records of a thread are in order, the records of different threads are not.
+ */
+class RingBufferTraceBackend : public TraceBackend
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(RingBufferTraceBackend)
+
+  /// Constructor.
+  /**
+   * \param[in] file_path path of the file written, replaced if it exists.
+   * \param[in] events_per_thread capacity of the ring of each thread, rounded up to a power of 2.
+   * \throws std::invalid_argument if events_per_thread is 0.
+   * \throws std::runtime_error if the file cannot be opened.
+   */
+  RCLCPP_PUBLIC
+  explicit RingBufferTraceBackend(const std::string & file_path, size_t events_per_thread = 65536);
+
+  /// Flush the remaining events.
+  RCLCPP_PUBLIC
+  virtual ~RingBufferTraceBackend();
+
+  RCLCPP_PUBLIC
+  void
+  record(const TraceEvent & event) override;
+
+  /// Write the events recorded since the last flush to the file.
+  /**
+   * It may be called from any thread, e.g. periodically from a timer, concurrently with the
+   * recording threads.
+   * \throws std::runtime_error if the file cannot be written.
+   */
+  RCLCPP_PUBLIC
+  void
+  flush();
+
+  /// Return the number of events dropped because the ring of their thread was full.
+  RCLCPP_PUBLIC
+  uint64_t
+  get_dropped_count() const;
+
+  static constexpr uint64_t kMagic = 0x45434152544c4352;  // "RCLTRACE"
+  static constexpr uint64_t kVersion = 1;
+
+private:
+  /// Ring of one thread, written by that thread only and read by flush() only.
+  struct Ring
+  {
+    Ring(std::thread::id owner, size_t capacity)
+    : owner(owner), events(capacity)
+    {}
+
+    const std::thread::id owner;
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> tail{0};
+  };
+
+  Ring *
+  get_thread_ring();
+
+  const uint64_t id_;
+  const size_t capacity_;
+
+  std::mutex rings_mutex_;
+  std::vector<std::unique_ptr<Ring>> rings_;
+
+  std::mutex file_mutex_;
+  std::ofstream file_;
+
+  std::atomic<uint64_t> dropped_count_{0};
+};
+
+}  // namespace tracing
+}  // namespace rclcpp
+
+#endif  // RCLCPP__TRACING_HPP_
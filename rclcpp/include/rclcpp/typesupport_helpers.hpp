@@ -29,6 +29,9 @@ namespace rclcpp
 {
 /// Load the type support library for the given type.
 /**
+ * The libraries are cached process-wide by package and type support identifier while in use,
+ * so that the same library is returned as long as a previously returned one is still alive.
+ *
  * \param[in] type The topic type, e.g. "std_msgs/msg/String"
  * \param[in] typesupport_identifier Type support identifier, typically "rosidl_typesupport_cpp"
  * \return A shared library
@@ -40,6 +43,7 @@ get_typesupport_library(const std::string & type, const std::string & typesuppor
 /// Extract the type support handle from the library.
 /**
  * The library needs to match the topic type. The shared library must stay loaded for the lifetime of the result.
+ * The handles of libraries returned by get_typesupport_library() are cached along with them.
  * \param[in] type The topic type, e.g. "std_msgs/msg/String"
  * \param[in] typesupport_identifier Type support identifier, typically "rosidl_typesupport_cpp"
  * \param[in] library The shared type support library
@@ -15,19 +15,176 @@
 #ifndef RCLCPP__WAIT_FOR_MESSAGE_HPP_
 #define RCLCPP__WAIT_FOR_MESSAGE_HPP_
 
+#include <chrono>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 
+#include "rclcpp/macros.hpp"
 #include "rclcpp/node.hpp"
 #include "rclcpp/visibility_control.hpp"
 #include "rclcpp/wait_set.hpp"
 
 namespace rclcpp
 {
+/// Wait for the messages of a subscription, reusing the same entities for every wait.
+/**
+ * wait_for_message() creates a wait set and a guard condition for each call, and a subscription
+ * as well when given a topic.
+ * A MessageWaiter creates them once, so that repeated one-shot reads do not create and destroy
+ * middleware entities.
+ *
+ * The subscription must not be executed by an executor, which would take its messages.
+ * Waits are serialized, a single thread waits at a time.
+ */
+template<class MsgT>
+class MessageWaiter
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(MessageWaiter)
+
+  /// Wait for the messages of an already initialized subscription.
+  /**
+   * \param[in] subscription shared pointer to a previously initialized subscription.
+   * \param[in] context shared pointer to a context to watch for SIGINT requests.
+   */
+  MessageWaiter(
+    std::shared_ptr<rclcpp::Subscription<MsgT>> subscription,
+    std::shared_ptr<rclcpp::Context> context)
+  : subscription_(std::move(subscription)),
+    context_(std::move(context))
+  {
+    init();
+  }
+
+  /// Wait for the messages of a topic, with a subscription created once.
+  /**
+   * The subscription is in a callback group which is not added to executors, so that the node
+   * can be spun while waiting.
+   *
+   * \param[in] node the node pointer to initialize the subscription on.
+   * \param[in] topic the topic to wait for messages.
+   * \param[in] qos the QoS of the subscription.
+   */
+  MessageWaiter(
+    rclcpp::Node::SharedPtr node,
+    const std::string & topic,
+    const rclcpp::QoS & qos = rclcpp::QoS(1))
+  : callback_group_(
+      node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive, false)),
+    context_(node->get_node_options().context())
+  {
+    rclcpp::SubscriptionOptions options;
+    options.callback_group = callback_group_;
+    subscription_ = node->create_subscription<MsgT>(
+      topic, qos, [](const std::shared_ptr<const MsgT>) {}, options);
+    init();
+  }
+
+  ~MessageWaiter()
+  {
+    context_->remove_on_shutdown_callback(shutdown_callback_handle_);
+  }
+
+  /// Wait for the next incoming message.
+  /**
+   * A message received since the previous wait is returned without waiting.
+   *
+   * \param[out] out is the message to be filled when a new message is arriving.
+   * \param[in] time_to_wait parameter specifying the timeout before returning.
+   * \return true if a message was successfully received, false if message could not
+   * be obtained or shutdown was triggered asynchronously on the context.
+   */
+  template<class Rep = int64_t, class Period = std::milli>
+  bool
+  wait_for_message(
+    MsgT & out,
+    std::chrono::duration<Rep, Period> time_to_wait = std::chrono::duration<Rep, Period>(-1))
+  {
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    if (!context_->is_valid()) {
+      return false;
+    }
+    rclcpp::MessageInfo info;
+    if (subscription_->take(out, info)) {
+      return true;
+    }
+
+    auto ret = wait_set_.wait(time_to_wait);
+    if (ret.kind() != rclcpp::WaitResultKind::Ready) {
+      return false;
+    }
+
+    if (wait_set_.get_rcl_wait_set().guard_conditions[0]) {
+      return false;
+    }
+
+    return subscription_->take(out, info);
+  }
+
+  /// Wait for the next incoming message on another thread.
+  /**
+   * The MessageWaiter must outlive the returned future.
+   *
+   * \param[in] time_to_wait parameter specifying the timeout before returning.
+   * \return future of the message, or of nullptr if message could not be obtained or shutdown
+   * was triggered asynchronously on the context.
+   */
+  template<class Rep = int64_t, class Period = std::milli>
+  std::future<std::shared_ptr<MsgT>>
+  async_wait_for_message(
+    std::chrono::duration<Rep, Period> time_to_wait = std::chrono::duration<Rep, Period>(-1))
+  {
+    return std::async(
+      std::launch::async,
+      [this, time_to_wait]() -> std::shared_ptr<MsgT> {
+        auto message = std::make_shared<MsgT>();
+        if (!wait_for_message(*message, time_to_wait)) {
+          return nullptr;
+        }
+        return message;
+      });
+  }
+
+  /// Get the subscription whose messages are waited for.
+  std::shared_ptr<rclcpp::Subscription<MsgT>>
+  get_subscription() const
+  {
+    return subscription_;
+  }
+
+private:
+  void
+  init()
+  {
+    guard_condition_ = std::make_shared<rclcpp::GuardCondition>(context_);
+    shutdown_callback_handle_ = context_->add_on_shutdown_callback(
+      [weak_gc = std::weak_ptr<rclcpp::GuardCondition>{guard_condition_}]() {
+        auto strong_gc = weak_gc.lock();
+        if (strong_gc) {
+          strong_gc->trigger();
+        }
+      });
+    wait_set_.add_subscription(subscription_);
+    wait_set_.add_guard_condition(guard_condition_);
+  }
+
+  rclcpp::CallbackGroup::SharedPtr callback_group_;
+  std::shared_ptr<rclcpp::Subscription<MsgT>> subscription_;
+  std::shared_ptr<rclcpp::Context> context_;
+  std::shared_ptr<rclcpp::GuardCondition> guard_condition_;
+  rclcpp::OnShutdownCallbackHandle shutdown_callback_handle_;
+  rclcpp::WaitSet wait_set_;
+  std::mutex wait_mutex_;
+};
+
 /// Wait for the next incoming message.
 /**
  * Given an already initialized subscription,
  * wait for the next incoming message to arrive before the specified timeout.
+ * Use a MessageWaiter to wait repeatedly on the same subscription.
  *
  * \param[out] out is the message to be filled when a new message is arriving.
  * \param[in] subscription shared pointer to a previously initialized subscription.
@@ -43,33 +200,8 @@ bool wait_for_message(
   std::shared_ptr<rclcpp::Context> context,
   std::chrono::duration<Rep, Period> time_to_wait = std::chrono::duration<Rep, Period>(-1))
 {
-  auto gc = std::make_shared<rclcpp::GuardCondition>(context);
-  auto shutdown_callback_handle = context->add_on_shutdown_callback(
-    [weak_gc = std::weak_ptr<rclcpp::GuardCondition>{gc}]() {
-      auto strong_gc = weak_gc.lock();
-      if (strong_gc) {
-        strong_gc->trigger();
-      }
-    });
-
-  rclcpp::WaitSet wait_set;
-  wait_set.add_subscription(subscription);
-  wait_set.add_guard_condition(gc);
-  auto ret = wait_set.wait(time_to_wait);
-  if (ret.kind() != rclcpp::WaitResultKind::Ready) {
-    return false;
-  }
-
-  if (wait_set.get_rcl_wait_set().guard_conditions[0]) {
-    return false;
-  }
-
-  rclcpp::MessageInfo info;
-  if (!subscription->take(out, info)) {
-    return false;
-  }
-
-  return true;
+  MessageWaiter<MsgT> waiter(std::move(subscription), std::move(context));
+  return waiter.wait_for_message(out, time_to_wait);
 }
 
 /// Wait for the next incoming message.
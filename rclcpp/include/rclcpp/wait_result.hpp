@@ -17,7 +17,10 @@
 
 #include <cassert>
 #include <functional>
+#include <memory>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "rcl/wait.h"
 
@@ -27,6 +30,24 @@
 namespace rclcpp
 {
 
+class ClientBase;
+class GuardCondition;
+class ServiceBase;
+class SubscriptionBase;
+class TimerBase;
+class Waitable;
+
+/// The entities of a wait set which are ready after waiting on it.
+struct WaitResultReadyEntities
+{
+  std::vector<std::shared_ptr<rclcpp::SubscriptionBase>> subscriptions;
+  std::vector<std::shared_ptr<rclcpp::GuardCondition>> guard_conditions;
+  std::vector<std::shared_ptr<rclcpp::TimerBase>> timers;
+  std::vector<std::shared_ptr<rclcpp::ClientBase>> clients;
+  std::vector<std::shared_ptr<rclcpp::ServiceBase>> services;
+  std::vector<std::shared_ptr<rclcpp::Waitable>> waitables;
+};
+
 // TODO(wjwwood): the union-like design of this class could be replaced with
 //   std::variant, when we have access to that...
 /// Interface for introspecting a wait set after waiting on it.
@@ -122,9 +143,35 @@ public:
     return *wait_set_pointer_;
   }
 
+  /// Return the ready entities of the wait set.
+  /**
+   * The ready entities are collected once, on the first call, in a single pass over the
+   * ready entries of the rcl wait set, so that iterating over them scales with the number of
+   * ready entities rather than the size of the wait set.
+   * Only waitables are asked if they are ready, one by one, since they manage their own
+   * entries of the rcl wait set.
+   * Entities which were deleted since waiting are left out.
+   *
+   * \return the ready entities, empty unless the result was ready.
+   */
+  const WaitResultReadyEntities &
+  get_ready_entities()
+  {
+    if (!ready_entities_collected_) {
+      if (this->kind() == WaitResultKind::Ready) {
+        assert(wait_set_pointer_);
+        wait_set_pointer_->collect_ready_entities(ready_entities_);
+      }
+      ready_entities_collected_ = true;
+    }
+    return ready_entities_;
+  }
+
   WaitResult(WaitResult && other) noexcept
   : wait_result_kind_(other.wait_result_kind_),
-    wait_set_pointer_(std::exchange(other.wait_set_pointer_, nullptr))
+    wait_set_pointer_(std::exchange(other.wait_set_pointer_, nullptr)),
+    ready_entities_collected_(other.ready_entities_collected_),
+    ready_entities_(std::move(other.ready_entities_))
   {}
 
   ~WaitResult()
@@ -157,6 +204,9 @@ private:
   const WaitResultKind wait_result_kind_;
 
   WaitSetT * wait_set_pointer_ = nullptr;
+
+  bool ready_entities_collected_ = false;
+  WaitResultReadyEntities ready_entities_;
 };
 
 }  // namespace rclcpp
@@ -18,6 +18,7 @@
 #include <memory>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include "rcl/wait.h"
 
@@ -25,6 +26,7 @@
 #include "rclcpp/logging.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/visibility_control.hpp"
+#include "rclcpp/wait_result.hpp"
 #include "rclcpp/waitable.hpp"
 
 namespace rclcpp
@@ -154,6 +156,11 @@ protected:
    *   - resizing the wait set if needed,
    *   - clearing the wait set if not already done by resizing, and
    *   - re-adding the entities.
+   *
+   * The rcl handles of the entities, except for waitables which add themselves, are cached
+   * when the entities change, i.e. after storage_flag_for_resize().
+   * As long as they do not change, the cached handles are re-added without accessing the
+   * entities, which is needed because rcl_wait() removes the entities which are not ready.
    */
   template<
     class SubscriptionsIterable,
@@ -175,6 +182,16 @@ protected:
     const WaitablesIterable & waitables
   )
   {
+    if (!needs_resize_ && !needs_handles_refresh_) {
+      rcl_ret_t ret = rcl_wait_set_clear(&rcl_wait_set_);
+      if (RCL_RET_OK != ret) {
+        rclcpp::exceptions::throw_from_rcl_error(ret);
+      }
+      this->storage_add_cached_handles();
+      this->storage_add_waitables(waitables);
+      return;
+    }
+
     bool was_resized = false;
     // Resize the wait set, but only if it needs to be.
     if (needs_resize_) {
@@ -242,11 +259,25 @@ protected:
       }
     }
 
-    // Add subscriptions.
-    for (const auto & subscription_entry : subscriptions) {
-      auto subscription_ptr_pair =
-        get_raw_pointer_from_smart_pointer(subscription_entry.subscription);
-      if (nullptr == subscription_ptr_pair.second) {
+    // Cache the handles of the entities which are still alive, and the index of each entity in
+    // its sequence, which maps the entries of the rcl wait set back to the entities.
+    subscription_handles_.clear();
+    guard_condition_handles_.clear();
+    timer_handles_.clear();
+    client_handles_.clear();
+    service_handles_.clear();
+    subscription_indices_.clear();
+    guard_condition_indices_.clear();
+    timer_indices_.clear();
+    client_indices_.clear();
+    service_indices_.clear();
+    // Setup common code to skip and flag the entities which were deleted.
+    auto is_deleted =
+      [this](const auto & entity_ptr_pair)
+      {
+        if (nullptr != entity_ptr_pair.second) {
+          return false;
+        }
         // In this case it was probably stored as a weak_ptr, but is now locking to nullptr.
         if (HasStrongOwnership) {
           // This will not happen in fixed sized storage, as it holds
@@ -255,119 +286,194 @@ protected:
         }
         // Flag for pruning.
         needs_pruning_ = true;
-        continue;
+        return true;
+      };
+    size_t index = 0;
+    for (const auto & subscription_entry : subscriptions) {
+      auto subscription_ptr_pair =
+        get_raw_pointer_from_smart_pointer(subscription_entry.subscription);
+      if (!is_deleted(subscription_ptr_pair)) {
+        subscription_handles_.push_back(
+          subscription_ptr_pair.second->get_subscription_handle().get());
+        subscription_indices_.push_back(index);
       }
-      rcl_ret_t ret = rcl_wait_set_add_subscription(
-        &rcl_wait_set_,
-        subscription_ptr_pair.second->get_subscription_handle().get(),
-        nullptr);
-      if (RCL_RET_OK != ret) {
-        rclcpp::exceptions::throw_from_rcl_error(ret);
+      ++index;
+    }
+    index = 0;
+    for (const auto & guard_condition : guard_conditions) {
+      auto guard_condition_ptr_pair = get_raw_pointer_from_smart_pointer(guard_condition);
+      if (!is_deleted(guard_condition_ptr_pair)) {
+        guard_condition_handles_.push_back(
+          &guard_condition_ptr_pair.second->get_rcl_guard_condition());
+        guard_condition_indices_.push_back(index);
       }
+      ++index;
     }
-
-    // Setup common code to add guard_conditions.
-    auto add_guard_conditions =
-      [this](const auto & inner_guard_conditions)
-      {
-        for (const auto & guard_condition : inner_guard_conditions) {
-          auto guard_condition_ptr_pair = get_raw_pointer_from_smart_pointer(guard_condition);
-          if (nullptr == guard_condition_ptr_pair.second) {
-            // In this case it was probably stored as a weak_ptr, but is now locking to nullptr.
-            if (HasStrongOwnership) {
-              // This will not happen in fixed sized storage, as it holds
-              // shared ownership the whole time and is never in need of pruning.
-              throw std::runtime_error("unexpected condition, fixed storage policy needs pruning");
-            }
-            // Flag for pruning.
-            needs_pruning_ = true;
-            continue;
-          }
-          rcl_ret_t ret = rcl_wait_set_add_guard_condition(
-            &rcl_wait_set_,
-            &guard_condition_ptr_pair.second->get_rcl_guard_condition(),
-            nullptr);
-          if (RCL_RET_OK != ret) {
-            rclcpp::exceptions::throw_from_rcl_error(ret);
-          }
-        }
-      };
-
-    // Add guard conditions.
-    add_guard_conditions(guard_conditions);
-
-    // Add extra guard conditions.
-    add_guard_conditions(extra_guard_conditions);
-
-    // Add timers.
+    // The extra guard conditions are internal to the synchronization policy.
+    for (const auto & guard_condition : extra_guard_conditions) {
+      auto guard_condition_ptr_pair = get_raw_pointer_from_smart_pointer(guard_condition);
+      if (!is_deleted(guard_condition_ptr_pair)) {
+        guard_condition_handles_.push_back(
+          &guard_condition_ptr_pair.second->get_rcl_guard_condition());
+        guard_condition_indices_.push_back(no_entity_index);
+      }
+    }
+    index = 0;
     for (const auto & timer : timers) {
       auto timer_ptr_pair = get_raw_pointer_from_smart_pointer(timer);
-      if (nullptr == timer_ptr_pair.second) {
-        // In this case it was probably stored as a weak_ptr, but is now locking to nullptr.
-        if (HasStrongOwnership) {
-          // This will not happen in fixed sized storage, as it holds
-          // shared ownership the whole time and is never in need of pruning.
-          throw std::runtime_error("unexpected condition, fixed storage policy needs pruning");
-        }
-        // Flag for pruning.
-        needs_pruning_ = true;
-        continue;
-      }
-      rcl_ret_t ret = rcl_wait_set_add_timer(
-        &rcl_wait_set_,
-        timer_ptr_pair.second->get_timer_handle().get(),
-        nullptr);
-      if (RCL_RET_OK != ret) {
-        rclcpp::exceptions::throw_from_rcl_error(ret);
+      if (!is_deleted(timer_ptr_pair)) {
+        timer_handles_.push_back(timer_ptr_pair.second->get_timer_handle().get());
+        timer_indices_.push_back(index);
       }
+      ++index;
     }
-
-    // Add clients.
+    index = 0;
     for (const auto & client : clients) {
       auto client_ptr_pair = get_raw_pointer_from_smart_pointer(client);
-      if (nullptr == client_ptr_pair.second) {
-        // In this case it was probably stored as a weak_ptr, but is now locking to nullptr.
-        if (HasStrongOwnership) {
-          // This will not happen in fixed sized storage, as it holds
-          // shared ownership the whole time and is never in need of pruning.
-          throw std::runtime_error("unexpected condition, fixed storage policy needs pruning");
-        }
-        // Flag for pruning.
-        needs_pruning_ = true;
-        continue;
-      }
-      rcl_ret_t ret = rcl_wait_set_add_client(
-        &rcl_wait_set_,
-        client_ptr_pair.second->get_client_handle().get(),
-        nullptr);
-      if (RCL_RET_OK != ret) {
-        rclcpp::exceptions::throw_from_rcl_error(ret);
+      if (!is_deleted(client_ptr_pair)) {
+        client_handles_.push_back(client_ptr_pair.second->get_client_handle().get());
+        client_indices_.push_back(index);
       }
+      ++index;
     }
-
-    // Add services.
+    index = 0;
     for (const auto & service : services) {
       auto service_ptr_pair = get_raw_pointer_from_smart_pointer(service);
-      if (nullptr == service_ptr_pair.second) {
-        // In this case it was probably stored as a weak_ptr, but is now locking to nullptr.
-        if (HasStrongOwnership) {
-          // This will not happen in fixed sized storage, as it holds
-          // shared ownership the whole time and is never in need of pruning.
-          throw std::runtime_error("unexpected condition, fixed storage policy needs pruning");
-        }
-        // Flag for pruning.
-        needs_pruning_ = true;
-        continue;
+      if (!is_deleted(service_ptr_pair)) {
+        service_handles_.push_back(service_ptr_pair.second->get_service_handle().get());
+        service_indices_.push_back(index);
       }
-      rcl_ret_t ret = rcl_wait_set_add_service(
-        &rcl_wait_set_,
-        service_ptr_pair.second->get_service_handle().get(),
-        nullptr);
-      if (RCL_RET_OK != ret) {
-        rclcpp::exceptions::throw_from_rcl_error(ret);
+      ++index;
+    }
+    needs_handles_refresh_ = false;
+
+    this->storage_add_cached_handles();
+    this->storage_add_waitables(waitables);
+  }
+
+  /// Add the cached rcl handles of all entities but waitables to the cleared wait set.
+  void
+  storage_add_cached_handles()
+  {
+    // Setup common code to add the handles of one kind of entity.
+    auto add_handles =
+      [this](const auto & handles, auto add_to_wait_set)
+      {
+        for (const auto handle : handles) {
+          rcl_ret_t ret = add_to_wait_set(&rcl_wait_set_, handle, nullptr);
+          if (RCL_RET_OK != ret) {
+            rclcpp::exceptions::throw_from_rcl_error(ret);
+          }
+        }
+      };
+    add_handles(subscription_handles_, rcl_wait_set_add_subscription);
+    add_handles(guard_condition_handles_, rcl_wait_set_add_guard_condition);
+    add_handles(timer_handles_, rcl_wait_set_add_timer);
+    add_handles(client_handles_, rcl_wait_set_add_client);
+    add_handles(service_handles_, rcl_wait_set_add_service);
+  }
+
+  /// Collect the ready entities after waiting, in one pass over the cached entries.
+  /**
+   * The cached handles are the first entries of the rcl wait set, and each ready entry is
+   * mapped back to its entity with the cached index, after checking that the entity still
+   * has that handle, which is not the case if the entity sets changed since waiting.
+   */
+  template<
+    class SubscriptionsIterable,
+    class GuardConditionsIterable,
+    class TimersIterable,
+    class ClientsIterable,
+    class ServicesIterable,
+    class WaitablesIterable
+  >
+  void
+  storage_collect_ready_entities_with_sets(
+    const SubscriptionsIterable & subscriptions,
+    const GuardConditionsIterable & guard_conditions,
+    const TimersIterable & timers,
+    const ClientsIterable & clients,
+    const ServicesIterable & services,
+    const WaitablesIterable & waitables,
+    rclcpp::WaitResultReadyEntities & ready_entities)
+  {
+    // Setup common code to collect the ready entities of one kind.
+    auto collect =
+      [](
+        const auto * rcl_entries, size_t number_of_rcl_entries,
+        const auto & indices, const auto & entities,
+        auto get_entity, auto get_handle, auto & ready)
+      {
+        for (size_t entry = 0; entry < indices.size() && entry < number_of_rcl_entries; ++entry) {
+          const size_t index = indices[entry];
+          if (nullptr == rcl_entries[entry] || index >= entities.size()) {
+            continue;
+          }
+          auto entity = get_entity(entities[index]);
+          if (nullptr != entity && get_handle(*entity) == rcl_entries[entry]) {
+            ready.push_back(std::move(entity));
+          }
+        }
+      };
+    auto get_shared_pointer = [](const auto & pointer) {return to_shared_pointer(pointer);};
+    collect(
+      rcl_wait_set_.subscriptions, rcl_wait_set_.size_of_subscriptions,
+      subscription_indices_, subscriptions,
+      [](const auto & entry) {return to_shared_pointer(entry.subscription);},
+      [](const auto & subscription) {
+        return subscription.get_subscription_handle().get();
+      },
+      ready_entities.subscriptions);
+    collect(
+      rcl_wait_set_.guard_conditions, rcl_wait_set_.size_of_guard_conditions,
+      guard_condition_indices_, guard_conditions, get_shared_pointer,
+      [](auto & guard_condition) {
+        return &guard_condition.get_rcl_guard_condition();
+      },
+      ready_entities.guard_conditions);
+    collect(
+      rcl_wait_set_.timers, rcl_wait_set_.size_of_timers,
+      timer_indices_, timers, get_shared_pointer,
+      [](const auto & timer) {return timer.get_timer_handle().get();},
+      ready_entities.timers);
+    collect(
+      rcl_wait_set_.clients, rcl_wait_set_.size_of_clients,
+      client_indices_, clients, get_shared_pointer,
+      [](auto & client) {return client.get_client_handle().get();},
+      ready_entities.clients);
+    collect(
+      rcl_wait_set_.services, rcl_wait_set_.size_of_services,
+      service_indices_, services, get_shared_pointer,
+      [](auto & service) {return service.get_service_handle().get();},
+      ready_entities.services);
+    for (const auto & waitable_entry : waitables) {
+      auto waitable = to_shared_pointer(waitable_entry.waitable);
+      if (nullptr != waitable && waitable->is_ready(&rcl_wait_set_)) {
+        ready_entities.waitables.push_back(std::move(waitable));
       }
     }
+  }
 
+  template<class EntityT>
+  static
+  std::shared_ptr<EntityT>
+  to_shared_pointer(const std::shared_ptr<EntityT> & shared_pointer)
+  {
+    return shared_pointer;
+  }
+
+  template<class EntityT>
+  static
+  std::shared_ptr<EntityT>
+  to_shared_pointer(const std::weak_ptr<EntityT> & weak_pointer)
+  {
+    return weak_pointer.lock();
+  }
+
+  template<class WaitablesIterable>
+  void
+  storage_add_waitables(const WaitablesIterable & waitables)
+  {
     // Add waitables.
     for (auto & waitable_entry : waitables) {
       auto waitable_ptr_pair = get_raw_pointer_from_smart_pointer(waitable_entry.waitable);
@@ -408,11 +514,32 @@ protected:
     needs_resize_ = true;
   }
 
+  void
+  storage_flag_for_handles_refresh()
+  {
+    needs_handles_refresh_ = true;
+  }
+
   rcl_wait_set_t rcl_wait_set_;
   rclcpp::Context::SharedPtr context_;
 
   bool needs_pruning_ = false;
   bool needs_resize_ = false;
+  bool needs_handles_refresh_ = true;
+
+  std::vector<const rcl_subscription_t *> subscription_handles_;
+  std::vector<const rcl_guard_condition_t *> guard_condition_handles_;
+  std::vector<const rcl_timer_t *> timer_handles_;
+  std::vector<const rcl_client_t *> client_handles_;
+  std::vector<const rcl_service_t *> service_handles_;
+
+  // Index of the entity of each cached handle in its sequence, no_entity_index if internal.
+  static constexpr size_t no_entity_index = static_cast<size_t>(-1);
+  std::vector<size_t> subscription_indices_;
+  std::vector<size_t> guard_condition_indices_;
+  std::vector<size_t> timer_indices_;
+  std::vector<size_t> client_indices_;
+  std::vector<size_t> service_indices_;
 };
 
 }  // namespace detail
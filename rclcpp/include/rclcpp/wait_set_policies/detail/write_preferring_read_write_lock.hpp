@@ -15,7 +15,9 @@
 #ifndef RCLCPP__WAIT_SET_POLICIES__DETAIL__WRITE_PREFERRING_READ_WRITE_LOCK_HPP_
 #define RCLCPP__WAIT_SET_POLICIES__DETAIL__WRITE_PREFERRING_READ_WRITE_LOCK_HPP_
 
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 
@@ -215,6 +217,28 @@ protected:
     friend WritePreferringReadWriteLock;
   };
 
+  /// Contention statistics of the lock.
+  struct Statistics
+  {
+    /// Number of times the read mutex was locked.
+    uint64_t read_locks = 0;
+    /// Number of times the read mutex was locked after waiting for a writer.
+    uint64_t contended_read_locks = 0;
+    /// Total time spent waiting to lock the read mutex.
+    std::chrono::nanoseconds read_wait_time{0};
+    /// Number of times the write mutex was locked.
+    uint64_t write_locks = 0;
+    /// Number of times the write mutex was locked after waiting for the reader or a writer.
+    uint64_t contended_write_locks = 0;
+    /// Total time spent waiting to lock the write mutex.
+    std::chrono::nanoseconds write_wait_time{0};
+  };
+
+  /// Return the contention statistics accumulated since construction.
+  RCLCPP_PUBLIC
+  Statistics
+  get_statistics() const;
+
   /// Return read mutex which can be used with standard constructs like std::lock_guard.
   RCLCPP_PUBLIC
   ReadMutex &
@@ -229,8 +253,9 @@ protected:
   bool reader_active_ = false;
   std::size_t number_of_writers_waiting_ = 0;
   bool writer_active_ = false;
-  std::mutex mutex_;
+  mutable std::mutex mutex_;
   std::condition_variable condition_variable_;
+  Statistics statistics_;
   ReadMutex read_mutex_;
   WriteMutex write_mutex_;
   std::function<void()> enter_waiting_function_;
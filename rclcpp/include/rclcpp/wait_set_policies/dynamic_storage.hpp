@@ -215,6 +215,20 @@ public:
     );
   }
 
+  void
+  storage_collect_ready_entities(rclcpp::WaitResultReadyEntities & ready_entities)
+  {
+    this->storage_collect_ready_entities_with_sets(
+      subscriptions_,
+      guard_conditions_,
+      timers_,
+      clients_,
+      services_,
+      waitables_,
+      ready_entities
+    );
+  }
+
   template<class EntityT, class SequenceOfEntitiesT>
   static
   bool
@@ -398,15 +412,25 @@ public:
       // Avoid redundant locking.
       return;
     }
-    // Setup common locking function.
-    auto lock_all = [](const auto & weak_ptrs, auto & shared_ptrs) {
+    // Setup common locking function, which also detects deleted entities, whose cached rcl
+    // handles must not be added to the rcl wait set anymore.
+    bool has_deleted_entities = false;
+    auto lock_all = [&has_deleted_entities](const auto & weak_ptrs, auto & shared_ptrs) {
         shared_ptrs.resize(weak_ptrs.size());
         size_t index = 0;
         for (const auto & weak_ptr : weak_ptrs) {
-          shared_ptrs[index++] = weak_ptr.lock();
+          shared_ptrs[index] = weak_ptr.lock();
+          has_deleted_entities = has_deleted_entities || !shared_ptrs[index];
+          ++index;
         }
       };
     // Lock all the weak pointers and hold them until released.
+    shared_subscriptions_.resize(subscriptions_.size());
+    for (size_t index = 0; index < subscriptions_.size(); ++index) {
+      shared_subscriptions_[index] =
+        SubscriptionEntry{subscriptions_[index].lock(), subscriptions_[index].mask};
+      has_deleted_entities = has_deleted_entities || !shared_subscriptions_[index].subscription;
+    }
     lock_all(guard_conditions_, shared_guard_conditions_);
     lock_all(timers_, shared_timers_);
     lock_all(clients_, shared_clients_);
@@ -423,6 +447,9 @@ public:
         }
       };
     lock_all_waitables(waitables_, shared_waitables_);
+    if (has_deleted_entities) {
+      this->storage_flag_for_handles_refresh();
+    }
   }
 
   void
@@ -438,6 +465,9 @@ public:
           shared_ptr.reset();
         }
       };
+    for (auto & subscription_entry : shared_subscriptions_) {
+      subscription_entry.reset();
+    }
     reset_all(shared_guard_conditions_);
     reset_all(shared_timers_);
     reset_all(shared_clients_);
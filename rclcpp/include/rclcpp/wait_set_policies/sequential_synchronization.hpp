@@ -234,6 +234,17 @@ protected:
     prune_deleted_entities_function();
   }
 
+  /// Apply several add and remove operations without thread-safety.
+  /**
+   * Does not throw, but the batch function may throw.
+   */
+  void
+  sync_batch(std::function<void()> batch_function)
+  {
+    // Explicitly no thread synchronization.
+    batch_function();
+  }
+
   /// Implements wait without any thread-safety.
   template<class WaitResultT>
   WaitResultT
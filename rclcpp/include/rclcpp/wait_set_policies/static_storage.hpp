@@ -162,6 +162,20 @@ public:
     );
   }
 
+  void
+  storage_collect_ready_entities(rclcpp::WaitResultReadyEntities & ready_entities)
+  {
+    this->storage_collect_ready_entities_with_sets(
+      subscriptions_,
+      guard_conditions_,
+      timers_,
+      clients_,
+      services_,
+      waitables_,
+      ready_entities
+    );
+  }
+
   // storage_add_subscription() explicitly not declared here
   // storage_remove_subscription() explicitly not declared here
   // storage_add_guard_condition() explicitly not declared here
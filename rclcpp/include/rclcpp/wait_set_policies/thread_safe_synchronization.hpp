@@ -15,11 +15,16 @@
 #ifndef RCLCPP__WAIT_SET_POLICIES__THREAD_SAFE_SYNCHRONIZATION_HPP_
 #define RCLCPP__WAIT_SET_POLICIES__THREAD_SAFE_SYNCHRONIZATION_HPP_
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 
+#include "rcpputils/scope_exit.hpp"
+
 #include "rclcpp/client.hpp"
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/guard_condition.hpp"
@@ -103,8 +108,7 @@ protected:
       void(std::shared_ptr<rclcpp::SubscriptionBase>&&, const rclcpp::SubscriptionWaitSetMask &)
     > add_subscription_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     add_subscription_function(std::move(subscription), mask);
   }
 
@@ -117,8 +121,7 @@ protected:
       void(std::shared_ptr<rclcpp::SubscriptionBase>&&, const rclcpp::SubscriptionWaitSetMask &)
     > remove_subscription_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     remove_subscription_function(std::move(subscription), mask);
   }
 
@@ -128,8 +131,7 @@ protected:
     std::shared_ptr<rclcpp::GuardCondition> && guard_condition,
     std::function<void(std::shared_ptr<rclcpp::GuardCondition>&&)> add_guard_condition_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     add_guard_condition_function(std::move(guard_condition));
   }
 
@@ -139,8 +141,7 @@ protected:
     std::shared_ptr<rclcpp::GuardCondition> && guard_condition,
     std::function<void(std::shared_ptr<rclcpp::GuardCondition>&&)> remove_guard_condition_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     remove_guard_condition_function(std::move(guard_condition));
   }
 
@@ -150,8 +151,7 @@ protected:
     std::shared_ptr<rclcpp::TimerBase> && timer,
     std::function<void(std::shared_ptr<rclcpp::TimerBase>&&)> add_timer_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     add_timer_function(std::move(timer));
   }
 
@@ -161,8 +161,7 @@ protected:
     std::shared_ptr<rclcpp::TimerBase> && timer,
     std::function<void(std::shared_ptr<rclcpp::TimerBase>&&)> remove_timer_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     remove_timer_function(std::move(timer));
   }
 
@@ -172,8 +171,7 @@ protected:
     std::shared_ptr<rclcpp::ClientBase> && client,
     std::function<void(std::shared_ptr<rclcpp::ClientBase>&&)> add_client_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     add_client_function(std::move(client));
   }
 
@@ -183,8 +181,7 @@ protected:
     std::shared_ptr<rclcpp::ClientBase> && client,
     std::function<void(std::shared_ptr<rclcpp::ClientBase>&&)> remove_client_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     remove_client_function(std::move(client));
   }
 
@@ -194,8 +191,7 @@ protected:
     std::shared_ptr<rclcpp::ServiceBase> && service,
     std::function<void(std::shared_ptr<rclcpp::ServiceBase>&&)> add_service_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     add_service_function(std::move(service));
   }
 
@@ -205,8 +201,7 @@ protected:
     std::shared_ptr<rclcpp::ServiceBase> && service,
     std::function<void(std::shared_ptr<rclcpp::ServiceBase>&&)> remove_service_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     remove_service_function(std::move(service));
   }
 
@@ -219,8 +214,7 @@ protected:
       void(std::shared_ptr<rclcpp::Waitable>&&, std::shared_ptr<void>&&)
     > add_waitable_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     add_waitable_function(std::move(waitable), std::move(associated_entity));
   }
 
@@ -230,8 +224,7 @@ protected:
     std::shared_ptr<rclcpp::Waitable> && waitable,
     std::function<void(std::shared_ptr<rclcpp::Waitable>&&)> remove_waitable_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     remove_waitable_function(std::move(waitable));
   }
 
@@ -239,11 +232,38 @@ protected:
   void
   sync_prune_deleted_entities(std::function<void()> prune_deleted_entities_function)
   {
-    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
-    std::lock_guard<WritePreferringReadWriteLock::WriteMutex> lock(wprw_lock_.get_write_mutex());
+    auto lock = this->lock_for_writing();
     prune_deleted_entities_function();
   }
 
+  /// Apply several add and remove operations while holding the write lock once.
+  /**
+   * The waiting wait set is interrupted once for the whole batch, instead of once for each
+   * operation.
+   * The add and remove operations called by the batch function from this thread do not lock
+   * again, while the ones of other threads block until the batch is done.
+   */
+  void
+  sync_batch(std::function<void()> batch_function)
+  {
+    auto lock = this->lock_for_writing();
+    if (!lock.owns_lock()) {
+      // Nested batch, the outer batch holds the lock already.
+      batch_function();
+      return;
+    }
+    batch_owner_.store(std::this_thread::get_id());
+    RCPPUTILS_SCOPE_EXIT({batch_owner_.store(std::thread::id());});
+    batch_function();
+  }
+
+  /// Return the contention statistics of the lock which protects the entity sets.
+  rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock::Statistics
+  sync_get_lock_statistics() const
+  {
+    return wprw_lock_.get_statistics();
+  }
+
   /// Implements wait.
   template<class WaitResultT>
   WaitResultT
@@ -369,8 +389,22 @@ protected:
   }
 
 protected:
+  /// Lock the write mutex, unless this thread holds it for a batch already.
+  std::unique_lock<rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock::WriteMutex>
+  lock_for_writing()
+  {
+    using rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock;
+    if (batch_owner_.load() == std::this_thread::get_id()) {
+      return std::unique_lock<WritePreferringReadWriteLock::WriteMutex>();
+    }
+    return std::unique_lock<WritePreferringReadWriteLock::WriteMutex>(
+      wprw_lock_.get_write_mutex());
+  }
+
   std::array<std::shared_ptr<rclcpp::GuardCondition>, 1> extra_guard_conditions_;
   rclcpp::wait_set_policies::detail::WritePreferringReadWriteLock wprw_lock_;
+  // The thread which runs a batch of add and remove operations, if any.
+  std::atomic<std::thread::id> batch_owner_{std::thread::id()};
 };
 
 }  // namespace wait_set_policies
@@ -607,6 +607,87 @@ public:
       });
   }
 
+  /// Apply several add and remove operations to this wait set as one batch.
+  /**
+   * The batch function is called with this wait set, and the add_*() and remove_*() methods
+   * it calls are applied as one mutation of the wait set.
+   * With the thread-safe synchronization policy, the write lock is held and a concurrent
+   * wait() is interrupted once for the whole batch, rather than once for each operation,
+   * which avoids repeated rebuilds of the rcl wait set while adding many entities.
+   *
+   * \param[in] batch_function Callable with the signature void(WaitSetTemplate &).
+   * \throws exceptions thrown by the batch function, the operations applied before the
+   *   exception are kept.
+   */
+  template<class BatchFunctionT>
+  void
+  batch(BatchFunctionT && batch_function)
+  {
+    // this method comes from the SynchronizationPolicy
+    this->sync_batch([this, &batch_function]() {batch_function(*this);});
+  }
+
+  /// Add a range of subscriptions to this wait set as one batch.
+  /**
+   * \sa add_subscription() and batch()
+   */
+  template<class SubscriptionsRangeT>
+  void
+  add_subscriptions(
+    const SubscriptionsRangeT & subscriptions,
+    rclcpp::SubscriptionWaitSetMask mask = {})
+  {
+    this->batch(
+      [&subscriptions, &mask](WaitSetTemplate & wait_set) {
+        for (const auto & subscription : subscriptions) {
+          wait_set.add_subscription(subscription, mask);
+        }
+      });
+  }
+
+  /// Add a range of guard conditions to this wait set as one batch.
+  /**
+   * \sa add_guard_condition() and batch()
+   */
+  template<class GuardConditionsRangeT>
+  void
+  add_guard_conditions(const GuardConditionsRangeT & guard_conditions)
+  {
+    this->batch(
+      [&guard_conditions](WaitSetTemplate & wait_set) {
+        for (const auto & guard_condition : guard_conditions) {
+          wait_set.add_guard_condition(guard_condition);
+        }
+      });
+  }
+
+  /// Add a range of timers to this wait set as one batch.
+  /**
+   * \sa add_timer() and batch()
+   */
+  template<class TimersRangeT>
+  void
+  add_timers(const TimersRangeT & timers)
+  {
+    this->batch(
+      [&timers](WaitSetTemplate & wait_set) {
+        for (const auto & timer : timers) {
+          wait_set.add_timer(timer);
+        }
+      });
+  }
+
+  /// Return the contention statistics of the lock of the synchronization policy.
+  /**
+   * Only available with the thread-safe synchronization policy.
+   */
+  auto
+  get_lock_statistics() const
+  {
+    // this method comes from the SynchronizationPolicy
+    return this->sync_get_lock_statistics();
+  }
+
   /// Wait for any of the entities in the wait set to be ready, or a period of time to pass.
   /**
    * This function will return when either one of the entities within this wait
@@ -738,6 +819,14 @@ private:
     this->sync_wait_result_release();
   }
 
+  /// Called by the WaitResult to collect the ready entities after a ready result.
+  void
+  collect_ready_entities(WaitResultReadyEntities & ready_entities)
+  {
+    // this method comes from the StoragePolicy
+    this->storage_collect_ready_entities(ready_entities);
+  }
+
   bool wait_result_holding_ = false;
 };
 
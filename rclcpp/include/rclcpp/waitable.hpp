@@ -16,6 +16,7 @@
 #define RCLCPP__WAITABLE_HPP_
 
 #include <atomic>
+#include <functional>
 #include <memory>
 
 #include "rclcpp/macros.hpp"
@@ -137,6 +138,9 @@ public:
    * writes it to the void shared pointer `data` that is passed into the
    * method. The `data` can then be executed with the `execute` method.
    *
+   * The executor should release the `data` once executed, so that the waitables reusing the
+   * storage of their data do not allocate it for each event, see rclcpp::detail::TakenDataSlot.
+   *
    * Before calling this method, the Waitable should be added to a wait set,
    * waited on, and then updated.
    *
@@ -203,6 +207,40 @@ public:
   bool
   exchange_in_use_by_wait_set_state(bool in_use_state);
 
+  /// Set a callback to be called whenever the waitable becomes ready.
+  /**
+   * The callback receives a size_t which is the number of times the waitable
+   * was ready since the last time this callback was called.
+   * Normally this is 1, but can be > 1 if waitable was triggered before any
+   * callback was set.
+   *
+   * The callback also receives an int identifier argument, which is reserved
+   * for waitables made of several entities to tell which one became ready.
+   *
+   * The callback may be called from the middleware or from the thread which
+   * made the waitable ready, it should be fast and not blocking.
+   *
+   * Calling it again will clear any previously set callback.
+   *
+   * Waitables which support this override it along with clear_on_ready_callback().
+   *
+   * \param[in] callback functor to be called when the waitable becomes ready
+   * \throws std::runtime_error if the waitable does not support it
+   */
+  RCLCPP_PUBLIC
+  virtual
+  void
+  set_on_ready_callback(std::function<void(size_t, int)> callback);
+
+  /// Unset any callback registered via set_on_ready_callback.
+  /**
+   * \throws std::runtime_error if the waitable does not support it
+   */
+  RCLCPP_PUBLIC
+  virtual
+  void
+  clear_on_ready_callback();
+
 private:
   std::atomic<bool> in_use_by_wait_set_{false};
 };  // class Waitable
@@ -20,6 +20,7 @@
 #include <sstream>
 #include <type_traits>
 
+#include "rclcpp/detail/log_throttle.hpp"
 #include "rclcpp/logger.hpp"
 #include "rcutils/logging_macros.h"
 #include "rclcpp/utilities.hpp"
@@ -78,6 +79,17 @@ def get_rclcpp_suffix_from_features(features):
     if 'stream' in features:
         suffix = '_STREAM' + suffix
     return suffix
+
+def get_rcutils_features(features):
+    # the throttling, and the skipping of the first record along with it, is done by rclcpp
+    if 'throttle' in features:
+        return tuple(f for f in features if f not in ('throttle', 'skipfirst'))
+    return features
+
+def get_rcutils_params(features, params):
+    if 'throttle' in features:
+        return [p for p in params if p not in ('clock', 'duration')]
+    return list(params)
 }@
 @[for severity in severities]@
 /** @@name Logging macros for severity @(severity).
@@ -128,28 +140,26 @@ def get_rclcpp_suffix_from_features(features):
       ::std::is_same<typename std::remove_cv<typename std::remove_reference<decltype(logger)>::type>::type, \
       typename ::rclcpp::Logger>::value, \
       "First argument to logging macros must be an rclcpp::Logger"); \
-@[ if 'throttle' in feature_combination]@ \
-    auto get_time_point = [&c=clock](rcutils_time_point_value_t * time_point) -> rcutils_ret_t { \
-      try { \
-        *time_point = c.now().nanoseconds(); \
-      } catch (...) { \
-        RCUTILS_SAFE_FWRITE_TO_STDERR( \
-        "[rclcpp|logging.hpp] RCLCPP_@(severity)@(suffix) could not get current time stamp\n"); \
-        return RCUTILS_RET_ERROR; \
-      } \
-        return RCUTILS_RET_OK; \
-    }; \
-@[ end if] \
+    const ::rclcpp::Logger & rclcpp_logging_logger_ = (logger); \
+    if (!rclcpp_logging_logger_.is_enabled_for(::rclcpp::Logger::Level::@(severity.capitalize()))) { \
+      break; \
+    } \
+@[ if 'throttle' in feature_combination]@
+    static ::rclcpp::detail::LogThrottle rclcpp_logging_throttle_(@('true' if 'skipfirst' in feature_combination else 'false')); \
+    if (!rclcpp_logging_throttle_.should_log(clock, duration)) { \
+      break; \
+    } \
+@[ end if]@
 @[ if 'stream' in feature_combination]@
     std::stringstream ss; \
     ss << @(stream_arg); \
 @[ end if]@
-    RCUTILS_LOG_@(severity)@(get_suffix_from_features(feature_combination))_NAMED( \
-@{params = ['get_time_point' if p == 'clock' and 'throttle' in feature_combination else p for p in params]}@
+    RCUTILS_LOG_@(severity)@(get_suffix_from_features(get_rcutils_features(feature_combination)))_NAMED( \
+@{params = get_rcutils_params(feature_combination, params)}@
 @[ if params]@
 @(''.join(['      ' + p + ', \\\n' for p in params if p != stream_arg]))@
 @[ end if]@
-      logger.get_name(), \
+      rclcpp_logging_logger_.get_name(), \
 @[ if 'stream' not in feature_combination]@
       __VA_ARGS__); \
 @[ else]@
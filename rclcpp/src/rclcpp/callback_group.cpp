@@ -14,18 +14,34 @@
 
 #include "rclcpp/callback_group.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 using rclcpp::CallbackGroup;
 using rclcpp::CallbackGroupType;
+using rclcpp::CallbackGroupOverloadPolicy;
 
 CallbackGroup::CallbackGroup(
   CallbackGroupType group_type,
   bool automatically_add_to_executor_with_node)
 : type_(group_type), associated_with_executor_(false),
   can_be_taken_from_(true),
-  automatically_add_to_executor_with_node_(automatically_add_to_executor_with_node)
-{}
+  automatically_add_to_executor_with_node_(automatically_add_to_executor_with_node),
+  priority_(0),
+  scheduling_weight_(1u),
+  enabled_(true),
+  execution_budget_ns_(0),
+  execution_overrun_count_(0u),
+  overload_policy_(CallbackGroupOverloadPolicy::Execute),
+  shed_count_(0u)
+{
+  entities_ = std::make_shared<const Entities>();
+}
 
 
 std::atomic_bool &
@@ -53,80 +69,227 @@ CallbackGroup::automatically_add_to_executor_with_node() const
 }
 
 void
-CallbackGroup::add_subscription(
-  const rclcpp::SubscriptionBase::SharedPtr subscription_ptr)
+CallbackGroup::set_priority(int priority)
+{
+  priority_.store(priority);
+}
+
+int
+CallbackGroup::get_priority() const
+{
+  return priority_.load();
+}
+
+void
+CallbackGroup::set_scheduling_weight(size_t weight)
+{
+  if (0u == weight) {
+    throw std::invalid_argument("the scheduling weight of a callback group must not be 0");
+  }
+  scheduling_weight_.store(weight);
+}
+
+size_t
+CallbackGroup::get_scheduling_weight() const
+{
+  return scheduling_weight_.load();
+}
+
+void
+CallbackGroup::set_enabled(bool enabled)
+{
+  enabled_.store(enabled);
+}
+
+bool
+CallbackGroup::is_enabled() const
+{
+  return enabled_.load();
+}
+
+void
+CallbackGroup::set_execution_budget(std::chrono::nanoseconds budget)
+{
+  if (budget.count() < 0) {
+    throw std::invalid_argument("execution budget must not be negative");
+  }
+  execution_budget_ns_.store(budget.count());
+}
+
+std::chrono::nanoseconds
+CallbackGroup::get_execution_budget() const
+{
+  return std::chrono::nanoseconds(execution_budget_ns_.load(std::memory_order_relaxed));
+}
+
+void
+CallbackGroup::set_execution_overrun_callback(
+  std::function<void(const rclcpp::ExecutableExecution &)> callback)
+{
+  std::lock_guard<std::mutex> lock(execution_overrun_callback_mutex_);
+  execution_overrun_callback_ = std::move(callback);
+}
+
+uint64_t
+CallbackGroup::get_execution_overrun_count() const
+{
+  return execution_overrun_count_.load(std::memory_order_relaxed);
+}
+
+void
+CallbackGroup::report_execution_overrun(const rclcpp::ExecutableExecution & execution)
+{
+  execution_overrun_count_.fetch_add(1u, std::memory_order_relaxed);
+  std::function<void(const rclcpp::ExecutableExecution &)> callback;
+  {
+    std::lock_guard<std::mutex> lock(execution_overrun_callback_mutex_);
+    callback = execution_overrun_callback_;
+  }
+  if (callback) {
+    callback(execution);
+  }
+}
+
+void
+CallbackGroup::set_overload_policy(CallbackGroupOverloadPolicy policy)
+{
+  overload_policy_.store(policy);
+}
+
+rclcpp::CallbackGroupOverloadPolicy
+CallbackGroup::get_overload_policy() const
+{
+  return overload_policy_.load(std::memory_order_relaxed);
+}
+
+void
+CallbackGroup::set_backpressure_callback(
+  std::function<void(const rclcpp::OverloadEvent &)> callback)
+{
+  std::lock_guard<std::mutex> lock(backpressure_callback_mutex_);
+  backpressure_callback_ = std::move(callback);
+}
+
+uint64_t
+CallbackGroup::get_shed_count() const
+{
+  return shed_count_.load(std::memory_order_relaxed);
+}
+
+void
+CallbackGroup::report_overload(const rclcpp::OverloadEvent & event)
+{
+  if (event.shed) {
+    shed_count_.fetch_add(1u, std::memory_order_relaxed);
+  }
+  std::function<void(const rclcpp::OverloadEvent &)> callback;
+  {
+    std::lock_guard<std::mutex> lock(backpressure_callback_mutex_);
+    callback = backpressure_callback_;
+  }
+  if (callback) {
+    callback(event);
+  }
+}
+
+std::shared_ptr<const CallbackGroup::Entities>
+CallbackGroup::get_entities() const
+{
+  return std::atomic_load(&entities_);
+}
+
+uint64_t
+CallbackGroup::get_entities_version() const
+{
+  return get_entities()->version;
+}
+
+void
+CallbackGroup::update_entities(const std::function<void(Entities &)> & modify)
 {
   std::lock_guard<std::mutex> lock(mutex_);
-  subscription_ptrs_.push_back(subscription_ptr);
-  subscription_ptrs_.erase(
+  auto entities = std::make_shared<Entities>(*entities_);
+  modify(*entities);
+  ++entities->version;
+  std::atomic_store(&entities_, std::shared_ptr<const Entities>(std::move(entities)));
+}
+
+namespace
+{
+
+template<typename WeakPtrT, typename SharedPtrT>
+void
+add_entity(std::vector<WeakPtrT> & entities, const SharedPtrT & entity)
+{
+  entities.push_back(entity);
+  entities.erase(
     std::remove_if(
-      subscription_ptrs_.begin(),
-      subscription_ptrs_.end(),
-      [](rclcpp::SubscriptionBase::WeakPtr x) {return x.expired();}),
-    subscription_ptrs_.end());
+      entities.begin(),
+      entities.end(),
+      [](const WeakPtrT & x) {return x.expired();}),
+    entities.end());
+}
+
+}  // namespace
+
+void
+CallbackGroup::add_subscription(
+  const rclcpp::SubscriptionBase::SharedPtr subscription_ptr)
+{
+  update_entities(
+    [&subscription_ptr](Entities & entities) {
+      add_entity(entities.subscriptions, subscription_ptr);
+    });
 }
 
 void
 CallbackGroup::add_timer(const rclcpp::TimerBase::SharedPtr timer_ptr)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  timer_ptrs_.push_back(timer_ptr);
-  timer_ptrs_.erase(
-    std::remove_if(
-      timer_ptrs_.begin(),
-      timer_ptrs_.end(),
-      [](rclcpp::TimerBase::WeakPtr x) {return x.expired();}),
-    timer_ptrs_.end());
+  update_entities(
+    [&timer_ptr](Entities & entities) {
+      add_entity(entities.timers, timer_ptr);
+    });
 }
 
 void
 CallbackGroup::add_service(const rclcpp::ServiceBase::SharedPtr service_ptr)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  service_ptrs_.push_back(service_ptr);
-  service_ptrs_.erase(
-    std::remove_if(
-      service_ptrs_.begin(),
-      service_ptrs_.end(),
-      [](rclcpp::ServiceBase::WeakPtr x) {return x.expired();}),
-    service_ptrs_.end());
+  update_entities(
+    [&service_ptr](Entities & entities) {
+      add_entity(entities.services, service_ptr);
+    });
 }
 
 void
 CallbackGroup::add_client(const rclcpp::ClientBase::SharedPtr client_ptr)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  client_ptrs_.push_back(client_ptr);
-  client_ptrs_.erase(
-    std::remove_if(
-      client_ptrs_.begin(),
-      client_ptrs_.end(),
-      [](rclcpp::ClientBase::WeakPtr x) {return x.expired();}),
-    client_ptrs_.end());
+  update_entities(
+    [&client_ptr](Entities & entities) {
+      add_entity(entities.clients, client_ptr);
+    });
 }
 
 void
 CallbackGroup::add_waitable(const rclcpp::Waitable::SharedPtr waitable_ptr)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  waitable_ptrs_.push_back(waitable_ptr);
-  waitable_ptrs_.erase(
-    std::remove_if(
-      waitable_ptrs_.begin(),
-      waitable_ptrs_.end(),
-      [](rclcpp::Waitable::WeakPtr x) {return x.expired();}),
-    waitable_ptrs_.end());
+  update_entities(
+    [&waitable_ptr](Entities & entities) {
+      add_entity(entities.waitables, waitable_ptr);
+    });
 }
 
 void
 CallbackGroup::remove_waitable(const rclcpp::Waitable::SharedPtr waitable_ptr) noexcept
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  for (auto iter = waitable_ptrs_.begin(); iter != waitable_ptrs_.end(); ++iter) {
-    const auto shared_ptr = iter->lock();
-    if (shared_ptr.get() == waitable_ptr.get()) {
-      waitable_ptrs_.erase(iter);
-      break;
-    }
-  }
+  update_entities(
+    [&waitable_ptr](Entities & entities) {
+      auto & waitables = entities.waitables;
+      for (auto iter = waitables.begin(); iter != waitables.end(); ++iter) {
+        const auto shared_ptr = iter->lock();
+        if (shared_ptr.get() == waitable_ptr.get()) {
+          waitables.erase(iter);
+          break;
+        }
+      }
+    });
 }
@@ -17,18 +17,26 @@
 #include <algorithm>
 #include <chrono>
 #include <cstdio>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 
 #include "rcl/graph.h"
 #include "rcl/node.h"
 #include "rcl/wait.h"
+#include "rclcpp/detail/cpp_callback_trampoline.hpp"
+#include "rclcpp/detail/fast_exit.hpp"
 #include "rclcpp/exceptions.hpp"
+#include "rclcpp/experimental/intra_process_manager.hpp"
 #include "rclcpp/node_interfaces/node_base_interface.hpp"
 #include "rclcpp/node_interfaces/node_graph_interface.hpp"
 #include "rclcpp/utilities.hpp"
 #include "rclcpp/logging.hpp"
 
+#include "rmw/impl/cpp/demangle.hpp"
+
 using rclcpp::ClientBase;
 using rclcpp::exceptions::InvalidNodeError;
 using rclcpp::exceptions::throw_from_rcl_error;
@@ -47,6 +55,10 @@ ClientBase::ClientBase(
     new_rcl_client, [weak_node_handle](rcl_client_t * client)
     {
       auto handle = weak_node_handle.lock();
+      if (rclcpp::detail::skip_entity_finalization(handle.get())) {
+        delete client;
+        return;
+      }
       if (handle) {
         if (rcl_client_fini(client, handle.get()) != RCL_RET_OK) {
           RCLCPP_ERROR(
@@ -66,6 +78,7 @@ ClientBase::ClientBase(
 
 ClientBase::~ClientBase()
 {
+  clear_on_new_response_callback();
   // Make sure the client handle is destructed as early as possible and before the node handle
   client_handle_.reset();
 }
@@ -157,6 +170,7 @@ ClientBase::wait_for_service_nanoseconds(std::chrono::nanoseconds timeout)
     if (!rclcpp::ok(this->context_)) {
       return false;
     }
+    // Only the graph changes listing the server wake this up, not every graph change.
     // Limit each wait to 100ms to workaround an issue specific to the Connext RMW implementation.
     // A race condition means that graph changes for services becoming available may trigger the
     // wait set to wake up, but then not be reported as ready immediately after the wake up
@@ -164,11 +178,11 @@ ClientBase::wait_for_service_nanoseconds(std::chrono::nanoseconds timeout)
     // If no other graph events occur, the wait set will not be triggered again until the timeout
     // has been reached, despite the service being available, so we artificially limit the wait
     // time to limit the delay.
-    node_ptr->wait_for_graph_change(
-      event, std::min(time_to_wait, std::chrono::nanoseconds(RCL_MS_TO_NS(100))));
+    node_ptr->wait_for_service_server(
+      event, this->get_service_name(),
+      std::min(time_to_wait, std::chrono::nanoseconds(RCL_MS_TO_NS(100))));
     // Because of the aforementioned race condition, we check if the service is ready even if the
-    // graph event wasn't triggered.
-    event->check_and_clear();
+    // server was not listed.
     if (this->service_is_ready()) {
       return true;
     }
@@ -198,3 +212,95 @@ ClientBase::exchange_in_use_by_wait_set_state(bool in_use_state)
 {
   return in_use_by_wait_set_.exchange(in_use_state);
 }
+
+void
+ClientBase::set_on_new_response_callback(std::function<void(size_t)> callback)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_new_response_callback is not callable.");
+  }
+
+  auto new_callback =
+    [callback, this](size_t number_of_responses) {
+      try {
+        callback(number_of_responses);
+      } catch (const std::exception & exception) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::ClientBase@" << this <<
+            " caught " << rmw::impl::cpp::demangle(exception) <<
+            " exception in user-provided callback for the 'on new response' callback: " <<
+            exception.what());
+      } catch (...) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::ClientBase@" << this <<
+            " caught unhandled exception in user-provided callback " <<
+            "for the 'on new response' callback");
+      }
+    };
+
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+
+  // Set it temporarily to the new callback, while we replace the old one.
+  // This two-step setting, prevents a gap where the old std::function has
+  // been replaced but the middleware hasn't been told about the new one yet.
+  set_on_new_response_callback(
+    rclcpp::detail::cpp_callback_trampoline<const void *, size_t>,
+    static_cast<const void *>(&new_callback));
+
+  // Store the std::function to keep it in scope, also overwrites the existing one.
+  on_new_response_callback_ = new_callback;
+
+  // Set it again, now using the permanent storage.
+  set_on_new_response_callback(
+    rclcpp::detail::cpp_callback_trampoline<const void *, size_t>,
+    static_cast<const void *>(&on_new_response_callback_));
+}
+
+void
+ClientBase::clear_on_new_response_callback()
+{
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  if (on_new_response_callback_) {
+    set_on_new_response_callback(nullptr, nullptr);
+    on_new_response_callback_ = nullptr;
+  }
+}
+
+void
+ClientBase::set_on_new_response_callback(rcl_event_callback_t callback, const void * user_data)
+{
+  rcl_ret_t ret = rcl_client_set_on_new_response_callback(
+    client_handle_.get(),
+    callback,
+    user_data);
+
+  if (RCL_RET_OK != ret) {
+    throw_from_rcl_error(ret, "failed to set the on new response callback for client");
+  }
+}
+
+void
+ClientBase::setup_intra_process()
+{
+  weak_ipm_ = context_->get_sub_context<rclcpp::experimental::IntraProcessManager>();
+  intra_process_service_name_ = get_service_name();
+}
+
+rclcpp::experimental::ServiceIntraProcessBase::SharedPtr
+ClientBase::get_intra_process_service() const
+{
+  auto ipm = weak_ipm_.lock();
+  if (!ipm) {
+    return nullptr;
+  }
+  return ipm->get_service_intra_process(intra_process_service_name_);
+}
+
+int64_t
+ClientBase::get_next_intra_process_request_id()
+{
+  return next_intra_process_request_id_.fetch_sub(1, std::memory_order_relaxed);
+}
@@ -14,16 +14,27 @@
 
 #include "rclcpp/clock.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <thread>
 
 #include "rclcpp/exceptions.hpp"
 
+#include "rcpputils/scope_exit.hpp"
 #include "rcutils/logging_macros.h"
 
 namespace rclcpp
 {
 
+// Value of the snapshot of the ROS time override while the time source does not override it.
+static constexpr rcl_time_point_value_t kNoRosTimeOverride =
+  std::numeric_limits<rcl_time_point_value_t>::min();
+
 class Clock::Impl
 {
 public:
@@ -47,6 +58,10 @@ public:
   rcl_clock_t rcl_clock_;
   rcl_allocator_t allocator_;
   std::mutex clock_mutex_;
+  // ROS time set by the time source, read by now() without going through the rcl clock.
+  std::atomic<rcl_time_point_value_t> ros_time_override_{kNoRosTimeOverride};
+  // Number of the jump handlers of the clock, for the time source to skip their preparation.
+  std::atomic<size_t> jump_handler_count_{0u};
 };
 
 JumpHandler::JumpHandler(
@@ -66,6 +81,14 @@ Clock::~Clock() {}
 Time
 Clock::now()
 {
+  if (impl_->rcl_clock_.type == RCL_ROS_TIME) {
+    const rcl_time_point_value_t ros_time_override =
+      impl_->ros_time_override_.load(std::memory_order_acquire);
+    if (ros_time_override != kNoRosTimeOverride) {
+      return Time(ros_time_override, RCL_ROS_TIME);
+    }
+  }
+
   Time now(0, 0, impl_->rcl_clock_.type);
 
   auto ret = rcl_clock_get_now(&impl_->rcl_clock_, &now.rcl_time_.nanoseconds);
@@ -76,6 +99,112 @@ Clock::now()
   return now;
 }
 
+namespace
+{
+
+// Longest single wait on a std::chrono clock, so that computing its deadline cannot overflow.
+constexpr std::chrono::hours kMaxChronoWait{24};
+
+// Return the deadline on the std::chrono clock at which the clock is expected to reach `until`.
+template<typename ChronoClockT>
+auto
+to_chrono_deadline(rclcpp::Clock & clock, const rclcpp::Time & until)
+{
+  const std::chrono::nanoseconds time_left((until - clock.now()).nanoseconds());
+  return ChronoClockT::now() + std::min<std::chrono::nanoseconds>(time_left, kMaxChronoWait);
+}
+
+}  // namespace
+
+bool
+Clock::sleep_until(Time until, Context::SharedPtr context)
+{
+  if (!context) {
+    throw std::runtime_error("context cannot be null");
+  }
+  const auto this_clock_type = get_clock_type();
+  if (until.get_clock_type() != this_clock_type) {
+    throw std::runtime_error("until's clock type does not match this clock's type");
+  }
+
+  std::condition_variable cv;
+
+  // A sleep on a wall clock is only interrupted by a shutdown of the context during the sleep.
+  const bool context_was_valid = context->is_valid();
+  auto shut_down = [&context, context_was_valid]() {
+      return context_was_valid && !context->is_valid();
+    };
+
+  // Wake this thread if the context is shut down.
+  // The clock mutex is locked to notify, so that the shutdown cannot happen between the check of
+  // the context and the wait.
+  rclcpp::OnShutdownCallbackHandle shutdown_callback_handle = context->add_on_shutdown_callback(
+    [this, &cv]() {
+      std::lock_guard<std::mutex> lock(impl_->clock_mutex_);
+      cv.notify_all();
+    });
+  auto remove_shutdown_callback = rcpputils::make_scope_exit(
+    [&context, &shutdown_callback_handle]() {
+      context->remove_on_shutdown_callback(shutdown_callback_handle);
+    });
+
+  if (this_clock_type == RCL_STEADY_TIME) {
+    std::unique_lock<std::mutex> lock(impl_->clock_mutex_);
+    while (now() < until && !shut_down()) {
+      cv.wait_until(lock, to_chrono_deadline<std::chrono::steady_clock>(*this, until));
+    }
+    return now() >= until;
+  }
+  if (this_clock_type == RCL_SYSTEM_TIME) {
+    std::unique_lock<std::mutex> lock(impl_->clock_mutex_);
+    while (now() < until && !shut_down()) {
+      cv.wait_until(lock, to_chrono_deadline<std::chrono::system_clock>(*this, until));
+    }
+    return now() >= until;
+  }
+
+  // For ROS time, the jump callbacks are called by the time source with the clock mutex locked,
+  // every time it sets the time.
+  // They wake this thread to check whether the time was reached, and detect the activation or
+  // deactivation of ROS time, which interrupts the sleep.
+  std::atomic<bool> time_source_changed{false};
+  rcl_jump_threshold_t threshold;
+  threshold.on_clock_change = true;
+  // 0 disables the thresholds, -1 and 1 are the smallest time changes
+  threshold.min_backward.nanoseconds = -1;
+  threshold.min_forward.nanoseconds = 1;
+  JumpHandler::SharedPtr jump_handler = create_jump_callback(
+    nullptr,
+    [&cv, &time_source_changed](const rcl_time_jump_t & jump) {
+      if (jump.clock_change != RCL_ROS_TIME_NO_CHANGE) {
+        time_source_changed.store(true);
+      }
+      cv.notify_all();
+    },
+    threshold);
+
+  std::unique_lock<std::mutex> lock(impl_->clock_mutex_);
+  if (ros_time_is_active()) {
+    // Only the time source can wake this thread, which it cannot once the context is shut down.
+    while (now() < until && context->is_valid() && !time_source_changed.load()) {
+      cv.wait(lock);
+    }
+  } else {
+    while (now() < until && !shut_down() && !time_source_changed.load()) {
+      cv.wait_until(lock, to_chrono_deadline<std::chrono::system_clock>(*this, until));
+    }
+  }
+  // Unlock before the jump handler is destroyed, which locks the clock mutex to remove it.
+  lock.unlock();
+  return !time_source_changed.load() && now() >= until;
+}
+
+bool
+Clock::sleep_for(Duration rel_time, Context::SharedPtr context)
+{
+  return sleep_until(now() + rel_time, context);
+}
+
 bool
 Clock::ros_time_is_active()
 {
@@ -111,6 +240,27 @@ Clock::get_clock_mutex() noexcept
   return impl_->clock_mutex_;
 }
 
+void
+Clock::set_ros_time_override_snapshot(
+  bool ros_time_active, rcl_time_point_value_t nanoseconds) noexcept
+{
+  impl_->ros_time_override_.store(
+    ros_time_active ? nanoseconds : kNoRosTimeOverride, std::memory_order_release);
+}
+
+bool
+Clock::ros_time_override_snapshot_equals(rcl_time_point_value_t nanoseconds) const noexcept
+{
+  return nanoseconds != kNoRosTimeOverride &&
+         impl_->ros_time_override_.load(std::memory_order_acquire) == nanoseconds;
+}
+
+bool
+Clock::has_jump_handlers() const noexcept
+{
+  return impl_->jump_handler_count_.load(std::memory_order_acquire) > 0u;
+}
+
 void
 Clock::on_time_jump(
   const rcl_time_jump_t * time_jump,
@@ -149,6 +299,7 @@ Clock::create_jump_callback(
     if (RCL_RET_OK != ret) {
       exceptions::throw_from_rcl_error(ret, "Failed to add time jump callback");
     }
+    ++impl_->jump_handler_count_;
   }
 
   std::weak_ptr<Clock::Impl> weak_impl = impl_;
@@ -163,6 +314,7 @@ Clock::create_jump_callback(
       if (RCL_RET_OK != ret) {
         RCUTILS_LOG_ERROR("Failed to remove time jump callback");
       }
+      --shared_impl->jump_handler_count_;
     }
     delete handler;
   });
@@ -0,0 +1,677 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/content_filter.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "rcutils/error_handling.h"
+#include "rosidl_runtime_c/message_type_support_struct.h"
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+
+namespace rclcpp
+{
+
+namespace
+{
+
+namespace introspection = rosidl_typesupport_introspection_cpp;
+
+constexpr const char * introspection_typesupport_identifier =
+  "rosidl_typesupport_introspection_cpp";
+
+enum class Relation
+{
+  Equal,
+  NotEqual,
+  Less,
+  LessEqual,
+  Greater,
+  GreaterEqual,
+};
+
+/// Field of the messages or value, in a condition of a filter.
+struct Operand
+{
+  bool is_field = false;
+  /// Offset of the field in the messages.
+  size_t offset = 0;
+  uint8_t type_id = 0;
+  /// Value, if the operand is not a field.
+  bool is_string = false;
+  long double number = 0.0L;
+  std::string string;
+};
+
+bool
+is_string(const Operand & operand)
+{
+  return operand.is_field ? introspection::ROS_TYPE_STRING == operand.type_id : operand.is_string;
+}
+
+bool
+is_supported_field(uint8_t type_id)
+{
+  return introspection::ROS_TYPE_MESSAGE != type_id && introspection::ROS_TYPE_WSTRING != type_id;
+}
+
+template<typename T>
+long double
+read_number(const uint8_t * field)
+{
+  T value;
+  std::memcpy(&value, field, sizeof(value));
+  return static_cast<long double>(value);
+}
+
+long double
+get_number(const Operand & operand, const uint8_t * message)
+{
+  if (!operand.is_field) {
+    return operand.number;
+  }
+  const uint8_t * field = message + operand.offset;
+  switch (operand.type_id) {
+    case introspection::ROS_TYPE_BOOLEAN:
+      return read_number<bool>(field);
+    case introspection::ROS_TYPE_OCTET:
+    case introspection::ROS_TYPE_CHAR:
+    case introspection::ROS_TYPE_UINT8:
+      return read_number<uint8_t>(field);
+    case introspection::ROS_TYPE_INT8:
+      return read_number<int8_t>(field);
+    case introspection::ROS_TYPE_WCHAR:
+    case introspection::ROS_TYPE_UINT16:
+      return read_number<uint16_t>(field);
+    case introspection::ROS_TYPE_INT16:
+      return read_number<int16_t>(field);
+    case introspection::ROS_TYPE_UINT32:
+      return read_number<uint32_t>(field);
+    case introspection::ROS_TYPE_INT32:
+      return read_number<int32_t>(field);
+    case introspection::ROS_TYPE_UINT64:
+      return read_number<uint64_t>(field);
+    case introspection::ROS_TYPE_INT64:
+      return read_number<int64_t>(field);
+    case introspection::ROS_TYPE_FLOAT:
+      return read_number<float>(field);
+    case introspection::ROS_TYPE_DOUBLE:
+      return read_number<double>(field);
+    case introspection::ROS_TYPE_LONG_DOUBLE:
+      return read_number<long double>(field);
+    default:
+      // Rejected when the filter is constructed.
+      return 0.0L;
+  }
+}
+
+std::string_view
+get_string(const Operand & operand, const uint8_t * message)
+{
+  if (!operand.is_field) {
+    return operand.string;
+  }
+  return *reinterpret_cast<const std::string *>(message + operand.offset);
+}
+
+template<typename T>
+bool
+compare(Relation relation, const T & left, const T & right)
+{
+  switch (relation) {
+    case Relation::Equal:
+      return left == right;
+    case Relation::NotEqual:
+      return left != right;
+    case Relation::Less:
+      return left < right;
+    case Relation::LessEqual:
+      return left <= right;
+    case Relation::Greater:
+      return left > right;
+    case Relation::GreaterEqual:
+      return left >= right;
+  }
+  return false;
+}
+
+/// Return true if the text matches the pattern of a LIKE condition.
+bool
+matches_pattern(std::string_view text, std::string_view pattern)
+{
+  // Backtrack to the last % when the characters do not match.
+  size_t text_index = 0;
+  size_t pattern_index = 0;
+  size_t wildcard_index = std::string_view::npos;
+  size_t wildcard_text_index = 0;
+  while (text_index < text.size()) {
+    if (pattern_index < pattern.size() &&
+      ('_' == pattern[pattern_index] || text[text_index] == pattern[pattern_index]))
+    {
+      ++text_index;
+      ++pattern_index;
+    } else if (pattern_index < pattern.size() && '%' == pattern[pattern_index]) {
+      wildcard_index = pattern_index++;
+      wildcard_text_index = text_index;
+    } else if (std::string_view::npos != wildcard_index) {
+      pattern_index = wildcard_index + 1;
+      text_index = ++wildcard_text_index;
+    } else {
+      return false;
+    }
+  }
+  while (pattern_index < pattern.size() && '%' == pattern[pattern_index]) {
+    ++pattern_index;
+  }
+  return pattern_index == pattern.size();
+}
+
+const introspection::MessageMembers *
+get_members(const rosidl_message_type_support_t * type_support)
+{
+  return static_cast<const introspection::MessageMembers *>(type_support->data);
+}
+
+}  // namespace
+
+struct ContentFilter::Condition
+{
+  enum class Kind
+  {
+    Or,
+    And,
+    Not,
+    Compare,
+    Like,
+    Between,
+  };
+
+  bool
+  evaluate(const uint8_t * message) const
+  {
+    switch (kind) {
+      case Kind::Or:
+        for (const Condition & child : children) {
+          if (child.evaluate(message)) {
+            return true;
+          }
+        }
+        return false;
+      case Kind::And:
+        for (const Condition & child : children) {
+          if (!child.evaluate(message)) {
+            return false;
+          }
+        }
+        return true;
+      case Kind::Not:
+        return !children.front().evaluate(message);
+      case Kind::Compare:
+        if (is_string(operands[0])) {
+          return compare(
+            relation, get_string(operands[0], message), get_string(operands[1], message));
+        }
+        return compare(
+          relation, get_number(operands[0], message), get_number(operands[1], message));
+      case Kind::Like:
+        return matches_pattern(get_string(operands[0], message), get_string(operands[1], message));
+      case Kind::Between:
+        if (is_string(operands[0])) {
+          const std::string_view value = get_string(operands[0], message);
+          return get_string(operands[1], message) <= value &&
+                 value <= get_string(operands[2], message);
+        } else {
+          const long double value = get_number(operands[0], message);
+          return get_number(operands[1], message) <= value &&
+                 value <= get_number(operands[2], message);
+        }
+    }
+    return false;
+  }
+
+  Kind kind = Kind::Compare;
+  Relation relation = Relation::Equal;
+  std::vector<Condition> children;
+  std::vector<Operand> operands;
+};
+
+/// Parses a filter expression, or the value of one of its parameters.
+class ContentFilter::Parser
+{
+public:
+  Parser(
+    const introspection::MessageMembers * members,
+    const std::string & expression,
+    const std::vector<std::string> & parameters)
+  : members_(members),
+    expression_(expression)
+  {
+    for (const std::string & parameter : parameters) {
+      Parser parameter_parser(members, parameter, {});
+      parameter_parser.description_ = "filter expression parameter";
+      parameters_.push_back(parameter_parser.parse_parameter());
+    }
+    tokenize();
+  }
+
+  Condition
+  parse_condition()
+  {
+    Condition condition = parse_or();
+    if (Token::Kind::End != tokens_[index_].kind) {
+      throw error("unexpected '" + tokens_[index_].text + "'");
+    }
+    return condition;
+  }
+
+  /// Parse the value of a parameter.
+  Operand
+  parse_parameter()
+  {
+    Operand operand = parse_value();
+    if (Token::Kind::End != tokens_[index_].kind) {
+      throw error("unexpected '" + tokens_[index_].text + "'");
+    }
+    return operand;
+  }
+
+private:
+  struct Token
+  {
+    enum class Kind
+    {
+      Identifier,
+      Number,
+      String,
+      Parameter,
+      Symbol,
+      End,
+    };
+
+    Kind kind;
+    std::string text;
+  };
+
+  std::invalid_argument
+  error(const std::string & reason) const
+  {
+    return std::invalid_argument(
+      "invalid " + description_ + " \"" + expression_ + "\": " + reason);
+  }
+
+  void
+  tokenize()
+  {
+    static const char * const symbols[] = {
+      "<=", ">=", "<>", "!=", "=", "<", ">", "(", ")", "-", "+"};
+    size_t position = 0;
+    while (position < expression_.size()) {
+      const char character = expression_[position];
+      const size_t begin = position;
+      if (std::isspace(static_cast<unsigned char>(character))) {
+        ++position;
+      } else if ('\'' == character) {
+        const size_t end = expression_.find('\'', begin + 1);
+        if (std::string::npos == end) {
+          throw error("unterminated string");
+        }
+        tokens_.push_back({Token::Kind::String, expression_.substr(begin + 1, end - begin - 1)});
+        position = end + 1;
+      } else if ('%' == character) {
+        ++position;
+        while (position < expression_.size() &&
+          std::isdigit(static_cast<unsigned char>(expression_[position])))
+        {
+          ++position;
+        }
+        if (position == begin + 1) {
+          throw error("expected the index of a parameter after '%'");
+        }
+        tokens_.push_back(
+          {Token::Kind::Parameter, expression_.substr(begin + 1, position - begin - 1)});
+      } else if (std::isdigit(static_cast<unsigned char>(character)) || '.' == character) {
+        while (position < expression_.size() &&
+          (std::isalnum(static_cast<unsigned char>(expression_[position])) ||
+          '.' == expression_[position] ||
+          (('-' == expression_[position] || '+' == expression_[position]) &&
+          ('e' == expression_[position - 1] || 'E' == expression_[position - 1]))))
+        {
+          ++position;
+        }
+        tokens_.push_back({Token::Kind::Number, expression_.substr(begin, position - begin)});
+      } else if (std::isalpha(static_cast<unsigned char>(character)) || '_' == character) {
+        while (position < expression_.size() &&
+          (std::isalnum(static_cast<unsigned char>(expression_[position])) ||
+          '_' == expression_[position] || '.' == expression_[position]))
+        {
+          ++position;
+        }
+        tokens_.push_back({Token::Kind::Identifier, expression_.substr(begin, position - begin)});
+      } else {
+        for (const char * symbol : symbols) {
+          if (0 == expression_.compare(begin, std::strlen(symbol), symbol)) {
+            tokens_.push_back({Token::Kind::Symbol, symbol});
+            position += std::strlen(symbol);
+            break;
+          }
+        }
+        if (position == begin) {
+          throw error("unexpected '" + std::string(1, character) + "'");
+        }
+      }
+    }
+    tokens_.push_back({Token::Kind::End, "end of expression"});
+  }
+
+  bool
+  is_keyword(const Token & token, const char * keyword) const
+  {
+    if (Token::Kind::Identifier != token.kind || token.text.size() != std::strlen(keyword)) {
+      return false;
+    }
+    for (size_t i = 0; i < token.text.size(); ++i) {
+      if (std::toupper(static_cast<unsigned char>(token.text[i])) != keyword[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool
+  accept_keyword(const char * keyword)
+  {
+    if (!is_keyword(tokens_[index_], keyword)) {
+      return false;
+    }
+    ++index_;
+    return true;
+  }
+
+  bool
+  accept_symbol(const char * symbol)
+  {
+    if (Token::Kind::Symbol != tokens_[index_].kind || symbol != tokens_[index_].text) {
+      return false;
+    }
+    ++index_;
+    return true;
+  }
+
+  Condition
+  parse_or()
+  {
+    Condition condition = parse_and();
+    if (!is_keyword(tokens_[index_], "OR")) {
+      return condition;
+    }
+    Condition disjunction;
+    disjunction.kind = Condition::Kind::Or;
+    disjunction.children.push_back(std::move(condition));
+    while (accept_keyword("OR")) {
+      disjunction.children.push_back(parse_and());
+    }
+    return disjunction;
+  }
+
+  Condition
+  parse_and()
+  {
+    Condition condition = parse_not();
+    if (!is_keyword(tokens_[index_], "AND")) {
+      return condition;
+    }
+    Condition conjunction;
+    conjunction.kind = Condition::Kind::And;
+    conjunction.children.push_back(std::move(condition));
+    while (accept_keyword("AND")) {
+      conjunction.children.push_back(parse_not());
+    }
+    return conjunction;
+  }
+
+  Condition
+  parse_not()
+  {
+    if (accept_keyword("NOT")) {
+      return negate(parse_not());
+    }
+    if (accept_symbol("(")) {
+      Condition condition = parse_or();
+      if (!accept_symbol(")")) {
+        throw error("expected ')' instead of '" + tokens_[index_].text + "'");
+      }
+      return condition;
+    }
+    return parse_predicate();
+  }
+
+  static Condition
+  negate(Condition condition)
+  {
+    Condition negation;
+    negation.kind = Condition::Kind::Not;
+    negation.children.push_back(std::move(condition));
+    return negation;
+  }
+
+  Condition
+  parse_predicate()
+  {
+    Condition condition;
+    condition.operands.push_back(parse_operand());
+    const bool negated = accept_keyword("NOT");
+    if (accept_keyword("BETWEEN")) {
+      condition.kind = Condition::Kind::Between;
+      condition.operands.push_back(parse_operand());
+      if (!accept_keyword("AND")) {
+        throw error("expected AND instead of '" + tokens_[index_].text + "'");
+      }
+      condition.operands.push_back(parse_operand());
+    } else if (accept_keyword("LIKE")) {
+      condition.kind = Condition::Kind::Like;
+      condition.operands.push_back(parse_operand());
+      if (!is_string(condition.operands[0]) || !is_string(condition.operands[1])) {
+        throw error("LIKE compares strings");
+      }
+    } else if (negated) {
+      throw error("expected BETWEEN or LIKE instead of '" + tokens_[index_].text + "'");
+    } else {
+      condition.kind = Condition::Kind::Compare;
+      condition.relation = parse_relation();
+      condition.operands.push_back(parse_operand());
+    }
+    bool has_field = false;
+    for (const Operand & operand : condition.operands) {
+      has_field = has_field || operand.is_field;
+      if (is_string(operand) != is_string(condition.operands[0])) {
+        throw error("a string is compared with a number");
+      }
+    }
+    if (!has_field) {
+      throw error("a condition compares values without fields");
+    }
+    return negated ? negate(std::move(condition)) : condition;
+  }
+
+  Relation
+  parse_relation()
+  {
+    static const std::pair<const char *, Relation> relations[] = {
+      {"=", Relation::Equal},
+      {"<>", Relation::NotEqual},
+      {"!=", Relation::NotEqual},
+      {"<", Relation::Less},
+      {"<=", Relation::LessEqual},
+      {">", Relation::Greater},
+      {">=", Relation::GreaterEqual},
+    };
+    for (const auto & relation : relations) {
+      if (accept_symbol(relation.first)) {
+        return relation.second;
+      }
+    }
+    throw error("expected a comparison operator instead of '" + tokens_[index_].text + "'");
+  }
+
+  Operand
+  parse_operand()
+  {
+    const Token & token = tokens_[index_];
+    if (Token::Kind::Identifier == token.kind && !is_keyword(token, "TRUE") &&
+      !is_keyword(token, "FALSE"))
+    {
+      ++index_;
+      return resolve_field(token.text);
+    }
+    if (Token::Kind::Parameter == token.kind) {
+      ++index_;
+      const size_t parameter_index = std::strtoul(token.text.c_str(), nullptr, 10);
+      if (parameter_index >= parameters_.size()) {
+        throw error("the parameter %" + token.text + " is not given");
+      }
+      return parameters_[parameter_index];
+    }
+    return parse_value();
+  }
+
+  /// Parse a number, a boolean or a string.
+  Operand
+  parse_value()
+  {
+    Operand operand;
+    const Token & token = tokens_[index_++];
+    if (Token::Kind::String == token.kind) {
+      operand.is_string = true;
+      operand.string = token.text;
+    } else if (is_keyword(token, "TRUE") || is_keyword(token, "FALSE")) {
+      operand.number = is_keyword(token, "TRUE") ? 1.0L : 0.0L;
+    } else if (Token::Kind::Number == token.kind) {
+      operand.number = parse_number(token.text);
+    } else if (
+      Token::Kind::Symbol == token.kind && ("-" == token.text || "+" == token.text) &&
+      Token::Kind::Number == tokens_[index_].kind)
+    {
+      const long double number = parse_number(tokens_[index_++].text);
+      operand.number = "-" == token.text ? -number : number;
+    } else {
+      throw error("expected a field or a value instead of '" + token.text + "'");
+    }
+    return operand;
+  }
+
+  long double
+  parse_number(const std::string & text) const
+  {
+    char * end = nullptr;
+    const long double number = std::strtold(text.c_str(), &end);
+    if (end != text.c_str() + text.size()) {
+      throw error("invalid number '" + text + "'");
+    }
+    return number;
+  }
+
+  Operand
+  resolve_field(const std::string & field_name) const
+  {
+    Operand operand;
+    operand.is_field = true;
+    const introspection::MessageMembers * members = members_;
+    size_t begin = 0;
+    while (true) {
+      const size_t end = field_name.find('.', begin);
+      const std::string name = field_name.substr(begin, end - begin);
+      uint32_t index = 0;
+      while (index < members->member_count_ && name != members->members_[index].name_) {
+        ++index;
+      }
+      if (index == members->member_count_) {
+        throw error(
+                "the field '" + field_name + "' does not exist in the messages of type '" +
+                members->message_namespace_ + "::" + members->message_name_ + "'");
+      }
+      const introspection::MessageMember & member = members->members_[index];
+      if (member.is_array_) {
+        throw error(
+                "the field '" + field_name.substr(0, end) + "' is an array or a sequence, "
+                "which is not supported");
+      }
+      operand.offset += member.offset_;
+      if (std::string::npos == end) {
+        if (!is_supported_field(member.type_id_)) {
+          throw error("the type of the field '" + field_name + "' is not supported");
+        }
+        operand.type_id = member.type_id_;
+        return operand;
+      }
+      if (introspection::ROS_TYPE_MESSAGE != member.type_id_) {
+        throw error("the field '" + field_name.substr(0, end) + "' is not a message");
+      }
+      members = get_members(member.members_);
+      begin = end + 1;
+    }
+  }
+
+  const introspection::MessageMembers * members_;
+  const std::string & expression_;
+  std::string description_{"filter expression"};
+  std::vector<Operand> parameters_;
+  std::vector<Token> tokens_;
+  size_t index_{0};
+};
+
+ContentFilter::ContentFilter(
+  const rosidl_message_type_support_t * type_support,
+  const std::string & filter_expression,
+  const std::vector<std::string> & expression_parameters)
+: options_{filter_expression, expression_parameters}
+{
+  if (nullptr == type_support) {
+    throw std::invalid_argument("the type support is null");
+  }
+  const rosidl_message_type_support_t * introspection_type_support =
+    get_message_typesupport_handle(type_support, introspection_typesupport_identifier);
+  if (nullptr == introspection_type_support) {
+    rcutils_reset_error();
+    throw std::invalid_argument("the type support provides no introspection information");
+  }
+  Parser parser(
+    get_members(introspection_type_support), filter_expression, expression_parameters);
+  condition_ = std::make_unique<const Condition>(parser.parse_condition());
+}
+
+ContentFilter::~ContentFilter() = default;
+
+bool
+ContentFilter::matches(const void * message) const
+{
+  return condition_->evaluate(static_cast<const uint8_t *>(message));
+}
+
+const ContentFilterOptions &
+ContentFilter::get_options() const
+{
+  return options_;
+}
+
+}  // namespace rclcpp
@@ -25,15 +25,19 @@
 #include "rcl/init.h"
 #include "rcl/logging.h"
 
+#include "rclcpp/detail/fast_exit.hpp"
 #include "rclcpp/detail/utilities.hpp"
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/logging.hpp"
+#include "rclcpp/real_time_memory.hpp"
 
 #include "rcutils/error_handling.h"
 #include "rcutils/macros.h"
 
 #include "rmw/impl/cpp/demangle.hpp"
 
+#include "./detail/async_log_dispatcher.hpp"
+#include "./detail/shared_node_infrastructure.hpp"
 #include "./logging_mutex.hpp"
 
 using rclcpp::Context;
@@ -120,6 +124,38 @@ get_logging_reference_count()
   return ref_count;
 }
 
+extern "C"
+{
+/// Output handler of rcl, followed by the publishing of the shared "/rosout" publisher.
+static
+void
+rclcpp_logging_multiple_output_handler(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  rcl_logging_multiple_output_handler(location, severity, name, timestamp, format, args);
+  rclcpp::detail::publish_to_shared_rosout(location, severity, name, timestamp, format, args);
+}
+}  // extern "C"
+
+/// Dispatcher of the asynchronous logging, only started if InitOptions::async_logging() is.
+static
+std::shared_ptr<rclcpp::detail::AsyncLogDispatcher>
+get_global_async_log_dispatcher()
+{
+  // Shared like the global logging mutex, so that contexts can use it at destruction time.
+  static auto dispatcher = std::make_shared<rclcpp::detail::AsyncLogDispatcher>(
+    rclcpp_logging_multiple_output_handler, get_global_logging_mutex());
+  return dispatcher;
+}
+
+uint64_t
+rclcpp::get_async_logging_dropped_count()
+{
+  return get_global_async_log_dispatcher()->get_dropped_count();
+}
+
 extern "C"
 {
 static
@@ -130,10 +166,15 @@ rclcpp_logging_output_handler(
   const char * format, va_list * args)
 {
   try {
+    if (get_global_async_log_dispatcher()->push(
+        location, severity, name, timestamp, format, args))
+    {
+      return;
+    }
     std::shared_ptr<std::recursive_mutex> logging_mutex;
     logging_mutex = get_global_logging_mutex();
     std::lock_guard<std::recursive_mutex> guard(*logging_mutex);
-    return rcl_logging_multiple_output_handler(
+    return rclcpp_logging_multiple_output_handler(
       location, severity, name, timestamp, format, args);
   } catch (std::exception & ex) {
     RCUTILS_SAFE_FWRITE_TO_STDERR(ex.what());
@@ -172,6 +213,7 @@ void
 __delete_context(rcl_context_t * context)
 {
   if (context) {
+    rclcpp::detail::unregister_fast_exit_context(context);
     if (rcl_context_is_valid(context)) {
       RCLCPP_ERROR(
         rclcpp::get_logger("rclcpp"), "rcl context unexpectedly not shutdown during cleanup");
@@ -211,9 +253,13 @@ Context::init(
     rclcpp::exceptions::throw_from_rcl_error(ret, "failed to initialize rcl");
   }
   rcl_context_.reset(context, __delete_context);
+  if (init_options.fast_exit()) {
+    rclcpp::detail::register_fast_exit_context(context);
+  }
 
   if (init_options.auto_initialize_logging()) {
     logging_mutex_ = get_global_logging_mutex();
+    async_log_dispatcher_ = get_global_async_log_dispatcher();
     std::lock_guard<std::recursive_mutex> guard(*logging_mutex_);
     size_t & count = get_logging_reference_count();
     if (0u == count) {
@@ -225,6 +271,12 @@ Context::init(
         rcl_context_.reset();
         rclcpp::exceptions::throw_from_rcl_error(ret, "failed to configure logging");
       }
+      // The logger levels may be set by the command line arguments.
+      rclcpp::invalidate_logger_level_caches();
+      const rclcpp::AsyncLoggingOptions & async_logging = init_options.async_logging();
+      if (async_logging.enabled) {
+        async_log_dispatcher_->start(async_logging.queue_size, async_logging.overflow_policy);
+      }
     } else {
       RCLCPP_WARN(
         rclcpp::get_logger("rclcpp"),
@@ -240,6 +292,9 @@ Context::init(
       throw exceptions::UnknownROSArgsError(std::move(unparsed_ros_arguments));
     }
 
+    // After rcl_init(), so that the memory of the middleware is locked too.
+    rclcpp::prepare_memory_for_real_time(init_options.real_time_memory());
+
     init_options_ = init_options;
 
     weak_contexts_ = get_weak_contexts();
@@ -339,9 +394,16 @@ Context::shutdown(const std::string & reason)
   // shutdown logger
   if (logging_mutex_) {
     // logging was initialized by this context
-    std::lock_guard<std::recursive_mutex> guard(*logging_mutex_);
+    std::unique_lock<std::recursive_mutex> guard(*logging_mutex_);
     size_t & count = get_logging_reference_count();
     if (0u == --count) {
+      // Flush the asynchronous logging, whose thread outputs the records holding the mutex.
+      guard.unlock();
+      async_log_dispatcher_->stop();
+      guard.lock();
+    }
+    // Unless another context initialized the logging again in the meantime.
+    if (0u == count) {
       rcl_ret_t rcl_ret = rcl_logging_fini();
       if (RCL_RET_OK != rcl_ret) {
         RCUTILS_SAFE_FWRITE_TO_STDERR(
@@ -350,6 +412,7 @@ Context::shutdown(const std::string & reason)
           " failed to fini logging");
         rcl_reset_error();
       }
+      rclcpp::invalidate_logger_level_caches();
     }
   }
   return true;
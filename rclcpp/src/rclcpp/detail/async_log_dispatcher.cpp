@@ -0,0 +1,258 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./async_log_dispatcher.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "rcpputils/scope_exit.hpp"
+
+#include "./log_formatting.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+namespace
+{
+
+// Dispatcher calling the output handler from the current thread, if any.
+thread_local const AsyncLogDispatcher * outputting_dispatcher = nullptr;
+
+// Wake up the background thread periodically, in case a wake up was missed.
+constexpr std::chrono::milliseconds kMaxWaitDuration{100};
+
+}  // namespace
+
+AsyncLogDispatcher::AsyncLogDispatcher(
+  rcutils_logging_output_handler_t output_handler,
+  std::shared_ptr<std::recursive_mutex> output_mutex)
+: output_handler_(output_handler),
+  output_mutex_(std::move(output_mutex))
+{}
+
+AsyncLogDispatcher::~AsyncLogDispatcher()
+{
+  stop();
+}
+
+void
+AsyncLogDispatcher::start(size_t queue_size, rclcpp::AsyncLoggingOverflowPolicy overflow_policy)
+{
+  std::lock_guard<std::mutex> state_lock(state_mutex_);
+  if (thread_.joinable()) {
+    return;
+  }
+  size_t slot_count = 1u;
+  while (slot_count < queue_size) {
+    slot_count *= 2u;
+  }
+  slots_ = std::make_unique<Slot[]>(slot_count);
+  for (size_t i = 0u; i < slot_count; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  mask_ = slot_count - 1u;
+  enqueue_position_.store(0u, std::memory_order_relaxed);
+  dequeue_position_.store(0u, std::memory_order_relaxed);
+  overflow_policy_ = overflow_policy;
+  stopping_.store(false);
+  thread_ = std::thread(&AsyncLogDispatcher::run, this);
+  accepting_.store(true);
+}
+
+void
+AsyncLogDispatcher::stop()
+{
+  std::lock_guard<std::mutex> state_lock(state_mutex_);
+  if (!thread_.joinable()) {
+    return;
+  }
+  // Wait for the log calls which are pushing a record, then let the thread output all of them.
+  accepting_.store(false);
+  while (0u != active_producers_.load()) {
+    std::this_thread::yield();
+  }
+  stopping_.store(true);
+  {
+    std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+    wake_condition_.notify_one();
+  }
+  thread_.join();
+}
+
+bool
+AsyncLogDispatcher::push(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  if (this == outputting_dispatcher) {
+    return false;
+  }
+  active_producers_.fetch_add(1u);
+  auto release_producer = rcpputils::make_scope_exit(
+    [this]() {
+      active_producers_.fetch_sub(1u);
+    });
+  if (!accepting_.load()) {
+    return false;
+  }
+
+  size_t position;
+  Slot * slot = claim_slot(position);
+  if (!slot) {
+    if (rclcpp::AsyncLoggingOverflowPolicy::Drop == overflow_policy_) {
+      dropped_count_.fetch_add(1u, std::memory_order_relaxed);
+      return true;
+    }
+    slot = claim_slot_making_room(position);
+  }
+
+  Record & record = slot->record;
+  record.has_location = nullptr != location;
+  if (location) {
+    record.location = *location;
+  }
+  record.severity = severity;
+  record.timestamp = timestamp;
+  record.name.assign(name ? name : "");
+  format_log_message(record.message, format, args);
+  slot->sequence.store(position + 1u, std::memory_order_release);
+  wake_up();
+  return true;
+}
+
+uint64_t
+AsyncLogDispatcher::get_dropped_count() const
+{
+  return dropped_count_.load(std::memory_order_relaxed);
+}
+
+AsyncLogDispatcher::Slot *
+AsyncLogDispatcher::claim_slot(size_t & position)
+{
+  position = enqueue_position_.load(std::memory_order_relaxed);
+  while (true) {
+    Slot & slot = slots_[position & mask_];
+    const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+    if (0 == difference) {
+      // The slot is free, claim it unless another log call claimed it concurrently.
+      if (enqueue_position_.compare_exchange_weak(
+          position, position + 1u, std::memory_order_relaxed))
+      {
+        return &slot;
+      }
+    } else if (difference < 0) {
+      // The slot still holds the record pushed one lap earlier, the queue is full.
+      return nullptr;
+    } else {
+      position = enqueue_position_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+AsyncLogDispatcher::Slot *
+AsyncLogDispatcher::claim_slot_making_room(size_t & position)
+{
+  // The output mutex may already be held by this thread, e.g. while a node is created, so this
+  // outputs the queued records itself instead of waiting for the background thread to do it.
+  std::lock_guard<std::recursive_mutex> output_lock(*output_mutex_);
+  while (true) {
+    Slot * slot = claim_slot(position);
+    if (slot) {
+      return slot;
+    }
+    if (!output_one()) {
+      // The oldest record is still being pushed by another log call.
+      std::this_thread::yield();
+    }
+  }
+}
+
+bool
+AsyncLogDispatcher::output_one()
+{
+  const size_t position = dequeue_position_.load(std::memory_order_relaxed);
+  Slot & slot = slots_[position & mask_];
+  if (slot.sequence.load(std::memory_order_acquire) != position + 1u) {
+    return false;
+  }
+  const Record & record = slot.record;
+  {
+    // A record logged by the output handler is output synchronously, instead of reentering.
+    outputting_dispatcher = this;
+    auto reset_outputting = rcpputils::make_scope_exit(
+      []() {
+        outputting_dispatcher = nullptr;
+      });
+    call_output_handler(
+      output_handler_, record.has_location ? &record.location : nullptr, record.severity,
+      record.name.c_str(), record.timestamp, "%s", record.message.c_str());
+  }
+  // Release the slot for the next lap.
+  slot.sequence.store(position + mask_ + 1u, std::memory_order_release);
+  dequeue_position_.store(position + 1u, std::memory_order_relaxed);
+  return true;
+}
+
+void
+AsyncLogDispatcher::run()
+{
+  while (true) {
+    try {
+      std::lock_guard<std::recursive_mutex> output_lock(*output_mutex_);
+      if (output_one()) {
+        continue;
+      }
+    } catch (const std::exception & ex) {
+      RCUTILS_SAFE_FWRITE_TO_STDERR(ex.what());
+      RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+      continue;
+    }
+    if (stopping_.load()) {
+      // No record can be pushed anymore, and all of them were output.
+      break;
+    }
+    std::unique_lock<std::mutex> wake_lock(wake_mutex_);
+    thread_waiting_.store(true);
+    const size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    if (slots_[position & mask_].sequence.load() != position + 1u && !stopping_.load()) {
+      wake_condition_.wait_for(wake_lock, kMaxWaitDuration);
+    }
+    thread_waiting_.store(false, std::memory_order_relaxed);
+  }
+}
+
+void
+AsyncLogDispatcher::wake_up()
+{
+  // Pairs with the store of thread_waiting_ followed by the load of the sequence in run(), so
+  // that either the thread sees the record, or this sees the thread waiting.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (thread_waiting_.load(std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> wake_lock(wake_mutex_);
+    wake_condition_.notify_one();
+  }
+}
+
+}  // namespace detail
+}  // namespace rclcpp
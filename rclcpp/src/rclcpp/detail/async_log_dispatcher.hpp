@@ -0,0 +1,161 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__ASYNC_LOG_DISPATCHER_HPP_
+#define RCLCPP__DETAIL__ASYNC_LOG_DISPATCHER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "rcutils/logging.h"
+
+#include "rclcpp/init_options.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// \internal Queue of log records output by a background thread.
+/**
+ * The log calls format their message, and push the record to a bounded multi-producer
+ * single-consumer queue without locking.
+ * The background thread pops the records, and passes each of them to the output handler while
+ * holding the output mutex, so the output handler is still never called concurrently.
+ * While the queue is full, the records are dropped, or, with the block policy, the log call waits
+ * for the output mutex and outputs queued records itself until its record fits in the queue.
+ *
+ * The dispatcher can be started and stopped repeatedly, any record pushed before stop() is
+ * output before stop() returns.
+ */
+class AsyncLogDispatcher
+{
+public:
+  /**
+   * \param[in] output_handler called from the background thread with each record
+   * \param[in] output_mutex locked while calling the output handler
+   */
+  RCLCPP_LOCAL
+  AsyncLogDispatcher(
+    rcutils_logging_output_handler_t output_handler,
+    std::shared_ptr<std::recursive_mutex> output_mutex);
+
+  RCLCPP_LOCAL
+  ~AsyncLogDispatcher();
+
+  /// Start the background thread, if it is not started yet.
+  RCLCPP_LOCAL
+  void
+  start(size_t queue_size, rclcpp::AsyncLoggingOverflowPolicy overflow_policy);
+
+  /// Output the records which are still queued, and stop the background thread.
+  RCLCPP_LOCAL
+  void
+  stop();
+
+  /// Format the message and queue the record.
+  /**
+   * \return false if the record must be output synchronously instead, i.e. if the dispatcher is
+   *   stopped or if it is called from the background thread, e.g. by the output handler
+   */
+  RCLCPP_LOCAL
+  bool
+  push(
+    const rcutils_log_location_t * location,
+    int severity, const char * name, rcutils_time_point_value_t timestamp,
+    const char * format, va_list * args);
+
+  /// Return the number of records dropped because the queue was full.
+  RCLCPP_LOCAL
+  uint64_t
+  get_dropped_count() const;
+
+private:
+  struct Record
+  {
+    bool has_location;
+    rcutils_log_location_t location;
+    int severity;
+    rcutils_time_point_value_t timestamp;
+    // The capacity of the strings is kept by the slot, so that they allocate only when a record
+    // is longer than all the previous records of the slot.
+    std::string name;
+    std::string message;
+  };
+
+  struct Slot
+  {
+    std::atomic<size_t> sequence{0u};
+    Record record;
+  };
+
+  /// Claim a free slot, or return null if the queue is full.
+  Slot *
+  claim_slot(size_t & position);
+
+  /// Claim a slot, outputting the oldest records until one is free.
+  Slot *
+  claim_slot_making_room(size_t & position);
+
+  /// Pop and output one record, return false if the queue is empty.
+  /**
+   * The output mutex must be held, so the records are popped by a single thread at a time.
+   */
+  bool
+  output_one();
+
+  void
+  run();
+
+  void
+  wake_up();
+
+  const rcutils_logging_output_handler_t output_handler_;
+  const std::shared_ptr<std::recursive_mutex> output_mutex_;
+
+  // Serializes start() and stop().
+  std::mutex state_mutex_;
+  std::atomic<bool> accepting_{false};
+  std::atomic<size_t> active_producers_{0u};
+  rclcpp::AsyncLoggingOverflowPolicy overflow_policy_{rclcpp::AsyncLoggingOverflowPolicy::Drop};
+
+  // Bounded queue using a sequence number per slot, see
+  // https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_{0u};
+  std::atomic<size_t> enqueue_position_{0u};
+  // Only changed while holding the output mutex.
+  std::atomic<size_t> dequeue_position_{0u};
+
+  std::atomic<uint64_t> dropped_count_{0u};
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_condition_;
+  std::atomic<bool> thread_waiting_{false};
+  std::atomic<bool> stopping_{false};
+  std::thread thread_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__ASYNC_LOG_DISPATCHER_HPP_
@@ -0,0 +1,72 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/detail/fast_exit.hpp"
+
+#include <mutex>
+#include <unordered_set>
+
+namespace rclcpp
+{
+namespace detail
+{
+
+namespace
+{
+std::mutex &
+get_fast_exit_contexts_mutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::unordered_set<const rcl_context_t *> &
+get_fast_exit_contexts()
+{
+  static std::unordered_set<const rcl_context_t *> contexts;
+  return contexts;
+}
+}  // namespace
+
+void
+register_fast_exit_context(const rcl_context_t * context)
+{
+  std::lock_guard<std::mutex> lock(get_fast_exit_contexts_mutex());
+  get_fast_exit_contexts().insert(context);
+}
+
+void
+unregister_fast_exit_context(const rcl_context_t * context)
+{
+  std::lock_guard<std::mutex> lock(get_fast_exit_contexts_mutex());
+  get_fast_exit_contexts().erase(context);
+}
+
+bool
+skip_entity_finalization(const rcl_node_t * node_handle)
+{
+  if (!node_handle || !node_handle->context) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(get_fast_exit_contexts_mutex());
+    if (0u == get_fast_exit_contexts().count(node_handle->context)) {
+      return false;
+    }
+  }
+  return !rcl_context_is_valid(node_handle->context);
+}
+
+}  // namespace detail
+}  // namespace rclcpp
@@ -0,0 +1,101 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./local_parameter_events.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace rclcpp
+{
+namespace detail
+{
+
+std::shared_ptr<LocalParameterEvents>
+LocalParameterEvents::get(const rclcpp::Context::SharedPtr & context)
+{
+  return context->get_sub_context<LocalParameterEvents>();
+}
+
+LocalParameterEvents::LocalParameterEvents()
+: observers_(std::make_shared<const Observers>())
+{}
+
+void
+LocalParameterEvents::add_node(const std::string & node_name)
+{
+  std::lock_guard<std::mutex> lock(nodes_mutex_);
+  ++nodes_[node_name];
+}
+
+void
+LocalParameterEvents::remove_node(const std::string & node_name)
+{
+  std::lock_guard<std::mutex> lock(nodes_mutex_);
+  auto it = nodes_.find(node_name);
+  if (it != nodes_.end() && 0u == --it->second) {
+    nodes_.erase(it);
+  }
+}
+
+bool
+LocalParameterEvents::has_node(const std::string & node_name) const
+{
+  std::lock_guard<std::mutex> lock(nodes_mutex_);
+  return nodes_.find(node_name) != nodes_.end();
+}
+
+uint64_t
+LocalParameterEvents::add_observer(ObserverCallback callback)
+{
+  std::lock_guard<std::mutex> lock(observers_mutex_);
+  auto observers = std::make_shared<Observers>(*observers_);
+  const uint64_t observer_id = next_observer_id_++;
+  observers->emplace_back(observer_id, std::move(callback));
+  observers_ = std::move(observers);
+  return observer_id;
+}
+
+void
+LocalParameterEvents::remove_observer(uint64_t observer_id)
+{
+  std::lock_guard<std::mutex> lock(observers_mutex_);
+  auto observers = std::make_shared<Observers>(*observers_);
+  observers->erase(
+    std::remove_if(
+      observers->begin(), observers->end(),
+      [observer_id](const auto & observer) {return observer.first == observer_id;}),
+    observers->end());
+  observers_ = std::move(observers);
+}
+
+void
+LocalParameterEvents::notify(const ParameterEvent & event) const
+{
+  std::shared_ptr<const Observers> observers;
+  {
+    std::lock_guard<std::mutex> lock(observers_mutex_);
+    observers = observers_;
+  }
+  for (const auto & observer : *observers) {
+    observer.second(event);
+  }
+}
+
+}  // namespace detail
+}  // namespace rclcpp
@@ -0,0 +1,113 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__LOCAL_PARAMETER_EVENTS_HPP_
+#define RCLCPP__DETAIL__LOCAL_PARAMETER_EVENTS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "rcl_interfaces/msg/parameter_event.hpp"
+
+#include "rclcpp/context.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// \internal Parameter events of the nodes of a context, passed to the observers in process.
+/**
+ * The nodes publishing their parameter events also give each of them to the observers of
+ * their context, by reference, before it is destroyed, so that the observers in the same
+ * process neither wait for, nor deserialize, the events of these nodes received on the
+ * `/parameter_events` topic.
+ * The observers are called from the thread changing the parameters, with the parameters of
+ * the node locked.
+ *
+ * It is a sub context of the rclcpp::Context, see get().
+ */
+class LocalParameterEvents
+{
+public:
+  using ParameterEvent = rcl_interfaces::msg::ParameterEvent;
+  using ObserverCallback = std::function<void (const ParameterEvent &)>;
+
+  /// Return the local parameter events of the context, creating them if they do not exist.
+  RCLCPP_LOCAL
+  static std::shared_ptr<LocalParameterEvents>
+  get(const rclcpp::Context::SharedPtr & context);
+
+  RCLCPP_LOCAL
+  LocalParameterEvents();
+
+  /// Add a node whose parameter events are given to the observers.
+  /**
+   * The nodes are counted by name, so that a name added twice is removed twice.
+   */
+  RCLCPP_LOCAL
+  void
+  add_node(const std::string & node_name);
+
+  RCLCPP_LOCAL
+  void
+  remove_node(const std::string & node_name);
+
+  /// Return true if the parameter events of the node are given to the observers.
+  RCLCPP_LOCAL
+  bool
+  has_node(const std::string & node_name) const;
+
+  /// Add a callback called with the parameter events of all the added nodes.
+  /**
+   * \return an identifier of the observer for remove_observer()
+   */
+  RCLCPP_LOCAL
+  uint64_t
+  add_observer(ObserverCallback callback);
+
+  /// Remove an observer, whose callback may still be running when this returns.
+  RCLCPP_LOCAL
+  void
+  remove_observer(uint64_t observer_id);
+
+  /// Give a parameter event, published by an added node, to the observers.
+  RCLCPP_LOCAL
+  void
+  notify(const ParameterEvent & event) const;
+
+private:
+  using Observers = std::vector<std::pair<uint64_t, ObserverCallback>>;
+
+  mutable std::mutex nodes_mutex_;
+  std::unordered_map<std::string, size_t> nodes_;
+
+  mutable std::mutex observers_mutex_;
+  // Replaced on each change, so that notify() does not hold the mutex while calling.
+  std::shared_ptr<const Observers> observers_;
+  uint64_t next_observer_id_{0u};
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__LOCAL_PARAMETER_EVENTS_HPP_
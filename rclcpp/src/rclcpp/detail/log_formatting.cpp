@@ -0,0 +1,59 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./log_formatting.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace rclcpp
+{
+namespace detail
+{
+
+void
+format_log_message(std::string & message, const char * format, va_list * args)
+{
+  char buffer[1024];
+  va_list args_copy;
+  va_copy(args_copy, *args);
+  const int length = std::vsnprintf(buffer, sizeof(buffer), format, args_copy);
+  va_end(args_copy);
+  if (length < 0) {
+    message.assign("failed to format the log message");
+  } else if (static_cast<size_t>(length) < sizeof(buffer)) {
+    message.assign(buffer, static_cast<size_t>(length));
+  } else {
+    message.resize(static_cast<size_t>(length));
+    va_copy(args_copy, *args);
+    std::vsnprintf(&message[0], message.size() + 1u, format, args_copy);
+    va_end(args_copy);
+  }
+}
+
+void
+call_output_handler(
+  rcutils_logging_output_handler_t output_handler,
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  output_handler(location, severity, name, timestamp, format, &args);
+  va_end(args);
+}
+
+}  // namespace detail
+}  // namespace rclcpp
@@ -0,0 +1,51 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__LOG_FORMATTING_HPP_
+#define RCLCPP__DETAIL__LOG_FORMATTING_HPP_
+
+#include <cstdarg>
+#include <string>
+
+#include "rcutils/logging.h"
+#include "rcutils/time.h"
+
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// \internal Format the message of a log call into the given string.
+/**
+ * The arguments are only read through copies, so the caller can still use them afterwards.
+ */
+RCLCPP_LOCAL
+void
+format_log_message(std::string & message, const char * format, va_list * args);
+
+/// \internal Call the output handler with an already formatted message.
+RCLCPP_LOCAL
+void
+call_output_handler(
+  rcutils_logging_output_handler_t output_handler,
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, ...);
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__LOG_FORMATTING_HPP_
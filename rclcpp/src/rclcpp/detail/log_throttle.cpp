@@ -0,0 +1,88 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/detail/log_throttle.hpp"
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#include "rcutils/error_handling.h"
+#include "rcutils/time.h"
+
+#include "rclcpp/clock.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+namespace
+{
+
+// Resolution of the coarse monotonic clock, by which a throttling period is shortened.
+int64_t
+coarse_steady_resolution()
+{
+#if defined(__linux__)
+  static const int64_t resolution = []() -> int64_t {
+      struct timespec resolution;
+      if (0 != clock_getres(CLOCK_MONOTONIC_COARSE, &resolution)) {
+        return RCUTILS_MS_TO_NS(10);
+      }
+      return static_cast<int64_t>(resolution.tv_sec) * 1000000000 +
+             static_cast<int64_t>(resolution.tv_nsec);
+    }();
+  return resolution;
+#else
+  return 0;
+#endif
+}
+
+}  // namespace
+
+bool
+LogThrottle::should_log_with_clock(rclcpp::Clock & clock, int64_t duration_ms)
+{
+  const int64_t coarse_now = coarse_steady_now();
+  int64_t now = 0;
+  try {
+    now = clock.now().nanoseconds();
+  } catch (...) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR(
+      "[rclcpp|logging.hpp] a throttled logging macro could not get current time stamp\n");
+    return true;
+  }
+  const int64_t duration = RCUTILS_MS_TO_NS(duration_ms);
+  if (now < last_logged_.load(std::memory_order_relaxed) + duration) {
+    return false;
+  }
+  last_logged_.store(now, std::memory_order_relaxed);
+  bool follows_steady_time = true;
+  try {
+    follows_steady_time = RCL_ROS_TIME != clock.get_clock_type() || !clock.ros_time_is_active();
+  } catch (...) {
+    follows_steady_time = false;
+  }
+  coarse_deadline_.store(
+    follows_steady_time ? coarse_now + duration - coarse_steady_resolution() : 0,
+    std::memory_order_relaxed);
+  // The first record skipped still starts a throttling period.
+  return !(skip_first_ && first_.exchange(false, std::memory_order_relaxed));
+}
+
+}  // namespace detail
+}  // namespace rclcpp
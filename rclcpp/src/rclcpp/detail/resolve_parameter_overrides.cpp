@@ -14,6 +14,7 @@
 
 #include "./resolve_parameter_overrides.hpp"
 
+#include <array>
 #include <string>
 #include <map>
 #include <vector>
@@ -23,49 +24,77 @@
 
 #include "rclcpp/parameter_map.hpp"
 
+static const std::string kWildcardNodeName = "/**";
+
+// Return the parameter map of the parameter files of the arguments, or an empty map.
+static rclcpp::ParameterMap
+parameter_map_from_arguments(const rcl_arguments_t * arguments)
+{
+  rcl_params_t * params = NULL;
+  rcl_ret_t ret = rcl_arguments_get_param_overrides(arguments, &params);
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret);
+  }
+  if (!params) {
+    return {};
+  }
+  auto cleanup_params = rcpputils::make_scope_exit(
+    [params]() {
+      rcl_yaml_node_struct_fini(params);
+    });
+  return rclcpp::parameter_map_from(params);
+}
+
+// Add the parameters of a node to the overrides, overwriting the older ones.
+static void
+add_node_overrides(
+  const rclcpp::ParameterMap & parameter_map,
+  const std::string & node_fqn,
+  std::map<std::string, rclcpp::ParameterValue> & result)
+{
+  // Enforce wildcard matching precedence
+  // TODO(cottsay) implement further wildcard matching
+  const std::array<const std::string *, 2> node_matching_names{&kWildcardNodeName, &node_fqn};
+  for (const std::string * node_name : node_matching_names) {
+    auto it = parameter_map.find(*node_name);
+    if (it != parameter_map.end()) {
+      // Combine parameter yaml files, overwriting values in older ones
+      for (const rclcpp::Parameter & param : it->second) {
+        result[param.get_name()] = param.get_parameter_value();
+      }
+    }
+  }
+}
+
+rclcpp::detail::GlobalParameterOverrides::GlobalParameterOverrides(
+  const rcl_arguments_t * global_args)
+: parameter_map_(parameter_map_from_arguments(global_args))
+{
+}
+
+void
+rclcpp::detail::GlobalParameterOverrides::add_overrides(
+  const std::string & node_fqn,
+  std::map<std::string, rclcpp::ParameterValue> & result) const
+{
+  add_node_overrides(parameter_map_, node_fqn, result);
+}
+
 std::map<std::string, rclcpp::ParameterValue>
 rclcpp::detail::resolve_parameter_overrides(
   const std::string & node_fqn,
   const std::vector<rclcpp::Parameter> & parameter_overrides,
   const rcl_arguments_t * local_args,
-  const rcl_arguments_t * global_args)
+  const GlobalParameterOverrides * global_overrides)
 {
   std::map<std::string, rclcpp::ParameterValue> result;
 
   // global before local so that local overwrites global
-  std::array<const rcl_arguments_t *, 2> argument_sources = {global_args, local_args};
-
-  // Get fully qualified node name post-remapping to use to find node's params in yaml files
-
-  for (const rcl_arguments_t * source : argument_sources) {
-    if (!source) {
-      continue;
-    }
-    rcl_params_t * params = NULL;
-    rcl_ret_t ret = rcl_arguments_get_param_overrides(source, &params);
-    if (RCL_RET_OK != ret) {
-      rclcpp::exceptions::throw_from_rcl_error(ret);
-    }
-    if (params) {
-      auto cleanup_params = rcpputils::make_scope_exit(
-        [params]() {
-          rcl_yaml_node_struct_fini(params);
-        });
-      rclcpp::ParameterMap initial_map = rclcpp::parameter_map_from(params);
-
-      // Enforce wildcard matching precedence
-      // TODO(cottsay) implement further wildcard matching
-      const std::array<std::string, 2> node_matching_names{"/**", node_fqn};
-      for (const auto & node_name : node_matching_names) {
-        if (initial_map.count(node_name) > 0) {
-          // Combine parameter yaml files, overwriting values in older ones
-          for (const rclcpp::Parameter & param : initial_map.at(node_name)) {
-            result[param.get_name()] =
-              rclcpp::ParameterValue(param.get_value_message());
-          }
-        }
-      }
-    }
+  if (global_overrides) {
+    global_overrides->add_overrides(node_fqn, result);
+  }
+  if (local_args) {
+    add_node_overrides(parameter_map_from_arguments(local_args), node_fqn, result);
   }
 
   // parameter overrides passed to constructor will overwrite overrides from yaml file sources
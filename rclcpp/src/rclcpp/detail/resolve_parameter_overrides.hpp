@@ -22,6 +22,7 @@
 #include "rcl/arguments.h"
 
 #include "rclcpp/parameter.hpp"
+#include "rclcpp/parameter_map.hpp"
 #include "rclcpp/parameter_value.hpp"
 #include "rclcpp/visibility_control.hpp"
 
@@ -29,6 +30,32 @@ namespace rclcpp
 {
 namespace detail
 {
+/// \internal Parameter overrides of the global arguments, parsed once for all the nodes.
+/**
+ * It is a sub context of the rclcpp::Context, see rclcpp::Context::get_sub_context(), so that
+ * the parameter files of the global arguments are converted once, instead of once per node.
+ */
+class GlobalParameterOverrides
+{
+public:
+  RCLCPP_LOCAL
+  explicit GlobalParameterOverrides(const rcl_arguments_t * global_args);
+
+  /// Add the overrides of a node to the result, overwriting the ones already in it.
+  /**
+   * The overrides of the wildcard node name are added first, so that the ones of the node
+   * overwrite them.
+   */
+  RCLCPP_LOCAL
+  void
+  add_overrides(
+    const std::string & node_fqn,
+    std::map<std::string, rclcpp::ParameterValue> & result) const;
+
+private:
+  ParameterMap parameter_map_;
+};
+
 /// \internal Get the parameter overrides from the arguments.
 RCLCPP_LOCAL
 std::map<std::string, rclcpp::ParameterValue>
@@ -36,7 +63,7 @@ resolve_parameter_overrides(
   const std::string & node_name,
   const std::vector<rclcpp::Parameter> & parameter_overrides,
   const rcl_arguments_t * local_args,
-  const rcl_arguments_t * global_args);
+  const GlobalParameterOverrides * global_overrides);
 
 }  // namespace detail
 }  // namespace rclcpp
@@ -0,0 +1,104 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "rclcpp/detail/serialized_message_pool.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rcutils/allocator.h"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+SerializedMessagePool::SerializedMessagePool(
+  size_t max_size,
+  const rcl_allocator_t & allocator)
+: max_size_(max_size),
+  allocator_(allocator)
+{
+  messages_.reserve(max_size_);
+}
+
+SerializedMessagePool::~SerializedMessagePool()
+{
+  for (rclcpp::SerializedMessage * message : messages_) {
+    delete message;
+  }
+}
+
+std::shared_ptr<rclcpp::SerializedMessage>
+SerializedMessagePool::borrow(size_t capacity)
+{
+  rclcpp::SerializedMessage * message = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!messages_.empty()) {
+      message = messages_.back();
+      messages_.pop_back();
+    }
+  }
+  if (nullptr == message) {
+    message = new rclcpp::SerializedMessage(capacity, allocator_);
+  } else if (message->capacity() < capacity) {
+    message->reserve(capacity);
+  }
+
+  std::weak_ptr<SerializedMessagePool> weak_pool = shared_from_this();
+  return std::shared_ptr<rclcpp::SerializedMessage>(
+    message,
+    [weak_pool](rclcpp::SerializedMessage * msg) {
+      auto pool = weak_pool.lock();
+      if (pool) {
+        pool->recycle(msg);
+      } else {
+        delete msg;
+      }
+    });
+}
+
+size_t
+SerializedMessagePool::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return messages_.size();
+}
+
+void
+SerializedMessagePool::recycle(rclcpp::SerializedMessage * message)
+{
+  auto & rcl_message = message->get_rcl_serialized_message();
+  // The buffer may have been moved out, e.g. to be published again, leaving nothing to reuse.
+  if (!rcutils_allocator_is_valid(&rcl_message.allocator)) {
+    delete message;
+    return;
+  }
+  // Keep the buffer, only its content is discarded.
+  rcl_message.buffer_length = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (messages_.size() < max_size_) {
+      messages_.push_back(message);
+      return;
+    }
+  }
+  delete message;
+}
+
+}  // namespace detail
+}  // namespace rclcpp
@@ -0,0 +1,144 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./shared_clock_source.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "rclcpp/node_options.hpp"
+#include "rclcpp/parameter.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+namespace
+{
+
+// Sub context of the rclcpp::Context, which does not keep the clock source alive.
+struct SharedClockSourceRegistry
+{
+  std::mutex mutex;
+  std::weak_ptr<SharedClockSource> clock_source;
+};
+
+}  // namespace
+
+std::shared_ptr<SharedClockSource>
+SharedClockSource::get(const rclcpp::Context::SharedPtr & context, const rclcpp::QoS & qos)
+{
+  auto registry = context->get_sub_context<SharedClockSourceRegistry>();
+  std::lock_guard<std::mutex> lock(registry->mutex);
+  auto clock_source = registry->clock_source.lock();
+  if (!clock_source) {
+    clock_source = std::make_shared<SharedClockSource>(context, qos);
+    registry->clock_source = clock_source;
+  }
+  return clock_source;
+}
+
+SharedClockSource::SharedClockSource(
+  const rclcpp::Context::SharedPtr & context,
+  const rclcpp::QoS & qos)
+: listeners_(std::make_shared<const Listeners>())
+{
+  // The node is hidden and has no time source subscription of its own, even if the global
+  // arguments set use_sim_time for all the nodes.
+  node_ = std::make_shared<rclcpp::Node>(
+    "_clock_source_" + std::to_string(reinterpret_cast<uintptr_t>(this)),
+    rclcpp::NodeOptions()
+    .context(context)
+    .enable_rosout(false)
+    .start_parameter_services(false)
+    .start_parameter_event_publisher(false)
+    .use_clock_thread(false)
+    .parameter_overrides({rclcpp::Parameter("use_sim_time", false)}));
+
+  subscription_ = node_->create_subscription<ClockMessage>(
+    "/clock", qos,
+    [this](std::shared_ptr<const ClockMessage> msg) {
+      on_clock(std::move(msg));
+    });
+
+  rclcpp::ExecutorOptions executor_options;
+  executor_options.context = context;
+  executor_ = std::make_shared<rclcpp::executors::SingleThreadedExecutor>(executor_options);
+  executor_->add_node(node_);
+  // The thread holds the executor and the node, so that it can finish on its own, see the
+  // destructor.
+  executor_thread_ = std::thread(
+    [executor = executor_, node = node_, future = cancel_executor_promise_.get_future()]() {
+      executor->spin_until_future_complete(future);
+    });
+}
+
+SharedClockSource::~SharedClockSource()
+{
+  cancel_executor_promise_.set_value();
+  executor_->cancel();
+  if (executor_thread_.get_id() == std::this_thread::get_id()) {
+    // The last listener released the clock source from its callback, the thread finishes once
+    // the callback returns.
+    executor_thread_.detach();
+  } else {
+    executor_thread_.join();
+  }
+}
+
+uint64_t
+SharedClockSource::add_listener(ListenerCallback callback)
+{
+  std::lock_guard<std::mutex> lock(listeners_mutex_);
+  auto listeners = std::make_shared<Listeners>(*listeners_);
+  const uint64_t listener_id = next_listener_id_++;
+  listeners->emplace_back(listener_id, std::move(callback));
+  listeners_ = std::move(listeners);
+  return listener_id;
+}
+
+void
+SharedClockSource::remove_listener(uint64_t listener_id)
+{
+  std::lock_guard<std::mutex> lock(listeners_mutex_);
+  auto listeners = std::make_shared<Listeners>(*listeners_);
+  listeners->erase(
+    std::remove_if(
+      listeners->begin(), listeners->end(),
+      [listener_id](const auto & listener) {return listener.first == listener_id;}),
+    listeners->end());
+  listeners_ = std::move(listeners);
+}
+
+void
+SharedClockSource::on_clock(std::shared_ptr<const ClockMessage> msg)
+{
+  std::shared_ptr<const Listeners> listeners;
+  {
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    listeners = listeners_;
+  }
+  // Only the local copy is used from here, since a listener may destroy the clock source.
+  for (const auto & listener : *listeners) {
+    listener.second(msg);
+  }
+}
+
+}  // namespace detail
+}  // namespace rclcpp
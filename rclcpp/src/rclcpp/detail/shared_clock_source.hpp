@@ -0,0 +1,101 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__SHARED_CLOCK_SOURCE_HPP_
+#define RCLCPP__DETAIL__SHARED_CLOCK_SOURCE_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rosgraph_msgs/msg/clock.hpp"
+
+#include "rclcpp/context.hpp"
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rclcpp/node.hpp"
+#include "rclcpp/qos.hpp"
+#include "rclcpp/subscription.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// \internal Subscription to the /clock topic shared by the time sources of a context.
+/**
+ * A single subscription, on a hidden node spun by a dedicated thread, receives the clock
+ * messages and passes each of them to all the listeners, so that the nodes using simulated time
+ * do not subscribe to, and deserialize, the clock messages once each.
+ *
+ * The clock source of a context is created by the first get(), with the QoS given to it, and is
+ * destroyed once no listener holds it anymore.
+ */
+class SharedClockSource
+{
+public:
+  using ClockMessage = rosgraph_msgs::msg::Clock;
+  using ListenerCallback = std::function<void (std::shared_ptr<const ClockMessage>)>;
+
+  /// Return the clock source of the context, creating it if it does not exist.
+  RCLCPP_LOCAL
+  static std::shared_ptr<SharedClockSource>
+  get(const rclcpp::Context::SharedPtr & context, const rclcpp::QoS & qos);
+
+  RCLCPP_LOCAL
+  SharedClockSource(const rclcpp::Context::SharedPtr & context, const rclcpp::QoS & qos);
+
+  RCLCPP_LOCAL
+  ~SharedClockSource();
+
+  /// Add a callback called with each clock message, from the thread of the clock source.
+  /**
+   * \return an identifier of the listener for remove_listener()
+   */
+  RCLCPP_LOCAL
+  uint64_t
+  add_listener(ListenerCallback callback);
+
+  /// Remove a listener, whose callback may still be running when this returns.
+  RCLCPP_LOCAL
+  void
+  remove_listener(uint64_t listener_id);
+
+private:
+  void
+  on_clock(std::shared_ptr<const ClockMessage> msg);
+
+  using Listeners = std::vector<std::pair<uint64_t, ListenerCallback>>;
+
+  std::mutex listeners_mutex_;
+  // Replaced on each change, so that the clock callback does not hold the mutex while calling.
+  std::shared_ptr<const Listeners> listeners_;
+  uint64_t next_listener_id_{0u};
+
+  rclcpp::Node::SharedPtr node_;
+  rclcpp::Subscription<ClockMessage>::SharedPtr subscription_;
+  rclcpp::executors::SingleThreadedExecutor::SharedPtr executor_;
+  std::promise<void> cancel_executor_promise_;
+  std::thread executor_thread_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__SHARED_CLOCK_SOURCE_HPP_
@@ -0,0 +1,697 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./shared_node_infrastructure.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "rcl/logging.h"
+#include "rcpputils/scope_exit.hpp"
+
+#include "rclcpp/exceptions.hpp"
+#include "rclcpp/logging.hpp"
+#include "rclcpp/node_options.hpp"
+#include "rclcpp/parameter.hpp"
+#include "rclcpp/parameter_client.hpp"
+#include "rclcpp/time.hpp"
+
+#include "../parameter_service_names.hpp"
+#include "./log_formatting.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+namespace
+{
+
+// Sub context of the rclcpp::Context, which does not keep the infrastructure alive.
+struct SharedNodeInfrastructureRegistry
+{
+  std::mutex mutex;
+  std::weak_ptr<SharedNodeInfrastructure> infrastructure;
+};
+
+// Loggers publishing through a shared /rosout publisher, for the logging output handler.
+struct SharedRosoutLoggers
+{
+  std::mutex mutex;
+  // Number of add_rosout_logger() calls and infrastructure, by logger name.
+  std::map<std::string, std::pair<size_t, std::weak_ptr<SharedNodeInfrastructure>>> loggers;
+};
+
+SharedRosoutLoggers &
+get_shared_rosout_loggers()
+{
+  static SharedRosoutLoggers shared_rosout_loggers;
+  return shared_rosout_loggers;
+}
+
+// Checked by the output handler before locking, since most processes do not use it.
+std::atomic<size_t> shared_rosout_logger_count{0u};
+
+// Set while publishing a log record, so that the records logged meanwhile are not published.
+thread_local bool publishing_to_shared_rosout = false;
+
+// Return the key identifying the repetitions of a log record.
+std::string
+make_rosout_record_key(const rcl_interfaces::msg::Log & record)
+{
+  std::string key;
+  key.reserve(
+    record.name.size() + record.file.size() + record.function.size() + record.msg.size() + 16u);
+  key.append(record.name).append(1u, '\0');
+  key.append(std::to_string(record.level)).append(1u, '\0');
+  key.append(record.file).append(1u, '\0');
+  key.append(record.function).append(1u, '\0');
+  key.append(std::to_string(record.line)).append(1u, '\0');
+  key.append(record.msg);
+  return key;
+}
+
+}  // namespace
+
+std::shared_ptr<SharedNodeInfrastructure>
+SharedNodeInfrastructure::get(const rclcpp::Context::SharedPtr & context)
+{
+  auto registry = context->get_sub_context<SharedNodeInfrastructureRegistry>();
+  std::lock_guard<std::mutex> lock(registry->mutex);
+  auto infrastructure = registry->infrastructure.lock();
+  if (!infrastructure) {
+    infrastructure = std::make_shared<SharedNodeInfrastructure>(context);
+    registry->infrastructure = infrastructure;
+  }
+  return infrastructure;
+}
+
+SharedNodeInfrastructure::SharedNodeInfrastructure(const rclcpp::Context::SharedPtr & context)
+: rosout_aggregation_(context->get_init_options().rosout_aggregation()),
+  rosout_budget_(static_cast<double>(rosout_aggregation_.max_records_per_second)),
+  rosout_budget_time_(std::chrono::steady_clock::now()),
+  parameter_event_listeners_(std::make_shared<const ParameterEventListeners>())
+{
+  // The name is random, since the parameter services must not clash with the ones of the other
+  // processes.
+  std::random_device random_device;
+  node_ = std::make_shared<rclcpp::Node>(
+    "_node_infrastructure_" + std::to_string(random_device()),
+    rclcpp::NodeOptions()
+    .context(context)
+    .enable_rosout(false)
+    .start_parameter_services(false)
+    .start_parameter_event_publisher(false)
+    .use_clock_thread(false)
+    .parameter_overrides({rclcpp::Parameter("use_sim_time", false)}));
+
+  rclcpp::ExecutorOptions executor_options;
+  executor_options.context = context;
+  executor_ = std::make_shared<rclcpp::executors::SingleThreadedExecutor>(executor_options);
+  executor_->add_node(node_);
+  // The thread holds the executor and the node, so that it can finish on its own, see the
+  // destructor.
+  executor_thread_ = std::thread(
+    [executor = executor_, node = node_, future = cancel_executor_promise_.get_future()]() {
+      executor->spin_until_future_complete(future);
+    });
+}
+
+SharedNodeInfrastructure::~SharedNodeInfrastructure()
+{
+  if (rosout_timer_) {
+    rosout_timer_->cancel();
+    try {
+      publish_pending_rosout_records(true);
+    } catch (const std::exception &) {
+      // The context may be shutdown already, the pending records are lost.
+    }
+  }
+  cancel_executor_promise_.set_value();
+  executor_->cancel();
+  if (executor_thread_.get_id() == std::this_thread::get_id()) {
+    // The last node was released from a callback of the infrastructure, the thread finishes once
+    // the callback returns.
+    executor_thread_.detach();
+  } else {
+    executor_thread_.join();
+  }
+}
+
+std::string
+SharedNodeInfrastructure::get_fully_qualified_name() const
+{
+  return node_->get_fully_qualified_name();
+}
+
+rclcpp::Publisher<SharedNodeInfrastructure::ParameterEvent>::SharedPtr
+SharedNodeInfrastructure::get_parameter_event_publisher(
+  const rclcpp::QoS & qos,
+  const rclcpp::PublisherOptionsBase & options)
+{
+  std::lock_guard<std::mutex> lock(publishers_mutex_);
+  if (!parameter_event_publisher_) {
+    rclcpp::PublisherOptionsWithAllocator<std::allocator<void>> publisher_options(options);
+    parameter_event_publisher_ = node_->create_publisher<ParameterEvent>(
+      "/parameter_events", qos, publisher_options);
+  }
+  return parameter_event_publisher_;
+}
+
+uint64_t
+SharedNodeInfrastructure::add_parameter_event_listener(
+  const std::string & node_name,
+  ParameterEventCallback callback)
+{
+  std::lock_guard<std::mutex> lock(parameter_event_listeners_mutex_);
+  if (!parameter_event_subscription_) {
+    parameter_event_subscription_ = rclcpp::AsyncParametersClient::on_parameter_event(
+      node_,
+      [this](std::shared_ptr<const ParameterEvent> event) {
+        on_parameter_event(std::move(event));
+      });
+  }
+  auto listeners = std::make_shared<ParameterEventListeners>(*parameter_event_listeners_);
+  const uint64_t listener_id = next_parameter_event_listener_id_++;
+  listeners->push_back({listener_id, node_name, std::move(callback)});
+  parameter_event_listeners_ = std::move(listeners);
+  return listener_id;
+}
+
+void
+SharedNodeInfrastructure::remove_parameter_event_listener(uint64_t listener_id)
+{
+  std::lock_guard<std::mutex> lock(parameter_event_listeners_mutex_);
+  auto listeners = std::make_shared<ParameterEventListeners>(*parameter_event_listeners_);
+  listeners->erase(
+    std::remove_if(
+      listeners->begin(), listeners->end(),
+      [listener_id](const ParameterEventListener & listener) {return listener.id == listener_id;}),
+    listeners->end());
+  parameter_event_listeners_ = std::move(listeners);
+}
+
+void
+SharedNodeInfrastructure::on_parameter_event(std::shared_ptr<const ParameterEvent> event)
+{
+  // A listener may release the last node holding the infrastructure.
+  auto self = weak_from_this().lock();
+  if (!self) {
+    return;
+  }
+  std::shared_ptr<const ParameterEventListeners> listeners;
+  {
+    std::lock_guard<std::mutex> lock(parameter_event_listeners_mutex_);
+    listeners = parameter_event_listeners_;
+  }
+  for (const auto & listener : *listeners) {
+    if (listener.node_name == event->node) {
+      listener.callback(event);
+    }
+  }
+}
+
+void
+SharedNodeInfrastructure::add_node_parameters(
+  const std::string & node_name,
+  NodeParametersPtr node_parameters)
+{
+  std::lock_guard<std::recursive_mutex> lock(parameters_mutex_);
+  if (!node_parameters_.emplace(node_name, node_parameters).second) {
+    RCLCPP_WARN(
+      node_->get_logger(),
+      "the parameters of another node named '%s' are already served, not serving the new ones",
+      node_name.c_str());
+    return;
+  }
+  if (!get_parameters_service_) {
+    create_parameter_services();
+  }
+}
+
+void
+SharedNodeInfrastructure::remove_node_parameters(NodeParametersPtr node_parameters)
+{
+  std::lock_guard<std::recursive_mutex> lock(parameters_mutex_);
+  for (auto it = node_parameters_.begin(); it != node_parameters_.end(); ++it) {
+    if (it->second == node_parameters) {
+      node_parameters_.erase(it);
+      return;
+    }
+  }
+}
+
+SharedNodeInfrastructure::ParameterName
+SharedNodeInfrastructure::find_parameter(const std::string & name) const
+{
+  // The longest node name followed by a '/' is the node of the parameter.
+  for (size_t separator = name.rfind('/');
+    separator != std::string::npos && separator > 0u;
+    separator = name.rfind('/', separator - 1u))
+  {
+    auto it = node_parameters_.find(name.substr(0u, separator));
+    if (it != node_parameters_.end()) {
+      return {it->second, name.substr(separator + 1u)};
+    }
+  }
+  return {nullptr, ""};
+}
+
+void
+SharedNodeInfrastructure::list_node_parameters(
+  const std::string & node_name,
+  NodeParametersPtr node_parameters,
+  const std::vector<std::string> & prefixes,
+  uint64_t depth,
+  rcl_interfaces::msg::ListParametersResult & result) const
+{
+  auto node_result = node_parameters->list_parameters(prefixes, depth);
+  auto append = [&node_name](std::vector<std::string> & names, std::vector<std::string> & to) {
+      for (const auto & name : names) {
+        std::string shared_name = node_name + "/" + name;
+        if (std::find(to.begin(), to.end(), shared_name) == to.end()) {
+          to.push_back(std::move(shared_name));
+        }
+      }
+    };
+  append(node_result.names, result.names);
+  append(node_result.prefixes, result.prefixes);
+}
+
+void
+SharedNodeInfrastructure::create_parameter_services()
+{
+  using rclcpp::exceptions::ParameterNotDeclaredException;
+  const std::string node_name = node_->get_name();
+  auto find_declared = [this](const std::string & name) {
+      auto parameter_name = find_parameter(name);
+      if (!parameter_name.first) {
+        throw ParameterNotDeclaredException("no node has the parameter '" + name + "'");
+      }
+      return parameter_name;
+    };
+
+  get_parameters_service_ = node_->create_service<rcl_interfaces::srv::GetParameters>(
+    node_name + "/" + parameter_service_names::get_parameters,
+    [this, find_declared](
+      const std::shared_ptr<rmw_request_id_t>,
+      const std::shared_ptr<rcl_interfaces::srv::GetParameters::Request> request,
+      std::shared_ptr<rcl_interfaces::srv::GetParameters::Response> response)
+    {
+      auto self = weak_from_this().lock();
+      if (!self) {
+        return;
+      }
+      std::lock_guard<std::recursive_mutex> lock(parameters_mutex_);
+      try {
+        for (const auto & name : request->names) {
+          auto parameter_name = find_declared(name);
+          response->values.push_back(
+            parameter_name.first->get_parameter(parameter_name.second).get_value_message());
+        }
+      } catch (const ParameterNotDeclaredException & ex) {
+        RCLCPP_DEBUG(rclcpp::get_logger("rclcpp"), "Failed to get parameters: %s", ex.what());
+        response->values.clear();
+      }
+    },
+    rmw_qos_profile_parameters);
+
+  get_parameter_types_service_ = node_->create_service<rcl_interfaces::srv::GetParameterTypes>(
+    node_name + "/" + parameter_service_names::get_parameter_types,
+    [this, find_declared](
+      const std::shared_ptr<rmw_request_id_t>,
+      const std::shared_ptr<rcl_interfaces::srv::GetParameterTypes::Request> request,
+      std::shared_ptr<rcl_interfaces::srv::GetParameterTypes::Response> response)
+    {
+      auto self = weak_from_this().lock();
+      if (!self) {
+        return;
+      }
+      std::lock_guard<std::recursive_mutex> lock(parameters_mutex_);
+      try {
+        for (const auto & name : request->names) {
+          auto parameter_name = find_declared(name);
+          response->types.push_back(
+            parameter_name.first->get_parameter_types({parameter_name.second}).at(0));
+        }
+      } catch (const ParameterNotDeclaredException & ex) {
+        RCLCPP_DEBUG(rclcpp::get_logger("rclcpp"), "Failed to get parameter types: %s", ex.what());
+        response->types.clear();
+      }
+    },
+    rmw_qos_profile_parameters);
+
+  set_parameters_service_ = node_->create_service<rcl_interfaces::srv::SetParameters>(
+    node_name + "/" + parameter_service_names::set_parameters,
+    [this, find_declared](
+      const std::shared_ptr<rmw_request_id_t>,
+      const std::shared_ptr<rcl_interfaces::srv::SetParameters::Request> request,
+      std::shared_ptr<rcl_interfaces::srv::SetParameters::Response> response)
+    {
+      auto self = weak_from_this().lock();
+      if (!self) {
+        return;
+      }
+      std::lock_guard<std::recursive_mutex> lock(parameters_mutex_);
+      // Set parameters one-by-one, like the parameter services of a node.
+      for (const auto & p : request->parameters) {
+        auto result = rcl_interfaces::msg::SetParametersResult();
+        try {
+          auto parameter_name = find_declared(p.name);
+          result = parameter_name.first->set_parameters_atomically(
+            {rclcpp::Parameter(parameter_name.second, rclcpp::ParameterValue(p.value))});
+        } catch (const ParameterNotDeclaredException & ex) {
+          RCLCPP_DEBUG(rclcpp::get_logger("rclcpp"), "Failed to set parameter: %s", ex.what());
+          result.successful = false;
+          result.reason = ex.what();
+        }
+        response->results.push_back(result);
+      }
+    },
+    rmw_qos_profile_parameters);
+
+  set_parameters_atomically_service_ =
+    node_->create_service<rcl_interfaces::srv::SetParametersAtomically>(
+    node_name + "/" + parameter_service_names::set_parameters_atomically,
+    [this, find_declared](
+      const std::shared_ptr<rmw_request_id_t>,
+      const std::shared_ptr<rcl_interfaces::srv::SetParametersAtomically::Request> request,
+      std::shared_ptr<rcl_interfaces::srv::SetParametersAtomically::Response> response)
+    {
+      auto self = weak_from_this().lock();
+      if (!self) {
+        return;
+      }
+      std::lock_guard<std::recursive_mutex> lock(parameters_mutex_);
+      try {
+        NodeParametersPtr node_parameters = nullptr;
+        std::vector<rclcpp::Parameter> parameters;
+        for (const auto & p : request->parameters) {
+          auto parameter_name = find_declared(p.name);
+          if (node_parameters && node_parameters != parameter_name.first) {
+            response->result.successful = false;
+            response->result.reason =
+              "The parameters of several nodes cannot be set atomically";
+            return;
+          }
+          node_parameters = parameter_name.first;
+          parameters.emplace_back(parameter_name.second, rclcpp::ParameterValue(p.value));
+        }
+        if (!node_parameters) {
+          response->result.successful = true;
+          return;
+        }
+        response->result = node_parameters->set_parameters_atomically(parameters);
+      } catch (const ParameterNotDeclaredException & ex) {
+        RCLCPP_DEBUG(
+          rclcpp::get_logger("rclcpp"), "Failed to set parameters atomically: %s", ex.what());
+        response->result.successful = false;
+        response->result.reason = "One or more parameters were not declared before setting";
+      }
+    },
+    rmw_qos_profile_parameters);
+
+  describe_parameters_service_ = node_->create_service<rcl_interfaces::srv::DescribeParameters>(
+    node_name + "/" + parameter_service_names::describe_parameters,
+    [this, find_declared](
+      const std::shared_ptr<rmw_request_id_t>,
+      const std::shared_ptr<rcl_interfaces::srv::DescribeParameters::Request> request,
+      std::shared_ptr<rcl_interfaces::srv::DescribeParameters::Response> response)
+    {
+      auto self = weak_from_this().lock();
+      if (!self) {
+        return;
+      }
+      std::lock_guard<std::recursive_mutex> lock(parameters_mutex_);
+      try {
+        for (const auto & name : request->names) {
+          auto parameter_name = find_declared(name);
+          auto descriptor =
+            parameter_name.first->describe_parameters({parameter_name.second}).at(0);
+          descriptor.name = name;
+          response->descriptors.push_back(std::move(descriptor));
+        }
+      } catch (const ParameterNotDeclaredException & ex) {
+        RCLCPP_DEBUG(rclcpp::get_logger("rclcpp"), "Failed to describe parameters: %s", ex.what());
+        response->descriptors.clear();
+      }
+    },
+    rmw_qos_profile_parameters);
+
+  list_parameters_service_ = node_->create_service<rcl_interfaces::srv::ListParameters>(
+    node_name + "/" + parameter_service_names::list_parameters,
+    [this](
+      const std::shared_ptr<rmw_request_id_t>,
+      const std::shared_ptr<rcl_interfaces::srv::ListParameters::Request> request,
+      std::shared_ptr<rcl_interfaces::srv::ListParameters::Response> response)
+    {
+      auto self = weak_from_this().lock();
+      if (!self) {
+        return;
+      }
+      std::lock_guard<std::recursive_mutex> lock(parameters_mutex_);
+      if (request->prefixes.empty()) {
+        for (const auto & node_parameters : node_parameters_) {
+          list_node_parameters(
+            node_parameters.first, node_parameters.second, {}, request->depth, response->result);
+        }
+        return;
+      }
+      for (const auto & prefix : request->prefixes) {
+        // A prefix is either the name of a node, or the name of a node followed by a prefix of
+        // its parameters.
+        auto it = node_parameters_.find(prefix);
+        if (it != node_parameters_.end()) {
+          list_node_parameters(it->first, it->second, {}, request->depth, response->result);
+          continue;
+        }
+        auto parameter_name = find_parameter(prefix);
+        if (parameter_name.first) {
+          const std::string node_name = prefix.substr(
+            0u, prefix.size() - parameter_name.second.size() - 1u);
+          list_node_parameters(
+            node_name, parameter_name.first, {parameter_name.second}, request->depth,
+            response->result);
+        }
+      }
+    },
+    rmw_qos_profile_parameters);
+}
+
+void
+SharedNodeInfrastructure::add_rosout_logger(
+  const std::string & logger_name,
+  const rclcpp::QoS & qos)
+{
+  if (!rcl_logging_rosout_enabled()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(publishers_mutex_);
+    if (!rosout_publisher_) {
+      rosout_publisher_ = node_->create_publisher<rcl_interfaces::msg::Log>("/rosout", qos);
+      if (rosout_aggregation_.enabled) {
+        rosout_timer_ = node_->create_wall_timer(
+          rosout_aggregation_.period,
+          [weak_this = weak_from_this()]() {
+            auto shared_this = weak_this.lock();
+            if (shared_this) {
+              shared_this->publish_pending_rosout_records(false);
+            }
+          });
+      }
+    }
+  }
+  auto & shared_rosout_loggers = get_shared_rosout_loggers();
+  std::lock_guard<std::mutex> lock(shared_rosout_loggers.mutex);
+  auto & logger = shared_rosout_loggers.loggers[logger_name];
+  if (0u == logger.first++) {
+    logger.second = weak_from_this();
+  }
+  shared_rosout_logger_count.fetch_add(1u);
+}
+
+void
+SharedNodeInfrastructure::remove_rosout_logger(const std::string & logger_name)
+{
+  auto & shared_rosout_loggers = get_shared_rosout_loggers();
+  std::lock_guard<std::mutex> lock(shared_rosout_loggers.mutex);
+  auto it = shared_rosout_loggers.loggers.find(logger_name);
+  if (it == shared_rosout_loggers.loggers.end()) {
+    return;
+  }
+  if (0u == --it->second.first) {
+    shared_rosout_loggers.loggers.erase(it);
+  }
+  shared_rosout_logger_count.fetch_sub(1u);
+}
+
+void
+SharedNodeInfrastructure::publish_rosout_record(rcl_interfaces::msg::Log && record)
+{
+  if (!rosout_aggregation_.enabled) {
+    std::shared_ptr<rclcpp::Publisher<rcl_interfaces::msg::Log>> rosout_publisher;
+    {
+      std::lock_guard<std::mutex> lock(publishers_mutex_);
+      rosout_publisher = rosout_publisher_;
+    }
+    if (rosout_publisher) {
+      rosout_publisher->publish(record);
+    }
+    return;
+  }
+  std::string key = make_rosout_record_key(record);
+  std::lock_guard<std::mutex> lock(pending_rosout_records_mutex_);
+  auto it = pending_rosout_record_indices_.find(key);
+  if (it != pending_rosout_record_indices_.end()) {
+    ++pending_rosout_records_[it->second].count;
+    return;
+  }
+  if (pending_rosout_records_.size() >= rosout_aggregation_.max_pending_records) {
+    ++dropped_rosout_records_;
+    return;
+  }
+  pending_rosout_record_indices_.emplace(key, pending_rosout_records_.size());
+  pending_rosout_records_.push_back(PendingRosoutRecord{std::move(key), std::move(record), 1u});
+}
+
+void
+SharedNodeInfrastructure::publish_pending_rosout_records(bool unlimited)
+{
+  std::vector<PendingRosoutRecord> records;
+  size_t dropped_records = 0u;
+  {
+    std::lock_guard<std::mutex> lock(pending_rosout_records_mutex_);
+    size_t number_of_records = pending_rosout_records_.size();
+    const size_t max_records_per_second = rosout_aggregation_.max_records_per_second;
+    if (!unlimited && 0u != max_records_per_second) {
+      // The budget is refilled with the elapsed time, up to the records of one second.
+      const auto now = std::chrono::steady_clock::now();
+      const std::chrono::duration<double> elapsed = now - rosout_budget_time_;
+      rosout_budget_time_ = now;
+      rosout_budget_ = std::min(
+        static_cast<double>(max_records_per_second),
+        rosout_budget_ + elapsed.count() * static_cast<double>(max_records_per_second));
+      number_of_records = std::min(number_of_records, static_cast<size_t>(rosout_budget_));
+      rosout_budget_ -= static_cast<double>(number_of_records);
+    }
+    if (number_of_records == pending_rosout_records_.size()) {
+      records.swap(pending_rosout_records_);
+      pending_rosout_record_indices_.clear();
+    } else if (0u != number_of_records) {
+      const auto first_kept = pending_rosout_records_.begin() +
+        static_cast<std::ptrdiff_t>(number_of_records);
+      records.assign(
+        std::make_move_iterator(pending_rosout_records_.begin()),
+        std::make_move_iterator(first_kept));
+      pending_rosout_records_.erase(pending_rosout_records_.begin(), first_kept);
+      pending_rosout_record_indices_.clear();
+      for (size_t i = 0u; i < pending_rosout_records_.size(); ++i) {
+        pending_rosout_record_indices_.emplace(pending_rosout_records_[i].key, i);
+      }
+    }
+    std::swap(dropped_records, dropped_rosout_records_);
+  }
+  if (records.empty() && 0u == dropped_records) {
+    return;
+  }
+
+  std::shared_ptr<rclcpp::Publisher<rcl_interfaces::msg::Log>> rosout_publisher;
+  {
+    std::lock_guard<std::mutex> lock(publishers_mutex_);
+    rosout_publisher = rosout_publisher_;
+  }
+  // The records logged while publishing, e.g. by the middleware, are not published.
+  publishing_to_shared_rosout = true;
+  auto reset_publishing = rcpputils::make_scope_exit(
+    []() {
+      publishing_to_shared_rosout = false;
+    });
+  for (auto & pending_record : records) {
+    if (pending_record.count > 1u) {
+      pending_record.record.msg +=
+        " (logged " + std::to_string(pending_record.count) + " times)";
+    }
+    rosout_publisher->publish(pending_record.record);
+  }
+  if (0u != dropped_records) {
+    rcl_interfaces::msg::Log record;
+    record.stamp = node_->now();
+    record.level = rcl_interfaces::msg::Log::WARN;
+    record.name = "rclcpp";
+    record.msg = std::to_string(dropped_records) +
+      " log records were dropped, since too many were waiting to be published to /rosout";
+    rosout_publisher->publish(record);
+  }
+}
+
+void
+publish_to_shared_rosout(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args)
+{
+  if (0u == shared_rosout_logger_count.load(std::memory_order_relaxed) ||
+    publishing_to_shared_rosout || !name)
+  {
+    return;
+  }
+  publishing_to_shared_rosout = true;
+  auto reset_publishing = rcpputils::make_scope_exit(
+    []() {
+      publishing_to_shared_rosout = false;
+    });
+
+  std::shared_ptr<SharedNodeInfrastructure> infrastructure;
+  {
+    auto & shared_rosout_loggers = get_shared_rosout_loggers();
+    std::lock_guard<std::mutex> lock(shared_rosout_loggers.mutex);
+    auto it = shared_rosout_loggers.loggers.find(name);
+    if (it == shared_rosout_loggers.loggers.end()) {
+      return;
+    }
+    infrastructure = it->second.second.lock();
+  }
+  if (!infrastructure) {
+    return;
+  }
+
+  rcl_interfaces::msg::Log log_message;
+  log_message.stamp = rclcpp::Time(timestamp);
+  log_message.level = static_cast<uint8_t>(severity);
+  log_message.name = name;
+  format_log_message(log_message.msg, format, args);
+  if (location) {
+    log_message.file = location->file_name;
+    log_message.function = location->function_name;
+    log_message.line = static_cast<uint32_t>(location->line_number);
+  }
+  infrastructure->publish_rosout_record(std::move(log_message));
+}
+
+}  // namespace detail
+}  // namespace rclcpp
@@ -0,0 +1,256 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__SHARED_NODE_INFRASTRUCTURE_HPP_
+#define RCLCPP__DETAIL__SHARED_NODE_INFRASTRUCTURE_HPP_
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "rcl_interfaces/msg/log.hpp"
+#include "rcl_interfaces/msg/parameter_event.hpp"
+#include "rcl_interfaces/srv/describe_parameters.hpp"
+#include "rcl_interfaces/srv/get_parameter_types.hpp"
+#include "rcl_interfaces/srv/get_parameters.hpp"
+#include "rcl_interfaces/srv/list_parameters.hpp"
+#include "rcl_interfaces/srv/set_parameters.hpp"
+#include "rcl_interfaces/srv/set_parameters_atomically.hpp"
+#include "rcutils/logging.h"
+
+#include "rclcpp/context.hpp"
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rclcpp/init_options.hpp"
+#include "rclcpp/node.hpp"
+#include "rclcpp/node_interfaces/node_parameters_interface.hpp"
+#include "rclcpp/publisher.hpp"
+#include "rclcpp/publisher_options.hpp"
+#include "rclcpp/qos.hpp"
+#include "rclcpp/service.hpp"
+#include "rclcpp/subscription.hpp"
+#include "rclcpp/timer.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// \internal Entities shared by the nodes of a context which use the shared infrastructure.
+/**
+ * The nodes created with rclcpp::NodeOptions::use_shared_infrastructure() use, instead of their
+ * own entities:
+ *
+ *   - a single `/parameter_events` publisher, the events still name the node they are about,
+ *   - a single `/parameter_events` subscription for their time sources,
+ *   - a single set of parameter services, where the parameters of a node are named after the
+ *     fully qualified name of the node, e.g. `/ns/talker/rate`,
+ *   - a single `/rosout` publisher, the log records still name their logger.
+ *
+ * The `/rosout` publisher is also used by the other nodes of a context which aggregates the
+ * rosout records, see rclcpp::InitOptions::rosout_aggregation().
+ *
+ * The entities live on a hidden node, spun by a dedicated thread, and are created on first use.
+ * The infrastructure of a context is created by the first get() and is destroyed once no node
+ * holds it anymore.
+ */
+class SharedNodeInfrastructure : public std::enable_shared_from_this<SharedNodeInfrastructure>
+{
+public:
+  using ParameterEvent = rcl_interfaces::msg::ParameterEvent;
+  using ParameterEventCallback = std::function<void (std::shared_ptr<const ParameterEvent>)>;
+
+  /// Return the infrastructure of the context, creating it if it does not exist.
+  RCLCPP_LOCAL
+  static std::shared_ptr<SharedNodeInfrastructure>
+  get(const rclcpp::Context::SharedPtr & context);
+
+  RCLCPP_LOCAL
+  explicit SharedNodeInfrastructure(const rclcpp::Context::SharedPtr & context);
+
+  RCLCPP_LOCAL
+  ~SharedNodeInfrastructure();
+
+  /// Return the fully qualified name of the node hosting the shared parameter services.
+  RCLCPP_LOCAL
+  std::string
+  get_fully_qualified_name() const;
+
+  /// Return the `/parameter_events` publisher, created by the first call with its arguments.
+  RCLCPP_LOCAL
+  rclcpp::Publisher<ParameterEvent>::SharedPtr
+  get_parameter_event_publisher(
+    const rclcpp::QoS & qos,
+    const rclcpp::PublisherOptionsBase & options);
+
+  /// Call the callback with the parameter events of a node, from the thread of the
+  /// infrastructure.
+  /**
+   * \return an identifier of the listener for remove_parameter_event_listener()
+   */
+  RCLCPP_LOCAL
+  uint64_t
+  add_parameter_event_listener(const std::string & node_name, ParameterEventCallback callback);
+
+  /// Remove a listener, whose callback may still be running when this returns.
+  RCLCPP_LOCAL
+  void
+  remove_parameter_event_listener(uint64_t listener_id);
+
+  /// Serve the parameters of a node through the shared parameter services.
+  /**
+   * The node parameters must be removed before they are destroyed.
+   * If parameters were already added for the node name, the new ones are not served.
+   */
+  RCLCPP_LOCAL
+  void
+  add_node_parameters(
+    const std::string & node_name,
+    rclcpp::node_interfaces::NodeParametersInterface * node_parameters);
+
+  /// Stop serving the parameters of a node, which are not used anymore once this returns.
+  RCLCPP_LOCAL
+  void
+  remove_node_parameters(rclcpp::node_interfaces::NodeParametersInterface * node_parameters);
+
+  /// Publish the log records of a logger through the shared `/rosout` publisher.
+  /**
+   * The publisher is created by the first call with the given QoS.
+   * Nothing is published if rosout logging is disabled.
+   */
+  RCLCPP_LOCAL
+  void
+  add_rosout_logger(const std::string & logger_name, const rclcpp::QoS & qos);
+
+  /// Stop publishing the log records of a logger, once each add_rosout_logger() call.
+  RCLCPP_LOCAL
+  void
+  remove_rosout_logger(const std::string & logger_name);
+
+  /// Publish a log record through the shared `/rosout` publisher, or queue it if aggregated.
+  RCLCPP_LOCAL
+  void
+  publish_rosout_record(rcl_interfaces::msg::Log && record);
+
+private:
+  struct ParameterEventListener
+  {
+    uint64_t id;
+    std::string node_name;
+    ParameterEventCallback callback;
+  };
+  using ParameterEventListeners = std::vector<ParameterEventListener>;
+  using NodeParametersPtr = rclcpp::node_interfaces::NodeParametersInterface *;
+  using ParameterName = std::pair<NodeParametersPtr, std::string>;
+
+  struct PendingRosoutRecord
+  {
+    /// Identifies the repetitions of the record.
+    std::string key;
+    rcl_interfaces::msg::Log record;
+    size_t count;
+  };
+
+  void
+  on_parameter_event(std::shared_ptr<const ParameterEvent> event);
+
+  /// Publish the pending log records allowed by the rate budget, or all of them if unlimited.
+  void
+  publish_pending_rosout_records(bool unlimited);
+
+  /// Create the parameter services, must be called with parameters_mutex_ locked.
+  void
+  create_parameter_services();
+
+  /// Return the node parameters and the local name of a parameter, or null if no node has it.
+  /** Must be called with parameters_mutex_ locked. */
+  ParameterName
+  find_parameter(const std::string & name) const;
+
+  /// Return the names of the parameters of a node, in the naming of the shared services.
+  /** Must be called with parameters_mutex_ locked. */
+  void
+  list_node_parameters(
+    const std::string & node_name,
+    NodeParametersPtr node_parameters,
+    const std::vector<std::string> & prefixes,
+    uint64_t depth,
+    rcl_interfaces::msg::ListParametersResult & result) const;
+
+  rclcpp::Node::SharedPtr node_;
+  rclcpp::executors::SingleThreadedExecutor::SharedPtr executor_;
+  std::promise<void> cancel_executor_promise_;
+  std::thread executor_thread_;
+
+  std::mutex publishers_mutex_;
+  rclcpp::Publisher<ParameterEvent>::SharedPtr parameter_event_publisher_;
+  rclcpp::Publisher<rcl_interfaces::msg::Log>::SharedPtr rosout_publisher_;
+
+  const rclcpp::RosoutAggregationOptions rosout_aggregation_;
+  rclcpp::TimerBase::SharedPtr rosout_timer_;
+  std::mutex pending_rosout_records_mutex_;
+  std::vector<PendingRosoutRecord> pending_rosout_records_;
+  // Index of the pending records, by key.
+  std::unordered_map<std::string, size_t> pending_rosout_record_indices_;
+  size_t dropped_rosout_records_{0u};
+  // Number of records which can be published, refilled at max_records_per_second.
+  double rosout_budget_{0.0};
+  std::chrono::steady_clock::time_point rosout_budget_time_;
+
+  std::mutex parameter_event_listeners_mutex_;
+  // Replaced on each change, so that the event callback does not hold the mutex while calling.
+  std::shared_ptr<const ParameterEventListeners> parameter_event_listeners_;
+  uint64_t next_parameter_event_listener_id_{0u};
+  rclcpp::Subscription<ParameterEvent>::SharedPtr parameter_event_subscription_;
+
+  // Held while the services use the node parameters, so that they are not removed meanwhile.
+  // Recursive, since a parameter callback may create or destroy a node.
+  mutable std::recursive_mutex parameters_mutex_;
+  std::map<std::string, NodeParametersPtr> node_parameters_;
+  rclcpp::Service<rcl_interfaces::srv::GetParameters>::SharedPtr get_parameters_service_;
+  rclcpp::Service<rcl_interfaces::srv::GetParameterTypes>::SharedPtr
+    get_parameter_types_service_;
+  rclcpp::Service<rcl_interfaces::srv::SetParameters>::SharedPtr set_parameters_service_;
+  rclcpp::Service<rcl_interfaces::srv::SetParametersAtomically>::SharedPtr
+    set_parameters_atomically_service_;
+  rclcpp::Service<rcl_interfaces::srv::DescribeParameters>::SharedPtr
+    describe_parameters_service_;
+  rclcpp::Service<rcl_interfaces::srv::ListParameters>::SharedPtr list_parameters_service_;
+};
+
+/// \internal Publish a log record through the shared `/rosout` publisher, if its logger uses it.
+/**
+ * Called by the logging output handler of rclcpp, after the output handler of rcl.
+ */
+RCLCPP_LOCAL
+void
+publish_to_shared_rosout(
+  const rcutils_log_location_t * location,
+  int severity, const char * name, rcutils_time_point_value_t timestamp,
+  const char * format, va_list * args);
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__SHARED_NODE_INFRASTRUCTURE_HPP_
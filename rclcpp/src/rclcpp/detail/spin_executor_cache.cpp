@@ -0,0 +1,175 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./spin_executor_cache.hpp"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/context.hpp"
+#include "rclcpp/executor_options.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+namespace
+{
+
+using SpinExecutor = rclcpp::executors::SingleThreadedExecutor;
+using rclcpp::node_interfaces::NodeBaseInterface;
+
+struct CachedSpinExecutor
+{
+  NodeBaseInterface::WeakPtr node;
+  const rclcpp::Context * context;
+  std::shared_ptr<SpinExecutor> executor;
+};
+
+struct SpinExecutorCache
+{
+  ~SpinExecutorCache()
+  {
+    // The executors are destroyed in the body of the destructor, since destroying the last
+    // reference to a context shuts it down, which calls back into the cache.
+    std::unordered_map<const NodeBaseInterface *, CachedSpinExecutor> destroyed_executors;
+    std::lock_guard<std::mutex> lock(mutex);
+    destroyed_executors.swap(executors);
+  }
+
+  std::mutex mutex;
+  std::unordered_map<const NodeBaseInterface *, CachedSpinExecutor> executors;
+};
+
+SpinExecutorCache &
+get_spin_executor_cache()
+{
+  static SpinExecutorCache cache;
+  return cache;
+}
+
+// Sub context of the rclcpp::Context, dropping the cached executors of its nodes before it
+// shuts down, since they hold the context.
+class SpinExecutorShutdownHook
+{
+public:
+  explicit SpinExecutorShutdownHook(rclcpp::Context * context)
+  : context_(context)
+  {
+    callback_handle_ = context_->add_pre_shutdown_callback(
+      [this]() {
+        std::vector<std::shared_ptr<SpinExecutor>> dropped_executors;
+        auto & cache = get_spin_executor_cache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        shutting_down = true;
+        for (auto it = cache.executors.begin(); it != cache.executors.end(); ) {
+          if (it->second.context == context_) {
+            dropped_executors.push_back(std::move(it->second.executor));
+            it = cache.executors.erase(it);
+          } else {
+            ++it;
+          }
+        }
+      });
+  }
+
+  ~SpinExecutorShutdownHook()
+  {
+    context_->remove_pre_shutdown_callback(callback_handle_);
+  }
+
+  // Guarded by the mutex of the cache.
+  bool shutting_down{false};
+
+private:
+  rclcpp::Context * context_;
+  rclcpp::PreShutdownCallbackHandle callback_handle_;
+};
+
+}  // namespace
+
+std::shared_ptr<SpinExecutor>
+get_spin_executor(const NodeBaseInterface::SharedPtr & node)
+{
+  auto & cache = get_spin_executor_cache();
+  std::shared_ptr<SpinExecutor> stale_executor;
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.executors.find(node.get());
+    if (it != cache.executors.end()) {
+      if (it->second.node.lock() == node) {
+        return it->second.executor;
+      }
+      // A destroyed node had the same address.
+      stale_executor = std::move(it->second.executor);
+      cache.executors.erase(it);
+    }
+  }
+
+  auto context = node->get_context();
+  if (!context->is_valid()) {
+    return nullptr;
+  }
+  auto shutdown_hook = context->get_sub_context<SpinExecutorShutdownHook>(context.get());
+
+  rclcpp::ExecutorOptions options;
+  options.context = context;
+  auto executor = std::make_shared<SpinExecutor>(options);
+  executor->add_node(node, false);
+
+  std::vector<std::shared_ptr<SpinExecutor>> expired_executors;
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  if (shutdown_hook->shutting_down) {
+    // Not cached, the node is removed once the caller is done with the executor.
+    return executor;
+  }
+  for (auto it = cache.executors.begin(); it != cache.executors.end(); ) {
+    if (it->second.node.expired()) {
+      expired_executors.push_back(std::move(it->second.executor));
+      it = cache.executors.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  cache.executors.emplace(node.get(), CachedSpinExecutor{node, context.get(), executor});
+  return executor;
+}
+
+bool
+release_spin_executor(const NodeBaseInterface * node)
+{
+  std::shared_ptr<SpinExecutor> executor;
+  {
+    auto & cache = get_spin_executor_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.executors.find(node);
+    // The executor is held by the caller of rclcpp::spin() or rclcpp::spin_some() while it
+    // spins, the node is then left to it.
+    if (it == cache.executors.end() || it->second.executor.use_count() > 1) {
+      return false;
+    }
+    executor = std::move(it->second.executor);
+    cache.executors.erase(it);
+  }
+  // The destructor of the executor disassociates the node and its callback groups.
+  executor.reset();
+  return true;
+}
+
+}  // namespace detail
+}  // namespace rclcpp
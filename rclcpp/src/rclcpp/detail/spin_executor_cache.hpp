@@ -0,0 +1,56 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__SPIN_EXECUTOR_CACHE_HPP_
+#define RCLCPP__DETAIL__SPIN_EXECUTOR_CACHE_HPP_
+
+#include <memory>
+
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rclcpp/node_interfaces/node_base_interface.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// \internal Return the executor used by rclcpp::spin() and rclcpp::spin_some() for a node.
+/**
+ * The executor is created with the node added on the first call for the node, and is kept
+ * until the node is destroyed, the node is added to another executor, or its context shuts
+ * down, so that spinning the node in a loop does not create a wait set and add the node each
+ * time.
+ *
+ * \return the executor of the node, or nullptr if the context of the node is not valid.
+ * \throws std::runtime_error if the node has already been added to another executor.
+ */
+RCLCPP_LOCAL
+std::shared_ptr<rclcpp::executors::SingleThreadedExecutor>
+get_spin_executor(const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr & node);
+
+/// \internal Destroy the executor of rclcpp::spin_some() holding a node, if it is not spinning.
+/**
+ * Called when the node, or one of its callback groups, is added to another executor.
+ *
+ * \return true if the node was held by such an executor, and is now free.
+ */
+RCLCPP_LOCAL
+bool
+release_spin_executor(const rclcpp::node_interfaces::NodeBaseInterface * node);
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__SPIN_EXECUTOR_CACHE_HPP_
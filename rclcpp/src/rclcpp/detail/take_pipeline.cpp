@@ -0,0 +1,243 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./take_pipeline.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "rcpputils/scope_exit.hpp"
+
+#include "rclcpp/exceptions.hpp"
+#include "rclcpp/logging.hpp"
+#include "rclcpp/message_info.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+namespace
+{
+
+struct TakenMessage
+{
+  std::shared_ptr<void> message;
+  rclcpp::MessageInfo message_info;
+};
+
+/// Take and deserialize a message, return false if there was none.
+bool
+take(rclcpp::SubscriptionBase & subscription, TakenMessage & taken)
+{
+  taken.message = subscription.create_message();
+  taken.message_info.get_rmw_message_info().from_intra_process = false;
+  try {
+    if (subscription.take_type_erased(taken.message.get(), taken.message_info)) {
+      return true;
+    }
+  } catch (const rclcpp::exceptions::RCLError & rcl_error) {
+    RCLCPP_ERROR(
+      rclcpp::get_logger("rclcpp"),
+      "executor taking a message from topic '%s' unexpectedly failed: %s",
+      subscription.get_topic_name(), rcl_error.what());
+  }
+  subscription.return_message(taken.message);
+  taken.message.reset();
+  return false;
+}
+
+}  // namespace
+
+/// Messages of one execution of a subscription, taken ahead of the callback.
+class TakePipeline::Batch
+{
+public:
+  Batch(rclcpp::SubscriptionBase::SharedPtr subscription, size_t count)
+  : subscription_(std::move(subscription)),
+    remaining_(count)
+  {}
+
+  ~Batch()
+  {
+    for (TakenMessage & taken : messages_) {
+      subscription_->return_message(taken.message);
+    }
+  }
+
+  /// Take the messages on a pipeline thread, unless the executor thread took over.
+  void
+  run()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (State::Queued != state_) {
+        return;
+      }
+      state_ = State::Running;
+    }
+    bool running = true;
+    while (running) {
+      TakenMessage taken;
+      const bool is_taken = take(*subscription_, taken);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (is_taken) {
+          messages_.push_back(std::move(taken));
+          --remaining_;
+        } else {
+          remaining_ = 0;
+        }
+        if (0 == remaining_ || cancelled_) {
+          state_ = State::Done;
+          running = false;
+        }
+      }
+      condition_.notify_all();
+    }
+  }
+
+  /// Get the next message, in order, return false if there is none left.
+  bool
+  next(TakenMessage & taken)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (State::Queued == state_) {
+      // The pipeline threads are busy with other subscriptions, so the executor thread takes
+      // the messages itself rather than waiting.
+      state_ = State::Done;
+      taken_by_executor_ = true;
+    }
+    if (taken_by_executor_) {
+      if (0 == remaining_) {
+        return false;
+      }
+      --remaining_;
+      lock.unlock();
+      return take(*subscription_, taken);
+    }
+    condition_.wait(lock, [this]() {return !messages_.empty() || State::Done == state_;});
+    if (messages_.empty()) {
+      return false;
+    }
+    taken = std::move(messages_.front());
+    messages_.pop_front();
+    return true;
+  }
+
+  /// Stop taking messages, and wait for the message being taken, if any.
+  /**
+   * Called when the execution ends, so that the next execution of the subscription does not
+   * take messages concurrently, e.g. after the callback threw.
+   */
+  void
+  cancel()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cancelled_ = true;
+    if (State::Queued == state_) {
+      state_ = State::Done;
+    }
+    condition_.wait(lock, [this]() {return State::Running != state_;});
+  }
+
+private:
+  enum class State
+  {
+    Queued,
+    Running,
+    Done,
+  };
+
+  const rclcpp::SubscriptionBase::SharedPtr subscription_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  State state_{State::Queued};
+  size_t remaining_;
+  bool taken_by_executor_{false};
+  bool cancelled_{false};
+  std::deque<TakenMessage> messages_;
+};
+
+TakePipeline::TakePipeline(size_t thread_count)
+{
+  for (size_t i = 0; i < thread_count; ++i) {
+    threads_.emplace_back([this]() {run();});
+  }
+}
+
+TakePipeline::~TakePipeline()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  condition_.notify_all();
+  for (std::thread & thread : threads_) {
+    thread.join();
+  }
+}
+
+bool
+TakePipeline::supports(const rclcpp::SubscriptionBase & subscription)
+{
+  return !subscription.is_serialized() && !subscription.get_take_latest_only() &&
+         subscription.get_min_message_period().count() == 0 &&
+         subscription.get_max_messages_per_take() > 1 && !subscription.can_loan_messages();
+}
+
+void
+TakePipeline::execute_subscription(const rclcpp::SubscriptionBase::SharedPtr & subscription)
+{
+  TakenMessage taken;
+  if (!take(*subscription, taken)) {
+    return;
+  }
+  // The next messages are taken by a pipeline thread once the first one is taken, so that a
+  // single thread takes the messages at a time.
+  auto batch = std::make_shared<Batch>(
+    subscription, subscription->get_max_messages_per_take() - 1);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.emplace_back([batch]() {batch->run();});
+  }
+  condition_.notify_one();
+  RCPPUTILS_SCOPE_EXIT(batch->cancel(); );
+  do {
+    subscription->record_message_taken();
+    subscription->handle_message(taken.message, taken.message_info);
+    subscription->return_message(taken.message);
+  } while (batch->next(taken));
+}
+
+void
+TakePipeline::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [this]() {return stopping_ || !tasks_.empty();});
+    if (tasks_.empty()) {
+      return;
+    }
+    std::function<void()> task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    task();
+    lock.lock();
+  }
+}
+
+}  // namespace detail
+}  // namespace rclcpp
@@ -0,0 +1,92 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP__DETAIL__TAKE_PIPELINE_HPP_
+#define RCLCPP__DETAIL__TAKE_PIPELINE_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/subscription_base.hpp"
+#include "rclcpp/visibility_control.hpp"
+
+namespace rclcpp
+{
+namespace detail
+{
+
+/// \internal Threads taking and deserializing the messages of subscriptions ahead of callbacks.
+/**
+ * When an executor executes a subscription, it takes the first message, then a pipeline thread
+ * takes and deserializes the next ones, up to the maximum number of messages per take of the
+ * subscription, while the callback runs on the executor thread.
+ * The executor thread then calls the callback with each message in order, as soon as it is
+ * deserialized.
+ *
+ * The messages of a subscription are taken by a single thread at a time, and the callbacks are
+ * only called by the executor thread, so the order of the messages and the exclusion of the
+ * callback groups are kept.
+ * If all the pipeline threads are busy when the callback returns, the executor thread takes the
+ * next messages itself.
+ */
+class TakePipeline
+{
+public:
+  /// Start the threads.
+  /**
+   * \param[in] thread_count number of pipeline threads, must be greater than 0
+   */
+  RCLCPP_LOCAL
+  explicit TakePipeline(size_t thread_count);
+
+  /// Stop the threads, once they are done with the messages being taken.
+  RCLCPP_LOCAL
+  ~TakePipeline();
+
+  /// Return true if the messages of the subscription can be taken by the pipeline.
+  /**
+   * The pipeline only takes ROS messages, which are not loaned, neither rate limited nor only
+   * the latest, and only if more than one message is taken per execution.
+   */
+  RCLCPP_LOCAL
+  static bool
+  supports(const rclcpp::SubscriptionBase & subscription);
+
+  /// Take the messages of the subscription and call its callback with each of them.
+  RCLCPP_LOCAL
+  void
+  execute_subscription(const rclcpp::SubscriptionBase::SharedPtr & subscription);
+
+private:
+  class Batch;
+
+  void
+  run();
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_{false};
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace detail
+}  // namespace rclcpp
+
+#endif  // RCLCPP__DETAIL__TAKE_PIPELINE_HPP_
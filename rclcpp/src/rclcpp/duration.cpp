@@ -15,6 +15,8 @@
 #include <cmath>
 #include <cstdlib>
 #include <limits>
+#include <stdexcept>
+#include <string>
 #include <utility>
 
 #include "rclcpp/clock.hpp"
@@ -102,99 +104,6 @@ Duration::operator=(const builtin_interfaces::msg::Duration & duration_msg)
   return *this;
 }
 
-bool
-Duration::operator==(const rclcpp::Duration & rhs) const
-{
-  return rcl_duration_.nanoseconds == rhs.rcl_duration_.nanoseconds;
-}
-
-bool
-Duration::operator!=(const rclcpp::Duration & rhs) const
-{
-  return rcl_duration_.nanoseconds != rhs.rcl_duration_.nanoseconds;
-}
-
-bool
-Duration::operator<(const rclcpp::Duration & rhs) const
-{
-  return rcl_duration_.nanoseconds < rhs.rcl_duration_.nanoseconds;
-}
-
-bool
-Duration::operator<=(const rclcpp::Duration & rhs) const
-{
-  return rcl_duration_.nanoseconds <= rhs.rcl_duration_.nanoseconds;
-}
-
-bool
-Duration::operator>=(const rclcpp::Duration & rhs) const
-{
-  return rcl_duration_.nanoseconds >= rhs.rcl_duration_.nanoseconds;
-}
-
-bool
-Duration::operator>(const rclcpp::Duration & rhs) const
-{
-  return rcl_duration_.nanoseconds > rhs.rcl_duration_.nanoseconds;
-}
-
-void
-bounds_check_duration_sum(int64_t lhsns, int64_t rhsns, uint64_t max)
-{
-  auto abs_lhs = static_cast<uint64_t>(std::abs(lhsns));
-  auto abs_rhs = static_cast<uint64_t>(std::abs(rhsns));
-
-  if (lhsns > 0 && rhsns > 0) {
-    if (abs_lhs + abs_rhs > max) {
-      throw std::overflow_error("addition leads to int64_t overflow");
-    }
-  } else if (lhsns < 0 && rhsns < 0) {
-    if (abs_lhs + abs_rhs > max) {
-      throw std::underflow_error("addition leads to int64_t underflow");
-    }
-  }
-}
-
-Duration
-Duration::operator+(const rclcpp::Duration & rhs) const
-{
-  bounds_check_duration_sum(
-    this->rcl_duration_.nanoseconds,
-    rhs.rcl_duration_.nanoseconds,
-    std::numeric_limits<rcl_duration_value_t>::max());
-  return Duration::from_nanoseconds(
-    rcl_duration_.nanoseconds + rhs.rcl_duration_.nanoseconds);
-}
-
-void
-bounds_check_duration_difference(int64_t lhsns, int64_t rhsns, uint64_t max)
-{
-  auto abs_lhs = static_cast<uint64_t>(std::abs(lhsns));
-  auto abs_rhs = static_cast<uint64_t>(std::abs(rhsns));
-
-  if (lhsns > 0 && rhsns < 0) {
-    if (abs_lhs + abs_rhs > max) {
-      throw std::overflow_error("duration subtraction leads to int64_t overflow");
-    }
-  } else if (lhsns < 0 && rhsns > 0) {
-    if (abs_lhs + abs_rhs > max) {
-      throw std::underflow_error("duration subtraction leads to int64_t underflow");
-    }
-  }
-}
-
-Duration
-Duration::operator-(const rclcpp::Duration & rhs) const
-{
-  bounds_check_duration_difference(
-    this->rcl_duration_.nanoseconds,
-    rhs.rcl_duration_.nanoseconds,
-    std::numeric_limits<rcl_duration_value_t>::max());
-
-  return Duration::from_nanoseconds(
-    rcl_duration_.nanoseconds - rhs.rcl_duration_.nanoseconds);
-}
-
 void
 bounds_check_duration_scale(int64_t dns, double scale, uint64_t max)
 {
@@ -227,12 +136,6 @@ Duration::operator*(double scale) const
       static_cast<long double>(rcl_duration_.nanoseconds) * scale_ld));
 }
 
-rcl_duration_value_t
-Duration::nanoseconds() const
-{
-  return rcl_duration_.nanoseconds;
-}
-
 Duration
 Duration::max()
 {
@@ -292,12 +195,17 @@ Duration::from_seconds(double seconds)
   return ret;
 }
 
-Duration
-Duration::from_nanoseconds(rcl_duration_value_t nanoseconds)
+namespace detail
 {
-  Duration ret;
-  ret.rcl_duration_.nanoseconds = nanoseconds;
-  return ret;
+
+void
+throw_nanoseconds_arithmetic_error(NanosecondsArithmeticStatus status, const char * operation)
+{
+  if (NanosecondsArithmeticStatus::Overflow == status) {
+    throw std::overflow_error(std::string(operation) + " leads to int64_t overflow");
+  }
+  throw std::underflow_error(std::string(operation) + " leads to int64_t underflow");
 }
 
+}  // namespace detail
 }  // namespace rclcpp
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <utility>
+#include <vector>
 
 #include "rclcpp/experimental/executable_list.hpp"
 
@@ -33,15 +34,23 @@ void
 ExecutableList::clear()
 {
   this->timer.clear();
+  this->timer_handle.clear();
+  this->timer_ready.clear();
   this->number_of_timers = 0;
 
   this->subscription.clear();
+  this->subscription_handle.clear();
+  this->subscription_ready.clear();
   this->number_of_subscriptions = 0;
 
   this->service.clear();
+  this->service_handle.clear();
+  this->service_ready.clear();
   this->number_of_services = 0;
 
   this->client.clear();
+  this->client_handle.clear();
+  this->client_ready.clear();
   this->number_of_clients = 0;
 
   this->waitable.clear();
@@ -51,6 +60,7 @@ ExecutableList::clear()
 void
 ExecutableList::add_subscription(rclcpp::SubscriptionBase::SharedPtr subscription)
 {
+  this->subscription_handle.push_back(subscription->get_subscription_handle().get());
   this->subscription.push_back(std::move(subscription));
   this->number_of_subscriptions++;
 }
@@ -58,6 +68,7 @@ ExecutableList::add_subscription(rclcpp::SubscriptionBase::SharedPtr subscriptio
 void
 ExecutableList::add_timer(rclcpp::TimerBase::SharedPtr timer)
 {
+  this->timer_handle.push_back(timer->get_timer_handle().get());
   this->timer.push_back(std::move(timer));
   this->number_of_timers++;
 }
@@ -65,6 +76,7 @@ ExecutableList::add_timer(rclcpp::TimerBase::SharedPtr timer)
 void
 ExecutableList::add_service(rclcpp::ServiceBase::SharedPtr service)
 {
+  this->service_handle.push_back(service->get_service_handle().get());
   this->service.push_back(std::move(service));
   this->number_of_services++;
 }
@@ -72,6 +84,7 @@ ExecutableList::add_service(rclcpp::ServiceBase::SharedPtr service)
 void
 ExecutableList::add_client(rclcpp::ClientBase::SharedPtr client)
 {
+  this->client_handle.push_back(client->get_client_handle().get());
   this->client.push_back(std::move(client));
   this->number_of_clients++;
 }
@@ -82,3 +95,93 @@ ExecutableList::add_waitable(rclcpp::Waitable::SharedPtr waitable)
   this->waitable.push_back(std::move(waitable));
   this->number_of_waitables++;
 }
+
+void
+ExecutableList::swap(ExecutableList & other)
+{
+  std::swap(this->subscription, other.subscription);
+  std::swap(this->subscription_handle, other.subscription_handle);
+  std::swap(this->subscription_ready, other.subscription_ready);
+  std::swap(this->number_of_subscriptions, other.number_of_subscriptions);
+  std::swap(this->timer, other.timer);
+  std::swap(this->timer_handle, other.timer_handle);
+  std::swap(this->timer_ready, other.timer_ready);
+  std::swap(this->number_of_timers, other.number_of_timers);
+  std::swap(this->service, other.service);
+  std::swap(this->service_handle, other.service_handle);
+  std::swap(this->service_ready, other.service_ready);
+  std::swap(this->number_of_services, other.number_of_services);
+  std::swap(this->client, other.client);
+  std::swap(this->client_handle, other.client_handle);
+  std::swap(this->client_ready, other.client_ready);
+  std::swap(this->number_of_clients, other.number_of_clients);
+  std::swap(this->waitable, other.waitable);
+  std::swap(this->number_of_waitables, other.number_of_waitables);
+}
+
+namespace
+{
+
+template<typename HandleT>
+bool
+fill_ready_set(
+  ExecutableList::ReadySet & ready, size_t number_of_entities,
+  HandleT * const * wait_set_handles, size_t wait_set_size)
+{
+  ready.assign((number_of_entities + 63) / 64, 0);
+  if (number_of_entities > wait_set_size) {
+    number_of_entities = wait_set_size;
+  }
+  bool any_ready = false;
+  for (size_t i = 0; i < number_of_entities; ++i) {
+    if (wait_set_handles[i]) {
+      ready[i / 64] |= uint64_t(1) << (i % 64);
+      any_ready = true;
+    }
+  }
+  return any_ready;
+}
+
+}  // namespace
+
+bool
+ExecutableList::update_ready(const rcl_wait_set_t & wait_set)
+{
+  bool any_ready = fill_ready_set(
+    this->subscription_ready, this->number_of_subscriptions,
+    wait_set.subscriptions, wait_set.size_of_subscriptions);
+  any_ready |= fill_ready_set(
+    this->timer_ready, this->number_of_timers, wait_set.timers, wait_set.size_of_timers);
+  any_ready |= fill_ready_set(
+    this->service_ready, this->number_of_services, wait_set.services, wait_set.size_of_services);
+  any_ready |= fill_ready_set(
+    this->client_ready, this->number_of_clients, wait_set.clients, wait_set.size_of_clients);
+  return any_ready;
+}
+
+size_t
+ExecutableList::next_ready(const ReadySet & ready, size_t index)
+{
+  size_t word_index = index / 64;
+  if (word_index >= ready.size()) {
+    return npos;
+  }
+  // Ignore the entities before index in the first word, then skip the empty words.
+  uint64_t word = ready[word_index] & (~uint64_t(0) << (index % 64));
+  while (0 == word) {
+    if (++word_index == ready.size()) {
+      return npos;
+    }
+    word = ready[word_index];
+  }
+  size_t bit = 0;
+#if defined(__GNUC__) || defined(__clang__)
+  bit = static_cast<size_t>(__builtin_ctzll(word));
+#else
+  while (0 == (word & 1)) {
+    word >>= 1;
+    ++bit;
+  }
+#endif
+  return word_index * 64 + bit;
+}
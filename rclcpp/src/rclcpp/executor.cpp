@@ -13,15 +13,18 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <map>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "rcl/allocator.h"
 #include "rcl/error_handling.h"
+#include "rcl/timer.h"
 #include "rcpputils/scope_exit.hpp"
 
 #include "rclcpp/exceptions.hpp"
@@ -29,12 +32,18 @@
 #include "rclcpp/guard_condition.hpp"
 #include "rclcpp/memory_strategy.hpp"
 #include "rclcpp/node.hpp"
+#include "rclcpp/real_time_memory.hpp"
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/tracing.hpp"
 #include "rclcpp/utilities.hpp"
 
 #include "rcutils/logging_macros.h"
 
 #include "tracetools/tracetools.h"
 
+#include "./detail/spin_executor_cache.hpp"
+#include "./detail/take_pipeline.hpp"
+
 using namespace std::chrono_literals;
 
 using rclcpp::exceptions::throw_from_rcl_error;
@@ -46,11 +55,22 @@ using rclcpp::FutureReturnCode;
 Executor::Executor(const rclcpp::ExecutorOptions & options)
 : spinning(false),
   shutdown_guard_condition_(std::make_shared<rclcpp::GuardCondition>(options.context)),
-  memory_strategy_(options.memory_strategy)
+  memory_strategy_(options.memory_strategy),
+  scheduling_policy_(options.scheduling_policy),
+  instrumentation_(options.instrumentation),
+  busy_poll_(options.busy_poll),
+  overload_(options.overload),
+  detects_overload_(
+    options.overload.max_ready_count > 0u || options.overload.max_dispatch_lag.count() > 0),
+  shared_node_notifications_(options.shared_node_notifications)
 {
   // Store the context for later use.
   context_ = options.context;
 
+  if (options.take_pipeline_threads > 0) {
+    take_pipeline_ = std::make_unique<rclcpp::detail::TakePipeline>(options.take_pipeline_threads);
+  }
+
   rcl_guard_condition_options_t guard_condition_options = rcl_guard_condition_get_default_options();
   rcl_ret_t ret = rcl_guard_condition_init(
     &interrupt_guard_condition_, context_->get_rcl_context().get(), guard_condition_options);
@@ -118,11 +138,19 @@ Executor::~Executor()
   weak_groups_associated_with_executor_to_nodes_.clear();
   weak_groups_to_nodes_associated_with_executor_.clear();
   weak_groups_to_nodes_.clear();
+  group_registry_.clear();
   for (const auto & pair : weak_nodes_to_guard_conditions_) {
     auto & guard_condition = pair.second;
     memory_strategy_->remove_guard_condition(guard_condition);
   }
   weak_nodes_to_guard_conditions_.clear();
+  for (const auto & pair : weak_nodes_to_notify_flags_) {
+    auto node = pair.first.lock();
+    if (node) {
+      node->set_notify_callback(nullptr);
+    }
+  }
+  weak_nodes_to_notify_flags_.clear();
 
   // Finalize the wait set.
   if (rcl_wait_set_fini(&wait_set_) != RCL_RET_OK) {
@@ -219,11 +247,14 @@ Executor::add_callback_group_to_map(
 {
   // If the callback_group already has an executor
   std::atomic_bool & has_executor = group_ptr->get_associated_with_executor_atomic();
-  if (has_executor.exchange(true)) {
+  if (
+    has_executor.exchange(true) &&
+    // The group may be held by the executor kept by rclcpp::spin_some(), which gives it up.
+    (!rclcpp::detail::release_spin_executor(node_ptr.get()) || has_executor.exchange(true)))
+  {
     throw std::runtime_error("Callback group has already been added to an executor.");
   }
-  bool is_new_node = !has_node(node_ptr, weak_groups_to_nodes_associated_with_executor_) &&
-    !has_node(node_ptr, weak_groups_associated_with_executor_to_nodes_);
+  bool is_new_node = !group_registry_.has_node(node_ptr.get());
   rclcpp::CallbackGroup::WeakPtr weak_group_ptr = group_ptr;
   auto insert_info =
     weak_groups_to_nodes.insert(std::make_pair(weak_group_ptr, node_ptr));
@@ -233,18 +264,41 @@ Executor::add_callback_group_to_map(
   }
   // Also add to the map that contains all callback groups
   weak_groups_to_nodes_.insert(std::make_pair(weak_group_ptr, node_ptr));
+  group_registry_.add(group_ptr, node_ptr);
+  entities_need_rebuild_.store(true);
   if (is_new_node) {
     rclcpp::node_interfaces::NodeBaseInterface::WeakPtr node_weak_ptr(node_ptr);
     weak_nodes_to_guard_conditions_[node_weak_ptr] = node_ptr->get_notify_guard_condition();
+    // The entities are collected with the node, whether a trigger of it is pending or not.
+    node_ptr->consume_notify_guard_condition_trigger();
     if (notify) {
       // Interrupt waiting to handle new node
-      rcl_ret_t ret = rcl_trigger_guard_condition(&interrupt_guard_condition_);
+      rcl_ret_t ret = trigger_interrupt_guard_condition();
       if (ret != RCL_RET_OK) {
         throw_from_rcl_error(ret, "Failed to trigger guard condition on callback group add");
       }
     }
-    // Add the node's notify condition to the guard condition handles
-    memory_strategy_->add_guard_condition(node_ptr->get_notify_guard_condition());
+    if (shared_node_notifications_) {
+      // The node sets its flag and interrupts the wait, instead of being waited on.
+      auto notify_flag = std::make_shared<std::atomic_bool>(false);
+      weak_nodes_to_notify_flags_[node_weak_ptr] = notify_flag;
+      node_ptr->set_notify_callback(
+        [this, notify_flag]() {
+          notify_flag->store(true);
+          node_notifications_pending_.store(true);
+          rcl_ret_t ret = trigger_interrupt_guard_condition();
+          if (RCL_RET_OK != ret) {
+            RCUTILS_LOG_ERROR_NAMED(
+              "rclcpp",
+              "failed to trigger guard condition on node notification: %s",
+              rcl_get_error_string().str);
+            rcl_reset_error();
+          }
+        });
+    } else {
+      // Add the node's notify condition to the guard condition handles
+      memory_strategy_->add_guard_condition(node_ptr->get_notify_guard_condition());
+    }
   }
 }
 
@@ -267,7 +321,11 @@ Executor::add_node(rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_pt
 {
   // If the node already has an executor
   std::atomic_bool & has_executor = node_ptr->get_associated_with_executor_atomic();
-  if (has_executor.exchange(true)) {
+  if (
+    has_executor.exchange(true) &&
+    // The node may be held by the executor kept by rclcpp::spin_some(), which gives it up.
+    (!rclcpp::detail::release_spin_executor(node_ptr.get()) || has_executor.exchange(true)))
+  {
     throw std::runtime_error(
             std::string("Node '") + node_ptr->get_fully_qualified_name() +
             "' has already been added to an executor.");
@@ -297,6 +355,7 @@ Executor::remove_callback_group_from_map(
   bool notify)
 {
   rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr;
+  bool node_removed = false;
   rclcpp::CallbackGroup::WeakPtr weak_group_ptr = group_ptr;
   auto iter = weak_groups_to_nodes.find(weak_group_ptr);
   if (iter != weak_groups_to_nodes.end()) {
@@ -306,24 +365,31 @@ Executor::remove_callback_group_from_map(
     }
     weak_groups_to_nodes.erase(iter);
     weak_groups_to_nodes_.erase(group_ptr);
+    node_removed = group_registry_.remove(group_ptr.get());
+    // Only the entities of the group are dropped, the others are not collected again.
+    if (!memory_strategy_->remove_collected_callback_group(weak_group_ptr)) {
+      entities_need_rebuild_.store(true);
+    }
     std::atomic_bool & has_executor = group_ptr->get_associated_with_executor_atomic();
     has_executor.store(false);
   } else {
     throw std::runtime_error("Callback group needs to be associated with executor.");
   }
   // If the node was matched and removed, interrupt waiting.
-  if (!has_node(node_ptr, weak_groups_to_nodes_associated_with_executor_) &&
-    !has_node(node_ptr, weak_groups_associated_with_executor_to_nodes_))
-  {
+  if (node_removed) {
     rclcpp::node_interfaces::NodeBaseInterface::WeakPtr node_weak_ptr(node_ptr);
     weak_nodes_to_guard_conditions_.erase(node_weak_ptr);
     if (notify) {
-      rcl_ret_t ret = rcl_trigger_guard_condition(&interrupt_guard_condition_);
+      rcl_ret_t ret = trigger_interrupt_guard_condition();
       if (ret != RCL_RET_OK) {
         throw_from_rcl_error(ret, "Failed to trigger guard condition on callback group remove");
       }
     }
-    memory_strategy_->remove_guard_condition(node_ptr->get_notify_guard_condition());
+    if (weak_nodes_to_notify_flags_.erase(node_weak_ptr) > 0) {
+      node_ptr->set_notify_callback(nullptr);
+    } else {
+      memory_strategy_->remove_guard_condition(node_ptr->get_notify_guard_condition());
+    }
   }
 }
 
@@ -494,12 +560,67 @@ void
 Executor::cancel()
 {
   spinning.store(false);
-  rcl_ret_t ret = rcl_trigger_guard_condition(&interrupt_guard_condition_);
+  rcl_ret_t ret = trigger_interrupt_guard_condition();
   if (ret != RCL_RET_OK) {
     throw_from_rcl_error(ret, "Failed to trigger guard condition in cancel");
   }
 }
 
+rcl_ret_t
+Executor::trigger_interrupt_guard_condition()
+{
+  if (interrupt_guard_condition_trigger_pending_.exchange(true)) {
+    // The wait has not consumed the previous trigger yet, and checks this interruption too.
+    return RCL_RET_OK;
+  }
+  rcl_ret_t ret = rcl_trigger_guard_condition(&interrupt_guard_condition_);
+  if (RCL_RET_OK != ret) {
+    interrupt_guard_condition_trigger_pending_.store(false);
+  }
+  return ret;
+}
+
+void
+Executor::consume_interrupt_guard_condition_trigger()
+{
+  interrupt_guard_condition_trigger_pending_.store(false);
+}
+
+template<typename EntityT>
+static size_t
+count_ready(EntityT * const * entities, size_t size)
+{
+  size_t ready_count = 0;
+  for (size_t i = 0; i < size; ++i) {
+    if (entities[i]) {
+      ++ready_count;
+    }
+  }
+  return ready_count;
+}
+
+void
+Executor::report_wait(std::chrono::steady_clock::time_point wait_start)
+{
+  const auto wait_end = std::chrono::steady_clock::now();
+  last_wait_end_nanoseconds_.store(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(wait_end.time_since_epoch()).count());
+  instrumentation_->on_wait(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(wait_end - wait_start));
+  const size_t wait_set_size =
+    wait_set_.size_of_subscriptions + wait_set_.size_of_guard_conditions +
+    wait_set_.size_of_timers + wait_set_.size_of_clients + wait_set_.size_of_services +
+    wait_set_.size_of_events;
+  const size_t ready_count =
+    count_ready(wait_set_.subscriptions, wait_set_.size_of_subscriptions) +
+    count_ready(wait_set_.guard_conditions, wait_set_.size_of_guard_conditions) +
+    count_ready(wait_set_.timers, wait_set_.size_of_timers) +
+    count_ready(wait_set_.clients, wait_set_.size_of_clients) +
+    count_ready(wait_set_.services, wait_set_.size_of_services) +
+    count_ready(wait_set_.events, wait_set_.size_of_events);
+  instrumentation_->on_wait_result(wait_set_size, ready_count);
+}
+
 void
 Executor::set_memory_strategy(rclcpp::memory_strategy::MemoryStrategy::SharedPtr memory_strategy)
 {
@@ -508,6 +629,201 @@ Executor::set_memory_strategy(rclcpp::memory_strategy::MemoryStrategy::SharedPtr
   }
   std::lock_guard<std::mutex> guard{mutex_};
   memory_strategy_ = memory_strategy;
+  entities_need_rebuild_.store(true);
+}
+
+size_t
+Executor::get_starvation_count() const
+{
+  return starvation_count_.load();
+}
+
+size_t
+Executor::get_overload_count() const
+{
+  return overload_count_.load();
+}
+
+rclcpp::ExecutorInstrumentation::SharedPtr
+Executor::get_instrumentation() const
+{
+  return instrumentation_;
+}
+
+void
+Executor::prepare_for_real_time()
+{
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    add_callback_groups_from_nodes_associated_to_executor();
+
+    memory_strategy_->clear_handles();
+    if (memory_strategy_->collect_entities(weak_groups_to_nodes_)) {
+      // Let the next wait prune the invalid callback groups and nodes.
+      entities_need_rebuild_.store(true);
+    }
+
+    rcl_ret_t ret = rcl_wait_set_clear(&wait_set_);
+    if (ret != RCL_RET_OK) {
+      throw_from_rcl_error(ret, "Couldn't clear wait set");
+    }
+    ret = rcl_wait_set_resize(
+      &wait_set_, memory_strategy_->number_of_ready_subscriptions(),
+      memory_strategy_->number_of_guard_conditions(), memory_strategy_->number_of_ready_timers(),
+      memory_strategy_->number_of_ready_clients(), memory_strategy_->number_of_ready_services(),
+      memory_strategy_->number_of_ready_events());
+    if (RCL_RET_OK != ret) {
+      throw_from_rcl_error(ret, "Couldn't resize the wait set");
+    }
+
+    for (const auto & pair : weak_groups_to_nodes_) {
+      auto group = pair.first.lock();
+      if (!group) {
+        continue;
+      }
+      group->find_subscription_ptrs_if(
+        [](const rclcpp::SubscriptionBase::SharedPtr & subscription) {
+          if (subscription->is_serialized()) {
+            auto serialized_message = subscription->create_serialized_message();
+            subscription->return_serialized_message(serialized_message);
+          } else {
+            auto message = subscription->create_message();
+            subscription->return_message(message);
+          }
+          return false;
+        });
+    }
+  }
+  rclcpp::prefault_stack(context_->get_init_options().real_time_memory().prefault_stack_size);
+}
+
+static std::chrono::nanoseconds
+get_execution_budget(const AnyExecutable & any_exec)
+{
+  if (any_exec.subscription) {
+    const std::chrono::nanoseconds budget = any_exec.subscription->get_execution_budget();
+    if (budget.count() > 0) {
+      return budget;
+    }
+  }
+  return any_exec.callback_group->get_execution_budget();
+}
+
+static rclcpp::ExecutableExecution
+make_execution(
+  const AnyExecutable & any_exec,
+  std::chrono::steady_clock::time_point execution_start,
+  std::chrono::steady_clock::time_point execution_end,
+  std::chrono::nanoseconds budget)
+{
+  rclcpp::ExecutableExecution execution;
+  if (any_exec.timer) {
+    execution.type = rclcpp::ExecutableType::Timer;
+    execution.entity = any_exec.timer.get();
+  } else if (any_exec.subscription) {
+    execution.type = rclcpp::ExecutableType::Subscription;
+    execution.entity = any_exec.subscription.get();
+  } else if (any_exec.service) {
+    execution.type = rclcpp::ExecutableType::Service;
+    execution.entity = any_exec.service.get();
+  } else if (any_exec.client) {
+    execution.type = rclcpp::ExecutableType::Client;
+    execution.entity = any_exec.client.get();
+  } else {
+    execution.type = rclcpp::ExecutableType::Waitable;
+    execution.entity = any_exec.waitable.get();
+  }
+  execution.callback_group = any_exec.callback_group.get();
+  execution.dispatch_latency = std::chrono::nanoseconds(0);
+  if (any_exec.ready_time != std::chrono::steady_clock::time_point() &&
+    execution_start > any_exec.ready_time)
+  {
+    execution.dispatch_latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      execution_start - any_exec.ready_time);
+  }
+  execution.duration =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(execution_end - execution_start);
+  execution.budget = budget;
+  return execution;
+}
+
+static void
+trace_dispatch(const void * entity, rclcpp::ExecutableType type)
+{
+  rclcpp::tracing::trace(rclcpp::tracing::TraceEventType::ExecutorDispatch, entity, 0, type);
+}
+
+static void
+handle_latest_message(
+  const rclcpp::SubscriptionBase::SharedPtr & subscription,
+  rclcpp::MessageInfo & message_info);
+
+static void
+drop_queued_messages(
+  const rclcpp::SubscriptionBase::SharedPtr & subscription,
+  rclcpp::MessageInfo & message_info);
+
+void
+Executor::release_callback_group(AnyExecutable & any_exec)
+{
+  // Reset the callback_group, regardless of type
+  any_exec.callback_group->can_be_taken_from().store(true);
+  // Wake a wait of another thread, because its wait set may be missing the work that was
+  // blocked by the callback group until now.
+  // A wait which starts after the reset collects that work anyway, so a single threaded spin,
+  // e.g. spin_until_future_complete(), is not woken up needlessly by the next wait.
+  if (threads_waiting_for_work_.load() > 0) {
+    rcl_ret_t ret = trigger_interrupt_guard_condition();
+    if (ret != RCL_RET_OK) {
+      throw_from_rcl_error(ret, "Failed to trigger guard condition from execute_any_executable");
+    }
+  }
+}
+
+bool
+Executor::apply_overload_policy(AnyExecutable & any_exec, bool & skip_stale_messages)
+{
+  rclcpp::OverloadEvent event;
+  event.ready_count = last_wait_ready_count_.load();
+  const size_t dispatch_index = dispatched_since_wait_.fetch_add(1u);
+  if (
+    overload_.max_dispatch_lag.count() > 0 &&
+    any_exec.ready_time != std::chrono::steady_clock::time_point())
+  {
+    event.dispatch_lag = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - any_exec.ready_time);
+  }
+  const bool overloaded =
+    (overload_.max_ready_count > 0u && dispatch_index >= overload_.max_ready_count) ||
+    (overload_.max_dispatch_lag.count() > 0 && event.dispatch_lag > overload_.max_dispatch_lag);
+  if (!overloaded) {
+    return false;
+  }
+  ++overload_count_;
+  event.policy = any_exec.callback_group->get_overload_policy();
+  switch (event.policy) {
+    case rclcpp::CallbackGroupOverloadPolicy::Shed:
+      // The other entities, e.g. services, are still expected to respond.
+      event.shed = any_exec.subscription || any_exec.timer;
+      break;
+    case rclcpp::CallbackGroupOverloadPolicy::SkipStale:
+      skip_stale_messages = any_exec.subscription != nullptr;
+      break;
+    case rclcpp::CallbackGroupOverloadPolicy::Execute:
+      break;
+  }
+  any_exec.callback_group->report_overload(event);
+  if (!event.shed) {
+    return false;
+  }
+  if (any_exec.subscription) {
+    rclcpp::MessageInfo message_info;
+    message_info.get_rmw_message_info().from_intra_process = false;
+    drop_queued_messages(any_exec.subscription, message_info);
+  } else {
+    any_exec.timer->skip_callback();
+  }
+  return true;
 }
 
 void
@@ -516,44 +832,83 @@ Executor::execute_any_executable(AnyExecutable & any_exec)
   if (!spinning.load()) {
     return;
   }
+  bool skip_stale_messages = false;
+  if (detects_overload_ && apply_overload_policy(any_exec, skip_stale_messages)) {
+    release_callback_group(any_exec);
+    return;
+  }
+  // Nothing is measured, not even the time, unless the executor is instrumented or the entity
+  // has an execution budget.
+  rclcpp::ExecutorInstrumentation * instrumentation = instrumentation_.get();
+  const std::chrono::nanoseconds execution_budget = get_execution_budget(any_exec);
+  const bool measured = instrumentation || execution_budget.count() > 0;
+  std::chrono::steady_clock::time_point execution_start;
+  if (measured) {
+    execution_start = std::chrono::steady_clock::now();
+  }
   if (any_exec.timer) {
     TRACEPOINT(
       rclcpp_executor_execute,
       static_cast<const void *>(any_exec.timer->get_timer_handle().get()));
+    trace_dispatch(any_exec.timer.get(), rclcpp::ExecutableType::Timer);
     execute_timer(any_exec.timer);
   }
   if (any_exec.subscription) {
     TRACEPOINT(
       rclcpp_executor_execute,
       static_cast<const void *>(any_exec.subscription->get_subscription_handle().get()));
-    execute_subscription(any_exec.subscription);
+    trace_dispatch(any_exec.subscription.get(), rclcpp::ExecutableType::Subscription);
+    if (skip_stale_messages) {
+      rclcpp::MessageInfo message_info;
+      message_info.get_rmw_message_info().from_intra_process = false;
+      handle_latest_message(any_exec.subscription, message_info);
+    } else if (
+      take_pipeline_ && rclcpp::detail::TakePipeline::supports(*any_exec.subscription))
+    {
+      take_pipeline_->execute_subscription(any_exec.subscription);
+    } else {
+      execute_subscription(any_exec.subscription);
+    }
   }
   if (any_exec.service) {
+    trace_dispatch(any_exec.service.get(), rclcpp::ExecutableType::Service);
     execute_service(any_exec.service);
   }
   if (any_exec.client) {
+    trace_dispatch(any_exec.client.get(), rclcpp::ExecutableType::Client);
     execute_client(any_exec.client);
   }
   if (any_exec.waitable) {
+    trace_dispatch(any_exec.waitable.get(), rclcpp::ExecutableType::Waitable);
     any_exec.waitable->execute(any_exec.data);
   }
-  // Reset the callback_group, regardless of type
-  any_exec.callback_group->can_be_taken_from().store(true);
-  // Wake the wait, because it may need to be recalculated or work that
-  // was previously blocked is now available.
-  rcl_ret_t ret = rcl_trigger_guard_condition(&interrupt_guard_condition_);
-  if (ret != RCL_RET_OK) {
-    throw_from_rcl_error(ret, "Failed to trigger guard condition from execute_any_executable");
+  std::chrono::steady_clock::time_point execution_end;
+  if (measured) {
+    execution_end = std::chrono::steady_clock::now();
+  }
+  release_callback_group(any_exec);
+  if (measured) {
+    const rclcpp::ExecutableExecution execution =
+      make_execution(any_exec, execution_start, execution_end, execution_budget);
+    if (execution_budget.count() > 0 && execution.duration > execution_budget) {
+      any_exec.callback_group->report_execution_overrun(execution);
+    }
+    if (instrumentation) {
+      instrumentation->on_execute(execution);
+    }
   }
 }
 
+// The actions are template parameters rather than std::function, so that executing an entity
+// does not allocate for the type erasure of their captures.
+template<typename TakeActionT, typename HandleActionT>
 static
-void
+bool
 take_and_do_error_handling(
   const char * action_description,
   const char * topic_or_service_name,
-  std::function<bool()> take_action,
-  std::function<void()> handle_action)
+  TakeActionT && take_action,
+  HandleActionT && handle_action)
 {
   bool taken = false;
   try {
@@ -581,85 +936,244 @@ take_and_do_error_handling(
       action_description,
       topic_or_service_name);
   }
+  return taken;
+}
+
+// Take and drop the queued messages, as loaned messages if possible, so that they are neither
+// copied nor deserialized.
+static void
+drop_queued_messages(
+  const rclcpp::SubscriptionBase::SharedPtr & subscription,
+  rclcpp::MessageInfo & message_info)
+{
+  if (subscription->can_loan_messages()) {
+    take_and_do_error_handling(
+      "dropping loaned messages from topic",
+      subscription->get_topic_name(),
+      [&]()
+      {
+        bool taken = false;
+        while (true) {
+          void * loaned_msg = nullptr;
+          rcl_ret_t ret = rcl_take_loaned_message(
+            subscription->get_subscription_handle().get(),
+            &loaned_msg,
+            &message_info.get_rmw_message_info(),
+            nullptr);
+          if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+            return taken;
+          } else if (RCL_RET_OK != ret) {
+            rclcpp::exceptions::throw_from_rcl_error(ret);
+          }
+          taken = true;
+          ret = rcl_return_loaned_message_from_subscription(
+            subscription->get_subscription_handle().get(), loaned_msg);
+          if (RCL_RET_OK != ret) {
+            rclcpp::exceptions::throw_from_rcl_error(ret);
+          }
+        }
+      },
+      []() {});
+  } else {
+    std::shared_ptr<rclcpp::SerializedMessage> serialized_msg =
+      subscription->create_serialized_message();
+    take_and_do_error_handling(
+      "dropping serialized messages from topic",
+      subscription->get_topic_name(),
+      [&]()
+      {
+        bool taken = false;
+        while (subscription->take_serialized(*serialized_msg, message_info)) {
+          taken = true;
+        }
+        return taken;
+      },
+      []() {});
+    subscription->return_serialized_message(serialized_msg);
+  }
+}
+
+// All the queued messages are taken serialized, which is a copy of their buffer, and only the
+// last one is handled, so the stale messages are never deserialized.
+static void
+handle_latest_message(
+  const rclcpp::SubscriptionBase::SharedPtr & subscription,
+  rclcpp::MessageInfo & message_info)
+{
+  // The messages arriving while the queue is drained are newer, so they are taken as well.
+  std::shared_ptr<rclcpp::SerializedMessage> serialized_msg =
+    subscription->create_serialized_message();
+  std::shared_ptr<rclcpp::SerializedMessage> next_serialized_msg =
+    subscription->create_serialized_message();
+  rclcpp::MessageInfo next_message_info = message_info;
+  take_and_do_error_handling(
+    "taking the latest serialized message from topic",
+    subscription->get_topic_name(),
+    [&]()
+    {
+      bool taken = false;
+      while (subscription->take_serialized(*next_serialized_msg, next_message_info)) {
+        std::swap(serialized_msg, next_serialized_msg);
+        std::swap(message_info, next_message_info);
+        taken = true;
+      }
+      return taken;
+    },
+    [&]()
+    {
+      subscription->record_message_taken();
+      if (subscription->is_serialized()) {
+        subscription->handle_serialized_message(serialized_msg, message_info);
+        return;
+      }
+      std::shared_ptr<void> message = subscription->create_message();
+      rclcpp::SerializationBase serialization(&subscription->get_message_type_support_handle());
+      serialization.deserialize_message(serialized_msg.get(), message.get());
+      subscription->handle_message(message, message_info);
+      subscription->return_message(message);
+    });
+  subscription->return_serialized_message(next_serialized_msg);
+  subscription->return_serialized_message(serialized_msg);
 }
 
 void
-Executor::execute_subscription(rclcpp::SubscriptionBase::SharedPtr subscription)
+Executor::execute_subscription(const rclcpp::SubscriptionBase::SharedPtr & subscription)
 {
   rclcpp::MessageInfo message_info;
   message_info.get_rmw_message_info().from_intra_process = false;
-
-  if (subscription->is_serialized()) {
+  if (subscription->is_message_rate_limited()) {
+    // The messages arriving before the end of the minimum message period are dropped.
+    drop_queued_messages(subscription, message_info);
+    return;
+  }
+  // Messages are taken until nothing is left, the limit of the subscription is reached or its
+  // minimum message period is not over, the message and the message info are reused for every
+  // take.
+  const size_t max_messages_per_take = subscription->get_max_messages_per_take();
+
+  if (subscription->get_take_latest_only()) {
+    handle_latest_message(subscription, message_info);
+  } else if (subscription->is_serialized()) {
     // This is the case where a copy of the serialized message is taken from
     // the middleware via inter-process communication.
     std::shared_ptr<SerializedMessage> serialized_msg = subscription->create_serialized_message();
-    take_and_do_error_handling(
-      "taking a serialized message from topic",
-      subscription->get_topic_name(),
-      [&]() {return subscription->take_serialized(*serialized_msg.get(), message_info);},
-      [&]()
-      {
-        subscription->handle_serialized_message(serialized_msg, message_info);
-      });
+    // References held by the memory strategy itself, e.g. by a pool.
+    auto owners = serialized_msg.use_count();
+    for (size_t i = 0; i < max_messages_per_take; ++i) {
+      if (i > 0 && subscription->is_message_rate_limited()) {
+        break;
+      }
+      if (serialized_msg.use_count() > owners) {
+        // The callback kept the previous message, it must not be overwritten.
+        subscription->return_serialized_message(serialized_msg);
+        serialized_msg = subscription->create_serialized_message();
+        owners = serialized_msg.use_count();
+      }
+      bool taken = take_and_do_error_handling(
+        "taking a serialized message from topic",
+        subscription->get_topic_name(),
+        [&]() {return subscription->take_serialized(*serialized_msg.get(), message_info);},
+        [&]()
+        {
+          subscription->record_message_taken();
+          subscription->handle_serialized_message(serialized_msg, message_info);
+        });
+      if (!taken) {
+        break;
+      }
+    }
     subscription->return_serialized_message(serialized_msg);
   } else if (subscription->can_loan_messages()) {
     // This is the case where a loaned message is taken from the middleware via
     // inter-process communication, given to the user for their callback,
     // and then returned.
-    void * loaned_msg = nullptr;
-    // TODO(wjwwood): refactor this into methods on subscription when LoanedMessage
-    //   is extened to support subscriptions as well.
-    take_and_do_error_handling(
-      "taking a loaned message from topic",
-      subscription->get_topic_name(),
-      [&]()
-      {
-        rcl_ret_t ret = rcl_take_loaned_message(
+    for (size_t i = 0; i < max_messages_per_take; ++i) {
+      if (i > 0 && subscription->is_message_rate_limited()) {
+        break;
+      }
+      void * loaned_msg = nullptr;
+      // TODO(wjwwood): refactor this into methods on subscription when LoanedMessage
+      //   is extened to support subscriptions as well.
+      bool taken = take_and_do_error_handling(
+        "taking a loaned message from topic",
+        subscription->get_topic_name(),
+        [&]()
+        {
+          rcl_ret_t ret = rcl_take_loaned_message(
+            subscription->get_subscription_handle().get(),
+            &loaned_msg,
+            &message_info.get_rmw_message_info(),
+            nullptr);
+          if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+            return false;
+          } else if (RCL_RET_OK != ret) {
+            rclcpp::exceptions::throw_from_rcl_error(ret);
+          }
+          return true;
+        },
+        [&]()
+        {
+          subscription->record_message_taken();
+          subscription->handle_loaned_message_taking_ownership(loaned_msg, message_info);
+        });
+      if (nullptr != loaned_msg) {
+        rcl_ret_t ret = rcl_return_loaned_message_from_subscription(
           subscription->get_subscription_handle().get(),
-          &loaned_msg,
-          &message_info.get_rmw_message_info(),
-          nullptr);
-        if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
-          return false;
-        } else if (RCL_RET_OK != ret) {
-          rclcpp::exceptions::throw_from_rcl_error(ret);
+          loaned_msg);
+        if (RCL_RET_OK != ret) {
+          RCLCPP_ERROR(
+            rclcpp::get_logger("rclcpp"),
+            "rcl_return_loaned_message_from_subscription() failed for subscription on topic "
+            "'%s': %s",
+            subscription->get_topic_name(), rcl_get_error_string().str);
         }
-        return true;
-      },
-      [&]() {subscription->handle_loaned_message(loaned_msg, message_info);});
-    if (nullptr != loaned_msg) {
-      rcl_ret_t ret = rcl_return_loaned_message_from_subscription(
-        subscription->get_subscription_handle().get(),
-        loaned_msg);
-      if (RCL_RET_OK != ret) {
-        RCLCPP_ERROR(
-          rclcpp::get_logger("rclcpp"),
-          "rcl_return_loaned_message_from_subscription() failed for subscription on topic '%s': %s",
-          subscription->get_topic_name(), rcl_get_error_string().str);
+        loaned_msg = nullptr;
+      }
+      if (!taken) {
+        break;
       }
-      loaned_msg = nullptr;
     }
   } else {
     // This case is taking a copy of the message data from the middleware via
     // inter-process communication.
     std::shared_ptr<void> message = subscription->create_message();
-    take_and_do_error_handling(
-      "taking a message from topic",
-      subscription->get_topic_name(),
-      [&]() {return subscription->take_type_erased(message.get(), message_info);},
-      [&]() {subscription->handle_message(message, message_info);});
+    // References held by the memory strategy itself, e.g. by a pool.
+    auto owners = message.use_count();
+    for (size_t i = 0; i < max_messages_per_take; ++i) {
+      if (i > 0 && subscription->is_message_rate_limited()) {
+        break;
+      }
+      if (message.use_count() > owners) {
+        // The callback kept the previous message, it must not be overwritten.
+        subscription->return_message(message);
+        message = subscription->create_message();
+        owners = message.use_count();
+      }
+      bool taken = take_and_do_error_handling(
+        "taking a message from topic",
+        subscription->get_topic_name(),
+        [&]() {return subscription->take_type_erased(message.get(), message_info);},
+        [&]()
+        {
+          subscription->record_message_taken();
+          subscription->handle_message(message, message_info);
+        });
+      if (!taken) {
+        break;
+      }
+    }
     subscription->return_message(message);
   }
 }
 
 void
-Executor::execute_timer(rclcpp::TimerBase::SharedPtr timer)
+Executor::execute_timer(const rclcpp::TimerBase::SharedPtr & timer)
 {
   timer->execute_callback();
 }
 
 void
-Executor::execute_service(rclcpp::ServiceBase::SharedPtr service)
+Executor::execute_service(const rclcpp::ServiceBase::SharedPtr & service)
 {
   auto request_header = service->create_request_header();
   std::shared_ptr<void> request = service->create_request();
@@ -672,7 +1186,7 @@ Executor::execute_service(rclcpp::ServiceBase::SharedPtr service)
 
 void
 Executor::execute_client(
-  rclcpp::ClientBase::SharedPtr client)
+  const rclcpp::ClientBase::SharedPtr & client)
 {
   auto request_header = client->create_request_header();
   std::shared_ptr<void> response = client->create_response();
@@ -683,10 +1197,52 @@ Executor::execute_client(
     [&]() {client->handle_response(request_header, response);});
 }
 
+rcl_ret_t
+Executor::busy_poll_wait(std::chrono::nanoseconds timeout, WaitStage & stage)
+{
+  const auto start = std::chrono::steady_clock::now();
+  const size_t poll_iterations = busy_poll_.spin_iterations + busy_poll_.yield_iterations;
+  for (size_t i = 0; i < poll_iterations; ++i) {
+    stage = i < busy_poll_.spin_iterations ? WaitStage::Spin : WaitStage::Yield;
+    if (WaitStage::Yield == stage) {
+      std::this_thread::yield();
+    }
+    rcl_ret_t status = rcl_wait(&wait_set_, 0);
+    if (RCL_RET_TIMEOUT != status) {
+      return status;
+    }
+    if (timeout > 0ns && std::chrono::steady_clock::now() - start >= timeout) {
+      return status;
+    }
+    // The handles which were not ready were cleared by the wait, they are all added back.
+    std::lock_guard<std::mutex> guard(mutex_);
+    status = rcl_wait_set_clear(&wait_set_);
+    if (RCL_RET_OK != status) {
+      throw_from_rcl_error(status, "Couldn't clear wait set");
+    }
+    if (!memory_strategy_->add_handles_to_wait_set(&wait_set_)) {
+      throw std::runtime_error("Couldn't fill wait set");
+    }
+  }
+
+  stage = WaitStage::Block;
+  if (timeout < 0ns) {
+    return rcl_wait(&wait_set_, -1);
+  }
+  const auto remaining = timeout - (std::chrono::steady_clock::now() - start);
+  return rcl_wait(
+    &wait_set_,
+    std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(remaining), 0ns).count());
+}
+
 void
 Executor::wait_for_work(std::chrono::nanoseconds timeout)
 {
   TRACEPOINT(rclcpp_executor_wait_for_work, timeout.count());
+  // Counted before the entities are collected, so that execute_any_executable() either sees
+  // this wait or resets its callback group before it is collected.
+  ++threads_waiting_for_work_;
+  RCPPUTILS_SCOPE_EXIT(--threads_waiting_for_work_; );
   {
     std::lock_guard<std::mutex> guard(mutex_);
 
@@ -696,16 +1252,20 @@ Executor::wait_for_work(std::chrono::nanoseconds timeout)
     // allowed to add to another executor
     add_callback_groups_from_nodes_associated_to_executor();
 
-    // Collect the subscriptions and timers to be waited on
-    memory_strategy_->clear_handles();
-    bool has_invalid_weak_groups_or_nodes =
-      memory_strategy_->collect_entities(weak_groups_to_nodes_);
+    // Collect the subscriptions and timers to be waited on, reusing the previous collection
+    // if no callback group, node or entity was added or removed since then.
+    bool has_invalid_weak_groups_or_nodes = false;
+    if (entities_need_rebuild_.exchange(false) || !memory_strategy_->restore_collected_entities()) {
+      memory_strategy_->clear_handles();
+      has_invalid_weak_groups_or_nodes =
+        memory_strategy_->collect_entities(weak_groups_to_nodes_);
+    }
 
     if (has_invalid_weak_groups_or_nodes) {
       std::vector<rclcpp::CallbackGroup::WeakPtr> invalid_group_ptrs;
-      for (auto pair : weak_groups_to_nodes_) {
-        auto weak_group_ptr = pair.first;
-        auto weak_node_ptr = pair.second;
+      for (const auto & pair : weak_groups_to_nodes_) {
+        const auto & weak_group_ptr = pair.first;
+        const auto & weak_node_ptr = pair.second;
         if (weak_group_ptr.expired() || weak_node_ptr.expired()) {
           invalid_group_ptrs.push_back(weak_group_ptr);
           auto node_guard_pair = weak_nodes_to_guard_conditions_.find(weak_node_ptr);
@@ -714,6 +1274,7 @@ Executor::wait_for_work(std::chrono::nanoseconds timeout)
             weak_nodes_to_guard_conditions_.erase(weak_node_ptr);
             memory_strategy_->remove_guard_condition(guard_condition);
           }
+          weak_nodes_to_notify_flags_.erase(weak_node_ptr);
         }
       }
       std::for_each(
@@ -731,6 +1292,7 @@ Executor::wait_for_work(std::chrono::nanoseconds timeout)
           }
           weak_groups_to_nodes_.erase(group_ptr);
         });
+      group_registry_.remove_expired();
     }
 
     // clear wait set
@@ -754,8 +1316,48 @@ Executor::wait_for_work(std::chrono::nanoseconds timeout)
     }
   }
 
-  rcl_ret_t status =
+  std::chrono::steady_clock::time_point wait_start;
+  if (instrumentation_) {
+    wait_start = std::chrono::steady_clock::now();
+  }
+  WaitStage stage = WaitStage::Block;
+  rcl_ret_t status = busy_poll_.enabled && timeout != 0ns ?
+    busy_poll_wait(timeout, stage) :
     rcl_wait(&wait_set_, std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count());
+  if (instrumentation_) {
+    report_wait(wait_start);
+    // Only the timers have a known time at which they became ready.
+    for (size_t i = 0; RCL_RET_OK == status && i < wait_set_.size_of_timers; ++i) {
+      if (!wait_set_.timers[i]) {
+        continue;
+      }
+      int64_t time_until_next_call = 0;
+      if (
+        RCL_RET_OK != rcl_timer_get_time_until_next_call(
+          wait_set_.timers[i], &time_until_next_call))
+      {
+        // e.g. the timer was canceled in the meantime.
+        rcl_reset_error();
+      } else if (time_until_next_call <= 0) {
+        instrumentation_->on_wake_up(stage, std::chrono::nanoseconds(-time_until_next_call));
+      }
+    }
+  }
+  if (detects_overload_) {
+    if (!instrumentation_) {
+      last_wait_end_nanoseconds_.store(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+    // The guard conditions are not work to be dispatched.
+    last_wait_ready_count_.store(
+      count_ready(wait_set_.subscriptions, wait_set_.size_of_subscriptions) +
+      count_ready(wait_set_.timers, wait_set_.size_of_timers) +
+      count_ready(wait_set_.clients, wait_set_.size_of_clients) +
+      count_ready(wait_set_.services, wait_set_.size_of_services) +
+      count_ready(wait_set_.events, wait_set_.size_of_events));
+    dispatched_since_wait_.store(0u);
+  }
   if (status == RCL_RET_WAIT_SET_EMPTY) {
     RCUTILS_LOG_WARN_NAMED(
       "rclcpp",
@@ -768,6 +1370,41 @@ Executor::wait_for_work(std::chrono::nanoseconds timeout)
   // check the null handles in the wait set and remove them from the handles in memory strategy
   // for callback-based entities
   std::lock_guard<std::mutex> guard(mutex_);
+  // A triggered node guard condition means that the node's entities have changed.
+  for (size_t i = 0; i < wait_set_.size_of_guard_conditions; ++i) {
+    const rcl_guard_condition_t * guard_condition = wait_set_.guard_conditions[i];
+    if (!guard_condition) {
+      continue;
+    }
+    if (guard_condition == &interrupt_guard_condition_) {
+      consume_interrupt_guard_condition_trigger();
+      continue;
+    }
+    for (const auto & pair : weak_nodes_to_guard_conditions_) {
+      if (pair.second == guard_condition) {
+        // Consumed before the entities are collected again, so that no change is missed.
+        auto node = pair.first.lock();
+        if (node) {
+          node->consume_notify_guard_condition_trigger();
+        }
+        entities_need_rebuild_.store(true);
+        break;
+      }
+    }
+  }
+  // Checked after the interrupt guard condition trigger was consumed, so that a notification
+  // is either seen here or triggers the guard condition again.
+  if (node_notifications_pending_.exchange(false)) {
+    for (const auto & pair : weak_nodes_to_notify_flags_) {
+      if (pair.second->exchange(false)) {
+        auto node = pair.first.lock();
+        if (node) {
+          node->consume_notify_guard_condition_trigger();
+        }
+        entities_need_rebuild_.store(true);
+      }
+    }
+  }
   memory_strategy_->remove_null_handles(&wait_set_);
 }
 
@@ -827,6 +1464,12 @@ bool
 Executor::get_next_ready_executable(AnyExecutable & any_executable)
 {
   bool success = get_next_ready_executable_from_map(any_executable, weak_groups_to_nodes_);
+  if (success && (instrumentation_ || overload_.max_dispatch_lag.count() > 0)) {
+    // The executable is from the wait set of the last wait.
+    any_executable.ready_time = std::chrono::steady_clock::time_point(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::nanoseconds(last_wait_end_nanoseconds_.load())));
+  }
   return success;
 }
 
@@ -839,39 +1482,57 @@ Executor::get_next_ready_executable_from_map(
   TRACEPOINT(rclcpp_executor_get_next_ready);
   bool success = false;
   std::lock_guard<std::mutex> guard{mutex_};
-  // Check the timers to see if there are any that are ready
-  memory_strategy_->get_next_timer(any_executable, weak_groups_to_nodes);
-  if (any_executable.timer) {
-    success = true;
-  }
-  if (!success) {
-    // Check the subscriptions to see if there are any that are ready
-    memory_strategy_->get_next_subscription(any_executable, weak_groups_to_nodes);
-    if (any_executable.subscription) {
-      success = true;
-    }
-  }
-  if (!success) {
-    // Check the services to see if there are any that are ready
-    memory_strategy_->get_next_service(any_executable, weak_groups_to_nodes);
-    if (any_executable.service) {
-      success = true;
-    }
-  }
-  if (!success) {
-    // Check the clients to see if there are any that are ready
-    memory_strategy_->get_next_client(any_executable, weak_groups_to_nodes);
-    if (any_executable.client) {
-      success = true;
+  if (scheduling_policy_ == ExecutorSchedulingPolicy::RoundRobin) {
+    memory_strategy_->get_next_round_robin_executable(any_executable, weak_groups_to_nodes);
+    if (any_executable.waitable) {
+      any_executable.data = any_executable.waitable->take_data();
     }
-  }
-  if (!success) {
-    // Check the waitables to see if there are any that are ready
-    memory_strategy_->get_next_waitable(any_executable, weak_groups_to_nodes);
+    success = any_executable.timer || any_executable.subscription || any_executable.service ||
+      any_executable.client || any_executable.waitable;
+  } else if (scheduling_policy_ != ExecutorSchedulingPolicy::FixedOrder) {
+    starvation_count_ += memory_strategy_->get_next_prioritized_executable(
+      any_executable, weak_groups_to_nodes,
+      scheduling_policy_ == ExecutorSchedulingPolicy::PriorityEarliestDeadlineFirst);
     if (any_executable.waitable) {
       any_executable.data = any_executable.waitable->take_data();
+    }
+    success = any_executable.timer || any_executable.subscription || any_executable.service ||
+      any_executable.client || any_executable.waitable;
+  } else {
+    // Check the timers to see if there are any that are ready
+    memory_strategy_->get_next_timer(any_executable, weak_groups_to_nodes);
+    if (any_executable.timer) {
       success = true;
     }
+    if (!success) {
+      // Check the subscriptions to see if there are any that are ready
+      memory_strategy_->get_next_subscription(any_executable, weak_groups_to_nodes);
+      if (any_executable.subscription) {
+        success = true;
+      }
+    }
+    if (!success) {
+      // Check the services to see if there are any that are ready
+      memory_strategy_->get_next_service(any_executable, weak_groups_to_nodes);
+      if (any_executable.service) {
+        success = true;
+      }
+    }
+    if (!success) {
+      // Check the clients to see if there are any that are ready
+      memory_strategy_->get_next_client(any_executable, weak_groups_to_nodes);
+      if (any_executable.client) {
+        success = true;
+      }
+    }
+    if (!success) {
+      // Check the waitables to see if there are any that are ready
+      memory_strategy_->get_next_waitable(any_executable, weak_groups_to_nodes);
+      if (any_executable.waitable) {
+        any_executable.data = any_executable.waitable->take_data();
+        success = true;
+      }
+    }
   }
   // At this point any_executable should be valid with either a valid subscription
   // or a valid timer, or it should be a null shared_ptr
@@ -0,0 +1,279 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/executor_instrumentation.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using rclcpp::ExecutionStatistics;
+using rclcpp::ExecutionStatisticsCollector;
+using rclcpp::ExecutorInstrumentation;
+
+ExecutorInstrumentation::~ExecutorInstrumentation()
+{}
+
+void
+ExecutorInstrumentation::on_wait(std::chrono::nanoseconds)
+{}
+
+void
+ExecutorInstrumentation::on_wait_result(size_t, size_t)
+{}
+
+void
+ExecutorInstrumentation::on_execute(const ExecutableExecution &)
+{}
+
+void
+ExecutorInstrumentation::on_wake_up(WaitStage, std::chrono::nanoseconds)
+{}
+
+static void
+atomic_max(std::atomic<int64_t> & target, int64_t value)
+{
+  int64_t current = target.load(std::memory_order_relaxed);
+  while (value > current &&
+    !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+void
+ExecutionStatisticsCollector::Counters::add(
+  std::chrono::nanoseconds dispatch_latency, std::chrono::nanoseconds duration,
+  bool overrun)
+{
+  count.fetch_add(1u, std::memory_order_relaxed);
+  total_duration.fetch_add(duration.count(), std::memory_order_relaxed);
+  atomic_max(max_duration, duration.count());
+  total_dispatch_latency.fetch_add(dispatch_latency.count(), std::memory_order_relaxed);
+  atomic_max(max_dispatch_latency, dispatch_latency.count());
+  if (overrun) {
+    overrun_count.fetch_add(1u, std::memory_order_relaxed);
+  }
+}
+
+ExecutionStatistics
+ExecutionStatisticsCollector::Counters::load() const
+{
+  ExecutionStatistics statistics;
+  statistics.count = count.load(std::memory_order_relaxed);
+  statistics.total_duration = std::chrono::nanoseconds(
+    total_duration.load(std::memory_order_relaxed));
+  statistics.max_duration = std::chrono::nanoseconds(max_duration.load(std::memory_order_relaxed));
+  statistics.total_dispatch_latency = std::chrono::nanoseconds(
+    total_dispatch_latency.load(std::memory_order_relaxed));
+  statistics.max_dispatch_latency = std::chrono::nanoseconds(
+    max_dispatch_latency.load(std::memory_order_relaxed));
+  statistics.overrun_count = overrun_count.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+ExecutionStatisticsCollector::SlotTable::SlotTable(size_t max_keys)
+{
+  // At most half of the slots are used, so that the probe sequences stay short.
+  size_t slot_count = 2u;
+  while (slot_count < 2u * max_keys) {
+    slot_count *= 2u;
+  }
+  mask_ = slot_count - 1u;
+  slots_ = std::make_unique<Slot[]>(slot_count);
+}
+
+size_t
+ExecutionStatisticsCollector::SlotTable::first_index(const void * key) const
+{
+  // Fibonacci hashing of the address, whose low bits are zero because of the alignment.
+  const uint64_t address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key));
+  return static_cast<size_t>((address >> 4u) * UINT64_C(0x9E3779B97F4A7C15) >> 32u) & mask_;
+}
+
+ExecutionStatisticsCollector::Slot *
+ExecutionStatisticsCollector::SlotTable::find_or_claim(const void * key)
+{
+  // Only half of the slots can be claimed, see the constructor.
+  const size_t max_probes = (mask_ + 1u) / 2u;
+  size_t index = first_index(key);
+  for (size_t probe = 0u; probe < max_probes; ++probe, index = (index + 1u) & mask_) {
+    Slot & slot = slots_[index];
+    const void * slot_key = slot.key.load(std::memory_order_acquire);
+    if (slot_key == nullptr) {
+      // Claim the slot, unless another thread claimed it concurrently.
+      if (slot.key.compare_exchange_strong(slot_key, key, std::memory_order_acq_rel)) {
+        return &slot;
+      }
+    }
+    if (slot_key == key) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+const ExecutionStatisticsCollector::Slot *
+ExecutionStatisticsCollector::SlotTable::find(const void * key) const
+{
+  size_t index = first_index(key);
+  for (size_t probe = 0u; probe <= mask_; ++probe, index = (index + 1u) & mask_) {
+    const Slot & slot = slots_[index];
+    const void * slot_key = slot.key.load(std::memory_order_acquire);
+    if (slot_key == key) {
+      return &slot;
+    }
+    if (slot_key == nullptr) {
+      return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+size_t
+ExecutionStatisticsCollector::SlotTable::size() const
+{
+  return mask_ + 1u;
+}
+
+const ExecutionStatisticsCollector::Slot &
+ExecutionStatisticsCollector::SlotTable::at(size_t index) const
+{
+  return slots_[index];
+}
+
+ExecutionStatisticsCollector::ExecutionStatisticsCollector(size_t max_entities)
+: entities_(max_entities),
+  callback_groups_(max_entities)
+{}
+
+ExecutionStatisticsCollector::~ExecutionStatisticsCollector()
+{}
+
+void
+ExecutionStatisticsCollector::on_wait(std::chrono::nanoseconds wait_duration)
+{
+  waits_.add(std::chrono::nanoseconds(0), wait_duration, false);
+}
+
+void
+ExecutionStatisticsCollector::on_execute(const ExecutableExecution & execution)
+{
+  const bool overrun =
+    execution.budget.count() > 0 && execution.duration > execution.budget;
+  bool tracked = true;
+  Slot * entity_slot = entities_.find_or_claim(execution.entity);
+  if (entity_slot) {
+    entity_slot->type.store(execution.type, std::memory_order_relaxed);
+    entity_slot->counters.add(execution.dispatch_latency, execution.duration, overrun);
+  } else {
+    tracked = false;
+  }
+  if (execution.callback_group) {
+    Slot * group_slot = callback_groups_.find_or_claim(execution.callback_group);
+    if (group_slot) {
+      group_slot->counters.add(execution.dispatch_latency, execution.duration, overrun);
+    } else {
+      tracked = false;
+    }
+  }
+  if (!tracked) {
+    untracked_execution_count_.fetch_add(1u, std::memory_order_relaxed);
+  }
+}
+
+ExecutionStatistics
+ExecutionStatisticsCollector::get_statistics(const void * entity) const
+{
+  const Slot * slot = entities_.find(entity);
+  return slot ? slot->counters.load() : ExecutionStatistics();
+}
+
+ExecutionStatistics
+ExecutionStatisticsCollector::get_entity_statistics(const rclcpp::TimerBase * timer) const
+{
+  return get_statistics(timer);
+}
+
+ExecutionStatistics
+ExecutionStatisticsCollector::get_entity_statistics(
+  const rclcpp::SubscriptionBase * subscription) const
+{
+  return get_statistics(subscription);
+}
+
+ExecutionStatistics
+ExecutionStatisticsCollector::get_entity_statistics(const rclcpp::ServiceBase * service) const
+{
+  return get_statistics(service);
+}
+
+ExecutionStatistics
+ExecutionStatisticsCollector::get_entity_statistics(const rclcpp::ClientBase * client) const
+{
+  return get_statistics(client);
+}
+
+ExecutionStatistics
+ExecutionStatisticsCollector::get_entity_statistics(const rclcpp::Waitable * waitable) const
+{
+  return get_statistics(waitable);
+}
+
+std::vector<ExecutionStatisticsCollector::EntityStatistics>
+ExecutionStatisticsCollector::get_all_entity_statistics() const
+{
+  std::vector<EntityStatistics> all_statistics;
+  for (size_t i = 0u; i < entities_.size(); ++i) {
+    const Slot & slot = entities_.at(i);
+    const void * key = slot.key.load(std::memory_order_acquire);
+    if (key) {
+      all_statistics.push_back(
+        {slot.type.load(std::memory_order_relaxed), key, slot.counters.load()});
+    }
+  }
+  return all_statistics;
+}
+
+ExecutionStatistics
+ExecutionStatisticsCollector::get_callback_group_statistics(
+  const rclcpp::CallbackGroup * callback_group) const
+{
+  const Slot * slot = callback_groups_.find(callback_group);
+  return slot ? slot->counters.load() : ExecutionStatistics();
+}
+
+void
+ExecutionStatisticsCollector::on_wake_up(WaitStage stage, std::chrono::nanoseconds latency)
+{
+  wake_up_latencies_[static_cast<size_t>(stage)].record(latency.count());
+}
+
+ExecutionStatistics
+ExecutionStatisticsCollector::get_wait_statistics() const
+{
+  return waits_.load();
+}
+
+uint64_t
+ExecutionStatisticsCollector::get_untracked_execution_count() const
+{
+  return untracked_execution_count_.load(std::memory_order_relaxed);
+}
+
+const rclcpp::topic_statistics::HdrHistogram &
+ExecutionStatisticsCollector::get_wake_up_latency_histogram(WaitStage stage) const
+{
+  return wake_up_latencies_[static_cast<size_t>(stage)];
+}
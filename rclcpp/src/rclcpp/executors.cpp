@@ -14,9 +14,17 @@
 
 #include "rclcpp/executors.hpp"
 
+#include "./detail/spin_executor_cache.hpp"
+
 void
 rclcpp::spin_some(rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr)
 {
+  // The executor of the node is kept between the calls, see get_spin_executor().
+  auto executor = rclcpp::detail::get_spin_executor(node_ptr);
+  if (executor) {
+    executor->spin_some();
+    return;
+  }
   rclcpp::executors::SingleThreadedExecutor exec;
   exec.spin_node_some(node_ptr);
 }
@@ -30,6 +38,11 @@ rclcpp::spin_some(rclcpp::Node::SharedPtr node_ptr)
 void
 rclcpp::spin(rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr)
 {
+  auto executor = rclcpp::detail::get_spin_executor(node_ptr);
+  if (executor) {
+    executor->spin();
+    return;
+  }
   rclcpp::executors::SingleThreadedExecutor exec;
   exec.add_node(node_ptr);
   exec.spin();
@@ -0,0 +1,558 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/executors/events_executor.hpp"
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "rcl/error_handling.h"
+#include "rcl/wait.h"
+#include "rcpputils/scope_exit.hpp"
+
+#include "rclcpp/utilities.hpp"
+
+#include "rcutils/logging_macros.h"
+
+using namespace std::chrono_literals;
+
+using rclcpp::executors::EventsExecutor;
+
+EventsExecutor::EventsExecutor(const rclcpp::ExecutorOptions & options)
+: rclcpp::Executor(options)
+{
+  timers_manager_ = std::make_unique<rclcpp::experimental::TimersManager>(
+    [this](const rclcpp::TimerBase * timer) {
+      push_event({timer, ExecutorEventType::TIMER_EVENT, 1});
+    });
+  entities_watcher_thread_ = std::thread(&EventsExecutor::run_entities_watcher, this);
+}
+
+EventsExecutor::~EventsExecutor()
+{
+  stop_entities_watcher_.store(true);
+  if (trigger_interrupt_guard_condition() != RCL_RET_OK) {
+    RCUTILS_LOG_ERROR_NAMED(
+      "rclcpp",
+      "failed to wake up the entities watcher: %s", rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+  entities_watcher_thread_.join();
+
+  // The listeners capture this executor, they must not be called anymore once it is destroyed.
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    refresh_entities(WeakCallbackGroupsToNodesMap());
+  }
+
+#ifdef __linux__
+  if (ready_fd_.load() >= 0) {
+    close(ready_fd_.load());
+  }
+#endif
+}
+
+void
+EventsExecutor::spin()
+{
+  if (spinning.exchange(true)) {
+    throw std::runtime_error("spin() called while already spinning");
+  }
+  RCPPUTILS_SCOPE_EXIT(this->spinning.store(false); );
+  timers_manager_->start();
+  RCPPUTILS_SCOPE_EXIT(timers_manager_->stop(); );
+  while (rclcpp::ok(this->context_) && spinning.load()) {
+    refresh_entities_if_needed();
+    wait_for_events(-1ns);
+    execute_events(std::chrono::steady_clock::time_point::max());
+  }
+}
+
+void
+EventsExecutor::spin_some(std::chrono::nanoseconds max_duration)
+{
+  spin_ready_events(max_duration, false);
+}
+
+void
+EventsExecutor::spin_all(std::chrono::nanoseconds max_duration)
+{
+  if (max_duration <= 0ns) {
+    throw std::invalid_argument("max_duration must be positive");
+  }
+  spin_ready_events(max_duration, true);
+}
+
+void
+EventsExecutor::spin_ready_events(std::chrono::nanoseconds max_duration, bool exhaustive)
+{
+  if (spinning.exchange(true)) {
+    throw std::runtime_error("spin_some() called while already spinning");
+  }
+  RCPPUTILS_SCOPE_EXIT(this->spinning.store(false); );
+  const auto deadline = max_duration == 0ns ?
+    std::chrono::steady_clock::time_point::max() :
+    std::chrono::steady_clock::now() + max_duration;
+  while (rclcpp::ok(context_) && spinning.load() && std::chrono::steady_clock::now() < deadline) {
+    refresh_entities_if_needed();
+    timers_manager_->execute_ready_timers();
+    wait_for_events(0ns);
+    if (!execute_events(deadline) || !exhaustive) {
+      break;
+    }
+  }
+}
+
+int
+EventsExecutor::get_ready_fd()
+{
+#ifdef __linux__
+  std::lock_guard<std::mutex> lock(ready_fd_mutex_);
+  if (ready_fd_.load() < 0) {
+    const int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "failed to create an eventfd");
+    }
+    ready_fd_.store(fd);
+    // The events queued before the descriptor existed are not missed.
+    signal_ready_fd();
+  }
+  return ready_fd_.load();
+#else
+  throw std::runtime_error("the ready file descriptor is only supported on Linux");
+#endif
+}
+
+void
+EventsExecutor::dispatch_ready()
+{
+#ifdef __linux__
+  const int fd = ready_fd_.load();
+  if (fd >= 0) {
+    uint64_t count;
+    // Fails with EAGAIN if it was not readable, which is fine.
+    const ssize_t ret = read(fd, &count, sizeof(count));
+    (void)ret;
+  }
+#endif
+  try {
+    spin_ready_events(0ns, false);
+  } catch (...) {
+    // The events left over when a callback throws are dispatched on the next call.
+    signal_ready_fd();
+    throw;
+  }
+}
+
+std::chrono::nanoseconds
+EventsExecutor::get_next_timer_timeout()
+{
+  // Timers added since the last dispatch are only scheduled once the entities are refreshed.
+  refresh_entities_if_needed();
+  return timers_manager_->get_head_timeout();
+}
+
+void
+EventsExecutor::spin_once_impl(std::chrono::nanoseconds timeout)
+{
+  refresh_entities_if_needed();
+  const std::chrono::nanoseconds timeout_to_next_timer = timers_manager_->get_head_timeout();
+  if (timeout_to_next_timer >= 0ns && (timeout < 0ns || timeout_to_next_timer < timeout)) {
+    timeout = timeout_to_next_timer;
+  }
+  wait_for_events(timeout);
+  timers_manager_->execute_ready_timers();
+  // The events of the timers which just expired were queued after the ones taken already.
+  wait_for_events(0ns);
+  if (!ready_events_.empty()) {
+    ExecutorEvent event = ready_events_.front();
+    ready_events_.pop_front();
+    execute_event(event);
+  }
+  requeue_ready_events();
+}
+
+void
+EventsExecutor::remove_callback_group_from_map(
+  rclcpp::CallbackGroup::SharedPtr group_ptr,
+  WeakCallbackGroupsToNodesMap & weak_groups_to_nodes,
+  bool notify)
+{
+  Executor::remove_callback_group_from_map(group_ptr, weak_groups_to_nodes, notify);
+  // Unregister the listeners right away, the group may be added to another executor next.
+  refresh_entities(weak_groups_to_nodes_);
+}
+
+void
+EventsExecutor::push_event(const ExecutorEvent & event)
+{
+  {
+    std::lock_guard<std::mutex> lock(events_queue_mutex_);
+    events_queue_.push_back(event);
+  }
+  events_queue_cv_.notify_one();
+  signal_ready_fd();
+}
+
+void
+EventsExecutor::signal_ready_fd()
+{
+#ifdef __linux__
+  const int fd = ready_fd_.load();
+  if (fd >= 0) {
+    const uint64_t one = 1;
+    // Only fails with EAGAIN if the counter would overflow, it is readable anyway then.
+    const ssize_t ret = write(fd, &one, sizeof(one));
+    (void)ret;
+  }
+#endif
+}
+
+void
+EventsExecutor::wait_for_events(std::chrono::nanoseconds timeout)
+{
+  std::unique_lock<std::mutex> lock(events_queue_mutex_);
+  auto has_work = [this]() {return !events_queue_.empty() || notified_;};
+  if (timeout < 0ns) {
+    events_queue_cv_.wait(lock, has_work);
+  } else if (timeout > 0ns) {
+    events_queue_cv_.wait_for(lock, timeout, has_work);
+  }
+  notified_ = false;
+  if (ready_events_.empty()) {
+    std::swap(ready_events_, events_queue_);
+  } else {
+    // Left over if executing an event threw.
+    ready_events_.insert(ready_events_.end(), events_queue_.begin(), events_queue_.end());
+    events_queue_.clear();
+  }
+}
+
+bool
+EventsExecutor::execute_events(std::chrono::steady_clock::time_point deadline)
+{
+  bool executed = false;
+  while (!ready_events_.empty() && spinning.load() &&
+    std::chrono::steady_clock::now() < deadline)
+  {
+    ExecutorEvent event = ready_events_.front();
+    ready_events_.pop_front();
+    execute_event(event);
+    executed = true;
+  }
+  requeue_ready_events();
+  return executed;
+}
+
+void
+EventsExecutor::execute_event(const ExecutorEvent & event)
+{
+  switch (event.type) {
+    case ExecutorEventType::SUBSCRIPTION_EVENT:
+      {
+        auto subscription = get_entity(subscriptions_, event.entity_key);
+        if (subscription) {
+          // Every execution takes up to max_messages_per_take messages, or all of them when
+          // only the latest message is handled.
+          const size_t max_messages = subscription->get_take_latest_only() ?
+            event.num_events : subscription->get_max_messages_per_take();
+          for (size_t taken = 0; taken < event.num_events; taken += max_messages) {
+            execute_subscription(subscription);
+          }
+        }
+        break;
+      }
+    case ExecutorEventType::SERVICE_EVENT:
+      {
+        auto service = get_entity(services_, event.entity_key);
+        if (service) {
+          for (size_t i = 0; i < event.num_events; ++i) {
+            execute_service(service);
+          }
+        }
+        break;
+      }
+    case ExecutorEventType::CLIENT_EVENT:
+      {
+        auto client = get_entity(clients_, event.entity_key);
+        if (client) {
+          for (size_t i = 0; i < event.num_events; ++i) {
+            execute_client(client);
+          }
+        }
+        break;
+      }
+    case ExecutorEventType::WAITABLE_EVENT:
+      {
+        auto waitable = get_entity(waitables_, event.entity_key);
+        if (waitable) {
+          for (size_t i = 0; i < event.num_events; ++i) {
+            auto data = waitable->take_data();
+            waitable->execute(data);
+          }
+        }
+        break;
+      }
+    case ExecutorEventType::TIMER_EVENT:
+      {
+        // The timers manager already called the timer, only its callback is left.
+        auto timer = get_entity(timers_, event.entity_key);
+        if (timer) {
+          execute_timer(timer);
+        }
+        break;
+      }
+  }
+}
+
+void
+EventsExecutor::requeue_ready_events()
+{
+  if (ready_events_.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(events_queue_mutex_);
+    events_queue_.insert(events_queue_.begin(), ready_events_.begin(), ready_events_.end());
+  }
+  ready_events_.clear();
+}
+
+void
+EventsExecutor::refresh_entities_if_needed()
+{
+  if (!entities_need_rebuild_.exchange(false)) {
+    return;
+  }
+  std::lock_guard<std::mutex> guard{mutex_};
+  add_callback_groups_from_nodes_associated_to_executor();
+  refresh_entities(weak_groups_to_nodes_);
+}
+
+void
+EventsExecutor::refresh_entities(const WeakCallbackGroupsToNodesMap & weak_groups_to_nodes)
+{
+  EntityMap<rclcpp::SubscriptionBase> subscriptions;
+  EntityMap<rclcpp::ServiceBase> services;
+  EntityMap<rclcpp::ClientBase> clients;
+  EntityMap<rclcpp::Waitable> waitables;
+  EntityMap<rclcpp::TimerBase> timers;
+
+  for (const auto & pair : weak_groups_to_nodes) {
+    auto group = pair.first.lock();
+    // The entities of disabled groups are dropped like the ones of removed groups.
+    if (!group || !group->is_enabled()) {
+      continue;
+    }
+    group->find_subscription_ptrs_if(
+      [this, &subscriptions](const rclcpp::SubscriptionBase::SharedPtr & subscription) {
+        const void * key = subscription.get();
+        if (subscriptions_.count(key) == 0) {
+          subscription->set_on_new_message_callback(
+            [this, key](size_t num_messages) {
+              push_event({key, ExecutorEventType::SUBSCRIPTION_EVENT, num_messages});
+            });
+        }
+        subscriptions.emplace(key, subscription);
+        return false;
+      });
+    group->find_service_ptrs_if(
+      [this, &services](const rclcpp::ServiceBase::SharedPtr & service) {
+        const void * key = service.get();
+        if (services_.count(key) == 0) {
+          service->set_on_new_request_callback(
+            [this, key](size_t num_requests) {
+              push_event({key, ExecutorEventType::SERVICE_EVENT, num_requests});
+            });
+        }
+        services.emplace(key, service);
+        return false;
+      });
+    group->find_client_ptrs_if(
+      [this, &clients](const rclcpp::ClientBase::SharedPtr & client) {
+        const void * key = client.get();
+        if (clients_.count(key) == 0) {
+          client->set_on_new_response_callback(
+            [this, key](size_t num_responses) {
+              push_event({key, ExecutorEventType::CLIENT_EVENT, num_responses});
+            });
+        }
+        clients.emplace(key, client);
+        return false;
+      });
+    group->find_waitable_ptrs_if(
+      [this, &waitables](const rclcpp::Waitable::SharedPtr & waitable) {
+        const void * key = waitable.get();
+        if (waitables_.count(key) == 0) {
+          try {
+            waitable->set_on_ready_callback(
+              [this, key](size_t num_events, int) {
+                push_event({key, ExecutorEventType::WAITABLE_EVENT, num_events});
+              });
+          } catch (const std::exception & exception) {
+            // Still remembered below, so that the warning is printed only once.
+            RCUTILS_LOG_WARN_NAMED(
+              "rclcpp",
+              "waitable can not be executed by the EventsExecutor: %s", exception.what());
+          }
+        }
+        waitables.emplace(key, waitable);
+        return false;
+      });
+    group->find_timer_ptrs_if(
+      [this, &timers](const rclcpp::TimerBase::SharedPtr & timer) {
+        const void * key = timer.get();
+        if (timers_.count(key) == 0) {
+          timers_manager_->add_timer(timer);
+        }
+        timers.emplace(key, timer);
+        return false;
+      });
+  }
+
+  // Entities which were destroyed already cleared their listener themselves.
+  for (const auto & pair : subscriptions_) {
+    auto subscription = pair.second.lock();
+    if (subscription && subscriptions.count(pair.first) == 0) {
+      subscription->clear_on_new_message_callback();
+    }
+  }
+  for (const auto & pair : services_) {
+    auto service = pair.second.lock();
+    if (service && services.count(pair.first) == 0) {
+      service->clear_on_new_request_callback();
+    }
+  }
+  for (const auto & pair : clients_) {
+    auto client = pair.second.lock();
+    if (client && clients.count(pair.first) == 0) {
+      client->clear_on_new_response_callback();
+    }
+  }
+  for (const auto & pair : waitables_) {
+    auto waitable = pair.second.lock();
+    if (waitable && waitables.count(pair.first) == 0) {
+      try {
+        waitable->clear_on_ready_callback();
+      } catch (const std::exception &) {
+        // The waitable does not support listeners, there is nothing to clear.
+      }
+    }
+  }
+
+  for (const auto & pair : timers_) {
+    auto timer = pair.second.lock();
+    if (timer && timers.count(pair.first) == 0) {
+      timers_manager_->remove_timer(timer);
+    }
+  }
+
+  subscriptions_ = std::move(subscriptions);
+  services_ = std::move(services);
+  clients_ = std::move(clients);
+  waitables_ = std::move(waitables);
+  timers_ = std::move(timers);
+}
+
+void
+EventsExecutor::run_entities_watcher()
+{
+  // Only waits on guard conditions, which is independent of the number of entities:
+  // the interrupt guard condition is triggered by cancel() and when nodes or callback groups are
+  // added, and the notify guard condition of a node when its entities change.
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(
+    &wait_set, 0, 2, 0, 0, 0, 0, context_->get_rcl_context().get(), rcl_get_default_allocator());
+  if (RCL_RET_OK != ret) {
+    RCUTILS_LOG_ERROR_NAMED(
+      "rclcpp",
+      "failed to create wait set of the entities watcher: %s", rcl_get_error_string().str);
+    rcl_reset_error();
+    return;
+  }
+  while (!stop_entities_watcher_.load() && rclcpp::ok(context_)) {
+    {
+      std::lock_guard<std::mutex> guard{mutex_};
+      ret = rcl_wait_set_resize(
+        &wait_set, 0, 2 + weak_nodes_to_guard_conditions_.size(), 0, 0, 0, 0);
+      if (RCL_RET_OK == ret) {
+        ret = rcl_wait_set_add_guard_condition(&wait_set, &interrupt_guard_condition_, NULL);
+      }
+      if (RCL_RET_OK == ret) {
+        ret = rcl_wait_set_add_guard_condition(
+          &wait_set, &shutdown_guard_condition_->get_rcl_guard_condition(), NULL);
+      }
+      for (const auto & pair : weak_nodes_to_guard_conditions_) {
+        if (RCL_RET_OK == ret && !pair.first.expired()) {
+          ret = rcl_wait_set_add_guard_condition(&wait_set, pair.second, NULL);
+        }
+      }
+    }
+    if (RCL_RET_OK == ret) {
+      ret = rcl_wait(&wait_set, -1);
+    }
+    if (RCL_RET_OK != ret) {
+      RCUTILS_LOG_ERROR_NAMED(
+        "rclcpp",
+        "entities watcher failed to wait: %s", rcl_get_error_string().str);
+      rcl_reset_error();
+      break;
+    }
+
+    if (wait_set.guard_conditions[0]) {
+      consume_interrupt_guard_condition_trigger();
+    }
+    for (size_t i = 2; i < wait_set.size_of_guard_conditions; ++i) {
+      if (wait_set.guard_conditions[i]) {
+        entities_need_rebuild_.store(true);
+        // Consumed before the entities are collected again, so that no change is missed.
+        std::lock_guard<std::mutex> guard{mutex_};
+        for (const auto & pair : weak_nodes_to_guard_conditions_) {
+          if (pair.second != wait_set.guard_conditions[i]) {
+            continue;
+          }
+          auto node = pair.first.lock();
+          if (node) {
+            node->consume_notify_guard_condition_trigger();
+          }
+        }
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(events_queue_mutex_);
+      notified_ = true;
+    }
+    events_queue_cv_.notify_one();
+    signal_ready_fd();
+  }
+
+  if (rcl_wait_set_fini(&wait_set) != RCL_RET_OK) {
+    RCUTILS_LOG_ERROR_NAMED(
+      "rclcpp",
+      "failed to destroy wait set of the entities watcher: %s", rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+}
@@ -15,21 +15,148 @@
 #include "rclcpp/executors/multi_threaded_executor.hpp"
 
 #include <chrono>
+#include <exception>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "rcpputils/scope_exit.hpp"
 
+#include "rclcpp/exceptions.hpp"
+#include "rclcpp/memory_strategies.hpp"
 #include "rclcpp/utilities.hpp"
 
+using rclcpp::exceptions::throw_from_rcl_error;
 using rclcpp::executors::MultiThreadedExecutor;
 
+/// Executor only used for its wait set, waiting on the callback groups assigned to it.
+/**
+ * The callback groups stay associated with the MultiThreadedExecutor, which assigns them to
+ * the wait sets before their waits.
+ * The first wait set also waits on the interrupt guard condition of the MultiThreadedExecutor
+ * and on the notify guard conditions of the nodes, so that it updates the assignments when
+ * callback groups or nodes are added or changed.
+ */
+class MultiThreadedExecutor::WaitSetShard : public rclcpp::Executor
+{
+public:
+  WaitSetShard(
+    const rclcpp::ExecutorOptions & options,
+    MultiThreadedExecutor * parent,
+    bool is_first)
+  : rclcpp::Executor(options),
+    parent_(parent),
+    is_first_(is_first)
+  {
+    if (is_first_) {
+      std::lock_guard<std::mutex> guard{mutex_};
+      memory_strategy_->add_guard_condition(&parent_->interrupt_guard_condition_);
+    }
+  }
+
+  ~WaitSetShard()
+  {
+    std::lock_guard<std::mutex> guard{mutex_};
+    if (is_first_) {
+      memory_strategy_->remove_guard_condition(&parent_->interrupt_guard_condition_);
+    }
+    // The callback groups are associated with the parent, which disassociates them.
+    weak_groups_to_nodes_.clear();
+  }
+
+  void
+  spin() override
+  {
+    throw std::runtime_error("the wait sets of a MultiThreadedExecutor cannot spin");
+  }
+
+  /// Replace the callback groups waited on, from the next wait on.
+  /**
+   * \param[in] callback_groups callback groups of this wait set
+   * \param[in] node_guard_conditions notify guard conditions of all the nodes, only waited on
+   *   by the first wait set
+   */
+  void
+  assign_callback_groups(
+    rclcpp::WeakCallbackGroupsToNodesMap callback_groups,
+    WeakNodesToGuardConditionsMap node_guard_conditions)
+  {
+    {
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      pending_callback_groups_ = std::move(callback_groups);
+      pending_node_guard_conditions_ = std::move(node_guard_conditions);
+      has_pending_callback_groups_ = true;
+    }
+    rcl_ret_t ret = trigger_interrupt_guard_condition();
+    if (ret != RCL_RET_OK) {
+      throw_from_rcl_error(ret, "Failed to trigger guard condition on callback groups assignment");
+    }
+  }
+
+  void
+  start()
+  {
+    spinning.store(true);
+  }
+
+  bool
+  wait_for_executable(rclcpp::AnyExecutable & any_exec, std::chrono::nanoseconds timeout)
+  {
+    return get_next_executable(any_exec, timeout);
+  }
+
+  void
+  execute(rclcpp::AnyExecutable & any_exec)
+  {
+    execute_any_executable(any_exec);
+  }
+
+protected:
+  /// Called at the start of each wait, with mutex_ held.
+  void
+  add_callback_groups_from_nodes_associated_to_executor() override RCPPUTILS_TSA_REQUIRES(mutex_)
+  {
+    if (is_first_) {
+      // Set after the previous wait if a node guard condition was triggered.
+      const bool nodes_changed = entities_need_rebuild_.load();
+      parent_->consume_interrupt_guard_condition_trigger();
+      parent_->update_wait_set_shards(nodes_changed);
+    }
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    if (!has_pending_callback_groups_) {
+      return;
+    }
+    has_pending_callback_groups_ = false;
+    weak_groups_to_nodes_ = std::move(pending_callback_groups_);
+    for (const auto & pair : weak_nodes_to_guard_conditions_) {
+      memory_strategy_->remove_guard_condition(pair.second);
+    }
+    weak_nodes_to_guard_conditions_ = std::move(pending_node_guard_conditions_);
+    for (const auto & pair : weak_nodes_to_guard_conditions_) {
+      memory_strategy_->add_guard_condition(pair.second);
+    }
+    entities_need_rebuild_.store(true);
+  }
+
+private:
+  MultiThreadedExecutor * const parent_;
+  const bool is_first_;
+
+  std::mutex pending_mutex_;
+  rclcpp::WeakCallbackGroupsToNodesMap pending_callback_groups_;
+  WeakNodesToGuardConditionsMap pending_node_guard_conditions_;
+  bool has_pending_callback_groups_{false};
+};
+
 MultiThreadedExecutor::MultiThreadedExecutor(
   const rclcpp::ExecutorOptions & options,
   size_t number_of_threads,
   bool yield_before_execute,
-  std::chrono::nanoseconds next_exec_timeout)
+  std::chrono::nanoseconds next_exec_timeout,
+  size_t number_of_wait_sets)
 : rclcpp::Executor(options),
   yield_before_execute_(yield_before_execute),
   next_exec_timeout_(next_exec_timeout)
@@ -38,9 +165,22 @@ MultiThreadedExecutor::MultiThreadedExecutor(
   if (number_of_threads_ == 0) {
     number_of_threads_ = 1;
   }
+  if (number_of_wait_sets > 1) {
+    // Every wait set needs its own memory strategy, the other options are shared.
+    rclcpp::ExecutorOptions shard_options = options;
+    for (size_t i = 0; i < number_of_wait_sets; ++i) {
+      shard_options.memory_strategy = rclcpp::memory_strategies::create_default_strategy();
+      shards_.emplace_back(std::make_unique<WaitSetShard>(shard_options, this, i == 0));
+    }
+    shard_callback_groups_.resize(number_of_wait_sets);
+  }
 }
 
-MultiThreadedExecutor::~MultiThreadedExecutor() {}
+MultiThreadedExecutor::~MultiThreadedExecutor()
+{
+  // The wait sets reference the interrupt guard condition of this executor.
+  shards_.clear();
+}
 
 void
 MultiThreadedExecutor::spin()
@@ -49,6 +189,14 @@ MultiThreadedExecutor::spin()
     throw std::runtime_error("spin() called while already spinning");
   }
   RCPPUTILS_SCOPE_EXIT(this->spinning.store(false); );
+  if (!shards_.empty()) {
+    spin_sharded();
+    return;
+  }
+  if (thread_pool_) {
+    spin_with_thread_pool();
+    return;
+  }
   std::vector<std::thread> threads;
   size_t thread_id = 0;
   {
@@ -71,6 +219,25 @@ MultiThreadedExecutor::get_number_of_threads()
   return number_of_threads_;
 }
 
+size_t
+MultiThreadedExecutor::get_number_of_wait_sets() const
+{
+  return shards_.empty() ? 1u : shards_.size();
+}
+
+void
+MultiThreadedExecutor::set_thread_pool(SharedThreadPool::SharedPtr thread_pool)
+{
+  if (spinning.load()) {
+    throw std::runtime_error("set_thread_pool() called while spinning");
+  }
+  if (thread_pool && !shards_.empty()) {
+    throw std::invalid_argument(
+            "a thread pool can not be used by a MultiThreadedExecutor with several wait sets");
+  }
+  thread_pool_ = std::move(thread_pool);
+}
+
 void
 MultiThreadedExecutor::run(size_t)
 {
@@ -96,3 +263,238 @@ MultiThreadedExecutor::run(size_t)
     any_exec.callback_group.reset();
   }
 }
+
+void
+MultiThreadedExecutor::spin_with_thread_pool()
+{
+  {
+    std::lock_guard<std::mutex> lock(thread_pool_mutex_);
+    thread_pool_error_ = nullptr;
+  }
+  while (rclcpp::ok(this->context_) && spinning.load()) {
+    {
+      // An executable is only taken once the quota of the executor allows executing it.
+      std::unique_lock<std::mutex> lock(thread_pool_mutex_);
+      thread_pool_condition_.wait(
+        lock, [this]() {
+          return thread_pool_executions_ < number_of_threads_ || thread_pool_error_;
+        });
+      if (thread_pool_error_) {
+        break;
+      }
+    }
+    auto any_exec = std::make_shared<rclcpp::AnyExecutable>();
+    if (!get_next_executable(*any_exec, next_exec_timeout_)) {
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> lock(thread_pool_mutex_);
+      ++thread_pool_executions_;
+    }
+    thread_pool_->submit(
+      [this, any_exec]() {
+        if (yield_before_execute_) {
+          std::this_thread::yield();
+        }
+        std::exception_ptr error;
+        try {
+          execute_any_executable(*any_exec);
+        } catch (...) {
+          error = std::current_exception();
+        }
+        // Clear the callback_group to prevent the AnyExecutable destructor from
+        // resetting the callback group `can_be_taken_from`
+        any_exec->callback_group.reset();
+        // Notified with the lock held, as spin() may return and destroy the executor as soon
+        // as the lock is released.
+        std::lock_guard<std::mutex> lock(thread_pool_mutex_);
+        if (error && !thread_pool_error_) {
+          thread_pool_error_ = error;
+        }
+        --thread_pool_executions_;
+        thread_pool_condition_.notify_all();
+      });
+  }
+
+  std::unique_lock<std::mutex> lock(thread_pool_mutex_);
+  thread_pool_condition_.wait(lock, [this]() {return 0 == thread_pool_executions_;});
+  if (thread_pool_error_) {
+    std::rethrow_exception(std::exchange(thread_pool_error_, nullptr));
+  }
+}
+
+void
+MultiThreadedExecutor::spin_sharded()
+{
+  {
+    std::lock_guard<std::mutex> lock(ready_mutex_);
+    shards_stopped_ = false;
+  }
+  // The nodes may have changed since the last spin, while no wait set was waiting on them.
+  update_wait_set_shards(true);
+  for (auto & shard : shards_) {
+    shard->start();
+  }
+
+  std::vector<std::thread> threads;
+  threads.reserve(shards_.size() + number_of_threads_ - 1);
+  for (size_t wait_set_index = 0; wait_set_index < shards_.size(); ++wait_set_index) {
+    threads.emplace_back(&MultiThreadedExecutor::run_waiter, this, wait_set_index);
+  }
+  for (size_t thread_id = 0; thread_id < number_of_threads_ - 1; ++thread_id) {
+    threads.emplace_back(&MultiThreadedExecutor::run_worker, this);
+  }
+
+  std::exception_ptr error;
+  try {
+    run_worker();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  stop_wait_set_shards();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  {
+    std::lock_guard<std::mutex> lock(ready_mutex_);
+    // Destroying the queued executables marks their callback groups as available again.
+    ready_executables_.clear();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void
+MultiThreadedExecutor::run_waiter(size_t wait_set_index)
+{
+  WaitSetShard & shard = *shards_[wait_set_index];
+  while (rclcpp::ok(this->context_) && spinning.load()) {
+    auto any_exec = std::make_unique<rclcpp::AnyExecutable>();
+    if (!shard.wait_for_executable(*any_exec, next_exec_timeout_)) {
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> lock(ready_mutex_);
+      ready_executables_.emplace_back(&shard, std::move(any_exec));
+    }
+    ready_condition_.notify_one();
+  }
+  // Stopped by cancel(), which wakes the first wait set, or by the shutdown of the context.
+  stop_wait_set_shards();
+}
+
+void
+MultiThreadedExecutor::run_worker()
+{
+  while (true) {
+    std::pair<WaitSetShard *, std::unique_ptr<rclcpp::AnyExecutable>> ready;
+    {
+      std::unique_lock<std::mutex> lock(ready_mutex_);
+      ready_condition_.wait(
+        lock, [this]() {return shards_stopped_ || !ready_executables_.empty();});
+      if (shards_stopped_) {
+        return;
+      }
+      ready = std::move(ready_executables_.front());
+      ready_executables_.pop_front();
+    }
+    if (yield_before_execute_) {
+      std::this_thread::yield();
+    }
+
+    // The wait set of the executable is woken up when its callback group is available again.
+    ready.first->execute(*ready.second);
+
+    // Clear the callback_group to prevent the AnyExecutable destructor from
+    // resetting the callback group `can_be_taken_from`
+    ready.second->callback_group.reset();
+  }
+}
+
+void
+MultiThreadedExecutor::update_wait_set_shards(bool nodes_changed)
+{
+  std::lock_guard<std::mutex> guard{mutex_};
+  add_callback_groups_from_nodes_associated_to_executor();
+
+  std::vector<bool> changed(shards_.size(), nodes_changed);
+  // Forget the callback groups which were removed or destroyed.
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    auto & callback_groups = shard_callback_groups_[i];
+    for (auto it = callback_groups.begin(); it != callback_groups.end(); ) {
+      if (it->first.expired() || weak_groups_to_nodes_.count(it->first) == 0) {
+        it = callback_groups.erase(it);
+        changed[i] = true;
+      } else {
+        ++it;
+      }
+    }
+  }
+  // Assign the new callback groups to the wait set with the fewest of them.
+  for (const auto & pair : weak_groups_to_nodes_) {
+    if (pair.first.expired()) {
+      continue;
+    }
+    size_t least_loaded = 0;
+    bool assigned = false;
+    for (size_t i = 0; i < shards_.size() && !assigned; ++i) {
+      assigned = shard_callback_groups_[i].count(pair.first) != 0;
+      if (shard_callback_groups_[i].size() < shard_callback_groups_[least_loaded].size()) {
+        least_loaded = i;
+      }
+    }
+    if (!assigned) {
+      shard_callback_groups_[least_loaded].insert(pair);
+      changed[least_loaded] = true;
+    }
+  }
+
+  // The first wait set waits on the nodes of all the callback groups.
+  WeakNodesToGuardConditionsMap node_guard_conditions;
+  for (const auto & pair : weak_groups_to_nodes_) {
+    auto node = pair.second.lock();
+    if (node) {
+      node_guard_conditions[node] = node->get_notify_guard_condition();
+    }
+  }
+  for (const auto & weak_node : weak_nodes_) {
+    auto node = weak_node.lock();
+    if (node) {
+      node_guard_conditions[node] = node->get_notify_guard_condition();
+    }
+  }
+  if (node_guard_conditions.size() != shard_node_guard_conditions_.size()) {
+    changed[0] = true;
+  }
+  for (const auto & pair : node_guard_conditions) {
+    auto it = shard_node_guard_conditions_.find(pair.first);
+    if (it == shard_node_guard_conditions_.end() || it->second != pair.second) {
+      changed[0] = true;
+    }
+  }
+  if (changed[0]) {
+    shard_node_guard_conditions_ = std::move(node_guard_conditions);
+  }
+
+  for (size_t i = 0; i < shards_.size(); ++i) {
+    if (changed[i]) {
+      shards_[i]->assign_callback_groups(
+        shard_callback_groups_[i],
+        i == 0 ? shard_node_guard_conditions_ : WeakNodesToGuardConditionsMap());
+    }
+  }
+}
+
+void
+MultiThreadedExecutor::stop_wait_set_shards()
+{
+  {
+    std::lock_guard<std::mutex> lock(ready_mutex_);
+    shards_stopped_ = true;
+  }
+  ready_condition_.notify_all();
+  for (auto & shard : shards_) {
+    shard->cancel();
+  }
+}
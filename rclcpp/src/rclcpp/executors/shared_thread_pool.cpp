@@ -0,0 +1,89 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/executors/shared_thread_pool.hpp"
+
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+using rclcpp::executors::SharedThreadPool;
+
+SharedThreadPool::SharedThreadPool(size_t number_of_threads)
+{
+  if (0 == number_of_threads) {
+    number_of_threads = std::thread::hardware_concurrency();
+  }
+  if (0 == number_of_threads) {
+    number_of_threads = 1;
+  }
+  threads_.reserve(number_of_threads);
+  for (size_t i = 0; i < number_of_threads; ++i) {
+    threads_.emplace_back(&SharedThreadPool::run, this);
+  }
+}
+
+SharedThreadPool::~SharedThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  condition_.notify_all();
+  for (auto & thread : threads_) {
+    thread.join();
+  }
+}
+
+SharedThreadPool::SharedPtr
+SharedThreadPool::get_global_instance()
+{
+  static SharedThreadPool::SharedPtr pool = SharedThreadPool::make_shared();
+  return pool;
+}
+
+void
+SharedThreadPool::submit(std::function<void ()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  condition_.notify_one();
+}
+
+size_t
+SharedThreadPool::get_number_of_threads() const
+{
+  return threads_.size();
+}
+
+void
+SharedThreadPool::run()
+{
+  while (true) {
+    std::function<void ()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this]() {return stopped_ || !tasks_.empty();});
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
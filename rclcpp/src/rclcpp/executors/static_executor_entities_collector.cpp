@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <set>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -24,6 +25,8 @@
 #include "rclcpp/memory_strategy.hpp"
 #include "rclcpp/executors/static_single_threaded_executor.hpp"
 
+#include "../detail/spin_executor_cache.hpp"
+
 using rclcpp::executors::StaticExecutorEntitiesCollector;
 
 StaticExecutorEntitiesCollector::~StaticExecutorEntitiesCollector()
@@ -63,8 +66,9 @@ StaticExecutorEntitiesCollector::init(
   rcl_wait_set_t * p_wait_set,
   rclcpp::memory_strategy::MemoryStrategy::SharedPtr memory_strategy)
 {
-  // Empty initialize executable list
-  exec_list_ = rclcpp::experimental::ExecutableList();
+  // Empty initialize executable list, so that execute() fills it from scratch
+  exec_list_.clear();
+  groups_.clear();
   // Get executor's wait_set_ pointer
   p_wait_set_ = p_wait_set;
   // Get executor's memory strategy ptr
@@ -72,6 +76,9 @@ StaticExecutorEntitiesCollector::init(
     throw std::runtime_error("Received NULL memory strategy in executor waitable.");
   }
   memory_strategy_ = memory_strategy;
+  // The memory strategy only provides the guard conditions of the executor, the entities are
+  // added to the wait set from the executable list.
+  memory_strategy_->clear_handles();
 
   // Get memory strategy and executable list. Prepare wait_set_
   std::shared_ptr<void> shared_ptr;
@@ -86,6 +93,9 @@ StaticExecutorEntitiesCollector::fini()
 {
   memory_strategy_->clear_handles();
   exec_list_.clear();
+  next_exec_list_.clear();
+  groups_.clear();
+  next_groups_.clear();
 }
 
 std::shared_ptr<void>
@@ -98,11 +108,9 @@ void
 StaticExecutorEntitiesCollector::execute(std::shared_ptr<void> & data)
 {
   (void) data;
-  // Fill memory strategy with entities coming from weak_nodes_
-  fill_memory_strategy();
-  // Fill exec_list_ with entities coming from weak_nodes_ (same as memory strategy)
-  fill_executable_list();
-  // Resize the wait_set_ based on memory_strategy handles (rcl_wait_set_resize)
+  // Fill exec_list_ with entities coming from weak_nodes_, if any of them changed
+  update_executable_list();
+  // Resize the wait_set_ if the number of entities changed (rcl_wait_set_resize)
   prepare_wait_set();
   // Add new nodes guard conditions to map
   std::lock_guard<std::mutex> guard{new_nodes_mutex_};
@@ -114,104 +122,109 @@ StaticExecutorEntitiesCollector::execute(std::shared_ptr<void> & data)
   new_nodes_.clear();
 }
 
-void
-StaticExecutorEntitiesCollector::fill_memory_strategy()
+bool
+StaticExecutorEntitiesCollector::update_executable_list()
 {
-  memory_strategy_->clear_handles();
-  bool has_invalid_weak_groups_or_nodes =
-    memory_strategy_->collect_entities(weak_groups_to_nodes_associated_with_executor_);
-  // Clean up any invalid nodes, if they were detected
-  if (has_invalid_weak_groups_or_nodes) {
-    std::vector<rclcpp::CallbackGroup::WeakPtr> invalid_group_ptrs;
-    for (const auto & pair : weak_groups_to_nodes_associated_with_executor_) {
-      auto & weak_group_ptr = pair.first;
-      auto & weak_node_ptr = pair.second;
-      if (weak_group_ptr.expired() || weak_node_ptr.expired()) {
-        invalid_group_ptrs.push_back(weak_group_ptr);
-      }
-    }
-    std::for_each(
-      invalid_group_ptrs.begin(), invalid_group_ptrs.end(),
-      [this](rclcpp::CallbackGroup::WeakPtr group_ptr) {
-        weak_groups_to_nodes_associated_with_executor_.erase(group_ptr);
-      });
-  }
-  has_invalid_weak_groups_or_nodes =
-    memory_strategy_->collect_entities(weak_groups_associated_with_executor_to_nodes_);
-  // Clean up any invalid nodes, if they were detected
-  if (has_invalid_weak_groups_or_nodes) {
-    std::vector<rclcpp::CallbackGroup::WeakPtr> invalid_group_ptrs;
-    for (const auto & pair : weak_groups_associated_with_executor_to_nodes_) {
-      auto & weak_group_ptr = pair.first;
-      const auto & weak_node_ptr = pair.second;
-      if (weak_group_ptr.expired() || weak_node_ptr.expired()) {
-        invalid_group_ptrs.push_back(weak_group_ptr);
-      }
-    }
-    std::for_each(
-      invalid_group_ptrs.begin(), invalid_group_ptrs.end(),
-      [this](rclcpp::CallbackGroup::WeakPtr group_ptr) {
-        weak_groups_associated_with_executor_to_nodes_.erase(group_ptr);
-      });
+  add_callback_groups_from_nodes_associated_to_executor();
+  remove_invalid_callback_groups(weak_groups_associated_with_executor_to_nodes_);
+  remove_invalid_callback_groups(weak_groups_to_nodes_associated_with_executor_);
+
+  // Collect into the spare list, which keeps its capacity, and compare it with the current
+  // one: most changes of a node, e.g. a new publisher, leave the executable entities as they are.
+  next_exec_list_.clear();
+  next_groups_.clear();
+  fill_executable_list_from_map(
+    weak_groups_associated_with_executor_to_nodes_, next_exec_list_, next_groups_);
+  fill_executable_list_from_map(
+    weak_groups_to_nodes_associated_with_executor_, next_exec_list_, next_groups_);
+  // Add the executor's waitable to the executable list
+  next_exec_list_.add_waitable(shared_from_this());
+  next_groups_.waitable.emplace_back();
+
+  // Comparing the contiguous handles is enough, exec_list_ keeps its entities, and so their
+  // handles, alive.
+  bool changed =
+    next_exec_list_.subscription_handle != exec_list_.subscription_handle ||
+    next_exec_list_.timer_handle != exec_list_.timer_handle ||
+    next_exec_list_.service_handle != exec_list_.service_handle ||
+    next_exec_list_.client_handle != exec_list_.client_handle ||
+    next_exec_list_.waitable != exec_list_.waitable;
+  if (changed) {
+    exec_list_.swap(next_exec_list_);
+    std::swap(groups_, next_groups_);
   }
-
-  // Add the static executor waitable to the memory strategy
-  memory_strategy_->add_waitable_handle(this->shared_from_this());
+  // Release the entities of the previous list
+  next_exec_list_.clear();
+  next_groups_.clear();
+  return changed;
 }
 
 void
-StaticExecutorEntitiesCollector::fill_executable_list()
+StaticExecutorEntitiesCollector::remove_invalid_callback_groups(
+  WeakCallbackGroupsToNodesMap & weak_groups_to_nodes)
 {
-  exec_list_.clear();
-  add_callback_groups_from_nodes_associated_to_executor();
-  fill_executable_list_from_map(weak_groups_associated_with_executor_to_nodes_);
-  fill_executable_list_from_map(weak_groups_to_nodes_associated_with_executor_);
-  // Add the executor's waitable to the executable list
-  exec_list_.add_waitable(shared_from_this());
+  auto it = weak_groups_to_nodes.begin();
+  while (it != weak_groups_to_nodes.end()) {
+    if (it->first.expired() || it->second.expired()) {
+      it = weak_groups_to_nodes.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
+
 void
 StaticExecutorEntitiesCollector::fill_executable_list_from_map(
   const rclcpp::memory_strategy::MemoryStrategy::WeakCallbackGroupsToNodesMap &
-  weak_groups_to_nodes)
+  weak_groups_to_nodes,
+  rclcpp::experimental::ExecutableList & exec_list,
+  CallbackGroupList & groups)
 {
   for (const auto & pair : weak_groups_to_nodes) {
     auto group = pair.first.lock();
     auto node = pair.second.lock();
-    if (!node || !group || !group->can_be_taken_from().load()) {
+    // Groups taken by a thread of a multi-threaded executor are collected anyway, their entities
+    // do not leave the executable list while a callback runs, unlike the ones of disabled groups.
+    if (!node || !group || !group->is_enabled()) {
       continue;
     }
     group->find_timer_ptrs_if(
-      [this](const rclcpp::TimerBase::SharedPtr & timer) {
+      [&exec_list, &groups, &group](const rclcpp::TimerBase::SharedPtr & timer) {
         if (timer) {
-          exec_list_.add_timer(timer);
+          exec_list.add_timer(timer);
+          groups.timer.push_back(group);
         }
         return false;
       });
     group->find_subscription_ptrs_if(
-      [this](const rclcpp::SubscriptionBase::SharedPtr & subscription) {
+      [&exec_list, &groups, &group](const rclcpp::SubscriptionBase::SharedPtr & subscription) {
         if (subscription) {
-          exec_list_.add_subscription(subscription);
+          exec_list.add_subscription(subscription);
+          groups.subscription.push_back(group);
         }
         return false;
       });
     group->find_service_ptrs_if(
-      [this](const rclcpp::ServiceBase::SharedPtr & service) {
+      [&exec_list, &groups, &group](const rclcpp::ServiceBase::SharedPtr & service) {
         if (service) {
-          exec_list_.add_service(service);
+          exec_list.add_service(service);
+          groups.service.push_back(group);
         }
         return false;
       });
     group->find_client_ptrs_if(
-      [this](const rclcpp::ClientBase::SharedPtr & client) {
+      [&exec_list, &groups, &group](const rclcpp::ClientBase::SharedPtr & client) {
         if (client) {
-          exec_list_.add_client(client);
+          exec_list.add_client(client);
+          groups.client.push_back(group);
         }
         return false;
       });
     group->find_waitable_ptrs_if(
-      [this](const rclcpp::Waitable::SharedPtr & waitable) {
+      [&exec_list, &groups, &group](const rclcpp::Waitable::SharedPtr & waitable) {
         if (waitable) {
-          exec_list_.add_waitable(waitable);
+          exec_list.add_waitable(waitable);
+          groups.waitable.push_back(group);
         }
         return false;
       });
@@ -221,17 +234,42 @@ StaticExecutorEntitiesCollector::fill_executable_list_from_map(
 void
 StaticExecutorEntitiesCollector::prepare_wait_set()
 {
+  // The size of waitables are accounted for in size of the other entities
+  size_t number_of_subscriptions = exec_list_.number_of_subscriptions;
+  size_t number_of_guard_conditions = memory_strategy_->number_of_guard_conditions();
+  size_t number_of_timers = exec_list_.number_of_timers;
+  size_t number_of_clients = exec_list_.number_of_clients;
+  size_t number_of_services = exec_list_.number_of_services;
+  size_t number_of_events = 0;
+  for (const auto & waitable : exec_list_.waitable) {
+    number_of_subscriptions += waitable->get_number_of_ready_subscriptions();
+    number_of_guard_conditions += waitable->get_number_of_ready_guard_conditions();
+    number_of_timers += waitable->get_number_of_ready_timers();
+    number_of_clients += waitable->get_number_of_ready_clients();
+    number_of_services += waitable->get_number_of_ready_services();
+    number_of_events += waitable->get_number_of_ready_events();
+  }
+  if (
+    p_wait_set_ != nullptr &&
+    p_wait_set_->size_of_subscriptions == number_of_subscriptions &&
+    p_wait_set_->size_of_guard_conditions == number_of_guard_conditions &&
+    p_wait_set_->size_of_timers == number_of_timers &&
+    p_wait_set_->size_of_clients == number_of_clients &&
+    p_wait_set_->size_of_services == number_of_services &&
+    p_wait_set_->size_of_events == number_of_events)
+  {
+    // Nothing to reallocate, refresh_wait_set() clears the wait set anyway.
+    return;
+  }
+
   // clear wait set
   if (rcl_wait_set_clear(p_wait_set_) != RCL_RET_OK) {
     throw std::runtime_error("Couldn't clear wait set");
   }
 
-  // The size of waitables are accounted for in size of the other entities
   rcl_ret_t ret = rcl_wait_set_resize(
-    p_wait_set_, memory_strategy_->number_of_ready_subscriptions(),
-    memory_strategy_->number_of_guard_conditions(), memory_strategy_->number_of_ready_timers(),
-    memory_strategy_->number_of_ready_clients(), memory_strategy_->number_of_ready_services(),
-    memory_strategy_->number_of_ready_events());
+    p_wait_set_, number_of_subscriptions, number_of_guard_conditions, number_of_timers,
+    number_of_clients, number_of_services, number_of_events);
 
   if (RCL_RET_OK != ret) {
     throw std::runtime_error(
@@ -239,16 +277,86 @@ StaticExecutorEntitiesCollector::prepare_wait_set()
   }
 }
 
+namespace
+{
+
+/// Erase the entities of the removed callback groups from the vectors indexed like groups.
+template<typename IsRemovedT, typename ... VectorsT>
+bool
+erase_entities_of_groups(
+  std::vector<rclcpp::CallbackGroup::WeakPtr> & groups,
+  IsRemovedT is_removed,
+  VectorsT & ... entities)
+{
+  size_t kept = 0;
+  for (size_t i = 0; i < groups.size(); ++i) {
+    if (is_removed(groups[i])) {
+      continue;
+    }
+    if (kept != i) {
+      groups[kept] = std::move(groups[i]);
+      ((entities[kept] = std::move(entities[i])), ...);
+    }
+    ++kept;
+  }
+  if (kept == groups.size()) {
+    return false;
+  }
+  groups.resize(kept);
+  (entities.resize(kept), ...);
+  return true;
+}
+
+}  // namespace
+
+bool
+StaticExecutorEntitiesCollector::remove_entities_of_removed_callback_groups()
+{
+  std::set<rclcpp::CallbackGroup::WeakPtr, std::owner_less<rclcpp::CallbackGroup::WeakPtr>>
+  removed_groups;
+  {
+    std::lock_guard<std::mutex> guard{new_nodes_mutex_};
+    if (removed_callback_groups_.empty()) {
+      return false;
+    }
+    removed_groups.insert(removed_callback_groups_.begin(), removed_callback_groups_.end());
+    removed_callback_groups_.clear();
+  }
+  auto is_removed = [&removed_groups](const rclcpp::CallbackGroup::WeakPtr & group) {
+      return removed_groups.count(group) != 0;
+    };
+  bool removed = erase_entities_of_groups(
+    groups_.subscription, is_removed, exec_list_.subscription, exec_list_.subscription_handle);
+  removed |= erase_entities_of_groups(
+    groups_.timer, is_removed, exec_list_.timer, exec_list_.timer_handle);
+  removed |= erase_entities_of_groups(
+    groups_.service, is_removed, exec_list_.service, exec_list_.service_handle);
+  removed |= erase_entities_of_groups(
+    groups_.client, is_removed, exec_list_.client, exec_list_.client_handle);
+  removed |= erase_entities_of_groups(groups_.waitable, is_removed, exec_list_.waitable);
+  exec_list_.number_of_subscriptions = exec_list_.subscription.size();
+  exec_list_.number_of_timers = exec_list_.timer.size();
+  exec_list_.number_of_services = exec_list_.service.size();
+  exec_list_.number_of_clients = exec_list_.client.size();
+  exec_list_.number_of_waitables = exec_list_.waitable.size();
+  return removed;
+}
+
 void
 StaticExecutorEntitiesCollector::refresh_wait_set(std::chrono::nanoseconds timeout)
 {
+  // Removing a callback group drops its entities only, see remove_callback_group_from_map().
+  if (remove_entities_of_removed_callback_groups()) {
+    prepare_wait_set();
+  }
+
   // clear wait set (memset to '0' all wait_set_ entities
   // but keeps the wait_set_ number of entities)
   if (rcl_wait_set_clear(p_wait_set_) != RCL_RET_OK) {
     throw std::runtime_error("Couldn't clear wait set");
   }
 
-  if (!memory_strategy_->add_handles_to_wait_set(p_wait_set_)) {
+  if (!add_handles_to_wait_set()) {
     throw std::runtime_error("Couldn't fill wait set");
   }
 
@@ -263,6 +371,58 @@ StaticExecutorEntitiesCollector::refresh_wait_set(std::chrono::nanoseconds timeo
     using rclcpp::exceptions::throw_from_rcl_error;
     throw_from_rcl_error(status, "rcl_wait() failed");
   }
+  exec_list_.update_ready(*p_wait_set_);
+}
+
+bool
+StaticExecutorEntitiesCollector::add_handles_to_wait_set()
+{
+  // Added first, so that the index of an entity in the wait set is its index in exec_list_.
+  for (const rcl_subscription_t * subscription : exec_list_.subscription_handle) {
+    if (rcl_wait_set_add_subscription(p_wait_set_, subscription, NULL) != RCL_RET_OK) {
+      RCUTILS_LOG_ERROR_NAMED(
+        "rclcpp",
+        "Couldn't add subscription to wait set: %s", rcl_get_error_string().str);
+      return false;
+    }
+  }
+  for (const rcl_timer_t * timer : exec_list_.timer_handle) {
+    if (rcl_wait_set_add_timer(p_wait_set_, timer, NULL) != RCL_RET_OK) {
+      RCUTILS_LOG_ERROR_NAMED(
+        "rclcpp",
+        "Couldn't add timer to wait set: %s", rcl_get_error_string().str);
+      return false;
+    }
+  }
+  for (const rcl_service_t * service : exec_list_.service_handle) {
+    if (rcl_wait_set_add_service(p_wait_set_, service, NULL) != RCL_RET_OK) {
+      RCUTILS_LOG_ERROR_NAMED(
+        "rclcpp",
+        "Couldn't add service to wait set: %s", rcl_get_error_string().str);
+      return false;
+    }
+  }
+  for (const rcl_client_t * client : exec_list_.client_handle) {
+    if (rcl_wait_set_add_client(p_wait_set_, client, NULL) != RCL_RET_OK) {
+      RCUTILS_LOG_ERROR_NAMED(
+        "rclcpp",
+        "Couldn't add client to wait set: %s", rcl_get_error_string().str);
+      return false;
+    }
+  }
+  // Guard conditions of the executor
+  if (!memory_strategy_->add_handles_to_wait_set(p_wait_set_)) {
+    return false;
+  }
+  for (const auto & waitable : exec_list_.waitable) {
+    if (!waitable->add_to_wait_set(p_wait_set_)) {
+      RCUTILS_LOG_ERROR_NAMED(
+        "rclcpp",
+        "Couldn't add waitable to wait set: %s", rcl_get_error_string().str);
+      return false;
+    }
+  }
+  return true;
 }
 
 bool
@@ -292,7 +452,11 @@ StaticExecutorEntitiesCollector::add_node(
   bool is_new_node = false;
   // If the node already has an executor
   std::atomic_bool & has_executor = node_ptr->get_associated_with_executor_atomic();
-  if (has_executor.exchange(true)) {
+  if (
+    has_executor.exchange(true) &&
+    // The node may be held by the executor kept by rclcpp::spin_some(), which gives it up.
+    (!rclcpp::detail::release_spin_executor(node_ptr.get()) || has_executor.exchange(true)))
+  {
     throw std::runtime_error("Node has already been added to an executor.");
   }
   node_ptr->for_each_callback_group(
@@ -321,7 +485,11 @@ StaticExecutorEntitiesCollector::add_callback_group(
 {
   // If the callback_group already has an executor
   std::atomic_bool & has_executor = group_ptr->get_associated_with_executor_atomic();
-  if (has_executor.exchange(true)) {
+  if (
+    has_executor.exchange(true) &&
+    // The group may be held by the executor kept by rclcpp::spin_some(), which gives it up.
+    (!rclcpp::detail::release_spin_executor(node_ptr.get()) || has_executor.exchange(true)))
+  {
     throw std::runtime_error("Callback group has already been added to an executor.");
   }
   bool is_new_node = !has_node(node_ptr, weak_groups_associated_with_executor_to_nodes_) &&
@@ -333,9 +501,23 @@ StaticExecutorEntitiesCollector::add_callback_group(
   if (!was_inserted) {
     throw std::runtime_error("Callback group was already added to executor.");
   }
+  {
+    // A group added back before its removal was applied keeps its entities.
+    std::lock_guard<std::mutex> guard{new_nodes_mutex_};
+    removed_callback_groups_.erase(
+      std::remove_if(
+        removed_callback_groups_.begin(), removed_callback_groups_.end(),
+        [&weak_group_ptr](const rclcpp::CallbackGroup::WeakPtr & removed_group) {
+          return !removed_group.owner_before(weak_group_ptr) &&
+          !weak_group_ptr.owner_before(removed_group);
+        }),
+      removed_callback_groups_.end());
+  }
   if (is_new_node) {
     std::lock_guard<std::mutex> guard{new_nodes_mutex_};
     new_nodes_.push_back(node_ptr);
+    // The entities are collected with the node, whether a trigger of it is pending or not.
+    node_ptr->consume_notify_guard_condition_trigger();
     return true;
   }
   return false;
@@ -375,6 +557,11 @@ StaticExecutorEntitiesCollector::remove_callback_group_from_map(
   } else {
     throw std::runtime_error("Callback group needs to be associated with executor.");
   }
+  {
+    // Dropped by the spinning thread, which may be executing the entities right now.
+    std::lock_guard<std::mutex> guard{new_nodes_mutex_};
+    removed_callback_groups_.push_back(group_ptr);
+  }
   // If the node was matched and removed, interrupt waiting.
   if (!has_node(node_ptr, weak_groups_associated_with_executor_to_nodes_) &&
     !has_node(node_ptr, weak_groups_to_nodes_associated_with_executor_))
@@ -436,6 +623,7 @@ bool
 StaticExecutorEntitiesCollector::is_ready(rcl_wait_set_t * p_wait_set)
 {
   // Check wait_set guard_conditions for added/removed entities to/from a node
+  bool is_ready = false;
   for (size_t i = 0; i < p_wait_set->size_of_guard_conditions; ++i) {
     if (p_wait_set->guard_conditions[i] != NULL) {
       auto found_guard_condition = std::find_if(
@@ -445,12 +633,17 @@ StaticExecutorEntitiesCollector::is_ready(rcl_wait_set_t * p_wait_set)
           return pair.second == p_wait_set->guard_conditions[i];
         });
       if (found_guard_condition != weak_nodes_to_guard_conditions_.end()) {
-        return true;
+        // Consumed before execute() collects the entities, so that no change is missed.
+        auto node_ptr = found_guard_condition->first.lock();
+        if (node_ptr) {
+          node_ptr->consume_notify_guard_condition_trigger();
+        }
+        is_ready = true;
       }
     }
   }
-  // None of the guard conditions triggered belong to a registered node
-  return false;
+  // False if none of the guard conditions triggered belong to a registered node
+  return is_ready;
 }
 
 // Returns true iff the weak_groups_to_nodes map has node_ptr as the value in any of its entry.
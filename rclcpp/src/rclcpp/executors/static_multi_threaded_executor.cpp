@@ -0,0 +1,282 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/executors/static_multi_threaded_executor.hpp"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rcpputils/scope_exit.hpp"
+
+#include "rclcpp/utilities.hpp"
+
+using rclcpp::executors::StaticMultiThreadedExecutor;
+
+namespace
+{
+
+/// Take a mutually exclusive callback group, reentrant groups can always be taken.
+bool
+take_callback_group(const rclcpp::CallbackGroup::SharedPtr & group)
+{
+  return group->type() != rclcpp::CallbackGroupType::MutuallyExclusive ||
+         group->can_be_taken_from().exchange(false);
+}
+
+}  // namespace
+
+StaticMultiThreadedExecutor::StaticMultiThreadedExecutor(
+  const rclcpp::ExecutorOptions & options,
+  size_t number_of_threads,
+  std::chrono::nanoseconds next_exec_timeout)
+: StaticSingleThreadedExecutor(options),
+  next_exec_timeout_(next_exec_timeout)
+{
+  number_of_threads_ = number_of_threads ? number_of_threads : std::thread::hardware_concurrency();
+  if (number_of_threads_ == 0) {
+    number_of_threads_ = 1;
+  }
+}
+
+StaticMultiThreadedExecutor::~StaticMultiThreadedExecutor() {}
+
+void
+StaticMultiThreadedExecutor::spin()
+{
+  if (spinning.exchange(true)) {
+    throw std::runtime_error("spin() called while already spinning");
+  }
+  RCPPUTILS_SCOPE_EXIT(this->spinning.store(false); );
+
+  // Set memory_strategy_ and exec_list_ based on weak_nodes_
+  // Prepare wait_set_ based on memory_strategy_
+  entities_collector_->init(&wait_set_, memory_strategy_);
+
+  std::vector<std::thread> threads;
+  size_t thread_id = 0;
+  {
+    std::lock_guard wait_lock{wait_mutex_};
+    for (; thread_id < number_of_threads_ - 1; ++thread_id) {
+      auto func = std::bind(&StaticMultiThreadedExecutor::run, this, thread_id);
+      threads.emplace_back(func);
+    }
+  }
+
+  run(thread_id);
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  // Release the callback groups of the executables which were queued but not executed
+  ready_executables_.clear();
+}
+
+size_t
+StaticMultiThreadedExecutor::get_number_of_threads()
+{
+  return number_of_threads_;
+}
+
+void
+StaticMultiThreadedExecutor::run(size_t)
+{
+  while (rclcpp::ok(this->context_) && spinning.load()) {
+    rclcpp::AnyExecutable any_exec;
+    {
+      std::lock_guard wait_lock{wait_mutex_};
+      if (!rclcpp::ok(this->context_) || !spinning.load()) {
+        return;
+      }
+      if (!get_next_ready_executable(any_exec)) {
+        continue;
+      }
+    }
+
+    if (spinning.load()) {
+      if (any_exec.timer) {
+        execute_timer(any_exec.timer);
+      }
+      if (any_exec.subscription) {
+        execute_subscription(any_exec.subscription);
+      }
+      if (any_exec.service) {
+        execute_service(any_exec.service);
+      }
+      if (any_exec.client) {
+        execute_client(any_exec.client);
+      }
+      if (any_exec.waitable) {
+        any_exec.waitable->execute(any_exec.data);
+      }
+    }
+    // Release the callback group here, rather than in the AnyExecutable destructor, so that
+    // the release is visible before the waiting thread is notified.
+    any_exec.callback_group->can_be_taken_from().store(true);
+    any_exec.callback_group.reset();
+    notify_group_released();
+  }
+}
+
+bool
+StaticMultiThreadedExecutor::get_next_ready_executable(rclcpp::AnyExecutable & any_exec)
+{
+  if (ready_executables_.empty()) {
+    entities_collector_->refresh_wait_set(next_exec_timeout_);
+    consume_interrupt_guard_condition_trigger();
+    uint64_t released_count;
+    {
+      std::lock_guard<std::mutex> lock(released_mutex_);
+      released_count = released_count_;
+    }
+    bool has_blocked_executables = queue_ready_executables();
+    if (ready_executables_.empty()) {
+      if (has_blocked_executables) {
+        // The blocked executables stay ready in the wait set, so waiting again would return
+        // immediately until their group is released by the thread executing from it.
+        std::unique_lock<std::mutex> lock(released_mutex_);
+        released_cv_.wait(
+          lock, [this, released_count]() {return released_count_ != released_count;});
+      }
+      return false;
+    }
+  }
+  // AnyExecutable is only copyable and its destructor releases the callback group, which now
+  // belongs to any_exec.
+  any_exec = ready_executables_.front();
+  ready_executables_.front().callback_group.reset();
+  ready_executables_.pop_front();
+  return true;
+}
+
+bool
+StaticMultiThreadedExecutor::queue_ready_executables()
+{
+  bool has_blocked_executables = false;
+
+  // The entities of the collector occupy the first slots of the wait set, in the same order.
+  const size_t number_of_subscriptions = entities_collector_->get_number_of_subscriptions();
+  for (size_t i = 0; i < number_of_subscriptions; ++i) {
+    if (!wait_set_.subscriptions[i]) {
+      continue;
+    }
+    auto group = entities_collector_->get_subscription_group(i).lock();
+    if (!group) {
+      continue;
+    }
+    if (!take_callback_group(group)) {
+      has_blocked_executables = true;
+      continue;
+    }
+    ready_executables_.emplace_back();
+    ready_executables_.back().subscription = entities_collector_->get_subscription(i);
+    ready_executables_.back().callback_group = std::move(group);
+  }
+  const size_t number_of_timers = entities_collector_->get_number_of_timers();
+  for (size_t i = 0; i < number_of_timers; ++i) {
+    if (!wait_set_.timers[i]) {
+      continue;
+    }
+    auto timer = entities_collector_->get_timer(i);
+    auto group = entities_collector_->get_timer_group(i).lock();
+    if (!group || !timer->is_ready()) {
+      continue;
+    }
+    if (!take_callback_group(group)) {
+      has_blocked_executables = true;
+      continue;
+    }
+    // Called here, so that the timer is not queued again by the next wait.
+    if (!timer->call()) {
+      group->can_be_taken_from().store(true);
+      continue;
+    }
+    ready_executables_.emplace_back();
+    ready_executables_.back().timer = std::move(timer);
+    ready_executables_.back().callback_group = std::move(group);
+  }
+  const size_t number_of_services = entities_collector_->get_number_of_services();
+  for (size_t i = 0; i < number_of_services; ++i) {
+    if (!wait_set_.services[i]) {
+      continue;
+    }
+    auto group = entities_collector_->get_service_group(i).lock();
+    if (!group) {
+      continue;
+    }
+    if (!take_callback_group(group)) {
+      has_blocked_executables = true;
+      continue;
+    }
+    ready_executables_.emplace_back();
+    ready_executables_.back().service = entities_collector_->get_service(i);
+    ready_executables_.back().callback_group = std::move(group);
+  }
+  const size_t number_of_clients = entities_collector_->get_number_of_clients();
+  for (size_t i = 0; i < number_of_clients; ++i) {
+    if (!wait_set_.clients[i]) {
+      continue;
+    }
+    auto group = entities_collector_->get_client_group(i).lock();
+    if (!group) {
+      continue;
+    }
+    if (!take_callback_group(group)) {
+      has_blocked_executables = true;
+      continue;
+    }
+    ready_executables_.emplace_back();
+    ready_executables_.back().client = entities_collector_->get_client(i);
+    ready_executables_.back().callback_group = std::move(group);
+  }
+  for (size_t i = 0; i < entities_collector_->get_number_of_waitables(); ++i) {
+    auto waitable = entities_collector_->get_waitable(i);
+    if (!waitable->is_ready(&wait_set_)) {
+      continue;
+    }
+    if (waitable == entities_collector_) {
+      // Executed right away, it updates the entities while no other thread is waiting.
+      // It is the last waitable, so the indices of this loop are not affected.
+      auto data = waitable->take_data();
+      waitable->execute(data);
+      continue;
+    }
+    auto group = entities_collector_->get_waitable_group(i).lock();
+    if (!group) {
+      continue;
+    }
+    if (!take_callback_group(group)) {
+      has_blocked_executables = true;
+      continue;
+    }
+    ready_executables_.emplace_back();
+    ready_executables_.back().data = waitable->take_data();
+    ready_executables_.back().waitable = std::move(waitable);
+    ready_executables_.back().callback_group = std::move(group);
+  }
+  return has_blocked_executables;
+}
+
+void
+StaticMultiThreadedExecutor::notify_group_released()
+{
+  {
+    std::lock_guard<std::mutex> lock(released_mutex_);
+    ++released_count_;
+  }
+  released_cv_.notify_one();
+}
@@ -14,7 +14,10 @@
 
 #include "rclcpp/executors/static_single_threaded_executor.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -24,6 +27,37 @@
 using rclcpp::executors::StaticSingleThreadedExecutor;
 using rclcpp::experimental::ExecutableList;
 
+/// Execute an entity, reporting the execution to the instrumentation, if any.
+template<typename ExecuteT>
+static void
+execute_instrumented(
+  rclcpp::ExecutorInstrumentation * instrumentation,
+  const std::atomic<int64_t> & last_wait_end_nanoseconds,
+  rclcpp::ExecutableType type,
+  const void * entity,
+  ExecuteT && execute)
+{
+  if (!instrumentation) {
+    execute();
+    return;
+  }
+  const auto execution_start = std::chrono::steady_clock::now();
+  execute();
+  const auto execution_end = std::chrono::steady_clock::now();
+  rclcpp::ExecutableExecution execution;
+  execution.type = type;
+  execution.entity = entity;
+  // The executable list does not keep the callback groups of the entities.
+  execution.callback_group = nullptr;
+  execution.dispatch_latency = std::max(
+    std::chrono::nanoseconds(0),
+    std::chrono::duration_cast<std::chrono::nanoseconds>(execution_start.time_since_epoch()) -
+    std::chrono::nanoseconds(last_wait_end_nanoseconds.load()));
+  execution.duration =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(execution_end - execution_start);
+  instrumentation->on_execute(execution);
+}
+
 StaticSingleThreadedExecutor::StaticSingleThreadedExecutor(
   const rclcpp::ExecutorOptions & options)
 : rclcpp::Executor(options)
@@ -52,7 +86,8 @@ StaticSingleThreadedExecutor::spin()
 
   while (rclcpp::ok(this->context_) && spinning.load()) {
     // Refresh wait set and wait for work
-    entities_collector_->refresh_wait_set();
+    refresh_wait_set();
+    consume_interrupt_guard_condition_trigger();
     execute_ready_executables();
   }
 }
@@ -105,7 +140,8 @@ StaticSingleThreadedExecutor::spin_some_impl(std::chrono::nanoseconds max_durati
 
   while (rclcpp::ok(context_) && spinning.load() && max_duration_not_elapsed()) {
     // Get executables that are ready now
-    entities_collector_->refresh_wait_set(std::chrono::milliseconds::zero());
+    refresh_wait_set(std::chrono::milliseconds::zero());
+    consume_interrupt_guard_condition_trigger();
     // Execute ready executables
     bool work_available = execute_ready_executables();
     if (!work_available || !exhaustive) {
@@ -124,7 +160,8 @@ StaticSingleThreadedExecutor::spin_once_impl(std::chrono::nanoseconds timeout)
 
   if (rclcpp::ok(context_) && spinning.load()) {
     // Wait until we have a ready entity or timeout expired
-    entities_collector_->refresh_wait_set(timeout);
+    refresh_wait_set(timeout);
+    consume_interrupt_guard_condition_trigger();
     // Execute ready executables
     execute_ready_executables(true);
   }
@@ -139,7 +176,7 @@ StaticSingleThreadedExecutor::add_callback_group(
   bool is_new_node = entities_collector_->add_callback_group(group_ptr, node_ptr);
   if (is_new_node && notify) {
     // Interrupt waiting to handle new node
-    if (rcl_trigger_guard_condition(&interrupt_guard_condition_) != RCL_RET_OK) {
+    if (trigger_interrupt_guard_condition() != RCL_RET_OK) {
       throw std::runtime_error(rcl_get_error_string().str);
     }
   }
@@ -152,7 +189,7 @@ StaticSingleThreadedExecutor::add_node(
   bool is_new_node = entities_collector_->add_node(node_ptr);
   if (is_new_node && notify) {
     // Interrupt waiting to handle new node
-    if (rcl_trigger_guard_condition(&interrupt_guard_condition_) != RCL_RET_OK) {
+    if (trigger_interrupt_guard_condition() != RCL_RET_OK) {
       throw std::runtime_error(rcl_get_error_string().str);
     }
   }
@@ -171,7 +208,7 @@ StaticSingleThreadedExecutor::remove_callback_group(
   bool node_removed = entities_collector_->remove_callback_group(group_ptr);
   // If the node was matched and removed, interrupt waiting
   if (node_removed && notify) {
-    if (rcl_trigger_guard_condition(&interrupt_guard_condition_) != RCL_RET_OK) {
+    if (trigger_interrupt_guard_condition() != RCL_RET_OK) {
       throw std::runtime_error(rcl_get_error_string().str);
     }
   }
@@ -187,7 +224,7 @@ StaticSingleThreadedExecutor::remove_node(
   }
   // If the node was matched and removed, interrupt waiting
   if (notify) {
-    if (rcl_trigger_guard_condition(&interrupt_guard_condition_) != RCL_RET_OK) {
+    if (trigger_interrupt_guard_condition() != RCL_RET_OK) {
       throw std::runtime_error(rcl_get_error_string().str);
     }
   }
@@ -217,67 +254,96 @@ StaticSingleThreadedExecutor::remove_node(std::shared_ptr<rclcpp::Node> node_ptr
   this->remove_node(node_ptr->get_node_base_interface(), notify);
 }
 
+void
+StaticSingleThreadedExecutor::refresh_wait_set(std::chrono::nanoseconds timeout)
+{
+  std::chrono::steady_clock::time_point wait_start;
+  if (instrumentation_) {
+    wait_start = std::chrono::steady_clock::now();
+  }
+  entities_collector_->refresh_wait_set(timeout);
+  if (instrumentation_) {
+    report_wait(wait_start);
+  }
+}
+
 bool
 StaticSingleThreadedExecutor::execute_ready_executables(bool spin_once)
 {
   bool any_ready_executable = false;
 
+  // The entities of the collector occupy the first slots of the wait set, in the same order,
+  // so the ready sets of the executable list directly index the entities to execute.
+  const ExecutableList & exec_list = entities_collector_->get_executable_list();
   // Execute all the ready subscriptions
-  for (size_t i = 0; i < wait_set_.size_of_subscriptions; ++i) {
-    if (i < entities_collector_->get_number_of_subscriptions()) {
-      if (wait_set_.subscriptions[i]) {
-        execute_subscription(entities_collector_->get_subscription(i));
-        if (spin_once) {
-          return true;
-        }
-        any_ready_executable = true;
-      }
+  for (size_t i = ExecutableList::next_ready(exec_list.subscription_ready, 0);
+    i != ExecutableList::npos;
+    i = ExecutableList::next_ready(exec_list.subscription_ready, i + 1))
+  {
+    const auto & subscription = exec_list.subscription[i];
+    execute_instrumented(
+      instrumentation_.get(), last_wait_end_nanoseconds_, rclcpp::ExecutableType::Subscription,
+      subscription.get(), [&subscription]() {execute_subscription(subscription);});
+    if (spin_once) {
+      return true;
     }
+    any_ready_executable = true;
   }
   // Execute all the ready timers
-  for (size_t i = 0; i < wait_set_.size_of_timers; ++i) {
-    if (i < entities_collector_->get_number_of_timers()) {
-      if (wait_set_.timers[i] && entities_collector_->get_timer(i)->is_ready()) {
-        auto timer = entities_collector_->get_timer(i);
-        timer->call();
-        execute_timer(std::move(timer));
-        if (spin_once) {
-          return true;
-        }
-        any_ready_executable = true;
+  for (size_t i = ExecutableList::next_ready(exec_list.timer_ready, 0);
+    i != ExecutableList::npos;
+    i = ExecutableList::next_ready(exec_list.timer_ready, i + 1))
+  {
+    const auto & timer = exec_list.timer[i];
+    if (timer->is_ready()) {
+      timer->call();
+      execute_instrumented(
+        instrumentation_.get(), last_wait_end_nanoseconds_, rclcpp::ExecutableType::Timer,
+        timer.get(), [&timer]() {execute_timer(timer);});
+      if (spin_once) {
+        return true;
       }
+      any_ready_executable = true;
     }
   }
   // Execute all the ready services
-  for (size_t i = 0; i < wait_set_.size_of_services; ++i) {
-    if (i < entities_collector_->get_number_of_services()) {
-      if (wait_set_.services[i]) {
-        execute_service(entities_collector_->get_service(i));
-        if (spin_once) {
-          return true;
-        }
-        any_ready_executable = true;
-      }
+  for (size_t i = ExecutableList::next_ready(exec_list.service_ready, 0);
+    i != ExecutableList::npos;
+    i = ExecutableList::next_ready(exec_list.service_ready, i + 1))
+  {
+    const auto & service = exec_list.service[i];
+    execute_instrumented(
+      instrumentation_.get(), last_wait_end_nanoseconds_, rclcpp::ExecutableType::Service,
+      service.get(), [&service]() {execute_service(service);});
+    if (spin_once) {
+      return true;
     }
+    any_ready_executable = true;
   }
   // Execute all the ready clients
-  for (size_t i = 0; i < wait_set_.size_of_clients; ++i) {
-    if (i < entities_collector_->get_number_of_clients()) {
-      if (wait_set_.clients[i]) {
-        execute_client(entities_collector_->get_client(i));
-        if (spin_once) {
-          return true;
-        }
-        any_ready_executable = true;
-      }
+  for (size_t i = ExecutableList::next_ready(exec_list.client_ready, 0);
+    i != ExecutableList::npos;
+    i = ExecutableList::next_ready(exec_list.client_ready, i + 1))
+  {
+    const auto & client = exec_list.client[i];
+    execute_instrumented(
+      instrumentation_.get(), last_wait_end_nanoseconds_, rclcpp::ExecutableType::Client,
+      client.get(), [&client]() {execute_client(client);});
+    if (spin_once) {
+      return true;
     }
+    any_ready_executable = true;
   }
   // Execute all the ready waitables
   for (size_t i = 0; i < entities_collector_->get_number_of_waitables(); ++i) {
     auto waitable = entities_collector_->get_waitable(i);
     if (waitable->is_ready(&wait_set_)) {
-      auto data = waitable->take_data();
-      waitable->execute(data);
+      execute_instrumented(
+        instrumentation_.get(), last_wait_end_nanoseconds_, rclcpp::ExecutableType::Waitable,
+        waitable.get(), [&waitable]() {
+          auto data = waitable->take_data();
+          waitable->execute(data);
+        });
       if (spin_once) {
         return true;
       }
@@ -0,0 +1,354 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/executors/thread_affinity_executor.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rcpputils/scope_exit.hpp"
+
+#include "rclcpp/utilities.hpp"
+
+using rclcpp::executors::ThreadAffinityExecutor;
+
+namespace
+{
+
+#ifdef __linux__
+// MPOL_PREFERRED from linux/mempolicy.h, set_mempolicy() is called directly to not depend on
+// libnuma.
+constexpr int kMpolPreferred = 1;
+
+/// Parse a sysfs list such as "0-3,8,10-11", return an empty list on failure.
+std::vector<size_t>
+read_sysfs_list(const std::string & path)
+{
+  std::ifstream file(path);
+  std::string line;
+  if (!file || !std::getline(file, line)) {
+    return {};
+  }
+  std::vector<size_t> values;
+  std::istringstream ranges(line);
+  std::string range;
+  while (std::getline(ranges, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    try {
+      const auto dash = range.find('-');
+      const size_t first = std::stoul(range.substr(0, dash));
+      const size_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+      for (size_t value = first; value <= last; ++value) {
+        values.push_back(value);
+      }
+    } catch (const std::logic_error &) {
+      return {};
+    }
+  }
+  return values;
+}
+#endif
+
+}  // namespace
+
+ThreadAffinityExecutor::ThreadAffinityExecutor(
+  const rclcpp::ExecutorOptions & options,
+  std::vector<WorkerOptions> workers)
+: rclcpp::Executor(options),
+  worker_options_(std::move(workers))
+{
+  worker_executors_.reserve(worker_options_.size());
+  for (size_t i = 0; i < worker_options_.size(); ++i) {
+    // Every worker needs its own memory strategy, only the context and policy are shared.
+    rclcpp::ExecutorOptions worker_executor_options;
+    worker_executor_options.context = options.context;
+    worker_executor_options.scheduling_policy = options.scheduling_policy;
+    worker_executors_.emplace_back(
+      std::make_unique<rclcpp::executors::SingleThreadedExecutor>(worker_executor_options));
+  }
+}
+
+ThreadAffinityExecutor::~ThreadAffinityExecutor() {}
+
+std::vector<std::vector<size_t>>
+ThreadAffinityExecutor::get_numa_node_cpus()
+{
+  std::vector<std::vector<size_t>> numa_node_cpus;
+#ifdef __linux__
+  for (size_t numa_node : read_sysfs_list("/sys/devices/system/node/online")) {
+    if (numa_node_cpus.size() <= numa_node) {
+      numa_node_cpus.resize(numa_node + 1);
+    }
+    numa_node_cpus[numa_node] = read_sysfs_list(
+      "/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+  }
+#endif
+  bool has_cpus = false;
+  for (const auto & cpus : numa_node_cpus) {
+    has_cpus |= !cpus.empty();
+  }
+  if (!has_cpus) {
+    std::vector<size_t> cpus(std::max(1u, std::thread::hardware_concurrency()));
+    for (size_t cpu = 0; cpu < cpus.size(); ++cpu) {
+      cpus[cpu] = cpu;
+    }
+    numa_node_cpus.assign(1, std::move(cpus));
+  }
+  return numa_node_cpus;
+}
+
+std::vector<ThreadAffinityExecutor::WorkerOptions>
+ThreadAffinityExecutor::make_numa_worker_options(
+  size_t threads_per_numa_node,
+  bool prefer_numa_node_memory)
+{
+  const auto numa_node_cpus = get_numa_node_cpus();
+  std::vector<WorkerOptions> workers;
+  workers.reserve(numa_node_cpus.size() * threads_per_numa_node);
+  for (size_t numa_node = 0; numa_node < numa_node_cpus.size(); ++numa_node) {
+    WorkerOptions worker;
+    // Nodes without CPUs, e.g. memory only nodes, still get workers to keep the indices
+    // predictable, they are not pinned.
+    worker.numa_node = static_cast<int>(numa_node);
+#ifdef __linux__
+    worker.cpu_affinity = numa_node_cpus[numa_node];
+    worker.prefer_numa_node_memory = prefer_numa_node_memory;
+#else
+    // Elsewhere the workers can neither be pinned nor bound, they only form the pool.
+    (void)prefer_numa_node_memory;
+#endif
+    workers.insert(workers.end(), threads_per_numa_node, worker);
+  }
+  return workers;
+}
+
+void
+ThreadAffinityExecutor::add_callback_group_to_worker(
+  rclcpp::CallbackGroup::SharedPtr group_ptr,
+  rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr,
+  size_t worker_index,
+  bool notify)
+{
+  if (worker_index >= worker_executors_.size()) {
+    throw std::out_of_range("worker index " + std::to_string(worker_index) + " out of range");
+  }
+  std::lock_guard<std::mutex> guard{mutex_};
+  // Hand the group over from this executor while holding the lock, so it is not added back
+  // automatically together with the other groups of its node in the meantime.
+  rclcpp::CallbackGroup::WeakPtr weak_group_ptr = group_ptr;
+  if (weak_groups_associated_with_executor_to_nodes_.count(weak_group_ptr) != 0) {
+    remove_callback_group_from_map(
+      group_ptr, weak_groups_associated_with_executor_to_nodes_, notify);
+  } else if (weak_groups_to_nodes_associated_with_executor_.count(weak_group_ptr) != 0) {
+    remove_callback_group_from_map(
+      group_ptr, weak_groups_to_nodes_associated_with_executor_, notify);
+  }
+  worker_executors_[worker_index]->add_callback_group(group_ptr, node_ptr, notify);
+}
+
+size_t
+ThreadAffinityExecutor::add_callback_group_to_numa_node(
+  rclcpp::CallbackGroup::SharedPtr group_ptr,
+  rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_ptr,
+  int numa_node,
+  bool notify)
+{
+  size_t worker_index = worker_executors_.size();
+  size_t worker_load = std::numeric_limits<size_t>::max();
+  for (size_t i = 0; i < worker_executors_.size(); ++i) {
+    if (worker_options_[i].numa_node != numa_node) {
+      continue;
+    }
+    const size_t load = worker_executors_[i]->get_all_callback_groups().size();
+    if (load < worker_load) {
+      worker_index = i;
+      worker_load = load;
+    }
+  }
+  if (worker_index == worker_executors_.size()) {
+    throw std::out_of_range("no worker on NUMA node " + std::to_string(numa_node));
+  }
+  add_callback_group_to_worker(group_ptr, node_ptr, worker_index, notify);
+  return worker_index;
+}
+
+void
+ThreadAffinityExecutor::remove_callback_group_from_worker(
+  rclcpp::CallbackGroup::SharedPtr group_ptr,
+  size_t worker_index,
+  bool notify)
+{
+  if (worker_index >= worker_executors_.size()) {
+    throw std::out_of_range("worker index " + std::to_string(worker_index) + " out of range");
+  }
+  worker_executors_[worker_index]->remove_callback_group(group_ptr, notify);
+}
+
+void
+ThreadAffinityExecutor::spin()
+{
+  if (spinning.exchange(true)) {
+    throw std::runtime_error("spin() called while already spinning");
+  }
+  RCPPUTILS_SCOPE_EXIT(this->spinning.store(false); );
+
+  std::vector<std::thread> threads;
+  std::vector<std::future<void>> workers_started;
+  threads.reserve(worker_executors_.size());
+  workers_started.reserve(worker_executors_.size());
+  for (size_t worker_index = 0; worker_index < worker_executors_.size(); ++worker_index) {
+    std::promise<void> worker_started;
+    workers_started.emplace_back(worker_started.get_future());
+    threads.emplace_back(
+      [this, worker_index, worker_started = std::move(worker_started)]() mutable {
+        try {
+          apply_worker_options(worker_options_[worker_index]);
+        } catch (...) {
+          worker_started.set_exception(std::current_exception());
+          return;
+        }
+        worker_started.set_value();
+        run_worker(worker_index);
+      });
+  }
+
+  std::exception_ptr error;
+  for (auto & worker_started : workers_started) {
+    try {
+      worker_started.get();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+
+  if (!error) {
+    try {
+      while (rclcpp::ok(this->context_) && spinning.load()) {
+        rclcpp::AnyExecutable any_executable;
+        if (get_next_executable(any_executable)) {
+          execute_any_executable(any_executable);
+        }
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+  }
+
+  // Stop the workers, they check spinning between two executables.
+  spinning.store(false);
+  for (auto & worker_executor : worker_executors_) {
+    worker_executor->cancel();
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+size_t
+ThreadAffinityExecutor::get_number_of_workers() const
+{
+  return worker_executors_.size();
+}
+
+void
+ThreadAffinityExecutor::apply_worker_options(const WorkerOptions & options)
+{
+#ifdef __linux__
+  if (!options.cpu_affinity.empty()) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (size_t cpu : options.cpu_affinity) {
+      if (cpu >= CPU_SETSIZE) {
+        throw std::invalid_argument("cpu " + std::to_string(cpu) + " out of range");
+      }
+      CPU_SET(cpu, &cpu_set);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (ret != 0) {
+      throw std::system_error(
+              ret, std::generic_category(), "failed to set cpu affinity of executor worker");
+    }
+  }
+  if (options.sched_fifo_priority > 0) {
+    sched_param param{};
+    param.sched_priority = options.sched_fifo_priority;
+    int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (ret != 0) {
+      throw std::system_error(
+              ret, std::generic_category(), "failed to set SCHED_FIFO priority of executor worker");
+    }
+  }
+  if (options.prefer_numa_node_memory && options.numa_node >= 0) {
+    constexpr size_t bits_per_word = std::numeric_limits<unsigned long>::digits;  // NOLINT
+    std::vector<unsigned long> node_mask(  // NOLINT
+      static_cast<size_t>(options.numa_node) / bits_per_word + 1, 0ul);
+    node_mask.back() |= 1ul << (static_cast<size_t>(options.numa_node) % bits_per_word);
+    // The mask size passed to the kernel is one more than the number of bits, see
+    // set_mempolicy(2).
+    const long ret = syscall(  // NOLINT
+      SYS_set_mempolicy, kMpolPreferred, node_mask.data(),
+      node_mask.size() * bits_per_word + 1);
+    if (ret != 0) {
+      throw std::system_error(
+              errno, std::generic_category(), "failed to set memory policy of executor worker");
+    }
+  }
+#else
+  if (!options.cpu_affinity.empty() || options.sched_fifo_priority > 0 ||
+    options.prefer_numa_node_memory)
+  {
+    throw std::runtime_error(
+            "cpu affinity, priority and memory policy of executor workers are only supported on "
+            "Linux");
+  }
+#endif
+}
+
+void
+ThreadAffinityExecutor::run_worker(size_t worker_index)
+{
+  auto & worker_executor = worker_executors_[worker_index];
+  // spin_once() instead of spin(), since a cancel() before the worker started spinning
+  // would otherwise be lost.
+  while (rclcpp::ok(this->context_) && spinning.load()) {
+    worker_executor->spin_once();
+  }
+}
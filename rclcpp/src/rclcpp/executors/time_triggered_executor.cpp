@@ -0,0 +1,174 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/executors/time_triggered_executor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "rcpputils/scope_exit.hpp"
+
+#include "rclcpp/duration.hpp"
+#include "rclcpp/memory_strategies.hpp"
+#include "rclcpp/time.hpp"
+#include "rclcpp/utilities.hpp"
+
+using rclcpp::executors::TimeTriggeredExecutor;
+
+TimeTriggeredExecutor::TimeTriggeredExecutor(
+  std::chrono::nanoseconds cycle_period,
+  rclcpp::Clock::SharedPtr clock,
+  const rclcpp::ExecutorOptions & options)
+: rclcpp::Executor(options),
+  cycle_period_(cycle_period),
+  clock_(std::move(clock)),
+  options_(options)
+{
+  if (cycle_period_ <= std::chrono::nanoseconds(0)) {
+    throw std::invalid_argument("the cycle period of a time triggered executor must be positive");
+  }
+  if (!clock_) {
+    throw std::invalid_argument("the clock of a time triggered executor must not be nullptr");
+  }
+}
+
+TimeTriggeredExecutor::~TimeTriggeredExecutor() = default;
+
+size_t
+TimeTriggeredExecutor::add_slot(
+  rclcpp::CallbackGroup::SharedPtr group,
+  rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node,
+  std::chrono::nanoseconds offset,
+  std::chrono::nanoseconds duration)
+{
+  std::lock_guard<std::mutex> lock(slots_mutex_);
+  if (spinning.load()) {
+    throw std::runtime_error("add_slot() called while spinning");
+  }
+  if (offset < std::chrono::nanoseconds(0) || duration <= std::chrono::nanoseconds(0) ||
+    offset + duration > cycle_period_)
+  {
+    throw std::invalid_argument("a slot must have a positive duration and end within the cycle");
+  }
+  if (!slots_.empty() && offset < slots_.back().offset + slots_.back().duration) {
+    throw std::invalid_argument("a slot must start after the end of the previous slot");
+  }
+
+  auto it = std::find_if(
+    group_executors_.begin(), group_executors_.end(),
+    [&group](const auto & pair) {return pair.first.lock() == group;});
+  if (it == group_executors_.end()) {
+    // Every executor needs its own memory strategy, the other options are shared.
+    rclcpp::ExecutorOptions group_options = options_;
+    group_options.memory_strategy = rclcpp::memory_strategies::create_default_strategy();
+    auto executor = std::make_unique<StaticSingleThreadedExecutor>(group_options);
+    executor->add_callback_group(group, node);
+    group_executors_.emplace_back(group, std::move(executor));
+    it = std::prev(group_executors_.end());
+  }
+  slots_.push_back(Slot{offset, duration, it->second.get()});
+  return slots_.size() - 1;
+}
+
+void
+TimeTriggeredExecutor::set_overrun_callback(OverrunCallback callback)
+{
+  std::lock_guard<std::mutex> lock(slots_mutex_);
+  overrun_callback_ = std::move(callback);
+}
+
+uint64_t
+TimeTriggeredExecutor::get_overrun_count() const
+{
+  return overrun_count_.load();
+}
+
+void
+TimeTriggeredExecutor::spin()
+{
+  if (spinning.exchange(true)) {
+    throw std::runtime_error("spin() called while already spinning");
+  }
+  RCPPUTILS_SCOPE_EXIT(this->spinning.store(false); );
+
+  std::vector<Slot> slots;
+  OverrunCallback overrun_callback;
+  {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    slots = slots_;
+    overrun_callback = overrun_callback_;
+  }
+
+  const rclcpp::Time start = clock_->now();
+  uint64_t cycle = 0;
+  while (rclcpp::ok(this->context_) && spinning.load()) {
+    const rclcpp::Time cycle_start =
+      start + rclcpp::Duration(cycle_period_ * static_cast<int64_t>(cycle));
+    for (size_t slot_index = 0; slot_index < slots.size(); ++slot_index) {
+      if (!rclcpp::ok(this->context_) || !spinning.load()) {
+        return;
+      }
+      const Slot & slot = slots[slot_index];
+      const rclcpp::Time slot_start = cycle_start + rclcpp::Duration(slot.offset);
+      if (clock_->now() < slot_start && !clock_->sleep_until(slot_start, this->context_)) {
+        return;
+      }
+      // The entities ready at the start of the slot are executed once.
+      slot.executor->spin_some();
+      const rclcpp::Duration lateness =
+        clock_->now() - (slot_start + rclcpp::Duration(slot.duration));
+      if (lateness > rclcpp::Duration(0, 0)) {
+        ++overrun_count_;
+        if (overrun_callback) {
+          overrun_callback(
+            Overrun{slot_index, cycle, lateness.to_chrono<std::chrono::nanoseconds>()});
+        }
+      }
+    }
+    ++cycle;
+    // Skip to the next cycle if a whole cycle was missed.
+    const int64_t elapsed = (clock_->now() - start).nanoseconds();
+    const uint64_t current_cycle = static_cast<uint64_t>(elapsed / cycle_period_.count());
+    if (current_cycle > cycle) {
+      cycle = current_cycle + 1;
+    }
+  }
+}
+
+void
+TimeTriggeredExecutor::add_callback_group(
+  rclcpp::CallbackGroup::SharedPtr,
+  rclcpp::node_interfaces::NodeBaseInterface::SharedPtr,
+  bool)
+{
+  throw std::runtime_error("the callback groups of a TimeTriggeredExecutor are added by slot");
+}
+
+void
+TimeTriggeredExecutor::add_node(
+  rclcpp::node_interfaces::NodeBaseInterface::SharedPtr, bool)
+{
+  throw std::runtime_error("the callback groups of a TimeTriggeredExecutor are added by slot");
+}
+
+void
+TimeTriggeredExecutor::add_node(std::shared_ptr<rclcpp::Node>, bool)
+{
+  throw std::runtime_error("the callback groups of a TimeTriggeredExecutor are added by slot");
+}
@@ -0,0 +1,179 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/executors/work_stealing_multi_threaded_executor.hpp"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "rcpputils/scope_exit.hpp"
+
+#include "rclcpp/utilities.hpp"
+
+using rclcpp::executors::WorkStealingMultiThreadedExecutor;
+
+WorkStealingMultiThreadedExecutor::WorkStealingMultiThreadedExecutor(
+  const rclcpp::ExecutorOptions & options,
+  size_t number_of_threads,
+  size_t max_batch_size,
+  std::chrono::nanoseconds next_exec_timeout)
+: rclcpp::Executor(options),
+  next_exec_timeout_(next_exec_timeout)
+{
+  number_of_threads_ = number_of_threads ? number_of_threads : std::thread::hardware_concurrency();
+  if (number_of_threads_ == 0) {
+    number_of_threads_ = 1;
+  }
+  max_batch_size_ = max_batch_size ? max_batch_size : 4 * number_of_threads_;
+  ready_queues_.reserve(number_of_threads_);
+  for (size_t i = 0; i < number_of_threads_; ++i) {
+    ready_queues_.emplace_back(std::make_unique<ReadyQueue>());
+  }
+}
+
+WorkStealingMultiThreadedExecutor::~WorkStealingMultiThreadedExecutor()
+{
+  clear_ready_queues();
+}
+
+void
+WorkStealingMultiThreadedExecutor::spin()
+{
+  if (spinning.exchange(true)) {
+    throw std::runtime_error("spin() called while already spinning");
+  }
+  RCPPUTILS_SCOPE_EXIT(this->clear_ready_queues(); this->spinning.store(false); );
+  std::vector<std::thread> threads;
+  size_t thread_id = 0;
+  {
+    std::lock_guard wait_lock{wait_mutex_};
+    for (; thread_id < number_of_threads_ - 1; ++thread_id) {
+      auto func = std::bind(&WorkStealingMultiThreadedExecutor::run, this, thread_id);
+      threads.emplace_back(func);
+    }
+  }
+
+  run(thread_id);
+  for (auto & thread : threads) {
+    thread.join();
+  }
+}
+
+size_t
+WorkStealingMultiThreadedExecutor::get_number_of_threads()
+{
+  return number_of_threads_;
+}
+
+size_t
+WorkStealingMultiThreadedExecutor::get_max_batch_size()
+{
+  return max_batch_size_;
+}
+
+void
+WorkStealingMultiThreadedExecutor::run(size_t this_thread_number)
+{
+  while (rclcpp::ok(this->context_) && spinning.load()) {
+    std::unique_ptr<rclcpp::AnyExecutable> any_exec;
+    if (!take_ready_executable(this_thread_number, any_exec)) {
+      std::lock_guard wait_lock{wait_mutex_};
+      if (!rclcpp::ok(this->context_) || !spinning.load()) {
+        return;
+      }
+      // Another thread may have refilled the queues while this one was waiting for the lock.
+      if (!take_ready_executable(this_thread_number, any_exec)) {
+        refill_ready_queues(this_thread_number);
+        continue;
+      }
+    }
+
+    execute_any_executable(*any_exec);
+
+    // Clear the callback_group to prevent the AnyExecutable destructor from
+    // resetting the callback group `can_be_taken_from`
+    any_exec->callback_group.reset();
+  }
+}
+
+bool
+WorkStealingMultiThreadedExecutor::take_ready_executable(
+  size_t this_thread_number,
+  std::unique_ptr<rclcpp::AnyExecutable> & any_exec)
+{
+  {
+    ReadyQueue & own_queue = *ready_queues_[this_thread_number];
+    std::lock_guard<std::mutex> lock(own_queue.mutex);
+    if (!own_queue.executables.empty()) {
+      any_exec = std::move(own_queue.executables.front());
+      own_queue.executables.pop_front();
+      return true;
+    }
+  }
+  // Steal from the opposite end of the other queues to stay away from their owners.
+  for (size_t offset = 1; offset < number_of_threads_; ++offset) {
+    ReadyQueue & victim = *ready_queues_[(this_thread_number + offset) % number_of_threads_];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.executables.empty()) {
+      any_exec = std::move(victim.executables.back());
+      victim.executables.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t
+WorkStealingMultiThreadedExecutor::refill_ready_queues(size_t this_thread_number)
+{
+  size_t batch_size = 0;
+  bool waited = false;
+  auto any_exec = std::make_unique<rclcpp::AnyExecutable>();
+  while (batch_size < max_batch_size_ && spinning.load()) {
+    if (!get_next_ready_executable(*any_exec)) {
+      if (any_exec->callback_group) {
+        // A partially filled executable was rejected, start over with a clean one.
+        any_exec = std::make_unique<rclcpp::AnyExecutable>();
+      }
+      // Only block if nothing at all was ready, otherwise hand out what was found.
+      if (batch_size > 0 || waited) {
+        break;
+      }
+      wait_for_work(next_exec_timeout_);
+      waited = true;
+      continue;
+    }
+    ReadyQueue & queue = *ready_queues_[(this_thread_number + batch_size) % number_of_threads_];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.executables.push_back(std::move(any_exec));
+    }
+    ++batch_size;
+    any_exec = std::make_unique<rclcpp::AnyExecutable>();
+  }
+  return batch_size;
+}
+
+void
+WorkStealingMultiThreadedExecutor::clear_ready_queues()
+{
+  for (auto & queue : ready_queues_) {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    // Destroying the queued executables marks their callback groups as available again.
+    queue->executables.clear();
+  }
+}
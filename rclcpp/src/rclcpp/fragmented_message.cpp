@@ -0,0 +1,238 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/fragmented_message.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace rclcpp
+{
+
+namespace
+{
+
+// The header of a fragment is the magic number, then the identifier of the message, the size
+// of the message and the offset of the fragment in it, each on 8 bytes in little endian.
+constexpr uint8_t kMagic[] = {'R', 'C', 'F', 1};
+static_assert(
+  sizeof(kMagic) + 3 * sizeof(uint64_t) == FragmentedPublisher::header_size,
+  "the header size must match its fields");
+
+uint8_t *
+write_uint64(uint8_t * buffer, uint64_t value)
+{
+  for (size_t i = 0; i < sizeof(value); ++i) {
+    *buffer++ = static_cast<uint8_t>(value >> (8 * i));
+  }
+  return buffer;
+}
+
+const uint8_t *
+read_uint64(const uint8_t * buffer, uint64_t & value)
+{
+  value = 0;
+  for (size_t i = 0; i < sizeof(value); ++i) {
+    value |= static_cast<uint64_t>(*buffer++) << (8 * i);
+  }
+  return buffer;
+}
+
+}  // namespace
+
+FragmentedPublisher::FragmentedPublisher(
+  rclcpp::GenericPublisher::SharedPtr publisher, size_t fragment_size)
+: publisher_(std::move(publisher))
+{
+  if (!publisher_) {
+    throw std::invalid_argument("the publisher of the fragments must not be nullptr");
+  }
+  if (fragment_size <= header_size) {
+    throw std::invalid_argument("the fragment size must be larger than the fragment header");
+  }
+  fragment_.resize(fragment_size);
+  // The identifiers of the publishers of a topic start at random, so that they do not collide.
+  std::random_device random_device;
+  next_message_id_ = (static_cast<uint64_t>(random_device()) << 32) | random_device();
+}
+
+void
+FragmentedPublisher::publish(const rclcpp::SerializedMessage & message)
+{
+  const auto & rcl_message = message.get_rcl_serialized_message();
+  size_t offset = 0;
+  publish(
+    rcl_message.buffer_length,
+    [&rcl_message, &offset](uint8_t * buffer, size_t size) {
+      std::memcpy(buffer, rcl_message.buffer + offset, size);
+      offset += size;
+      return size;
+    });
+}
+
+void
+FragmentedPublisher::publish(size_t size, const Source & source)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint64_t message_id = next_message_id_++;
+  size_t offset = 0;
+  // An empty message is published as one empty fragment.
+  do {
+    const size_t fragment_data_size = std::min(fragment_.size() - header_size, size - offset);
+    uint8_t * data = fragment_.data();
+    std::memcpy(data, kMagic, sizeof(kMagic));
+    data = write_uint64(data + sizeof(kMagic), message_id);
+    data = write_uint64(data, size);
+    data = write_uint64(data, offset);
+    size_t written = 0;
+    while (written < fragment_data_size) {
+      const size_t source_size = source(data + written, fragment_data_size - written);
+      if (0 == source_size) {
+        throw std::runtime_error("the source of a fragmented message ended before its size");
+      }
+      written += source_size;
+    }
+    // The fragment is only borrowed, it is copied if there are intra-process subscriptions.
+    publisher_->publish(fragment_.data(), header_size + fragment_data_size);
+    offset += fragment_data_size;
+  } while (offset < size);
+}
+
+FragmentReassembler::FragmentReassembler(
+  MessageCallback callback, size_t max_message_size, size_t max_pending_messages)
+: message_callback_(std::move(callback)),
+  max_message_size_(max_message_size),
+  max_pending_messages_(max_pending_messages)
+{
+  if (0 == max_pending_messages_) {
+    throw std::invalid_argument("the maximum number of pending messages must not be 0");
+  }
+}
+
+FragmentReassembler::FragmentReassembler(StreamCallback callback, size_t max_pending_messages)
+: stream_callback_(std::move(callback)),
+  max_message_size_(SIZE_MAX),
+  max_pending_messages_(max_pending_messages)
+{
+  if (0 == max_pending_messages_) {
+    throw std::invalid_argument("the maximum number of pending messages must not be 0");
+  }
+}
+
+bool
+FragmentReassembler::add_fragment(const rclcpp::SerializedMessage & fragment)
+{
+  FragmentInfo info;
+  const uint8_t * data = nullptr;
+  size_t size = 0;
+  if (!parse_fragment(fragment, info, data, size)) {
+    return false;
+  }
+
+  auto pending = std::find_if(
+    pending_messages_.begin(), pending_messages_.end(),
+    [&info](const PendingMessage & message) {return message.id == info.message_id;});
+  if (pending == pending_messages_.end()) {
+    if (0 != info.offset) {
+      // The first fragments of the message were missed.
+      return false;
+    }
+    if (info.message_size > max_message_size_) {
+      ++dropped_message_count_;
+      return false;
+    }
+    if (pending_messages_.size() == max_pending_messages_) {
+      pending_messages_.pop_front();
+      ++dropped_message_count_;
+    }
+    PendingMessage message{info.message_id, info.message_size, 0, nullptr};
+    if (message_callback_) {
+      message.message = std::make_shared<rclcpp::SerializedMessage>(info.message_size);
+    }
+    pending_messages_.push_back(std::move(message));
+    pending = std::prev(pending_messages_.end());
+  } else if (pending->next_offset != info.offset || pending->size != info.message_size) {
+    pending_messages_.erase(pending);
+    ++dropped_message_count_;
+    return false;
+  }
+
+  if (pending->message && size > 0) {
+    auto & rcl_message = pending->message->get_rcl_serialized_message();
+    std::memcpy(rcl_message.buffer + info.offset, data, size);
+    rcl_message.buffer_length = info.offset + size;
+  }
+  pending->next_offset += size;
+  if (pending->next_offset < pending->size) {
+    if (stream_callback_) {
+      stream_callback_(info, data, size);
+    }
+    return true;
+  }
+
+  auto message = std::move(pending->message);
+  pending_messages_.erase(pending);
+  if (stream_callback_) {
+    stream_callback_(info, data, size);
+  } else {
+    message_callback_(std::move(message));
+  }
+  return true;
+}
+
+size_t
+FragmentReassembler::get_dropped_message_count() const
+{
+  return dropped_message_count_;
+}
+
+bool
+FragmentReassembler::parse_fragment(
+  const rclcpp::SerializedMessage & fragment,
+  FragmentInfo & info,
+  const uint8_t * & data,
+  size_t & size)
+{
+  const auto & rcl_fragment = fragment.get_rcl_serialized_message();
+  if (rcl_fragment.buffer_length < FragmentedPublisher::header_size ||
+    0 != std::memcmp(rcl_fragment.buffer, kMagic, sizeof(kMagic)))
+  {
+    return false;
+  }
+  uint64_t message_id = 0;
+  uint64_t message_size = 0;
+  uint64_t offset = 0;
+  const uint8_t * header = rcl_fragment.buffer + sizeof(kMagic);
+  header = read_uint64(header, message_id);
+  header = read_uint64(header, message_size);
+  header = read_uint64(header, offset);
+  size = rcl_fragment.buffer_length - FragmentedPublisher::header_size;
+  if (offset > message_size || size > message_size - offset) {
+    return false;
+  }
+  info.message_id = message_id;
+  info.message_size = static_cast<size_t>(message_size);
+  info.offset = static_cast<size_t>(offset);
+  data = header;
+  return true;
+}
+
+}  // namespace rclcpp
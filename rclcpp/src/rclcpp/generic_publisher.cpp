@@ -16,19 +16,167 @@
 #include "rclcpp/generic_publisher.hpp"
 
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <utility>
 
 namespace rclcpp
 {
 
 void GenericPublisher::publish(const rclcpp::SerializedMessage & message)
 {
+  if (!intra_process_is_enabled_) {
+    do_inter_process_publish(message);
+    return;
+  }
+  bool inter_process_publish_needed =
+    get_subscription_count() > get_intra_process_subscription_count();
+
+  if (get_intra_process_subscription_count() > 0) {
+    do_intra_process_publish(std::make_unique<rclcpp::SerializedMessage>(message));
+  }
+  if (inter_process_publish_needed) {
+    do_inter_process_publish(message);
+  }
+}
+
+void GenericPublisher::publish(std::unique_ptr<rclcpp::SerializedMessage> message)
+{
+  if (!message) {
+    throw std::runtime_error("cannot publish msg which is a null pointer");
+  }
+  if (!intra_process_is_enabled_) {
+    do_inter_process_publish(*message);
+    return;
+  }
+  bool inter_process_publish_needed =
+    get_subscription_count() > get_intra_process_subscription_count();
+
+  if (inter_process_publish_needed) {
+    auto shared_message = do_intra_process_publish_and_return_shared(std::move(message));
+    do_inter_process_publish(*shared_message);
+  } else {
+    do_intra_process_publish(std::move(message));
+  }
+}
+
+void GenericPublisher::publish(rclcpp::SerializedMessage && message)
+{
+  if (!intra_process_is_enabled_ || get_intra_process_subscription_count() == 0) {
+    do_inter_process_publish(message);
+    return;
+  }
+  publish(std::make_unique<rclcpp::SerializedMessage>(std::move(message)));
+}
+
+void GenericPublisher::publish(const uint8_t * data, size_t length)
+{
+  // The message borrows the data, which publish() copies for the intra-process subscriptions.
+  const rclcpp::SerializedMessage message(data, length, nullptr);
+  publish(message);
+}
+
+void GenericPublisher::publish(
+  const uint8_t * data,
+  size_t length,
+  rclcpp::SerializedMessage::ExternalBufferDeleter deleter)
+{
+  if (!deleter) {
+    throw std::invalid_argument("the deleter of published data must not be empty");
+  }
+  publish(std::make_unique<rclcpp::SerializedMessage>(data, length, std::move(deleter)));
+}
+
+// Number of buffers kept for the next borrows, enough for a publisher used by a few threads.
+static constexpr size_t kMaxKeptBorrowedSerializedMessages = 4;
+
+std::unique_ptr<rclcpp::SerializedMessage>
+GenericPublisher::borrow_serialized_message(size_t length)
+{
+  std::unique_ptr<rclcpp::SerializedMessage> message;
+  {
+    std::lock_guard<std::mutex> lock(borrowed_serialized_messages_mutex_);
+    if (!borrowed_serialized_messages_.empty()) {
+      message = std::move(borrowed_serialized_messages_.back());
+      borrowed_serialized_messages_.pop_back();
+    }
+  }
+  if (!message) {
+    message = std::make_unique<rclcpp::SerializedMessage>(length);
+  } else if (message->capacity() < length) {
+    message->reserve(length);
+  }
+  message->get_rcl_serialized_message().buffer_length = length;
+  return message;
+}
+
+void
+GenericPublisher::publish_borrowed_serialized_message(
+  std::unique_ptr<rclcpp::SerializedMessage> message)
+{
+  if (!message) {
+    throw std::runtime_error("cannot publish msg which is a null pointer");
+  }
+  if (intra_process_is_enabled_ && get_intra_process_subscription_count() > 0) {
+    // The intra-process subscriptions take the ownership of the message.
+    publish(std::move(message));
+    return;
+  }
+  do_inter_process_publish(*message);
+  if (message->uses_external_buffer()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(borrowed_serialized_messages_mutex_);
+  if (borrowed_serialized_messages_.size() < kMaxKeptBorrowedSerializedMessages) {
+    borrowed_serialized_messages_.push_back(std::move(message));
+  }
+}
+
+void GenericPublisher::do_inter_process_publish(const rclcpp::SerializedMessage & message)
+{
+  // Only the messages given to the middleware are compressed.
+  const rclcpp::SerializedMessage * published_message = &message;
+  rclcpp::SerializedMessage encoded_message;
+  if (codec_) {
+    encoded_message = codec_->encode(message);
+    published_message = &encoded_message;
+  }
   auto return_code = rcl_publish_serialized_message(
-    get_publisher_handle().get(), &message.get_rcl_serialized_message(), NULL);
+    get_publisher_handle().get(), &published_message->get_rcl_serialized_message(), NULL);
 
   if (return_code != RCL_RET_OK) {
     rclcpp::exceptions::throw_from_rcl_error(return_code, "failed to publish serialized message");
   }
 }
 
+void GenericPublisher::do_intra_process_publish(
+  std::unique_ptr<rclcpp::SerializedMessage> message)
+{
+  auto ipm = weak_ipm_.lock();
+  if (!ipm) {
+    throw std::runtime_error(
+            "intra process publish called after destruction of intra process manager");
+  }
+  ipm->do_intra_process_publish<rclcpp::SerializedMessage>(
+    intra_process_publisher_id_,
+    std::move(message),
+    serialized_message_allocator_);
+}
+
+std::shared_ptr<const rclcpp::SerializedMessage>
+GenericPublisher::do_intra_process_publish_and_return_shared(
+  std::unique_ptr<rclcpp::SerializedMessage> message)
+{
+  auto ipm = weak_ipm_.lock();
+  if (!ipm) {
+    throw std::runtime_error(
+            "intra process publish called after destruction of intra process manager");
+  }
+  return ipm->do_intra_process_publish_and_return_shared<rclcpp::SerializedMessage>(
+    intra_process_publisher_id_,
+    std::move(message),
+    serialized_message_allocator_);
+}
+
 }  // namespace rclcpp
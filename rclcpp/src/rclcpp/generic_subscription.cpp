@@ -16,11 +16,13 @@
 #include "rclcpp/generic_subscription.hpp"
 
 #include <memory>
+#include <stdexcept>
 #include <string>
 
 #include "rcl/subscription.h"
 
 #include "rclcpp/exceptions.hpp"
+#include "rclcpp/logging.hpp"
 
 namespace rclcpp
 {
@@ -32,6 +34,9 @@ std::shared_ptr<void> GenericSubscription::create_message()
 
 std::shared_ptr<rclcpp::SerializedMessage> GenericSubscription::create_serialized_message()
 {
+  if (serialized_message_pool_) {
+    return serialized_message_pool_->borrow();
+  }
   return std::make_shared<rclcpp::SerializedMessage>(0);
 }
 
@@ -48,6 +53,19 @@ GenericSubscription::handle_serialized_message(
   const std::shared_ptr<rclcpp::SerializedMessage> & message,
   const rclcpp::MessageInfo &)
 {
+  if (codec_ && rclcpp::SerializedMessageCodec::is_encoded(*message)) {
+    auto decoded_message = create_serialized_message();
+    try {
+      codec_->decode(*message, *decoded_message);
+    } catch (const std::runtime_error & exception) {
+      RCLCPP_ERROR(
+        rclcpp::get_logger("rclcpp"),
+        "dropping a message on topic '%s': %s", get_topic_name(), exception.what());
+      return;
+    }
+    callback_(decoded_message);
+    return;
+  }
   callback_(message);
 }
 
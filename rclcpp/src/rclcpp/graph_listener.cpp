@@ -14,6 +14,8 @@
 
 #include "rclcpp/graph_listener.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <exception>
 #include <memory>
@@ -36,6 +38,9 @@ namespace rclcpp
 namespace graph_listener
 {
 
+GraphObserver::~GraphObserver()
+{}
+
 GraphListener::GraphListener(const std::shared_ptr<Context> & parent_context)
 : weak_parent_context_(parent_context),
   rcl_parent_context_(parent_context->get_rcl_context()),
@@ -144,16 +149,18 @@ GraphListener::run_loop()
     }
     // This lock is released when the loop continues or exits.
     std::lock_guard<std::mutex> nodes_lock(node_graph_interfaces_mutex_, std::adopt_lock);
+    // Only regroup the graph guard conditions when nodes or observers were added or removed.
+    update_graph_guard_conditions();
     // Resize the wait set if necessary.
-    const size_t node_graph_interfaces_size = node_graph_interfaces_.size();
     // Add 2 for the interrupt and shutdown guard conditions
-    if (wait_set_.size_of_guard_conditions < (node_graph_interfaces_size + 2)) {
-      ret = rcl_wait_set_resize(&wait_set_, 0, node_graph_interfaces_size + 2, 0, 0, 0, 0);
+    const size_t graph_gcs_size = graph_guard_conditions_.size();
+    if (wait_set_.size_of_guard_conditions < (graph_gcs_size + 2)) {
+      ret = rcl_wait_set_resize(&wait_set_, 0, graph_gcs_size + 2, 0, 0, 0, 0);
       if (RCL_RET_OK != ret) {
         throw_from_rcl_error(ret, "failed to resize wait set");
       }
     }
-    // Clear the wait set.
+    // Clear the wait set, rcl_wait() removes the guard conditions which were not triggered.
     ret = rcl_wait_set_clear(&wait_set_);
     if (RCL_RET_OK != ret) {
       throw_from_rcl_error(ret, "failed to clear wait set");
@@ -164,20 +171,19 @@ GraphListener::run_loop()
       throw_from_rcl_error(ret, "failed to add interrupt guard condition to wait set");
     }
 
-    // Put graph guard conditions for each node into the wait set.
-    std::vector<size_t> graph_gc_indexes(node_graph_interfaces_size, 0u);
-    for (size_t i = 0u; i < node_graph_interfaces_size; ++i) {
-      auto node_ptr = node_graph_interfaces_[i];
-      // Only wait on graph changes if some user of the node is watching.
-      if (node_ptr->count_graph_users() == 0) {
+    // Put each distinct graph guard condition into the wait set, once however many nodes use it.
+    for (auto & graph_gc : graph_guard_conditions_) {
+      // Only wait on graph changes if an observer or some user of a node is watching.
+      graph_gc.is_waited_on = !graph_gc.observers.empty() || std::any_of(
+        graph_gc.nodes.begin(), graph_gc.nodes.end(),
+        [](const rclcpp::node_interfaces::NodeGraphInterface * node_ptr) {
+          return node_ptr->count_graph_users() != 0;
+        });
+      if (!graph_gc.is_waited_on) {
         continue;
       }
-      // Add the graph guard condition for the node to the wait set.
-      auto graph_gc = node_ptr->get_graph_guard_condition();
-      if (!graph_gc) {
-        throw_from_rcl_error(RCL_RET_ERROR, "failed to get graph guard condition");
-      }
-      ret = rcl_wait_set_add_guard_condition(&wait_set_, graph_gc, &graph_gc_indexes[i]);
+      ret = rcl_wait_set_add_guard_condition(
+        &wait_set_, graph_gc.guard_condition, &graph_gc.wait_set_index);
       if (RCL_RET_OK != ret) {
         throw_from_rcl_error(ret, "failed to add graph guard condition to wait set");
       }
@@ -192,24 +198,79 @@ GraphListener::run_loop()
       throw_from_rcl_error(ret, "failed to wait on wait set");
     }
 
-    // Notify nodes who's guard conditions are set (triggered).
-    for (size_t i = 0u; i < node_graph_interfaces_size; ++i) {
-      const auto node_ptr = node_graph_interfaces_[i];
-      auto graph_gc = node_ptr->get_graph_guard_condition();
-      if (!graph_gc) {
-        throw_from_rcl_error(RCL_RET_ERROR, "failed to get graph guard condition");
+    // Count the graph change before notifying the nodes, so that the cached graph queries of the
+    // nodes are invalidated by the time the waiters of their graph events wake up.
+    bool graph_changed = false;
+    for (auto & graph_gc : graph_guard_conditions_) {
+      graph_gc.is_waited_on = graph_gc.is_waited_on &&
+        graph_gc.guard_condition == wait_set_.guard_conditions[graph_gc.wait_set_index];
+      graph_changed = graph_changed || graph_gc.is_waited_on;
+    }
+    if (graph_changed) {
+      graph_change_count_.fetch_add(1u);
+    }
+
+    // Notify the nodes which have graph users and use a triggered guard condition, once each even
+    // if several graph changes happened since the last wait.
+    for (const auto & graph_gc : graph_guard_conditions_) {
+      if (!graph_gc.is_waited_on) {
+        continue;
       }
-      if (graph_gc == wait_set_.guard_conditions[graph_gc_indexes[i]]) {
-        node_ptr->notify_graph_change();
+      for (const auto node_ptr : graph_gc.nodes) {
+        if (node_ptr->count_graph_users() != 0) {
+          node_ptr->notify_graph_change();
+        }
       }
-      if (is_shutdown_) {
-        // If shutdown, then notify the node of this as well.
+    }
+    if (is_shutdown_) {
+      // If shutdown, then notify the nodes of this as well.
+      for (const auto node_ptr : node_graph_interfaces_) {
         node_ptr->notify_shutdown();
       }
     }
+    if (graph_changed) {
+      for (const auto observer : graph_observers_) {
+        observer->on_graph_change();
+      }
+    }
   }  // while (true)
 }
 
+void
+GraphListener::update_graph_guard_conditions()
+{
+  if (!graph_guard_conditions_changed_) {
+    return;
+  }
+  graph_guard_conditions_.clear();
+  auto get_entry =
+    [this](const rcl_guard_condition_t * guard_condition) -> GraphGuardCondition & {
+      if (!guard_condition) {
+        throw_from_rcl_error(RCL_RET_ERROR, "failed to get graph guard condition");
+      }
+      const void * rmw_handle = rcl_guard_condition_get_rmw_handle(guard_condition);
+      if (!rmw_handle) {
+        // Fall back to waiting on this guard condition on its own.
+        rcl_reset_error();
+        rmw_handle = guard_condition;
+      }
+      for (auto & graph_gc : graph_guard_conditions_) {
+        if (rmw_handle == graph_gc.rmw_handle) {
+          return graph_gc;
+        }
+      }
+      graph_guard_conditions_.push_back({guard_condition, rmw_handle, {}, {}, false, 0u});
+      return graph_guard_conditions_.back();
+    };
+  for (const auto node_ptr : node_graph_interfaces_) {
+    get_entry(node_ptr->get_graph_guard_condition()).nodes.push_back(node_ptr);
+  }
+  for (const auto observer : graph_observers_) {
+    get_entry(observer->get_graph_guard_condition()).observers.push_back(observer);
+  }
+  graph_guard_conditions_changed_ = false;
+}
+
 static void
 interrupt_(rcl_guard_condition_t * interrupt_guard_condition)
 {
@@ -288,6 +349,7 @@ GraphListener::add_node(rclcpp::node_interfaces::NodeGraphInterface * node_graph
     throw NodeAlreadyAddedError();
   }
   node_graph_interfaces_.push_back(node_graph);
+  graph_guard_conditions_changed_ = true;
   // The run loop has already been interrupted by acquire_nodes_lock_() and
   // will evaluate the new node when nodes_lock releases the node_graph_interfaces_mutex_.
 }
@@ -331,6 +393,64 @@ GraphListener::remove_node(rclcpp::node_interfaces::NodeGraphInterface * node_gr
   // Store the now acquired node_graph_interfaces_mutex_ in the scoped lock using adopt_lock.
   std::lock_guard<std::mutex> nodes_lock(node_graph_interfaces_mutex_, std::adopt_lock);
   remove_node_(&node_graph_interfaces_, node_graph);
+  graph_guard_conditions_changed_ = true;
+}
+
+void
+GraphListener::add_graph_observer(GraphObserver * observer)
+{
+  if (!observer) {
+    throw std::invalid_argument("observer is nullptr");
+  }
+  std::lock_guard<std::mutex> shutdown_lock(shutdown_mutex_);
+  if (is_shutdown_.load()) {
+    throw GraphListenerShutdownError();
+  }
+  // Acquire the nodes mutex using the barrier to prevent the run loop from
+  // re-locking the nodes mutex after being interrupted.
+  acquire_nodes_lock_(
+    &node_graph_interfaces_barrier_mutex_,
+    &node_graph_interfaces_mutex_,
+    &interrupt_guard_condition_);
+  // Store the now acquired node_graph_interfaces_mutex_ in the scoped lock using adopt_lock.
+  std::lock_guard<std::mutex> nodes_lock(node_graph_interfaces_mutex_, std::adopt_lock);
+  graph_observers_.push_back(observer);
+  graph_guard_conditions_changed_ = true;
+}
+
+static void
+remove_graph_observer_(
+  std::vector<GraphObserver *> * graph_observers,
+  GraphObserver * observer)
+{
+  auto it = std::find(graph_observers->begin(), graph_observers->end(), observer);
+  if (graph_observers->end() == it) {
+    throw GraphObserverNotFoundError();
+  }
+  graph_observers->erase(it);
+}
+
+void
+GraphListener::remove_graph_observer(GraphObserver * observer)
+{
+  if (!observer) {
+    throw std::invalid_argument("observer is nullptr");
+  }
+  std::lock_guard<std::mutex> shutdown_lock(shutdown_mutex_);
+  if (is_shutdown()) {
+    // If shutdown, then the run loop has been joined, so we can remove them directly.
+    return remove_graph_observer_(&graph_observers_, observer);
+  }
+  // Acquire the nodes mutex using the barrier to prevent the run loop from
+  // re-locking the nodes mutex after being interrupted.
+  acquire_nodes_lock_(
+    &node_graph_interfaces_barrier_mutex_,
+    &node_graph_interfaces_mutex_,
+    &interrupt_guard_condition_);
+  // Store the now acquired node_graph_interfaces_mutex_ in the scoped lock using adopt_lock.
+  std::lock_guard<std::mutex> nodes_lock(node_graph_interfaces_mutex_, std::adopt_lock);
+  remove_graph_observer_(&graph_observers_, observer);
+  graph_guard_conditions_changed_ = true;
 }
 
 void
@@ -390,5 +510,11 @@ GraphListener::is_shutdown()
   return is_shutdown_.load();
 }
 
+uint64_t
+GraphListener::get_graph_change_count() const
+{
+  return graph_change_count_.load();
+}
+
 }  // namespace graph_listener
 }  // namespace rclcpp
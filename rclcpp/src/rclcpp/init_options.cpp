@@ -14,6 +14,8 @@
 
 #include "rclcpp/init_options.hpp"
 
+#include <stdexcept>
+
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/logging.hpp"
 
@@ -45,6 +47,10 @@ InitOptions::InitOptions(const InitOptions & other)
 {
   shutdown_on_signal = other.shutdown_on_signal;
   initialize_logging_ = other.initialize_logging_;
+  async_logging_options_ = other.async_logging_options_;
+  fast_exit_ = other.fast_exit_;
+  real_time_memory_options_ = other.real_time_memory_options_;
+  rosout_aggregation_options_ = other.rosout_aggregation_options_;
 }
 
 bool
@@ -60,6 +66,68 @@ InitOptions::auto_initialize_logging(bool initialize_logging)
   return *this;
 }
 
+const AsyncLoggingOptions &
+InitOptions::async_logging() const
+{
+  return async_logging_options_;
+}
+
+InitOptions &
+InitOptions::async_logging(const AsyncLoggingOptions & options)
+{
+  if (0u == options.queue_size) {
+    throw std::invalid_argument("the queue size of the asynchronous logging must not be zero");
+  }
+  async_logging_options_ = options;
+  return *this;
+}
+
+bool
+InitOptions::fast_exit() const
+{
+  return fast_exit_;
+}
+
+InitOptions &
+InitOptions::fast_exit(bool fast_exit)
+{
+  fast_exit_ = fast_exit;
+  return *this;
+}
+
+const RealTimeMemoryOptions &
+InitOptions::real_time_memory() const
+{
+  return real_time_memory_options_;
+}
+
+InitOptions &
+InitOptions::real_time_memory(const RealTimeMemoryOptions & options)
+{
+  real_time_memory_options_ = options;
+  return *this;
+}
+
+const RosoutAggregationOptions &
+InitOptions::rosout_aggregation() const
+{
+  return rosout_aggregation_options_;
+}
+
+InitOptions &
+InitOptions::rosout_aggregation(const RosoutAggregationOptions & options)
+{
+  if (options.period <= std::chrono::milliseconds::zero()) {
+    throw std::invalid_argument("the period of the rosout aggregation must be positive");
+  }
+  if (0u == options.max_pending_records) {
+    throw std::invalid_argument(
+            "the maximum number of pending records of the rosout aggregation must not be zero");
+  }
+  rosout_aggregation_options_ = options;
+  return *this;
+}
+
 InitOptions &
 InitOptions::operator=(const InitOptions & other)
 {
@@ -72,6 +140,10 @@ InitOptions::operator=(const InitOptions & other)
     }
     this->shutdown_on_signal = other.shutdown_on_signal;
     this->initialize_logging_ = other.initialize_logging_;
+    this->async_logging_options_ = other.async_logging_options_;
+    this->fast_exit_ = other.fast_exit_;
+    this->real_time_memory_options_ = other.real_time_memory_options_;
+    this->rosout_aggregation_options_ = other.rosout_aggregation_options_;
   }
   return *this;
 }
@@ -14,9 +14,16 @@
 
 #include "rclcpp/experimental/intra_process_manager.hpp"
 
+#include <algorithm>
 #include <atomic>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/tracing.hpp"
 
 namespace rclcpp
 {
@@ -26,70 +33,54 @@ namespace experimental
 static std::atomic<uint64_t> _next_unique_id {1};
 
 IntraProcessManager::IntraProcessManager()
+: routing_table_(std::make_shared<const RoutingTable>())
 {}
 
 IntraProcessManager::~IntraProcessManager()
 {}
 
 uint64_t
-IntraProcessManager::add_publisher(rclcpp::PublisherBase::SharedPtr publisher)
+IntraProcessManager::add_publisher(
+  rclcpp::PublisherBase::SharedPtr publisher,
+  PublisherIntraProcessHistoryBase::SharedPtr history,
+  PublisherIntraProcessRingBase::SharedPtr ring)
 {
-  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
-
-  uint64_t pub_id = IntraProcessManager::get_next_unique_id();
-
-  publishers_[pub_id] = publisher;
-
-  // Initialize the subscriptions storage for this publisher.
-  pub_to_subs_[pub_id] = SplittedSubscriptions();
-
-  // create an entry for the publisher id and populate with already existing subscriptions
-  for (auto & pair : subscriptions_) {
-    auto subscription = pair.second.lock();
-    if (!subscription) {
-      continue;
-    }
-    if (can_communicate(publisher, subscription)) {
-      uint64_t sub_id = pair.first;
-      insert_sub_id_for_pub(sub_id, pub_id, subscription->use_take_shared_method());
-    }
-  }
+  return register_publisher(std::move(publisher), nullptr, std::move(history), std::move(ring));
+}
 
-  return pub_id;
+uint64_t
+IntraProcessManager::add_serialized_publisher(
+  rclcpp::PublisherBase::SharedPtr publisher,
+  const std::string & type_name)
+{
+  return register_publisher(std::move(publisher), &type_name, nullptr, nullptr);
 }
 
 uint64_t
 IntraProcessManager::add_subscription(SubscriptionIntraProcessBase::SharedPtr subscription)
 {
-  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
-
-  uint64_t sub_id = IntraProcessManager::get_next_unique_id();
-
-  subscriptions_[sub_id] = subscription;
-
-  // adds the subscription id to all the matchable publishers
-  for (auto & pair : publishers_) {
-    auto publisher = pair.second.lock();
-    if (!publisher) {
-      continue;
-    }
-    if (can_communicate(publisher, subscription)) {
-      uint64_t pub_id = pair.first;
-      insert_sub_id_for_pub(sub_id, pub_id, subscription->use_take_shared_method());
-    }
-  }
+  return register_subscription(std::move(subscription), nullptr);
+}
 
-  return sub_id;
+uint64_t
+IntraProcessManager::add_serialized_subscription(
+  SubscriptionIntraProcessBase::SharedPtr subscription,
+  const std::string & type_name)
+{
+  return register_subscription(std::move(subscription), &type_name);
 }
 
 void
 IntraProcessManager::remove_subscription(uint64_t intra_process_subscription_id)
 {
-  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto routing_table = std::make_shared<RoutingTable>(*get_routing_table());
 
-  subscriptions_.erase(intra_process_subscription_id);
+  routing_table->subscriptions.erase(intra_process_subscription_id);
+  routing_table->serialized_types.erase(intra_process_subscription_id);
 
-  for (auto & pair : pub_to_subs_) {
+  for (auto & pair : routing_table->pub_to_subs) {
     pair.second.take_shared_subscriptions.erase(
       std::remove(
         pair.second.take_shared_subscriptions.begin(),
@@ -103,24 +94,105 @@ IntraProcessManager::remove_subscription(uint64_t intra_process_subscription_id)
         pair.second.take_ownership_subscriptions.end(),
         intra_process_subscription_id),
       pair.second.take_ownership_subscriptions.end());
+
+    pair.second.ring_subscriptions.erase(
+      std::remove(
+        pair.second.ring_subscriptions.begin(),
+        pair.second.ring_subscriptions.end(),
+        intra_process_subscription_id),
+      pair.second.ring_subscriptions.end());
   }
+
+  set_routing_table(std::move(routing_table));
 }
 
 void
 IntraProcessManager::remove_publisher(uint64_t intra_process_publisher_id)
 {
-  std::unique_lock<std::shared_timed_mutex> lock(mutex_);
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto routing_table = std::make_shared<RoutingTable>(*get_routing_table());
+
+  routing_table->publishers.erase(intra_process_publisher_id);
+  routing_table->pub_to_subs.erase(intra_process_publisher_id);
+  routing_table->serialized_types.erase(intra_process_publisher_id);
+  routing_table->histories.erase(intra_process_publisher_id);
+  routing_table->publication_states.erase(intra_process_publisher_id);
+  auto ring_it = routing_table->rings.find(intra_process_publisher_id);
+  if (ring_it != routing_table->rings.end()) {
+    // The subscriptions still read the messages published until now.
+    ring_it->second->close();
+    routing_table->rings.erase(ring_it);
+  }
+
+  set_routing_table(std::move(routing_table));
+}
+
+uint64_t
+IntraProcessManager::add_service(ServiceIntraProcessBase::SharedPtr service)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto routing_table = std::make_shared<RoutingTable>(*get_routing_table());
+
+  uint64_t service_id = IntraProcessManager::get_next_unique_id();
+  routing_table->services[service->get_service_name()].emplace_back(service_id, service);
+
+  set_routing_table(std::move(routing_table));
+
+  return service_id;
+}
+
+void
+IntraProcessManager::remove_service(uint64_t intra_process_service_id)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto routing_table = std::make_shared<RoutingTable>(*get_routing_table());
+
+  for (auto it = routing_table->services.begin(); it != routing_table->services.end(); ++it) {
+    auto & services = it->second;
+    auto service_it = std::find_if(
+      services.begin(), services.end(),
+      [intra_process_service_id](const auto & service) {
+        return service.first == intra_process_service_id;
+      });
+    if (service_it != services.end()) {
+      services.erase(service_it);
+      if (services.empty()) {
+        routing_table->services.erase(it);
+      }
+      break;
+    }
+  }
+
+  set_routing_table(std::move(routing_table));
+}
+
+ServiceIntraProcessBase::SharedPtr
+IntraProcessManager::get_service_intra_process(const std::string & service_name) const
+{
+  auto routing_table = get_routing_table();
 
-  publishers_.erase(intra_process_publisher_id);
-  pub_to_subs_.erase(intra_process_publisher_id);
+  auto services_it = routing_table->services.find(service_name);
+  if (services_it == routing_table->services.end()) {
+    return nullptr;
+  }
+  for (const auto & service : services_it->second) {
+    auto service_intra_process = service.second.lock();
+    if (service_intra_process) {
+      return service_intra_process;
+    }
+  }
+  return nullptr;
 }
 
 bool
 IntraProcessManager::matches_any_publishers(const rmw_gid_t * id) const
 {
-  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+  auto routing_table = get_routing_table();
 
-  for (auto & publisher_pair : publishers_) {
+  for (auto & publisher_pair : routing_table->publishers) {
     auto publisher = publisher_pair.second.lock();
     if (!publisher) {
       continue;
@@ -132,13 +204,44 @@ IntraProcessManager::matches_any_publishers(const rmw_gid_t * id) const
   return false;
 }
 
+bool
+IntraProcessManager::matches_any_publishers(
+  const rmw_gid_t * id,
+  uint64_t intra_process_subscription_id) const
+{
+  auto routing_table = get_routing_table();
+
+  for (auto & publisher_pair : routing_table->publishers) {
+    auto publisher = publisher_pair.second.lock();
+    if (!publisher || !(*publisher.get() == id)) {
+      continue;
+    }
+    auto publisher_it = routing_table->pub_to_subs.find(publisher_pair.first);
+    if (publisher_it == routing_table->pub_to_subs.end()) {
+      return false;
+    }
+    const auto & sub_ids = publisher_it->second;
+    return
+      std::find(
+      sub_ids.take_shared_subscriptions.begin(), sub_ids.take_shared_subscriptions.end(),
+      intra_process_subscription_id) != sub_ids.take_shared_subscriptions.end() ||
+      std::find(
+      sub_ids.take_ownership_subscriptions.begin(), sub_ids.take_ownership_subscriptions.end(),
+      intra_process_subscription_id) != sub_ids.take_ownership_subscriptions.end() ||
+      std::find(
+      sub_ids.ring_subscriptions.begin(), sub_ids.ring_subscriptions.end(),
+      intra_process_subscription_id) != sub_ids.ring_subscriptions.end();
+  }
+  return false;
+}
+
 size_t
 IntraProcessManager::get_subscription_count(uint64_t intra_process_publisher_id) const
 {
-  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+  auto routing_table = get_routing_table();
 
-  auto publisher_it = pub_to_subs_.find(intra_process_publisher_id);
-  if (publisher_it == pub_to_subs_.end()) {
+  auto publisher_it = routing_table->pub_to_subs.find(intra_process_publisher_id);
+  if (publisher_it == routing_table->pub_to_subs.end()) {
     // Publisher is either invalid or no longer exists.
     RCLCPP_WARN(
       rclcpp::get_logger("rclcpp"),
@@ -148,7 +251,8 @@ IntraProcessManager::get_subscription_count(uint64_t intra_process_publisher_id)
 
   auto count =
     publisher_it->second.take_shared_subscriptions.size() +
-    publisher_it->second.take_ownership_subscriptions.size();
+    publisher_it->second.take_ownership_subscriptions.size() +
+    publisher_it->second.ring_subscriptions.size();
 
   return count;
 }
@@ -156,20 +260,57 @@ IntraProcessManager::get_subscription_count(uint64_t intra_process_publisher_id)
 SubscriptionIntraProcessBase::SharedPtr
 IntraProcessManager::get_subscription_intra_process(uint64_t intra_process_subscription_id)
 {
-  std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+  auto routing_table = get_routing_table();
 
-  auto subscription_it = subscriptions_.find(intra_process_subscription_id);
-  if (subscription_it == subscriptions_.end()) {
+  auto subscription_it = routing_table->subscriptions.find(intra_process_subscription_id);
+  if (subscription_it == routing_table->subscriptions.end()) {
     return nullptr;
-  } else {
-    auto subscription = subscription_it->second.lock();
-    if (subscription) {
-      return subscription;
-    } else {
-      subscriptions_.erase(subscription_it);
-      return nullptr;
+  }
+  return subscription_it->second.lock();
+}
+
+std::vector<IntraProcessManager::TopicInfo>
+IntraProcessManager::get_topic_info() const
+{
+  auto routing_table = get_routing_table();
+
+  std::map<std::string, TopicInfo> topics;
+  for (const auto & publisher_pair : routing_table->publishers) {
+    auto publisher = publisher_pair.second.lock();
+    if (!publisher) {
+      continue;
+    }
+    auto & topic = topics[publisher->get_topic_name()];
+    ++topic.publisher_count;
+    auto publisher_it = routing_table->pub_to_subs.find(publisher_pair.first);
+    if (publisher_it != routing_table->pub_to_subs.end()) {
+      topic.route_count +=
+        publisher_it->second.take_shared_subscriptions.size() +
+        publisher_it->second.take_ownership_subscriptions.size() +
+        publisher_it->second.ring_subscriptions.size();
     }
   }
+  for (const auto & subscription_pair : routing_table->subscriptions) {
+    auto subscription = subscription_pair.second.lock();
+    if (!subscription) {
+      continue;
+    }
+    ++topics[subscription->get_topic_name()].subscription_count;
+  }
+
+  std::vector<TopicInfo> topic_info;
+  topic_info.reserve(topics.size());
+  for (auto & topic_pair : topics) {
+    topic_pair.second.topic_name = topic_pair.first;
+    topic_info.push_back(std::move(topic_pair.second));
+  }
+  return topic_info;
+}
+
+void
+IntraProcessManager::set_routing_table(std::shared_ptr<RoutingTable> routing_table)
+{
+  std::atomic_store(&routing_table_, std::shared_ptr<const RoutingTable>(std::move(routing_table)));
 }
 
 uint64_t
@@ -194,29 +335,164 @@ IntraProcessManager::get_next_unique_id()
   return next_id;
 }
 
+IntraProcessMessageInfo
+IntraProcessManager::make_message_info(
+  uint64_t intra_process_publisher_id,
+  const RoutingTable & routing_table)
+{
+  IntraProcessMessageInfo info;
+  info.intra_process_publisher_id = intra_process_publisher_id;
+  auto state_it = routing_table.publication_states.find(intra_process_publisher_id);
+  if (state_it != routing_table.publication_states.end()) {
+    info.publisher_gid = state_it->second->gid;
+    info.publication_sequence_number = ++state_it->second->sequence_number;
+  }
+  if (RCUTILS_RET_OK != rcutils_system_time_now(&info.source_timestamp)) {
+    info.source_timestamp = 0;
+  }
+  rclcpp::tracing::trace(
+    rclcpp::tracing::TraceEventType::IntraProcessPublish, nullptr,
+    intra_process_publisher_id, info.publication_sequence_number);
+  return info;
+}
+
+uint64_t
+IntraProcessManager::register_publisher(
+  rclcpp::PublisherBase::SharedPtr publisher,
+  const std::string * serialized_type_name,
+  PublisherIntraProcessHistoryBase::SharedPtr history,
+  PublisherIntraProcessRingBase::SharedPtr ring)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto routing_table = std::make_shared<RoutingTable>(*get_routing_table());
+
+  uint64_t pub_id = IntraProcessManager::get_next_unique_id();
+
+  routing_table->publishers[pub_id] = publisher;
+  if (serialized_type_name) {
+    routing_table->serialized_types[pub_id] = *serialized_type_name;
+  }
+  if (history) {
+    routing_table->histories[pub_id] = std::move(history);
+  }
+  if (ring) {
+    routing_table->rings[pub_id] = std::move(ring);
+  }
+  auto publication_state = std::make_shared<PublicationState>();
+  publication_state->gid = publisher->get_gid();
+  routing_table->publication_states[pub_id] = std::move(publication_state);
+
+  // Initialize the subscriptions storage for this publisher.
+  routing_table->pub_to_subs[pub_id] = SplittedSubscriptions();
+
+  // create an entry for the publisher id and populate with already existing subscriptions
+  for (auto & pair : routing_table->subscriptions) {
+    auto subscription = pair.second.lock();
+    if (!subscription) {
+      continue;
+    }
+    uint64_t sub_id = pair.first;
+    if (can_communicate(*routing_table, pub_id, publisher, sub_id, subscription)) {
+      insert_sub_id_for_pub(*routing_table, sub_id, pub_id, subscription);
+    }
+  }
+
+  set_routing_table(std::move(routing_table));
+
+  return pub_id;
+}
+
+uint64_t
+IntraProcessManager::register_subscription(
+  SubscriptionIntraProcessBase::SharedPtr subscription,
+  const std::string * serialized_type_name)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  auto routing_table = std::make_shared<RoutingTable>(*get_routing_table());
+
+  uint64_t sub_id = IntraProcessManager::get_next_unique_id();
+  const bool transient_local =
+    subscription->get_actual_qos().durability() == rclcpp::DurabilityPolicy::TransientLocal;
+  std::vector<PublisherIntraProcessHistoryBase::SharedPtr> histories;
+
+  routing_table->subscriptions[sub_id] = subscription;
+  if (serialized_type_name) {
+    routing_table->serialized_types[sub_id] = *serialized_type_name;
+  }
+
+  // adds the subscription id to all the matchable publishers
+  for (auto & pair : routing_table->publishers) {
+    auto publisher = pair.second.lock();
+    if (!publisher) {
+      continue;
+    }
+    uint64_t pub_id = pair.first;
+    if (can_communicate(*routing_table, pub_id, publisher, sub_id, subscription)) {
+      insert_sub_id_for_pub(*routing_table, sub_id, pub_id, subscription);
+      auto history_it = routing_table->histories.find(pub_id);
+      if (transient_local && history_it != routing_table->histories.end()) {
+        histories.push_back(history_it->second);
+      }
+    }
+  }
+
+  set_routing_table(std::move(routing_table));
+  lock.unlock();
+
+  // The messages published from now on are routed to the subscription, the previous ones are
+  // replayed from the histories of the publishers.
+  for (auto & history : histories) {
+    history->replay(subscription);
+  }
+
+  return sub_id;
+}
+
 void
 IntraProcessManager::insert_sub_id_for_pub(
+  RoutingTable & routing_table,
   uint64_t sub_id,
   uint64_t pub_id,
-  bool use_take_shared_method)
+  const SubscriptionIntraProcessBase::SharedPtr & subscription)
 {
-  if (use_take_shared_method) {
-    pub_to_subs_[pub_id].take_shared_subscriptions.push_back(sub_id);
+  auto ring_it = routing_table.rings.find(pub_id);
+  if (ring_it != routing_table.rings.end() && ring_it->second->attach(subscription)) {
+    routing_table.pub_to_subs[pub_id].ring_subscriptions.push_back(sub_id);
+  } else if (subscription->use_take_shared_method()) {
+    routing_table.pub_to_subs[pub_id].take_shared_subscriptions.push_back(sub_id);
   } else {
-    pub_to_subs_[pub_id].take_ownership_subscriptions.push_back(sub_id);
+    routing_table.pub_to_subs[pub_id].take_ownership_subscriptions.push_back(sub_id);
   }
 }
 
 bool
 IntraProcessManager::can_communicate(
+  const RoutingTable & routing_table,
+  uint64_t pub_id,
   rclcpp::PublisherBase::SharedPtr pub,
-  rclcpp::experimental::SubscriptionIntraProcessBase::SharedPtr sub) const
+  uint64_t sub_id,
+  rclcpp::experimental::SubscriptionIntraProcessBase::SharedPtr sub)
 {
   // publisher and subscription must be on the same topic
   if (strcmp(pub->get_topic_name(), sub->get_topic_name()) != 0) {
     return false;
   }
 
+  // serialized messages are only exchanged between the publishers and subscriptions of
+  // serialized messages, of the same type
+  auto pub_type_it = routing_table.serialized_types.find(pub_id);
+  auto sub_type_it = routing_table.serialized_types.find(sub_id);
+  const bool pub_is_serialized = pub_type_it != routing_table.serialized_types.end();
+  const bool sub_is_serialized = sub_type_it != routing_table.serialized_types.end();
+  if (pub_is_serialized != sub_is_serialized) {
+    return false;
+  }
+  if (pub_is_serialized && pub_type_it->second != sub_type_it->second) {
+    return false;
+  }
+
   auto check_result = rclcpp::qos_check_compatible(pub->get_actual_qos(), sub->get_actual_qos());
   if (check_result.compatibility == rclcpp::QoSCompatibility::Error) {
     return false;
@@ -0,0 +1,98 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/lazy_message.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace rclcpp
+{
+namespace detail
+{
+
+namespace
+{
+// Identifiers of the encapsulations of RTPS serialized payloads, in their second byte.
+constexpr uint8_t cdr_be = 0x00;
+constexpr uint8_t cdr_le = 0x01;
+constexpr uint8_t plain_cdr2_be = 0x06;
+constexpr uint8_t plain_cdr2_le = 0x07;
+
+// The encapsulation, the sec and nanosec of the stamp, and the length of the frame id.
+constexpr size_t encapsulation_size = 4;
+constexpr size_t header_prefix_size = encapsulation_size + 3 * sizeof(uint32_t);
+
+uint32_t
+read_uint32(const uint8_t * buffer, bool little_endian)
+{
+  if (little_endian) {
+    return static_cast<uint32_t>(buffer[0]) |
+           (static_cast<uint32_t>(buffer[1]) << 8) |
+           (static_cast<uint32_t>(buffer[2]) << 16) |
+           (static_cast<uint32_t>(buffer[3]) << 24);
+  }
+  return (static_cast<uint32_t>(buffer[0]) << 24) |
+         (static_cast<uint32_t>(buffer[1]) << 16) |
+         (static_cast<uint32_t>(buffer[2]) << 8) |
+         static_cast<uint32_t>(buffer[3]);
+}
+}  // namespace
+
+bool
+read_serialized_header(
+  const rcl_serialized_message_t & serialized_message,
+  builtin_interfaces::msg::Time * stamp,
+  std::string * frame_id)
+{
+  const uint8_t * buffer = serialized_message.buffer;
+  const size_t length = serialized_message.buffer_length;
+  if (nullptr == buffer || length < header_prefix_size || 0 != buffer[0]) {
+    return false;
+  }
+  bool little_endian;
+  switch (buffer[1]) {
+    case cdr_be:
+    case plain_cdr2_be:
+      little_endian = false;
+      break;
+    case cdr_le:
+    case plain_cdr2_le:
+      little_endian = true;
+      break;
+    default:
+      // Parameter lists and delimited encodings are not laid out as the fields.
+      return false;
+  }
+
+  // The fields of the header are 4 bytes aligned, so there is no padding before them.
+  const uint8_t * fields = buffer + encapsulation_size;
+  if (nullptr != frame_id) {
+    // The length of the string counts its terminating null character.
+    const uint32_t frame_id_length = read_uint32(fields + 8, little_endian);
+    if (0 == frame_id_length || frame_id_length > length - header_prefix_size) {
+      return false;
+    }
+    frame_id->assign(
+      reinterpret_cast<const char *>(buffer + header_prefix_size), frame_id_length - 1);
+  }
+  if (nullptr != stamp) {
+    stamp->sec = static_cast<int32_t>(read_uint32(fields, little_endian));
+    stamp->nanosec = read_uint32(fields + 4, little_endian);
+  }
+  return true;
+}
+
+}  // namespace detail
+}  // namespace rclcpp
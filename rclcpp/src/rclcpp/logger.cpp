@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 
 #include "rcl_logging_interface/rcl_logging_interface.h"
@@ -23,6 +25,12 @@
 namespace rclcpp
 {
 
+namespace detail
+{
+// Cached levels are zero initialized, so they never match the first generation.
+std::atomic<uint64_t> g_logger_level_generation{1u};
+}  // namespace detail
+
 Logger
 get_logger(const std::string & name)
 {
@@ -48,6 +56,12 @@ get_node_logger(const rcl_node_t * node)
   return rclcpp::get_logger(logger_name);
 }
 
+void
+invalidate_logger_level_caches()
+{
+  detail::g_logger_level_generation.fetch_add(1u, std::memory_order_acq_rel);
+}
+
 rcpputils::fs::path
 get_logging_directory()
 {
@@ -78,6 +92,23 @@ Logger::set_level(Level level)
       RCL_RET_ERROR, "Couldn't set logger level",
       rcutils_get_error_state(), rcutils_reset_error);
   }
+  invalidate_logger_level_caches();
+}
+
+bool
+Logger::update_level_cache(Level level, uint64_t generation) const
+{
+  RCUTILS_LOGGING_AUTOINIT;
+  const int effective_level = rcutils_logging_get_logger_effective_level(get_name());
+  if (effective_level < 0) {
+    // Let the logging macros check the level again.
+    rcutils_reset_error();
+    return true;
+  }
+  // The generation was loaded before the level, so a concurrent level change is seen next time.
+  level_cache_->store(
+    (generation << 8u) | static_cast<uint64_t>(effective_level), std::memory_order_relaxed);
+  return static_cast<int>(level) >= effective_level;
 }
 
 }  // namespace rclcpp
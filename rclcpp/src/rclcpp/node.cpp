@@ -166,8 +166,13 @@ Node::Node(
       *(options.get_rcl_node_options()),
       options.use_intra_process_comms(),
       options.enable_topic_statistics())),
-  node_graph_(new rclcpp::node_interfaces::NodeGraph(node_base_.get())),
-  node_logging_(new rclcpp::node_interfaces::NodeLogging(node_base_.get())),
+  node_graph_(new rclcpp::node_interfaces::NodeGraph(
+      node_base_.get(),
+      options.use_graph_cache())),
+  node_logging_(new rclcpp::node_interfaces::NodeLogging(
+      node_base_.get(),
+      options.use_shared_rosout(),
+      options.rosout_qos())),
   node_timers_(new rclcpp::node_interfaces::NodeTimers(node_base_.get())),
   node_topics_(new rclcpp::node_interfaces::NodeTopics(node_base_.get(), node_timers_.get())),
   node_services_(new rclcpp::node_interfaces::NodeServices(node_base_.get())),
@@ -192,7 +197,12 @@ Node::Node(
       get_parameter_events_qos(*node_base_, options),
       options.parameter_event_publisher_options(),
       options.allow_undeclared_parameters(),
-      options.automatically_declare_parameters_from_overrides()
+      options.automatically_declare_parameters_from_overrides(),
+      node_timers_,
+      options.parameter_event_coalescing_period(),
+      options.use_shared_infrastructure(),
+      options.lazy_parameter_services(),
+      node_graph_
     )),
   node_time_source_(new rclcpp::node_interfaces::NodeTimeSource(
       node_base_,
@@ -203,7 +213,9 @@ Node::Node(
       node_clock_,
       node_parameters_,
       options.clock_qos(),
-      options.use_clock_thread()
+      options.use_clock_thread(),
+      options.use_shared_clock_source(),
+      options.use_shared_infrastructure()
     )),
   node_waitables_(new rclcpp::node_interfaces::NodeWaitables(node_base_.get())),
   node_options_(options),
@@ -15,6 +15,7 @@
 #include <string>
 #include <limits>
 #include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -356,6 +357,38 @@ NodeBase::acquire_notify_guard_condition_lock() const
   return std::unique_lock<std::recursive_mutex>(notify_guard_condition_mutex_);
 }
 
+rcl_ret_t
+NodeBase::trigger_notify_guard_condition()
+{
+  std::lock_guard<std::recursive_mutex> notify_condition_lock(notify_guard_condition_mutex_);
+  if (notify_guard_condition_trigger_pending_.exchange(true)) {
+    // The waiter has not woken up on the previous trigger yet, and collects this change too.
+    return RCL_RET_OK;
+  }
+  if (notify_callback_) {
+    notify_callback_();
+  }
+  rcl_ret_t ret = rcl_trigger_guard_condition(
+    notify_guard_condition_is_valid_ ? &notify_guard_condition_ : nullptr);
+  if (RCL_RET_OK != ret) {
+    notify_guard_condition_trigger_pending_.store(false);
+  }
+  return ret;
+}
+
+void
+NodeBase::consume_notify_guard_condition_trigger()
+{
+  notify_guard_condition_trigger_pending_.store(false);
+}
+
+void
+NodeBase::set_notify_callback(std::function<void ()> callback)
+{
+  std::lock_guard<std::recursive_mutex> notify_condition_lock(notify_guard_condition_mutex_);
+  notify_callback_ = std::move(callback);
+}
+
 bool
 NodeBase::get_use_intra_process_default() const
 {
@@ -372,6 +405,16 @@ std::string
 NodeBase::resolve_topic_or_service_name(
   const std::string & name, bool is_service, bool only_expand) const
 {
+  // Every entity resolves its name, often the same ones, e.g. when creating many entities.
+  auto key = std::make_tuple(name, is_service, only_expand);
+  {
+    std::lock_guard<std::mutex> lock(resolved_names_mutex_);
+    auto it = resolved_names_.find(key);
+    if (resolved_names_.end() != it) {
+      return it->second;
+    }
+  }
+
   char * output_cstr = NULL;
   auto allocator = rcl_get_default_allocator();
   rcl_ret_t ret = rcl_node_resolve_name(
@@ -386,5 +429,8 @@ NodeBase::resolve_topic_or_service_name(
   }
   std::string output{output_cstr};
   allocator.deallocate(output_cstr, allocator.state);
+
+  std::lock_guard<std::mutex> lock(resolved_names_mutex_);
+  resolved_names_.emplace(std::move(key), output);
   return output;
 }
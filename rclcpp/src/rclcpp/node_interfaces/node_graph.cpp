@@ -16,6 +16,8 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -34,13 +36,16 @@ using rclcpp::node_interfaces::NodeGraph;
 using rclcpp::exceptions::throw_from_rcl_error;
 using rclcpp::graph_listener::GraphListener;
 
-NodeGraph::NodeGraph(rclcpp::node_interfaces::NodeBaseInterface * node_base)
+NodeGraph::NodeGraph(
+  rclcpp::node_interfaces::NodeBaseInterface * node_base,
+  bool use_graph_cache)
 : node_base_(node_base),
   graph_listener_(
     node_base->get_context()->get_sub_context<GraphListener>(node_base->get_context())
   ),
   should_add_to_graph_listener_(true),
-  graph_users_count_(0)
+  graph_users_count_(0),
+  use_graph_cache_(use_graph_cache)
 {}
 
 NodeGraph::~NodeGraph()
@@ -54,14 +59,17 @@ NodeGraph::~NodeGraph()
   }
 }
 
+static
 std::map<std::string, std::vector<std::string>>
-NodeGraph::get_topic_names_and_types(bool no_demangle) const
+query_topic_names_and_types(
+  rclcpp::node_interfaces::NodeBaseInterface * node_base,
+  bool no_demangle)
 {
   rcl_names_and_types_t topic_names_and_types = rcl_get_zero_initialized_names_and_types();
 
   rcl_allocator_t allocator = rcl_get_default_allocator();
   auto ret = rcl_get_topic_names_and_types(
-    node_base_->get_rcl_node_handle(),
+    node_base->get_rcl_node_handle(),
     &allocator,
     no_demangle,
     &topic_names_and_types);
@@ -96,6 +104,31 @@ NodeGraph::get_topic_names_and_types(bool no_demangle) const
   return topics_and_types;
 }
 
+std::map<std::string, std::vector<std::string>>
+NodeGraph::get_topic_names_and_types(bool no_demangle) const
+{
+  if (!use_graph_cache_) {
+    return query_topic_names_and_types(node_base_, no_demangle);
+  }
+  return *get_topic_names_and_types_snapshot(no_demangle);
+}
+
+std::shared_ptr<const std::map<std::string, std::vector<std::string>>>
+NodeGraph::get_topic_names_and_types_snapshot(bool no_demangle) const
+{
+  std::unique_lock<std::mutex> cache_lock;
+  if (!lock_graph_cache(cache_lock)) {
+    return std::make_shared<const TopicNamesAndTypes>(
+      query_topic_names_and_types(node_base_, no_demangle));
+  }
+  auto & topic_names_and_types = graph_cache_.topic_names_and_types[no_demangle ? 1 : 0];
+  if (!topic_names_and_types) {
+    topic_names_and_types = std::make_shared<const TopicNamesAndTypes>(
+      query_topic_names_and_types(node_base_, no_demangle));
+  }
+  return topic_names_and_types;
+}
+
 std::map<std::string, std::vector<std::string>>
 NodeGraph::get_service_names_and_types() const
 {
@@ -289,11 +322,12 @@ NodeGraph::get_subscriber_names_and_types_by_node(
   return topics_and_types;
 }
 
+static
 std::vector<std::string>
-NodeGraph::get_node_names() const
+to_fully_qualified_node_names(
+  const std::vector<std::pair<std::string, std::string>> & names_and_namespaces)
 {
   std::vector<std::string> nodes;
-  auto names_and_namespaces = get_node_names_and_namespaces();
 
   std::transform(
     names_and_namespaces.begin(),
@@ -317,6 +351,30 @@ NodeGraph::get_node_names() const
   return nodes;
 }
 
+std::vector<std::string>
+NodeGraph::get_node_names() const
+{
+  if (!use_graph_cache_) {
+    return to_fully_qualified_node_names(get_node_names_and_namespaces());
+  }
+  return *get_node_names_snapshot();
+}
+
+std::shared_ptr<const std::vector<std::string>>
+NodeGraph::get_node_names_snapshot() const
+{
+  std::unique_lock<std::mutex> cache_lock;
+  if (!lock_graph_cache(cache_lock)) {
+    return std::make_shared<const std::vector<std::string>>(
+      to_fully_qualified_node_names(get_node_names_and_namespaces()));
+  }
+  if (!graph_cache_.node_names) {
+    graph_cache_.node_names = std::make_shared<const std::vector<std::string>>(
+      to_fully_qualified_node_names(get_node_names_and_namespaces()));
+  }
+  return graph_cache_.node_names;
+}
+
 std::vector<std::tuple<std::string, std::string, std::string>>
 NodeGraph::get_node_names_with_enclaves() const
 {
@@ -454,19 +512,14 @@ NodeGraph::get_node_names_and_namespaces() const
   return node_names;
 }
 
+static
 size_t
-NodeGraph::count_publishers(const std::string & topic_name) const
+query_publisher_count(
+  rclcpp::node_interfaces::NodeBaseInterface * node_base,
+  const std::string & fqdn)
 {
-  auto rcl_node_handle = node_base_->get_rcl_node_handle();
-
-  auto fqdn = rclcpp::expand_topic_or_service_name(
-    topic_name,
-    rcl_node_get_name(rcl_node_handle),
-    rcl_node_get_namespace(rcl_node_handle),
-    false);    // false = not a service
-
   size_t count;
-  auto ret = rcl_count_publishers(rcl_node_handle, fqdn.c_str(), &count);
+  auto ret = rcl_count_publishers(node_base->get_rcl_node_handle(), fqdn.c_str(), &count);
   if (ret != RMW_RET_OK) {
     // *INDENT-OFF*
     throw std::runtime_error(
@@ -476,26 +529,144 @@ NodeGraph::count_publishers(const std::string & topic_name) const
   return count;
 }
 
+static
+size_t
+query_subscriber_count(
+  rclcpp::node_interfaces::NodeBaseInterface * node_base,
+  const std::string & fqdn)
+{
+  size_t count;
+  auto ret = rcl_count_subscribers(node_base->get_rcl_node_handle(), fqdn.c_str(), &count);
+  if (ret != RMW_RET_OK) {
+    // *INDENT-OFF*
+    throw std::runtime_error(
+      std::string("could not count subscribers: ") + rmw_get_error_string().str);
+    // *INDENT-ON*
+  }
+  return count;
+}
+
+size_t
+NodeGraph::count_publishers(const std::string & topic_name) const
+{
+  std::unique_lock<std::mutex> cache_lock;
+  if (!lock_graph_cache(cache_lock)) {
+    return query_publisher_count(node_base_, expand_topic_name(topic_name));
+  }
+  auto it = graph_cache_.publisher_counts.find(topic_name);
+  if (graph_cache_.publisher_counts.end() == it) {
+    it = graph_cache_.publisher_counts.emplace(
+      topic_name, query_publisher_count(node_base_, expand_topic_name(topic_name))).first;
+  }
+  return it->second;
+}
+
 size_t
 NodeGraph::count_subscribers(const std::string & topic_name) const
 {
-  auto rcl_node_handle = node_base_->get_rcl_node_handle();
+  std::unique_lock<std::mutex> cache_lock;
+  if (!lock_graph_cache(cache_lock)) {
+    return query_subscriber_count(node_base_, expand_topic_name(topic_name));
+  }
+  auto it = graph_cache_.subscriber_counts.find(topic_name);
+  if (graph_cache_.subscriber_counts.end() == it) {
+    it = graph_cache_.subscriber_counts.emplace(
+      topic_name, query_subscriber_count(node_base_, expand_topic_name(topic_name))).first;
+  }
+  return it->second;
+}
 
+std::string
+NodeGraph::expand_topic_name(const std::string & topic_name) const
+{
+  std::lock_guard<std::mutex> lock(resolved_names_.mutex);
+  auto it = resolved_names_.expanded.find(topic_name);
+  if (resolved_names_.expanded.end() != it) {
+    return it->second;
+  }
+  auto rcl_node_handle = node_base_->get_rcl_node_handle();
+  // This throws on invalid names, which are therefore not cached.
   auto fqdn = rclcpp::expand_topic_or_service_name(
     topic_name,
     rcl_node_get_name(rcl_node_handle),
     rcl_node_get_namespace(rcl_node_handle),
     false);    // false = not a service
+  resolved_names_.expanded.emplace(topic_name, fqdn);
+  return fqdn;
+}
 
-  size_t count;
-  auto ret = rcl_count_subscribers(rcl_node_handle, fqdn.c_str(), &count);
-  if (ret != RMW_RET_OK) {
-    // *INDENT-OFF*
-    throw std::runtime_error(
-      std::string("could not count subscribers: ") + rmw_get_error_string().str);
-    // *INDENT-ON*
+std::string
+NodeGraph::remap_topic_name(const std::string & topic_name) const
+{
+  {
+    std::lock_guard<std::mutex> lock(resolved_names_.mutex);
+    auto it = resolved_names_.remapped.find(topic_name);
+    if (resolved_names_.remapped.end() != it) {
+      return it->second;
+    }
   }
-  return count;
+  std::string fqdn = expand_topic_name(topic_name);
+  auto rcl_node_handle = node_base_->get_rcl_node_handle();
+
+  // Get the node options
+  const rcl_node_options_t * node_options = rcl_node_get_options(rcl_node_handle);
+  if (nullptr == node_options) {
+    throw std::runtime_error("Need valid node options in get_info_by_topic()");
+  }
+  const rcl_arguments_t * global_args = nullptr;
+  if (node_options->use_global_arguments) {
+    global_args = &(rcl_node_handle->context->global_arguments);
+  }
+
+  char * remapped_topic_name = nullptr;
+  rcl_ret_t ret = rcl_remap_topic_name(
+    &(node_options->arguments),
+    global_args,
+    fqdn.c_str(),
+    rcl_node_get_name(rcl_node_handle),
+    rcl_node_get_namespace(rcl_node_handle),
+    node_options->allocator,
+    &remapped_topic_name);
+  if (RCL_RET_OK != ret) {
+    throw_from_rcl_error(ret, std::string("Failed to remap topic name ") + fqdn);
+  } else if (nullptr != remapped_topic_name) {
+    fqdn = remapped_topic_name;
+    node_options->allocator.deallocate(remapped_topic_name, node_options->allocator.state);
+  }
+
+  std::lock_guard<std::mutex> lock(resolved_names_.mutex);
+  resolved_names_.remapped.emplace(topic_name, fqdn);
+  return fqdn;
+}
+
+bool
+NodeGraph::lock_graph_cache(std::unique_lock<std::mutex> & lock) const
+{
+  if (!use_graph_cache_ || graph_listener_->is_shutdown()) {
+    return false;
+  }
+  lock = std::unique_lock<std::mutex>(graph_cache_.mutex);
+  if (!graph_cache_.graph_event) {
+    try {
+      // Only the graph event related data structures, which are guarded, are modified.
+      graph_cache_.graph_event = const_cast<NodeGraph *>(this)->get_graph_event();
+    } catch (const rclcpp::graph_listener::GraphListenerShutdownError &) {
+      lock = std::unique_lock<std::mutex>();
+      return false;
+    }
+  }
+  const uint64_t graph_change_count = graph_listener_->get_graph_change_count();
+  if (graph_change_count != graph_cache_.graph_change_count) {
+    graph_cache_.graph_change_count = graph_change_count;
+    graph_cache_.topic_names_and_types[0].reset();
+    graph_cache_.topic_names_and_types[1].reset();
+    graph_cache_.node_names.reset();
+    graph_cache_.graph_snapshot.reset();
+    // Keep the buckets, the same topics are usually counted again.
+    graph_cache_.publisher_counts.clear();
+    graph_cache_.subscriber_counts.clear();
+  }
+  return true;
 }
 
 const rcl_guard_condition_t *
@@ -507,6 +678,7 @@ NodeGraph::get_graph_guard_condition() const
 void
 NodeGraph::notify_graph_change()
 {
+  update_waited_services();
   {
     std::lock_guard<std::mutex> graph_changed_lock(graph_mutex_);
     bool bad_ptr_encountered = false;
@@ -535,7 +707,7 @@ NodeGraph::notify_graph_change()
   graph_cv_.notify_all();
   {
     auto notify_condition_lock = node_base_->acquire_notify_guard_condition_lock();
-    rcl_ret_t ret = rcl_trigger_guard_condition(node_base_->get_notify_guard_condition());
+    rcl_ret_t ret = node_base_->trigger_notify_guard_condition();
     if (RCL_RET_OK != ret) {
       throw_from_rcl_error(ret, "failed to trigger notify guard condition");
     }
@@ -567,28 +739,32 @@ NodeGraph::get_graph_event()
 }
 
 void
-NodeGraph::wait_for_graph_change(
-  rclcpp::Event::SharedPtr event,
-  std::chrono::nanoseconds timeout)
+NodeGraph::check_graph_event(const rclcpp::Event::SharedPtr & event) const
 {
   using rclcpp::exceptions::InvalidEventError;
   using rclcpp::exceptions::EventNotRegisteredError;
   if (!event) {
     throw InvalidEventError();
   }
-  {
-    std::lock_guard<std::mutex> graph_changed_lock(graph_mutex_);
-    bool event_in_graph_events = false;
-    for (const auto & event_wptr : graph_events_) {
-      if (event == event_wptr.lock()) {
-        event_in_graph_events = true;
-        break;
-      }
-    }
-    if (!event_in_graph_events) {
-      throw EventNotRegisteredError();
+  std::lock_guard<std::mutex> graph_changed_lock(graph_mutex_);
+  bool event_in_graph_events = false;
+  for (const auto & event_wptr : graph_events_) {
+    if (event == event_wptr.lock()) {
+      event_in_graph_events = true;
+      break;
     }
   }
+  if (!event_in_graph_events) {
+    throw EventNotRegisteredError();
+  }
+}
+
+void
+NodeGraph::wait_for_graph_change(
+  rclcpp::Event::SharedPtr event,
+  std::chrono::nanoseconds timeout)
+{
+  check_graph_event(event);
   auto pred = [&event, context = node_base_->get_context()]() {
       return event->check() || !rclcpp::ok(context);
     };
@@ -598,6 +774,55 @@ NodeGraph::wait_for_graph_change(
   }
 }
 
+bool
+NodeGraph::wait_for_service_server(
+  rclcpp::Event::SharedPtr event,
+  const std::string & service_name,
+  std::chrono::nanoseconds timeout)
+{
+  check_graph_event(event);
+  auto context = node_base_->get_context();
+  std::unique_lock<std::mutex> graph_lock(graph_mutex_);
+  // The references to the elements of an unordered_map are not invalidated by a rehash.
+  WaitedService & waited_service = waited_services_[service_name];
+  ++waited_service.waiters;
+  const uint64_t listed_count = waited_service.listed_count;
+  graph_cv_.wait_for(
+    graph_lock, timeout,
+    [&waited_service, listed_count, &context]() {
+      return waited_service.listed_count != listed_count || !rclcpp::ok(context);
+    });
+  const bool listed = waited_service.listed_count != listed_count;
+  if (0u == --waited_service.waiters) {
+    waited_services_.erase(service_name);
+  }
+  return listed;
+}
+
+void
+NodeGraph::update_waited_services()
+{
+  {
+    std::lock_guard<std::mutex> graph_changed_lock(graph_mutex_);
+    if (waited_services_.empty()) {
+      return;
+    }
+  }
+  std::map<std::string, std::vector<std::string>> service_names_and_types;
+  try {
+    service_names_and_types = get_service_names_and_types();
+  } catch (const std::exception &) {
+    // The waiters check their service on their timeout, which is bounded.
+    return;
+  }
+  std::lock_guard<std::mutex> graph_changed_lock(graph_mutex_);
+  for (auto & waited_service : waited_services_) {
+    if (service_names_and_types.count(waited_service.first) > 0u) {
+      ++waited_service.second.listed_count;
+    }
+  }
+}
+
 size_t
 NodeGraph::count_graph_users() const
 {
@@ -619,49 +844,12 @@ template<const char * EndpointType, typename FunctionT>
 static std::vector<rclcpp::TopicEndpointInfo>
 get_info_by_topic(
   rclcpp::node_interfaces::NodeBaseInterface * node_base,
-  const std::string & topic_name,
+  const std::string & fqdn,
   bool no_mangle,
   FunctionT rcl_get_info_by_topic)
 {
-  std::string fqdn;
   auto rcl_node_handle = node_base->get_rcl_node_handle();
 
-  if (no_mangle) {
-    fqdn = topic_name;
-  } else {
-    fqdn = rclcpp::expand_topic_or_service_name(
-      topic_name,
-      rcl_node_get_name(rcl_node_handle),
-      rcl_node_get_namespace(rcl_node_handle),
-      false);    // false = not a service
-
-    // Get the node options
-    const rcl_node_options_t * node_options = rcl_node_get_options(rcl_node_handle);
-    if (nullptr == node_options) {
-      throw std::runtime_error("Need valid node options in get_info_by_topic()");
-    }
-    const rcl_arguments_t * global_args = nullptr;
-    if (node_options->use_global_arguments) {
-      global_args = &(rcl_node_handle->context->global_arguments);
-    }
-
-    char * remapped_topic_name = nullptr;
-    rcl_ret_t ret = rcl_remap_topic_name(
-      &(node_options->arguments),
-      global_args,
-      fqdn.c_str(),
-      rcl_node_get_name(rcl_node_handle),
-      rcl_node_get_namespace(rcl_node_handle),
-      node_options->allocator,
-      &remapped_topic_name);
-    if (RCL_RET_OK != ret) {
-      throw_from_rcl_error(ret, std::string("Failed to remap topic name ") + fqdn);
-    } else if (nullptr != remapped_topic_name) {
-      fqdn = remapped_topic_name;
-      node_options->allocator.deallocate(remapped_topic_name, node_options->allocator.state);
-    }
-  }
-
   rcutils_allocator_t allocator = rcutils_get_default_allocator();
   rcl_topic_endpoint_info_array_t info_array = rcl_get_zero_initialized_topic_endpoint_info_array();
   rcl_ret_t ret =
@@ -700,7 +888,7 @@ NodeGraph::get_publishers_info_by_topic(
 {
   return get_info_by_topic<kPublisherEndpointTypeName>(
     node_base_,
-    topic_name,
+    no_mangle ? topic_name : remap_topic_name(topic_name),
     no_mangle,
     rcl_get_publishers_info_by_topic);
 }
@@ -713,11 +901,57 @@ NodeGraph::get_subscriptions_info_by_topic(
 {
   return get_info_by_topic<kSubscriptionEndpointTypeName>(
     node_base_,
-    topic_name,
+    no_mangle ? topic_name : remap_topic_name(topic_name),
     no_mangle,
     rcl_get_subscriptions_info_by_topic);
 }
 
+std::shared_ptr<const rclcpp::GraphSnapshot>
+NodeGraph::get_graph_snapshot() const
+{
+  std::unique_lock<std::mutex> cache_lock;
+  if (!lock_graph_cache(cache_lock)) {
+    // The graph changes are only counted while the node has graph users, so they cannot be
+    // relied upon to detect a change during the query.
+    return std::make_shared<const rclcpp::GraphSnapshot>(query_graph_snapshot(false));
+  }
+  if (!graph_cache_.graph_snapshot) {
+    // The graph event of the cache makes the graph listener count the changes of the graph.
+    graph_cache_.graph_snapshot =
+      std::make_shared<const rclcpp::GraphSnapshot>(query_graph_snapshot(true));
+  }
+  return graph_cache_.graph_snapshot;
+}
+
+rclcpp::GraphSnapshot
+NodeGraph::query_graph_snapshot(bool retry_on_graph_change) const
+{
+  // The graph may change between the queries, they are done again if the graph listener saw a
+  // change meanwhile, a bounded number of times as the graph may keep changing.
+  const int max_attempts = retry_on_graph_change ? 3 : 1;
+  rclcpp::GraphSnapshot snapshot;
+  for (int attempt = 0; attempt < max_attempts; ++attempt) {
+    const uint64_t graph_change_count = graph_listener_->get_graph_change_count();
+    snapshot = rclcpp::GraphSnapshot();
+    snapshot.node_names = to_fully_qualified_node_names(get_node_names_and_namespaces());
+    snapshot.services = get_service_names_and_types();
+    for (auto & topic_name_and_types : query_topic_names_and_types(node_base_, false)) {
+      const std::string & topic_name = topic_name_and_types.first;
+      auto & topic = snapshot.topics[topic_name];
+      topic.types = std::move(topic_name_and_types.second);
+      // The names are already fully qualified and remapped.
+      topic.publishers = get_info_by_topic<kPublisherEndpointTypeName>(
+        node_base_, topic_name, false, rcl_get_publishers_info_by_topic);
+      topic.subscriptions = get_info_by_topic<kSubscriptionEndpointTypeName>(
+        node_base_, topic_name, false, rcl_get_subscriptions_info_by_topic);
+    }
+    if (graph_change_count == graph_listener_->get_graph_change_count()) {
+      break;
+    }
+  }
+  return snapshot;
+}
+
 std::string &
 rclcpp::TopicEndpointInfo::node_name()
 {
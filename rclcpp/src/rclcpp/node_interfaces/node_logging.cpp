@@ -14,16 +14,29 @@
 
 #include "rclcpp/node_interfaces/node_logging.hpp"
 
+#include "../detail/shared_node_infrastructure.hpp"
+
 using rclcpp::node_interfaces::NodeLogging;
 
-NodeLogging::NodeLogging(rclcpp::node_interfaces::NodeBaseInterface * node_base)
+NodeLogging::NodeLogging(
+  rclcpp::node_interfaces::NodeBaseInterface * node_base,
+  bool use_shared_rosout,
+  const rclcpp::QoS & rosout_qos)
 : node_base_(node_base)
 {
   logger_ = rclcpp::get_logger(this->get_logger_name());
+  if (use_shared_rosout) {
+    shared_infrastructure_ = rclcpp::detail::SharedNodeInfrastructure::get(
+      node_base_->get_context());
+    shared_infrastructure_->add_rosout_logger(logger_.get_name(), rosout_qos);
+  }
 }
 
 NodeLogging::~NodeLogging()
 {
+  if (shared_infrastructure_) {
+    shared_infrastructure_->remove_rosout_logger(logger_.get_name());
+  }
 }
 
 rclcpp::Logger
@@ -16,29 +16,67 @@
 
 #include <rcl_yaml_param_parser/parser.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <functional>
+#include <initializer_list>
 #include <limits>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "rcl_interfaces/srv/list_parameters.hpp"
 #include "rclcpp/create_publisher.hpp"
+#include "rclcpp/create_timer.hpp"
+#include "rclcpp/graph_listener.hpp"
+#include "rclcpp/logging.hpp"
 #include "rclcpp/parameter_map.hpp"
 #include "rcutils/logging_macros.h"
+#include "rmw/impl/cpp/demangle.hpp"
 #include "rmw/qos_profiles.h"
 
+#include "../detail/local_parameter_events.hpp"
 #include "../detail/resolve_parameter_overrides.hpp"
+#include "../detail/shared_node_infrastructure.hpp"
+#include "../parameter_service_names.hpp"
 
 using rclcpp::node_interfaces::NodeParameters;
 
+/// Creates the lazy parameter services of its node parameters after the graph changes.
+class NodeParameters::ParameterClientObserver : public rclcpp::graph_listener::GraphObserver
+{
+public:
+  ParameterClientObserver(
+    NodeParameters & node_parameters,
+    const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr & node_base)
+  : node_parameters_(node_parameters),
+    node_base_(node_base)
+  {}
+
+  const rcl_guard_condition_t *
+  get_graph_guard_condition() const override
+  {
+    return rcl_node_get_graph_guard_condition(node_base_->get_rcl_node_handle());
+  }
+
+  void
+  on_graph_change() override
+  {
+    node_parameters_.create_parameter_services_if_discovered();
+  }
+
+private:
+  NodeParameters & node_parameters_;
+  rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base_;
+};
+
 NodeParameters::NodeParameters(
   const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base,
   const rclcpp::node_interfaces::NodeLoggingInterface::SharedPtr node_logging,
@@ -51,9 +89,15 @@ NodeParameters::NodeParameters(
   const rclcpp::QoS & parameter_event_qos,
   const rclcpp::PublisherOptionsBase & parameter_event_publisher_options,
   bool allow_undeclared_parameters,
-  bool automatically_declare_parameters_from_overrides)
+  bool automatically_declare_parameters_from_overrides,
+  const rclcpp::node_interfaces::NodeTimersInterface::SharedPtr node_timers,
+  std::chrono::nanoseconds parameter_event_coalescing_period,
+  bool use_shared_infrastructure,
+  bool lazy_parameter_services,
+  const rclcpp::node_interfaces::NodeGraphInterface::SharedPtr node_graph)
 : allow_undeclared_(allow_undeclared_parameters),
   events_publisher_(nullptr),
+  node_graph_(node_graph),
   node_logging_(node_logging),
   node_clock_(node_clock)
 {
@@ -65,17 +109,62 @@ NodeParameters::NodeParameters(
     parameter_event_publisher_options);
   publisher_options.allocator = std::make_shared<AllocatorT>();
 
-  if (start_parameter_services) {
-    parameter_service_ = std::make_shared<ParameterService>(node_base, node_services, this);
+  if (use_shared_infrastructure && (start_parameter_services || start_parameter_event_publisher)) {
+    shared_infrastructure_ =
+      rclcpp::detail::SharedNodeInfrastructure::get(node_base->get_context());
+  }
+
+  lazy_parameter_services = lazy_parameter_services && !shared_infrastructure_;
+  if (lazy_parameter_services && start_parameter_services && !node_graph) {
+    throw std::invalid_argument("lazy parameter services need the node graph interface");
+  }
+
+  if (start_parameter_services && !shared_infrastructure_) {
+    if (lazy_parameter_services) {
+      create_parameter_service_ = [this, node_base, node_services]() {
+          parameter_service_ = std::make_shared<ParameterService>(node_base, node_services, this);
+        };
+    } else {
+      parameter_service_ = std::make_shared<ParameterService>(node_base, node_services, this);
+    }
   }
 
   if (start_parameter_event_publisher) {
-    // TODO(ivanpauno): Qos of the `/parameters_event` topic should be somehow overridable.
-    events_publisher_ = rclcpp::create_publisher<MessageT, AllocatorT, PublisherT>(
-      node_topics,
-      "/parameter_events",
-      parameter_event_qos,
-      publisher_options);
+    if (shared_infrastructure_) {
+      events_publisher_ = shared_infrastructure_->get_parameter_event_publisher(
+        parameter_event_qos, parameter_event_publisher_options);
+    } else {
+      // TODO(ivanpauno): Qos of the `/parameters_event` topic should be somehow overridable.
+      create_events_publisher_ = [this, node_topics, parameter_event_qos, publisher_options]() {
+          events_publisher_ = rclcpp::create_publisher<MessageT, AllocatorT, PublisherT>(
+            node_topics,
+            "/parameter_events",
+            parameter_event_qos,
+            publisher_options);
+        };
+      if (!lazy_parameter_services) {
+        create_events_publisher_();
+        create_events_publisher_ = nullptr;
+      }
+    }
+
+    if (node_timers && parameter_event_coalescing_period > std::chrono::nanoseconds(0)) {
+      coalescing_timer_ = rclcpp::create_wall_timer(
+        parameter_event_coalescing_period,
+        [this]() {
+          std::lock_guard<std::recursive_mutex> lock(mutex_);
+          coalescing_timer_->cancel();
+          // A batch publishes the pending event when it ends.
+          if (0u == parameter_event_batch_depth_) {
+            publish_pending_parameter_event();
+          }
+        },
+        nullptr,
+        node_base.get(),
+        node_timers.get());
+      // Started by the first event of each coalescing period.
+      coalescing_timer_->cancel();
+    }
   }
 
   // Get the node options
@@ -88,35 +177,107 @@ NodeParameters::NodeParameters(
     throw std::runtime_error("Need valid node options in NodeParameters");
   }
 
-  const rcl_arguments_t * global_args = nullptr;
+  // The parameter files of the global arguments are converted once and shared by the nodes.
+  std::shared_ptr<rclcpp::detail::GlobalParameterOverrides> global_overrides;
   if (options->use_global_arguments) {
-    auto context_ptr = node_base->get_context()->get_rcl_context();
-    global_args = &(context_ptr->global_arguments);
+    auto context = node_base->get_context();
+    auto context_ptr = context->get_rcl_context();
+    global_overrides = context->get_sub_context<rclcpp::detail::GlobalParameterOverrides>(
+      &(context_ptr->global_arguments));
   }
   combined_name_ = node_base->get_fully_qualified_name();
 
   parameter_overrides_ = rclcpp::detail::resolve_parameter_overrides(
-    combined_name_, parameter_overrides, &options->arguments, global_args);
+    combined_name_, parameter_overrides, &options->arguments, global_overrides.get());
+
+  // The parameter event handlers of the context get the events of the node in process.
+  if (start_parameter_event_publisher) {
+    local_parameter_events_ =
+      rclcpp::detail::LocalParameterEvents::get(node_base->get_context());
+    local_parameter_events_->add_node(combined_name_);
+  }
 
   // If asked, initialize any parameters that ended up in the initial parameter values,
   // but did not get declared explcitily by this point.
   if (automatically_declare_parameters_from_overrides) {
     rcl_interfaces::msg::ParameterDescriptor descriptor;
     descriptor.dynamic_typing = true;
-    for (const auto & pair : this->get_parameter_overrides()) {
-      if (!this->has_parameter(pair.first)) {
-        this->declare_parameter(
-          pair.first,
-          pair.second,
-          descriptor,
-          true);
+    // A single event is published for all the parameters declared from the overrides.
+    this->begin_parameter_event_batch();
+    try {
+      for (const auto & pair : this->get_parameter_overrides()) {
+        if (!this->has_parameter(pair.first)) {
+          this->declare_parameter(
+            pair.first,
+            pair.second,
+            descriptor,
+            true);
+        }
+      }
+    } catch (...) {
+      this->end_parameter_event_batch();
+      if (local_parameter_events_) {
+        local_parameter_events_->remove_node(combined_name_);
       }
+      throw;
     }
+    this->end_parameter_event_batch();
+  }
+
+  // Last, since the shared parameter services may use the parameters from now on.
+  if (start_parameter_services && shared_infrastructure_) {
+    shared_infrastructure_->add_node_parameters(combined_name_, this);
+  }
+
+  // The lazy parameter services too.
+  if (create_parameter_service_) {
+    for (const char * service_name : {
+        parameter_service_names::get_parameters,
+        parameter_service_names::get_parameter_types,
+        parameter_service_names::set_parameters,
+        parameter_service_names::set_parameters_atomically,
+        parameter_service_names::describe_parameters,
+        parameter_service_names::list_parameters})
+    {
+      lazy_parameter_service_names_.push_back(combined_name_ + "/" + service_name);
+    }
+    auto context = node_base->get_context();
+    graph_listener_ = context->get_sub_context<rclcpp::graph_listener::GraphListener>(context);
+    parameter_client_observer_ = std::make_unique<ParameterClientObserver>(*this, node_base);
+    graph_listener_->add_graph_observer(parameter_client_observer_.get());
+    try {
+      graph_listener_->start_if_not_started();
+    } catch (...) {
+      graph_listener_->remove_graph_observer(parameter_client_observer_.get());
+      throw;
+    }
+    // The clients discovered before the graph listener observes the node.
+    create_parameter_services_if_discovered();
   }
 }
 
 NodeParameters::~NodeParameters()
-{}
+{
+  if (parameter_client_observer_) {
+    try {
+      graph_listener_->remove_graph_observer(parameter_client_observer_.get());
+    } catch (const std::exception & exception) {
+      RCLCPP_ERROR(
+        node_logging_->get_logger(),
+        "caught %s exception when removing the graph observer of the parameter services: %s",
+        rmw::impl::cpp::demangle(exception).c_str(), exception.what());
+    }
+  }
+  if (shared_infrastructure_) {
+    shared_infrastructure_->remove_node_parameters(this);
+  }
+  if (local_parameter_events_) {
+    local_parameter_events_->remove_node(combined_name_);
+  }
+  if (coalescing_timer_) {
+    coalescing_timer_->cancel();
+  }
+}
 
 RCLCPP_LOCAL
 bool
@@ -399,9 +560,7 @@ declare_parameter_helper(
   const std::map<std::string, rclcpp::ParameterValue> & overrides,
   CallbacksContainerType & callback_container,
   const OnParametersSetCallbackType & callback,
-  rclcpp::Publisher<rcl_interfaces::msg::ParameterEvent> * events_publisher,
-  const std::string & combined_name,
-  rclcpp::node_interfaces::NodeClockInterface & node_clock)
+  rcl_interfaces::msg::ParameterEvent & parameter_event)
 {
   // TODO(sloretz) parameter name validation
   if (name.empty()) {
@@ -427,7 +586,6 @@ declare_parameter_helper(
     parameter_descriptor.type = static_cast<uint8_t>(type);
   }
 
-  rcl_interfaces::msg::ParameterEvent parameter_event;
   auto result = __declare_parameter_common(
     name,
     default_value,
@@ -454,13 +612,6 @@ declare_parameter_helper(
             "parameter '" + name + "' could not be set: " + result.reason);
   }
 
-  // Publish if events_publisher_ is not nullptr, which may be if disabled in the constructor.
-  if (nullptr != events_publisher) {
-    parameter_event.node = combined_name;
-    parameter_event.stamp = node_clock.get_clock()->now();
-    events_publisher->publish(parameter_event);
-  }
-
   return parameters.at(name).value;
 }
 
@@ -482,7 +633,8 @@ NodeParameters::declare_parameter(
   std::lock_guard<std::recursive_mutex> lock(mutex_);
   ParameterMutationRecursionGuard guard(parameter_modification_enabled_);
 
-  return declare_parameter_helper(
+  rcl_interfaces::msg::ParameterEvent parameter_event;
+  const rclcpp::ParameterValue & value = declare_parameter_helper(
     name,
     rclcpp::PARAMETER_NOT_SET,
     default_value,
@@ -492,9 +644,10 @@ NodeParameters::declare_parameter(
     parameter_overrides_,
     on_parameters_set_callback_container_,
     on_parameters_set_callback_,
-    events_publisher_.get(),
-    combined_name_,
-    *node_clock_);
+    parameter_event);
+  publish_parameter_event(std::move(parameter_event));
+  update_parameter_handles(name);
+  return value;
 }
 
 const rclcpp::ParameterValue &
@@ -518,7 +671,8 @@ NodeParameters::declare_parameter(
             "with `dynamic_typing=true`"};
   }
 
-  return declare_parameter_helper(
+  rcl_interfaces::msg::ParameterEvent parameter_event;
+  const rclcpp::ParameterValue & value = declare_parameter_helper(
     name,
     type,
     rclcpp::ParameterValue{},
@@ -528,9 +682,10 @@ NodeParameters::declare_parameter(
     parameter_overrides_,
     on_parameters_set_callback_container_,
     on_parameters_set_callback_,
-    events_publisher_.get(),
-    combined_name_,
-    *node_clock_);
+    parameter_event);
+  publish_parameter_event(std::move(parameter_event));
+  update_parameter_handles(name);
+  return value;
 }
 
 void
@@ -556,6 +711,7 @@ NodeParameters::undeclare_parameter(const std::string & name)
   }
 
   parameters_.erase(parameter_info);
+  update_parameter_handles(name);
 }
 
 bool
@@ -777,12 +933,12 @@ NodeParameters::set_parameters_atomically(const std::vector<rclcpp::Parameter> &
     parameter_event_msg.changed_parameters.push_back(parameter.to_parameter_msg());
   }
 
-  // Publish if events_publisher_ is not nullptr, which may be if disabled in the constructor.
-  if (nullptr != events_publisher_) {
-    parameter_event_msg.stamp = node_clock_->get_clock()->now();
-    events_publisher_->publish(parameter_event_msg);
+  for (const auto & parameter : *parameters_to_be_set) {
+    update_parameter_handles(parameter.get_name());
   }
 
+  publish_parameter_event(std::move(parameter_event_msg));
+
   return result;
 }
 
@@ -849,6 +1005,32 @@ NodeParameters::get_parameter(
   }
 }
 
+namespace
+{
+
+/// Call a function with each parameter whose name starts with a prefix, in name order.
+/**
+ * The parameters are sorted by name, so the matching ones are contiguous and found without
+ * walking the others.
+ */
+template<typename ParametersT, typename FunctionT>
+void
+for_each_parameter_with_name_prefix(
+  ParametersT & parameters,
+  const std::string & name_prefix,
+  FunctionT && function)
+{
+  for (
+    auto it = parameters.lower_bound(name_prefix);
+    it != parameters.end() && 0 == it->first.compare(0, name_prefix.length(), name_prefix);
+    ++it)
+  {
+    function(*it);
+  }
+}
+
+}  // namespace
+
 bool
 NodeParameters::get_parameters_by_prefix(
   const std::string & prefix,
@@ -859,13 +1041,16 @@ NodeParameters::get_parameters_by_prefix(
   std::string prefix_with_dot = prefix.empty() ? prefix : prefix + ".";
   bool ret = false;
 
-  for (const auto & param : parameters_) {
-    if (param.first.find(prefix_with_dot) == 0 && param.first.length() > prefix_with_dot.length()) {
-      // Found one!
-      parameters[param.first.substr(prefix_with_dot.length())] = rclcpp::Parameter(param.second);
-      ret = true;
-    }
-  }
+  for_each_parameter_with_name_prefix(
+    parameters_, prefix_with_dot,
+    [&prefix_with_dot, &parameters, &ret](const auto & param) {
+      if (param.first.length() > prefix_with_dot.length()) {
+        // Found one!
+        parameters[param.first.substr(prefix_with_dot.length())] =
+        rclcpp::Parameter(param.second);
+        ret = true;
+      }
+    });
 
   return ret;
 }
@@ -932,36 +1117,54 @@ NodeParameters::list_parameters(const std::vector<std::string> & prefixes, uint6
 
   // TODO(mikaelarguedas) define parameter separator different from "/" to avoid ambiguity
   // using "." for now
-  const char * separator = ".";
-  for (auto & kv : parameters_) {
-    bool get_all = (prefixes.size() == 0) &&
-      ((depth == rcl_interfaces::srv::ListParameters::Request::DEPTH_RECURSIVE) ||
-      (static_cast<uint64_t>(std::count(kv.first.begin(), kv.first.end(), *separator)) < depth));
-    bool prefix_matches = std::any_of(
-      prefixes.cbegin(), prefixes.cend(),
-      [&kv, &depth, &separator](const std::string & prefix) {
-        if (kv.first == prefix) {
-          return true;
-        } else if (kv.first.find(prefix + separator) == 0) {
-          size_t length = prefix.length();
-          std::string substr = kv.first.substr(length);
-          // Cast as unsigned integer to avoid warning
-          return (depth == rcl_interfaces::srv::ListParameters::Request::DEPTH_RECURSIVE) ||
-          (static_cast<uint64_t>(std::count(substr.begin(), substr.end(), *separator)) < depth);
-        }
-        return false;
-      });
-    if (get_all || prefix_matches) {
-      result.names.push_back(kv.first);
-      size_t last_separator = kv.first.find_last_of(separator);
-      if (std::string::npos != last_separator) {
-        std::string prefix = kv.first.substr(0, last_separator);
-        if (
-          std::find(result.prefixes.cbegin(), result.prefixes.cend(), prefix) ==
-          result.prefixes.cend())
-        {
-          result.prefixes.push_back(prefix);
-        }
+  const char separator = '.';
+  auto is_within_depth = [depth, separator](const std::string & name, size_t start) {
+      // Cast as unsigned integer to avoid warning
+      return (depth == rcl_interfaces::srv::ListParameters::Request::DEPTH_RECURSIVE) ||
+             (static_cast<uint64_t>(std::count(name.begin() + start, name.end(), separator)) <
+             depth);
+    };
+
+  // The parameters listed, in name order, each once even if it matches several prefixes.
+  std::vector<const std::string *> names;
+  if (prefixes.empty()) {
+    for (const auto & kv : parameters_) {
+      if (is_within_depth(kv.first, 0)) {
+        names.push_back(&kv.first);
+      }
+    }
+  } else {
+    for (const auto & prefix : prefixes) {
+      auto it = parameters_.find(prefix);
+      if (it != parameters_.end()) {
+        names.push_back(&it->first);
+      }
+      for_each_parameter_with_name_prefix(
+        parameters_, prefix + separator,
+        [&names, &is_within_depth, &prefix](const auto & kv) {
+          if (is_within_depth(kv.first, prefix.length())) {
+            names.push_back(&kv.first);
+          }
+        });
+    }
+    if (prefixes.size() > 1) {
+      auto name_less = [](const std::string * lhs, const std::string * rhs) {
+          return *lhs < *rhs;
+        };
+      std::sort(names.begin(), names.end(), name_less);
+      names.erase(std::unique(names.begin(), names.end()), names.end());
+    }
+  }
+
+  result.names.reserve(names.size());
+  std::unordered_set<std::string> listed_prefixes;
+  for (const std::string * name : names) {
+    result.names.push_back(*name);
+    size_t last_separator = name->find_last_of(separator);
+    if (std::string::npos != last_separator) {
+      std::string prefix = name->substr(0, last_separator);
+      if (listed_prefixes.insert(prefix).second) {
+        result.prefixes.push_back(std::move(prefix));
       }
     }
   }
@@ -1006,3 +1209,202 @@ NodeParameters::get_parameter_overrides() const
 {
   return parameter_overrides_;
 }
+
+void
+NodeParameters::add_parameter_handle(const rclcpp::detail::ParameterHandleBase::SharedPtr & handle)
+{
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+  const std::string & name = handle->get_name();
+  auto parameter_info = parameters_.find(name);
+  if (parameter_info == parameters_.end()) {
+    if (!allow_undeclared_) {
+      throw rclcpp::exceptions::ParameterNotDeclaredException(name);
+    }
+  } else if (
+    rclcpp::PARAMETER_NOT_SET != parameter_info->second.value.get_type() &&
+    !handle->update(parameter_info->second.value))
+  {
+    throw rclcpp::exceptions::InvalidParameterTypeException(
+            name, "the parameter type does not match the type of the handle");
+  }
+  parameter_handles_.emplace(name, handle);
+}
+
+void
+NodeParameters::update_parameter_handles(const std::string & name)
+{
+  if (parameter_handles_.empty()) {
+    return;
+  }
+  auto parameter_info = parameters_.find(name);
+  auto range = parameter_handles_.equal_range(name);
+  for (auto it = range.first; it != range.second; ) {
+    auto handle = it->second.lock();
+    if (!handle) {
+      it = parameter_handles_.erase(it);
+      continue;
+    }
+    if (parameter_info == parameters_.end()) {
+      handle->invalidate();
+    } else {
+      handle->update(parameter_info->second.value);
+    }
+    ++it;
+  }
+}
+
+void
+NodeParameters::begin_parameter_event_batch()
+{
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+  ++parameter_event_batch_depth_;
+}
+
+void
+NodeParameters::end_parameter_event_batch()
+{
+  std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+  if (0u == parameter_event_batch_depth_) {
+    throw std::runtime_error("end_parameter_event_batch() called without a batch");
+  }
+  if (0u == --parameter_event_batch_depth_) {
+    if (coalescing_timer_) {
+      coalescing_timer_->cancel();
+    }
+    publish_pending_parameter_event();
+  }
+}
+
+// Merge a parameter event into the events which are not published yet, so that the merged
+// event describes the net change, e.g. a parameter declared then deleted is not in it.
+static void
+merge_parameter_event(
+  rcl_interfaces::msg::ParameterEvent & pending_event,
+  rcl_interfaces::msg::ParameterEvent && parameter_event)
+{
+  using ParameterMsgs = std::vector<rcl_interfaces::msg::Parameter>;
+  auto find = [](ParameterMsgs & parameters, const std::string & name) {
+      return std::find_if(
+        parameters.begin(), parameters.end(),
+        [&name](const rcl_interfaces::msg::Parameter & parameter) {
+          return parameter.name == name;
+        });
+    };
+
+  for (auto & parameter : parameter_event.new_parameters) {
+    auto deleted = find(pending_event.deleted_parameters, parameter.name);
+    if (deleted != pending_event.deleted_parameters.end()) {
+      // Deleted, then declared again.
+      pending_event.deleted_parameters.erase(deleted);
+      pending_event.changed_parameters.push_back(std::move(parameter));
+    } else {
+      pending_event.new_parameters.push_back(std::move(parameter));
+    }
+  }
+  for (auto & parameter : parameter_event.changed_parameters) {
+    auto added = find(pending_event.new_parameters, parameter.name);
+    if (added != pending_event.new_parameters.end()) {
+      added->value = std::move(parameter.value);
+      continue;
+    }
+    auto changed = find(pending_event.changed_parameters, parameter.name);
+    if (changed != pending_event.changed_parameters.end()) {
+      changed->value = std::move(parameter.value);
+    } else {
+      pending_event.changed_parameters.push_back(std::move(parameter));
+    }
+  }
+  for (auto & parameter : parameter_event.deleted_parameters) {
+    auto added = find(pending_event.new_parameters, parameter.name);
+    if (added != pending_event.new_parameters.end()) {
+      // Declared, then deleted.
+      pending_event.new_parameters.erase(added);
+      continue;
+    }
+    auto changed = find(pending_event.changed_parameters, parameter.name);
+    if (changed != pending_event.changed_parameters.end()) {
+      pending_event.changed_parameters.erase(changed);
+    }
+    pending_event.deleted_parameters.push_back(std::move(parameter));
+  }
+}
+
+void
+NodeParameters::publish_parameter_event(rcl_interfaces::msg::ParameterEvent && parameter_event)
+{
+  // Publish if events_publisher_ is not nullptr, which may be if disabled in the constructor.
+  if (nullptr == events_publisher_) {
+    if (!create_events_publisher_) {
+      return;
+    }
+    // A lazy publisher is created for the first change, not for the declarations.
+    if (!lazy_parameter_services_created_ && parameter_event.changed_parameters.empty() &&
+      parameter_event.deleted_parameters.empty())
+    {
+      return;
+    }
+    create_events_publisher_();
+    create_events_publisher_ = nullptr;
+  }
+  if (0u == parameter_event_batch_depth_ && !coalescing_timer_) {
+    parameter_event.node = combined_name_;
+    parameter_event.stamp = node_clock_->get_clock()->now();
+    events_publisher_->publish(parameter_event);
+    local_parameter_events_->notify(parameter_event);
+    return;
+  }
+  if (!has_pending_parameter_event_ && 0u == parameter_event_batch_depth_) {
+    // First event of a coalescing period.
+    coalescing_timer_->reset();
+  }
+  merge_parameter_event(pending_parameter_event_, std::move(parameter_event));
+  has_pending_parameter_event_ = true;
+}
+
+void
+NodeParameters::create_parameter_services_if_discovered()
+{
+  std::lock_guard<std::mutex> lock(lazy_parameter_services_mutex_);
+  if (!create_parameter_service_) {
+    return;
+  }
+  // The names of the services with a client, since the services are not created yet.
+  const auto service_names_and_types = node_graph_->get_service_names_and_types();
+  const bool discovered = std::any_of(
+    lazy_parameter_service_names_.begin(), lazy_parameter_service_names_.end(),
+    [&service_names_and_types](const std::string & service_name) {
+      return service_names_and_types.count(service_name) > 0u;
+    });
+  if (!discovered) {
+    return;
+  }
+  create_parameter_service_();
+  create_parameter_service_ = nullptr;
+  lazy_parameter_services_created_ = true;
+  RCLCPP_DEBUG(
+    node_logging_->get_logger(), "created the parameter services for a discovered client");
+}
+
+void
+NodeParameters::publish_pending_parameter_event()
+{
+  if (!has_pending_parameter_event_) {
+    return;
+  }
+  rcl_interfaces::msg::ParameterEvent parameter_event = std::move(pending_parameter_event_);
+  pending_parameter_event_ = rcl_interfaces::msg::ParameterEvent();
+  has_pending_parameter_event_ = false;
+  if (parameter_event.new_parameters.empty() && parameter_event.changed_parameters.empty() &&
+    parameter_event.deleted_parameters.empty())
+  {
+    // The changes cancelled each other out.
+    return;
+  }
+  parameter_event.node = combined_name_;
+  parameter_event.stamp = node_clock_->get_clock()->now();
+  events_publisher_->publish(parameter_event);
+  local_parameter_events_->notify(parameter_event);
+}
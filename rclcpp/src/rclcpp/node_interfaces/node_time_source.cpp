@@ -28,7 +28,9 @@ NodeTimeSource::NodeTimeSource(
   rclcpp::node_interfaces::NodeClockInterface::SharedPtr node_clock,
   rclcpp::node_interfaces::NodeParametersInterface::SharedPtr node_parameters,
   const rclcpp::QoS & qos,
-  bool use_clock_thread)
+  bool use_clock_thread,
+  bool use_shared_clock_source,
+  bool use_shared_infrastructure)
 : node_base_(node_base),
   node_topics_(node_topics),
   node_graph_(node_graph),
@@ -38,6 +40,8 @@ NodeTimeSource::NodeTimeSource(
   node_parameters_(node_parameters),
   time_source_(qos, use_clock_thread)
 {
+  time_source_.set_use_shared_clock_source(use_shared_clock_source);
+  time_source_.set_use_shared_infrastructure(use_shared_infrastructure);
   time_source_.attachNode(
     node_base_,
     node_topics_,
@@ -55,14 +55,15 @@ NodeTopics::add_publisher(
     callback_group = node_base_->get_default_callback_group();
   }
 
-  for (auto & publisher_event : publisher->get_event_handlers()) {
-    callback_group->add_waitable(publisher_event);
+  auto publisher_events = publisher->get_event_handlers_waitable();
+  if (nullptr != publisher_events) {
+    callback_group->add_waitable(publisher_events);
   }
 
   // Notify the executor that a new publisher was created using the parent Node.
   {
     auto notify_guard_condition_lock = node_base_->acquire_notify_guard_condition_lock();
-    if (rcl_trigger_guard_condition(node_base_->get_notify_guard_condition()) != RCL_RET_OK) {
+    if (node_base_->trigger_notify_guard_condition() != RCL_RET_OK) {
       throw std::runtime_error(
               std::string("Failed to notify wait set on publisher creation: ") +
               rmw_get_error_string().str);
@@ -97,8 +98,9 @@ NodeTopics::add_subscription(
 
   callback_group->add_subscription(subscription);
 
-  for (auto & subscription_event : subscription->get_event_handlers()) {
-    callback_group->add_waitable(subscription_event);
+  auto subscription_events = subscription->get_event_handlers_waitable();
+  if (nullptr != subscription_events) {
+    callback_group->add_waitable(subscription_events);
   }
 
   auto intra_process_waitable = subscription->get_intra_process_waitable();
@@ -110,7 +112,7 @@ NodeTopics::add_subscription(
   // Notify the executor that a new subscription was created using the parent Node.
   {
     auto notify_guard_condition_lock = node_base_->acquire_notify_guard_condition_lock();
-    auto ret = rcl_trigger_guard_condition(node_base_->get_notify_guard_condition());
+    auto ret = node_base_->trigger_notify_guard_condition();
     if (ret != RCL_RET_OK) {
       using rclcpp::exceptions::throw_from_rcl_error;
       throw_from_rcl_error(ret, "failed to notify wait set on subscription creation");
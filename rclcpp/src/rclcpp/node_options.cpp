@@ -77,11 +77,17 @@ NodeOptions::operator=(const NodeOptions & other)
     this->enable_topic_statistics_ = other.enable_topic_statistics_;
     this->start_parameter_services_ = other.start_parameter_services_;
     this->start_parameter_event_publisher_ = other.start_parameter_event_publisher_;
+    this->lazy_parameter_services_ = other.lazy_parameter_services_;
+    this->lazy_lifecycle_services_ = other.lazy_lifecycle_services_;
     this->clock_qos_ = other.clock_qos_;
     this->use_clock_thread_ = other.use_clock_thread_;
+    this->use_shared_clock_source_ = other.use_shared_clock_source_;
+    this->use_graph_cache_ = other.use_graph_cache_;
+    this->use_shared_infrastructure_ = other.use_shared_infrastructure_;
     this->parameter_event_qos_ = other.parameter_event_qos_;
     this->rosout_qos_ = other.rosout_qos_;
     this->parameter_event_publisher_options_ = other.parameter_event_publisher_options_;
+    this->parameter_event_coalescing_period_ = other.parameter_event_coalescing_period_;
     this->allow_undeclared_parameters_ = other.allow_undeclared_parameters_;
     this->automatically_declare_parameters_from_overrides_ =
       other.automatically_declare_parameters_from_overrides_;
@@ -99,7 +105,8 @@ NodeOptions::get_rcl_node_options() const
     *node_options_ = rcl_node_get_default_options();
     node_options_->allocator = this->allocator_;
     node_options_->use_global_arguments = this->use_global_arguments_;
-    node_options_->enable_rosout = this->enable_rosout_;
+    // The log records of a node using the shared "/rosout" publisher are published by rclcpp.
+    node_options_->enable_rosout = this->enable_rosout_ && !this->use_shared_rosout();
     node_options_->rosout_qos = this->rosout_qos_.get_rmw_qos_profile();
 
     int c_argc = 0;
@@ -143,6 +150,7 @@ NodeOptions::context() const
 NodeOptions &
 NodeOptions::context(rclcpp::Context::SharedPtr context)
 {
+  this->node_options_.reset();  // reset node options to make it be recreated on next access.
   this->context_ = context;
   return *this;
 }
@@ -260,6 +268,32 @@ NodeOptions::start_parameter_event_publisher(bool start_parameter_event_publishe
   return *this;
 }
 
+bool
+NodeOptions::lazy_parameter_services() const
+{
+  return this->lazy_parameter_services_;
+}
+
+NodeOptions &
+NodeOptions::lazy_parameter_services(bool lazy_parameter_services)
+{
+  this->lazy_parameter_services_ = lazy_parameter_services;
+  return *this;
+}
+
+bool
+NodeOptions::lazy_lifecycle_services() const
+{
+  return this->lazy_lifecycle_services_;
+}
+
+NodeOptions &
+NodeOptions::lazy_lifecycle_services(bool lazy_lifecycle_services)
+{
+  this->lazy_lifecycle_services_ = lazy_lifecycle_services;
+  return *this;
+}
+
 const rclcpp::QoS &
 NodeOptions::clock_qos() const
 {
@@ -286,6 +320,53 @@ NodeOptions::use_clock_thread(bool use_clock_thread)
   return *this;
 }
 
+bool
+NodeOptions::use_shared_clock_source() const
+{
+  return this->use_shared_clock_source_;
+}
+
+NodeOptions &
+NodeOptions::use_shared_clock_source(bool use_shared_clock_source)
+{
+  this->use_shared_clock_source_ = use_shared_clock_source;
+  return *this;
+}
+
+bool
+NodeOptions::use_graph_cache() const
+{
+  return this->use_graph_cache_;
+}
+
+NodeOptions &
+NodeOptions::use_graph_cache(bool use_graph_cache)
+{
+  this->use_graph_cache_ = use_graph_cache;
+  return *this;
+}
+
+bool
+NodeOptions::use_shared_infrastructure() const
+{
+  return this->use_shared_infrastructure_;
+}
+
+NodeOptions &
+NodeOptions::use_shared_infrastructure(bool use_shared_infrastructure)
+{
+  this->node_options_.reset();  // reset node options to make it be recreated on next access.
+  this->use_shared_infrastructure_ = use_shared_infrastructure;
+  return *this;
+}
+
+bool
+NodeOptions::use_shared_rosout() const
+{
+  return this->enable_rosout_ && (this->use_shared_infrastructure_ ||
+         (this->context_ && this->context_->get_init_options().rosout_aggregation().enabled));
+}
+
 const rclcpp::QoS &
 NodeOptions::parameter_event_qos() const
 {
@@ -327,6 +408,20 @@ NodeOptions::parameter_event_publisher_options(
   return *this;
 }
 
+const std::chrono::nanoseconds &
+NodeOptions::parameter_event_coalescing_period() const
+{
+  return parameter_event_coalescing_period_;
+}
+
+NodeOptions &
+NodeOptions::parameter_event_coalescing_period(
+  const std::chrono::nanoseconds & parameter_event_coalescing_period)
+{
+  parameter_event_coalescing_period_ = parameter_event_coalescing_period;
+  return *this;
+}
+
 bool
 NodeOptions::allow_undeclared_parameters() const
 {
@@ -19,13 +19,18 @@
 #include <functional>
 #include <future>
 #include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#include "rclcpp/logging.hpp"
+
 #include "./parameter_service_names.hpp"
 
+using rclcpp::AsyncMultiNodeParametersClient;
 using rclcpp::AsyncParametersClient;
 using rclcpp::SyncParametersClient;
 
@@ -390,17 +395,307 @@ AsyncParametersClient::wait_for_service_nanoseconds(std::chrono::nanoseconds tim
   return true;
 }
 
+AsyncMultiNodeParametersClient::AsyncMultiNodeParametersClient(
+  const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base_interface,
+  const rclcpp::node_interfaces::NodeTopicsInterface::SharedPtr node_topics_interface,
+  const rclcpp::node_interfaces::NodeGraphInterface::SharedPtr node_graph_interface,
+  const rclcpp::node_interfaces::NodeServicesInterface::SharedPtr node_services_interface,
+  const std::vector<std::string> & remote_node_names,
+  const rmw_qos_profile_t & qos_profile,
+  rclcpp::CallbackGroup::SharedPtr group)
+{
+  for (const auto & remote_node_name : remote_node_names) {
+    if (clients_.count(remote_node_name) != 0u) {
+      throw std::invalid_argument("remote node '" + remote_node_name + "' is repeated");
+    }
+    clients_.emplace(
+      remote_node_name,
+      std::make_shared<AsyncParametersClient>(
+        node_base_interface,
+        node_topics_interface,
+        node_graph_interface,
+        node_services_interface,
+        remote_node_name,
+        qos_profile,
+        group));
+  }
+}
+
+std::vector<std::string>
+AsyncMultiNodeParametersClient::get_remote_node_names() const
+{
+  std::vector<std::string> remote_node_names;
+  remote_node_names.reserve(clients_.size());
+  for (const auto & pair : clients_) {
+    remote_node_names.push_back(pair.first);
+  }
+  return remote_node_names;
+}
+
+AsyncParametersClient::SharedPtr
+AsyncMultiNodeParametersClient::get_client(const std::string & remote_node_name) const
+{
+  auto it = clients_.find(remote_node_name);
+  if (it == clients_.end()) {
+    throw std::out_of_range("'" + remote_node_name + "' is not a remote node of the client");
+  }
+  return it->second;
+}
+
+namespace
+{
+
+// Combine the futures of the requests sent to several remote nodes into one future, ready
+// once every request completed.
+template<typename ResultT>
+class CombinedResults
+{
+public:
+  using ResultsByNode = AsyncMultiNodeParametersClient::ResultsByNode<ResultT>;
+  using Callback = std::function<void (std::shared_future<ResultsByNode>)>;
+
+  CombinedResults(size_t request_count, Callback callback)
+  : remaining_(request_count),
+    future_(promise_.get_future().share()),
+    callback_(std::move(callback))
+  {
+  }
+
+  std::shared_future<ResultsByNode>
+  get_future() const
+  {
+    return future_;
+  }
+
+  void
+  on_result(const std::string & remote_node_name, std::shared_future<ResultT> future)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      try {
+        results_.emplace(remote_node_name, future.get());
+      } catch (...) {
+        if (!exception_) {
+          exception_ = std::current_exception();
+        }
+      }
+      if (0u != --remaining_) {
+        return;
+      }
+    }
+    complete();
+  }
+
+  // Make the future ready, once every request completed or if none was sent.
+  void
+  complete()
+  {
+    if (exception_) {
+      promise_.set_exception(exception_);
+    } else {
+      promise_.set_value(std::move(results_));
+    }
+    if (callback_) {
+      callback_(future_);
+    }
+  }
+
+private:
+  std::mutex mutex_;
+  size_t remaining_;
+  ResultsByNode results_;
+  std::exception_ptr exception_;
+  std::promise<ResultsByNode> promise_;
+  std::shared_future<ResultsByNode> future_;
+  Callback callback_;
+};
+
+// Send a request to each of the clients, without waiting for the responses.
+template<typename ResultT, typename ClientsT, typename SendRequestT>
+std::shared_future<AsyncMultiNodeParametersClient::ResultsByNode<ResultT>>
+send_to_all(
+  const ClientsT & clients,
+  typename CombinedResults<ResultT>::Callback callback,
+  SendRequestT send_request)
+{
+  auto combined_results = std::make_shared<CombinedResults<ResultT>>(
+    clients.size(), std::move(callback));
+  for (const auto & [remote_node_name, client] : clients) {
+    send_request(
+      remote_node_name, client,
+      [combined_results, remote_node_name = remote_node_name](
+        std::shared_future<ResultT> future)
+      {
+        combined_results->on_result(remote_node_name, future);
+      });
+  }
+  if (clients.empty()) {
+    combined_results->complete();
+  }
+  return combined_results->get_future();
+}
+
+}  // namespace
+
+std::shared_future<
+  AsyncMultiNodeParametersClient::ResultsByNode<std::vector<rclcpp::Parameter>>>
+AsyncMultiNodeParametersClient::get_parameters(
+  const std::vector<std::string> & names,
+  std::function<
+    void(std::shared_future<ResultsByNode<std::vector<rclcpp::Parameter>>>)
+  > callback)
+{
+  using ResultT = std::vector<rclcpp::Parameter>;
+  return send_to_all<ResultT>(
+    clients_, std::move(callback),
+    [&names](
+      const std::string &, const AsyncParametersClient::SharedPtr & client, auto on_result)
+    {
+      client->get_parameters(names, on_result);
+    });
+}
+
+std::shared_future<
+  AsyncMultiNodeParametersClient::ResultsByNode<
+    std::vector<rcl_interfaces::msg::SetParametersResult>>>
+AsyncMultiNodeParametersClient::set_parameters(
+  const std::vector<rclcpp::Parameter> & parameters,
+  std::function<
+    void(std::shared_future<
+      ResultsByNode<std::vector<rcl_interfaces::msg::SetParametersResult>>>)
+  > callback)
+{
+  using ResultT = std::vector<rcl_interfaces::msg::SetParametersResult>;
+  return send_to_all<ResultT>(
+    clients_, std::move(callback),
+    [&parameters](
+      const std::string &, const AsyncParametersClient::SharedPtr & client, auto on_result)
+    {
+      client->set_parameters(parameters, on_result);
+    });
+}
+
+std::shared_future<
+  AsyncMultiNodeParametersClient::ResultsByNode<
+    std::vector<rcl_interfaces::msg::SetParametersResult>>>
+AsyncMultiNodeParametersClient::set_parameters(
+  const ResultsByNode<std::vector<rclcpp::Parameter>> & parameters_by_node,
+  std::function<
+    void(std::shared_future<
+      ResultsByNode<std::vector<rcl_interfaces::msg::SetParametersResult>>>)
+  > callback)
+{
+  using ResultT = std::vector<rcl_interfaces::msg::SetParametersResult>;
+  // Look up all the clients first, so that no request is sent if a node is unknown.
+  std::map<std::string, AsyncParametersClient::SharedPtr> clients;
+  for (const auto & pair : parameters_by_node) {
+    clients.emplace(pair.first, get_client(pair.first));
+  }
+  return send_to_all<ResultT>(
+    clients, std::move(callback),
+    [&parameters_by_node](
+      const std::string & remote_node_name, const AsyncParametersClient::SharedPtr & client,
+      auto on_result)
+    {
+      client->set_parameters(parameters_by_node.at(remote_node_name), on_result);
+    });
+}
+
+std::shared_future<
+  AsyncMultiNodeParametersClient::ResultsByNode<rcl_interfaces::msg::ListParametersResult>>
+AsyncMultiNodeParametersClient::list_parameters(
+  const std::vector<std::string> & prefixes,
+  uint64_t depth,
+  std::function<
+    void(std::shared_future<ResultsByNode<rcl_interfaces::msg::ListParametersResult>>)
+  > callback)
+{
+  using ResultT = rcl_interfaces::msg::ListParametersResult;
+  return send_to_all<ResultT>(
+    clients_, std::move(callback),
+    [&prefixes, depth](
+      const std::string &, const AsyncParametersClient::SharedPtr & client, auto on_result)
+    {
+      client->list_parameters(prefixes, depth, on_result);
+    });
+}
+
+bool
+AsyncMultiNodeParametersClient::service_is_ready() const
+{
+  return std::all_of(
+    clients_.begin(), clients_.end(),
+    [](const auto & pair) {
+      return pair.second->service_is_ready();
+    });
+}
+
+bool
+AsyncMultiNodeParametersClient::wait_for_service_nanoseconds(std::chrono::nanoseconds timeout)
+{
+  for (const auto & pair : clients_) {
+    auto stamp = std::chrono::steady_clock::now();
+    if (!pair.second->wait_for_service(timeout)) {
+      return false;
+    }
+    if (timeout > std::chrono::nanoseconds::zero()) {
+      timeout -= std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - stamp);
+      if (timeout < std::chrono::nanoseconds::zero()) {
+        timeout = std::chrono::nanoseconds::zero();
+      }
+    }
+  }
+  return true;
+}
+
+namespace
+{
+
+/// Spin the executor of a SyncParametersClient until the response to a request arrives.
+/**
+ * Only the callback group of the client is spun, unless the request is for the parameter
+ * services of its own node and no executor spins that node.
+ */
+template<typename FutureT>
+rclcpp::FutureReturnCode
+spin_until_response(
+  rclcpp::Executor & executor,
+  const rclcpp::node_interfaces::NodeBaseInterface::SharedPtr & node_base_interface,
+  bool targets_own_node,
+  const FutureT & future,
+  std::chrono::nanoseconds timeout)
+{
+  if (targets_own_node && !node_base_interface->get_associated_with_executor_atomic().load()) {
+    return rclcpp::executors::spin_node_until_future_complete(
+      executor, node_base_interface, future, timeout);
+  }
+  return executor.spin_until_future_complete(future, timeout);
+}
+
+}  // namespace
+
+SyncParametersClient::~SyncParametersClient()
+{
+  try {
+    executor_->remove_callback_group(callback_group_, false);
+  } catch (const std::exception & exception) {
+    RCLCPP_ERROR(
+      rclcpp::get_logger("rclcpp"),
+      "failed to remove the callback group of a SyncParametersClient from its executor: %s",
+      exception.what());
+  }
+}
+
 std::vector<rclcpp::Parameter>
 SyncParametersClient::get_parameters(
   const std::vector<std::string> & parameter_names,
   std::chrono::nanoseconds timeout)
 {
   auto f = async_parameters_client_->get_parameters(parameter_names);
-  using rclcpp::executors::spin_node_until_future_complete;
   if (
-    spin_node_until_future_complete(
-      *executor_, node_base_interface_, f,
-      timeout) == rclcpp::FutureReturnCode::SUCCESS)
+    spin_until_response(*executor_, node_base_interface_, targets_own_node_, f, timeout) ==
+    rclcpp::FutureReturnCode::SUCCESS)
   {
     return f.get();
   }
@@ -424,9 +719,8 @@ SyncParametersClient::describe_parameters(
 {
   auto f = async_parameters_client_->describe_parameters(parameter_names);
 
-  using rclcpp::executors::spin_node_until_future_complete;
   rclcpp::FutureReturnCode future =
-    spin_node_until_future_complete(*executor_, node_base_interface_, f, timeout);
+    spin_until_response(*executor_, node_base_interface_, targets_own_node_, f, timeout);
   if (future == rclcpp::FutureReturnCode::SUCCESS) {
     return f.get();
   }
@@ -440,11 +734,9 @@ SyncParametersClient::get_parameter_types(
 {
   auto f = async_parameters_client_->get_parameter_types(parameter_names);
 
-  using rclcpp::executors::spin_node_until_future_complete;
   if (
-    spin_node_until_future_complete(
-      *executor_, node_base_interface_, f,
-      timeout) == rclcpp::FutureReturnCode::SUCCESS)
+    spin_until_response(*executor_, node_base_interface_, targets_own_node_, f, timeout) ==
+    rclcpp::FutureReturnCode::SUCCESS)
   {
     return f.get();
   }
@@ -458,11 +750,9 @@ SyncParametersClient::set_parameters(
 {
   auto f = async_parameters_client_->set_parameters(parameters);
 
-  using rclcpp::executors::spin_node_until_future_complete;
   if (
-    spin_node_until_future_complete(
-      *executor_, node_base_interface_, f,
-      timeout) == rclcpp::FutureReturnCode::SUCCESS)
+    spin_until_response(*executor_, node_base_interface_, targets_own_node_, f, timeout) ==
+    rclcpp::FutureReturnCode::SUCCESS)
   {
     return f.get();
   }
@@ -476,11 +766,9 @@ SyncParametersClient::delete_parameters(
 {
   auto f = async_parameters_client_->delete_parameters(parameters_names);
 
-  using rclcpp::executors::spin_node_until_future_complete;
   if (
-    spin_node_until_future_complete(
-      *executor_, node_base_interface_, f,
-      timeout) == rclcpp::FutureReturnCode::SUCCESS)
+    spin_until_response(*executor_, node_base_interface_, targets_own_node_, f, timeout) ==
+    rclcpp::FutureReturnCode::SUCCESS)
   {
     return f.get();
   }
@@ -494,11 +782,9 @@ SyncParametersClient::load_parameters(
 {
   auto f = async_parameters_client_->load_parameters(yaml_filename);
 
-  using rclcpp::executors::spin_node_until_future_complete;
   if (
-    spin_node_until_future_complete(
-      *executor_, node_base_interface_, f,
-      timeout) == rclcpp::FutureReturnCode::SUCCESS)
+    spin_until_response(*executor_, node_base_interface_, targets_own_node_, f, timeout) ==
+    rclcpp::FutureReturnCode::SUCCESS)
   {
     return f.get();
   }
@@ -512,11 +798,9 @@ SyncParametersClient::set_parameters_atomically(
 {
   auto f = async_parameters_client_->set_parameters_atomically(parameters);
 
-  using rclcpp::executors::spin_node_until_future_complete;
   if (
-    spin_node_until_future_complete(
-      *executor_, node_base_interface_, f,
-      timeout) == rclcpp::FutureReturnCode::SUCCESS)
+    spin_until_response(*executor_, node_base_interface_, targets_own_node_, f, timeout) ==
+    rclcpp::FutureReturnCode::SUCCESS)
   {
     return f.get();
   }
@@ -532,11 +816,9 @@ SyncParametersClient::list_parameters(
 {
   auto f = async_parameters_client_->list_parameters(parameter_prefixes, depth);
 
-  using rclcpp::executors::spin_node_until_future_complete;
   if (
-    spin_node_until_future_complete(
-      *executor_, node_base_interface_, f,
-      timeout) == rclcpp::FutureReturnCode::SUCCESS)
+    spin_until_response(*executor_, node_base_interface_, targets_own_node_, f, timeout) ==
+    rclcpp::FutureReturnCode::SUCCESS)
   {
     return f.get();
   }
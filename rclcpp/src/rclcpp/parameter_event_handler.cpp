@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -20,8 +22,11 @@
 #include <vector>
 
 #include "rclcpp/parameter_event_handler.hpp"
+#include "rclcpp/serialization.hpp"
 #include "rcpputils/join.hpp"
 
+#include "./detail/local_parameter_events.hpp"
+
 namespace rclcpp
 {
 
@@ -69,7 +74,7 @@ ParameterEventHandler::add_parameter_callback(
   handle->parameter_name = parameter_name;
   handle->node_name = full_node_name;
   // the last callback registered is executed first.
-  callbacks_->parameter_callbacks_[{parameter_name, full_node_name}].emplace_front(handle);
+  callbacks_->parameter_callbacks_[full_node_name][parameter_name].emplace_front(handle);
 
   return handle;
 }
@@ -80,21 +85,30 @@ ParameterEventHandler::remove_parameter_callback(
 {
   std::lock_guard<std::recursive_mutex> lock(callbacks_->mutex_);
   auto handle = callback_handle.get();
-  auto & container = callbacks_->parameter_callbacks_[{handle->parameter_name, handle->node_name}];
-  auto it = std::find_if(
-    container.begin(),
-    container.end(),
-    [handle](const auto & weak_handle) {
-      return handle == weak_handle.lock().get();
-    });
-  if (it != container.end()) {
-    container.erase(it);
-    if (container.empty()) {
-      callbacks_->parameter_callbacks_.erase({handle->parameter_name, handle->node_name});
+  auto node_it = callbacks_->parameter_callbacks_.find(handle->node_name);
+  if (node_it != callbacks_->parameter_callbacks_.end()) {
+    auto parameter_it = node_it->second.find(handle->parameter_name);
+    if (parameter_it != node_it->second.end()) {
+      auto & container = parameter_it->second;
+      auto it = std::find_if(
+        container.begin(),
+        container.end(),
+        [handle](const auto & weak_handle) {
+          return handle == weak_handle.lock().get();
+        });
+      if (it != container.end()) {
+        container.erase(it);
+        if (container.empty()) {
+          node_it->second.erase(parameter_it);
+          if (node_it->second.empty()) {
+            callbacks_->parameter_callbacks_.erase(node_it);
+          }
+        }
+        return;
+      }
     }
-  } else {
-    throw std::runtime_error("Callback doesn't exist");
   }
+  throw std::runtime_error("Callback doesn't exist");
 }
 
 bool
@@ -162,28 +176,145 @@ ParameterEventHandler::Callbacks::event_callback(const rcl_interfaces::msg::Para
 {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
 
-  for (auto it = parameter_callbacks_.begin(); it != parameter_callbacks_.end(); ++it) {
-    rclcpp::Parameter p;
-    if (get_parameter_from_event(event, p, it->first.first, it->first.second)) {
-      for (auto cb = it->second.begin(); cb != it->second.end(); ++cb) {
-        auto shared_handle = cb->lock();
-        if (nullptr != shared_handle) {
-          shared_handle->callback(p);
-        } else {
-          cb = it->second.erase(cb);
+  // The callbacks are collected before being called, since they may add or remove callbacks.
+  using ParameterCallback =
+    std::pair<ParameterCallbackHandle::SharedPtr, const rcl_interfaces::msg::Parameter *>;
+  std::vector<ParameterCallback> parameter_callbacks;
+  auto node_it = parameter_callbacks_.find(event.node);
+  if (node_it != parameter_callbacks_.end()) {
+    auto & node_callbacks = node_it->second;
+    std::vector<const CallbacksContainerType *> dispatched_containers;
+    auto collect = [&](const rcl_interfaces::msg::Parameter & parameter_msg) {
+        auto parameter_it = node_callbacks.find(parameter_msg.name);
+        if (parameter_it == node_callbacks.end()) {
+          return;
         }
-      }
+        auto & container = parameter_it->second;
+        // A parameter both new and changed in the event is only dispatched for its first entry.
+        if (std::find(
+            dispatched_containers.begin(), dispatched_containers.end(),
+            &container) != dispatched_containers.end())
+        {
+          return;
+        }
+        dispatched_containers.push_back(&container);
+        for (auto cb = container.begin(); cb != container.end(); ) {
+          auto shared_handle = cb->lock();
+          if (nullptr != shared_handle) {
+            parameter_callbacks.emplace_back(std::move(shared_handle), &parameter_msg);
+            ++cb;
+          } else {
+            cb = container.erase(cb);
+          }
+        }
+      };
+    for (const auto & new_parameter : event.new_parameters) {
+      collect(new_parameter);
+    }
+    for (const auto & changed_parameter : event.changed_parameters) {
+      collect(changed_parameter);
     }
   }
 
-  for (auto event_cb = event_callbacks_.begin(); event_cb != event_callbacks_.end(); ++event_cb) {
+  std::vector<ParameterEventCallbackHandle::SharedPtr> event_callbacks;
+  for (auto event_cb = event_callbacks_.begin(); event_cb != event_callbacks_.end(); ) {
     auto shared_event_handle = event_cb->lock();
     if (nullptr != shared_event_handle) {
-      shared_event_handle->callback(event);
+      event_callbacks.push_back(std::move(shared_event_handle));
+      ++event_cb;
     } else {
       event_cb = event_callbacks_.erase(event_cb);
     }
   }
+
+  for (const auto & [handle, parameter_msg] : parameter_callbacks) {
+    handle->callback(rclcpp::Parameter::from_parameter_msg(*parameter_msg));
+  }
+  for (const auto & handle : event_callbacks) {
+    handle->callback(event);
+  }
+}
+
+// Read the node name of a parameter event serialized in plain CDR, without deserializing it.
+// Return false if the event is serialized with another encoding or is truncated.
+static bool
+get_node_name_from_serialized_event(
+  const rclcpp::SerializedMessage & serialized_event, std::string & node_name)
+{
+  const rcl_serialized_message_t & message = serialized_event.get_rcl_serialized_message();
+  // Encapsulation header, then the stamp, two 4 bytes integers, then the length of the name.
+  constexpr size_t kStampOffset = 4u;
+  constexpr size_t kNodeNameLengthOffset = kStampOffset + 8u;
+  constexpr size_t kNodeNameOffset = kNodeNameLengthOffset + 4u;
+  if (message.buffer_length < kNodeNameOffset || message.buffer[0] != 0u) {
+    return false;
+  }
+  const uint8_t encapsulation = message.buffer[1];
+  if (encapsulation != 0u && encapsulation != 1u) {
+    // Neither CDR_BE nor CDR_LE.
+    return false;
+  }
+  const uint8_t * length_bytes = message.buffer + kNodeNameLengthOffset;
+  uint32_t length = 0u;
+  for (size_t i = 0u; i < 4u; ++i) {
+    const uint32_t byte = length_bytes[encapsulation == 1u ? 3u - i : i];
+    length = (length << 8u) | byte;
+  }
+  // The serialized length includes the terminating null character.
+  if (length == 0u || length > message.buffer_length - kNodeNameOffset) {
+    return false;
+  }
+  const char * name = reinterpret_cast<const char *>(message.buffer + kNodeNameOffset);
+  if (name[length - 1u] != '\0') {
+    return false;
+  }
+  node_name.assign(name, length - 1u);
+  return true;
+}
+
+void
+ParameterEventHandler::Callbacks::serialized_event_callback(
+  const rclcpp::SerializedMessage & serialized_event)
+{
+  std::string node_name;
+  const bool has_node_name = get_node_name_from_serialized_event(serialized_event, node_name);
+  if (has_node_name && local_parameter_events_ && local_parameter_events_->has_node(node_name)) {
+    // Already given in process.
+    return;
+  }
+  {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if (event_callbacks_.empty() && has_node_name &&
+      parameter_callbacks_.find(node_name) == parameter_callbacks_.end())
+    {
+      return;
+    }
+  }
+
+  static const rclcpp::Serialization<rcl_interfaces::msg::ParameterEvent> serialization;
+  rcl_interfaces::msg::ParameterEvent event;
+  serialization.deserialize_message(&serialized_event, &event);
+  if (!has_node_name && local_parameter_events_ && local_parameter_events_->has_node(event.node)) {
+    return;
+  }
+  event_callback(event);
+}
+
+void
+ParameterEventHandler::observe_local_parameter_events()
+{
+  auto local_parameter_events =
+    rclcpp::detail::LocalParameterEvents::get(node_base_->get_context());
+  const uint64_t observer_id = local_parameter_events->add_observer(
+    [callbacks = callbacks_](const rcl_interfaces::msg::ParameterEvent & event) {
+      callbacks->event_callback(event);
+    });
+  callbacks_->local_parameter_events_ = local_parameter_events;
+  local_parameter_events_observer_ = std::shared_ptr<void>(
+    nullptr,
+    [local_parameter_events, observer_id](void *) {
+      local_parameter_events->remove_observer(observer_id);
+    });
 }
 
 std::string
@@ -0,0 +1,410 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/parameter_snapshot.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "rcl_interfaces/srv/list_parameters.hpp"
+
+#include "rclcpp/exceptions.hpp"
+
+namespace
+{
+
+// Followed by the version and a known value, which reads differently in another byte order.
+constexpr char snapshot_magic[8] = {'R', 'C', 'L', 'P', 'S', 'N', 'A', 'P'};
+constexpr uint32_t snapshot_version = 1u;
+constexpr uint32_t snapshot_byte_order = 0x01020304u;
+
+class SnapshotWriter
+{
+public:
+  template<typename T>
+  void
+  write(T value)
+  {
+    const char * bytes = reinterpret_cast<const char *>(&value);
+    buffer_.append(bytes, sizeof(T));
+  }
+
+  void
+  write_bytes(const void * bytes, size_t size)
+  {
+    buffer_.append(static_cast<const char *>(bytes), size);
+  }
+
+  void
+  write_size(size_t size)
+  {
+    if (size > UINT32_MAX) {
+      throw std::length_error("parameter snapshot entries are limited to 2^32 - 1 elements");
+    }
+    write(static_cast<uint32_t>(size));
+  }
+
+  void
+  write_string(const std::string & value)
+  {
+    write_size(value.size());
+    buffer_.append(value);
+  }
+
+  template<typename T>
+  void
+  write_array(const std::vector<T> & values)
+  {
+    write_size(values.size());
+    if (!values.empty()) {
+      buffer_.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+    }
+  }
+
+  const std::string &
+  buffer() const
+  {
+    return buffer_;
+  }
+
+private:
+  std::string buffer_;
+};
+
+class SnapshotReader
+{
+public:
+  SnapshotReader(const std::string & filename, const uint8_t * data, size_t size)
+  : filename_(filename), data_(data), end_(data + size)
+  {}
+
+  template<typename T>
+  T
+  read()
+  {
+    T value;
+    std::memcpy(&value, consume(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  size_t
+  read_size()
+  {
+    return read<uint32_t>();
+  }
+
+  std::string
+  read_string()
+  {
+    const size_t size = read_size();
+    return std::string(reinterpret_cast<const char *>(consume(size)), size);
+  }
+
+  template<typename T>
+  std::vector<T>
+  read_array()
+  {
+    const size_t size = read_size();
+    if (size > static_cast<size_t>(end_ - data_) / sizeof(T)) {
+      throw_invalid("is truncated");
+    }
+    std::vector<T> values(size);
+    if (size > 0u) {
+      std::memcpy(values.data(), consume(size * sizeof(T)), size * sizeof(T));
+    }
+    return values;
+  }
+
+  bool
+  at_end() const
+  {
+    return data_ == end_;
+  }
+
+  [[noreturn]] void
+  throw_invalid(const std::string & reason) const
+  {
+    throw rclcpp::exceptions::InvalidParametersException(
+            "parameter snapshot '" + filename_ + "' " + reason);
+  }
+
+private:
+  const uint8_t *
+  consume(size_t size)
+  {
+    if (size > static_cast<size_t>(end_ - data_)) {
+      throw_invalid("is truncated");
+    }
+    const uint8_t * bytes = data_;
+    data_ += size;
+    return bytes;
+  }
+
+  const std::string & filename_;
+  const uint8_t * data_;
+  const uint8_t * const end_;
+};
+
+void
+write_parameter(SnapshotWriter & writer, const rclcpp::Parameter & parameter)
+{
+  writer.write_string(parameter.get_name());
+  writer.write(static_cast<uint8_t>(parameter.get_type()));
+  switch (parameter.get_type()) {
+    case rclcpp::ParameterType::PARAMETER_NOT_SET:
+      break;
+    case rclcpp::ParameterType::PARAMETER_BOOL:
+      writer.write(static_cast<uint8_t>(parameter.as_bool()));
+      break;
+    case rclcpp::ParameterType::PARAMETER_INTEGER:
+      writer.write(parameter.as_int());
+      break;
+    case rclcpp::ParameterType::PARAMETER_DOUBLE:
+      writer.write(parameter.as_double());
+      break;
+    case rclcpp::ParameterType::PARAMETER_STRING:
+      writer.write_string(parameter.as_string());
+      break;
+    case rclcpp::ParameterType::PARAMETER_BYTE_ARRAY:
+      writer.write_array(parameter.as_byte_array());
+      break;
+    case rclcpp::ParameterType::PARAMETER_BOOL_ARRAY:
+      {
+        const auto & values = parameter.get_parameter_value().get<std::vector<bool>>();
+        writer.write_size(values.size());
+        for (const bool value : values) {
+          writer.write(static_cast<uint8_t>(value));
+        }
+        break;
+      }
+    case rclcpp::ParameterType::PARAMETER_INTEGER_ARRAY:
+      writer.write_array(parameter.as_integer_array());
+      break;
+    case rclcpp::ParameterType::PARAMETER_DOUBLE_ARRAY:
+      writer.write_array(parameter.as_double_array());
+      break;
+    case rclcpp::ParameterType::PARAMETER_STRING_ARRAY:
+      {
+        const auto & values = parameter.as_string_array();
+        writer.write_size(values.size());
+        for (const auto & value : values) {
+          writer.write_string(value);
+        }
+        break;
+      }
+  }
+}
+
+rclcpp::Parameter
+read_parameter(SnapshotReader & reader)
+{
+  std::string name = reader.read_string();
+  rclcpp::ParameterValue value;
+  switch (reader.read<uint8_t>()) {
+    case rclcpp::ParameterType::PARAMETER_NOT_SET:
+      break;
+    case rclcpp::ParameterType::PARAMETER_BOOL:
+      value = rclcpp::ParameterValue(reader.read<uint8_t>() != 0u);
+      break;
+    case rclcpp::ParameterType::PARAMETER_INTEGER:
+      value = rclcpp::ParameterValue(reader.read<int64_t>());
+      break;
+    case rclcpp::ParameterType::PARAMETER_DOUBLE:
+      value = rclcpp::ParameterValue(reader.read<double>());
+      break;
+    case rclcpp::ParameterType::PARAMETER_STRING:
+      value = rclcpp::ParameterValue(reader.read_string());
+      break;
+    case rclcpp::ParameterType::PARAMETER_BYTE_ARRAY:
+      value = rclcpp::ParameterValue(reader.read_array<uint8_t>());
+      break;
+    case rclcpp::ParameterType::PARAMETER_BOOL_ARRAY:
+      {
+        const auto bytes = reader.read_array<uint8_t>();
+        std::vector<bool> values(bytes.size());
+        for (size_t i = 0u; i < bytes.size(); ++i) {
+          values[i] = bytes[i] != 0u;
+        }
+        value = rclcpp::ParameterValue(values);
+        break;
+      }
+    case rclcpp::ParameterType::PARAMETER_INTEGER_ARRAY:
+      value = rclcpp::ParameterValue(reader.read_array<int64_t>());
+      break;
+    case rclcpp::ParameterType::PARAMETER_DOUBLE_ARRAY:
+      value = rclcpp::ParameterValue(reader.read_array<double>());
+      break;
+    case rclcpp::ParameterType::PARAMETER_STRING_ARRAY:
+      {
+        std::vector<std::string> values(reader.read_size());
+        for (auto & element : values) {
+          element = reader.read_string();
+        }
+        value = rclcpp::ParameterValue(values);
+        break;
+      }
+    default:
+      reader.throw_invalid("has a parameter of unknown type");
+  }
+  return rclcpp::Parameter(std::move(name), std::move(value));
+}
+
+std::vector<rclcpp::Parameter>
+read_parameters(const std::string & filename, const uint8_t * data, size_t size)
+{
+  if (size < sizeof(snapshot_magic) ||
+    0 != std::memcmp(data, snapshot_magic, sizeof(snapshot_magic)))
+  {
+    throw rclcpp::exceptions::InvalidParametersException(
+            "file '" + filename + "' is not a parameter snapshot");
+  }
+  SnapshotReader reader(filename, data + sizeof(snapshot_magic), size - sizeof(snapshot_magic));
+  if (reader.read<uint32_t>() != snapshot_version) {
+    reader.throw_invalid("has an unsupported version");
+  }
+  if (reader.read<uint32_t>() != snapshot_byte_order) {
+    reader.throw_invalid("was saved with another byte order");
+  }
+  const size_t count = reader.read_size();
+  std::vector<rclcpp::Parameter> parameters;
+  parameters.reserve(count);
+  for (size_t i = 0u; i < count; ++i) {
+    parameters.push_back(read_parameter(reader));
+  }
+  if (!reader.at_end()) {
+    reader.throw_invalid("has trailing data");
+  }
+  return parameters;
+}
+
+}  // namespace
+
+namespace rclcpp
+{
+
+void
+save_parameter_snapshot(
+  const std::string & filename,
+  const std::vector<rclcpp::Parameter> & parameters)
+{
+  SnapshotWriter writer;
+  writer.write_bytes(snapshot_magic, sizeof(snapshot_magic));
+  writer.write(snapshot_version);
+  writer.write(snapshot_byte_order);
+  writer.write_size(parameters.size());
+  for (const auto & parameter : parameters) {
+    write_parameter(writer, parameter);
+  }
+
+  const std::string temporary_filename = filename + ".tmp";
+  {
+    std::ofstream file(temporary_filename, std::ios::binary | std::ios::trunc);
+    file.write(writer.buffer().data(), static_cast<std::streamsize>(writer.buffer().size()));
+    file.close();
+    if (!file) {
+      std::remove(temporary_filename.c_str());
+      throw std::system_error(
+              errno, std::generic_category(),
+              "failed to write parameter snapshot '" + temporary_filename + "'");
+    }
+  }
+  if (0 != std::rename(temporary_filename.c_str(), filename.c_str())) {
+    const int error = errno;
+    std::remove(temporary_filename.c_str());
+    throw std::system_error(
+            error, std::generic_category(),
+            "failed to replace parameter snapshot '" + filename + "'");
+  }
+}
+
+void
+save_parameter_snapshot(
+  const std::string & filename,
+  rclcpp::node_interfaces::NodeParametersInterface & node_parameters)
+{
+  const auto names = node_parameters.list_parameters(
+    {}, rcl_interfaces::srv::ListParameters::Request::DEPTH_RECURSIVE).names;
+  save_parameter_snapshot(filename, node_parameters.get_parameters(names));
+}
+
+std::vector<rclcpp::Parameter>
+load_parameter_snapshot(const std::string & filename)
+{
+#ifndef _WIN32
+  const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::system_error(
+            errno, std::generic_category(),
+            "failed to open parameter snapshot '" + filename + "'");
+  }
+  struct stat file_status;
+  if (0 != ::fstat(fd, &file_status)) {
+    const int error = errno;
+    ::close(fd);
+    throw std::system_error(
+            error, std::generic_category(),
+            "failed to stat parameter snapshot '" + filename + "'");
+  }
+  const size_t size = static_cast<size_t>(file_status.st_size);
+  if (0u == size) {
+    ::close(fd);
+    return read_parameters(filename, nullptr, 0u);
+  }
+  void * data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  const int error = errno;
+  // The mapping remains valid once the file is closed.
+  ::close(fd);
+  if (MAP_FAILED == data) {
+    throw std::system_error(
+            error, std::generic_category(),
+            "failed to map parameter snapshot '" + filename + "'");
+  }
+  try {
+    auto parameters = read_parameters(filename, static_cast<const uint8_t *>(data), size);
+    ::munmap(data, size);
+    return parameters;
+  } catch (...) {
+    ::munmap(data, size);
+    throw;
+  }
+#else
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    throw std::system_error(
+            errno, std::generic_category(),
+            "failed to open parameter snapshot '" + filename + "'");
+  }
+  const std::vector<char> data(
+    (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  return read_parameters(
+    filename, reinterpret_cast<const uint8_t *>(data.data()), data.size());
+#endif
+}
+
+}  // namespace rclcpp
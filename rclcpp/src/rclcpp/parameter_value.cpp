@@ -15,6 +15,7 @@
 #include "rclcpp/parameter_value.hpp"
 
 #include <string>
+#include <variant>
 #include <vector>
 
 using rclcpp::ParameterType;
@@ -109,23 +110,38 @@ rclcpp::to_string(const ParameterValue & value)
 }
 
 ParameterValue::ParameterValue()
-{
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_NOT_SET;
-}
+{}
 
 ParameterValue::ParameterValue(const rcl_interfaces::msg::ParameterValue & value)
 {
-  value_ = value;
   switch (value.type) {
     case PARAMETER_BOOL:
+      value_.emplace<PARAMETER_BOOL>(value.bool_value);
+      break;
     case PARAMETER_INTEGER:
+      value_.emplace<PARAMETER_INTEGER>(value.integer_value);
+      break;
     case PARAMETER_DOUBLE:
+      value_.emplace<PARAMETER_DOUBLE>(value.double_value);
+      break;
     case PARAMETER_STRING:
+      value_.emplace<PARAMETER_STRING>(value.string_value);
+      break;
     case PARAMETER_BYTE_ARRAY:
+      value_.emplace<PARAMETER_BYTE_ARRAY>(value.byte_array_value);
+      break;
     case PARAMETER_BOOL_ARRAY:
+      value_.emplace<PARAMETER_BOOL_ARRAY>(value.bool_array_value);
+      break;
     case PARAMETER_INTEGER_ARRAY:
+      value_.emplace<PARAMETER_INTEGER_ARRAY>(value.integer_array_value);
+      break;
     case PARAMETER_DOUBLE_ARRAY:
+      value_.emplace<PARAMETER_DOUBLE_ARRAY>(value.double_array_value);
+      break;
     case PARAMETER_STRING_ARRAY:
+      value_.emplace<PARAMETER_STRING_ARRAY>(value.string_array_value);
+      break;
     case PARAMETER_NOT_SET:
       break;
     default:
@@ -135,97 +151,108 @@ ParameterValue::ParameterValue(const rcl_interfaces::msg::ParameterValue & value
 }
 
 ParameterValue::ParameterValue(const bool bool_value)
-{
-  value_.bool_value = bool_value;
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_BOOL;
-}
+: value_(std::in_place_index<PARAMETER_BOOL>, bool_value)
+{}
 
 ParameterValue::ParameterValue(const int int_value)
-{
-  value_.integer_value = int_value;
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
-}
+: value_(std::in_place_index<PARAMETER_INTEGER>, int_value)
+{}
 
 ParameterValue::ParameterValue(const int64_t int_value)
-{
-  value_.integer_value = int_value;
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
-}
+: value_(std::in_place_index<PARAMETER_INTEGER>, int_value)
+{}
 
 ParameterValue::ParameterValue(const float double_value)
-{
-  value_.double_value = static_cast<double>(double_value);
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_DOUBLE;
-}
+: value_(std::in_place_index<PARAMETER_DOUBLE>, static_cast<double>(double_value))
+{}
 
 ParameterValue::ParameterValue(const double double_value)
-{
-  value_.double_value = double_value;
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_DOUBLE;
-}
+: value_(std::in_place_index<PARAMETER_DOUBLE>, double_value)
+{}
 
 ParameterValue::ParameterValue(const std::string & string_value)
-{
-  value_.string_value = string_value;
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_STRING;
-}
+: value_(std::in_place_index<PARAMETER_STRING>, string_value)
+{}
 
 ParameterValue::ParameterValue(const char * string_value)
 : ParameterValue(std::string(string_value))
 {}
 
 ParameterValue::ParameterValue(const std::vector<uint8_t> & byte_array_value)
-{
-  value_.byte_array_value = byte_array_value;
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_BYTE_ARRAY;
-}
+: value_(std::in_place_index<PARAMETER_BYTE_ARRAY>, byte_array_value)
+{}
 
 ParameterValue::ParameterValue(const std::vector<bool> & bool_array_value)
-{
-  value_.bool_array_value = bool_array_value;
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_BOOL_ARRAY;
-}
+: value_(std::in_place_index<PARAMETER_BOOL_ARRAY>, bool_array_value)
+{}
 
 ParameterValue::ParameterValue(const std::vector<int> & int_array_value)
-{
-  value_.integer_array_value.assign(int_array_value.cbegin(), int_array_value.cend());
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER_ARRAY;
-}
+: value_(
+    std::in_place_index<PARAMETER_INTEGER_ARRAY>,
+    int_array_value.cbegin(), int_array_value.cend())
+{}
 
 ParameterValue::ParameterValue(const std::vector<int64_t> & int_array_value)
-{
-  value_.integer_array_value = int_array_value;
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER_ARRAY;
-}
+: value_(std::in_place_index<PARAMETER_INTEGER_ARRAY>, int_array_value)
+{}
 
 ParameterValue::ParameterValue(const std::vector<float> & float_array_value)
-{
-  value_.double_array_value.assign(float_array_value.cbegin(), float_array_value.cend());
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_DOUBLE_ARRAY;
-}
+: value_(
+    std::in_place_index<PARAMETER_DOUBLE_ARRAY>,
+    float_array_value.cbegin(), float_array_value.cend())
+{}
 
 ParameterValue::ParameterValue(const std::vector<double> & double_array_value)
-{
-  value_.double_array_value = double_array_value;
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_DOUBLE_ARRAY;
-}
+: value_(std::in_place_index<PARAMETER_DOUBLE_ARRAY>, double_array_value)
+{}
 
 ParameterValue::ParameterValue(const std::vector<std::string> & string_array_value)
-{
-  value_.string_array_value = string_array_value;
-  value_.type = rcl_interfaces::msg::ParameterType::PARAMETER_STRING_ARRAY;
-}
+: value_(std::in_place_index<PARAMETER_STRING_ARRAY>, string_array_value)
+{}
 
 ParameterType
 ParameterValue::get_type() const
 {
-  return static_cast<ParameterType>(value_.type);
+  return static_cast<ParameterType>(value_.index());
 }
 
 rcl_interfaces::msg::ParameterValue
 ParameterValue::to_value_msg() const
 {
-  return value_;
+  rcl_interfaces::msg::ParameterValue value;
+  value.type = get_type();
+  switch (value.type) {
+    case PARAMETER_BOOL:
+      value.bool_value = std::get<PARAMETER_BOOL>(value_);
+      break;
+    case PARAMETER_INTEGER:
+      value.integer_value = std::get<PARAMETER_INTEGER>(value_);
+      break;
+    case PARAMETER_DOUBLE:
+      value.double_value = std::get<PARAMETER_DOUBLE>(value_);
+      break;
+    case PARAMETER_STRING:
+      value.string_value = std::get<PARAMETER_STRING>(value_);
+      break;
+    case PARAMETER_BYTE_ARRAY:
+      value.byte_array_value = std::get<PARAMETER_BYTE_ARRAY>(value_);
+      break;
+    case PARAMETER_BOOL_ARRAY:
+      value.bool_array_value = std::get<PARAMETER_BOOL_ARRAY>(value_);
+      break;
+    case PARAMETER_INTEGER_ARRAY:
+      value.integer_array_value = std::get<PARAMETER_INTEGER_ARRAY>(value_);
+      break;
+    case PARAMETER_DOUBLE_ARRAY:
+      value.double_array_value = std::get<PARAMETER_DOUBLE_ARRAY>(value_);
+      break;
+    case PARAMETER_STRING_ARRAY:
+      value.string_array_value = std::get<PARAMETER_STRING_ARRAY>(value_);
+      break;
+    default:
+      break;
+  }
+  return value;
 }
 
 bool
@@ -17,21 +17,27 @@
 #include <rmw/error_handling.h>
 #include <rmw/rmw.h>
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "rcl/graph.h"
 #include "rcutils/logging_macros.h"
 #include "rmw/impl/cpp/demangle.hpp"
 
 #include "rclcpp/allocator/allocator_common.hpp"
 #include "rclcpp/allocator/allocator_deleter.hpp"
+#include "rclcpp/detail/fast_exit.hpp"
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/expand_topic_or_service_name.hpp"
 #include "rclcpp/experimental/intra_process_manager.hpp"
+#include "rclcpp/graph_listener.hpp"
 #include "rclcpp/logging.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/network_flow_endpoint.hpp"
@@ -40,16 +46,91 @@
 
 using rclcpp::PublisherBase;
 
+/// Count the subscriptions of the topic of a publisher after each graph change.
+class PublisherBase::SubscriptionObserver : public rclcpp::graph_listener::GraphObserver
+{
+public:
+  SubscriptionObserver(
+    rclcpp::Context::SharedPtr context,
+    std::shared_ptr<rcl_node_t> node_handle,
+    const std::string & topic_name)
+  : node_handle_(std::move(node_handle)),
+    topic_name_(topic_name),
+    graph_listener_(context->get_sub_context<rclcpp::graph_listener::GraphListener>(context))
+  {
+    graph_listener_->add_graph_observer(this);
+    try {
+      graph_listener_->start_if_not_started();
+    } catch (...) {
+      graph_listener_->remove_graph_observer(this);
+      throw;
+    }
+    // The subscriptions matched before the observation started.
+    on_graph_change();
+  }
+
+  ~SubscriptionObserver()
+  {
+    try {
+      graph_listener_->remove_graph_observer(this);
+    } catch (const std::exception & exception) {
+      RCLCPP_ERROR(
+        rclcpp::get_logger("rclcpp"),
+        "caught %s exception when removing the graph observer of a publisher: %s",
+        rmw::impl::cpp::demangle(exception).c_str(), exception.what());
+    }
+  }
+
+  const rcl_guard_condition_t *
+  get_graph_guard_condition() const override
+  {
+    return rcl_node_get_graph_guard_condition(node_handle_.get());
+  }
+
+  void
+  on_graph_change() override
+  {
+    // Counted under the lock, so that concurrent updates are applied in the order of the counts.
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t count = 0;
+    rcl_ret_t ret = rcl_count_subscribers(node_handle_.get(), topic_name_.c_str(), &count);
+    if (RCL_RET_OK != ret) {
+      // Keep the previous result, the next graph change counts again.
+      rcl_reset_error();
+      return;
+    }
+    has_subscribers_.store(count > 0u, std::memory_order_relaxed);
+  }
+
+  bool
+  has_subscribers() const
+  {
+    return has_subscribers_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::shared_ptr<rcl_node_t> node_handle_;
+  std::string topic_name_;
+  std::shared_ptr<rclcpp::graph_listener::GraphListener> graph_listener_;
+  std::mutex mutex_;
+  std::atomic<bool> has_subscribers_{false};
+};
+
 PublisherBase::PublisherBase(
   rclcpp::node_interfaces::NodeBaseInterface * node_base,
   const std::string & topic,
   const rosidl_message_type_support_t & type_support,
   const rcl_publisher_options_t & publisher_options)
 : rcl_node_handle_(node_base->get_shared_rcl_node_handle()),
-  intra_process_is_enabled_(false), intra_process_publisher_id_(0)
+  intra_process_is_enabled_(false), intra_process_publisher_id_(0),
+  context_(node_base->get_context())
 {
   auto custom_deleter = [node_handle = this->rcl_node_handle_](rcl_publisher_t * rcl_pub)
     {
+      if (rclcpp::detail::skip_entity_finalization(node_handle.get())) {
+        delete rcl_pub;
+        return;
+      }
       if (rcl_publisher_fini(rcl_pub, node_handle.get()) != RCL_RET_OK) {
         RCLCPP_ERROR(
           rclcpp::get_node_logger(node_handle.get()).get_child("rclcpp"),
@@ -100,7 +181,7 @@ PublisherBase::PublisherBase(
 PublisherBase::~PublisherBase()
 {
   // must fini the events before fini-ing the publisher
-  event_handlers_.clear();
+  event_handlers_.reset();
 
   auto ipm = weak_ipm_.lock();
 
@@ -157,7 +238,44 @@ PublisherBase::get_publisher_handle() const
 const std::vector<std::shared_ptr<rclcpp::QOSEventHandlerBase>> &
 PublisherBase::get_event_handlers() const
 {
-  return event_handlers_;
+  static const std::vector<std::shared_ptr<rclcpp::QOSEventHandlerBase>> no_event_handlers;
+  return event_handlers_ ? event_handlers_->handlers : no_event_handlers;
+}
+
+rclcpp::Waitable::SharedPtr
+PublisherBase::get_event_handlers_waitable()
+{
+  if (!event_handlers_) {
+    return nullptr;
+  }
+  auto & handlers = event_handlers_->handlers;
+  if (handlers.size() == 1u) {
+    return handlers.front();
+  }
+  if (!event_handlers_->group) {
+    event_handlers_->group = std::make_shared<rclcpp::QOSEventHandlerGroup>(handlers);
+  }
+  return event_handlers_->group;
+}
+
+void
+PublisherBase::add_event_handler(std::shared_ptr<rclcpp::QOSEventHandlerBase> handler)
+{
+  if (!event_handlers_) {
+    event_handlers_ = std::make_unique<EventHandlers>();
+  }
+  event_handlers_->handlers.emplace_back(std::move(handler));
+}
+
+void
+PublisherBase::add_matched_event_handler(
+  rclcpp::node_interfaces::NodeBaseInterface * node_base,
+  const QOSMatchedCallbackType & callback)
+{
+  add_event_handler(
+    std::make_shared<MatchedEventHandler>(
+      callback, node_base->get_context(), rcl_node_handle_, get_topic_name(),
+      rcl_count_subscribers));
 }
 
 size_t
@@ -202,6 +320,21 @@ PublisherBase::get_intra_process_subscription_count() const
   return ipm->get_subscription_count(intra_process_publisher_id_);
 }
 
+bool
+PublisherBase::has_subscribers() const
+{
+  std::call_once(
+    subscription_observer_flag_, [this]() {
+      auto context = context_.lock();
+      if (!context) {
+        throw std::runtime_error("has_subscribers() called after the destruction of the context");
+      }
+      subscription_observer_ = std::make_unique<SubscriptionObserver>(
+        context, rcl_node_handle_, get_topic_name());
+    });
+  return subscription_observer_->has_subscribers();
+}
+
 rclcpp::QoS
 PublisherBase::get_actual_qos() const
 {
@@ -305,3 +438,16 @@ std::vector<rclcpp::NetworkFlowEndpoint> PublisherBase::get_network_flow_endpoin
 
   return network_flow_endpoint_vector;
 }
+
+void
+PublisherBase::set_topic_statistics(
+  std::shared_ptr<rclcpp::topic_statistics::PublisherTopicStatistics> topic_statistics)
+{
+  topic_statistics_ = std::move(topic_statistics);
+}
+
+std::shared_ptr<rclcpp::topic_statistics::PublisherTopicStatistics>
+PublisherBase::get_topic_statistics() const
+{
+  return topic_statistics_;
+}
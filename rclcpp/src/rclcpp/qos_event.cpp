@@ -12,10 +12,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "rclcpp/detail/cpp_callback_trampoline.hpp"
+#include "rclcpp/graph_listener.hpp"
+#include "rclcpp/logging.hpp"
 #include "rclcpp/qos_event.hpp"
 
+#include "rmw/impl/cpp/demangle.hpp"
+
 namespace rclcpp
 {
 
@@ -35,6 +46,9 @@ UnsupportedEventTypeException::UnsupportedEventTypeException(
 
 QOSEventHandlerBase::~QOSEventHandlerBase()
 {
+  // The callback must not be called anymore once the event handle is finalized.
+  clear_on_ready_callback();
+
   if (rcl_event_fini(&event_handle_) != RCL_RET_OK) {
     RCUTILS_LOG_ERROR_NAMED(
       "rclcpp",
@@ -68,4 +82,407 @@ QOSEventHandlerBase::is_ready(rcl_wait_set_t * wait_set)
   return wait_set->events[wait_set_event_index_] == &event_handle_;
 }
 
+void
+QOSEventHandlerBase::set_on_ready_callback(std::function<void(size_t, int)> callback)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_ready_callback is not callable.");
+  }
+
+  // Note: we bind the int identifier argument to this waitable's entity types
+  auto new_callback =
+    [callback, this](size_t number_of_events) {
+      try {
+        callback(number_of_events, 0);
+      } catch (const std::exception & exception) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::QOSEventHandlerBase@" << this <<
+            " caught " << rmw::impl::cpp::demangle(exception) <<
+            " exception in user-provided callback for the 'on ready' callback: " <<
+            exception.what());
+      } catch (...) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::QOSEventHandlerBase@" << this <<
+            " caught unhandled exception in user-provided callback " <<
+            "for the 'on ready' callback");
+      }
+    };
+
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+
+  // Set it temporarily to the new callback, while we replace the old one.
+  // This two-step setting, prevents a gap where the old std::function has
+  // been replaced but the middleware hasn't been told about the new one yet.
+  set_on_new_event_callback(
+    rclcpp::detail::cpp_callback_trampoline<const void *, size_t>,
+    static_cast<const void *>(&new_callback));
+
+  // Store the std::function to keep it in scope, also overwrites the existing one.
+  on_new_event_callback_ = new_callback;
+
+  // Set it again, now using the permanent storage.
+  set_on_new_event_callback(
+    rclcpp::detail::cpp_callback_trampoline<const void *, size_t>,
+    static_cast<const void *>(&on_new_event_callback_));
+}
+
+void
+QOSEventHandlerBase::clear_on_ready_callback()
+{
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  if (on_new_event_callback_) {
+    set_on_new_event_callback(nullptr, nullptr);
+    on_new_event_callback_ = nullptr;
+  }
+}
+
+void
+QOSEventHandlerBase::set_on_new_event_callback(
+  rcl_event_callback_t callback,
+  const void * user_data)
+{
+  rcl_ret_t ret = rcl_event_set_callback(
+    &event_handle_,
+    callback,
+    user_data);
+
+  if (RCL_RET_OK != ret) {
+    exceptions::throw_from_rcl_error(ret, "failed to set the on new event callback");
+  }
+}
+
+/// Updates the matched count of its handler after each graph change.
+class MatchedEventHandler::Observer : public rclcpp::graph_listener::GraphObserver
+{
+public:
+  explicit Observer(MatchedEventHandler & handler)
+  : handler_(handler)
+  {}
+
+  const rcl_guard_condition_t *
+  get_graph_guard_condition() const override
+  {
+    return rcl_node_get_graph_guard_condition(handler_.node_handle_.get());
+  }
+
+  void
+  on_graph_change() override
+  {
+    handler_.update_matched_count();
+  }
+
+private:
+  MatchedEventHandler & handler_;
+};
+
+MatchedEventHandler::MatchedEventHandler(
+  const QOSMatchedCallbackType & callback,
+  rclcpp::Context::SharedPtr context,
+  std::shared_ptr<rcl_node_t> node_handle,
+  const std::string & topic_name,
+  CountFunction count_function)
+: callback_(callback),
+  node_handle_(std::move(node_handle)),
+  topic_name_(topic_name),
+  count_function_(count_function),
+  graph_listener_(context->get_sub_context<rclcpp::graph_listener::GraphListener>(context)),
+  guard_condition_(context),
+  wait_set_guard_condition_index_(0u),
+  observer_(std::make_unique<Observer>(*this))
+{
+  graph_listener_->add_graph_observer(observer_.get());
+  try {
+    graph_listener_->start_if_not_started();
+  } catch (...) {
+    graph_listener_->remove_graph_observer(observer_.get());
+    throw;
+  }
+  // The endpoints matched before the handler was created are reported as changes as well.
+  update_matched_count();
+}
+
+MatchedEventHandler::~MatchedEventHandler()
+{
+  try {
+    graph_listener_->remove_graph_observer(observer_.get());
+  } catch (const std::exception & exception) {
+    RCLCPP_ERROR(
+      rclcpp::get_logger("rclcpp"),
+      "caught %s exception when removing the graph observer of a matched event handler: %s",
+      rmw::impl::cpp::demangle(exception).c_str(), exception.what());
+  }
+  clear_on_ready_callback();
+}
+
+size_t
+MatchedEventHandler::get_number_of_ready_events()
+{
+  return 0u;
+}
+
+size_t
+MatchedEventHandler::get_number_of_ready_guard_conditions()
+{
+  return 1u;
+}
+
+bool
+MatchedEventHandler::add_to_wait_set(rcl_wait_set_t * wait_set)
+{
+  rcl_ret_t ret = rcl_wait_set_add_guard_condition(
+    wait_set, &guard_condition_.get_rcl_guard_condition(), &wait_set_guard_condition_index_);
+  if (RCL_RET_OK != ret) {
+    exceptions::throw_from_rcl_error(ret, "Couldn't add guard condition to wait set");
+  }
+  return true;
+}
+
+bool
+MatchedEventHandler::is_ready(rcl_wait_set_t * wait_set)
+{
+  return wait_set->guard_conditions[wait_set_guard_condition_index_] ==
+         &guard_condition_.get_rcl_guard_condition();
+}
+
+std::shared_ptr<void>
+MatchedEventHandler::take_data()
+{
+  std::lock_guard<std::mutex> lock(status_mutex_);
+  if (!changed_) {
+    // The changes were taken since the guard condition was triggered.
+    return nullptr;
+  }
+  auto info = std::make_shared<MatchedInfo>(status_);
+  status_.total_count_change = 0u;
+  status_.current_count_change = 0;
+  changed_ = false;
+  return std::static_pointer_cast<void>(info);
+}
+
+void
+MatchedEventHandler::execute(std::shared_ptr<void> & data)
+{
+  if (!data) {
+    return;
+  }
+  auto info = std::static_pointer_cast<MatchedInfo>(data);
+  callback_(*info);
+}
+
+void
+MatchedEventHandler::set_on_ready_callback(std::function<void(size_t, int)> callback)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_ready_callback is not callable.");
+  }
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  on_ready_callback_ = callback;
+  bool changed;
+  {
+    std::lock_guard<std::mutex> status_lock(status_mutex_);
+    changed = changed_;
+  }
+  if (changed) {
+    // Report the changes which occurred before the callback was set.
+    on_ready_callback_(1u, 0);
+  }
+}
+
+void
+MatchedEventHandler::clear_on_ready_callback()
+{
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  on_ready_callback_ = nullptr;
+}
+
+void
+MatchedEventHandler::update_matched_count()
+{
+  {
+    // Counted under the lock, so that concurrent updates are applied in the order of the counts.
+    std::lock_guard<std::mutex> lock(status_mutex_);
+    size_t count = 0u;
+    rcl_ret_t ret = count_function_(node_handle_.get(), topic_name_.c_str(), &count);
+    if (RCL_RET_OK != ret) {
+      RCLCPP_ERROR(
+        rclcpp::get_logger("rclcpp"),
+        "failed to count the endpoints matched on '%s': %s",
+        topic_name_.c_str(), rcl_get_error_string().str);
+      rcl_reset_error();
+      return;
+    }
+    if (count == status_.current_count) {
+      return;
+    }
+    if (count > status_.current_count) {
+      status_.total_count += count - status_.current_count;
+      status_.total_count_change += count - status_.current_count;
+    }
+    status_.current_count_change +=
+      static_cast<int32_t>(count) - static_cast<int32_t>(status_.current_count);
+    status_.current_count = count;
+    if (changed_) {
+      // The executor was already signaled and takes this change as well.
+      return;
+    }
+    changed_ = true;
+  }
+  guard_condition_.trigger();
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  if (on_ready_callback_) {
+    try {
+      on_ready_callback_(1u, 0);
+    } catch (const std::exception & exception) {
+      RCLCPP_ERROR_STREAM(
+        rclcpp::get_logger("rclcpp"),
+        "rclcpp::MatchedEventHandler@" << this <<
+          " caught " << rmw::impl::cpp::demangle(exception) <<
+          " exception in user-provided callback for the 'on ready' callback: " <<
+          exception.what());
+    }
+  }
+}
+
+QOSEventHandlerGroup::QOSEventHandlerGroup(
+  std::vector<std::shared_ptr<QOSEventHandlerBase>> handlers)
+: handlers_(std::move(handlers)),
+  ready_(handlers_.size(), false),
+  pending_events_(handlers_.size(), 0u)
+{}
+
+QOSEventHandlerGroup::~QOSEventHandlerGroup()
+{
+  // The callbacks of the handlers refer to this group.
+  try {
+    clear_on_ready_callback();
+  } catch (const std::exception & exception) {
+    RCLCPP_ERROR(
+      rclcpp::get_logger("rclcpp"),
+      "failed to clear the on ready callbacks of the event handlers: %s", exception.what());
+  }
+}
+
+size_t
+QOSEventHandlerGroup::get_number_of_ready_events()
+{
+  size_t number_of_events = 0u;
+  for (const auto & handler : handlers_) {
+    number_of_events += handler->get_number_of_ready_events();
+  }
+  return number_of_events;
+}
+
+size_t
+QOSEventHandlerGroup::get_number_of_ready_guard_conditions()
+{
+  size_t number_of_guard_conditions = 0u;
+  for (const auto & handler : handlers_) {
+    number_of_guard_conditions += handler->get_number_of_ready_guard_conditions();
+  }
+  return number_of_guard_conditions;
+}
+
+bool
+QOSEventHandlerGroup::add_to_wait_set(rcl_wait_set_t * wait_set)
+{
+  for (const auto & handler : handlers_) {
+    handler->add_to_wait_set(wait_set);
+  }
+  return true;
+}
+
+bool
+QOSEventHandlerGroup::is_ready(rcl_wait_set_t * wait_set)
+{
+  std::lock_guard<std::mutex> lock(ready_mutex_);
+  bool any_ready = false;
+  for (size_t i = 0u; i < handlers_.size(); ++i) {
+    ready_[i] = handlers_[i]->is_ready(wait_set);
+    any_ready = any_ready || ready_[i];
+  }
+  return any_ready;
+}
+
+std::shared_ptr<void>
+QOSEventHandlerGroup::take_data()
+{
+  auto data = std::make_shared<ReadyData>();
+  {
+    std::lock_guard<std::mutex> lock(ready_mutex_);
+    for (size_t i = 0u; i < handlers_.size(); ++i) {
+      if (ready_[i]) {
+        ready_[i] = false;
+        data->emplace_back(i, nullptr);
+      }
+    }
+    if (data->empty()) {
+      // Taken for an event reported by an on ready callback, one at a time.
+      for (size_t i = 0u; i < handlers_.size(); ++i) {
+        if (pending_events_[i] > 0u) {
+          --pending_events_[i];
+          data->emplace_back(i, nullptr);
+          break;
+        }
+      }
+    }
+  }
+  for (auto & ready_handler : *data) {
+    ready_handler.second = handlers_[ready_handler.first]->take_data();
+  }
+  return std::static_pointer_cast<void>(data);
+}
+
+void
+QOSEventHandlerGroup::execute(std::shared_ptr<void> & data)
+{
+  if (!data) {
+    return;
+  }
+  auto ready_data = std::static_pointer_cast<ReadyData>(data);
+  for (auto & ready_handler : *ready_data) {
+    if (ready_handler.second) {
+      handlers_[ready_handler.first]->execute(ready_handler.second);
+    }
+  }
+}
+
+void
+QOSEventHandlerGroup::set_on_ready_callback(std::function<void(size_t, int)> callback)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_ready_callback is not callable.");
+  }
+  for (size_t i = 0u; i < handlers_.size(); ++i) {
+    handlers_[i]->set_on_ready_callback(
+      [this, i, callback](size_t number_of_events, int) {
+        {
+          std::lock_guard<std::mutex> lock(ready_mutex_);
+          pending_events_[i] += number_of_events;
+        }
+        callback(number_of_events, static_cast<int>(i));
+      });
+  }
+}
+
+void
+QOSEventHandlerGroup::clear_on_ready_callback()
+{
+  for (const auto & handler : handlers_) {
+    handler->clear_on_ready_callback();
+  }
+  std::lock_guard<std::mutex> lock(ready_mutex_);
+  std::fill(pending_events_.begin(), pending_events_.end(), 0u);
+}
+
+const std::vector<std::shared_ptr<QOSEventHandlerBase>> &
+QOSEventHandlerGroup::get_event_handlers() const
+{
+  return handlers_;
+}
+
 }  // namespace rclcpp
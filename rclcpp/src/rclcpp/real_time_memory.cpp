@@ -0,0 +1,122 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/real_time_memory.hpp"
+
+#ifdef __linux__
+#include <malloc.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+namespace
+{
+
+constexpr size_t default_page_size = 4096u;
+
+size_t
+get_page_size()
+{
+#ifdef __linux__
+  const long page_size = sysconf(_SC_PAGESIZE);  // NOLINT(runtime/int)
+  if (page_size > 0) {
+    return static_cast<size_t>(page_size);
+  }
+#endif
+  return default_page_size;
+}
+
+// Touch one page of the stack per call, not inlined so that every call has its own frame.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+void
+prefault_stack_pages(size_t remaining)
+{
+  volatile unsigned char page[default_page_size];
+  for (size_t i = 0; i < sizeof(page); i += 64u) {
+    page[i] = 0;
+  }
+  if (remaining > sizeof(page)) {
+    prefault_stack_pages(remaining - sizeof(page));
+  }
+  // Keep the call from being turned into a jump reusing this frame.
+  page[0] = page[0];
+}
+
+}  // namespace
+
+namespace rclcpp
+{
+
+void
+lock_memory()
+{
+#ifdef __linux__
+  if (0 != mlockall(MCL_CURRENT | MCL_FUTURE)) {
+    throw std::system_error(errno, std::generic_category(), "failed to lock the process memory");
+  }
+#ifdef __GLIBC__
+  // Keep freed memory in the process, and serve large allocations from the locked heap too.
+  mallopt(M_TRIM_THRESHOLD, -1);
+  mallopt(M_MMAP_MAX, 0);
+#endif
+#else
+  throw std::runtime_error("locking the process memory is only supported on Linux");
+#endif
+}
+
+void
+prefault_stack(size_t size)
+{
+  if (0u == size) {
+    return;
+  }
+  prefault_stack_pages(size);
+}
+
+void
+prefault_heap(size_t size)
+{
+  if (0u == size) {
+    return;
+  }
+  auto memory = static_cast<volatile unsigned char *>(std::malloc(size));
+  if (!memory) {
+    throw std::bad_alloc();
+  }
+  const size_t page_size = get_page_size();
+  for (size_t i = 0; i < size; i += page_size) {
+    memory[i] = 0;
+  }
+  std::free(const_cast<unsigned char *>(memory));
+}
+
+void
+prepare_memory_for_real_time(const RealTimeMemoryOptions & options)
+{
+  if (options.lock_memory) {
+    lock_memory();
+  }
+  prefault_heap(options.prefault_heap_size);
+  prefault_stack(options.prefault_stack_size);
+}
+
+}  // namespace rclcpp
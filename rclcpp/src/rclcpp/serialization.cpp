@@ -14,6 +14,8 @@
 
 #include "rclcpp/serialization.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -22,11 +24,39 @@
 
 #include "rcpputils/asserts.hpp"
 
+#include "rcutils/allocator.h"
+
 #include "rmw/rmw.h"
 
 namespace rclcpp
 {
 
+namespace
+{
+
+// Allocator of the buffers provided by the caller of serialize_into(), which must not be
+// reallocated or freed.
+void * fail_allocate(size_t, void *)
+{
+  return nullptr;
+}
+
+void * fail_reallocate(void *, size_t, void *)
+{
+  return nullptr;
+}
+
+void * fail_zero_allocate(size_t, size_t, void *)
+{
+  return nullptr;
+}
+
+void keep_deallocate(void *, void *)
+{
+}
+
+}  // namespace
+
 SerializationBase::SerializationBase(const rosidl_message_type_support_t * type_support)
 : type_support_(type_support)
 {
@@ -49,6 +79,36 @@ void SerializationBase::serialize_message(
   }
 }
 
+const SerializedMessage & SerializationBase::serialize_message(const void * ros_message) const
+{
+  thread_local SerializedMessage serialized_message;
+  serialize_message(ros_message, &serialized_message);
+  return serialized_message;
+}
+
+size_t SerializationBase::serialize_into(
+  const void * ros_message, uint8_t * buffer, size_t buffer_capacity) const
+{
+  rcpputils::check_true(nullptr != type_support_, "Typesupport is nullpointer.");
+  rcpputils::check_true(nullptr != ros_message, "ROS message is nullpointer.");
+  rcpputils::check_true(nullptr != buffer, "Buffer is nullpointer.");
+
+  rcl_serialized_message_t serialized_message = rmw_get_zero_initialized_serialized_message();
+  serialized_message.buffer = buffer;
+  serialized_message.buffer_capacity = buffer_capacity;
+  serialized_message.allocator = rcutils_get_zero_initialized_allocator();
+  serialized_message.allocator.allocate = fail_allocate;
+  serialized_message.allocator.deallocate = keep_deallocate;
+  serialized_message.allocator.reallocate = fail_reallocate;
+  serialized_message.allocator.zero_allocate = fail_zero_allocate;
+
+  const auto ret = rmw_serialize(ros_message, type_support_, &serialized_message);
+  if (ret != RMW_RET_OK) {
+    rclcpp::exceptions::throw_from_rcl_error(ret, "Failed to serialize ROS message.");
+  }
+  return serialized_message.buffer_length;
+}
+
 void SerializationBase::deserialize_message(
   const SerializedMessage * serialized_message, void * ros_message) const
 {
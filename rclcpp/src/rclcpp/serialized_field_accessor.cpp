@@ -0,0 +1,532 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/serialized_field_accessor.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rcutils/error_handling.h"
+#include "rosidl_runtime_c/message_type_support_struct.h"
+#include "rosidl_typesupport_introspection_cpp/field_types.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+
+#include "rclcpp/typesupport_helpers.hpp"
+
+namespace rclcpp
+{
+
+namespace
+{
+
+namespace introspection = rosidl_typesupport_introspection_cpp;
+
+constexpr const char * introspection_typesupport_identifier =
+  "rosidl_typesupport_introspection_cpp";
+
+/// Size of the CDR encapsulation header, the alignment of the fields is relative to its end.
+constexpr size_t encapsulation_size = 4;
+
+/// Return the size of a primitive in the CDR encoding, its alignment too, 0 if not supported.
+size_t
+get_primitive_size(uint8_t type_id)
+{
+  switch (type_id) {
+    case introspection::ROS_TYPE_BOOLEAN:
+    case introspection::ROS_TYPE_OCTET:
+    case introspection::ROS_TYPE_CHAR:
+    case introspection::ROS_TYPE_UINT8:
+    case introspection::ROS_TYPE_INT8:
+      return 1;
+    case introspection::ROS_TYPE_UINT16:
+    case introspection::ROS_TYPE_INT16:
+      return 2;
+    case introspection::ROS_TYPE_UINT32:
+    case introspection::ROS_TYPE_INT32:
+    case introspection::ROS_TYPE_FLOAT:
+      return 4;
+    case introspection::ROS_TYPE_UINT64:
+    case introspection::ROS_TYPE_INT64:
+    case introspection::ROS_TYPE_DOUBLE:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+size_t
+align(size_t position, size_t alignment)
+{
+  return (position + alignment - 1) & ~(alignment - 1);
+}
+
+const introspection::MessageMembers *
+get_members(const rosidl_message_type_support_t * type_support)
+{
+  return static_cast<const introspection::MessageMembers *>(type_support->data);
+}
+
+bool
+is_sequence(const introspection::MessageMember & member)
+{
+  return member.is_array_ && (0 == member.array_size_ || member.is_upper_bound_);
+}
+
+/// Return true if the messages have the same size whatever their content.
+bool
+is_fixed_size(const introspection::MessageMembers * members)
+{
+  for (uint32_t i = 0; i < members->member_count_; ++i) {
+    const introspection::MessageMember & member = members->members_[i];
+    if (is_sequence(member)) {
+      return false;
+    }
+    if (introspection::ROS_TYPE_MESSAGE == member.type_id_) {
+      if (!is_fixed_size(get_members(member.members_))) {
+        return false;
+      }
+    } else if (0 == get_primitive_size(member.type_id_)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool
+is_little_endian()
+{
+  const uint16_t one = 1;
+  uint8_t first_byte;
+  std::memcpy(&first_byte, &one, 1);
+  return 1 == first_byte;
+}
+
+}  // namespace
+
+/// Reads a CDR buffer, from the end of its encapsulation header.
+class SerializedFieldAccessor::Reader
+{
+public:
+  explicit Reader(const rcl_serialized_message_t & message)
+  : buffer_(message.buffer),
+    length_(message.buffer_length)
+  {
+    // The encapsulation header starts with 0x00 0x00 for big endian CDR and 0x00 0x01 for little
+    // endian CDR.
+    if (length_ < encapsulation_size || 0 != buffer_[0] || buffer_[1] > 1) {
+      throw std::runtime_error("the serialized message is not CDR encoded");
+    }
+    swap_bytes_ = (1 == buffer_[1]) != is_little_endian();
+    buffer_ += encapsulation_size;
+    length_ -= encapsulation_size;
+  }
+
+  void
+  seek(size_t position)
+  {
+    position_ = position;
+  }
+
+  void
+  align_to(size_t alignment)
+  {
+    position_ = align(position_, alignment);
+  }
+
+  void
+  skip(size_t size, size_t count)
+  {
+    if (0 != count && count > (length_ - std::min(position_, length_)) / size) {
+      throw_truncated();
+    }
+    position_ += size * count;
+  }
+
+  void
+  read_bytes(void * value, size_t size)
+  {
+    require(size);
+    uint8_t * bytes = static_cast<uint8_t *>(value);
+    std::memcpy(bytes, buffer_ + position_, size);
+    if (swap_bytes_) {
+      std::reverse(bytes, bytes + size);
+    }
+    position_ += size;
+  }
+
+  uint32_t
+  read_length()
+  {
+    align_to(4);
+    uint32_t length;
+    read_bytes(&length, sizeof(length));
+    return length;
+  }
+
+  void
+  skip_string()
+  {
+    skip(1, read_length());
+  }
+
+  std::string
+  read_string()
+  {
+    const uint32_t length = read_length();
+    require(length);
+    const char * characters = reinterpret_cast<const char *>(buffer_ + position_);
+    position_ += length;
+    // The length includes the null terminator.
+    size_t size = length;
+    if (0 != size && '\0' == characters[size - 1]) {
+      --size;
+    }
+    return std::string(characters, size);
+  }
+
+private:
+  void
+  require(size_t size) const
+  {
+    if (position_ > length_ || size > length_ - position_) {
+      throw_truncated();
+    }
+  }
+
+  [[noreturn]] static void
+  throw_truncated()
+  {
+    throw std::runtime_error("the serialized message is truncated");
+  }
+
+  const uint8_t * buffer_;
+  size_t length_;
+  size_t position_{0};
+  bool swap_bytes_;
+};
+
+/// Resolves the steps skipping the fields of the messages.
+class SerializedFieldAccessor::Resolver
+{
+public:
+  /**
+   * \param[in] steps the steps of the accessor, extended with the steps of the messages.
+   * \param[in] position_known whether the position is known, e.g. at the beginning of the
+   *   messages, in which case the fields of fixed size are skipped at once.
+   */
+  Resolver(std::vector<std::vector<Step>> & steps, bool position_known)
+  : steps_(steps),
+    position_known_(position_known)
+  {}
+
+  /// Add the steps skipping the first members of a message to the steps of the given index.
+  void
+  skip_members(const introspection::MessageMembers * members, uint32_t count, size_t index)
+  {
+    for (uint32_t i = 0; i < count; ++i) {
+      skip_member(members->members_[i], index);
+    }
+  }
+
+  /// Add the step going to the known position, if any, to the steps of the given index.
+  void
+  flush(size_t index)
+  {
+    if (position_known_) {
+      steps_[index].push_back({Step::Kind::Seek, position_, 0, 0});
+      position_known_ = false;
+    }
+  }
+
+private:
+  void
+  skip_member(const introspection::MessageMember & member, size_t index)
+  {
+    const bool sequence = is_sequence(member);
+    const size_t count = member.is_array_ ? member.array_size_ : 1;
+    if (introspection::ROS_TYPE_STRING == member.type_id_) {
+      flush(index);
+      steps_[index].push_back(
+        {sequence ? Step::Kind::SkipStringSequence : Step::Kind::SkipStrings, 0, count, 0});
+      return;
+    }
+    if (introspection::ROS_TYPE_MESSAGE == member.type_id_) {
+      const introspection::MessageMembers * members = get_members(member.members_);
+      if (!sequence && (1 == count || (position_known_ && is_fixed_size(members)))) {
+        for (size_t i = 0; i < count; ++i) {
+          skip_members(members, members->member_count_, index);
+        }
+        return;
+      }
+      flush(index);
+      const size_t message_index = steps_.size();
+      steps_.emplace_back();
+      Resolver(steps_, false).skip_members(members, members->member_count_, message_index);
+      steps_[index].push_back(
+        {sequence ? Step::Kind::SkipMessageSequence : Step::Kind::SkipMessages, 0, count,
+          message_index});
+      return;
+    }
+    const size_t size = get_primitive_size(member.type_id_);
+    if (0 == size) {
+      throw std::invalid_argument(
+              std::string("the type of the field '") + member.name_ + "' is not supported");
+    }
+    if (sequence) {
+      flush(index);
+      steps_[index].push_back({Step::Kind::SkipPrimitiveSequence, size, 0, 0});
+    } else if (position_known_) {
+      position_ = align(position_, size) + size * count;
+    } else {
+      steps_[index].push_back({Step::Kind::SkipPrimitives, size, count, 0});
+    }
+  }
+
+  std::vector<std::vector<Step>> & steps_;
+  bool position_known_;
+  size_t position_{0};
+};
+
+SerializedFieldAccessor::SerializedFieldAccessor(
+  const rosidl_message_type_support_t * type_support,
+  const std::string & field_name)
+{
+  resolve(type_support, field_name);
+}
+
+SerializedFieldAccessor::SerializedFieldAccessor(
+  const std::string & type,
+  const std::string & field_name)
+: library_(rclcpp::get_typesupport_library(type, introspection_typesupport_identifier))
+{
+  resolve(
+    rclcpp::get_typesupport_handle(type, introspection_typesupport_identifier, *library_),
+    field_name);
+}
+
+void
+SerializedFieldAccessor::resolve(
+  const rosidl_message_type_support_t * type_support,
+  const std::string & field_name)
+{
+  if (nullptr == type_support) {
+    throw std::invalid_argument("the type support is null");
+  }
+  const rosidl_message_type_support_t * introspection_type_support =
+    get_message_typesupport_handle(type_support, introspection_typesupport_identifier);
+  if (nullptr == introspection_type_support) {
+    rcutils_reset_error();
+    throw std::invalid_argument("the type support provides no introspection information");
+  }
+
+  steps_.assign(1, {});
+  Resolver resolver(steps_, true);
+  const introspection::MessageMembers * members = get_members(introspection_type_support);
+  size_t begin = 0;
+  while (true) {
+    const size_t end = field_name.find('.', begin);
+    const std::string name = field_name.substr(begin, end - begin);
+    uint32_t index = 0;
+    while (index < members->member_count_ && name != members->members_[index].name_) {
+      ++index;
+    }
+    if (index == members->member_count_) {
+      throw std::invalid_argument(
+              "the field '" + field_name + "' does not exist in the messages of type '" +
+              members->message_namespace_ + "::" + members->message_name_ + "'");
+    }
+    const introspection::MessageMember & member = members->members_[index];
+    if (member.is_array_) {
+      throw std::invalid_argument(
+              "the field '" + field_name.substr(0, end) + "' is an array or a sequence, "
+              "which is not supported");
+    }
+    resolver.skip_members(members, index, 0);
+    if (std::string::npos == end) {
+      if (introspection::ROS_TYPE_STRING != member.type_id_ &&
+        0 == get_primitive_size(member.type_id_))
+      {
+        throw std::invalid_argument("the type of the field '" + field_name + "' is not supported");
+      }
+      field_type_id_ = member.type_id_;
+      break;
+    }
+    if (introspection::ROS_TYPE_MESSAGE != member.type_id_) {
+      throw std::invalid_argument(
+              "the field '" + field_name.substr(0, end) + "' is not a message");
+    }
+    members = get_members(member.members_);
+    begin = end + 1;
+  }
+  resolver.flush(0);
+}
+
+void
+SerializedFieldAccessor::skip(Reader & reader, const std::vector<Step> & steps) const
+{
+  for (const Step & step : steps) {
+    switch (step.kind) {
+      case Step::Kind::Seek:
+        reader.seek(step.size);
+        break;
+      case Step::Kind::SkipPrimitives:
+        reader.align_to(step.size);
+        reader.skip(step.size, step.count);
+        break;
+      case Step::Kind::SkipPrimitiveSequence:
+        {
+          const uint32_t count = reader.read_length();
+          if (0 != count) {
+            reader.align_to(step.size);
+            reader.skip(step.size, count);
+          }
+          break;
+        }
+      case Step::Kind::SkipStrings:
+        for (size_t i = 0; i < step.count; ++i) {
+          reader.skip_string();
+        }
+        break;
+      case Step::Kind::SkipStringSequence:
+        {
+          const uint32_t count = reader.read_length();
+          for (uint32_t i = 0; i < count; ++i) {
+            reader.skip_string();
+          }
+          break;
+        }
+      case Step::Kind::SkipMessages:
+        for (size_t i = 0; i < step.count; ++i) {
+          skip(reader, steps_[step.steps_index]);
+        }
+        break;
+      case Step::Kind::SkipMessageSequence:
+        {
+          const uint32_t count = reader.read_length();
+          for (uint32_t i = 0; i < count; ++i) {
+            skip(reader, steps_[step.steps_index]);
+          }
+          break;
+        }
+    }
+  }
+}
+
+template<typename T>
+void
+SerializedFieldAccessor::read_primitive(
+  const rclcpp::SerializedMessage & message,
+  bool type_matches,
+  T & value) const
+{
+  if (!type_matches) {
+    throw std::invalid_argument("the requested type is not the type of the field");
+  }
+  Reader reader(message.get_rcl_serialized_message());
+  skip(reader, steps_[0]);
+  reader.align_to(sizeof(T));
+  reader.read_bytes(&value, sizeof(T));
+}
+
+void
+SerializedFieldAccessor::read(const rclcpp::SerializedMessage & message, bool & value) const
+{
+  uint8_t byte;
+  read_primitive(message, introspection::ROS_TYPE_BOOLEAN == field_type_id_, byte);
+  value = 0 != byte;
+}
+
+void
+SerializedFieldAccessor::read(const rclcpp::SerializedMessage & message, uint8_t & value) const
+{
+  read_primitive(
+    message,
+    introspection::ROS_TYPE_UINT8 == field_type_id_ ||
+    introspection::ROS_TYPE_OCTET == field_type_id_ ||
+    introspection::ROS_TYPE_CHAR == field_type_id_,
+    value);
+}
+
+void
+SerializedFieldAccessor::read(const rclcpp::SerializedMessage & message, int8_t & value) const
+{
+  read_primitive(message, introspection::ROS_TYPE_INT8 == field_type_id_, value);
+}
+
+void
+SerializedFieldAccessor::read(const rclcpp::SerializedMessage & message, uint16_t & value) const
+{
+  read_primitive(message, introspection::ROS_TYPE_UINT16 == field_type_id_, value);
+}
+
+void
+SerializedFieldAccessor::read(const rclcpp::SerializedMessage & message, int16_t & value) const
+{
+  read_primitive(message, introspection::ROS_TYPE_INT16 == field_type_id_, value);
+}
+
+void
+SerializedFieldAccessor::read(const rclcpp::SerializedMessage & message, uint32_t & value) const
+{
+  read_primitive(message, introspection::ROS_TYPE_UINT32 == field_type_id_, value);
+}
+
+void
+SerializedFieldAccessor::read(const rclcpp::SerializedMessage & message, int32_t & value) const
+{
+  read_primitive(message, introspection::ROS_TYPE_INT32 == field_type_id_, value);
+}
+
+void
+SerializedFieldAccessor::read(const rclcpp::SerializedMessage & message, uint64_t & value) const
+{
+  read_primitive(message, introspection::ROS_TYPE_UINT64 == field_type_id_, value);
+}
+
+void
+SerializedFieldAccessor::read(const rclcpp::SerializedMessage & message, int64_t & value) const
+{
+  read_primitive(message, introspection::ROS_TYPE_INT64 == field_type_id_, value);
+}
+
+void
+SerializedFieldAccessor::read(const rclcpp::SerializedMessage & message, float & value) const
+{
+  read_primitive(message, introspection::ROS_TYPE_FLOAT == field_type_id_, value);
+}
+
+void
+SerializedFieldAccessor::read(const rclcpp::SerializedMessage & message, double & value) const
+{
+  read_primitive(message, introspection::ROS_TYPE_DOUBLE == field_type_id_, value);
+}
+
+void
+SerializedFieldAccessor::read(
+  const rclcpp::SerializedMessage & message,
+  std::string & value) const
+{
+  if (introspection::ROS_TYPE_STRING != field_type_id_) {
+    throw std::invalid_argument("the requested type is not the type of the field");
+  }
+  Reader reader(message.get_rcl_serialized_message());
+  skip(reader, steps_[0]);
+  value = reader.read_string();
+}
+
+}  // namespace rclcpp
@@ -15,6 +15,7 @@
 #include "rclcpp/serialized_message.hpp"
 
 #include <cstring>
+#include <utility>
 
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/logging.hpp"
@@ -55,6 +56,25 @@ SerializedMessage::SerializedMessage(
   }
 }
 
+SerializedMessage::SerializedMessage(
+  const uint8_t * buffer,
+  size_t length,
+  ExternalBufferDeleter deleter,
+  const rcl_allocator_t & allocator)
+: serialized_message_(rmw_get_zero_initialized_serialized_message()),
+  external_buffer_deleter_(std::move(deleter))
+{
+  if (!external_buffer_deleter_) {
+    // The caller keeps the buffer alive, but the message must still know it is external.
+    external_buffer_deleter_ = [](const uint8_t *, size_t) {};
+  }
+  // The buffer is never written through the message, see copy_external_buffer().
+  serialized_message_.buffer = const_cast<uint8_t *>(buffer);
+  serialized_message_.buffer_length = length;
+  serialized_message_.buffer_capacity = length;
+  serialized_message_.allocator = allocator;
+}
+
 SerializedMessage::SerializedMessage(const SerializedMessage & other)
 : SerializedMessage(other.serialized_message_)
 {}
@@ -67,7 +87,8 @@ SerializedMessage::SerializedMessage(const rcl_serialized_message_t & other)
 
 SerializedMessage::SerializedMessage(SerializedMessage && other)
 : serialized_message_(
-    std::exchange(other.serialized_message_, rmw_get_zero_initialized_serialized_message()))
+    std::exchange(other.serialized_message_, rmw_get_zero_initialized_serialized_message())),
+  external_buffer_deleter_(std::exchange(other.external_buffer_deleter_, nullptr))
 {}
 
 SerializedMessage::SerializedMessage(rcl_serialized_message_t && other)
@@ -78,6 +99,7 @@ SerializedMessage::SerializedMessage(rcl_serialized_message_t && other)
 SerializedMessage & SerializedMessage::operator=(const SerializedMessage & other)
 {
   if (this != &other) {
+    release_external_buffer();
     serialized_message_ = rmw_get_zero_initialized_serialized_message();
     copy_rcl_message(other.serialized_message_, serialized_message_);
   }
@@ -88,6 +110,7 @@ SerializedMessage & SerializedMessage::operator=(const SerializedMessage & other
 SerializedMessage & SerializedMessage::operator=(const rcl_serialized_message_t & other)
 {
   if (&serialized_message_ != &other) {
+    release_external_buffer();
     serialized_message_ = rmw_get_zero_initialized_serialized_message();
     copy_rcl_message(other, serialized_message_);
   }
@@ -98,8 +121,10 @@ SerializedMessage & SerializedMessage::operator=(const rcl_serialized_message_t
 SerializedMessage & SerializedMessage::operator=(SerializedMessage && other)
 {
   if (this != &other) {
+    release_external_buffer();
     serialized_message_ =
       std::exchange(other.serialized_message_, rmw_get_zero_initialized_serialized_message());
+    external_buffer_deleter_ = std::exchange(other.external_buffer_deleter_, nullptr);
   }
 
   return *this;
@@ -108,6 +133,7 @@ SerializedMessage & SerializedMessage::operator=(SerializedMessage && other)
 SerializedMessage & SerializedMessage::operator=(rcl_serialized_message_t && other)
 {
   if (&serialized_message_ != &other) {
+    release_external_buffer();
     serialized_message_ =
       std::exchange(other, rmw_get_zero_initialized_serialized_message());
   }
@@ -116,7 +142,9 @@ SerializedMessage & SerializedMessage::operator=(rcl_serialized_message_t && oth
 
 SerializedMessage::~SerializedMessage()
 {
-  if (nullptr != serialized_message_.buffer) {
+  if (external_buffer_deleter_) {
+    release_external_buffer();
+  } else if (nullptr != serialized_message_.buffer) {
     const auto fini_ret = rmw_serialized_message_fini(&serialized_message_);
     if (RCL_RET_OK != fini_ret) {
       RCLCPP_ERROR(
@@ -146,8 +174,14 @@ size_t SerializedMessage::capacity() const
   return serialized_message_.buffer_capacity;
 }
 
+bool SerializedMessage::uses_external_buffer() const
+{
+  return static_cast<bool>(external_buffer_deleter_);
+}
+
 void SerializedMessage::reserve(size_t capacity)
 {
+  copy_external_buffer();
   auto ret = rmw_serialized_message_resize(&serialized_message_, capacity);
   if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret);
@@ -156,9 +190,33 @@ void SerializedMessage::reserve(size_t capacity)
 
 rcl_serialized_message_t SerializedMessage::release_rcl_serialized_message()
 {
+  copy_external_buffer();
   auto ret = serialized_message_;
   serialized_message_ = rmw_get_zero_initialized_serialized_message();
 
   return ret;
 }
+
+void SerializedMessage::copy_external_buffer()
+{
+  if (!external_buffer_deleter_) {
+    return;
+  }
+  auto owned = rmw_get_zero_initialized_serialized_message();
+  copy_rcl_message(serialized_message_, owned);
+  release_external_buffer();
+  serialized_message_ = owned;
+}
+
+void SerializedMessage::release_external_buffer()
+{
+  if (!external_buffer_deleter_) {
+    return;
+  }
+  auto deleter = std::exchange(external_buffer_deleter_, nullptr);
+  const rcl_allocator_t allocator = serialized_message_.allocator;
+  deleter(serialized_message_.buffer, serialized_message_.buffer_capacity);
+  serialized_message_ = rmw_get_zero_initialized_serialized_message();
+  serialized_message_.allocator = allocator;
+}
 }  // namespace rclcpp
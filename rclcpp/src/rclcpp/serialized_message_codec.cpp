@@ -0,0 +1,136 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/serialized_message_codec.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace rclcpp
+{
+
+namespace
+{
+
+// The header of an encoded message is the magic number, the length of the name of the codec,
+// the name, and the size of the decoded message on 8 bytes, in little endian.
+// A CDR serialized message starts with a zero byte, so it is not mistaken for an encoded one.
+constexpr uint8_t kMagic[] = {'R', 'C', 'Z', 1};
+constexpr size_t kDecodedSizeLength = 8;
+
+size_t
+header_length(size_t name_length)
+{
+  return sizeof(kMagic) + 1 + name_length + kDecodedSizeLength;
+}
+
+}  // namespace
+
+SerializedMessageCodec::SerializedMessageCodec(const std::string & name)
+: name_(name)
+{
+  if (name_.empty() || name_.size() > 255) {
+    throw std::invalid_argument(
+            "the name of a serialized message codec must have 1 to 255 characters");
+  }
+}
+
+SerializedMessageCodec::~SerializedMessageCodec() = default;
+
+const std::string &
+SerializedMessageCodec::get_name() const
+{
+  return name_;
+}
+
+rclcpp::SerializedMessage
+SerializedMessageCodec::encode(const rclcpp::SerializedMessage & message)
+{
+  const auto & rcl_message = message.get_rcl_serialized_message();
+  const size_t size = rcl_message.buffer_length;
+  const size_t header_size = header_length(name_.size());
+  rclcpp::SerializedMessage encoded_message(
+    header_size + max_compressed_size(size), rcl_message.allocator);
+  auto & rcl_encoded_message = encoded_message.get_rcl_serialized_message();
+
+  uint8_t * header = rcl_encoded_message.buffer;
+  std::memcpy(header, kMagic, sizeof(kMagic));
+  header += sizeof(kMagic);
+  *header++ = static_cast<uint8_t>(name_.size());
+  std::memcpy(header, name_.data(), name_.size());
+  header += name_.size();
+  for (size_t i = 0; i < kDecodedSizeLength; ++i) {
+    *header++ = static_cast<uint8_t>(static_cast<uint64_t>(size) >> (8 * i));
+  }
+
+  const size_t compressed_size = compress(
+    rcl_message.buffer, size, header, rcl_encoded_message.buffer_capacity - header_size);
+  if (0 == compressed_size && 0 != size) {
+    throw std::runtime_error("failed to compress a message with codec '" + name_ + "'");
+  }
+  if (header_size + compressed_size >= size) {
+    return message;
+  }
+  rcl_encoded_message.buffer_length = header_size + compressed_size;
+  return encoded_message;
+}
+
+void
+SerializedMessageCodec::decode(
+  const rclcpp::SerializedMessage & message, rclcpp::SerializedMessage & decoded_message)
+{
+  if (!is_encoded(message)) {
+    throw std::runtime_error("the message was not encoded by a codec");
+  }
+  const auto & rcl_message = message.get_rcl_serialized_message();
+  const uint8_t * header = rcl_message.buffer + sizeof(kMagic);
+  const size_t name_length = *header++;
+  const size_t header_size = header_length(name_length);
+  if (rcl_message.buffer_length < header_size) {
+    throw std::runtime_error("the header of an encoded message is truncated");
+  }
+  if (name_length != name_.size() || 0 != std::memcmp(header, name_.data(), name_length)) {
+    throw std::runtime_error(
+            "the message was encoded with codec '" +
+            std::string(reinterpret_cast<const char *>(header), name_length) +
+            "' instead of '" + name_ + "'");
+  }
+  header += name_length;
+  uint64_t size = 0;
+  for (size_t i = 0; i < kDecodedSizeLength; ++i) {
+    size |= static_cast<uint64_t>(*header++) << (8 * i);
+  }
+
+  if (decoded_message.capacity() < size) {
+    decoded_message.reserve(size);
+  }
+  auto & rcl_decoded_message = decoded_message.get_rcl_serialized_message();
+  if (!decompress(
+      header, rcl_message.buffer_length - header_size, rcl_decoded_message.buffer, size))
+  {
+    throw std::runtime_error("failed to decompress a message with codec '" + name_ + "'");
+  }
+  rcl_decoded_message.buffer_length = size;
+}
+
+bool
+SerializedMessageCodec::is_encoded(const rclcpp::SerializedMessage & message)
+{
+  const auto & rcl_message = message.get_rcl_serialized_message();
+  return rcl_message.buffer_length > sizeof(kMagic) &&
+         0 == std::memcmp(rcl_message.buffer, kMagic, sizeof(kMagic));
+}
+
+}  // namespace rclcpp
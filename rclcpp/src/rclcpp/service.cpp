@@ -17,12 +17,19 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include "rclcpp/any_service_callback.hpp"
+#include "rclcpp/detail/cpp_callback_trampoline.hpp"
+#include "rclcpp/exceptions.hpp"
+#include "rclcpp/experimental/intra_process_manager.hpp"
+#include "rclcpp/logging.hpp"
 #include "rclcpp/macros.hpp"
 #include "rmw/error_handling.h"
+#include "rmw/impl/cpp/demangle.hpp"
 #include "rmw/rmw.h"
 
 using rclcpp::ServiceBase;
@@ -32,7 +39,32 @@ ServiceBase::ServiceBase(std::shared_ptr<rcl_node_t> node_handle)
 {}
 
 ServiceBase::~ServiceBase()
-{}
+{
+  clear_on_new_request_callback();
+  if (intra_process_service_) {
+    auto ipm = weak_ipm_.lock();
+    if (ipm) {
+      ipm->remove_service(intra_process_service_id_);
+    }
+  }
+}
+
+rclcpp::Waitable::SharedPtr
+ServiceBase::get_intra_process_waitable() const
+{
+  return intra_process_service_;
+}
+
+void
+ServiceBase::setup_intra_process(
+  rclcpp::experimental::ServiceIntraProcessBase::SharedPtr intra_process_service,
+  rclcpp::Context::SharedPtr context)
+{
+  auto ipm = context->get_sub_context<rclcpp::experimental::IntraProcessManager>();
+  intra_process_service_id_ = ipm->add_service(intra_process_service);
+  intra_process_service_ = std::move(intra_process_service);
+  weak_ipm_ = ipm;
+}
 
 bool
 ServiceBase::take_type_erased_request(void * request_out, rmw_request_id_t & request_id_out)
@@ -84,3 +116,73 @@ ServiceBase::exchange_in_use_by_wait_set_state(bool in_use_state)
 {
   return in_use_by_wait_set_.exchange(in_use_state);
 }
+
+void
+ServiceBase::set_on_new_request_callback(std::function<void(size_t)> callback)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_new_request_callback is not callable.");
+  }
+
+  auto new_callback =
+    [callback, this](size_t number_of_requests) {
+      try {
+        callback(number_of_requests);
+      } catch (const std::exception & exception) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::ServiceBase@" << this <<
+            " caught " << rmw::impl::cpp::demangle(exception) <<
+            " exception in user-provided callback for the 'on new request' callback: " <<
+            exception.what());
+      } catch (...) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::ServiceBase@" << this <<
+            " caught unhandled exception in user-provided callback " <<
+            "for the 'on new request' callback");
+      }
+    };
+
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+
+  // Set it temporarily to the new callback, while we replace the old one.
+  // This two-step setting, prevents a gap where the old std::function has
+  // been replaced but the middleware hasn't been told about the new one yet.
+  set_on_new_request_callback(
+    rclcpp::detail::cpp_callback_trampoline<const void *, size_t>,
+    static_cast<const void *>(&new_callback));
+
+  // Store the std::function to keep it in scope, also overwrites the existing one.
+  on_new_request_callback_ = new_callback;
+
+  // Set it again, now using the permanent storage.
+  set_on_new_request_callback(
+    rclcpp::detail::cpp_callback_trampoline<const void *, size_t>,
+    static_cast<const void *>(&on_new_request_callback_));
+}
+
+void
+ServiceBase::clear_on_new_request_callback()
+{
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  if (on_new_request_callback_) {
+    set_on_new_request_callback(nullptr, nullptr);
+    on_new_request_callback_ = nullptr;
+  }
+}
+
+void
+ServiceBase::set_on_new_request_callback(rcl_event_callback_t callback, const void * user_data)
+{
+  rcl_ret_t ret = rcl_service_set_on_new_request_callback(
+    service_handle_.get(),
+    callback,
+    user_data);
+
+  if (RCL_RET_OK != ret) {
+    using rclcpp::exceptions::throw_from_rcl_error;
+    throw_from_rcl_error(ret, "failed to set the on new request callback for service");
+  }
+}
@@ -0,0 +1,118 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/experimental/service_intra_process_base.hpp"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "rclcpp/logging.hpp"
+
+#include "rmw/impl/cpp/demangle.hpp"
+
+using rclcpp::experimental::ServiceIntraProcessBase;
+
+ServiceIntraProcessBase::ServiceIntraProcessBase(
+  rclcpp::Context::SharedPtr context,
+  const std::string & service_name)
+: service_name_(service_name),
+  guard_condition_(std::move(context))
+{}
+
+ServiceIntraProcessBase::~ServiceIntraProcessBase()
+{
+  clear_on_ready_callback();
+}
+
+bool
+ServiceIntraProcessBase::add_to_wait_set(rcl_wait_set_t * wait_set)
+{
+  rcl_ret_t ret = rcl_wait_set_add_guard_condition(
+    wait_set, &guard_condition_.get_rcl_guard_condition(), NULL);
+  return RCL_RET_OK == ret;
+}
+
+const char *
+ServiceIntraProcessBase::get_service_name() const
+{
+  return service_name_.c_str();
+}
+
+void
+ServiceIntraProcessBase::set_on_ready_callback(std::function<void(size_t, int)> callback)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_ready_callback is not callable.");
+  }
+
+  // Note: we bind the int identifier argument to this waitable's entity types
+  auto new_callback =
+    [callback, this](size_t number_of_events) {
+      try {
+        callback(number_of_events, 0);
+      } catch (const std::exception & exception) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::ServiceIntraProcessBase@" << this <<
+            " caught " << rmw::impl::cpp::demangle(exception) <<
+            " exception in user-provided callback for the 'on ready' callback: " <<
+            exception.what());
+      } catch (...) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::ServiceIntraProcessBase@" << this <<
+            " caught unhandled exception in user-provided callback " <<
+            "for the 'on ready' callback");
+      }
+    };
+
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  on_new_request_callback_ = new_callback;
+
+  if (unread_count_ > 0) {
+    on_new_request_callback_(unread_count_);
+    unread_count_ = 0;
+  }
+}
+
+void
+ServiceIntraProcessBase::clear_on_ready_callback()
+{
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  on_new_request_callback_ = nullptr;
+}
+
+void
+ServiceIntraProcessBase::notify_new_request()
+{
+  guard_condition_.trigger();
+
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  if (on_new_request_callback_) {
+    on_new_request_callback_(1);
+  } else {
+    unread_count_++;
+  }
+}
+
+void
+ServiceIntraProcessBase::trigger_guard_condition()
+{
+  guard_condition_.trigger();
+}
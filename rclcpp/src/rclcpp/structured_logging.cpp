@@ -0,0 +1,781 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/structured_logging.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "rcutils/error_handling.h"
+
+#include "./detail/log_formatting.hpp"
+
+namespace rclcpp
+{
+namespace structured_logging
+{
+
+namespace detail
+{
+std::atomic<bool> g_enabled{false};
+}  // namespace detail
+
+namespace
+{
+
+constexpr char kFileMagic[8] = {'R', 'C', 'L', 'S', 'L', 'O', 'G', '\0'};
+constexpr uint32_t kFileVersion = 1u;
+constexpr uint8_t kFileSiteEntry = 'S';
+constexpr uint8_t kFileRecordEntry = 'R';
+
+constexpr size_t kDefaultThreadBufferSize = 64u * 1024u;
+constexpr std::chrono::milliseconds kDrainPeriod{10};
+
+/// Sites registered by the logging macros, which are never unregistered.
+class SiteRegistry
+{
+public:
+  uint32_t
+  add(Site site)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    site.id = static_cast<uint32_t>(sites_.size());
+    sites_.push_back(std::move(site));
+    return sites_.back().id;
+  }
+
+  const Site *
+  find(uint32_t id)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return id < sites_.size() ? &sites_[id] : nullptr;
+  }
+
+private:
+  std::mutex mutex_;
+  // A deque, so that the sites do not move when a site is added.
+  std::deque<Site> sites_;
+};
+
+SiteRegistry &
+get_site_registry()
+{
+  static SiteRegistry registry;
+  return registry;
+}
+
+template<typename T>
+T
+read_value(const uint8_t *& in, const uint8_t * end)
+{
+  T value;
+  if (static_cast<size_t>(end - in) < sizeof(value)) {
+    throw std::runtime_error("truncated structured log record");
+  }
+  std::memcpy(&value, in, sizeof(value));
+  in += sizeof(value);
+  return value;
+}
+
+std::string
+read_string(const uint8_t *& in, const uint8_t * end, size_t length)
+{
+  if (static_cast<size_t>(end - in) < length) {
+    throw std::runtime_error("truncated structured log record");
+  }
+  std::string value(reinterpret_cast<const char *>(in), length);
+  in += length;
+  return value;
+}
+
+void
+read_arguments(const uint8_t *& in, const uint8_t * end, std::vector<Argument> & arguments)
+{
+  const auto count = read_value<uint8_t>(in, end);
+  arguments.clear();
+  arguments.reserve(count);
+  for (uint8_t i = 0u; i < count; ++i) {
+    switch (read_value<uint8_t>(in, end)) {
+      case detail::SignedTag:
+        arguments.emplace_back(read_value<int64_t>(in, end));
+        break;
+      case detail::UnsignedTag:
+        arguments.emplace_back(read_value<uint64_t>(in, end));
+        break;
+      case detail::FloatingPointTag:
+        arguments.emplace_back(read_value<double>(in, end));
+        break;
+      case detail::StringTag:
+        arguments.emplace_back(read_string(in, end, read_value<uint32_t>(in, end)));
+        break;
+      default:
+        throw std::runtime_error("invalid argument of structured log record");
+    }
+  }
+}
+
+template<typename T>
+void
+write_value(std::string & out, const T & value)
+{
+  out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void
+write_string(std::string & out, const std::string & value)
+{
+  write_value(out, static_cast<uint32_t>(value.size()));
+  out.append(value);
+}
+
+void
+write_arguments(std::string & out, const std::vector<Argument> & arguments)
+{
+  write_value(out, static_cast<uint8_t>(arguments.size()));
+  for (const auto & argument : arguments) {
+    if (const auto * value = std::get_if<int64_t>(&argument)) {
+      write_value(out, static_cast<uint8_t>(detail::SignedTag));
+      write_value(out, *value);
+    } else if (const auto * value = std::get_if<uint64_t>(&argument)) {
+      write_value(out, static_cast<uint8_t>(detail::UnsignedTag));
+      write_value(out, *value);
+    } else if (const auto * value = std::get_if<double>(&argument)) {
+      write_value(out, static_cast<uint8_t>(detail::FloatingPointTag));
+      write_value(out, *value);
+    } else {
+      write_value(out, static_cast<uint8_t>(detail::StringTag));
+      write_string(out, std::get<std::string>(argument));
+    }
+  }
+}
+
+/// Decode a record of a thread buffer, see rclcpp::structured_logging::detail::ThreadBuffer.
+void
+decode_record(const uint8_t * data, size_t size, Record & record)
+{
+  const uint8_t * in = data + sizeof(uint32_t);
+  const uint8_t * end = data + size;
+  const auto site_id = read_value<uint32_t>(in, end);
+  record.site = get_site_registry().find(site_id);
+  if (!record.site) {
+    throw std::runtime_error("unknown site of structured log record");
+  }
+  record.timestamp = read_value<int64_t>(in, end);
+  record.logger_name = read_string(in, end, read_value<uint16_t>(in, end));
+  read_arguments(in, end, record.arguments);
+}
+
+/// Thread buffers and sinks, and the background thread moving the records from the former to the
+/// latter.
+class Collector
+{
+public:
+  ~Collector()
+  {
+    try {
+      drain();
+    } catch (...) {
+    }
+    stop_thread();
+  }
+
+  std::shared_ptr<detail::ThreadBuffer>
+  create_thread_buffer()
+  {
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    auto buffer = std::make_shared<detail::ThreadBuffer>(thread_buffer_size_);
+    buffers_.push_back(buffer);
+    return buffer;
+  }
+
+  void
+  set_thread_buffer_size(size_t size)
+  {
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    thread_buffer_size_ = size;
+  }
+
+  void
+  add_sink(Sink::SharedPtr sink)
+  {
+    if (!sink) {
+      throw std::invalid_argument("the structured logging sink must not be null");
+    }
+    {
+      std::lock_guard<std::mutex> lock(drain_mutex_);
+      sinks_.push_back(std::move(sink));
+    }
+    std::lock_guard<std::mutex> lock(thread_mutex_);
+    if (!thread_.joinable()) {
+      stopping_ = false;
+      thread_ = std::thread(&Collector::run, this);
+    }
+    detail::g_enabled.store(true);
+  }
+
+  void
+  remove_sink(const Sink::SharedPtr & sink)
+  {
+    drain();
+    bool no_sinks;
+    {
+      std::lock_guard<std::mutex> lock(drain_mutex_);
+      sinks_.erase(std::remove(sinks_.begin(), sinks_.end(), sink), sinks_.end());
+      no_sinks = sinks_.empty();
+    }
+    if (no_sinks) {
+      detail::g_enabled.store(false);
+      stop_thread();
+    }
+  }
+
+  void
+  drain()
+  {
+    std::vector<std::shared_ptr<detail::ThreadBuffer>> buffers;
+    {
+      std::lock_guard<std::mutex> lock(buffers_mutex_);
+      buffers = buffers_;
+    }
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    std::vector<const detail::ThreadBuffer *> exhausted_buffers;
+    for (const auto & buffer : buffers) {
+      // Read before consuming, so that the records of an exited thread are all consumed.
+      const bool orphaned = buffer->orphaned.load();
+      buffer->consume(
+        [this](const uint8_t * data, size_t size) {
+          try {
+            decode_record(data, size, record_);
+          } catch (const std::exception & exception) {
+            RCUTILS_SAFE_FWRITE_TO_STDERR(exception.what());
+            RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+            return;
+          }
+          for (const auto & sink : sinks_) {
+            sink->consume(record_);
+          }
+        });
+      if (orphaned) {
+        exhausted_buffers.push_back(buffer.get());
+      }
+    }
+    for (const auto & sink : sinks_) {
+      sink->flush();
+    }
+    if (!exhausted_buffers.empty()) {
+      std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+      buffers_.erase(
+        std::remove_if(
+          buffers_.begin(), buffers_.end(),
+          [&exhausted_buffers](const std::shared_ptr<detail::ThreadBuffer> & buffer) {
+            return exhausted_buffers.end() != std::find(
+              exhausted_buffers.begin(), exhausted_buffers.end(), buffer.get());
+          }),
+        buffers_.end());
+    }
+  }
+
+  std::atomic<uint64_t> dropped_record_count{0u};
+
+private:
+  void
+  run()
+  {
+    std::unique_lock<std::mutex> lock(thread_mutex_);
+    while (!stopping_) {
+      wake_condition_.wait_for(lock, kDrainPeriod);
+      lock.unlock();
+      try {
+        drain();
+      } catch (const std::exception & exception) {
+        RCUTILS_SAFE_FWRITE_TO_STDERR(exception.what());
+        RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+      }
+      lock.lock();
+    }
+  }
+
+  void
+  stop_thread()
+  {
+    std::thread thread;
+    {
+      std::lock_guard<std::mutex> lock(thread_mutex_);
+      stopping_ = true;
+      wake_condition_.notify_all();
+      thread = std::move(thread_);
+    }
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+
+  std::mutex buffers_mutex_;
+  std::vector<std::shared_ptr<detail::ThreadBuffer>> buffers_;
+  size_t thread_buffer_size_{kDefaultThreadBufferSize};
+
+  // Held while consuming, so that the sinks are never called concurrently.
+  std::mutex drain_mutex_;
+  std::vector<Sink::SharedPtr> sinks_;
+  // Reused by each record, so that its arguments are only allocated once.
+  Record record_;
+
+  std::mutex thread_mutex_;
+  std::condition_variable wake_condition_;
+  bool stopping_{false};
+  std::thread thread_;
+};
+
+Collector &
+get_collector()
+{
+  static Collector collector;
+  return collector;
+}
+
+size_t
+round_up_to_power_of_two(size_t size)
+{
+  size_t rounded = 64u;
+  while (rounded < size) {
+    rounded *= 2u;
+  }
+  return rounded;
+}
+
+// Marks the buffer of the thread orphaned when the thread exits.
+struct ThreadBufferHolder
+{
+  ~ThreadBufferHolder()
+  {
+    if (buffer) {
+      buffer->orphaned.store(true);
+    }
+  }
+
+  std::shared_ptr<detail::ThreadBuffer> buffer;
+};
+
+/// Format a single conversion specification with its argument, appending to the result.
+template<typename T>
+void
+append_formatted(std::string & result, const std::string & specification, T value)
+{
+  char buffer[256];
+  const int length = std::snprintf(buffer, sizeof(buffer), specification.c_str(), value);
+  if (length < 0) {
+    return;
+  }
+  if (static_cast<size_t>(length) < sizeof(buffer)) {
+    result.append(buffer, static_cast<size_t>(length));
+    return;
+  }
+  const size_t offset = result.size();
+  result.resize(offset + static_cast<size_t>(length));
+  std::snprintf(&result[offset], static_cast<size_t>(length) + 1u, specification.c_str(), value);
+}
+
+long long
+to_signed(const Argument & argument)
+{
+  return std::visit(
+    [](const auto & value) -> long long {
+      if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::string>) {
+        return 0;
+      } else {
+        return static_cast<long long>(value);
+      }
+    }, argument);
+}
+
+unsigned long long
+to_unsigned(const Argument & argument)
+{
+  return static_cast<unsigned long long>(to_signed(argument));
+}
+
+double
+to_double(const Argument & argument)
+{
+  return std::visit(
+    [](const auto & value) -> double {
+      if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::string>) {
+        return 0.0;
+      } else {
+        return static_cast<double>(value);
+      }
+    }, argument);
+}
+
+std::string
+to_string(const Argument & argument)
+{
+  return std::visit(
+    [](const auto & value) -> std::string {
+      if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::string>) {
+        return value;
+      } else {
+        return std::to_string(value);
+      }
+    }, argument);
+}
+
+}  // namespace
+
+std::string
+format(const Record & record)
+{
+  const std::string & format_string = record.site->format;
+  const auto & arguments = record.arguments;
+  size_t next_argument = 0u;
+  auto take_argument = [&arguments, &next_argument]() -> const Argument * {
+      return next_argument < arguments.size() ? &arguments[next_argument++] : nullptr;
+    };
+
+  std::string result;
+  result.reserve(format_string.size());
+  size_t i = 0u;
+  while (i < format_string.size()) {
+    if ('%' != format_string[i]) {
+      result.push_back(format_string[i++]);
+      continue;
+    }
+    if (i + 1u < format_string.size() && '%' == format_string[i + 1u]) {
+      result.push_back('%');
+      i += 2u;
+      continue;
+    }
+    // Rebuild the conversion specification, without its length modifier as the numbers are
+    // stored with 64 bits.
+    const size_t start = i++;
+    std::string specification("%");
+    while (i < format_string.size() && std::strchr("-+ #0", format_string[i])) {
+      specification.push_back(format_string[i++]);
+    }
+    for (int field = 0; field < 2 && i < format_string.size(); ++field) {
+      if (1 == field) {
+        if ('.' != format_string[i]) {
+          break;
+        }
+        specification.push_back(format_string[i++]);
+      }
+      if (i < format_string.size() && '*' == format_string[i]) {
+        const Argument * argument = take_argument();
+        specification += std::to_string(argument ? to_signed(*argument) : 0);
+        ++i;
+      }
+      while (i < format_string.size() && format_string[i] >= '0' && format_string[i] <= '9') {
+        specification.push_back(format_string[i++]);
+      }
+    }
+    while (i < format_string.size() && std::strchr("hlLqjzt", format_string[i])) {
+      ++i;
+    }
+    if (i >= format_string.size()) {
+      result.append(format_string, start, std::string::npos);
+      break;
+    }
+    const char conversion = format_string[i++];
+    const Argument * argument = take_argument();
+    if (!argument) {
+      result.append(format_string, start, i - start);
+      continue;
+    }
+    switch (conversion) {
+      case 'd':
+      case 'i':
+        append_formatted(result, specification + "ll" + conversion, to_signed(*argument));
+        break;
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+        append_formatted(result, specification + "ll" + conversion, to_unsigned(*argument));
+        break;
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A':
+        append_formatted(result, specification + conversion, to_double(*argument));
+        break;
+      case 'c':
+        append_formatted(
+          result, specification + conversion, static_cast<int>(to_signed(*argument)));
+        break;
+      case 'p':
+        append_formatted(
+          result, specification + conversion,
+          reinterpret_cast<void *>(static_cast<uintptr_t>(to_unsigned(*argument))));
+        break;
+      case 's':
+        append_formatted(result, specification + conversion, to_string(*argument).c_str());
+        break;
+      default:
+        result.append(format_string, start, i - start);
+        break;
+    }
+  }
+  return result;
+}
+
+Sink::~Sink()
+{}
+
+void
+Sink::flush()
+{}
+
+void
+OutputSink::consume(const Record & record)
+{
+  rcutils_logging_output_handler_t output_handler = rcutils_logging_get_output_handler();
+  if (!output_handler) {
+    return;
+  }
+  const rcutils_log_location_t location = {
+    record.site->function_name.c_str(), record.site->file_name.c_str(), record.site->line_number};
+  rclcpp::detail::call_output_handler(
+    output_handler, &location, record.site->severity, record.logger_name.c_str(),
+    record.timestamp, "%s", format(record).c_str());
+}
+
+BinaryFileSink::BinaryFileSink(const std::string & path)
+: file_(path, std::ios::binary | std::ios::trunc)
+{
+  if (!file_) {
+    throw std::runtime_error("failed to open structured log file '" + path + "'");
+  }
+  file_.write(kFileMagic, sizeof(kFileMagic));
+  file_.write(reinterpret_cast<const char *>(&kFileVersion), sizeof(kFileVersion));
+}
+
+BinaryFileSink::~BinaryFileSink()
+{
+  flush();
+}
+
+void
+BinaryFileSink::consume(const Record & record)
+{
+  const Site & site = *record.site;
+  if (written_sites_.insert(site.id).second) {
+    write_value(buffer_, kFileSiteEntry);
+    write_value(buffer_, site.id);
+    write_value(buffer_, static_cast<int32_t>(site.severity));
+    write_value(buffer_, static_cast<uint64_t>(site.line_number));
+    write_string(buffer_, site.format);
+    write_string(buffer_, site.function_name);
+    write_string(buffer_, site.file_name);
+  }
+  write_value(buffer_, kFileRecordEntry);
+  write_value(buffer_, site.id);
+  write_value(buffer_, static_cast<int64_t>(record.timestamp));
+  write_string(buffer_, record.logger_name);
+  write_arguments(buffer_, record.arguments);
+}
+
+void
+BinaryFileSink::flush()
+{
+  file_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  file_.flush();
+  buffer_.clear();
+}
+
+void
+read_binary_file(const std::string & path, std::function<void(const Record &)> callback)
+{
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("failed to open structured log file '" + path + "'");
+  }
+  const std::string content(
+    (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  const auto * in = reinterpret_cast<const uint8_t *>(content.data());
+  const uint8_t * end = in + content.size();
+  if (content.size() < sizeof(kFileMagic) + sizeof(kFileVersion) ||
+    0 != std::memcmp(in, kFileMagic, sizeof(kFileMagic)))
+  {
+    throw std::runtime_error("'" + path + "' is not a structured log file");
+  }
+  in += sizeof(kFileMagic);
+  if (kFileVersion != read_value<uint32_t>(in, end)) {
+    throw std::runtime_error("unsupported version of structured log file '" + path + "'");
+  }
+
+  std::unordered_map<uint32_t, Site> sites;
+  Record record;
+  while (in < end) {
+    const auto entry = read_value<uint8_t>(in, end);
+    if (kFileSiteEntry == entry) {
+      Site site;
+      site.id = read_value<uint32_t>(in, end);
+      site.severity = read_value<int32_t>(in, end);
+      site.line_number = static_cast<size_t>(read_value<uint64_t>(in, end));
+      site.format = read_string(in, end, read_value<uint32_t>(in, end));
+      site.function_name = read_string(in, end, read_value<uint32_t>(in, end));
+      site.file_name = read_string(in, end, read_value<uint32_t>(in, end));
+      sites[site.id] = std::move(site);
+    } else if (kFileRecordEntry == entry) {
+      const auto site = sites.find(read_value<uint32_t>(in, end));
+      if (sites.end() == site) {
+        throw std::runtime_error("unknown site of structured log record");
+      }
+      record.site = &site->second;
+      record.timestamp = read_value<int64_t>(in, end);
+      record.logger_name = read_string(in, end, read_value<uint32_t>(in, end));
+      read_arguments(in, end, record.arguments);
+      callback(record);
+    } else {
+      throw std::runtime_error("invalid entry in structured log file '" + path + "'");
+    }
+  }
+}
+
+void
+add_sink(Sink::SharedPtr sink)
+{
+  get_collector().add_sink(std::move(sink));
+}
+
+void
+remove_sink(const Sink::SharedPtr & sink)
+{
+  get_collector().remove_sink(sink);
+}
+
+void
+flush()
+{
+  get_collector().drain();
+}
+
+void
+set_thread_buffer_size(size_t size)
+{
+  get_collector().set_thread_buffer_size(size);
+}
+
+uint64_t
+get_dropped_record_count()
+{
+  return get_collector().dropped_record_count.load(std::memory_order_relaxed);
+}
+
+namespace detail
+{
+
+uint32_t
+register_site(
+  const char * format, int severity, const char * function_name, const char * file_name,
+  size_t line_number)
+{
+  return get_site_registry().add(
+    {0u, severity, format ? format : "", function_name, file_name, line_number});
+}
+
+void
+count_dropped_record()
+{
+  get_collector().dropped_record_count.fetch_add(1u, std::memory_order_relaxed);
+}
+
+ThreadBuffer::ThreadBuffer(size_t size)
+: mask_(round_up_to_power_of_two(size) - 1u)
+{
+  data_ = std::make_unique<uint8_t[]>(mask_ + 1u);
+}
+
+ThreadBuffer &
+ThreadBuffer::get()
+{
+  thread_local ThreadBufferHolder holder;
+  if (!holder.buffer) {
+    holder.buffer = get_collector().create_thread_buffer();
+  }
+  return *holder.buffer;
+}
+
+uint8_t *
+ThreadBuffer::reserve(size_t size)
+{
+  const uint64_t capacity = mask_ + 1u;
+  const uint64_t write_position = write_position_.load(std::memory_order_relaxed);
+  const uint64_t used = write_position - read_position_.load(std::memory_order_acquire);
+  const uint64_t offset = write_position & mask_;
+  // Records do not wrap, the end of the buffer is skipped if the record does not fit in it.
+  const uint64_t skipped = capacity - offset < size ? capacity - offset : 0u;
+  if (used + skipped + size > capacity) {
+    return nullptr;
+  }
+  if (skipped) {
+    const uint32_t wrap_marker = 0u;
+    std::memcpy(&data_[offset], &wrap_marker, sizeof(wrap_marker));
+  }
+  reserved_end_ = write_position + skipped + size;
+  return &data_[(write_position + skipped) & mask_];
+}
+
+void
+ThreadBuffer::commit()
+{
+  write_position_.store(reserved_end_, std::memory_order_release);
+}
+
+size_t
+ThreadBuffer::consume(const std::function<void(const uint8_t *, size_t)> & callback)
+{
+  const uint64_t capacity = mask_ + 1u;
+  const uint64_t write_position = write_position_.load(std::memory_order_acquire);
+  uint64_t read_position = read_position_.load(std::memory_order_relaxed);
+  size_t count = 0u;
+  while (read_position < write_position) {
+    const uint64_t offset = read_position & mask_;
+    uint32_t size;
+    std::memcpy(&size, &data_[offset], sizeof(size));
+    if (0u == size) {
+      read_position += capacity - offset;
+      continue;
+    }
+    callback(&data_[offset], size);
+    read_position += size;
+    ++count;
+    // Release each record, so that the thread can log again while the next one is consumed.
+    read_position_.store(read_position, std::memory_order_release);
+  }
+  read_position_.store(read_position, std::memory_order_release);
+  return count;
+}
+
+}  // namespace detail
+}  // namespace structured_logging
+}  // namespace rclcpp
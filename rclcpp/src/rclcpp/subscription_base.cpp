@@ -14,23 +14,53 @@
 
 #include "rclcpp/subscription_base.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include "rcl/graph.h"
+
+#include "rclcpp/detail/cpp_callback_trampoline.hpp"
+#include "rclcpp/detail/fast_exit.hpp"
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/expand_topic_or_service_name.hpp"
 #include "rclcpp/experimental/intra_process_manager.hpp"
 #include "rclcpp/logging.hpp"
 #include "rclcpp/node_interfaces/node_base_interface.hpp"
 #include "rclcpp/qos_event.hpp"
+#include "rclcpp/tracing.hpp"
 
 #include "rmw/error_handling.h"
+#include "rmw/impl/cpp/demangle.hpp"
 #include "rmw/rmw.h"
 
 using rclcpp::SubscriptionBase;
 
+/// Content filter of a subscription, which may be replaced while messages are filtered.
+struct SubscriptionBase::ContentFilterState
+{
+  bool
+  matches(const void * message) const
+  {
+    if (!enabled.load(std::memory_order_acquire)) {
+      return true;
+    }
+    auto current_filter = std::atomic_load(&filter);
+    return !current_filter || current_filter->matches(message);
+  }
+
+  /// False if there is no filter, so that the messages are not filtered with a lock.
+  std::atomic<bool> enabled{false};
+  /// Accessed with the std::atomic_load/store overloads.
+  std::shared_ptr<const rclcpp::ContentFilter> filter;
+};
+
 SubscriptionBase::SubscriptionBase(
   rclcpp::node_interfaces::NodeBaseInterface * node_base,
   const rosidl_message_type_support_t & type_support_handle,
@@ -42,10 +72,17 @@ SubscriptionBase::SubscriptionBase(
   use_intra_process_(false),
   intra_process_subscription_id_(0),
   type_support_(type_support_handle),
-  is_serialized_(is_serialized)
+  is_serialized_(is_serialized),
+  max_messages_per_take_(1),
+  take_latest_only_(false),
+  content_filter_state_(std::make_shared<ContentFilterState>())
 {
   auto custom_deletor = [node_handle = this->node_handle_](rcl_subscription_t * rcl_subs)
     {
+      if (rclcpp::detail::skip_entity_finalization(node_handle.get())) {
+        delete rcl_subs;
+        return;
+      }
       if (rcl_subscription_fini(rcl_subs, node_handle.get()) != RCL_RET_OK) {
         RCLCPP_ERROR(
           rclcpp::get_node_logger(node_handle.get()).get_child("rclcpp"),
@@ -83,6 +120,8 @@ SubscriptionBase::SubscriptionBase(
 
 SubscriptionBase::~SubscriptionBase()
 {
+  clear_on_new_message_callback();
+
   if (!use_intra_process_) {
     return;
   }
@@ -118,7 +157,45 @@ SubscriptionBase::get_subscription_handle() const
 const std::vector<std::shared_ptr<rclcpp::QOSEventHandlerBase>> &
 SubscriptionBase::get_event_handlers() const
 {
-  return event_handlers_;
+  static const std::vector<std::shared_ptr<rclcpp::QOSEventHandlerBase>> no_event_handlers;
+  return event_handlers_ ? event_handlers_->handlers : no_event_handlers;
+}
+
+rclcpp::Waitable::SharedPtr
+SubscriptionBase::get_event_handlers_waitable()
+{
+  if (!event_handlers_) {
+    return nullptr;
+  }
+  auto & handlers = event_handlers_->handlers;
+  if (handlers.size() == 1u) {
+    return handlers.front();
+  }
+  if (!event_handlers_->group) {
+    event_handlers_->group = std::make_shared<rclcpp::QOSEventHandlerGroup>(handlers);
+  }
+  return event_handlers_->group;
+}
+
+void
+SubscriptionBase::add_event_handler(std::shared_ptr<rclcpp::QOSEventHandlerBase> handler)
+{
+  if (!event_handlers_) {
+    event_handlers_ = std::make_unique<EventHandlers>();
+  }
+  event_handlers_->in_use_by_wait_set.emplace(
+    std::piecewise_construct, std::forward_as_tuple(handler.get()), std::forward_as_tuple(false));
+  event_handlers_->handlers.emplace_back(std::move(handler));
+}
+
+void
+SubscriptionBase::add_matched_event_handler(
+  rclcpp::node_interfaces::NodeBaseInterface * node_base,
+  const QOSMatchedCallbackType & callback)
+{
+  auto handler = std::make_shared<MatchedEventHandler>(
+    callback, node_base->get_context(), node_handle_, get_topic_name(), rcl_count_publishers);
+  add_event_handler(std::move(handler));
 }
 
 rclcpp::QoS
@@ -144,6 +221,8 @@ SubscriptionBase::take_type_erased(void * message_out, rclcpp::MessageInfo & mes
     nullptr  // rmw_subscription_allocation_t is unused here
   );
   TRACEPOINT(rclcpp_take, static_cast<const void *>(message_out));
+  rclcpp::tracing::trace(
+    rclcpp::tracing::TraceEventType::Take, this->get_subscription_handle().get(), 0, message_out);
   if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
     return false;
   } else if (RCL_RET_OK != ret) {
@@ -159,6 +238,14 @@ SubscriptionBase::take_type_erased(void * message_out, rclcpp::MessageInfo & mes
   return true;
 }
 
+void
+SubscriptionBase::handle_loaned_message_taking_ownership(
+  void *& loaned_message,
+  const rclcpp::MessageInfo & message_info)
+{
+  handle_loaned_message(loaned_message, message_info);
+}
+
 bool
 SubscriptionBase::take_serialized(
   rclcpp::SerializedMessage & message_out,
@@ -189,6 +276,123 @@ SubscriptionBase::is_serialized() const
   return is_serialized_;
 }
 
+size_t
+SubscriptionBase::get_max_messages_per_take() const
+{
+  return max_messages_per_take_;
+}
+
+void
+SubscriptionBase::set_max_messages_per_take(size_t max_messages_per_take)
+{
+  if (max_messages_per_take == 0) {
+    throw std::invalid_argument("max_messages_per_take must be greater than zero");
+  }
+  max_messages_per_take_ = max_messages_per_take;
+}
+
+bool
+SubscriptionBase::get_take_latest_only() const
+{
+  return take_latest_only_;
+}
+
+void
+SubscriptionBase::set_take_latest_only(bool take_latest_only)
+{
+  take_latest_only_ = take_latest_only;
+}
+
+std::chrono::nanoseconds
+SubscriptionBase::get_min_message_period() const
+{
+  return message_rate_limiter_.get_min_period();
+}
+
+void
+SubscriptionBase::set_min_message_period(std::chrono::nanoseconds min_message_period)
+{
+  if (min_message_period.count() < 0) {
+    throw std::invalid_argument("min_message_period must not be negative");
+  }
+  message_rate_limiter_.set_min_period(min_message_period);
+}
+
+std::chrono::nanoseconds
+SubscriptionBase::get_execution_budget() const
+{
+  return execution_budget_;
+}
+
+void
+SubscriptionBase::set_execution_budget(std::chrono::nanoseconds execution_budget)
+{
+  if (execution_budget.count() < 0) {
+    throw std::invalid_argument("execution_budget must not be negative");
+  }
+  execution_budget_ = execution_budget;
+}
+
+bool
+SubscriptionBase::is_cft_enabled() const
+{
+  return content_filter_state_->enabled.load(std::memory_order_acquire);
+}
+
+void
+SubscriptionBase::set_content_filter(
+  const std::string & filter_expression,
+  const std::vector<std::string> & expression_parameters)
+{
+  if (filter_expression.empty()) {
+    content_filter_state_->enabled.store(false, std::memory_order_release);
+    std::atomic_store(
+      &content_filter_state_->filter, std::shared_ptr<const rclcpp::ContentFilter>());
+    return;
+  }
+  if (is_serialized_) {
+    throw std::invalid_argument(
+            "the serialized messages of a subscription cannot be filtered by content");
+  }
+  auto filter = std::make_shared<const rclcpp::ContentFilter>(
+    &type_support_, filter_expression, expression_parameters);
+  std::atomic_store(&content_filter_state_->filter, std::move(filter));
+  content_filter_state_->enabled.store(true, std::memory_order_release);
+}
+
+rclcpp::ContentFilterOptions
+SubscriptionBase::get_content_filter() const
+{
+  auto filter = std::atomic_load(&content_filter_state_->filter);
+  return filter ? filter->get_options() : rclcpp::ContentFilterOptions();
+}
+
+bool
+SubscriptionBase::matches_content_filter(const void * message) const
+{
+  return content_filter_state_->matches(message);
+}
+
+std::function<bool (const void *)>
+SubscriptionBase::get_content_filter_predicate() const
+{
+  return [content_filter_state = content_filter_state_](const void * message) {
+           return content_filter_state->matches(message);
+         };
+}
+
+bool
+SubscriptionBase::is_message_rate_limited() const
+{
+  return message_rate_limiter_.is_limited();
+}
+
+void
+SubscriptionBase::record_message_taken()
+{
+  message_rate_limiter_.record_accepted();
+}
+
 size_t
 SubscriptionBase::get_publisher_count() const
 {
@@ -265,7 +469,7 @@ SubscriptionBase::matches_any_intra_process_publishers(const rmw_gid_t * sender_
             "intra process publisher check called "
             "after destruction of intra process manager");
   }
-  return ipm->matches_any_publishers(sender_gid);
+  return ipm->matches_any_publishers(sender_gid, intra_process_subscription_id_);
 }
 
 bool
@@ -282,9 +486,11 @@ SubscriptionBase::exchange_in_use_by_wait_set_state(
   if (get_intra_process_waitable().get() == pointer_to_subscription_part) {
     return intra_process_subscription_waitable_in_use_by_wait_set_.exchange(in_use_state);
   }
-  for (const auto & qos_event : event_handlers_) {
-    if (qos_event.get() == pointer_to_subscription_part) {
-      return qos_events_in_use_by_wait_set_[qos_event.get()].exchange(in_use_state);
+  if (event_handlers_) {
+    auto it = event_handlers_->in_use_by_wait_set.find(
+      static_cast<rclcpp::QOSEventHandlerBase *>(pointer_to_subscription_part));
+    if (it != event_handlers_->in_use_by_wait_set.end()) {
+      return it->second.exchange(in_use_state);
     }
   }
   throw std::runtime_error("given pointer_to_subscription_part does not match any part");
@@ -326,3 +532,73 @@ std::vector<rclcpp::NetworkFlowEndpoint> SubscriptionBase::get_network_flow_endp
 
   return network_flow_endpoint_vector;
 }
+
+void
+SubscriptionBase::set_on_new_message_callback(std::function<void(size_t)> callback)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_new_message_callback is not callable.");
+  }
+
+  auto new_callback =
+    [callback, this](size_t number_of_messages) {
+      try {
+        callback(number_of_messages);
+      } catch (const std::exception & exception) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::SubscriptionBase@" << this <<
+            " caught " << rmw::impl::cpp::demangle(exception) <<
+            " exception in user-provided callback for the 'on new message' callback: " <<
+            exception.what());
+      } catch (...) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::SubscriptionBase@" << this <<
+            " caught unhandled exception in user-provided callback " <<
+            "for the 'on new message' callback");
+      }
+    };
+
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+
+  // Set it temporarily to the new callback, while we replace the old one.
+  // This two-step setting, prevents a gap where the old std::function has
+  // been replaced but the middleware hasn't been told about the new one yet.
+  set_on_new_message_callback(
+    rclcpp::detail::cpp_callback_trampoline<const void *, size_t>,
+    static_cast<const void *>(&new_callback));
+
+  // Store the std::function to keep it in scope, also overwrites the existing one.
+  on_new_message_callback_ = new_callback;
+
+  // Set it again, now using the permanent storage.
+  set_on_new_message_callback(
+    rclcpp::detail::cpp_callback_trampoline<const void *, size_t>,
+    static_cast<const void *>(&on_new_message_callback_));
+}
+
+void
+SubscriptionBase::clear_on_new_message_callback()
+{
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  if (on_new_message_callback_) {
+    set_on_new_message_callback(nullptr, nullptr);
+    on_new_message_callback_ = nullptr;
+  }
+}
+
+void
+SubscriptionBase::set_on_new_message_callback(rcl_event_callback_t callback, const void * user_data)
+{
+  rcl_ret_t ret = rcl_subscription_set_on_new_message_callback(
+    subscription_handle_.get(),
+    callback,
+    user_data);
+
+  if (RCL_RET_OK != ret) {
+    using rclcpp::exceptions::throw_from_rcl_error;
+    throw_from_rcl_error(ret, "failed to set the on new message callback for subscription");
+  }
+}
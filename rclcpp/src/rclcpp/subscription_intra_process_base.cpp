@@ -14,8 +14,25 @@
 
 #include "rclcpp/experimental/subscription_intra_process_base.hpp"
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "rclcpp/callback_group.hpp"
+#include "rclcpp/logging.hpp"
+
+#include "rmw/impl/cpp/demangle.hpp"
+
 using rclcpp::experimental::SubscriptionIntraProcessBase;
 
+namespace
+{
+// Number of direct dispatches nested in the current thread, whatever their subscriptions.
+thread_local size_t direct_dispatch_depth = 0;
+}  // namespace
+
 bool
 SubscriptionIntraProcessBase::add_to_wait_set(rcl_wait_set_t * wait_set)
 {
@@ -36,3 +53,163 @@ SubscriptionIntraProcessBase::get_actual_qos() const
 {
   return qos_profile_;
 }
+
+uint64_t
+SubscriptionIntraProcessBase::get_dropped_count() const
+{
+  return dropped_count_.load(std::memory_order_relaxed);
+}
+
+void
+SubscriptionIntraProcessBase::set_message_lost_callback(
+  rclcpp::QOSMessageLostCallbackType callback)
+{
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  on_message_lost_callback_ = std::move(callback);
+}
+
+void
+SubscriptionIntraProcessBase::on_message_dropped()
+{
+  const uint64_t dropped_count = dropped_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  if (!on_message_lost_callback_ || dropped_count <= reported_dropped_count_) {
+    // Reported by a concurrent call.
+    return;
+  }
+  rclcpp::QOSMessageLostInfo info;
+  info.total_count = static_cast<size_t>(dropped_count);
+  info.total_count_change = static_cast<size_t>(dropped_count - reported_dropped_count_);
+  reported_dropped_count_ = dropped_count;
+  try {
+    on_message_lost_callback_(info);
+  } catch (const std::exception & exception) {
+    RCLCPP_ERROR_STREAM(
+      rclcpp::get_logger("rclcpp"),
+      "rclcpp::SubscriptionIntraProcessBase@" << this <<
+        " caught " << rmw::impl::cpp::demangle(exception) <<
+        " exception in user-provided callback for the message lost event: " <<
+        exception.what());
+  } catch (...) {
+    RCLCPP_ERROR_STREAM(
+      rclcpp::get_logger("rclcpp"),
+      "rclcpp::SubscriptionIntraProcessBase@" << this <<
+        " caught unhandled exception in user-provided callback " <<
+        "for the message lost event");
+  }
+}
+
+void
+SubscriptionIntraProcessBase::set_direct_dispatch(
+  size_t max_depth, std::weak_ptr<rclcpp::CallbackGroup> callback_group)
+{
+  max_direct_dispatch_depth_ = max_depth;
+  direct_dispatch_callback_group_ = std::move(callback_group);
+}
+
+uint64_t
+SubscriptionIntraProcessBase::get_direct_dispatch_count() const
+{
+  return direct_dispatch_count_.load(std::memory_order_relaxed);
+}
+
+bool
+SubscriptionIntraProcessBase::try_begin_direct_dispatch()
+{
+  if (direct_dispatch_depth >= max_direct_dispatch_depth_ || get_lag() > 0) {
+    // Disabled, nested too deep, or a queued message must be executed first to keep the order.
+    return false;
+  }
+  if (direct_dispatching_.exchange(true)) {
+    return false;
+  }
+  auto callback_group = direct_dispatch_callback_group_.lock();
+  if (
+    !callback_group || !callback_group->get_associated_with_executor_atomic().load() ||
+    (callback_group->type() == rclcpp::CallbackGroupType::MutuallyExclusive &&
+    !callback_group->can_be_taken_from().exchange(false)))
+  {
+    direct_dispatching_.store(false);
+    return false;
+  }
+  ++direct_dispatch_depth;
+  return true;
+}
+
+void
+SubscriptionIntraProcessBase::end_direct_dispatch()
+{
+  --direct_dispatch_depth;
+  direct_dispatch_count_.fetch_add(1, std::memory_order_relaxed);
+  auto callback_group = direct_dispatch_callback_group_.lock();
+  if (callback_group && callback_group->type() == rclcpp::CallbackGroupType::MutuallyExclusive) {
+    callback_group->can_be_taken_from().store(true);
+    // Wake the executor, which may have skipped the work of the group while it was taken.
+    trigger_guard_condition();
+  }
+  direct_dispatching_.store(false);
+}
+
+void
+SubscriptionIntraProcessBase::notify_intra_process_message()
+{
+  trigger_guard_condition();
+  invoke_on_new_message();
+}
+
+void
+SubscriptionIntraProcessBase::set_on_ready_callback(std::function<void(size_t, int)> callback)
+{
+  if (!callback) {
+    throw std::invalid_argument(
+            "The callback passed to set_on_ready_callback is not callable.");
+  }
+
+  // Note: we bind the int identifier argument to this waitable's entity types
+  auto new_callback =
+    [callback, this](size_t number_of_events) {
+      try {
+        callback(number_of_events, 0);
+      } catch (const std::exception & exception) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::SubscriptionIntraProcessBase@" << this <<
+            " caught " << rmw::impl::cpp::demangle(exception) <<
+            " exception in user-provided callback for the 'on ready' callback: " <<
+            exception.what());
+      } catch (...) {
+        RCLCPP_ERROR_STREAM(
+          rclcpp::get_logger("rclcpp"),
+          "rclcpp::SubscriptionIntraProcessBase@" << this <<
+            " caught unhandled exception in user-provided callback " <<
+            "for the 'on ready' callback");
+      }
+    };
+
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  on_new_message_callback_ = new_callback;
+
+  if (unread_count_ > 0) {
+    on_new_message_callback_(unread_count_);
+    unread_count_ = 0;
+  }
+}
+
+void
+SubscriptionIntraProcessBase::clear_on_ready_callback()
+{
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  on_new_message_callback_ = nullptr;
+}
+
+void
+SubscriptionIntraProcessBase::invoke_on_new_message()
+{
+  std::lock_guard<std::recursive_mutex> lock(callback_mutex_);
+  if (on_new_message_callback_) {
+    on_new_message_callback_(1);
+  } else {
+    unread_count_++;
+  }
+}
@@ -57,12 +57,6 @@ Time::Time(int32_t seconds, uint32_t nanoseconds, rcl_clock_type_t clock_type)
   rcl_time_.nanoseconds += nanoseconds;
 }
 
-Time::Time(int64_t nanoseconds, rcl_clock_type_t clock_type)
-: rcl_time_(init_time_point(clock_type))
-{
-  rcl_time_.nanoseconds = nanoseconds;
-}
-
 Time::Time(const Time & rhs) = default;
 
 Time::Time(
@@ -113,173 +107,34 @@ Time::operator=(const builtin_interfaces::msg::Time & time_msg)
   return *this;
 }
 
-bool
-Time::operator==(const rclcpp::Time & rhs) const
-{
-  if (rcl_time_.clock_type != rhs.rcl_time_.clock_type) {
-    throw std::runtime_error("can't compare times with different time sources");
-  }
-
-  return rcl_time_.nanoseconds == rhs.rcl_time_.nanoseconds;
-}
-
-bool
-Time::operator!=(const rclcpp::Time & rhs) const
-{
-  return !(*this == rhs);
-}
-
-bool
-Time::operator<(const rclcpp::Time & rhs) const
-{
-  if (rcl_time_.clock_type != rhs.rcl_time_.clock_type) {
-    throw std::runtime_error("can't compare times with different time sources");
-  }
-
-  return rcl_time_.nanoseconds < rhs.rcl_time_.nanoseconds;
-}
-
-bool
-Time::operator<=(const rclcpp::Time & rhs) const
-{
-  if (rcl_time_.clock_type != rhs.rcl_time_.clock_type) {
-    throw std::runtime_error("can't compare times with different time sources");
-  }
-
-  return rcl_time_.nanoseconds <= rhs.rcl_time_.nanoseconds;
-}
-
-bool
-Time::operator>=(const rclcpp::Time & rhs) const
-{
-  if (rcl_time_.clock_type != rhs.rcl_time_.clock_type) {
-    throw std::runtime_error("can't compare times with different time sources");
-  }
-
-  return rcl_time_.nanoseconds >= rhs.rcl_time_.nanoseconds;
-}
-
-bool
-Time::operator>(const rclcpp::Time & rhs) const
-{
-  if (rcl_time_.clock_type != rhs.rcl_time_.clock_type) {
-    throw std::runtime_error("can't compare times with different time sources");
-  }
-
-  return rcl_time_.nanoseconds > rhs.rcl_time_.nanoseconds;
-}
-
-Time
-Time::operator+(const rclcpp::Duration & rhs) const
-{
-  if (rclcpp::add_will_overflow(rhs.nanoseconds(), this->nanoseconds())) {
-    throw std::overflow_error("addition leads to int64_t overflow");
-  }
-  if (rclcpp::add_will_underflow(rhs.nanoseconds(), this->nanoseconds())) {
-    throw std::underflow_error("addition leads to int64_t underflow");
-  }
-  return Time(this->nanoseconds() + rhs.nanoseconds(), this->get_clock_type());
-}
-
-Duration
-Time::operator-(const rclcpp::Time & rhs) const
-{
-  if (rcl_time_.clock_type != rhs.rcl_time_.clock_type) {
-    throw std::runtime_error(
-            std::string("can't subtract times with different time sources [") +
-            std::to_string(rcl_time_.clock_type) + " != " +
-            std::to_string(rhs.rcl_time_.clock_type) + "]");
-  }
-
-  if (rclcpp::sub_will_overflow(rcl_time_.nanoseconds, rhs.rcl_time_.nanoseconds)) {
-    throw std::overflow_error("time subtraction leads to int64_t overflow");
-  }
-
-  if (rclcpp::sub_will_underflow(rcl_time_.nanoseconds, rhs.rcl_time_.nanoseconds)) {
-    throw std::underflow_error("time subtraction leads to int64_t underflow");
-  }
-
-  return Duration::from_nanoseconds(rcl_time_.nanoseconds - rhs.rcl_time_.nanoseconds);
-}
-
-Time
-Time::operator-(const rclcpp::Duration & rhs) const
-{
-  if (rclcpp::sub_will_overflow(rcl_time_.nanoseconds, rhs.nanoseconds())) {
-    throw std::overflow_error("time subtraction leads to int64_t overflow");
-  }
-  if (rclcpp::sub_will_underflow(rcl_time_.nanoseconds, rhs.nanoseconds())) {
-    throw std::underflow_error("time subtraction leads to int64_t underflow");
-  }
-
-  return Time(rcl_time_.nanoseconds - rhs.nanoseconds(), rcl_time_.clock_type);
-}
-
-int64_t
-Time::nanoseconds() const
-{
-  return rcl_time_.nanoseconds;
-}
-
 double
 Time::seconds() const
 {
   return std::chrono::duration<double>(std::chrono::nanoseconds(rcl_time_.nanoseconds)).count();
 }
 
-rcl_clock_type_t
-Time::get_clock_type() const
-{
-  return rcl_time_.clock_type;
-}
-
 Time
-operator+(const rclcpp::Duration & lhs, const rclcpp::Time & rhs)
+Time::max()
 {
-  if (rclcpp::add_will_overflow(rhs.nanoseconds(), lhs.nanoseconds())) {
-    throw std::overflow_error("addition leads to int64_t overflow");
-  }
-  if (rclcpp::add_will_underflow(rhs.nanoseconds(), lhs.nanoseconds())) {
-    throw std::underflow_error("addition leads to int64_t underflow");
-  }
-  return Time(lhs.nanoseconds() + rhs.nanoseconds(), rhs.get_clock_type());
+  return Time(std::numeric_limits<int32_t>::max(), 999999999);
 }
 
-Time &
-Time::operator+=(const rclcpp::Duration & rhs)
+namespace detail
 {
-  if (rclcpp::add_will_overflow(rhs.nanoseconds(), this->nanoseconds())) {
-    throw std::overflow_error("addition leads to int64_t overflow");
-  }
-  if (rclcpp::add_will_underflow(rhs.nanoseconds(), this->nanoseconds())) {
-    throw std::underflow_error("addition leads to int64_t underflow");
-  }
-
-  rcl_time_.nanoseconds += rhs.nanoseconds();
-
-  return *this;
-}
 
-Time &
-Time::operator-=(const rclcpp::Duration & rhs)
+void
+throw_time_comparison_error()
 {
-  if (rclcpp::sub_will_overflow(rcl_time_.nanoseconds, rhs.nanoseconds())) {
-    throw std::overflow_error("time subtraction leads to int64_t overflow");
-  }
-  if (rclcpp::sub_will_underflow(rcl_time_.nanoseconds, rhs.nanoseconds())) {
-    throw std::underflow_error("time subtraction leads to int64_t underflow");
-  }
-
-  rcl_time_.nanoseconds -= rhs.nanoseconds();
-
-  return *this;
+  throw std::runtime_error("can't compare times with different time sources");
 }
 
-Time
-Time::max()
+void
+throw_time_subtraction_error(rcl_clock_type_t lhs, rcl_clock_type_t rhs)
 {
-  return Time(std::numeric_limits<int32_t>::max(), 999999999);
+  throw std::runtime_error(
+          std::string("can't subtract times with different time sources [") +
+          std::to_string(lhs) + " != " + std::to_string(rhs) + "]");
 }
 
-
+}  // namespace detail
 }  // namespace rclcpp
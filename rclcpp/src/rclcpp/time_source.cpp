@@ -30,6 +30,9 @@
 #include "rclcpp/time.hpp"
 #include "rclcpp/time_source.hpp"
 
+#include "./detail/shared_clock_source.hpp"
+#include "./detail/shared_node_infrastructure.hpp"
+
 namespace rclcpp
 {
 
@@ -41,6 +44,16 @@ public:
   {
   }
 
+  ~ClocksState()
+  {
+    // The ROS time overrides of the clocks are not updated anymore.
+    std::lock_guard<std::mutex> guard(clock_list_lock_);
+    for (const auto & clock : associated_clocks_) {
+      std::lock_guard<std::mutex> clock_guard(clock->get_clock_mutex());
+      TimeSource::set_ros_time_override_snapshot(*clock, false, 0);
+    }
+  }
+
   // An internal method to use in the clock callback that iterates and enables all clocks
   void enable_ros_time()
   {
@@ -54,12 +67,9 @@ public:
 
     // Update all attached clocks to zero or last recorded time
     std::lock_guard<std::mutex> guard(clock_list_lock_);
-    auto time_msg = std::make_shared<builtin_interfaces::msg::Time>();
-    if (last_msg_set_) {
-      time_msg = std::make_shared<builtin_interfaces::msg::Time>(last_msg_set_->clock);
-    }
+    const rcl_time_point_value_t nanoseconds = get_last_msg_nanoseconds();
     for (auto it = associated_clocks_.begin(); it != associated_clocks_.end(); ++it) {
-      set_clock(time_msg, true, *it);
+      set_clock(nanoseconds, true, *it);
     }
   }
 
@@ -77,8 +87,7 @@ public:
     // Update all attached clocks
     std::lock_guard<std::mutex> guard(clock_list_lock_);
     for (auto it = associated_clocks_.begin(); it != associated_clocks_.end(); ++it) {
-      auto msg = std::make_shared<builtin_interfaces::msg::Time>();
-      set_clock(msg, false, *it);
+      set_clock(0, false, *it);
     }
   }
 
@@ -98,11 +107,7 @@ public:
     std::lock_guard<std::mutex> guard(clock_list_lock_);
     associated_clocks_.push_back(clock);
     // Set the clock to zero unless there's a recently received message
-    auto time_msg = std::make_shared<builtin_interfaces::msg::Time>();
-    if (last_msg_set_) {
-      time_msg = std::make_shared<builtin_interfaces::msg::Time>(last_msg_set_->clock);
-    }
-    set_clock(time_msg, ros_time_active_, clock);
+    set_clock(get_last_msg_nanoseconds(), ros_time_active_, clock);
   }
 
   // Detach a clock
@@ -111,6 +116,11 @@ public:
     std::lock_guard<std::mutex> guard(clock_list_lock_);
     auto result = std::find(associated_clocks_.begin(), associated_clocks_.end(), clock);
     if (result != associated_clocks_.end()) {
+      {
+        // The ROS time override of the clock is not updated anymore.
+        std::lock_guard<std::mutex> clock_guard(clock->get_clock_mutex());
+        TimeSource::set_ros_time_override_snapshot(*clock, false, 0);
+      }
       associated_clocks_.erase(result);
     } else {
       RCLCPP_ERROR(logger_, "failed to remove clock");
@@ -119,12 +129,24 @@ public:
 
   // Internal helper function used inside iterators
   static void set_clock(
-    const builtin_interfaces::msg::Time::SharedPtr msg,
+    rcl_time_point_value_t nanoseconds,
     bool set_ros_time_enabled,
-    rclcpp::Clock::SharedPtr clock)
+    const rclcpp::Clock::SharedPtr & clock)
   {
     std::lock_guard<std::mutex> clock_guard(clock->get_clock_mutex());
 
+    // Nothing changes, e.g. the simulation is paused, so neither the rcl clock is updated nor
+    // the jump callbacks are checked.
+    if (set_ros_time_enabled &&
+      TimeSource::ros_time_override_snapshot_equals(*clock, nanoseconds))
+    {
+      return;
+    }
+    // Read the rcl clock while it changes, e.g. in the time jump callbacks.
+    if (clock->has_jump_handlers()) {
+      TimeSource::set_ros_time_override_snapshot(*clock, false, 0);
+    }
+
     // Do change
     if (!set_ros_time_enabled && clock->ros_time_is_active()) {
       auto ret = rcl_disable_ros_time_override(clock->get_clock_handle());
@@ -140,23 +162,23 @@ public:
       }
     }
 
-    auto ret = rcl_set_ros_time_override(
-      clock->get_clock_handle(),
-      rclcpp::Time(*msg).nanoseconds());
+    // The jump callbacks whose threshold is exceeded are called by rcl.
+    auto ret = rcl_set_ros_time_override(clock->get_clock_handle(), nanoseconds);
     if (ret != RCL_RET_OK) {
       rclcpp::exceptions::throw_from_rcl_error(
         ret, "Failed to set ros_time_override_status");
     }
+    TimeSource::set_ros_time_override_snapshot(*clock, set_ros_time_enabled, nanoseconds);
   }
 
   // Internal helper function
   void set_all_clocks(
-    const builtin_interfaces::msg::Time::SharedPtr msg,
+    rcl_time_point_value_t nanoseconds,
     bool set_ros_time_enabled)
   {
     std::lock_guard<std::mutex> guard(clock_list_lock_);
     for (auto it = associated_clocks_.begin(); it != associated_clocks_.end(); ++it) {
-      set_clock(msg, set_ros_time_enabled, *it);
+      set_clock(nanoseconds, set_ros_time_enabled, *it);
     }
   }
 
@@ -166,6 +188,12 @@ public:
     last_msg_set_ = msg;
   }
 
+  // Return the time of the last clock message received, zero if none was
+  rcl_time_point_value_t get_last_msg_nanoseconds() const
+  {
+    return last_msg_set_ ? rclcpp::Time(last_msg_set_->clock).nanoseconds() : 0;
+  }
+
 private:
   // Store (and update on node attach) logger for logging.
   Logger logger_;
@@ -215,6 +243,30 @@ public:
     use_clock_thread_ = use_clock_thread;
   }
 
+  // Check if the clock subscription of the context is used
+  bool get_use_shared_clock_source()
+  {
+    return use_shared_clock_source_;
+  }
+
+  // Set whether the clock subscription of the context is used
+  void set_use_shared_clock_source(bool use_shared_clock_source)
+  {
+    use_shared_clock_source_ = use_shared_clock_source;
+  }
+
+  // Check if the infrastructure of the context is used
+  bool get_use_shared_infrastructure()
+  {
+    return use_shared_infrastructure_;
+  }
+
+  // Set whether the infrastructure of the context is used
+  void set_use_shared_infrastructure(bool use_shared_infrastructure)
+  {
+    use_shared_infrastructure_ = use_shared_infrastructure;
+  }
+
   // Check if the clock thread is joinable
   bool clock_thread_is_joinable()
   {
@@ -287,17 +339,24 @@ public:
         return result;
       });
 
-    // TODO(tfoote) use parameters interface not subscribe to events via topic ticketed #609
-    parameter_subscription_ = rclcpp::AsyncParametersClient::on_parameter_event(
-      node_topics_,
+    auto parameter_event_callback =
       [state = std::weak_ptr<NodeState>(this->shared_from_this())](
-        std::shared_ptr<const rcl_interfaces::msg::ParameterEvent> event) {
+      std::shared_ptr<const rcl_interfaces::msg::ParameterEvent> event) {
         if (auto state_ptr = state.lock()) {
           state_ptr->on_parameter_event(event);
         }
         // Do nothing if the pointer could not be locked because it means the TimeSource is now
         // without an attached node
-      });
+      };
+    if (use_shared_infrastructure_) {
+      shared_infrastructure_ = detail::SharedNodeInfrastructure::get(node_base_->get_context());
+      parameter_event_listener_id_ = shared_infrastructure_->add_parameter_event_listener(
+        node_base_->get_fully_qualified_name(), parameter_event_callback);
+      return;
+    }
+    // TODO(tfoote) use parameters interface not subscribe to events via topic ticketed #609
+    parameter_subscription_ = rclcpp::AsyncParametersClient::on_parameter_event(
+      node_topics_, parameter_event_callback);
   }
 
   // Detach the attached node
@@ -310,6 +369,10 @@ public:
     }
     destroy_clock_sub();
     parameter_subscription_.reset();
+    if (shared_infrastructure_) {
+      shared_infrastructure_->remove_parameter_event_listener(parameter_event_listener_id_);
+      shared_infrastructure_.reset();
+    }
     node_base_.reset();
     node_topics_.reset();
     node_graph_.reset();
@@ -330,6 +393,17 @@ private:
   bool use_clock_thread_;
   std::thread clock_executor_thread_;
 
+  // Clock subscription shared with the other nodes of the context, instead of one per node.
+  bool use_shared_clock_source_{false};
+  std::shared_ptr<detail::SharedClockSource> shared_clock_source_;
+  uint64_t shared_clock_listener_id_{0u};
+
+  // Parameter event subscription shared with the other nodes of the context, instead of one per
+  // node, which also implies the shared clock subscription.
+  bool use_shared_infrastructure_{false};
+  std::shared_ptr<detail::SharedNodeInfrastructure> shared_infrastructure_;
+  uint64_t parameter_event_listener_id_{0u};
+
   // Preserve the node reference
   rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base_;
   rclcpp::node_interfaces::NodeTopicsInterface::SharedPtr node_topics_;
@@ -369,10 +443,10 @@ private:
     }
     // Cache the last message in case a new clock is attached.
     clocks_state_ptr->cache_last_msg(msg);
-    auto time_msg = std::make_shared<builtin_interfaces::msg::Time>(msg->clock);
 
     if (SET_TRUE == this->parameter_state_) {
-      clocks_state_ptr->set_all_clocks(time_msg, true);
+      // Converted once for all the clocks.
+      clocks_state_ptr->set_all_clocks(rclcpp::Time(msg->clock).nanoseconds(), true);
     }
   }
 
@@ -380,11 +454,23 @@ private:
   void create_clock_sub()
   {
     std::lock_guard<std::mutex> guard(clock_sub_lock_);
-    if (clock_subscription_) {
+    if (clock_subscription_ || shared_clock_source_) {
       // Subscription already created.
       return;
     }
 
+    if (use_shared_clock_source_ || use_shared_infrastructure_) {
+      shared_clock_source_ = detail::SharedClockSource::get(node_base_->get_context(), qos_);
+      shared_clock_listener_id_ = shared_clock_source_->add_listener(
+        [state = std::weak_ptr<NodeState>(this->shared_from_this())](
+          std::shared_ptr<const rosgraph_msgs::msg::Clock> msg) {
+          if (auto state_ptr = state.lock()) {
+            state_ptr->clock_cb(msg);
+          }
+        });
+      return;
+    }
+
     rclcpp::SubscriptionOptions options;
     options.qos_overriding_options = rclcpp::QosOverridingOptions(
       {
@@ -444,6 +530,10 @@ private:
       clock_executor_->remove_callback_group(clock_callback_group_);
     }
     clock_subscription_.reset();
+    if (shared_clock_source_) {
+      shared_clock_source_->remove_listener(shared_clock_listener_id_);
+      shared_clock_source_.reset();
+    }
   }
 
   // Parameter Event subscription
@@ -526,6 +616,8 @@ TimeSource::TimeSource(
 void TimeSource::attachNode(rclcpp::Node::SharedPtr node)
 {
   node_state_->set_use_clock_thread(node->get_node_options().use_clock_thread());
+  set_use_shared_clock_source(node->get_node_options().use_shared_clock_source());
+  set_use_shared_infrastructure(node->get_node_options().use_shared_infrastructure());
   attachNode(
     node->get_node_base_interface(),
     node->get_node_topics_interface(),
@@ -562,6 +654,8 @@ void TimeSource::detachNode()
     clocks_state_->weak_from_this(),
     constructed_qos_,
     constructed_use_clock_thread_);
+  node_state_->set_use_shared_clock_source(use_shared_clock_source_);
+  node_state_->set_use_shared_infrastructure(use_shared_infrastructure_);
 }
 
 void TimeSource::attachClock(std::shared_ptr<rclcpp::Clock> clock)
@@ -569,6 +663,18 @@ void TimeSource::attachClock(std::shared_ptr<rclcpp::Clock> clock)
   clocks_state_->attachClock(std::move(clock));
 }
 
+void TimeSource::set_ros_time_override_snapshot(
+  rclcpp::Clock & clock, bool ros_time_active, rcl_time_point_value_t nanoseconds) noexcept
+{
+  clock.set_ros_time_override_snapshot(ros_time_active, nanoseconds);
+}
+
+bool TimeSource::ros_time_override_snapshot_equals(
+  const rclcpp::Clock & clock, rcl_time_point_value_t nanoseconds) noexcept
+{
+  return clock.ros_time_override_snapshot_equals(nanoseconds);
+}
+
 void TimeSource::detachClock(std::shared_ptr<rclcpp::Clock> clock)
 {
   clocks_state_->detachClock(std::move(clock));
@@ -584,6 +690,28 @@ void TimeSource::set_use_clock_thread(bool use_clock_thread)
   node_state_->set_use_clock_thread(use_clock_thread);
 }
 
+bool TimeSource::get_use_shared_clock_source()
+{
+  return node_state_->get_use_shared_clock_source();
+}
+
+void TimeSource::set_use_shared_clock_source(bool use_shared_clock_source)
+{
+  use_shared_clock_source_ = use_shared_clock_source;
+  node_state_->set_use_shared_clock_source(use_shared_clock_source);
+}
+
+bool TimeSource::get_use_shared_infrastructure()
+{
+  return node_state_->get_use_shared_infrastructure();
+}
+
+void TimeSource::set_use_shared_infrastructure(bool use_shared_infrastructure)
+{
+  use_shared_infrastructure_ = use_shared_infrastructure;
+  node_state_->set_use_shared_infrastructure(use_shared_infrastructure);
+}
+
 bool TimeSource::clock_thread_is_joinable()
 {
   return node_state_->clock_thread_is_joinable();
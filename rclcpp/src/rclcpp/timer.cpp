@@ -14,10 +14,16 @@
 
 #include "rclcpp/timer.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <thread>
+#include <utility>
 
 #include "rclcpp/contexts/default_context.hpp"
 #include "rclcpp/exceptions.hpp"
@@ -100,6 +106,26 @@ TimerBase::reset()
   if (ret != RCL_RET_OK) {
     rclcpp::exceptions::throw_from_rcl_error(ret, "Couldn't reset timer");
   }
+  // The deadlines missed before the reset are not caught up on.
+  catch_up_call_count_.store(0u, std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(on_reset_callback_mutex_);
+  if (on_reset_callback_) {
+    on_reset_callback_();
+  }
+}
+
+void
+TimerBase::set_on_reset_callback(std::function<void()> callback)
+{
+  std::lock_guard<std::mutex> lock(on_reset_callback_mutex_);
+  on_reset_callback_ = std::move(callback);
+}
+
+void
+TimerBase::clear_on_reset_callback()
+{
+  std::lock_guard<std::mutex> lock(on_reset_callback_mutex_);
+  on_reset_callback_ = nullptr;
 }
 
 bool
@@ -136,3 +162,129 @@ TimerBase::exchange_in_use_by_wait_set_state(bool in_use_state)
 {
   return in_use_by_wait_set_.exchange(in_use_state);
 }
+
+void
+TimerBase::set_overrun_policy(TimerOverrunPolicy policy)
+{
+  overrun_policy_.store(policy, std::memory_order_relaxed);
+}
+
+rclcpp::TimerOverrunPolicy
+TimerBase::get_overrun_policy() const
+{
+  return overrun_policy_.load(std::memory_order_relaxed);
+}
+
+void
+TimerBase::set_slack(std::chrono::nanoseconds slack)
+{
+  if (slack < std::chrono::nanoseconds::zero()) {
+    throw std::invalid_argument("timer slack cannot be negative");
+  }
+  slack_.store(slack.count(), std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds
+TimerBase::get_slack() const
+{
+  return std::chrono::nanoseconds(slack_.load(std::memory_order_relaxed));
+}
+
+rclcpp::TimerStatistics
+TimerBase::get_statistics() const
+{
+  TimerStatistics statistics;
+  statistics.call_count = call_count_.load(std::memory_order_relaxed);
+  statistics.missed_deadline_count = missed_deadline_count_.load(std::memory_order_relaxed);
+  statistics.total_lateness = std::chrono::nanoseconds(
+    total_lateness_.load(std::memory_order_relaxed));
+  statistics.max_lateness = std::chrono::nanoseconds(max_lateness_.load(std::memory_order_relaxed));
+  return statistics;
+}
+
+void
+TimerBase::reset_statistics()
+{
+  call_count_.store(0u, std::memory_order_relaxed);
+  missed_deadline_count_.store(0u, std::memory_order_relaxed);
+  total_lateness_.store(0, std::memory_order_relaxed);
+  max_lateness_.store(0, std::memory_order_relaxed);
+}
+
+static void
+atomic_max(std::atomic<int64_t> & target, int64_t value)
+{
+  int64_t current = target.load(std::memory_order_relaxed);
+  while (value > current &&
+    !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+bool
+TimerBase::call_timer_handle()
+{
+  // The time until the next call is negative when the timer is called after its deadline.
+  int64_t time_until_next_call = 0;
+  rcl_ret_t ret = rcl_timer_get_time_until_next_call(
+    timer_handle_.get(), &time_until_next_call);
+  if (ret == RCL_RET_TIMER_CANCELED) {
+    return false;
+  }
+  if (ret != RCL_RET_OK) {
+    rclcpp::exceptions::throw_from_rcl_error(ret, "Timer could not get time until next call");
+  }
+  // The rcl timer moves its deadline to the first one after now, by a whole number of periods.
+  ret = rcl_timer_call(timer_handle_.get());
+  if (ret == RCL_RET_TIMER_CANCELED) {
+    return false;
+  }
+  if (ret != RCL_RET_OK) {
+    throw std::runtime_error("Failed to notify timer that callback occurred");
+  }
+
+  const int64_t lateness = std::max<int64_t>(0, -time_until_next_call);
+  int64_t period = 0;
+  ret = rcl_timer_get_period(timer_handle_.get(), &period);
+  if (ret != RCL_RET_OK) {
+    rclcpp::exceptions::throw_from_rcl_error(ret, "Couldn't get timer period");
+  }
+  const uint64_t missed_deadline_count =
+    period > 0 ? static_cast<uint64_t>(lateness / period) : 0u;
+
+  call_count_.fetch_add(1u, std::memory_order_relaxed);
+  missed_deadline_count_.fetch_add(missed_deadline_count, std::memory_order_relaxed);
+  total_lateness_.fetch_add(lateness, std::memory_order_relaxed);
+  atomic_max(max_lateness_, lateness);
+
+  if (missed_deadline_count > 0u) {
+    switch (overrun_policy_.load(std::memory_order_relaxed)) {
+      case TimerOverrunPolicy::Skip:
+        break;
+      case TimerOverrunPolicy::CatchUp:
+        catch_up_call_count_.fetch_add(missed_deadline_count, std::memory_order_relaxed);
+        break;
+      case TimerOverrunPolicy::Coalesce:
+        // The next deadline is a period after now, the on reset callback is not called since the
+        // caller, e.g. a rclcpp::experimental::TimersManager, reschedules the timer anyway.
+        ret = rcl_timer_reset(timer_handle_.get());
+        if (ret != RCL_RET_OK) {
+          rclcpp::exceptions::throw_from_rcl_error(ret, "Couldn't reset timer");
+        }
+        break;
+    }
+  }
+  return true;
+}
+
+void
+TimerBase::skip_callback()
+{
+  take_callback_call_count();
+}
+
+uint64_t
+TimerBase::take_callback_call_count()
+{
+  return 1u + catch_up_call_count_.exchange(0u, std::memory_order_relaxed);
+}
@@ -0,0 +1,322 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/timer_wheel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using rclcpp::TimerWheel;
+
+TimerWheel::TimerWheel(
+  rclcpp::Context::SharedPtr context,
+  std::chrono::nanoseconds tick)
+: tick_(tick),
+  start_(std::chrono::steady_clock::now()),
+  guard_condition_(context)
+{
+  if (tick <= std::chrono::nanoseconds(0)) {
+    throw std::invalid_argument("the tick of a timer wheel must be positive");
+  }
+  // The timer only wakes the executor up on each tick, the wheel executes the expirations.
+  rclcpp::VoidCallbackType callback = []() {};
+  tick_timer_ = std::make_shared<rclcpp::WallTimer<rclcpp::VoidCallbackType>>(
+    tick, std::move(callback), std::move(context));
+  tick_timer_->cancel();
+  slots_.fill(kNone);
+}
+
+TimerWheel::TimerId
+TimerWheel::add_timer(
+  std::chrono::nanoseconds delay,
+  TimerCallback callback,
+  std::chrono::nanoseconds period)
+{
+  if (!callback) {
+    throw std::invalid_argument("the callback of a timer must be callable");
+  }
+  if (period < std::chrono::nanoseconds(0)) {
+    throw std::invalid_argument("the period of a timer must not be negative");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (0 == size_) {
+    // Nothing expired while the wheel was empty and not ticking, catch up with the time.
+    current_tick_ = std::max(current_tick_, now_tick());
+  }
+  uint32_t index;
+  if (!free_entries_.empty()) {
+    index = free_entries_.back();
+    free_entries_.pop_back();
+  } else {
+    if (entries_.size() >= kNone - 1) {
+      throw std::length_error("too many timers in the timer wheel");
+    }
+    index = static_cast<uint32_t>(entries_.size());
+    entries_.emplace_back();
+  }
+  Entry & entry = entries_[index];
+  entry.callback = std::make_shared<const TimerCallback>(std::move(callback));
+  entry.expiry_tick = std::max(current_tick_ + 1, deadline_tick(delay));
+  // The period is rounded up to a whole number of ticks.
+  entry.period_ticks =
+    static_cast<uint64_t>((period + tick_ - std::chrono::nanoseconds(1)) / tick_);
+  link(index);
+  if (0 == size_++) {
+    start_ticking();
+  }
+  return (static_cast<uint64_t>(entry.generation) << 32) | (index + 1);
+}
+
+bool
+TimerWheel::restart_timer(TimerId id, std::chrono::nanoseconds delay)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  Entry * entry = find(id);
+  if (nullptr == entry) {
+    return false;
+  }
+  const uint32_t index = static_cast<uint32_t>(entry - entries_.data());
+  unlink(index);
+  entry->expiry_tick = std::max(current_tick_ + 1, deadline_tick(delay));
+  link(index);
+  return true;
+}
+
+bool
+TimerWheel::cancel_timer(TimerId id)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  Entry * entry = find(id);
+  if (nullptr == entry) {
+    return false;
+  }
+  const uint32_t index = static_cast<uint32_t>(entry - entries_.data());
+  unlink(index);
+  release(index);
+  if (0 == size_) {
+    tick_timer_->cancel();
+  }
+  return true;
+}
+
+size_t
+TimerWheel::get_number_of_timers() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+std::chrono::nanoseconds
+TimerWheel::get_tick() const
+{
+  return tick_;
+}
+
+bool
+TimerWheel::add_to_wait_set(rcl_wait_set_t * wait_set)
+{
+  rcl_ret_t ret = rcl_wait_set_add_timer(wait_set, tick_timer_->get_timer_handle().get(), NULL);
+  if (RCL_RET_OK != ret) {
+    return false;
+  }
+  ret = rcl_wait_set_add_guard_condition(
+    wait_set, &guard_condition_.get_rcl_guard_condition(), NULL);
+  return RCL_RET_OK == ret;
+}
+
+bool
+TimerWheel::is_ready(rcl_wait_set_t * wait_set)
+{
+  const rcl_timer_t * timer_handle = tick_timer_->get_timer_handle().get();
+  for (size_t i = 0; i < wait_set->size_of_timers; ++i) {
+    if (wait_set->timers[i] == timer_handle) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::shared_ptr<void>
+TimerWheel::take_data()
+{
+  // Acknowledge the tick, so that the timer is not ready until the next one.
+  tick_timer_->call();
+  return nullptr;
+}
+
+void
+TimerWheel::execute(std::shared_ptr<void> & data)
+{
+  (void)data;
+  std::vector<std::shared_ptr<const TimerCallback>> expired;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    advance(now_tick(), expired);
+    if (0 == size_) {
+      tick_timer_->cancel();
+    }
+  }
+  // The callbacks may add, restart or cancel timers.
+  for (const auto & callback : expired) {
+    (*callback)();
+  }
+}
+
+uint64_t
+TimerWheel::now_tick() const
+{
+  return static_cast<uint64_t>((std::chrono::steady_clock::now() - start_) / tick_);
+}
+
+uint64_t
+TimerWheel::deadline_tick(std::chrono::nanoseconds delay) const
+{
+  // First tick at or after the deadline.
+  const auto elapsed = std::chrono::steady_clock::now() - start_ +
+    std::max(delay, std::chrono::nanoseconds(0));
+  return static_cast<uint64_t>((elapsed + tick_ - std::chrono::nanoseconds(1)) / tick_);
+}
+
+TimerWheel::Entry *
+TimerWheel::find(TimerId id)
+{
+  const uint64_t position = id & UINT32_MAX;
+  if (0 == position || position > entries_.size()) {
+    return nullptr;
+  }
+  Entry & entry = entries_[position - 1];
+  if (!entry.callback || entry.generation != static_cast<uint32_t>(id >> 32)) {
+    return nullptr;
+  }
+  return &entry;
+}
+
+void
+TimerWheel::link(uint32_t index)
+{
+  Entry & entry = entries_[index];
+  const uint64_t delta = entry.expiry_tick > current_tick_ ? entry.expiry_tick - current_tick_ : 0;
+  size_t level = 0;
+  while (level + 1 < kLevels && 0 != (delta >> (kSlotBits * (level + 1)))) {
+    ++level;
+  }
+  uint64_t slot_tick = entry.expiry_tick;
+  if (0 != (delta >> (kSlotBits * kLevels))) {
+    // Beyond the range of the wheel: park it in the last slot, it is cascaded again from there.
+    slot_tick = current_tick_ + (uint64_t(1) << (kSlotBits * kLevels)) - 1;
+  }
+  const uint32_t slot = static_cast<uint32_t>(
+    level * kSlotsPerLevel + ((slot_tick >> (kSlotBits * level)) & (kSlotsPerLevel - 1)));
+  entry.slot = slot;
+  entry.previous = kNone;
+  entry.next = slots_[slot];
+  if (kNone != entry.next) {
+    entries_[entry.next].previous = index;
+  }
+  slots_[slot] = index;
+}
+
+void
+TimerWheel::unlink(uint32_t index)
+{
+  Entry & entry = entries_[index];
+  if (kNone != entry.previous) {
+    entries_[entry.previous].next = entry.next;
+  } else {
+    slots_[entry.slot] = entry.next;
+  }
+  if (kNone != entry.next) {
+    entries_[entry.next].previous = entry.previous;
+  }
+  entry.slot = kNone;
+  entry.previous = kNone;
+  entry.next = kNone;
+}
+
+void
+TimerWheel::release(uint32_t index)
+{
+  Entry & entry = entries_[index];
+  entry.callback.reset();
+  ++entry.generation;
+  free_entries_.push_back(index);
+  --size_;
+}
+
+void
+TimerWheel::cascade(size_t level)
+{
+  const size_t slot = level * kSlotsPerLevel +
+    ((current_tick_ >> (kSlotBits * level)) & (kSlotsPerLevel - 1));
+  uint32_t index = slots_[slot];
+  slots_[slot] = kNone;
+  while (kNone != index) {
+    const uint32_t next = entries_[index].next;
+    link(index);
+    index = next;
+  }
+}
+
+void
+TimerWheel::advance(uint64_t tick, std::vector<std::shared_ptr<const TimerCallback>> & expired)
+{
+  while (current_tick_ < tick) {
+    if (0 == size_) {
+      current_tick_ = tick;
+      return;
+    }
+    ++current_tick_;
+    // Spread the next slot of each level into the lower ones once they wrapped around.
+    for (size_t level = 1; level < kLevels; ++level) {
+      if (0 != (current_tick_ & ((uint64_t(1) << (kSlotBits * level)) - 1))) {
+        break;
+      }
+      cascade(level);
+    }
+    const size_t slot = current_tick_ & (kSlotsPerLevel - 1);
+    uint32_t index = slots_[slot];
+    slots_[slot] = kNone;
+    while (kNone != index) {
+      Entry & entry = entries_[index];
+      const uint32_t next = entry.next;
+      if (entry.expiry_tick > current_tick_) {
+        link(index);
+      } else {
+        expired.push_back(entry.callback);
+        if (0 != entry.period_ticks) {
+          entry.expiry_tick = current_tick_ + entry.period_ticks;
+          link(index);
+        } else {
+          entry.slot = kNone;
+          entry.next = kNone;
+          release(index);
+        }
+      }
+      index = next;
+    }
+  }
+}
+
+void
+TimerWheel::start_ticking()
+{
+  tick_timer_->reset();
+  // Interrupt a wait which started while the tick timer was cancelled.
+  guard_condition_.trigger();
+}
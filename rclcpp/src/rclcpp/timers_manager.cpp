@@ -0,0 +1,315 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/experimental/timers_manager.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "rcutils/logging_macros.h"
+
+using namespace std::chrono_literals;
+
+using rclcpp::experimental::TimersManager;
+
+TimersManager::TimersManager(OnReadyCallback on_ready_callback)
+: on_ready_callback_(std::move(on_ready_callback))
+{
+  if (!on_ready_callback_) {
+    throw std::invalid_argument("on_ready_callback of TimersManager is not callable");
+  }
+}
+
+TimersManager::~TimersManager()
+{
+  stop();
+  clear();
+}
+
+void
+TimersManager::add_timer(rclcpp::TimerBase::SharedPtr timer)
+{
+  if (!timer) {
+    throw std::invalid_argument("timer argument is null");
+  }
+  {
+    std::lock_guard<std::mutex> lock(timers_mutex_);
+    for (const auto & entry : timers_heap_) {
+      if (entry.key == timer.get()) {
+        return;
+      }
+    }
+    TimerEntry entry{{}, {}, timer, timer.get()};
+    set_ready_time(entry, *timer, get_deadline(*timer, std::chrono::steady_clock::now()));
+    timers_heap_.push_back(entry);
+    std::push_heap(timers_heap_.begin(), timers_heap_.end(), has_later_deadline);
+    head_changed_ = true;
+  }
+  timers_cv_.notify_one();
+  // Set without holding timers_mutex_, which the callback locks while reset() holds the lock
+  // of the timer.
+  timer->set_on_reset_callback(
+    [this]() {
+      {
+        std::lock_guard<std::mutex> lock(timers_mutex_);
+        timers_reset_ = true;
+      }
+      timers_cv_.notify_one();
+    });
+}
+
+void
+TimersManager::remove_timer(const rclcpp::TimerBase::SharedPtr & timer)
+{
+  if (!timer) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(timers_mutex_);
+    auto it = std::find_if(
+      timers_heap_.begin(), timers_heap_.end(),
+      [&timer](const TimerEntry & entry) {return entry.key == timer.get();});
+    if (it == timers_heap_.end()) {
+      return;
+    }
+    timers_heap_.erase(it);
+    std::make_heap(timers_heap_.begin(), timers_heap_.end(), has_later_deadline);
+    head_changed_ = true;
+  }
+  timers_cv_.notify_one();
+  timer->clear_on_reset_callback();
+}
+
+void
+TimersManager::clear()
+{
+  std::vector<TimerEntry> timers;
+  {
+    std::lock_guard<std::mutex> lock(timers_mutex_);
+    std::swap(timers, timers_heap_);
+    head_changed_ = true;
+  }
+  timers_cv_.notify_one();
+  for (const auto & entry : timers) {
+    auto timer = entry.timer.lock();
+    if (timer) {
+      timer->clear_on_reset_callback();
+    }
+  }
+}
+
+void
+TimersManager::start()
+{
+  std::lock_guard<std::mutex> lock(timers_mutex_);
+  if (running_) {
+    throw std::runtime_error("TimersManager::start() called while already running");
+  }
+  running_ = true;
+  timers_thread_ = std::thread(&TimersManager::run_timers, this);
+}
+
+void
+TimersManager::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(timers_mutex_);
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+  timers_cv_.notify_one();
+  timers_thread_.join();
+}
+
+size_t
+TimersManager::execute_ready_timers()
+{
+  std::lock_guard<std::mutex> lock(timers_mutex_);
+  if (timers_reset_) {
+    timers_reset_ = false;
+    reschedule_timers_unsafe();
+  }
+  return execute_ready_timers_unsafe();
+}
+
+std::chrono::nanoseconds
+TimersManager::get_head_timeout()
+{
+  std::lock_guard<std::mutex> lock(timers_mutex_);
+  if (timers_reset_) {
+    timers_reset_ = false;
+    reschedule_timers_unsafe();
+  }
+  if (timers_heap_.empty() ||
+    timers_heap_.front().deadline == std::chrono::steady_clock::time_point::max())
+  {
+    return -1ns;
+  }
+  return std::max(0ns, timers_heap_.front().deadline - std::chrono::steady_clock::now());
+}
+
+size_t
+TimersManager::get_number_of_timers() const
+{
+  std::lock_guard<std::mutex> lock(timers_mutex_);
+  return timers_heap_.size();
+}
+
+std::chrono::steady_clock::time_point
+TimersManager::get_deadline(
+  rclcpp::TimerBase & timer,
+  std::chrono::steady_clock::time_point now)
+{
+  try {
+    if (timer.is_canceled()) {
+      return std::chrono::steady_clock::time_point::max();
+    }
+    return now + std::max(0ns, timer.time_until_trigger());
+  } catch (const std::runtime_error &) {
+    // The timer was canceled in the meantime.
+    return std::chrono::steady_clock::time_point::max();
+  }
+}
+
+void
+TimersManager::set_ready_time(
+  TimerEntry & entry,
+  const rclcpp::TimerBase & timer,
+  std::chrono::steady_clock::time_point ready_time)
+{
+  entry.ready_time = ready_time;
+  const auto slack = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+    timer.get_slack());
+  // Saturates, e.g. for the ready time of a canceled timer.
+  entry.deadline =
+    ready_time + std::min(slack, std::chrono::steady_clock::time_point::max() - ready_time);
+}
+
+void
+TimersManager::run_timers()
+{
+  std::unique_lock<std::mutex> lock(timers_mutex_);
+  auto needs_update = [this]() {return !running_ || head_changed_ || timers_reset_;};
+  while (running_) {
+    if (timers_heap_.empty() ||
+      timers_heap_.front().deadline == std::chrono::steady_clock::time_point::max())
+    {
+      timers_cv_.wait(lock, needs_update);
+    } else {
+      timers_cv_.wait_until(lock, timers_heap_.front().deadline, needs_update);
+    }
+    if (!running_) {
+      break;
+    }
+    head_changed_ = false;
+    if (timers_reset_) {
+      timers_reset_ = false;
+      reschedule_timers_unsafe();
+    }
+    execute_ready_timers_unsafe();
+  }
+}
+
+size_t
+TimersManager::execute_ready_timers_unsafe()
+{
+  size_t executed = 0;
+  const auto now = std::chrono::steady_clock::now();
+  if (timers_heap_.empty() || timers_heap_.front().deadline > now) {
+    return executed;
+  }
+  while (!timers_heap_.empty() && timers_heap_.front().deadline <= now) {
+    std::pop_heap(timers_heap_.begin(), timers_heap_.end(), has_later_deadline);
+    if (!call_timer_unsafe(timers_heap_.back(), now, executed)) {
+      timers_heap_.pop_back();
+      continue;
+    }
+    std::push_heap(timers_heap_.begin(), timers_heap_.end(), has_later_deadline);
+  }
+  // Since the thread woke up anyway, also call the ready timers whose slack did not run out.
+  bool coalesced = false;
+  for (auto & entry : timers_heap_) {
+    if (entry.ready_time <= now) {
+      call_timer_unsafe(entry, now, executed);
+      coalesced = true;
+    }
+  }
+  if (coalesced) {
+    auto expired = std::remove_if(
+      timers_heap_.begin(), timers_heap_.end(),
+      [](const TimerEntry & entry) {return entry.timer.expired();});
+    timers_heap_.erase(expired, timers_heap_.end());
+    std::make_heap(timers_heap_.begin(), timers_heap_.end(), has_later_deadline);
+  }
+  return executed;
+}
+
+bool
+TimersManager::call_timer_unsafe(
+  TimerEntry & entry,
+  std::chrono::steady_clock::time_point now,
+  size_t & executed)
+{
+  auto timer = entry.timer.lock();
+  if (!timer) {
+    return false;
+  }
+  try {
+    // The deadline is an estimate, only the timer itself knows if it is ready.
+    set_ready_time(entry, *timer, get_deadline(*timer, now));
+    if (entry.ready_time <= now) {
+      if (timer->call()) {
+        on_ready_callback_(timer.get());
+        ++executed;
+      }
+      // Not reported again in this call, even if its period is shorter than this loop.
+      set_ready_time(
+        entry, *timer,
+        std::max(get_deadline(*timer, std::chrono::steady_clock::now()), now + 1ns));
+    }
+  } catch (const std::exception & exception) {
+    RCUTILS_LOG_ERROR_NAMED(
+      "rclcpp",
+      "failed to execute timer, it is not rescheduled until reset: %s", exception.what());
+    entry.ready_time = std::chrono::steady_clock::time_point::max();
+    entry.deadline = std::chrono::steady_clock::time_point::max();
+  }
+  return true;
+}
+
+void
+TimersManager::reschedule_timers_unsafe()
+{
+  auto expired = std::remove_if(
+    timers_heap_.begin(), timers_heap_.end(),
+    [](const TimerEntry & entry) {return entry.timer.expired();});
+  timers_heap_.erase(expired, timers_heap_.end());
+  const auto now = std::chrono::steady_clock::now();
+  for (auto & entry : timers_heap_) {
+    auto timer = entry.timer.lock();
+    if (timer) {
+      set_ready_time(entry, *timer, get_deadline(*timer, now));
+    } else {
+      entry.ready_time = std::chrono::steady_clock::time_point::max();
+      entry.deadline = std::chrono::steady_clock::time_point::max();
+    }
+  }
+  std::make_heap(timers_heap_.begin(), timers_heap_.end(), has_later_deadline);
+}
@@ -0,0 +1,162 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/topic_statistics/executor_metrics_collector.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+
+using rclcpp::topic_statistics::ExecutorMetricsCollector;
+using statistics_msgs::msg::MetricsMessage;
+
+namespace
+{
+
+constexpr const char kCountUnitName[]{"count"};
+constexpr const char kMillisecondUnitName[]{"ms"};
+constexpr const char kHertzUnitName[]{"hz"};
+constexpr const char kPercentUnitName[]{"percent"};
+
+rclcpp::Time
+get_current_time()
+{
+  return rclcpp::Time(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+double
+to_milliseconds(std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/// Return the statistics of a value computed over the whole window, from sample_count samples.
+rclcpp::topic_statistics::AtomicStatisticsAccumulator::StatisticData
+make_window_statistic(double value, uint64_t sample_count)
+{
+  rclcpp::topic_statistics::AtomicStatisticsAccumulator::StatisticData data;
+  data.average = value;
+  data.min = value;
+  data.max = value;
+  data.standard_deviation = 0.0;
+  data.sample_count = sample_count;
+  return data;
+}
+
+}  // namespace
+
+ExecutorMetricsCollector::ExecutorMetricsCollector(
+  const std::string & executor_name,
+  rclcpp::Publisher<MetricsMessage>::SharedPtr publisher)
+: executor_name_(executor_name),
+  publisher_(std::move(publisher)),
+  window_start_(get_current_time()),
+  window_steady_start_(std::chrono::steady_clock::now())
+{}
+
+ExecutorMetricsCollector::~ExecutorMetricsCollector()
+{
+  if (publisher_timer_) {
+    publisher_timer_->cancel();
+  }
+}
+
+void
+ExecutorMetricsCollector::on_wait(std::chrono::nanoseconds wait_duration)
+{
+  wait_time_.add_measurement(to_milliseconds(wait_duration));
+  total_wait_nanoseconds_.fetch_add(wait_duration.count(), std::memory_order_relaxed);
+  cycle_count_.fetch_add(1u, std::memory_order_relaxed);
+}
+
+void
+ExecutorMetricsCollector::on_wait_result(size_t wait_set_size, size_t ready_count)
+{
+  wait_set_size_.add_measurement(static_cast<double>(wait_set_size));
+  ready_count_.add_measurement(static_cast<double>(ready_count));
+}
+
+void
+ExecutorMetricsCollector::on_execute(const rclcpp::ExecutableExecution & execution)
+{
+  execution_time_.add_measurement(to_milliseconds(execution.duration));
+  total_execution_nanoseconds_.fetch_add(
+    execution.duration.count(), std::memory_order_relaxed);
+}
+
+std::vector<MetricsMessage>
+ExecutorMetricsCollector::collect_metrics_and_reset()
+{
+  std::lock_guard<std::mutex> lock(window_mutex_);
+  const rclcpp::Time window_end = get_current_time();
+  const auto window_steady_end = std::chrono::steady_clock::now();
+  const double window_seconds =
+    std::chrono::duration<double>(window_steady_end - window_steady_start_).count();
+
+  const uint64_t cycle_count = cycle_count_.exchange(0u, std::memory_order_relaxed);
+  const int64_t wait_nanoseconds = total_wait_nanoseconds_.exchange(0, std::memory_order_relaxed);
+  const int64_t execution_nanoseconds =
+    total_execution_nanoseconds_.exchange(0, std::memory_order_relaxed);
+  const double cycle_rate = window_seconds > 0.0 ? cycle_count / window_seconds : 0.0;
+  const int64_t busy_and_idle_nanoseconds = wait_nanoseconds + execution_nanoseconds;
+  const double utilization = busy_and_idle_nanoseconds > 0 ?
+    100.0 * static_cast<double>(execution_nanoseconds) / busy_and_idle_nanoseconds : 0.0;
+
+  std::vector<MetricsMessage> messages;
+  auto add_message = [&](const char * metric_name, const char * unit, const auto & data) {
+      messages.push_back(
+        libstatistics_collector::collector::GenerateStatisticMessage(
+          executor_name_, metric_name, unit, window_start_, window_end, data));
+    };
+  add_message("executor_wait_set_size", kCountUnitName, wait_set_size_.get_statistics_and_reset());
+  add_message("executor_ready_entities", kCountUnitName, ready_count_.get_statistics_and_reset());
+  add_message("executor_wait_time", kMillisecondUnitName, wait_time_.get_statistics_and_reset());
+  add_message(
+    "executor_execution_time", kMillisecondUnitName, execution_time_.get_statistics_and_reset());
+  add_message(
+    "executor_cycle_rate", kHertzUnitName, make_window_statistic(cycle_rate, cycle_count));
+  add_message(
+    "executor_utilization", kPercentUnitName, make_window_statistic(utilization, cycle_count));
+
+  window_start_ = window_end;
+  window_steady_start_ = window_steady_end;
+  return messages;
+}
+
+void
+ExecutorMetricsCollector::publish_metrics_and_reset()
+{
+  if (!publisher_) {
+    throw std::runtime_error("the executor metrics collector has no publisher");
+  }
+  for (const auto & message : collect_metrics_and_reset()) {
+    publisher_->publish(message);
+  }
+}
+
+void
+ExecutorMetricsCollector::set_publisher_timer(rclcpp::TimerBase::SharedPtr publisher_timer)
+{
+  publisher_timer_ = std::move(publisher_timer);
+}
@@ -0,0 +1,169 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/topic_statistics/publisher_topic_statistics.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "libstatistics_collector/collector/generate_statistics_message.hpp"
+#include "libstatistics_collector/topic_statistics_collector/constants.hpp"
+
+#include "rclcpp/publisher.hpp"
+#include "rclcpp/timer.hpp"
+
+using rclcpp::topic_statistics::PublishMeasurementType;
+using rclcpp::topic_statistics::PublisherTopicStatistics;
+using statistics_msgs::msg::MetricsMessage;
+
+namespace
+{
+
+constexpr const char kPublishPeriodStatName[]{"publish_period"};
+constexpr const char kPublishDurationStatName[]{"publish_duration"};
+constexpr const char kInterProcessPublishDurationStatName[]{"inter_process_publish_duration"};
+constexpr const char kIntraProcessFanOutStatName[]{"intra_process_fan_out"};
+constexpr const char kCountUnitName[]{"count"};
+
+/// Publisher statistics of the publish call being measured on this thread, if any.
+thread_local const PublisherTopicStatistics * g_measured_publish = nullptr;
+
+rclcpp::Time
+get_current_time()
+{
+  return rclcpp::Time(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+double
+to_milliseconds(std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+}  // namespace
+
+PublisherTopicStatistics::PublisherTopicStatistics(
+  const std::string & source_name,
+  std::shared_ptr<rclcpp::PublisherBase> publisher)
+: source_name_(source_name),
+  publisher_(std::move(publisher)),
+  window_start_(get_current_time())
+{
+  if (nullptr == publisher_) {
+    throw std::invalid_argument("publisher pointer is nullptr");
+  }
+  if (nullptr == std::dynamic_pointer_cast<rclcpp::Publisher<MetricsMessage>>(publisher_)) {
+    throw std::invalid_argument("publisher must publish statistics_msgs/msg/MetricsMessage");
+  }
+}
+
+PublisherTopicStatistics::~PublisherTopicStatistics()
+{
+  if (publisher_timer_) {
+    publisher_timer_->cancel();
+  }
+}
+
+bool
+PublisherTopicStatistics::begin_measurement(
+  PublishMeasurementType type,
+  std::chrono::steady_clock::time_point start)
+{
+  if (PublishMeasurementType::Publish != type) {
+    return true;
+  }
+  if (g_measured_publish == this) {
+    return false;
+  }
+  g_measured_publish = this;
+  const int64_t start_nanoseconds =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+  const int64_t previous_nanoseconds = last_publish_nanoseconds_.exchange(start_nanoseconds);
+  if (previous_nanoseconds != kNoPublication) {
+    publish_period_.add_measurement(
+      to_milliseconds(std::chrono::nanoseconds(start_nanoseconds - previous_nanoseconds)));
+  }
+  return true;
+}
+
+void
+PublisherTopicStatistics::end_measurement(
+  PublishMeasurementType type,
+  std::chrono::nanoseconds duration)
+{
+  if (PublishMeasurementType::Publish == type) {
+    if (g_measured_publish == this) {
+      g_measured_publish = nullptr;
+    }
+    publish_duration_.add_measurement(to_milliseconds(duration));
+  } else {
+    inter_process_publish_duration_.add_measurement(to_milliseconds(duration));
+  }
+}
+
+void
+PublisherTopicStatistics::record_intra_process_fan_out(size_t subscription_count)
+{
+  intra_process_fan_out_.add_measurement(static_cast<double>(subscription_count));
+}
+
+std::vector<MetricsMessage>
+PublisherTopicStatistics::collect_metrics_and_reset()
+{
+  namespace constants =
+    libstatistics_collector::topic_statistics_collector::topic_statistics_constants;
+
+  std::lock_guard<std::mutex> lock(window_mutex_);
+  const rclcpp::Time window_end = get_current_time();
+  std::vector<MetricsMessage> messages;
+  auto add_message =
+    [&](const char * metric_name, const char * unit, AtomicStatisticsAccumulator & accumulator) {
+      messages.push_back(
+        libstatistics_collector::collector::GenerateStatisticMessage(
+          source_name_, metric_name, unit, window_start_, window_end,
+          accumulator.get_statistics_and_reset()));
+    };
+  add_message(kPublishPeriodStatName, constants::kMillisecondUnitName, publish_period_);
+  add_message(kPublishDurationStatName, constants::kMillisecondUnitName, publish_duration_);
+  add_message(
+    kInterProcessPublishDurationStatName, constants::kMillisecondUnitName,
+    inter_process_publish_duration_);
+  add_message(kIntraProcessFanOutStatName, kCountUnitName, intra_process_fan_out_);
+  window_start_ = window_end;
+  return messages;
+}
+
+void
+PublisherTopicStatistics::publish_message_and_reset_measurements()
+{
+  auto publisher = std::static_pointer_cast<rclcpp::Publisher<MetricsMessage>>(publisher_);
+  for (const auto & message : collect_metrics_and_reset()) {
+    publisher->publish(message);
+  }
+}
+
+void
+PublisherTopicStatistics::set_publisher_timer(std::shared_ptr<rclcpp::TimerBase> publisher_timer)
+{
+  publisher_timer_ = std::move(publisher_timer);
+}
@@ -0,0 +1,237 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp/tracing.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace rclcpp
+{
+namespace tracing
+{
+
+namespace
+{
+
+struct BackendState
+{
+  std::mutex mutex;
+  TraceBackend::SharedPtr backend;
+  // Backends replaced while threads may still be recording to them.
+  std::vector<TraceBackend::SharedPtr> retired_backends;
+};
+
+BackendState &
+get_backend_state()
+{
+  // Never destroyed, so that threads recording during the exit do not use a destroyed backend.
+  static BackendState * state = new BackendState();
+  return *state;
+}
+
+std::atomic<TraceBackend *> g_backend{nullptr};
+
+uint64_t
+get_thread_id()
+{
+  static std::atomic<uint64_t> next_thread_id{1};
+  thread_local const uint64_t thread_id = next_thread_id.fetch_add(1, std::memory_order_relaxed);
+  return thread_id;
+}
+
+uint64_t
+next_backend_id()
+{
+  static std::atomic<uint64_t> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t
+round_up_to_power_of_2(size_t value)
+{
+  size_t capacity = 1;
+  while (capacity < value) {
+    capacity <<= 1;
+  }
+  return capacity;
+}
+
+}  // namespace
+
+TraceBackend::~TraceBackend()
+{}
+
+void
+set_backend(TraceBackend::SharedPtr backend)
+{
+  BackendState & state = get_backend_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  if (state.backend) {
+    state.retired_backends.push_back(state.backend);
+  }
+  state.backend = std::move(backend);
+  g_backend.store(state.backend.get(), std::memory_order_release);
+}
+
+TraceBackend::SharedPtr
+get_backend()
+{
+  BackendState & state = get_backend_state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  return state.backend;
+}
+
+bool
+is_enabled()
+{
+  return nullptr != g_backend.load(std::memory_order_relaxed);
+}
+
+void
+record(TraceEventType type, uint64_t handle, uint64_t source, uint64_t data)
+{
+  TraceBackend * backend = g_backend.load(std::memory_order_acquire);
+  if (nullptr == backend) {
+    return;
+  }
+  TraceEvent event;
+  event.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+  event.thread_id = get_thread_id();
+  event.handle = handle;
+  event.source = source;
+  event.data = data;
+  event.type = static_cast<uint32_t>(type);
+  event.reserved = 0;
+  backend->record(event);
+}
+
+RingBufferTraceBackend::RingBufferTraceBackend(
+  const std::string & file_path,
+  size_t events_per_thread)
+: id_(next_backend_id()),
+  capacity_(round_up_to_power_of_2(events_per_thread))
+{
+  if (0 == events_per_thread) {
+    throw std::invalid_argument("the ring of a trace backend must hold at least one event");
+  }
+  file_.open(file_path, std::ios::binary | std::ios::trunc);
+  if (!file_) {
+    throw std::runtime_error("failed to open the trace file '" + file_path + "'");
+  }
+  const uint64_t header[] = {kMagic, kVersion, sizeof(TraceEvent)};
+  file_.write(reinterpret_cast<const char *>(header), sizeof(header));
+  file_.flush();
+  if (!file_) {
+    throw std::runtime_error("failed to write the trace file '" + file_path + "'");
+  }
+}
+
+RingBufferTraceBackend::~RingBufferTraceBackend()
+{
+  try {
+    flush();
+  } catch (...) {
+    // The events are lost, a destructor must not throw.
+  }
+}
+
+RingBufferTraceBackend::Ring *
+RingBufferTraceBackend::get_thread_ring()
+{
+  // Most threads record to a single backend, whose ring is cached.
+  thread_local uint64_t cached_backend_id = 0;
+  thread_local Ring * cached_ring = nullptr;
+  if (cached_backend_id == id_) {
+    return cached_ring;
+  }
+  const std::thread::id thread_id = std::this_thread::get_id();
+  Ring * ring = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (const auto & existing_ring : rings_) {
+      if (existing_ring->owner == thread_id) {
+        ring = existing_ring.get();
+        break;
+      }
+    }
+    if (nullptr == ring) {
+      rings_.push_back(std::make_unique<Ring>(thread_id, capacity_));
+      ring = rings_.back().get();
+    }
+  }
+  cached_backend_id = id_;
+  cached_ring = ring;
+  return ring;
+}
+
+void
+RingBufferTraceBackend::record(const TraceEvent & event)
+{
+  Ring * ring = get_thread_ring();
+  const uint64_t head = ring->head.load(std::memory_order_relaxed);
+  const uint64_t tail = ring->tail.load(std::memory_order_acquire);
+  if (head - tail == capacity_) {
+    dropped_count_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  ring->events[head & (capacity_ - 1)] = event;
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+void
+RingBufferTraceBackend::flush()
+{
+  std::vector<Ring *> rings;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings.reserve(rings_.size());
+    for (const auto & ring : rings_) {
+      rings.push_back(ring.get());
+    }
+  }
+  std::lock_guard<std::mutex> lock(file_mutex_);
+  for (Ring * ring : rings) {
+    const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    const uint64_t head = ring->head.load(std::memory_order_acquire);
+    for (uint64_t index = tail; index != head; ++index) {
+      file_.write(
+        reinterpret_cast<const char *>(&ring->events[index & (capacity_ - 1)]),
+        sizeof(TraceEvent));
+    }
+    ring->tail.store(head, std::memory_order_release);
+  }
+  file_.flush();
+  if (!file_) {
+    throw std::runtime_error("failed to write the trace file");
+  }
+}
+
+uint64_t
+RingBufferTraceBackend::get_dropped_count() const
+{
+  return dropped_count_.load(std::memory_order_relaxed);
+}
+
+}  // namespace tracing
+}  // namespace rclcpp
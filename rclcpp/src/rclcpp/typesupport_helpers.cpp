@@ -16,11 +16,14 @@
 #include "rclcpp/typesupport_helpers.hpp"
 
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 
 #include "ament_index_cpp/get_package_prefix.hpp"
@@ -91,14 +94,82 @@ extract_type_identifier(const std::string & full_type)
   return std::make_tuple(package_name, middle_module, type_name);
 }
 
+/// Loaded type support library, and the handles already looked up in it.
+struct CachedTypesupportLibrary
+{
+  // Not owning, so that the library is unloaded once the last user releases it.
+  std::weak_ptr<rcpputils::SharedLibrary> library;
+  std::unordered_map<std::string, const rosidl_message_type_support_t *> handles;
+};
+
+/// Process-wide cache of the type support libraries, by package and type support identifier.
+class TypesupportLibraryCache
+{
+public:
+  std::mutex mutex;
+  std::map<std::pair<std::string, std::string>, CachedTypesupportLibrary> libraries;
+
+  /// Return the entry of the given library, or nullptr if it was not loaded through the cache.
+  CachedTypesupportLibrary *
+  find(
+    const std::string & package_name, const std::string & typesupport_identifier,
+    const rcpputils::SharedLibrary & library)
+  {
+    auto it = libraries.find({package_name, typesupport_identifier});
+    if (it == libraries.end() || it->second.library.lock().get() != &library) {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  /// Drop the entries of the libraries which were unloaded.
+  void
+  prune()
+  {
+    for (auto it = libraries.begin(); it != libraries.end(); ) {
+      if (it->second.library.expired()) {
+        it = libraries.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+};
+
+TypesupportLibraryCache &
+get_typesupport_library_cache()
+{
+  static TypesupportLibraryCache cache;
+  return cache;
+}
+
 }  // anonymous namespace
 
 std::shared_ptr<rcpputils::SharedLibrary>
 get_typesupport_library(const std::string & type, const std::string & typesupport_identifier)
 {
   auto package_name = std::get<0>(extract_type_identifier(type));
-  auto library_path = get_typesupport_library_path(package_name, typesupport_identifier);
-  return std::make_shared<rcpputils::SharedLibrary>(library_path);
+
+  // The libraries are shared while in use, so creating many generic publishers and
+  // subscriptions of the same packages only looks up the ament index and loads each once.
+  auto & cache = get_typesupport_library_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto & cached = cache.libraries[{package_name, typesupport_identifier}];
+  auto library = cached.library.lock();
+  if (library) {
+    return library;
+  }
+  cached.handles.clear();
+  try {
+    auto library_path = get_typesupport_library_path(package_name, typesupport_identifier);
+    library = std::make_shared<rcpputils::SharedLibrary>(library_path);
+  } catch (...) {
+    cache.libraries.erase({package_name, typesupport_identifier});
+    throw;
+  }
+  cached.library = library;
+  cache.prune();
+  return library;
 }
 
 const rosidl_message_type_support_t *
@@ -120,6 +191,16 @@ get_typesupport_handle(
       return rcutils_dynamic_loading_error.str();
     };
 
+  auto & cache = get_typesupport_library_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  CachedTypesupportLibrary * cached = cache.find(package_name, typesupport_identifier, library);
+  if (cached) {
+    auto handle_it = cached->handles.find(type);
+    if (handle_it != cached->handles.end()) {
+      return handle_it->second;
+    }
+  }
+
   try {
     std::string symbol_name = typesupport_identifier + "__get_message_type_support_handle__" +
       package_name + "__" + (middle_module.empty() ? "msg" : middle_module) + "__" + type_name;
@@ -127,7 +208,11 @@ get_typesupport_handle(
     const rosidl_message_type_support_t * (* get_ts)() = nullptr;
     // This will throw runtime_error if the symbol was not found.
     get_ts = reinterpret_cast<decltype(get_ts)>(library.get_symbol(symbol_name));
-    return get_ts();
+    const rosidl_message_type_support_t * handle = get_ts();
+    if (cached) {
+      cached->handles.emplace(type, handle);
+    }
+    return handle;
   } catch (std::runtime_error &) {
     throw std::runtime_error{mk_error("Library could not be found.")};
   }
@@ -38,6 +38,13 @@ WritePreferringReadWriteLock::get_write_mutex()
   return write_mutex_;
 }
 
+WritePreferringReadWriteLock::Statistics
+WritePreferringReadWriteLock::get_statistics() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
 WritePreferringReadWriteLock::ReadMutex::ReadMutex(WritePreferringReadWriteLock & parent_lock)
 : parent_lock_(parent_lock)
 {}
@@ -46,13 +53,23 @@ void
 WritePreferringReadWriteLock::ReadMutex::lock()
 {
   std::unique_lock<std::mutex> lock(parent_lock_.mutex_);
-  while (
-    parent_lock_.number_of_writers_waiting_ > 0 ||
-    parent_lock_.writer_active_ ||
-    parent_lock_.reader_active_)
-  {
-    parent_lock_.condition_variable_.wait(lock);
+  auto must_wait = [this]() {
+      return parent_lock_.number_of_writers_waiting_ > 0 ||
+             parent_lock_.writer_active_ ||
+             parent_lock_.reader_active_;
+    };
+  Statistics & statistics = parent_lock_.statistics_;
+  if (must_wait()) {
+    // Only measure the time of contended locks, which block anyway.
+    auto start = std::chrono::steady_clock::now();
+    do {
+      parent_lock_.condition_variable_.wait(lock);
+    } while (must_wait());
+    statistics.contended_read_locks++;
+    statistics.read_wait_time += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
   }
+  statistics.read_locks++;
   parent_lock_.reader_active_ = true;
   // implicit unlock of parent_lock_.mutex_
 }
@@ -78,9 +95,17 @@ WritePreferringReadWriteLock::WriteMutex::lock()
   if (nullptr != parent_lock_.enter_waiting_function_) {
     parent_lock_.enter_waiting_function_();
   }
-  while (parent_lock_.reader_active_ || parent_lock_.writer_active_) {
-    parent_lock_.condition_variable_.wait(lock);
+  Statistics & statistics = parent_lock_.statistics_;
+  if (parent_lock_.reader_active_ || parent_lock_.writer_active_) {
+    auto start = std::chrono::steady_clock::now();
+    do {
+      parent_lock_.condition_variable_.wait(lock);
+    } while (parent_lock_.reader_active_ || parent_lock_.writer_active_);
+    statistics.contended_write_locks++;
+    statistics.write_wait_time += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - start);
   }
+  statistics.write_locks++;
   parent_lock_.number_of_writers_waiting_ -= 1;
   parent_lock_.writer_active_ = true;
   // implicit unlock of parent_lock_.mutex_
@@ -14,6 +14,9 @@
 
 #include "rclcpp/waitable.hpp"
 
+#include <functional>
+#include <stdexcept>
+
 using rclcpp::Waitable;
 
 size_t
@@ -57,3 +60,21 @@ Waitable::exchange_in_use_by_wait_set_state(bool in_use_state)
 {
   return in_use_by_wait_set_.exchange(in_use_state);
 }
+
+void
+Waitable::set_on_ready_callback(std::function<void(size_t, int)> callback)
+{
+  (void)callback;
+
+  throw std::runtime_error(
+          "Custom waitables should override set_on_ready_callback "
+          "if they want to use it.");
+}
+
+void
+Waitable::clear_on_ready_callback()
+{
+  throw std::runtime_error(
+          "Custom waitables should override clear_on_ready_callback "
+          "if they want to use it.");
+}
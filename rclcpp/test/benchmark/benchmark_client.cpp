@@ -143,6 +143,47 @@ BENCHMARK_F(ClientPerformanceTest, async_send_request_only)(benchmark::State & s
   }
 }
 
+BENCHMARK_F(ClientPerformanceTest, async_send_request_future_callback_only)(
+  benchmark::State & state)
+{
+  // Per request cost of the callback overload which creates a promise and a shared future,
+  // to be compared with async_send_request_response_callback_only
+  using SharedFuture = rclcpp::Client<test_msgs::srv::Empty>::SharedFuture;
+  auto client = node->create_client<test_msgs::srv::Empty>(empty_service_name);
+  auto shared_request = std::make_shared<test_msgs::srv::Empty::Request>();
+
+  reset_heap_counters();
+  for (auto _ : state) {
+    (void)_;
+    auto future = client->async_send_request(shared_request, [](SharedFuture) {});
+    benchmark::DoNotOptimize(future);
+    benchmark::ClobberMemory();
+    state.PauseTiming();
+    client->prune_pending_requests();
+    state.ResumeTiming();
+  }
+}
+
+BENCHMARK_F(ClientPerformanceTest, async_send_request_response_callback_only)(
+  benchmark::State & state)
+{
+  // The callback is stored in place in the pending requests, no promise nor future is created
+  using SharedResponse = rclcpp::Client<test_msgs::srv::Empty>::SharedResponse;
+  auto client = node->create_client<test_msgs::srv::Empty>(empty_service_name);
+  auto shared_request = std::make_shared<test_msgs::srv::Empty::Request>();
+
+  reset_heap_counters();
+  for (auto _ : state) {
+    (void)_;
+    auto request_id = client->async_send_request(shared_request, [](SharedResponse) {});
+    benchmark::DoNotOptimize(request_id);
+    benchmark::ClobberMemory();
+    state.PauseTiming();
+    client->prune_pending_requests();
+    state.ResumeTiming();
+  }
+}
+
 BENCHMARK_F(ClientPerformanceTest, async_send_request_and_response)(benchmark::State & state) {
   auto client = node->create_client<test_msgs::srv::Empty>(empty_service_name);
   auto shared_request = std::make_shared<test_msgs::srv::Empty::Request>();
@@ -157,3 +198,31 @@ BENCHMARK_F(ClientPerformanceTest, async_send_request_and_response)(benchmark::S
     benchmark::ClobberMemory();
   }
 }
+
+BENCHMARK_F(ClientPerformanceTest, async_send_request_and_response_same_executor)(
+  benchmark::State & state)
+{
+  // Per call latency of a client spinning a long lived executor, as done by tools issuing many
+  // short service calls, instead of the temporary executor of rclcpp::spin_until_future_complete
+  auto client = node->create_client<test_msgs::srv::Empty>(empty_service_name);
+  auto shared_request = std::make_shared<test_msgs::srv::Empty::Request>();
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node->get_node_base_interface());
+  // Prime the executor, the first wait returns right away for the added node
+  executor.spin_some();
+
+  reset_heap_counters();
+  for (auto _ : state) {
+    (void)_;
+    auto future = client->async_send_request(shared_request);
+    if (executor.spin_until_future_complete(future, std::chrono::seconds(1)) !=
+      rclcpp::FutureReturnCode::SUCCESS)
+    {
+      state.SkipWithError("response not received");
+      break;
+    }
+    benchmark::DoNotOptimize(future);
+    benchmark::ClobberMemory();
+  }
+  executor.remove_node(node->get_node_base_interface());
+}
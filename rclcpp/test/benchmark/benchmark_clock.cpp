@@ -0,0 +1,115 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "benchmark/benchmark.h"
+
+#include "rclcpp/rclcpp.hpp"
+
+namespace
+{
+
+// Node using simulated time, shared by the threads of the benchmarks.
+class SimTimeNode
+{
+public:
+  SimTimeNode()
+  {
+    context = std::make_shared<rclcpp::Context>();
+    context->init(0, nullptr, rclcpp::InitOptions().auto_initialize_logging(false));
+    node = std::make_shared<rclcpp::Node>(
+      "benchmark_clock_node",
+      rclcpp::NodeOptions()
+      .context(context)
+      .parameter_overrides({rclcpp::Parameter("use_sim_time", true)}));
+  }
+
+  ~SimTimeNode()
+  {
+    node.reset();
+    context->shutdown("Benchmark is complete");
+  }
+
+  rclcpp::Context::SharedPtr context;
+  rclcpp::Node::SharedPtr node;
+};
+
+rclcpp::Clock::SharedPtr
+get_sim_time_clock()
+{
+  static SimTimeNode sim_time_node;
+  return sim_time_node.node->get_clock();
+}
+
+rclcpp::Clock::SharedPtr
+get_ros_time_override_clock()
+{
+  static rclcpp::Clock::SharedPtr clock = []() {
+      auto ros_clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+      rcl_enable_ros_time_override(ros_clock->get_clock_handle());
+      rcl_set_ros_time_override(ros_clock->get_clock_handle(), RCL_S_TO_NS(1));
+      return ros_clock;
+    }();
+  return clock;
+}
+
+void
+clock_now(benchmark::State & state, rclcpp::Clock & clock)
+{
+  for (auto _ : state) {
+    (void)_;
+    benchmark::DoNotOptimize(clock.now());
+  }
+}
+
+}  // namespace
+
+static void
+BM_now_system_time(benchmark::State & state)
+{
+  static rclcpp::Clock clock(RCL_SYSTEM_TIME);
+  clock_now(state, clock);
+}
+BENCHMARK(BM_now_system_time)->ThreadRange(1, 8);
+
+static void
+BM_now_steady_time(benchmark::State & state)
+{
+  static rclcpp::Clock clock(RCL_STEADY_TIME);
+  clock_now(state, clock);
+}
+BENCHMARK(BM_now_steady_time)->ThreadRange(1, 8);
+
+// ROS time overridden through the rcl clock, without a time source.
+static void
+BM_now_ros_time_rcl_override(benchmark::State & state)
+{
+  auto clock = get_ros_time_override_clock();
+  clock_now(state, *clock);
+}
+BENCHMARK(BM_now_ros_time_rcl_override)->ThreadRange(1, 8);
+
+// Simulated time set by the time source of a node.
+static void
+BM_now_sim_time(benchmark::State & state)
+{
+  auto clock = get_sim_time_clock();
+  if (!clock->ros_time_is_active()) {
+    state.SkipWithError("Simulated time is not active");
+    return;
+  }
+  clock_now(state, *clock);
+}
+BENCHMARK(BM_now_sim_time)->ThreadRange(1, 8);
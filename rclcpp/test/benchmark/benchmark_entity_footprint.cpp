@@ -0,0 +1,110 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <memory>
+#include <string>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "test_msgs/msg/empty.hpp"
+
+using performance_test_fixture::PerformanceTest;
+
+// Report of the memory taken by each publisher and subscription, by the heap allocations made
+// to create them and the size of the objects, with the default options and with the options
+// of slim entities, without QoS event handlers.
+class EntityFootprintPerformanceTest : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & state)
+  {
+    rclcpp::init(0, nullptr);
+    node = std::make_shared<rclcpp::Node>("node", "ns");
+    performance_test_fixture::PerformanceTest::SetUp(state);
+  }
+
+  void TearDown(benchmark::State & state)
+  {
+    performance_test_fixture::PerformanceTest::TearDown(state);
+    node.reset();
+    rclcpp::shutdown();
+  }
+
+protected:
+  template<typename CreateT>
+  void
+  measure_creation(benchmark::State & state, size_t object_size, CreateT create)
+  {
+    // Warmup and prime caches
+    auto outer_entity = create();
+    outer_entity.reset();
+
+    reset_heap_counters();
+    for (auto _ : state) {
+      (void)_;
+      auto entity = create();
+#ifndef __clang_analyzer__
+      benchmark::DoNotOptimize(entity);
+#endif
+      benchmark::ClobberMemory();
+
+      // Ensure destruction of the entity is not counted toward timing
+      state.PauseTiming();
+      entity.reset();
+      state.ResumeTiming();
+    }
+    state.counters["object_bytes"] = static_cast<double>(object_size);
+  }
+
+  rclcpp::Node::SharedPtr node;
+};
+
+BENCHMARK_F(EntityFootprintPerformanceTest, create_publisher)(benchmark::State & state)
+{
+  measure_creation(
+    state, sizeof(rclcpp::Publisher<test_msgs::msg::Empty>), [this]() {
+      return node->create_publisher<test_msgs::msg::Empty>("footprint_topic", 10);
+    });
+}
+
+BENCHMARK_F(EntityFootprintPerformanceTest, create_slim_publisher)(benchmark::State & state)
+{
+  rclcpp::PublisherOptions options;
+  options.use_default_callbacks = false;
+  measure_creation(
+    state, sizeof(rclcpp::Publisher<test_msgs::msg::Empty>), [this, &options]() {
+      return node->create_publisher<test_msgs::msg::Empty>("footprint_topic", 10, options);
+    });
+}
+
+BENCHMARK_F(EntityFootprintPerformanceTest, create_subscription)(benchmark::State & state)
+{
+  measure_creation(
+    state, sizeof(rclcpp::Subscription<test_msgs::msg::Empty>), [this]() {
+      return node->create_subscription<test_msgs::msg::Empty>(
+        "footprint_topic", 10, [](test_msgs::msg::Empty::ConstSharedPtr) {});
+    });
+}
+
+BENCHMARK_F(EntityFootprintPerformanceTest, create_slim_subscription)(benchmark::State & state)
+{
+  rclcpp::SubscriptionOptions options;
+  options.use_default_callbacks = false;
+  measure_creation(
+    state, sizeof(rclcpp::Subscription<test_msgs::msg::Empty>), [this, &options]() {
+      return node->create_subscription<test_msgs::msg::Empty>(
+        "footprint_topic", 10, [](test_msgs::msg::Empty::ConstSharedPtr) {}, options);
+    });
+}
@@ -140,6 +140,29 @@ public:
 };
 
 
+BENCHMARK_F(PerformanceTestExecutorSimple, single_thread_executor_spin_once_timer)(
+  benchmark::State & st)
+{
+  int callback_count = 0;
+  auto timer = node->create_wall_timer(0ms, [&callback_count]() {callback_count++;});
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  // The first iterations collect the entities and size the wait set.
+  executor.spin_once(100ms);
+  executor.spin_once(100ms);
+
+  callback_count = 0;
+  reset_heap_counters();
+
+  for (auto _ : st) {
+    (void)_;
+    executor.spin_once(100ms);
+  }
+  if (callback_count == 0) {
+    st.SkipWithError("Timer was not executed");
+  }
+}
+
 BENCHMARK_F(PerformanceTestExecutorSimple, single_thread_executor_add_node)(benchmark::State & st)
 {
   rclcpp::executors::SingleThreadedExecutor executor;
@@ -0,0 +1,243 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rclcpp/rclcpp.hpp"
+#include "test_msgs/msg/empty.hpp"
+
+using namespace std::chrono_literals;
+using performance_test_fixture::PerformanceTest;
+
+/// Kind of the entities whose number is scaled, alongside the measured subscription.
+enum class ScaledEntity : int64_t
+{
+  Nodes,
+  Subscriptions,
+  Timers,
+  CallbackGroups,
+};
+
+enum class ExecutorKind : int64_t
+{
+  SingleThreaded,
+  StaticSingleThreaded,
+  MultiThreaded,
+};
+
+constexpr size_t kBurstSize = 100;
+
+// Every scaled entity kind from 10 to 10k entities, for each executor, with 1 to 64 threads for
+// the multi threaded executor.
+static void
+entities_and_executors(benchmark::internal::Benchmark * b)
+{
+  for (auto kind : {
+      ScaledEntity::Nodes, ScaledEntity::Subscriptions, ScaledEntity::Timers,
+      ScaledEntity::CallbackGroups})
+  {
+    for (int64_t count : {10, 100, 1000, 10000}) {
+      b->Args({static_cast<int64_t>(kind), count,
+          static_cast<int64_t>(ExecutorKind::SingleThreaded), 1});
+      b->Args({static_cast<int64_t>(kind), count,
+          static_cast<int64_t>(ExecutorKind::StaticSingleThreaded), 1});
+      for (int64_t threads : {1, 4, 16, 64}) {
+        b->Args({static_cast<int64_t>(kind), count,
+            static_cast<int64_t>(ExecutorKind::MultiThreaded), threads});
+      }
+    }
+  }
+}
+
+/// Executor of a node with one measured subscription among a scaled number of idle entities.
+/**
+ * The idle entities are added to the wait sets but never ready, so the measurements expose the
+ * costs of the executors which grow with the number of entities.
+ * The executor spins in the background, as an application would, and the benchmarks publish to
+ * the measured subscription.
+ */
+class PerformanceTestExecutorScaling : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st)
+  {
+    rclcpp::init(0, nullptr);
+    // The parameter services and publisher would dominate the entities of the scaled nodes.
+    auto node_options = rclcpp::NodeOptions()
+      .start_parameter_services(false)
+      .start_parameter_event_publisher(false);
+    node = std::make_shared<rclcpp::Node>("measured_node", node_options);
+    publisher = node->create_publisher<test_msgs::msg::Empty>("measured", rclcpp::QoS(kBurstSize));
+    rclcpp::SubscriptionOptions subscription_options;
+    subscription_options.callback_group =
+      node->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+    subscription = node->create_subscription<test_msgs::msg::Empty>(
+      "measured", rclcpp::QoS(kBurstSize),
+      [this](test_msgs::msg::Empty::ConstSharedPtr) {
+        // Stored before the count, which the benchmark thread waits for.
+        int64_t unset = 0;
+        first_callback_time_ns.compare_exchange_strong(unset, now_ns());
+        callback_count.fetch_add(1);
+      },
+      subscription_options);
+
+    const auto count = static_cast<size_t>(st.range(1));
+    switch (static_cast<ScaledEntity>(st.range(0))) {
+      case ScaledEntity::Nodes:
+        for (size_t i = 0; i < count; ++i) {
+          idle_nodes.push_back(
+            std::make_shared<rclcpp::Node>("idle_node_" + std::to_string(i), node_options));
+        }
+        break;
+      case ScaledEntity::Subscriptions:
+        for (size_t i = 0; i < count; ++i) {
+          idle_subscriptions.push_back(
+            node->create_subscription<test_msgs::msg::Empty>(
+              "idle", rclcpp::QoS(1), [](test_msgs::msg::Empty::ConstSharedPtr) {}));
+        }
+        break;
+      case ScaledEntity::Timers:
+        for (size_t i = 0; i < count; ++i) {
+          idle_timers.push_back(node->create_wall_timer(1h, []() {}));
+        }
+        break;
+      case ScaledEntity::CallbackGroups:
+        for (size_t i = 0; i < count; ++i) {
+          idle_callback_groups.push_back(
+            node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive));
+        }
+        break;
+    }
+
+    switch (static_cast<ExecutorKind>(st.range(2))) {
+      case ExecutorKind::SingleThreaded:
+        executor = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+        break;
+      case ExecutorKind::StaticSingleThreaded:
+        executor = std::make_shared<rclcpp::executors::StaticSingleThreadedExecutor>();
+        break;
+      case ExecutorKind::MultiThreaded:
+        executor = std::make_shared<rclcpp::executors::MultiThreadedExecutor>(
+          rclcpp::ExecutorOptions(), static_cast<size_t>(st.range(3)));
+        break;
+    }
+    executor->add_node(node);
+    for (const auto & idle_node : idle_nodes) {
+      executor->add_node(idle_node);
+    }
+    spin_thread = std::thread([this]() {executor->spin();});
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st)
+  {
+    PerformanceTest::TearDown(st);
+    executor->cancel();
+    spin_thread.join();
+    executor.reset();
+    idle_callback_groups.clear();
+    idle_timers.clear();
+    idle_subscriptions.clear();
+    idle_nodes.clear();
+    subscription.reset();
+    publisher.reset();
+    node.reset();
+    rclcpp::shutdown();
+  }
+
+  /// Publish messages and wait until their callbacks were executed.
+  /**
+   * \return the time from the publication to the start of the first callback.
+   */
+  std::chrono::nanoseconds publish_and_wait(size_t number_of_messages)
+  {
+    callback_count = 0;
+    first_callback_time_ns = 0;
+    const int64_t publish_time_ns = now_ns();
+    for (size_t i = 0; i < number_of_messages; ++i) {
+      publisher->publish(test_msgs::msg::Empty());
+    }
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (callback_count.load() < number_of_messages) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        return std::chrono::nanoseconds::max();
+      }
+      std::this_thread::yield();
+    }
+    return std::chrono::nanoseconds(first_callback_time_ns.load() - publish_time_ns);
+  }
+
+  static int64_t now_ns()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  rclcpp::Node::SharedPtr node;
+  rclcpp::Publisher<test_msgs::msg::Empty>::SharedPtr publisher;
+  rclcpp::Subscription<test_msgs::msg::Empty>::SharedPtr subscription;
+  std::vector<rclcpp::Node::SharedPtr> idle_nodes;
+  std::vector<rclcpp::Subscription<test_msgs::msg::Empty>::SharedPtr> idle_subscriptions;
+  std::vector<rclcpp::TimerBase::SharedPtr> idle_timers;
+  std::vector<rclcpp::CallbackGroup::SharedPtr> idle_callback_groups;
+  rclcpp::Executor::SharedPtr executor;
+  std::thread spin_thread;
+  std::atomic<size_t> callback_count{0};
+  std::atomic<int64_t> first_callback_time_ns{0};
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestExecutorScaling, dispatch_latency)(benchmark::State & st)
+{
+  // The iteration time is the time of a wait and dispatch cycle for one ready entity.
+  double total_latency_us = 0.0;
+  reset_heap_counters();
+  for (auto _ : st) {
+    (void)_;
+    const auto latency = publish_and_wait(1u);
+    if (latency == std::chrono::nanoseconds::max()) {
+      st.SkipWithError("The message was not received");
+      break;
+    }
+    total_latency_us += std::chrono::duration<double, std::micro>(latency).count();
+  }
+  st.counters["dispatch_latency_us"] =
+    benchmark::Counter(total_latency_us, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_REGISTER_F(PerformanceTestExecutorScaling, dispatch_latency)
+->Apply(entities_and_executors)->UseRealTime();
+
+BENCHMARK_DEFINE_F(PerformanceTestExecutorScaling, callbacks_per_second)(benchmark::State & st)
+{
+  reset_heap_counters();
+  for (auto _ : st) {
+    (void)_;
+    if (publish_and_wait(kBurstSize) == std::chrono::nanoseconds::max()) {
+      st.SkipWithError("The messages were not received");
+      break;
+    }
+  }
+  st.counters["callbacks"] = benchmark::Counter(
+    static_cast<double>(st.iterations() * kBurstSize), benchmark::Counter::kIsRate);
+}
+BENCHMARK_REGISTER_F(PerformanceTestExecutorScaling, callbacks_per_second)
+->Apply(entities_and_executors)->UseRealTime();
@@ -0,0 +1,112 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "test_msgs/msg/strings.hpp"
+
+using performance_test_fixture::PerformanceTest;
+
+constexpr size_t kPayloadSize = 1024 * 1024;
+constexpr char kTopicType[] = "test_msgs/msg/Strings";
+
+class PerformanceTestGenericRelay : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st)
+  {
+    rclcpp::init(0, nullptr);
+    node = std::make_shared<rclcpp::Node>(
+      "relay_node", rclcpp::NodeOptions().use_intra_process_comms(true));
+    publisher = node->create_generic_publisher("input", kTopicType, rclcpp::QoS(1));
+    relay_publisher = node->create_generic_publisher("output", kTopicType, rclcpp::QoS(1));
+    subscription = node->create_generic_subscription(
+      "output", kTopicType, rclcpp::QoS(1),
+      [this](std::shared_ptr<rclcpp::SerializedMessage>) {this->callback_count++;});
+
+    test_msgs::msg::Strings msg;
+    msg.string_value = std::string(kPayloadSize, 'a');
+    rclcpp::Serialization<test_msgs::msg::Strings>().serialize_message(&msg, &serialized_msg);
+    callback_count = 0;
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st)
+  {
+    PerformanceTest::TearDown(st);
+    relay_subscription.reset();
+    subscription.reset();
+    relay_publisher.reset();
+    publisher.reset();
+    node.reset();
+    rclcpp::shutdown();
+  }
+
+  // Relay each message from the input topic to the output topic, measuring the throughput.
+  template<typename RelayT>
+  void relay(benchmark::State & st, RelayT && relay_message)
+  {
+    relay_subscription = node->create_generic_subscription(
+      "input", kTopicType, rclcpp::QoS(1), std::forward<RelayT>(relay_message));
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(node);
+
+    callback_count = 0;
+    reset_heap_counters();
+
+    for (auto _ : st) {
+      (void)_;
+      st.PauseTiming();
+      publisher->publish(std::make_unique<rclcpp::SerializedMessage>(serialized_msg));
+      st.ResumeTiming();
+
+      const size_t expected_count = callback_count + 1;
+      while (callback_count < expected_count) {
+        executor.spin_some();
+      }
+    }
+    st.SetBytesProcessed(st.iterations() * serialized_msg.size());
+  }
+
+  rclcpp::Node::SharedPtr node;
+  rclcpp::GenericPublisher::SharedPtr publisher;
+  rclcpp::GenericPublisher::SharedPtr relay_publisher;
+  rclcpp::GenericSubscription::SharedPtr relay_subscription;
+  rclcpp::GenericSubscription::SharedPtr subscription;
+  rclcpp::SerializedMessage serialized_msg;
+  size_t callback_count;
+};
+
+BENCHMARK_F(PerformanceTestGenericRelay, relay_copy)(benchmark::State & st)
+{
+  relay(
+    st, [this](std::shared_ptr<rclcpp::SerializedMessage> message) {
+      relay_publisher->publish(*message);
+    });
+}
+
+BENCHMARK_F(PerformanceTestGenericRelay, relay_move)(benchmark::State & st)
+{
+  relay(
+    st, [this](std::shared_ptr<rclcpp::SerializedMessage> message) {
+      relay_publisher->publish(std::move(*message));
+    });
+}
@@ -12,12 +12,67 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "performance_test_fixture/performance_test_fixture.hpp"
 
 #include "rclcpp/rclcpp.hpp"
+#include "test_msgs/msg/empty.hpp"
 
 using performance_test_fixture::PerformanceTest;
 
+constexpr unsigned int kNumberOfNodes = 10;
+constexpr unsigned int kNumberOfEntities = 1000;
+
+/// Nodes with kNumberOfEntities publishers and subscriptions in total.
+struct LargeProcess
+{
+  explicit LargeProcess(rclcpp::Context::SharedPtr context)
+  {
+    const unsigned int entities_per_node = kNumberOfEntities / kNumberOfNodes / 2u;
+    for (unsigned int i = 0u; i < kNumberOfNodes; i++) {
+      auto node = std::make_shared<rclcpp::Node>(
+        "my_node_" + std::to_string(i), "", rclcpp::NodeOptions().context(context));
+      for (unsigned int j = 0u; j < entities_per_node; j++) {
+        const std::string topic = "empty_" + std::to_string(j);
+        publishers.push_back(node->create_publisher<test_msgs::msg::Empty>(topic, 10));
+        subscriptions.push_back(
+          node->create_subscription<test_msgs::msg::Empty>(
+            topic, 10, [](test_msgs::msg::Empty::ConstSharedPtr) {}));
+      }
+      nodes.push_back(node);
+    }
+  }
+
+  std::vector<rclcpp::Node::SharedPtr> nodes;
+  std::vector<rclcpp::PublisherBase::SharedPtr> publishers;
+  std::vector<rclcpp::SubscriptionBase::SharedPtr> subscriptions;
+};
+
+class PerformanceTestLargeProcess : public PerformanceTest
+{
+protected:
+  /// Measure the shutdown of a context followed by the destruction of a large process.
+  void shutdown_large_process(benchmark::State & state, const rclcpp::InitOptions & init_options)
+  {
+    reset_heap_counters();
+    for (auto _ : state) {
+      (void)_;
+      state.PauseTiming();
+      auto context = std::make_shared<rclcpp::Context>();
+      context->init(0, nullptr, init_options);
+      auto process = std::make_unique<LargeProcess>(context);
+      state.ResumeTiming();
+
+      context->shutdown("benchmark");
+      process.reset();
+      benchmark::ClobberMemory();
+    }
+  }
+};
+
 BENCHMARK_F(PerformanceTest, rclcpp_init)(benchmark::State & state)
 {
   // Warmup and prime caches
@@ -53,3 +108,14 @@ BENCHMARK_F(PerformanceTest, rclcpp_shutdown)(benchmark::State & state)
     benchmark::ClobberMemory();
   }
 }
+
+BENCHMARK_F(PerformanceTestLargeProcess, shutdown_1000_entities)(benchmark::State & state)
+{
+  shutdown_large_process(state, rclcpp::InitOptions());
+}
+
+BENCHMARK_F(PerformanceTestLargeProcess, shutdown_1000_entities_fast_exit)(
+  benchmark::State & state)
+{
+  shutdown_large_process(state, rclcpp::InitOptions().fast_exit(true));
+}
@@ -0,0 +1,265 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/type_adapter.hpp"
+#include "test_msgs/msg/strings.hpp"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace rclcpp
+{
+template<>
+struct TypeAdapter<std::string, test_msgs::msg::Strings>
+{
+  using is_specialized = std::true_type;
+  using custom_type = std::string;
+  using ros_message_type = test_msgs::msg::Strings;
+
+  static void
+  convert_to_ros_message(const custom_type & source, ros_message_type & destination)
+  {
+    destination.string_value = source;
+  }
+
+  static void
+  convert_to_custom(const ros_message_type & source, custom_type & destination)
+  {
+    destination = source.string_value;
+  }
+};
+}  // namespace rclcpp
+
+using StringTypeAdapter = rclcpp::TypeAdapter<std::string, test_msgs::msg::Strings>;
+
+// The message sizes, from 1 KB to 8 MB, and the numbers of subscriptions.
+static void
+message_sizes_and_subscriptions(benchmark::internal::Benchmark * b)
+{
+  for (int64_t size : {1024, 16 * 1024, 256 * 1024, 1024 * 1024, 8 * 1024 * 1024}) {
+    for (int64_t subscriptions : {1, 4, 16}) {
+      b->Args({size, subscriptions});
+    }
+  }
+}
+
+// Every intra process buffer type, for a small and a large message and 1 and 4 subscriptions.
+static void
+buffer_types(benchmark::internal::Benchmark * b)
+{
+  for (int64_t size : {1024, 1024 * 1024}) {
+    for (int64_t subscriptions : {1, 4}) {
+      for (auto buffer_type : {
+          rclcpp::IntraProcessBufferType::SharedPtr,
+          rclcpp::IntraProcessBufferType::UniquePtr,
+          rclcpp::IntraProcessBufferType::LockFreeSharedPtr,
+          rclcpp::IntraProcessBufferType::LockFreeUniquePtr})
+      {
+        b->Args({size, subscriptions, static_cast<int64_t>(buffer_type)});
+      }
+    }
+  }
+}
+
+/// Latency from a publication to the callbacks of all the subscriptions, within one process.
+/**
+ * Each iteration publishes one message and spins until every subscription got it, the message
+ * is created with the timing paused, so the iteration time is the latency of the delivery and
+ * the heap allocations reported by the fixture are the ones of the delivery, including the
+ * copies of the message.
+ * The bytes processed are the bytes delivered, i.e. the throughput of the subscriptions.
+ */
+class PerformanceTestIntraProcess : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st)
+  {
+    rclcpp::init(0, nullptr);
+    node = std::make_shared<rclcpp::Node>(
+      "intra_process_node", rclcpp::NodeOptions().use_intra_process_comms(true));
+    message_size = static_cast<size_t>(st.range(0));
+    number_of_subscriptions = static_cast<size_t>(st.range(1));
+    callback_count = 0;
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st)
+  {
+    PerformanceTest::TearDown(st);
+    subscriptions.clear();
+    node.reset();
+    rclcpp::shutdown();
+  }
+
+  /// Create the subscriptions, whose callback takes the message as MessageT.
+  template<typename SubscribedT, typename MessageT>
+  void create_subscriptions(const rclcpp::SubscriptionOptions & options = {})
+  {
+    for (size_t i = 0; i < number_of_subscriptions; ++i) {
+      subscriptions.push_back(
+        node->create_subscription<SubscribedT>(
+          "topic", rclcpp::QoS(1), [this](MessageT) {this->callback_count++;}, options));
+    }
+  }
+
+  /// Measure the delivery of the messages made by make_message and published by publish.
+  template<typename MakeMessageT, typename PublishT>
+  void deliver(benchmark::State & st, MakeMessageT && make_message, PublishT && publish)
+  {
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(node);
+
+    callback_count = 0;
+    reset_heap_counters();
+
+    for (auto _ : st) {
+      (void)_;
+      st.PauseTiming();
+      auto message = make_message();
+      st.ResumeTiming();
+
+      const size_t expected_count = callback_count + number_of_subscriptions;
+      publish(std::move(message));
+      while (callback_count < expected_count) {
+        executor.spin_some();
+      }
+    }
+    st.SetBytesProcessed(
+      static_cast<int64_t>(st.iterations() * message_size * number_of_subscriptions));
+  }
+
+  /// Make a ROS message of the benchmarked size.
+  std::unique_ptr<test_msgs::msg::Strings> make_ros_message() const
+  {
+    auto message = std::make_unique<test_msgs::msg::Strings>();
+    message->string_value = std::string(message_size, 'a');
+    return message;
+  }
+
+  rclcpp::Node::SharedPtr node;
+  std::vector<rclcpp::SubscriptionBase::SharedPtr> subscriptions;
+  size_t message_size;
+  size_t number_of_subscriptions;
+  size_t callback_count;
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestIntraProcess, unique_ptr_to_shared_ptr)(benchmark::State & st)
+{
+  // The message is shared by all the subscriptions, without copies.
+  create_subscriptions<test_msgs::msg::Strings, test_msgs::msg::Strings::ConstSharedPtr>();
+  auto publisher = node->create_publisher<test_msgs::msg::Strings>("topic", rclcpp::QoS(1));
+  deliver(
+    st, [this]() {return make_ros_message();},
+    [&publisher](std::unique_ptr<test_msgs::msg::Strings> message) {
+      publisher->publish(std::move(message));
+    });
+}
+BENCHMARK_REGISTER_F(PerformanceTestIntraProcess, unique_ptr_to_shared_ptr)
+->Apply(message_sizes_and_subscriptions);
+
+BENCHMARK_DEFINE_F(PerformanceTestIntraProcess, unique_ptr_to_unique_ptr)(benchmark::State & st)
+{
+  // The message is moved to one of the subscriptions and copied for each of the others.
+  create_subscriptions<test_msgs::msg::Strings, test_msgs::msg::Strings::UniquePtr>();
+  auto publisher = node->create_publisher<test_msgs::msg::Strings>("topic", rclcpp::QoS(1));
+  deliver(
+    st, [this]() {return make_ros_message();},
+    [&publisher](std::unique_ptr<test_msgs::msg::Strings> message) {
+      publisher->publish(std::move(message));
+    });
+}
+BENCHMARK_REGISTER_F(PerformanceTestIntraProcess, unique_ptr_to_unique_ptr)
+->Apply(message_sizes_and_subscriptions);
+
+BENCHMARK_DEFINE_F(PerformanceTestIntraProcess, shared_ptr_to_shared_ptr)(benchmark::State & st)
+{
+  // The message stays shared with the publisher, without copies.
+  create_subscriptions<test_msgs::msg::Strings, test_msgs::msg::Strings::ConstSharedPtr>();
+  auto publisher = node->create_publisher<test_msgs::msg::Strings>("topic", rclcpp::QoS(1));
+  deliver(
+    st, [this]() {return std::shared_ptr<const test_msgs::msg::Strings>(make_ros_message());},
+    [&publisher](std::shared_ptr<const test_msgs::msg::Strings> message) {
+      publisher->publish(std::move(message));
+    });
+}
+BENCHMARK_REGISTER_F(PerformanceTestIntraProcess, shared_ptr_to_shared_ptr)
+->Apply(message_sizes_and_subscriptions);
+
+BENCHMARK_DEFINE_F(PerformanceTestIntraProcess, const_reference_to_shared_ptr)(
+  benchmark::State & st)
+{
+  // The message is copied once by the publisher, then shared.
+  create_subscriptions<test_msgs::msg::Strings, test_msgs::msg::Strings::ConstSharedPtr>();
+  auto publisher = node->create_publisher<test_msgs::msg::Strings>("topic", rclcpp::QoS(1));
+  deliver(
+    st, [this]() {return make_ros_message();},
+    [&publisher](std::unique_ptr<test_msgs::msg::Strings> message) {
+      publisher->publish(*message);
+    });
+}
+BENCHMARK_REGISTER_F(PerformanceTestIntraProcess, const_reference_to_shared_ptr)
+->Apply(message_sizes_and_subscriptions);
+
+BENCHMARK_DEFINE_F(PerformanceTestIntraProcess, buffer_type)(benchmark::State & st)
+{
+  rclcpp::SubscriptionOptions options;
+  options.intra_process_buffer_type = static_cast<rclcpp::IntraProcessBufferType>(st.range(2));
+  create_subscriptions<test_msgs::msg::Strings, test_msgs::msg::Strings::ConstSharedPtr>(options);
+  auto publisher = node->create_publisher<test_msgs::msg::Strings>("topic", rclcpp::QoS(1));
+  deliver(
+    st, [this]() {return make_ros_message();},
+    [&publisher](std::unique_ptr<test_msgs::msg::Strings> message) {
+      publisher->publish(std::move(message));
+    });
+}
+BENCHMARK_REGISTER_F(PerformanceTestIntraProcess, buffer_type)->Apply(buffer_types);
+
+BENCHMARK_DEFINE_F(PerformanceTestIntraProcess, type_adapter_without_conversion)(
+  benchmark::State & st)
+{
+  // The custom type is delivered as is to the subscriptions of the same adapted type.
+  create_subscriptions<StringTypeAdapter, std::shared_ptr<const std::string>>();
+  auto publisher = node->create_publisher<StringTypeAdapter>("topic", rclcpp::QoS(1));
+  deliver(
+    st, [this]() {return std::make_unique<std::string>(message_size, 'a');},
+    [&publisher](std::unique_ptr<std::string> message) {
+      publisher->publish(std::move(message));
+    });
+}
+BENCHMARK_REGISTER_F(PerformanceTestIntraProcess, type_adapter_without_conversion)
+->Apply(message_sizes_and_subscriptions);
+
+BENCHMARK_DEFINE_F(PerformanceTestIntraProcess, type_adapter_with_conversion)(
+  benchmark::State & st)
+{
+  // The custom type is converted to the ROS message of the subscriptions.
+  create_subscriptions<test_msgs::msg::Strings, test_msgs::msg::Strings::ConstSharedPtr>();
+  auto publisher = node->create_publisher<StringTypeAdapter>("topic", rclcpp::QoS(1));
+  deliver(
+    st, [this]() {return std::make_unique<std::string>(message_size, 'a');},
+    [&publisher](std::unique_ptr<std::string> message) {
+      publisher->publish(std::move(message));
+    });
+}
+BENCHMARK_REGISTER_F(PerformanceTestIntraProcess, type_adapter_with_conversion)
+->Apply(message_sizes_and_subscriptions);
@@ -0,0 +1,49 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "benchmark/benchmark.h"
+
+#include "rclcpp/logger.hpp"
+#include "rclcpp/logging.hpp"
+
+// The debug severity is disabled by default, so nothing is output by these benchmarks.
+
+static void
+BM_disabled_debug(benchmark::State & state)
+{
+  const rclcpp::Logger logger = rclcpp::get_logger("benchmark_logging.a.deep.child.logger");
+  for (auto _ : state) {
+    RCLCPP_DEBUG(logger, "disabled message %d", 42);
+  }
+}
+BENCHMARK(BM_disabled_debug)->ThreadRange(1, 8);
+
+static void
+BM_disabled_debug_stream(benchmark::State & state)
+{
+  const rclcpp::Logger logger = rclcpp::get_logger("benchmark_logging.a.deep.child.logger");
+  for (auto _ : state) {
+    RCLCPP_DEBUG_STREAM(logger, "disabled message " << 42);
+  }
+}
+BENCHMARK(BM_disabled_debug_stream)->ThreadRange(1, 8);
+
+static void
+BM_disabled_debug_rcutils(benchmark::State & state)
+{
+  for (auto _ : state) {
+    RCUTILS_LOG_DEBUG_NAMED("benchmark_logging.a.deep.child.logger", "disabled message %d", 42);
+  }
+}
+BENCHMARK(BM_disabled_debug_rcutils)->ThreadRange(1, 8);
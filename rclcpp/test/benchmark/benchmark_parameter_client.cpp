@@ -12,9 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <string>
+#include <thread>
 
 #include "benchmark/benchmark.h"
 
@@ -335,3 +337,122 @@ BENCHMARK_F(ParameterClientTest, list_parameters_miss)(benchmark::State & state)
     }
   }
 }
+
+class MultiNodeParameterClientTest : public benchmark::Fixture
+{
+public:
+  static constexpr size_t kRemoteNodeCount = 20u;
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+#endif
+  void SetUp(benchmark::State & state)
+  {
+    remote_context = std::make_shared<rclcpp::Context>();
+    remote_context->init(0, nullptr, rclcpp::InitOptions().auto_initialize_logging(false));
+
+    rclcpp::ExecutorOptions exec_options;
+    exec_options.context = remote_context;
+    remote_executor = std::make_shared<rclcpp::executors::MultiThreadedExecutor>(exec_options);
+
+    for (size_t i = 0; i < kRemoteNodeCount; ++i) {
+      auto remote_node = std::make_shared<rclcpp::Node>(
+        "my_remote_node_" + std::to_string(i), rclcpp::NodeOptions().context(remote_context));
+      remote_node->declare_parameter("my_param", 0);
+      remote_executor->add_node(remote_node);
+      remote_node_names.push_back(remote_node->get_fully_qualified_name());
+      remote_nodes.push_back(remote_node);
+    }
+    remote_thread = std::thread(
+      &rclcpp::executors::MultiThreadedExecutor::spin, remote_executor);
+
+    rclcpp::init(0, nullptr);
+    // The synchronous clients spin their node, it cannot be added to the executor.
+    node = std::make_shared<rclcpp::Node>("my_node");
+    multi_node = std::make_shared<rclcpp::Node>("my_multi_node");
+    executor = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+    executor->add_node(multi_node);
+
+    multi_node_client = std::make_shared<rclcpp::AsyncMultiNodeParametersClient>(
+      multi_node, remote_node_names);
+    if (!multi_node_client->wait_for_service(std::chrono::seconds(10))) {
+      state.SkipWithError("Clients failed to become ready");
+    }
+    for (const auto & remote_node_name : remote_node_names) {
+      sync_clients.push_back(
+        std::make_shared<rclcpp::SyncParametersClient>(node, remote_node_name));
+    }
+  }
+
+  void TearDown(benchmark::State &)
+  {
+    sync_clients.clear();
+    multi_node_client.reset();
+    executor.reset();
+    multi_node.reset();
+    node.reset();
+    rclcpp::shutdown();
+
+    remote_executor->cancel();
+    remote_context->shutdown("Test is complete");
+    remote_thread.join();
+    remote_nodes.clear();
+    remote_node_names.clear();
+    remote_executor.reset();
+    remote_context.reset();
+  }
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+protected:
+  rclcpp::Context::SharedPtr remote_context;
+  rclcpp::executors::MultiThreadedExecutor::SharedPtr remote_executor;
+  std::vector<rclcpp::Node::SharedPtr> remote_nodes;
+  std::vector<std::string> remote_node_names;
+  std::thread remote_thread;
+
+  rclcpp::Node::SharedPtr node;
+  rclcpp::Node::SharedPtr multi_node;
+  rclcpp::executors::SingleThreadedExecutor::SharedPtr executor;
+  rclcpp::AsyncMultiNodeParametersClient::SharedPtr multi_node_client;
+  std::vector<rclcpp::SyncParametersClient::SharedPtr> sync_clients;
+};
+
+BENCHMARK_F(MultiNodeParameterClientTest, set_parameters_sequential)(benchmark::State & state)
+{
+  int64_t value = 0;
+  for (auto _ : state) {
+    (void)_;
+    const std::vector<rclcpp::Parameter> parameters{rclcpp::Parameter("my_param", ++value)};
+    for (const auto & sync_client : sync_clients) {
+      const auto results = sync_client->set_parameters(parameters);
+      if (!std::all_of(results.begin(), results.end(), result_is_successful)) {
+        state.SkipWithError("Failed to set one or more parameters");
+        break;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kRemoteNodeCount);
+}
+
+BENCHMARK_F(MultiNodeParameterClientTest, set_parameters_multi_node)(benchmark::State & state)
+{
+  int64_t value = 0;
+  for (auto _ : state) {
+    (void)_;
+    auto future = multi_node_client->set_parameters({rclcpp::Parameter("my_param", ++value)});
+    if (executor->spin_until_future_complete(future) != rclcpp::FutureReturnCode::SUCCESS) {
+      state.SkipWithError("Failed to set the parameters");
+      break;
+    }
+    for (const auto & pair : future.get()) {
+      if (!std::all_of(pair.second.begin(), pair.second.end(), result_is_successful)) {
+        state.SkipWithError("Failed to set one or more parameters");
+        break;
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kRemoteNodeCount);
+}
@@ -0,0 +1,88 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+
+#include "rclcpp/duration.hpp"
+#include "rclcpp/time.hpp"
+
+// Arithmetic and comparisons of rclcpp::Time and rclcpp::Duration, e.g. to compute the next
+// deadline of a schedule or to compare the stamps of messages.
+
+static void
+BM_time_add_duration(benchmark::State & state)
+{
+  rclcpp::Time time(int64_t(1000), RCL_STEADY_TIME);
+  const rclcpp::Duration period = rclcpp::Duration::from_nanoseconds(10);
+  for (auto _ : state) {
+    (void)_;
+    time += period;
+    benchmark::DoNotOptimize(time);
+  }
+}
+BENCHMARK(BM_time_add_duration);
+
+static void
+BM_time_saturating_add_duration(benchmark::State & state)
+{
+  rclcpp::Time time(int64_t(1000), RCL_STEADY_TIME);
+  const rclcpp::Duration period = rclcpp::Duration::from_nanoseconds(10);
+  for (auto _ : state) {
+    (void)_;
+    time = time.saturating_add(period);
+    benchmark::DoNotOptimize(time);
+  }
+}
+BENCHMARK(BM_time_saturating_add_duration);
+
+static void
+BM_time_difference(benchmark::State & state)
+{
+  const rclcpp::Time start(int64_t(1000), RCL_STEADY_TIME);
+  rclcpp::Time end(int64_t(5000), RCL_STEADY_TIME);
+  for (auto _ : state) {
+    (void)_;
+    benchmark::DoNotOptimize(end);
+    benchmark::DoNotOptimize(end - start);
+  }
+}
+BENCHMARK(BM_time_difference);
+
+static void
+BM_time_compare(benchmark::State & state)
+{
+  const rclcpp::Time stamp(int64_t(1000), RCL_ROS_TIME);
+  rclcpp::Time deadline(int64_t(5000), RCL_ROS_TIME);
+  for (auto _ : state) {
+    (void)_;
+    benchmark::DoNotOptimize(deadline);
+    benchmark::DoNotOptimize(stamp < deadline);
+  }
+}
+BENCHMARK(BM_time_compare);
+
+static void
+BM_duration_add(benchmark::State & state)
+{
+  rclcpp::Duration total = rclcpp::Duration::from_nanoseconds(0);
+  const rclcpp::Duration step = rclcpp::Duration::from_nanoseconds(10);
+  for (auto _ : state) {
+    (void)_;
+    total = total + step;
+    benchmark::DoNotOptimize(total);
+  }
+}
+BENCHMARK(BM_duration_add);
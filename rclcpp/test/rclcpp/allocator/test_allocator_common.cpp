@@ -14,7 +14,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstring>
 #include <memory>
+#include <memory_resource>
 
 #include "rclcpp/allocator/allocator_common.hpp"
 
@@ -71,3 +73,31 @@ TEST(TestAllocatorCommon, get_void_rcl_allocator) {
   EXPECT_NE(nullptr, rcl_allocator.zero_allocate);
   // Not testing state as that may or may not be null depending on platform
 }
+
+TEST(TestAllocatorCommon, get_polymorphic_rcl_allocator) {
+  std::pmr::monotonic_buffer_resource upstream;
+  std::pmr::unsynchronized_pool_resource resource(&upstream);
+  std::pmr::polymorphic_allocator<char> allocator(&resource);
+  auto rcl_allocator = rclcpp::allocator::get_rcl_allocator<char>(allocator);
+  EXPECT_EQ(&resource, rcl_allocator.state);
+
+  auto allocated_mem = static_cast<char *>(rcl_allocator.allocate(4u, rcl_allocator.state));
+  ASSERT_TRUE(nullptr != allocated_mem);
+  std::memcpy(allocated_mem, "abc", 4u);
+
+  // Reallocation keeps the content.
+  auto reallocated_mem =
+    static_cast<char *>(rcl_allocator.reallocate(allocated_mem, 64u, rcl_allocator.state));
+  ASSERT_TRUE(nullptr != reallocated_mem);
+  EXPECT_STREQ("abc", reallocated_mem);
+  rcl_allocator.deallocate(reallocated_mem, rcl_allocator.state);
+
+  auto zero_allocated_mem =
+    static_cast<char *>(rcl_allocator.zero_allocate(4u, 2u, rcl_allocator.state));
+  ASSERT_TRUE(nullptr != zero_allocated_mem);
+  for (size_t i = 0; i < 8u; ++i) {
+    EXPECT_EQ(0, zero_allocated_mem[i]);
+  }
+  rcl_allocator.deallocate(zero_allocated_mem, rcl_allocator.state);
+  rcl_allocator.deallocate(nullptr, rcl_allocator.state);
+}
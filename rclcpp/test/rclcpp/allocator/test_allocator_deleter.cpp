@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <memory_resource>
 
 #include "rclcpp/allocator/allocator_deleter.hpp"
 
@@ -46,6 +47,18 @@ TEST(TestAllocatorDeleter, delete) {
   EXPECT_NO_THROW(deleter(some_mem));
 }
 
+TEST(TestAllocatorDeleter, delete_polymorphic) {
+  std::pmr::monotonic_buffer_resource resource;
+  std::pmr::polymorphic_allocator<void *> allocator(&resource);
+  std::pmr::polymorphic_allocator<int> int_allocator(allocator);
+  int * some_mem = int_allocator.allocate(1u);
+  ASSERT_TRUE(nullptr != some_mem);
+
+  // The deleter rebinds the allocator to the type of the deleted object.
+  rclcpp::allocator::AllocatorDeleter<std::pmr::polymorphic_allocator<void *>> deleter(&allocator);
+  EXPECT_NO_THROW(deleter(some_mem));
+}
+
 TEST(TestAllocatorDeleter, set_allocator_for_deleter_AllocatorDeleter) {
   using AllocatorT = std::allocator<int>;
   using DeleterT = rclcpp::allocator::AllocatorDeleter<AllocatorT>;
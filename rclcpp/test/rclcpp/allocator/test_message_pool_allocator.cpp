@@ -0,0 +1,116 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "rclcpp/allocator/allocator_common.hpp"
+#include "rclcpp/allocator/allocator_deleter.hpp"
+#include "rclcpp/allocator/message_pool_allocator.hpp"
+
+struct Message
+{
+  double values[8];
+};
+
+TEST(TestMessagePoolAllocator, single_objects_are_recycled) {
+  rclcpp::allocator::MessagePoolAllocator<Message> allocator;
+
+  Message * first = allocator.allocate(1u);
+  ASSERT_TRUE(nullptr != first);
+  EXPECT_EQ(0u, allocator.get_pool()->pooled_blocks(sizeof(Message)));
+  allocator.deallocate(first, 1u);
+  EXPECT_EQ(1u, allocator.get_pool()->pooled_blocks(sizeof(Message)));
+
+  Message * second = allocator.allocate(1u);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(0u, allocator.get_pool()->pooled_blocks(sizeof(Message)));
+  allocator.deallocate(second, 1u);
+}
+
+TEST(TestMessagePoolAllocator, copies_and_rebinds_share_the_pool) {
+  rclcpp::allocator::MessagePoolAllocator<void> allocator;
+  using MessageAllocTraits = rclcpp::allocator::AllocRebind<Message, decltype(allocator)>;
+  typename MessageAllocTraits::allocator_type message_allocator(allocator);
+
+  auto copy = message_allocator;
+  EXPECT_TRUE(copy == message_allocator);
+  EXPECT_TRUE(allocator == message_allocator);
+  EXPECT_FALSE(rclcpp::allocator::MessagePoolAllocator<void>() == allocator);
+
+  Message * message = MessageAllocTraits::allocate(message_allocator, 1u);
+  MessageAllocTraits::deallocate(copy, message, 1u);
+  EXPECT_EQ(1u, allocator.get_pool()->pooled_blocks(sizeof(Message)));
+  EXPECT_EQ(message, MessageAllocTraits::allocate(message_allocator, 1u));
+  MessageAllocTraits::deallocate(message_allocator, message, 1u);
+}
+
+TEST(TestMessagePoolAllocator, arrays_bypass_the_pool) {
+  rclcpp::allocator::MessagePoolAllocator<Message> allocator;
+  Message * messages = allocator.allocate(4u);
+  ASSERT_TRUE(nullptr != messages);
+  allocator.deallocate(messages, 4u);
+  EXPECT_EQ(0u, allocator.get_pool()->pooled_blocks(sizeof(Message)));
+  EXPECT_EQ(0u, allocator.get_pool()->pooled_blocks(4u * sizeof(Message)));
+}
+
+TEST(TestMessagePoolAllocator, rcl_allocator_bypasses_the_pool) {
+  rclcpp::allocator::MessagePoolAllocator<Message> allocator;
+  rcl_allocator_t rcl_allocator = rclcpp::allocator::get_rcl_allocator<Message>(allocator);
+
+  void * block = rcl_allocator.allocate(4u * sizeof(Message), rcl_allocator.state);
+  ASSERT_TRUE(nullptr != block);
+  block = rcl_allocator.reallocate(block, 8u * sizeof(Message), rcl_allocator.state);
+  ASSERT_TRUE(nullptr != block);
+  rcl_allocator.deallocate(block, rcl_allocator.state);
+  EXPECT_EQ(0u, allocator.get_pool()->pooled_blocks(1u));
+  EXPECT_EQ(0u, allocator.get_pool()->pooled_blocks(sizeof(Message)));
+
+  // The block freed by rcl must not be handed out as a message.
+  Message * message = allocator.allocate(1u);
+  ASSERT_TRUE(nullptr != message);
+  *message = Message();
+  allocator.deallocate(message, 1u);
+  EXPECT_EQ(1u, allocator.get_pool()->pooled_blocks(sizeof(Message)));
+}
+
+TEST(TestMessagePoolAllocator, pool_size_is_bounded) {
+  rclcpp::allocator::MessagePoolAllocator<Message> allocator(2u);
+  Message * messages[3];
+  for (auto & message : messages) {
+    message = allocator.allocate(1u);
+  }
+  for (auto & message : messages) {
+    allocator.deallocate(message, 1u);
+  }
+  EXPECT_EQ(2u, allocator.get_pool()->pooled_blocks(sizeof(Message)));
+}
+
+TEST(TestMessagePoolAllocator, allocator_deleter_returns_messages_to_the_pool) {
+  using MessageAllocator = rclcpp::allocator::MessagePoolAllocator<Message>;
+  using MessageAllocTraits = std::allocator_traits<MessageAllocator>;
+  using MessageDeleter = rclcpp::allocator::Deleter<MessageAllocator, Message>;
+  MessageAllocator allocator;
+
+  // This is how the intra-process manager copies a message for a subscription taking ownership.
+  Message * ptr = MessageAllocTraits::allocate(allocator, 1u);
+  MessageAllocTraits::construct(allocator, ptr, Message());
+  std::unique_ptr<Message, MessageDeleter> message(ptr, MessageDeleter(&allocator));
+  message.reset();
+
+  EXPECT_EQ(1u, allocator.get_pool()->pooled_blocks(sizeof(Message)));
+  EXPECT_EQ(ptr, MessageAllocTraits::allocate(allocator, 1u));
+  MessageAllocTraits::deallocate(allocator, ptr, 1u);
+}
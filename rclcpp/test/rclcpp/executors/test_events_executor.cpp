@@ -0,0 +1,180 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#ifdef __linux__
+#include <poll.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "rclcpp/executors.hpp"
+#include "rclcpp/node.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "test_msgs/msg/empty.hpp"
+#include "test_msgs/srv/empty.hpp"
+
+using namespace std::chrono_literals;
+
+using rclcpp::executors::EventsExecutor;
+
+class TestEventsExecutor : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+};
+
+TEST_F(TestEventsExecutor, spin_with_timer) {
+  EventsExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>("test_events_executor_timer");
+
+  std::atomic_int calls{0};
+  auto timer = node->create_wall_timer(
+    1ms, [&]() {
+      if (++calls >= 10) {
+        executor.cancel();
+      }
+    });
+  executor.add_node(node);
+  executor.spin();
+
+  EXPECT_GE(calls.load(), 10);
+}
+
+/*
+   Test that messages, requests and responses are dispatched as events, including the ones of
+   entities created after spinning started.
+ */
+TEST_F(TestEventsExecutor, dispatch_entity_events) {
+  EventsExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>("test_events_executor_entities");
+  executor.add_node(node);
+  std::thread spinner([&executor]() {executor.spin();});
+
+  std::atomic_int messages{0};
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "test_events_executor_topic", 10,
+    [&messages](test_msgs::msg::Empty::ConstSharedPtr) {++messages;});
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>(
+    "test_events_executor_topic", 10);
+
+  auto service = node->create_service<test_msgs::srv::Empty>(
+    "test_events_executor_service",
+    [](
+      const test_msgs::srv::Empty::Request::SharedPtr,
+      test_msgs::srv::Empty::Response::SharedPtr) {});
+  auto client = node->create_client<test_msgs::srv::Empty>("test_events_executor_service");
+  ASSERT_TRUE(client->wait_for_service(5s));
+
+  auto start = std::chrono::steady_clock::now();
+  while (messages.load() == 0 && std::chrono::steady_clock::now() - start < 5s) {
+    publisher->publish(test_msgs::msg::Empty());
+    std::this_thread::sleep_for(10ms);
+  }
+  auto future = client->async_send_request(std::make_shared<test_msgs::srv::Empty::Request>());
+  EXPECT_EQ(std::future_status::ready, future.wait_for(5s));
+
+  executor.cancel();
+  spinner.join();
+  EXPECT_GT(messages.load(), 0);
+}
+
+/*
+   Test that spin_some() executes what is ready and returns without blocking.
+ */
+TEST_F(TestEventsExecutor, spin_some) {
+  EventsExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>("test_events_executor_spin_some");
+  std::atomic_int calls{0};
+  auto timer = node->create_wall_timer(1ms, [&calls]() {++calls;});
+  executor.add_node(node);
+
+  std::this_thread::sleep_for(5ms);
+  auto start = std::chrono::steady_clock::now();
+  executor.spin_some();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 500ms);
+  EXPECT_EQ(1, calls.load());
+
+  EXPECT_THROW(executor.spin_all(0ns), std::invalid_argument);
+}
+
+/*
+   Test that a removed node is not executed anymore.
+ */
+TEST_F(TestEventsExecutor, remove_node) {
+  EventsExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>("test_events_executor_remove_node");
+  std::atomic_int calls{0};
+  auto timer = node->create_wall_timer(1ms, [&calls]() {++calls;});
+  executor.add_node(node);
+  executor.remove_node(node);
+
+  std::this_thread::sleep_for(5ms);
+  executor.spin_some();
+  EXPECT_EQ(0, calls.load());
+}
+
+#ifdef __linux__
+/*
+   Test that an event loop polling the ready file descriptor dispatches the messages and timers.
+ */
+TEST_F(TestEventsExecutor, dispatch_ready_from_event_loop) {
+  EventsExecutor executor;
+  auto node = std::make_shared<rclcpp::Node>("test_events_executor_ready_fd");
+  std::atomic_int messages{0};
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "test_events_executor_ready_fd_topic", 10,
+    [&messages](test_msgs::msg::Empty::ConstSharedPtr) {++messages;});
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>(
+    "test_events_executor_ready_fd_topic", 10);
+  std::atomic_int timer_calls{0};
+  auto timer = node->create_wall_timer(20ms, [&timer_calls]() {++timer_calls;});
+  executor.add_node(node);
+
+  const int fd = executor.get_ready_fd();
+  ASSERT_GE(fd, 0);
+  EXPECT_EQ(fd, executor.get_ready_fd());
+
+  auto start = std::chrono::steady_clock::now();
+  while ((messages.load() == 0 || timer_calls.load() == 0) &&
+    std::chrono::steady_clock::now() - start < 5s)
+  {
+    publisher->publish(test_msgs::msg::Empty());
+    auto timeout = executor.get_next_timer_timeout();
+    EXPECT_LE(timeout, 20ms);
+    pollfd poll_fd{fd, POLLIN, 0};
+    const int ready = poll(
+      &poll_fd, 1,
+      timeout < 0ns ? 10 : static_cast<int>(
+        std::chrono::ceil<std::chrono::milliseconds>(timeout).count()));
+    ASSERT_GE(ready, 0);
+    executor.dispatch_ready();
+  }
+  EXPECT_GT(messages.load(), 0);
+  EXPECT_GT(timer_calls.load(), 0);
+}
+#endif
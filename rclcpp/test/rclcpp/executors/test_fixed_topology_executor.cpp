@@ -0,0 +1,139 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+#include "rclcpp/executors/fixed_topology_executor.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "test_msgs/msg/empty.hpp"
+#include "test_msgs/srv/empty.hpp"
+
+using namespace std::chrono_literals;
+
+using rclcpp::executors::FixedTopologyExecutor;
+using rclcpp::executors::make_fixed_topology_executor;
+
+class TestFixedTopologyExecutor : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    node = std::make_shared<rclcpp::Node>("test_fixed_topology_executor", "/ns");
+  }
+
+  void TearDown() override
+  {
+    node.reset();
+  }
+
+  /// Spin the executor once at a time until the predicate is true, or a timeout.
+  template<typename ExecutorT>
+  bool spin_until(ExecutorT & executor, std::function<bool()> predicate)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    while (!predicate() && std::chrono::steady_clock::now() - start < 10s) {
+      executor.spin_once(10ms);
+    }
+    return predicate();
+  }
+
+  rclcpp::Node::SharedPtr node;
+};
+
+TEST_F(TestFixedTopologyExecutor, wait_set_sizes) {
+  using Subscription = rclcpp::Subscription<test_msgs::msg::Empty>;
+  using Service = rclcpp::Service<test_msgs::srv::Empty>;
+  using Client = rclcpp::Client<test_msgs::srv::Empty>;
+  using Timer = rclcpp::TimerBase;
+  using Executor = FixedTopologyExecutor<Subscription, Timer, Subscription, Service, Client>;
+  static_assert(2u == Executor::number_of_subscriptions, "unexpected number of subscriptions");
+  static_assert(1u == Executor::number_of_timers, "unexpected number of timers");
+  static_assert(1u == Executor::number_of_services, "unexpected number of services");
+  static_assert(1u == Executor::number_of_clients, "unexpected number of clients");
+  static_assert(
+    std::is_same<Executor::WaitSet, rclcpp::StaticWaitSet<2u, 1u, 1u, 1u, 1u, 0u>>::value,
+    "unexpected wait set");
+}
+
+TEST_F(TestFixedTopologyExecutor, null_entity) {
+  std::shared_ptr<rclcpp::Subscription<test_msgs::msg::Empty>> subscription;
+  EXPECT_THROW(make_fixed_topology_executor(subscription), std::invalid_argument);
+}
+
+TEST_F(TestFixedTopologyExecutor, subscriptions_and_timers) {
+  size_t messages_received = 0u;
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "topic", 10, [&messages_received](test_msgs::msg::Empty::ConstSharedPtr) {
+      ++messages_received;
+    });
+  size_t timer_calls = 0u;
+  auto timer = node->create_wall_timer(1ms, [&timer_calls]() {++timer_calls;});
+  auto executor = make_fixed_topology_executor(subscription, timer);
+
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>("topic", 10);
+  ASSERT_TRUE(
+    spin_until(*executor, [&publisher]() {return publisher->get_subscription_count() > 0u;}));
+  publisher->publish(test_msgs::msg::Empty());
+  EXPECT_TRUE(spin_until(*executor, [&messages_received]() {return messages_received > 0u;}));
+  EXPECT_EQ(1u, messages_received);
+  EXPECT_TRUE(spin_until(*executor, [&timer_calls]() {return timer_calls > 2u;}));
+}
+
+TEST_F(TestFixedTopologyExecutor, services_and_clients) {
+  size_t requests_received = 0u;
+  auto service = node->create_service<test_msgs::srv::Empty>(
+    "service",
+    [&requests_received](
+      test_msgs::srv::Empty::Request::SharedPtr, test_msgs::srv::Empty::Response::SharedPtr) {
+      ++requests_received;
+    });
+  auto client = node->create_client<test_msgs::srv::Empty>("service");
+  auto executor = make_fixed_topology_executor(service, client);
+
+  ASSERT_TRUE(client->wait_for_service(10s));
+  auto future = client->async_send_request(std::make_shared<test_msgs::srv::Empty::Request>());
+  EXPECT_TRUE(
+    spin_until(
+      *executor, [&future]() {return future.wait_for(0s) == std::future_status::ready;}));
+  EXPECT_EQ(1u, requests_received);
+}
+
+TEST_F(TestFixedTopologyExecutor, cancel) {
+  auto timer = node->create_wall_timer(1h, []() {});
+  auto executor = make_fixed_topology_executor(timer);
+  std::thread spinner([&executor]() {executor->spin();});
+  std::this_thread::sleep_for(50ms);
+  EXPECT_THROW(executor->spin(), std::runtime_error);
+  executor->cancel();
+  spinner.join();
+  EXPECT_FALSE(executor->spin_once(0ms));
+}
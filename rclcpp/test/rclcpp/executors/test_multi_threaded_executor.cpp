@@ -14,9 +14,14 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/node.hpp"
@@ -97,3 +102,131 @@ TEST_F(TestMultiThreadedExecutor, timer_over_take) {
   executor.add_node(node);
   executor.spin();
 }
+
+/*
+   Test that the callback groups partitioned across several wait sets are all executed, with
+   their mutual exclusion, including a callback group created while spinning.
+ */
+TEST_F(TestMultiThreadedExecutor, sharded_wait_sets) {
+  rclcpp::executors::MultiThreadedExecutor default_executor;
+  EXPECT_EQ(1u, default_executor.get_number_of_wait_sets());
+
+  rclcpp::executors::MultiThreadedExecutor executor(
+    rclcpp::ExecutorOptions(), 2u, false, std::chrono::nanoseconds(-1), 3u);
+  EXPECT_EQ(3u, executor.get_number_of_wait_sets());
+
+  auto node = std::make_shared<rclcpp::Node>("test_multi_threaded_executor_sharded_wait_sets");
+
+  constexpr size_t number_of_groups = 5u;
+  std::array<std::atomic_int, number_of_groups> calls{};
+  std::array<std::atomic_bool, number_of_groups> in_callback{};
+  std::atomic_bool overlapped{false};
+  std::vector<rclcpp::TimerBase::SharedPtr> timers;
+  std::mutex timers_mutex;
+  auto add_timer = [&](size_t index) {
+      auto cbg = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+      auto timer = node->create_wall_timer(
+        1ms, [&, index]() {
+          if (in_callback[index].exchange(true)) {
+            overlapped = true;
+          }
+          std::this_thread::sleep_for(100us);
+          in_callback[index] = false;
+          ++calls[index];
+          bool done = true;
+          for (const auto & count : calls) {
+            done &= count.load() >= 10;
+          }
+          if (done) {
+            executor.cancel();
+          }
+        }, cbg);
+      std::lock_guard<std::mutex> lock(timers_mutex);
+      timers.push_back(timer);
+    };
+  for (size_t i = 0; i < number_of_groups - 1; ++i) {
+    add_timer(i);
+  }
+  executor.add_node(node);
+
+  std::thread late_group([&]() {
+      std::this_thread::sleep_for(50ms);
+      add_timer(number_of_groups - 1);
+    });
+  executor.spin();
+  late_group.join();
+
+  for (const auto & count : calls) {
+    EXPECT_GE(count.load(), 10);
+  }
+  EXPECT_FALSE(overlapped.load());
+}
+
+/*
+   Test that executors attached to a shared thread pool execute their callbacks on its threads,
+   within the quota of each executor.
+ */
+TEST_F(TestMultiThreadedExecutor, shared_thread_pool) {
+  auto thread_pool = std::make_shared<rclcpp::executors::SharedThreadPool>(4u);
+  EXPECT_EQ(4u, thread_pool->get_number_of_threads());
+
+  rclcpp::executors::MultiThreadedExecutor sharded_executor(
+    rclcpp::ExecutorOptions(), 2u, false, std::chrono::nanoseconds(-1), 2u);
+  EXPECT_THROW(sharded_executor.set_thread_pool(thread_pool), std::invalid_argument);
+
+  // Each executor may only use one thread of the pool at a time.
+  constexpr size_t number_of_executors = 2u;
+  std::array<std::unique_ptr<rclcpp::executors::MultiThreadedExecutor>, number_of_executors>
+  executors;
+  std::array<rclcpp::Node::SharedPtr, number_of_executors> nodes;
+  std::vector<rclcpp::TimerBase::SharedPtr> timers;
+  std::array<std::atomic_int, number_of_executors> in_callback{};
+  std::array<std::atomic_int, number_of_executors> calls{};
+  std::atomic_bool over_quota{false};
+  std::atomic_bool on_spinning_thread{false};
+  std::array<std::thread::id, number_of_executors> spinning_threads;
+  for (size_t i = 0; i < number_of_executors; ++i) {
+    executors[i] = std::make_unique<rclcpp::executors::MultiThreadedExecutor>(
+      rclcpp::ExecutorOptions(), 1u);
+    executors[i]->set_thread_pool(thread_pool);
+    nodes[i] = std::make_shared<rclcpp::Node>(
+      "test_multi_threaded_executor_shared_thread_pool_" + std::to_string(i));
+    auto cbg = nodes[i]->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+    for (size_t j = 0; j < 2u; ++j) {
+      timers.push_back(
+        nodes[i]->create_wall_timer(
+          1ms, [&, i]() {
+            if (in_callback[i]++ > 0) {
+              over_quota = true;
+            }
+            if (std::this_thread::get_id() == spinning_threads[i]) {
+              on_spinning_thread = true;
+            }
+            std::this_thread::sleep_for(100us);
+            --in_callback[i];
+            if (++calls[i] >= 20) {
+              executors[i]->cancel();
+            }
+          }, cbg));
+    }
+    executors[i]->add_node(nodes[i]);
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < number_of_executors; ++i) {
+    threads.emplace_back(
+      [&, i]() {
+        spinning_threads[i] = std::this_thread::get_id();
+        executors[i]->spin();
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  for (const auto & count : calls) {
+    EXPECT_GE(count.load(), 20);
+  }
+  EXPECT_FALSE(over_quota.load());
+  EXPECT_FALSE(on_spinning_thread.load());
+}
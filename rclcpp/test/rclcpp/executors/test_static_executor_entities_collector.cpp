@@ -367,6 +367,8 @@ TEST_F(TestStaticExecutorEntitiesCollector, prepare_wait_set_rcl_wait_set_clear_
   entities_collector_->init(&wait_set, memory_strategy);
   RCPPUTILS_SCOPE_EXIT(entities_collector_->fini());
 
+  // The wait set is only prepared again if the entities changed
+  auto timer = node->create_wall_timer(std::chrono::seconds(60), []() {});
   {
     auto mock = mocking_utils::patch_and_return("lib:rclcpp", rcl_wait_set_clear, RCL_RET_ERROR);
     std::shared_ptr<void> data = entities_collector_->take_data();
@@ -397,6 +399,8 @@ TEST_F(TestStaticExecutorEntitiesCollector, prepare_wait_set_rcl_wait_set_resize
   entities_collector_->init(&wait_set, memory_strategy);
   RCPPUTILS_SCOPE_EXIT(entities_collector_->fini());
 
+  // The wait set is only prepared again if the entities changed
+  auto timer = node->create_wall_timer(std::chrono::seconds(60), []() {});
   {
     auto mock = mocking_utils::patch_and_return("lib:rclcpp", rcl_wait_set_resize, RCL_RET_ERROR);
     std::shared_ptr<void> data = entities_collector_->take_data();
@@ -408,6 +412,80 @@ TEST_F(TestStaticExecutorEntitiesCollector, prepare_wait_set_rcl_wait_set_resize
   EXPECT_TRUE(entities_collector_->remove_node(node->get_node_base_interface()));
 }
 
+TEST_F(TestStaticExecutorEntitiesCollector, execute_without_changes) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto timer = node->create_wall_timer(std::chrono::seconds(60), []() {});
+  entities_collector_->add_node(node->get_node_base_interface());
+
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  auto shared_context = node->get_node_base_interface()->get_context();
+  rcl_context_t * context = shared_context->get_rcl_context().get();
+  EXPECT_EQ(
+    RCL_RET_OK,
+    rcl_wait_set_init(&wait_set, 100, 100, 100, 100, 100, 100, context, allocator));
+  RCPPUTILS_SCOPE_EXIT({EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));});
+
+  auto memory_strategy = rclcpp::memory_strategies::create_default_strategy();
+  entities_collector_->init(&wait_set, memory_strategy);
+  RCPPUTILS_SCOPE_EXIT(entities_collector_->fini());
+  const size_t number_of_timers = entities_collector_->get_number_of_timers();
+  const size_t size_of_timers = wait_set.size_of_timers;
+  EXPECT_LE(number_of_timers, size_of_timers);
+
+  {
+    // Nothing changed, so neither the executable list nor the wait set are rebuilt.
+    auto mock = mocking_utils::patch_and_return("lib:rclcpp", rcl_wait_set_resize, RCL_RET_ERROR);
+    std::shared_ptr<void> data = entities_collector_->take_data();
+    EXPECT_NO_THROW(entities_collector_->execute(data));
+    EXPECT_EQ(number_of_timers, entities_collector_->get_number_of_timers());
+  }
+
+  // A new timer is appended, the wait set follows
+  auto other_timer = node->create_wall_timer(std::chrono::seconds(60), []() {});
+  std::shared_ptr<void> data = entities_collector_->take_data();
+  entities_collector_->execute(data);
+  EXPECT_EQ(number_of_timers + 1u, entities_collector_->get_number_of_timers());
+  EXPECT_EQ(size_of_timers + 1u, wait_set.size_of_timers);
+
+  EXPECT_TRUE(entities_collector_->remove_node(node->get_node_base_interface()));
+}
+
+TEST_F(TestStaticExecutorEntitiesCollector, ready_sets_index_the_executable_list) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto idle_timer = node->create_wall_timer(std::chrono::seconds(60), []() {});
+  auto timer = node->create_wall_timer(std::chrono::milliseconds(1), []() {});
+  entities_collector_->add_node(node->get_node_base_interface());
+
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  auto shared_context = node->get_node_base_interface()->get_context();
+  rcl_context_t * context = shared_context->get_rcl_context().get();
+  EXPECT_EQ(
+    RCL_RET_OK,
+    rcl_wait_set_init(&wait_set, 100, 100, 100, 100, 100, 100, context, allocator));
+  RCPPUTILS_SCOPE_EXIT({EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));});
+
+  auto memory_strategy = rclcpp::memory_strategies::create_default_strategy();
+  entities_collector_->init(&wait_set, memory_strategy);
+  RCPPUTILS_SCOPE_EXIT(entities_collector_->fini());
+
+  using rclcpp::experimental::ExecutableList;
+  const ExecutableList & exec_list = entities_collector_->get_executable_list();
+  ASSERT_EQ(exec_list.timer.size(), exec_list.timer_handle.size());
+  for (size_t i = 0; i < exec_list.timer.size(); ++i) {
+    EXPECT_EQ(exec_list.timer[i]->get_timer_handle().get(), exec_list.timer_handle[i]);
+  }
+
+  entities_collector_->refresh_wait_set(std::chrono::seconds(1));
+  size_t i = ExecutableList::next_ready(exec_list.timer_ready, 0);
+  ASSERT_NE(ExecutableList::npos, i);
+  EXPECT_EQ(timer, exec_list.timer[i]);
+  EXPECT_EQ(ExecutableList::npos, ExecutableList::next_ready(exec_list.timer_ready, i + 1));
+
+  EXPECT_TRUE(entities_collector_->remove_node(node->get_node_base_interface()));
+}
+
 TEST_F(TestStaticExecutorEntitiesCollector, refresh_wait_set_not_initialized) {
   RCLCPP_EXPECT_THROW_EQ(
     entities_collector_->refresh_wait_set(std::chrono::nanoseconds(1000)),
@@ -0,0 +1,209 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/executors.hpp"
+#include "rclcpp/node.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+using namespace std::chrono_literals;
+
+using rclcpp::executors::ThreadAffinityExecutor;
+
+class TestThreadAffinityExecutor : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+};
+
+TEST_F(TestThreadAffinityExecutor, construction) {
+  ThreadAffinityExecutor default_executor;
+  EXPECT_EQ(0u, default_executor.get_number_of_workers());
+
+  ThreadAffinityExecutor executor(
+    rclcpp::ExecutorOptions(), std::vector<ThreadAffinityExecutor::WorkerOptions>(2));
+  EXPECT_EQ(2u, executor.get_number_of_workers());
+
+  auto node = std::make_shared<rclcpp::Node>("test_thread_affinity_construction");
+  auto cbg = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive, false);
+  EXPECT_THROW(
+    executor.add_callback_group_to_worker(cbg, node->get_node_base_interface(), 2u),
+    std::out_of_range);
+  EXPECT_THROW(executor.remove_callback_group_from_worker(cbg, 0u), std::runtime_error);
+
+  executor.add_callback_group_to_worker(cbg, node->get_node_base_interface(), 1u);
+  EXPECT_TRUE(cbg->get_associated_with_executor_atomic().load());
+  EXPECT_TRUE(executor.get_all_callback_groups().empty());
+  EXPECT_THROW(executor.remove_callback_group_from_worker(cbg, 0u), std::runtime_error);
+  executor.remove_callback_group_from_worker(cbg, 1u);
+  EXPECT_FALSE(cbg->get_associated_with_executor_atomic().load());
+}
+
+/*
+   Test that a group assigned to a worker runs on the worker thread, while the other groups of
+   the node keep running on the spinning thread.
+ */
+TEST_F(TestThreadAffinityExecutor, assigned_group_runs_on_worker) {
+  ThreadAffinityExecutor executor(
+    rclcpp::ExecutorOptions(), std::vector<ThreadAffinityExecutor::WorkerOptions>(1));
+  auto node = std::make_shared<rclcpp::Node>("test_thread_affinity_worker");
+  auto worker_cbg = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+
+  std::mutex ids_mutex;
+  std::thread::id worker_thread_id;
+  std::thread::id default_thread_id;
+  std::atomic_int worker_calls{0};
+  std::atomic_int default_calls{0};
+  auto worker_timer = node->create_wall_timer(
+    1ms, [&]() {
+      std::lock_guard<std::mutex> lock(ids_mutex);
+      worker_thread_id = std::this_thread::get_id();
+      ++worker_calls;
+    }, worker_cbg);
+  auto default_timer = node->create_wall_timer(
+    1ms, [&]() {
+      {
+        std::lock_guard<std::mutex> lock(ids_mutex);
+        default_thread_id = std::this_thread::get_id();
+      }
+      if (++default_calls >= 10 && worker_calls.load() >= 10) {
+        executor.cancel();
+      }
+    });
+
+  // The group is moved from the executor to the worker.
+  executor.add_node(node);
+  executor.add_callback_group_to_worker(worker_cbg, node->get_node_base_interface(), 0u);
+  executor.spin();
+
+  EXPECT_GE(worker_calls.load(), 10);
+  EXPECT_GE(default_calls.load(), 10);
+  EXPECT_EQ(std::this_thread::get_id(), default_thread_id);
+  EXPECT_NE(std::this_thread::get_id(), worker_thread_id);
+}
+
+#ifdef __linux__
+/*
+   Test that a worker thread is pinned to the requested cpu.
+ */
+TEST_F(TestThreadAffinityExecutor, worker_is_pinned) {
+  ThreadAffinityExecutor::WorkerOptions worker_options;
+  worker_options.cpu_affinity = {0u};
+  ThreadAffinityExecutor executor(rclcpp::ExecutorOptions(), {worker_options});
+  auto node = std::make_shared<rclcpp::Node>("test_thread_affinity_pinned");
+  auto cbg = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive, false);
+
+  std::atomic_int calls{0};
+  std::atomic_bool ran_on_other_cpu{false};
+  auto timer = node->create_wall_timer(
+    1ms, [&]() {
+      if (sched_getcpu() != 0) {
+        ran_on_other_cpu = true;
+      }
+      if (++calls >= 10) {
+        executor.cancel();
+      }
+    }, cbg);
+  executor.add_callback_group_to_worker(cbg, node->get_node_base_interface(), 0u);
+  executor.spin();
+
+  EXPECT_GE(calls.load(), 10);
+  EXPECT_FALSE(ran_on_other_cpu.load());
+}
+
+/*
+   Test that an invalid worker option makes spin() throw instead of running unpinned.
+ */
+TEST_F(TestThreadAffinityExecutor, invalid_worker_options_throw) {
+  ThreadAffinityExecutor::WorkerOptions worker_options;
+  worker_options.cpu_affinity = {CPU_SETSIZE};
+  ThreadAffinityExecutor executor(rclcpp::ExecutorOptions(), {worker_options});
+  EXPECT_THROW(executor.spin(), std::invalid_argument);
+}
+#endif
+
+/*
+   Test that the workers of a NUMA node share its groups, and run them on its CPUs.
+ */
+TEST_F(TestThreadAffinityExecutor, numa_node_workers) {
+  const auto numa_node_cpus = ThreadAffinityExecutor::get_numa_node_cpus();
+  ASSERT_FALSE(numa_node_cpus.empty());
+  auto workers = ThreadAffinityExecutor::make_numa_worker_options(2u);
+  ASSERT_EQ(2u * numa_node_cpus.size(), workers.size());
+  for (size_t i = 0; i < workers.size(); ++i) {
+    EXPECT_EQ(static_cast<int>(i / 2u), workers[i].numa_node);
+  }
+
+  ThreadAffinityExecutor executor(rclcpp::ExecutorOptions(), workers);
+  auto node = std::make_shared<rclcpp::Node>("test_thread_affinity_numa");
+  auto cbg1 = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive, false);
+  auto cbg2 = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive, false);
+  EXPECT_THROW(
+    executor.add_callback_group_to_numa_node(
+      cbg1, node->get_node_base_interface(), static_cast<int>(numa_node_cpus.size())),
+    std::out_of_range);
+
+  std::atomic_int calls1{0};
+  std::atomic_int calls2{0};
+  std::atomic_bool ran_on_other_numa_node{false};
+  auto check_cpu = [&]() {
+#ifdef __linux__
+      const auto & cpus = numa_node_cpus[0];
+      if (!cpus.empty() &&
+        std::find(cpus.begin(), cpus.end(), static_cast<size_t>(sched_getcpu())) == cpus.end())
+      {
+        ran_on_other_numa_node = true;
+      }
+#endif
+    };
+  auto timer1 = node->create_wall_timer(1ms, [&]() {check_cpu(); ++calls1;}, cbg1);
+  auto timer2 = node->create_wall_timer(
+    1ms, [&]() {
+      check_cpu();
+      if (++calls2 >= 10 && calls1.load() >= 10) {
+        executor.cancel();
+      }
+    }, cbg2);
+
+  // The least loaded worker of the node gets each group.
+  EXPECT_EQ(0u, executor.add_callback_group_to_numa_node(cbg1, node->get_node_base_interface(), 0));
+  EXPECT_EQ(1u, executor.add_callback_group_to_numa_node(cbg2, node->get_node_base_interface(), 0));
+  executor.spin();
+
+  EXPECT_GE(calls1.load(), 10);
+  EXPECT_GE(calls2.load(), 10);
+  EXPECT_FALSE(ran_on_other_numa_node.load());
+}
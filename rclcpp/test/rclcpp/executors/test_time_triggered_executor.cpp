@@ -0,0 +1,121 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/executors/time_triggered_executor.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+using namespace std::chrono_literals;
+
+class TestTimeTriggeredExecutor : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    node = std::make_shared<rclcpp::Node>("test_time_triggered_executor");
+    control_group = node->create_callback_group(
+      rclcpp::CallbackGroupType::MutuallyExclusive, false);
+    estimation_group = node->create_callback_group(
+      rclcpp::CallbackGroupType::MutuallyExclusive, false);
+  }
+
+  rclcpp::Node::SharedPtr node;
+  rclcpp::CallbackGroup::SharedPtr control_group;
+  rclcpp::CallbackGroup::SharedPtr estimation_group;
+};
+
+TEST_F(TestTimeTriggeredExecutor, invalid_schedule) {
+  EXPECT_THROW(rclcpp::executors::TimeTriggeredExecutor(0ms), std::invalid_argument);
+
+  rclcpp::executors::TimeTriggeredExecutor executor(10ms);
+  auto node_base = node->get_node_base_interface();
+  EXPECT_THROW(
+    executor.add_slot(control_group, node_base, 8ms, 3ms), std::invalid_argument);
+  EXPECT_EQ(0u, executor.add_slot(control_group, node_base, 0ms, 2ms));
+  EXPECT_THROW(
+    executor.add_slot(estimation_group, node_base, 1ms, 1ms), std::invalid_argument);
+  EXPECT_EQ(1u, executor.add_slot(estimation_group, node_base, 2ms, 1ms));
+  // A callback group may run in several slots.
+  EXPECT_EQ(2u, executor.add_slot(control_group, node_base, 5ms, 2ms));
+  EXPECT_THROW(executor.add_node(node), std::runtime_error);
+}
+
+TEST_F(TestTimeTriggeredExecutor, runs_slots_in_order) {
+  rclcpp::executors::TimeTriggeredExecutor executor(10ms);
+  auto node_base = node->get_node_base_interface();
+  executor.add_slot(control_group, node_base, 0ms, 2ms);
+  executor.add_slot(estimation_group, node_base, 2ms, 1ms);
+
+  // The timers are always ready, so each slot executes its timer once.
+  std::vector<std::string> executions;
+  auto control_timer = node->create_wall_timer(
+    100us, [&executions]() {executions.push_back("control");}, control_group);
+  auto estimation_timer = node->create_wall_timer(
+    100us, [&executor, &executions]() {
+      executions.push_back("estimation");
+      if (executions.size() >= 10u) {
+        executor.cancel();
+      }
+    }, estimation_group);
+  std::this_thread::sleep_for(1ms);
+
+  executor.spin();
+
+  ASSERT_EQ(10u, executions.size());
+  for (size_t i = 0; i < executions.size(); ++i) {
+    EXPECT_EQ(i % 2 == 0 ? "control" : "estimation", executions[i]);
+  }
+}
+
+TEST_F(TestTimeTriggeredExecutor, reports_overruns) {
+  rclcpp::executors::TimeTriggeredExecutor executor(10ms);
+  auto node_base = node->get_node_base_interface();
+  executor.add_slot(control_group, node_base, 0ms, 1ms);
+
+  std::vector<rclcpp::executors::TimeTriggeredExecutor::Overrun> overruns;
+  executor.set_overrun_callback(
+    [&executor, &overruns](const rclcpp::executors::TimeTriggeredExecutor::Overrun & overrun) {
+      overruns.push_back(overrun);
+      executor.cancel();
+    });
+  auto timer = node->create_wall_timer(
+    100us, []() {std::this_thread::sleep_for(3ms);}, control_group);
+  std::this_thread::sleep_for(1ms);
+
+  executor.spin();
+
+  ASSERT_EQ(1u, overruns.size());
+  EXPECT_EQ(0u, overruns[0].slot_index);
+  EXPECT_EQ(0u, overruns[0].cycle);
+  EXPECT_GE(overruns[0].lateness, 1ms);
+  EXPECT_EQ(1u, executor.get_overrun_count());
+}
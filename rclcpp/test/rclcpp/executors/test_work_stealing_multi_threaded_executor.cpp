@@ -0,0 +1,125 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/executors.hpp"
+#include "rclcpp/node.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+using namespace std::chrono_literals;
+
+class TestWorkStealingMultiThreadedExecutor : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+};
+
+TEST_F(TestWorkStealingMultiThreadedExecutor, construction) {
+  rclcpp::executors::WorkStealingMultiThreadedExecutor executor(rclcpp::ExecutorOptions(), 3u);
+  EXPECT_EQ(3u, executor.get_number_of_threads());
+  EXPECT_EQ(12u, executor.get_max_batch_size());
+
+  rclcpp::executors::WorkStealingMultiThreadedExecutor executor_with_batch(
+    rclcpp::ExecutorOptions(), 2u, 5u);
+  EXPECT_EQ(2u, executor_with_batch.get_number_of_threads());
+  EXPECT_EQ(5u, executor_with_batch.get_max_batch_size());
+
+  rclcpp::executors::WorkStealingMultiThreadedExecutor default_executor;
+  EXPECT_GT(default_executor.get_number_of_threads(), 0u);
+}
+
+/*
+   Test that callbacks of a mutually exclusive callback group never run concurrently, even when
+   they become ready in the same batch.
+ */
+TEST_F(TestWorkStealingMultiThreadedExecutor, mutually_exclusive_group_is_respected) {
+  rclcpp::executors::WorkStealingMultiThreadedExecutor executor(rclcpp::ExecutorOptions(), 4u);
+  auto node = std::make_shared<rclcpp::Node>("test_work_stealing_mutually_exclusive");
+  auto cbg = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+
+  std::atomic_int in_callback{0};
+  std::atomic_int max_in_callback{0};
+  std::atomic_int calls{0};
+  auto callback = [&]() {
+      int current = ++in_callback;
+      int observed = max_in_callback.load();
+      while (current > observed && !max_in_callback.compare_exchange_weak(observed, current)) {}
+      std::this_thread::sleep_for(1ms);
+      --in_callback;
+      if (++calls >= 40) {
+        executor.cancel();
+      }
+    };
+
+  std::vector<rclcpp::TimerBase::SharedPtr> timers;
+  for (size_t i = 0; i < 8; ++i) {
+    timers.push_back(node->create_wall_timer(1ms, callback, cbg));
+  }
+  executor.add_node(node);
+  executor.spin();
+
+  EXPECT_GE(calls.load(), 40);
+  EXPECT_EQ(1, max_in_callback.load());
+}
+
+/*
+   Test that reentrant work is spread over more than one thread.
+ */
+TEST_F(TestWorkStealingMultiThreadedExecutor, reentrant_work_uses_several_threads) {
+  rclcpp::executors::WorkStealingMultiThreadedExecutor executor(rclcpp::ExecutorOptions(), 4u);
+  auto node = std::make_shared<rclcpp::Node>("test_work_stealing_reentrant");
+  auto cbg = node->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+
+  std::mutex ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  std::atomic_int calls{0};
+  auto callback = [&]() {
+      {
+        std::lock_guard<std::mutex> lock(ids_mutex);
+        thread_ids.insert(std::this_thread::get_id());
+      }
+      std::this_thread::sleep_for(5ms);
+      if (++calls >= 80) {
+        executor.cancel();
+      }
+    };
+
+  std::vector<rclcpp::TimerBase::SharedPtr> timers;
+  for (size_t i = 0; i < 8; ++i) {
+    timers.push_back(node->create_wall_timer(1ms, callback, cbg));
+  }
+  executor.add_node(node);
+  executor.spin();
+
+  EXPECT_GE(calls.load(), 80);
+  EXPECT_GT(thread_ids.size(), 1u);
+}
@@ -18,6 +18,7 @@
 #include <string>
 
 #include "rcl/node_options.h"
+#include "rcl/wait.h"
 #include "rclcpp/node.hpp"
 #include "rclcpp/node_interfaces/node_base.hpp"
 #include "rclcpp/rclcpp.hpp"
@@ -191,3 +192,38 @@ TEST_F(TestNodeBase, construct_destruct_rcl_guard_condition_fini_error) {
 
   EXPECT_NO_THROW(std::make_shared<rclcpp::Node>("node", "ns").reset());
 }
+
+TEST_F(TestNodeBase, trigger_notify_guard_condition_coalescing) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto node_base = node->get_node_base_interface();
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_wait_set_init(
+      &wait_set, 0, 1, 0, 0, 0, 0, node_base->get_context()->get_rcl_context().get(),
+      rcl_get_default_allocator()));
+  auto wait = [&wait_set, &node_base]() {
+      EXPECT_EQ(RCL_RET_OK, rcl_wait_set_clear(&wait_set));
+      EXPECT_EQ(
+        RCL_RET_OK,
+        rcl_wait_set_add_guard_condition(
+          &wait_set, node_base->get_notify_guard_condition(), nullptr));
+      return rcl_wait(&wait_set, 0) == RCL_RET_OK;
+    };
+  // Consume the triggers of the node creation.
+  wait();
+  node_base->consume_notify_guard_condition_trigger();
+
+  EXPECT_EQ(RCL_RET_OK, node_base->trigger_notify_guard_condition());
+  EXPECT_EQ(RCL_RET_OK, node_base->trigger_notify_guard_condition());
+  EXPECT_TRUE(wait());
+  // The second trigger was pending, so it did not trigger the guard condition again.
+  EXPECT_FALSE(wait());
+  EXPECT_EQ(RCL_RET_OK, node_base->trigger_notify_guard_condition());
+  EXPECT_FALSE(wait());
+
+  node_base->consume_notify_guard_condition_trigger();
+  EXPECT_EQ(RCL_RET_OK, node_base->trigger_notify_guard_condition());
+  EXPECT_TRUE(wait());
+  EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));
+}
@@ -14,15 +14,20 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
+#include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "rcl/graph.h"
 #include "rcl/node_options.h"
 #include "rcl/remap.h"
+#include "rclcpp/graph_listener.hpp"
 #include "rclcpp/node.hpp"
 #include "rclcpp/node_interfaces/node_base.hpp"
 #include "rclcpp/node_interfaces/node_graph.hpp"
@@ -552,6 +557,41 @@ TEST_F(TestNodeGraph, wait_for_graph_change)
     rclcpp::exceptions::EventNotRegisteredError);
 }
 
+TEST_F(TestNodeGraph, wait_for_service_server)
+{
+  auto node_graph_interface = node()->get_node_graph_interface();
+  EXPECT_THROW(
+    node_graph_interface->wait_for_service_server(
+      nullptr, "/ns/service", std::chrono::milliseconds(1)),
+    rclcpp::exceptions::InvalidEventError);
+  EXPECT_THROW(
+    node_graph_interface->wait_for_service_server(
+      std::make_shared<rclcpp::Event>(), "/ns/service", std::chrono::milliseconds(0)),
+    rclcpp::exceptions::EventNotRegisteredError);
+
+  auto event = node_graph_interface->get_graph_event();
+  // A graph change which does not list the service does not wake the waiter up.
+  auto publisher = node()->create_publisher<test_msgs::msg::Empty>("topic", 10);
+  EXPECT_FALSE(
+    node_graph_interface->wait_for_service_server(
+      event, "/ns/service", std::chrono::milliseconds(100)));
+
+  auto callback = [](
+    const test_msgs::srv::Empty::Request::SharedPtr,
+    test_msgs::srv::Empty::Response::SharedPtr) {};
+  auto service = node()->create_service<test_msgs::srv::Empty>("service", callback);
+  // The graph changes made while waiting list the service once it is discovered.
+  std::vector<rclcpp::Publisher<test_msgs::msg::Empty>::SharedPtr> publishers;
+  bool listed = false;
+  for (size_t i = 0; i < 50u && !listed; ++i) {
+    publishers.push_back(
+      node()->create_publisher<test_msgs::msg::Empty>("topic_" + std::to_string(i), 10));
+    listed = node_graph_interface->wait_for_service_server(
+      event, "/ns/service", std::chrono::milliseconds(100));
+  }
+  EXPECT_TRUE(listed);
+}
+
 TEST_F(TestNodeGraph, notify_graph_change_rcl_error)
 {
   auto mock = mocking_utils::patch_and_return(
@@ -695,3 +735,71 @@ TEST_F(TestNodeGraph, get_info_by_topic_endpoint_info_array_fini_error)
     node_graph()->get_publishers_info_by_topic("topic", false),
     rclcpp::exceptions::RCLError);
 }
+
+TEST_F(TestNodeGraph, graph_cache)
+{
+  auto cached_node = std::make_shared<rclcpp::Node>(
+    "cached_node", node_namespace, rclcpp::NodeOptions().use_graph_cache(true));
+  auto cached_node_graph = dynamic_cast<rclcpp::node_interfaces::NodeGraph *>(
+    cached_node->get_node_graph_interface().get());
+  ASSERT_NE(nullptr, cached_node_graph);
+  auto context = cached_node->get_node_base_interface()->get_context();
+  auto graph_listener = context->get_sub_context<rclcpp::graph_listener::GraphListener>(context);
+
+  EXPECT_EQ(0u, cached_node_graph->count_publishers("cached_topic"));
+  EXPECT_EQ(0u, cached_node_graph->count_subscribers("cached_topic"));
+
+  // The results queried while the graph is unchanged are shared.
+  uint64_t graph_change_count;
+  std::shared_ptr<const std::map<std::string, std::vector<std::string>>> first, second;
+  do {
+    graph_change_count = graph_listener->get_graph_change_count();
+    first = cached_node_graph->get_topic_names_and_types_snapshot();
+    second = cached_node_graph->get_topic_names_and_types_snapshot();
+  } while (graph_change_count != graph_listener->get_graph_change_count());
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(*first, cached_node_graph->get_topic_names_and_types());
+
+  // The results are queried again once the graph listener observed the new publisher.
+  auto publisher = node()->create_publisher<test_msgs::msg::Empty>("cached_topic", 1);
+  const auto start = std::chrono::steady_clock::now();
+  while (0u == cached_node_graph->count_publishers("cached_topic") &&
+    std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(1u, cached_node_graph->count_publishers("cached_topic"));
+  EXPECT_EQ(1u, cached_node_graph->get_topic_names_and_types().count("/ns/cached_topic"));
+
+  auto node_names = cached_node_graph->get_node_names_snapshot();
+  EXPECT_NE(
+    node_names->end(), std::find(node_names->begin(), node_names->end(), "/ns/cached_node"));
+  EXPECT_EQ(*node_names, cached_node_graph->get_node_names());
+}
+
+TEST_F(TestNodeGraph, get_graph_snapshot)
+{
+  auto concrete_node_graph = dynamic_cast<rclcpp::node_interfaces::NodeGraph *>(
+    node()->get_node_graph_interface().get());
+  ASSERT_NE(nullptr, concrete_node_graph);
+  auto publisher = node()->create_publisher<test_msgs::msg::Empty>("snapshot_topic", 1);
+
+  std::shared_ptr<const rclcpp::GraphSnapshot> snapshot;
+  size_t num_publishers = get_num_graph_things(
+    [concrete_node_graph, &snapshot]() -> size_t {
+      snapshot = concrete_node_graph->get_graph_snapshot();
+      auto it = snapshot->topics.find("/ns/snapshot_topic");
+      return snapshot->topics.end() == it ? 0u : it->second.publishers.size();
+    });
+  ASSERT_EQ(1u, num_publishers);
+
+  const auto & topic = snapshot->topics.at("/ns/snapshot_topic");
+  ASSERT_EQ(1u, topic.types.size());
+  EXPECT_EQ("test_msgs/msg/Empty", topic.types[0]);
+  EXPECT_TRUE(topic.subscriptions.empty());
+  EXPECT_STREQ(node_name, topic.publishers[0].node_name().c_str());
+  EXPECT_EQ(rclcpp::EndpointType::Publisher, topic.publishers[0].endpoint_type());
+  EXPECT_NE(
+    snapshot->node_names.end(),
+    std::find(snapshot->node_names.begin(), snapshot->node_names.end(), "/ns/node"));
+}
@@ -21,12 +21,17 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <chrono>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "rcl_interfaces/srv/list_parameters.hpp"
+#include "rclcpp/executors/single_threaded_executor.hpp"
 #include "rclcpp/node.hpp"
 #include "rclcpp/node_interfaces/node_parameters.hpp"
+#include "rclcpp/parameter_client.hpp"
 
 #include "../../mocking_utils/patch.hpp"
 #include "../../utils/rclcpp_gtest_macros.hpp"
@@ -113,6 +118,42 @@ TEST_F(TestNodeParameters, list_parameters)
     list_result4.names.end());
 }
 
+TEST_F(TestNodeParameters, list_parameters_by_prefixes)
+{
+  const rcl_interfaces::msg::ParameterDescriptor descriptor;
+  for (const std::string name : {
+      "arm", "arm.joint1.gain", "arm.joint1.gain.i", "arm.joint2.gain", "arm_base.gain", "armor"})
+  {
+    node_parameters->declare_parameter(name, rclcpp::ParameterValue(1.0), descriptor, false);
+  }
+
+  // Only the parameters in the namespace of the prefix are listed, not the ones whose name
+  // merely starts with it, in name order and each once.
+  auto list_result = node_parameters->list_parameters(
+    {"arm.joint1", "arm"}, rcl_interfaces::srv::ListParameters::Request::DEPTH_RECURSIVE);
+  EXPECT_EQ(
+    std::vector<std::string>({"arm", "arm.joint1.gain", "arm.joint1.gain.i", "arm.joint2.gain"}),
+    list_result.names);
+  EXPECT_EQ(
+    std::vector<std::string>({"arm.joint1", "arm.joint1.gain", "arm.joint2"}),
+    list_result.prefixes);
+
+  // The depth counts the separators after the prefix, including the first one.
+  list_result = node_parameters->list_parameters({"arm"}, 3u);
+  EXPECT_EQ(
+    std::vector<std::string>({"arm", "arm.joint1.gain", "arm.joint2.gain"}),
+    list_result.names);
+
+  std::map<std::string, rclcpp::Parameter> parameters;
+  EXPECT_TRUE(node_parameters->get_parameters_by_prefix("arm.joint1", parameters));
+  ASSERT_EQ(2u, parameters.size());
+  EXPECT_EQ(1u, parameters.count("gain"));
+  EXPECT_EQ(1u, parameters.count("gain.i"));
+  parameters.clear();
+  EXPECT_FALSE(node_parameters->get_parameters_by_prefix("arm.joint", parameters));
+  EXPECT_TRUE(parameters.empty());
+}
+
 TEST_F(TestNodeParameters, parameter_overrides)
 {
   rclcpp::NodeOptions node_options;
@@ -199,3 +240,108 @@ TEST_F(TestNodeParameters, add_remove_parameters_callback) {
     node_parameters->remove_on_set_parameters_callback(handle.get()),
     std::runtime_error("Callback doesn't exist"));
 }
+
+TEST_F(TestNodeParameters, parameter_event_batch) {
+  std::vector<rcl_interfaces::msg::ParameterEvent> events;
+  auto subscription = node->create_subscription<rcl_interfaces::msg::ParameterEvent>(
+    "/parameter_events", rclcpp::ParameterEventsQoS(),
+    [&events](rcl_interfaces::msg::ParameterEvent::UniquePtr event) {
+      if (event->node == "/ns/node") {
+        events.push_back(*event);
+      }
+    });
+
+  {
+    rclcpp::node_interfaces::ParameterEventBatch batch(node->get_node_parameters_interface());
+    node->declare_parameter("declared_then_set", 1);
+    node->set_parameter(rclcpp::Parameter("declared_then_set", 2));
+    node->declare_parameter("declared_then_undeclared", true);
+    node->undeclare_parameter("declared_then_undeclared");
+  }
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (events.empty() && std::chrono::steady_clock::now() < deadline) {
+    executor.spin_some(std::chrono::milliseconds(10));
+  }
+  // Let any unexpected extra event arrive.
+  executor.spin_some(std::chrono::milliseconds(100));
+
+  ASSERT_EQ(1u, events.size());
+  ASSERT_EQ(1u, events[0].new_parameters.size());
+  EXPECT_EQ("declared_then_set", events[0].new_parameters[0].name);
+  EXPECT_EQ(2, events[0].new_parameters[0].value.integer_value);
+  EXPECT_TRUE(events[0].changed_parameters.empty());
+  EXPECT_TRUE(events[0].deleted_parameters.empty());
+
+  RCLCPP_EXPECT_THROW_EQ(
+    node_parameters->end_parameter_event_batch(),
+    std::runtime_error("end_parameter_event_batch() called without a batch"));
+}
+
+TEST_F(TestNodeParameters, lazy_parameter_services) {
+  auto lazy_node = std::make_shared<rclcpp::Node>(
+    "lazy_node", "ns", rclcpp::NodeOptions().lazy_parameter_services(true));
+  lazy_node->declare_parameter("value", 1);
+  auto service_names = node->get_service_names_and_types();
+  EXPECT_EQ(0u, service_names.count("/ns/lazy_node/get_parameters"));
+
+  // The services are created once the client is discovered.
+  auto client = std::make_shared<rclcpp::AsyncParametersClient>(node, "/ns/lazy_node");
+  ASSERT_TRUE(client->wait_for_service(std::chrono::seconds(5)));
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  executor.add_node(lazy_node);
+  auto future = client->get_parameters({"value"});
+  ASSERT_EQ(
+    rclcpp::FutureReturnCode::SUCCESS,
+    executor.spin_until_future_complete(future, std::chrono::seconds(5)));
+  ASSERT_EQ(1u, future.get().size());
+  EXPECT_EQ(1, future.get()[0].as_int());
+
+  EXPECT_THROW(
+    std::make_shared<rclcpp::node_interfaces::NodeParameters>(
+      lazy_node->get_node_base_interface(), lazy_node->get_node_logging_interface(),
+      lazy_node->get_node_topics_interface(), lazy_node->get_node_services_interface(),
+      lazy_node->get_node_clock_interface(), std::vector<rclcpp::Parameter>{}, true, true,
+      rclcpp::ParameterEventsQoS(), rclcpp::PublisherOptionsBase(), false, false, nullptr,
+      std::chrono::nanoseconds(0), false, true, nullptr),
+    std::invalid_argument);
+}
+
+TEST_F(TestNodeParameters, lazy_parameter_event_publisher) {
+  std::vector<rcl_interfaces::msg::ParameterEvent> events;
+  auto subscription = node->create_subscription<rcl_interfaces::msg::ParameterEvent>(
+    "/parameter_events", rclcpp::ParameterEventsQoS(),
+    [&events](rcl_interfaces::msg::ParameterEvent::UniquePtr event) {
+      if (event->node == "/ns/lazy_node") {
+        events.push_back(*event);
+      }
+    });
+  auto lazy_node = std::make_shared<rclcpp::Node>(
+    "lazy_node", "ns", rclcpp::NodeOptions().lazy_parameter_services(true));
+  const size_t publisher_count = node->count_publishers("/parameter_events");
+  // The declarations do not create the publisher.
+  lazy_node->declare_parameter("value", 1);
+  EXPECT_EQ(publisher_count, node->count_publishers("/parameter_events"));
+
+  // The first change creates it.
+  lazy_node->set_parameter(rclcpp::Parameter("value", 2));
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (node->count_publishers("/parameter_events") == publisher_count &&
+    std::chrono::steady_clock::now() < deadline)
+  {
+    executor.spin_some(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(publisher_count + 1u, node->count_publishers("/parameter_events"));
+  while (events.empty() && std::chrono::steady_clock::now() < deadline) {
+    // The events published before the publisher is matched may be lost.
+    lazy_node->set_parameter(rclcpp::Parameter("value", 3));
+    executor.spin_some(std::chrono::milliseconds(10));
+  }
+  ASSERT_FALSE(events.empty());
+  EXPECT_EQ("value", events[0].changed_parameters[0].name);
+}
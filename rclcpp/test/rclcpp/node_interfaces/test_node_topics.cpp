@@ -169,3 +169,19 @@ TEST_F(TestNodeTopics, resolve_topic_name)
     node_topics->resolve_topic_name("this is not a valid name!~>", true),
     rclcpp::exceptions::RCLError);
 }
+
+TEST_F(TestNodeTopics, resolve_topic_name_cached)
+{
+  EXPECT_EQ("/ns/bar", node_topics->resolve_topic_name("foo", false));
+
+  // Resolved names are not resolved by rcl again.
+  auto mock = mocking_utils::patch_and_return(
+    "lib:rclcpp", rcl_node_resolve_name, RCL_RET_ERROR);
+  EXPECT_EQ("/ns/bar", node_topics->resolve_topic_name("foo", false));
+  EXPECT_THROW(
+    node_topics->resolve_topic_name("foo", true),
+    rclcpp::exceptions::RCLError);
+  EXPECT_THROW(
+    node_topics->resolve_topic_name("other", false),
+    rclcpp::exceptions::RCLError);
+}
@@ -15,6 +15,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <utility>
@@ -914,3 +915,321 @@ TEST_F(TestAllocatorMemoryStrategy, get_next_waitable_out_of_scope) {
   allocator_memory_strategy()->get_next_waitable(result, weak_groups_to_nodes);
   EXPECT_EQ(nullptr, result.node_base);
 }
+
+TEST_F(TestAllocatorMemoryStrategy, restore_collected_entities) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto callback_group = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  rclcpp::SubscriptionOptions subscription_options;
+  subscription_options.callback_group = callback_group;
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "topic", rclcpp::QoS(10), [](test_msgs::msg::Empty::ConstSharedPtr) {},
+    subscription_options);
+  auto timer = node->create_wall_timer(std::chrono::seconds(10), []() {}, callback_group);
+
+  WeakCallbackGroupsToNodesMap weak_groups_to_nodes;
+  node->for_each_callback_group(
+    [node, &weak_groups_to_nodes](rclcpp::CallbackGroup::SharedPtr group_ptr)
+    {
+      weak_groups_to_nodes.insert(
+        std::pair<rclcpp::CallbackGroup::WeakPtr,
+        rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>(
+          group_ptr,
+          node->get_node_base_interface()));
+    });
+
+  // Nothing was collected yet, so there is nothing to restore.
+  EXPECT_FALSE(allocator_memory_strategy()->restore_collected_entities());
+
+  EXPECT_FALSE(allocator_memory_strategy()->collect_entities(weak_groups_to_nodes));
+  const size_t number_of_subscriptions =
+    allocator_memory_strategy()->number_of_ready_subscriptions();
+  EXPECT_LE(1u, number_of_subscriptions);
+  EXPECT_EQ(1u, allocator_memory_strategy()->number_of_ready_timers());
+
+  // Taking an entity removes it from the handles, restoring brings it back.
+  rclcpp::AnyExecutable any_exec;
+  allocator_memory_strategy()->get_next_subscription(any_exec, weak_groups_to_nodes);
+  EXPECT_EQ(subscription, any_exec.subscription);
+  any_exec.callback_group->can_be_taken_from() = true;
+  any_exec.callback_group.reset();
+  EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+  EXPECT_EQ(number_of_subscriptions, allocator_memory_strategy()->number_of_ready_subscriptions());
+  EXPECT_EQ(1u, allocator_memory_strategy()->number_of_ready_timers());
+
+  // Entities of a callback group in use are not restored, but are still remembered.
+  callback_group->can_be_taken_from() = false;
+  EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+  EXPECT_EQ(0u, allocator_memory_strategy()->number_of_ready_timers());
+  callback_group->can_be_taken_from() = true;
+  EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+  EXPECT_EQ(1u, allocator_memory_strategy()->number_of_ready_timers());
+
+  // A destroyed entity invalidates the collection.
+  timer.reset();
+  EXPECT_FALSE(allocator_memory_strategy()->restore_collected_entities());
+  EXPECT_EQ(0u, allocator_memory_strategy()->number_of_ready_timers());
+  EXPECT_FALSE(allocator_memory_strategy()->restore_collected_entities());
+
+  // Clearing the handles also drops the collection.
+  EXPECT_FALSE(allocator_memory_strategy()->collect_entities(weak_groups_to_nodes));
+  allocator_memory_strategy()->clear_handles();
+  EXPECT_FALSE(allocator_memory_strategy()->restore_collected_entities());
+}
+
+TEST_F(TestAllocatorMemoryStrategy, restore_collected_entities_after_entity_added) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto callback_group = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  auto timer = node->create_wall_timer(std::chrono::seconds(10), []() {}, callback_group);
+
+  WeakCallbackGroupsToNodesMap weak_groups_to_nodes;
+  weak_groups_to_nodes.insert(
+    std::pair<rclcpp::CallbackGroup::WeakPtr,
+    rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>(
+      callback_group,
+      node->get_node_base_interface()));
+
+  EXPECT_FALSE(allocator_memory_strategy()->collect_entities(weak_groups_to_nodes));
+  EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+  EXPECT_EQ(1u, allocator_memory_strategy()->number_of_ready_timers());
+
+  // Adding an entity publishes a new snapshot of the group, the previous one is unchanged.
+  auto entities = callback_group->get_entities();
+  const uint64_t version = callback_group->get_entities_version();
+  auto other_timer = node->create_wall_timer(std::chrono::seconds(10), []() {}, callback_group);
+  EXPECT_LT(version, callback_group->get_entities_version());
+  EXPECT_EQ(1u, entities->timers.size());
+  EXPECT_EQ(2u, callback_group->get_entities()->timers.size());
+
+  // The collection misses the new timer, so it can't be restored.
+  EXPECT_FALSE(allocator_memory_strategy()->restore_collected_entities());
+  EXPECT_FALSE(allocator_memory_strategy()->collect_entities(weak_groups_to_nodes));
+  EXPECT_EQ(2u, allocator_memory_strategy()->number_of_ready_timers());
+  EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+  EXPECT_EQ(2u, allocator_memory_strategy()->number_of_ready_timers());
+}
+
+TEST_F(TestAllocatorMemoryStrategy, remove_collected_callback_group) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto first_group = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  auto second_group = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  auto third_group = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  auto first_timer = node->create_wall_timer(std::chrono::seconds(10), []() {}, first_group);
+  auto second_timer = node->create_wall_timer(std::chrono::seconds(10), []() {}, second_group);
+  auto other_timer = node->create_wall_timer(std::chrono::seconds(10), []() {}, second_group);
+  auto third_timer = node->create_wall_timer(std::chrono::seconds(10), []() {}, third_group);
+
+  WeakCallbackGroupsToNodesMap weak_groups_to_nodes;
+  for (const auto & group : {first_group, second_group, third_group}) {
+    weak_groups_to_nodes.insert(
+      std::pair<rclcpp::CallbackGroup::WeakPtr,
+      rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>(
+        group, node->get_node_base_interface()));
+  }
+
+  // Nothing was collected yet, so there is nothing to remove from.
+  EXPECT_FALSE(allocator_memory_strategy()->remove_collected_callback_group(second_group));
+
+  EXPECT_FALSE(allocator_memory_strategy()->collect_entities(weak_groups_to_nodes));
+  EXPECT_EQ(4u, allocator_memory_strategy()->number_of_ready_timers());
+
+  // The entities of the other groups are restored without collecting them again.
+  weak_groups_to_nodes.erase(second_group);
+  EXPECT_TRUE(allocator_memory_strategy()->remove_collected_callback_group(second_group));
+  EXPECT_FALSE(allocator_memory_strategy()->remove_collected_callback_group(second_group));
+  EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+  EXPECT_EQ(2u, allocator_memory_strategy()->number_of_ready_timers());
+
+  rclcpp::AnyExecutable result;
+  allocator_memory_strategy()->get_next_timer(result, weak_groups_to_nodes);
+  EXPECT_EQ(first_timer, result.timer);
+  result.callback_group->can_be_taken_from() = true;
+  result = rclcpp::AnyExecutable();
+  allocator_memory_strategy()->get_next_timer(result, weak_groups_to_nodes);
+  EXPECT_EQ(third_timer, result.timer);
+  result.callback_group->can_be_taken_from() = true;
+  result = rclcpp::AnyExecutable();
+
+  // The timers of the removed group may be destroyed without invalidating the collection.
+  second_timer.reset();
+  other_timer.reset();
+  EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+  EXPECT_EQ(2u, allocator_memory_strategy()->number_of_ready_timers());
+}
+
+TEST_F(TestAllocatorMemoryStrategy, get_next_timer_of_removed_callback_group) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto callback_group = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  auto timer = node->create_wall_timer(std::chrono::seconds(10), []() {}, callback_group);
+
+  WeakCallbackGroupsToNodesMap weak_groups_to_nodes;
+  weak_groups_to_nodes.insert(
+    std::pair<rclcpp::CallbackGroup::WeakPtr,
+    rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>(
+      callback_group, node->get_node_base_interface()));
+
+  EXPECT_FALSE(allocator_memory_strategy()->collect_entities(weak_groups_to_nodes));
+  EXPECT_EQ(1u, allocator_memory_strategy()->number_of_ready_timers());
+
+  // The collected timer must not be resolved once its group is not part of the map anymore.
+  WeakCallbackGroupsToNodesMap empty_weak_groups_to_nodes;
+  rclcpp::AnyExecutable result;
+  allocator_memory_strategy()->get_next_timer(result, empty_weak_groups_to_nodes);
+  EXPECT_EQ(nullptr, result.node_base);
+  EXPECT_EQ(0u, allocator_memory_strategy()->number_of_ready_timers());
+
+  EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+  allocator_memory_strategy()->get_next_timer(result, weak_groups_to_nodes);
+  EXPECT_EQ(timer, result.timer);
+  EXPECT_EQ(callback_group, result.callback_group);
+  EXPECT_EQ(node->get_node_base_interface(), result.node_base);
+}
+
+TEST_F(TestAllocatorMemoryStrategy, disabled_callback_group) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto callback_group =
+    node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  auto timer = node->create_wall_timer(std::chrono::seconds(10), []() {}, callback_group);
+
+  WeakCallbackGroupsToNodesMap weak_groups_to_nodes;
+  weak_groups_to_nodes.insert(
+    std::pair<rclcpp::CallbackGroup::WeakPtr,
+    rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>(
+      callback_group, node->get_node_base_interface()));
+
+  // The timer of the disabled group is collected, but not waited on.
+  callback_group->set_enabled(false);
+  EXPECT_FALSE(callback_group->is_enabled());
+  EXPECT_FALSE(allocator_memory_strategy()->collect_entities(weak_groups_to_nodes));
+  EXPECT_EQ(0u, allocator_memory_strategy()->number_of_ready_timers());
+
+  callback_group->set_enabled(true);
+  EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+  EXPECT_EQ(1u, allocator_memory_strategy()->number_of_ready_timers());
+
+  callback_group->set_enabled(false);
+  EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+  EXPECT_EQ(0u, allocator_memory_strategy()->number_of_ready_timers());
+}
+
+TEST_F(TestAllocatorMemoryStrategy, get_next_prioritized_executable) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto low_priority_group =
+    node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  auto high_priority_group =
+    node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  high_priority_group->set_priority(1);
+  auto timer = node->create_wall_timer(std::chrono::seconds(10), []() {}, low_priority_group);
+  rclcpp::SubscriptionOptions subscription_options;
+  subscription_options.callback_group = high_priority_group;
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "topic", rclcpp::QoS(10), [](test_msgs::msg::Empty::ConstSharedPtr) {},
+    subscription_options);
+
+  WeakCallbackGroupsToNodesMap weak_groups_to_nodes;
+  weak_groups_to_nodes.insert(
+    std::pair<rclcpp::CallbackGroup::WeakPtr,
+    rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>(
+      low_priority_group, node->get_node_base_interface()));
+  weak_groups_to_nodes.insert(
+    std::pair<rclcpp::CallbackGroup::WeakPtr,
+    rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>(
+      high_priority_group, node->get_node_base_interface()));
+  EXPECT_FALSE(allocator_memory_strategy()->collect_entities(weak_groups_to_nodes));
+
+  // The subscription is taken before the timer, which is passed over once.
+  rclcpp::AnyExecutable high_priority_result;
+  EXPECT_EQ(
+    1u, allocator_memory_strategy()->get_next_prioritized_executable(
+      high_priority_result, weak_groups_to_nodes, false));
+  EXPECT_EQ(subscription, high_priority_result.subscription);
+  EXPECT_EQ(nullptr, high_priority_result.timer);
+  EXPECT_EQ(high_priority_group, high_priority_result.callback_group);
+
+  rclcpp::AnyExecutable low_priority_result;
+  EXPECT_EQ(
+    0u, allocator_memory_strategy()->get_next_prioritized_executable(
+      low_priority_result, weak_groups_to_nodes, false));
+  EXPECT_EQ(timer, low_priority_result.timer);
+  EXPECT_EQ(low_priority_group, low_priority_result.callback_group);
+
+  rclcpp::AnyExecutable empty_result;
+  EXPECT_EQ(
+    0u, allocator_memory_strategy()->get_next_prioritized_executable(
+      empty_result, weak_groups_to_nodes, false));
+  EXPECT_EQ(nullptr, empty_result.node_base);
+}
+
+TEST_F(TestAllocatorMemoryStrategy, get_next_round_robin_executable) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto callback_group = node->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+  rclcpp::SubscriptionOptions subscription_options;
+  subscription_options.callback_group = callback_group;
+  std::vector<rclcpp::SubscriptionBase::SharedPtr> subscriptions;
+  for (size_t i = 0; i < 3u; ++i) {
+    subscriptions.push_back(
+      node->create_subscription<test_msgs::msg::Empty>(
+        "topic", rclcpp::QoS(10), [](test_msgs::msg::Empty::ConstSharedPtr) {},
+        subscription_options));
+  }
+
+  WeakCallbackGroupsToNodesMap weak_groups_to_nodes;
+  weak_groups_to_nodes.insert(
+    std::pair<rclcpp::CallbackGroup::WeakPtr,
+    rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>(
+      callback_group, node->get_node_base_interface()));
+  EXPECT_FALSE(allocator_memory_strategy()->collect_entities(weak_groups_to_nodes));
+
+  // Every subscription is ready after each restore, they take turns nonetheless.
+  auto next_subscription = [&]() {
+      allocator_memory_strategy()->clear_handles();
+      EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+      rclcpp::AnyExecutable result;
+      allocator_memory_strategy()->get_next_round_robin_executable(result, weak_groups_to_nodes);
+      EXPECT_EQ(callback_group, result.callback_group);
+      return result.subscription;
+    };
+  for (size_t round = 0; round < 2u; ++round) {
+    for (const auto & subscription : subscriptions) {
+      EXPECT_EQ(subscription, next_subscription());
+    }
+  }
+
+  // With a weight, each subscription is taken that many times in a row, including the last
+  // one, whose turn is not over.
+  EXPECT_THROW(callback_group->set_scheduling_weight(0u), std::invalid_argument);
+  callback_group->set_scheduling_weight(2u);
+  EXPECT_EQ(subscriptions[2], next_subscription());
+  EXPECT_EQ(subscriptions[0], next_subscription());
+  EXPECT_EQ(subscriptions[0], next_subscription());
+  EXPECT_EQ(subscriptions[1], next_subscription());
+  EXPECT_EQ(subscriptions[1], next_subscription());
+}
+
+TEST_F(TestAllocatorMemoryStrategy, get_next_prioritized_executable_by_deadline) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto callback_group = node->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+  auto late_timer = node->create_wall_timer(std::chrono::seconds(10), []() {}, callback_group);
+  auto early_timer = node->create_wall_timer(std::chrono::seconds(1), []() {}, callback_group);
+
+  WeakCallbackGroupsToNodesMap weak_groups_to_nodes;
+  weak_groups_to_nodes.insert(
+    std::pair<rclcpp::CallbackGroup::WeakPtr,
+    rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>(
+      callback_group, node->get_node_base_interface()));
+
+  // Without deadline ordering, the timer created first is taken first.
+  EXPECT_FALSE(allocator_memory_strategy()->collect_entities(weak_groups_to_nodes));
+  rclcpp::AnyExecutable fixed_order_result;
+  EXPECT_EQ(
+    0u, allocator_memory_strategy()->get_next_prioritized_executable(
+      fixed_order_result, weak_groups_to_nodes, false));
+  EXPECT_EQ(late_timer, fixed_order_result.timer);
+
+  allocator_memory_strategy()->clear_handles();
+  EXPECT_TRUE(allocator_memory_strategy()->restore_collected_entities());
+  rclcpp::AnyExecutable deadline_result;
+  EXPECT_EQ(
+    0u, allocator_memory_strategy()->get_next_prioritized_executable(
+      deadline_result, weak_groups_to_nodes, true));
+  EXPECT_EQ(early_timer, deadline_result.timer);
+}
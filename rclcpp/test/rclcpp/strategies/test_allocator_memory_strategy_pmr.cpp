@@ -0,0 +1,174 @@
+// Copyright 2020 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/strategies/allocator_memory_strategy.hpp"
+#include "test_msgs/msg/empty.hpp"
+#include "test_msgs/srv/empty.hpp"
+
+using rclcpp::memory_strategies::allocator_memory_strategy::AllocatorMemoryStrategy;
+typedef std::map<rclcpp::CallbackGroup::WeakPtr,
+    rclcpp::node_interfaces::NodeBaseInterface::WeakPtr,
+    std::owner_less<rclcpp::CallbackGroup::WeakPtr>> WeakCallbackGroupsToNodesMap;
+
+// Only count the allocations of the test thread, the middleware has threads of its own.
+static thread_local bool count_global_allocations = false;
+static thread_local size_t number_of_global_allocations = 0;
+
+void * operator new(std::size_t size)
+{
+  if (count_global_allocations) {
+    ++number_of_global_allocations;
+  }
+  void * pointer = std::malloc(size ? size : 1);
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void operator delete(void * pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void * pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+/// Memory resource counting the allocations it forwards to its upstream resource.
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+  explicit CountingResource(std::pmr::memory_resource * upstream)
+  : upstream_(upstream)
+  {}
+
+  size_t number_of_allocations = 0;
+
+private:
+  void * do_allocate(size_t bytes, size_t alignment) override
+  {
+    ++number_of_allocations;
+    return upstream_->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void * pointer, size_t bytes, size_t alignment) override
+  {
+    upstream_->deallocate(pointer, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+  {
+    return this == &other;
+  }
+
+  std::pmr::memory_resource * upstream_;
+};
+
+class TestAllocatorMemoryStrategyPmr : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  void TearDown() override
+  {
+    rclcpp::shutdown();
+  }
+};
+
+TEST_F(TestAllocatorMemoryStrategyPmr, no_global_allocations_after_initialization) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "topic", 10, [](test_msgs::msg::Empty::ConstSharedPtr) {});
+  auto timer = node->create_wall_timer(std::chrono::hours(1), []() {});
+  auto service = node->create_service<test_msgs::srv::Empty>(
+    "service",
+    [](
+      const test_msgs::srv::Empty::Request::SharedPtr,
+      test_msgs::srv::Empty::Response::SharedPtr) {});
+  auto client = node->create_client<test_msgs::srv::Empty>("service");
+
+  WeakCallbackGroupsToNodesMap weak_groups_to_nodes;
+  node->for_each_callback_group(
+    [&node, &weak_groups_to_nodes](rclcpp::CallbackGroup::SharedPtr group_ptr)
+    {
+      weak_groups_to_nodes.insert(
+        std::pair<rclcpp::CallbackGroup::WeakPtr,
+        rclcpp::node_interfaces::NodeBaseInterface::WeakPtr>(
+          group_ptr,
+          node->get_node_base_interface()));
+    });
+
+  // The whole executor bookkeeping is backed by a fixed buffer, through a pool.
+  static std::array<std::byte, 1 << 20> buffer;
+  std::pmr::monotonic_buffer_resource buffer_resource(
+    buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+  std::pmr::unsynchronized_pool_resource pool_resource(&buffer_resource);
+  CountingResource resource(&pool_resource);
+  using PolymorphicAllocator = std::pmr::polymorphic_allocator<void>;
+  auto memory_strategy = std::make_shared<AllocatorMemoryStrategy<PolymorphicAllocator>>(
+    std::make_shared<PolymorphicAllocator>(&resource));
+
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ASSERT_EQ(
+    RCL_RET_OK,
+    rcl_wait_set_init(
+      &wait_set, 10, 10, 10, 10, 10, 10,
+      node->get_node_base_interface()->get_context()->get_rcl_context().get(),
+      memory_strategy->get_allocator()));
+
+  // Initialization, the containers of the memory strategy reach their size.
+  memory_strategy->collect_entities(weak_groups_to_nodes);
+  ASSERT_TRUE(memory_strategy->add_handles_to_wait_set(&wait_set));
+  const size_t number_of_resource_allocations = resource.number_of_allocations;
+  EXPECT_LT(0u, number_of_resource_allocations);
+
+  count_global_allocations = true;
+  for (size_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(RCL_RET_OK, rcl_wait_set_clear(&wait_set));
+    if (i % 2 == 0) {
+      // A full collection only allocates from the memory resource.
+      memory_strategy->clear_handles();
+      memory_strategy->collect_entities(weak_groups_to_nodes);
+    } else {
+      ASSERT_TRUE(memory_strategy->restore_collected_entities());
+    }
+    ASSERT_TRUE(memory_strategy->add_handles_to_wait_set(&wait_set));
+    memory_strategy->remove_null_handles(&wait_set);
+  }
+  count_global_allocations = false;
+
+  EXPECT_EQ(0u, number_of_global_allocations);
+  EXPECT_LT(number_of_resource_allocations, resource.number_of_allocations);
+  EXPECT_LE(1u, memory_strategy->number_of_ready_subscriptions());
+  EXPECT_LE(1u, memory_strategy->number_of_ready_timers());
+
+  EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set));
+}
@@ -0,0 +1,125 @@
+// Copyright 2015 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "rclcpp/strategies/reclaiming_message_pool_memory_strategy.hpp"
+#include "test_msgs/msg/basic_types.hpp"
+#include "../../utils/rclcpp_gtest_macros.hpp"
+
+using rclcpp::strategies::reclaiming_message_pool_memory_strategy::
+ReclaimingMessagePoolMemoryStrategy;
+using test_msgs::msg::BasicTypes;
+
+TEST(TestReclaimingMessagePoolMemoryStrategy, construct_invalid) {
+  EXPECT_THROW(
+    ReclaimingMessagePoolMemoryStrategy<BasicTypes>(0),
+    std::invalid_argument);
+}
+
+TEST(TestReclaimingMessagePoolMemoryStrategy, borrow_return) {
+  ReclaimingMessagePoolMemoryStrategy<BasicTypes> strategy(2);
+  EXPECT_EQ(2u, strategy.capacity());
+  EXPECT_EQ(2u, strategy.available());
+
+  auto message = strategy.borrow_message();
+  ASSERT_NE(nullptr, message);
+  EXPECT_EQ(1u, strategy.available());
+  message->int32_value = 42;
+
+  EXPECT_NO_THROW(strategy.return_message(message));
+  EXPECT_EQ(nullptr, message);
+  EXPECT_EQ(2u, strategy.available());
+
+  // Returned messages are reset.
+  auto first = strategy.borrow_message();
+  auto second = strategy.borrow_message();
+  EXPECT_EQ(0, first->int32_value);
+  EXPECT_EQ(0, second->int32_value);
+}
+
+TEST(TestReclaimingMessagePoolMemoryStrategy, retained_message) {
+  ReclaimingMessagePoolMemoryStrategy<BasicTypes> strategy(1);
+
+  auto message = strategy.borrow_message();
+  // The subscription returns its reference, while the callback keeps its copy.
+  auto retained = message;
+  strategy.return_message(message);
+  EXPECT_EQ(0u, strategy.available());
+  RCLCPP_EXPECT_THROW_EQ(
+    strategy.borrow_message(),
+    std::runtime_error("No message available in the message pool."));
+
+  // A weak_ptr also keeps the message from being reused.
+  std::weak_ptr<BasicTypes> weak = retained;
+  retained.reset();
+  EXPECT_TRUE(weak.expired());
+  EXPECT_EQ(0u, strategy.available());
+  weak.reset();
+  EXPECT_EQ(1u, strategy.available());
+  EXPECT_NE(nullptr, strategy.borrow_message());
+}
+
+TEST(TestReclaimingMessagePoolMemoryStrategy, grow) {
+  ReclaimingMessagePoolMemoryStrategy<BasicTypes> strategy(2, 5);
+
+  std::vector<std::shared_ptr<BasicTypes>> messages;
+  for (size_t i = 0; i < 5; ++i) {
+    messages.push_back(strategy.borrow_message());
+  }
+  // Grows by the initial size, up to a multiple of it.
+  EXPECT_EQ(6u, strategy.capacity());
+  messages.push_back(strategy.borrow_message());
+  RCLCPP_EXPECT_THROW_EQ(
+    strategy.borrow_message(),
+    std::runtime_error("No message available in the message pool."));
+
+  messages.clear();
+  EXPECT_EQ(6u, strategy.available());
+}
+
+TEST(TestReclaimingMessagePoolMemoryStrategy, outlive_strategy) {
+  std::shared_ptr<BasicTypes> message;
+  {
+    ReclaimingMessagePoolMemoryStrategy<BasicTypes> strategy(1);
+    message = strategy.borrow_message();
+  }
+  message->int64_value = 1;
+  EXPECT_EQ(1, message->int64_value);
+}
+
+TEST(TestReclaimingMessagePoolMemoryStrategy, concurrent_borrow) {
+  ReclaimingMessagePoolMemoryStrategy<BasicTypes> strategy(4, 64);
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; ++i) {
+    threads.emplace_back(
+      [&strategy]() {
+        for (size_t j = 0; j < 10000; ++j) {
+          auto message = strategy.borrow_message();
+          EXPECT_EQ(0, message->int32_value);
+          message->int32_value = 1;
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_LE(strategy.capacity(), 8u);
+  EXPECT_EQ(strategy.capacity(), strategy.available());
+}
@@ -0,0 +1,114 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include "rclcpp/experimental/buffers/adaptive_ring_buffer_implementation.hpp"
+
+using rclcpp::experimental::buffers::AdaptiveRingBufferImplementation;
+
+/*
+   Constructor
+ */
+TEST(TestAdaptiveRingBufferImplementation, constructor) {
+  EXPECT_THROW(
+    AdaptiveRingBufferImplementation<int> rb(0, 4),
+    std::invalid_argument);
+  EXPECT_THROW(
+    AdaptiveRingBufferImplementation<int> rb(4, 2),
+    std::invalid_argument);
+
+  AdaptiveRingBufferImplementation<int> rb(2, 8);
+
+  EXPECT_FALSE(rb.has_data());
+  EXPECT_FALSE(rb.is_full());
+  EXPECT_EQ(0u, rb.size());
+  EXPECT_EQ(2u, rb.capacity());
+  EXPECT_THROW(rb.dequeue(), std::runtime_error);
+}
+
+/*
+   Grow when the consumer falls behind, up to the maximum capacity, then drop the oldest data
+ */
+TEST(TestAdaptiveRingBufferImplementation, grow) {
+  AdaptiveRingBufferImplementation<int> rb(2, 6);
+
+  for (int i = 0; i < 3; ++i) {
+    rb.enqueue(i);
+  }
+  EXPECT_EQ(3u, rb.size());
+  EXPECT_EQ(4u, rb.capacity());
+  EXPECT_FALSE(rb.is_full());
+
+  for (int i = 3; i < 6; ++i) {
+    rb.enqueue(i);
+  }
+  EXPECT_EQ(6u, rb.size());
+  EXPECT_EQ(6u, rb.capacity());
+  EXPECT_TRUE(rb.is_full());
+
+  rb.enqueue(6);
+  EXPECT_EQ(6u, rb.size());
+  for (int i = 1; i < 7; ++i) {
+    EXPECT_EQ(i, rb.dequeue());
+  }
+  EXPECT_FALSE(rb.has_data());
+}
+
+/*
+   Shrink when the buffer is emptied after being mostly unused
+ */
+TEST(TestAdaptiveRingBufferImplementation, shrink) {
+  AdaptiveRingBufferImplementation<int> rb(2, 16);
+
+  for (int i = 0; i < 16; ++i) {
+    rb.enqueue(i);
+  }
+  for (int i = 0; i < 16; ++i) {
+    EXPECT_EQ(i, rb.dequeue());
+  }
+  // It was full since it was last empty.
+  EXPECT_EQ(16u, rb.capacity());
+
+  rb.enqueue(0);
+  rb.dequeue();
+  EXPECT_EQ(8u, rb.capacity());
+  rb.enqueue(0);
+  rb.dequeue();
+  EXPECT_EQ(4u, rb.capacity());
+  rb.enqueue(0);
+  rb.dequeue();
+  EXPECT_EQ(2u, rb.capacity());
+  rb.enqueue(0);
+  rb.dequeue();
+  EXPECT_EQ(2u, rb.capacity());
+
+  // Data is kept in order across resizes with a wrapped around buffer.
+  rb.enqueue(1);
+  rb.enqueue(2);
+  EXPECT_EQ(1, rb.dequeue());
+  rb.enqueue(3);
+  rb.enqueue(4);
+  EXPECT_EQ(4u, rb.capacity());
+  EXPECT_EQ(2, rb.dequeue());
+  EXPECT_EQ(3, rb.dequeue());
+  EXPECT_EQ(4, rb.dequeue());
+
+  rb.enqueue(5);
+  rb.clear();
+  EXPECT_FALSE(rb.has_data());
+  EXPECT_EQ(2u, rb.capacity());
+}
@@ -22,6 +22,7 @@
 // TODO(aprotyas): Figure out better way to suppress deprecation warnings.
 #define RCLCPP_AVOID_DEPRECATIONS_FOR_UNIT_TESTS 1
 #include "rclcpp/any_subscription_callback.hpp"
+#include "rclcpp/detail/resolve_intra_process_buffer_type.hpp"
 #include "test_msgs/msg/empty.hpp"
 #include "test_msgs/msg/empty.h"
 
@@ -622,3 +623,154 @@ INSTANTIATE_TEST_SUITE_P(
   ),
   format_parameter_with_ta
 );
+
+//
+// Versions of `rclcpp::SubscriptionLoanedMessage<MessageT>`
+//
+using LoanedEmpty = rclcpp::SubscriptionLoanedMessage<test_msgs::msg::Empty>;
+
+void loaned_message_free_func(LoanedEmpty) {}
+void loaned_message_w_info_free_func(LoanedEmpty, const rclcpp::MessageInfo &) {}
+
+INSTANTIATE_TEST_SUITE_P(
+  LoanedMessageCallbackTests,
+  DispatchTests,
+  ::testing::Values(
+    // lambda
+    InstanceContext{"lambda", rclcpp::AnySubscriptionCallback<test_msgs::msg::Empty>().set(
+        [](LoanedEmpty) {})},
+    InstanceContext{"lambda_with_info",
+      rclcpp::AnySubscriptionCallback<test_msgs::msg::Empty>().set(
+        [](LoanedEmpty, const rclcpp::MessageInfo &) {})},
+    // free function
+    InstanceContext{"free_function", rclcpp::AnySubscriptionCallback<test_msgs::msg::Empty>().set(
+        loaned_message_free_func)},
+    InstanceContext{"free_function_with_info",
+      rclcpp::AnySubscriptionCallback<test_msgs::msg::Empty>().set(
+        loaned_message_w_info_free_func)}
+  ),
+  format_parameter
+);
+
+TEST_F(TestAnySubscriptionCallback, dispatch_loaned_message) {
+  const test_msgs::msg::Empty * received = nullptr;
+  any_subscription_callback_.set(
+    [&received](LoanedEmpty msg) {
+      EXPECT_TRUE(msg.is_valid());
+      EXPECT_FALSE(msg.is_loaned());
+      received = &msg.get();
+    });
+  EXPECT_TRUE(any_subscription_callback_.is_loaned_message_callback());
+  EXPECT_TRUE(any_subscription_callback_.use_take_shared_method());
+
+  // The message is not copied.
+  any_subscription_callback_.dispatch_loaned_message(LoanedEmpty(msg_shared_ptr_), message_info_);
+  EXPECT_EQ(msg_shared_ptr_.get(), received);
+  received = nullptr;
+  any_subscription_callback_.dispatch_intra_process(msg_shared_ptr_, message_info_);
+  EXPECT_EQ(msg_shared_ptr_.get(), received);
+
+  any_subscription_callback_.set([](const test_msgs::msg::Empty &) {});
+  EXPECT_FALSE(any_subscription_callback_.is_loaned_message_callback());
+  EXPECT_THROW(
+    any_subscription_callback_.dispatch_loaned_message(LoanedEmpty(msg_shared_ptr_), message_info_),
+    std::runtime_error);
+}
+
+// Versions of `rclcpp::LazyMessage<MessageT>`
+using LazyEmpty = rclcpp::LazyMessage<test_msgs::msg::Empty>;
+
+void lazy_message_free_func(LazyEmpty) {}
+void lazy_message_w_info_free_func(LazyEmpty, const rclcpp::MessageInfo &) {}
+
+INSTANTIATE_TEST_SUITE_P(
+  LazyMessageCallbackTests,
+  DispatchTests,
+  ::testing::Values(
+    // lambda
+    InstanceContext{"lambda", rclcpp::AnySubscriptionCallback<test_msgs::msg::Empty>().set(
+        [](LazyEmpty) {})},
+    InstanceContext{"lambda_with_info",
+      rclcpp::AnySubscriptionCallback<test_msgs::msg::Empty>().set(
+        [](LazyEmpty, const rclcpp::MessageInfo &) {})},
+    // free function
+    InstanceContext{"free_function", rclcpp::AnySubscriptionCallback<test_msgs::msg::Empty>().set(
+        lazy_message_free_func)},
+    InstanceContext{"free_function_with_info",
+      rclcpp::AnySubscriptionCallback<test_msgs::msg::Empty>().set(
+        lazy_message_w_info_free_func)}
+  ),
+  format_parameter
+);
+
+TEST_F(TestAnySubscriptionCallback, dispatch_lazy_message) {
+  bool deserialized = true;
+  any_subscription_callback_.set(
+    [&deserialized](LazyEmpty msg) {
+      deserialized = msg.is_deserialized();
+    });
+  EXPECT_TRUE(any_subscription_callback_.is_lazy_message_callback());
+  EXPECT_TRUE(any_subscription_callback_.is_serialized_message_callback());
+  EXPECT_TRUE(any_subscription_callback_.use_take_shared_method());
+
+  // The messages taken from the middleware are not deserialized before the callback.
+  auto serialized_msg = std::make_shared<rclcpp::SerializedMessage>();
+  any_subscription_callback_.dispatch(serialized_msg, message_info_);
+  EXPECT_FALSE(deserialized);
+
+  // The messages received intra process are shared.
+  const test_msgs::msg::Empty * received = nullptr;
+  any_subscription_callback_.set(
+    [&received](LazyEmpty msg) {
+      EXPECT_TRUE(msg.is_deserialized());
+      received = &msg.get();
+    });
+  any_subscription_callback_.dispatch_intra_process(msg_shared_ptr_, message_info_);
+  EXPECT_EQ(msg_shared_ptr_.get(), received);
+}
+
+TEST_F(TestAnySubscriptionCallback, resolve_intra_process_buffer_type) {
+  using rclcpp::IntraProcessBufferType;
+  using rclcpp::detail::intra_process_buffer_copies_messages;
+  using rclcpp::detail::resolve_intra_process_buffer_type;
+
+  // Callbacks which do not take ownership share the messages.
+  any_subscription_callback_.set([](const test_msgs::msg::Empty &) {});
+  EXPECT_FALSE(any_subscription_callback_.takes_message_ownership());
+  EXPECT_EQ(
+    IntraProcessBufferType::SharedPtr,
+    resolve_intra_process_buffer_type(
+      IntraProcessBufferType::CallbackDefault, any_subscription_callback_));
+  any_subscription_callback_.set([](std::shared_ptr<const test_msgs::msg::Empty>) {});
+  EXPECT_FALSE(any_subscription_callback_.takes_message_ownership());
+  EXPECT_EQ(
+    IntraProcessBufferType::SharedPtr,
+    resolve_intra_process_buffer_type(
+      IntraProcessBufferType::CallbackDefault, any_subscription_callback_));
+  EXPECT_FALSE(
+    intra_process_buffer_copies_messages(
+      IntraProcessBufferType::SharedPtr, any_subscription_callback_));
+
+  // Callbacks which take ownership own the messages.
+  any_subscription_callback_.set([](std::unique_ptr<test_msgs::msg::Empty>) {});
+  EXPECT_TRUE(any_subscription_callback_.takes_message_ownership());
+  EXPECT_EQ(
+    IntraProcessBufferType::UniquePtr,
+    resolve_intra_process_buffer_type(
+      IntraProcessBufferType::CallbackDefault, any_subscription_callback_));
+  EXPECT_FALSE(
+    intra_process_buffer_copies_messages(
+      IntraProcessBufferType::UniquePtr, any_subscription_callback_));
+  EXPECT_TRUE(
+    intra_process_buffer_copies_messages(
+      IntraProcessBufferType::SharedPtr, any_subscription_callback_));
+  EXPECT_TRUE(
+    intra_process_buffer_copies_messages(
+      IntraProcessBufferType::LockFreeSharedPtr, any_subscription_callback_));
+
+  // The buffer type set by the user is kept.
+  EXPECT_EQ(
+    IntraProcessBufferType::SharedPtr,
+    resolve_intra_process_buffer_type(
+      IntraProcessBufferType::SharedPtr, any_subscription_callback_));
+}
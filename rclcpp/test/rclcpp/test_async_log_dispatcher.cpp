@@ -0,0 +1,220 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The dispatcher is private to the library, so it is compiled with the test.
+#include "../../src/rclcpp/detail/async_log_dispatcher.cpp"
+
+using rclcpp::AsyncLoggingOverflowPolicy;
+using rclcpp::detail::AsyncLogDispatcher;
+
+namespace
+{
+
+struct OutputRecord
+{
+  std::string name;
+  std::string message;
+  size_t line_number;
+};
+
+std::mutex g_output_mutex;
+std::vector<OutputRecord> g_output;
+// When set, the output handler waits for g_release_output before returning.
+std::atomic<bool> g_hold_output{false};
+std::atomic<bool> g_output_held{false};
+std::atomic<bool> g_release_output{false};
+
+void
+test_output_handler(
+  const rcutils_log_location_t * location,
+  int, const char * name, rcutils_time_point_value_t,
+  const char * format, va_list * args)
+{
+  char buffer[4096];
+  std::vsnprintf(buffer, sizeof(buffer), format, *args);
+  {
+    std::lock_guard<std::mutex> lock(g_output_mutex);
+    g_output.push_back({name, buffer, location ? location->line_number : 0u});
+  }
+  if (g_hold_output.exchange(false)) {
+    g_output_held.store(true);
+    while (!g_release_output.load()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+bool
+push(AsyncLogDispatcher & dispatcher, const char * name, const char * format, ...)
+{
+  static const rcutils_log_location_t location = {"function", "file", 42u};
+  va_list args;
+  va_start(args, format);
+  const bool pushed = dispatcher.push(
+    &location, RCUTILS_LOG_SEVERITY_INFO, name, 0, format, &args);
+  va_end(args);
+  return pushed;
+}
+
+class TestAsyncLogDispatcher : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    g_output.clear();
+    g_hold_output.store(false);
+    g_output_held.store(false);
+    g_release_output.store(false);
+    dispatcher = std::make_unique<AsyncLogDispatcher>(
+      test_output_handler, std::make_shared<std::recursive_mutex>());
+  }
+
+  /// Wait until the background thread is blocked in the output handler.
+  void hold_output()
+  {
+    g_hold_output.store(true);
+    ASSERT_TRUE(push(*dispatcher, "held", "held"));
+    while (!g_output_held.load()) {
+      std::this_thread::yield();
+    }
+  }
+
+  std::unique_ptr<AsyncLogDispatcher> dispatcher;
+};
+
+}  // namespace
+
+TEST_F(TestAsyncLogDispatcher, not_started) {
+  EXPECT_FALSE(push(*dispatcher, "logger", "message"));
+  dispatcher->start(8u, AsyncLoggingOverflowPolicy::Drop);
+  dispatcher->stop();
+  EXPECT_FALSE(push(*dispatcher, "logger", "message"));
+  EXPECT_TRUE(g_output.empty());
+}
+
+TEST_F(TestAsyncLogDispatcher, output_in_order) {
+  dispatcher->start(4u, AsyncLoggingOverflowPolicy::Block);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(push(*dispatcher, "logger", "message %d", i));
+  }
+  const std::string long_message(3000u, 'x');
+  EXPECT_TRUE(push(*dispatcher, "other_logger", "%s", long_message.c_str()));
+  dispatcher->stop();
+
+  ASSERT_EQ(101u, g_output.size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ("logger", g_output[i].name);
+    EXPECT_EQ("message " + std::to_string(i), g_output[i].message);
+    EXPECT_EQ(42u, g_output[i].line_number);
+  }
+  EXPECT_EQ("other_logger", g_output.back().name);
+  EXPECT_EQ(long_message, g_output.back().message);
+  EXPECT_EQ(0u, dispatcher->get_dropped_count());
+}
+
+TEST_F(TestAsyncLogDispatcher, drop_when_full) {
+  dispatcher->start(2u, AsyncLoggingOverflowPolicy::Drop);
+  hold_output();
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(push(*dispatcher, "logger", "message %d", i));
+  }
+  // The slot of the record being output is only free once it is output.
+  EXPECT_EQ(4u, dispatcher->get_dropped_count());
+  g_release_output.store(true);
+  dispatcher->stop();
+
+  ASSERT_EQ(2u, g_output.size());
+  EXPECT_EQ("held", g_output[0].message);
+  EXPECT_EQ("message 0", g_output[1].message);
+}
+
+TEST_F(TestAsyncLogDispatcher, block_when_full) {
+  dispatcher->start(2u, AsyncLoggingOverflowPolicy::Block);
+  hold_output();
+  std::atomic<int> pushed{0};
+  std::thread producer(
+    [this, &pushed]() {
+      for (int i = 0; i < 5; ++i) {
+        push(*dispatcher, "logger", "message %d", i);
+        ++pushed;
+      }
+    });
+  // The second record waits for the output handler, which is busy with the held record.
+  while (pushed.load() < 1) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(1, pushed.load());
+  g_release_output.store(true);
+  producer.join();
+  dispatcher->stop();
+
+  ASSERT_EQ(6u, g_output.size());
+  EXPECT_EQ("held", g_output[0].message);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ("message " + std::to_string(i), g_output[i + 1].message);
+  }
+  EXPECT_EQ(0u, dispatcher->get_dropped_count());
+}
+
+TEST_F(TestAsyncLogDispatcher, concurrent_producers) {
+  constexpr int kThreads = 4;
+  constexpr int kRecordsPerThread = 1000;
+  dispatcher->start(64u, AsyncLoggingOverflowPolicy::Block);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back(
+      [this, i]() {
+        const std::string name = "logger_" + std::to_string(i);
+        for (int j = 0; j < kRecordsPerThread; ++j) {
+          push(*dispatcher, name.c_str(), "%d", j);
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  dispatcher->stop();
+
+  ASSERT_EQ(static_cast<size_t>(kThreads * kRecordsPerThread), g_output.size());
+  // The records of each thread are output in order.
+  std::vector<int> next(kThreads, 0);
+  for (const auto & record : g_output) {
+    const int thread_index = std::stoi(record.name.substr(7u));
+    EXPECT_EQ(std::to_string(next[thread_index]++), record.message);
+  }
+}
+
+TEST_F(TestAsyncLogDispatcher, restart) {
+  dispatcher->start(8u, AsyncLoggingOverflowPolicy::Drop);
+  EXPECT_TRUE(push(*dispatcher, "logger", "first"));
+  dispatcher->stop();
+  dispatcher->start(8u, AsyncLoggingOverflowPolicy::Drop);
+  EXPECT_TRUE(push(*dispatcher, "logger", "second"));
+  dispatcher->stop();
+  ASSERT_EQ(2u, g_output.size());
+  EXPECT_EQ("second", g_output[1].message);
+}
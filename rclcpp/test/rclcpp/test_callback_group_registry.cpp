@@ -0,0 +1,96 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "rclcpp/detail/callback_group_registry.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+using Registry = rclcpp::detail::CallbackGroupRegistry;
+
+class TestCallbackGroupRegistry : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    rclcpp::init(0, nullptr);
+    node = std::make_shared<rclcpp::Node>("test_callback_group_registry_node");
+  }
+
+  void TearDown() override
+  {
+    node.reset();
+    rclcpp::shutdown();
+  }
+
+  rclcpp::Node::SharedPtr node;
+};
+
+TEST_F(TestCallbackGroupRegistry, add_find_remove) {
+  Registry registry;
+  auto node_base = node->get_node_base_interface();
+  auto group = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  auto other_group = node->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+  EXPECT_FALSE(registry.has_node(node_base.get()));
+
+  const Registry::Id id = registry.add(group, node_base);
+  ASSERT_NE(Registry::invalid_id, id);
+  EXPECT_EQ(Registry::invalid_id, registry.add(group, node_base));
+  const Registry::Id other_id = registry.add(other_group, node_base);
+  ASSERT_NE(Registry::invalid_id, other_id);
+  EXPECT_NE(id, other_id);
+  EXPECT_EQ(2u, registry.size());
+
+  EXPECT_EQ(id, registry.find(group.get()));
+  EXPECT_EQ(group, registry.get_group(id));
+  EXPECT_EQ(node_base, registry.get_node(id));
+  EXPECT_TRUE(registry.has_node(node_base.get()));
+
+  // The node is only gone with its last group.
+  EXPECT_FALSE(registry.remove(group.get()));
+  EXPECT_EQ(Registry::invalid_id, registry.find(group.get()));
+  EXPECT_TRUE(registry.has_node(node_base.get()));
+  EXPECT_FALSE(registry.remove(group.get()));
+  EXPECT_TRUE(registry.remove(other_group.get()));
+  EXPECT_FALSE(registry.has_node(node_base.get()));
+  EXPECT_EQ(0u, registry.size());
+
+  // Ids are reused.
+  EXPECT_EQ(other_id, registry.add(other_group, node_base));
+}
+
+TEST_F(TestCallbackGroupRegistry, remove_expired) {
+  Registry registry;
+  auto node_base = node->get_node_base_interface();
+  auto group = node->create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive, false);
+  auto other_group = node->create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive, false);
+  registry.add(group, node_base);
+  registry.add(other_group, node_base);
+
+  group.reset();
+  EXPECT_EQ(1u, registry.remove_expired());
+  EXPECT_EQ(1u, registry.size());
+  EXPECT_TRUE(registry.has_node(node_base.get()));
+  EXPECT_EQ(0u, registry.remove_expired());
+
+  // Groups of a destroyed node are expired as well.
+  node_base.reset();
+  node.reset();
+  EXPECT_EQ(1u, registry.remove_expired());
+  EXPECT_EQ(0u, registry.size());
+}
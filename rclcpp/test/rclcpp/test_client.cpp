@@ -14,6 +14,8 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <future>
 #include <string>
 #include <memory>
 #include <utility>
@@ -271,6 +273,75 @@ TEST_F(TestClientWithServer, async_send_request_callback_with_request) {
   EXPECT_FALSE(client->remove_pending_request(req_id));
 }
 
+TEST_F(TestClientWithServer, async_send_request_response_callback) {
+  using SharedResponse = rclcpp::Client<test_msgs::srv::Empty>::SharedResponse;
+
+  auto client = node->create_client<test_msgs::srv::Empty>(service_name);
+  ASSERT_TRUE(client->wait_for_service(std::chrono::seconds(1)));
+
+  auto request = std::make_shared<test_msgs::srv::Empty::Request>();
+  bool received_response = false;
+  auto callback = [&received_response](SharedResponse response) {
+      EXPECT_NE(nullptr, response);
+      received_response = true;
+    };
+  int64_t req_id = client->async_send_request(request, std::move(callback));
+
+  auto start = std::chrono::steady_clock::now();
+  while (!received_response &&
+    (std::chrono::steady_clock::now() - start) < std::chrono::seconds(1))
+  {
+    rclcpp::spin_some(node);
+  }
+  EXPECT_TRUE(received_response);
+  EXPECT_FALSE(client->remove_pending_request(req_id));
+
+  // A request without response stays pending until it is removed.
+  auto unanswered_client = node->create_client<test_msgs::srv::Empty>("no_service_here");
+  req_id = unanswered_client->async_send_request(request, [](SharedResponse) {});
+  EXPECT_TRUE(unanswered_client->remove_pending_request(req_id));
+}
+
+TEST_F(TestClientWithServer, response_cache) {
+  using SharedResponse = rclcpp::Client<test_msgs::srv::Empty>::SharedResponse;
+
+  auto client = node->create_client<test_msgs::srv::Empty>(service_name);
+  ASSERT_TRUE(client->wait_for_service(std::chrono::seconds(1)));
+  client->enable_response_cache(std::chrono::hours(1));
+
+  auto request = std::make_shared<test_msgs::srv::Empty::Request>();
+  SharedResponse received_response;
+  auto callback = [&received_response](SharedResponse response) {
+      received_response = response;
+    };
+  EXPECT_NE(0, client->async_send_request(request, callback));
+  auto start = std::chrono::steady_clock::now();
+  while (!received_response &&
+    (std::chrono::steady_clock::now() - start) < std::chrono::seconds(1))
+  {
+    rclcpp::spin_some(node);
+  }
+  ASSERT_NE(nullptr, received_response);
+
+  // An equal request is answered with the cached response, without being sent.
+  auto future = client->async_send_request(std::make_shared<test_msgs::srv::Empty::Request>());
+  EXPECT_EQ(0, future.request_id);
+  ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(0)));
+  EXPECT_EQ(received_response, future.get());
+
+  SharedResponse cached_response;
+  EXPECT_EQ(
+    0, client->async_send_request(
+      request, [&cached_response](SharedResponse response) {cached_response = response;}));
+  EXPECT_EQ(received_response, cached_response);
+
+  // Once invalidated, the request is sent again.
+  client->invalidate_response_cache();
+  auto sent_future = client->async_send_request(request);
+  EXPECT_NE(0, sent_future.request_id);
+  EXPECT_TRUE(client->remove_pending_request(sent_future));
+}
+
 TEST_F(TestClientWithServer, test_client_remove_pending_request) {
   auto client = node->create_client<test_msgs::srv::Empty>("no_service_server_available_here");
   auto request = std::make_shared<test_msgs::srv::Empty::Request>();
@@ -0,0 +1,156 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rclcpp/content_filter.hpp"
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+#include "test_msgs/msg/arrays.hpp"
+#include "test_msgs/msg/basic_types.hpp"
+#include "test_msgs/msg/nested.hpp"
+#include "test_msgs/msg/strings.hpp"
+
+template<typename MessageT>
+rclcpp::ContentFilter
+make_filter(
+  const std::string & filter_expression,
+  const std::vector<std::string> & expression_parameters = {})
+{
+  return rclcpp::ContentFilter(
+    rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>(),
+    filter_expression, expression_parameters);
+}
+
+TEST(TestContentFilter, comparisons) {
+  using test_msgs::msg::BasicTypes;
+  BasicTypes message;
+  message.int32_value = 5;
+  message.uint64_value = 10;
+  message.float64_value = 0.5;
+  message.bool_value = true;
+
+  EXPECT_TRUE(make_filter<BasicTypes>("int32_value = 5").matches(&message));
+  EXPECT_FALSE(make_filter<BasicTypes>("int32_value <> 5").matches(&message));
+  EXPECT_TRUE(make_filter<BasicTypes>("int32_value != 4").matches(&message));
+  EXPECT_TRUE(make_filter<BasicTypes>("int32_value < 6").matches(&message));
+  EXPECT_FALSE(make_filter<BasicTypes>("int32_value < 5").matches(&message));
+  EXPECT_TRUE(make_filter<BasicTypes>("int32_value <= 5").matches(&message));
+  EXPECT_TRUE(make_filter<BasicTypes>("int32_value > -6").matches(&message));
+  EXPECT_TRUE(make_filter<BasicTypes>("int32_value >= 5.0").matches(&message));
+  EXPECT_TRUE(make_filter<BasicTypes>("6 > int32_value").matches(&message));
+  EXPECT_TRUE(make_filter<BasicTypes>("uint64_value > int32_value").matches(&message));
+  EXPECT_TRUE(make_filter<BasicTypes>("float64_value = 5e-1").matches(&message));
+  EXPECT_TRUE(make_filter<BasicTypes>("bool_value = TRUE").matches(&message));
+  EXPECT_FALSE(make_filter<BasicTypes>("bool_value = false").matches(&message));
+  EXPECT_TRUE(make_filter<BasicTypes>("int32_value BETWEEN 5 AND 6").matches(&message));
+  EXPECT_FALSE(make_filter<BasicTypes>("int32_value NOT BETWEEN 5 AND 6").matches(&message));
+}
+
+TEST(TestContentFilter, logical_operators) {
+  using test_msgs::msg::BasicTypes;
+  BasicTypes message;
+  message.int8_value = 1;
+  message.int16_value = 2;
+
+  EXPECT_TRUE(make_filter<BasicTypes>("int8_value = 1 AND int16_value = 2").matches(&message));
+  EXPECT_FALSE(make_filter<BasicTypes>("int8_value = 1 AND int16_value = 3").matches(&message));
+  EXPECT_TRUE(make_filter<BasicTypes>("int8_value = 0 or int16_value = 2").matches(&message));
+  EXPECT_FALSE(make_filter<BasicTypes>("NOT int8_value = 1").matches(&message));
+  // AND takes precedence over OR.
+  EXPECT_TRUE(
+    make_filter<BasicTypes>("int8_value = 1 OR int8_value = 0 AND int16_value = 0")
+    .matches(&message));
+  EXPECT_FALSE(
+    make_filter<BasicTypes>("(int8_value = 1 OR int8_value = 0) AND int16_value = 0")
+    .matches(&message));
+}
+
+TEST(TestContentFilter, strings) {
+  using test_msgs::msg::Strings;
+  Strings message;
+  message.string_value = "Hello world";
+
+  EXPECT_TRUE(make_filter<Strings>("string_value = 'Hello world'").matches(&message));
+  EXPECT_TRUE(make_filter<Strings>("string_value > 'Hello'").matches(&message));
+  EXPECT_TRUE(make_filter<Strings>("string_value LIKE 'Hello%'").matches(&message));
+  EXPECT_TRUE(make_filter<Strings>("string_value LIKE '%o w%'").matches(&message));
+  EXPECT_TRUE(make_filter<Strings>("string_value LIKE 'H_llo world'").matches(&message));
+  EXPECT_FALSE(make_filter<Strings>("string_value LIKE 'Hello'").matches(&message));
+  EXPECT_TRUE(make_filter<Strings>("string_value NOT LIKE '%!'").matches(&message));
+  EXPECT_TRUE(make_filter<Strings>("bounded_string_value = ''").matches(&message));
+}
+
+TEST(TestContentFilter, nested_fields) {
+  using test_msgs::msg::Nested;
+  Nested message;
+  message.basic_types_value.uint32_value = 42;
+
+  EXPECT_TRUE(make_filter<Nested>("basic_types_value.uint32_value = 42").matches(&message));
+  EXPECT_FALSE(make_filter<Nested>("basic_types_value.uint32_value > 42").matches(&message));
+}
+
+TEST(TestContentFilter, parameters) {
+  using test_msgs::msg::Strings;
+  Strings message;
+  message.string_value = "map";
+
+  auto filter = make_filter<Strings>("string_value = %1 OR string_value = %0", {"'odom'", "'map'"});
+  EXPECT_TRUE(filter.matches(&message));
+  EXPECT_EQ("string_value = %1 OR string_value = %0", filter.get_options().filter_expression);
+  EXPECT_EQ(
+    std::vector<std::string>({"'odom'", "'map'"}), filter.get_options().expression_parameters);
+
+  using test_msgs::msg::BasicTypes;
+  BasicTypes basic_types;
+  basic_types.int64_value = -3;
+  EXPECT_TRUE(make_filter<BasicTypes>("int64_value = %0", {"-3"}).matches(&basic_types));
+}
+
+TEST(TestContentFilter, invalid_expressions) {
+  using test_msgs::msg::BasicTypes;
+  const std::vector<std::string> invalid_expressions = {
+    "",
+    "int32_value",
+    "int32_value = ",
+    "int32_value == 1",
+    "unknown_value = 1",
+    "int32_value.value = 1",
+    "int32_value = 'one'",
+    "int32_value LIKE 'one'",
+    "int32_value NOT = 1",
+    "int32_value BETWEEN 1 2",
+    "1 = 1",
+    "(int32_value = 1",
+    "int32_value = 1)",
+    "int32_value = %0",
+    "int32_value = 1 AND",
+    "int32_value = 'unterminated",
+    "int32_value = 1x",
+  };
+  for (const std::string & expression : invalid_expressions) {
+    EXPECT_THROW(make_filter<BasicTypes>(expression), std::invalid_argument) << expression;
+  }
+  EXPECT_THROW(
+    make_filter<BasicTypes>("int32_value = %0", {"int64_value"}), std::invalid_argument);
+  EXPECT_THROW(
+    make_filter<test_msgs::msg::Arrays>("int32_values = 1"), std::invalid_argument);
+  EXPECT_THROW(
+    rclcpp::ContentFilter(nullptr, "int32_value = 1"), std::invalid_argument);
+}
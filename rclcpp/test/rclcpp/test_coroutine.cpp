@@ -0,0 +1,153 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "rclcpp/coroutine.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "test_msgs/msg/basic_types.hpp"
+#include "test_msgs/srv/basic_types.hpp"
+
+using namespace std::chrono_literals;
+
+#ifdef RCLCPP_HAS_COROUTINES
+
+class TestCoroutine : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp()
+  {
+    node = std::make_shared<rclcpp::Node>("test_coroutine", "/ns");
+    executor.add_node(node);
+  }
+
+  void TearDown()
+  {
+    executor.remove_node(node);
+    node.reset();
+  }
+
+  template<typename ConditionT>
+  void spin_until(ConditionT condition)
+  {
+    auto start = std::chrono::steady_clock::now();
+    while (!condition() && std::chrono::steady_clock::now() - start < 10s) {
+      executor.spin_some(10ms);
+    }
+  }
+
+  rclcpp::Node::SharedPtr node;
+  rclcpp::executors::SingleThreadedExecutor executor;
+};
+
+using test_msgs::srv::BasicTypes;
+
+rclcpp::Task
+increment_twice(
+  rclcpp::Client<BasicTypes>::SharedPtr client,
+  int32_t value,
+  std::vector<int32_t> & values)
+{
+  auto request = std::make_shared<BasicTypes::Request>();
+  request->int32_value = value;
+  auto response = co_await rclcpp::send_request_awaitable<BasicTypes>(client, request);
+  values.push_back(response->int32_value);
+  request->int32_value = response->int32_value;
+  response = co_await rclcpp::send_request_awaitable<BasicTypes>(client, request);
+  values.push_back(response->int32_value);
+}
+
+/*
+   Testing a chain of requests awaited on a single threaded executor.
+ */
+TEST_F(TestCoroutine, send_request_awaitable) {
+  auto service = node->create_service<BasicTypes>(
+    "increment",
+    [](BasicTypes::Request::SharedPtr request, BasicTypes::Response::SharedPtr response) {
+      response->int32_value = request->int32_value + 1;
+    });
+  auto client = node->create_client<BasicTypes>("increment");
+  ASSERT_TRUE(client->wait_for_service(10s));
+
+  std::vector<int32_t> values;
+  increment_twice(client, 40, values);
+  // The coroutine is suspended until the executor executes the responses.
+  EXPECT_TRUE(values.empty());
+  spin_until([&values]() {return values.size() == 2u;});
+  EXPECT_EQ(std::vector<int32_t>({41, 42}), values);
+}
+
+rclcpp::Task
+receive_message(
+  rclcpp::Node::SharedPtr node,
+  std::chrono::milliseconds time_to_wait,
+  std::shared_ptr<const test_msgs::msg::BasicTypes> & message,
+  bool & done)
+{
+  message = co_await rclcpp::wait_for_message_awaitable<test_msgs::msg::BasicTypes>(
+    node, "coroutine_topic", rclcpp::QoS(1), time_to_wait);
+  done = true;
+}
+
+/*
+   Testing the messages and the timeouts awaited on a single threaded executor.
+ */
+TEST_F(TestCoroutine, wait_for_message_awaitable) {
+  auto publisher = node->create_publisher<test_msgs::msg::BasicTypes>("coroutine_topic", 1);
+  std::shared_ptr<const test_msgs::msg::BasicTypes> message;
+  bool done = false;
+  receive_message(node, 10s, message, done);
+  EXPECT_FALSE(done);
+
+  test_msgs::msg::BasicTypes published_message;
+  published_message.int32_value = 42;
+  // Published until the subscription is matched by the middleware.
+  spin_until(
+    [&publisher, &published_message, &done]() {
+      publisher->publish(published_message);
+      return done;
+    });
+  ASSERT_TRUE(done);
+  ASSERT_NE(nullptr, message);
+  EXPECT_EQ(42, message->int32_value);
+
+  done = false;
+  receive_message(node, 10ms, message, done);
+  spin_until([&done]() {return done;});
+  ASSERT_TRUE(done);
+  EXPECT_EQ(nullptr, message);
+}
+
+#else
+
+TEST(TestCoroutine, not_supported) {
+  GTEST_SKIP() << "the compiler does not support coroutines";
+}
+
+#endif  // RCLCPP_HAS_COROUTINES
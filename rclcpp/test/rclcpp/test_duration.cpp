@@ -321,3 +321,18 @@ TEST_F(TestDuration, test_some_exceptions) {
     test_duration = test_duration * (std::numeric_limits<double>::infinity()),
     std::runtime_error("abnormal scale in rclcpp::Duration"));
 }
+
+TEST_F(TestDuration, saturating_arithmetic) {
+  auto max = rclcpp::Duration::from_nanoseconds(std::numeric_limits<rcl_duration_value_t>::max());
+  auto min = rclcpp::Duration::from_nanoseconds(std::numeric_limits<rcl_duration_value_t>::min());
+  rclcpp::Duration one(1ns);
+
+  EXPECT_EQ(max, max.saturating_add(one));
+  EXPECT_EQ(min, min.saturating_sub(one));
+  EXPECT_EQ(max, one.saturating_sub(min));
+  EXPECT_EQ(rclcpp::Duration(2ns), one.saturating_add(one));
+  EXPECT_EQ(rclcpp::Duration(0ns), one.saturating_sub(one));
+
+  // The smallest representable duration is the result of a valid addition.
+  EXPECT_EQ(min, rclcpp::Duration(-1ns) + (min + one));
+}
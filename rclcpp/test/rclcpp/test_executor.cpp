@@ -18,12 +18,18 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "rclcpp/executor.hpp"
+#include "rclcpp/executors.hpp"
 #include "rclcpp/memory_strategy.hpp"
 #include "rclcpp/executors/single_threaded_executor.hpp"
 #include "rclcpp/strategies/allocator_memory_strategy.hpp"
 
+#include "test_msgs/msg/basic_types.hpp"
+#include "test_msgs/msg/empty.hpp"
+
 #include "../mocking_utils/patch.hpp"
 #include "../utils/rclcpp_gtest_macros.hpp"
 
@@ -33,8 +39,8 @@
 class DummyExecutor : public rclcpp::Executor
 {
 public:
-  DummyExecutor()
-  : rclcpp::Executor()
+  explicit DummyExecutor(const rclcpp::ExecutorOptions & options = rclcpp::ExecutorOptions())
+  : rclcpp::Executor(options)
   {
   }
 
@@ -346,21 +352,21 @@ TEST_F(TestExecutor, set_memory_strategy) {
   EXPECT_EQ(dummy.memory_strategy_ptr(), strategy.get());
 }
 
-TEST_F(TestExecutor, spin_once_failed_trigger_guard_condition) {
+TEST_F(TestExecutor, spin_once_does_not_trigger_guard_condition) {
   DummyExecutor dummy;
   auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  bool timer_called = false;
   auto timer =
-    node->create_wall_timer(std::chrono::milliseconds(1), [&]() {});
+    node->create_wall_timer(std::chrono::milliseconds(1), [&]() {timer_called = true;});
 
   dummy.add_node(node);
   // Wait for the wall timer to have expired.
   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  // No other thread is waiting for work, so executing the timer does not interrupt a wait.
   auto mock = mocking_utils::patch_and_return(
     "lib:rclcpp", rcl_trigger_guard_condition, RCL_RET_ERROR);
-  RCLCPP_EXPECT_THROW_EQ(
-    dummy.spin_once(std::chrono::milliseconds(1)),
-    std::runtime_error(
-      "Failed to trigger guard condition from execute_any_executable: error not set"));
+  EXPECT_NO_THROW(dummy.spin_once(std::chrono::milliseconds(1)));
+  EXPECT_TRUE(timer_called);
 }
 
 TEST_F(TestExecutor, spin_some_fail_wait_set_clear) {
@@ -556,3 +562,175 @@ TEST_F(TestExecutor, spin_until_future_complete_future_already_complete) {
     rclcpp::FutureReturnCode::SUCCESS,
     dummy.spin_until_future_complete(future, std::chrono::milliseconds(1)));
 }
+
+TEST_F(TestExecutor, prepare_for_real_time) {
+  DummyExecutor dummy;
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  size_t number_of_messages = 0;
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    "topic", 10, [&number_of_messages](test_msgs::msg::Empty::ConstSharedPtr) {
+      ++number_of_messages;
+    });
+  bool timer_called = false;
+  auto timer = node->create_wall_timer(
+    std::chrono::milliseconds(1), [&timer_called]() {timer_called = true;});
+  dummy.add_node(node);
+
+  EXPECT_NO_THROW(dummy.prepare_for_real_time());
+  // The entities are collected before spinning.
+  EXPECT_LE(1u, dummy.memory_strategy_ptr()->number_of_ready_subscriptions());
+  EXPECT_LE(1u, dummy.memory_strategy_ptr()->number_of_ready_timers());
+  EXPECT_EQ(0u, number_of_messages);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  dummy.spin_some();
+  EXPECT_TRUE(timer_called);
+}
+
+TEST_F(TestExecutor, spin_some_free_function_reuses_executor) {
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  bool timer_called = false;
+  auto timer = node->create_wall_timer(
+    std::chrono::milliseconds(1), [&timer_called]() {timer_called = true;});
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  rclcpp::spin_some(node);
+  EXPECT_TRUE(timer_called);
+  // The node stays in the executor of rclcpp::spin_some() between the calls.
+  EXPECT_TRUE(node->get_node_base_interface()->get_associated_with_executor_atomic().load());
+  timer_called = false;
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  rclcpp::spin_some(node);
+  EXPECT_TRUE(timer_called);
+
+  // Which gives it up when it is added to another executor.
+  DummyExecutor dummy;
+  EXPECT_NO_THROW(dummy.add_node(node->get_node_base_interface(), false));
+  timer_called = false;
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  dummy.spin_some();
+  EXPECT_TRUE(timer_called);
+  EXPECT_THROW(rclcpp::spin_some(node), std::runtime_error);
+  dummy.remove_node(node->get_node_base_interface(), false);
+
+  timer_called = false;
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  rclcpp::spin_some(node);
+  EXPECT_TRUE(timer_called);
+
+  // Or when one of its callback groups is added to another executor.
+  auto callback_group = node->create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive);
+  rclcpp::spin_some(node);
+  EXPECT_TRUE(callback_group->get_associated_with_executor_atomic().load());
+  EXPECT_NO_THROW(dummy.add_callback_group(callback_group, node->get_node_base_interface()));
+  dummy.remove_callback_group(callback_group);
+}
+
+TEST_F(TestExecutor, take_pipeline_keeps_message_order) {
+  rclcpp::ExecutorOptions options;
+  options.take_pipeline_threads = 2u;
+  rclcpp::executors::SingleThreadedExecutor executor(options);
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  rclcpp::SubscriptionOptions subscription_options;
+  subscription_options.max_messages_per_take = 10u;
+  std::vector<int32_t> received;
+  auto subscription = node->create_subscription<test_msgs::msg::BasicTypes>(
+    "topic", 100, [&received](test_msgs::msg::BasicTypes::ConstSharedPtr msg) {
+      received.push_back(msg->int32_value);
+    }, subscription_options);
+  auto publisher = node->create_publisher<test_msgs::msg::BasicTypes>("topic", 100);
+  executor.add_node(node);
+
+  constexpr int32_t number_of_messages = 25;
+  for (int32_t i = 0; i < number_of_messages; ++i) {
+    test_msgs::msg::BasicTypes msg;
+    msg.int32_value = i;
+    publisher->publish(msg);
+  }
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (received.size() < static_cast<size_t>(number_of_messages) &&
+    std::chrono::steady_clock::now() < deadline)
+  {
+    executor.spin_some(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(static_cast<size_t>(number_of_messages), received.size());
+  for (int32_t i = 0; i < number_of_messages; ++i) {
+    EXPECT_EQ(i, received[static_cast<size_t>(i)]);
+  }
+}
+
+TEST_F(TestExecutor, shared_node_notifications) {
+  rclcpp::ExecutorOptions options;
+  options.shared_node_notifications = true;
+  DummyExecutor dummy(options);
+  std::vector<rclcpp::Node::SharedPtr> nodes;
+  nodes.push_back(std::make_shared<rclcpp::Node>("node_0", "ns"));
+  dummy.add_node(nodes.back());
+  dummy.spin_some(std::chrono::milliseconds(1));
+  const size_t number_of_guard_conditions =
+    dummy.memory_strategy_ptr()->number_of_guard_conditions();
+
+  // The nodes are not waited on one by one.
+  for (int i = 1; i < 20; ++i) {
+    nodes.push_back(std::make_shared<rclcpp::Node>("node_" + std::to_string(i), "ns"));
+    dummy.add_node(nodes.back());
+  }
+  dummy.spin_some(std::chrono::milliseconds(1));
+  EXPECT_EQ(
+    number_of_guard_conditions, dummy.memory_strategy_ptr()->number_of_guard_conditions());
+
+  // An entity created after the node was added is still collected.
+  bool timer_called = false;
+  auto timer = nodes[10]->create_wall_timer(
+    std::chrono::milliseconds(1), [&timer_called]() {timer_called = true;});
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!timer_called && std::chrono::steady_clock::now() < deadline) {
+    dummy.spin_some(std::chrono::milliseconds(10));
+  }
+  EXPECT_TRUE(timer_called);
+
+  for (const auto & node : nodes) {
+    dummy.remove_node(node);
+  }
+}
+
+TEST_F(TestExecutor, overload_sheds_lowest_priority) {
+  rclcpp::ExecutorOptions options;
+  options.scheduling_policy = rclcpp::ExecutorSchedulingPolicy::Priority;
+  options.overload.max_ready_count = 1u;
+  rclcpp::executors::SingleThreadedExecutor executor(options);
+  auto node = std::make_shared<rclcpp::Node>("node", "ns");
+  auto high_priority_group = node->create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive);
+  high_priority_group->set_priority(1);
+  auto low_priority_group = node->create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive);
+  low_priority_group->set_overload_policy(rclcpp::CallbackGroupOverloadPolicy::Shed);
+  std::vector<rclcpp::OverloadEvent> events;
+  low_priority_group->set_backpressure_callback(
+    [&events](const rclcpp::OverloadEvent & event) {events.push_back(event);});
+
+  size_t high_priority_calls = 0;
+  size_t low_priority_calls = 0;
+  auto high_priority_timer = node->create_wall_timer(
+    std::chrono::milliseconds(10), [&high_priority_calls]() {++high_priority_calls;},
+    high_priority_group);
+  auto low_priority_timer = node->create_wall_timer(
+    std::chrono::milliseconds(10), [&low_priority_calls]() {++low_priority_calls;},
+    low_priority_group);
+  executor.add_node(node);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  // Both timers are found ready by one wait, only the first one dispatched is executed.
+  executor.spin_some();
+  EXPECT_EQ(1u, high_priority_calls);
+  EXPECT_EQ(0u, low_priority_calls);
+  EXPECT_EQ(1u, executor.get_overload_count());
+  EXPECT_EQ(0u, high_priority_group->get_shed_count());
+  EXPECT_EQ(1u, low_priority_group->get_shed_count());
+  ASSERT_EQ(1u, events.size());
+  EXPECT_TRUE(events[0].shed);
+  EXPECT_EQ(rclcpp::CallbackGroupOverloadPolicy::Shed, events[0].policy);
+  EXPECT_LE(2u, events[0].ready_count);
+}
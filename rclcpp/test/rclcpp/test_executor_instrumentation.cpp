@@ -0,0 +1,260 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/executor_instrumentation.hpp"
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rclcpp/executors/static_single_threaded_executor.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+using namespace std::chrono_literals;
+
+using rclcpp::ExecutableExecution;
+using rclcpp::ExecutableType;
+using rclcpp::ExecutionStatisticsCollector;
+
+namespace
+{
+
+ExecutableExecution
+make_execution(
+  const void * entity,
+  const rclcpp::CallbackGroup * callback_group,
+  std::chrono::nanoseconds dispatch_latency,
+  std::chrono::nanoseconds duration)
+{
+  return {ExecutableType::Waitable, entity, callback_group, dispatch_latency, duration};
+}
+
+}  // namespace
+
+TEST(TestExecutionStatisticsCollector, accumulate_per_entity_and_callback_group) {
+  ExecutionStatisticsCollector collector;
+  const rclcpp::Waitable * waitable = reinterpret_cast<const rclcpp::Waitable *>(0x1000);
+  const rclcpp::Waitable * other_waitable = reinterpret_cast<const rclcpp::Waitable *>(0x2000);
+  const auto group = reinterpret_cast<const rclcpp::CallbackGroup *>(0x3000);
+
+  collector.on_execute(make_execution(waitable, group, 1us, 10us));
+  collector.on_execute(make_execution(waitable, group, 3us, 30us));
+  collector.on_execute(make_execution(other_waitable, group, 2us, 20us));
+
+  auto statistics = collector.get_entity_statistics(waitable);
+  EXPECT_EQ(2u, statistics.count);
+  EXPECT_EQ(40us, statistics.total_duration);
+  EXPECT_EQ(30us, statistics.max_duration);
+  EXPECT_EQ(4us, statistics.total_dispatch_latency);
+  EXPECT_EQ(3us, statistics.max_dispatch_latency);
+
+  statistics = collector.get_callback_group_statistics(group);
+  EXPECT_EQ(3u, statistics.count);
+  EXPECT_EQ(60us, statistics.total_duration);
+
+  EXPECT_EQ(2u, collector.get_all_entity_statistics().size());
+  const auto unknown_waitable = reinterpret_cast<const rclcpp::Waitable *>(0x4000);
+  EXPECT_EQ(0u, collector.get_entity_statistics(unknown_waitable).count);
+  EXPECT_EQ(0u, collector.get_untracked_execution_count());
+}
+
+TEST(TestExecutionStatisticsCollector, untracked_executions) {
+  ExecutionStatisticsCollector collector(1u);
+  for (uintptr_t address = 0x1000; address < 0x1000 + 16 * 0x100; address += 0x100) {
+    collector.on_execute(
+      make_execution(reinterpret_cast<const void *>(address), nullptr, 0ns, 1us));
+  }
+  const auto all_statistics = collector.get_all_entity_statistics();
+  ASSERT_FALSE(all_statistics.empty());
+  EXPECT_EQ(16u, all_statistics.size() + collector.get_untracked_execution_count());
+}
+
+TEST(TestExecutionStatisticsCollector, wait_statistics) {
+  ExecutionStatisticsCollector collector;
+  collector.on_wait(5ms);
+  collector.on_wait(1ms);
+  const auto statistics = collector.get_wait_statistics();
+  EXPECT_EQ(2u, statistics.count);
+  EXPECT_EQ(6ms, statistics.total_duration);
+  EXPECT_EQ(5ms, statistics.max_duration);
+}
+
+TEST(TestExecutionStatisticsCollector, overrun_count) {
+  ExecutionStatisticsCollector collector;
+  const rclcpp::Waitable * waitable = reinterpret_cast<const rclcpp::Waitable *>(0x1000);
+  const auto group = reinterpret_cast<const rclcpp::CallbackGroup *>(0x3000);
+
+  auto execution = make_execution(waitable, group, 0us, 10us);
+  collector.on_execute(execution);
+  execution.budget = 20us;
+  collector.on_execute(execution);
+  execution.budget = 5us;
+  collector.on_execute(execution);
+
+  EXPECT_EQ(1u, collector.get_entity_statistics(waitable).overrun_count);
+  EXPECT_EQ(1u, collector.get_callback_group_statistics(group).overrun_count);
+}
+
+class TestExecutorInstrumentation : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  void TearDown()
+  {
+    rclcpp::shutdown();
+  }
+};
+
+TEST_F(TestExecutorInstrumentation, timer_callback_duration) {
+  auto collector = std::make_shared<ExecutionStatisticsCollector>();
+  rclcpp::ExecutorOptions options;
+  options.instrumentation = collector;
+  rclcpp::executors::SingleThreadedExecutor executor(options);
+  EXPECT_EQ(collector, executor.get_instrumentation());
+
+  auto node = std::make_shared<rclcpp::Node>("test_executor_instrumentation");
+  int executions = 0;
+  rclcpp::TimerBase::SharedPtr timer = node->create_wall_timer(
+    1ms, [&]() {
+      std::this_thread::sleep_for(2ms);
+      if (++executions == 3) {
+        executor.cancel();
+      }
+    });
+  executor.add_node(node);
+  executor.spin();
+
+  const auto statistics = collector->get_entity_statistics(timer.get());
+  EXPECT_EQ(3u, statistics.count);
+  EXPECT_GE(statistics.total_duration, 6ms);
+  EXPECT_GE(statistics.max_duration, 2ms);
+  EXPECT_GE(statistics.total_dispatch_latency, 0ns);
+
+  const auto group_statistics = collector->get_callback_group_statistics(
+    node->get_node_base_interface()->get_default_callback_group().get());
+  EXPECT_EQ(3u, group_statistics.count);
+  EXPECT_GT(collector->get_wait_statistics().count, 0u);
+}
+
+TEST_F(TestExecutorInstrumentation, not_instrumented_by_default) {
+  rclcpp::executors::SingleThreadedExecutor executor;
+  EXPECT_EQ(nullptr, executor.get_instrumentation());
+}
+
+TEST_F(TestExecutorInstrumentation, busy_poll_wake_up_latencies) {
+  auto collector = std::make_shared<ExecutionStatisticsCollector>();
+  rclcpp::ExecutorOptions options;
+  options.instrumentation = collector;
+  options.busy_poll.enabled = true;
+  options.busy_poll.spin_iterations = 10u;
+  options.busy_poll.yield_iterations = 10u;
+  rclcpp::executors::SingleThreadedExecutor executor(options);
+
+  auto node = std::make_shared<rclcpp::Node>("test_executor_instrumentation");
+  int executions = 0;
+  rclcpp::TimerBase::SharedPtr timer = node->create_wall_timer(
+    1ms, [&]() {
+      if (++executions == 10) {
+        executor.cancel();
+      }
+    });
+  executor.add_node(node);
+  executor.spin();
+
+  EXPECT_EQ(10, executions);
+  uint64_t wake_ups = 0u;
+  for (auto stage : {rclcpp::WaitStage::Spin, rclcpp::WaitStage::Yield, rclcpp::WaitStage::Block}) {
+    const auto & histogram = collector->get_wake_up_latency_histogram(stage);
+    wake_ups += histogram.get_total_count();
+    if (histogram.get_total_count() > 0u) {
+      EXPECT_GE(histogram.get_value_at_percentile(100.0), 0);
+    }
+  }
+  EXPECT_GE(wake_ups, 10u);
+}
+
+/*
+   Test that the executions overrunning their budget are reported, without instrumentation.
+ */
+TEST_F(TestExecutorInstrumentation, execution_budget_overruns) {
+  rclcpp::executors::SingleThreadedExecutor executor;
+
+  auto node = std::make_shared<rclcpp::Node>("test_executor_instrumentation");
+  auto group = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  EXPECT_THROW(group->set_execution_budget(-1ms), std::invalid_argument);
+  group->set_execution_budget(20ms);
+  EXPECT_EQ(20ms, group->get_execution_budget());
+
+  std::vector<ExecutableExecution> overruns;
+  group->set_execution_overrun_callback(
+    [&overruns](const ExecutableExecution & execution) {
+      overruns.push_back(execution);
+    });
+
+  // Every other execution overruns the budget.
+  int executions = 0;
+  rclcpp::TimerBase::SharedPtr timer = node->create_wall_timer(
+    1ms, [&]() {
+      if (++executions % 2 == 1) {
+        std::this_thread::sleep_for(30ms);
+      }
+      if (executions == 4) {
+        executor.cancel();
+      }
+    }, group);
+  executor.add_node(node);
+  executor.spin();
+
+  EXPECT_EQ(2u, group->get_execution_overrun_count());
+  ASSERT_EQ(2u, overruns.size());
+  for (const auto & overrun : overruns) {
+    EXPECT_EQ(timer.get(), overrun.entity);
+    EXPECT_EQ(group.get(), overrun.callback_group);
+    EXPECT_EQ(20ms, overrun.budget);
+    EXPECT_GT(overrun.duration, overrun.budget);
+  }
+}
+
+TEST_F(TestExecutorInstrumentation, static_executor_timer_callback_duration) {
+  auto collector = std::make_shared<ExecutionStatisticsCollector>();
+  rclcpp::ExecutorOptions options;
+  options.instrumentation = collector;
+  rclcpp::executors::StaticSingleThreadedExecutor executor(options);
+
+  auto node = std::make_shared<rclcpp::Node>("test_executor_instrumentation");
+  int executions = 0;
+  rclcpp::TimerBase::SharedPtr timer = node->create_wall_timer(
+    1ms, [&]() {
+      std::this_thread::sleep_for(2ms);
+      if (++executions == 3) {
+        executor.cancel();
+      }
+    });
+  executor.add_node(node);
+  executor.spin();
+
+  const auto statistics = collector->get_entity_statistics(timer.get());
+  EXPECT_EQ(3u, statistics.count);
+  EXPECT_GE(statistics.total_duration, 6ms);
+  EXPECT_GT(collector->get_wait_statistics().count, 0u);
+}
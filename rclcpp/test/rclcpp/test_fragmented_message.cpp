@@ -0,0 +1,176 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rclcpp/fragmented_message.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+class TestFragmentedMessage : public ::testing::Test
+{
+public:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+protected:
+  void SetUp() override
+  {
+    // The fragments are published intra process, so that none of them is lost.
+    node = std::make_shared<rclcpp::Node>(
+      "fragmented_message", rclcpp::NodeOptions().use_intra_process_comms(true));
+    publisher = node->create_generic_publisher(
+      "fragments", "test_msgs/msg/Strings", rclcpp::QoS(100));
+    message = rclcpp::SerializedMessage(kMessageSize);
+    auto & rcl_message = message.get_rcl_serialized_message();
+    for (size_t i = 0; i < kMessageSize; ++i) {
+      rcl_message.buffer[i] = static_cast<uint8_t>(i);
+    }
+    rcl_message.buffer_length = kMessageSize;
+  }
+
+  // Subscribe to the fragments, giving them to the reassembler except the skipped one.
+  void subscribe(rclcpp::FragmentReassembler & reassembler, size_t skipped_fragment = SIZE_MAX)
+  {
+    subscription = node->create_generic_subscription(
+      "fragments", "test_msgs/msg/Strings", rclcpp::QoS(100),
+      [this, &reassembler, skipped_fragment](std::shared_ptr<rclcpp::SerializedMessage> fragment)
+      {
+        if (received_fragments++ != skipped_fragment) {
+          reassembler.add_fragment(*fragment);
+        }
+      });
+  }
+
+  // Spin until the publisher's fragments are all received.
+  void spin_until_received(size_t fragments)
+  {
+    using namespace std::chrono_literals;
+    auto start = std::chrono::steady_clock::now();
+    while (received_fragments < fragments && std::chrono::steady_clock::now() - start < 5s) {
+      rclcpp::spin_some(node);
+    }
+  }
+
+  static constexpr size_t kMessageSize = 1000;
+  static constexpr size_t kFragmentSize = rclcpp::FragmentedPublisher::header_size + 100;
+
+  rclcpp::Node::SharedPtr node;
+  rclcpp::GenericPublisher::SharedPtr publisher;
+  rclcpp::GenericSubscription::SharedPtr subscription;
+  rclcpp::SerializedMessage message;
+  size_t received_fragments = 0;
+};
+
+TEST_F(TestFragmentedMessage, invalid_arguments) {
+  EXPECT_THROW(rclcpp::FragmentedPublisher(nullptr, kFragmentSize), std::invalid_argument);
+  EXPECT_THROW(
+    rclcpp::FragmentedPublisher(publisher, rclcpp::FragmentedPublisher::header_size),
+    std::invalid_argument);
+  EXPECT_THROW(
+    rclcpp::FragmentReassembler([](std::shared_ptr<rclcpp::SerializedMessage>) {}, 100, 0),
+    std::invalid_argument);
+}
+
+TEST_F(TestFragmentedMessage, reassemble) {
+  std::vector<std::shared_ptr<rclcpp::SerializedMessage>> messages;
+  rclcpp::FragmentReassembler reassembler(
+    [&messages](std::shared_ptr<rclcpp::SerializedMessage> message) {
+      messages.push_back(message);
+    }, kMessageSize);
+  subscribe(reassembler);
+
+  rclcpp::FragmentedPublisher fragmented_publisher(publisher, kFragmentSize);
+  fragmented_publisher.publish(message);
+  spin_until_received(10);
+
+  EXPECT_EQ(10u, received_fragments);
+  ASSERT_EQ(1u, messages.size());
+  ASSERT_EQ(kMessageSize, messages[0]->size());
+  EXPECT_EQ(
+    0, std::memcmp(
+      message.get_rcl_serialized_message().buffer,
+      messages[0]->get_rcl_serialized_message().buffer, kMessageSize));
+}
+
+TEST_F(TestFragmentedMessage, missing_fragment_drops_message) {
+  std::vector<std::shared_ptr<rclcpp::SerializedMessage>> messages;
+  rclcpp::FragmentReassembler reassembler(
+    [&messages](std::shared_ptr<rclcpp::SerializedMessage> message) {
+      messages.push_back(message);
+    }, kMessageSize);
+  subscribe(reassembler, 3);
+
+  // Only the message missing a fragment is dropped.
+  rclcpp::FragmentedPublisher fragmented_publisher(publisher, kFragmentSize);
+  fragmented_publisher.publish(message);
+  fragmented_publisher.publish(message);
+  spin_until_received(20);
+
+  EXPECT_EQ(1u, reassembler.get_dropped_message_count());
+  ASSERT_EQ(1u, messages.size());
+  EXPECT_EQ(kMessageSize, messages[0]->size());
+}
+
+TEST_F(TestFragmentedMessage, stream) {
+  std::vector<uint8_t> streamed_data;
+  size_t completed_messages = 0;
+  rclcpp::FragmentReassembler reassembler(
+    [&streamed_data, &completed_messages](
+      const rclcpp::FragmentInfo & info, const uint8_t * data, size_t size)
+    {
+      EXPECT_EQ(streamed_data.size(), info.offset);
+      streamed_data.insert(streamed_data.end(), data, data + size);
+      if (info.offset + size == info.message_size) {
+        ++completed_messages;
+      }
+    });
+  subscribe(reassembler);
+
+  // The message is produced incrementally, as it is published.
+  rclcpp::FragmentedPublisher fragmented_publisher(publisher, kFragmentSize);
+  size_t offset = 0;
+  fragmented_publisher.publish(
+    kMessageSize, [this, &offset](uint8_t * buffer, size_t size) {
+      std::memcpy(buffer, message.get_rcl_serialized_message().buffer + offset, size);
+      offset += size;
+      return size;
+    });
+  spin_until_received(10);
+
+  EXPECT_EQ(1u, completed_messages);
+  ASSERT_EQ(kMessageSize, streamed_data.size());
+  EXPECT_EQ(
+    0, std::memcmp(
+      message.get_rcl_serialized_message().buffer, streamed_data.data(), kMessageSize));
+
+  // A source ending early is an error.
+  EXPECT_THROW(
+    fragmented_publisher.publish(kMessageSize, [](uint8_t *, size_t) {return size_t(0);}),
+    std::runtime_error);
+}
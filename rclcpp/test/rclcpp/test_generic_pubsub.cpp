@@ -15,9 +15,11 @@
 
 #include <gmock/gmock.h>
 
+#include <cstring>
 #include <future>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "test_msgs/message_fixtures.hpp"
@@ -194,3 +196,157 @@ TEST_F(RclcppGenericNodeFixture, generic_publisher_uses_qos)
   // It normally takes < 20ms, 5s chosen as "a very long time"
   ASSERT_TRUE(wait_for(connected, 5s));
 }
+
+TEST_F(RclcppGenericNodeFixture, publisher_and_subscriber_work_intra_process)
+{
+  using namespace std::chrono_literals;
+  std::string topic_name = "/string_topic";
+  std::string topic_type = "test_msgs/msg/Strings";
+
+  auto node = std::make_shared<rclcpp::Node>(
+    "intra_process_pubsub", rclcpp::NodeOptions().use_intra_process_comms(true));
+
+  const rclcpp::SerializedMessage * received_message = nullptr;
+  std::vector<std::string> subscribed_messages;
+  auto subscription = node->create_generic_subscription(
+    topic_name, topic_type, rclcpp::QoS(1),
+    [&received_message, &subscribed_messages](std::shared_ptr<rclcpp::SerializedMessage> message) {
+      received_message = message.get();
+      test_msgs::msg::Strings string_message;
+      rclcpp::Serialization<test_msgs::msg::Strings> serializer;
+      serializer.deserialize_message(message.get(), &string_message);
+      subscribed_messages.push_back(string_message.string_value);
+    });
+  auto publisher = node->create_generic_publisher(topic_name, topic_type, rclcpp::QoS(1));
+
+  // The only subscription receives the published message itself, without discovery.
+  auto message = std::make_unique<rclcpp::SerializedMessage>(
+    serialize_string_message("Hello World"));
+  const rclcpp::SerializedMessage * published_message = message.get();
+  publisher->publish(std::move(message));
+
+  auto start = std::chrono::system_clock::now();
+  while (subscribed_messages.empty() && std::chrono::system_clock::now() - start < 5s) {
+    rclcpp::spin_some(node);
+  }
+  ASSERT_THAT(subscribed_messages, SizeIs(1));
+  EXPECT_THAT(subscribed_messages[0], StrEq("Hello World"));
+  EXPECT_EQ(published_message, received_message);
+}
+
+TEST_F(RclcppGenericNodeFixture, relay_moves_message_intra_process)
+{
+  using namespace std::chrono_literals;
+  std::string topic_type = "test_msgs/msg/Strings";
+
+  auto node = std::make_shared<rclcpp::Node>(
+    "intra_process_relay", rclcpp::NodeOptions().use_intra_process_comms(true));
+
+  auto relay_publisher = node->create_generic_publisher(
+    "/relayed_topic", topic_type, rclcpp::QoS(1));
+  auto relay_subscription = node->create_generic_subscription(
+    "/string_topic", topic_type, rclcpp::QoS(1),
+    [&relay_publisher](std::shared_ptr<rclcpp::SerializedMessage> message) {
+      relay_publisher->publish(std::move(*message));
+    });
+  const uint8_t * received_buffer = nullptr;
+  std::vector<std::string> subscribed_messages;
+  auto subscription = node->create_generic_subscription(
+    "/relayed_topic", topic_type, rclcpp::QoS(1),
+    [&received_buffer, &subscribed_messages](std::shared_ptr<rclcpp::SerializedMessage> message) {
+      received_buffer = message->get_rcl_serialized_message().buffer;
+      test_msgs::msg::Strings string_message;
+      rclcpp::Serialization<test_msgs::msg::Strings> serializer;
+      serializer.deserialize_message(message.get(), &string_message);
+      subscribed_messages.push_back(string_message.string_value);
+    });
+  auto publisher = node->create_generic_publisher("/string_topic", topic_type, rclcpp::QoS(1));
+
+  // The buffer of the published message is relayed, without being copied.
+  auto message = std::make_unique<rclcpp::SerializedMessage>(
+    serialize_string_message("Hello World"));
+  const uint8_t * published_buffer = message->get_rcl_serialized_message().buffer;
+  publisher->publish(std::move(message));
+
+  auto start = std::chrono::system_clock::now();
+  while (subscribed_messages.empty() && std::chrono::system_clock::now() - start < 5s) {
+    rclcpp::spin_some(node);
+  }
+  ASSERT_THAT(subscribed_messages, SizeIs(1));
+  EXPECT_THAT(subscribed_messages[0], StrEq("Hello World"));
+  EXPECT_EQ(published_buffer, received_buffer);
+}
+
+TEST_F(RclcppGenericNodeFixture, publish_external_buffer_intra_process)
+{
+  using namespace std::chrono_literals;
+  std::string topic_name = "/string_topic";
+  std::string topic_type = "test_msgs/msg/Strings";
+
+  auto node = std::make_shared<rclcpp::Node>(
+    "intra_process_external_buffer", rclcpp::NodeOptions().use_intra_process_comms(true));
+
+  const uint8_t * received_buffer = nullptr;
+  std::vector<std::string> subscribed_messages;
+  auto subscription = node->create_generic_subscription(
+    topic_name, topic_type, rclcpp::QoS(1),
+    [&received_buffer, &subscribed_messages](std::shared_ptr<rclcpp::SerializedMessage> message) {
+      received_buffer = message->get_rcl_serialized_message().buffer;
+      test_msgs::msg::Strings string_message;
+      rclcpp::Serialization<test_msgs::msg::Strings> serializer;
+      serializer.deserialize_message(message.get(), &string_message);
+      subscribed_messages.push_back(string_message.string_value);
+    });
+  auto publisher = node->create_generic_publisher(topic_name, topic_type, rclcpp::QoS(1));
+
+  // The data of the recording is given to the subscription without being copied.
+  const auto recording = serialize_string_message("Hello World");
+  const auto & recorded_message = recording.get_rcl_serialized_message();
+  std::promise<void> released;
+  publisher->publish(
+    recorded_message.buffer, recorded_message.buffer_length,
+    [&released](const uint8_t *, size_t) {released.set_value();});
+
+  auto start = std::chrono::system_clock::now();
+  while (subscribed_messages.empty() && std::chrono::system_clock::now() - start < 5s) {
+    rclcpp::spin_some(node);
+  }
+  ASSERT_THAT(subscribed_messages, SizeIs(1));
+  EXPECT_THAT(subscribed_messages[0], StrEq("Hello World"));
+  EXPECT_EQ(recorded_message.buffer, received_buffer);
+  EXPECT_EQ(std::future_status::ready, released.get_future().wait_for(5s));
+}
+
+TEST_F(RclcppGenericNodeFixture, publish_borrowed_serialized_message)
+{
+  using namespace std::chrono_literals;
+  const std::string topic_name = "/borrowed_string_topic";
+  const std::string topic_type = "test_msgs/msg/Strings";
+  std::vector<std::string> received;
+  auto subscription = node_->create_subscription<test_msgs::msg::Strings>(
+    topic_name, 10, [&received](const test_msgs::msg::Strings & message) {
+      received.push_back(message.string_value);
+    });
+  auto publisher = node_->create_generic_publisher(topic_name, topic_type, rclcpp::QoS(10));
+  ASSERT_TRUE(wait_for([&publisher]() {return publisher->get_subscription_count() > 0u;}, 5s));
+
+  // The serialized data is written into the borrowed buffer.
+  auto serialized_message = serialize_string_message("borrowed");
+  const size_t length = serialized_message.size();
+  auto message = publisher->borrow_serialized_message(length);
+  ASSERT_EQ(length, message->size());
+  ASSERT_LE(length, message->capacity());
+  std::memcpy(
+    message->get_rcl_serialized_message().buffer,
+    serialized_message.get_rcl_serialized_message().buffer, length);
+  const uint8_t * buffer = message->get_rcl_serialized_message().buffer;
+  publisher->publish_borrowed_serialized_message(std::move(message));
+
+  // The buffer of a message published inter-process only is reused.
+  message = publisher->borrow_serialized_message(length);
+  EXPECT_EQ(buffer, message->get_rcl_serialized_message().buffer);
+  EXPECT_THROW(publisher->publish_borrowed_serialized_message(nullptr), std::runtime_error);
+
+  ASSERT_TRUE(wait_for([&received]() {return !received.empty();}, 5s));
+  EXPECT_EQ("borrowed", received[0]);
+}
@@ -13,7 +13,11 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+
+#include <chrono>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "rclcpp/contexts/default_context.hpp"
 #include "rclcpp/graph_listener.hpp"
@@ -245,6 +249,23 @@ TEST_F(TestGraphListener, test_errors_graph_listener_add_remove_node) {
     std::runtime_error("node not found"));
 }
 
+/* Graph changes notify each node with graph users */
+TEST_F(TestGraphListener, test_graph_listener_notify_nodes) {
+  std::vector<rclcpp::Node::SharedPtr> nodes;
+  std::vector<rclcpp::Event::SharedPtr> graph_events;
+  for (int i = 0; i < 3; ++i) {
+    nodes.push_back(std::make_shared<rclcpp::Node>("node_" + std::to_string(i), node_namespace));
+    graph_events.push_back(nodes.back()->get_node_graph_interface()->get_graph_event());
+  }
+  // Creating a node changes the graph, which is seen through the shared graph guard condition.
+  auto other_node = std::make_shared<rclcpp::Node>("other_node", node_namespace);
+  for (size_t i = 0u; i < nodes.size(); ++i) {
+    nodes[i]->get_node_graph_interface()->wait_for_graph_change(
+      graph_events[i], std::chrono::seconds(10));
+    EXPECT_TRUE(graph_events[i]->check_and_clear()) << "node " << i;
+  }
+}
+
 /* Shutdown errors */
 TEST_F(TestGraphListener, test_graph_listener_shutdown_wait_fini_error_nothrow) {
   auto global_context = rclcpp::contexts::get_global_default_context();
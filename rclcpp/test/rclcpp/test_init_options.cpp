@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "rcl/allocator.h"
 #include "rcl/domain_id.h"
 
+#include "rclcpp/context.hpp"
 #include "rclcpp/init_options.hpp"
 
 #include "../mocking_utils/patch.hpp"
@@ -65,6 +67,62 @@ TEST(TestInitOptions, test_initialize_logging) {
   }
 }
 
+TEST(TestInitOptions, test_async_logging) {
+  rclcpp::InitOptions options;
+  EXPECT_FALSE(options.async_logging().enabled);
+
+  rclcpp::AsyncLoggingOptions async_logging;
+  async_logging.enabled = true;
+  async_logging.queue_size = 16u;
+  async_logging.overflow_policy = rclcpp::AsyncLoggingOverflowPolicy::Block;
+  options.async_logging(async_logging);
+  rclcpp::InitOptions options_copy(options);
+  EXPECT_TRUE(options_copy.async_logging().enabled);
+  EXPECT_EQ(16u, options_copy.async_logging().queue_size);
+  EXPECT_EQ(
+    rclcpp::AsyncLoggingOverflowPolicy::Block, options_copy.async_logging().overflow_policy);
+
+  async_logging.queue_size = 0u;
+  EXPECT_THROW(options.async_logging(async_logging), std::invalid_argument);
+  EXPECT_EQ(16u, options.async_logging().queue_size);
+}
+
+TEST(TestInitOptions, test_fast_exit) {
+  rclcpp::InitOptions options;
+  EXPECT_FALSE(options.fast_exit());
+
+  options.fast_exit(true);
+  EXPECT_TRUE(options.fast_exit());
+  rclcpp::InitOptions options_copy(options);
+  EXPECT_TRUE(options_copy.fast_exit());
+  options_copy = rclcpp::InitOptions();
+  EXPECT_FALSE(options_copy.fast_exit());
+}
+
+TEST(TestInitOptions, test_real_time_memory) {
+  rclcpp::InitOptions options;
+  EXPECT_FALSE(options.real_time_memory().lock_memory);
+  EXPECT_EQ(0u, options.real_time_memory().prefault_stack_size);
+  EXPECT_EQ(0u, options.real_time_memory().prefault_heap_size);
+
+  rclcpp::RealTimeMemoryOptions real_time_memory;
+  real_time_memory.prefault_stack_size = 64u * 1024u;
+  real_time_memory.prefault_heap_size = 1024u * 1024u;
+  options.real_time_memory(real_time_memory);
+  rclcpp::InitOptions options_copy(options);
+  EXPECT_EQ(64u * 1024u, options_copy.real_time_memory().prefault_stack_size);
+  EXPECT_EQ(1024u * 1024u, options_copy.real_time_memory().prefault_heap_size);
+  options_copy = rclcpp::InitOptions();
+  EXPECT_EQ(0u, options_copy.real_time_memory().prefault_stack_size);
+
+  // Prefaulting does not need any privilege, unlike locking the memory.
+  auto context = std::make_shared<rclcpp::Context>();
+  EXPECT_NO_THROW(context->init(0, nullptr, options));
+  EXPECT_EQ(
+    1024u * 1024u, context->get_init_options().real_time_memory().prefault_heap_size);
+  context->shutdown("test");
+}
+
 TEST(TestInitOptions, test_domain_id) {
   rcl_allocator_t allocator = rcl_get_default_allocator();
   auto options = rclcpp::InitOptions(allocator);
@@ -0,0 +1,101 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "rclcpp/detail/inplace_function.hpp"
+
+using rclcpp::detail::InplaceFunction;
+
+namespace
+{
+
+int
+add_one(int value)
+{
+  return value + 1;
+}
+
+}  // namespace
+
+TEST(TestInplaceFunction, empty) {
+  InplaceFunction<void()> function;
+  EXPECT_FALSE(function);
+  EXPECT_THROW(function(), std::bad_function_call);
+
+  InplaceFunction<void()> null_function = nullptr;
+  EXPECT_FALSE(null_function);
+}
+
+TEST(TestInplaceFunction, call) {
+  InplaceFunction<int(int)> function = add_one;
+  ASSERT_TRUE(function);
+  EXPECT_EQ(2, function(1));
+
+  int offset = 10;
+  function = [offset](int value) {return value + offset;};
+  EXPECT_EQ(11, function(1));
+
+  // The callable is mutable, as with std::function.
+  int count = 0;
+  InplaceFunction<int()> counter = [count]() mutable {return ++count;};
+  EXPECT_EQ(1, counter());
+  EXPECT_EQ(2, counter());
+
+  // Arguments which can only be moved are forwarded.
+  InplaceFunction<int(std::unique_ptr<int>)> take = [](std::unique_ptr<int> value) {
+      return *value;
+    };
+  EXPECT_EQ(3, take(std::make_unique<int>(3)));
+}
+
+TEST(TestInplaceFunction, copy_and_move) {
+  auto shared_value = std::make_shared<int>(42);
+  InplaceFunction<int()> function = [shared_value]() {return *shared_value;};
+  EXPECT_EQ(2, shared_value.use_count());
+
+  InplaceFunction<int()> copy = function;
+  EXPECT_EQ(3, shared_value.use_count());
+  EXPECT_EQ(42, copy());
+
+  InplaceFunction<int()> moved = std::move(function);
+  EXPECT_EQ(3, shared_value.use_count());
+  EXPECT_FALSE(function);  // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(42, moved());
+
+  copy = moved;
+  EXPECT_EQ(3, shared_value.use_count());
+  copy = nullptr;
+  EXPECT_EQ(2, shared_value.use_count());
+  moved = std::move(copy);
+  EXPECT_EQ(1, shared_value.use_count());
+  EXPECT_FALSE(moved);
+}
+
+TEST(TestInplaceFunction, capacity) {
+  // A std::function fits the default capacity, so it can be wrapped.
+  std::function<int(int)> std_function = add_one;
+  InplaceFunction<int(int)> function = [std_function](int value) {return std_function(value);};
+  EXPECT_EQ(2, function(1));
+
+  char large_capture[64] = {1};
+  InplaceFunction<int(), sizeof(large_capture)> large_function = [large_capture]() {
+      return static_cast<int>(large_capture[0]);
+    };
+  EXPECT_EQ(1, large_function());
+}
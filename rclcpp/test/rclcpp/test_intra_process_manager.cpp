@@ -15,6 +15,7 @@
 #include <gmock/gmock.h>
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -22,6 +23,7 @@
 
 #define RCLCPP_BUILDING_LIBRARY 1
 #include "rclcpp/allocator/allocator_common.hpp"
+#include "rclcpp/experimental/intra_process_message_info.hpp"
 #include "rclcpp/macros.hpp"
 #include "rclcpp/qos.hpp"
 #include "rmw/types.h"
@@ -79,6 +81,12 @@ public:
     return qos_profile;
   }
 
+  const rmw_gid_t &
+  get_gid() const
+  {
+    return gid_;
+  }
+
   bool
   operator==(const rmw_gid_t & gid) const
   {
@@ -97,6 +105,7 @@ public:
   std::string topic_name;
   uint64_t intra_process_publisher_id_;
   IntraProcessManagerWeakPtr weak_ipm_;
+  rmw_gid_t gid_{};
 };
 
 template<typename T, typename Alloc = std::allocator<void>>
@@ -173,7 +182,7 @@ public:
   ConstMessageSharedPtr shared_msg;
   MessageUniquePtr unique_msg;
 
-  std::uintptr_t message_ptr;
+  std::uintptr_t message_ptr = 0;
 };
 
 }  // namespace mock
@@ -215,6 +224,10 @@ public:
     return topic_name;
   }
 
+  void
+  notify_intra_process_message()
+  {}
+
   rclcpp::QoS qos_profile;
   const char * topic_name;
 };
@@ -222,7 +235,9 @@ public:
 template<
   typename MessageT,
   typename Alloc = std::allocator<void>,
-  typename Deleter = std::default_delete<MessageT>>
+  typename Deleter = std::default_delete<MessageT>,
+  typename ROSMessageType = MessageT,
+  typename ROSMessageTypeDeleter = Deleter>
 class SubscriptionIntraProcessBuffer : public SubscriptionIntraProcessBase
 {
 public:
@@ -235,14 +250,20 @@ public:
   }
 
   void
-  provide_intra_process_message(std::shared_ptr<const MessageT> msg)
+  provide_intra_process_message(
+    std::shared_ptr<const MessageT> msg,
+    const rclcpp::experimental::IntraProcessMessageInfo & info)
   {
+    (void)info;
     buffer->add(msg);
   }
 
   void
-  provide_intra_process_message(std::unique_ptr<MessageT> msg)
+  provide_intra_process_message(
+    std::unique_ptr<MessageT> msg,
+    const rclcpp::experimental::IntraProcessMessageInfo & info)
   {
+    (void)info;
     buffer->add(std::move(msg));
   }
 
@@ -260,8 +281,23 @@ public:
     return take_shared_method;
   }
 
+  bool
+  accepts_message(const MessageT & msg) const
+  {
+    return !message_filter || message_filter(msg);
+  }
+
+  bool
+  add_publisher_ring(std::shared_ptr<void> ring)
+  {
+    (void)ring;
+    return false;
+  }
+
   bool take_shared_method;
 
+  std::function<bool (const MessageT &)> message_filter;
+
   typename rclcpp::experimental::buffers::mock::IntraProcessBuffer<MessageT>::UniquePtr buffer;
 };
 
@@ -300,12 +336,15 @@ public:
 #define IntraProcessBuffer mock::IntraProcessBuffer
 #define SubscriptionIntraProcessBase mock::SubscriptionIntraProcessBase
 #define SubscriptionIntraProcessBuffer mock::SubscriptionIntraProcessBuffer
+#define ROSMessageIntraProcessBuffer mock::SubscriptionIntraProcessBuffer
 #define SubscriptionIntraProcess mock::SubscriptionIntraProcess
 #include "../src/rclcpp/intra_process_manager.cpp"
 #undef Publisher
 #undef PublisherBase
 #undef IntraProcessBuffer
 #undef SubscriptionIntraProcessBase
+#undef SubscriptionIntraProcessBuffer
+#undef ROSMessageIntraProcessBuffer
 #undef SubscriptionIntraProcess
 
 using ::testing::_;
@@ -403,6 +442,53 @@ TEST(TestIntraProcessManager, add_pub_sub) {
   ASSERT_EQ(1u, p3_subs);
 }
 
+/*
+   This tests the routing of the publishers and subscriptions of serialized messages:
+   - Typed and serialized entities on the same topic do not communicate.
+   - Serialized entities only communicate with the ones of the same type.
+   - A message published by a serialized publisher only reaches its serialized subscriptions.
+ */
+TEST(TestIntraProcessManager, add_serialized_pub_sub) {
+  using IntraProcessManagerT = rclcpp::experimental::IntraProcessManager;
+  using MessageT = rcl_interfaces::msg::Log;
+  using PublisherT = rclcpp::mock::Publisher<MessageT>;
+  using SubscriptionIntraProcessT = rclcpp::experimental::mock::SubscriptionIntraProcess<MessageT>;
+
+  auto ipm = std::make_shared<IntraProcessManagerT>();
+
+  auto p1 = std::make_shared<PublisherT>();
+  auto p1_id = ipm->add_publisher(p1);
+  auto p2 = std::make_shared<PublisherT>();
+  auto p2_id = ipm->add_serialized_publisher(p2, "pkg/msg/A");
+  p2->set_intra_process_manager(p2_id, ipm);
+
+  auto s1 = std::make_shared<SubscriptionIntraProcessT>();
+  ipm->add_subscription(s1);
+  auto s2 = std::make_shared<SubscriptionIntraProcessT>();
+  ipm->add_serialized_subscription(s2, "pkg/msg/A");
+  auto s3 = std::make_shared<SubscriptionIntraProcessT>();
+  ipm->add_serialized_subscription(s3, "pkg/msg/B");
+
+  ASSERT_EQ(1u, ipm->get_subscription_count(p1_id));
+  ASSERT_EQ(1u, ipm->get_subscription_count(p2_id));
+
+  auto p3 = std::make_shared<PublisherT>();
+  auto p3_id = ipm->add_serialized_publisher(p3, "pkg/msg/B");
+  ASSERT_EQ(1u, ipm->get_subscription_count(p3_id));
+
+  auto unique_msg = std::make_unique<MessageT>();
+  auto original_message_pointer = reinterpret_cast<std::uintptr_t>(unique_msg.get());
+  p2->publish(std::move(unique_msg));
+  ASSERT_EQ(0u, s1->pop());
+  ASSERT_EQ(original_message_pointer, s2->pop());
+  ASSERT_EQ(0u, s3->pop());
+
+  ipm->remove_publisher(p3_id);
+  auto p4 = std::make_shared<PublisherT>();
+  auto p4_id = ipm->add_publisher(p4);
+  ASSERT_EQ(1u, ipm->get_subscription_count(p4_id));
+}
+
 /*
    This tests the minimal usage of the class where there is a single subscription per publisher:
    - Publishes a unique_ptr message with a subscription requesting ownership.
@@ -692,3 +778,111 @@ TEST(TestIntraProcessManager, multiple_subscriptions_different_type) {
   EXPECT_EQ(original_message_pointer, received_message_pointer_10);
   EXPECT_NE(original_message_pointer, received_message_pointer_11);
 }
+
+/*
+   This tests the filtering of the messages by the subscriptions:
+   - Publishes a unique_ptr message with 2 subscriptions requesting ownership, one filtering it.
+   - The other subscription is expected to receive the published message, without any copy.
+   - Publishes a unique_ptr message with 1 subscription requesting ownership and 1 not, the one
+     not requesting ownership filtering it.
+   - The subscription requesting ownership is expected to receive the published message.
+ */
+TEST(TestIntraProcessManager, filtered_subscriptions) {
+  using IntraProcessManagerT = rclcpp::experimental::IntraProcessManager;
+  using MessageT = rcl_interfaces::msg::Log;
+  using PublisherT = rclcpp::mock::Publisher<MessageT>;
+  using SubscriptionIntraProcessT = rclcpp::experimental::mock::SubscriptionIntraProcess<MessageT>;
+
+  auto ipm = std::make_shared<IntraProcessManagerT>();
+
+  auto p1 = std::make_shared<PublisherT>();
+  auto p1_id = ipm->add_publisher(p1);
+  p1->set_intra_process_manager(p1_id, ipm);
+
+  auto s1 = std::make_shared<SubscriptionIntraProcessT>();
+  s1->take_shared_method = false;
+  auto s1_id = ipm->add_subscription(s1);
+
+  auto s2 = std::make_shared<SubscriptionIntraProcessT>();
+  s2->take_shared_method = false;
+  s2->message_filter = [](const MessageT & msg) {return msg.level > 10u;};
+  auto s2_id = ipm->add_subscription(s2);
+
+  auto unique_msg = std::make_unique<MessageT>();
+  unique_msg->level = 10u;
+  auto original_message_pointer = reinterpret_cast<std::uintptr_t>(unique_msg.get());
+  p1->publish(std::move(unique_msg));
+  EXPECT_EQ(original_message_pointer, s1->pop());
+  EXPECT_EQ(0u, s2->pop());
+
+  unique_msg = std::make_unique<MessageT>();
+  unique_msg->level = 20u;
+  original_message_pointer = reinterpret_cast<std::uintptr_t>(unique_msg.get());
+  p1->publish(std::move(unique_msg));
+  auto received_message_pointer_1 = s1->pop();
+  auto received_message_pointer_2 = s2->pop();
+  EXPECT_NE(0u, received_message_pointer_1);
+  EXPECT_NE(original_message_pointer, received_message_pointer_1);
+  EXPECT_EQ(original_message_pointer, received_message_pointer_2);
+
+  ipm->remove_subscription(s2_id);
+
+  auto s3 = std::make_shared<SubscriptionIntraProcessT>();
+  s3->take_shared_method = true;
+  s3->message_filter = [](const MessageT &) {return false;};
+  auto s3_id = ipm->add_subscription(s3);
+  (void)s3_id;
+
+  unique_msg = std::make_unique<MessageT>();
+  original_message_pointer = reinterpret_cast<std::uintptr_t>(unique_msg.get());
+  p1->publish(std::move(unique_msg));
+  EXPECT_EQ(original_message_pointer, s1->pop());
+  EXPECT_EQ(0u, s3->pop());
+
+  ipm->remove_subscription(s1_id);
+}
+
+/*
+   This tests the report of the intra process entities of each topic:
+   - A best effort publisher and a reliable subscription on the same topic are registered,
+     but do not communicate because of their incompatible QoS.
+   - A reliable publisher is added, which communicates with the subscription.
+   - Topics are reported sorted by name, with their publishers, subscriptions and routes.
+ */
+TEST(TestIntraProcessManager, get_topic_info) {
+  using IntraProcessManagerT = rclcpp::experimental::IntraProcessManager;
+  using MessageT = rcl_interfaces::msg::Log;
+  using PublisherT = rclcpp::mock::Publisher<MessageT>;
+  using SubscriptionIntraProcessT = rclcpp::experimental::mock::SubscriptionIntraProcess<MessageT>;
+
+  auto ipm = std::make_shared<IntraProcessManagerT>();
+  EXPECT_TRUE(ipm->get_topic_info().empty());
+
+  auto p1 = std::make_shared<PublisherT>(rclcpp::QoS(10).best_effort());
+  ipm->add_publisher(p1);
+  auto s1 = std::make_shared<SubscriptionIntraProcessT>(rclcpp::QoS(10).reliable());
+  ipm->add_subscription(s1);
+  auto p2 = std::make_shared<PublisherT>(rclcpp::QoS(10).best_effort());
+  p2->topic_name = "another_topic";
+  ipm->add_publisher(p2);
+
+  auto topic_info = ipm->get_topic_info();
+  ASSERT_EQ(2u, topic_info.size());
+  EXPECT_EQ("another_topic", topic_info[0].topic_name);
+  EXPECT_EQ(1u, topic_info[0].publisher_count);
+  EXPECT_EQ(0u, topic_info[0].subscription_count);
+  EXPECT_EQ(0u, topic_info[0].route_count);
+  EXPECT_EQ("topic", topic_info[1].topic_name);
+  EXPECT_EQ(1u, topic_info[1].publisher_count);
+  EXPECT_EQ(1u, topic_info[1].subscription_count);
+  EXPECT_EQ(0u, topic_info[1].route_count);
+
+  auto p3 = std::make_shared<PublisherT>(rclcpp::QoS(10).reliable());
+  ipm->add_publisher(p3);
+
+  topic_info = ipm->get_topic_info();
+  ASSERT_EQ(2u, topic_info.size());
+  EXPECT_EQ(2u, topic_info[1].publisher_count);
+  EXPECT_EQ(1u, topic_info[1].subscription_count);
+  EXPECT_EQ(1u, topic_info[1].route_count);
+}
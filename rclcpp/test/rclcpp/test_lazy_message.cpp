@@ -0,0 +1,152 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/lazy_message.hpp"
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+
+#include "test_msgs/msg/basic_types.hpp"
+
+namespace
+{
+
+std::shared_ptr<rclcpp::SerializedMessage>
+make_serialized_message(const std::vector<uint8_t> & bytes)
+{
+  auto serialized_message = std::make_shared<rclcpp::SerializedMessage>(bytes.size());
+  auto & rcl_handle = serialized_message->get_rcl_serialized_message();
+  std::copy(bytes.begin(), bytes.end(), rcl_handle.buffer);
+  rcl_handle.buffer_length = bytes.size();
+  return serialized_message;
+}
+
+}  // namespace
+
+TEST(TestLazyMessage, null_message) {
+  EXPECT_THROW(
+    rclcpp::LazyMessage<test_msgs::msg::BasicTypes>(
+      std::shared_ptr<const rclcpp::SerializedMessage>()),
+    std::invalid_argument);
+  EXPECT_THROW(
+    rclcpp::LazyMessage<test_msgs::msg::BasicTypes>(
+      std::shared_ptr<const test_msgs::msg::BasicTypes>()),
+    std::invalid_argument);
+}
+
+TEST(TestLazyMessage, deserialize_on_access) {
+  test_msgs::msg::BasicTypes message;
+  message.int32_value = 42;
+  message.float64_value = 1.5;
+  auto serialized_message = std::make_shared<rclcpp::SerializedMessage>();
+  rclcpp::Serialization<test_msgs::msg::BasicTypes> serialization;
+  serialization.serialize_message(&message, serialized_message.get());
+
+  rclcpp::LazyMessage<test_msgs::msg::BasicTypes> lazy_message(serialized_message);
+  EXPECT_FALSE(lazy_message.is_deserialized());
+  EXPECT_EQ(serialized_message.get(), lazy_message.get_serialized_message().get());
+
+  EXPECT_EQ(42, lazy_message->int32_value);
+  EXPECT_TRUE(lazy_message.is_deserialized());
+  EXPECT_EQ(message, *lazy_message);
+  // The message is deserialized only once.
+  EXPECT_EQ(&lazy_message.get(), lazy_message.get_shared().get());
+
+  rclcpp::LazyMessage<test_msgs::msg::BasicTypes> moved_message(std::move(lazy_message));
+  EXPECT_TRUE(moved_message.is_deserialized());
+  EXPECT_EQ(message, moved_message.get());
+}
+
+TEST(TestLazyMessage, deserialized_message) {
+  auto message = std::make_shared<const test_msgs::msg::BasicTypes>();
+  rclcpp::LazyMessage<test_msgs::msg::BasicTypes> lazy_message(message);
+  EXPECT_TRUE(lazy_message.is_deserialized());
+  EXPECT_EQ(message.get(), &lazy_message.get());
+}
+
+TEST(TestLazyMessage, read_serialized_header) {
+  // Little endian CDR: sec = 3, nanosec = 500, frame_id = "map".
+  auto serialized_message = make_serialized_message(
+  {
+    0x00, 0x01, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00,
+    0xf4, 0x01, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00,
+    'm', 'a', 'p', '\0',
+  });
+  builtin_interfaces::msg::Time stamp;
+  std::string frame_id;
+  ASSERT_TRUE(
+    rclcpp::detail::read_serialized_header(
+      serialized_message->get_rcl_serialized_message(), &stamp, &frame_id));
+  EXPECT_EQ(3, stamp.sec);
+  EXPECT_EQ(500u, stamp.nanosec);
+  EXPECT_EQ("map", frame_id);
+
+  // Big endian CDR.
+  serialized_message = make_serialized_message(
+  {
+    0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x03,
+    0x00, 0x00, 0x01, 0xf4,
+    0x00, 0x00, 0x00, 0x01,
+    '\0',
+  });
+  ASSERT_TRUE(
+    rclcpp::detail::read_serialized_header(
+      serialized_message->get_rcl_serialized_message(), &stamp, &frame_id));
+  EXPECT_EQ(3, stamp.sec);
+  EXPECT_EQ(500u, stamp.nanosec);
+  EXPECT_EQ("", frame_id);
+
+  // The frame id is not read if it is not requested.
+  ASSERT_TRUE(
+    rclcpp::detail::read_serialized_header(
+      serialized_message->get_rcl_serialized_message(), &stamp, nullptr));
+
+  // Truncated message.
+  serialized_message = make_serialized_message(
+  {
+    0x00, 0x01, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00,
+    0xf4, 0x01, 0x00, 0x00,
+    0x10, 0x00, 0x00, 0x00,
+    'm', 'a', 'p', '\0',
+  });
+  EXPECT_FALSE(
+    rclcpp::detail::read_serialized_header(
+      serialized_message->get_rcl_serialized_message(), &stamp, &frame_id));
+
+  // Unsupported encapsulation, e.g. parameter list CDR.
+  serialized_message = make_serialized_message(
+  {
+    0x00, 0x03, 0x00, 0x00,
+    0x03, 0x00, 0x00, 0x00,
+    0xf4, 0x01, 0x00, 0x00,
+    0x04, 0x00, 0x00, 0x00,
+    'm', 'a', 'p', '\0',
+  });
+  EXPECT_FALSE(
+    rclcpp::detail::read_serialized_header(
+      serialized_message->get_rcl_serialized_message(), &stamp, &frame_id));
+}
@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "rclcpp/loaned_message.hpp"
 #include "rclcpp/rclcpp.hpp"
@@ -192,3 +193,154 @@ TEST_F(TestLoanedMessage, move_loaned_message) {
   ASSERT_EQ(42.0f, loaned_msg_moved_to.get().float32_value);
   SUCCEED();
 }
+
+TEST_F(TestLoanedMessage, pooled_allocated_messages) {
+  auto node = std::make_shared<rclcpp::Node>("loaned_message_test_node");
+  auto mock_can_loan = mocking_utils::patch_and_return(
+    "lib:rclcpp", rcl_publisher_can_loan_messages, false);
+  rclcpp::PublisherOptions options;
+  options.loaned_message_pool_size = 1;
+  auto pub = node->create_publisher<MessageT>("loaned_message_test_topic", 1, options);
+
+  MessageT * message = nullptr;
+  {
+    auto loaned_msg = pub->borrow_loaned_message();
+    ASSERT_TRUE(loaned_msg.is_valid());
+    message = &loaned_msg.get();
+    message->float64_value = 42.0;
+  }
+  {
+    // The message was given back to the pool, and is reused, default constructed.
+    auto loaned_msg = pub->borrow_loaned_message();
+    EXPECT_EQ(message, &loaned_msg.get());
+    EXPECT_EQ(0.0, loaned_msg.get().float64_value);
+    // Not taken from the pool, which is empty.
+    auto other_loaned_msg = pub->borrow_loaned_message();
+    EXPECT_NE(message, &other_loaned_msg.get());
+    EXPECT_NO_THROW(pub->publish(std::move(other_loaned_msg)));
+  }
+  {
+    auto loaned_msg = pub->borrow_loaned_message();
+    auto released_msg = loaned_msg.release();
+    EXPECT_NE(nullptr, released_msg);
+  }
+}
+
+TEST_F(TestLoanedMessage, pooled_loaned_messages_are_borrowed_ahead) {
+  auto node = std::make_shared<rclcpp::Node>("loaned_message_test_node");
+  auto mock_can_loan = mocking_utils::patch_and_return(
+    "lib:rclcpp", rcl_publisher_can_loan_messages, true);
+  rclcpp::PublisherOptions options;
+  options.loaned_message_pool_size = 3;
+  auto pub = node->create_publisher<MessageT>("loaned_message_test_topic", 1, options);
+
+  std::vector<MessageT> messages(4);
+  size_t number_of_borrows = 0;
+  auto mock_borrow_loaned = mocking_utils::patch(
+    "self", rcl_borrow_loaned_message,
+    [&messages, &number_of_borrows](
+      const rcl_publisher_t *, const rosidl_message_type_support_t *, void ** ros_message) {
+      if (number_of_borrows == messages.size()) {
+        return RCL_RET_ERROR;
+      }
+      *ros_message = &messages[number_of_borrows++];
+      return RCL_RET_OK;
+    });
+  size_t number_of_returns = 0;
+  auto mock_return_loaned = mocking_utils::patch(
+    "self", rcl_return_loaned_message_from_publisher,
+    [&number_of_returns](const rcl_publisher_t *, void *) {
+      ++number_of_returns;
+      return RCL_RET_OK;
+    });
+
+  {
+    auto loaned_msg = pub->borrow_loaned_message();
+    EXPECT_EQ(3u, number_of_borrows);
+    auto second_loaned_msg = pub->borrow_loaned_message();
+    auto third_loaned_msg = pub->borrow_loaned_message();
+    EXPECT_EQ(3u, number_of_borrows);
+    // The middleware runs out of loans while borrowing ahead.
+    auto fourth_loaned_msg = pub->borrow_loaned_message();
+    EXPECT_EQ(4u, number_of_borrows);
+    EXPECT_TRUE(fourth_loaned_msg.is_valid());
+    EXPECT_THROW(pub->borrow_loaned_message(), rclcpp::exceptions::RCLError);
+  }
+  // Three messages went back to the pool, the last one to the middleware.
+  EXPECT_EQ(1u, number_of_returns);
+  pub.reset();
+  EXPECT_EQ(4u, number_of_returns);
+}
+
+TEST_F(TestLoanedMessage, intra_process_loaned_messages) {
+  auto node = std::make_shared<rclcpp::Node>(
+    "loaned_message_test_node", rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto mock_can_loan = mocking_utils::patch_and_return(
+    "lib:rclcpp", rcl_publisher_can_loan_messages, true);
+  auto pub = node->create_publisher<MessageT>("loaned_message_test_topic", 1);
+
+  std::vector<double> received_values;
+  auto sub = node->create_subscription<MessageT>(
+    "loaned_message_test_topic", 1,
+    [&received_values](const MessageT & msg) {
+      received_values.push_back(msg.float64_value);
+    });
+  ASSERT_EQ(1u, pub->get_intra_process_subscription_count());
+
+  MessageT loaned_memory;
+  size_t number_of_borrows = 0;
+  auto mock_borrow_loaned = mocking_utils::patch(
+    "self", rcl_borrow_loaned_message,
+    [&loaned_memory, &number_of_borrows](
+      const rcl_publisher_t *, const rosidl_message_type_support_t *, void ** ros_message) {
+      ++number_of_borrows;
+      *ros_message = &loaned_memory;
+      return RCL_RET_OK;
+    });
+  size_t number_of_returns = 0;
+  auto mock_return_loaned = mocking_utils::patch(
+    "self", rcl_return_loaned_message_from_publisher,
+    [&number_of_returns](const rcl_publisher_t *, void *) {
+      ++number_of_returns;
+      return RCL_RET_OK;
+    });
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  {
+    // Only intra process subscriptions, the message is not loaned.
+    auto mock_count = mocking_utils::patch(
+      "lib:rclcpp", rcl_publisher_get_subscription_count,
+      [](const rcl_publisher_t *, size_t * count) {
+        *count = 1;
+        return RCL_RET_OK;
+      });
+    auto loaned_msg = pub->borrow_loaned_message();
+    EXPECT_FALSE(loaned_msg.is_loaned());
+    loaned_msg.get().float64_value = 1.0;
+    pub->publish(std::move(loaned_msg));
+    EXPECT_EQ(0u, number_of_borrows);
+    executor.spin_some();
+    ASSERT_EQ(1u, received_values.size());
+    EXPECT_EQ(1.0, received_values[0]);
+  }
+  {
+    // An inter process subscription too, the loaned message is shared with the intra process one.
+    auto mock_count = mocking_utils::patch(
+      "lib:rclcpp", rcl_publisher_get_subscription_count,
+      [](const rcl_publisher_t *, size_t * count) {
+        *count = 2;
+        return RCL_RET_OK;
+      });
+    auto loaned_msg = pub->borrow_loaned_message();
+    EXPECT_TRUE(loaned_msg.is_loaned());
+    EXPECT_EQ(1u, number_of_borrows);
+    loaned_msg.get().float64_value = 2.0;
+    pub->publish(std::move(loaned_msg));
+    executor.spin_some();
+    ASSERT_EQ(2u, received_values.size());
+    EXPECT_EQ(2.0, received_values[1]);
+  }
+  // The loan went back to the middleware once the subscription released it.
+  EXPECT_EQ(1u, number_of_returns);
+}
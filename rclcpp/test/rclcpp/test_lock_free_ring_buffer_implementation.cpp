@@ -0,0 +1,141 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "rclcpp/experimental/buffers/buffer_implementation_base.hpp"
+#include "rclcpp/experimental/buffers/lock_free_ring_buffer_implementation.hpp"
+
+using rclcpp::experimental::buffers::LockFreeRingBufferImplementation;
+
+/*
+   Constructor
+ */
+TEST(TestLockFreeRingBufferImplementation, constructor) {
+  // Cannot create a buffer of size zero.
+  EXPECT_THROW(
+    LockFreeRingBufferImplementation<char> rb(0),
+    std::invalid_argument);
+
+  LockFreeRingBufferImplementation<char> rb(1);
+
+  EXPECT_EQ(false, rb.has_data());
+  EXPECT_EQ(false, rb.is_full());
+  EXPECT_THROW(rb.dequeue(), std::runtime_error);
+}
+
+/*
+   Basic usage
+   - insert data and check that it has data
+   - extract data
+   - overwrite old data writing over the buffer capacity
+ */
+TEST(TestLockFreeRingBufferImplementation, basic_usage) {
+  LockFreeRingBufferImplementation<char> rb(2);
+
+  rb.enqueue('a');
+
+  EXPECT_EQ(true, rb.has_data());
+  EXPECT_EQ(false, rb.is_full());
+
+  char v = rb.dequeue();
+
+  EXPECT_EQ('a', v);
+  EXPECT_EQ(false, rb.has_data());
+  EXPECT_EQ(false, rb.is_full());
+
+  rb.enqueue('b');
+  rb.enqueue('c');
+
+  EXPECT_EQ(true, rb.has_data());
+  EXPECT_EQ(true, rb.is_full());
+
+  rb.enqueue('d');
+
+  EXPECT_EQ(true, rb.has_data());
+  EXPECT_EQ(true, rb.is_full());
+
+  v = rb.dequeue();
+
+  EXPECT_EQ('c', v);
+  EXPECT_EQ(true, rb.has_data());
+  EXPECT_EQ(false, rb.is_full());
+
+  v = rb.dequeue();
+
+  EXPECT_EQ('d', v);
+  EXPECT_EQ(false, rb.has_data());
+  EXPECT_EQ(false, rb.is_full());
+}
+
+/*
+   Move-only elements are moved in and out of the buffer
+ */
+TEST(TestLockFreeRingBufferImplementation, unique_ptr_elements) {
+  LockFreeRingBufferImplementation<std::unique_ptr<int>> rb(3);
+
+  rb.enqueue(std::make_unique<int>(1));
+  rb.enqueue(std::make_unique<int>(2));
+
+  auto first = rb.dequeue();
+  ASSERT_NE(nullptr, first);
+  EXPECT_EQ(1, *first);
+  auto second = rb.dequeue();
+  ASSERT_NE(nullptr, second);
+  EXPECT_EQ(2, *second);
+  EXPECT_EQ(false, rb.has_data());
+}
+
+/*
+   Several producers and one consumer
+   - every element is received exactly once when the buffer is large enough
+ */
+TEST(TestLockFreeRingBufferImplementation, multiple_producers) {
+  constexpr size_t number_of_producers = 4;
+  constexpr size_t elements_per_producer = 1000;
+  LockFreeRingBufferImplementation<size_t> rb(number_of_producers * elements_per_producer);
+
+  std::vector<std::thread> producers;
+  for (size_t producer = 0; producer < number_of_producers; ++producer) {
+    producers.emplace_back(
+      [&rb, producer]() {
+        for (size_t i = 0; i < elements_per_producer; ++i) {
+          rb.enqueue(producer * elements_per_producer + i);
+        }
+      });
+  }
+
+  std::vector<bool> received(number_of_producers * elements_per_producer, false);
+  size_t number_received = 0;
+  while (number_received < received.size()) {
+    if (!rb.has_data()) {
+      std::this_thread::yield();
+      continue;
+    }
+    size_t v = rb.dequeue();
+    ASSERT_LT(v, received.size());
+    EXPECT_FALSE(received[v]);
+    received[v] = true;
+    ++number_received;
+  }
+  for (auto & producer : producers) {
+    producer.join();
+  }
+  EXPECT_EQ(false, rb.has_data());
+}
@@ -160,6 +160,38 @@ TEST(TestLogger, set_level) {
   EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
 }
 
+TEST(TestLogger, is_enabled_for) {
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_logging_initialize());
+  using Level = rclcpp::Logger::Level;
+
+  rclcpp::Logger parent = rclcpp::get_logger("test_is_enabled_for");
+  rclcpp::Logger child = parent.get_child("child");
+  rclcpp::Logger child_copy = child;
+  EXPECT_FALSE(child.is_enabled_for(Level::Debug));
+  EXPECT_TRUE(child.is_enabled_for(Level::Info));
+
+  // The level of an ancestor invalidates the cached level of all the loggers.
+  parent.set_level(Level::Debug);
+  EXPECT_TRUE(child.is_enabled_for(Level::Debug));
+  EXPECT_TRUE(child_copy.is_enabled_for(Level::Debug));
+  child.set_level(Level::Error);
+  EXPECT_FALSE(child_copy.is_enabled_for(Level::Warn));
+  EXPECT_TRUE(child_copy.is_enabled_for(Level::Error));
+  EXPECT_TRUE(parent.is_enabled_for(Level::Debug));
+
+  // Levels set through rcutils are only seen once the caches are invalidated.
+  ASSERT_EQ(
+    RCUTILS_RET_OK, rcutils_logging_set_logger_level(
+      "test_is_enabled_for", RCUTILS_LOG_SEVERITY_FATAL));
+  EXPECT_TRUE(parent.is_enabled_for(Level::Debug));
+  rclcpp::invalidate_logger_level_caches();
+  EXPECT_FALSE(parent.is_enabled_for(Level::Error));
+  EXPECT_TRUE(parent.is_enabled_for(Level::Fatal));
+
+  EXPECT_EQ(RCUTILS_RET_OK, rcutils_logging_shutdown());
+  rclcpp::invalidate_logger_level_caches();
+}
+
 TEST(TestLogger, get_logging_directory) {
   ASSERT_EQ(true, rcutils_set_env("HOME", "/fake_home_dir"));
   ASSERT_EQ(true, rcutils_set_env("USERPROFILE", nullptr));
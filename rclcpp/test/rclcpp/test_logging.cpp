@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "rclcpp/clock.hpp"
+#include "rclcpp/detail/log_throttle.hpp"
 #include "rclcpp/logger.hpp"
 #include "rclcpp/logging.hpp"
 #include "rcutils/logging.h"
@@ -229,6 +230,34 @@ TEST_F(TestLoggingMacros, test_throttle) {
   }
 }
 
+TEST(TestLogThrottle, throttle_on_the_clock) {
+  using namespace std::chrono_literals;
+  rclcpp::Clock steady_clock(RCL_STEADY_TIME);
+  rclcpp::detail::LogThrottle throttle;
+  EXPECT_TRUE(throttle.should_log(steady_clock, 100));
+  EXPECT_FALSE(throttle.should_log(steady_clock, 100));
+  std::this_thread::sleep_for(150ms);
+  EXPECT_TRUE(throttle.should_log(steady_clock, 100));
+
+  rclcpp::detail::LogThrottle skip_first_throttle(true);
+  EXPECT_FALSE(skip_first_throttle.should_log(steady_clock, 100));
+  EXPECT_FALSE(skip_first_throttle.should_log(steady_clock, 100));
+  std::this_thread::sleep_for(150ms);
+  EXPECT_TRUE(skip_first_throttle.should_log(steady_clock, 100));
+
+  // The ROS time is not compared to the monotonic clock.
+  rclcpp::Clock ros_clock(RCL_ROS_TIME);
+  ASSERT_EQ(RCL_RET_OK, rcl_enable_ros_time_override(ros_clock.get_clock_handle()));
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_set_ros_time_override(ros_clock.get_clock_handle(), RCUTILS_S_TO_NS(1)));
+  rclcpp::detail::LogThrottle ros_throttle;
+  EXPECT_TRUE(ros_throttle.should_log(ros_clock, 100));
+  EXPECT_FALSE(ros_throttle.should_log(ros_clock, 100));
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_set_ros_time_override(ros_clock.get_clock_handle(), RCUTILS_S_TO_NS(2)));
+  EXPECT_TRUE(ros_throttle.should_log(ros_clock, 100));
+}
+
 bool log_function(rclcpp::Logger logger)
 {
   RCLCPP_INFO(logger, "successful log");
@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <utility>
 
 #include "rclcpp/message_memory_strategy.hpp"
 #include "test_msgs/msg/empty.hpp"
@@ -56,3 +57,48 @@ TEST(TestMemoryStrategies, standard_allocation) {
   EXPECT_EQ(42u, serialized_message->capacity());
   EXPECT_NO_THROW(memory_strategy->return_serialized_message(serialized_message));
 }
+
+TEST(TestMemoryStrategies, serialized_message_pool) {
+  auto memory_strategy =
+    rclcpp::message_memory_strategy::MessageMemoryStrategy<
+    test_msgs::msg::Empty>::create_default();
+  memory_strategy->set_serialized_message_pool_size(1);
+
+  auto serialized_message = memory_strategy->borrow_serialized_message(16);
+  ASSERT_NE(nullptr, serialized_message);
+  rclcpp::SerializedMessage * message = serialized_message.get();
+  // As the middleware would for a larger message.
+  serialized_message->reserve(1024);
+  serialized_message->get_rcl_serialized_message().buffer_length = 1000;
+  auto kept_message = serialized_message;
+  EXPECT_NO_THROW(memory_strategy->return_serialized_message(serialized_message));
+
+  // Still used by the callback, so not reused.
+  auto other_message = memory_strategy->borrow_serialized_message(16);
+  EXPECT_NE(message, other_message.get());
+  kept_message.reset();
+  // The pool already keeps a message, so this one is freed.
+  memory_strategy->return_serialized_message(other_message);
+
+  // Reused with its buffer, the pool keeping a single message.
+  serialized_message = memory_strategy->borrow_serialized_message(16);
+  EXPECT_EQ(message, serialized_message.get());
+  EXPECT_EQ(1024u, serialized_message->capacity());
+  EXPECT_EQ(0u, serialized_message->size());
+  memory_strategy->return_serialized_message(serialized_message);
+
+  // A message whose buffer was moved out is not kept.
+  serialized_message = memory_strategy->borrow_serialized_message(16);
+  rclcpp::SerializedMessage moved_message(std::move(*serialized_message));
+  EXPECT_NO_THROW(memory_strategy->return_serialized_message(serialized_message));
+  serialized_message = memory_strategy->borrow_serialized_message(16);
+  EXPECT_EQ(16u, serialized_message->capacity());
+  memory_strategy->return_serialized_message(serialized_message);
+
+  // The messages outlive the pool.
+  serialized_message = memory_strategy->borrow_serialized_message(16);
+  memory_strategy->set_serialized_message_pool_size(0);
+  EXPECT_NO_THROW(serialized_message.reset());
+  serialized_message = memory_strategy->borrow_serialized_message(16);
+  EXPECT_EQ(16u, serialized_message->capacity());
+}
@@ -2660,6 +2660,61 @@ bool wait_for_event(
 }  // namespace
 
 // test that calling get_publishers_info_by_topic and get_subscriptions_info_by_topic
+TEST_F(TestNode, get_parameter_handle) {
+  auto node = std::make_shared<rclcpp::Node>("test_get_parameter_handle_node"_unq);
+  {
+    // the handle follows the value set in place
+    auto name = "parameter"_unq;
+    node->declare_parameter(name, 1.5);
+    auto handle = node->get_parameter_handle<double>(name);
+    EXPECT_TRUE(handle->is_valid());
+    EXPECT_EQ(1.5, handle->get());
+    EXPECT_TRUE(node->set_parameter({name, 2.5}).successful);
+    EXPECT_EQ(2.5, handle->get());
+    EXPECT_TRUE(node->set_parameters_atomically({{name, 3.5}}).successful);
+    EXPECT_EQ(3.5, handle->get());
+  }
+  {
+    // strings are shared instead of copied
+    auto name = "parameter"_unq;
+    node->declare_parameter(name, "hello");
+    auto handle = node->get_parameter_handle<std::string>(name);
+    auto value = handle->get();
+    EXPECT_EQ("hello", *value);
+    EXPECT_TRUE(node->set_parameter({name, "world"}).successful);
+    EXPECT_EQ("world", *handle->get());
+    EXPECT_EQ("hello", *value);
+  }
+  {
+    // undeclared and dynamically typed parameters invalidate the handle
+    auto name = "parameter"_unq;
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.dynamic_typing = true;
+    node->declare_parameter(name, 42, descriptor);
+    auto handle = node->get_parameter_handle<int64_t>(name);
+    EXPECT_EQ(42, handle->get());
+    EXPECT_TRUE(node->set_parameter({name, "not an integer"}).successful);
+    EXPECT_FALSE(handle->is_valid());
+    EXPECT_EQ(42, handle->get());
+    EXPECT_TRUE(node->set_parameter({name, 43}).successful);
+    EXPECT_TRUE(handle->is_valid());
+    EXPECT_EQ(43, handle->get());
+    node->undeclare_parameter(name);
+    EXPECT_FALSE(handle->is_valid());
+  }
+  {
+    // wrong type or undeclared
+    auto name = "parameter"_unq;
+    node->declare_parameter(name, true);
+    EXPECT_THROW(
+      node->get_parameter_handle<double>(name),
+      rclcpp::exceptions::InvalidParameterTypeException);
+    EXPECT_THROW(
+      node->get_parameter_handle<double>("parameter"_unq),
+      rclcpp::exceptions::ParameterNotDeclaredException);
+  }
+}
+
 TEST_F(TestNode, get_publishers_subscriptions_info_by_topic) {
   auto node = std::make_shared<rclcpp::Node>("my_node", "/ns");
   std::string topic_name = "test_topic_info";
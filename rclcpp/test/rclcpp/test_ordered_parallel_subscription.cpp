@@ -0,0 +1,171 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/executors.hpp"
+#include "rclcpp/node.hpp"
+#include "rclcpp/ordered_parallel_subscription.hpp"
+
+#include "test_msgs/msg/basic_types.hpp"
+
+using namespace std::chrono_literals;
+using test_msgs::msg::BasicTypes;
+
+class TestOrderedParallelSubscription : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    rclcpp::init(0, nullptr);
+    node = std::make_shared<rclcpp::Node>("test_ordered_parallel_subscription", "/ns");
+    publisher = node->create_publisher<BasicTypes>("topic", 100);
+  }
+
+  void TearDown()
+  {
+    publisher.reset();
+    node.reset();
+    rclcpp::shutdown();
+  }
+
+  void publish(int32_t count)
+  {
+    for (int32_t i = 0; i < count; ++i) {
+      BasicTypes message;
+      message.int32_value = i;
+      publisher->publish(message);
+    }
+  }
+
+  /// Spin until the number of outputs is reached or a timeout.
+  void spin_until(rclcpp::Executor & executor, const std::function<bool()> & done)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while (!done() && std::chrono::steady_clock::now() < deadline) {
+      executor.spin_some(10ms);
+    }
+  }
+
+protected:
+  rclcpp::Node::SharedPtr node;
+  rclcpp::Publisher<BasicTypes>::SharedPtr publisher;
+};
+
+TEST_F(TestOrderedParallelSubscription, invalid_arguments) {
+  auto process = [](std::shared_ptr<const BasicTypes> message) {return message->int32_value;};
+  auto output = [](int32_t) {};
+  EXPECT_THROW(
+    (rclcpp::create_ordered_parallel_subscription<BasicTypes, int32_t>(
+      node, "topic", 10, process, output, 0u)),
+    std::invalid_argument);
+  EXPECT_THROW(
+    (rclcpp::create_ordered_parallel_subscription<BasicTypes, int32_t>(
+      node, "topic", 10, nullptr, output, 10u)),
+    std::invalid_argument);
+  rclcpp::SubscriptionOptions options;
+  options.callback_group =
+    node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
+  EXPECT_THROW(
+    (rclcpp::create_ordered_parallel_subscription<BasicTypes, int32_t>(
+      node, "topic", 10, process, output, 10u, options)),
+    std::invalid_argument);
+}
+
+TEST_F(TestOrderedParallelSubscription, results_in_order) {
+  constexpr int32_t number_of_messages = 40;
+  constexpr size_t window = 8u;
+  std::atomic<size_t> processing{0};
+  std::atomic<size_t> max_processing{0};
+  std::mutex mutex;
+  std::vector<int32_t> outputs;
+  auto subscription = rclcpp::create_ordered_parallel_subscription<BasicTypes, int32_t>(
+    node, "topic", 100,
+    [&](std::shared_ptr<const BasicTypes> message) {
+      const size_t concurrent = ++processing;
+      size_t max = max_processing.load();
+      while (concurrent > max && !max_processing.compare_exchange_weak(max, concurrent)) {}
+      // The later messages of a batch are faster, so they complete out of order.
+      std::this_thread::sleep_for(std::chrono::milliseconds(4 - message->int32_value % 4));
+      --processing;
+      return message->int32_value * 2;
+    },
+    [&](int32_t result) {
+      std::lock_guard<std::mutex> lock(mutex);
+      outputs.push_back(result);
+    },
+    window);
+  ASSERT_NE(nullptr, subscription->get_subscription());
+
+  rclcpp::executors::MultiThreadedExecutor executor(rclcpp::ExecutorOptions(), 4u);
+  executor.add_node(node);
+  publish(number_of_messages);
+  spin_until(
+    executor, [&]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      return outputs.size() == static_cast<size_t>(number_of_messages);
+    });
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(static_cast<size_t>(number_of_messages), outputs.size());
+  for (int32_t i = 0; i < number_of_messages; ++i) {
+    EXPECT_EQ(i * 2, outputs[static_cast<size_t>(i)]);
+  }
+  EXPECT_LE(max_processing.load(), window);
+  EXPECT_EQ(0u, subscription->get_number_of_messages_in_flight());
+}
+
+TEST_F(TestOrderedParallelSubscription, single_threaded_executor) {
+  constexpr int32_t number_of_messages = 10;
+  std::vector<int32_t> outputs;
+  auto subscription = rclcpp::create_ordered_parallel_subscription<BasicTypes, int32_t>(
+    node, "topic", 100,
+    [](std::shared_ptr<const BasicTypes> message) {
+      if (3 == message->int32_value) {
+        throw std::runtime_error("failed to process the message");
+      }
+      return message->int32_value;
+    },
+    [&outputs](int32_t result) {outputs.push_back(result);},
+    2u);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  publish(number_of_messages);
+  // The window is smaller than the number of messages, the messages are then processed by the
+  // thread taking them, and the exception of the message without result reaches the executor.
+  bool thrown = false;
+  const auto deadline = std::chrono::steady_clock::now() + 10s;
+  while (outputs.size() < static_cast<size_t>(number_of_messages - 1) &&
+    std::chrono::steady_clock::now() < deadline)
+  {
+    try {
+      executor.spin_some(10ms);
+    } catch (const std::runtime_error &) {
+      thrown = true;
+    }
+  }
+  EXPECT_TRUE(thrown);
+  EXPECT_EQ((std::vector<int32_t>{0, 1, 2, 4, 5, 6, 7, 8, 9}), outputs);
+}
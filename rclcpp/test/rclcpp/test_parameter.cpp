@@ -947,3 +947,21 @@ TEST_F(TestParameter, parameter_vector_stringification) {
     "\"string_param\": {\"type\": \"string\", \"value\": \"I'm a string\"}}",
     ss.str());
 }
+
+TEST_F(TestParameter, value_message_only_holds_the_set_value) {
+  rclcpp::ParameterValue integer_value(42);
+  const rcl_interfaces::msg::ParameterValue integer_msg = integer_value.to_value_msg();
+  EXPECT_EQ(rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER, integer_msg.type);
+  EXPECT_EQ(42, integer_msg.integer_value);
+  EXPECT_FALSE(integer_msg.bool_value);
+  EXPECT_TRUE(integer_msg.string_value.empty());
+
+  // Only the value of the type of the message is kept.
+  rcl_interfaces::msg::ParameterValue msg_with_stale_fields = integer_msg;
+  msg_with_stale_fields.string_value = "stale";
+  EXPECT_EQ(integer_value, rclcpp::ParameterValue(msg_with_stale_fields));
+  EXPECT_EQ(integer_msg, rclcpp::ParameterValue(msg_with_stale_fields).to_value_msg());
+
+  EXPECT_NE(rclcpp::ParameterValue(1), rclcpp::ParameterValue(1.0));
+  EXPECT_LT(sizeof(rclcpp::ParameterValue), sizeof(rcl_interfaces::msg::ParameterValue));
+}
@@ -17,9 +17,11 @@
 #include <chrono>
 #include <functional>
 #include <future>
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "rclcpp/rclcpp.hpp"
@@ -948,3 +950,103 @@ TEST_F(TestParameterClient, sync_parameter_load_parameters) {
   auto list_parameters = synchronous_client->list_parameters({}, 3);
   ASSERT_EQ(list_parameters.names.size(), static_cast<uint64_t>(5));
 }
+
+/*
+  Coverage for the requests to several remote nodes at once
+ */
+TEST_F(TestParameterClient, async_multi_node_parameters) {
+  const std::string remote_node_name = node->get_fully_qualified_name();
+  const std::string remote_node_with_option_name = node_with_option->get_fully_qualified_name();
+  auto multi_node_client = std::make_shared<rclcpp::AsyncMultiNodeParametersClient>(
+    node, std::vector<std::string>{remote_node_name, remote_node_with_option_name});
+  EXPECT_EQ(
+    (std::vector<std::string>{remote_node_name, remote_node_with_option_name}),
+    multi_node_client->get_remote_node_names());
+  EXPECT_THROW(multi_node_client->get_client("/ns/unknown_node"), std::out_of_range);
+  ASSERT_TRUE(multi_node_client->wait_for_service(std::chrono::seconds(5)));
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  executor.add_node(node_with_option);
+
+  // Only the node allowing undeclared parameters accepts the new parameter.
+  bool callback_called = false;
+  auto set_future = multi_node_client->set_parameters(
+    {rclcpp::Parameter("foo", 42)},
+    [&callback_called](auto) {callback_called = true;});
+  ASSERT_EQ(
+    rclcpp::FutureReturnCode::SUCCESS,
+    executor.spin_until_future_complete(set_future, std::chrono::seconds(5)));
+  EXPECT_TRUE(callback_called);
+  auto set_results = set_future.get();
+  ASSERT_EQ(2u, set_results.size());
+  ASSERT_EQ(1u, set_results.at(remote_node_name).size());
+  EXPECT_FALSE(set_results.at(remote_node_name)[0].successful);
+  ASSERT_EQ(1u, set_results.at(remote_node_with_option_name).size());
+  EXPECT_TRUE(set_results.at(remote_node_with_option_name)[0].successful);
+
+  auto get_future = multi_node_client->get_parameters({"foo"});
+  ASSERT_EQ(
+    rclcpp::FutureReturnCode::SUCCESS,
+    executor.spin_until_future_complete(get_future, std::chrono::seconds(5)));
+  auto get_results = get_future.get();
+  EXPECT_TRUE(get_results.at(remote_node_name).empty());
+  ASSERT_EQ(1u, get_results.at(remote_node_with_option_name).size());
+  EXPECT_EQ(42, get_results.at(remote_node_with_option_name)[0].as_int());
+
+  auto list_future = multi_node_client->list_parameters({}, 1u);
+  ASSERT_EQ(
+    rclcpp::FutureReturnCode::SUCCESS,
+    executor.spin_until_future_complete(list_future, std::chrono::seconds(5)));
+  EXPECT_EQ(2u, list_future.get().size());
+
+  // Parameters set on one node only.
+  auto set_one_future = multi_node_client->set_parameters(
+    std::map<std::string, std::vector<rclcpp::Parameter>>{
+    {remote_node_with_option_name, {rclcpp::Parameter("foo", 43)}}});
+  ASSERT_EQ(
+    rclcpp::FutureReturnCode::SUCCESS,
+    executor.spin_until_future_complete(set_one_future, std::chrono::seconds(5)));
+  EXPECT_EQ(1u, set_one_future.get().size());
+  EXPECT_EQ(43, node_with_option->get_parameter("foo").as_int());
+
+  EXPECT_THROW(
+    multi_node_client->set_parameters(
+      std::map<std::string, std::vector<rclcpp::Parameter>>{
+    {"/ns/unknown_node", {rclcpp::Parameter("foo", 43)}}}),
+    std::out_of_range);
+}
+
+/*
+  Coverage for the sync requests while the node of the client is spun by another executor
+ */
+TEST_F(TestParameterClient, sync_parameters_node_spun_by_another_executor) {
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  executor.add_node(node_with_option);
+  std::thread spin_thread([&executor]() {executor.spin();});
+
+  // The requests are waited for by the executor of the client, without adding the node to it.
+  auto synchronous_client = std::make_shared<rclcpp::SyncParametersClient>(
+    node, node_with_option->get_fully_qualified_name());
+  ASSERT_TRUE(synchronous_client->wait_for_service(std::chrono::seconds(5)));
+  for (int value = 0; value < 10; ++value) {
+    auto set_results = synchronous_client->set_parameters(
+      {rclcpp::Parameter("foo", value)}, std::chrono::seconds(5));
+    ASSERT_EQ(1u, set_results.size());
+    EXPECT_TRUE(set_results[0].successful);
+    auto parameters = synchronous_client->get_parameters({"foo"}, std::chrono::seconds(5));
+    ASSERT_EQ(1u, parameters.size());
+    EXPECT_EQ(value, parameters[0].as_int());
+  }
+
+  // The requests to the node of the client are served by the executor spinning it.
+  auto own_client = std::make_shared<rclcpp::SyncParametersClient>(node);
+  node->declare_parameter("foo", 4);
+  auto parameters = own_client->get_parameters({"foo"}, std::chrono::seconds(5));
+  ASSERT_EQ(1u, parameters.size());
+  EXPECT_EQ(4, parameters[0].as_int());
+
+  executor.cancel();
+  spin_thread.join();
+}
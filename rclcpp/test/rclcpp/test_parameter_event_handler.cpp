@@ -16,9 +16,11 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "rclcpp/rclcpp.hpp"
+#include "rclcpp/serialization.hpp"
 
 class TestParameterEventHandler : public rclcpp::ParameterEventHandler
 {
@@ -37,9 +39,21 @@ public:
     return callbacks_->event_callbacks_.size();
   }
 
+  void test_serialized_event(rcl_interfaces::msg::ParameterEvent::ConstSharedPtr event)
+  {
+    rclcpp::Serialization<rcl_interfaces::msg::ParameterEvent> serialization;
+    rclcpp::SerializedMessage serialized_event;
+    serialization.serialize_message(event.get(), &serialized_event);
+    callbacks_->serialized_event_callback(serialized_event);
+  }
+
   size_t num_parameter_callbacks()
   {
-    return callbacks_->parameter_callbacks_.size();
+    size_t count = 0u;
+    for (const auto & node_callbacks : callbacks_->parameter_callbacks_) {
+      count += node_callbacks.second.size();
+    }
+    return count;
   }
 };
 
@@ -430,3 +444,98 @@ TEST_F(TestNode, LastInFirstCallForParameterEventCallbacks)
   param_handler->remove_parameter_event_callback(h2);
   EXPECT_EQ(param_handler->num_event_callbacks(), 0UL);
 }
+
+TEST_F(TestNode, SerializedEventsOfOtherNodesAreDropped)
+{
+  int received{0};
+  auto cb = [&received](const rclcpp::Parameter &) {++received;};
+  auto h1 = param_handler->add_parameter_callback("my_int", cb, remote_node_name);
+
+  param_handler->test_serialized_event(diff_node_int);
+  EXPECT_EQ(received, 1);
+
+  // No callback is registered for the node in another namespace, its events are not
+  // deserialized.
+  param_handler->test_serialized_event(diff_ns_bool);
+  EXPECT_EQ(received, 1);
+
+  // Callbacks for all events receive the events of every node.
+  int received_events{0};
+  auto h2 = param_handler->add_parameter_event_callback(
+    [&received_events](const rcl_interfaces::msg::ParameterEvent &) {++received_events;});
+  param_handler->test_serialized_event(diff_ns_bool);
+  EXPECT_EQ(received, 1);
+  EXPECT_EQ(received_events, 1);
+
+  param_handler->remove_parameter_event_callback(h2);
+  param_handler->remove_parameter_callback(h1);
+  param_handler->test_serialized_event(diff_node_int);
+  EXPECT_EQ(received, 1);
+  EXPECT_EQ(param_handler->num_parameter_callbacks(), 0UL);
+}
+
+TEST_F(TestNode, LocalEventsAreGivenInProcess)
+{
+  auto other_node = std::make_shared<rclcpp::Node>("other_local_node");
+
+  std::vector<rclcpp::Parameter> received;
+  auto cb = [&received](const rclcpp::Parameter & p) {received.push_back(p);};
+  auto h1 = param_handler->add_parameter_callback("my_int", cb);
+  auto h2 = param_handler->add_parameter_callback(
+    "my_int", cb, other_node->get_fully_qualified_name());
+
+  // The callbacks are called before the parameters are set, without spinning the handler.
+  node->declare_parameter("my_int", 1);
+  ASSERT_EQ(received.size(), 1u);
+  EXPECT_EQ(received.back().as_int(), 1);
+  node->set_parameter(rclcpp::Parameter("my_int", 2));
+  ASSERT_EQ(received.size(), 2u);
+  EXPECT_EQ(received.back().as_int(), 2);
+  other_node->declare_parameter("my_int", 3);
+  ASSERT_EQ(received.size(), 3u);
+  EXPECT_EQ(received.back().as_int(), 3);
+
+  // The same events received on the topic are dropped.
+  param_handler->test_serialized_event(same_node_int);
+  EXPECT_EQ(received.size(), 3u);
+
+  // A destroyed handler is not given the events anymore.
+  param_handler.reset();
+  node->set_parameter(rclcpp::Parameter("my_int", 4));
+  EXPECT_EQ(received.size(), 3u);
+}
+
+TEST_F(TestNode, LocalEventsOfAnotherContextAreNotGivenInProcess)
+{
+  auto context = std::make_shared<rclcpp::Context>();
+  context->init(0, nullptr);
+  auto other_node = std::make_shared<rclcpp::Node>(
+    "other_context_node", rclcpp::NodeOptions().context(context));
+
+  int received{0};
+  auto h1 = param_handler->add_parameter_callback(
+    "my_int", [&received](const rclcpp::Parameter &) {++received;},
+    other_node->get_fully_qualified_name());
+
+  other_node->declare_parameter("my_int", 1);
+  EXPECT_EQ(received, 0);
+
+  other_node.reset();
+  context->shutdown("done");
+}
+
+TEST_F(TestNode, CallbackRemovingItself)
+{
+  int received{0};
+  rclcpp::ParameterCallbackHandle::SharedPtr handle;
+  auto cb = [this, &received, &handle](const rclcpp::Parameter &) {
+      ++received;
+      param_handler->remove_parameter_callback(handle);
+    };
+  handle = param_handler->add_parameter_callback("my_int", cb);
+
+  param_handler->test_event(same_node_int);
+  param_handler->test_event(same_node_int);
+  EXPECT_EQ(received, 1);
+  EXPECT_EQ(param_handler->num_parameter_callbacks(), 0UL);
+}
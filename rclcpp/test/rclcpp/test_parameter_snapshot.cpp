@@ -0,0 +1,121 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "rclcpp/exceptions.hpp"
+#include "rclcpp/parameter_snapshot.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+class TestParameterSnapshot : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    filename_ = (std::filesystem::temp_directory_path() / "rclcpp_test_parameter_snapshot")
+      .string();
+    std::remove(filename_.c_str());
+  }
+
+  void TearDown() override
+  {
+    std::remove(filename_.c_str());
+  }
+
+  std::string filename_;
+};
+
+TEST_F(TestParameterSnapshot, save_and_load_all_types) {
+  const std::vector<rclcpp::Parameter> parameters = {
+    rclcpp::Parameter("not_set"),
+    rclcpp::Parameter("bool", true),
+    rclcpp::Parameter("integer", int64_t(-42)),
+    rclcpp::Parameter("double", 2.5),
+    rclcpp::Parameter("string", "value"),
+    rclcpp::Parameter("byte_array", std::vector<uint8_t>{0u, 255u}),
+    rclcpp::Parameter("bool_array", std::vector<bool>{true, false, true}),
+    rclcpp::Parameter("integer_array", std::vector<int64_t>{1, -2, 3}),
+    rclcpp::Parameter("double_array", std::vector<double>{}),
+    rclcpp::Parameter("string_array", std::vector<std::string>{"a", "", "bc"}),
+  };
+
+  rclcpp::save_parameter_snapshot(filename_, parameters);
+  EXPECT_EQ(rclcpp::load_parameter_snapshot(filename_), parameters);
+
+  // An existing snapshot is replaced.
+  rclcpp::save_parameter_snapshot(filename_, {});
+  EXPECT_TRUE(rclcpp::load_parameter_snapshot(filename_).empty());
+}
+
+TEST_F(TestParameterSnapshot, invalid_snapshots) {
+  EXPECT_THROW(rclcpp::load_parameter_snapshot(filename_), std::system_error);
+
+  rclcpp::save_parameter_snapshot(
+    filename_, {rclcpp::Parameter("string_array", std::vector<std::string>{"a", "b"})});
+  std::string contents;
+  {
+    std::ifstream file(filename_, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+
+  // Every truncation is detected.
+  for (size_t size = 0u; size < contents.size(); ++size) {
+    {
+      std::ofstream file(filename_, std::ios::binary | std::ios::trunc);
+      file.write(contents.data(), static_cast<std::streamsize>(size));
+    }
+    EXPECT_THROW(
+      rclcpp::load_parameter_snapshot(filename_),
+      rclcpp::exceptions::InvalidParametersException) << "size " << size;
+  }
+
+  {
+    std::ofstream file(filename_, std::ios::binary | std::ios::trunc);
+    file << "a: 1\n";
+  }
+  EXPECT_THROW(
+    rclcpp::load_parameter_snapshot(filename_),
+    rclcpp::exceptions::InvalidParametersException);
+}
+
+TEST_F(TestParameterSnapshot, restore_node_parameters) {
+  rclcpp::init(0, nullptr);
+  {
+    auto node = std::make_shared<rclcpp::Node>("snapshot_node");
+    node->declare_parameter("gain", 1.5);
+    node->declare_parameter("offsets", std::vector<int64_t>{1, 2});
+    rclcpp::save_parameter_snapshot(filename_, *node->get_node_parameters_interface());
+  }
+
+  auto node = std::make_shared<rclcpp::Node>(
+    "snapshot_node",
+    rclcpp::NodeOptions()
+    .parameter_overrides(rclcpp::load_parameter_snapshot(filename_))
+    .automatically_declare_parameters_from_overrides(true));
+  EXPECT_EQ(node->get_parameter("gain").as_double(), 1.5);
+  EXPECT_EQ(node->get_parameter("offsets").as_integer_array(), (std::vector<int64_t>{1, 2}));
+  EXPECT_TRUE(node->has_parameter("use_sim_time"));
+  node.reset();
+  rclcpp::shutdown();
+}
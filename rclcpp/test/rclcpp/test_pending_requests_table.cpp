@@ -0,0 +1,97 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rclcpp/detail/pending_requests_table.hpp"
+
+using namespace std::chrono_literals;
+
+using Table = rclcpp::detail::PendingRequestsTable<std::unique_ptr<std::string>>;
+
+TEST(TestPendingRequestsTable, insert_take_erase) {
+  Table table;
+  const auto now = std::chrono::system_clock::now();
+  EXPECT_TRUE(table.insert(1, now, std::make_unique<std::string>("one")));
+  EXPECT_TRUE(table.insert(2, now, std::make_unique<std::string>("two")));
+  EXPECT_FALSE(table.insert(2, now, std::make_unique<std::string>("again")));
+  EXPECT_EQ(2u, table.size());
+
+  auto value = table.take(2);
+  ASSERT_TRUE(value.has_value());
+  EXPECT_EQ("two", **value);
+  EXPECT_FALSE(table.take(2).has_value());
+  EXPECT_FALSE(table.take(3).has_value());
+  EXPECT_TRUE(table.erase(1));
+  EXPECT_FALSE(table.erase(1));
+  EXPECT_EQ(0u, table.size());
+}
+
+/*
+   Test that the ring grows to hold many outstanding requests, also behind an old one.
+ */
+TEST(TestPendingRequestsTable, grow) {
+  Table table;
+  const auto now = std::chrono::system_clock::now();
+  for (int64_t i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(table.insert(i, now, std::make_unique<std::string>(std::to_string(i))));
+  }
+  for (int64_t i = 1; i < 1000; i += 2) {
+    ASSERT_TRUE(table.erase(i));
+  }
+  for (int64_t i = 1000; i < 3000; ++i) {
+    ASSERT_TRUE(table.insert(i, now, std::make_unique<std::string>(std::to_string(i))));
+  }
+  EXPECT_EQ(2500u, table.size());
+  for (int64_t i = 0; i < 1000; i += 2) {
+    auto value = table.take(i);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(std::to_string(i), **value);
+  }
+  for (int64_t i = 1000; i < 3000; ++i) {
+    auto value = table.take(i);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(std::to_string(i), **value);
+  }
+  EXPECT_EQ(0u, table.size());
+}
+
+TEST(TestPendingRequestsTable, erase_older_than) {
+  Table table;
+  const auto now = std::chrono::system_clock::now();
+  for (int64_t i = 0; i < 10; ++i) {
+    table.insert(i, now + std::chrono::seconds(i), std::make_unique<std::string>());
+  }
+  table.erase(2);
+  // Out of order, before the front of the ring
+  table.insert(-5, now, std::make_unique<std::string>());
+
+  std::vector<int64_t> erased;
+  EXPECT_EQ(5u, table.erase_older_than(now + 4500ms, &erased));
+  EXPECT_EQ((std::vector<int64_t>{0, 1, 3, 4, -5}), erased);
+  EXPECT_EQ(5u, table.size());
+  EXPECT_EQ(0u, table.erase_older_than(now));
+  EXPECT_TRUE(table.take(5).has_value());
+
+  table.clear();
+  EXPECT_EQ(0u, table.size());
+  EXPECT_FALSE(table.take(9).has_value());
+  EXPECT_TRUE(table.insert(100, now, std::make_unique<std::string>()));
+  EXPECT_EQ(1u, table.size());
+}
@@ -14,8 +14,10 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <string>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -27,6 +29,7 @@
 #include "../mocking_utils/patch.hpp"
 #include "../utils/rclcpp_gtest_macros.hpp"
 
+#include "test_msgs/msg/basic_types.hpp"
 #include "test_msgs/msg/empty.hpp"
 
 class TestPublisher : public ::testing::Test
@@ -181,11 +184,7 @@ static std::vector<TestParameters> invalid_qos_profiles()
 {
   std::vector<TestParameters> parameters;
 
-  parameters.reserve(2);
-  parameters.push_back(
-    TestParameters(
-      rclcpp::QoS(rclcpp::KeepLast(10)).transient_local(),
-      "transient_local_qos"));
+  parameters.reserve(1);
   parameters.push_back(
     TestParameters(
       rclcpp::QoS(rclcpp::KeepAll()),
@@ -393,9 +392,7 @@ TEST_F(TestPublisher, intra_process_publish_failures) {
   std::allocator<void> allocator;
   {
     rclcpp::LoanedMessage<test_msgs::msg::Empty> loaned_msg(*publisher, allocator);
-    RCLCPP_EXPECT_THROW_EQ(
-      publisher->publish(std::move(loaned_msg)),
-      std::runtime_error("storing loaned messages in intra process is not supported yet"));
+    EXPECT_NO_THROW(publisher->publish(std::move(loaned_msg)));
   }
 
   {
@@ -452,6 +449,213 @@ TEST_F(TestPublisher, inter_process_publish_failures) {
   EXPECT_NO_THROW(publisher->publish(std::move(loaned_msg)));
 }
 
+/*
+   Testing publishing a batch of messages, intra process and inter process.
+ */
+TEST_F(TestPublisher, publish_batch) {
+  using test_msgs::msg::Empty;
+  for (auto setting : {rclcpp::IntraProcessSetting::Enable, rclcpp::IntraProcessSetting::Disable}) {
+    initialize();
+    rclcpp::PublisherOptionsWithAllocator<std::allocator<void>> pub_options;
+    pub_options.use_intra_process_comm = setting;
+    auto publisher = node->create_publisher<Empty>("topic", 10, pub_options);
+    rclcpp::SubscriptionOptionsWithAllocator<std::allocator<void>> sub_options;
+    sub_options.use_intra_process_comm = setting;
+    size_t number_of_received = 0;
+    auto subscription = node->create_subscription<Empty>(
+      "topic", 10, [&number_of_received](Empty::ConstSharedPtr) {++number_of_received;},
+      sub_options);
+    // Messages published before the subscription is matched would be lost.
+    auto start = std::chrono::steady_clock::now();
+    while (publisher->get_subscription_count() == 0u &&
+      std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::vector<Empty> msgs(3);
+    EXPECT_NO_THROW(publisher->publish_batch(msgs));
+    std::vector<std::unique_ptr<Empty>> unique_msgs;
+    unique_msgs.push_back(std::make_unique<Empty>());
+    unique_msgs.push_back(std::make_unique<Empty>());
+    EXPECT_NO_THROW(publisher->publish_batch(unique_msgs.begin(), unique_msgs.end()));
+    unique_msgs.push_back(nullptr);
+    RCLCPP_EXPECT_THROW_EQ(
+      publisher->publish_batch(unique_msgs),
+      std::runtime_error("cannot publish msg which is a null pointer"));
+
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(node);
+    start = std::chrono::steady_clock::now();
+    while (number_of_received < 5u &&
+      std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+    {
+      executor.spin_some(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(5u, number_of_received);
+  }
+}
+
+TEST_F(TestPublisher, publish_lazy) {
+  using test_msgs::msg::Empty;
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto publisher = node->create_publisher<Empty>("topic", 10);
+  size_t number_of_generated = 0;
+  auto generator = [&number_of_generated]() {
+      ++number_of_generated;
+      return Empty();
+    };
+  EXPECT_FALSE(publisher->has_subscribers());
+  EXPECT_FALSE(publisher->publish_lazy(generator));
+  EXPECT_EQ(0u, number_of_generated);
+
+  size_t number_of_received = 0;
+  auto subscription = node->create_subscription<Empty>(
+    "topic", 10, [&number_of_received](Empty::ConstSharedPtr) {++number_of_received;});
+  // The subscription is seen once the graph change is handled.
+  auto start = std::chrono::steady_clock::now();
+  while (!publisher->has_subscribers() &&
+    std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_TRUE(publisher->has_subscribers());
+  EXPECT_TRUE(publisher->publish_lazy(generator));
+  EXPECT_TRUE(publisher->publish_lazy([]() {return std::make_unique<Empty>();}));
+  EXPECT_EQ(1u, number_of_generated);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  start = std::chrono::steady_clock::now();
+  while (number_of_received < 2u &&
+    std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+  {
+    executor.spin_some(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(2u, number_of_received);
+
+  subscription.reset();
+  start = std::chrono::steady_clock::now();
+  while (publisher->has_subscribers() &&
+    std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_FALSE(publisher->publish_lazy(generator));
+  EXPECT_EQ(1u, number_of_generated);
+}
+
+TEST_F(TestPublisher, publish_prepared_message) {
+  using test_msgs::msg::BasicTypes;
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto publisher = node->create_publisher<BasicTypes>("topic", 10);
+  BasicTypes msg;
+  msg.int32_value = 42;
+  auto prepared_msg = publisher->prepare_message(msg);
+  EXPECT_EQ(42, prepared_msg.get().int32_value);
+  BasicTypes deserialized_msg;
+  rclcpp::Serialization<BasicTypes>().deserialize_message(
+    &prepared_msg.get_serialized_message(), &deserialized_msg);
+  EXPECT_EQ(msg, deserialized_msg);
+  EXPECT_THROW(
+    publisher->prepare_message(std::unique_ptr<BasicTypes>()),
+    std::invalid_argument);
+
+  // The intra process subscriptions share the prepared message.
+  std::vector<const BasicTypes *> received;
+  auto subscription = node->create_subscription<BasicTypes>(
+    "topic", 10, [&received](BasicTypes::ConstSharedPtr m) {received.push_back(m.get());});
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_NO_THROW(publisher->publish(prepared_msg));
+  }
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  executor.spin_some();
+  EXPECT_EQ(std::vector<const BasicTypes *>(3, prepared_msg.get_shared().get()), received);
+
+  // Without intra process communication, the serialized message is published.
+  initialize();
+  auto inter_process_publisher = node->create_publisher<BasicTypes>("topic", 10);
+  EXPECT_NO_THROW(
+    inter_process_publisher->publish(inter_process_publisher->prepare_message(msg)));
+}
+
+TEST_F(TestPublisher, publish_shared_message) {
+  using test_msgs::msg::BasicTypes;
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto publisher = node->create_publisher<BasicTypes>("topic", 10);
+  EXPECT_THROW(
+    publisher->publish(std::shared_ptr<const BasicTypes>()),
+    std::runtime_error);
+
+  // The message is shared with the subscriptions taking it shared, and copied for the others.
+  const BasicTypes * shared_received = nullptr;
+  auto shared_subscription = node->create_subscription<BasicTypes>(
+    "topic", 10, [&shared_received](BasicTypes::ConstSharedPtr m) {shared_received = m.get();});
+  const BasicTypes * owned_received = nullptr;
+  int32_t owned_value = 0;
+  auto owned_subscription = node->create_subscription<BasicTypes>(
+    "topic", 10, [&owned_received, &owned_value](BasicTypes::UniquePtr m) {
+      owned_received = m.get();
+      owned_value = m->int32_value;
+    });
+  auto msg = std::make_shared<BasicTypes>();
+  msg->int32_value = 42;
+  EXPECT_NO_THROW(publisher->publish(std::shared_ptr<const BasicTypes>(msg)));
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  executor.spin_some();
+  EXPECT_EQ(msg.get(), shared_received);
+  EXPECT_NE(nullptr, owned_received);
+  EXPECT_NE(msg.get(), owned_received);
+  EXPECT_EQ(42, owned_value);
+
+  // Without intra process communication, the message is published inter process.
+  initialize();
+  auto inter_process_publisher = node->create_publisher<BasicTypes>("topic", 10);
+  EXPECT_NO_THROW(inter_process_publisher->publish(std::shared_ptr<const BasicTypes>(msg)));
+}
+
+/*
+   Testing that an inter process subscription does not make the intra process subscription
+   taking ownership receive a copy of a message published as a unique pointer.
+ */
+TEST_F(TestPublisher, publish_unique_message_with_inter_process_subscription) {
+  using test_msgs::msg::BasicTypes;
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto publisher = node->create_publisher<BasicTypes>("topic", 10);
+  const BasicTypes * owned_received = nullptr;
+  auto owned_subscription = node->create_subscription<BasicTypes>(
+    "topic", 10, [&owned_received](BasicTypes::UniquePtr m) {owned_received = m.get();});
+  rclcpp::SubscriptionOptions inter_process_options;
+  inter_process_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  size_t inter_process_count = 0;
+  auto inter_process_subscription = node->create_subscription<BasicTypes>(
+    "topic", 10, [&inter_process_count](const BasicTypes &) {++inter_process_count;},
+    inter_process_options);
+  auto start = std::chrono::steady_clock::now();
+  while (publisher->get_subscription_count() < 2u &&
+    std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(2u, publisher->get_subscription_count());
+
+  auto msg = std::make_unique<BasicTypes>();
+  const BasicTypes * published = msg.get();
+  publisher->publish(std::move(msg));
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  start = std::chrono::steady_clock::now();
+  while ((nullptr == owned_received || 0u == inter_process_count) &&
+    std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+  {
+    executor.spin_some(std::chrono::milliseconds(100));
+  }
+  EXPECT_EQ(published, owned_received);
+  EXPECT_EQ(1u, inter_process_count);
+}
+
 template<typename MessageT, typename AllocatorT = std::allocator<void>>
 class TestPublisherProtectedMethods : public rclcpp::Publisher<MessageT, AllocatorT>
 {
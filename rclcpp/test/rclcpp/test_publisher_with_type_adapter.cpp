@@ -333,3 +333,32 @@ TEST_F(TestPublisher, check_type_adapted_message_is_sent_and_received) {
     assert_message_was_received();
   }
 }
+
+/*
+   Testing the messages of a TypeAdapter converted into a reused ROS message.
+ */
+TEST_F(TestPublisher, type_adapted_message_converted_into_reused_ros_message) {
+  using StringTypeAdapter = rclcpp::TypeAdapter<std::string, rclcpp::msg::String>;
+  initialize();
+
+  rclcpp::PublisherOptions options;
+  options.reuse_converted_ros_message = true;
+  auto pub = node->create_publisher<StringTypeAdapter>("topic_name", 10, options);
+  auto sub = node->create_subscription<rclcpp::msg::String>(
+    "topic_name", 10, [](std::shared_ptr<const rclcpp::msg::String>) {FAIL();});
+
+  // The second message is shorter than the first, whose buffer it reuses.
+  for (const std::string message_data : {"first message", "second"}) {
+    pub->publish(message_data);
+    rclcpp::msg::String msg;
+    rclcpp::MessageInfo msg_info;
+    bool message_received = false;
+    auto start = std::chrono::steady_clock::now();
+    do {
+      message_received = sub->take(msg, msg_info);
+      std::this_thread::sleep_for(100ms);
+    } while (!message_received && std::chrono::steady_clock::now() - start < 10s);
+    EXPECT_TRUE(message_received);
+    EXPECT_EQ(message_data, msg.data);
+  }
+}
@@ -18,7 +18,10 @@
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "rclcpp/rclcpp.hpp"
 #include "rcutils/logging.h"
@@ -325,3 +328,142 @@ TEST_F(TestQosEvent, add_to_wait_set) {
     EXPECT_THROW(handler.add_to_wait_set(&wait_set), rclcpp::exceptions::RCLError);
   }
 }
+
+TEST_F(TestQosEvent, matched_callbacks) {
+  std::vector<rclcpp::MatchedInfo> publisher_infos;
+  rclcpp::PublisherOptions publisher_options;
+  publisher_options.event_callbacks.matched_callback =
+    [&publisher_infos](rclcpp::MatchedInfo & info) {
+      publisher_infos.push_back(info);
+    };
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>(
+    topic_name, 10, publisher_options);
+
+  std::vector<rclcpp::MatchedInfo> subscription_infos;
+  rclcpp::SubscriptionOptions subscription_options;
+  subscription_options.event_callbacks.matched_callback =
+    [&subscription_infos](rclcpp::MatchedInfo & info) {
+      subscription_infos.push_back(info);
+    };
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    topic_name, 10, message_callback, subscription_options);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  auto spin_until = [&executor](std::function<bool()> predicate) {
+      const auto start = std::chrono::steady_clock::now();
+      while (!predicate() && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+        executor.spin_some(std::chrono::milliseconds(10));
+      }
+      return predicate();
+    };
+
+  ASSERT_TRUE(
+    spin_until(
+      [&]() {
+        return !publisher_infos.empty() && 1u == publisher_infos.back().current_count &&
+        !subscription_infos.empty() && 1u == subscription_infos.back().current_count;
+      }));
+  EXPECT_EQ(1u, publisher_infos.back().total_count);
+  EXPECT_EQ(1u, subscription_infos.back().total_count);
+
+  // The changes are reported once.
+  const size_t publisher_info_count = publisher_infos.size();
+  executor.spin_some(std::chrono::milliseconds(10));
+  EXPECT_EQ(publisher_info_count, publisher_infos.size());
+
+  subscription.reset();
+  ASSERT_TRUE(
+    spin_until(
+      [&]() {
+        return 0u == publisher_infos.back().current_count;
+      }));
+  EXPECT_EQ(1u, publisher_infos.back().total_count);
+  EXPECT_EQ(0u, publisher_infos.back().total_count_change);
+  EXPECT_EQ(-1, publisher_infos.back().current_count_change);
+}
+
+TEST_F(TestQosEvent, no_event_handlers) {
+  // Without event callbacks nor default callbacks, the entities have no event handlers.
+  rclcpp::PublisherOptions publisher_options;
+  publisher_options.use_default_callbacks = false;
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>(
+    topic_name, 10, publisher_options);
+  EXPECT_TRUE(publisher->get_event_handlers().empty());
+  EXPECT_EQ(nullptr, publisher->get_event_handlers_waitable());
+
+  rclcpp::SubscriptionOptions subscription_options;
+  subscription_options.use_default_callbacks = false;
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    topic_name, 10, message_callback, subscription_options);
+  EXPECT_TRUE(subscription->get_event_handlers().empty());
+  EXPECT_EQ(nullptr, subscription->get_event_handlers_waitable());
+  EXPECT_THROW(
+    subscription->exchange_in_use_by_wait_set_state(publisher.get(), true),
+    std::runtime_error);
+}
+
+TEST_F(TestQosEvent, event_handler_group) {
+  std::vector<rclcpp::MatchedInfo> publisher_infos;
+  rclcpp::PublisherOptions publisher_options;
+  publisher_options.event_callbacks.matched_callback =
+    [&publisher_infos](rclcpp::MatchedInfo & info) {
+      publisher_infos.push_back(info);
+    };
+  auto publisher = node->create_publisher<test_msgs::msg::Empty>(
+    topic_name, 10, publisher_options);
+
+  // The matched handler is grouped with the default incompatible QoS handler, if supported.
+  const auto & handlers = publisher->get_event_handlers();
+  ASSERT_LE(1u, handlers.size());
+  auto waitable = publisher->get_event_handlers_waitable();
+  EXPECT_EQ(waitable, publisher->get_event_handlers_waitable());
+  if (handlers.size() == 1u) {
+    EXPECT_EQ(handlers[0], waitable);
+  } else {
+    ASSERT_NE(nullptr, std::dynamic_pointer_cast<rclcpp::QOSEventHandlerGroup>(waitable));
+  }
+
+  auto group = std::make_shared<rclcpp::QOSEventHandlerGroup>(handlers);
+  EXPECT_EQ(handlers, group->get_event_handlers());
+  size_t number_of_events = 0u;
+  size_t number_of_guard_conditions = 0u;
+  for (const auto & handler : handlers) {
+    number_of_events += handler->get_number_of_ready_events();
+    number_of_guard_conditions += handler->get_number_of_ready_guard_conditions();
+  }
+  EXPECT_EQ(number_of_events, group->get_number_of_ready_events());
+  EXPECT_EQ(number_of_guard_conditions, group->get_number_of_ready_guard_conditions());
+
+  // Events reported by the on ready callback are taken and executed one at a time.
+  std::mutex mutex;
+  std::vector<int> ready_handlers;
+  group->set_on_ready_callback(
+    [&mutex, &ready_handlers](size_t, int handler_index) {
+      std::lock_guard<std::mutex> lock(mutex);
+      ready_handlers.push_back(handler_index);
+    });
+  auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+    topic_name, 10, message_callback);
+  const auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!ready_handlers.empty()) {
+        break;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_FALSE(ready_handlers.empty());
+    // The matched handler is the last one.
+    EXPECT_EQ(static_cast<int>(handlers.size()) - 1, ready_handlers.front());
+  }
+  std::shared_ptr<void> data = group->take_data();
+  group->execute(data);
+  ASSERT_FALSE(publisher_infos.empty());
+  EXPECT_EQ(1u, publisher_infos.back().current_count);
+  group->clear_on_ready_callback();
+}
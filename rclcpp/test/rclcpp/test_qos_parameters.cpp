@@ -12,9 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gmock/gmock.h"
 
@@ -240,6 +242,45 @@ TEST(TestQosParameters, declare_no_parameters_interface) {
   rclcpp::shutdown();
 }
 
+TEST(TestQosParameters, declare_in_one_parameter_event) {
+  rclcpp::init(0, nullptr);
+  auto node = std::make_shared<rclcpp::Node>("my_node", "/ns");
+  std::vector<rcl_interfaces::msg::ParameterEvent> events;
+  auto subscription = node->create_subscription<rcl_interfaces::msg::ParameterEvent>(
+    "/parameter_events", rclcpp::ParameterEventsQoS(),
+    [&events](rcl_interfaces::msg::ParameterEvent::UniquePtr event) {
+      if (event->node == "/ns/my_node") {
+        events.push_back(*event);
+      }
+    });
+
+  {
+    rclcpp::node_interfaces::ParameterEventBatch batch(node->get_node_parameters_interface());
+    for (const char * topic_name : {"/topic_1", "/topic_2"}) {
+      rclcpp::detail::declare_qos_parameters(
+        rclcpp::QosOverridingOptions::with_default_policies(),
+        node,
+        topic_name,
+        rclcpp::QoS{rclcpp::KeepLast(10)},
+        rclcpp::detail::PublisherQosParametersTraits{});
+    }
+  }
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (events.empty() && std::chrono::steady_clock::now() < deadline) {
+    executor.spin_some(std::chrono::milliseconds(10));
+  }
+  // Let any unexpected extra event arrive.
+  executor.spin_some(std::chrono::milliseconds(100));
+
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ(6u, events[0].new_parameters.size());
+
+  rclcpp::shutdown();
+}
+
 TEST(TestQosParameters, internal_functions_failure_modes) {
   rclcpp::QoS qos{rclcpp::KeepLast{10}};
   EXPECT_THROW(
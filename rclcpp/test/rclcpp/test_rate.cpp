@@ -14,9 +14,16 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
 
 #include "rclcpp/rate.hpp"
+#include "rclcpp/utilities.hpp"
 
 /*
    Basic tests for the Rate and WallRate classes.
@@ -119,3 +126,50 @@ TEST(TestRate, from_double) {
     EXPECT_EQ(std::chrono::milliseconds(250), rate.period());
   }
 }
+
+TEST(TestRate, null_clock) {
+  EXPECT_THROW(rclcpp::Rate(1.0, nullptr), std::invalid_argument);
+}
+
+TEST(TestRate, clock_types) {
+  rclcpp::Rate rate(1.0);
+  EXPECT_EQ(RCL_SYSTEM_TIME, rate.get_type());
+  rclcpp::WallRate wall_rate(1.0);
+  EXPECT_EQ(RCL_STEADY_TIME, wall_rate.get_type());
+  rclcpp::Rate ros_rate(1.0, std::make_shared<rclcpp::Clock>(RCL_ROS_TIME));
+  EXPECT_EQ(RCL_ROS_TIME, ros_rate.get_type());
+  EXPECT_FALSE(ros_rate.is_steady());
+}
+
+TEST(TestRate, ros_time_rate) {
+  rclcpp::init(0, nullptr);
+  auto clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  ASSERT_EQ(RCL_RET_OK, rcl_enable_ros_time_override(clock->get_clock_handle()));
+  ASSERT_EQ(RCL_RET_OK, rcl_set_ros_time_override(clock->get_clock_handle(), 0));
+
+  // Simulated time advancing by 10 ms every real millisecond, set like a time source does
+  std::atomic<bool> done{false};
+  std::thread time_source_thread(
+    [clock, &done]() {
+      rcl_time_point_value_t t = 0;
+      while (!done.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        t += RCL_MS_TO_NS(10);
+        std::lock_guard<std::mutex> guard(clock->get_clock_mutex());
+        rcl_set_ros_time_override(clock->get_clock_handle(), t);
+      }
+    });
+
+  // A simulated second is much shorter than a real second
+  const auto start = std::chrono::steady_clock::now();
+  rclcpp::Rate rate(std::chrono::milliseconds(100), clock);
+  for (int i = 1; i <= 10; ++i) {
+    EXPECT_TRUE(rate.sleep());
+    EXPECT_LE(rclcpp::Time(RCL_MS_TO_NS(100) * i, RCL_ROS_TIME), clock->now());
+  }
+  EXPECT_GT(std::chrono::seconds(1), std::chrono::steady_clock::now() - start);
+
+  done.store(true);
+  time_source_thread.join();
+  rclcpp::shutdown();
+}
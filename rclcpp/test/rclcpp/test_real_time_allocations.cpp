@@ -0,0 +1,313 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/strategies/allocator_memory_strategy.hpp"
+#include "rclcpp/strategies/message_pool_memory_strategy.hpp"
+
+#include "test_msgs/msg/basic_types.hpp"
+
+using namespace std::chrono_literals;
+using rclcpp::memory_strategies::allocator_memory_strategy::AllocatorMemoryStrategy;
+using rclcpp::strategies::message_pool_memory_strategy::MessagePoolMemoryStrategy;
+using test_msgs::msg::BasicTypes;
+
+// This file checks that the hot paths do not allocate once warmed up, so that real-time
+// applications can rely on it. Only the allocations of the test thread are counted, the
+// middleware has threads of its own, and the allocations of the C libraries do not go through
+// operator new.
+
+static thread_local bool count_allocations = false;
+static thread_local size_t number_of_allocations = 0;
+
+void * operator new(std::size_t size)
+{
+  if (count_allocations) {
+    ++number_of_allocations;
+  }
+  void * pointer = std::malloc(size ? size : 1);
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void * operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void * pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void * pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void * pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void * pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+/// Number of the executions before the allocations are counted, and of the counted ones.
+constexpr size_t kWarmUpIterations = 10;
+constexpr size_t kCountedIterations = 100;
+
+/// Count the allocations made by a function after it was warmed up.
+size_t
+count_steady_state_allocations(const std::function<void()> & function)
+{
+  for (size_t i = 0; i < kWarmUpIterations; ++i) {
+    function();
+  }
+  number_of_allocations = 0;
+  for (size_t i = 0; i < kCountedIterations; ++i) {
+    count_allocations = true;
+    function();
+    count_allocations = false;
+  }
+  return number_of_allocations;
+}
+
+class TestRealTimeAllocations : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    rclcpp::init(0, nullptr);
+    node = std::make_shared<rclcpp::Node>("test_real_time_allocations", "ns");
+  }
+
+  void TearDown() override
+  {
+    node.reset();
+    rclcpp::shutdown();
+  }
+
+protected:
+  rclcpp::Node::SharedPtr node;
+};
+
+TEST_F(TestRealTimeAllocations, clock_now) {
+  for (auto clock_type : {RCL_SYSTEM_TIME, RCL_STEADY_TIME, RCL_ROS_TIME}) {
+    rclcpp::Clock clock(clock_type);
+    EXPECT_EQ(0u, count_steady_state_allocations([&clock]() {(void)clock.now();}));
+  }
+}
+
+TEST_F(TestRealTimeAllocations, publish) {
+  auto publisher = node->create_publisher<BasicTypes>("topic", 10);
+  BasicTypes message;
+  EXPECT_EQ(0u, count_steady_state_allocations([&]() {publisher->publish(message);}));
+}
+
+TEST_F(TestRealTimeAllocations, take) {
+  auto publisher = node->create_publisher<BasicTypes>("topic", 10);
+  auto subscription = node->create_subscription<BasicTypes>(
+    "topic", 10, [](const BasicTypes &) {});
+  BasicTypes message;
+  rclcpp::MessageInfo message_info;
+  size_t number_taken = 0;
+  const size_t allocations = count_steady_state_allocations(
+    [&]() {
+      count_allocations = false;
+      publisher->publish(message);
+      // Wait for the message, without counting the allocations of the polling.
+      const auto deadline = std::chrono::steady_clock::now() + 1s;
+      bool taken = false;
+      while (!taken && std::chrono::steady_clock::now() < deadline) {
+        count_allocations = true;
+        taken = subscription->take(message, message_info);
+        count_allocations = false;
+      }
+      number_taken += taken ? 1u : 0u;
+    });
+  EXPECT_EQ(kWarmUpIterations + kCountedIterations, number_taken);
+  EXPECT_EQ(0u, allocations);
+}
+
+/// Executor under test, with the memory strategy it is given.
+struct ExecutorFactory
+{
+  std::string name;
+  std::function<rclcpp::Executor::SharedPtr(const rclcpp::ExecutorOptions &)> create;
+  bool custom_allocator;
+};
+
+std::ostream &
+operator<<(std::ostream & os, const ExecutorFactory & factory)
+{
+  return os << factory.name;
+}
+
+class TestRealTimeAllocationsExecutor
+  : public TestRealTimeAllocations,
+  public ::testing::WithParamInterface<ExecutorFactory>
+{
+public:
+  void SetUp() override
+  {
+    TestRealTimeAllocations::SetUp();
+    rclcpp::ExecutorOptions options;
+    if (GetParam().custom_allocator) {
+      // The bookkeeping of the executor is backed by a fixed buffer, not by operator new.
+      buffer_resource = std::make_unique<std::pmr::monotonic_buffer_resource>(
+        buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+      pool_resource = std::make_unique<std::pmr::unsynchronized_pool_resource>(
+        buffer_resource.get());
+      using PolymorphicAllocator = std::pmr::polymorphic_allocator<void>;
+      options.memory_strategy = std::make_shared<AllocatorMemoryStrategy<PolymorphicAllocator>>(
+        std::make_shared<PolymorphicAllocator>(pool_resource.get()));
+    }
+    executor = GetParam().create(options);
+  }
+
+  void TearDown() override
+  {
+    executor.reset();
+    TestRealTimeAllocations::TearDown();
+    pool_resource.reset();
+    buffer_resource.reset();
+  }
+
+  /// Spin until a callback sets done, the allocations of the waits are counted.
+  void spin_until(const bool & done)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + 1s;
+    while (!done && std::chrono::steady_clock::now() < deadline) {
+      executor->spin_some(10ms);
+    }
+  }
+
+protected:
+  rclcpp::Executor::SharedPtr executor;
+  std::array<std::byte, 1 << 20> buffer;
+  std::unique_ptr<std::pmr::monotonic_buffer_resource> buffer_resource;
+  std::unique_ptr<std::pmr::unsynchronized_pool_resource> pool_resource;
+};
+
+TEST_P(TestRealTimeAllocationsExecutor, execute_subscription) {
+  auto publisher = node->create_publisher<BasicTypes>("topic", 10);
+  bool received = false;
+  // The messages are borrowed from a pool rather than allocated for each take.
+  auto subscription = node->create_subscription<BasicTypes>(
+    "topic", 10, [&received](const BasicTypes &) {received = true;},
+    rclcpp::SubscriptionOptions(), std::make_shared<MessagePoolMemoryStrategy<BasicTypes, 1>>());
+  executor->add_node(node);
+  executor->prepare_for_real_time();
+  BasicTypes message;
+  size_t number_received = 0;
+  const size_t allocations = count_steady_state_allocations(
+    [&]() {
+      count_allocations = false;
+      received = false;
+      publisher->publish(message);
+      count_allocations = true;
+      spin_until(received);
+      number_received += received ? 1u : 0u;
+    });
+  EXPECT_EQ(kWarmUpIterations + kCountedIterations, number_received);
+  EXPECT_EQ(0u, allocations);
+}
+
+TEST_P(TestRealTimeAllocationsExecutor, timer_dispatch) {
+  bool called = false;
+  auto timer = node->create_wall_timer(1ms, [&called]() {called = true;});
+  executor->add_node(node);
+  executor->prepare_for_real_time();
+  size_t number_called = 0;
+  const size_t allocations = count_steady_state_allocations(
+    [&]() {
+      called = false;
+      spin_until(called);
+      number_called += called ? 1u : 0u;
+    });
+  EXPECT_EQ(kWarmUpIterations + kCountedIterations, number_called);
+  EXPECT_EQ(0u, allocations);
+}
+
+TEST_P(TestRealTimeAllocationsExecutor, intra_process_delivery) {
+  auto intra_process_node = std::make_shared<rclcpp::Node>(
+    "intra_process", "ns", rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto publisher = intra_process_node->create_publisher<BasicTypes>("topic", 10);
+  bool received = false;
+  // The message is shared by the publisher and the subscription, so it is neither copied nor
+  // allocated for each publication.
+  auto subscription = intra_process_node->create_subscription<BasicTypes>(
+    "topic", 10, [&received](BasicTypes::ConstSharedPtr) {received = true;});
+  executor->add_node(intra_process_node);
+  executor->prepare_for_real_time();
+  auto message = std::make_shared<const BasicTypes>();
+  size_t number_received = 0;
+  const size_t allocations = count_steady_state_allocations(
+    [&]() {
+      received = false;
+      publisher->publish(message);
+      spin_until(received);
+      number_received += received ? 1u : 0u;
+    });
+  EXPECT_EQ(kWarmUpIterations + kCountedIterations, number_received);
+  EXPECT_EQ(0u, allocations);
+}
+
+template<typename ExecutorT>
+ExecutorFactory
+make_factory(const std::string & name, bool custom_allocator)
+{
+  return ExecutorFactory{
+    name,
+    [](const rclcpp::ExecutorOptions & options) -> rclcpp::Executor::SharedPtr {
+      return std::make_shared<ExecutorT>(options);
+    },
+    custom_allocator};
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  Executors,
+  TestRealTimeAllocationsExecutor,
+  ::testing::Values(
+    make_factory<rclcpp::executors::SingleThreadedExecutor>("single_threaded", false),
+    make_factory<rclcpp::executors::SingleThreadedExecutor>(
+      "single_threaded_custom_allocator", true),
+    // The multi threaded executor spins some on the calling thread.
+    make_factory<rclcpp::executors::MultiThreadedExecutor>("multi_threaded", false),
+    make_factory<rclcpp::executors::MultiThreadedExecutor>(
+      "multi_threaded_custom_allocator", true),
+    make_factory<rclcpp::executors::StaticSingleThreadedExecutor>("static_single_threaded", false)
+  ),
+  [](const ::testing::TestParamInfo<ExecutorFactory> & info) {
+    return info.param.name;
+  });
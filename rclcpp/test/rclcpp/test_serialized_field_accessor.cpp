@@ -0,0 +1,146 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_field_accessor.hpp"
+#include "rclcpp/serialized_message.hpp"
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+#include "test_msgs/message_fixtures.hpp"
+#include "test_msgs/msg/arrays.hpp"
+#include "test_msgs/msg/basic_types.hpp"
+#include "test_msgs/msg/bounded_sequences.hpp"
+#include "test_msgs/msg/builtins.hpp"
+#include "test_msgs/msg/strings.hpp"
+#include "test_msgs/msg/unbounded_sequences.hpp"
+
+template<typename MessageT>
+rclcpp::SerializedMessage
+serialize(const MessageT & message)
+{
+  rclcpp::SerializedMessage serialized_message;
+  rclcpp::Serialization<MessageT>().serialize_message(&message, &serialized_message);
+  return serialized_message;
+}
+
+template<typename MessageT>
+rclcpp::SerializedFieldAccessor
+make_accessor(const std::string & field_name)
+{
+  return rclcpp::SerializedFieldAccessor(
+    rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>(), field_name);
+}
+
+TEST(TestSerializedFieldAccessor, primitive_fields) {
+  using test_msgs::msg::BasicTypes;
+  auto bool_value = make_accessor<BasicTypes>("bool_value");
+  auto byte_value = make_accessor<BasicTypes>("byte_value");
+  auto char_value = make_accessor<BasicTypes>("char_value");
+  auto float32_value = make_accessor<BasicTypes>("float32_value");
+  auto float64_value = make_accessor<BasicTypes>("float64_value");
+  auto int8_value = make_accessor<BasicTypes>("int8_value");
+  auto uint8_value = make_accessor<BasicTypes>("uint8_value");
+  auto int16_value = make_accessor<BasicTypes>("int16_value");
+  auto uint16_value = make_accessor<BasicTypes>("uint16_value");
+  auto int32_value = make_accessor<BasicTypes>("int32_value");
+  auto uint32_value = make_accessor<BasicTypes>("uint32_value");
+  auto int64_value = make_accessor<BasicTypes>("int64_value");
+  auto uint64_value = make_accessor<BasicTypes>("uint64_value");
+  for (const auto & message : get_messages_basic_types()) {
+    const auto serialized_message = serialize(*message);
+    EXPECT_EQ(message->bool_value, bool_value.get<bool>(serialized_message));
+    EXPECT_EQ(message->byte_value, byte_value.get<uint8_t>(serialized_message));
+    EXPECT_EQ(message->char_value, char_value.get<uint8_t>(serialized_message));
+    EXPECT_EQ(message->float32_value, float32_value.get<float>(serialized_message));
+    EXPECT_EQ(message->float64_value, float64_value.get<double>(serialized_message));
+    EXPECT_EQ(message->int8_value, int8_value.get<int8_t>(serialized_message));
+    EXPECT_EQ(message->uint8_value, uint8_value.get<uint8_t>(serialized_message));
+    EXPECT_EQ(message->int16_value, int16_value.get<int16_t>(serialized_message));
+    EXPECT_EQ(message->uint16_value, uint16_value.get<uint16_t>(serialized_message));
+    EXPECT_EQ(message->int32_value, int32_value.get<int32_t>(serialized_message));
+    EXPECT_EQ(message->uint32_value, uint32_value.get<uint32_t>(serialized_message));
+    EXPECT_EQ(message->int64_value, int64_value.get<int64_t>(serialized_message));
+    EXPECT_EQ(message->uint64_value, uint64_value.get<uint64_t>(serialized_message));
+  }
+}
+
+TEST(TestSerializedFieldAccessor, nested_fields) {
+  using test_msgs::msg::Builtins;
+  auto sec = make_accessor<Builtins>("time_value.sec");
+  auto nanosec = make_accessor<Builtins>("time_value.nanosec");
+  for (const auto & message : get_messages_builtins()) {
+    const auto serialized_message = serialize(*message);
+    EXPECT_EQ(message->time_value.sec, sec.get<int32_t>(serialized_message));
+    EXPECT_EQ(message->time_value.nanosec, nanosec.get<uint32_t>(serialized_message));
+  }
+}
+
+TEST(TestSerializedFieldAccessor, fields_after_strings_arrays_and_sequences) {
+  auto string_value = make_accessor<test_msgs::msg::Strings>("string_value");
+  for (const auto & message : get_messages_strings()) {
+    EXPECT_EQ(message->string_value, string_value.get<std::string>(serialize(*message)));
+  }
+  auto arrays_alignment_check = make_accessor<test_msgs::msg::Arrays>("alignment_check");
+  for (const auto & message : get_messages_arrays()) {
+    EXPECT_EQ(
+      message->alignment_check, arrays_alignment_check.get<int32_t>(serialize(*message)));
+  }
+  auto bounded_alignment_check =
+    make_accessor<test_msgs::msg::BoundedSequences>("alignment_check");
+  for (const auto & message : get_messages_bounded_sequences()) {
+    EXPECT_EQ(
+      message->alignment_check, bounded_alignment_check.get<int32_t>(serialize(*message)));
+  }
+  auto unbounded_alignment_check =
+    make_accessor<test_msgs::msg::UnboundedSequences>("alignment_check");
+  for (const auto & message : get_messages_unbounded_sequences()) {
+    EXPECT_EQ(
+      message->alignment_check, unbounded_alignment_check.get<int32_t>(serialize(*message)));
+  }
+}
+
+TEST(TestSerializedFieldAccessor, type_known_by_name) {
+  rclcpp::SerializedFieldAccessor accessor("test_msgs/msg/Builtins", "time_value.sec");
+  for (const auto & message : get_messages_builtins()) {
+    EXPECT_EQ(message->time_value.sec, accessor.get<int32_t>(serialize(*message)));
+  }
+}
+
+TEST(TestSerializedFieldAccessor, errors) {
+  using test_msgs::msg::Arrays;
+  using test_msgs::msg::BasicTypes;
+  using test_msgs::msg::Builtins;
+  EXPECT_THROW(make_accessor<BasicTypes>("unknown_value"), std::invalid_argument);
+  EXPECT_THROW(make_accessor<BasicTypes>("int32_value.sec"), std::invalid_argument);
+  EXPECT_THROW(make_accessor<Builtins>("time_value"), std::invalid_argument);
+  EXPECT_THROW(make_accessor<Arrays>("int32_values"), std::invalid_argument);
+  EXPECT_THROW(
+    rclcpp::SerializedFieldAccessor(nullptr, "int32_value"), std::invalid_argument);
+
+  auto int32_value = make_accessor<BasicTypes>("int32_value");
+  auto serialized_message = serialize(*get_messages_basic_types()[0]);
+  EXPECT_THROW(int32_value.get<uint32_t>(serialized_message), std::invalid_argument);
+  EXPECT_THROW(int32_value.get<std::string>(serialized_message), std::invalid_argument);
+  serialized_message.get_rcl_serialized_message().buffer_length = 8;
+  EXPECT_THROW(int32_value.get<int32_t>(serialized_message), std::runtime_error);
+  serialized_message.get_rcl_serialized_message().buffer_length = 2;
+  EXPECT_THROW(int32_value.get<int32_t>(serialized_message), std::runtime_error);
+}
@@ -154,6 +154,49 @@ TEST(TestSerializedMessage, reserve) {
     rclcpp::exceptions::RCLBadAlloc);
 }
 
+TEST(TestSerializedMessage, external_buffer) {
+  const uint8_t content[] = {1, 2, 3, 4, 5};
+  size_t released_length = 0;
+  const uint8_t * released_buffer = nullptr;
+  auto deleter = [&released_length, &released_buffer](const uint8_t * buffer, size_t length) {
+      released_buffer = buffer;
+      released_length = length;
+    };
+  {
+    rclcpp::SerializedMessage serialized_msg(content, sizeof(content), deleter);
+    EXPECT_TRUE(serialized_msg.uses_external_buffer());
+    EXPECT_EQ(content, serialized_msg.get_rcl_serialized_message().buffer);
+    EXPECT_EQ(sizeof(content), serialized_msg.size());
+    EXPECT_EQ(sizeof(content), serialized_msg.capacity());
+
+    // A copy owns a copy of the buffer.
+    rclcpp::SerializedMessage copied_msg(serialized_msg);
+    EXPECT_FALSE(copied_msg.uses_external_buffer());
+    EXPECT_NE(content, copied_msg.get_rcl_serialized_message().buffer);
+    EXPECT_EQ(
+      0, std::memcmp(content, copied_msg.get_rcl_serialized_message().buffer, sizeof(content)));
+
+    // A move keeps the external buffer.
+    rclcpp::SerializedMessage moved_msg(std::move(serialized_msg));
+    EXPECT_TRUE(moved_msg.uses_external_buffer());
+    EXPECT_EQ(content, moved_msg.get_rcl_serialized_message().buffer);
+    EXPECT_EQ(nullptr, released_buffer);
+  }
+  EXPECT_EQ(content, released_buffer);
+  EXPECT_EQ(sizeof(content), released_length);
+
+  // Reserving memory copies the buffer first, and releases the external one.
+  released_buffer = nullptr;
+  rclcpp::SerializedMessage serialized_msg(content, sizeof(content), deleter);
+  serialized_msg.reserve(2 * sizeof(content));
+  EXPECT_EQ(content, released_buffer);
+  EXPECT_FALSE(serialized_msg.uses_external_buffer());
+  EXPECT_EQ(2 * sizeof(content), serialized_msg.capacity());
+  EXPECT_EQ(sizeof(content), serialized_msg.size());
+  EXPECT_EQ(
+    0, std::memcmp(content, serialized_msg.get_rcl_serialized_message().buffer, sizeof(content)));
+}
+
 TEST(TestSerializedMessage, serialization) {
   using MessageT = test_msgs::msg::BasicTypes;
 
@@ -173,6 +216,51 @@ TEST(TestSerializedMessage, serialization) {
   }
 }
 
+TEST(TestSerializedMessage, serialization_reuses_thread_local_buffer) {
+  using MessageT = test_msgs::msg::BasicTypes;
+
+  rclcpp::Serialization<MessageT> serializer;
+
+  auto basic_type_ros_msgs = get_messages_basic_types();
+  const rclcpp::SerializedMessage * buffer = nullptr;
+  size_t capacity = 0u;
+  for (const auto & ros_msg : basic_type_ros_msgs) {
+    const rclcpp::SerializedMessage & serialized_msg = serializer.serialize_message(ros_msg.get());
+    if (buffer) {
+      EXPECT_EQ(buffer, &serialized_msg);
+      EXPECT_GE(serialized_msg.capacity(), capacity);
+    }
+    buffer = &serialized_msg;
+    capacity = serialized_msg.capacity();
+
+    MessageT deserialized_ros_msg;
+    serializer.deserialize_message(&serialized_msg, &deserialized_ros_msg);
+    EXPECT_EQ(*ros_msg, deserialized_ros_msg);
+  }
+}
+
+TEST(TestSerializedMessage, serialization_into_buffer) {
+  using MessageT = test_msgs::msg::BasicTypes;
+
+  rclcpp::Serialization<MessageT> serializer;
+
+  auto basic_type_ros_msgs = get_messages_basic_types();
+  for (const auto & ros_msg : basic_type_ros_msgs) {
+    rclcpp::SerializedMessage serialized_msg;
+    serializer.serialize_message(ros_msg.get(), &serialized_msg);
+
+    uint8_t buffer[1024];
+    size_t size = serializer.serialize_into(ros_msg.get(), buffer, sizeof(buffer));
+    ASSERT_EQ(serialized_msg.size(), size);
+    EXPECT_EQ(
+      0, std::memcmp(serialized_msg.get_rcl_serialized_message().buffer, buffer, size));
+
+    EXPECT_THROW(
+      serializer.serialize_into(ros_msg.get(), buffer, size - 1u),
+      rclcpp::exceptions::RCLErrorBase);
+  }
+}
+
 TEST(TestSerializedMessage, assignment_operators) {
   const std::string content = "Hello World";
   const auto content_size = content.size() + 1;  // accounting for null terminator
@@ -0,0 +1,174 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "rclcpp/serialized_message_codec.hpp"
+
+#include "test_msgs/msg/strings.hpp"
+
+namespace
+{
+
+// Run-length encoding, as pairs of a count and a byte, standing for a compression library.
+class RunLengthCodec : public rclcpp::SerializedMessageCodec
+{
+public:
+  explicit RunLengthCodec(const std::string & name = "run_length")
+  : rclcpp::SerializedMessageCodec(name)
+  {}
+
+protected:
+  size_t
+  max_compressed_size(size_t size) const override
+  {
+    return 2 * size;
+  }
+
+  size_t
+  compress(const uint8_t * data, size_t size, uint8_t * compressed, size_t) override
+  {
+    size_t compressed_size = 0;
+    for (size_t i = 0; i < size; ) {
+      size_t run_end = i;
+      while (run_end < size && data[run_end] == data[i] && run_end - i < 255) {
+        ++run_end;
+      }
+      compressed[compressed_size++] = static_cast<uint8_t>(run_end - i);
+      compressed[compressed_size++] = data[i];
+      i = run_end;
+    }
+    return compressed_size;
+  }
+
+  bool
+  decompress(
+    const uint8_t * compressed, size_t compressed_size, uint8_t * data, size_t size) override
+  {
+    size_t decompressed_size = 0;
+    for (size_t i = 0; i + 1 < compressed_size; i += 2) {
+      if (decompressed_size + compressed[i] > size) {
+        return false;
+      }
+      std::memset(data + decompressed_size, compressed[i + 1], compressed[i]);
+      decompressed_size += compressed[i];
+    }
+    return decompressed_size == size;
+  }
+};
+
+rclcpp::SerializedMessage
+serialize_string_message(const std::string & string_value)
+{
+  test_msgs::msg::Strings message;
+  message.string_value = string_value;
+  rclcpp::SerializedMessage serialized_message;
+  rclcpp::Serialization<test_msgs::msg::Strings>().serialize_message(
+    &message, &serialized_message);
+  return serialized_message;
+}
+
+}  // namespace
+
+TEST(TestSerializedMessageCodec, invalid_name) {
+  EXPECT_THROW(RunLengthCodec(""), std::invalid_argument);
+  EXPECT_THROW(RunLengthCodec(std::string(256, 'a')), std::invalid_argument);
+}
+
+TEST(TestSerializedMessageCodec, encode_and_decode) {
+  RunLengthCodec codec;
+  const auto message = serialize_string_message(std::string(1000, 'a'));
+  EXPECT_FALSE(rclcpp::SerializedMessageCodec::is_encoded(message));
+
+  const auto encoded_message = codec.encode(message);
+  EXPECT_TRUE(rclcpp::SerializedMessageCodec::is_encoded(encoded_message));
+  EXPECT_LT(encoded_message.size(), message.size() / 10);
+
+  rclcpp::SerializedMessage decoded_message;
+  codec.decode(encoded_message, decoded_message);
+  ASSERT_EQ(message.size(), decoded_message.size());
+  EXPECT_EQ(
+    0, std::memcmp(
+      message.get_rcl_serialized_message().buffer,
+      decoded_message.get_rcl_serialized_message().buffer, message.size()));
+
+  // The messages of another codec are not decoded.
+  RunLengthCodec other_codec("other");
+  EXPECT_THROW(other_codec.decode(encoded_message, decoded_message), std::runtime_error);
+  EXPECT_THROW(codec.decode(message, decoded_message), std::runtime_error);
+}
+
+TEST(TestSerializedMessageCodec, incompressible_message_is_not_encoded) {
+  RunLengthCodec codec;
+  const auto message = serialize_string_message("abcdefgh");
+  const auto encoded_message = codec.encode(message);
+  EXPECT_FALSE(rclcpp::SerializedMessageCodec::is_encoded(encoded_message));
+  EXPECT_EQ(message.size(), encoded_message.size());
+}
+
+TEST(TestSerializedMessageCodec, generic_publisher_and_subscription) {
+  using namespace std::chrono_literals;
+  rclcpp::init(0, nullptr);
+  {
+    auto node = std::make_shared<rclcpp::Node>("serialized_message_codec");
+    const std::string topic_name = "/compressed_topic";
+    const std::string topic_type = "test_msgs/msg/Strings";
+    auto codec = std::make_shared<RunLengthCodec>();
+
+    std::string received_string;
+    rclcpp::SubscriptionOptions subscription_options;
+    subscription_options.serialized_message_codec = codec;
+    auto subscription = node->create_generic_subscription(
+      topic_name, topic_type, rclcpp::QoS(1),
+      [&received_string](std::shared_ptr<rclcpp::SerializedMessage> message) {
+        test_msgs::msg::Strings string_message;
+        rclcpp::Serialization<test_msgs::msg::Strings>().deserialize_message(
+          message.get(), &string_message);
+        received_string = string_message.string_value;
+      },
+      subscription_options);
+    size_t received_encoded_messages = 0;
+    auto raw_subscription = node->create_generic_subscription(
+      topic_name, topic_type, rclcpp::QoS(1),
+      [&received_encoded_messages](std::shared_ptr<rclcpp::SerializedMessage> message) {
+        if (rclcpp::SerializedMessageCodec::is_encoded(*message)) {
+          ++received_encoded_messages;
+        }
+      });
+    rclcpp::PublisherOptions publisher_options;
+    publisher_options.serialized_message_codec = codec;
+    auto publisher = node->create_generic_publisher(
+      topic_name, topic_type, rclcpp::QoS(1), publisher_options);
+
+    const std::string published_string(1000, 'a');
+    const auto start = std::chrono::steady_clock::now();
+    while (received_string.empty() && std::chrono::steady_clock::now() - start < 5s) {
+      publisher->publish(serialize_string_message(published_string));
+      rclcpp::spin_some(node);
+    }
+    EXPECT_EQ(published_string, received_string);
+    // The messages went through the middleware compressed.
+    EXPECT_GT(received_encoded_messages, 0u);
+  }
+  rclcpp::shutdown();
+}
@@ -14,9 +14,13 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "rclcpp/exceptions.hpp"
 #include "rclcpp/rclcpp.hpp"
@@ -24,6 +28,7 @@
 #include "../mocking_utils/patch.hpp"
 
 #include "rcl_interfaces/srv/list_parameters.hpp"
+#include "test_msgs/srv/basic_types.hpp"
 #include "test_msgs/srv/empty.hpp"
 #include "test_msgs/srv/empty.h"
 
@@ -235,3 +240,163 @@ TEST_F(TestService, send_response) {
       rclcpp::exceptions::RCLError);
   }
 }
+
+/*
+   Testing deferred responses sent concurrently from worker threads.
+ */
+TEST_F(TestService, deferred_response_from_worker_threads) {
+  using namespace std::chrono_literals;
+  using ServiceT = test_msgs::srv::Empty;
+  constexpr size_t number_of_requests = 8;
+
+  std::mutex workers_mutex;
+  std::vector<std::thread> workers;
+  rclcpp::Service<ServiceT>::SharedPtr server;
+  auto callback =
+    [&](std::shared_ptr<rmw_request_id_t> request_header, ServiceT::Request::SharedPtr) {
+      std::lock_guard<std::mutex> lock(workers_mutex);
+      workers.emplace_back(
+        [&server, request_header]() {
+          std::this_thread::sleep_for(10ms);
+          ServiceT::Response response;
+          server->send_response(*request_header, response);
+        });
+    };
+  server = node->create_service<ServiceT>("service", callback);
+  auto client = node->create_client<ServiceT>("service");
+  ASSERT_TRUE(client->wait_for_service(5s));
+
+  std::vector<rclcpp::Client<ServiceT>::SharedFuture> futures;
+  for (size_t i = 0; i < number_of_requests; ++i) {
+    futures.push_back(client->async_send_request(std::make_shared<ServiceT::Request>()).share());
+  }
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  for (auto & future : futures) {
+    EXPECT_EQ(
+      rclcpp::FutureReturnCode::SUCCESS,
+      executor.spin_until_future_complete(future, 5s));
+  }
+
+  std::lock_guard<std::mutex> lock(workers_mutex);
+  EXPECT_EQ(number_of_requests, workers.size());
+  for (auto & worker : workers) {
+    worker.join();
+  }
+}
+
+TEST_F(TestService, intra_process_request) {
+  using namespace std::chrono_literals;
+  using ServiceT = test_msgs::srv::BasicTypes;
+  auto intra_process_node = std::make_shared<rclcpp::Node>(
+    "intra_process_node", "/ns", rclcpp::NodeOptions().use_intra_process_comms(true));
+
+  const ServiceT::Request * received_request = nullptr;
+  auto server = intra_process_node->create_service<ServiceT>(
+    "intra_process_service",
+    [&received_request](
+      const ServiceT::Request::SharedPtr request, ServiceT::Response::SharedPtr response) {
+      received_request = request.get();
+      response->int32_value = request->int32_value + 1;
+    });
+  EXPECT_NE(nullptr, server->get_intra_process_waitable());
+  auto client = intra_process_node->create_client<ServiceT>("intra_process_service");
+  ASSERT_TRUE(client->wait_for_service(5s));
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(intra_process_node);
+  executor.add_node(node);
+
+  // The request is given to the service callback as is.
+  auto request = std::make_shared<ServiceT::Request>();
+  request->int32_value = 41;
+  auto future = client->async_send_request(request);
+  EXPECT_GT(0, future.request_id);
+  ASSERT_EQ(rclcpp::FutureReturnCode::SUCCESS, executor.spin_until_future_complete(future, 5s));
+  EXPECT_EQ(42, future.get()->int32_value);
+  EXPECT_EQ(request.get(), received_request);
+
+  // The clients of nodes without intra process communication use the middleware.
+  received_request = nullptr;
+  auto inter_process_client = node->create_client<ServiceT>("/ns/intra_process_service");
+  ASSERT_TRUE(inter_process_client->wait_for_service(5s));
+  auto inter_process_future = inter_process_client->async_send_request(request);
+  EXPECT_LT(0, inter_process_future.request_id);
+  ASSERT_EQ(
+    rclcpp::FutureReturnCode::SUCCESS,
+    executor.spin_until_future_complete(inter_process_future, 5s));
+  EXPECT_EQ(42, inter_process_future.get()->int32_value);
+  EXPECT_NE(nullptr, received_request);
+  EXPECT_NE(request.get(), received_request);
+}
+
+TEST_F(TestService, intra_process_deferred_response) {
+  using namespace std::chrono_literals;
+  using ServiceT = test_msgs::srv::BasicTypes;
+  auto intra_process_node = std::make_shared<rclcpp::Node>(
+    "intra_process_node", "/ns", rclcpp::NodeOptions().use_intra_process_comms(true));
+
+  rclcpp::Service<ServiceT>::SharedPtr server;
+  std::shared_ptr<rmw_request_id_t> pending_request_header;
+  server = intra_process_node->create_service<ServiceT>(
+    "intra_process_deferred_service",
+    [&pending_request_header](
+      std::shared_ptr<rmw_request_id_t> request_header, ServiceT::Request::SharedPtr) {
+      pending_request_header = request_header;
+    });
+  auto client = intra_process_node->create_client<ServiceT>("intra_process_deferred_service");
+  ASSERT_TRUE(client->wait_for_service(5s));
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(intra_process_node);
+  auto future = client->async_send_request(std::make_shared<ServiceT::Request>());
+  executor.spin_some();
+  ASSERT_NE(nullptr, pending_request_header);
+  EXPECT_EQ(std::future_status::timeout, future.wait_for(0s));
+
+  ServiceT::Response response;
+  response.int32_value = 7;
+  server->send_response(*pending_request_header, response);
+  ASSERT_EQ(std::future_status::ready, future.wait_for(0s));
+  EXPECT_EQ(7, future.get()->int32_value);
+}
+
+TEST_F(TestService, message_pools) {
+  using namespace std::chrono_literals;
+  using ServiceT = test_msgs::srv::BasicTypes;
+  std::vector<const ServiceT::Response *> responses;
+  std::vector<int32_t> initial_values;
+  auto server = node->create_service<ServiceT>(
+    "pooled_service",
+    [&responses, &initial_values](
+      const ServiceT::Request::SharedPtr request, ServiceT::Response::SharedPtr response) {
+      responses.push_back(response.get());
+      initial_values.push_back(response->int32_value);
+      response->int32_value = request->int32_value + 1;
+    });
+  server->set_message_pool_capacity(2);
+  auto client = node->create_client<ServiceT>("pooled_service");
+  client->set_message_pool_capacity(2);
+  ASSERT_TRUE(client->wait_for_service(5s));
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  for (int32_t i = 0; i < 2; ++i) {
+    auto request = client->borrow_request();
+    request->int32_value = i;
+    auto future = client->async_send_request(request);
+    ASSERT_EQ(rclcpp::FutureReturnCode::SUCCESS, executor.spin_until_future_complete(future, 5s));
+    EXPECT_EQ(i + 1, future.get()->int32_value);
+  }
+
+  // The response sent is given back to the pool, and reset before being reused.
+  ASSERT_EQ(2u, responses.size());
+  EXPECT_EQ(responses[0], responses[1]);
+  EXPECT_EQ(0, initial_values[1]);
+
+  // The messages in use outlive the pools.
+  auto response = server->borrow_response();
+  server->set_message_pool_capacity(0);
+  response.reset();
+  EXPECT_NE(nullptr, server->borrow_response());
+}
@@ -0,0 +1,286 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rcl_interfaces/msg/log.hpp"
+#include "rcl_interfaces/msg/parameter_event.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+using namespace std::chrono_literals;
+
+class TestSharedNodeInfrastructure : public ::testing::Test
+{
+public:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp()
+  {
+    node = std::make_shared<rclcpp::Node>("observer_node", "/ns");
+    for (int i = 0; i < 3; ++i) {
+      shared_nodes.push_back(
+        std::make_shared<rclcpp::Node>(
+          "shared_node_" + std::to_string(i), "/ns",
+          rclcpp::NodeOptions().use_shared_infrastructure(true)));
+      shared_nodes.back()->declare_parameter("value", i);
+    }
+  }
+
+  void TearDown()
+  {
+    shared_nodes.clear();
+    node.reset();
+  }
+
+  /// Spin the observer node until the predicate is true, or a timeout.
+  bool spin_until(std::function<bool()> predicate)
+  {
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(node);
+    const auto start = std::chrono::steady_clock::now();
+    while (!predicate() && std::chrono::steady_clock::now() - start < 10s) {
+      executor.spin_once(10ms);
+    }
+    return predicate();
+  }
+
+  /// Return the fully qualified name of the node hosting the shared parameter services.
+  std::string find_infrastructure_node()
+  {
+    std::string infrastructure_node;
+    spin_until(
+      [this, &infrastructure_node]() {
+        for (const auto & name : node->get_node_names()) {
+          if (name.find("/_node_infrastructure_") == 0u) {
+            infrastructure_node = name;
+          }
+        }
+        return !infrastructure_node.empty();
+      });
+    return infrastructure_node;
+  }
+
+  rclcpp::Node::SharedPtr node;
+  std::vector<rclcpp::Node::SharedPtr> shared_nodes;
+};
+
+TEST_F(TestSharedNodeInfrastructure, no_entities_per_node) {
+  std::map<std::string, std::vector<std::string>> service_names;
+  ASSERT_TRUE(
+    spin_until(
+      [this, &service_names]() {
+        service_names = node->get_service_names_and_types();
+        return service_names.count("/ns/observer_node/get_parameters") > 0u;
+      }));
+  EXPECT_EQ(0u, service_names.count("/ns/shared_node_0/get_parameters"));
+
+  // The nodes created from now on do not add any publisher.
+  const size_t parameter_event_publishers = node->count_publishers("/parameter_events");
+  const size_t rosout_publishers = node->count_publishers("/rosout");
+  for (int i = 3; i < 10; ++i) {
+    shared_nodes.push_back(
+      std::make_shared<rclcpp::Node>(
+        "shared_node_" + std::to_string(i), "/ns",
+        rclcpp::NodeOptions().use_shared_infrastructure(true)));
+  }
+  EXPECT_EQ(parameter_event_publishers, node->count_publishers("/parameter_events"));
+  EXPECT_EQ(rosout_publishers, node->count_publishers("/rosout"));
+}
+
+TEST_F(TestSharedNodeInfrastructure, parameter_services) {
+  const std::string infrastructure_node = find_infrastructure_node();
+  ASSERT_FALSE(infrastructure_node.empty());
+  auto client = std::make_shared<rclcpp::SyncParametersClient>(node, infrastructure_node);
+  ASSERT_TRUE(client->wait_for_service(10s));
+
+  auto parameters = client->get_parameters({"/ns/shared_node_0/value", "/ns/shared_node_2/value"});
+  ASSERT_EQ(2u, parameters.size());
+  EXPECT_EQ(0, parameters[0].as_int());
+  EXPECT_EQ(2, parameters[1].as_int());
+  EXPECT_TRUE(client->get_parameters({"/ns/unknown_node/value"}).empty());
+
+  auto results = client->set_parameters({rclcpp::Parameter("/ns/shared_node_1/value", 42)});
+  ASSERT_EQ(1u, results.size());
+  EXPECT_TRUE(results[0].successful);
+  EXPECT_EQ(42, shared_nodes[1]->get_parameter("value").as_int());
+
+  // The parameters of several nodes are not set atomically.
+  auto result = client->set_parameters_atomically(
+    {rclcpp::Parameter("/ns/shared_node_0/value", 1),
+      rclcpp::Parameter("/ns/shared_node_1/value", 1)});
+  EXPECT_FALSE(result.successful);
+  EXPECT_EQ(0, shared_nodes[0]->get_parameter("value").as_int());
+
+  auto listed = client->list_parameters({"/ns/shared_node_2"}, 0u);
+  EXPECT_NE(
+    listed.names.end(),
+    std::find(listed.names.begin(), listed.names.end(), "/ns/shared_node_2/value"));
+  EXPECT_EQ(
+    listed.names.end(),
+    std::find(listed.names.begin(), listed.names.end(), "/ns/shared_node_0/value"));
+
+  auto descriptors = client->describe_parameters({"/ns/shared_node_0/value"});
+  ASSERT_EQ(1u, descriptors.size());
+  EXPECT_EQ("/ns/shared_node_0/value", descriptors[0].name);
+
+  // The parameters of a destroyed node are not served anymore.
+  shared_nodes.pop_back();
+  EXPECT_TRUE(client->get_parameters({"/ns/shared_node_2/value"}).empty());
+}
+
+TEST_F(TestSharedNodeInfrastructure, parameter_events) {
+  std::vector<std::string> event_nodes;
+  auto subscription = node->create_subscription<rcl_interfaces::msg::ParameterEvent>(
+    "/parameter_events", rclcpp::ParameterEventsQoS(),
+    [&event_nodes](rcl_interfaces::msg::ParameterEvent::ConstSharedPtr event) {
+      for (const auto & parameter : event->changed_parameters) {
+        if (parameter.name == "value") {
+          event_nodes.push_back(event->node);
+        }
+      }
+    });
+  ASSERT_TRUE(
+    spin_until(
+      [this]() {
+        return shared_nodes[0]->count_subscribers("/parameter_events") > 0u &&
+        node->count_publishers("/parameter_events") > 1u;
+      }));
+
+  shared_nodes[0]->set_parameter(rclcpp::Parameter("value", 10));
+  shared_nodes[2]->set_parameter(rclcpp::Parameter("value", 12));
+  EXPECT_TRUE(spin_until([&event_nodes]() {return event_nodes.size() >= 2u;}));
+  ASSERT_EQ(2u, event_nodes.size());
+  EXPECT_EQ("/ns/shared_node_0", event_nodes[0]);
+  EXPECT_EQ("/ns/shared_node_2", event_nodes[1]);
+}
+
+TEST_F(TestSharedNodeInfrastructure, time_source) {
+  auto clock = shared_nodes[1]->get_clock();
+  EXPECT_FALSE(clock->ros_time_is_active());
+  // The time source sees the parameter event through the shared subscription.
+  shared_nodes[1]->set_parameter(rclcpp::Parameter("use_sim_time", true));
+  EXPECT_TRUE(spin_until([&clock]() {return clock->ros_time_is_active();}));
+  EXPECT_FALSE(shared_nodes[0]->get_clock()->ros_time_is_active());
+
+  shared_nodes[1]->set_parameter(rclcpp::Parameter("use_sim_time", false));
+  EXPECT_TRUE(spin_until([&clock]() {return !clock->ros_time_is_active();}));
+}
+
+TEST_F(TestSharedNodeInfrastructure, rosout) {
+  std::vector<rcl_interfaces::msg::Log> logs;
+  auto subscription = node->create_subscription<rcl_interfaces::msg::Log>(
+    "/rosout", rclcpp::RosoutQoS(),
+    [&logs](rcl_interfaces::msg::Log::ConstSharedPtr log) {
+      if (log->msg == "shared rosout") {
+        logs.push_back(*log);
+      }
+    });
+  ASSERT_TRUE(
+    spin_until([this]() {return shared_nodes[0]->count_subscribers("/rosout") > 0u;}));
+
+  RCLCPP_INFO(shared_nodes[0]->get_logger(), "shared %s", "rosout");
+  EXPECT_TRUE(spin_until([&logs]() {return !logs.empty();}));
+  ASSERT_EQ(1u, logs.size());
+  EXPECT_EQ(shared_nodes[0]->get_logger().get_name(), logs[0].name);
+  EXPECT_EQ(rcl_interfaces::msg::Log::INFO, logs[0].level);
+  EXPECT_EQ(std::string(__FILE__), logs[0].file);
+}
+
+TEST(TestRosoutAggregation, invalid_options) {
+  rclcpp::RosoutAggregationOptions options;
+  options.period = 0ms;
+  EXPECT_THROW(rclcpp::InitOptions().rosout_aggregation(options), std::invalid_argument);
+  options.period = 100ms;
+  options.max_pending_records = 0u;
+  EXPECT_THROW(rclcpp::InitOptions().rosout_aggregation(options), std::invalid_argument);
+}
+
+TEST(TestRosoutAggregation, repeated_and_dropped_records) {
+  rclcpp::RosoutAggregationOptions aggregation_options;
+  aggregation_options.enabled = true;
+  aggregation_options.period = 50ms;
+  aggregation_options.max_records_per_second = 5u;
+  aggregation_options.max_pending_records = 4u;
+  rclcpp::InitOptions init_options;
+  init_options.rosout_aggregation(aggregation_options);
+  auto context = std::make_shared<rclcpp::Context>();
+  context->init(0, nullptr, init_options);
+
+  auto observer = std::make_shared<rclcpp::Node>(
+    "observer_node", "/ns", rclcpp::NodeOptions().context(context).enable_rosout(false));
+  auto node = std::make_shared<rclcpp::Node>(
+    "aggregated_node", "/ns", rclcpp::NodeOptions().context(context));
+  EXPECT_TRUE(node->get_node_options().use_shared_rosout());
+  EXPECT_FALSE(node->get_node_options().get_rcl_node_options()->enable_rosout);
+
+  std::vector<rcl_interfaces::msg::Log> logs;
+  auto subscription = observer->create_subscription<rcl_interfaces::msg::Log>(
+    "/rosout", rclcpp::RosoutQoS(),
+    [&logs](rcl_interfaces::msg::Log::ConstSharedPtr log) {
+      if (log->msg.find("aggregated") == 0u || log->name == "rclcpp") {
+        logs.push_back(*log);
+      }
+    });
+  rclcpp::ExecutorOptions executor_options;
+  executor_options.context = context;
+  rclcpp::executors::SingleThreadedExecutor executor(executor_options);
+  executor.add_node(observer);
+  auto spin_until = [&executor](std::function<bool()> predicate) {
+      const auto start = std::chrono::steady_clock::now();
+      while (!predicate() && std::chrono::steady_clock::now() - start < 10s) {
+        executor.spin_once(10ms);
+      }
+      return predicate();
+    };
+  ASSERT_TRUE(spin_until([&node]() {return node->count_subscribers("/rosout") > 0u;}));
+
+  // The repetitions are published once, the records beyond the pending ones are dropped.
+  for (int i = 0; i < 10; ++i) {
+    RCLCPP_INFO(node->get_logger(), "aggregated repeated");
+  }
+  for (int i = 0; i < 5; ++i) {
+    RCLCPP_INFO(node->get_logger(), "aggregated %d", i);
+  }
+  EXPECT_TRUE(spin_until([&logs]() {return logs.size() >= 5u;}));
+  ASSERT_EQ(5u, logs.size());
+  EXPECT_EQ("aggregated repeated (logged 10 times)", logs[0].msg);
+  EXPECT_EQ(node->get_logger().get_name(), logs[0].name);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ("aggregated " + std::to_string(i), logs[i + 1].msg);
+  }
+  EXPECT_EQ("rclcpp", logs[4].name);
+  EXPECT_EQ(rcl_interfaces::msg::Log::WARN, logs[4].level);
+  EXPECT_EQ(0u, logs[4].msg.find("2 log records were dropped"));
+
+  node.reset();
+  observer.reset();
+  context->shutdown("test finished");
+}
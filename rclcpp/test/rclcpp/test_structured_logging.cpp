@@ -0,0 +1,201 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/logger.hpp"
+#include "rclcpp/structured_logging.hpp"
+
+namespace structured_logging = rclcpp::structured_logging;
+using rclcpp::Logger;
+
+namespace
+{
+
+class CapturingSink : public structured_logging::Sink
+{
+public:
+  void
+  consume(const structured_logging::Record & record) override
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    records.push_back(record);
+    messages.push_back(structured_logging::format(record));
+  }
+
+  std::mutex mutex;
+  std::vector<structured_logging::Record> records;
+  std::vector<std::string> messages;
+};
+
+class TestStructuredLogging : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    sink = std::make_shared<CapturingSink>();
+    structured_logging::add_sink(sink);
+  }
+
+  void TearDown()
+  {
+    structured_logging::remove_sink(sink);
+  }
+
+  std::shared_ptr<CapturingSink> sink;
+  Logger logger = rclcpp::get_logger("test_structured_logging");
+};
+
+}  // namespace
+
+TEST(TestStructuredLoggingFormat, format) {
+  structured_logging::Site site{
+    0u, RCUTILS_LOG_SEVERITY_INFO, "%d|%5.2f|%s|%x|%03u|%c|%ld|%%|%-4s|%*d|%", "function",
+    "file", 1u};
+  structured_logging::Record record{
+    &site, "logger", 0,
+    {int64_t(-42), 3.14159, std::string("text"), uint64_t(255), uint64_t(7), int64_t('z'),
+      int64_t(1) << 40, std::string("ab"), int64_t(4), int64_t(12)}};
+  EXPECT_EQ(
+    "-42| 3.14|text|ff|007|z|1099511627776|%|ab  |  12|%", structured_logging::format(record));
+
+  // Missing arguments are left as is.
+  site.format = "%d and %s";
+  record.arguments = {int64_t(1)};
+  EXPECT_EQ("1 and %s", structured_logging::format(record));
+}
+
+TEST_F(TestStructuredLogging, log_and_flush) {
+  const std::string text("copied");
+  const char * c_string = "c string";
+  RCLCPP_LOG_STRUCTURED(
+    logger, Logger::Level::Info, "int %d unsigned %u double %.1f %s %s %s", -1, 2u, 0.5, text,
+    c_string, "literal");
+  RCLCPP_LOG_STRUCTURED(logger, Logger::Level::Warn, "no arguments");
+  // Disabled severity.
+  RCLCPP_LOG_STRUCTURED(logger, Logger::Level::Debug, "debug %d", 1);
+  structured_logging::flush();
+
+  ASSERT_EQ(2u, sink->messages.size());
+  EXPECT_EQ("int -1 unsigned 2 double 0.5 copied c string literal", sink->messages[0]);
+  EXPECT_EQ("no arguments", sink->messages[1]);
+  const auto & record = sink->records[0];
+  EXPECT_EQ("test_structured_logging", record.logger_name);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_INFO, record.site->severity);
+  EXPECT_EQ(std::string(__FILE__), record.site->file_name);
+  EXPECT_GT(record.timestamp, 0);
+  ASSERT_EQ(6u, record.arguments.size());
+  EXPECT_EQ(int64_t(-1), std::get<int64_t>(record.arguments[0]));
+  EXPECT_EQ(uint64_t(2u), std::get<uint64_t>(record.arguments[1]));
+  EXPECT_EQ(0.5, std::get<double>(record.arguments[2]));
+  EXPECT_NE(sink->records[0].site->id, sink->records[1].site->id);
+}
+
+TEST_F(TestStructuredLogging, same_site) {
+  for (int i = 0; i < 3; ++i) {
+    RCLCPP_LOG_STRUCTURED(logger, Logger::Level::Info, "iteration %d", i);
+  }
+  structured_logging::flush();
+  ASSERT_EQ(3u, sink->records.size());
+  EXPECT_EQ(sink->records[0].site, sink->records[2].site);
+  EXPECT_EQ("iteration 2", sink->messages[2]);
+}
+
+TEST_F(TestStructuredLogging, threads) {
+  constexpr int kThreads = 4;
+  constexpr int kRecordsPerThread = 100;
+  const uint64_t dropped_before = structured_logging::get_dropped_record_count();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back(
+      [this, i]() {
+        for (int j = 0; j < kRecordsPerThread; ++j) {
+          RCLCPP_LOG_STRUCTURED(logger, Logger::Level::Info, "thread %d record %d", i, j);
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  // The records of exited threads are still consumed.
+  structured_logging::flush();
+  const uint64_t dropped = structured_logging::get_dropped_record_count() - dropped_before;
+  EXPECT_EQ(static_cast<size_t>(kThreads * kRecordsPerThread), sink->records.size() + dropped);
+}
+
+TEST_F(TestStructuredLogging, drop_when_full) {
+  structured_logging::set_thread_buffer_size(256u);
+  const uint64_t dropped_before = structured_logging::get_dropped_record_count();
+  std::thread thread(
+    [this]() {
+      const std::string long_text(100u, 'x');
+      for (int i = 0; i < 10; ++i) {
+        RCLCPP_LOG_STRUCTURED(logger, Logger::Level::Info, "%s", long_text);
+      }
+    });
+  thread.join();
+  structured_logging::set_thread_buffer_size(64u * 1024u);
+  structured_logging::flush();
+  const uint64_t dropped = structured_logging::get_dropped_record_count() - dropped_before;
+  EXPECT_GT(dropped, 0u);
+  EXPECT_EQ(10u, sink->records.size() + dropped);
+}
+
+TEST_F(TestStructuredLogging, binary_file) {
+  const std::string path = testing::TempDir() + "test_structured_logging.bin";
+  auto file_sink = std::make_shared<structured_logging::BinaryFileSink>(path);
+  structured_logging::add_sink(file_sink);
+  for (int i = 0; i < 3; ++i) {
+    RCLCPP_LOG_STRUCTURED(logger, Logger::Level::Error, "value %d of %s", i, "file");
+  }
+  RCLCPP_LOG_STRUCTURED(logger, Logger::Level::Info, "ratio %.2f", 0.25);
+  structured_logging::remove_sink(file_sink);
+  file_sink.reset();
+
+  std::vector<std::string> messages;
+  std::vector<int> severities;
+  structured_logging::read_binary_file(
+    path, [&](const structured_logging::Record & record) {
+      EXPECT_EQ("test_structured_logging", record.logger_name);
+      messages.push_back(structured_logging::format(record));
+      severities.push_back(record.site->severity);
+    });
+  EXPECT_EQ(sink->messages, messages);
+  ASSERT_EQ(4u, messages.size());
+  EXPECT_EQ("value 1 of file", messages[1]);
+  EXPECT_EQ("ratio 0.25", messages[3]);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_ERROR, severities[0]);
+  EXPECT_EQ(RCUTILS_LOG_SEVERITY_INFO, severities[3]);
+  std::remove(path.c_str());
+
+  EXPECT_THROW(
+    structured_logging::read_binary_file(path, [](const structured_logging::Record &) {}),
+    std::runtime_error);
+}
+
+TEST(TestStructuredLoggingDisabled, no_sinks) {
+  const Logger logger = rclcpp::get_logger("test_structured_logging");
+  int evaluations = 0;
+  RCLCPP_LOG_STRUCTURED(logger, Logger::Level::Fatal, "%d", ++evaluations);
+  EXPECT_EQ(0, evaluations);
+}
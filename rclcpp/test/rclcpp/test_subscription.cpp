@@ -27,6 +27,7 @@
 #include "../mocking_utils/patch.hpp"
 #include "../utils/rclcpp_gtest_macros.hpp"
 
+#include "test_msgs/msg/basic_types.hpp"
 #include "test_msgs/msg/empty.hpp"
 
 using namespace std::chrono_literals;
@@ -489,11 +490,7 @@ static std::vector<TestParameters> invalid_qos_profiles()
 {
   std::vector<TestParameters> parameters;
 
-  parameters.reserve(3);
-  parameters.push_back(
-    TestParameters(
-      rclcpp::QoS(rclcpp::KeepLast(10)).transient_local(),
-      "transient_local_qos"));
+  parameters.reserve(1);
   parameters.push_back(
     TestParameters(
       rclcpp::QoS(rclcpp::KeepAll()),
@@ -540,3 +537,524 @@ TEST_F(TestSubscription, get_network_flow_endpoints_errors) {
     EXPECT_NO_THROW(subscription->get_network_flow_endpoints());
   }
 }
+
+/*
+   Testing that an executor takes up to max_messages_per_take messages per readiness event.
+ */
+TEST_F(TestSubscription, max_messages_per_take) {
+  initialize();
+  auto callback = [](test_msgs::msg::Empty::ConstSharedPtr) {};
+  {
+    rclcpp::SubscriptionOptions options;
+    options.max_messages_per_take = 0;
+    EXPECT_THROW(
+      node->create_subscription<test_msgs::msg::Empty>(
+        "~/test_max_messages_per_take", 10, callback, options), std::invalid_argument);
+  }
+  {
+    auto sub = node->create_subscription<test_msgs::msg::Empty>(
+      "~/test_max_messages_per_take", 10, callback);
+    EXPECT_EQ(1u, sub->get_max_messages_per_take());
+  }
+
+  size_t received = 0;
+  rclcpp::SubscriptionOptions options;
+  options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  options.max_messages_per_take = 3;
+  auto sub = node->create_subscription<test_msgs::msg::Empty>(
+    "~/test_max_messages_per_take", 10,
+    [&received](test_msgs::msg::Empty::ConstSharedPtr) {++received;}, options);
+  EXPECT_EQ(3u, sub->get_max_messages_per_take());
+  rclcpp::PublisherOptions publisher_options;
+  publisher_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  auto pub = node->create_publisher<test_msgs::msg::Empty>(
+    "~/test_max_messages_per_take", 10, publisher_options);
+  for (size_t i = 0; i < 5; ++i) {
+    pub->publish(test_msgs::msg::Empty());
+  }
+  // Give the middleware time to deliver all messages before the subscription is executed.
+  std::this_thread::sleep_for(100ms);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  auto start = std::chrono::steady_clock::now();
+  while (received == 0 && std::chrono::steady_clock::now() - start < 10s) {
+    executor.spin_once(100ms);
+  }
+  EXPECT_EQ(3u, received);
+  start = std::chrono::steady_clock::now();
+  while (received < 5 && std::chrono::steady_clock::now() - start < 10s) {
+    executor.spin_once(100ms);
+  }
+  EXPECT_EQ(5u, received);
+}
+
+/*
+   Testing that only the latest message is handled with take_latest_only.
+ */
+TEST_F(TestSubscription, take_latest_only) {
+  initialize();
+  {
+    auto sub = node->create_subscription<test_msgs::msg::BasicTypes>(
+      "~/test_take_latest_only", 10, [](test_msgs::msg::BasicTypes::ConstSharedPtr) {});
+    EXPECT_FALSE(sub->get_take_latest_only());
+  }
+
+  std::vector<int32_t> received;
+  auto callback = [&received](test_msgs::msg::BasicTypes::ConstSharedPtr msg) {
+      received.push_back(msg->int32_value);
+    };
+  rclcpp::SubscriptionOptions options;
+  options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  options.take_latest_only = true;
+  auto sub = node->create_subscription<test_msgs::msg::BasicTypes>(
+    "~/test_take_latest_only", 10, callback, options);
+  EXPECT_TRUE(sub->get_take_latest_only());
+  rclcpp::PublisherOptions publisher_options;
+  publisher_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  auto pub = node->create_publisher<test_msgs::msg::BasicTypes>(
+    "~/test_take_latest_only", 10, publisher_options);
+  test_msgs::msg::BasicTypes msg;
+  for (int32_t i = 0; i < 5; ++i) {
+    msg.int32_value = i;
+    pub->publish(msg);
+  }
+  // Give the middleware time to deliver all messages before the subscription is executed.
+  std::this_thread::sleep_for(100ms);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  auto start = std::chrono::steady_clock::now();
+  while (received.empty() && std::chrono::steady_clock::now() - start < 10s) {
+    executor.spin_once(100ms);
+  }
+  executor.spin_some();
+  EXPECT_EQ(std::vector<int32_t>({4}), received);
+}
+
+/*
+   Testing that the intra-process buffer keeps the latest message only with take_latest_only.
+ */
+TEST_F(TestSubscription, take_latest_only_intra_process) {
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  std::vector<int32_t> received;
+  auto callback = [&received](const test_msgs::msg::BasicTypes & msg) {
+      received.push_back(msg.int32_value);
+    };
+  rclcpp::SubscriptionOptions options;
+  options.take_latest_only = true;
+  {
+    rclcpp::SubscriptionOptions adaptive_options = options;
+    adaptive_options.intra_process_buffer_memory_budget = 8 * sizeof(test_msgs::msg::BasicTypes);
+    EXPECT_THROW(
+      node->create_subscription<test_msgs::msg::BasicTypes>(
+        "~/test_take_latest_only_intra_process", 10, callback, adaptive_options),
+      std::invalid_argument);
+  }
+  auto sub = node->create_subscription<test_msgs::msg::BasicTypes>(
+    "~/test_take_latest_only_intra_process", 10, callback, options);
+  auto pub = node->create_publisher<test_msgs::msg::BasicTypes>(
+    "~/test_take_latest_only_intra_process", 10);
+  test_msgs::msg::BasicTypes msg;
+  for (int32_t i = 0; i < 5; ++i) {
+    msg.int32_value = i;
+    pub->publish(msg);
+  }
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  executor.spin_some();
+  EXPECT_EQ(std::vector<int32_t>({4}), received);
+}
+
+/*
+   Testing that the messages arriving within the minimum message period are dropped.
+ */
+TEST_F(TestSubscription, min_message_period) {
+  initialize();
+  std::vector<int32_t> received;
+  auto callback = [&received](test_msgs::msg::BasicTypes::ConstSharedPtr msg) {
+      received.push_back(msg->int32_value);
+    };
+  rclcpp::SubscriptionOptions options;
+  options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  {
+    rclcpp::SubscriptionOptions negative_options = options;
+    negative_options.min_message_period = -1s;
+    EXPECT_THROW(
+      node->create_subscription<test_msgs::msg::BasicTypes>(
+        "~/test_min_message_period", 10, callback, negative_options),
+      std::invalid_argument);
+  }
+  options.min_message_period = 1h;
+  options.max_messages_per_take = 10;
+  auto sub = node->create_subscription<test_msgs::msg::BasicTypes>(
+    "~/test_min_message_period", 10, callback, options);
+  EXPECT_EQ(std::chrono::nanoseconds(1h), sub->get_min_message_period());
+  EXPECT_FALSE(sub->is_message_rate_limited());
+  rclcpp::PublisherOptions publisher_options;
+  publisher_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+  auto pub = node->create_publisher<test_msgs::msg::BasicTypes>(
+    "~/test_min_message_period", 10, publisher_options);
+  test_msgs::msg::BasicTypes msg;
+  for (int32_t i = 0; i < 3; ++i) {
+    msg.int32_value = i;
+    pub->publish(msg);
+  }
+  // Give the middleware time to deliver all messages before the subscription is executed.
+  std::this_thread::sleep_for(100ms);
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  auto start = std::chrono::steady_clock::now();
+  while (received.empty() && std::chrono::steady_clock::now() - start < 10s) {
+    executor.spin_once(100ms);
+  }
+  EXPECT_TRUE(sub->is_message_rate_limited());
+  // The remaining messages are taken and dropped.
+  executor.spin_some();
+  msg.int32_value = 3;
+  pub->publish(msg);
+  std::this_thread::sleep_for(100ms);
+  executor.spin_some();
+  EXPECT_EQ(std::vector<int32_t>({0}), received);
+}
+
+/*
+   Testing that the messages published intra process within the minimum message period are
+   dropped before being queued.
+ */
+TEST_F(TestSubscription, min_message_period_intra_process) {
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  std::vector<int32_t> received;
+  auto callback = [&received](const test_msgs::msg::BasicTypes & msg) {
+      received.push_back(msg.int32_value);
+    };
+  rclcpp::SubscriptionOptions options;
+  options.min_message_period = 1h;
+  auto sub = node->create_subscription<test_msgs::msg::BasicTypes>(
+    "~/test_min_message_period_intra_process", 10, callback, options);
+  auto pub = node->create_publisher<test_msgs::msg::BasicTypes>(
+    "~/test_min_message_period_intra_process", 10);
+  test_msgs::msg::BasicTypes msg;
+  for (int32_t i = 0; i < 3; ++i) {
+    msg.int32_value = i;
+    pub->publish(msg);
+  }
+  auto buffer = std::dynamic_pointer_cast<rclcpp::experimental::SubscriptionIntraProcessBase>(
+    sub->get_intra_process_waitable());
+  ASSERT_NE(nullptr, buffer);
+  EXPECT_EQ(1u, buffer->get_lag());
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  executor.spin_some();
+  EXPECT_EQ(std::vector<int32_t>({0}), received);
+}
+
+/*
+   Testing the content filter of a subscription, replaced at runtime, with messages published
+   inter and intra process.
+ */
+TEST_F(TestSubscription, content_filter) {
+  initialize();
+  std::vector<int32_t> received;
+  auto callback = [&received](const test_msgs::msg::BasicTypes & msg) {
+      received.push_back(msg.int32_value);
+    };
+  rclcpp::SubscriptionOptions invalid_options;
+  invalid_options.content_filter_options.filter_expression = "unknown_value = 1";
+  EXPECT_THROW(
+    node->create_subscription<test_msgs::msg::BasicTypes>(
+      "~/test_content_filter", 10, callback, invalid_options),
+    std::invalid_argument);
+
+  for (const bool intra_process : {false, true}) {
+    received.clear();
+    const auto intra_process_setting =
+      intra_process ? rclcpp::IntraProcessSetting::Enable : rclcpp::IntraProcessSetting::Disable;
+    rclcpp::SubscriptionOptions options;
+    options.use_intra_process_comm = intra_process_setting;
+    options.content_filter_options.filter_expression = "int32_value > %0";
+    options.content_filter_options.expression_parameters = {"1"};
+    auto sub = node->create_subscription<test_msgs::msg::BasicTypes>(
+      "~/test_content_filter", 10, callback, options);
+    EXPECT_TRUE(sub->is_cft_enabled());
+    EXPECT_EQ("int32_value > %0", sub->get_content_filter().filter_expression);
+    rclcpp::PublisherOptions publisher_options;
+    publisher_options.use_intra_process_comm = intra_process_setting;
+    auto pub = node->create_publisher<test_msgs::msg::BasicTypes>(
+      "~/test_content_filter", 10, publisher_options);
+
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(node);
+    const auto publish_and_spin = [&](int32_t first, size_t expected_size) {
+        test_msgs::msg::BasicTypes msg;
+        for (int32_t i = first; i < first + 4; ++i) {
+          msg.int32_value = i;
+          pub->publish(msg);
+        }
+        auto start = std::chrono::steady_clock::now();
+        while (received.size() < expected_size && std::chrono::steady_clock::now() - start < 10s) {
+          executor.spin_some(100ms);
+        }
+      };
+    publish_and_spin(0, 2);
+    EXPECT_EQ(std::vector<int32_t>({2, 3}), received);
+
+    sub->set_content_filter("int32_value < %0 OR int32_value = %1", {"5", "7"});
+    publish_and_spin(4, 4);
+    EXPECT_EQ(std::vector<int32_t>({2, 3, 4, 7}), received);
+
+    sub->set_content_filter("");
+    EXPECT_FALSE(sub->is_cft_enabled());
+    EXPECT_TRUE(sub->get_content_filter().filter_expression.empty());
+    publish_and_spin(8, 8);
+    EXPECT_EQ(std::vector<int32_t>({2, 3, 4, 7, 8, 9, 10, 11}), received);
+  }
+}
+
+/*
+   Testing the lag and drop counters of adaptive and fixed-size intra-process buffers.
+ */
+TEST_F(TestSubscription, adaptive_intra_process_buffer) {
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto callback = [](const test_msgs::msg::Empty &) {};
+  rclcpp::SubscriptionOptions options;
+  options.intra_process_buffer_memory_budget = 8 * sizeof(test_msgs::msg::Empty);
+  auto adaptive_sub = node->create_subscription<test_msgs::msg::Empty>(
+    "~/test_adaptive_intra_process_buffer", 2, callback, options);
+  auto fixed_sub = node->create_subscription<test_msgs::msg::Empty>(
+    "~/test_adaptive_intra_process_buffer", 2, callback);
+  options.intra_process_buffer_type = rclcpp::IntraProcessBufferType::LockFreeSharedPtr;
+  EXPECT_THROW(
+    node->create_subscription<test_msgs::msg::Empty>(
+      "~/test_adaptive_intra_process_buffer", 2, callback, options),
+    std::invalid_argument);
+
+  auto pub = node->create_publisher<test_msgs::msg::Empty>(
+    "~/test_adaptive_intra_process_buffer", 2);
+  for (size_t i = 0; i < 10; ++i) {
+    pub->publish(test_msgs::msg::Empty());
+  }
+
+  using rclcpp::experimental::SubscriptionIntraProcessBase;
+  auto adaptive_buffer = std::dynamic_pointer_cast<SubscriptionIntraProcessBase>(
+    adaptive_sub->get_intra_process_waitable());
+  ASSERT_NE(nullptr, adaptive_buffer);
+  EXPECT_EQ(8u, adaptive_buffer->get_lag());
+  EXPECT_EQ(8u, adaptive_buffer->get_buffer_capacity());
+  EXPECT_EQ(2u, adaptive_buffer->get_dropped_count());
+
+  auto fixed_buffer = std::dynamic_pointer_cast<SubscriptionIntraProcessBase>(
+    fixed_sub->get_intra_process_waitable());
+  ASSERT_NE(nullptr, fixed_buffer);
+  EXPECT_EQ(2u, fixed_buffer->get_lag());
+  EXPECT_EQ(2u, fixed_buffer->get_buffer_capacity());
+  EXPECT_EQ(8u, fixed_buffer->get_dropped_count());
+}
+
+/*
+   Testing the message lost event of messages dropped by the intra-process buffer.
+ */
+TEST_F(TestSubscription, intra_process_message_lost_callback) {
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  std::vector<rclcpp::QOSMessageLostInfo> events;
+  rclcpp::SubscriptionOptions options;
+  options.event_callbacks.message_lost_callback = [&events](rclcpp::QOSMessageLostInfo & info) {
+      events.push_back(info);
+    };
+  auto sub = node->create_subscription<test_msgs::msg::Empty>(
+    "~/test_intra_process_message_lost", 1, [](const test_msgs::msg::Empty &) {}, options);
+  auto pub = node->create_publisher<test_msgs::msg::Empty>(
+    "~/test_intra_process_message_lost", 1);
+  for (size_t i = 0; i < 3; ++i) {
+    pub->publish(test_msgs::msg::Empty());
+  }
+
+  ASSERT_EQ(2u, events.size());
+  EXPECT_EQ(1u, events[0].total_count);
+  EXPECT_EQ(1u, events[0].total_count_change);
+  EXPECT_EQ(2u, events[1].total_count);
+  EXPECT_EQ(1u, events[1].total_count_change);
+}
+
+/*
+   Testing the replay of the messages of a transient local publisher to late intra-process
+   subscriptions.
+ */
+TEST_F(TestSubscription, intra_process_transient_local) {
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto callback = [](const test_msgs::msg::Empty &) {};
+  auto pub = node->create_publisher<test_msgs::msg::Empty>(
+    "~/test_intra_process_transient_local", rclcpp::QoS(2).transient_local());
+  for (size_t i = 0; i < 3; ++i) {
+    pub->publish(test_msgs::msg::Empty());
+  }
+
+  auto transient_local_sub = node->create_subscription<test_msgs::msg::Empty>(
+    "~/test_intra_process_transient_local", rclcpp::QoS(10).transient_local(), callback);
+  auto volatile_sub = node->create_subscription<test_msgs::msg::Empty>(
+    "~/test_intra_process_transient_local", 10, callback);
+
+  using rclcpp::experimental::SubscriptionIntraProcessBase;
+  auto transient_local_buffer = std::dynamic_pointer_cast<SubscriptionIntraProcessBase>(
+    transient_local_sub->get_intra_process_waitable());
+  ASSERT_NE(nullptr, transient_local_buffer);
+  auto volatile_buffer = std::dynamic_pointer_cast<SubscriptionIntraProcessBase>(
+    volatile_sub->get_intra_process_waitable());
+  ASSERT_NE(nullptr, volatile_buffer);
+  // Only the history of the publisher is replayed, to the transient local subscription.
+  EXPECT_EQ(2u, transient_local_buffer->get_lag());
+  EXPECT_EQ(0u, volatile_buffer->get_lag());
+
+  pub->publish(test_msgs::msg::Empty());
+  EXPECT_EQ(3u, transient_local_buffer->get_lag());
+  EXPECT_EQ(1u, volatile_buffer->get_lag());
+}
+
+/*
+   Testing the message info given to the callbacks of intra-process subscriptions.
+ */
+TEST_F(TestSubscription, intra_process_message_info) {
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  std::vector<rmw_message_info_t> shared_infos;
+  auto shared_callback =
+    [&shared_infos](test_msgs::msg::Empty::ConstSharedPtr, const rclcpp::MessageInfo & info) {
+      shared_infos.push_back(info.get_rmw_message_info());
+    };
+  std::vector<rmw_message_info_t> unique_infos;
+  auto unique_callback =
+    [&unique_infos](test_msgs::msg::Empty::UniquePtr, const rclcpp::MessageInfo & info) {
+      unique_infos.push_back(info.get_rmw_message_info());
+    };
+  auto shared_sub = node->create_subscription<test_msgs::msg::Empty>(
+    "~/test_intra_process_message_info", 10, shared_callback);
+  auto unique_sub = node->create_subscription<test_msgs::msg::Empty>(
+    "~/test_intra_process_message_info", 10, unique_callback);
+  auto pub = node->create_publisher<test_msgs::msg::Empty>(
+    "~/test_intra_process_message_info", 10);
+  for (size_t i = 0; i < 3; ++i) {
+    pub->publish(test_msgs::msg::Empty());
+  }
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  executor.spin_some();
+  for (const auto & infos : {shared_infos, unique_infos}) {
+    ASSERT_EQ(3u, infos.size());
+    for (size_t i = 0; i < infos.size(); ++i) {
+      EXPECT_TRUE(infos[i].from_intra_process);
+      EXPECT_EQ(i + 1, infos[i].publication_sequence_number);
+      EXPECT_TRUE(*pub == infos[i].publisher_gid);
+      EXPECT_GT(infos[i].source_timestamp, 0);
+      EXPECT_GE(infos[i].received_timestamp, infos[i].source_timestamp);
+    }
+  }
+}
+
+/*
+   Testing the direct dispatch of the messages published intra process, through a chain of two
+   subscriptions limited to one nested direct dispatch.
+ */
+TEST_F(TestSubscription, intra_process_direct_dispatch) {
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  rclcpp::SubscriptionOptions options;
+  options.intra_process_direct_dispatch_depth = 1;
+  options.callback_group = node->create_callback_group(rclcpp::CallbackGroupType::Reentrant);
+  auto pub_b = node->create_publisher<test_msgs::msg::BasicTypes>("~/test_direct_dispatch_b", 10);
+  std::vector<int32_t> received_a;
+  auto sub_a = node->create_subscription<test_msgs::msg::BasicTypes>(
+    "~/test_direct_dispatch_a", 10,
+    [&received_a, &pub_b](const test_msgs::msg::BasicTypes & msg) {
+      received_a.push_back(msg.int32_value);
+      pub_b->publish(msg);
+    }, options);
+  std::vector<int32_t> received_b;
+  auto sub_b = node->create_subscription<test_msgs::msg::BasicTypes>(
+    "~/test_direct_dispatch_b", 10,
+    [&received_b](const test_msgs::msg::BasicTypes & msg) {
+      received_b.push_back(msg.int32_value);
+    }, options);
+  auto pub_a = node->create_publisher<test_msgs::msg::BasicTypes>("~/test_direct_dispatch_a", 10);
+  auto buffer_a = std::dynamic_pointer_cast<rclcpp::experimental::SubscriptionIntraProcessBase>(
+    sub_a->get_intra_process_waitable());
+  auto buffer_b = std::dynamic_pointer_cast<rclcpp::experimental::SubscriptionIntraProcessBase>(
+    sub_b->get_intra_process_waitable());
+  ASSERT_NE(nullptr, buffer_a);
+  ASSERT_NE(nullptr, buffer_b);
+
+  // Queued, since the callback group is not added to an executor yet.
+  test_msgs::msg::BasicTypes msg;
+  msg.int32_value = 0;
+  pub_a->publish(msg);
+  EXPECT_TRUE(received_a.empty());
+  EXPECT_EQ(1u, buffer_a->get_lag());
+
+  // Executed by the executor, which is not a direct dispatch, so the next stage is dispatched.
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  executor.spin_some();
+  EXPECT_EQ(std::vector<int32_t>({0}), received_a);
+  EXPECT_EQ(std::vector<int32_t>({0}), received_b);
+  EXPECT_EQ(0u, buffer_a->get_direct_dispatch_count());
+  EXPECT_EQ(1u, buffer_b->get_direct_dispatch_count());
+
+  // Dispatched in publish(), the next stage being queued beyond the maximum depth.
+  msg.int32_value = 1;
+  pub_a->publish(msg);
+  EXPECT_EQ(std::vector<int32_t>({0, 1}), received_a);
+  EXPECT_EQ(std::vector<int32_t>({0}), received_b);
+  EXPECT_EQ(1u, buffer_a->get_direct_dispatch_count());
+  EXPECT_EQ(1u, buffer_b->get_lag());
+  executor.spin_some();
+  EXPECT_EQ(std::vector<int32_t>({0, 1}), received_b);
+}
+
+/*
+   Testing the subscriptions reading the messages of a publisher from its intra-process ring,
+   one of them keeping fewer messages than the ring.
+ */
+TEST_F(TestSubscription, intra_process_ring) {
+  initialize(rclcpp::NodeOptions().use_intra_process_comms(true));
+  rclcpp::PublisherOptions publisher_options;
+  publisher_options.use_intra_process_ring = true;
+  auto pub = node->create_publisher<test_msgs::msg::BasicTypes>(
+    "~/test_intra_process_ring", 10, publisher_options);
+  std::vector<int32_t> received;
+  auto sub = node->create_subscription<test_msgs::msg::BasicTypes>(
+    "~/test_intra_process_ring", 10,
+    [&received](const test_msgs::msg::BasicTypes & msg) {
+      received.push_back(msg.int32_value);
+    });
+  std::vector<int32_t> received_shallow;
+  auto shallow_sub = node->create_subscription<test_msgs::msg::BasicTypes>(
+    "~/test_intra_process_ring", 2,
+    [&received_shallow](const test_msgs::msg::BasicTypes & msg) {
+      received_shallow.push_back(msg.int32_value);
+    });
+  EXPECT_EQ(2u, pub->get_intra_process_subscription_count());
+
+  test_msgs::msg::BasicTypes msg;
+  for (int32_t i = 0; i < 5; ++i) {
+    msg.int32_value = i;
+    pub->publish(msg);
+  }
+  auto buffer = std::dynamic_pointer_cast<rclcpp::experimental::SubscriptionIntraProcessBase>(
+    sub->get_intra_process_waitable());
+  auto shallow_buffer =
+    std::dynamic_pointer_cast<rclcpp::experimental::SubscriptionIntraProcessBase>(
+    shallow_sub->get_intra_process_waitable());
+  ASSERT_NE(nullptr, buffer);
+  ASSERT_NE(nullptr, shallow_buffer);
+  EXPECT_EQ(5u, buffer->get_lag());
+  EXPECT_EQ(2u, shallow_buffer->get_lag());
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  executor.spin_some();
+  EXPECT_EQ(std::vector<int32_t>({0, 1, 2, 3, 4}), received);
+  EXPECT_EQ(std::vector<int32_t>({3, 4}), received_shallow);
+  EXPECT_EQ(0u, buffer->get_dropped_count());
+  EXPECT_EQ(3u, shallow_buffer->get_dropped_count());
+}
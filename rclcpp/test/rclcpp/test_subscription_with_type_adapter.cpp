@@ -601,3 +601,74 @@ TEST_F(
     }
   }
 }
+
+/*
+ * Testing that type adapted messages published intra process reach the subscriptions with the
+ * same type adapter without being converted.
+ */
+TEST_F(
+  CLASSNAME(test_intra_process_within_one_node, RMW_IMPLEMENTATION),
+  check_type_adapted_messages_are_not_converted_intra_process) {
+  using StringTypeAdapter = rclcpp::TypeAdapter<std::string, rclcpp::msg::String>;
+  const std::string message_data = "Message Data";
+  const std::string topic_name = "topic_name";
+
+  auto node = rclcpp::Node::make_shared(
+    "test_intra_process",
+    rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto pub = node->create_publisher<StringTypeAdapter>(topic_name, 1);
+
+  {
+    { // std::unique_ptr<std::string>, the published message is moved to the subscription
+      const std::string * received_message = nullptr;
+      auto callback =
+        [message_data, &received_message](std::unique_ptr<std::string> msg) -> void {
+          ASSERT_STREQ(message_data.c_str(), msg->c_str());
+          received_message = msg.get();
+        };
+      auto sub = node->create_subscription<StringTypeAdapter>(topic_name, 1, callback);
+      ASSERT_TRUE(wait_for_match(sub, pub));
+      auto msg = std::make_unique<std::string>(message_data);
+      const std::string * published_message = msg.get();
+      pub->publish(std::move(msg));
+      bool is_received = false;
+      rclcpp::executors::SingleThreadedExecutor executor;
+      executor.add_node(node);
+      for (int i = 0; !is_received && i < g_max_loops; ++i) {
+        executor.spin_once(g_sleep_per_loop);
+        is_received = received_message != nullptr;
+      }
+      ASSERT_TRUE(is_received);
+      EXPECT_EQ(published_message, received_message);
+    }
+    { // std::shared_ptr<const std::string> and rclcpp::msg::String on the same topic
+      std::shared_ptr<const std::string> custom_message;
+      bool ros_message_is_received = false;
+      auto custom_callback =
+        [&custom_message](std::shared_ptr<const std::string> msg) -> void {
+          custom_message = msg;
+        };
+      auto ros_callback =
+        [message_data, &ros_message_is_received](const rclcpp::msg::String & msg) -> void {
+          ASSERT_STREQ(message_data.c_str(), msg.data.c_str());
+          ros_message_is_received = true;
+        };
+      auto custom_sub =
+        node->create_subscription<StringTypeAdapter>(topic_name, 1, custom_callback);
+      auto ros_sub = node->create_subscription<rclcpp::msg::String>(topic_name, 1, ros_callback);
+      ASSERT_TRUE(wait_for_match(custom_sub, pub));
+      ASSERT_TRUE(wait_for_match(ros_sub, pub));
+      auto msg = std::make_unique<std::string>(message_data);
+      const std::string * published_message = msg.get();
+      pub->publish(std::move(msg));
+      rclcpp::executors::SingleThreadedExecutor executor;
+      executor.add_node(node);
+      for (int i = 0; (!custom_message || !ros_message_is_received) && i < g_max_loops; ++i) {
+        executor.spin_once(g_sleep_per_loop);
+      }
+      ASSERT_TRUE(ros_message_is_received);
+      ASSERT_NE(nullptr, custom_message);
+      EXPECT_EQ(published_message, custom_message.get());
+    }
+  }
+}
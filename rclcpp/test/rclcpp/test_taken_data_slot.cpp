@@ -0,0 +1,66 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "rclcpp/detail/taken_data_slot.hpp"
+
+using rclcpp::detail::TakenDataSlot;
+
+namespace
+{
+
+struct TakenData
+{
+  int value = 0;
+  std::shared_ptr<std::string> message;
+};
+
+}  // namespace
+
+TEST(TestTakenDataSlot, reused_once_released) {
+  TakenDataSlot<TakenData> slot;
+
+  auto data = slot.acquire();
+  data->value = 42;
+  data->message = std::make_shared<std::string>("message");
+  TakenData * storage = data.get();
+  data.reset();
+
+  data = slot.acquire();
+  EXPECT_EQ(storage, data.get());
+  // Reset when reused.
+  EXPECT_EQ(0, data->value);
+  EXPECT_EQ(nullptr, data->message);
+}
+
+TEST(TestTakenDataSlot, allocated_while_in_use) {
+  TakenDataSlot<TakenData> slot;
+
+  auto first = slot.acquire();
+  first->value = 1;
+  auto second = slot.acquire();
+  EXPECT_NE(first.get(), second.get());
+  // The data in use is left as is.
+  EXPECT_EQ(1, first->value);
+
+  // The newest storage is the one reused.
+  TakenData * storage = second.get();
+  first.reset();
+  second.reset();
+  EXPECT_EQ(storage, slot.acquire().get());
+}
@@ -17,7 +17,11 @@
 #include <algorithm>
 #include <chrono>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
 
 #include "rcl/error_handling.h"
 #include "rcl/time.h"
@@ -352,6 +356,39 @@ TEST_F(TestTime, overflows) {
   EXPECT_NO_THROW(one_time - two_time);
 }
 
+TEST_F(TestTime, saturating_arithmetic) {
+  rclcpp::Time max_time(std::numeric_limits<rcl_time_point_value_t>::max(), RCL_ROS_TIME);
+  rclcpp::Time min_time(std::numeric_limits<rcl_time_point_value_t>::min(), RCL_ROS_TIME);
+  rclcpp::Duration one(1ns);
+
+  EXPECT_EQ(max_time, max_time.saturating_add(one));
+  EXPECT_EQ(min_time, min_time.saturating_sub(one));
+  EXPECT_EQ(RCL_ROS_TIME, max_time.saturating_add(one).get_clock_type());
+
+  rclcpp::Time time(10, RCL_ROS_TIME);
+  EXPECT_EQ(11, time.saturating_add(one).nanoseconds());
+  EXPECT_EQ(9, time.saturating_sub(one).nanoseconds());
+  EXPECT_EQ(time + one, time.saturating_add(one));
+
+  static_assert(
+    rclcpp::detail::saturating_add_nanoseconds(
+      std::numeric_limits<int64_t>::min(), -1) == std::numeric_limits<int64_t>::min(),
+    "the nanoseconds arithmetic must be usable in constant expressions");
+}
+
+TEST_F(TestTime, arithmetic_exceptions) {
+  rclcpp::Time max_time(std::numeric_limits<rcl_time_point_value_t>::max());
+  RCLCPP_EXPECT_THROW_EQ(
+    max_time + rclcpp::Duration(1ns),
+    std::overflow_error("addition leads to int64_t overflow"));
+  RCLCPP_EXPECT_THROW_EQ(
+    max_time - rclcpp::Duration(-1ns),
+    std::overflow_error("time subtraction leads to int64_t overflow"));
+  RCLCPP_EXPECT_THROW_EQ(
+    (void)(max_time < rclcpp::Time(0, 0, RCL_ROS_TIME)),
+    std::runtime_error("can't compare times with different time sources"));
+}
+
 TEST_F(TestTime, seconds) {
   EXPECT_DOUBLE_EQ(0.0, rclcpp::Time(0, 0).seconds());
   EXPECT_DOUBLE_EQ(4.5, rclcpp::Time(4, 500000000).seconds());
@@ -447,3 +484,68 @@ TEST_F(TestTime, test_overflow_underflow_throws) {
     test_time = rclcpp::Duration::from_nanoseconds(INT64_MIN) + rclcpp::Time(-1),
     std::underflow_error("addition leads to int64_t underflow"));
 }
+
+TEST_F(TestTime, sleep_until_mismatched_clock_type) {
+  rclcpp::Clock clock(RCL_SYSTEM_TIME);
+  rclcpp::Time steady_until(0, 0, RCL_STEADY_TIME);
+  EXPECT_THROW(clock.sleep_until(steady_until), std::runtime_error);
+  EXPECT_THROW(clock.sleep_until(clock.now(), nullptr), std::runtime_error);
+}
+
+TEST_F(TestTime, sleep_for_wall_clocks) {
+  for (rcl_clock_type_t clock_type : {RCL_STEADY_TIME, RCL_SYSTEM_TIME, RCL_ROS_TIME}) {
+    rclcpp::Clock clock(clock_type);
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(clock.sleep_for(rclcpp::Duration(20ms)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+    // A time in the past is already reached
+    EXPECT_TRUE(clock.sleep_until(clock.now() - rclcpp::Duration(1s)));
+  }
+}
+
+TEST_F(TestTime, sleep_until_ros_time) {
+  auto clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  ASSERT_EQ(RCL_RET_OK, rcl_enable_ros_time_override(clock->get_clock_handle()));
+  ASSERT_EQ(RCL_RET_OK, rcl_set_ros_time_override(clock->get_clock_handle(), 0));
+
+  // Advance the ROS time like a time source does, with the clock mutex locked
+  std::thread time_source_thread(
+    [clock]() {
+      for (rcl_time_point_value_t t = 1; t <= 10; ++t) {
+        std::this_thread::sleep_for(5ms);
+        std::lock_guard<std::mutex> guard(clock->get_clock_mutex());
+        rcl_set_ros_time_override(clock->get_clock_handle(), RCL_S_TO_NS(t));
+      }
+    });
+  EXPECT_TRUE(clock->sleep_until(rclcpp::Time(5, 0, RCL_ROS_TIME)));
+  EXPECT_GE(clock->now(), rclcpp::Time(5, 0, RCL_ROS_TIME));
+  time_source_thread.join();
+}
+
+TEST_F(TestTime, sleep_until_ros_time_interrupted) {
+  auto context = std::make_shared<rclcpp::Context>();
+  context->init(0, nullptr);
+  auto clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  ASSERT_EQ(RCL_RET_OK, rcl_enable_ros_time_override(clock->get_clock_handle()));
+
+  // The shutdown of the context interrupts the sleep
+  std::thread shutdown_thread(
+    [context]() {
+      std::this_thread::sleep_for(10ms);
+      context->shutdown("test is done");
+    });
+  EXPECT_FALSE(clock->sleep_until(rclcpp::Time(1, 0, RCL_ROS_TIME), context));
+  shutdown_thread.join();
+  // The time source cannot wake the sleep up once the context is shut down
+  EXPECT_FALSE(clock->sleep_until(rclcpp::Time(1, 0, RCL_ROS_TIME), context));
+
+  // Deactivating ROS time interrupts the sleep
+  std::thread deactivate_thread(
+    [clock]() {
+      std::this_thread::sleep_for(10ms);
+      std::lock_guard<std::mutex> guard(clock->get_clock_mutex());
+      rcl_disable_ros_time_override(clock->get_clock_handle());
+    });
+  EXPECT_FALSE(clock->sleep_until(rclcpp::Time(1000, 0, RCL_ROS_TIME)));
+  deactivate_thread.join();
+}
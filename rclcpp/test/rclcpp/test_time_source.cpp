@@ -15,10 +15,13 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "rcl/error_handling.h"
 #include "rcl/time.h"
@@ -245,6 +248,20 @@ TEST_F(TestTimeSource, ROS_time_valid_sim_time) {
   EXPECT_TRUE(ros_clock2->ros_time_is_active());
 }
 
+TEST_F(TestTimeSource, ROS_time_override_after_detach) {
+  rclcpp::TimeSource ts;
+  auto ros_clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  ts.attachClock(ros_clock);
+  set_use_sim_time_parameter(node, rclcpp::ParameterValue(true), ros_clock);
+  ts.attachNode(node);
+  ASSERT_TRUE(ros_clock->ros_time_is_active());
+
+  // Once detached, the time is read from the rcl clock again.
+  ts.detachClock(ros_clock);
+  ASSERT_EQ(RCL_RET_OK, rcl_set_ros_time_override(ros_clock->get_clock_handle(), 42));
+  EXPECT_EQ(42, ros_clock->now().nanoseconds());
+}
+
 TEST_F(TestTimeSource, ROS_invalid_sim_time) {
   rclcpp::TimeSource ts;
   ts.attachNode(node);
@@ -517,6 +534,116 @@ TEST_F(TestTimeSource, no_pre_jump_callback) {
   EXPECT_EQ(1, cbo.post_callback_calls_);
 }
 
+TEST_F(TestTimeSource, unchanged_clock_time_is_skipped) {
+  CallbackObject cbo;
+  rcl_jump_threshold_t jump_threshold;
+  jump_threshold.min_forward.nanoseconds = 1;
+  jump_threshold.min_backward.nanoseconds = -1;
+  jump_threshold.on_clock_change = false;
+
+  rclcpp::TimeSource ts(node);
+  auto ros_clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  rclcpp::JumpHandler::SharedPtr callback_handler = ros_clock->create_jump_callback(
+    std::bind(&CallbackObject::pre_callback, &cbo, 1),
+    std::bind(&CallbackObject::post_callback, &cbo, std::placeholders::_1, 1),
+    jump_threshold);
+  ts.attachClock(ros_clock);
+  set_use_sim_time_parameter(node, rclcpp::ParameterValue(true), ros_clock);
+  ASSERT_TRUE(ros_clock->ros_time_is_active());
+
+  // Count the clock messages received by the node, to know when the repeated one arrived.
+  std::atomic<int> received_messages{0};
+  auto clock_sub = node->create_subscription<rosgraph_msgs::msg::Clock>(
+    "clock", rclcpp::ClockQoS(),
+    [&received_messages](const rosgraph_msgs::msg::Clock &) {++received_messages;});
+  auto clock_pub = node->create_publisher<rosgraph_msgs::msg::Clock>("clock", 10);
+
+  rosgraph_msgs::msg::Clock msg;
+  msg.clock.sec = 42;
+  msg.clock.nanosec = 1000;
+  const auto time = std::chrono::seconds(42) + std::chrono::nanoseconds(1000);
+  clock_pub->publish(msg);
+  spin_until_time(ros_clock, node, time, true);
+  EXPECT_EQ(1, cbo.pre_callback_calls_);
+  EXPECT_EQ(1, cbo.post_callback_calls_);
+
+  // Publish the same time again, e.g. a paused simulation.
+  clock_pub->publish(msg);
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  const auto start = std::chrono::steady_clock::now();
+  while (received_messages.load() < 2 && std::chrono::steady_clock::now() < start + 1s) {
+    executor.spin_once(10ms);
+  }
+  ASSERT_EQ(2, received_messages.load());
+  // Give the clock subscription of the time source time to process the message too.
+  executor.spin_all(100ms);
+  std::this_thread::sleep_for(100ms);
+
+  EXPECT_EQ(time.count(), ros_clock->now().nanoseconds());
+  EXPECT_EQ(1, cbo.pre_callback_calls_);
+  EXPECT_EQ(1, cbo.post_callback_calls_);
+}
+
+TEST_F(TestTimeSource, jump_callbacks_see_the_clock_change) {
+  rcl_jump_threshold_t jump_threshold;
+  jump_threshold.min_forward.nanoseconds = 1;
+  jump_threshold.min_backward.nanoseconds = -1;
+  jump_threshold.on_clock_change = false;
+
+  rclcpp::TimeSource ts(node);
+  auto ros_clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  ts.attachClock(ros_clock);
+  set_use_sim_time_parameter(node, rclcpp::ParameterValue(true), ros_clock);
+  ASSERT_TRUE(ros_clock->ros_time_is_active());
+
+  auto clock_pub = node->create_publisher<rosgraph_msgs::msg::Clock>("clock", 10);
+  rosgraph_msgs::msg::Clock msg;
+  msg.clock.sec = 1;
+  clock_pub->publish(msg);
+  spin_until_time(ros_clock, node, std::chrono::seconds(1), true);
+
+  // Written by the thread updating the clock, read once the new time is visible.
+  rcl_time_point_value_t time_before_jump = 0;
+  rcl_time_point_value_t time_after_jump = 0;
+  rclcpp::JumpHandler::SharedPtr callback_handler = ros_clock->create_jump_callback(
+    [&time_before_jump, &ros_clock]() {
+      time_before_jump = ros_clock->now().nanoseconds();
+    },
+    [&time_after_jump, &ros_clock](const rcl_time_jump_t &) {
+      time_after_jump = ros_clock->now().nanoseconds();
+    },
+    jump_threshold);
+
+  msg.clock.sec = 2;
+  clock_pub->publish(msg);
+  spin_until_time(ros_clock, node, std::chrono::seconds(2), true);
+
+  EXPECT_EQ(RCL_S_TO_NS(1), time_before_jump);
+  EXPECT_EQ(RCL_S_TO_NS(2), time_after_jump);
+}
+
+TEST_F(TestTimeSource, jump_handler_count) {
+  rcl_jump_threshold_t jump_threshold;
+  jump_threshold.min_forward.nanoseconds = 1;
+  jump_threshold.min_backward.nanoseconds = -1;
+  jump_threshold.on_clock_change = true;
+
+  auto ros_clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  EXPECT_FALSE(ros_clock->has_jump_handlers());
+
+  rclcpp::JumpHandler::SharedPtr callback_handler = ros_clock->create_jump_callback(
+    []() {}, [](const rcl_time_jump_t &) {}, jump_threshold);
+  rclcpp::JumpHandler::SharedPtr callback_handler2 = ros_clock->create_jump_callback(
+    []() {}, [](const rcl_time_jump_t &) {}, jump_threshold);
+  EXPECT_TRUE(ros_clock->has_jump_handlers());
+
+  callback_handler.reset();
+  EXPECT_TRUE(ros_clock->has_jump_handlers());
+  callback_handler2.reset();
+  EXPECT_FALSE(ros_clock->has_jump_handlers());
+}
+
 // A TimeSource-inheriting class
 // that allows access to TimeSource protected attributes
 // use_clock_thread_ and clock_executor_thread_
@@ -742,3 +869,56 @@ TEST_F(TestTimeSource, check_sim_time_updated_in_callback_if_use_clock_thread) {
   // Node should have get out of timer callback
   ASSERT_FALSE(clock_thread_testing_node.GetIsCallbackFrozen());
 }
+
+TEST_F(TestTimeSource, use_shared_clock_source) {
+  rclcpp::TimeSource ts;
+  EXPECT_FALSE(ts.get_use_shared_clock_source());
+  ts.set_use_shared_clock_source(true);
+  EXPECT_TRUE(ts.get_use_shared_clock_source());
+  // The flag is kept when the node is detached
+  ts.detachNode();
+  EXPECT_TRUE(ts.get_use_shared_clock_source());
+}
+
+TEST_F(TestTimeSource, shared_clock_source_updates_all_nodes) {
+  // Create a "sim time" publisher and spin it
+  SimClockPublisherNode pub_node;
+  pub_node.SpinNode();
+
+  // The nodes are not spun, their clocks are updated by the clock source of the context
+  auto options = rclcpp::NodeOptions()
+    .use_shared_clock_source(true)
+    .parameter_overrides({rclcpp::Parameter("use_sim_time", true)});
+  std::vector<rclcpp::Node::SharedPtr> nodes;
+  for (int i = 0; i < 3; ++i) {
+    nodes.push_back(
+      std::make_shared<rclcpp::Node>("shared_clock_node_" + std::to_string(i), options));
+  }
+
+  auto steady_clock = rclcpp::Clock(RCL_STEADY_TIME);
+  const auto start_time = steady_clock.now();
+  auto all_clocks_updated = [&nodes]() {
+      return std::all_of(
+        nodes.begin(), nodes.end(),
+        [](const rclcpp::Node::SharedPtr & node) {
+          return node->get_clock()->ros_time_is_active() && node->now().nanoseconds() > 0;
+        });
+    };
+  while (rclcpp::ok() && !all_clocks_updated() &&
+    (steady_clock.now() - start_time).seconds() < 5.0)
+  {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_TRUE(all_clocks_updated());
+
+  // Once a node is destroyed, the others are still updated
+  nodes.pop_back();
+  const auto time_before = nodes.front()->now();
+  while (rclcpp::ok() && nodes.front()->now() == time_before &&
+    (steady_clock.now() - start_time).seconds() < 10.0)
+  {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_GT(nodes.front()->now(), time_before);
+  nodes.clear();
+}
@@ -18,6 +18,7 @@
 #include <chrono>
 #include <exception>
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include "rcl/timer.h"
@@ -281,3 +282,65 @@ TEST_F(TestTimer, test_failures_with_exceptions)
       std::runtime_error("Timer could not get time until next call: error not set"));
   }
 }
+
+TEST_F(TestTimer, overrun_policy)
+{
+  EXPECT_EQ(rclcpp::TimerOverrunPolicy::Skip, timer->get_overrun_policy());
+  timer->set_overrun_policy(rclcpp::TimerOverrunPolicy::CatchUp);
+  EXPECT_EQ(rclcpp::TimerOverrunPolicy::CatchUp, timer->get_overrun_policy());
+}
+
+TEST_F(TestTimer, statistics_of_late_calls)
+{
+  int callback_count = 0;
+  auto late_timer = test_node->create_wall_timer(10ms, [&callback_count]() {++callback_count;});
+  std::this_thread::sleep_for(55ms);
+  ASSERT_TRUE(late_timer->call());
+  late_timer->execute_callback();
+  EXPECT_EQ(1, callback_count);
+
+  auto statistics = late_timer->get_statistics();
+  EXPECT_EQ(1u, statistics.call_count);
+  EXPECT_GE(statistics.missed_deadline_count, 4u);
+  EXPECT_GE(statistics.max_lateness, 45ms);
+  EXPECT_EQ(statistics.max_lateness, statistics.total_lateness);
+  // The rcl timer skipped the missed deadlines
+  EXPECT_GT(late_timer->time_until_trigger(), 0ns);
+
+  late_timer->reset_statistics();
+  statistics = late_timer->get_statistics();
+  EXPECT_EQ(0u, statistics.call_count);
+  EXPECT_EQ(0u, statistics.missed_deadline_count);
+  EXPECT_EQ(0ns, statistics.max_lateness);
+}
+
+TEST_F(TestTimer, catch_up_on_missed_deadlines)
+{
+  int callback_count = 0;
+  auto late_timer = test_node->create_wall_timer(10ms, [&callback_count]() {++callback_count;});
+  late_timer->set_overrun_policy(rclcpp::TimerOverrunPolicy::CatchUp);
+  std::this_thread::sleep_for(55ms);
+  ASSERT_TRUE(late_timer->call());
+  late_timer->execute_callback();
+  const auto statistics = late_timer->get_statistics();
+  EXPECT_EQ(static_cast<int>(1u + statistics.missed_deadline_count), callback_count);
+  EXPECT_GE(callback_count, 5);
+
+  // Once caught up, the callback is called once per execution
+  late_timer->execute_callback();
+  EXPECT_EQ(static_cast<int>(2u + statistics.missed_deadline_count), callback_count);
+}
+
+TEST_F(TestTimer, coalesce_missed_deadlines)
+{
+  int callback_count = 0;
+  auto late_timer = test_node->create_wall_timer(
+    100ms, [&callback_count]() {++callback_count;});
+  late_timer->set_overrun_policy(rclcpp::TimerOverrunPolicy::Coalesce);
+  std::this_thread::sleep_for(250ms);
+  ASSERT_TRUE(late_timer->call());
+  late_timer->execute_callback();
+  EXPECT_EQ(1, callback_count);
+  // The period restarts from the call, instead of the next deadline 50ms later
+  EXPECT_GT(late_timer->time_until_trigger(), 60ms);
+}
@@ -0,0 +1,121 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/timer_wheel.hpp"
+
+using namespace std::chrono_literals;
+
+class TestTimerWheel : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    rclcpp::init(0, nullptr);
+    node = std::make_shared<rclcpp::Node>("test_timer_wheel_node");
+    wheel = std::make_shared<rclcpp::TimerWheel>(
+      rclcpp::contexts::get_global_default_context(), 1ms);
+    node->get_node_waitables_interface()->add_waitable(wheel, nullptr);
+    executor.add_node(node);
+  }
+
+  void TearDown() override
+  {
+    executor.remove_node(node);
+    wheel.reset();
+    node.reset();
+    rclcpp::shutdown();
+  }
+
+  rclcpp::Node::SharedPtr node;
+  rclcpp::TimerWheel::SharedPtr wheel;
+  rclcpp::executors::SingleThreadedExecutor executor;
+};
+
+TEST_F(TestTimerWheel, invalid_arguments) {
+  EXPECT_THROW(
+    rclcpp::TimerWheel(rclcpp::contexts::get_global_default_context(), 0ms),
+    std::invalid_argument);
+  EXPECT_THROW(wheel->add_timer(1ms, nullptr), std::invalid_argument);
+  EXPECT_THROW(wheel->add_timer(1ms, []() {}, -1ms), std::invalid_argument);
+  EXPECT_FALSE(wheel->cancel_timer(0));
+  EXPECT_FALSE(wheel->restart_timer(42, 1ms));
+}
+
+TEST_F(TestTimerWheel, one_shot_and_periodic_timers) {
+  std::atomic<int> one_shot_count{0};
+  std::atomic<int> periodic_count{0};
+  wheel->add_timer(5ms, [&one_shot_count]() {one_shot_count++;});
+  auto periodic = wheel->add_timer(
+    2ms, [&periodic_count, this]() {
+      if (++periodic_count == 5) {
+        executor.cancel();
+      }
+    }, 2ms);
+  EXPECT_EQ(2u, wheel->get_number_of_timers());
+
+  executor.spin();
+
+  EXPECT_EQ(5, periodic_count.load());
+  EXPECT_EQ(1, one_shot_count.load());
+  EXPECT_EQ(1u, wheel->get_number_of_timers());
+  EXPECT_TRUE(wheel->cancel_timer(periodic));
+  EXPECT_FALSE(wheel->cancel_timer(periodic));
+  EXPECT_EQ(0u, wheel->get_number_of_timers());
+}
+
+TEST_F(TestTimerWheel, cancelled_and_restarted_timers) {
+  std::atomic<bool> cancelled_called{false};
+  std::atomic<bool> restarted_called{false};
+  // Many idle timers do not make the wheel slower to wait on.
+  for (int i = 0; i < 1000; ++i) {
+    wheel->add_timer(1h, []() {});
+  }
+  auto cancelled = wheel->add_timer(5ms, [&cancelled_called]() {cancelled_called = true;});
+  auto restarted = wheel->add_timer(1h, [&restarted_called]() {restarted_called = true;});
+  wheel->add_timer(50ms, [this]() {executor.cancel();});
+  EXPECT_TRUE(wheel->cancel_timer(cancelled));
+  EXPECT_TRUE(wheel->restart_timer(restarted, 10ms));
+
+  executor.spin();
+
+  EXPECT_FALSE(cancelled_called.load());
+  EXPECT_TRUE(restarted_called.load());
+  EXPECT_FALSE(wheel->restart_timer(restarted, 10ms));
+  EXPECT_EQ(1000u, wheel->get_number_of_timers());
+}
+
+TEST_F(TestTimerWheel, timer_added_while_waiting) {
+  std::atomic<bool> called{false};
+  std::thread thread([this, &called]() {
+      std::this_thread::sleep_for(20ms);
+      wheel->add_timer(
+        1ms, [this, &called]() {
+          called = true;
+          executor.cancel();
+        });
+    });
+  executor.spin();
+  thread.join();
+  EXPECT_TRUE(called.load());
+}
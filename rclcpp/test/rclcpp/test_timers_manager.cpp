@@ -0,0 +1,160 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "rclcpp/experimental/timers_manager.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+using namespace std::chrono_literals;
+
+using rclcpp::experimental::TimersManager;
+
+class TestTimersManager : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp()
+  {
+    node = std::make_shared<rclcpp::Node>("test_timers_manager");
+  }
+
+  rclcpp::TimerBase::SharedPtr create_timer(std::chrono::nanoseconds period)
+  {
+    return node->create_wall_timer(period, []() {});
+  }
+
+  rclcpp::Node::SharedPtr node;
+};
+
+TEST_F(TestTimersManager, construction) {
+  EXPECT_THROW(TimersManager(nullptr), std::invalid_argument);
+
+  TimersManager timers_manager([](const rclcpp::TimerBase *) {});
+  EXPECT_THROW(timers_manager.add_timer(nullptr), std::invalid_argument);
+  EXPECT_EQ(-1ns, timers_manager.get_head_timeout());
+
+  auto timer = create_timer(1s);
+  timers_manager.add_timer(timer);
+  timers_manager.add_timer(timer);
+  EXPECT_EQ(1u, timers_manager.get_number_of_timers());
+  EXPECT_GT(timers_manager.get_head_timeout(), 0ns);
+  EXPECT_LE(timers_manager.get_head_timeout(), 1s);
+
+  timers_manager.remove_timer(timer);
+  EXPECT_EQ(0u, timers_manager.get_number_of_timers());
+}
+
+/*
+   Test that execute_ready_timers() only reports the timers which expired, each one once.
+ */
+TEST_F(TestTimersManager, execute_ready_timers) {
+  const rclcpp::TimerBase * reported = nullptr;
+  size_t number_of_reports = 0;
+  TimersManager timers_manager(
+    [&](const rclcpp::TimerBase * timer) {
+      reported = timer;
+      ++number_of_reports;
+    });
+  auto fast_timer = create_timer(1ms);
+  auto slow_timer = create_timer(1h);
+  timers_manager.add_timer(fast_timer);
+  timers_manager.add_timer(slow_timer);
+
+  std::this_thread::sleep_for(5ms);
+  EXPECT_EQ(0ns, timers_manager.get_head_timeout());
+  EXPECT_EQ(1u, timers_manager.execute_ready_timers());
+  EXPECT_EQ(fast_timer.get(), reported);
+  EXPECT_EQ(1u, number_of_reports);
+  EXPECT_LE(timers_manager.get_head_timeout(), 1ms);
+}
+
+/*
+   Test that a timer with slack waits for another timer to expire, within its slack.
+ */
+TEST_F(TestTimersManager, slack) {
+  auto slack_timer = create_timer(5ms);
+  EXPECT_THROW(slack_timer->set_slack(-1ns), std::invalid_argument);
+  slack_timer->set_slack(1h);
+  EXPECT_EQ(1h, slack_timer->get_slack());
+  auto strict_timer = node->create_wall_timer(100ms, []() {}, nullptr, 0ns);
+  EXPECT_EQ(0ns, strict_timer->get_slack());
+
+  size_t number_of_reports = 0;
+  TimersManager timers_manager(
+    [&number_of_reports](const rclcpp::TimerBase *) {++number_of_reports;});
+  timers_manager.add_timer(slack_timer);
+  timers_manager.add_timer(strict_timer);
+
+  std::this_thread::sleep_for(10ms);
+  EXPECT_GT(timers_manager.get_head_timeout(), 0ns);
+  EXPECT_EQ(0u, timers_manager.execute_ready_timers());
+
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(0ns, timers_manager.get_head_timeout());
+  EXPECT_EQ(2u, timers_manager.execute_ready_timers());
+  EXPECT_EQ(2u, number_of_reports);
+}
+
+/*
+   Test that the timers thread reports expired timers, except while they are canceled.
+ */
+TEST_F(TestTimersManager, timers_thread) {
+  std::atomic_size_t number_of_reports{0};
+  TimersManager timers_manager(
+    [&number_of_reports](const rclcpp::TimerBase *) {++number_of_reports;});
+  auto timer = create_timer(1ms);
+  timers_manager.add_timer(timer);
+  timers_manager.start();
+  EXPECT_THROW(timers_manager.start(), std::runtime_error);
+
+  auto start = std::chrono::steady_clock::now();
+  while (number_of_reports.load() < 10 && std::chrono::steady_clock::now() - start < 5s) {
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT_GE(number_of_reports.load(), 10u);
+
+  timer->cancel();
+  std::this_thread::sleep_for(5ms);
+  const size_t reports_when_canceled = number_of_reports.load();
+  std::this_thread::sleep_for(20ms);
+  EXPECT_EQ(reports_when_canceled, number_of_reports.load());
+
+  timer->reset();
+  start = std::chrono::steady_clock::now();
+  while (number_of_reports.load() == reports_when_canceled &&
+    std::chrono::steady_clock::now() - start < 5s)
+  {
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT_GT(number_of_reports.load(), reports_when_canceled);
+
+  timers_manager.stop();
+  timers_manager.stop();
+}
@@ -0,0 +1,114 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rclcpp/experimental/topic_demultiplexer.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "test_msgs/msg/basic_types.hpp"
+#include "test_msgs/msg/strings.hpp"
+
+using namespace std::chrono_literals;
+
+class TestTopicDemultiplexer : public ::testing::Test
+{
+public:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+
+  void SetUp() override
+  {
+    node_ = std::make_shared<rclcpp::Node>("test_topic_demultiplexer");
+  }
+
+  template<typename Condition>
+  bool wait_for(const Condition & condition)
+  {
+    auto start = std::chrono::steady_clock::now();
+    while (!condition()) {
+      if (std::chrono::steady_clock::now() - start > 5s) {
+        return false;
+      }
+      rclcpp::spin_some(node_);
+    }
+    return true;
+  }
+
+  rclcpp::Node::SharedPtr node_;
+};
+
+TEST_F(TestTopicDemultiplexer, callbacks_share_messages)
+{
+  auto demultiplexer = std::make_shared<rclcpp::experimental::TopicDemultiplexer>(
+    node_->get_node_topics_interface(), "demultiplexed_topic", "test_msgs/msg/Strings",
+    rclcpp::QoS(10));
+
+  std::vector<std::shared_ptr<const test_msgs::msg::Strings>> received_messages;
+  auto callback = [&received_messages](std::shared_ptr<const test_msgs::msg::Strings> message) {
+      received_messages.push_back(message);
+    };
+  demultiplexer->add_callback<test_msgs::msg::Strings>(callback);
+  auto removed_id = demultiplexer->add_callback<test_msgs::msg::Strings>(callback);
+  demultiplexer->add_callback<test_msgs::msg::Strings>(callback);
+  size_t serialized_count = 0;
+  demultiplexer->add_serialized_callback(
+    [&serialized_count](std::shared_ptr<const rclcpp::SerializedMessage> message) {
+      EXPECT_NE(0u, message->size());
+      ++serialized_count;
+    });
+  EXPECT_EQ(4u, demultiplexer->get_callback_count());
+  EXPECT_EQ(1u, demultiplexer->get_message_type_count());
+
+  EXPECT_TRUE(demultiplexer->remove_callback(removed_id));
+  EXPECT_FALSE(demultiplexer->remove_callback(removed_id));
+  EXPECT_EQ(3u, demultiplexer->get_callback_count());
+
+  EXPECT_THROW(
+    demultiplexer->add_callback<test_msgs::msg::BasicTypes>(
+      [](std::shared_ptr<const test_msgs::msg::BasicTypes>) {}),
+    std::invalid_argument);
+
+  auto publisher = node_->create_publisher<test_msgs::msg::Strings>("demultiplexed_topic", 10);
+  ASSERT_TRUE(
+    wait_for(
+      [&publisher]() {return publisher->get_subscription_count() > 0u;}));
+
+  test_msgs::msg::Strings message;
+  message.string_value = "Hello World";
+  ASSERT_TRUE(
+    wait_for(
+      [&publisher, &message, &serialized_count]() {
+        publisher->publish(message);
+        return serialized_count > 0u;
+      }));
+
+  // The message is only deserialized once for both typed callbacks.
+  ASSERT_GE(received_messages.size(), 2u);
+  EXPECT_EQ(received_messages[0], received_messages[1]);
+  EXPECT_EQ("Hello World", received_messages[0]->string_value);
+}
@@ -0,0 +1,205 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/tracing.hpp"
+
+#include "test_msgs/msg/empty.hpp"
+
+using rclcpp::tracing::TraceEvent;
+using rclcpp::tracing::TraceEventType;
+
+namespace
+{
+
+class CapturingBackend : public rclcpp::tracing::TraceBackend
+{
+public:
+  void
+  record(const TraceEvent & event) override
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back(event);
+  }
+
+  std::vector<TraceEvent>
+  get_events(TraceEventType type)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<TraceEvent> events_of_type;
+    for (const auto & event : events) {
+      if (event.type == static_cast<uint32_t>(type)) {
+        events_of_type.push_back(event);
+      }
+    }
+    return events_of_type;
+  }
+
+  std::mutex mutex;
+  std::vector<TraceEvent> events;
+};
+
+std::vector<TraceEvent>
+read_trace_file(const std::string & file_path)
+{
+  std::ifstream file(file_path, std::ios::binary);
+  uint64_t header[3] = {0, 0, 0};
+  file.read(reinterpret_cast<char *>(header), sizeof(header));
+  EXPECT_EQ(rclcpp::tracing::RingBufferTraceBackend::kMagic, header[0]);
+  EXPECT_EQ(rclcpp::tracing::RingBufferTraceBackend::kVersion, header[1]);
+  EXPECT_EQ(sizeof(TraceEvent), header[2]);
+  std::vector<TraceEvent> events;
+  TraceEvent event;
+  while (file.read(reinterpret_cast<char *>(&event), sizeof(event))) {
+    events.push_back(event);
+  }
+  return events;
+}
+
+std::string
+get_trace_file_path()
+{
+  return (std::filesystem::temp_directory_path() / "rclcpp_test_tracing.trace").string();
+}
+
+}  // namespace
+
+class TestTracing : public ::testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    rclcpp::tracing::set_backend(nullptr);
+    std::filesystem::remove(get_trace_file_path());
+  }
+};
+
+TEST_F(TestTracing, disabled_without_backend) {
+  EXPECT_FALSE(rclcpp::tracing::is_enabled());
+  auto backend = std::make_shared<CapturingBackend>();
+  rclcpp::tracing::set_backend(backend);
+  EXPECT_TRUE(rclcpp::tracing::is_enabled());
+  EXPECT_EQ(backend, rclcpp::tracing::get_backend());
+
+  rclcpp::tracing::trace(TraceEventType::Take, &backend, 3, uint64_t{4});
+  rclcpp::tracing::set_backend(nullptr);
+  EXPECT_FALSE(rclcpp::tracing::is_enabled());
+  rclcpp::tracing::trace(TraceEventType::Take, &backend, 5, uint64_t{6});
+
+  auto events = backend->get_events(TraceEventType::Take);
+  ASSERT_EQ(1u, events.size());
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(&backend), events[0].handle);
+  EXPECT_EQ(3u, events[0].source);
+  EXPECT_EQ(4u, events[0].data);
+  EXPECT_GT(events[0].time_ns, 0);
+  EXPECT_NE(0u, events[0].thread_id);
+}
+
+TEST_F(TestTracing, ring_buffer_flushes_the_events_of_each_thread) {
+  auto backend = std::make_shared<rclcpp::tracing::RingBufferTraceBackend>(
+    get_trace_file_path(), 100);
+  rclcpp::tracing::set_backend(backend);
+  constexpr uint64_t events_per_thread = 100;
+  auto record_events = [](uint64_t source) {
+      for (uint64_t data = 0; data < events_per_thread; ++data) {
+        rclcpp::tracing::trace(TraceEventType::Publish, nullptr, source, data);
+      }
+    };
+  std::thread first_thread(record_events, 1);
+  std::thread second_thread(record_events, 2);
+  first_thread.join();
+  second_thread.join();
+  // The capacity is rounded up to 128 events per thread.
+  record_events(3);
+  record_events(3);
+  EXPECT_EQ(72u, backend->get_dropped_count());
+  backend->flush();
+
+  auto events = read_trace_file(get_trace_file_path());
+  ASSERT_EQ(3 * events_per_thread + 28, events.size());
+  std::vector<uint64_t> next_data(4, 0);
+  for (const auto & event : events) {
+    ASSERT_EQ(static_cast<uint32_t>(TraceEventType::Publish), event.type);
+    ASSERT_LT(event.source, 4u);
+    // The events of a thread are in order.
+    EXPECT_EQ(next_data[event.source] % events_per_thread, event.data);
+    ++next_data[event.source];
+  }
+
+  // The flushed events make room for the next ones.
+  record_events(3);
+  backend->flush();
+  EXPECT_EQ(4 * events_per_thread + 28, read_trace_file(get_trace_file_path()).size());
+}
+
+TEST_F(TestTracing, intra_process_publication_to_callback) {
+  rclcpp::init(0, nullptr);
+  {
+    auto backend = std::make_shared<CapturingBackend>();
+    auto node = std::make_shared<rclcpp::Node>(
+      "test_tracing_node", rclcpp::NodeOptions().use_intra_process_comms(true));
+    size_t received = 0;
+    auto subscription = node->create_subscription<test_msgs::msg::Empty>(
+      "test_tracing_topic", 10, [&received](test_msgs::msg::Empty::ConstSharedPtr) {++received;});
+    auto publisher = node->create_publisher<test_msgs::msg::Empty>("test_tracing_topic", 10);
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(node);
+
+    rclcpp::tracing::set_backend(backend);
+    publisher->publish(test_msgs::msg::Empty());
+    publisher->publish(test_msgs::msg::Empty());
+    while (received < 2) {
+      executor.spin_some();
+    }
+    rclcpp::tracing::set_backend(nullptr);
+
+    auto publications = backend->get_events(TraceEventType::IntraProcessPublish);
+    auto enqueues = backend->get_events(TraceEventType::IntraProcessEnqueue);
+    auto dequeues = backend->get_events(TraceEventType::IntraProcessDequeue);
+    ASSERT_EQ(2u, publications.size());
+    ASSERT_EQ(2u, enqueues.size());
+    ASSERT_EQ(2u, dequeues.size());
+    for (size_t i = 0; i < 2; ++i) {
+      EXPECT_EQ(i + 1, publications[i].data);
+      EXPECT_EQ(publications[i].source, enqueues[i].source);
+      EXPECT_EQ(publications[i].data, enqueues[i].data);
+      EXPECT_EQ(enqueues[i].handle, dequeues[i].handle);
+      EXPECT_EQ(enqueues[i].data, dequeues[i].data);
+      EXPECT_LE(publications[i].time_ns, dequeues[i].time_ns);
+    }
+
+    auto dispatches = backend->get_events(TraceEventType::ExecutorDispatch);
+    EXPECT_EQ(
+      2, std::count_if(
+        dispatches.begin(), dispatches.end(), [&dequeues](const TraceEvent & event) {
+          return event.handle == dequeues[0].handle;
+        }));
+    EXPECT_EQ(2u, backend->get_events(TraceEventType::CallbackStart).size());
+    EXPECT_EQ(2u, backend->get_events(TraceEventType::CallbackEnd).size());
+  }
+  rclcpp::shutdown();
+}
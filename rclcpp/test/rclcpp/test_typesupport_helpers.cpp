@@ -75,3 +75,34 @@ TEST(TypesupportHelpersTest, returns_c_type_info_for_valid_library) {
     FAIL() << e.what();
   }
 }
+
+TEST(TypesupportHelpersTest, shares_loaded_library) {
+  auto library = rclcpp::get_typesupport_library(
+    "test_msgs/msg/BasicTypes", "rosidl_typesupport_cpp");
+  // Types of the same package share the library while it is in use.
+  auto other_library = rclcpp::get_typesupport_library(
+    "test_msgs/msg/Strings", "rosidl_typesupport_cpp");
+  EXPECT_EQ(library, other_library);
+
+  auto handle = rclcpp::get_typesupport_handle(
+    "test_msgs/msg/BasicTypes", "rosidl_typesupport_cpp", *library);
+  EXPECT_EQ(
+    handle,
+    rclcpp::get_typesupport_handle(
+      "test_msgs/msg/BasicTypes", "rosidl_typesupport_cpp", *other_library));
+  EXPECT_NE(
+    handle,
+    rclcpp::get_typesupport_handle(
+      "test_msgs/msg/Strings", "rosidl_typesupport_cpp", *library));
+
+  std::weak_ptr<rcpputils::SharedLibrary> weak_library = library;
+  library.reset();
+  other_library.reset();
+  EXPECT_TRUE(weak_library.expired());
+  library = rclcpp::get_typesupport_library(
+    "test_msgs/msg/BasicTypes", "rosidl_typesupport_cpp");
+  EXPECT_NE(
+    nullptr,
+    rclcpp::get_typesupport_handle(
+      "test_msgs/msg/BasicTypes", "rosidl_typesupport_cpp", *library));
+}
@@ -20,9 +20,12 @@
 
 #include "rcl/init.h"
 #include "rcl/logging.h"
+#include "rcl/publisher.h"
+#include "rcl/service.h"
 
 #include "rclcpp/contexts/default_context.hpp"
 #include "rclcpp/exceptions.hpp"
+#include "rclcpp/node.hpp"
 #include "rclcpp/utilities.hpp"
 
 #include "../mocking_utils/patch.hpp"
@@ -214,6 +217,31 @@ TEST(TestUtilities, test_context_init_shutdown_fails) {
   }
 }
 
+TEST(TestUtilities, test_context_fast_exit) {
+  auto context = std::make_shared<rclcpp::contexts::DefaultContext>();
+  context->init(0, nullptr, rclcpp::InitOptions().fast_exit(true));
+  auto node = std::make_shared<rclcpp::Node>(
+    "node", "ns", rclcpp::NodeOptions().context(context));
+  context->shutdown("fast exit");
+
+  // The parameter services and the parameter events publisher are not finalized.
+  size_t number_of_finalizations = 0u;
+  auto mock_publisher_fini = mocking_utils::patch(
+    "lib:rclcpp", rcl_publisher_fini, [&number_of_finalizations](rcl_publisher_t *, rcl_node_t *)
+    {
+      ++number_of_finalizations;
+      return RCL_RET_OK;
+    });
+  auto mock_service_fini = mocking_utils::patch(
+    "lib:rclcpp", rcl_service_fini, [&number_of_finalizations](rcl_service_t *, rcl_node_t *)
+    {
+      ++number_of_finalizations;
+      return RCL_RET_OK;
+    });
+  EXPECT_NO_THROW(node.reset());
+  EXPECT_EQ(0u, number_of_finalizations);
+}
+
 // Required for mocking_utils below
 MOCKING_UTILS_BOOL_OPERATOR_RETURNS_FALSE(rcutils_allocator_t, ==)
 MOCKING_UTILS_BOOL_OPERATOR_RETURNS_FALSE(rcutils_allocator_t, !=)
@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 
+#include <future>
 #include <memory>
 #include <string>
 #include <vector>
@@ -72,3 +73,39 @@ TEST(TestUtilities, wait_for_message_indefinitely) {
 
   ASSERT_FALSE(received);
 }
+
+TEST(TestUtilities, message_waiter) {
+  rclcpp::init(0, nullptr);
+
+  auto node = std::make_shared<rclcpp::Node>("message_waiter_node");
+
+  using MsgT = test_msgs::msg::Strings;
+  auto pub = node->create_publisher<MsgT>("message_waiter_topic", 10);
+
+  rclcpp::MessageWaiter<MsgT> waiter(node, "message_waiter_topic");
+  auto subscription = waiter.get_subscription();
+
+  // Every read reuses the subscription of the waiter.
+  for (auto read = 0u; read < 3u; ++read) {
+    auto future = waiter.async_wait_for_message(5s);
+    for (auto i = 0u; i < 10 && future.wait_for(0s) != std::future_status::ready; ++i) {
+      pub->publish(*get_messages_strings()[0]);
+      future.wait_for(500ms);
+    }
+    ASSERT_EQ(std::future_status::ready, future.wait_for(0s));
+    auto message = future.get();
+    ASSERT_NE(nullptr, message);
+    EXPECT_EQ(*message, *get_messages_strings()[0]);
+    EXPECT_EQ(subscription, waiter.get_subscription());
+  }
+  EXPECT_EQ(1u, node->count_subscribers("message_waiter_topic"));
+
+  // Drain the messages published during the reads, then time out.
+  MsgT out;
+  while (waiter.wait_for_message(out, 0s)) {}
+  EXPECT_FALSE(waiter.wait_for_message(out, 10ms));
+  EXPECT_EQ(nullptr, waiter.async_wait_for_message(10ms).get());
+
+  rclcpp::shutdown();
+  EXPECT_FALSE(waiter.wait_for_message(out));
+}
@@ -0,0 +1,93 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/topic_statistics/atomic_statistics_accumulator.hpp"
+
+using rclcpp::topic_statistics::AtomicStatisticsAccumulator;
+
+TEST(TestAtomicStatisticsAccumulator, empty) {
+  AtomicStatisticsAccumulator accumulator;
+  const auto data = accumulator.get_statistics_and_reset();
+  EXPECT_TRUE(std::isnan(data.average));
+  EXPECT_TRUE(std::isnan(data.min));
+  EXPECT_TRUE(std::isnan(data.max));
+  EXPECT_TRUE(std::isnan(data.standard_deviation));
+  EXPECT_EQ(0u, data.sample_count);
+}
+
+TEST(TestAtomicStatisticsAccumulator, statistics) {
+  AtomicStatisticsAccumulator accumulator;
+  for (double value : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}) {
+    accumulator.add_measurement(value);
+  }
+  auto data = accumulator.get_statistics();
+  EXPECT_DOUBLE_EQ(5.0, data.average);
+  EXPECT_DOUBLE_EQ(2.0, data.min);
+  EXPECT_DOUBLE_EQ(9.0, data.max);
+  EXPECT_DOUBLE_EQ(2.0, data.standard_deviation);
+  EXPECT_EQ(8u, data.sample_count);
+
+  data = accumulator.get_statistics_and_reset();
+  EXPECT_DOUBLE_EQ(5.0, data.average);
+  EXPECT_EQ(8u, data.sample_count);
+
+  // The window is reset.
+  accumulator.add_measurement(1.0);
+  data = accumulator.get_statistics_and_reset();
+  EXPECT_DOUBLE_EQ(1.0, data.average);
+  EXPECT_DOUBLE_EQ(1.0, data.min);
+  EXPECT_DOUBLE_EQ(1.0, data.max);
+  EXPECT_DOUBLE_EQ(0.0, data.standard_deviation);
+  EXPECT_EQ(1u, data.sample_count);
+  EXPECT_EQ(0u, accumulator.get_statistics_and_reset().sample_count);
+}
+
+TEST(TestAtomicStatisticsAccumulator, concurrent_measurements) {
+  constexpr size_t kNumberOfThreads = 4u;
+  constexpr uint64_t kMeasurementsPerThread = 10000u;
+
+  AtomicStatisticsAccumulator accumulator;
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumberOfThreads; ++i) {
+    threads.emplace_back(
+      [&accumulator]() {
+        for (uint64_t j = 0; j < kMeasurementsPerThread; ++j) {
+          accumulator.add_measurement(1.0);
+        }
+      });
+  }
+  // Every sample is counted in exactly one window, with all its values.
+  uint64_t sample_count = 0u;
+  double sum = 0.0;
+  while (sample_count < kNumberOfThreads * kMeasurementsPerThread) {
+    const auto data = accumulator.get_statistics_and_reset();
+    if (data.sample_count > 0u) {
+      EXPECT_DOUBLE_EQ(1.0, data.average);
+      sum += data.average * static_cast<double>(data.sample_count);
+    }
+    sample_count += data.sample_count;
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(kNumberOfThreads * kMeasurementsPerThread, sample_count);
+  EXPECT_DOUBLE_EQ(static_cast<double>(sample_count), sum);
+}
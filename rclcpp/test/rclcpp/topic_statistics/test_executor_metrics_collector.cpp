@@ -0,0 +1,168 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/executors/single_threaded_executor.hpp"
+#include "rclcpp/executors/static_single_threaded_executor.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/topic_statistics/executor_metrics_collector.hpp"
+
+#include "statistics_msgs/msg/metrics_message.hpp"
+#include "statistics_msgs/msg/statistic_data_type.hpp"
+
+using namespace std::chrono_literals;
+
+using rclcpp::topic_statistics::ExecutorMetricsCollector;
+using statistics_msgs::msg::MetricsMessage;
+using statistics_msgs::msg::StatisticDataType;
+
+namespace
+{
+
+const MetricsMessage &
+find_metric(const std::vector<MetricsMessage> & messages, const std::string & metric_name)
+{
+  for (const auto & message : messages) {
+    if (message.metrics_source == metric_name) {
+      return message;
+    }
+  }
+  throw std::runtime_error("metric " + metric_name + " not found");
+}
+
+double
+get_statistic(const MetricsMessage & message, uint8_t data_type)
+{
+  for (const auto & point : message.statistics) {
+    if (point.data_type == data_type) {
+      return point.data;
+    }
+  }
+  throw std::runtime_error("statistic not found");
+}
+
+}  // namespace
+
+TEST(TestExecutorMetricsCollector, collect_metrics_and_reset) {
+  ExecutorMetricsCollector collector("test_executor");
+  collector.on_wait(3ms);
+  collector.on_wait_result(10u, 2u);
+  collector.on_wait(1ms);
+  collector.on_wait_result(20u, 0u);
+  rclcpp::ExecutableExecution execution{};
+  execution.duration = 4ms;
+  collector.on_execute(execution);
+
+  auto messages = collector.collect_metrics_and_reset();
+  ASSERT_EQ(6u, messages.size());
+  for (const auto & message : messages) {
+    EXPECT_EQ("test_executor", message.measurement_source_name);
+  }
+  const auto & wait_set_size = find_metric(messages, "executor_wait_set_size");
+  EXPECT_DOUBLE_EQ(
+    15.0, get_statistic(wait_set_size, StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+  EXPECT_DOUBLE_EQ(
+    20.0, get_statistic(wait_set_size, StatisticDataType::STATISTICS_DATA_TYPE_MAXIMUM));
+  const auto & ready_entities = find_metric(messages, "executor_ready_entities");
+  EXPECT_DOUBLE_EQ(
+    1.0, get_statistic(ready_entities, StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+  const auto & wait_time = find_metric(messages, "executor_wait_time");
+  EXPECT_EQ("ms", wait_time.unit);
+  EXPECT_DOUBLE_EQ(
+    2.0, get_statistic(wait_time, StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+  const auto & execution_time = find_metric(messages, "executor_execution_time");
+  EXPECT_DOUBLE_EQ(
+    4.0, get_statistic(execution_time, StatisticDataType::STATISTICS_DATA_TYPE_MAXIMUM));
+  const auto & cycle_rate = find_metric(messages, "executor_cycle_rate");
+  EXPECT_GT(get_statistic(cycle_rate, StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE), 0.0);
+  EXPECT_DOUBLE_EQ(
+    2.0, get_statistic(cycle_rate, StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT));
+  // 4 ms executing for 4 ms waiting.
+  const auto & utilization = find_metric(messages, "executor_utilization");
+  EXPECT_DOUBLE_EQ(
+    50.0, get_statistic(utilization, StatisticDataType::STATISTICS_DATA_TYPE_AVERAGE));
+
+  // The next window starts where this one stopped.
+  const auto next_messages = collector.collect_metrics_and_reset();
+  const auto & next_cycle_rate = find_metric(next_messages, "executor_cycle_rate");
+  EXPECT_EQ(cycle_rate.window_stop, next_cycle_rate.window_start);
+  EXPECT_DOUBLE_EQ(
+    0.0, get_statistic(next_cycle_rate, StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT));
+
+  EXPECT_THROW(collector.publish_metrics_and_reset(), std::runtime_error);
+}
+
+class TestExecutorMetricsPublication : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  void TearDown()
+  {
+    rclcpp::shutdown();
+  }
+};
+
+template<typename ExecutorT>
+void
+test_executor_feeds_metrics()
+{
+  auto node = std::make_shared<rclcpp::Node>("test_executor_metrics");
+  auto collector = rclcpp::topic_statistics::create_executor_metrics_collector(
+    node, "test_executor", "/test_executor_metrics", 50ms);
+  std::vector<MetricsMessage> received;
+  auto subscription = node->create_subscription<MetricsMessage>(
+    "/test_executor_metrics", 10, [&received](const MetricsMessage & message) {
+      received.push_back(message);
+    });
+  rclcpp::ExecutorOptions options;
+  options.instrumentation = collector;
+  ExecutorT executor(options);
+  auto timer = node->create_wall_timer(1ms, []() {std::this_thread::sleep_for(100us);});
+  executor.add_node(node);
+
+  const auto deadline = std::chrono::steady_clock::now() + 10s;
+  bool found_cycles = false;
+  while (!found_cycles && std::chrono::steady_clock::now() < deadline) {
+    executor.spin_once(10ms);
+    for (const auto & message : received) {
+      if (message.metrics_source == "executor_cycle_rate" &&
+        get_statistic(message, StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT) > 0.0)
+      {
+        found_cycles = true;
+        EXPECT_EQ("test_executor", message.measurement_source_name);
+      }
+    }
+  }
+  EXPECT_TRUE(found_cycles);
+}
+
+TEST_F(TestExecutorMetricsPublication, single_threaded_executor) {
+  test_executor_feeds_metrics<rclcpp::executors::SingleThreadedExecutor>();
+}
+
+TEST_F(TestExecutorMetricsPublication, static_single_threaded_executor) {
+  test_executor_feeds_metrics<rclcpp::executors::StaticSingleThreadedExecutor>();
+}
@@ -0,0 +1,113 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/topic_statistics/hdr_histogram.hpp"
+
+using rclcpp::topic_statistics::HdrHistogram;
+
+TEST(TestHdrHistogram, empty) {
+  HdrHistogram histogram;
+  EXPECT_EQ(0u, histogram.get_total_count());
+  EXPECT_EQ(0, histogram.get_value_at_percentile(50.0));
+}
+
+TEST(TestHdrHistogram, invalid_highest_trackable_value) {
+  EXPECT_THROW(HdrHistogram(255), std::invalid_argument);
+  EXPECT_NO_THROW(HdrHistogram(256));
+}
+
+TEST(TestHdrHistogram, small_values_are_exact) {
+  HdrHistogram histogram;
+  for (int64_t value = 1; value <= 200; ++value) {
+    histogram.record(value);
+  }
+  EXPECT_EQ(200u, histogram.get_total_count());
+  EXPECT_EQ(1, histogram.get_value_at_percentile(0.0));
+  EXPECT_EQ(100, histogram.get_value_at_percentile(50.0));
+  EXPECT_EQ(180, histogram.get_value_at_percentile(90.0));
+  EXPECT_EQ(198, histogram.get_value_at_percentile(99.0));
+  EXPECT_EQ(200, histogram.get_value_at_percentile(100.0));
+}
+
+TEST(TestHdrHistogram, relative_error_is_bounded) {
+  HdrHistogram histogram;
+  // Latencies from 1 us to 10 s in nanoseconds.
+  for (int64_t value = 1000; value <= 10000000000; value += value / 10) {
+    histogram.reset();
+    histogram.record(value);
+    const int64_t reported = histogram.get_value_at_percentile(99.9);
+    EXPECT_GE(reported, value);
+    EXPECT_LT(reported - value, value / 100) << value;
+  }
+}
+
+TEST(TestHdrHistogram, percentiles) {
+  HdrHistogram histogram;
+  // 1000 values of 1 ms, except 10 values of 1 s in the tail.
+  for (int i = 0; i < 990; ++i) {
+    histogram.record(1000000);
+  }
+  for (int i = 0; i < 10; ++i) {
+    histogram.record(1000000000);
+  }
+  EXPECT_NEAR(1000000, histogram.get_value_at_percentile(50.0), 10000);
+  EXPECT_NEAR(1000000, histogram.get_value_at_percentile(99.0), 10000);
+  EXPECT_NEAR(1000000000, histogram.get_value_at_percentile(99.9), 10000000);
+}
+
+TEST(TestHdrHistogram, out_of_range_values_are_clamped) {
+  HdrHistogram histogram(1000);
+  histogram.record(-5);
+  histogram.record(1000000);
+  EXPECT_EQ(2u, histogram.get_total_count());
+  EXPECT_EQ(0, histogram.get_value_at_percentile(50.0));
+  EXPECT_EQ(1000, histogram.get_value_at_percentile(100.0));
+}
+
+TEST(TestHdrHistogram, reset) {
+  HdrHistogram histogram;
+  histogram.record(42);
+  histogram.reset();
+  EXPECT_EQ(0u, histogram.get_total_count());
+  histogram.record(7);
+  EXPECT_EQ(7, histogram.get_value_at_percentile(100.0));
+}
+
+TEST(TestHdrHistogram, concurrent_records) {
+  constexpr int kThreads = 4;
+  constexpr int kRecordsPerThread = 10000;
+  HdrHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back(
+      [&histogram, i]() {
+        for (int j = 0; j < kRecordsPerThread; ++j) {
+          histogram.record(i + 1);
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(static_cast<uint64_t>(kThreads * kRecordsPerThread), histogram.get_total_count());
+  EXPECT_EQ(1, histogram.get_value_at_percentile(25.0));
+  EXPECT_EQ(kThreads, histogram.get_value_at_percentile(100.0));
+}
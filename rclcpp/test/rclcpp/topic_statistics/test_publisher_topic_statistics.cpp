@@ -0,0 +1,189 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/topic_statistics/publisher_topic_statistics.hpp"
+
+#include "statistics_msgs/msg/metrics_message.hpp"
+#include "statistics_msgs/msg/statistic_data_type.hpp"
+#include "test_msgs/msg/empty.hpp"
+
+using namespace std::chrono_literals;
+
+using rclcpp::topic_statistics::PublisherTopicStatistics;
+using statistics_msgs::msg::MetricsMessage;
+using statistics_msgs::msg::StatisticDataType;
+
+namespace
+{
+
+const MetricsMessage &
+find_metric(const std::vector<MetricsMessage> & messages, const std::string & metric_name)
+{
+  for (const auto & message : messages) {
+    if (message.metrics_source == metric_name) {
+      return message;
+    }
+  }
+  throw std::runtime_error("metric " + metric_name + " not found");
+}
+
+double
+get_sample_count(const MetricsMessage & message)
+{
+  for (const auto & point : message.statistics) {
+    if (point.data_type == StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT) {
+      return point.data;
+    }
+  }
+  throw std::runtime_error("sample count not found");
+}
+
+}  // namespace
+
+class TestPublisherTopicStatistics : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+    rclcpp::init(0, nullptr);
+    node_ = std::make_shared<rclcpp::Node>("test_publisher_topic_statistics");
+  }
+
+  void TearDown()
+  {
+    node_.reset();
+    rclcpp::shutdown();
+  }
+
+protected:
+  rclcpp::PublisherOptions
+  make_options() const
+  {
+    rclcpp::PublisherOptions options;
+    options.topic_stats_options.state = rclcpp::TopicStatisticsState::Enable;
+    options.topic_stats_options.publish_topic = "/test_publisher_statistics";
+    options.topic_stats_options.publish_period = 10min;
+    return options;
+  }
+
+  rclcpp::Node::SharedPtr node_;
+};
+
+TEST_F(TestPublisherTopicStatistics, disabled_by_default) {
+  auto publisher = node_->create_publisher<test_msgs::msg::Empty>("/test_topic", 10);
+  EXPECT_EQ(nullptr, publisher->get_topic_statistics());
+}
+
+TEST_F(TestPublisherTopicStatistics, constructor_checks_publisher) {
+  EXPECT_THROW(PublisherTopicStatistics("source", nullptr), std::invalid_argument);
+  auto publisher = node_->create_publisher<test_msgs::msg::Empty>("/test_topic", 10);
+  EXPECT_THROW(PublisherTopicStatistics("source", publisher), std::invalid_argument);
+}
+
+TEST_F(TestPublisherTopicStatistics, invalid_publish_period) {
+  auto options = make_options();
+  options.topic_stats_options.publish_period = 0ms;
+  EXPECT_THROW(
+    node_->create_publisher<test_msgs::msg::Empty>("/test_topic", 10, options),
+    std::invalid_argument);
+}
+
+TEST_F(TestPublisherTopicStatistics, inter_process_publications) {
+  auto publisher =
+    node_->create_publisher<test_msgs::msg::Empty>("/test_topic", 10, make_options());
+  auto statistics = publisher->get_topic_statistics();
+  ASSERT_NE(nullptr, statistics);
+
+  publisher->publish(test_msgs::msg::Empty());
+  publisher->publish(std::make_unique<test_msgs::msg::Empty>());
+  publisher->publish(test_msgs::msg::Empty());
+
+  auto messages = statistics->collect_metrics_and_reset();
+  ASSERT_EQ(4u, messages.size());
+  for (const auto & message : messages) {
+    EXPECT_EQ("/test_publisher_topic_statistics:/test_topic", message.measurement_source_name);
+  }
+  EXPECT_DOUBLE_EQ(2.0, get_sample_count(find_metric(messages, "publish_period")));
+  EXPECT_DOUBLE_EQ(3.0, get_sample_count(find_metric(messages, "publish_duration")));
+  EXPECT_DOUBLE_EQ(
+    3.0, get_sample_count(find_metric(messages, "inter_process_publish_duration")));
+  EXPECT_DOUBLE_EQ(0.0, get_sample_count(find_metric(messages, "intra_process_fan_out")));
+  EXPECT_EQ("ms", find_metric(messages, "publish_duration").unit);
+
+  // The measurements were reset.
+  messages = statistics->collect_metrics_and_reset();
+  EXPECT_DOUBLE_EQ(0.0, get_sample_count(find_metric(messages, "publish_duration")));
+}
+
+TEST_F(TestPublisherTopicStatistics, intra_process_publications) {
+  auto options = make_options();
+  options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+  auto publisher = node_->create_publisher<test_msgs::msg::Empty>("/test_topic", 10, options);
+  rclcpp::SubscriptionOptions subscription_options;
+  subscription_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+  auto subscription = node_->create_subscription<test_msgs::msg::Empty>(
+    "/test_topic", 10, [](const test_msgs::msg::Empty &) {}, subscription_options);
+  auto statistics = publisher->get_topic_statistics();
+  ASSERT_NE(nullptr, statistics);
+
+  // publish(const T &) forwards to publish(std::unique_ptr), which is measured once.
+  publisher->publish(test_msgs::msg::Empty());
+  publisher->publish(test_msgs::msg::Empty());
+
+  auto messages = statistics->collect_metrics_and_reset();
+  EXPECT_DOUBLE_EQ(2.0, get_sample_count(find_metric(messages, "publish_duration")));
+  const auto & fan_out = find_metric(messages, "intra_process_fan_out");
+  EXPECT_EQ("count", fan_out.unit);
+  EXPECT_DOUBLE_EQ(2.0, get_sample_count(fan_out));
+  for (const auto & point : fan_out.statistics) {
+    if (point.data_type == StatisticDataType::STATISTICS_DATA_TYPE_MAXIMUM) {
+      EXPECT_DOUBLE_EQ(1.0, point.data);
+    }
+  }
+}
+
+TEST_F(TestPublisherTopicStatistics, statistics_are_published) {
+  auto options = make_options();
+  options.topic_stats_options.publish_period = 10ms;
+  auto publisher = node_->create_publisher<test_msgs::msg::Empty>("/test_topic", 10, options);
+  std::vector<MetricsMessage> received;
+  auto subscription = node_->create_subscription<MetricsMessage>(
+    "/test_publisher_statistics", 10, [&received](const MetricsMessage & message) {
+      received.push_back(message);
+    });
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node_);
+  const auto deadline = std::chrono::steady_clock::now() + 10s;
+  bool found_publications = false;
+  while (!found_publications && std::chrono::steady_clock::now() < deadline) {
+    publisher->publish(test_msgs::msg::Empty());
+    executor.spin_once(10ms);
+    for (const auto & message : received) {
+      if (message.metrics_source == "publish_duration" && get_sample_count(message) > 0.0) {
+        found_publications = true;
+      }
+    }
+  }
+  EXPECT_TRUE(found_publications);
+}
@@ -85,8 +85,11 @@ class TestSubscriptionTopicStatistics : public SubscriptionTopicStatistics<Callb
 public:
   TestSubscriptionTopicStatistics(
     const std::string & node_name,
-    rclcpp::Publisher<statistics_msgs::msg::MetricsMessage>::SharedPtr publisher)
-  : SubscriptionTopicStatistics<CallbackMessageT>(node_name, publisher)
+    rclcpp::Publisher<statistics_msgs::msg::MetricsMessage>::SharedPtr publisher,
+    bool lock_free_accumulation = false,
+    bool report_percentiles = false)
+  : SubscriptionTopicStatistics<CallbackMessageT>(
+      node_name, publisher, lock_free_accumulation, report_percentiles)
   {
   }
 
@@ -97,6 +100,12 @@ public:
   {
     return SubscriptionTopicStatistics<CallbackMessageT>::get_current_collector_data();
   }
+
+  /// Exposed for testing
+  const rclcpp::topic_statistics::HdrHistogram * get_message_period_histogram() const
+  {
+    return SubscriptionTopicStatistics<CallbackMessageT>::get_message_period_histogram();
+  }
 };
 
 /**
@@ -403,6 +412,157 @@ TEST_F(TestSubscriptionTopicStatisticsFixture, test_manual_construction)
   }
 }
 
+TEST_F(TestSubscriptionTopicStatisticsFixture, test_manual_lock_free_accumulation)
+{
+  auto empty_subscriber = std::make_shared<EmptySubscriber>(
+    kTestSubNodeName,
+    kTestSubStatsEmptyTopic);
+
+  auto topic_stats_publisher =
+    empty_subscriber->create_publisher<MetricsMessage>(
+    kTestTopicStatisticsTopic,
+    10);
+
+  auto sub_topic_stats = std::make_unique<TestSubscriptionTopicStatistics<Empty>>(
+    empty_subscriber->get_name(),
+    topic_stats_publisher,
+    true);
+
+  Empty message;
+  for (int64_t seconds = 1; seconds <= 3; ++seconds) {
+    sub_topic_stats->handle_message(message, rclcpp::Time(seconds, 0u));
+  }
+
+  const auto data = sub_topic_stats->get_current_collector_data();
+  ASSERT_EQ(2u, data.size());
+  // Empty messages do not have a header, so their age is not measured.
+  const auto & message_age = data[0];
+  EXPECT_TRUE(std::isnan(message_age.average));
+  EXPECT_EQ(kNoSamples, message_age.sample_count);
+  const auto & message_period = data[1];
+  EXPECT_DOUBLE_EQ(1000.0, message_period.average);
+  EXPECT_DOUBLE_EQ(1000.0, message_period.min);
+  EXPECT_DOUBLE_EQ(1000.0, message_period.max);
+  EXPECT_DOUBLE_EQ(0.0, message_period.standard_deviation);
+  EXPECT_EQ(2u, message_period.sample_count);
+}
+
+TEST_F(TestSubscriptionTopicStatisticsFixture, test_manual_intra_process_message_age)
+{
+  auto empty_subscriber = std::make_shared<EmptySubscriber>(
+    kTestSubNodeName,
+    kTestSubStatsEmptyTopic);
+
+  auto topic_stats_publisher =
+    empty_subscriber->create_publisher<MetricsMessage>(
+    kTestTopicStatisticsTopic,
+    10);
+
+  for (const bool lock_free_accumulation : {false, true}) {
+    auto sub_topic_stats = std::make_unique<TestSubscriptionTopicStatistics<Empty>>(
+      empty_subscriber->get_name(),
+      topic_stats_publisher,
+      lock_free_accumulation);
+
+    // Empty messages do not have a header, so their age is measured from their publication.
+    Empty message;
+    sub_topic_stats->handle_intra_process_message(
+      message, rclcpp::Time(1, 0u), rclcpp::Time(0, 500000000u).nanoseconds());
+    sub_topic_stats->handle_intra_process_message(
+      message, rclcpp::Time(2, 0u), rclcpp::Time(1, 500000000u).nanoseconds());
+    // Unknown publication times are not measured.
+    sub_topic_stats->handle_intra_process_message(message, rclcpp::Time(3, 0u), 0);
+
+    const auto data = sub_topic_stats->get_current_collector_data();
+    ASSERT_EQ(2u, data.size());
+    const auto & message_age = data[0];
+    EXPECT_DOUBLE_EQ(500.0, message_age.average);
+    EXPECT_EQ(2u, message_age.sample_count);
+    const auto & message_period = data[1];
+    EXPECT_DOUBLE_EQ(1000.0, message_period.average);
+    EXPECT_EQ(2u, message_period.sample_count);
+  }
+}
+
+TEST_F(TestSubscriptionTopicStatisticsFixture, test_receive_stats_intra_process)
+{
+  auto node = std::make_shared<rclcpp::Node>(
+    kTestSubNodeName, rclcpp::NodeOptions().use_intra_process_comms(true));
+  auto publisher = node->create_publisher<Empty>(kTestSubStatsEmptyTopic, 10);
+
+  rclcpp::SubscriptionOptions options;
+  options.topic_stats_options.state = rclcpp::TopicStatisticsState::Enable;
+  options.topic_stats_options.publish_topic = kTestTopicStatisticsTopic;
+  options.topic_stats_options.publish_period = std::chrono::milliseconds(100);
+  auto subscription = node->create_subscription<Empty>(
+    kTestSubStatsEmptyTopic, 10, [](const Empty &) {}, options);
+
+  std::atomic<bool> found_message_age{false};
+  auto statistics_subscription = node->create_subscription<MetricsMessage>(
+    kTestTopicStatisticsTopic, 10, [&found_message_age](const MetricsMessage & message) {
+      if (message.metrics_source != kMessageAgeSourceLabel) {
+        return;
+      }
+      for (const auto & stats_point : message.statistics) {
+        if (stats_point.data_type == StatisticDataType::STATISTICS_DATA_TYPE_SAMPLE_COUNT &&
+          stats_point.data > 0)
+        {
+          found_message_age = true;
+        }
+      }
+    });
+
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  const auto deadline = std::chrono::steady_clock::now() + kTestTimeout;
+  while (!found_message_age && std::chrono::steady_clock::now() < deadline) {
+    publisher->publish(Empty());
+    executor.spin_some(std::chrono::milliseconds(10));
+  }
+  EXPECT_TRUE(found_message_age);
+}
+
+TEST_F(TestSubscriptionTopicStatisticsFixture, test_manual_percentiles)
+{
+  auto empty_subscriber = std::make_shared<EmptySubscriber>(
+    kTestSubNodeName,
+    kTestSubStatsEmptyTopic);
+
+  auto topic_stats_publisher =
+    empty_subscriber->create_publisher<MetricsMessage>(
+    kTestTopicStatisticsTopic,
+    10);
+
+  auto sub_topic_stats = std::make_unique<TestSubscriptionTopicStatistics<Empty>>(
+    empty_subscriber->get_name(),
+    topic_stats_publisher);
+  EXPECT_EQ(nullptr, sub_topic_stats->get_message_period_histogram());
+
+  sub_topic_stats = std::make_unique<TestSubscriptionTopicStatistics<Empty>>(
+    empty_subscriber->get_name(),
+    topic_stats_publisher,
+    false,
+    true);
+
+  // 100 periods of 10 ms, except the last one of 1 s.
+  Empty message;
+  int64_t now = 0;
+  for (int i = 0; i <= 100; ++i) {
+    now += i < 100 ? 10000000 : 1000000000;
+    sub_topic_stats->handle_message(message, rclcpp::Time(now));
+  }
+
+  const auto histogram = sub_topic_stats->get_message_period_histogram();
+  ASSERT_NE(nullptr, histogram);
+  EXPECT_EQ(100u, histogram->get_total_count());
+  EXPECT_NEAR(10000000, histogram->get_value_at_percentile(50.0), 100000);
+  EXPECT_NEAR(10000000, histogram->get_value_at_percentile(99.0), 100000);
+  EXPECT_NEAR(1000000000, histogram->get_value_at_percentile(99.9), 10000000);
+
+  sub_topic_stats->publish_message_and_reset_measurements();
+  EXPECT_EQ(0u, histogram->get_total_count());
+}
+
 /**
  * Publish messages that do not have a header timestamp, test that all statistics messages
  * were received, and verify the statistics message contents.
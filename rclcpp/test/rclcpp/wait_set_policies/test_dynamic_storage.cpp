@@ -231,6 +231,27 @@ TEST_F(TestDynamicStorage, add_remove_out_of_scope) {
   EXPECT_EQ(rclcpp::WaitResultKind::Timeout, wait_set.wait(std::chrono::milliseconds(10)).kind());
 }
 
+TEST_F(TestDynamicStorage, repeated_waits) {
+  rclcpp::WaitSet wait_set;
+
+  auto guard_condition = std::make_shared<rclcpp::GuardCondition>();
+  wait_set.add_guard_condition(guard_condition);
+  // The timer is not called, so it stays ready
+  auto timer = node->create_wall_timer(std::chrono::milliseconds(1), []() {});
+  wait_set.add_timer(timer);
+
+  // The cached handles of unchanged entities are waited on again.
+  for (size_t i = 0; i < 3; ++i) {
+    guard_condition->trigger();
+    auto wait_result = wait_set.wait(std::chrono::seconds(-1));
+    EXPECT_EQ(rclcpp::WaitResultKind::Ready, wait_result.kind());
+  }
+
+  // The handle of a deleted entity is not waited on anymore.
+  timer.reset();
+  EXPECT_EQ(rclcpp::WaitResultKind::Timeout, wait_set.wait(std::chrono::milliseconds(10)).kind());
+}
+
 TEST_F(TestDynamicStorage, wait_subscription) {
   rclcpp::WaitSet wait_set;
 
@@ -300,3 +321,27 @@ TEST_F(TestDynamicStorage, wait_waitable) {
     EXPECT_EQ(rclcpp::WaitResultKind::Empty, wait_result.kind());
   }
 }
+
+TEST_F(TestDynamicStorage, get_ready_entities) {
+  rclcpp::WaitSet wait_set;
+
+  std::vector<std::shared_ptr<rclcpp::GuardCondition>> guard_conditions;
+  for (size_t i = 0; i < 10; ++i) {
+    guard_conditions.push_back(std::make_shared<rclcpp::GuardCondition>());
+    wait_set.add_guard_condition(guard_conditions.back());
+  }
+  auto timer = node->create_wall_timer(std::chrono::hours(1), []() {});
+  wait_set.add_timer(timer);
+
+  guard_conditions[3]->trigger();
+  auto wait_result = wait_set.wait(std::chrono::seconds(-1));
+  ASSERT_EQ(rclcpp::WaitResultKind::Ready, wait_result.kind());
+  const auto & ready_entities = wait_result.get_ready_entities();
+  ASSERT_EQ(1u, ready_entities.guard_conditions.size());
+  EXPECT_EQ(guard_conditions[3], ready_entities.guard_conditions[0]);
+  EXPECT_TRUE(ready_entities.subscriptions.empty());
+  EXPECT_TRUE(ready_entities.timers.empty());
+  EXPECT_TRUE(ready_entities.clients.empty());
+  EXPECT_TRUE(ready_entities.services.empty());
+  EXPECT_TRUE(ready_entities.waitables.empty());
+}
@@ -304,3 +304,47 @@ TEST_F(TestThreadSafeStorage, wait_waitable) {
     EXPECT_EQ(rclcpp::WaitResultKind::Timeout, wait_result.kind());
   }
 }
+
+TEST_F(TestThreadSafeStorage, add_in_batch) {
+  rclcpp::ThreadSafeWaitSet wait_set;
+
+  std::vector<rclcpp::GuardCondition::SharedPtr> guard_conditions;
+  std::vector<rclcpp::TimerBase::SharedPtr> timers;
+  std::vector<rclcpp::SubscriptionBase::SharedPtr> subscriptions;
+  for (size_t i = 0; i < 10; ++i) {
+    guard_conditions.push_back(std::make_shared<rclcpp::GuardCondition>());
+    timers.push_back(node->create_wall_timer(std::chrono::seconds(100), []() {}));
+    subscriptions.push_back(
+      node->create_subscription<test_msgs::msg::Empty>(
+        "topic", 10, [](test_msgs::msg::Empty::ConstSharedPtr) {}));
+  }
+
+  // Each range takes the write lock once.
+  wait_set.add_guard_conditions(guard_conditions);
+  wait_set.add_timers(timers);
+  wait_set.add_subscriptions(subscriptions);
+  EXPECT_EQ(3u, wait_set.get_lock_statistics().write_locks);
+
+  // Nested batches, and removals, are applied with the lock of the outer batch.
+  wait_set.batch(
+    [&](rclcpp::ThreadSafeWaitSet & inner_wait_set) {
+      inner_wait_set.remove_timer(timers[0]);
+      inner_wait_set.batch(
+        [&](rclcpp::ThreadSafeWaitSet & nested_wait_set) {
+          nested_wait_set.remove_guard_condition(guard_conditions[0]);
+        });
+    });
+  EXPECT_EQ(4u, wait_set.get_lock_statistics().write_locks);
+
+  guard_conditions[1]->trigger();
+  {
+    auto wait_result = wait_set.wait(std::chrono::seconds(1));
+    EXPECT_EQ(rclcpp::WaitResultKind::Ready, wait_result.kind());
+  }
+  // The wait and the wait result each lock the read mutex.
+  EXPECT_EQ(2u, wait_set.get_lock_statistics().read_locks);
+
+  RCLCPP_EXPECT_THROW_EQ(
+    wait_set.add_timers(std::vector<rclcpp::TimerBase::SharedPtr>{timers[1]}),
+    std::runtime_error("timer already in use by another wait set"));
+}
@@ -0,0 +1,139 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP_ACTION__ACTION_INTRA_PROCESS_HPP_
+#define RCLCPP_ACTION__ACTION_INTRA_PROCESS_HPP_
+
+#include <rclcpp/context.hpp>
+#include <rclcpp/experimental/service_intra_process_base.hpp>
+#include <rclcpp/macros.hpp>
+#include <rosidl_runtime_c/action_type_support_struct.h>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "rclcpp_action/visibility_control.hpp"
+
+namespace rclcpp_action
+{
+
+/// Queue of the messages passed intra process to an action server or to an action client.
+/**
+ * With intra process communication enabled for its node, an action server registers its queue
+ * with the rclcpp::experimental::IntraProcessManager of its context, under the name of the
+ * action followed by "/_action".
+ * The clients of the same context find it there and queue their goal, cancel and result requests
+ * in it, each with a callback queueing the response in the queue of the client.
+ * The server also queues its feedback and status messages in the queues of these clients.
+ *
+ * The messages are shared as is, without being serialized.
+ * Each queue is executed as part of the waitable of its server or client, so the callbacks are
+ * still called by the executor of the server or client, in its callback group.
+ */
+class ActionIntraProcess : public rclcpp::experimental::ServiceIntraProcessBase
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(ActionIntraProcess)
+
+  enum class MessageType
+  {
+    GoalRequest,
+    CancelRequest,
+    ResultRequest,
+    GoalResponse,
+    CancelResponse,
+    ResultResponse,
+    Feedback,
+    Status,
+  };
+
+  /// Called with the response to a request, from the thread of the server.
+  using ResponseCallback = std::function<void (std::shared_ptr<void>)>;
+
+  struct Message
+  {
+    MessageType type;
+    /// The message, of the type of the action, not modified once queued.
+    std::shared_ptr<void> message;
+    /// For a request, called with the response, for a response, the callback of the client.
+    ResponseCallback response_callback;
+    /// For a goal request, the queue of the client, which receives the feedback and the status.
+    std::weak_ptr<ActionIntraProcess> client;
+  };
+
+  /// Called by execute() with each message taken from the queue.
+  using MessageHandler = std::function<void (Message &)>;
+
+  /// Constructor.
+  /**
+   * \param[in] context the context of the server or client.
+   * \param[in] name the name the queue is registered with, if it is the queue of a server.
+   * \param[in] type_support the type support of the action, for the clients to check it.
+   * \param[in] message_handler called with each message taken from the queue.
+   */
+  RCLCPP_ACTION_PUBLIC
+  ActionIntraProcess(
+    rclcpp::Context::SharedPtr context,
+    const std::string & name,
+    const rosidl_action_type_support_t * type_support,
+    MessageHandler message_handler);
+
+  RCLCPP_ACTION_PUBLIC
+  virtual ~ActionIntraProcess();
+
+  /// Return the name of the queue of the server of an action.
+  /**
+   * \param[in] action_name the fully qualified name of the action.
+   */
+  RCLCPP_ACTION_PUBLIC
+  static std::string
+  get_server_queue_name(const std::string & action_name);
+
+  RCLCPP_ACTION_PUBLIC
+  const rosidl_action_type_support_t *
+  get_type_support() const;
+
+  /// Queue a message and wake the executor of the owner of the queue up.
+  RCLCPP_ACTION_PUBLIC
+  void
+  push(Message message);
+
+  RCLCPP_ACTION_PUBLIC
+  bool
+  is_ready(rcl_wait_set_t * wait_set) override;
+
+  /// Take the oldest message, or return nullptr if the queue is empty.
+  RCLCPP_ACTION_PUBLIC
+  std::shared_ptr<void>
+  take_data() override;
+
+  /// Pass a message taken with take_data() to the message handler.
+  RCLCPP_ACTION_PUBLIC
+  void
+  execute(std::shared_ptr<void> & data) override;
+
+private:
+  const rosidl_action_type_support_t * type_support_;
+  MessageHandler message_handler_;
+
+  std::mutex mutex_;
+  std::deque<Message> messages_;
+};
+
+}  // namespace rclcpp_action
+
+#endif  // RCLCPP_ACTION__ACTION_INTRA_PROCESS_HPP_
@@ -31,12 +31,13 @@
 #include <chrono>
 #include <functional>
 #include <future>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
+#include "rclcpp_action/action_intra_process.hpp"
 #include "rclcpp_action/client_goal_handle.hpp"
 #include "rclcpp_action/exceptions.hpp"
 #include "rclcpp_action/types.hpp"
@@ -55,6 +56,10 @@ class ClientBaseImpl;
  * Instead users should use `rclcpp_action::Client<>`.
  *
  * Internally, this class is responsible for interfacing with the `rcl_action` API.
+ *
+ * If intra process communication is enabled for the node and the action server is in the same
+ * context, the requests, the responses, the feedback and the status are passed to and from the
+ * server without being serialized, see ActionIntraProcess.
  */
 class ClientBase : public rclcpp::Waitable
 {
@@ -245,6 +250,10 @@ protected:
   // ---------------------------------------------------------
 
 private:
+  /// Handle a response, feedback or status message received intra process.
+  void
+  execute_intra_process_message(ActionIntraProcess::Message & message);
+
   std::unique_ptr<ClientBaseImpl> pimpl_;
 };
 
@@ -469,7 +478,7 @@ private:
           new GoalHandle(goal_info, options.feedback_callback, options.result_callback));
         {
           std::lock_guard<std::mutex> guard(goal_handles_mutex_);
-          goal_handles_[goal_handle->get_goal_id()] = goal_handle;
+          goal_handles_[goal_handle->get_goal_id()] = {goal_handle, goal_handle->get_status()};
         }
         promise->set_value(goal_handle);
         if (options.goal_response_callback) {
@@ -489,7 +498,7 @@ private:
       std::lock_guard<std::mutex> guard(goal_handles_mutex_);
       auto goal_handle_it = goal_handles_.begin();
       while (goal_handle_it != goal_handles_.end()) {
-        if (!goal_handle_it->second.lock()) {
+        if (goal_handle_it->second.goal_handle.expired()) {
           RCLCPP_DEBUG(
             this->get_logger(),
             "Dropping weak reference to goal handle during send_goal()");
@@ -613,7 +622,7 @@ private:
     std::lock_guard<std::mutex> guard(goal_handles_mutex_);
     auto it = goal_handles_.begin();
     while (it != goal_handles_.end()) {
-      typename GoalHandle::SharedPtr goal_handle = it->second.lock();
+      typename GoalHandle::SharedPtr goal_handle = it->second.goal_handle.lock();
       if (goal_handle) {
         goal_handle->invalidate(exceptions::UnawareGoalHandleError());
       }
@@ -657,28 +666,32 @@ private:
   void
   handle_feedback_message(std::shared_ptr<void> message) override
   {
-    std::lock_guard<std::mutex> guard(goal_handles_mutex_);
     using FeedbackMessage = typename ActionT::Impl::FeedbackMessage;
     typename FeedbackMessage::SharedPtr feedback_message =
       std::static_pointer_cast<FeedbackMessage>(message);
     const GoalUUID & goal_id = feedback_message->goal_id.uuid;
-    if (goal_handles_.count(goal_id) == 0) {
-      RCLCPP_DEBUG(
-        this->get_logger(),
-        "Received feedback for unknown goal. Ignoring...");
-      return;
-    }
-    typename GoalHandle::SharedPtr goal_handle = goal_handles_[goal_id].lock();
-    // Forget about the goal if there are no more user references
-    if (!goal_handle) {
-      RCLCPP_DEBUG(
-        this->get_logger(),
-        "Dropping weak reference to goal handle during feedback callback");
-      goal_handles_.erase(goal_id);
-      return;
+    typename GoalHandle::SharedPtr goal_handle;
+    {
+      std::lock_guard<std::mutex> guard(goal_handles_mutex_);
+      auto it = goal_handles_.find(goal_id);
+      if (it == goal_handles_.end()) {
+        RCLCPP_DEBUG(
+          this->get_logger(),
+          "Received feedback for unknown goal. Ignoring...");
+        return;
+      }
+      goal_handle = it->second.goal_handle.lock();
+      // Forget about the goal if there are no more user references
+      if (!goal_handle) {
+        RCLCPP_DEBUG(
+          this->get_logger(),
+          "Dropping weak reference to goal handle during feedback callback");
+        goal_handles_.erase(it);
+        return;
+      }
     }
-    auto feedback = std::make_shared<Feedback>();
-    *feedback = feedback_message->feedback;
+    // The feedback is handed out in place, sharing the ownership of the received message.
+    std::shared_ptr<const Feedback> feedback(feedback_message, &feedback_message->feedback);
     goal_handle->call_feedback_callback(goal_handle, feedback);
   }
 
@@ -697,23 +710,31 @@ private:
     std::lock_guard<std::mutex> guard(goal_handles_mutex_);
     using GoalStatusMessage = typename ActionT::Impl::GoalStatusMessage;
     auto status_message = std::static_pointer_cast<GoalStatusMessage>(message);
+    // The status array holds the goals of every client of the server, only the goals of this
+    // client whose status changed since the last message are updated.
+    size_t remaining_goals = goal_handles_.size();
     for (const GoalStatus & status : status_message->status_list) {
-      const GoalUUID & goal_id = status.goal_info.goal_id.uuid;
-      if (goal_handles_.count(goal_id) == 0) {
-        RCLCPP_DEBUG(
-          this->get_logger(),
-          "Received status for unknown goal. Ignoring...");
+      if (0u == remaining_goals) {
+        break;
+      }
+      auto it = goal_handles_.find(status.goal_info.goal_id.uuid);
+      if (it == goal_handles_.end()) {
+        continue;
+      }
+      --remaining_goals;
+      if (it->second.status == status.status) {
         continue;
       }
-      typename GoalHandle::SharedPtr goal_handle = goal_handles_[goal_id].lock();
+      typename GoalHandle::SharedPtr goal_handle = it->second.goal_handle.lock();
       // Forget about the goal if there are no more user references
       if (!goal_handle) {
         RCLCPP_DEBUG(
           this->get_logger(),
           "Dropping weak reference to goal handle during status callback");
-        goal_handles_.erase(goal_id);
+        goal_handles_.erase(it);
         continue;
       }
+      it->second.status = status.status;
       goal_handle->set_status(status.status);
     }
   }
@@ -774,7 +795,14 @@ private:
     return future;
   }
 
-  std::map<GoalUUID, typename GoalHandle::WeakPtr> goal_handles_;
+  /// A goal of this client, with its status as of the last status message.
+  struct TrackedGoal
+  {
+    typename GoalHandle::WeakPtr goal_handle;
+    int8_t status;
+  };
+
+  std::unordered_map<GoalUUID, TrackedGoal> goal_handles_;
   std::mutex goal_handles_mutex_;
 };
 }  // namespace rclcpp_action
@@ -0,0 +1,186 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP_ACTION__COROUTINE_HPP_
+#define RCLCPP_ACTION__COROUTINE_HPP_
+
+// Awaitable results of the action clients, for C++20 coroutines, see rclcpp/coroutine.hpp.
+
+#include "rclcpp/coroutine.hpp"
+
+#ifdef RCLCPP_HAS_COROUTINES
+
+#include <chrono>
+#include <coroutine>
+#include <future>
+#include <memory>
+#include <utility>
+
+#include "rclcpp_action/client.hpp"
+
+namespace rclcpp_action
+{
+
+/// Awaiter of the response of an action server to a goal, see send_goal_awaitable().
+template<typename ActionT>
+class GoalResponseAwaiter
+{
+public:
+  using ClientT = Client<ActionT>;
+  using GoalHandleSharedPtr = typename ClientT::GoalHandle::SharedPtr;
+
+  GoalResponseAwaiter(
+    typename ClientT::SharedPtr client,
+    const typename ClientT::Goal & goal,
+    const typename ClientT::SendGoalOptions & options)
+  : client_(std::move(client)),
+    goal_(goal),
+    options_(options),
+    state_(std::make_shared<rclcpp::detail::AwaitState<GoalHandleSharedPtr>>())
+  {}
+
+  bool
+  await_ready() const noexcept
+  {
+    return false;
+  }
+
+  void
+  await_suspend(std::coroutine_handle<> handle)
+  {
+    state_->handle = handle;
+    // The response can resume the coroutine before the goal call returns, so only locals are
+    // used from here on.
+    auto client = client_;
+    auto state = state_;
+    auto options = options_;
+    options.goal_response_callback =
+      typename ClientT::GoalResponseCallback::NewSignature(
+      [state](GoalHandleSharedPtr goal_handle) {
+        state->complete(std::move(goal_handle));
+      });
+    client->async_send_goal(goal_, options);
+  }
+
+  GoalHandleSharedPtr
+  await_resume()
+  {
+    return std::move(state_->result);
+  }
+
+private:
+  typename ClientT::SharedPtr client_;
+  typename ClientT::Goal goal_;
+  typename ClientT::SendGoalOptions options_;
+  std::shared_ptr<rclcpp::detail::AwaitState<GoalHandleSharedPtr>> state_;
+};
+
+/// Send a goal to an action server and await its acceptance.
+/**
+ * The coroutine is resumed by the executor of the client, when it executes the goal response.
+ * It stays suspended if no response arrives, e.g. if the client is destroyed first.
+ *
+ * \param[in] client the action client.
+ * \param[in] goal the goal.
+ * \param[in] options the options of the goal, whose goal_response_callback is replaced.
+ * \return an awaitable whose result is the goal handle, or nullptr if the goal was rejected.
+ */
+template<typename ActionT>
+GoalResponseAwaiter<ActionT>
+send_goal_awaitable(
+  typename Client<ActionT>::SharedPtr client,
+  const typename Client<ActionT>::Goal & goal,
+  const typename Client<ActionT>::SendGoalOptions & options =
+  typename Client<ActionT>::SendGoalOptions())
+{
+  return GoalResponseAwaiter<ActionT>(std::move(client), goal, options);
+}
+
+/// Awaiter of the result of a goal, see get_result_awaitable().
+template<typename ActionT>
+class ResultAwaiter
+{
+public:
+  using ClientT = Client<ActionT>;
+
+  ResultAwaiter(
+    typename ClientT::SharedPtr client,
+    typename ClientT::GoalHandle::SharedPtr goal_handle)
+  : client_(std::move(client)),
+    goal_handle_(std::move(goal_handle)),
+    state_(std::make_shared<rclcpp::detail::AwaitState<typename ClientT::WrappedResult>>())
+  {}
+
+  bool
+  await_ready() const noexcept
+  {
+    return false;
+  }
+
+  bool
+  await_suspend(std::coroutine_handle<> handle)
+  {
+    state_->handle = handle;
+    auto client = client_;
+    auto state = state_;
+    auto result_future = client->async_get_result(
+      goal_handle_,
+      [state](const typename ClientT::WrappedResult & result) {
+        state->complete(result);
+      });
+    // The result may have been received before the callback was set.
+    if (result_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+      // Resume without suspending, unless the callback already resumes the coroutine.
+      return !state->set_result(result_future.get());
+    }
+    return true;
+  }
+
+  typename ClientT::WrappedResult
+  await_resume()
+  {
+    return std::move(state_->result);
+  }
+
+private:
+  typename ClientT::SharedPtr client_;
+  typename ClientT::GoalHandle::SharedPtr goal_handle_;
+  std::shared_ptr<rclcpp::detail::AwaitState<typename ClientT::WrappedResult>> state_;
+};
+
+/// Await the result of an accepted goal.
+/**
+ * The coroutine is resumed by the executor of the client, when it executes the result.
+ * The result callback of the goal is replaced, see Client::async_get_result().
+ *
+ * \param[in] client the action client which sent the goal.
+ * \param[in] goal_handle the goal handle, e.g. the result of send_goal_awaitable().
+ * \return an awaitable whose result is the wrapped result of the goal.
+ * \throws exceptions::UnknownGoalHandleError from the co_await expression, if the goal is
+ *   unknown, see Client::async_get_result().
+ */
+template<typename ActionT>
+ResultAwaiter<ActionT>
+get_result_awaitable(
+  typename Client<ActionT>::SharedPtr client,
+  typename Client<ActionT>::GoalHandle::SharedPtr goal_handle)
+{
+  return ResultAwaiter<ActionT>(std::move(client), std::move(goal_handle));
+}
+
+}  // namespace rclcpp_action
+
+#endif  // RCLCPP_HAS_COROUTINES
+
+#endif  // RCLCPP_ACTION__COROUTINE_HPP_
@@ -52,6 +52,10 @@ namespace rclcpp_action
  * \param[in] options Options to pass to the underlying `rcl_action_server_t`.
  * \param[in] group The action server will be added to this callback group.
  *   If `nullptr`, then the action server is added to the default callback group.
+ * \param[in] status_options Options of the publishing of the goal statuses.
+ * \param[in] execution_options Options of the execution of the accepted goals.
+ *   With a pool of threads, handle_accepted is called by one of them and may block until the
+ *   goal reaches a terminal state.
  */
 template<typename ActionT>
 typename Server<ActionT>::SharedPtr
@@ -65,7 +69,9 @@ create_server(
   typename Server<ActionT>::CancelCallback handle_cancel,
   typename Server<ActionT>::AcceptedCallback handle_accepted,
   const rcl_action_server_options_t & options = rcl_action_server_get_default_options(),
-  rclcpp::CallbackGroup::SharedPtr group = nullptr)
+  rclcpp::CallbackGroup::SharedPtr group = nullptr,
+  const GoalStatusPublishingOptions & status_options = GoalStatusPublishingOptions(),
+  const GoalExecutionOptions & execution_options = GoalExecutionOptions())
 {
   std::weak_ptr<rclcpp::node_interfaces::NodeWaitablesInterface> weak_node =
     node_waitables_interface;
@@ -104,7 +110,9 @@ create_server(
       options,
       handle_goal,
       handle_cancel,
-      handle_accepted), deleter);
+      handle_accepted,
+      status_options,
+      execution_options), deleter);
 
   node_waitables_interface->add_waitable(action_server, group);
   return action_server;
@@ -126,6 +134,10 @@ create_server(
  * \param[in] options Options to pass to the underlying `rcl_action_server_t`.
  * \param[in] group The action server will be added to this callback group.
  *   If `nullptr`, then the action server is added to the default callback group.
+ * \param[in] status_options Options of the publishing of the goal statuses.
+ * \param[in] execution_options Options of the execution of the accepted goals.
+ *   With a pool of threads, handle_accepted is called by one of them and may block until the
+ *   goal reaches a terminal state.
  */
 template<typename ActionT, typename NodeT>
 typename Server<ActionT>::SharedPtr
@@ -136,7 +148,9 @@ create_server(
   typename Server<ActionT>::CancelCallback handle_cancel,
   typename Server<ActionT>::AcceptedCallback handle_accepted,
   const rcl_action_server_options_t & options = rcl_action_server_get_default_options(),
-  rclcpp::CallbackGroup::SharedPtr group = nullptr)
+  rclcpp::CallbackGroup::SharedPtr group = nullptr,
+  const GoalStatusPublishingOptions & status_options = GoalStatusPublishingOptions(),
+  const GoalExecutionOptions & execution_options = GoalExecutionOptions())
 {
   return create_server<ActionT>(
     node->get_node_base_interface(),
@@ -148,7 +162,9 @@ create_server(
     handle_cancel,
     handle_accepted,
     options,
-    group);
+    group,
+    status_options,
+    execution_options);
 }
 }  // namespace rclcpp_action
 #endif  // RCLCPP_ACTION__CREATE_SERVER_HPP_
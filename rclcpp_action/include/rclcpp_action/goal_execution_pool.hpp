@@ -0,0 +1,107 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP_ACTION__GOAL_EXECUTION_POOL_HPP_
+#define RCLCPP_ACTION__GOAL_EXECUTION_POOL_HPP_
+
+#include <rclcpp/macros.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "rclcpp_action/visibility_control.hpp"
+
+namespace rclcpp_action
+{
+
+/// Options of the execution of the goals accepted by an action server.
+struct GoalExecutionOptions
+{
+  /// Number of threads executing the accepted goals.
+  /**
+   * If zero, the accepted callback is called by the executor, which is expected to hand the goal
+   * over to another thread.
+   * Otherwise, the accepted callback is called by one of these threads and can execute the goal
+   * until it reaches a terminal state.
+   */
+  size_t max_concurrent_goals = 0;
+  /// Number of accepted goals waiting for a thread, goals requested beyond it are rejected.
+  size_t max_queued_goals = 0;
+};
+
+/// A bounded pool of threads executing the goals of an action server.
+/**
+ * Up to `max_concurrent_goals` goals run at the same time, and up to `max_queued_goals` more wait
+ * for a thread, in the order they were submitted.
+ *
+ * The pool is used by `rclcpp_action::Server` when created with non-zero
+ * `GoalExecutionOptions::max_concurrent_goals`.
+ */
+class GoalExecutionPool
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS_NOT_COPYABLE(GoalExecutionPool)
+
+  /// Start the threads of the pool.
+  /**
+   * \throws std::invalid_argument If `max_concurrent_goals` is zero.
+   */
+  RCLCPP_ACTION_PUBLIC
+  explicit GoalExecutionPool(const GoalExecutionOptions & options);
+
+  /// Wait for the running goals to return, the queued goals are dropped.
+  /**
+   * If called from a thread of the pool, that thread is detached instead.
+   */
+  RCLCPP_ACTION_PUBLIC
+  ~GoalExecutionPool();
+
+  /// Return true if no more goal can be submitted without exceeding the queue size.
+  RCLCPP_ACTION_PUBLIC
+  bool
+  is_full() const;
+
+  /// Queue a goal, to be executed by the first available thread.
+  /**
+   * The goal is queued even if the pool is full, the caller is expected to reject goals first
+   * with is_full().
+   */
+  RCLCPP_ACTION_PUBLIC
+  void
+  submit(std::function<void()> goal);
+
+  /// Return the number of goals running or waiting for a thread.
+  RCLCPP_ACTION_PUBLIC
+  size_t
+  size() const;
+
+private:
+  struct State;
+
+  /// Execute the queued goals until the pool is stopped.
+  static void
+  run_goals(std::shared_ptr<State> state);
+
+  const GoalExecutionOptions options_;
+  // Shared with the threads, which may outlive the pool when it is destroyed by one of them
+  std::shared_ptr<State> state_;
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace rclcpp_action
+
+#endif  // RCLCPP_ACTION__GOAL_EXECUTION_POOL_HPP_
@@ -24,6 +24,7 @@
  * - Action Server
  *   - rclcpp_action/server.hpp
  *   - rclcpp_action/create_server.hpp
+ *   - rclcpp_action/goal_execution_pool.hpp
  *   - rclcpp_action/server_goal_handle.hpp
  */
 
@@ -37,6 +38,7 @@
 #include "rclcpp_action/client_goal_handle.hpp"
 #include "rclcpp_action/create_client.hpp"
 #include "rclcpp_action/create_server.hpp"
+#include "rclcpp_action/goal_execution_pool.hpp"
 #include "rclcpp_action/server.hpp"
 #include "rclcpp_action/server_goal_handle.hpp"
 #include "rclcpp_action/visibility_control.hpp"
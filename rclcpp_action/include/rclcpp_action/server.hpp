@@ -15,6 +15,7 @@
 #ifndef RCLCPP_ACTION__SERVER_HPP_
 #define RCLCPP_ACTION__SERVER_HPP_
 
+#include <action_msgs/srv/cancel_goal.hpp>
 #include <rcl_action/action_server.h>
 #include <rosidl_runtime_c/action_type_support_struct.h>
 #include <rosidl_typesupport_cpp/action_type_support.hpp>
@@ -23,13 +24,17 @@
 #include <rclcpp/node_interfaces/node_logging_interface.hpp>
 #include <rclcpp/waitable.hpp>
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <utility>
 
+#include "rclcpp_action/action_intra_process.hpp"
+#include "rclcpp_action/goal_execution_pool.hpp"
 #include "rclcpp_action/visibility_control.hpp"
 #include "rclcpp_action/server_goal_handle.hpp"
 #include "rclcpp_action/types.hpp"
@@ -59,6 +64,26 @@ enum class CancelResponse : int8_t
   ACCEPT = 2,
 };
 
+/// Options of the publishing of the goal statuses of an action server.
+struct GoalStatusPublishingOptions
+{
+  /// If true, the status message is updated for the goals which changed state only.
+  /**
+   * The server then keeps the status message and updates the entry of a goal as it changes
+   * state, instead of gathering the status of all the goals at each transition.
+   */
+  bool incremental = false;
+  /// Period over which the transitions are coalesced into one status message, if incremental.
+  /** With a zero period, a status message is published at each transition. */
+  std::chrono::nanoseconds coalescing_period{0};
+  /// If true and incremental, a goal is left out of the status messages once reported terminal.
+  /**
+   * The goal is still kept by the server until it expires, so a client can get its result.
+   * A client which had not received the terminal state of the goal does not see it anymore.
+   */
+  bool skip_reported_terminal_goals = false;
+};
+
 /// Base Action Server implementation
 /// \internal
 /**
@@ -66,6 +91,12 @@ enum class CancelResponse : int8_t
  * Instead users should use `rclcpp_action::Server`.
  *
  * Internally, this class is responsible for interfacing with the `rcl_action` API.
+ *
+ * With intra process communication enabled for the node, the clients of the same context send
+ * their requests through an ActionIntraProcess queue, and receive the responses, the feedback
+ * and the status messages as shared pointers, see ActionIntraProcess.
+ * The feedback and the status messages are then only published through the middleware if it
+ * reports subscribers besides these clients.
  */
 class ServerBase : public rclcpp::Waitable
 {
@@ -139,7 +170,8 @@ protected:
     rclcpp::node_interfaces::NodeLoggingInterface::SharedPtr node_logging,
     const std::string & name,
     const rosidl_action_type_support_t * type_support,
-    const rcl_action_server_options_t & options);
+    const rcl_action_server_options_t & options,
+    const GoalStatusPublishingOptions & status_options = GoalStatusPublishingOptions());
 
   // -----------------------------------------------------
   // API for communication between ServerBase and Server<>
@@ -205,11 +237,21 @@ protected:
   std::shared_ptr<void>
   create_result_response(decltype(action_msgs::msg::GoalStatus::status) status) = 0;
 
+  /// Publish the status of all the goals.
   /// \internal
   RCLCPP_ACTION_PUBLIC
   void
   publish_status();
 
+  /// Publish the status of the goals after the given goal changed state.
+  /**
+   * Unless the status publishing is incremental, this is the same as publish_status().
+   * \internal
+   */
+  RCLCPP_ACTION_PUBLIC
+  void
+  publish_status(const GoalUUID & uuid);
+
   /// \internal
   RCLCPP_ACTION_PUBLIC
   void
@@ -225,6 +267,19 @@ protected:
   void
   publish_feedback(std::shared_ptr<void> feedback_msg);
 
+  /// Publish a feedback message, the clients of the same context get the message to share
+  /**
+   * \param[in] feedback_msg the message to publish
+   * \param[in] get_intra_process_message returns the message given to the clients of the same
+   *   context, e.g. a copy of a message which is reused.
+   * \internal
+   */
+  RCLCPP_ACTION_PUBLIC
+  void
+  publish_feedback(
+    std::shared_ptr<void> feedback_msg,
+    const std::function<std::shared_ptr<void>()> & get_intra_process_message);
+
   // End API for communication between ServerBase and Server<>
   // ---------------------------------------------------------
 
@@ -247,12 +302,64 @@ private:
   void
   execute_result_request_received(std::shared_ptr<void> & data);
 
+  /// Function sending the response to a request
+  using ResponseSender = std::function<void (std::shared_ptr<void> response)>;
+
+  /// Handle a goal request received from the middleware or intra process
+  /// \internal
+  RCLCPP_ACTION_PUBLIC
+  void
+  handle_goal_request(std::shared_ptr<void> message, const ResponseSender & send_response);
+
+  /// Handle a cancel request received from the middleware or intra process
+  /// \internal
+  RCLCPP_ACTION_PUBLIC
+  std::shared_ptr<action_msgs::srv::CancelGoal::Response>
+  handle_cancel_request(const action_msgs::srv::CancelGoal::Request & request);
+
+  /// Handle a request sent intra process by a client of the same context
+  /// \internal
+  RCLCPP_ACTION_PUBLIC
+  void
+  execute_intra_process_message(ActionIntraProcess::Message & message);
+
+  /// Give a feedback or status message to the clients of the same context
+  /**
+   * \param[in] type the type of the message
+   * \param[in] get_message returns the message, only called if there are such clients
+   * \return true if it must also be published through the middleware
+   * \internal
+   */
+  RCLCPP_ACTION_PUBLIC
+  bool
+  publish_intra_process(
+    ActionIntraProcess::MessageType type,
+    const std::function<std::shared_ptr<void>()> & get_message);
+
   /// Handle a timeout indicating a completed goal should be forgotten by the server
   /// \internal
   RCLCPP_ACTION_PUBLIC
   void
   execute_check_expired_goals();
 
+  /// Update the entry of a goal in the incremental status message
+  /// \internal
+  RCLCPP_ACTION_PUBLIC
+  void
+  update_goal_status(const GoalUUID & uuid);
+
+  /// Publish the updated status message, or at the end of the coalescing period
+  /// \internal
+  RCLCPP_ACTION_PUBLIC
+  void
+  publish_updated_status();
+
+  /// Publish the updated status message now, if any goal changed state since the last one
+  /// \internal
+  RCLCPP_ACTION_PUBLIC
+  void
+  publish_pending_status();
+
   /// Private implementation
   /// \internal
   std::unique_ptr<ServerBaseImpl> pimpl_;
@@ -291,7 +398,8 @@ public:
    *  - one to accept or reject goals sent to the server,
    *  - one to accept or reject requests to cancel a goal,
    *  - one to receive a goal handle after a goal has been accepted.
-   * All callbacks must be non-blocking.
+   * All callbacks must be non-blocking, except the accepted callback when the goals are executed
+   * by a pool of threads of the server, see `GoalExecutionOptions`.
    * The result of a goal should be set using methods on `rclcpp_action::ServerGoalHandle`.
    *
    * \param[in] node_base a pointer to the base interface of a node.
@@ -307,6 +415,12 @@ public:
    *  It does not indicate if the goal was actually canceled.
    * \param[in] handle_accepted a callback that is called to give the user a handle to the goal.
    *  execution.
+   * \param[in] status_options options of the publishing of the goal statuses.
+   * \param[in] execution_options options of the execution of the accepted goals.
+   *  When goals are executed by a pool of threads, the goals requested while the pool is full
+   *  are rejected without calling handle_goal, and the destruction of the server waits for the
+   *  running goals.
+   * \throws std::invalid_argument If goals are queued without a pool of threads.
    */
   Server(
     rclcpp::node_interfaces::NodeBaseInterface::SharedPtr node_base,
@@ -316,7 +430,9 @@ public:
     const rcl_action_server_options_t & options,
     GoalCallback handle_goal,
     CancelCallback handle_cancel,
-    AcceptedCallback handle_accepted
+    AcceptedCallback handle_accepted,
+    const GoalStatusPublishingOptions & status_options = GoalStatusPublishingOptions(),
+    const GoalExecutionOptions & execution_options = GoalExecutionOptions()
   )
   : ServerBase(
       node_base,
@@ -324,11 +440,17 @@ public:
       node_logging,
       name,
       rosidl_typesupport_cpp::get_action_type_support_handle<ActionT>(),
-      options),
+      options,
+      status_options),
     handle_goal_(handle_goal),
     handle_cancel_(handle_cancel),
     handle_accepted_(handle_accepted)
   {
+    if (execution_options.max_concurrent_goals > 0u) {
+      execution_pool_ = std::make_unique<GoalExecutionPool>(execution_options);
+    } else if (execution_options.max_queued_goals > 0u) {
+      throw std::invalid_argument("queueing goals requires a goal execution pool");
+    }
   }
 
   virtual ~Server() = default;
@@ -344,7 +466,14 @@ protected:
     auto request = std::static_pointer_cast<
       typename ActionT::Impl::SendGoalService::Request>(message);
     auto goal = std::shared_ptr<typename ActionT::Goal>(request, &request->goal);
-    GoalResponse user_response = handle_goal_(uuid, goal);
+    GoalResponse user_response = GoalResponse::REJECT;
+    if (execution_pool_ && execution_pool_->is_full()) {
+      RCLCPP_DEBUG(
+        rclcpp::get_logger("rclcpp_action"),
+        "Rejecting goal %s, the goal execution pool is full", to_string(uuid).c_str());
+    } else {
+      user_response = handle_goal_(uuid, goal);
+    }
 
     auto ros_response = std::make_shared<typename ActionT::Impl::SendGoalService::Response>();
     ros_response->accepted = GoalResponse::ACCEPT_AND_EXECUTE == user_response ||
@@ -401,7 +530,7 @@ protected:
         // Send result message to anyone that asked
         shared_this->publish_result(goal_uuid, result_message);
         // Publish a status message any time a goal handle changes state
-        shared_this->publish_status();
+        shared_this->publish_status(goal_uuid);
         // notify base so it can recalculate the expired goal timer
         shared_this->notify_goal_terminal_state();
         // Delete data now (ServerBase and rcl_action_server_t keep data until goal handle expires)
@@ -416,9 +545,8 @@ protected:
         if (!shared_this) {
           return;
         }
-        (void)goal_uuid;
         // Publish a status message any time a goal handle changes state
-        shared_this->publish_status();
+        shared_this->publish_status(goal_uuid);
       };
 
     std::function<void(std::shared_ptr<typename ActionT::Impl::FeedbackMessage>)> publish_feedback =
@@ -431,17 +559,42 @@ protected:
         shared_this->publish_feedback(std::static_pointer_cast<void>(feedback_msg));
       };
 
+    std::function<void(std::shared_ptr<typename ActionT::Impl::FeedbackMessage>)>
+    publish_borrowed_feedback =
+      [weak_this](std::shared_ptr<typename ActionT::Impl::FeedbackMessage> feedback_msg)
+      {
+        std::shared_ptr<Server<ActionT>> shared_this = weak_this.lock();
+        if (!shared_this) {
+          return;
+        }
+        // The message is reused by the goal handle, so it is only shared as a copy.
+        shared_this->publish_feedback(
+          std::static_pointer_cast<void>(feedback_msg),
+          [&feedback_msg]() {
+            return std::make_shared<typename ActionT::Impl::FeedbackMessage>(*feedback_msg);
+          });
+      };
+
     auto request = std::static_pointer_cast<
       const typename ActionT::Impl::SendGoalService::Request>(goal_request_message);
     auto goal = std::shared_ptr<const typename ActionT::Goal>(request, &request->goal);
     goal_handle.reset(
       new ServerGoalHandle<ActionT>(
-        rcl_goal_handle, uuid, goal, on_terminal_state, on_executing, publish_feedback));
+        rcl_goal_handle, uuid, goal, on_terminal_state, on_executing, publish_feedback,
+        publish_borrowed_feedback));
     {
       std::lock_guard<std::mutex> lock(goal_handles_mutex_);
       goal_handles_[uuid] = goal_handle;
     }
-    handle_accepted_(goal_handle);
+    if (execution_pool_) {
+      AcceptedCallback handle_accepted = handle_accepted_;
+      execution_pool_->submit(
+        [handle_accepted, goal_handle]() {
+          handle_accepted(goal_handle);
+        });
+    } else {
+      handle_accepted_(goal_handle);
+    }
   }
 
   /// \internal
@@ -496,6 +649,10 @@ private:
   /// This is used to provide a goal handle to handle_cancel.
   std::unordered_map<GoalUUID, GoalHandleWeakPtr> goal_handles_;
   std::mutex goal_handles_mutex_;
+
+  /// Threads calling handle_accepted_, if any.
+  /** Declared last, so that it waits for the running goals before destroying the server. */
+  std::unique_ptr<GoalExecutionPool> execution_pool_;
 };
 }  // namespace rclcpp_action
 #endif  // RCLCPP_ACTION__SERVER_HPP_
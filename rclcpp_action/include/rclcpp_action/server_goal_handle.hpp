@@ -23,6 +23,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 
 #include "rclcpp_action/visibility_control.hpp"
 #include "rclcpp_action/types.hpp"
@@ -154,6 +155,49 @@ public:
     publish_feedback_(feedback_message);
   }
 
+  /// Borrow the feedback message of the goal, to fill it in and publish it without allocating.
+  /**
+   * The message is allocated on the first call and reused by every later call, with the goal
+   * id already set.
+   * Its content is kept between publications, so only the changed fields have to be updated.
+   * Call `ServerGoalHandle::publish_borrowed_feedback()` to publish it.
+   *
+   * The feedback of a goal must not be borrowed and published concurrently from several threads.
+   *
+   * \return the feedback to fill in, valid for the lifetime of the goal handle.
+   */
+  typename ActionT::Feedback &
+  borrow_feedback()
+  {
+    if (!feedback_message_) {
+      feedback_message_ = std::make_shared<typename ActionT::Impl::FeedbackMessage>();
+      feedback_message_->goal_id.uuid = uuid_;
+    }
+    return feedback_message_->feedback;
+  }
+
+  /// Publish the feedback filled in after `ServerGoalHandle::borrow_feedback()`.
+  /**
+   * This must only be called when the goal is executing, like
+   * `ServerGoalHandle::publish_feedback()`.
+   * The message is published in place, without any allocation or copy, except for the clients
+   * receiving it intra process, which are given a copy since the message is reused.
+   *
+   * \throws std::runtime_error If the feedback was not borrowed first.
+   */
+  void
+  publish_borrowed_feedback()
+  {
+    if (!feedback_message_) {
+      throw std::runtime_error("publish_borrowed_feedback() called before borrow_feedback()");
+    }
+    if (publish_borrowed_feedback_) {
+      publish_borrowed_feedback_(feedback_message_);
+    } else {
+      publish_feedback_(feedback_message_);
+    }
+  }
+
   /// Indicate that a goal could not be reached and has been aborted.
   /**
    * Only call this if the goal was executing but cannot be completed.
@@ -259,11 +303,14 @@ protected:
     std::shared_ptr<const typename ActionT::Goal> goal,
     std::function<void(const GoalUUID &, std::shared_ptr<void>)> on_terminal_state,
     std::function<void(const GoalUUID &)> on_executing,
-    std::function<void(std::shared_ptr<typename ActionT::Impl::FeedbackMessage>)> publish_feedback
+    std::function<void(std::shared_ptr<typename ActionT::Impl::FeedbackMessage>)> publish_feedback,
+    std::function<void(std::shared_ptr<typename ActionT::Impl::FeedbackMessage>)>
+    publish_borrowed_feedback = nullptr
   )
   : ServerGoalHandleBase(rcl_handle), goal_(goal), uuid_(uuid),
     on_terminal_state_(on_terminal_state), on_executing_(on_executing),
-    publish_feedback_(publish_feedback)
+    publish_feedback_(publish_feedback),
+    publish_borrowed_feedback_(publish_borrowed_feedback)
   {
   }
 
@@ -278,6 +325,12 @@ protected:
   std::function<void(const GoalUUID &, std::shared_ptr<void>)> on_terminal_state_;
   std::function<void(const GoalUUID &)> on_executing_;
   std::function<void(std::shared_ptr<typename ActionT::Impl::FeedbackMessage>)> publish_feedback_;
+  /// Publishes the reused feedback message, publish_feedback_ is used if empty.
+  std::function<void(std::shared_ptr<typename ActionT::Impl::FeedbackMessage>)>
+  publish_borrowed_feedback_;
+
+  /// The feedback message reused by borrow_feedback(), or null if never borrowed.
+  std::shared_ptr<typename ActionT::Impl::FeedbackMessage> feedback_message_;
 };
 }  // namespace rclcpp_action
 
@@ -21,6 +21,8 @@
 #include <action_msgs/msg/goal_info.hpp>
 
 #include <climits>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <string>
 
@@ -33,6 +35,15 @@ using GoalUUID = std::array<uint8_t, UUID_SIZE>;
 using GoalStatus = action_msgs::msg::GoalStatus;
 using GoalInfo = action_msgs::msg::GoalInfo;
 
+/// Generate a random goal id.
+/**
+ * Each thread draws from its own generator, seeded from std::random_device, so that concurrent
+ * calls neither lock nor contend.
+ */
+RCLCPP_ACTION_PUBLIC
+GoalUUID
+generate_goal_uuid();
+
 /// Convert a goal id to a human readable string.
 RCLCPP_ACTION_PUBLIC
 std::string
@@ -68,16 +79,13 @@ struct hash<rclcpp_action::GoalUUID>
 {
   size_t operator()(const rclcpp_action::GoalUUID & uuid) const noexcept
   {
-    // TODO(sloretz) Use someone else's hash function and cite it
-    size_t result = 0;
-    for (size_t i = 0; i < uuid.size(); ++i) {
-      for (size_t b = 0; b < sizeof(size_t); ++b) {
-        size_t part = uuid[i];
-        part <<= CHAR_BIT * b;
-        result ^= part;
-      }
-    }
-    return result;
+    // The goal ids are random, so mixing their two halves is enough to spread them.
+    // The upper half is multiplied by the 64 bit golden ratio, for the halves not to cancel out.
+    static_assert(sizeof(rclcpp_action::GoalUUID) == 2 * sizeof(uint64_t), "unexpected size");
+    uint64_t words[2];
+    std::memcpy(words, uuid.data(), sizeof(words));
+    uint64_t result = words[0] ^ (words[1] * 0x9e3779b97f4a7c15ULL);
+    return static_cast<size_t>(result ^ (result >> 32));
   }
 };
 }  // namespace std
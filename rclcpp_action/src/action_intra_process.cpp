@@ -0,0 +1,95 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "rclcpp_action/action_intra_process.hpp"
+
+namespace rclcpp_action
+{
+
+ActionIntraProcess::ActionIntraProcess(
+  rclcpp::Context::SharedPtr context,
+  const std::string & name,
+  const rosidl_action_type_support_t * type_support,
+  MessageHandler message_handler)
+: ServiceIntraProcessBase(std::move(context), name),
+  type_support_(type_support),
+  message_handler_(std::move(message_handler))
+{
+}
+
+ActionIntraProcess::~ActionIntraProcess()
+{
+}
+
+std::string
+ActionIntraProcess::get_server_queue_name(const std::string & action_name)
+{
+  return action_name + "/_action";
+}
+
+const rosidl_action_type_support_t *
+ActionIntraProcess::get_type_support() const
+{
+  return type_support_;
+}
+
+void
+ActionIntraProcess::push(Message message)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages_.push_back(std::move(message));
+  }
+  notify_new_request();
+}
+
+bool
+ActionIntraProcess::is_ready(rcl_wait_set_t * wait_set)
+{
+  (void)wait_set;
+  std::lock_guard<std::mutex> lock(mutex_);
+  return !messages_.empty();
+}
+
+std::shared_ptr<void>
+ActionIntraProcess::take_data()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (messages_.empty()) {
+    return nullptr;
+  }
+  auto message = std::make_shared<Message>(std::move(messages_.front()));
+  messages_.pop_front();
+  if (!messages_.empty()) {
+    trigger_guard_condition();
+  }
+  return message;
+}
+
+void
+ActionIntraProcess::execute(std::shared_ptr<void> & data)
+{
+  if (!data) {
+    return;
+  }
+  auto message = std::static_pointer_cast<Message>(data);
+  message_handler_(*message);
+}
+
+}  // namespace rclcpp_action
@@ -14,15 +14,18 @@
 
 #include <rcl_action/action_client.h>
 #include <rcl_action/wait.h>
+#include <rclcpp/detail/fast_exit.hpp>
+#include <rclcpp/detail/pending_requests_table.hpp>
+#include <rclcpp/detail/taken_data_slot.hpp>
+#include <rclcpp/experimental/intra_process_manager.hpp>
 #include <rclcpp/node_interfaces/node_base_interface.hpp>
 #include <rclcpp/node_interfaces/node_logging_interface.hpp>
 
 #include <algorithm>
-#include <map>
+#include <atomic>
 #include <memory>
-#include <random>
+#include <optional>  // NOLINT, cpplint doesn't think this is a cpp std header
 #include <string>
-#include <tuple>
 #include <utility>
 
 #include "rclcpp_action/client.hpp"
@@ -31,6 +34,15 @@
 namespace rclcpp_action
 {
 
+// Data taken by the action client for an event, see ClientBase::take_data().
+struct ClientTakenData
+{
+  rcl_ret_t ret = RCL_RET_OK;
+  rmw_request_id_t response_header{};
+  // The feedback, status or response, given to the user.
+  std::shared_ptr<void> message;
+};
+
 class ClientBaseImpl
 {
 public:
@@ -43,14 +55,17 @@ public:
     const rcl_action_client_options_t & client_options)
   : node_graph_(node_graph),
     node_handle(node_base->get_shared_rcl_node_handle()),
-    logger(node_logging->get_logger().get_child("rclcpp_action")),
-    random_bytes_generator(std::random_device{} ())
+    logger(node_logging->get_logger().get_child("rclcpp_action"))
   {
     std::weak_ptr<rcl_node_t> weak_node_handle(node_handle);
     client_handle = std::shared_ptr<rcl_action_client_t>(
       new rcl_action_client_t, [weak_node_handle](rcl_action_client_t * client)
       {
         auto handle = weak_node_handle.lock();
+        if (rclcpp::detail::skip_entity_finalization(handle.get())) {
+          delete client;
+          return;
+        }
         if (handle) {
           if (RCL_RET_OK != rcl_action_client_fini(client, handle.get())) {
             RCLCPP_ERROR(
@@ -86,6 +101,48 @@ public:
       rclcpp::exceptions::throw_from_rcl_error(
         ret, "could not retrieve rcl action client details");
     }
+
+    if (node_base->get_use_intra_process_default()) {
+      auto context = node_base->get_context();
+      weak_ipm = context->get_sub_context<rclcpp::experimental::IntraProcessManager>();
+      intra_process_server_name = ActionIntraProcess::get_server_queue_name(
+        rcl_action_client_get_action_name(client_handle.get()));
+      action_type_support = type_support;
+    }
+  }
+
+  // Return the queue of the server if it is in the same context, nullptr otherwise
+  ActionIntraProcess::SharedPtr
+  get_intra_process_server() const
+  {
+    if (!intra_process_queue) {
+      return nullptr;
+    }
+    auto ipm = weak_ipm.lock();
+    if (!ipm) {
+      return nullptr;
+    }
+    auto server = std::dynamic_pointer_cast<ActionIntraProcess>(
+      ipm->get_service_intra_process(intra_process_server_name));
+    if (!server || server->get_type_support() != action_type_support) {
+      return nullptr;
+    }
+    return server;
+  }
+
+  // Return a callback queueing a response in the queue of the client, for the callback given
+  // by the user to be called by the executor of the client
+  ActionIntraProcess::ResponseCallback
+  make_intra_process_response_callback(
+    ActionIntraProcess::MessageType type, ActionIntraProcess::ResponseCallback callback) const
+  {
+    std::weak_ptr<ActionIntraProcess> weak_queue = intra_process_queue;
+    return [weak_queue, type, callback](std::shared_ptr<void> response) {
+             auto queue = weak_queue.lock();
+             if (queue) {
+               queue->push({type, std::move(response), callback, {}});
+             }
+           };
   }
 
   size_t num_subscriptions{0u};
@@ -99,6 +156,9 @@ public:
   bool is_goal_response_ready{false};
   bool is_cancel_response_ready{false};
   bool is_result_response_ready{false};
+  std::atomic<bool> is_intra_process_message_ready{false};
+
+  rclcpp::detail::TakenDataSlot<ClientTakenData> taken_data;
 
   rclcpp::Context::SharedPtr context_;
   rclcpp::node_interfaces::NodeGraphInterface::WeakPtr node_graph_;
@@ -109,17 +169,22 @@ public:
 
   using ResponseCallback = std::function<void (std::shared_ptr<void> response)>;
 
-  std::map<int64_t, ResponseCallback> pending_goal_responses;
+  // The requests of each service are indexed by their monotonic sequence number.
+  rclcpp::detail::PendingRequestsTable<ResponseCallback> pending_goal_responses;
   std::mutex goal_requests_mutex;
 
-  std::map<int64_t, ResponseCallback> pending_result_responses;
+  rclcpp::detail::PendingRequestsTable<ResponseCallback> pending_result_responses;
   std::mutex result_requests_mutex;
 
-  std::map<int64_t, ResponseCallback> pending_cancel_responses;
+  rclcpp::detail::PendingRequestsTable<ResponseCallback> pending_cancel_responses;
   std::mutex cancel_requests_mutex;
 
-  std::independent_bits_engine<
-    std::default_random_engine, 8, unsigned int> random_bytes_generator;
+  // Responses, feedback and status of a server of the same context, if intra process
+  // communication is enabled
+  ActionIntraProcess::SharedPtr intra_process_queue;
+  std::weak_ptr<rclcpp::experimental::IntraProcessManager> weak_ipm;
+  std::string intra_process_server_name;
+  const rosidl_action_type_support_t * action_type_support{nullptr};
 };
 
 ClientBase::ClientBase(
@@ -132,6 +197,16 @@ ClientBase::ClientBase(
 : pimpl_(new ClientBaseImpl(
       node_base, node_graph, node_logging, action_name, type_support, client_options))
 {
+  if (node_base->get_use_intra_process_default()) {
+    pimpl_->intra_process_queue = std::make_shared<ActionIntraProcess>(
+      node_base->get_context(),
+      rcl_action_client_get_action_name(pimpl_->client_handle.get()),
+      type_support,
+      [this](ActionIntraProcess::Message & message) {
+        execute_intra_process_message(message);
+      });
+    ++pimpl_->num_guard_conditions;
+  }
 }
 
 ClientBase::~ClientBase()
@@ -177,6 +252,10 @@ ClientBase::wait_for_action_server_nanoseconds(std::chrono::nanoseconds timeout)
     // check was non-blocking, return immediately
     return false;
   }
+  // The action server is waited for through its goal service.
+  const std::string send_goal_service_name =
+    std::string(rcl_action_client_get_action_name(pimpl_->client_handle.get())) +
+    "/_action/send_goal";
   // update the time even on the first loop to account for time spent in the first call
   // to this->server_is_ready()
   std::chrono::nanoseconds time_to_wait =
@@ -192,6 +271,7 @@ ClientBase::wait_for_action_server_nanoseconds(std::chrono::nanoseconds timeout)
     if (!rclcpp::ok(this->pimpl_->context_)) {
       return false;
     }
+    // Only the graph changes listing the server wake this up, not every graph change.
     // Limit each wait to 100ms to workaround an issue specific to the Connext RMW implementation.
     // A race condition means that graph changes for services becoming available may trigger the
     // wait set to wake up, but then not be reported as ready immediately after the wake up
@@ -199,11 +279,11 @@ ClientBase::wait_for_action_server_nanoseconds(std::chrono::nanoseconds timeout)
     // If no other graph events occur, the wait set will not be triggered again until the timeout
     // has been reached, despite the service being available, so we artificially limit the wait
     // time to limit the delay.
-    node_ptr->wait_for_graph_change(
-      event, std::min(time_to_wait, std::chrono::nanoseconds(RCL_MS_TO_NS(100))));
+    node_ptr->wait_for_service_server(
+      event, send_goal_service_name,
+      std::min(time_to_wait, std::chrono::nanoseconds(RCL_MS_TO_NS(100))));
     // Because of the aforementioned race condition, we check if the service is ready even if the
-    // graph event wasn't triggered.
-    event->check_and_clear();
+    // server was not listed.
     if (this->action_server_is_ready()) {
       return true;
     }
@@ -257,6 +337,9 @@ ClientBase::add_to_wait_set(rcl_wait_set_t * wait_set)
 {
   rcl_ret_t ret = rcl_action_wait_set_add_action_client(
     wait_set, pimpl_->client_handle.get(), nullptr, nullptr);
+  if (RCL_RET_OK == ret && pimpl_->intra_process_queue) {
+    return pimpl_->intra_process_queue->add_to_wait_set(wait_set);
+  }
   return RCL_RET_OK == ret;
 }
 
@@ -274,7 +357,10 @@ ClientBase::is_ready(rcl_wait_set_t * wait_set)
     rclcpp::exceptions::throw_from_rcl_error(
       ret, "failed to check for any ready entities");
   }
+  pimpl_->is_intra_process_message_ready = pimpl_->intra_process_queue &&
+    pimpl_->intra_process_queue->is_ready(wait_set);
   return
+    pimpl_->is_intra_process_message_ready.load() ||
     pimpl_->is_feedback_ready ||
     pimpl_->is_status_ready ||
     pimpl_->is_goal_response_ready ||
@@ -287,19 +373,30 @@ ClientBase::handle_goal_response(
   const rmw_request_id_t & response_header,
   std::shared_ptr<void> response)
 {
-  std::lock_guard<std::mutex> guard(pimpl_->goal_requests_mutex);
-  const int64_t & sequence_number = response_header.sequence_number;
-  if (pimpl_->pending_goal_responses.count(sequence_number) == 0) {
+  std::optional<ResponseCallback> callback;
+  {
+    std::lock_guard<std::mutex> guard(pimpl_->goal_requests_mutex);
+    callback = pimpl_->pending_goal_responses.take(response_header.sequence_number);
+  }
+  if (!callback) {
     RCLCPP_ERROR(pimpl_->logger, "unknown goal response, ignoring...");
     return;
   }
-  pimpl_->pending_goal_responses[sequence_number](response);
-  pimpl_->pending_goal_responses.erase(sequence_number);
+  (*callback)(response);
 }
 
 void
 ClientBase::send_goal_request(std::shared_ptr<void> request, ResponseCallback callback)
 {
+  auto server = pimpl_->get_intra_process_server();
+  if (server) {
+    server->push(
+      {ActionIntraProcess::MessageType::GoalRequest, std::move(request),
+      pimpl_->make_intra_process_response_callback(
+        ActionIntraProcess::MessageType::GoalResponse, std::move(callback)),
+      pimpl_->intra_process_queue});
+    return;
+  }
   std::unique_lock<std::mutex> guard(pimpl_->goal_requests_mutex);
   int64_t sequence_number;
   rcl_ret_t ret = rcl_action_send_goal_request(
@@ -307,8 +404,11 @@ ClientBase::send_goal_request(std::shared_ptr<void> request, ResponseCallback ca
   if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret, "failed to send goal request");
   }
-  assert(pimpl_->pending_goal_responses.count(sequence_number) == 0);
-  pimpl_->pending_goal_responses[sequence_number] = callback;
+  bool inserted = pimpl_->pending_goal_responses.insert(
+    sequence_number, rclcpp::detail::PendingRequestsTable<ResponseCallback>::TimePoint(),
+    std::move(callback));
+  assert(inserted);
+  (void)inserted;
 }
 
 void
@@ -316,19 +416,30 @@ ClientBase::handle_result_response(
   const rmw_request_id_t & response_header,
   std::shared_ptr<void> response)
 {
-  std::lock_guard<std::mutex> guard(pimpl_->result_requests_mutex);
-  const int64_t & sequence_number = response_header.sequence_number;
-  if (pimpl_->pending_result_responses.count(sequence_number) == 0) {
+  std::optional<ResponseCallback> callback;
+  {
+    std::lock_guard<std::mutex> guard(pimpl_->result_requests_mutex);
+    callback = pimpl_->pending_result_responses.take(response_header.sequence_number);
+  }
+  if (!callback) {
     RCLCPP_ERROR(pimpl_->logger, "unknown result response, ignoring...");
     return;
   }
-  pimpl_->pending_result_responses[sequence_number](response);
-  pimpl_->pending_result_responses.erase(sequence_number);
+  (*callback)(response);
 }
 
 void
 ClientBase::send_result_request(std::shared_ptr<void> request, ResponseCallback callback)
 {
+  auto server = pimpl_->get_intra_process_server();
+  if (server) {
+    server->push(
+      {ActionIntraProcess::MessageType::ResultRequest, std::move(request),
+      pimpl_->make_intra_process_response_callback(
+        ActionIntraProcess::MessageType::ResultResponse, std::move(callback)),
+      {}});
+    return;
+  }
   std::lock_guard<std::mutex> guard(pimpl_->result_requests_mutex);
   int64_t sequence_number;
   rcl_ret_t ret = rcl_action_send_result_request(
@@ -336,8 +447,11 @@ ClientBase::send_result_request(std::shared_ptr<void> request, ResponseCallback
   if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret, "failed to send result request");
   }
-  assert(pimpl_->pending_result_responses.count(sequence_number) == 0);
-  pimpl_->pending_result_responses[sequence_number] = callback;
+  bool inserted = pimpl_->pending_result_responses.insert(
+    sequence_number, rclcpp::detail::PendingRequestsTable<ResponseCallback>::TimePoint(),
+    std::move(callback));
+  assert(inserted);
+  (void)inserted;
 }
 
 void
@@ -345,19 +459,30 @@ ClientBase::handle_cancel_response(
   const rmw_request_id_t & response_header,
   std::shared_ptr<void> response)
 {
-  std::lock_guard<std::mutex> guard(pimpl_->cancel_requests_mutex);
-  const int64_t & sequence_number = response_header.sequence_number;
-  if (pimpl_->pending_cancel_responses.count(sequence_number) == 0) {
+  std::optional<ResponseCallback> callback;
+  {
+    std::lock_guard<std::mutex> guard(pimpl_->cancel_requests_mutex);
+    callback = pimpl_->pending_cancel_responses.take(response_header.sequence_number);
+  }
+  if (!callback) {
     RCLCPP_ERROR(pimpl_->logger, "unknown cancel response, ignoring...");
     return;
   }
-  pimpl_->pending_cancel_responses[sequence_number](response);
-  pimpl_->pending_cancel_responses.erase(sequence_number);
+  (*callback)(response);
 }
 
 void
 ClientBase::send_cancel_request(std::shared_ptr<void> request, ResponseCallback callback)
 {
+  auto server = pimpl_->get_intra_process_server();
+  if (server) {
+    server->push(
+      {ActionIntraProcess::MessageType::CancelRequest, std::move(request),
+      pimpl_->make_intra_process_response_callback(
+        ActionIntraProcess::MessageType::CancelResponse, std::move(callback)),
+      {}});
+    return;
+  }
   std::lock_guard<std::mutex> guard(pimpl_->cancel_requests_mutex);
   int64_t sequence_number;
   rcl_ret_t ret = rcl_action_send_cancel_request(
@@ -365,65 +490,54 @@ ClientBase::send_cancel_request(std::shared_ptr<void> request, ResponseCallback
   if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret, "failed to send cancel request");
   }
-  assert(pimpl_->pending_cancel_responses.count(sequence_number) == 0);
-  pimpl_->pending_cancel_responses[sequence_number] = callback;
+  bool inserted = pimpl_->pending_cancel_responses.insert(
+    sequence_number, rclcpp::detail::PendingRequestsTable<ResponseCallback>::TimePoint(),
+    std::move(callback));
+  assert(inserted);
+  (void)inserted;
 }
 
 GoalUUID
 ClientBase::generate_goal_id()
 {
-  GoalUUID goal_id;
-  // TODO(hidmic): Do something better than this for UUID generation.
-  // std::generate(
-  //   goal_id.uuid.begin(), goal_id.uuid.end(),
-  //   std::ref(pimpl_->random_bytes_generator));
-  std::generate(
-    goal_id.begin(), goal_id.end(),
-    std::ref(pimpl_->random_bytes_generator));
-  return goal_id;
+  return generate_goal_uuid();
 }
 
 std::shared_ptr<void>
 ClientBase::take_data()
 {
-  if (pimpl_->is_feedback_ready) {
-    std::shared_ptr<void> feedback_message = this->create_feedback_message();
-    rcl_ret_t ret = rcl_action_take_feedback(
-      pimpl_->client_handle.get(), feedback_message.get());
-    return std::static_pointer_cast<void>(
-      std::make_shared<std::tuple<rcl_ret_t, std::shared_ptr<void>>>(
-        ret, feedback_message));
+  if (pimpl_->is_intra_process_message_ready.load()) {
+    return pimpl_->intra_process_queue->take_data();
+  } else if (pimpl_->is_feedback_ready) {
+    auto data = pimpl_->taken_data.acquire();
+    data->message = this->create_feedback_message();
+    data->ret = rcl_action_take_feedback(
+      pimpl_->client_handle.get(), data->message.get());
+    return data;
   } else if (pimpl_->is_status_ready) {
-    std::shared_ptr<void> status_message = this->create_status_message();
-    rcl_ret_t ret = rcl_action_take_status(
-      pimpl_->client_handle.get(), status_message.get());
-    return std::static_pointer_cast<void>(
-      std::make_shared<std::tuple<rcl_ret_t, std::shared_ptr<void>>>(
-        ret, status_message));
+    auto data = pimpl_->taken_data.acquire();
+    data->message = this->create_status_message();
+    data->ret = rcl_action_take_status(
+      pimpl_->client_handle.get(), data->message.get());
+    return data;
   } else if (pimpl_->is_goal_response_ready) {
-    rmw_request_id_t response_header;
-    std::shared_ptr<void> goal_response = this->create_goal_response();
-    rcl_ret_t ret = rcl_action_take_goal_response(
-      pimpl_->client_handle.get(), &response_header, goal_response.get());
-    return std::static_pointer_cast<void>(
-      std::make_shared<std::tuple<rcl_ret_t, rmw_request_id_t, std::shared_ptr<void>>>(
-        ret, response_header, goal_response));
+    auto data = pimpl_->taken_data.acquire();
+    data->message = this->create_goal_response();
+    data->ret = rcl_action_take_goal_response(
+      pimpl_->client_handle.get(), &data->response_header, data->message.get());
+    return data;
   } else if (pimpl_->is_result_response_ready) {
-    rmw_request_id_t response_header;
-    std::shared_ptr<void> result_response = this->create_result_response();
-    rcl_ret_t ret = rcl_action_take_result_response(
-      pimpl_->client_handle.get(), &response_header, result_response.get());
-    return std::static_pointer_cast<void>(
-      std::make_shared<std::tuple<rcl_ret_t, rmw_request_id_t, std::shared_ptr<void>>>(
-        ret, response_header, result_response));
+    auto data = pimpl_->taken_data.acquire();
+    data->message = this->create_result_response();
+    data->ret = rcl_action_take_result_response(
+      pimpl_->client_handle.get(), &data->response_header, data->message.get());
+    return data;
   } else if (pimpl_->is_cancel_response_ready) {
-    rmw_request_id_t response_header;
-    std::shared_ptr<void> cancel_response = this->create_cancel_response();
-    rcl_ret_t ret = rcl_action_take_cancel_response(
-      pimpl_->client_handle.get(), &response_header, cancel_response.get());
-    return std::static_pointer_cast<void>(
-      std::make_shared<std::tuple<rcl_ret_t, rmw_request_id_t, std::shared_ptr<void>>>(
-        ret, response_header, cancel_response));
+    auto data = pimpl_->taken_data.acquire();
+    data->message = this->create_cancel_response();
+    data->ret = rcl_action_take_cancel_response(
+      pimpl_->client_handle.get(), &data->response_header, data->message.get());
+    return data;
   } else {
     throw std::runtime_error("Taking data from action client but nothing is ready");
   }
@@ -432,63 +546,54 @@ ClientBase::take_data()
 void
 ClientBase::execute(std::shared_ptr<void> & data)
 {
+  if (pimpl_->is_intra_process_message_ready.load()) {
+    pimpl_->is_intra_process_message_ready = false;
+    // Empty if another thread took the last message meanwhile.
+    pimpl_->intra_process_queue->execute(data);
+    return;
+  }
+
   if (!data) {
     throw std::runtime_error("'data' is empty");
   }
 
+  auto taken_data = std::static_pointer_cast<ClientTakenData>(data);
+  const rcl_ret_t ret = taken_data->ret;
+  // Moved out, so that the reused storage does not keep the message.
+  std::shared_ptr<void> message = std::move(taken_data->message);
   if (pimpl_->is_feedback_ready) {
-    auto shared_ptr = std::static_pointer_cast<std::tuple<rcl_ret_t, std::shared_ptr<void>>>(data);
-    auto ret = std::get<0>(*shared_ptr);
     pimpl_->is_feedback_ready = false;
-    if (RCL_RET_OK == ret) {
-      auto feedback_message = std::get<1>(*shared_ptr);
-      this->handle_feedback_message(feedback_message);
+    // Received intra process from a server of the same context.
+    if (RCL_RET_OK == ret && !pimpl_->get_intra_process_server()) {
+      this->handle_feedback_message(message);
     } else if (RCL_RET_ACTION_CLIENT_TAKE_FAILED != ret) {
       rclcpp::exceptions::throw_from_rcl_error(ret, "error taking feedback");
     }
   } else if (pimpl_->is_status_ready) {
-    auto shared_ptr = std::static_pointer_cast<std::tuple<rcl_ret_t, std::shared_ptr<void>>>(data);
-    auto ret = std::get<0>(*shared_ptr);
     pimpl_->is_status_ready = false;
-    if (RCL_RET_OK == ret) {
-      auto status_message = std::get<1>(*shared_ptr);
-      this->handle_status_message(status_message);
+    if (RCL_RET_OK == ret && !pimpl_->get_intra_process_server()) {
+      this->handle_status_message(message);
     } else if (RCL_RET_ACTION_CLIENT_TAKE_FAILED != ret) {
       rclcpp::exceptions::throw_from_rcl_error(ret, "error taking status");
     }
   } else if (pimpl_->is_goal_response_ready) {
-    auto shared_ptr = std::static_pointer_cast<
-      std::tuple<rcl_ret_t, rmw_request_id_t, std::shared_ptr<void>>>(data);
-    auto ret = std::get<0>(*shared_ptr);
     pimpl_->is_goal_response_ready = false;
     if (RCL_RET_OK == ret) {
-      auto response_header = std::get<1>(*shared_ptr);
-      auto goal_response = std::get<2>(*shared_ptr);
-      this->handle_goal_response(response_header, goal_response);
+      this->handle_goal_response(taken_data->response_header, message);
     } else if (RCL_RET_ACTION_CLIENT_TAKE_FAILED != ret) {
       rclcpp::exceptions::throw_from_rcl_error(ret, "error taking goal response");
     }
   } else if (pimpl_->is_result_response_ready) {
-    auto shared_ptr = std::static_pointer_cast<
-      std::tuple<rcl_ret_t, rmw_request_id_t, std::shared_ptr<void>>>(data);
-    auto ret = std::get<0>(*shared_ptr);
     pimpl_->is_result_response_ready = false;
     if (RCL_RET_OK == ret) {
-      auto response_header = std::get<1>(*shared_ptr);
-      auto result_response = std::get<2>(*shared_ptr);
-      this->handle_result_response(response_header, result_response);
+      this->handle_result_response(taken_data->response_header, message);
     } else if (RCL_RET_ACTION_CLIENT_TAKE_FAILED != ret) {
       rclcpp::exceptions::throw_from_rcl_error(ret, "error taking result response");
     }
   } else if (pimpl_->is_cancel_response_ready) {
-    auto shared_ptr = std::static_pointer_cast<
-      std::tuple<rcl_ret_t, rmw_request_id_t, std::shared_ptr<void>>>(data);
-    auto ret = std::get<0>(*shared_ptr);
     pimpl_->is_cancel_response_ready = false;
     if (RCL_RET_OK == ret) {
-      auto response_header = std::get<1>(*shared_ptr);
-      auto cancel_response = std::get<2>(*shared_ptr);
-      this->handle_cancel_response(response_header, cancel_response);
+      this->handle_cancel_response(taken_data->response_header, message);
     } else if (RCL_RET_ACTION_CLIENT_TAKE_FAILED != ret) {
       rclcpp::exceptions::throw_from_rcl_error(ret, "error taking cancel response");
     }
@@ -497,4 +602,25 @@ ClientBase::execute(std::shared_ptr<void> & data)
   }
 }
 
+void
+ClientBase::execute_intra_process_message(ActionIntraProcess::Message & message)
+{
+  using MessageType = ActionIntraProcess::MessageType;
+  switch (message.type) {
+    case MessageType::GoalResponse:
+    case MessageType::CancelResponse:
+    case MessageType::ResultResponse:
+      message.response_callback(std::move(message.message));
+      break;
+    case MessageType::Feedback:
+      this->handle_feedback_message(std::move(message.message));
+      break;
+    case MessageType::Status:
+      this->handle_status_message(std::move(message.message));
+      break;
+    default:
+      throw std::runtime_error("action client received an intra process request");
+  }
+}
+
 }  // namespace rclcpp_action
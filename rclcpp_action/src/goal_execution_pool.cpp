@@ -0,0 +1,123 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <rclcpp/logging.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "rclcpp_action/goal_execution_pool.hpp"
+
+namespace rclcpp_action
+{
+
+struct GoalExecutionPool::State
+{
+  mutable std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<std::function<void()>> queue;
+  size_t num_running = 0;
+  bool stopped = false;
+};
+
+void
+GoalExecutionPool::run_goals(std::shared_ptr<State> state)
+{
+  std::unique_lock<std::mutex> lock(state->mutex);
+  while (true) {
+    state->condition.wait(lock, [&state]() {return state->stopped || !state->queue.empty();});
+    if (state->stopped) {
+      return;
+    }
+    std::function<void()> goal = std::move(state->queue.front());
+    state->queue.pop_front();
+    ++state->num_running;
+    lock.unlock();
+    try {
+      goal();
+    } catch (const std::exception & ex) {
+      RCLCPP_ERROR(
+        rclcpp::get_logger("rclcpp_action"), "Exception thrown by a goal execution: %s",
+        ex.what());
+    }
+    // Destroy the captures of the goal, such as its goal handle, before counting it done
+    goal = nullptr;
+    lock.lock();
+    --state->num_running;
+  }
+}
+
+GoalExecutionPool::GoalExecutionPool(const GoalExecutionOptions & options)
+: options_(options), state_(std::make_shared<State>())
+{
+  if (0u == options.max_concurrent_goals) {
+    throw std::invalid_argument("a goal execution pool needs at least one thread");
+  }
+  threads_.reserve(options.max_concurrent_goals);
+  for (size_t i = 0; i < options.max_concurrent_goals; ++i) {
+    threads_.emplace_back(run_goals, state_);
+  }
+}
+
+GoalExecutionPool::~GoalExecutionPool()
+{
+  std::deque<std::function<void()>> dropped_goals;
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->stopped = true;
+    dropped_goals.swap(state_->queue);
+  }
+  state_->condition.notify_all();
+  for (std::thread & thread : threads_) {
+    if (thread.get_id() == std::this_thread::get_id()) {
+      thread.detach();
+    } else {
+      thread.join();
+    }
+  }
+}
+
+bool
+GoalExecutionPool::is_full() const
+{
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->queue.size() + state_->num_running >=
+         options_.max_concurrent_goals + options_.max_queued_goals;
+}
+
+void
+GoalExecutionPool::submit(std::function<void()> goal)
+{
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->queue.push_back(std::move(goal));
+  }
+  state_->condition.notify_one();
+}
+
+size_t
+GoalExecutionPool::size() const
+{
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return state_->queue.size() + state_->num_running;
+}
+
+}  // namespace rclcpp_action
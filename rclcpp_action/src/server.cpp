@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <rcl/graph.h>
 #include <rcl_action/action_server.h>
 #include <rcl_action/wait.h>
 
@@ -19,13 +20,21 @@
 
 #include <action_msgs/msg/goal_status_array.hpp>
 #include <action_msgs/srv/cancel_goal.hpp>
+#include <rclcpp/detail/fast_exit.hpp>
+#include <rclcpp/detail/taken_data_slot.hpp>
 #include <rclcpp/exceptions.hpp>
+#include <rclcpp/experimental/intra_process_manager.hpp>
+#include <rclcpp/guard_condition.hpp>
+#include <rclcpp/timer.hpp>
 #include <rclcpp_action/server.hpp>
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <queue>
 #include <string>
-#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -35,20 +44,118 @@ using rclcpp_action::GoalUUID;
 
 namespace rclcpp_action
 {
+// State of an accepted goal, kept until the goal expires
+struct ServerGoalState
+{
+  // Lock for the members below
+  std::mutex mutex;
+  // rcl goal handle is kept so api to send result doesn't try to access freed memory
+  std::shared_ptr<rcl_action_goal_handle_t> rcl_handle;
+  // Result to be kept until the goal expires after reaching a terminal state
+  std::shared_ptr<void> result;
+  // Requests for the result are kept until it becomes available
+  std::vector<rmw_request_id_t> result_requests;
+  // Same for the requests sent intra process, by their response callback
+  std::vector<ActionIntraProcess::ResponseCallback> intra_process_result_requests;
+};
+
+// States of the goals by goal id, split into shards so that different goals seldom contend
+class ServerGoalStates
+{
+public:
+  std::shared_ptr<ServerGoalState>
+  find(const GoalUUID & uuid)
+  {
+    Shard & shard = get_shard(uuid);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.states.find(uuid);
+    return iter != shard.states.end() ? iter->second : nullptr;
+  }
+
+  void
+  insert(const GoalUUID & uuid, std::shared_ptr<ServerGoalState> state)
+  {
+    Shard & shard = get_shard(uuid);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.states[uuid] = std::move(state);
+  }
+
+  void
+  erase(const GoalUUID & uuid)
+  {
+    // Declared first so the state, and its rcl goal handle, are destroyed once unlocked
+    std::shared_ptr<ServerGoalState> state;
+    Shard & shard = get_shard(uuid);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto iter = shard.states.find(uuid);
+    if (iter != shard.states.end()) {
+      state = std::move(iter->second);
+      shard.states.erase(iter);
+    }
+  }
+
+private:
+  struct Shard
+  {
+    std::mutex mutex;
+    std::unordered_map<GoalUUID, std::shared_ptr<ServerGoalState>> states;
+  };
+
+  static constexpr size_t kNumberOfShards = 16u;
+
+  Shard &
+  get_shard(const GoalUUID & uuid)
+  {
+    return shards_[std::hash<GoalUUID>()(uuid) % kNumberOfShards];
+  }
+
+  std::array<Shard, kNumberOfShards> shards_;
+};
+
+// Data taken by the action server for an event, see ServerBase::take_data().
+struct ServerTakenData
+{
+  rcl_ret_t ret = RCL_RET_OK;
+  rmw_request_id_t request_header{};
+  // The goal or result request, given to the user.
+  std::shared_ptr<void> request;
+  // Kept in the reused storage, since it does not outlive the event.
+  action_msgs::srv::CancelGoal::Request cancel_request;
+};
+
 class ServerBaseImpl
 {
 public:
   ServerBaseImpl(
     rclcpp::Clock::SharedPtr clock,
-    rclcpp::Logger logger
+    rclcpp::Logger logger,
+    const GoalStatusPublishingOptions & status_options
   )
-  : clock_(clock), logger_(logger)
+  : clock_(clock), logger_(logger), status_options_(status_options)
+  {
+  }
+
+  // Return the number of goals due to expire, removed from the expiry heap.
+  // action_server_reentrant_mutex_ must be locked.
+  size_t
+  pop_expired_goals()
   {
+    const rcl_time_point_value_t now = clock_->now().nanoseconds();
+    size_t num_expired = 0;
+    while (!expiry_heap_.empty() && expiry_heap_.top() <= now) {
+      expiry_heap_.pop();
+      ++num_expired;
+    }
+    return num_expired;
   }
 
-  // Lock for action_server_
+  // Lock for the goals of action_server_ and the requests of its services.
+  // Publishing feedback and sending result responses do not take it, they only use a publisher and
+  // a service of action_server_, whose rmw entities are thread-safe.
   std::recursive_mutex action_server_reentrant_mutex_;
 
+  rclcpp::detail::TakenDataSlot<ServerTakenData> taken_data_;
+
   rclcpp::Clock::SharedPtr clock_;
 
   // Do not declare this before clock_ as this depends on clock_(see #1526)
@@ -65,17 +172,118 @@ public:
   std::atomic<bool> result_request_ready_{false};
   std::atomic<bool> goal_expired_{false};
 
-  // Lock for unordered_maps
-  std::recursive_mutex unordered_map_mutex_;
+  std::atomic<bool> intra_process_message_ready_{false};
 
-  // Results to be kept until the goal expires after reaching a terminal state
-  std::unordered_map<GoalUUID, std::shared_ptr<void>> goal_results_;
-  // Requests for results are kept until a result becomes available
-  std::unordered_map<GoalUUID, std::vector<rmw_request_id_t>> result_requests_;
-  // rcl goal handles are kept so api to send result doesn't try to access freed memory
-  std::unordered_map<GoalUUID, std::shared_ptr<rcl_action_goal_handle_t>> goal_handles_;
+  // How long a goal is kept after reaching a terminal state, negative if forever
+  rcl_duration_value_t result_timeout_ = 0;
+  // Expiry times of the terminal goals, the soonest first, guarded by
+  // action_server_reentrant_mutex_
+  std::priority_queue<
+    rcl_time_point_value_t, std::vector<rcl_time_point_value_t>,
+    std::greater<rcl_time_point_value_t>> expiry_heap_;
+
+  ServerGoalStates goal_states_;
 
   rclcpp::Logger logger_;
+
+  // Remove the entry of a goal from status_msg_, status_mutex_ must be locked
+  void
+  remove_goal_status(const GoalUUID & uuid)
+  {
+    auto iter = status_indices_.find(uuid);
+    if (iter == status_indices_.end()) {
+      return;
+    }
+    const size_t index = iter->second;
+    status_indices_.erase(iter);
+    // The order of the goals in the status message does not matter, move the last one here.
+    auto & status_list = status_msg_.status_list;
+    if (index + 1u != status_list.size()) {
+      status_list[index] = status_list.back();
+      status_indices_[status_list[index].goal_info.goal_id.uuid] = index;
+    }
+    status_list.pop_back();
+  }
+
+  const GoalStatusPublishingOptions status_options_;
+
+  // Lock for the incremental status message, taken before action_server_reentrant_mutex_
+  std::mutex status_mutex_;
+  // Status message reused by the incremental publishing, and index of the entry of each goal
+  action_msgs::msg::GoalStatusArray status_msg_;
+  std::unordered_map<GoalUUID, size_t> status_indices_;
+  // Goals reported terminal by the pending status message, to be skipped afterwards
+  std::vector<GoalUUID> terminal_goals_;
+  // True if a goal changed state since the last status message
+  bool status_pending_ = false;
+
+  // Timer publishing the pending status at the end of the coalescing period, if coalescing
+  rclcpp::TimerBase::SharedPtr status_timer_;
+  // Wakes the wait set up when the status timer is started, it may be waiting without it
+  std::shared_ptr<rclcpp::GuardCondition> status_timer_started_guard_condition_;
+  // True while the status timer runs, guarded by status_mutex_
+  bool status_timer_running_ = false;
+  size_t status_timer_index_ = 0;
+  std::atomic<bool> status_timer_ready_{false};
+
+  // Requests of the clients of the same context, if intra process communication is enabled
+  ActionIntraProcess::SharedPtr intra_process_queue_;
+  std::weak_ptr<rclcpp::experimental::IntraProcessManager> weak_ipm_;
+  uint64_t intra_process_queue_id_ = 0;
+  // Used to count the subscribers of the feedback and status topics
+  std::shared_ptr<rcl_node_t> node_handle_;
+  std::string feedback_topic_name_;
+  std::string status_topic_name_;
+
+  // Queues of the clients which sent a goal intra process
+  std::mutex intra_process_clients_mutex_;
+  std::vector<std::weak_ptr<ActionIntraProcess>> intra_process_clients_;
+
+  void
+  add_intra_process_client(const std::weak_ptr<ActionIntraProcess> & client)
+  {
+    std::lock_guard<std::mutex> lock(intra_process_clients_mutex_);
+    for (const auto & known_client : intra_process_clients_) {
+      if (!known_client.owner_before(client) && !client.owner_before(known_client)) {
+        return;
+      }
+    }
+    intra_process_clients_.push_back(client);
+  }
+
+  // Return the queues of the clients which still exist, forgetting the others
+  std::vector<ActionIntraProcess::SharedPtr>
+  get_intra_process_clients()
+  {
+    std::vector<ActionIntraProcess::SharedPtr> clients;
+    std::lock_guard<std::mutex> lock(intra_process_clients_mutex_);
+    auto expired = std::remove_if(
+      intra_process_clients_.begin(), intra_process_clients_.end(),
+      [&clients](const std::weak_ptr<ActionIntraProcess> & weak_client) {
+        auto client = weak_client.lock();
+        if (!client) {
+          return true;
+        }
+        clients.push_back(std::move(client));
+        return false;
+      });
+    intra_process_clients_.erase(expired, intra_process_clients_.end());
+    return clients;
+  }
+
+  // Return true if a topic has other subscribers than the given number of clients
+  bool
+  has_inter_process_subscribers(const std::string & topic_name, size_t number_of_clients)
+  {
+    // A remote client which was not discovered yet misses the message.
+    size_t count = 0;
+    rcl_ret_t ret = rcl_count_subscribers(node_handle_.get(), topic_name.c_str(), &count);
+    if (RCL_RET_OK != ret) {
+      rcl_reset_error();
+      return true;
+    }
+    return count > number_of_clients;
+  }
 };
 }  // namespace rclcpp_action
 
@@ -85,15 +293,32 @@ ServerBase::ServerBase(
   rclcpp::node_interfaces::NodeLoggingInterface::SharedPtr node_logging,
   const std::string & name,
   const rosidl_action_type_support_t * type_support,
-  const rcl_action_server_options_t & options
+  const rcl_action_server_options_t & options,
+  const GoalStatusPublishingOptions & status_options
 )
 : pimpl_(new ServerBaseImpl(
-      node_clock->get_clock(), node_logging->get_logger().get_child("rclcpp_action")))
+      node_clock->get_clock(), node_logging->get_logger().get_child("rclcpp_action"),
+      status_options))
 {
+  if (status_options.coalescing_period < std::chrono::nanoseconds(0)) {
+    throw std::invalid_argument("the status coalescing period must not be negative");
+  }
+  if (!status_options.incremental &&
+    (status_options.coalescing_period > std::chrono::nanoseconds(0) ||
+    status_options.skip_reported_terminal_goals))
+  {
+    throw std::invalid_argument(
+            "coalescing or skipping goal statuses requires the incremental status publishing");
+  }
+
   auto deleter = [node_base](rcl_action_server_t * ptr)
     {
       if (nullptr != ptr) {
         rcl_node_t * rcl_node = node_base->get_rcl_node_handle();
+        if (rclcpp::detail::skip_entity_finalization(rcl_node)) {
+          delete ptr;
+          return;
+        }
         rcl_ret_t ret = rcl_action_server_fini(ptr, rcl_node);
         if (RCL_RET_OK != ret) {
           RCLCPP_DEBUG(
@@ -116,6 +341,7 @@ ServerBase::ServerBase(
   if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret);
   }
+  pimpl_->result_timeout_ = options.result_timeout.nanoseconds;
 
   ret = rcl_action_server_wait_set_get_num_entities(
     pimpl_->action_server_.get(),
@@ -128,10 +354,47 @@ ServerBase::ServerBase(
   if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret);
   }
+
+  if (status_options.coalescing_period > std::chrono::nanoseconds(0)) {
+    // The timer is part of this waitable, it is only started when a goal changes state.
+    pimpl_->status_timer_ = std::make_shared<rclcpp::WallTimer<std::function<void()>>>(
+      status_options.coalescing_period, []() {}, node_base->get_context());
+    pimpl_->status_timer_->cancel();
+    pimpl_->status_timer_started_guard_condition_ =
+      std::make_shared<rclcpp::GuardCondition>(node_base->get_context());
+    ++pimpl_->num_timers_;
+    ++pimpl_->num_guard_conditions_;
+  }
+
+  if (node_base->get_use_intra_process_default()) {
+    const std::string action_name =
+      rcl_action_server_get_action_name(pimpl_->action_server_.get());
+    auto context = node_base->get_context();
+    pimpl_->intra_process_queue_ = std::make_shared<ActionIntraProcess>(
+      context,
+      ActionIntraProcess::get_server_queue_name(action_name),
+      type_support,
+      [this](ActionIntraProcess::Message & message) {
+        execute_intra_process_message(message);
+      });
+    auto ipm = context->get_sub_context<rclcpp::experimental::IntraProcessManager>();
+    pimpl_->intra_process_queue_id_ = ipm->add_service(pimpl_->intra_process_queue_);
+    pimpl_->weak_ipm_ = ipm;
+    pimpl_->node_handle_ = node_base->get_shared_rcl_node_handle();
+    pimpl_->feedback_topic_name_ = action_name + "/_action/feedback";
+    pimpl_->status_topic_name_ = action_name + "/_action/status";
+    ++pimpl_->num_guard_conditions_;
+  }
 }
 
 ServerBase::~ServerBase()
 {
+  if (pimpl_->intra_process_queue_) {
+    auto ipm = pimpl_->weak_ipm_.lock();
+    if (ipm) {
+      ipm->remove_service(pimpl_->intra_process_queue_id_);
+    }
+  }
 }
 
 size_t
@@ -170,6 +433,17 @@ ServerBase::add_to_wait_set(rcl_wait_set_t * wait_set)
   std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
   rcl_ret_t ret = rcl_action_wait_set_add_action_server(
     wait_set, pimpl_->action_server_.get(), NULL);
+  if (RCL_RET_OK == ret && pimpl_->status_timer_) {
+    ret = rcl_wait_set_add_timer(
+      wait_set, pimpl_->status_timer_->get_timer_handle().get(), &pimpl_->status_timer_index_);
+  }
+  if (RCL_RET_OK == ret && pimpl_->status_timer_started_guard_condition_) {
+    ret = rcl_wait_set_add_guard_condition(
+      wait_set, &pimpl_->status_timer_started_guard_condition_->get_rcl_guard_condition(), NULL);
+  }
+  if (RCL_RET_OK == ret && pimpl_->intra_process_queue_) {
+    return pimpl_->intra_process_queue_->add_to_wait_set(wait_set);
+  }
   return RCL_RET_OK == ret;
 }
 
@@ -196,6 +470,13 @@ ServerBase::is_ready(rcl_wait_set_t * wait_set)
   pimpl_->cancel_request_ready_ = cancel_request_ready;
   pimpl_->result_request_ready_ = result_request_ready;
   pimpl_->goal_expired_ = goal_expired;
+  // The status timer is only called when executed, so it is still ready in the next wait set if
+  // another entity of the action server is executed first.
+  pimpl_->status_timer_ready_ = pimpl_->status_timer_ &&
+    pimpl_->status_timer_index_ < wait_set->size_of_timers &&
+    nullptr != wait_set->timers[pimpl_->status_timer_index_];
+  pimpl_->intra_process_message_ready_ = pimpl_->intra_process_queue_ &&
+    pimpl_->intra_process_queue_->is_ready(wait_set);
 
   if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret);
@@ -204,62 +485,47 @@ ServerBase::is_ready(rcl_wait_set_t * wait_set)
   return pimpl_->goal_request_ready_.load() ||
          pimpl_->cancel_request_ready_.load() ||
          pimpl_->result_request_ready_.load() ||
-         pimpl_->goal_expired_.load();
+         pimpl_->goal_expired_.load() ||
+         pimpl_->status_timer_ready_.load() ||
+         pimpl_->intra_process_message_ready_.load();
 }
 
 std::shared_ptr<void>
 ServerBase::take_data()
 {
-  if (pimpl_->goal_request_ready_.load()) {
-    rcl_ret_t ret;
-    rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
-    rmw_request_id_t request_header;
+  if (pimpl_->intra_process_message_ready_.load()) {
+    return pimpl_->intra_process_queue_->take_data();
+  } else if (pimpl_->goal_request_ready_.load()) {
+    auto data = pimpl_->taken_data_.acquire();
+    data->request = create_goal_request();
 
     std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
-
-    std::shared_ptr<void> message = create_goal_request();
-    ret = rcl_action_take_goal_request(
+    data->ret = rcl_action_take_goal_request(
       pimpl_->action_server_.get(),
-      &request_header,
-      message.get());
-
-    return std::static_pointer_cast<void>(
-      std::make_shared
-      <std::tuple<rcl_ret_t, rcl_action_goal_info_t, rmw_request_id_t, std::shared_ptr<void>>>(
-        ret,
-        goal_info,
-        request_header, message));
+      &data->request_header,
+      data->request.get());
+    return data;
   } else if (pimpl_->cancel_request_ready_.load()) {
-    rcl_ret_t ret;
-    rmw_request_id_t request_header;
-
-    // Initialize cancel request
-    auto request = std::make_shared<action_msgs::srv::CancelGoal::Request>();
+    auto data = pimpl_->taken_data_.acquire();
 
     std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
-    ret = rcl_action_take_cancel_request(
+    data->ret = rcl_action_take_cancel_request(
       pimpl_->action_server_.get(),
-      &request_header,
-      request.get());
-
-    return std::static_pointer_cast<void>(
-      std::make_shared
-      <std::tuple<rcl_ret_t, std::shared_ptr<action_msgs::srv::CancelGoal::Request>,
-      rmw_request_id_t>>(ret, request, request_header));
+      &data->request_header,
+      &data->cancel_request);
+    return data;
   } else if (pimpl_->result_request_ready_.load()) {
-    rcl_ret_t ret;
-    // Get the result request message
-    rmw_request_id_t request_header;
-    std::shared_ptr<void> result_request = create_result_request();
-    std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
-    ret = rcl_action_take_result_request(
-      pimpl_->action_server_.get(), &request_header, result_request.get());
+    auto data = pimpl_->taken_data_.acquire();
+    data->request = create_result_request();
 
-    return std::static_pointer_cast<void>(
-      std::make_shared<std::tuple<rcl_ret_t, std::shared_ptr<void>, rmw_request_id_t>>(
-        ret, result_request, request_header));
+    std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
+    data->ret = rcl_action_take_result_request(
+      pimpl_->action_server_.get(), &data->request_header, data->request.get());
+    return data;
   } else if (pimpl_->goal_expired_.load()) {
     return nullptr;
+  } else if (pimpl_->status_timer_ready_.load()) {
+    return nullptr;
   } else {
     throw std::runtime_error("Taking data from action server but nothing is ready");
   }
@@ -268,7 +534,14 @@ ServerBase::take_data()
 void
 ServerBase::execute(std::shared_ptr<void> & data)
 {
-  if (!data && !pimpl_->goal_expired_.load()) {
+  if (pimpl_->intra_process_message_ready_.load()) {
+    pimpl_->intra_process_message_ready_ = false;
+    // Empty if another thread took the last message meanwhile.
+    pimpl_->intra_process_queue_->execute(data);
+    return;
+  }
+
+  if (!data && !pimpl_->goal_expired_.load() && !pimpl_->status_timer_ready_.load()) {
     throw std::runtime_error("'data' is empty");
   }
 
@@ -280,6 +553,11 @@ ServerBase::execute(std::shared_ptr<void> & data)
     execute_result_request_received(data);
   } else if (pimpl_->goal_expired_.load()) {
     execute_check_expired_goals();
+  } else if (pimpl_->status_timer_ready_.load()) {
+    pimpl_->status_timer_ready_ = false;
+    if (pimpl_->status_timer_->call()) {
+      publish_pending_status();
+    }
   } else {
     throw std::runtime_error("Executing action server but nothing is ready");
   }
@@ -288,9 +566,8 @@ ServerBase::execute(std::shared_ptr<void> & data)
 void
 ServerBase::execute_goal_request_received(std::shared_ptr<void> & data)
 {
-  auto shared_ptr = std::static_pointer_cast
-    <std::tuple<rcl_ret_t, rcl_action_goal_info_t, rmw_request_id_t, std::shared_ptr<void>>>(data);
-  rcl_ret_t ret = std::get<0>(*shared_ptr);
+  auto shared_ptr = std::static_pointer_cast<ServerTakenData>(data);
+  rcl_ret_t ret = shared_ptr->ret;
   if (RCL_RET_ACTION_SERVER_TAKE_FAILED == ret) {
     // Ignore take failure because connext fails if it receives a sample without valid data.
     // This happens when a client shuts down and connext receives a sample saying the client is
@@ -299,32 +576,44 @@ ServerBase::execute_goal_request_received(std::shared_ptr<void> & data)
   } else if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret);
   }
-  rcl_action_goal_info_t goal_info = std::get<1>(*shared_ptr);
-  rmw_request_id_t request_header = std::get<2>(*shared_ptr);
-  std::shared_ptr<void> message = std::get<3>(*shared_ptr);
+  rmw_request_id_t request_header = shared_ptr->request_header;
+  // Moved out, so that the reused storage does not keep the request.
+  std::shared_ptr<void> message = std::move(shared_ptr->request);
 
   bool expected = true;
   if (!pimpl_->goal_request_ready_.compare_exchange_strong(expected, false)) {
     return;
   }
 
+  handle_goal_request(
+    std::move(message),
+    [this, &request_header](std::shared_ptr<void> response) {
+      rcl_ret_t send_ret;
+      {
+        std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
+        send_ret = rcl_action_send_goal_response(
+          pimpl_->action_server_.get(), &request_header, response.get());
+      }
+      if (RCL_RET_OK != send_ret) {
+        rclcpp::exceptions::throw_from_rcl_error(send_ret);
+      }
+    });
+  data.reset();
+}
+
+void
+ServerBase::handle_goal_request(
+  std::shared_ptr<void> message,
+  const ResponseSender & send_response)
+{
+  rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
   GoalUUID uuid = get_goal_id_from_goal_request(message.get());
   convert(uuid, &goal_info);
 
   // Call user's callback, getting the user's response and a ros message to send back
   auto response_pair = call_handle_goal_callback(uuid, message);
 
-  {
-    std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
-    ret = rcl_action_send_goal_response(
-      pimpl_->action_server_.get(),
-      &request_header,
-      response_pair.second.get());
-  }
-
-  if (RCL_RET_OK != ret) {
-    rclcpp::exceptions::throw_from_rcl_error(ret);
-  }
+  send_response(response_pair.second);
 
   const auto status = response_pair.first;
 
@@ -344,12 +633,17 @@ ServerBase::execute_goal_request_received(std::shared_ptr<void> & data)
           delete ptr;
         }
       };
+    // The state is stored before the goal exists in rcl_action, so that a result request for the
+    // accepted goal always finds it.
+    auto goal_state = std::make_shared<ServerGoalState>();
+    pimpl_->goal_states_.insert(uuid, goal_state);
     rcl_action_goal_handle_t * rcl_handle;
     {
       std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
       rcl_handle = rcl_action_accept_new_goal(pimpl_->action_server_.get(), &goal_info);
     }
     if (!rcl_handle) {
+      pimpl_->goal_states_.erase(uuid);
       throw std::runtime_error("Failed to accept new goal\n");
     }
 
@@ -358,33 +652,30 @@ ServerBase::execute_goal_request_received(std::shared_ptr<void> & data)
     *handle = *rcl_handle;
 
     {
-      std::lock_guard<std::recursive_mutex> lock(pimpl_->unordered_map_mutex_);
-      pimpl_->goal_handles_[uuid] = handle;
+      std::lock_guard<std::mutex> lock(goal_state->mutex);
+      goal_state->rcl_handle = handle;
     }
 
     if (GoalResponse::ACCEPT_AND_EXECUTE == status) {
       // Change status to executing
-      ret = rcl_action_update_goal_state(handle.get(), GOAL_EVENT_EXECUTE);
+      rcl_ret_t ret = rcl_action_update_goal_state(handle.get(), GOAL_EVENT_EXECUTE);
       if (RCL_RET_OK != ret) {
         rclcpp::exceptions::throw_from_rcl_error(ret);
       }
     }
     // publish status since a goal's state has changed (was accepted or has begun execution)
-    publish_status();
+    publish_status(uuid);
 
     // Tell user to start executing action
     call_goal_accepted_callback(handle, uuid, message);
   }
-  data.reset();
 }
 
 void
 ServerBase::execute_cancel_request_received(std::shared_ptr<void> & data)
 {
-  auto shared_ptr = std::static_pointer_cast
-    <std::tuple<rcl_ret_t, std::shared_ptr<action_msgs::srv::CancelGoal::Request>,
-      rmw_request_id_t>>(data);
-  auto ret = std::get<0>(*shared_ptr);
+  auto shared_ptr = std::static_pointer_cast<ServerTakenData>(data);
+  auto ret = shared_ptr->ret;
   if (RCL_RET_ACTION_SERVER_TAKE_FAILED == ret) {
     // Ignore take failure because connext fails if it receives a sample without valid data.
     // This happens when a client shuts down and connext receives a sample saying the client is
@@ -393,18 +684,35 @@ ServerBase::execute_cancel_request_received(std::shared_ptr<void> & data)
   } else if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret);
   }
-  auto request = std::get<1>(*shared_ptr);
-  auto request_header = std::get<2>(*shared_ptr);
+  auto request_header = shared_ptr->request_header;
+
+  auto response = handle_cancel_request(shared_ptr->cancel_request);
 
+  {
+    std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
+    ret = rcl_action_send_cancel_response(
+      pimpl_->action_server_.get(), &request_header, response.get());
+  }
+
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret);
+  }
+  data.reset();
+}
+
+std::shared_ptr<action_msgs::srv::CancelGoal::Response>
+ServerBase::handle_cancel_request(const action_msgs::srv::CancelGoal::Request & request)
+{
   // Convert c++ message to C message
   rcl_action_cancel_request_t cancel_request = rcl_action_get_zero_initialized_cancel_request();
-  convert(request->goal_info.goal_id.uuid, &cancel_request.goal_info);
-  cancel_request.goal_info.stamp.sec = request->goal_info.stamp.sec;
-  cancel_request.goal_info.stamp.nanosec = request->goal_info.stamp.nanosec;
+  convert(request.goal_info.goal_id.uuid, &cancel_request.goal_info);
+  cancel_request.goal_info.stamp.sec = request.goal_info.stamp.sec;
+  cancel_request.goal_info.stamp.nanosec = request.goal_info.stamp.nanosec;
 
   // Get a list of goal info that should be attempted to be cancelled
   rcl_action_cancel_response_t cancel_response = rcl_action_get_zero_initialized_cancel_response();
 
+  rcl_ret_t ret;
   {
     std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
     ret = rcl_action_process_cancel_request(
@@ -452,27 +760,23 @@ ServerBase::execute_cancel_request_received(std::shared_ptr<void> & data)
 
   if (!response->goals_canceling.empty()) {
     // at least one goal state changed, publish a new status message
-    publish_status();
-  }
-
-  {
-    std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
-    ret = rcl_action_send_cancel_response(
-      pimpl_->action_server_.get(), &request_header, response.get());
-  }
-
-  if (RCL_RET_OK != ret) {
-    rclcpp::exceptions::throw_from_rcl_error(ret);
+    if (pimpl_->status_options_.incremental) {
+      for (const auto & cpp_info : response->goals_canceling) {
+        update_goal_status(cpp_info.goal_id.uuid);
+      }
+      publish_updated_status();
+    } else {
+      publish_status();
+    }
   }
-  data.reset();
+  return response;
 }
 
 void
 ServerBase::execute_result_request_received(std::shared_ptr<void> & data)
 {
-  auto shared_ptr = std::static_pointer_cast
-    <std::tuple<rcl_ret_t, std::shared_ptr<void>, rmw_request_id_t>>(data);
-  auto ret = std::get<0>(*shared_ptr);
+  auto shared_ptr = std::static_pointer_cast<ServerTakenData>(data);
+  auto ret = shared_ptr->ret;
   if (RCL_RET_ACTION_SERVER_TAKE_FAILED == ret) {
     // Ignore take failure because connext fails if it receives a sample without valid data.
     // This happens when a client shuts down and connext receives a sample saying the client is
@@ -481,39 +785,32 @@ ServerBase::execute_result_request_received(std::shared_ptr<void> & data)
   } else if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret);
   }
-  auto result_request = std::get<1>(*shared_ptr);
-  auto request_header = std::get<2>(*shared_ptr);
+  // Moved out, so that the reused storage does not keep the request.
+  auto result_request = std::move(shared_ptr->request);
+  auto request_header = shared_ptr->request_header;
 
   pimpl_->result_request_ready_ = false;
   std::shared_ptr<void> result_response;
 
-  // check if the goal exists
+  // check if the goal exists, the goal states mirror the goals of rcl_action until they expire
   GoalUUID uuid = get_goal_id_from_result_request(result_request.get());
-  rcl_action_goal_info_t goal_info;
-  convert(uuid, &goal_info);
-  bool goal_exists;
-  {
-    std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
-    goal_exists = rcl_action_server_goal_exists(pimpl_->action_server_.get(), &goal_info);
-  }
-  if (!goal_exists) {
+  std::shared_ptr<ServerGoalState> goal_state = pimpl_->goal_states_.find(uuid);
+  if (!goal_state) {
     // Goal does not exists
     result_response = create_result_response(action_msgs::msg::GoalStatus::STATUS_UNKNOWN);
   } else {
     // Goal exists, check if a result is already available
-    std::lock_guard<std::recursive_mutex> lock(pimpl_->unordered_map_mutex_);
-    auto iter = pimpl_->goal_results_.find(uuid);
-    if (iter != pimpl_->goal_results_.end()) {
-      result_response = iter->second;
+    std::lock_guard<std::mutex> lock(goal_state->mutex);
+    if (goal_state->result) {
+      result_response = goal_state->result;
     } else {
       // Store the request so it can be responded to later
-      pimpl_->result_requests_[uuid].push_back(request_header);
+      goal_state->result_requests.push_back(request_header);
     }
   }
 
   if (result_response) {
     // Send the result now
-    std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
     rcl_ret_t rcl_ret = rcl_action_send_result_response(
       pimpl_->action_server_.get(), &request_header, result_response.get());
     if (RCL_RET_OK != rcl_ret) {
@@ -523,33 +820,109 @@ ServerBase::execute_result_request_received(std::shared_ptr<void> & data)
   data.reset();
 }
 
+void
+ServerBase::execute_intra_process_message(ActionIntraProcess::Message & message)
+{
+  using MessageType = ActionIntraProcess::MessageType;
+  switch (message.type) {
+    case MessageType::GoalRequest:
+      // Registered first, so that the client receives the status of the accepted goal.
+      pimpl_->add_intra_process_client(message.client);
+      handle_goal_request(std::move(message.message), message.response_callback);
+      break;
+    case MessageType::CancelRequest:
+      message.response_callback(
+        handle_cancel_request(
+          *std::static_pointer_cast<action_msgs::srv::CancelGoal::Request>(message.message)));
+      break;
+    case MessageType::ResultRequest:
+      {
+        std::shared_ptr<void> result_response;
+        GoalUUID uuid = get_goal_id_from_result_request(message.message.get());
+        std::shared_ptr<ServerGoalState> goal_state = pimpl_->goal_states_.find(uuid);
+        if (!goal_state) {
+          result_response = create_result_response(action_msgs::msg::GoalStatus::STATUS_UNKNOWN);
+        } else {
+          std::lock_guard<std::mutex> lock(goal_state->mutex);
+          if (goal_state->result) {
+            result_response = goal_state->result;
+          } else {
+            goal_state->intra_process_result_requests.push_back(
+              std::move(message.response_callback));
+          }
+        }
+        if (result_response) {
+          message.response_callback(std::move(result_response));
+        }
+      }
+      break;
+    default:
+      throw std::runtime_error("action server received an intra process response");
+  }
+}
+
+bool
+ServerBase::publish_intra_process(
+  ActionIntraProcess::MessageType type,
+  const std::function<std::shared_ptr<void>()> & get_message)
+{
+  if (!pimpl_->intra_process_queue_) {
+    return true;
+  }
+  auto clients = pimpl_->get_intra_process_clients();
+  if (clients.empty()) {
+    return true;
+  }
+  std::shared_ptr<void> message = get_message();
+  for (const auto & client : clients) {
+    client->push({type, message, nullptr, {}});
+  }
+  // Each client also subscribes to the topic, the messages it takes from it are ignored.
+  return pimpl_->has_inter_process_subscribers(
+    ActionIntraProcess::MessageType::Feedback == type ?
+    pimpl_->feedback_topic_name_ : pimpl_->status_topic_name_,
+    clients.size());
+}
+
 void
 ServerBase::execute_check_expired_goals()
 {
-  // Allocate expecting only one goal to expire at a time
-  rcl_action_goal_info_t expired_goals[1];
-  size_t num_expired = 1;
+  // Expire all the goals due in one batch, rcl_action_expire_goals() visits every goal per call.
+  size_t capacity;
+  {
+    std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
+    capacity = std::max<size_t>(pimpl_->pop_expired_goals(), 1u);
+  }
+  std::vector<rcl_action_goal_info_t> expired_goals(capacity);
+  size_t num_expired;
 
-  // Loop in case more than 1 goal expired
-  while (num_expired > 0u) {
+  // Loop in case more goals expired than expected, after a clock jump for instance
+  do {
     rcl_ret_t ret;
     {
       std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
-      ret = rcl_action_expire_goals(pimpl_->action_server_.get(), expired_goals, 1, &num_expired);
+      ret = rcl_action_expire_goals(
+        pimpl_->action_server_.get(), expired_goals.data(), capacity, &num_expired);
     }
     if (RCL_RET_OK != ret) {
       rclcpp::exceptions::throw_from_rcl_error(ret);
-    } else if (num_expired) {
-      // A goal expired!
+    }
+    for (size_t i = 0; i < num_expired; ++i) {
       GoalUUID uuid;
-      convert(expired_goals[0], &uuid);
+      convert(expired_goals[i], &uuid);
       RCLCPP_DEBUG(pimpl_->logger_, "Expired goal %s", to_string(uuid).c_str());
-      std::lock_guard<std::recursive_mutex> lock(pimpl_->unordered_map_mutex_);
-      pimpl_->goal_results_.erase(uuid);
-      pimpl_->result_requests_.erase(uuid);
-      pimpl_->goal_handles_.erase(uuid);
+      pimpl_->goal_states_.erase(uuid);
     }
-  }
+    if (num_expired > 0u && pimpl_->status_options_.incremental) {
+      // Like rcl_action_get_goal_status_array(), the next status message omits the goals.
+      std::lock_guard<std::mutex> status_lock(pimpl_->status_mutex_);
+      for (size_t i = 0; i < num_expired; ++i) {
+        GoalUUID uuid;
+        convert(expired_goals[i], &uuid);
+        pimpl_->remove_goal_status(uuid);
+      }
+    }
+  } while (num_expired == capacity);
 }
 
 void
@@ -603,6 +976,13 @@ ServerBase::publish_status()
     status_msg->status_list.push_back(msg);
   }
 
+  if (!publish_intra_process(
+      ActionIntraProcess::MessageType::Status,
+      [&status_msg]() {return std::static_pointer_cast<void>(status_msg);}))
+  {
+    return;
+  }
+
   // Publish the message through the status publisher
   ret = rcl_action_publish_status(pimpl_->action_server_.get(), status_msg.get());
 
@@ -612,55 +992,152 @@ ServerBase::publish_status()
 }
 
 void
-ServerBase::publish_result(const GoalUUID & uuid, std::shared_ptr<void> result_msg)
+ServerBase::publish_status(const GoalUUID & uuid)
 {
-  // Check that the goal exists
-  rcl_action_goal_info_t goal_info;
-  convert(uuid, &goal_info);
-  bool goal_exists;
+  if (!pimpl_->status_options_.incremental) {
+    publish_status();
+    return;
+  }
+  update_goal_status(uuid);
+  publish_updated_status();
+}
+
+void
+ServerBase::update_goal_status(const GoalUUID & uuid)
+{
+  std::shared_ptr<ServerGoalState> goal_state = pimpl_->goal_states_.find(uuid);
+  if (!goal_state) {
+    return;
+  }
+
+  rcl_action_goal_state_t state;
+  rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
   {
-    std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
-    goal_exists = rcl_action_server_goal_exists(pimpl_->action_server_.get(), &goal_info);
+    std::lock_guard<std::mutex> lock(goal_state->mutex);
+    const std::shared_ptr<rcl_action_goal_handle_t> & goal_handle = goal_state->rcl_handle;
+    if (!goal_handle) {
+      return;
+    }
+    rcl_ret_t ret = rcl_action_goal_handle_get_status(goal_handle.get(), &state);
+    if (RCL_RET_OK != ret) {
+      rclcpp::exceptions::throw_from_rcl_error(ret);
+    }
+    ret = rcl_action_goal_handle_get_info(goal_handle.get(), &goal_info);
+    if (RCL_RET_OK != ret) {
+      rclcpp::exceptions::throw_from_rcl_error(ret);
+    }
   }
 
-  if (!goal_exists) {
-    throw std::runtime_error("Asked to publish result for goal that does not exist");
+  std::lock_guard<std::mutex> lock(pimpl_->status_mutex_);
+  auto & status_list = pimpl_->status_msg_.status_list;
+  auto iter = pimpl_->status_indices_.find(uuid);
+  if (iter == pimpl_->status_indices_.end()) {
+    iter = pimpl_->status_indices_.emplace(uuid, status_list.size()).first;
+    status_list.emplace_back();
+    auto & msg = status_list.back();
+    msg.goal_info.goal_id.uuid = uuid;
+    msg.goal_info.stamp.sec = goal_info.stamp.sec;
+    msg.goal_info.stamp.nanosec = goal_info.stamp.nanosec;
   }
+  status_list[iter->second].status = state;
+  pimpl_->status_pending_ = true;
 
+  if (pimpl_->status_options_.skip_reported_terminal_goals &&
+    (GOAL_STATE_SUCCEEDED == state || GOAL_STATE_CANCELED == state ||
+    GOAL_STATE_ABORTED == state))
   {
-    /**
-    * NOTE: There is a potential deadlock issue if both unordered_map_mutex_ and
-    * action_server_reentrant_mutex_ locked in other block scopes. Unless using
-    * std::scoped_lock, locking order must be consistent with the current.
-    *
-    * Current locking order:
-    *
-    *   1. unordered_map_mutex_
-    *   2. action_server_reentrant_mutex_
-    *
-    */
-    std::lock_guard<std::recursive_mutex> unordered_map_lock(pimpl_->unordered_map_mutex_);
-    pimpl_->goal_results_[uuid] = result_msg;
-
-    // if there are clients who already asked for the result, send it to them
-    auto iter = pimpl_->result_requests_.find(uuid);
-    if (iter != pimpl_->result_requests_.end()) {
-      std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
-      for (auto & request_header : iter->second) {
-        rcl_ret_t ret = rcl_action_send_result_response(
-          pimpl_->action_server_.get(), &request_header, result_msg.get());
-        if (RCL_RET_OK != ret) {
-          rclcpp::exceptions::throw_from_rcl_error(ret);
-        }
-      }
+    pimpl_->terminal_goals_.push_back(uuid);
+  }
+}
+
+void
+ServerBase::publish_updated_status()
+{
+  if (!pimpl_->status_timer_) {
+    publish_pending_status();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(pimpl_->status_mutex_);
+  if (pimpl_->status_pending_ && !pimpl_->status_timer_running_) {
+    // The coalescing period starts with the first transition after the last status message.
+    pimpl_->status_timer_running_ = true;
+    pimpl_->status_timer_->reset();
+    pimpl_->status_timer_started_guard_condition_->trigger();
+  }
+}
+
+void
+ServerBase::publish_pending_status()
+{
+  std::lock_guard<std::mutex> lock(pimpl_->status_mutex_);
+  if (pimpl_->status_timer_running_) {
+    pimpl_->status_timer_running_ = false;
+    pimpl_->status_timer_->cancel();
+  }
+  if (!pimpl_->status_pending_) {
+    return;
+  }
+  pimpl_->status_pending_ = false;
+
+  // The status message is reused, so the clients of the same context are given a copy.
+  const bool publishes_inter_process = publish_intra_process(
+    ActionIntraProcess::MessageType::Status,
+    [this]() {
+      return std::make_shared<action_msgs::msg::GoalStatusArray>(pimpl_->status_msg_);
+    });
+  rcl_ret_t ret = RCL_RET_OK;
+  if (publishes_inter_process) {
+    std::lock_guard<std::recursive_mutex> server_lock(pimpl_->action_server_reentrant_mutex_);
+    ret = rcl_action_publish_status(pimpl_->action_server_.get(), &pimpl_->status_msg_);
+  }
+
+  for (const GoalUUID & uuid : pimpl_->terminal_goals_) {
+    pimpl_->remove_goal_status(uuid);
+  }
+  pimpl_->terminal_goals_.clear();
+
+  if (RCL_RET_OK != ret) {
+    rclcpp::exceptions::throw_from_rcl_error(ret);
+  }
+}
+
+void
+ServerBase::publish_result(const GoalUUID & uuid, std::shared_ptr<void> result_msg)
+{
+  // Check that the goal exists
+  std::shared_ptr<ServerGoalState> goal_state = pimpl_->goal_states_.find(uuid);
+  if (!goal_state) {
+    throw std::runtime_error("Asked to publish result for goal that does not exist");
+  }
+
+  // Only this goal is locked, the results of other goals are published and looked up meanwhile.
+  std::lock_guard<std::mutex> lock(goal_state->mutex);
+  goal_state->result = result_msg;
+
+  // if there are clients who already asked for the result, send it to them
+  std::vector<rmw_request_id_t> result_requests;
+  result_requests.swap(goal_state->result_requests);
+  for (auto & request_header : result_requests) {
+    rcl_ret_t ret = rcl_action_send_result_response(
+      pimpl_->action_server_.get(), &request_header, result_msg.get());
+    if (RCL_RET_OK != ret) {
+      rclcpp::exceptions::throw_from_rcl_error(ret);
     }
   }
+  std::vector<ActionIntraProcess::ResponseCallback> intra_process_result_requests;
+  intra_process_result_requests.swap(goal_state->intra_process_result_requests);
+  for (auto & response_callback : intra_process_result_requests) {
+    response_callback(result_msg);
+  }
 }
 
 void
 ServerBase::notify_goal_terminal_state()
 {
   std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
+  if (pimpl_->result_timeout_ >= 0) {
+    pimpl_->expiry_heap_.push(pimpl_->clock_->now().nanoseconds() + pimpl_->result_timeout_);
+  }
   rcl_ret_t ret = rcl_action_notify_goal_done(pimpl_->action_server_.get());
   if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret);
@@ -670,7 +1147,20 @@ ServerBase::notify_goal_terminal_state()
 void
 ServerBase::publish_feedback(std::shared_ptr<void> feedback_msg)
 {
-  std::lock_guard<std::recursive_mutex> lock(pimpl_->action_server_reentrant_mutex_);
+  publish_feedback(feedback_msg, [&feedback_msg]() {return feedback_msg;});
+}
+
+void
+ServerBase::publish_feedback(
+  std::shared_ptr<void> feedback_msg,
+  const std::function<std::shared_ptr<void>()> & get_intra_process_message)
+{
+  if (!publish_intra_process(
+      ActionIntraProcess::MessageType::Feedback, get_intra_process_message))
+  {
+    return;
+  }
+  // Not locked, the feedback of the goals is published concurrently.
   rcl_ret_t ret = rcl_action_publish_feedback(pimpl_->action_server_.get(), feedback_msg.get());
   if (RCL_RET_OK != ret) {
     rclcpp::exceptions::throw_from_rcl_error(ret, "Failed to publish feedback");
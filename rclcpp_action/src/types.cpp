@@ -14,11 +14,30 @@
 
 #include "rclcpp_action/types.hpp"
 
+#include <cstdint>
+#include <cstring>
+#include <random>
 #include <string>
 #include <sstream>
 
 namespace rclcpp_action
 {
+GoalUUID
+generate_goal_uuid()
+{
+  thread_local std::mt19937_64 generator(
+    [] {
+      std::random_device device;
+      std::seed_seq seed{device(), device(), device(), device()};
+      return std::mt19937_64(seed);
+    } ());
+  const uint64_t words[2] = {generator(), generator()};
+  GoalUUID uuid;
+  static_assert(sizeof(uuid) == sizeof(words), "unexpected goal id size");
+  std::memcpy(uuid.data(), words, sizeof(words));
+  return uuid;
+}
+
 std::string
 to_string(const GoalUUID & goal_id)
 {
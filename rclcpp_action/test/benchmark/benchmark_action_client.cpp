@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "performance_test_fixture/performance_test_fixture.hpp"
 #include "rclcpp_action/rclcpp_action.hpp"
@@ -160,6 +161,16 @@ BENCHMARK_F(ActionClientPerformanceTest, destroy_client)(benchmark::State & stat
   }
 }
 
+BENCHMARK_F(ActionClientPerformanceTest, generate_goal_uuid)(benchmark::State & state)
+{
+  reset_heap_counters();
+  for (auto _ : state) {
+    (void)_;
+    auto goal_id = rclcpp_action::generate_goal_uuid();
+    benchmark::DoNotOptimize(goal_id);
+  }
+}
+
 BENCHMARK_F(ActionClientPerformanceTest, async_send_goal_only)(benchmark::State & state)
 {
   auto client = rclcpp_action::create_client<Fibonacci>(node, fibonacci_action_name);
@@ -361,3 +372,79 @@ BENCHMARK_F(ActionClientPerformanceTest, async_cancel_all_goals)(benchmark::Stat
     }
   }
 }
+
+BENCHMARK_DEFINE_F(ActionClientPerformanceTest, receive_feedback)(benchmark::State & state)
+{
+  const size_t num_goals = static_cast<size_t>(state.range(0));
+  std::vector<std::shared_ptr<GoalHandle>> server_goal_handles;
+  // Keep the feedback of all the goals published in a burst
+  rcl_action_server_options_t server_options = rcl_action_server_get_default_options();
+  server_options.feedback_topic_qos.depth = num_goals;
+  rcl_action_client_options_t client_options = rcl_action_client_get_default_options();
+  client_options.feedback_topic_qos.depth = num_goals;
+  action_server = rclcpp_action::create_server<Fibonacci>(
+    node, fibonacci_action_name,
+    [](const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>) {
+      return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    },
+    [](std::shared_ptr<GoalHandle>) {
+      return rclcpp_action::CancelResponse::ACCEPT;
+    },
+    [&server_goal_handles](std::shared_ptr<GoalHandle> goal_handle) {
+      server_goal_handles.push_back(goal_handle);
+    },
+    server_options);
+  auto client = rclcpp_action::create_client<Fibonacci>(
+    node, fibonacci_action_name, nullptr, client_options);
+  if (!client->wait_for_action_server(std::chrono::seconds(1))) {
+    state.SkipWithError("Waiting for server timed out");
+    return;
+  }
+
+  size_t num_feedback_received = 0;
+  auto send_goal_options = rclcpp_action::Client<Fibonacci>::SendGoalOptions();
+  send_goal_options.feedback_callback =
+    [&num_feedback_received](
+    rclcpp_action::ClientGoalHandle<Fibonacci>::SharedPtr,
+    const std::shared_ptr<const Fibonacci::Feedback>)
+    {
+      ++num_feedback_received;
+    };
+  // The client only keeps weak references to its goal handles
+  std::vector<rclcpp_action::ClientGoalHandle<Fibonacci>::SharedPtr> client_goal_handles;
+  const auto goal = GetGoalOfOrder(1);
+  for (size_t i = 0; i < num_goals; ++i) {
+    auto future_goal_handle = client->async_send_goal(goal, send_goal_options);
+    rclcpp::spin_until_future_complete(node, future_goal_handle, std::chrono::seconds(1));
+    client_goal_handles.push_back(future_goal_handle.get());
+  }
+  if (server_goal_handles.size() != num_goals) {
+    state.SkipWithError("Valid goal was not accepted");
+    return;
+  }
+
+  auto feedback = std::make_shared<Fibonacci::Feedback>();
+  feedback->sequence = {0, 1, 1, 2, 3, 5, 8, 13};
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+
+  reset_heap_counters();
+  for (auto _ : state) {
+    (void)_;
+    num_feedback_received = 0;
+    for (auto & server_goal_handle : server_goal_handles) {
+      server_goal_handle->publish_feedback(feedback);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    while (num_feedback_received < num_goals) {
+      if (std::chrono::steady_clock::now() - start > std::chrono::seconds(1)) {
+        state.SkipWithError("Feedback was not received");
+        return;
+      }
+      executor.spin_once(std::chrono::milliseconds(10));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ActionClientPerformanceTest, receive_feedback)
+->Arg(1)->Arg(10)->Arg(50);
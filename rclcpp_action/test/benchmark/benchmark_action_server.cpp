@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "performance_test_fixture/performance_test_fixture.hpp"
 #include "rclcpp_action/rclcpp_action.hpp"
@@ -58,6 +59,71 @@ public:
     return action_client->async_send_goal(goal);
   }
 
+  /// Send goals and return true if they were all accepted
+  /**
+   * The accept callback of the action server is expected to push the goal handles into
+   * goal_handles.
+   */
+  bool SendGoals(size_t num_goals, const std::vector<std::shared_ptr<GoalHandle>> & goal_handles)
+  {
+    const size_t expected_goals = goal_handles.size() + num_goals;
+    for (size_t i = 0; i < num_goals; ++i) {
+      auto client_goal_handle_future = AsyncSendGoalOfOrder(1);
+      rclcpp::spin_until_future_complete(node, client_goal_handle_future, std::chrono::seconds(1));
+    }
+    return goal_handles.size() == expected_goals;
+  }
+
+  /// Time the status published when a goal starts executing, with other goals retained
+  void BenchmarkPublishStatus(
+    benchmark::State & state,
+    const rclcpp_action::GoalStatusPublishingOptions & status_options)
+  {
+    std::vector<std::shared_ptr<GoalHandle>> goal_handles;
+    // Terminal goals expire on the next spin, only the executing goals below are retained
+    rcl_action_server_options_t options = rcl_action_server_get_default_options();
+    options.result_timeout.nanoseconds = 0;
+    auto action_server = rclcpp_action::create_server<Fibonacci>(
+      node, fibonacci_action_name,
+      [](const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>) {
+        return rclcpp_action::GoalResponse::ACCEPT_AND_DEFER;
+      },
+      [](std::shared_ptr<GoalHandle>) {
+        return rclcpp_action::CancelResponse::ACCEPT;
+      },
+      [&goal_handles](std::shared_ptr<GoalHandle> goal_handle) {
+        goal_handles.push_back(goal_handle);
+      },
+      options, nullptr, status_options);
+    const size_t num_retained_goals = static_cast<size_t>(state.range(0));
+    if (!SendGoals(num_retained_goals, goal_handles)) {
+      state.SkipWithError("Valid goal was not accepted");
+      return;
+    }
+    for (auto & goal_handle : goal_handles) {
+      goal_handle->execute();
+    }
+    auto result = std::make_shared<Fibonacci::Result>();
+
+    reset_heap_counters();
+    for (auto _ : state) {
+      (void)_;
+      state.PauseTiming();
+      if (!SendGoals(1u, goal_handles)) {
+        state.SkipWithError("Valid goal was not accepted");
+        return;
+      }
+      state.ResumeTiming();
+
+      goal_handles.back()->execute();
+
+      state.PauseTiming();
+      goal_handles.back()->succeed(result);
+      goal_handles.pop_back();
+      state.ResumeTiming();
+    }
+  }
+
 protected:
   std::shared_ptr<rclcpp::Node> node;
   std::shared_ptr<rclcpp_action::Client<Fibonacci>> action_client;
@@ -130,6 +196,18 @@ BENCHMARK_F(ActionServerPerformanceTest, destroy_server)(benchmark::State & stat
   }
 }
 
+BENCHMARK_F(ActionServerPerformanceTest, hash_goal_uuid)(benchmark::State & state)
+{
+  const GoalUUID goal_id = rclcpp_action::generate_goal_uuid();
+  const std::hash<GoalUUID> hash;
+  reset_heap_counters();
+  for (auto _ : state) {
+    (void)_;
+    size_t result = hash(goal_id);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
 BENCHMARK_F(ActionServerPerformanceTest, action_server_accept_goal)(benchmark::State & state)
 {
   std::shared_ptr<GoalHandle> current_goal_handle = nullptr;
@@ -324,3 +402,94 @@ BENCHMARK_F(ActionServerPerformanceTest, action_server_abort)(benchmark::State &
     server_goal_handle->abort(result);
   }
 }
+
+BENCHMARK_DEFINE_F(ActionServerPerformanceTest, action_server_publish_feedback)(
+  benchmark::State & state)
+{
+  const size_t num_goals = static_cast<size_t>(state.range(0));
+  std::vector<std::shared_ptr<GoalHandle>> goal_handles;
+  auto action_server = rclcpp_action::create_server<Fibonacci>(
+    node, fibonacci_action_name,
+    [](const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>) {
+      return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    },
+    [](std::shared_ptr<GoalHandle>) {
+      return rclcpp_action::CancelResponse::ACCEPT;
+    },
+    [&goal_handles](std::shared_ptr<GoalHandle> goal_handle) {
+      goal_handles.push_back(goal_handle);
+    });
+  if (!SendGoals(num_goals, goal_handles)) {
+    state.SkipWithError("Valid goal was not accepted");
+    return;
+  }
+
+  auto feedback = std::make_shared<Fibonacci::Feedback>();
+  feedback->sequence = {0, 1, 1, 2, 3, 5, 8, 13};
+
+  reset_heap_counters();
+  for (auto _ : state) {
+    (void)_;
+    for (auto & goal_handle : goal_handles) {
+      goal_handle->publish_feedback(feedback);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ActionServerPerformanceTest, action_server_publish_feedback)
+->Arg(1)->Arg(10)->Arg(50);
+
+BENCHMARK_DEFINE_F(ActionServerPerformanceTest, action_server_publish_borrowed_feedback)(
+  benchmark::State & state)
+{
+  const size_t num_goals = static_cast<size_t>(state.range(0));
+  std::vector<std::shared_ptr<GoalHandle>> goal_handles;
+  auto action_server = rclcpp_action::create_server<Fibonacci>(
+    node, fibonacci_action_name,
+    [](const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>) {
+      return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    },
+    [](std::shared_ptr<GoalHandle>) {
+      return rclcpp_action::CancelResponse::ACCEPT;
+    },
+    [&goal_handles](std::shared_ptr<GoalHandle> goal_handle) {
+      goal_handles.push_back(goal_handle);
+    });
+  if (!SendGoals(num_goals, goal_handles)) {
+    state.SkipWithError("Valid goal was not accepted");
+    return;
+  }
+  for (auto & goal_handle : goal_handles) {
+    goal_handle->borrow_feedback().sequence = {0, 1, 1, 2, 3, 5, 8, 13};
+  }
+
+  reset_heap_counters();
+  for (auto _ : state) {
+    (void)_;
+    for (auto & goal_handle : goal_handles) {
+      ++goal_handle->borrow_feedback().sequence.back();
+      goal_handle->publish_borrowed_feedback();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ActionServerPerformanceTest, action_server_publish_borrowed_feedback)
+->Arg(1)->Arg(10)->Arg(50);
+
+BENCHMARK_DEFINE_F(ActionServerPerformanceTest, action_server_publish_status)(
+  benchmark::State & state)
+{
+  BenchmarkPublishStatus(*this, state, rclcpp_action::GoalStatusPublishingOptions());
+}
+BENCHMARK_REGISTER_F(ActionServerPerformanceTest, action_server_publish_status)
+->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
+
+BENCHMARK_DEFINE_F(ActionServerPerformanceTest, action_server_publish_status_incremental)(
+  benchmark::State & state)
+{
+  rclcpp_action::GoalStatusPublishingOptions status_options;
+  status_options.incremental = true;
+  BenchmarkPublishStatus(*this, state, status_options);
+}
+BENCHMARK_REGISTER_F(ActionServerPerformanceTest, action_server_publish_status_incremental)
+->Arg(0)->Arg(10)->Arg(100)->Arg(1000);
@@ -39,6 +39,7 @@
 #include <string>
 #include <utility>
 #include <thread>
+#include <vector>
 #include <chrono>
 
 #include "rclcpp_action/exceptions.hpp"
@@ -536,6 +537,32 @@ TEST_F(TestClientAgainstServer, async_send_goal_with_goal_response_callback_wait
   }
 }
 
+TEST_F(TestClientAgainstServer, async_send_goal_from_goal_response_callback)
+{
+  auto action_client = rclcpp_action::create_client<ActionType>(client_node, action_name);
+  ASSERT_TRUE(action_client->wait_for_action_server(WAIT_FOR_SERVER_TIMEOUT));
+
+  // The goal response callback is not called with the pending requests locked.
+  std::shared_future<typename ActionGoalHandle::SharedPtr> future_second_goal_handle;
+  auto send_goal_ops = rclcpp_action::Client<ActionType>::SendGoalOptions();
+  send_goal_ops.goal_response_callback =
+    [&action_client, &future_second_goal_handle](typename ActionGoalHandle::SharedPtr)
+    {
+      ActionGoal goal;
+      goal.order = 2;
+      future_second_goal_handle = action_client->async_send_goal(goal);
+    };
+
+  ActionGoal goal;
+  goal.order = 4;
+  auto future_goal_handle = action_client->async_send_goal(goal, send_goal_ops);
+  dual_spin_until_future_complete(future_goal_handle);
+  ASSERT_TRUE(future_goal_handle.get());
+  ASSERT_TRUE(future_second_goal_handle.valid());
+  dual_spin_until_future_complete(future_second_goal_handle);
+  EXPECT_TRUE(future_second_goal_handle.get());
+}
+
 TEST_F(TestClientAgainstServer, async_send_goal_with_deprecated_goal_response_callback)
 {
   auto action_client = rclcpp_action::create_client<ActionType>(client_node, action_name);
@@ -628,6 +655,62 @@ TEST_F(TestClientAgainstServer, async_send_goal_with_feedback_callback_wait_for_
   EXPECT_EQ(5, feedback_count);
 }
 
+TEST_F(TestClientAgainstServer, status_and_feedback_of_other_goals)
+{
+  auto action_client = rclcpp_action::create_client<ActionType>(client_node, action_name);
+  ASSERT_TRUE(action_client->wait_for_action_server(WAIT_FOR_SERVER_TIMEOUT));
+
+  ActionGoal goal;
+  goal.order = 4;
+  std::vector<std::shared_ptr<const ActionFeedback>> feedbacks;
+  auto send_goal_ops = rclcpp_action::Client<ActionType>::SendGoalOptions();
+  send_goal_ops.feedback_callback =
+    [&feedbacks](
+    typename ActionGoalHandle::SharedPtr,
+    const std::shared_ptr<const ActionFeedback> feedback)
+    {
+      feedbacks.push_back(feedback);
+    };
+  auto future_goal_handle = action_client->async_send_goal(goal, send_goal_ops);
+  dual_spin_until_future_complete(future_goal_handle);
+  auto goal_handle = future_goal_handle.get();
+  ASSERT_TRUE(goal_handle);
+
+  // The goals of other clients are listed before the goal of this client.
+  ActionStatusMessage status_message;
+  for (uint8_t i = 1; i <= 10; ++i) {
+    rclcpp_action::GoalStatus goal_status;
+    goal_status.goal_info.goal_id.uuid.fill(i);
+    goal_status.status = rclcpp_action::GoalStatus::STATUS_ABORTED;
+    status_message.status_list.push_back(goal_status);
+  }
+  rclcpp_action::GoalStatus goal_status;
+  goal_status.goal_info.goal_id.uuid = goal_handle->get_goal_id();
+  goal_status.status = rclcpp_action::GoalStatus::STATUS_EXECUTING;
+  status_message.status_list.push_back(goal_status);
+  status_publisher->publish(status_message);
+
+  ActionFeedbackMessage feedback_message;
+  feedback_message.goal_id.uuid.fill(1u);
+  feedback_message.feedback.sequence = {1};
+  feedback_publisher->publish(feedback_message);
+  feedback_message.goal_id.uuid = goal_handle->get_goal_id();
+  feedback_message.feedback.sequence = {2};
+  feedback_publisher->publish(feedback_message);
+
+  const auto start = std::chrono::steady_clock::now();
+  while (
+    (feedbacks.empty() ||
+    rclcpp_action::GoalStatus::STATUS_EXECUTING != goal_handle->get_status()) &&
+    std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+  {
+    client_executor.spin_once(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(rclcpp_action::GoalStatus::STATUS_EXECUTING, goal_handle->get_status());
+  ASSERT_EQ(1u, feedbacks.size());
+  EXPECT_EQ(std::vector<int32_t>({2}), feedbacks[0]->sequence);
+}
+
 TEST_F(TestClientAgainstServer, async_send_goal_with_result_callback_wait_for_result)
 {
   auto action_client = rclcpp_action::create_client<ActionType>(client_node, action_name);
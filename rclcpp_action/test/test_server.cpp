@@ -20,11 +20,15 @@
 
 #include <gtest/gtest.h>
 
+#include <future>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "rcl_action/action_server.h"
 #include "rcl_action/wait.h"
+#include "rclcpp_action/create_client.hpp"
 #include "rclcpp_action/create_server.hpp"
 #include "rclcpp_action/server.hpp"
 #include "./mocking_utils/patch.hpp"
@@ -767,6 +771,86 @@ TEST_F(TestServer, publish_status_aborted)
   EXPECT_EQ(uuid, msg->status_list.at(0).goal_info.goal_id.uuid);
 }
 
+TEST_F(TestServer, publish_status_incremental)
+{
+  auto node = std::make_shared<rclcpp::Node>(
+    "status_incremental", "/rclcpp_action/status_incremental");
+  const GoalUUID uuid1{{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}};
+  const GoalUUID uuid2{{2, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}};
+
+  auto handle_goal = [](
+    const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>)
+    {
+      return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    };
+
+  using GoalHandle = rclcpp_action::ServerGoalHandle<Fibonacci>;
+
+  auto handle_cancel = [](std::shared_ptr<GoalHandle>)
+    {
+      return rclcpp_action::CancelResponse::REJECT;
+    };
+
+  std::shared_ptr<GoalHandle> received_handle;
+  auto handle_accepted = [&received_handle](std::shared_ptr<GoalHandle> handle)
+    {
+      received_handle = handle;
+    };
+
+  rclcpp_action::GoalStatusPublishingOptions status_options;
+  status_options.coalescing_period = std::chrono::milliseconds(500);
+  EXPECT_THROW(
+    rclcpp_action::create_server<Fibonacci>(
+      node, "fibonacci", handle_goal, handle_cancel, handle_accepted,
+      rcl_action_server_get_default_options(), nullptr, status_options),
+    std::invalid_argument);
+
+  status_options.incremental = true;
+  status_options.skip_reported_terminal_goals = true;
+  auto as = rclcpp_action::create_server<Fibonacci>(
+    node, "fibonacci", handle_goal, handle_cancel, handle_accepted,
+    rcl_action_server_get_default_options(), nullptr, status_options);
+  (void)as;
+
+  // Subscribe to status messages
+  std::vector<action_msgs::msg::GoalStatusArray::ConstSharedPtr> received_msgs;
+  auto subscriber = node->create_subscription<action_msgs::msg::GoalStatusArray>(
+    "fibonacci/_action/status", 10,
+    [&received_msgs](action_msgs::msg::GoalStatusArray::ConstSharedPtr list)
+    {
+      received_msgs.push_back(list);
+    });
+
+  auto spin_until_received = [&node, &received_msgs](size_t number_of_msgs)
+    {
+      // 10 seconds
+      const size_t max_tries = 10 * 1000 / 100;
+      for (size_t retry = 0; retry < max_tries && received_msgs.size() < number_of_msgs; ++retry) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        rclcpp::spin_some(node);
+      }
+    };
+
+  // The acceptance and the success of the goal are published in one message.
+  send_goal_request(node, uuid1);
+  received_handle->succeed(std::make_shared<Fibonacci::Result>());
+  spin_until_received(1u);
+  ASSERT_EQ(1u, received_msgs.size());
+  ASSERT_EQ(1u, received_msgs[0]->status_list.size());
+  EXPECT_EQ(
+    action_msgs::msg::GoalStatus::STATUS_SUCCEEDED, received_msgs[0]->status_list.at(0).status);
+  EXPECT_EQ(uuid1, received_msgs[0]->status_list.at(0).goal_info.goal_id.uuid);
+
+  // The goal reported terminal is not in the next message.
+  send_goal_request(node, uuid2);
+  spin_until_received(2u);
+  ASSERT_EQ(2u, received_msgs.size());
+  ASSERT_EQ(1u, received_msgs[1]->status_list.size());
+  EXPECT_EQ(
+    action_msgs::msg::GoalStatus::STATUS_EXECUTING, received_msgs[1]->status_list.at(0).status);
+  EXPECT_EQ(uuid2, received_msgs[1]->status_list.at(0).goal_info.goal_id.uuid);
+}
+
 TEST_F(TestServer, publish_feedback)
 {
   auto node = std::make_shared<rclcpp::Node>("pub_feedback", "/rclcpp_action/pub_feedback");
@@ -825,6 +909,154 @@ TEST_F(TestServer, publish_feedback)
   ASSERT_EQ(sent_message->sequence, msg->feedback.sequence);
 }
 
+TEST_F(TestServer, publish_borrowed_feedback)
+{
+  auto node = std::make_shared<rclcpp::Node>(
+    "pub_borrowed_feedback", "/rclcpp_action/pub_borrowed_feedback");
+  const GoalUUID uuid{{1, 20, 30, 4, 5, 6, 70, 8, 9, 1, 11, 120, 13, 14, 15, 161}};
+
+  auto handle_goal = [](
+    const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>)
+    {
+      return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    };
+
+  using GoalHandle = rclcpp_action::ServerGoalHandle<Fibonacci>;
+
+  auto handle_cancel = [](std::shared_ptr<GoalHandle>)
+    {
+      return rclcpp_action::CancelResponse::REJECT;
+    };
+
+  std::shared_ptr<GoalHandle> received_handle;
+  auto handle_accepted = [&received_handle](std::shared_ptr<GoalHandle> handle)
+    {
+      received_handle = handle;
+    };
+
+  auto as = rclcpp_action::create_server<Fibonacci>(
+    node, "fibonacci",
+    handle_goal,
+    handle_cancel,
+    handle_accepted);
+  (void)as;
+
+  using FeedbackT = Fibonacci::Impl::FeedbackMessage;
+  std::vector<FeedbackT::ConstSharedPtr> received_msgs;
+  auto subscriber = node->create_subscription<FeedbackT>(
+    "fibonacci/_action/feedback", 10, [&received_msgs](FeedbackT::ConstSharedPtr msg)
+    {
+      received_msgs.push_back(msg);
+    });
+
+  send_goal_request(node, uuid);
+  ASSERT_TRUE(received_handle);
+
+  EXPECT_THROW(received_handle->publish_borrowed_feedback(), std::runtime_error);
+
+  // The same message is reused, and keeps its content between publications.
+  auto & feedback = received_handle->borrow_feedback();
+  feedback.sequence = {1, 1, 2};
+  received_handle->publish_borrowed_feedback();
+  EXPECT_EQ(&feedback, &received_handle->borrow_feedback());
+  feedback.sequence.push_back(3);
+  received_handle->publish_borrowed_feedback();
+
+  // 10 seconds
+  const size_t max_tries = 10 * 1000 / 100;
+  for (size_t retry = 0; retry < max_tries && received_msgs.size() < 2u; ++retry) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    rclcpp::spin_some(node);
+  }
+
+  ASSERT_EQ(2u, received_msgs.size());
+  EXPECT_EQ(uuid, received_msgs[0]->goal_id.uuid);
+  EXPECT_EQ(std::vector<int32_t>({1, 1, 2}), received_msgs[0]->feedback.sequence);
+  EXPECT_EQ(uuid, received_msgs[1]->goal_id.uuid);
+  EXPECT_EQ(std::vector<int32_t>({1, 1, 2, 3}), received_msgs[1]->feedback.sequence);
+}
+
+TEST_F(TestServer, concurrent_feedback_and_results)
+{
+  auto node = std::make_shared<rclcpp::Node>(
+    "concurrent_goals", "/rclcpp_action/concurrent_goals");
+
+  auto handle_goal = [](
+    const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>)
+    {
+      return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    };
+
+  using GoalHandle = rclcpp_action::ServerGoalHandle<Fibonacci>;
+
+  auto handle_cancel = [](std::shared_ptr<GoalHandle>)
+    {
+      return rclcpp_action::CancelResponse::REJECT;
+    };
+
+  std::vector<std::shared_ptr<GoalHandle>> received_handles;
+  auto handle_accepted = [&received_handles](std::shared_ptr<GoalHandle> handle)
+    {
+      received_handles.push_back(handle);
+    };
+
+  auto as = rclcpp_action::create_server<Fibonacci>(
+    node, "fibonacci",
+    handle_goal,
+    handle_cancel,
+    handle_accepted);
+  (void)as;
+
+  auto result_client = node->create_client<Fibonacci::Impl::GetResultService>(
+    "fibonacci/_action/get_result");
+  ASSERT_TRUE(result_client->wait_for_service(std::chrono::seconds(20)));
+
+  const size_t number_of_goals = 4u;
+  std::vector<rclcpp::Client<Fibonacci::Impl::GetResultService>::SharedFuture> futures;
+  for (uint8_t i = 0u; i < number_of_goals; ++i) {
+    const GoalUUID uuid{{i, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16}};
+    send_goal_request(node, uuid);
+    auto request = std::make_shared<Fibonacci::Impl::GetResultService::Request>();
+    request->goal_id.uuid = uuid;
+    futures.push_back(result_client->async_send_request(request).share());
+  }
+  ASSERT_EQ(number_of_goals, received_handles.size());
+  // Let the server store the result requests
+  for (auto & future : futures) {
+    EXPECT_EQ(
+      rclcpp::FutureReturnCode::TIMEOUT,
+      rclcpp::spin_until_future_complete(node, future, std::chrono::milliseconds(100)));
+  }
+
+  // Each goal publishes its feedback and result from its own thread.
+  std::vector<std::thread> threads;
+  for (size_t i = 0u; i < number_of_goals; ++i) {
+    threads.emplace_back(
+      [handle = received_handles[i], i]() {
+        auto feedback = std::make_shared<Fibonacci::Feedback>();
+        for (int32_t j = 0; j < 100; ++j) {
+          feedback->sequence = {j};
+          handle->publish_feedback(feedback);
+        }
+        auto result = std::make_shared<Fibonacci::Result>();
+        result->sequence = {static_cast<int32_t>(i)};
+        handle->succeed(result);
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0u; i < number_of_goals; ++i) {
+    ASSERT_EQ(
+      rclcpp::FutureReturnCode::SUCCESS,
+      rclcpp::spin_until_future_complete(node, futures[i], std::chrono::seconds(10)));
+    auto response = futures[i].get();
+    EXPECT_EQ(action_msgs::msg::GoalStatus::STATUS_SUCCEEDED, response->status);
+    EXPECT_EQ(std::vector<int32_t>{static_cast<int32_t>(i)}, response->result.sequence);
+  }
+}
+
 TEST_F(TestServer, get_result)
 {
   auto node = std::make_shared<rclcpp::Node>("get_result", "/rclcpp_action/get_result");
@@ -903,6 +1135,72 @@ TEST_F(TestServer, get_result)
   EXPECT_EQ(action_msgs::msg::GoalStatus::STATUS_UNKNOWN, response->status);
 }
 
+TEST_F(TestServer, expire_goals_in_batch)
+{
+  auto node = std::make_shared<rclcpp::Node>("expire_goals", "/rclcpp_action/expire_goals");
+
+  auto handle_goal = [](
+    const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>)
+    {
+      return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    };
+
+  using GoalHandle = rclcpp_action::ServerGoalHandle<Fibonacci>;
+
+  auto handle_cancel = [](std::shared_ptr<GoalHandle>)
+    {
+      return rclcpp_action::CancelResponse::REJECT;
+    };
+
+  std::vector<std::shared_ptr<GoalHandle>> received_handles;
+  auto handle_accepted = [&received_handles](std::shared_ptr<GoalHandle> handle)
+    {
+      received_handles.push_back(handle);
+    };
+
+  const std::chrono::milliseconds result_timeout{50};
+
+  rcl_action_server_options_t options = rcl_action_server_get_default_options();
+  options.result_timeout.nanoseconds = RCL_MS_TO_NS(result_timeout.count());
+  auto as = rclcpp_action::create_server<Fibonacci>(
+    node, "fibonacci",
+    handle_goal,
+    handle_cancel,
+    handle_accepted,
+    options);
+  (void)as;
+
+  std::vector<GoalUUID> uuids;
+  for (uint8_t i = 1; i <= 5; ++i) {
+    GoalUUID uuid;
+    uuid.fill(i);
+    send_goal_request(node, uuid);
+    uuids.push_back(uuid);
+  }
+  ASSERT_EQ(5u, received_handles.size());
+  for (auto & handle : received_handles) {
+    handle->succeed(std::make_shared<Fibonacci::Result>());
+  }
+  received_handles.clear();
+
+  // Wait for the goals to expire together
+  rclcpp::sleep_for(2 * result_timeout);
+  rclcpp::spin_some(node);
+
+  auto result_client = node->create_client<Fibonacci::Impl::GetResultService>(
+    "fibonacci/_action/get_result");
+  ASSERT_TRUE(result_client->wait_for_service(std::chrono::seconds(20)));
+  for (const GoalUUID & uuid : uuids) {
+    auto request = std::make_shared<Fibonacci::Impl::GetResultService::Request>();
+    request->goal_id.uuid = uuid;
+    auto future = result_client->async_send_request(request);
+    ASSERT_EQ(
+      rclcpp::FutureReturnCode::SUCCESS,
+      rclcpp::spin_until_future_complete(node, future));
+    EXPECT_EQ(action_msgs::msg::GoalStatus::STATUS_UNKNOWN, future.get()->status);
+  }
+}
+
 TEST_F(TestServer, get_result_deferred)
 {
   auto node = std::make_shared<rclcpp::Node>("get_result", "/rclcpp_action/get_result");
@@ -965,6 +1263,126 @@ TEST_F(TestServer, get_result_deferred)
   EXPECT_EQ(result->sequence, response->result.sequence);
 }
 
+TEST_F(TestServer, goal_execution_pool)
+{
+  auto node = std::make_shared<rclcpp::Node>(
+    "goal_execution_pool", "/rclcpp_action/goal_execution_pool");
+
+  size_t num_handle_goal_calls = 0;
+  auto handle_goal = [&num_handle_goal_calls](
+    const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>)
+    {
+      ++num_handle_goal_calls;
+      return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    };
+
+  using GoalHandle = rclcpp_action::ServerGoalHandle<Fibonacci>;
+
+  auto handle_cancel = [](std::shared_ptr<GoalHandle>)
+    {
+      return rclcpp_action::CancelResponse::REJECT;
+    };
+
+  // The goals block their thread until released
+  std::promise<void> release_promise;
+  std::shared_future<void> release_future(release_promise.get_future());
+  std::mutex executed_mutex;
+  std::vector<std::thread::id> executing_threads;
+  auto handle_accepted = [&](std::shared_ptr<GoalHandle> handle)
+    {
+      {
+        std::lock_guard<std::mutex> lock(executed_mutex);
+        executing_threads.push_back(std::this_thread::get_id());
+      }
+      release_future.wait();
+      handle->succeed(std::make_shared<Fibonacci::Result>());
+    };
+
+  rclcpp_action::GoalExecutionOptions execution_options;
+  execution_options.max_concurrent_goals = 1u;
+  execution_options.max_queued_goals = 1u;
+  auto as = rclcpp_action::create_server<Fibonacci>(
+    node, "fibonacci",
+    handle_goal,
+    handle_cancel,
+    handle_accepted,
+    rcl_action_server_get_default_options(),
+    nullptr,
+    rclcpp_action::GoalStatusPublishingOptions(),
+    execution_options);
+
+  auto client = node->create_client<Fibonacci::Impl::SendGoalService>(
+    "fibonacci/_action/send_goal");
+  ASSERT_TRUE(client->wait_for_service(std::chrono::seconds(20)));
+  auto send_goal = [&node, &client](uint8_t id)
+    {
+      auto request = std::make_shared<Fibonacci::Impl::SendGoalService::Request>();
+      request->goal_id.uuid.fill(id);
+      auto future = client->async_send_request(request);
+      EXPECT_EQ(
+        rclcpp::FutureReturnCode::SUCCESS,
+        rclcpp::spin_until_future_complete(node, future, std::chrono::seconds(10)));
+      return future.get()->accepted;
+    };
+
+  // One goal runs, one goal is queued, the next one is rejected without calling handle_goal.
+  EXPECT_TRUE(send_goal(1u));
+  EXPECT_TRUE(send_goal(2u));
+  EXPECT_FALSE(send_goal(3u));
+  EXPECT_EQ(2u, num_handle_goal_calls);
+
+  release_promise.set_value();
+  auto wait_for_executed_goals = [&executed_mutex, &executing_threads]() {
+      const auto start = std::chrono::steady_clock::now();
+      while (std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+        {
+          std::lock_guard<std::mutex> lock(executed_mutex);
+          if (executing_threads.size() >= 2u) {
+            return true;
+          }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+      return false;
+    };
+  ASSERT_TRUE(wait_for_executed_goals());
+  EXPECT_NE(std::this_thread::get_id(), executing_threads[0]);
+  EXPECT_EQ(executing_threads[0], executing_threads[1]);
+
+  // Once the goals are done, the pool accepts goals again.
+  uint8_t id = 4u;
+  const auto start = std::chrono::steady_clock::now();
+  while (!send_goal(id) && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+    ++id;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(10));
+}
+
+TEST_F(TestServer, goal_execution_pool_invalid_options)
+{
+  auto node = std::make_shared<rclcpp::Node>(
+    "goal_execution_pool_invalid", "/rclcpp_action/goal_execution_pool_invalid");
+  using GoalHandle = rclcpp_action::ServerGoalHandle<Fibonacci>;
+  rclcpp_action::GoalExecutionOptions execution_options;
+  execution_options.max_queued_goals = 1u;
+  EXPECT_THROW(
+    rclcpp_action::create_server<Fibonacci>(
+      node, "fibonacci",
+      [](const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>) {
+        return rclcpp_action::GoalResponse::REJECT;
+      },
+      [](std::shared_ptr<GoalHandle>) {
+        return rclcpp_action::CancelResponse::REJECT;
+      },
+      [](std::shared_ptr<GoalHandle>) {},
+      rcl_action_server_get_default_options(),
+      nullptr,
+      rclcpp_action::GoalStatusPublishingOptions(),
+      execution_options),
+    std::invalid_argument);
+}
+
 TEST_F(TestServer, deferred_execution)
 {
   auto node = std::make_shared<rclcpp::Node>("defer_exec", "/rclcpp_action/defer_exec");
@@ -1339,3 +1757,55 @@ TEST_F(TestDeadlockServer, deadlock_while_succeed_and_canceled)
   EXPECT_EQ(CancelResponse::ERROR_REJECTED, response_ptr->return_code);
   t.join();
 }
+
+TEST_F(TestServer, intra_process_goal_feedback_and_result)
+{
+  auto node = std::make_shared<rclcpp::Node>(
+    "intra_process_action", "/rclcpp_action/intra_process",
+    rclcpp::NodeOptions().use_intra_process_comms(true));
+  using GoalHandle = rclcpp_action::ServerGoalHandle<Fibonacci>;
+  auto as = rclcpp_action::create_server<Fibonacci>(
+    node, "fibonacci",
+    [](const GoalUUID &, std::shared_ptr<const Fibonacci::Goal>) {
+      return rclcpp_action::GoalResponse::ACCEPT_AND_EXECUTE;
+    },
+    [](std::shared_ptr<GoalHandle>) {
+      return rclcpp_action::CancelResponse::REJECT;
+    },
+    [](std::shared_ptr<GoalHandle> handle) {
+      auto & feedback = handle->borrow_feedback();
+      feedback.sequence = {0, 1, 1};
+      handle->publish_borrowed_feedback();
+      // The copy published intra process is not modified.
+      feedback.sequence.clear();
+      auto result = std::make_shared<Fibonacci::Result>();
+      result->sequence = {0, 1, 1, 2};
+      handle->succeed(result);
+    });
+  auto ac = rclcpp_action::create_client<Fibonacci>(node, "fibonacci");
+
+  std::vector<int32_t> feedback_sequence;
+  rclcpp_action::Client<Fibonacci>::SendGoalOptions options;
+  options.feedback_callback =
+    [&feedback_sequence](
+    rclcpp_action::ClientGoalHandle<Fibonacci>::SharedPtr,
+    const std::shared_ptr<const Fibonacci::Feedback> feedback)
+    {
+      feedback_sequence = feedback->sequence;
+    };
+  auto goal_handle_future = ac->async_send_goal(Fibonacci::Goal(), options);
+  ASSERT_EQ(
+    rclcpp::FutureReturnCode::SUCCESS,
+    rclcpp::spin_until_future_complete(node, goal_handle_future, std::chrono::seconds(10)));
+  auto goal_handle = goal_handle_future.get();
+  ASSERT_NE(nullptr, goal_handle);
+
+  auto result_future = ac->async_get_result(goal_handle);
+  ASSERT_EQ(
+    rclcpp::FutureReturnCode::SUCCESS,
+    rclcpp::spin_until_future_complete(node, result_future, std::chrono::seconds(10)));
+  auto wrapped_result = result_future.get();
+  EXPECT_EQ(rclcpp_action::ResultCode::SUCCEEDED, wrapped_result.code);
+  EXPECT_EQ((std::vector<int32_t>{0, 1, 1, 2}), wrapped_result.result->sequence);
+  EXPECT_EQ((std::vector<int32_t>{0, 1, 1}), feedback_sequence);
+}
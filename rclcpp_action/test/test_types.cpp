@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 
 #include <limits>
+#include <unordered_set>
 #include "rclcpp_action/types.hpp"
 
 TEST(TestActionTypes, goal_uuid_to_string) {
@@ -59,3 +60,15 @@ TEST(TestActionTypes, rcl_action_goal_info_to_goal_uuid) {
     EXPECT_EQ(goal_info.goal_id.uuid[i], goal_id[i]);
   }
 }
+
+TEST(TestActionTypes, generate_goal_uuid) {
+  std::unordered_set<rclcpp_action::GoalUUID> goal_ids;
+  std::unordered_set<size_t> hashes;
+  for (size_t i = 0; i < 1000; ++i) {
+    auto goal_id = rclcpp_action::generate_goal_uuid();
+    EXPECT_TRUE(goal_ids.insert(goal_id).second);
+    hashes.insert(std::hash<rclcpp_action::GoalUUID>()(goal_id));
+  }
+  // The hash depends on every byte, so random ids hardly collide.
+  EXPECT_GT(hashes.size(), 990u);
+}
@@ -41,9 +41,13 @@
 #ifndef RCLCPP_COMPONENTS__COMPONENT_MANAGER_HPP__
 #define RCLCPP_COMPONENTS__COMPONENT_MANAGER_HPP__
 
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -52,6 +56,8 @@
 #include "composition_interfaces/srv/list_nodes.hpp"
 
 #include "rclcpp/executor.hpp"
+#include "rclcpp/executor_instrumentation.hpp"
+#include "rclcpp/experimental/intra_process_manager.hpp"
 #include "rclcpp/node_options.hpp"
 #include "rclcpp/rclcpp.hpp"
 
@@ -75,6 +81,28 @@ public:
 };
 
 /// ComponentManager handles the services to load, unload, and get the list of loaded components.
+/**
+ * By default, the nodes of the components are added to the executor given to the constructor.
+ * A component can instead get an executor of its own, spun by a thread of the manager, with
+ * these extra arguments of its load request:
+ * - `executor` (string): `shared` (the default), `single_threaded`, `static_single_threaded`
+ *   or `multi_threaded`.
+ * - `executor_threads` (integer): number of threads of a `multi_threaded` executor, 0 (the
+ *   default) for the number of cores.
+ * - `executor_cpu_affinity` (integer array): CPUs the threads of a dedicated executor may run
+ *   on, only supported on Linux.
+ *
+ * The libraries of the components of the packages listed in the `preload_packages` parameter
+ * are loaded in the background when the manager is created, see preload_component_libraries().
+ *
+ * If the `force_intra_process_comms` parameter is true, intra process communication is enabled
+ * for all components, and the topics on which components still exchange messages inter process
+ * are logged as warnings after loading components, see get_topic_delivery().
+ *
+ * If the `enable_component_accounting` parameter is true, the memory allocated by the rcl
+ * allocator of each component and the time spent in its callbacks are accounted, see
+ * get_component_accounting().
+ */
 class ComponentManager : public rclcpp::Node
 {
 public:
@@ -110,6 +138,9 @@ public:
 
   /// Return a list of valid loadable components in a given package.
   /**
+   * The resource of a package is read from the ament index once, later calls return a copy of
+   * the cached list.
+   *
    * \param package_name name of the package
    * \param resource_index name of the executable
    * \throws ComponentManagerException if the resource was not found or a invalid resource entry
@@ -130,6 +161,107 @@ public:
   virtual std::shared_ptr<rclcpp_components::NodeFactory>
   create_component_factory(const ComponentResource & resource);
 
+  /// Load several components, constructing their nodes in parallel.
+  /**
+   * Each request is handled like a request of the load node service.
+   * The libraries are loaded once each, and the nodes are constructed by up to `max_threads`
+   * threads, then added to the executor in order.
+   * The unique ids of the loaded components follow the order of the requests.
+   *
+   * This must not be called concurrently with the services of the manager, for instance call it
+   * before spinning the executor.
+   *
+   * \param requests the components to load
+   * \param max_threads the number of threads constructing nodes, if 0 the number of cores
+   * \return the response to each request, in the same order
+   * \throws std::overflow_error if the unique ids are exhausted, see on_load_node()
+   */
+  RCLCPP_COMPONENTS_PUBLIC
+  std::vector<std::shared_ptr<LoadNode::Response>>
+  load_nodes(
+    const std::vector<std::shared_ptr<LoadNode::Request>> & requests,
+    size_t max_threads = 0);
+
+  /// Delivery of the messages of a topic between the components of this manager.
+  struct TopicDelivery
+  {
+    std::string topic_name;
+    /// Number of components publishing on the topic.
+    size_t publishing_components = 0;
+    /// Number of components subscribed to the topic.
+    size_t subscribed_components = 0;
+    /// Intra process publishers, subscriptions and routes of the topic in this process.
+    rclcpp::experimental::IntraProcessManager::TopicInfo intra_process;
+    /// True if all messages between the components are delivered intra process.
+    bool intra_process_only = false;
+  };
+
+  /// Return how messages are delivered on the topics used by several components.
+  /**
+   * A topic is only delivered intra process if the publishers and subscriptions of all the
+   * components using it have intra process communication enabled, and all of them are
+   * routed to each other, i.e. none has an incompatible QoS.
+   * Otherwise some messages are serialized and sent through the middleware.
+   * The endpoints of the components are found in the ROS graph.
+   *
+   * \return the topics with at least one publishing and one subscribed component, by name
+   */
+  RCLCPP_COMPONENTS_PUBLIC
+  std::vector<TopicDelivery>
+  get_topic_delivery() const;
+
+  /// Resources used by a loaded component, see get_component_accounting().
+  struct ComponentAccounting
+  {
+    uint64_t unique_id = 0;
+    std::string full_node_name;
+    /// Bytes currently allocated through the rcl allocator of the node options of the component.
+    size_t allocated_bytes = 0;
+    /// Number of allocations through that allocator since the component was loaded.
+    uint64_t allocation_count = 0;
+    /// Executions of the callbacks of the callback groups of the node.
+    rclcpp::ExecutionStatistics execution_statistics;
+  };
+
+  /// Return the resources used by each loaded component, if accounting is enabled.
+  /**
+   * The allocations are counted by the rcl allocator given to the node options of each
+   * component, so they cover the rcl node and not the memory allocated by the component itself.
+   * The executions are only accounted for the executors reporting them to the collector of
+   * this manager: the dedicated executors of the components, and the shared executor if it was
+   * created with that collector, see set_execution_statistics_collector().
+   *
+   * \return the accounting of each loaded component, by unique id, empty if disabled
+   */
+  RCLCPP_COMPONENTS_PUBLIC
+  std::vector<ComponentAccounting>
+  get_component_accounting() const;
+
+  /// Set the collector of the executions, which should also instrument the shared executor.
+  /**
+   * By default, the manager creates its own collector when accounting is enabled, which only
+   * instruments the dedicated executors of the components.
+   * Must be called before loading components.
+   *
+   * \param collector the collector given to the options of the shared executor
+   */
+  RCLCPP_COMPONENTS_PUBLIC
+  void
+  set_execution_statistics_collector(
+    rclcpp::ExecutionStatisticsCollector::SharedPtr collector);
+
+  /// Load the libraries of the components of some packages in the background.
+  /**
+   * The libraries are loaded by a thread of the manager, so that a later request to load one of
+   * these components only has to construct its node.
+   * Packages or libraries which cannot be found or loaded are skipped with a warning.
+   *
+   * \param package_names the packages whose component libraries are loaded
+   */
+  RCLCPP_COMPONENTS_PUBLIC
+  void
+  preload_component_libraries(const std::vector<std::string> & package_names);
+
 protected:
   /// Create node options for loaded component
   /**
@@ -232,11 +364,105 @@ protected:
   }
 
 private:
+  /// Log a warning for each topic newly found not to be delivered intra process only.
+  void
+  warn_about_inter_process_topics();
+
+  /// Return the class loader of a library, loading the library on first use.
+  /**
+   * \throws ComponentManagerException if the library could not be loaded
+   */
+  class_loader::ClassLoader *
+  get_class_loader(const std::string & library_path);
+
+  /// Executor of a single component and the thread spinning it.
+  struct DedicatedExecutor
+  {
+    std::shared_ptr<rclcpp::Executor> executor;
+    std::vector<size_t> cpu_affinity;
+    std::thread thread;
+    /// Ready once the thread has stopped spinning.
+    std::future<void> done;
+  };
+
+  /// Create the dedicated executor requested in the extra arguments of a load request.
+  /**
+   * \return a dedicated executor without executor if the component uses the shared executor
+   * \throws ComponentManagerException if the extra arguments are invalid
+   */
+  DedicatedExecutor
+  create_dedicated_executor(const std::shared_ptr<LoadNode::Request> & request);
+
+  /// Start the thread spinning a dedicated executor, once the node was added to it.
+  /**
+   * \throws std::exception if the cpu affinity of the thread could not be set
+   */
+  void
+  start_dedicated_executor(DedicatedExecutor & dedicated_executor);
+
+  /// Cancel a dedicated executor and wait for its thread.
+  static void
+  stop_dedicated_executor(DedicatedExecutor & dedicated_executor);
+
+  /// Counter of the allocations of the rcl allocator of a component.
+  struct AllocationCounter;
+
+  /// Drops the reference of the manager to an AllocationCounter.
+  struct AllocationCounterRelease
+  {
+    void operator()(AllocationCounter * counter) const;
+  };
+
+  using AllocationCounterPtr = std::unique_ptr<AllocationCounter, AllocationCounterRelease>;
+
+  /// Node of a component, with the executor and allocation counter created for it.
+  struct ComponentInstance
+  {
+    rclcpp_components::NodeInstanceWrapper node_wrapper;
+    DedicatedExecutor dedicated_executor;
+    AllocationCounterPtr allocation_counter;
+  };
+
+  /// Find the requested component and construct its node.
+  /**
+   * \return false and the response filled in if the component could not be loaded
+   */
+  bool
+  create_node_instance(
+    const std::shared_ptr<LoadNode::Request> & request,
+    ComponentInstance & instance,
+    LoadNode::Response & response);
+
+  /// Give a unique id to the node of a loaded component and add it to its executor.
+  void
+  add_node_instance(ComponentInstance && instance, LoadNode::Response & response);
+
   std::weak_ptr<rclcpp::Executor> executor_;
 
   uint64_t unique_id_ {1};
+  /// Lock for loaders_, libraries may be loaded in parallel by load_nodes() and preloading.
+  std::mutex loaders_mutex_;
   std::map<std::string, std::unique_ptr<class_loader::ClassLoader>> loaders_;
+  /// Lock for component_resources_.
+  mutable std::mutex component_resources_mutex_;
+  /// Cached results of get_component_resources(), by resource index and package.
+  mutable std::map<std::pair<std::string, std::string>, std::vector<ComponentResource>>
+  component_resources_;
+  /// Value of the force_intra_process_comms parameter.
+  bool force_intra_process_comms_ {false};
+  /// Topics already reported by warn_about_inter_process_topics().
+  std::set<std::string> inter_process_topics_;
+  /// Value of the enable_component_accounting parameter.
+  bool component_accounting_ {false};
+  /// Collector of the executions of the components, if accounting is enabled.
+  rclcpp::ExecutionStatisticsCollector::SharedPtr execution_statistics_;
+  /// Threads started by preload_component_libraries(), joined by the destructor.
+  std::vector<std::thread> preload_threads_;
   std::map<uint64_t, rclcpp_components::NodeInstanceWrapper> node_wrappers_;
+  /// Executors of the components which do not use the shared executor, by unique id.
+  std::map<uint64_t, DedicatedExecutor> dedicated_executors_;
+  /// Allocation counters of the components, by unique id, if accounting is enabled.
+  std::map<uint64_t, AllocationCounterPtr> allocation_counters_;
 
   rclcpp::Service<LoadNode>::SharedPtr loadNode_srv_;
   rclcpp::Service<UnloadNode>::SharedPtr unloadNode_srv_;
@@ -0,0 +1,203 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP_COMPONENTS__FLIGHT_RECORDER_HPP__
+#define RCLCPP_COMPONENTS__FLIGHT_RECORDER_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "std_srvs/srv/trigger.hpp"
+
+#include "rclcpp_components/visibility_control.hpp"
+
+namespace rclcpp_components
+{
+
+/// Message of a flight recording.
+struct FlightRecord
+{
+  std::string topic_name;
+  std::string topic_type;
+  /// Time the message was received at, in nanoseconds, according to the clock of the recorder.
+  int64_t receive_time;
+  rclcpp::SerializedMessage message;
+};
+
+/// Ring of the last serialized messages received, in a memory-mapped file.
+/**
+ * The file is allocated at its full size when created, and mapped in memory, so writing a
+ * message is a copy into the mapping, evicting the oldest messages as needed, without any
+ * system call.
+ * The kernel writes the mapping back to the file, so the recording survives a crash of the
+ * process, but not a crash of the system.
+ *
+ * The file starts with a header, followed by the table of the recorded topics and by the ring of
+ * the messages, each preceded by the index of its topic, its receive time and its size.
+ * The header holds the positions of the oldest message and of the next one, the latter being
+ * updated once a message is completely written, so that a recording interrupted by a crash
+ * can be read back with read().
+ *
+ * This class is not thread-safe.
+ */
+class FlightRecorderFile
+{
+public:
+  /// Create the file, replacing any existing one.
+  /**
+   * \param[in] filename the name of the file.
+   * \param[in] capacity the number of bytes of the ring of messages.
+   * \param[in] topics_capacity the number of bytes of the table of topics.
+   * \throws std::invalid_argument if a capacity is too small.
+   * \throws std::system_error if the file cannot be created or mapped.
+   */
+  RCLCPP_COMPONENTS_PUBLIC
+  FlightRecorderFile(
+    const std::string & filename,
+    size_t capacity,
+    size_t topics_capacity = 64 * 1024);
+
+  RCLCPP_COMPONENTS_PUBLIC
+  ~FlightRecorderFile();
+
+  FlightRecorderFile(const FlightRecorderFile &) = delete;
+  FlightRecorderFile & operator=(const FlightRecorderFile &) = delete;
+
+  /// Add a topic to the table of topics.
+  /**
+   * \return the index of the topic, to write its messages with.
+   * \throws std::length_error if the table of topics is full.
+   */
+  RCLCPP_COMPONENTS_PUBLIC
+  uint32_t
+  add_topic(const std::string & topic_name, const std::string & topic_type);
+
+  /// Write a message, evicting the oldest ones if the ring is full.
+  /**
+   * \param[in] topic_index the index of the topic of the message, returned by add_topic().
+   * \param[in] receive_time the time the message was received at, in nanoseconds.
+   * \param[in] message the serialized message.
+   * \return false if the message is larger than the ring, so not written.
+   * \throws std::out_of_range if the topic index is not the one of a topic.
+   */
+  RCLCPP_COMPONENTS_PUBLIC
+  bool
+  write(uint32_t topic_index, int64_t receive_time, const rcl_serialized_message_t & message);
+
+  /// Write the messages received from a given time to a new file, e.g. after an incident.
+  /**
+   * The new file has the format of this one, with a ring just large enough for the messages.
+   *
+   * \param[in] filename the name of the new file.
+   * \param[in] since the receive time of the oldest message to write, in nanoseconds.
+   * \throws std::system_error if the file cannot be created or mapped.
+   */
+  RCLCPP_COMPONENTS_PUBLIC
+  void
+  dump(const std::string & filename, int64_t since) const;
+
+  /// Read the messages of a file, from the oldest to the newest.
+  /**
+   * \throws std::system_error if the file cannot be read.
+   * \throws std::runtime_error if the file is not a valid flight recording.
+   */
+  RCLCPP_COMPONENTS_PUBLIC
+  static std::vector<FlightRecord>
+  read(const std::string & filename);
+
+private:
+  struct FileHeader;
+
+  FileHeader &
+  header() const;
+
+  uint8_t *
+  ring() const;
+
+  bool
+  write(uint32_t topic_index, int64_t receive_time, const uint8_t * data, size_t size);
+
+  int fd_;
+  uint8_t * mapping_;
+  size_t mapping_size_;
+  std::vector<std::pair<std::string, std::string>> topics_;
+};
+
+/// Component recording the last messages of all the topics, or of the given ones.
+/**
+ * The messages are recorded without being deserialized, with rclcpp::GenericSubscription, in
+ * a FlightRecorderFile whose size bounds the duration of the recording, so that the recorder
+ * can be always on, as the flight recorder of an aircraft.
+ * The recording can be written to a separate file on an incident, with the `~/dump` service,
+ * and the file survives a crash of the process.
+ *
+ * Parameters:
+ * - `file` (string, "flight_recorder.ring"): the file of the recording, created at startup.
+ * - `capacity` (integer, 256 MiB): the number of bytes of the ring of messages.
+ * - `topics` (string array, all the topics if empty): the topics to record.
+ * - `discovery_period` (double, 1.0): the period in seconds of the discovery of the topics.
+ * - `dump_duration` (double, 60.0): the duration in seconds of the messages written by the
+ *   `~/dump` service, to a file named after the recording file and the current time.
+ */
+class FlightRecorder : public rclcpp::Node
+{
+public:
+  RCLCPP_COMPONENTS_PUBLIC
+  explicit FlightRecorder(const rclcpp::NodeOptions & options);
+
+  RCLCPP_COMPONENTS_PUBLIC
+  virtual ~FlightRecorder();
+
+  /// Write the messages of the last `dump_duration` seconds to a new file.
+  /**
+   * \param[in] filename the name of the new file.
+   * \throws std::system_error if the file cannot be created or mapped.
+   */
+  RCLCPP_COMPONENTS_PUBLIC
+  void
+  dump(const std::string & filename);
+
+private:
+  void
+  discover_topics();
+
+  void
+  on_dump(
+    const std::shared_ptr<std_srvs::srv::Trigger::Request> request,
+    std::shared_ptr<std_srvs::srv::Trigger::Response> response);
+
+  std::string filename_;
+  std::vector<std::string> topics_;
+  rclcpp::Duration dump_duration_;
+
+  std::mutex file_mutex_;
+  std::unique_ptr<FlightRecorderFile> file_;
+  size_t dropped_count_{0};
+
+  std::map<std::string, rclcpp::GenericSubscription::SharedPtr> subscriptions_;
+  rclcpp::TimerBase::SharedPtr discovery_timer_;
+  rclcpp::Service<std_srvs::srv::Trigger>::SharedPtr dump_service_;
+};
+
+}  // namespace rclcpp_components
+
+#endif  // RCLCPP_COMPONENTS__FLIGHT_RECORDER_HPP__
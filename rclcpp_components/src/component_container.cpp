@@ -22,8 +22,13 @@ int main(int argc, char * argv[])
 {
   /// Component container with a single-threaded executor.
   rclcpp::init(argc, argv);
-  auto exec = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  // The executions are attributed to the components if component accounting is enabled.
+  auto execution_statistics = std::make_shared<rclcpp::ExecutionStatisticsCollector>();
+  rclcpp::ExecutorOptions options;
+  options.instrumentation = execution_statistics;
+  auto exec = std::make_shared<rclcpp::executors::SingleThreadedExecutor>(options);
   auto node = std::make_shared<rclcpp_components::ComponentManager>(exec);
+  node->set_execution_statistics_collector(execution_statistics);
   exec->add_node(node);
   exec->spin();
 }
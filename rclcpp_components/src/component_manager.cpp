@@ -14,14 +14,33 @@
 
 #include "rclcpp_components/component_manager.hpp"
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "ament_index_cpp/get_resource.hpp"
 #include "class_loader/class_loader.hpp"
+#include "rcl/allocator.h"
 #include "rcpputils/filesystem_helper.hpp"
 #include "rcpputils/split.hpp"
 
@@ -30,6 +49,151 @@ using namespace std::placeholders;
 namespace rclcpp_components
 {
 
+namespace
+{
+
+void
+set_cpu_affinity(const std::vector<size_t> & cpu_affinity)
+{
+  if (cpu_affinity.empty()) {
+    return;
+  }
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (size_t cpu : cpu_affinity) {
+    if (cpu >= CPU_SETSIZE) {
+      throw std::invalid_argument("cpu " + std::to_string(cpu) + " out of range");
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+  int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (ret != 0) {
+    throw std::system_error(
+            ret, std::generic_category(), "failed to set cpu affinity of component executor");
+  }
+#else
+  throw std::runtime_error("cpu affinity of component executors is only supported on Linux");
+#endif
+}
+
+}  // namespace
+
+struct ComponentManager::AllocationCounter
+{
+  std::atomic<size_t> allocated_bytes{0};
+  std::atomic<uint64_t> allocation_count{0};
+  /// One reference for the manager and one for each live allocation, which may outlive it.
+  std::atomic<size_t> references{1};
+
+  void
+  release()
+  {
+    if (references.fetch_sub(1) == 1) {
+      delete this;
+    }
+  }
+
+  rcl_allocator_t
+  get_allocator();
+};
+
+void
+ComponentManager::AllocationCounterRelease::operator()(AllocationCounter * counter) const
+{
+  counter->release();
+}
+
+namespace
+{
+
+// Each allocation is prefixed with its size, so that deallocations can be accounted.
+constexpr size_t allocation_header_size = alignof(std::max_align_t);
+static_assert(allocation_header_size >= sizeof(size_t), "allocation header too small");
+
+template<typename CounterT>
+void *
+counted_allocate(size_t size, void * state)
+{
+  auto counter = static_cast<CounterT *>(state);
+  auto header = static_cast<char *>(std::malloc(size + allocation_header_size));
+  if (nullptr == header) {
+    return nullptr;
+  }
+  std::memcpy(header, &size, sizeof(size));
+  counter->allocated_bytes += size;
+  ++counter->allocation_count;
+  ++counter->references;
+  return header + allocation_header_size;
+}
+
+template<typename CounterT>
+void
+counted_deallocate(void * pointer, void * state)
+{
+  if (nullptr == pointer) {
+    return;
+  }
+  auto counter = static_cast<CounterT *>(state);
+  char * header = static_cast<char *>(pointer) - allocation_header_size;
+  size_t size;
+  std::memcpy(&size, header, sizeof(size));
+  std::free(header);
+  counter->allocated_bytes -= size;
+  counter->release();
+}
+
+template<typename CounterT>
+void *
+counted_reallocate(void * pointer, size_t size, void * state)
+{
+  if (nullptr == pointer) {
+    return counted_allocate<CounterT>(size, state);
+  }
+  auto counter = static_cast<CounterT *>(state);
+  char * header = static_cast<char *>(pointer) - allocation_header_size;
+  size_t old_size;
+  std::memcpy(&old_size, header, sizeof(old_size));
+  header = static_cast<char *>(std::realloc(header, size + allocation_header_size));
+  if (nullptr == header) {
+    return nullptr;
+  }
+  std::memcpy(header, &size, sizeof(size));
+  counter->allocated_bytes += size;
+  counter->allocated_bytes -= old_size;
+  ++counter->allocation_count;
+  return header + allocation_header_size;
+}
+
+template<typename CounterT>
+void *
+counted_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (size_of_element != 0 && number_of_elements > SIZE_MAX / size_of_element) {
+    return nullptr;
+  }
+  const size_t size = number_of_elements * size_of_element;
+  void * pointer = counted_allocate<CounterT>(size, state);
+  if (nullptr != pointer) {
+    std::memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+}  // namespace
+
+rcl_allocator_t
+ComponentManager::AllocationCounter::get_allocator()
+{
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  allocator.allocate = counted_allocate<AllocationCounter>;
+  allocator.deallocate = counted_deallocate<AllocationCounter>;
+  allocator.reallocate = counted_reallocate<AllocationCounter>;
+  allocator.zero_allocate = counted_zero_allocate<AllocationCounter>;
+  allocator.state = this;
+  return allocator;
+}
+
 ComponentManager::ComponentManager(
   std::weak_ptr<rclcpp::Executor> executor,
   std::string node_name,
@@ -46,15 +210,35 @@ ComponentManager::ComponentManager(
   listNodes_srv_ = create_service<ListNodes>(
     "~/_container/list_nodes",
     std::bind(&ComponentManager::on_list_nodes, this, _1, _2, _3));
+
+  force_intra_process_comms_ = declare_parameter<bool>("force_intra_process_comms", false);
+  component_accounting_ = declare_parameter<bool>("enable_component_accounting", false);
+  if (component_accounting_) {
+    execution_statistics_ = std::make_shared<rclcpp::ExecutionStatisticsCollector>();
+  }
+
+  auto preload_packages =
+    declare_parameter<std::vector<std::string>>("preload_packages", std::vector<std::string>());
+  if (!preload_packages.empty()) {
+    preload_component_libraries(preload_packages);
+  }
 }
 
 ComponentManager::~ComponentManager()
 {
+  for (auto & preload_thread : preload_threads_) {
+    preload_thread.join();
+  }
+  for (auto & dedicated_executor : dedicated_executors_) {
+    stop_dedicated_executor(dedicated_executor.second);
+  }
   if (node_wrappers_.size()) {
     RCLCPP_DEBUG(get_logger(), "Removing components from executor");
     if (auto exec = executor_.lock()) {
       for (auto & wrapper : node_wrappers_) {
-        exec->remove_node(wrapper.second.get_node_base_interface());
+        if (dedicated_executors_.count(wrapper.first) == 0) {
+          exec->remove_node(wrapper.second.get_node_base_interface());
+        }
       }
     }
   }
@@ -64,6 +248,15 @@ std::vector<ComponentManager::ComponentResource>
 ComponentManager::get_component_resources(
   const std::string & package_name, const std::string & resource_index) const
 {
+  auto key = std::make_pair(resource_index, package_name);
+  {
+    std::lock_guard<std::mutex> lock(component_resources_mutex_);
+    auto it = component_resources_.find(key);
+    if (it != component_resources_.end()) {
+      return it->second;
+    }
+  }
+
   std::string content;
   std::string base_path;
   if (
@@ -87,9 +280,162 @@ ComponentManager::get_component_resources(
     }
     resources.push_back({parts[0], library_path});
   }
+
+  std::lock_guard<std::mutex> lock(component_resources_mutex_);
+  component_resources_.emplace(std::move(key), resources);
   return resources;
 }
 
+std::vector<ComponentManager::TopicDelivery>
+ComponentManager::get_topic_delivery() const
+{
+  std::map<std::string, TopicDelivery> topics;
+  auto node_graph = get_node_graph_interface();
+  for (const auto & wrapper : node_wrappers_) {
+    auto node = wrapper.second.get_node_base_interface();
+    try {
+      for (const auto & publisher : node_graph->get_publisher_names_and_types_by_node(
+          node->get_name(), node->get_namespace()))
+      {
+        ++topics[publisher.first].publishing_components;
+      }
+      for (const auto & subscription : node_graph->get_subscriber_names_and_types_by_node(
+          node->get_name(), node->get_namespace()))
+      {
+        ++topics[subscription.first].subscribed_components;
+      }
+    } catch (const std::exception & ex) {
+      RCLCPP_DEBUG(
+        get_logger(), "Failed to get the topics of node '%s': %s",
+        node->get_fully_qualified_name(), ex.what());
+    }
+  }
+
+  auto ipm = get_node_base_interface()->get_context()->
+    get_sub_context<rclcpp::experimental::IntraProcessManager>();
+  for (auto & topic_info : ipm->get_topic_info()) {
+    auto it = topics.find(topic_info.topic_name);
+    if (it != topics.end()) {
+      it->second.intra_process = std::move(topic_info);
+    }
+  }
+
+  std::vector<TopicDelivery> topic_delivery;
+  for (auto & topic_pair : topics) {
+    auto & topic = topic_pair.second;
+    if (topic.publishing_components == 0 || topic.subscribed_components == 0) {
+      continue;
+    }
+    topic.topic_name = topic_pair.first;
+    topic.intra_process_only =
+      topic.publishing_components <= topic.intra_process.publisher_count &&
+      topic.subscribed_components <= topic.intra_process.subscription_count &&
+      topic.intra_process.route_count ==
+      topic.intra_process.publisher_count * topic.intra_process.subscription_count;
+    topic_delivery.push_back(std::move(topic));
+  }
+  return topic_delivery;
+}
+
+void
+ComponentManager::warn_about_inter_process_topics()
+{
+  for (const auto & topic : get_topic_delivery()) {
+    if (topic.intra_process_only || !inter_process_topics_.insert(topic.topic_name).second) {
+      continue;
+    }
+    RCLCPP_WARN(
+      get_logger(), "Topic '%s' is delivered inter process between components: "
+      "%zu publishing and %zu subscribed components, %zu intra process publishers and "
+      "%zu subscriptions with %zu routes between them",
+      topic.topic_name.c_str(), topic.publishing_components, topic.subscribed_components,
+      topic.intra_process.publisher_count, topic.intra_process.subscription_count,
+      topic.intra_process.route_count);
+  }
+}
+
+std::vector<ComponentManager::ComponentAccounting>
+ComponentManager::get_component_accounting() const
+{
+  std::vector<ComponentAccounting> accounting;
+  if (!component_accounting_) {
+    return accounting;
+  }
+  accounting.reserve(node_wrappers_.size());
+  for (const auto & wrapper : node_wrappers_) {
+    ComponentAccounting component;
+    component.unique_id = wrapper.first;
+    auto node = wrapper.second.get_node_base_interface();
+    component.full_node_name = node->get_fully_qualified_name();
+
+    auto counter = allocation_counters_.find(wrapper.first);
+    if (counter != allocation_counters_.end()) {
+      component.allocated_bytes = counter->second->allocated_bytes.load();
+      component.allocation_count = counter->second->allocation_count.load();
+    }
+
+    if (execution_statistics_) {
+      auto & total = component.execution_statistics;
+      node->for_each_callback_group(
+        [this, &total](rclcpp::CallbackGroup::SharedPtr group) {
+          auto statistics = execution_statistics_->get_callback_group_statistics(group.get());
+          total.count += statistics.count;
+          total.total_duration += statistics.total_duration;
+          total.max_duration = std::max(total.max_duration, statistics.max_duration);
+          total.total_dispatch_latency += statistics.total_dispatch_latency;
+          total.max_dispatch_latency =
+          std::max(total.max_dispatch_latency, statistics.max_dispatch_latency);
+        });
+    }
+    accounting.push_back(std::move(component));
+  }
+  return accounting;
+}
+
+void
+ComponentManager::set_execution_statistics_collector(
+  rclcpp::ExecutionStatisticsCollector::SharedPtr collector)
+{
+  execution_statistics_ = std::move(collector);
+}
+
+void
+ComponentManager::preload_component_libraries(const std::vector<std::string> & package_names)
+{
+  // Resolve the libraries here, the thread must not call virtual functions of a derived class
+  // which might not be constructed yet
+  std::vector<std::string> library_paths;
+  for (const auto & package_name : package_names) {
+    try {
+      for (const auto & resource : get_component_resources(package_name)) {
+        if (std::find(library_paths.begin(), library_paths.end(), resource.second) ==
+          library_paths.end())
+        {
+          library_paths.push_back(resource.second);
+        }
+      }
+    } catch (const ComponentManagerException & ex) {
+      RCLCPP_WARN(
+        get_logger(), "Failed to preload the components of package '%s': %s",
+        package_name.c_str(), ex.what());
+    }
+  }
+  if (library_paths.empty()) {
+    return;
+  }
+
+  preload_threads_.emplace_back(
+    [this, library_paths = std::move(library_paths)]() {
+      for (const auto & library_path : library_paths) {
+        try {
+          get_class_loader(library_path);
+        } catch (const ComponentManagerException & ex) {
+          RCLCPP_WARN(get_logger(), "Failed to preload library: %s", ex.what());
+        }
+      }
+    });
+}
+
 std::shared_ptr<rclcpp_components::NodeFactory>
 ComponentManager::create_component_factory(const ComponentResource & resource)
 {
@@ -97,18 +443,7 @@ ComponentManager::create_component_factory(const ComponentResource & resource)
   std::string class_name = resource.first;
   std::string fq_class_name = "rclcpp_components::NodeFactoryTemplate<" + class_name + ">";
 
-  class_loader::ClassLoader * loader;
-  if (loaders_.find(library_path) == loaders_.end()) {
-    RCLCPP_INFO(get_logger(), "Load Library: %s", library_path.c_str());
-    try {
-      loaders_[library_path] = std::make_unique<class_loader::ClassLoader>(library_path);
-    } catch (const std::exception & ex) {
-      throw ComponentManagerException("Failed to load library: " + std::string(ex.what()));
-    } catch (...) {
-      throw ComponentManagerException("Failed to load library");
-    }
-  }
-  loader = loaders_[library_path].get();
+  class_loader::ClassLoader * loader = get_class_loader(library_path);
 
   auto classes = loader->getAvailableClasses<rclcpp_components::NodeFactory>();
   for (const auto & clazz : classes) {
@@ -121,6 +456,26 @@ ComponentManager::create_component_factory(const ComponentResource & resource)
   return {};
 }
 
+class_loader::ClassLoader *
+ComponentManager::get_class_loader(const std::string & library_path)
+{
+  // Held while loading, so that components of the same library load it only once
+  std::lock_guard<std::mutex> lock(loaders_mutex_);
+  auto it = loaders_.find(library_path);
+  if (it == loaders_.end()) {
+    RCLCPP_INFO(get_logger(), "Load Library: %s", library_path.c_str());
+    try {
+      it = loaders_.emplace(
+        library_path, std::make_unique<class_loader::ClassLoader>(library_path)).first;
+    } catch (const std::exception & ex) {
+      throw ComponentManagerException("Failed to load library: " + std::string(ex.what()));
+    } catch (...) {
+      throw ComponentManagerException("Failed to load library");
+    }
+  }
+  return it->second.get();
+}
+
 rclcpp::NodeOptions
 ComponentManager::create_node_options(const std::shared_ptr<LoadNode::Request> request)
 {
@@ -159,21 +514,154 @@ ComponentManager::create_node_options(const std::shared_ptr<LoadNode::Request> r
         throw ComponentManagerException(
                 "Extra component argument 'use_intra_process_comms' must be a boolean");
       }
+      if (force_intra_process_comms_ && !extra_argument.get_value<bool>()) {
+        throw ComponentManagerException(
+                "Extra component argument 'use_intra_process_comms' cannot be false, "
+                "the container forces intra process communication");
+      }
       options.use_intra_process_comms(extra_argument.get_value<bool>());
+    } else if (extra_argument.get_name() == "use_shared_infrastructure") {
+      if (extra_argument.get_type() != rclcpp::ParameterType::PARAMETER_BOOL) {
+        throw ComponentManagerException(
+                "Extra component argument 'use_shared_infrastructure' must be a boolean");
+      }
+      options.use_shared_infrastructure(extra_argument.get_value<bool>());
     }
   }
 
+  if (force_intra_process_comms_) {
+    options.use_intra_process_comms(true);
+  }
+
   return options;
 }
 
+ComponentManager::DedicatedExecutor
+ComponentManager::create_dedicated_executor(const std::shared_ptr<LoadNode::Request> & request)
+{
+  std::string executor_type = "shared";
+  int64_t executor_threads = 0;
+  std::vector<size_t> cpu_affinity;
+  for (const auto & a : request->extra_arguments) {
+    const rclcpp::Parameter extra_argument = rclcpp::Parameter::from_parameter_msg(a);
+    if (extra_argument.get_name() == "executor") {
+      if (extra_argument.get_type() != rclcpp::ParameterType::PARAMETER_STRING) {
+        throw ComponentManagerException(
+                "Extra component argument 'executor' must be a string");
+      }
+      executor_type = extra_argument.get_value<std::string>();
+    } else if (extra_argument.get_name() == "executor_threads") {
+      if (extra_argument.get_type() != rclcpp::ParameterType::PARAMETER_INTEGER ||
+        extra_argument.get_value<int64_t>() < 0)
+      {
+        throw ComponentManagerException(
+                "Extra component argument 'executor_threads' must be a non-negative integer");
+      }
+      executor_threads = extra_argument.get_value<int64_t>();
+    } else if (extra_argument.get_name() == "executor_cpu_affinity") {
+      if (extra_argument.get_type() != rclcpp::ParameterType::PARAMETER_INTEGER_ARRAY) {
+        throw ComponentManagerException(
+                "Extra component argument 'executor_cpu_affinity' must be an integer array");
+      }
+      for (int64_t cpu : extra_argument.get_value<std::vector<int64_t>>()) {
+        if (cpu < 0) {
+          throw ComponentManagerException(
+                  "Extra component argument 'executor_cpu_affinity' must not be negative");
+        }
+        cpu_affinity.push_back(static_cast<size_t>(cpu));
+      }
+    }
+  }
+
+  if (executor_threads != 0 && executor_type != "multi_threaded") {
+    throw ComponentManagerException(
+            "Extra component argument 'executor_threads' requires a multi_threaded executor");
+  }
+
+  DedicatedExecutor dedicated_executor;
+  rclcpp::ExecutorOptions options;
+  options.context = get_node_base_interface()->get_context();
+  if (component_accounting_) {
+    options.instrumentation = execution_statistics_;
+  }
+  if (executor_type == "shared") {
+    if (!cpu_affinity.empty()) {
+      throw ComponentManagerException(
+              "Extra component argument 'executor_cpu_affinity' requires a dedicated executor");
+    }
+    return dedicated_executor;
+  } else if (executor_type == "single_threaded") {
+    dedicated_executor.executor =
+      std::make_shared<rclcpp::executors::SingleThreadedExecutor>(options);
+  } else if (executor_type == "static_single_threaded") {
+    dedicated_executor.executor =
+      std::make_shared<rclcpp::executors::StaticSingleThreadedExecutor>(options);
+  } else if (executor_type == "multi_threaded") {
+    dedicated_executor.executor = std::make_shared<rclcpp::executors::MultiThreadedExecutor>(
+      options, static_cast<size_t>(executor_threads));
+  } else {
+    throw ComponentManagerException(
+            "Extra component argument 'executor' must be one of 'shared', 'single_threaded', "
+            "'static_single_threaded' or 'multi_threaded'");
+  }
+  dedicated_executor.cpu_affinity = std::move(cpu_affinity);
+  return dedicated_executor;
+}
+
 void
-ComponentManager::on_load_node(
-  const std::shared_ptr<rmw_request_id_t> request_header,
-  const std::shared_ptr<LoadNode::Request> request,
-  std::shared_ptr<LoadNode::Response> response)
+ComponentManager::start_dedicated_executor(DedicatedExecutor & dedicated_executor)
 {
-  (void) request_header;
+  std::promise<void> started;
+  std::future<void> started_future = started.get_future();
+  std::promise<void> done;
+  dedicated_executor.done = done.get_future();
+
+  // The threads of a multi-threaded executor inherit the cpu affinity of the spinning thread.
+  dedicated_executor.thread = std::thread(
+    [executor = dedicated_executor.executor, cpu_affinity = dedicated_executor.cpu_affinity,
+    logger = get_logger(), started = std::move(started), done = std::move(done)]() mutable {
+      try {
+        set_cpu_affinity(cpu_affinity);
+      } catch (...) {
+        started.set_exception(std::current_exception());
+        done.set_value();
+        return;
+      }
+      started.set_value();
+      try {
+        executor->spin();
+      } catch (const std::exception & ex) {
+        RCLCPP_ERROR(logger, "Component executor stopped spinning: %s", ex.what());
+      }
+      done.set_value();
+    });
+
+  try {
+    started_future.get();
+  } catch (...) {
+    dedicated_executor.thread.join();
+    throw;
+  }
+}
+
+void
+ComponentManager::stop_dedicated_executor(DedicatedExecutor & dedicated_executor)
+{
+  // Cancel until the thread is done, as a cancel before spin() started would be lost
+  const auto period = std::chrono::milliseconds(10);
+  dedicated_executor.executor->cancel();
+  while (dedicated_executor.done.wait_for(period) != std::future_status::ready) {
+    dedicated_executor.executor->cancel();
+  }
+  dedicated_executor.thread.join();
+}
 
+bool
+ComponentManager::create_node_instance(
+  const std::shared_ptr<LoadNode::Request> & request,
+  ComponentInstance & instance,
+  LoadNode::Response & response)
+{
   try {
     auto resources = get_component_resources(request->package_name);
 
@@ -188,21 +676,14 @@ ComponentManager::on_load_node(
       }
 
       auto options = create_node_options(request);
-      auto node_id = unique_id_++;
-
-      if (0 == node_id) {
-        // This puts a technical limit on the number of times you can add a component.
-        // But even if you could add (and remove) them at 1 kHz (very optimistic rate)
-        // it would still be a very long time before you could exhaust the pool of id's:
-        //   2^64 / 1000 times per sec / 60 sec / 60 min / 24 hours / 365 days = 584,942,417 years
-        // So around 585 million years. Even at 1 GHz, it would take 585 years.
-        // I think it's safe to avoid trying to handle overflow.
-        // If we roll over then it's most likely a bug.
-        throw std::overflow_error("exhausted the unique ids for components in this process");
+      instance.dedicated_executor = create_dedicated_executor(request);
+      if (component_accounting_) {
+        instance.allocation_counter.reset(new AllocationCounter());
+        options.allocator(instance.allocation_counter->get_allocator());
       }
 
       try {
-        node_wrappers_[node_id] = factory->create_node_instance(options);
+        instance.node_wrapper = factory->create_node_instance(options);
       } catch (const std::exception & ex) {
         // In the case that the component constructor throws an exception,
         // rethrow into the following catch block.
@@ -213,29 +694,143 @@ ComponentManager::on_load_node(
         // rethrow into the following catch block.
         throw ComponentManagerException("Component constructor threw an exception");
       }
-
-      auto node = node_wrappers_[node_id].get_node_base_interface();
-      if (auto exec = executor_.lock()) {
-        exec->add_node(node, true);
-      }
-      response->full_node_name = node->get_fully_qualified_name();
-      response->unique_id = node_id;
-      response->success = true;
-      return;
+      return true;
     }
     RCLCPP_ERROR(
       get_logger(), "Failed to find class with the requested plugin name '%s' in "
       "the loaded library",
       request->plugin_name.c_str());
-    response->error_message = "Failed to find class with the requested plugin name.";
-    response->success = false;
+    response.error_message = "Failed to find class with the requested plugin name.";
+    response.success = false;
   } catch (const ComponentManagerException & ex) {
     RCLCPP_ERROR(get_logger(), "%s", ex.what());
-    response->error_message = ex.what();
-    response->success = false;
+    response.error_message = ex.what();
+    response.success = false;
+  }
+  return false;
+}
+
+void
+ComponentManager::add_node_instance(ComponentInstance && instance, LoadNode::Response & response)
+{
+  auto node_id = unique_id_++;
+
+  if (0 == node_id) {
+    // This puts a technical limit on the number of times you can add a component.
+    // But even if you could add (and remove) them at 1 kHz (very optimistic rate)
+    // it would still be a very long time before you could exhaust the pool of id's:
+    //   2^64 / 1000 times per sec / 60 sec / 60 min / 24 hours / 365 days = 584,942,417 years
+    // So around 585 million years. Even at 1 GHz, it would take 585 years.
+    // I think it's safe to avoid trying to handle overflow.
+    // If we roll over then it's most likely a bug.
+    throw std::overflow_error("exhausted the unique ids for components in this process");
+  }
+
+  auto node = instance.node_wrapper.get_node_base_interface();
+  auto & dedicated_executor = instance.dedicated_executor;
+  if (dedicated_executor.executor) {
+    dedicated_executor.executor->add_node(node, false);
+    try {
+      start_dedicated_executor(dedicated_executor);
+    } catch (const std::exception & ex) {
+      RCLCPP_ERROR(get_logger(), "Failed to start component executor: %s", ex.what());
+      response.error_message =
+        "Failed to start component executor: " + std::string(ex.what());
+      response.success = false;
+      return;
+    }
+    dedicated_executors_[node_id] = std::move(dedicated_executor);
+  } else if (auto exec = executor_.lock()) {
+    exec->add_node(node, true);
+  }
+  if (instance.allocation_counter) {
+    allocation_counters_[node_id] = std::move(instance.allocation_counter);
+  }
+  node_wrappers_[node_id] = std::move(instance.node_wrapper);
+  response.full_node_name = node->get_fully_qualified_name();
+  response.unique_id = node_id;
+  response.success = true;
+}
+
+void
+ComponentManager::on_load_node(
+  const std::shared_ptr<rmw_request_id_t> request_header,
+  const std::shared_ptr<LoadNode::Request> request,
+  std::shared_ptr<LoadNode::Response> response)
+{
+  (void) request_header;
+
+  ComponentInstance instance;
+  if (create_node_instance(request, instance, *response)) {
+    add_node_instance(std::move(instance), *response);
+  }
+  if (force_intra_process_comms_ && response->success) {
+    warn_about_inter_process_topics();
   }
 }
 
+std::vector<std::shared_ptr<ComponentManager::LoadNode::Response>>
+ComponentManager::load_nodes(
+  const std::vector<std::shared_ptr<LoadNode::Request>> & requests,
+  size_t max_threads)
+{
+  std::vector<std::shared_ptr<LoadNode::Response>> responses;
+  responses.reserve(requests.size());
+  for (size_t i = 0; i < requests.size(); ++i) {
+    responses.push_back(std::make_shared<LoadNode::Response>());
+  }
+  std::vector<ComponentInstance> instances(requests.size());
+  std::vector<char> created(requests.size(), false);
+
+  // Each thread takes the next request until none is left
+  std::atomic<size_t> next_request{0};
+  auto create_node_instances =
+    [this, &requests, &responses, &instances, &created, &next_request]() {
+      for (size_t i = next_request++; i < requests.size(); i = next_request++) {
+        try {
+          created[i] = create_node_instance(requests[i], instances[i], *responses[i]);
+        } catch (const std::exception & ex) {
+          RCLCPP_ERROR(get_logger(), "Failed to load component: %s", ex.what());
+          responses[i]->error_message = ex.what();
+          responses[i]->success = false;
+        } catch (...) {
+          RCLCPP_ERROR(get_logger(), "Failed to load component");
+          responses[i]->error_message = "Failed to load component";
+          responses[i]->success = false;
+        }
+      }
+    };
+
+  if (0u == max_threads) {
+    max_threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  const size_t num_threads = std::min(max_threads, requests.size());
+  if (num_threads > 1) {
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; ++i) {
+      threads.emplace_back(create_node_instances);
+    }
+    create_node_instances();
+    for (auto & thread : threads) {
+      thread.join();
+    }
+  } else {
+    create_node_instances();
+  }
+
+  // Ids and executor are not shared with the threads, add the nodes in order
+  for (size_t i = 0; i < requests.size(); ++i) {
+    if (created[i]) {
+      add_node_instance(std::move(instances[i]), *responses[i]);
+    }
+  }
+  if (force_intra_process_comms_) {
+    warn_about_inter_process_topics();
+  }
+  return responses;
+}
+
 void
 ComponentManager::on_unload_node(
   const std::shared_ptr<rmw_request_id_t> request_header,
@@ -253,10 +848,15 @@ ComponentManager::on_unload_node(
     response->error_message = ss.str();
     RCLCPP_WARN(get_logger(), "%s", ss.str().c_str());
   } else {
-    if (auto exec = executor_.lock()) {
+    auto dedicated_executor = dedicated_executors_.find(request->unique_id);
+    if (dedicated_executor != dedicated_executors_.end()) {
+      stop_dedicated_executor(dedicated_executor->second);
+      dedicated_executors_.erase(dedicated_executor);
+    } else if (auto exec = executor_.lock()) {
       exec->remove_node(wrapper->second.get_node_base_interface());
     }
     node_wrappers_.erase(wrapper);
+    allocation_counters_.erase(request->unique_id);
     response->success = true;
   }
 }
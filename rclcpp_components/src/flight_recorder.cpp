@@ -0,0 +1,507 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp_components/flight_recorder.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "rclcpp_components/register_node_macro.hpp"
+
+namespace rclcpp_components
+{
+
+struct FlightRecorderFile::FileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint64_t topics_capacity;
+  uint64_t capacity;
+  uint64_t topics_size;
+  uint32_t topic_count;
+  uint32_t reserved;
+  /// Position of the oldest message, as the number of bytes written before it.
+  uint64_t tail;
+  /// Position of the next message.
+  uint64_t head;
+};
+
+namespace
+{
+
+struct RecordHeader
+{
+  uint32_t topic_index;
+  uint32_t size;
+  int64_t receive_time;
+};
+
+constexpr char file_magic[8] = {'R', 'C', 'L', 'F', 'L', 'R', 'E', 'C'};
+constexpr uint32_t file_version = 1;
+constexpr uint32_t byte_order_marker = 0x01020304;
+/// Topic index of the records padding the end of the ring, when a message does not fit there.
+constexpr uint32_t padding_topic_index = std::numeric_limits<uint32_t>::max();
+
+uint64_t
+align8(uint64_t size)
+{
+  return (size + 7u) & ~uint64_t{7u};
+}
+
+/// Return the position of the beginning of the ring if a record cannot start at the position.
+uint64_t
+skip_end_of_ring(uint64_t position, uint64_t capacity)
+{
+  const uint64_t remaining = capacity - position % capacity;
+  return remaining < sizeof(RecordHeader) ? position + remaining : position;
+}
+
+RecordHeader
+read_record_header(const uint8_t * ring, uint64_t capacity, uint64_t position)
+{
+  RecordHeader record;
+  std::memcpy(&record, ring + position % capacity, sizeof(record));
+  return record;
+}
+
+/// Return the position of the record after the one at the position.
+uint64_t
+next_record(const uint8_t * ring, uint64_t capacity, uint64_t position)
+{
+  const RecordHeader record = read_record_header(ring, capacity, position);
+  if (padding_topic_index == record.topic_index) {
+    return position + (capacity - position % capacity);
+  }
+  return skip_end_of_ring(position + sizeof(RecordHeader) + align8(record.size), capacity);
+}
+
+[[noreturn]] void
+throw_system_error(int error, const std::string & what)
+{
+  throw std::system_error(error, std::generic_category(), what);
+}
+
+}  // namespace
+
+static_assert(sizeof(RecordHeader) == 16, "the records must keep the alignment of the ring");
+
+FlightRecorderFile::FlightRecorderFile(
+  const std::string & filename,
+  size_t capacity,
+  size_t topics_capacity)
+: fd_(-1),
+  mapping_(nullptr),
+  mapping_size_(0)
+{
+  if (capacity < sizeof(RecordHeader)) {
+    throw std::invalid_argument("the capacity of a flight recorder file must be at least 16 bytes");
+  }
+  capacity = static_cast<size_t>(align8(capacity));
+  topics_capacity = static_cast<size_t>(align8(topics_capacity));
+  mapping_size_ = sizeof(FileHeader) + topics_capacity + capacity;
+
+  fd_ = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    throw_system_error(errno, "failed to create the flight recorder file '" + filename + "'");
+  }
+#ifdef __APPLE__
+  int ret = ::ftruncate(fd_, static_cast<off_t>(mapping_size_)) == 0 ? 0 : errno;
+#else
+  // Allocate the file up front, so that writing the mapping cannot fail for lack of space later.
+  int ret = ::posix_fallocate(fd_, 0, static_cast<off_t>(mapping_size_));
+#endif
+  if (0 != ret) {
+    ::close(fd_);
+    throw_system_error(ret, "failed to allocate the flight recorder file '" + filename + "'");
+  }
+  void * mapping = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (MAP_FAILED == mapping) {
+    ret = errno;
+    ::close(fd_);
+    throw_system_error(ret, "failed to map the flight recorder file '" + filename + "'");
+  }
+  mapping_ = static_cast<uint8_t *>(mapping);
+
+  FileHeader & file_header = header();
+  std::memcpy(file_header.magic, file_magic, sizeof(file_magic));
+  file_header.version = file_version;
+  file_header.byte_order = byte_order_marker;
+  file_header.topics_capacity = topics_capacity;
+  file_header.capacity = capacity;
+  file_header.topics_size = 0;
+  file_header.topic_count = 0;
+  file_header.reserved = 0;
+  file_header.tail = 0;
+  file_header.head = 0;
+}
+
+FlightRecorderFile::~FlightRecorderFile()
+{
+  ::munmap(mapping_, mapping_size_);
+  ::close(fd_);
+}
+
+FlightRecorderFile::FileHeader &
+FlightRecorderFile::header() const
+{
+  return *reinterpret_cast<FileHeader *>(mapping_);
+}
+
+uint8_t *
+FlightRecorderFile::ring() const
+{
+  return mapping_ + sizeof(FileHeader) + header().topics_capacity;
+}
+
+uint32_t
+FlightRecorderFile::add_topic(const std::string & topic_name, const std::string & topic_type)
+{
+  FileHeader & file_header = header();
+  const uint32_t sizes[2] = {
+    static_cast<uint32_t>(topic_name.size()), static_cast<uint32_t>(topic_type.size())};
+  const uint64_t entry_size = align8(sizeof(sizes) + topic_name.size() + topic_type.size());
+  if (entry_size > file_header.topics_capacity - file_header.topics_size) {
+    throw std::length_error("the table of topics of the flight recorder file is full");
+  }
+  uint8_t * entry = mapping_ + sizeof(FileHeader) + file_header.topics_size;
+  std::memcpy(entry, sizes, sizeof(sizes));
+  std::memcpy(entry + sizeof(sizes), topic_name.data(), topic_name.size());
+  std::memcpy(entry + sizeof(sizes) + topic_name.size(), topic_type.data(), topic_type.size());
+  // The entry is complete before it is counted, in case of a crash.
+  std::atomic_thread_fence(std::memory_order_release);
+  file_header.topics_size += entry_size;
+  ++file_header.topic_count;
+  topics_.emplace_back(topic_name, topic_type);
+  return file_header.topic_count - 1;
+}
+
+bool
+FlightRecorderFile::write(
+  uint32_t topic_index,
+  int64_t receive_time,
+  const rcl_serialized_message_t & message)
+{
+  if (topic_index >= topics_.size()) {
+    throw std::out_of_range("unknown topic index of a flight recorder file");
+  }
+  return write(topic_index, receive_time, message.buffer, message.buffer_length);
+}
+
+bool
+FlightRecorderFile::write(
+  uint32_t topic_index,
+  int64_t receive_time,
+  const uint8_t * data,
+  size_t size)
+{
+  FileHeader & file_header = header();
+  const uint64_t capacity = file_header.capacity;
+  const uint64_t record_size = sizeof(RecordHeader) + align8(size);
+  if (record_size > capacity || size > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  // The record is written after the last one, or at the beginning of the ring if it does not
+  // fit before its end, which is then padded.
+  const uint64_t begin = file_header.head;
+  const uint64_t remaining = capacity - begin % capacity;
+  const uint64_t record_begin = remaining < record_size ? begin + remaining : begin;
+  const uint64_t end = record_begin + record_size;
+
+  // Evict the oldest records, before they are overwritten.
+  uint64_t tail = file_header.tail;
+  while (tail < begin && end - tail > capacity) {
+    tail = next_record(ring(), capacity, tail);
+  }
+  if (end - tail > capacity) {
+    tail = record_begin;
+  }
+  file_header.tail = tail;
+
+  uint8_t * ring_data = ring();
+  if (record_begin != begin) {
+    const RecordHeader padding{padding_topic_index, 0, 0};
+    std::memcpy(ring_data + begin % capacity, &padding, sizeof(padding));
+  }
+  const RecordHeader record{topic_index, static_cast<uint32_t>(size), receive_time};
+  uint8_t * record_data = ring_data + record_begin % capacity;
+  std::memcpy(record_data, &record, sizeof(record));
+  if (0 != size) {
+    std::memcpy(record_data + sizeof(record), data, size);
+  }
+  // The record is complete before it is part of the ring, in case of a crash.
+  std::atomic_thread_fence(std::memory_order_release);
+  file_header.head = skip_end_of_ring(end, capacity);
+  return true;
+}
+
+void
+FlightRecorderFile::dump(const std::string & filename, int64_t since) const
+{
+  const FileHeader & file_header = header();
+  const uint64_t capacity = file_header.capacity;
+  const uint8_t * ring_data = ring();
+
+  // Select the records first, for the new ring to be just large enough.
+  std::vector<uint64_t> positions;
+  uint64_t size = 0;
+  for (uint64_t position = file_header.tail; position < file_header.head;
+    position = next_record(ring_data, capacity, position))
+  {
+    const RecordHeader record = read_record_header(ring_data, capacity, position);
+    if (padding_topic_index != record.topic_index && record.receive_time >= since) {
+      positions.push_back(position);
+      size += sizeof(RecordHeader) + align8(record.size);
+    }
+  }
+
+  FlightRecorderFile file(
+    filename,
+    static_cast<size_t>(std::max<uint64_t>(size, sizeof(RecordHeader))),
+    static_cast<size_t>(file_header.topics_capacity));
+  for (const auto & topic : topics_) {
+    file.add_topic(topic.first, topic.second);
+  }
+  for (const uint64_t position : positions) {
+    const RecordHeader record = read_record_header(ring_data, capacity, position);
+    file.write(
+      record.topic_index, record.receive_time,
+      ring_data + position % capacity + sizeof(RecordHeader), record.size);
+  }
+}
+
+std::vector<FlightRecord>
+FlightRecorderFile::read(const std::string & filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    throw_system_error(errno, "failed to open the flight recorder file '" + filename + "'");
+  }
+  const std::vector<uint8_t> content(
+    (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  if (file.bad()) {
+    throw_system_error(errno, "failed to read the flight recorder file '" + filename + "'");
+  }
+
+  const auto invalid = [&filename](const std::string & reason) {
+      return std::runtime_error(
+        "invalid flight recorder file '" + filename + "': " + reason);
+    };
+  FileHeader file_header;
+  if (content.size() < sizeof(file_header)) {
+    throw invalid("truncated header");
+  }
+  std::memcpy(&file_header, content.data(), sizeof(file_header));
+  if (0 != std::memcmp(file_header.magic, file_magic, sizeof(file_magic))) {
+    throw invalid("not a flight recording");
+  }
+  if (file_version != file_header.version || byte_order_marker != file_header.byte_order) {
+    throw invalid("unsupported version or byte order");
+  }
+  const uint64_t capacity = file_header.capacity;
+  if (file_header.topics_capacity > content.size() - sizeof(file_header) ||
+    capacity > content.size() - sizeof(file_header) - file_header.topics_capacity ||
+    file_header.topics_size > file_header.topics_capacity || capacity < sizeof(RecordHeader))
+  {
+    throw invalid("truncated content");
+  }
+
+  const uint8_t * topics_data = content.data() + sizeof(file_header);
+  std::vector<std::pair<std::string, std::string>> topics;
+  uint64_t topics_position = 0;
+  for (uint32_t i = 0; i < file_header.topic_count; ++i) {
+    uint32_t sizes[2];
+    if (sizeof(sizes) > file_header.topics_size - topics_position) {
+      throw invalid("truncated table of topics");
+    }
+    const uint8_t * entry = topics_data + topics_position;
+    std::memcpy(sizes, entry, sizeof(sizes));
+    const uint64_t entry_size = sizeof(sizes) + uint64_t{sizes[0]} + sizes[1];
+    if (entry_size > file_header.topics_size - topics_position) {
+      throw invalid("truncated table of topics");
+    }
+    const char * names = reinterpret_cast<const char *>(entry + sizeof(sizes));
+    topics.emplace_back(std::string(names, sizes[0]), std::string(names + sizes[0], sizes[1]));
+    topics_position += align8(entry_size);
+  }
+
+  std::vector<FlightRecord> records;
+  const uint8_t * ring_data = topics_data + file_header.topics_capacity;
+  if (file_header.head - file_header.tail > capacity) {
+    // The ring was being cleared by a crashed write, so there are no records.
+    return records;
+  }
+  for (uint64_t position = file_header.tail; position < file_header.head;
+    position = next_record(ring_data, capacity, position))
+  {
+    if (capacity - position % capacity < sizeof(RecordHeader)) {
+      throw invalid("misaligned record");
+    }
+    const RecordHeader record = read_record_header(ring_data, capacity, position);
+    if (padding_topic_index == record.topic_index) {
+      continue;
+    }
+    if (record.topic_index >= topics.size() ||
+      record.size > capacity - position % capacity - sizeof(RecordHeader))
+    {
+      throw invalid("corrupted record");
+    }
+    rclcpp::SerializedMessage message(record.size);
+    auto & rcl_message = message.get_rcl_serialized_message();
+    if (0 != record.size) {
+      std::memcpy(
+        rcl_message.buffer, ring_data + position % capacity + sizeof(RecordHeader), record.size);
+    }
+    rcl_message.buffer_length = record.size;
+    const auto & topic = topics[record.topic_index];
+    records.push_back({topic.first, topic.second, record.receive_time, std::move(message)});
+  }
+  return records;
+}
+
+FlightRecorder::FlightRecorder(const rclcpp::NodeOptions & options)
+: rclcpp::Node("flight_recorder", options),
+  dump_duration_(0, 0)
+{
+  filename_ = declare_parameter<std::string>("file", "flight_recorder.ring");
+  const int64_t capacity = declare_parameter<int64_t>("capacity", 256 * 1024 * 1024);
+  topics_ = declare_parameter<std::vector<std::string>>("topics", std::vector<std::string>());
+  const double discovery_period = declare_parameter<double>("discovery_period", 1.0);
+  dump_duration_ = rclcpp::Duration::from_seconds(declare_parameter<double>("dump_duration", 60.0));
+  if (capacity <= 0) {
+    throw std::invalid_argument("the capacity of the flight recorder must be positive");
+  }
+  if (discovery_period <= 0.0) {
+    throw std::invalid_argument("the discovery period of the flight recorder must be positive");
+  }
+
+  file_ = std::make_unique<FlightRecorderFile>(filename_, static_cast<size_t>(capacity));
+
+  discover_topics();
+  discovery_timer_ = create_wall_timer(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(discovery_period)),
+    [this]() {discover_topics();});
+  dump_service_ = create_service<std_srvs::srv::Trigger>(
+    "~/dump",
+    [this](
+      const std::shared_ptr<std_srvs::srv::Trigger::Request> request,
+      std::shared_ptr<std_srvs::srv::Trigger::Response> response)
+    {
+      on_dump(request, response);
+    });
+}
+
+FlightRecorder::~FlightRecorder() = default;
+
+void
+FlightRecorder::dump(const std::string & filename)
+{
+  const int64_t since = get_clock()->now().nanoseconds() - dump_duration_.nanoseconds();
+  std::lock_guard<std::mutex> lock(file_mutex_);
+  file_->dump(filename, since);
+}
+
+void
+FlightRecorder::discover_topics()
+{
+  for (const auto & topic : get_topic_names_and_types()) {
+    const std::string & topic_name = topic.first;
+    if (subscriptions_.count(topic_name) != 0) {
+      continue;
+    }
+    if (!topics_.empty() &&
+      std::find(topics_.begin(), topics_.end(), topic_name) == topics_.end())
+    {
+      continue;
+    }
+    // A topic which is not recorded is kept without subscription, not to be warned about again.
+    if (topic.second.size() != 1) {
+      RCLCPP_WARN(
+        get_logger(), "Not recording the topic '%s', which has several types",
+        topic_name.c_str());
+      subscriptions_[topic_name] = nullptr;
+      continue;
+    }
+    const std::string & topic_type = topic.second.front();
+    uint32_t topic_index;
+    try {
+      std::lock_guard<std::mutex> lock(file_mutex_);
+      topic_index = file_->add_topic(topic_name, topic_type);
+    } catch (const std::length_error &) {
+      RCLCPP_WARN(
+        get_logger(), "Not recording the topic '%s', the table of topics is full",
+        topic_name.c_str());
+      subscriptions_[topic_name] = nullptr;
+      continue;
+    }
+    try {
+      subscriptions_[topic_name] = create_generic_subscription(
+        topic_name, topic_type, rclcpp::QoS(10).best_effort(),
+        [this, topic_index](std::shared_ptr<rclcpp::SerializedMessage> message) {
+          const int64_t receive_time = get_clock()->now().nanoseconds();
+          std::lock_guard<std::mutex> lock(file_mutex_);
+          if (!file_->write(topic_index, receive_time, message->get_rcl_serialized_message())) {
+            ++dropped_count_;
+            RCLCPP_WARN_THROTTLE(
+              get_logger(), *get_clock(), 1000,
+              "Dropped %zu messages larger than the flight recorder file", dropped_count_);
+          }
+        });
+    } catch (const std::runtime_error & exception) {
+      RCLCPP_WARN(
+        get_logger(), "Not recording the topic '%s': %s", topic_name.c_str(), exception.what());
+      subscriptions_[topic_name] = nullptr;
+    }
+  }
+}
+
+void
+FlightRecorder::on_dump(
+  const std::shared_ptr<std_srvs::srv::Trigger::Request> request,
+  std::shared_ptr<std_srvs::srv::Trigger::Response> response)
+{
+  (void)request;
+  const std::string filename =
+    filename_ + "." + std::to_string(get_clock()->now().nanoseconds());
+  try {
+    dump(filename);
+    response->success = true;
+    response->message = filename;
+  } catch (const std::exception & exception) {
+    response->success = false;
+    response->message = exception.what();
+  }
+}
+
+}  // namespace rclcpp_components
+
+RCLCPP_COMPONENTS_REGISTER_NODE(rclcpp_components::FlightRecorder)
@@ -15,6 +15,8 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "rclcpp_components/component_manager.hpp"
 
@@ -95,3 +97,41 @@ TEST_F(TestComponentManager, create_component_factory_invalid)
     auto resources = manager->get_component_resources("invalid_rclcpp_components"),
     rclcpp_components::ComponentManagerException);
 }
+
+TEST_F(TestComponentManager, get_component_resources_cached)
+{
+  auto exec = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  auto manager = std::make_shared<rclcpp_components::ComponentManager>(exec);
+
+  auto resources = manager->get_component_resources("rclcpp_components");
+  EXPECT_EQ(resources, manager->get_component_resources("rclcpp_components"));
+
+  // Failed lookups are not cached
+  EXPECT_THROW(
+    manager->get_component_resources("invalid_package"),
+    rclcpp_components::ComponentManagerException);
+  EXPECT_THROW(
+    manager->get_component_resources("invalid_package"),
+    rclcpp_components::ComponentManagerException);
+}
+
+TEST_F(TestComponentManager, preload_component_libraries)
+{
+  auto exec = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  auto manager = std::make_shared<rclcpp_components::ComponentManager>(
+    exec, "ComponentManager",
+    rclcpp::NodeOptions()
+    .start_parameter_services(false)
+    .start_parameter_event_publisher(false)
+    .parameter_overrides(
+      {rclcpp::Parameter(
+        "preload_packages", std::vector<std::string>{"rclcpp_components", "invalid_package"})}));
+
+  // Does not throw for missing packages
+  EXPECT_NO_THROW(manager->preload_component_libraries({"invalid_package"}));
+
+  auto resources = manager->get_component_resources("rclcpp_components");
+  for (const auto & resource : resources) {
+    EXPECT_NE(nullptr, manager->create_component_factory(resource));
+  }
+}
@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "composition_interfaces/srv/load_node.hpp"
 #include "composition_interfaces/srv/unload_node.hpp"
@@ -321,3 +322,241 @@ TEST_F(TestComponentManager, components_api)
     }
   }
 }
+
+TEST_F(TestComponentManager, load_nodes)
+{
+  using LoadNode = composition_interfaces::srv::LoadNode;
+  auto exec = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  auto node = rclcpp::Node::make_shared("test_component_manager_load_nodes");
+  auto manager = std::make_shared<rclcpp_components::ComponentManager>(exec);
+
+  std::vector<std::shared_ptr<LoadNode::Request>> requests;
+  for (const std::string plugin_name : {"TestComponentFoo", "TestComponentBar",
+      "TestComponentFoo", "TestComponentDoesNotExist"})
+  {
+    auto request = std::make_shared<LoadNode::Request>();
+    request->package_name = "rclcpp_components";
+    request->plugin_name = "test_rclcpp_components::" + plugin_name;
+    requests.push_back(request);
+  }
+  requests[2]->node_name = "test_component_foo_2";
+
+  auto responses = manager->load_nodes(requests, 2);
+  ASSERT_EQ(responses.size(), 4u);
+  EXPECT_TRUE(responses[0]->success);
+  EXPECT_EQ(responses[0]->full_node_name, "/test_component_foo");
+  EXPECT_EQ(responses[0]->unique_id, 1u);
+  EXPECT_TRUE(responses[1]->success);
+  EXPECT_EQ(responses[1]->full_node_name, "/test_component_bar");
+  EXPECT_EQ(responses[1]->unique_id, 2u);
+  EXPECT_TRUE(responses[2]->success);
+  EXPECT_EQ(responses[2]->full_node_name, "/test_component_foo_2");
+  EXPECT_EQ(responses[2]->unique_id, 3u);
+  EXPECT_FALSE(responses[3]->success);
+  EXPECT_EQ(
+    responses[3]->error_message, "Failed to find class with the requested plugin name.");
+
+  exec->add_node(manager);
+  exec->add_node(node);
+
+  auto client = node->create_client<composition_interfaces::srv::ListNodes>(
+    "/ComponentManager/_container/list_nodes");
+  if (!client->wait_for_service(20s)) {
+    ASSERT_TRUE(false) << "service not available after waiting";
+  }
+
+  auto request = std::make_shared<composition_interfaces::srv::ListNodes::Request>();
+  auto future = client->async_send_request(request);
+  auto ret = exec->spin_until_future_complete(future, 5s);  // Wait for the result.
+  EXPECT_EQ(ret, rclcpp::FutureReturnCode::SUCCESS);
+  auto result = future.get();
+  ASSERT_EQ(result->full_node_names.size(), 3u);
+  EXPECT_EQ(result->full_node_names[0], "/test_component_foo");
+  EXPECT_EQ(result->full_node_names[1], "/test_component_bar");
+  EXPECT_EQ(result->full_node_names[2], "/test_component_foo_2");
+}
+
+TEST_F(TestComponentManager, dedicated_executors)
+{
+  using LoadNode = composition_interfaces::srv::LoadNode;
+  auto exec = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  auto node = rclcpp::Node::make_shared("test_component_manager_dedicated_executors");
+  auto manager = std::make_shared<rclcpp_components::ComponentManager>(
+    exec, "ComponentManagerDedicatedExecutors");
+
+  exec->add_node(manager);
+  exec->add_node(node);
+
+  auto load_client = node->create_client<LoadNode>(
+    "/ComponentManagerDedicatedExecutors/_container/load_node");
+  if (!load_client->wait_for_service(20s)) {
+    ASSERT_TRUE(false) << "service not available after waiting";
+  }
+
+  auto load = [&](const std::string & node_name, std::vector<rclcpp::Parameter> extra_arguments) {
+      auto request = std::make_shared<LoadNode::Request>();
+      request->package_name = "rclcpp_components";
+      request->plugin_name = "test_rclcpp_components::TestComponentFoo";
+      request->node_name = node_name;
+      for (const auto & extra_argument : extra_arguments) {
+        request->extra_arguments.push_back(extra_argument.to_parameter_msg());
+      }
+      auto future = load_client->async_send_request(request);
+      EXPECT_EQ(exec->spin_until_future_complete(future, 5s), rclcpp::FutureReturnCode::SUCCESS);
+      return future.get();
+    };
+
+  {
+    auto result = load(
+      "test_component_single_threaded", {rclcpp::Parameter("executor", "single_threaded")});
+    EXPECT_TRUE(result->success);
+    EXPECT_EQ(result->error_message, "");
+    EXPECT_EQ(result->unique_id, 1u);
+  }
+
+  {
+    auto result = load(
+      "test_component_static", {rclcpp::Parameter("executor", "static_single_threaded")});
+    EXPECT_TRUE(result->success);
+    EXPECT_EQ(result->unique_id, 2u);
+  }
+
+  {
+    std::vector<rclcpp::Parameter> extra_arguments{
+      rclcpp::Parameter("executor", "multi_threaded"),
+      rclcpp::Parameter("executor_threads", 2)};
+#ifdef __linux__
+    extra_arguments.push_back(
+      rclcpp::Parameter("executor_cpu_affinity", std::vector<int64_t>{0}));
+#endif
+    auto result = load("test_component_multi_threaded", extra_arguments);
+    EXPECT_TRUE(result->success);
+    EXPECT_EQ(result->error_message, "");
+    EXPECT_EQ(result->unique_id, 3u);
+  }
+
+  {
+    auto result = load("test_component_invalid", {rclcpp::Parameter("executor", "events")});
+    EXPECT_FALSE(result->success);
+    EXPECT_EQ(
+      result->error_message,
+      "Extra component argument 'executor' must be one of 'shared', 'single_threaded', "
+      "'static_single_threaded' or 'multi_threaded'");
+  }
+
+  {
+    auto result = load("test_component_invalid", {rclcpp::Parameter("executor_threads", 2)});
+    EXPECT_FALSE(result->success);
+    EXPECT_EQ(
+      result->error_message,
+      "Extra component argument 'executor_threads' requires a multi_threaded executor");
+  }
+
+  {
+    auto client = node->create_client<composition_interfaces::srv::UnloadNode>(
+      "/ComponentManagerDedicatedExecutors/_container/unload_node");
+    if (!client->wait_for_service(20s)) {
+      ASSERT_TRUE(false) << "service not available after waiting";
+    }
+    auto request = std::make_shared<composition_interfaces::srv::UnloadNode::Request>();
+    request->unique_id = 1;
+    auto future = client->async_send_request(request);
+    auto ret = exec->spin_until_future_complete(future, 5s);  // Wait for the result.
+    EXPECT_EQ(ret, rclcpp::FutureReturnCode::SUCCESS);
+    EXPECT_TRUE(future.get()->success);
+  }
+
+  {
+    auto client = node->create_client<composition_interfaces::srv::ListNodes>(
+      "/ComponentManagerDedicatedExecutors/_container/list_nodes");
+    if (!client->wait_for_service(20s)) {
+      ASSERT_TRUE(false) << "service not available after waiting";
+    }
+    auto request = std::make_shared<composition_interfaces::srv::ListNodes::Request>();
+    auto future = client->async_send_request(request);
+    auto ret = exec->spin_until_future_complete(future, 5s);  // Wait for the result.
+    EXPECT_EQ(ret, rclcpp::FutureReturnCode::SUCCESS);
+    auto result = future.get();
+    ASSERT_EQ(result->full_node_names.size(), 2u);
+    EXPECT_EQ(result->full_node_names[0], "/test_component_static");
+    EXPECT_EQ(result->full_node_names[1], "/test_component_multi_threaded");
+  }
+}
+
+TEST_F(TestComponentManager, force_intra_process_comms)
+{
+  using LoadNode = composition_interfaces::srv::LoadNode;
+  auto exec = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  auto manager = std::make_shared<rclcpp_components::ComponentManager>(
+    exec, "ComponentManagerIntraProcess",
+    rclcpp::NodeOptions()
+    .start_parameter_services(false)
+    .start_parameter_event_publisher(false)
+    .parameter_overrides({rclcpp::Parameter("force_intra_process_comms", true)}));
+
+  std::vector<std::shared_ptr<LoadNode::Request>> requests;
+  for (bool use_intra_process_comms : {true, false}) {
+    auto request = std::make_shared<LoadNode::Request>();
+    request->package_name = "rclcpp_components";
+    request->plugin_name = "test_rclcpp_components::TestComponentFoo";
+    request->node_name = use_intra_process_comms ? "test_component_intra" : "test_component_inter";
+    request->extra_arguments.push_back(
+      rclcpp::Parameter("use_intra_process_comms", use_intra_process_comms).to_parameter_msg());
+    requests.push_back(request);
+  }
+
+  auto responses = manager->load_nodes(requests);
+  ASSERT_EQ(responses.size(), 2u);
+  EXPECT_TRUE(responses[0]->success);
+  EXPECT_FALSE(responses[1]->success);
+  EXPECT_EQ(
+    responses[1]->error_message,
+    "Extra component argument 'use_intra_process_comms' cannot be false, "
+    "the container forces intra process communication");
+
+  // The test components neither publish nor subscribe
+  EXPECT_TRUE(manager->get_topic_delivery().empty());
+}
+
+TEST_F(TestComponentManager, component_accounting)
+{
+  using LoadNode = composition_interfaces::srv::LoadNode;
+  auto exec = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+  auto manager = std::make_shared<rclcpp_components::ComponentManager>(
+    exec, "ComponentManagerAccounting",
+    rclcpp::NodeOptions()
+    .start_parameter_services(false)
+    .start_parameter_event_publisher(false)
+    .parameter_overrides({rclcpp::Parameter("enable_component_accounting", true)}));
+
+  std::vector<std::shared_ptr<LoadNode::Request>> requests;
+  for (const std::string executor : {"shared", "single_threaded"}) {
+    auto request = std::make_shared<LoadNode::Request>();
+    request->package_name = "rclcpp_components";
+    request->plugin_name = "test_rclcpp_components::TestComponentFoo";
+    request->node_name = "test_component_accounting_" + executor;
+    request->extra_arguments.push_back(rclcpp::Parameter("executor", executor).to_parameter_msg());
+    requests.push_back(request);
+  }
+  auto responses = manager->load_nodes(requests);
+  ASSERT_TRUE(responses[0]->success);
+  ASSERT_TRUE(responses[1]->success);
+
+  auto accounting = manager->get_component_accounting();
+  ASSERT_EQ(accounting.size(), 2u);
+  EXPECT_EQ(accounting[0].unique_id, 1u);
+  EXPECT_EQ(accounting[0].full_node_name, "/test_component_accounting_shared");
+  EXPECT_EQ(accounting[1].unique_id, 2u);
+  EXPECT_EQ(accounting[1].full_node_name, "/test_component_accounting_single_threaded");
+  for (const auto & component : accounting) {
+    // The rcl node of the component lives in memory of its allocator
+    EXPECT_GT(component.allocation_count, 0u);
+    EXPECT_GT(component.allocated_bytes, 0u);
+  }
+
+  // Disabled by default
+  auto other_manager = std::make_shared<rclcpp_components::ComponentManager>(
+    exec, "ComponentManagerNoAccounting");
+  other_manager->load_nodes({requests[0]});
+  EXPECT_TRUE(other_manager->get_component_accounting().empty());
+}
@@ -0,0 +1,194 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "std_msgs/msg/string.hpp"
+
+#include "rclcpp_components/flight_recorder.hpp"
+
+using rclcpp_components::FlightRecorderFile;
+
+namespace
+{
+
+rclcpp::SerializedMessage
+make_message(size_t size, uint8_t value)
+{
+  rclcpp::SerializedMessage message(size);
+  auto & rcl_message = message.get_rcl_serialized_message();
+  for (size_t i = 0; i < size; ++i) {
+    rcl_message.buffer[i] = value;
+  }
+  rcl_message.buffer_length = size;
+  return message;
+}
+
+uint8_t
+first_byte(const rclcpp_components::FlightRecord & record)
+{
+  return record.message.get_rcl_serialized_message().buffer[0];
+}
+
+}  // namespace
+
+class TestFlightRecorder : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    const std::string prefix = "/tmp/test_flight_recorder_" + std::to_string(::getpid());
+    filename_ = prefix + ".ring";
+    dump_filename_ = prefix + ".dump";
+  }
+
+  void TearDown() override
+  {
+    std::remove(filename_.c_str());
+    std::remove(dump_filename_.c_str());
+  }
+
+  std::string filename_;
+  std::string dump_filename_;
+};
+
+TEST_F(TestFlightRecorder, write_and_read) {
+  FlightRecorderFile file(filename_, 1024);
+  const uint32_t chatter = file.add_topic("/chatter", "std_msgs/msg/String");
+  const uint32_t empty = file.add_topic("/empty", "std_msgs/msg/Empty");
+  EXPECT_TRUE(file.write(chatter, 1, make_message(5, 1).get_rcl_serialized_message()));
+  EXPECT_TRUE(file.write(empty, 2, make_message(0, 0).get_rcl_serialized_message()));
+  EXPECT_THROW(
+    file.write(2, 3, make_message(1, 1).get_rcl_serialized_message()), std::out_of_range);
+
+  const auto records = FlightRecorderFile::read(filename_);
+  ASSERT_EQ(2u, records.size());
+  EXPECT_EQ("/chatter", records[0].topic_name);
+  EXPECT_EQ("std_msgs/msg/String", records[0].topic_type);
+  EXPECT_EQ(1, records[0].receive_time);
+  EXPECT_EQ(5u, records[0].message.size());
+  EXPECT_EQ(1u, first_byte(records[0]));
+  EXPECT_EQ("/empty", records[1].topic_name);
+  EXPECT_EQ(2, records[1].receive_time);
+  EXPECT_EQ(0u, records[1].message.size());
+}
+
+TEST_F(TestFlightRecorder, oldest_messages_evicted) {
+  // Each record takes 16 bytes of header and 24 bytes of message, so 6 of them fit.
+  FlightRecorderFile file(filename_, 256);
+  const uint32_t topic = file.add_topic("/chatter", "std_msgs/msg/String");
+  for (uint8_t i = 0; i < 20; ++i) {
+    ASSERT_TRUE(file.write(topic, i, make_message(20, i).get_rcl_serialized_message()));
+
+    const auto records = FlightRecorderFile::read(filename_);
+    ASSERT_EQ(std::min<size_t>(i + 1u, 6u), records.size());
+    EXPECT_EQ(i, records.back().receive_time);
+    EXPECT_EQ(i, first_byte(records.back()));
+    for (size_t j = 1; j < records.size(); ++j) {
+      EXPECT_EQ(records[j - 1].receive_time + 1, records[j].receive_time);
+    }
+  }
+}
+
+TEST_F(TestFlightRecorder, too_large_message_dropped) {
+  FlightRecorderFile file(filename_, 64);
+  const uint32_t topic = file.add_topic("/chatter", "std_msgs/msg/String");
+  EXPECT_TRUE(file.write(topic, 1, make_message(48, 1).get_rcl_serialized_message()));
+  EXPECT_FALSE(file.write(topic, 2, make_message(49, 2).get_rcl_serialized_message()));
+
+  const auto records = FlightRecorderFile::read(filename_);
+  ASSERT_EQ(1u, records.size());
+  EXPECT_EQ(1, records[0].receive_time);
+}
+
+TEST_F(TestFlightRecorder, topics_table_full) {
+  FlightRecorderFile file(filename_, 64, 32);
+  EXPECT_EQ(0u, file.add_topic("/a", "std_msgs/msg/String"));
+  EXPECT_THROW(file.add_topic("/b", "std_msgs/msg/String"), std::length_error);
+}
+
+TEST_F(TestFlightRecorder, dump_since) {
+  FlightRecorderFile file(filename_, 1024);
+  const uint32_t topic = file.add_topic("/chatter", "std_msgs/msg/String");
+  for (uint8_t i = 0; i < 10; ++i) {
+    ASSERT_TRUE(file.write(topic, i, make_message(i, i).get_rcl_serialized_message()));
+  }
+  file.dump(dump_filename_, 7);
+
+  const auto records = FlightRecorderFile::read(dump_filename_);
+  ASSERT_EQ(3u, records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    EXPECT_EQ("/chatter", records[i].topic_name);
+    EXPECT_EQ(static_cast<int64_t>(7 + i), records[i].receive_time);
+    EXPECT_EQ(7 + i, records[i].message.size());
+  }
+}
+
+TEST_F(TestFlightRecorder, read_invalid_file) {
+  EXPECT_THROW(FlightRecorderFile::read(filename_), std::system_error);
+  FILE * file = std::fopen(filename_.c_str(), "w");
+  ASSERT_NE(nullptr, file);
+  std::fputs("not a flight recording, but long enough for a header", file);
+  std::fclose(file);
+  EXPECT_THROW(FlightRecorderFile::read(filename_), std::runtime_error);
+}
+
+TEST_F(TestFlightRecorder, record_topic) {
+  rclcpp::init(0, nullptr);
+  {
+    rclcpp::NodeOptions options;
+    options.parameter_overrides(
+    {
+      {"file", filename_},
+      {"capacity", 4096},
+      {"topics", std::vector<std::string>{"/flight_recorder_chatter"}},
+      {"discovery_period", 0.01},
+    });
+    auto recorder = std::make_shared<rclcpp_components::FlightRecorder>(options);
+    auto node = std::make_shared<rclcpp::Node>("flight_recorder_talker");
+    auto publisher = node->create_publisher<std_msgs::msg::String>("/flight_recorder_chatter", 10);
+    rclcpp::executors::SingleThreadedExecutor executor;
+    executor.add_node(recorder);
+
+    std_msgs::msg::String message;
+    message.data = "Hello";
+    const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (FlightRecorderFile::read(filename_).empty() && std::chrono::steady_clock::now() < end) {
+      publisher->publish(message);
+      executor.spin_some(std::chrono::milliseconds(10));
+    }
+    recorder->dump(dump_filename_);
+  }
+  rclcpp::shutdown();
+
+  const auto records = FlightRecorderFile::read(dump_filename_);
+  ASSERT_FALSE(records.empty());
+  EXPECT_EQ("/flight_recorder_chatter", records[0].topic_name);
+  EXPECT_EQ("std_msgs/msg/String", records[0].topic_type);
+
+  rclcpp::Serialization<std_msgs::msg::String> serialization;
+  std_msgs::msg::String recorded;
+  serialization.deserialize_message(&records[0].message, &recorded);
+  EXPECT_EQ("Hello", recorded.data);
+}
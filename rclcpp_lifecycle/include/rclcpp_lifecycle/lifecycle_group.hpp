@@ -0,0 +1,163 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLCPP_LIFECYCLE__LIFECYCLE_GROUP_HPP_
+#define RCLCPP_LIFECYCLE__LIFECYCLE_GROUP_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "rclcpp/macros.hpp"
+
+#include "rclcpp_lifecycle/lifecycle_node.hpp"
+#include "rclcpp_lifecycle/state.hpp"
+#include "rclcpp_lifecycle/visibility_control.h"
+
+namespace rclcpp_lifecycle
+{
+
+/// Transitions a set of lifecycle nodes of this process together, in parallel.
+/**
+ * The transitions are triggered by calling the nodes directly, not through their services,
+ * on a pool of threads.
+ * A node can depend on other nodes of the group: it is configured and activated once the nodes
+ * it depends on are, and it is deactivated, cleaned up and shut down before them.
+ * Nodes whose transitions do not depend on each other transition at the same time, so that
+ * bringing up the group takes as long as the longest chain of dependencies.
+ *
+ * If the transition of a node fails, the nodes waiting for it are not transitioned.
+ */
+class LifecycleGroup
+{
+public:
+  RCLCPP_SMART_PTR_DEFINITIONS(LifecycleGroup)
+
+  using CallbackReturn = node_interfaces::LifecycleNodeInterface::CallbackReturn;
+
+  /// Outcome of the transition of one node of the group.
+  struct NodeTransitionResult
+  {
+    LifecycleNode::SharedPtr node;
+    /// False if the node was skipped because a node it waited for failed its transition.
+    bool triggered = false;
+    /// Return code of the transition callback, valid if triggered.
+    CallbackReturn callback_return = CallbackReturn::ERROR;
+    /// Id of the state of the node after the transition.
+    uint8_t state_id = 0;
+  };
+
+  /// Outcome of the transition of a group.
+  struct TransitionResult
+  {
+    /// True if the transition of every node succeeded.
+    bool success = false;
+    /// Result of each node, in the order the nodes were added.
+    std::vector<NodeTransitionResult> nodes;
+  };
+
+  /// Constructor.
+  /**
+   * \param[in] number_of_threads maximum number of nodes transitioning at the same time,
+   *   0 for the number of cores
+   */
+  RCLCPP_LIFECYCLE_PUBLIC
+  explicit LifecycleGroup(size_t number_of_threads = 0);
+
+  RCLCPP_LIFECYCLE_PUBLIC
+  virtual ~LifecycleGroup();
+
+  /// Add a node to the group.
+  /**
+   * The dependencies must have been added before, so the dependencies cannot form a cycle.
+   *
+   * \param[in] node the node to add
+   * \param[in] dependencies nodes of the group which must be brought up before this node
+   * \throws std::invalid_argument if the node is null or already in the group, or if a
+   *   dependency is not in the group
+   */
+  RCLCPP_LIFECYCLE_PUBLIC
+  void
+  add_node(
+    LifecycleNode::SharedPtr node,
+    const std::vector<LifecycleNode::SharedPtr> & dependencies = {});
+
+  /// Return the number of nodes of the group.
+  RCLCPP_LIFECYCLE_PUBLIC
+  size_t
+  size() const;
+
+  /// Trigger a transition of every node of the group.
+  /**
+   * The configure and activate transitions follow the dependencies, the others go in the
+   * opposite order.
+   *
+   * \param[in] transition_id id of the transition, see lifecycle_msgs::msg::Transition
+   * \return the result of the transition of each node
+   */
+  RCLCPP_LIFECYCLE_PUBLIC
+  TransitionResult
+  trigger_transition(uint8_t transition_id);
+
+  /// Configure every node of the group, dependencies first.
+  RCLCPP_LIFECYCLE_PUBLIC
+  TransitionResult
+  configure();
+
+  /// Clean up every node of the group, dependent nodes first.
+  RCLCPP_LIFECYCLE_PUBLIC
+  TransitionResult
+  cleanup();
+
+  /// Activate every node of the group, dependencies first.
+  RCLCPP_LIFECYCLE_PUBLIC
+  TransitionResult
+  activate();
+
+  /// Deactivate every node of the group, dependent nodes first.
+  RCLCPP_LIFECYCLE_PUBLIC
+  TransitionResult
+  deactivate();
+
+  /// Shut down every node of the group from its current state, dependent nodes first.
+  RCLCPP_LIFECYCLE_PUBLIC
+  TransitionResult
+  shutdown();
+
+private:
+  RCLCPP_DISABLE_COPY(LifecycleGroup)
+
+  using NodeTransition = std::function<const State &(LifecycleNode &, CallbackReturn &)>;
+
+  /// Run a transition on every node, following the dependencies or in reverse.
+  TransitionResult
+  run_transition(const NodeTransition & transition, bool reverse);
+
+  struct Entry
+  {
+    LifecycleNode::SharedPtr node;
+    /// Indices of the nodes this node depends on.
+    std::vector<size_t> dependencies;
+  };
+
+  size_t number_of_threads_;
+  /// Held by add_node() and while a transition runs, one transition of the group at a time.
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+};
+
+}  // namespace rclcpp_lifecycle
+
+#endif  // RCLCPP_LIFECYCLE__LIFECYCLE_GROUP_HPP_
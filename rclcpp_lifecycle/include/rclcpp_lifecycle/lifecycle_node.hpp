@@ -192,6 +192,20 @@ public:
     rclcpp::CallbackGroupType group_type,
     bool automatically_add_to_executor_with_node = true);
 
+  /// Return the callback group of the entities managed by the lifecycle of this node.
+  /**
+   * Subscriptions, timers, services and clients created in this callback group are only
+   * waited on by executors while the node is in the active state: they are detached from the
+   * wait set when the node leaves the active state, and attached again once it is activated,
+   * so that an inactive node neither wakes the executor nor takes messages.
+   * The callback group is mutually exclusive and created on the first call.
+   *
+   * \return the managed callback group of this node
+   */
+  RCLCPP_LIFECYCLE_PUBLIC
+  rclcpp::CallbackGroup::SharedPtr
+  get_managed_callback_group();
+
   /// Iterate over the callback groups in the node, calling func on each valid one.
   RCLCPP_LIFECYCLE_PUBLIC
   void
@@ -247,13 +261,15 @@ public:
    * \param[in] period Time interval between triggers of the callback.
    * \param[in] callback User-defined callback function.
    * \param[in] group Callback group to execute this timer's callback in.
+   * \param[in] slack How late the timer may be called, see rclcpp::TimerBase::set_slack().
    */
   template<typename DurationRepT = int64_t, typename DurationT = std::milli, typename CallbackT>
   typename rclcpp::WallTimer<CallbackT>::SharedPtr
   create_wall_timer(
     std::chrono::duration<DurationRepT, DurationT> period,
     CallbackT callback,
-    rclcpp::CallbackGroup::SharedPtr group = nullptr);
+    rclcpp::CallbackGroup::SharedPtr group = nullptr,
+    std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero());
 
   /// Create and return a Client.
   /**
@@ -786,6 +802,36 @@ public:
   std::vector<Transition>
   get_transition_graph();
 
+  /// Run the transitions requested through the change_state service on a worker thread.
+  /**
+   * By default, the transition callbacks of a transition requested through the change_state
+   * service run in the service callback, blocking the executor thread and the callback group
+   * of the service until they return.
+   * If enabled, the service callback only starts the transition on a worker thread, which
+   * sends the response once the transition completes, so that slow callbacks, e.g. loading a
+   * model in on_configure(), neither stall the executor nor the other nodes it executes.
+   *
+   * A single transition runs at a time: a change_state request received while one is running
+   * is responded to with success = false.
+   * The transitions triggered directly, e.g. with trigger_transition(), wait for the running
+   * transition.
+   * The node waits for the running transition when it is destroyed, so the transition
+   * callbacks of a derived class must not use its members once its destruction started.
+   *
+   * \param[in] async_transitions true to run the requested transitions on a worker thread
+   */
+  RCLCPP_LIFECYCLE_PUBLIC
+  void
+  set_async_transitions(bool async_transitions);
+
+  /// Return true if the requested transitions run on a worker thread.
+  /**
+   * \sa set_async_transitions()
+   */
+  RCLCPP_LIFECYCLE_PUBLIC
+  bool
+  get_async_transitions() const;
+
   /// Trigger the specified transition.
   /*
    * \return the new state after this transition
@@ -15,6 +15,7 @@
 #ifndef RCLCPP_LIFECYCLE__LIFECYCLE_PUBLISHER_HPP_
 #define RCLCPP_LIFECYCLE__LIFECYCLE_PUBLISHER_HPP_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -45,6 +46,10 @@ public:
 /// brief child class of rclcpp Publisher class.
 /**
  * Overrides all publisher functions to check for enabled/disabled state.
+ *
+ * The state is an atomic flag read inline by the publish functions, so publishing while the
+ * publisher is not activated costs a single load once the warning has been logged.
+ * The warning is logged once after each change of state.
  */
 template<typename MessageT, typename Alloc = std::allocator<void>>
 class LifecyclePublisher : public LifecyclePublisherInterface,
@@ -81,7 +86,7 @@ public:
   virtual void
   publish(std::unique_ptr<MessageT, MessageDeleter> msg)
   {
-    if (!enabled_) {
+    if (!enabled_.load(std::memory_order_acquire)) {
       log_publisher_not_enabled();
       return;
     }
@@ -97,30 +102,52 @@ public:
   virtual void
   publish(const MessageT & msg)
   {
-    if (!enabled_) {
+    if (!enabled_.load(std::memory_order_acquire)) {
       log_publisher_not_enabled();
       return;
     }
     rclcpp::Publisher<MessageT, Alloc>::publish(msg);
   }
 
+  /// Build and publish a message only if the publisher is activated.
+  /**
+   * The message factory is not called while the publisher is not activated, which avoids
+   * allocating and filling large messages which would be dropped.
+   *
+   * \param[in] make_message callable returning the message to publish, either a MessageT or a
+   *   std::unique_ptr<MessageT, MessageDeleter>
+   * \return true if the message was built and published
+   */
+  template<typename MessageFactoryT>
+  bool
+  publish_if_active(MessageFactoryT && make_message)
+  {
+    if (!enabled_.load(std::memory_order_acquire)) {
+      log_publisher_not_enabled();
+      return false;
+    }
+    this->publish(std::forward<MessageFactoryT>(make_message)());
+    return true;
+  }
+
   virtual void
   on_activate()
   {
-    enabled_ = true;
+    enabled_.store(true, std::memory_order_release);
+    should_log_.store(true, std::memory_order_relaxed);
   }
 
   virtual void
   on_deactivate()
   {
-    enabled_ = false;
-    should_log_ = true;
+    enabled_.store(false, std::memory_order_release);
+    should_log_.store(true, std::memory_order_relaxed);
   }
 
   virtual bool
   is_activated()
   {
-    return enabled_;
+    return enabled_.load(std::memory_order_acquire);
   }
 
 private:
@@ -131,8 +158,13 @@ private:
    */
   void log_publisher_not_enabled()
   {
-    // Nothing to do if we are not meant to log
-    if (!should_log_) {
+    // Nothing to do if we are not meant to log, checked without writing to keep the line shared
+    if (!should_log_.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    // We stop logging until the state changes again, only the thread clearing the flag logs
+    if (!should_log_.exchange(false, std::memory_order_relaxed)) {
       return;
     }
 
@@ -141,13 +173,10 @@ private:
       logger_,
       "Trying to publish message on the topic '%s', but the publisher is not activated",
       this->get_topic_name());
-
-    // We stop logging until the flag gets enabled again
-    should_log_ = false;
   }
 
-  bool enabled_ = false;
-  bool should_log_ = true;
+  std::atomic<bool> enabled_;
+  std::atomic<bool> should_log_;
   rclcpp::Logger logger_;
 };
 
@@ -0,0 +1,239 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rclcpp_lifecycle/lifecycle_group.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "lifecycle_msgs/msg/transition.hpp"
+
+#include "rclcpp/logging.hpp"
+
+namespace rclcpp_lifecycle
+{
+
+LifecycleGroup::LifecycleGroup(size_t number_of_threads)
+: number_of_threads_(number_of_threads)
+{
+  if (0u == number_of_threads_) {
+    number_of_threads_ = std::max(1u, std::thread::hardware_concurrency());
+  }
+}
+
+LifecycleGroup::~LifecycleGroup() {}
+
+void
+LifecycleGroup::add_node(
+  LifecycleNode::SharedPtr node,
+  const std::vector<LifecycleNode::SharedPtr> & dependencies)
+{
+  if (!node) {
+    throw std::invalid_argument("node cannot be null");
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto find_entry = [this](const LifecycleNode::SharedPtr & node_to_find) {
+      return std::find_if(
+        entries_.begin(), entries_.end(),
+        [&node_to_find](const Entry & entry) {return entry.node == node_to_find;});
+    };
+  if (find_entry(node) != entries_.end()) {
+    throw std::invalid_argument(
+            "node '" + std::string(node->get_name()) + "' is already in the group");
+  }
+
+  Entry entry;
+  entry.node = std::move(node);
+  for (const auto & dependency : dependencies) {
+    auto it = find_entry(dependency);
+    if (it == entries_.end()) {
+      throw std::invalid_argument("the dependencies of a node must be added to the group first");
+    }
+    entry.dependencies.push_back(static_cast<size_t>(it - entries_.begin()));
+  }
+  entries_.push_back(std::move(entry));
+}
+
+size_t
+LifecycleGroup::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+LifecycleGroup::TransitionResult
+LifecycleGroup::trigger_transition(uint8_t transition_id)
+{
+  using lifecycle_msgs::msg::Transition;
+  const bool reverse =
+    transition_id != Transition::TRANSITION_CONFIGURE &&
+    transition_id != Transition::TRANSITION_ACTIVATE;
+  return run_transition(
+    [transition_id](LifecycleNode & node, CallbackReturn & callback_return) -> const State & {
+      return node.trigger_transition(transition_id, callback_return);
+    }, reverse);
+}
+
+LifecycleGroup::TransitionResult
+LifecycleGroup::configure()
+{
+  return run_transition(
+    [](LifecycleNode & node, CallbackReturn & callback_return) -> const State & {
+      return node.configure(callback_return);
+    }, false);
+}
+
+LifecycleGroup::TransitionResult
+LifecycleGroup::cleanup()
+{
+  return run_transition(
+    [](LifecycleNode & node, CallbackReturn & callback_return) -> const State & {
+      return node.cleanup(callback_return);
+    }, true);
+}
+
+LifecycleGroup::TransitionResult
+LifecycleGroup::activate()
+{
+  return run_transition(
+    [](LifecycleNode & node, CallbackReturn & callback_return) -> const State & {
+      return node.activate(callback_return);
+    }, false);
+}
+
+LifecycleGroup::TransitionResult
+LifecycleGroup::deactivate()
+{
+  return run_transition(
+    [](LifecycleNode & node, CallbackReturn & callback_return) -> const State & {
+      return node.deactivate(callback_return);
+    }, true);
+}
+
+LifecycleGroup::TransitionResult
+LifecycleGroup::shutdown()
+{
+  return run_transition(
+    [](LifecycleNode & node, CallbackReturn & callback_return) -> const State & {
+      return node.shutdown(callback_return);
+    }, true);
+}
+
+LifecycleGroup::TransitionResult
+LifecycleGroup::run_transition(const NodeTransition & transition, bool reverse)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const size_t number_of_nodes = entries_.size();
+
+  // A node is ready once all the nodes it waits for are done
+  std::vector<std::vector<size_t>> waiting_nodes(number_of_nodes);
+  std::vector<size_t> pending(number_of_nodes, 0u);
+  for (size_t i = 0; i < number_of_nodes; ++i) {
+    for (size_t dependency : entries_[i].dependencies) {
+      if (reverse) {
+        waiting_nodes[i].push_back(dependency);
+        ++pending[dependency];
+      } else {
+        waiting_nodes[dependency].push_back(i);
+        ++pending[i];
+      }
+    }
+  }
+
+  TransitionResult result;
+  result.nodes.resize(number_of_nodes);
+  std::vector<char> skipped(number_of_nodes, false);
+  std::deque<size_t> ready;
+  for (size_t i = 0; i < number_of_nodes; ++i) {
+    result.nodes[i].node = entries_[i].node;
+    if (0u == pending[i]) {
+      ready.push_back(i);
+    }
+  }
+
+  std::mutex queue_mutex;
+  std::condition_variable queue_cv;
+  size_t remaining = number_of_nodes;
+  auto run_ready_nodes = [&]() {
+      std::unique_lock<std::mutex> queue_lock(queue_mutex);
+      while (true) {
+        queue_cv.wait(queue_lock, [&]() {return !ready.empty() || 0u == remaining;});
+        if (ready.empty()) {
+          return;
+        }
+        const size_t i = ready.front();
+        ready.pop_front();
+        auto & node_result = result.nodes[i];
+        const bool triggered = !skipped[i];
+        queue_lock.unlock();
+
+        if (triggered) {
+          node_result.triggered = true;
+          try {
+            node_result.state_id = transition(*node_result.node, node_result.callback_return).id();
+          } catch (const std::exception & ex) {
+            RCLCPP_ERROR(
+              node_result.node->get_logger(), "Failed to transition the node: %s", ex.what());
+            node_result.callback_return = CallbackReturn::ERROR;
+            node_result.state_id = node_result.node->get_current_state().id();
+          }
+        } else {
+          node_result.state_id = node_result.node->get_current_state().id();
+        }
+
+        queue_lock.lock();
+        const bool succeeded = triggered && CallbackReturn::SUCCESS == node_result.callback_return;
+        for (size_t waiting_node : waiting_nodes[i]) {
+          if (!succeeded) {
+            skipped[waiting_node] = true;
+          }
+          if (0u == --pending[waiting_node]) {
+            ready.push_back(waiting_node);
+          }
+        }
+        --remaining;
+        queue_cv.notify_all();
+      }
+    };
+
+  const size_t number_of_threads = std::min(number_of_threads_, number_of_nodes);
+  std::vector<std::thread> threads;
+  if (number_of_threads > 1) {
+    threads.reserve(number_of_threads - 1);
+    for (size_t i = 1; i < number_of_threads; ++i) {
+      threads.emplace_back(run_ready_nodes);
+    }
+  }
+  run_ready_nodes();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  result.success = std::all_of(
+    result.nodes.begin(), result.nodes.end(),
+    [](const NodeTransitionResult & node_result) {
+      return node_result.triggered && CallbackReturn::SUCCESS == node_result.callback_return;
+    });
+  return result;
+}
+
+}  // namespace rclcpp_lifecycle
@@ -68,8 +68,13 @@ LifecycleNode::LifecycleNode(
       *(options.get_rcl_node_options()),
       options.use_intra_process_comms(),
       options.enable_topic_statistics())),
-  node_graph_(new rclcpp::node_interfaces::NodeGraph(node_base_.get())),
-  node_logging_(new rclcpp::node_interfaces::NodeLogging(node_base_.get())),
+  node_graph_(new rclcpp::node_interfaces::NodeGraph(
+      node_base_.get(),
+      options.use_graph_cache())),
+  node_logging_(new rclcpp::node_interfaces::NodeLogging(
+      node_base_.get(),
+      options.use_shared_infrastructure() && options.enable_rosout(),
+      options.rosout_qos())),
   node_timers_(new rclcpp::node_interfaces::NodeTimers(node_base_.get())),
   node_topics_(new rclcpp::node_interfaces::NodeTopics(node_base_.get(), node_timers_.get())),
   node_services_(new rclcpp::node_interfaces::NodeServices(node_base_.get())),
@@ -92,7 +97,12 @@ LifecycleNode::LifecycleNode(
       options.parameter_event_qos(),
       options.parameter_event_publisher_options(),
       options.allow_undeclared_parameters(),
-      options.automatically_declare_parameters_from_overrides()
+      options.automatically_declare_parameters_from_overrides(),
+      node_timers_,
+      options.parameter_event_coalescing_period(),
+      options.use_shared_infrastructure(),
+      options.lazy_parameter_services(),
+      node_graph_
     )),
   node_time_source_(new rclcpp::node_interfaces::NodeTimeSource(
       node_base_,
@@ -103,13 +113,15 @@ LifecycleNode::LifecycleNode(
       node_clock_,
       node_parameters_,
       options.clock_qos(),
-      options.use_clock_thread()
+      options.use_clock_thread(),
+      options.use_shared_clock_source(),
+      options.use_shared_infrastructure()
     )),
   node_waitables_(new rclcpp::node_interfaces::NodeWaitables(node_base_.get())),
   node_options_(options),
-  impl_(new LifecycleNodeInterfaceImpl(node_base_, node_services_))
+  impl_(new LifecycleNodeInterfaceImpl(node_base_, node_services_, node_topics_, node_graph_))
 {
-  impl_->init(enable_communication_interface);
+  impl_->init(enable_communication_interface, options.lazy_lifecycle_services());
 
   register_on_configure(
     std::bind(
@@ -133,6 +145,8 @@ LifecycleNode::LifecycleNode(
 
 LifecycleNode::~LifecycleNode()
 {
+  // The transition callbacks may use the node interfaces.
+  impl_->wait_for_async_transition();
   // release sub-interfaces in an order that allows them to consult with node_base during tear-down
   node_waitables_.reset();
   node_time_source_.reset();
@@ -171,6 +185,12 @@ LifecycleNode::create_callback_group(
   return node_base_->create_callback_group(group_type, automatically_add_to_executor_with_node);
 }
 
+rclcpp::CallbackGroup::SharedPtr
+LifecycleNode::get_managed_callback_group()
+{
+  return impl_->get_managed_callback_group();
+}
+
 const rclcpp::ParameterValue &
 LifecycleNode::declare_parameter(
   const std::string & name,
@@ -543,6 +563,18 @@ LifecycleNode::get_transition_graph()
   return impl_->get_transition_graph();
 }
 
+void
+LifecycleNode::set_async_transitions(bool async_transitions)
+{
+  impl_->set_async_transitions(async_transitions);
+}
+
+bool
+LifecycleNode::get_async_transitions() const
+{
+  return impl_->get_async_transitions();
+}
+
 const State &
 LifecycleNode::trigger_transition(const Transition & transition)
 {
@@ -17,13 +17,18 @@
 
 #include "rclcpp_lifecycle/lifecycle_node.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <utility>
 
+#include "lifecycle_msgs/msg/state.hpp"
 #include "lifecycle_msgs/msg/transition_description.hpp"
 #include "lifecycle_msgs/msg/transition_event.h"  // for getting the c-typesupport
 #include "lifecycle_msgs/msg/transition_event.hpp"
@@ -37,8 +42,15 @@
 #include "rcl_lifecycle/rcl_lifecycle.h"
 #include "rcl_lifecycle/transition_map.h"
 
+#include "rclcpp/callback_group.hpp"
+#include "rclcpp/create_publisher.hpp"
+#include "rclcpp/create_service.hpp"
+#include "rclcpp/graph_listener.hpp"
 #include "rclcpp/node_interfaces/node_base_interface.hpp"
+#include "rclcpp/node_interfaces/node_graph_interface.hpp"
 #include "rclcpp/node_interfaces/node_services_interface.hpp"
+#include "rclcpp/node_interfaces/node_topics_interface.hpp"
+#include "rclcpp/publisher.hpp"
 
 #include "rcutils/logging_macros.h"
 
@@ -53,16 +65,55 @@ class LifecycleNode::LifecycleNodeInterfaceImpl
   using GetAvailableTransitionsSrv = lifecycle_msgs::srv::GetAvailableTransitions;
   using TransitionEventMsg = lifecycle_msgs::msg::TransitionEvent;
 
+  /// Creates the lazy communication interface after the graph changes.
+  class LifecycleClientObserver : public rclcpp::graph_listener::GraphObserver
+  {
+public:
+    explicit LifecycleClientObserver(LifecycleNodeInterfaceImpl & impl)
+    : impl_(impl)
+    {}
+
+    const rcl_guard_condition_t *
+    get_graph_guard_condition() const override
+    {
+      return rcl_node_get_graph_guard_condition(
+        impl_.node_base_interface_->get_rcl_node_handle());
+    }
+
+    void
+    on_graph_change() override
+    {
+      impl_.create_communication_interface_if_discovered();
+    }
+
+private:
+    LifecycleNodeInterfaceImpl & impl_;
+  };
+
 public:
   LifecycleNodeInterfaceImpl(
     std::shared_ptr<rclcpp::node_interfaces::NodeBaseInterface> node_base_interface,
-    std::shared_ptr<rclcpp::node_interfaces::NodeServicesInterface> node_services_interface)
+    std::shared_ptr<rclcpp::node_interfaces::NodeServicesInterface> node_services_interface,
+    std::shared_ptr<rclcpp::node_interfaces::NodeTopicsInterface> node_topics_interface,
+    std::shared_ptr<rclcpp::node_interfaces::NodeGraphInterface> node_graph_interface)
   : node_base_interface_(node_base_interface),
-    node_services_interface_(node_services_interface)
+    node_services_interface_(node_services_interface),
+    node_topics_interface_(node_topics_interface),
+    node_graph_interface_(node_graph_interface)
   {}
 
   ~LifecycleNodeInterfaceImpl()
   {
+    wait_for_async_transition();
+    if (client_observer_) {
+      try {
+        graph_listener_->remove_graph_observer(client_observer_.get());
+      } catch (const std::exception & exception) {
+        RCUTILS_LOG_ERROR_NAMED(
+          "rclcpp_lifecycle",
+          "failed to remove the graph observer of the lifecycle services: %s", exception.what());
+      }
+    }
     rcl_node_t * node_handle = node_base_interface_->get_rcl_node_handle();
     auto ret = rcl_lifecycle_state_machine_fini(&state_machine_, node_handle);
     if (ret != RCL_RET_OK) {
@@ -73,14 +124,16 @@ public:
   }
 
   void
-  init(bool enable_communication_interface = true)
+  init(bool enable_communication_interface = true, bool lazy_communication_interface = false)
   {
     rcl_node_t * node_handle = node_base_interface_->get_rcl_node_handle();
     const rcl_node_options_t * node_options =
       rcl_node_get_options(node_base_interface_->get_rcl_node_handle());
     state_machine_ = rcl_lifecycle_get_zero_initialized_state_machine();
     auto state_machine_options = rcl_lifecycle_get_default_state_machine_options();
-    state_machine_options.enable_com_interface = enable_communication_interface;
+    // The lazy communication interface is created by rclcpp, once it is needed.
+    state_machine_options.enable_com_interface =
+      enable_communication_interface && !lazy_communication_interface;
     state_machine_options.allocator = node_options->allocator;
 
     // The call to initialize the state machine takes
@@ -104,90 +157,148 @@ public:
               std::string("Couldn't initialize state machine for node ") +
               node_base_interface_->get_name());
     }
+    build_tables();
 
-    if (enable_communication_interface) {
-      { // change_state
-        auto cb = std::bind(
-          &LifecycleNodeInterfaceImpl::on_change_state, this,
-          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        rclcpp::AnyServiceCallback<ChangeStateSrv> any_cb;
-        any_cb.set(std::move(cb));
-
-        srv_change_state_ = std::make_shared<rclcpp::Service<ChangeStateSrv>>(
-          node_base_interface_->get_shared_rcl_node_handle(),
-          &state_machine_.com_interface.srv_change_state,
-          any_cb);
-        node_services_interface_->add_service(
-          std::dynamic_pointer_cast<rclcpp::ServiceBase>(srv_change_state_),
-          nullptr);
-      }
+    if (!enable_communication_interface) {
+      return;
+    }
+    if (!lazy_communication_interface) {
+      create_communication_interface();
+      return;
+    }
 
-      { // get_state
-        auto cb = std::bind(
-          &LifecycleNodeInterfaceImpl::on_get_state, this,
-          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        rclcpp::AnyServiceCallback<GetStateSrv> any_cb;
-        any_cb.set(std::move(cb));
-
-        srv_get_state_ = std::make_shared<rclcpp::Service<GetStateSrv>>(
-          node_base_interface_->get_shared_rcl_node_handle(),
-          &state_machine_.com_interface.srv_get_state,
-          any_cb);
-        node_services_interface_->add_service(
-          std::dynamic_pointer_cast<rclcpp::ServiceBase>(srv_get_state_),
-          nullptr);
-      }
+    const std::string node_name = node_base_interface_->get_fully_qualified_name();
+    const char * separator = node_name.back() == '/' ? "" : "/";
+    for (const char * service_name : {
+        "change_state", "get_state", "get_available_states", "get_available_transitions",
+        "get_transition_graph"})
+    {
+      lazy_service_names_.push_back(node_name + separator + service_name);
+    }
+    lazy_transition_event_topic_name_ = node_name + separator + "transition_event";
+    auto context = node_base_interface_->get_context();
+    graph_listener_ = context->get_sub_context<rclcpp::graph_listener::GraphListener>(context);
+    client_observer_ = std::make_unique<LifecycleClientObserver>(*this);
+    graph_listener_->add_graph_observer(client_observer_.get());
+    try {
+      graph_listener_->start_if_not_started();
+    } catch (...) {
+      graph_listener_->remove_graph_observer(client_observer_.get());
+      client_observer_.reset();
+      throw;
+    }
+    // The clients discovered before the graph listener observes the node.
+    create_communication_interface_if_discovered();
+  }
 
-      { // get_available_states
-        auto cb = std::bind(
-          &LifecycleNodeInterfaceImpl::on_get_available_states, this,
-          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        rclcpp::AnyServiceCallback<GetAvailableStatesSrv> any_cb;
-        any_cb.set(std::move(cb));
-
-        srv_get_available_states_ = std::make_shared<rclcpp::Service<GetAvailableStatesSrv>>(
-          node_base_interface_->get_shared_rcl_node_handle(),
-          &state_machine_.com_interface.srv_get_available_states,
-          any_cb);
-        node_services_interface_->add_service(
-          std::dynamic_pointer_cast<rclcpp::ServiceBase>(srv_get_available_states_),
-          nullptr);
-      }
+  /// Add a lifecycle service, using the service of the rcl state machine if it created one.
+  template<typename ServiceT, typename CallbackT>
+  std::shared_ptr<rclcpp::Service<ServiceT>>
+  add_lifecycle_service(rcl_service_t * rcl_service, const char * service_name, CallbackT && cb)
+  {
+    std::shared_ptr<rclcpp::Service<ServiceT>> service;
+    if (state_machine_.options.enable_com_interface) {
+      rclcpp::AnyServiceCallback<ServiceT> any_cb;
+      any_cb.set(std::forward<CallbackT>(cb));
+      service = std::make_shared<rclcpp::Service<ServiceT>>(
+        node_base_interface_->get_shared_rcl_node_handle(), rcl_service, any_cb);
+      node_services_interface_->add_service(
+        std::dynamic_pointer_cast<rclcpp::ServiceBase>(service), nullptr);
+    } else {
+      service = rclcpp::create_service<ServiceT>(
+        node_base_interface_, node_services_interface_, std::string("~/") + service_name,
+        std::forward<CallbackT>(cb), rmw_qos_profile_services_default, nullptr);
+    }
+    return service;
+  }
 
-      { // get_available_transitions
-        auto cb = std::bind(
-          &LifecycleNodeInterfaceImpl::on_get_available_transitions, this,
-          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        rclcpp::AnyServiceCallback<GetAvailableTransitionsSrv> any_cb;
-        any_cb.set(std::move(cb));
-
-        srv_get_available_transitions_ =
-          std::make_shared<rclcpp::Service<GetAvailableTransitionsSrv>>(
-          node_base_interface_->get_shared_rcl_node_handle(),
-          &state_machine_.com_interface.srv_get_available_transitions,
-          any_cb);
-        node_services_interface_->add_service(
-          std::dynamic_pointer_cast<rclcpp::ServiceBase>(srv_get_available_transitions_),
-          nullptr);
-      }
+  /// Create the lifecycle services, and the transition event publisher if rcl did not.
+  void
+  create_communication_interface()
+  {
+    using std::placeholders::_1;
+    using std::placeholders::_2;
+    using std::placeholders::_3;
+    // The response is sent by on_change_state(), possibly after the callback returned.
+    srv_change_state_ = add_lifecycle_service<ChangeStateSrv>(
+      &state_machine_.com_interface.srv_change_state, "change_state",
+      [this](
+        std::shared_ptr<rclcpp::Service<ChangeStateSrv>> service,
+        std::shared_ptr<rmw_request_id_t> header,
+        std::shared_ptr<ChangeStateSrv::Request> req)
+      {
+        on_change_state(std::move(service), std::move(header), std::move(req));
+      });
+    srv_get_state_ = add_lifecycle_service<GetStateSrv>(
+      &state_machine_.com_interface.srv_get_state, "get_state",
+      std::bind(&LifecycleNodeInterfaceImpl::on_get_state, this, _1, _2, _3));
+    srv_get_available_states_ = add_lifecycle_service<GetAvailableStatesSrv>(
+      &state_machine_.com_interface.srv_get_available_states, "get_available_states",
+      std::bind(&LifecycleNodeInterfaceImpl::on_get_available_states, this, _1, _2, _3));
+    srv_get_available_transitions_ = add_lifecycle_service<GetAvailableTransitionsSrv>(
+      &state_machine_.com_interface.srv_get_available_transitions, "get_available_transitions",
+      std::bind(&LifecycleNodeInterfaceImpl::on_get_available_transitions, this, _1, _2, _3));
+    srv_get_transition_graph_ = add_lifecycle_service<GetAvailableTransitionsSrv>(
+      &state_machine_.com_interface.srv_get_transition_graph, "get_transition_graph",
+      std::bind(&LifecycleNodeInterfaceImpl::on_get_transition_graph, this, _1, _2, _3));
+
+    if (!state_machine_.options.enable_com_interface) {
+      // The QoS of the publisher created by rcl.
+      auto publisher = rclcpp::create_publisher<TransitionEventMsg>(
+        node_topics_interface_, "~/transition_event", rclcpp::QoS(10));
+      std::lock_guard<std::mutex> lock(transition_event_publisher_mutex_);
+      transition_event_publisher_ = publisher;
+    }
+  }
 
-      { // get_transition_graph
-        auto cb = std::bind(
-          &LifecycleNodeInterfaceImpl::on_get_transition_graph, this,
-          std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
-        rclcpp::AnyServiceCallback<GetAvailableTransitionsSrv> any_cb;
-        any_cb.set(std::move(cb));
-
-        srv_get_transition_graph_ =
-          std::make_shared<rclcpp::Service<GetAvailableTransitionsSrv>>(
-          node_base_interface_->get_shared_rcl_node_handle(),
-          &state_machine_.com_interface.srv_get_transition_graph,
-          any_cb);
-        node_services_interface_->add_service(
-          std::dynamic_pointer_cast<rclcpp::ServiceBase>(srv_get_transition_graph_),
-          nullptr);
-      }
+  /// Create the lazy communication interface if one of its clients was discovered.
+  void
+  create_communication_interface_if_discovered()
+  {
+    std::lock_guard<std::mutex> lock(lazy_communication_interface_mutex_);
+    if (lazy_communication_interface_created_) {
+      return;
     }
+    // The names of the services with a client, since the services are not created yet.
+    const auto service_names_and_types = node_graph_interface_->get_service_names_and_types();
+    bool discovered = std::any_of(
+      lazy_service_names_.begin(), lazy_service_names_.end(),
+      [&service_names_and_types](const std::string & service_name) {
+        return service_names_and_types.count(service_name) > 0u;
+      });
+    if (!discovered) {
+      discovered = node_graph_interface_->get_topic_names_and_types().count(
+        lazy_transition_event_topic_name_) > 0u;
+    }
+    if (!discovered) {
+      return;
+    }
+    create_communication_interface();
+    lazy_communication_interface_created_ = true;
+    RCUTILS_LOG_DEBUG_NAMED(
+      "rclcpp_lifecycle", "created the lifecycle services of %s for a discovered client",
+      node_base_interface_->get_name());
+  }
+
+  /// Publish the event of a transition of the state machine, if rclcpp owns the publisher.
+  void
+  publish_transition_event(const rcl_lifecycle_transition_t * transition)
+  {
+    if (nullptr == transition) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(transition_event_publisher_mutex_);
+    if (!transition_event_publisher_) {
+      return;
+    }
+    TransitionEventMsg event;
+    event.transition.id = static_cast<uint8_t>(transition->id);
+    event.transition.label = transition->label;
+    event.start_state.id = static_cast<uint8_t>(transition->start->id);
+    event.start_state.label = transition->start->label;
+    event.goal_state.id = static_cast<uint8_t>(transition->goal->id);
+    event.goal_state.label = transition->goal->label;
+    transition_event_publisher_->publish(event);
   }
 
   bool
@@ -201,11 +312,11 @@ public:
 
   void
   on_change_state(
-    const std::shared_ptr<rmw_request_id_t> header,
-    const std::shared_ptr<ChangeStateSrv::Request> req,
-    std::shared_ptr<ChangeStateSrv::Response> resp)
+    std::shared_ptr<rclcpp::Service<ChangeStateSrv>> service,
+    std::shared_ptr<rmw_request_id_t> header,
+    const std::shared_ptr<ChangeStateSrv::Request> req)
   {
-    (void)header;
+    auto resp = std::make_shared<ChangeStateSrv::Response>();
     if (rcl_lifecycle_state_machine_is_initialized(&state_machine_) != RCL_RET_OK) {
       throw std::runtime_error(
               "Can't get state. State machine is not initialized.");
@@ -221,23 +332,87 @@ public:
     // can be different.
     // the result of this is that the label takes presedence of the id.
     if (req->transition.label.size() != 0) {
-      auto rcl_transition = rcl_lifecycle_get_transition_by_label(
-        state_machine_.current_state, req->transition.label.c_str());
-      if (rcl_transition == nullptr) {
+      if (!find_transition_id(req->transition.label.c_str(), transition_id)) {
         resp->success = false;
+        service->send_response(*header, *resp);
         return;
       }
-      transition_id = static_cast<std::uint8_t>(rcl_transition->id);
     }
 
+    if (!async_transitions_.load()) {
+      resp->success = change_state_for_request(transition_id);
+      service->send_response(*header, *resp);
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(async_transition_mutex_);
+    if (async_transition_running_) {
+      RCUTILS_LOG_WARN_NAMED(
+        "rclcpp_lifecycle", "Rejected transition %u of %s: a transition is running",
+        transition_id, node_base_interface_->get_name());
+      resp->success = false;
+      service->send_response(*header, *resp);
+      return;
+    }
+    // Finished, since it is not running anymore.
+    if (async_transition_thread_.joinable()) {
+      async_transition_thread_.join();
+    }
+    async_transition_running_ = true;
+    async_transition_thread_ = std::thread(
+      [this, service, header, resp, transition_id]() {
+        resp->success = change_state_for_request(transition_id);
+        {
+          std::lock_guard<std::mutex> lock(async_transition_mutex_);
+          async_transition_running_ = false;
+        }
+        try {
+          service->send_response(*header, *resp);
+        } catch (const std::exception & exception) {
+          RCUTILS_LOG_ERROR_NAMED(
+            "rclcpp_lifecycle", "Failed to send the response of transition %u: %s",
+            transition_id, exception.what());
+        }
+      });
+  }
+
+  /// Change the state for a change_state request, return the success of the response.
+  bool
+  change_state_for_request(std::uint8_t transition_id)
+  {
     node_interfaces::LifecycleNodeInterface::CallbackReturn cb_return_code;
     auto ret = change_state(transition_id, cb_return_code);
     (void) ret;
     // TODO(karsten1987): Lifecycle msgs have to be extended to keep both returns
     // 1. return is the actual transition
     // 2. return is whether an error occurred or not
-    resp->success =
-      (cb_return_code == node_interfaces::LifecycleNodeInterface::CallbackReturn::SUCCESS);
+    return cb_return_code == node_interfaces::LifecycleNodeInterface::CallbackReturn::SUCCESS;
+  }
+
+  void
+  set_async_transitions(bool async_transitions)
+  {
+    async_transitions_ = async_transitions;
+  }
+
+  bool
+  get_async_transitions() const
+  {
+    return async_transitions_.load();
+  }
+
+  /// Wait for the transition running on the worker thread, if any.
+  void
+  wait_for_async_transition()
+  {
+    std::thread thread;
+    {
+      std::lock_guard<std::mutex> lock(async_transition_mutex_);
+      thread = std::move(async_transition_thread_);
+    }
+    if (thread.joinable()) {
+      thread.join();
+    }
   }
 
   void
@@ -269,13 +444,7 @@ public:
               "Can't get available states. State machine is not initialized.");
     }
 
-    resp->available_states.resize(state_machine_.transition_map.states_size);
-    for (unsigned int i = 0; i < state_machine_.transition_map.states_size; ++i) {
-      resp->available_states[i].id =
-        static_cast<uint8_t>(state_machine_.transition_map.states[i].id);
-      resp->available_states[i].label =
-        static_cast<std::string>(state_machine_.transition_map.states[i].label);
-    }
+    resp->available_states = available_state_msgs_;
   }
 
   void
@@ -291,18 +460,8 @@ public:
               "Can't get available transitions. State machine is not initialized.");
     }
 
-    resp->available_transitions.resize(state_machine_.current_state->valid_transition_size);
-    for (unsigned int i = 0; i < state_machine_.current_state->valid_transition_size; ++i) {
-      lifecycle_msgs::msg::TransitionDescription & trans_desc = resp->available_transitions[i];
-
-      auto rcl_transition = state_machine_.current_state->valid_transitions[i];
-      trans_desc.transition.id = static_cast<uint8_t>(rcl_transition.id);
-      trans_desc.transition.label = rcl_transition.label;
-      trans_desc.start_state.id = static_cast<uint8_t>(rcl_transition.start->id);
-      trans_desc.start_state.label = rcl_transition.start->label;
-      trans_desc.goal_state.id = static_cast<uint8_t>(rcl_transition.goal->id);
-      trans_desc.goal_state.label = rcl_transition.goal->label;
-    }
+    resp->available_transitions =
+      tables_.at(static_cast<uint8_t>(state_machine_.current_state->id)).transition_msgs;
   }
 
   void
@@ -318,18 +477,7 @@ public:
               "Can't get available transitions. State machine is not initialized.");
     }
 
-    resp->available_transitions.resize(state_machine_.transition_map.transitions_size);
-    for (unsigned int i = 0; i < state_machine_.transition_map.transitions_size; ++i) {
-      lifecycle_msgs::msg::TransitionDescription & trans_desc = resp->available_transitions[i];
-
-      auto rcl_transition = state_machine_.transition_map.transitions[i];
-      trans_desc.transition.id = static_cast<uint8_t>(rcl_transition.id);
-      trans_desc.transition.label = rcl_transition.label;
-      trans_desc.start_state.id = static_cast<uint8_t>(rcl_transition.start->id);
-      trans_desc.start_state.label = rcl_transition.start->label;
-      trans_desc.goal_state.id = static_cast<uint8_t>(rcl_transition.goal->id);
-      trans_desc.goal_state.label = rcl_transition.goal->label;
-    }
+    resp->available_transitions = transition_graph_msgs_;
   }
 
   const State &
@@ -339,45 +487,29 @@ public:
     return current_state_;
   }
 
-  std::vector<State>
-  get_available_states()
+  const std::vector<State> &
+  get_available_states() const
   {
-    std::vector<State> states;
-    states.reserve(state_machine_.transition_map.states_size);
-
-    for (unsigned int i = 0; i < state_machine_.transition_map.states_size; ++i) {
-      states.emplace_back(&state_machine_.transition_map.states[i]);
-    }
-    return states;
+    return available_states_;
   }
 
-  std::vector<Transition>
-  get_available_transitions()
+  const std::vector<Transition> &
+  get_available_transitions() const
   {
-    std::vector<Transition> transitions;
-    transitions.reserve(state_machine_.current_state->valid_transition_size);
-
-    for (unsigned int i = 0; i < state_machine_.current_state->valid_transition_size; ++i) {
-      transitions.emplace_back(&state_machine_.current_state->valid_transitions[i]);
-    }
-    return transitions;
+    return tables_.at(static_cast<uint8_t>(state_machine_.current_state->id)).transitions;
   }
 
-  std::vector<Transition>
-  get_transition_graph()
+  const std::vector<Transition> &
+  get_transition_graph() const
   {
-    std::vector<Transition> transitions;
-    transitions.reserve(state_machine_.transition_map.transitions_size);
-
-    for (unsigned int i = 0; i < state_machine_.transition_map.transitions_size; ++i) {
-      transitions.emplace_back(&state_machine_.transition_map.transitions[i]);
-    }
-    return transitions;
+    return transition_graph_;
   }
 
   rcl_ret_t
   change_state(std::uint8_t transition_id, LifecycleNodeInterface::CallbackReturn & cb_return_code)
   {
+    // One transition at a time, the transition callbacks may trigger transitions themselves.
+    std::lock_guard<std::recursive_mutex> lock(change_state_mutex_);
     if (rcl_lifecycle_state_machine_is_initialized(&state_machine_) != RCL_RET_OK) {
       RCUTILS_LOG_ERROR(
         "Unable to change state for state machine for %s: %s",
@@ -389,6 +521,8 @@ public:
     // keep the initial state to pass to a transition callback
     State initial_state(state_machine_.current_state);
 
+    const rcl_lifecycle_transition_t * transition =
+      rcl_lifecycle_get_transition_by_id(state_machine_.current_state, transition_id);
     if (
       rcl_lifecycle_trigger_transition_by_id(
         &state_machine_, transition_id, publish_update) != RCL_RET_OK)
@@ -399,6 +533,9 @@ public:
       rcutils_reset_error();
       return RCL_RET_ERROR;
     }
+    publish_transition_event(transition);
+    // Detach the managed entities already while the node is in the transition state.
+    update_managed_callback_group();
 
     auto get_label_for_return_code =
       [](node_interfaces::LifecycleNodeInterface::CallbackReturn cb_return_code) -> const char *{
@@ -414,6 +551,8 @@ public:
     cb_return_code = execute_callback(state_machine_.current_state->id, initial_state);
     auto transition_label = get_label_for_return_code(cb_return_code);
 
+    transition =
+      rcl_lifecycle_get_transition_by_label(state_machine_.current_state, transition_label);
     if (
       rcl_lifecycle_trigger_transition_by_label(
         &state_machine_, transition_label, publish_update) != RCL_RET_OK)
@@ -422,8 +561,10 @@ public:
         "Failed to finish transition %u. Current state is now: %s (%s)",
         transition_id, state_machine_.current_state->label, rcl_get_error_string().str);
       rcutils_reset_error();
+      update_managed_callback_group();
       return RCL_RET_ERROR;
     }
+    publish_transition_event(transition);
 
     // error handling ?!
     // TODO(karsten1987): iterate over possible ret value
@@ -432,15 +573,20 @@ public:
 
       auto error_cb_code = execute_callback(state_machine_.current_state->id, initial_state);
       auto error_cb_label = get_label_for_return_code(error_cb_code);
+      transition =
+        rcl_lifecycle_get_transition_by_label(state_machine_.current_state, error_cb_label);
       if (
         rcl_lifecycle_trigger_transition_by_label(
           &state_machine_, error_cb_label, publish_update) != RCL_RET_OK)
       {
         RCUTILS_LOG_ERROR("Failed to call cleanup on error state: %s", rcl_get_error_string().str);
         rcutils_reset_error();
+        update_managed_callback_group();
         return RCL_RET_ERROR;
       }
+      publish_transition_event(transition);
     }
+    update_managed_callback_group();
     // This true holds in both cases where the actual callback
     // was successful or not, since at this point we have a valid transistion
     // to either a new primary state or error state
@@ -476,10 +622,9 @@ public:
   const State & trigger_transition(
     const char * transition_label, LifecycleNodeInterface::CallbackReturn & cb_return_code)
   {
-    auto transition =
-      rcl_lifecycle_get_transition_by_label(state_machine_.current_state, transition_label);
-    if (transition) {
-      change_state(static_cast<uint8_t>(transition->id), cb_return_code);
+    std::uint8_t transition_id;
+    if (find_transition_id(transition_label, transition_id)) {
+      change_state(transition_id, cb_return_code);
     }
     return get_current_state();
   }
@@ -512,6 +657,101 @@ public:
     weak_timers_.push_back(timer);
   }
 
+  /// Build the tables of states and transitions, which do not change after initialization.
+  void
+  build_tables()
+  {
+    const rcl_lifecycle_transition_map_t & map = state_machine_.transition_map;
+    available_states_.reserve(map.states_size);
+    available_state_msgs_.resize(map.states_size);
+    for (unsigned int i = 0; i < map.states_size; ++i) {
+      const rcl_lifecycle_state_t & rcl_state = map.states[i];
+      available_states_.emplace_back(&rcl_state);
+      available_state_msgs_[i].id = static_cast<uint8_t>(rcl_state.id);
+      available_state_msgs_[i].label = rcl_state.label;
+
+      StateTable & table = tables_[static_cast<uint8_t>(rcl_state.id)];
+      table.transitions.reserve(rcl_state.valid_transition_size);
+      table.transition_msgs.reserve(rcl_state.valid_transition_size);
+      for (unsigned int j = 0; j < rcl_state.valid_transition_size; ++j) {
+        const rcl_lifecycle_transition_t & rcl_transition = rcl_state.valid_transitions[j];
+        table.transitions.emplace_back(&rcl_transition);
+        table.transition_msgs.push_back(describe_transition(rcl_transition));
+        // The first of several transitions with the same label wins, like in the rcl lookup.
+        table.transition_ids_by_label.emplace(
+          rcl_transition.label, static_cast<uint8_t>(rcl_transition.id));
+      }
+    }
+    transition_graph_.reserve(map.transitions_size);
+    transition_graph_msgs_.reserve(map.transitions_size);
+    for (unsigned int i = 0; i < map.transitions_size; ++i) {
+      transition_graph_.emplace_back(&map.transitions[i]);
+      transition_graph_msgs_.push_back(describe_transition(map.transitions[i]));
+    }
+  }
+
+  static lifecycle_msgs::msg::TransitionDescription
+  describe_transition(const rcl_lifecycle_transition_t & rcl_transition)
+  {
+    lifecycle_msgs::msg::TransitionDescription trans_desc;
+    trans_desc.transition.id = static_cast<uint8_t>(rcl_transition.id);
+    trans_desc.transition.label = rcl_transition.label;
+    trans_desc.start_state.id = static_cast<uint8_t>(rcl_transition.start->id);
+    trans_desc.start_state.label = rcl_transition.start->label;
+    trans_desc.goal_state.id = static_cast<uint8_t>(rcl_transition.goal->id);
+    trans_desc.goal_state.label = rcl_transition.goal->label;
+    return trans_desc;
+  }
+
+  /// Look up the id of the transition with the given label valid in the current state.
+  bool
+  find_transition_id(const char * transition_label, std::uint8_t & transition_id) const
+  {
+    const auto & ids_by_label =
+      tables_.at(static_cast<uint8_t>(state_machine_.current_state->id)).transition_ids_by_label;
+    auto it = ids_by_label.find(transition_label);
+    if (it == ids_by_label.end()) {
+      return false;
+    }
+    transition_id = it->second;
+    return true;
+  }
+
+  rclcpp::CallbackGroup::SharedPtr
+  get_managed_callback_group()
+  {
+    std::lock_guard<std::mutex> lock(managed_callback_group_mutex_);
+    if (!managed_callback_group_) {
+      managed_callback_group_ = node_base_interface_->create_callback_group(
+        rclcpp::CallbackGroupType::MutuallyExclusive);
+      managed_callback_group_->set_enabled(is_active());
+    }
+    return managed_callback_group_;
+  }
+
+  bool
+  is_active() const
+  {
+    return state_machine_.current_state &&
+           state_machine_.current_state->id == lifecycle_msgs::msg::State::PRIMARY_STATE_ACTIVE;
+  }
+
+  /// Enable the managed callback group in the active state only and wake the executors.
+  void
+  update_managed_callback_group()
+  {
+    std::lock_guard<std::mutex> lock(managed_callback_group_mutex_);
+    if (!managed_callback_group_ || managed_callback_group_->is_enabled() == is_active()) {
+      return;
+    }
+    managed_callback_group_->set_enabled(is_active());
+    if (node_base_interface_->trigger_notify_guard_condition() != RCL_RET_OK) {
+      RCUTILS_LOG_ERROR(
+        "Failed to notify wait set on lifecycle state change: %s", rcl_get_error_string().str);
+      rcutils_reset_error();
+    }
+  }
+
   rcl_lifecycle_state_machine_t state_machine_;
   State current_state_;
   std::map<
@@ -520,6 +760,8 @@ public:
 
   using NodeBasePtr = std::shared_ptr<rclcpp::node_interfaces::NodeBaseInterface>;
   using NodeServicesPtr = std::shared_ptr<rclcpp::node_interfaces::NodeServicesInterface>;
+  using NodeTopicsPtr = std::shared_ptr<rclcpp::node_interfaces::NodeTopicsInterface>;
+  using NodeGraphPtr = std::shared_ptr<rclcpp::node_interfaces::NodeGraphInterface>;
   using ChangeStateSrvPtr = std::shared_ptr<rclcpp::Service<ChangeStateSrv>>;
   using GetStateSrvPtr = std::shared_ptr<rclcpp::Service<GetStateSrv>>;
   using GetAvailableStatesSrvPtr =
@@ -531,15 +773,50 @@ public:
 
   NodeBasePtr node_base_interface_;
   NodeServicesPtr node_services_interface_;
+  NodeTopicsPtr node_topics_interface_;
+  NodeGraphPtr node_graph_interface_;
   ChangeStateSrvPtr srv_change_state_;
   GetStateSrvPtr srv_get_state_;
   GetAvailableStatesSrvPtr srv_get_available_states_;
   GetAvailableTransitionsSrvPtr srv_get_available_transitions_;
   GetTransitionGraphSrvPtr srv_get_transition_graph_;
 
+  // Lazy communication interface, created by rclcpp instead of rcl
+  std::vector<std::string> lazy_service_names_;
+  std::string lazy_transition_event_topic_name_;
+  std::shared_ptr<rclcpp::graph_listener::GraphListener> graph_listener_;
+  std::unique_ptr<LifecycleClientObserver> client_observer_;
+  std::mutex lazy_communication_interface_mutex_;
+  bool lazy_communication_interface_created_ = false;
+  std::shared_ptr<rclcpp::Publisher<TransitionEventMsg>> transition_event_publisher_;
+  std::mutex transition_event_publisher_mutex_;
+
+  std::recursive_mutex change_state_mutex_;
+  // Transition requested through the change_state service, running on a worker thread
+  std::atomic<bool> async_transitions_{false};
+  std::mutex async_transition_mutex_;
+  bool async_transition_running_ = false;
+  std::thread async_transition_thread_;
+
+  // Immutable views of the transition map of the state machine
+  struct StateTable
+  {
+    std::vector<Transition> transitions;
+    std::vector<lifecycle_msgs::msg::TransitionDescription> transition_msgs;
+    std::map<std::string, std::uint8_t, std::less<>> transition_ids_by_label;
+  };
+  std::map<std::uint8_t, StateTable> tables_;
+  std::vector<State> available_states_;
+  std::vector<lifecycle_msgs::msg::State> available_state_msgs_;
+  std::vector<Transition> transition_graph_;
+  std::vector<lifecycle_msgs::msg::TransitionDescription> transition_graph_msgs_;
+
   // to controllable things
   std::vector<std::weak_ptr<rclcpp_lifecycle::LifecyclePublisherInterface>> weak_pubs_;
   std::vector<std::weak_ptr<rclcpp::TimerBase>> weak_timers_;
+  // Entities which executors only wait on in the active state
+  rclcpp::CallbackGroup::SharedPtr managed_callback_group_;
+  std::mutex managed_callback_group_mutex_;
 };
 
 }  // namespace rclcpp_lifecycle
@@ -0,0 +1,194 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lifecycle_msgs/msg/state.hpp"
+#include "lifecycle_msgs/msg/transition.hpp"
+
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_lifecycle/lifecycle_group.hpp"
+#include "rclcpp_lifecycle/lifecycle_node.hpp"
+
+using lifecycle_msgs::msg::State;
+using lifecycle_msgs::msg::Transition;
+using CallbackReturn = rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn;
+
+class TestLifecycleGroup : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    rclcpp::init(0, nullptr);
+  }
+
+  static void TearDownTestCase()
+  {
+    rclcpp::shutdown();
+  }
+};
+
+/// Records the order of the transition callbacks of several nodes.
+struct CallbackLog
+{
+  std::mutex mutex;
+  std::vector<std::string> entries;
+
+  void
+  add(const std::string & entry)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back(entry);
+  }
+
+  size_t
+  index_of(const std::string & entry)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      if (entries[i] == entry) {
+        return i;
+      }
+    }
+    throw std::out_of_range(entry + " not logged");
+  }
+};
+
+class LoggingLifecycleNode : public rclcpp_lifecycle::LifecycleNode
+{
+public:
+  LoggingLifecycleNode(const std::string & node_name, CallbackLog & log)
+  : rclcpp_lifecycle::LifecycleNode(node_name), log_(log)
+  {}
+
+  CallbackReturn configure_return = CallbackReturn::SUCCESS;
+
+protected:
+  CallbackReturn
+  on_configure(const rclcpp_lifecycle::State &) override
+  {
+    log_.add(std::string(get_name()) + ".configure");
+    return configure_return;
+  }
+
+  CallbackReturn
+  on_activate(const rclcpp_lifecycle::State &) override
+  {
+    log_.add(std::string(get_name()) + ".activate");
+    return CallbackReturn::SUCCESS;
+  }
+
+  CallbackReturn
+  on_deactivate(const rclcpp_lifecycle::State &) override
+  {
+    log_.add(std::string(get_name()) + ".deactivate");
+    return CallbackReturn::SUCCESS;
+  }
+
+private:
+  CallbackLog & log_;
+};
+
+TEST_F(TestLifecycleGroup, add_node) {
+  CallbackLog log;
+  auto a = std::make_shared<LoggingLifecycleNode>("a", log);
+  auto b = std::make_shared<LoggingLifecycleNode>("b", log);
+
+  rclcpp_lifecycle::LifecycleGroup group;
+  EXPECT_THROW(group.add_node(nullptr), std::invalid_argument);
+  // Dependencies must be added first
+  EXPECT_THROW(group.add_node(b, {a}), std::invalid_argument);
+  group.add_node(a);
+  EXPECT_THROW(group.add_node(a), std::invalid_argument);
+  group.add_node(b, {a});
+  EXPECT_EQ(2u, group.size());
+}
+
+TEST_F(TestLifecycleGroup, transitions_follow_dependencies) {
+  // c depends on a and b, d depends on c
+  CallbackLog log;
+  auto a = std::make_shared<LoggingLifecycleNode>("a", log);
+  auto b = std::make_shared<LoggingLifecycleNode>("b", log);
+  auto c = std::make_shared<LoggingLifecycleNode>("c", log);
+  auto d = std::make_shared<LoggingLifecycleNode>("d", log);
+
+  rclcpp_lifecycle::LifecycleGroup group(4);
+  group.add_node(a);
+  group.add_node(b);
+  group.add_node(c, {a, b});
+  group.add_node(d, {c});
+
+  auto result = group.configure();
+  EXPECT_TRUE(result.success);
+  ASSERT_EQ(4u, result.nodes.size());
+  for (const auto & node_result : result.nodes) {
+    EXPECT_TRUE(node_result.triggered);
+    EXPECT_EQ(CallbackReturn::SUCCESS, node_result.callback_return);
+    EXPECT_EQ(State::PRIMARY_STATE_INACTIVE, node_result.state_id);
+  }
+  EXPECT_EQ(a, result.nodes[0].node);
+  EXPECT_EQ(d, result.nodes[3].node);
+  EXPECT_LT(log.index_of("a.configure"), log.index_of("c.configure"));
+  EXPECT_LT(log.index_of("b.configure"), log.index_of("c.configure"));
+  EXPECT_LT(log.index_of("c.configure"), log.index_of("d.configure"));
+
+  result = group.trigger_transition(Transition::TRANSITION_ACTIVATE);
+  EXPECT_TRUE(result.success);
+  EXPECT_EQ(State::PRIMARY_STATE_ACTIVE, d->get_current_state().id());
+  EXPECT_LT(log.index_of("c.activate"), log.index_of("d.activate"));
+
+  // Dependent nodes go down first
+  result = group.deactivate();
+  EXPECT_TRUE(result.success);
+  EXPECT_LT(log.index_of("d.deactivate"), log.index_of("c.deactivate"));
+  EXPECT_LT(log.index_of("c.deactivate"), log.index_of("a.deactivate"));
+  EXPECT_LT(log.index_of("c.deactivate"), log.index_of("b.deactivate"));
+
+  result = group.shutdown();
+  EXPECT_TRUE(result.success);
+  for (const auto & node_result : result.nodes) {
+    EXPECT_EQ(State::PRIMARY_STATE_FINALIZED, node_result.state_id);
+  }
+}
+
+TEST_F(TestLifecycleGroup, failure_skips_dependent_nodes) {
+  CallbackLog log;
+  auto a = std::make_shared<LoggingLifecycleNode>("a", log);
+  auto b = std::make_shared<LoggingLifecycleNode>("b", log);
+  auto c = std::make_shared<LoggingLifecycleNode>("c", log);
+  a->configure_return = CallbackReturn::FAILURE;
+
+  rclcpp_lifecycle::LifecycleGroup group(2);
+  group.add_node(a);
+  group.add_node(b, {a});
+  group.add_node(c);
+
+  auto result = group.configure();
+  EXPECT_FALSE(result.success);
+  EXPECT_TRUE(result.nodes[0].triggered);
+  EXPECT_EQ(CallbackReturn::FAILURE, result.nodes[0].callback_return);
+  EXPECT_EQ(State::PRIMARY_STATE_UNCONFIGURED, result.nodes[0].state_id);
+  EXPECT_FALSE(result.nodes[1].triggered);
+  EXPECT_EQ(State::PRIMARY_STATE_UNCONFIGURED, result.nodes[1].state_id);
+  EXPECT_TRUE(result.nodes[2].triggered);
+  EXPECT_EQ(State::PRIMARY_STATE_INACTIVE, result.nodes[2].state_id);
+  EXPECT_THROW(log.index_of("b.configure"), std::out_of_range);
+}
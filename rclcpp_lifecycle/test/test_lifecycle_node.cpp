@@ -14,15 +14,18 @@
 
 
 #include <gtest/gtest.h>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 #include <utility>
 
 #include "lifecycle_msgs/msg/state.hpp"
 #include "lifecycle_msgs/msg/transition.hpp"
+#include "lifecycle_msgs/srv/get_state.hpp"
 
 #include "rcl_lifecycle/rcl_lifecycle.h"
 
@@ -613,6 +616,31 @@ TEST_F(TestDefaultStateMachine, check_parameters) {
   EXPECT_TRUE(parameter.as_bool());
 }
 
+TEST_F(TestDefaultStateMachine, transition_tables) {
+  auto test_node = std::make_shared<EmptyLifecycleNode>("testnode");
+  // The primary states, the transition states and the finalized state
+  EXPECT_EQ(11u, test_node->get_available_states().size());
+  const size_t graph_size = test_node->get_transition_graph().size();
+  EXPECT_LT(0u, graph_size);
+
+  auto transitions = test_node->get_available_transitions();
+  ASSERT_EQ(2u, transitions.size());
+  for (const auto & transition : transitions) {
+    EXPECT_EQ(State::PRIMARY_STATE_UNCONFIGURED, transition.start_state().id());
+  }
+
+  // Transitions are looked up by label in the table of the current state.
+  EXPECT_EQ(State::PRIMARY_STATE_INACTIVE, test_node->configure().id());
+  transitions = test_node->get_available_transitions();
+  ASSERT_EQ(3u, transitions.size());
+  for (const auto & transition : transitions) {
+    EXPECT_EQ(State::PRIMARY_STATE_INACTIVE, transition.start_state().id());
+  }
+  EXPECT_EQ(State::PRIMARY_STATE_INACTIVE, test_node->deactivate().id());
+  EXPECT_EQ(State::PRIMARY_STATE_ACTIVE, test_node->activate().id());
+  EXPECT_EQ(graph_size, test_node->get_transition_graph().size());
+}
+
 TEST_F(TestDefaultStateMachine, test_getters) {
   auto test_node = std::make_shared<EmptyLifecycleNode>("testnode");
   auto options = test_node->get_node_options();
@@ -715,6 +743,35 @@ TEST_F(TestDefaultStateMachine, test_graph_services_by_node) {
     "lifecycle_msgs/srv/GetAvailableTransitions");
 }
 
+TEST_F(TestDefaultStateMachine, lazy_lifecycle_services) {
+  auto test_node = std::make_shared<rclcpp_lifecycle::LifecycleNode>(
+    "lazytestnode", rclcpp::NodeOptions().lazy_lifecycle_services(true));
+  EXPECT_EQ(
+    0u, test_node->get_service_names_and_types_by_node("lazytestnode", "").count(
+      "/lazytestnode/change_state"));
+
+  // A client makes the node create its services.
+  auto client_node = std::make_shared<rclcpp::Node>("lazytestclient");
+  auto client = client_node->create_client<lifecycle_msgs::srv::GetState>(
+    "/lazytestnode/get_state");
+  ASSERT_TRUE(wait_for_service_by_node(test_node, "lazytestnode", "/lazytestnode/change_state"));
+  ASSERT_TRUE(wait_for_service_by_node(test_node, "lazytestnode", "/lazytestnode/get_state"));
+  ASSERT_TRUE(
+    wait_for_service_by_node(test_node, "lazytestnode", "/lazytestnode/get_transition_graph"));
+  ASSERT_TRUE(wait_for_topic(test_node, "/lazytestnode/transition_event"));
+
+  ASSERT_TRUE(client->wait_for_service(std::chrono::seconds(10)));
+  auto future = client->async_send_request(
+    std::make_shared<lifecycle_msgs::srv::GetState::Request>());
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(test_node->get_node_base_interface());
+  executor.add_node(client_node);
+  ASSERT_EQ(
+    rclcpp::FutureReturnCode::SUCCESS,
+    executor.spin_until_future_complete(future, std::chrono::seconds(10)));
+  EXPECT_EQ(State::PRIMARY_STATE_UNCONFIGURED, future.get()->current_state.id);
+}
+
 TEST_F(TestDefaultStateMachine, test_callback_groups) {
   auto test_node = std::make_shared<EmptyLifecycleNode>("testnode");
   size_t num_groups = 0;
@@ -740,6 +797,43 @@ TEST_F(TestDefaultStateMachine, test_callback_groups) {
   EXPECT_EQ(num_groups, 2u);
 }
 
+TEST_F(TestDefaultStateMachine, managed_callback_group) {
+  auto test_node = std::make_shared<EmptyLifecycleNode>("testnode");
+  auto group = test_node->get_managed_callback_group();
+  ASSERT_NE(nullptr, group);
+  EXPECT_EQ(group, test_node->get_managed_callback_group());
+  EXPECT_FALSE(group->is_enabled());
+
+  size_t timer_calls = 0;
+  auto timer = test_node->create_wall_timer(
+    std::chrono::milliseconds(1), [&timer_calls]() {++timer_calls;}, group);
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(test_node->get_node_base_interface());
+  auto spin_for_a_while = [&executor]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      executor.spin_some(std::chrono::milliseconds(10));
+    };
+
+  // The timer is detached from the wait set outside of the active state.
+  spin_for_a_while();
+  EXPECT_EQ(0u, timer_calls);
+  test_node->configure();
+  spin_for_a_while();
+  EXPECT_EQ(0u, timer_calls);
+
+  EXPECT_EQ(State::PRIMARY_STATE_ACTIVE, test_node->activate().id());
+  EXPECT_TRUE(group->is_enabled());
+  spin_for_a_while();
+  EXPECT_LT(0u, timer_calls);
+
+  EXPECT_EQ(State::PRIMARY_STATE_INACTIVE, test_node->deactivate().id());
+  EXPECT_FALSE(group->is_enabled());
+  spin_for_a_while();
+  timer_calls = 0;
+  spin_for_a_while();
+  EXPECT_EQ(0u, timer_calls);
+}
+
 TEST_F(TestDefaultStateMachine, wait_for_graph_change)
 {
   auto test_node = std::make_shared<EmptyLifecycleNode>("testnode");
@@ -102,3 +102,25 @@ TEST_F(TestLifecyclePublisher, publish) {
     EXPECT_NO_THROW(node_->publisher()->publish(std::move(msg_ptr)));
   }
 }
+
+TEST_F(TestLifecyclePublisher, publish_if_active) {
+  size_t messages_built = 0;
+  auto make_message = [&messages_built]() {
+      ++messages_built;
+      return test_msgs::msg::Empty();
+    };
+  auto make_unique_message = [&messages_built]() {
+      ++messages_built;
+      return std::make_unique<test_msgs::msg::Empty>();
+    };
+
+  node_->publisher()->on_deactivate();
+  EXPECT_FALSE(node_->publisher()->publish_if_active(make_message));
+  EXPECT_FALSE(node_->publisher()->publish_if_active(make_unique_message));
+  EXPECT_EQ(0u, messages_built);
+
+  node_->publisher()->on_activate();
+  EXPECT_TRUE(node_->publisher()->publish_if_active(make_message));
+  EXPECT_TRUE(node_->publisher()->publish_if_active(make_unique_message));
+  EXPECT_EQ(2u, messages_built);
+}
@@ -19,6 +19,7 @@
 
 #include <gtest/gtest.h>
 #include <chrono>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -364,6 +365,41 @@ TEST_F(TestLifecycleServiceClient, lifecycle_transitions) {
   EXPECT_EQ(transitions.size(), 0u);
 }
 
+TEST_F(TestLifecycleServiceClient, async_transitions) {
+  using CallbackReturn = rclcpp_lifecycle::node_interfaces::LifecycleNodeInterface::CallbackReturn;
+  std::promise<void> release_configure;
+  std::shared_future<void> configure_released = release_configure.get_future().share();
+  lifecycle_node()->register_on_configure(
+    [configure_released](const rclcpp_lifecycle::State &) {
+      configure_released.wait_for(10s);
+      return CallbackReturn::SUCCESS;
+    });
+  lifecycle_node()->set_async_transitions(true);
+  EXPECT_TRUE(lifecycle_node()->get_async_transitions());
+
+  auto configured = std::async(
+    std::launch::async, [this]() {
+      return lifecycle_client()->change_state(
+        lifecycle_msgs::msg::Transition::TRANSITION_CONFIGURE, 20s);
+    });
+
+  // The executor still serves the other requests while the node configures.
+  bool configuring = false;
+  for (size_t i = 0; i < 50u && !configuring; ++i) {
+    configuring = lifecycle_client()->get_state().id ==
+      lifecycle_msgs::msg::State::TRANSITION_STATE_CONFIGURING;
+  }
+  EXPECT_TRUE(configuring);
+  // A second transition is rejected while the first one runs.
+  EXPECT_FALSE(
+    lifecycle_client()->change_state(lifecycle_msgs::msg::Transition::TRANSITION_CONFIGURE));
+
+  release_configure.set_value();
+  EXPECT_TRUE(configured.get());
+  EXPECT_EQ(
+    lifecycle_client()->get_state().id, lifecycle_msgs::msg::State::PRIMARY_STATE_INACTIVE);
+}
+
 TEST_F(TestLifecycleServiceClient, get_service_names_and_types_by_node)
 {
   auto node1 = std::make_shared<LifecycleServiceClient>("client1");